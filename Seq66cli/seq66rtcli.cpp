@@ -24,7 +24,7 @@
  * \library       seq66rtcli application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2020-02-09
- * \updates       2023-10-31
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This application is seq66 without a GUI, control must be done via MIDI.
@@ -48,8 +48,14 @@
 
 #include "cfg/cmdlineopts.hpp"          /* command-line functions           */
 #include "cfg/settings.hpp"             /* seq66::usr() and seq66::rc()     */
+#include "midi/batchconvert.hpp"        /* seq66::batchconvert, --batch     */
+#include "midi/filebench.hpp"           /* seq66::filebench, --file-bench   */
 #include "os/daemonize.hpp"             /* seq66::daemonize()               */
 #include "play/performer.hpp"           /* seq66::perform, the main object  */
+#include "play/mirrorwatch.hpp"         /* seq66::mirrorwatch, --mirror     */
+#include "play/playbench.hpp"           /* seq66::playbench, --bench        */
+#include "play/replaybench.hpp"         /* seq66::replaybench, --replay     */
+#include "play/songrender.hpp"          /* seq66::songrender, --render      */
 #include "sessions/clinsmanager.hpp"    /* an seq66::smanager for CLI use   */
 
 /**
@@ -124,6 +130,42 @@ main (int argc, char * argv [])
     seq66::set_app_name("seq66cli");            /* also done in smanager!!  */
 #endif
 
+    /*
+     * A batch conversion, benchmark, render, or mirror client needs no
+     * session, ports, or threads.
+     */
+
+    if (seq66::batchconvert::requested(argc, argv))
+    {
+        seq66::batchconvert bc;
+        return bc.parse(argc, argv) ? bc.run() : EXIT_FAILURE ;
+    }
+    if (seq66::playbench::requested(argc, argv))
+    {
+        seq66::playbench pb;
+        return pb.parse(argc, argv) ? pb.run() : EXIT_FAILURE ;
+    }
+    if (seq66::filebench::requested(argc, argv))
+    {
+        seq66::filebench fb;
+        return fb.parse(argc, argv) ? fb.run() : EXIT_FAILURE ;
+    }
+    if (seq66::replaybench::requested(argc, argv))
+    {
+        seq66::replaybench rb;
+        return rb.parse(argc, argv) ? rb.run() : EXIT_FAILURE ;
+    }
+    if (seq66::songrender::requested(argc, argv))
+    {
+        seq66::songrender sr;
+        return sr.parse(argc, argv) ? sr.run() : EXIT_FAILURE ;
+    }
+    if (seq66::mirrorwatch::requested(argc, argv))
+    {
+        seq66::mirrorwatch mw;
+        return mw.parse(argc, argv) ? mw.run() : EXIT_FAILURE ;
+    }
+
     if (! ishelp)
     {
         (void) seq66::cmdlineopts::parse_o_options(argc, argv);
@@ -0,0 +1,92 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          eventlist_merge.cpp
+ *
+ *  This module tests the merging of the sorted runs of an event list.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  eventlist::sort() merges a list of two to eight sorted runs in place.
+ *  An odd run left over at the end of a pass must wait for the next pass,
+ *  or it is never merged.  This test appends 2 to 8 runs, descending so
+ *  that each is its own run, sorts them, and checks the result.  Build it
+ *  against libseq66, for example:
+ *
+\verbatim
+    g++ -std=c++14 -I include -I libseq66/include \
+        contrib/code/test/eventlist_merge.cpp libseq66/src/.libs/libseq66.a
+\endverbatim
+ *
+ *  It returns 0 if all of the cases pass.
+ */
+
+#include <algorithm>                    /* std::is_sorted()                 */
+#include <cstdio>                       /* std::printf()                    */
+
+#include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+
+/**
+ *  Appends the given number of runs of two events each, with each run
+ *  earlier than the one before it, like {5,6,3,4,1,2} for three runs.
+ *
+ * \return
+ *      Returns true if the sorted list has all of the events, in order.
+ */
+
+static bool
+merge_test (int runs)
+{
+    seq66::eventlist el;
+    for (int r = runs - 1; r >= 0; --r)
+    {
+        seq66::midipulse tick = seq66::midipulse(r * 20);
+        (void) el.append(seq66::event(tick, 0x90, 60, 100));
+        (void) el.append(seq66::event(tick + 10, 0x80, 60, 0));
+    }
+    el.sort();
+
+    bool result = el.count() == runs * 2 &&
+        std::is_sorted(el.cbegin(), el.cend());
+
+    std::printf("%d runs: %s\n", runs, result ? "sorted" : "NOT SORTED");
+    return result;
+}
+
+int
+main ()
+{
+    bool ok = true;
+    for (int runs = 2; runs <= 8; ++runs)
+    {
+        if (! merge_test(runs))
+            ok = false;
+    }
+    return ok ? 0 : 1 ;
+}
+
+/*
+ * eventlist_merge.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
@@ -0,0 +1,109 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          parallel_for.cpp
+ *
+ *  This module tests the sharing of jobs over threads by parallel_for().
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Every index must be done exactly once, whether there are no jobs, fewer
+ *  jobs than threads, or many more, and with no workers to spare.  Build it
+ *  against libseq66, for example:
+ *
+\verbatim
+    g++ -std=c++14 -pthread -I include -I libseq66/include \
+        contrib/code/test/parallel_for.cpp libseq66/src/.libs/libseq66.a
+\endverbatim
+ *
+ *  It returns 0 if all of the cases pass.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstdio>                       /* std::printf()                    */
+#include <vector>                       /* std::vector<>                    */
+
+#include "util/parallel.hpp"            /* seq66::parallel_for()            */
+
+/**
+ *  Counts the calls made for each index.
+ *
+ * \return
+ *      Returns true if each index was done once.
+ */
+
+static bool
+parallel_test (std::size_t count, std::size_t workers)
+{
+    std::vector<std::atomic<int>> done(count);
+    for (auto & d : done)
+        d.store(0);
+
+    seq66::parallel_for
+    (
+        count, [&done] (std::size_t i)
+        {
+            done[i].fetch_add(1);
+        },
+        workers
+    );
+
+    bool result = true;
+    for (auto & d : done)
+    {
+        if (d.load() != 1)
+            result = false;
+    }
+    std::printf
+    (
+        "%d jobs, %d workers: %s\n", int(count), int(workers),
+        result ? "passed" : "FAILED"
+    );
+    return result;
+}
+
+int
+main ()
+{
+    static const std::size_t s_counts [] = { 0, 1, 3, 64, 10000 };
+    static const std::size_t s_workers [] = { 0, 1, 2, 8, 100 };
+    bool ok = true;
+    for (auto c : s_counts)
+    {
+        for (auto w : s_workers)
+        {
+            if (! parallel_test(c, w))
+                ok = false;
+        }
+        if (! parallel_test(c, seq66::parallel_cores()))
+            ok = false;
+    }
+    return ok ? 0 : 1 ;
+}
+
+/*
+ * parallel_for.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,199 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          statemirror_view.cpp
+ *
+ *  This module tests the state mirror through its client, the view.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A song is read into a performer that is never launched, and its state
+ *  is published by a statemirror.  A statemirror_view attaches to the
+ *  segment and must see the transport and every pattern as the performer
+ *  has them, pass the checks of "seq66cli --mirror", see a change of a
+ *  pattern a little later, and see the engine go when the mirror stops.
+ *  Run it from the top of the tree, or give it a MIDI file.  Build it
+ *  against libseq66, for example:
+ *
+\verbatim
+    g++ -std=c++14 -I include -I libseq66/include -I seq_rtmidi/include \
+        contrib/code/test/statemirror_view.cpp libseq66/src/.libs/libseq66.a
+\endverbatim
+ *
+ *  It returns 0 if all of the checks pass.
+ */
+
+#include <chrono>                       /* std::chrono::milliseconds        */
+#include <cstdio>                       /* std::printf()                    */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::this_thread::sleep_for()    */
+#include <unistd.h>                     /* ::getpid()                       */
+
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/midifile.hpp"            /* seq66::read_midi_file()          */
+#include "play/mirrorwatch.hpp"         /* seq66::mirrorwatch::check()      */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/statemirror.hpp"         /* seq66::statemirror, _view        */
+
+/**
+ *  Long enough for the mirror thread to make a few passes, including a
+ *  rescan of the status of the patterns.
+ */
+
+static const int c_settle_ms = 200;
+
+static void
+settle ()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(c_settle_ms));
+}
+
+static bool
+expect (bool ok, const char * what)
+{
+    if (! ok)
+        std::printf("FAILED: %s\n", what);
+
+    return ok;
+}
+
+/**
+ *  Compares each pattern slot of the view to the performer's pattern.
+ */
+
+static bool
+patterns_match (seq66::performer & p, const seq66::statemirror_view & view)
+{
+    bool result = true;
+    seq66::statemirror_view::pattern vp;
+    for (int s = 0; result && s < p.sequence_high(); ++s)
+    {
+        result = view.read_pattern(s, vp);
+        if (! result)
+            break;
+
+        seq66::seq::pointer sp = p.get_sequence(s);
+        if (sp)
+        {
+            seq66::sequence::snapshot snap = sp->play_snapshot();
+            std::size_t events = snap ? snap->events().size() : 0 ;
+            std::string n = sp->name().substr(0, seq66::c_shm_name_size - 1);
+            result = vp.p_info.pi_active != 0 && vp.p_name == n &&
+                vp.p_info.pi_length == sp->get_length() &&
+                vp.p_events.size() == events &&
+                vp.p_triggers.size() == sp->get_triggers().size();
+        }
+        else
+            result = vp.p_info.pi_active == 0;
+    }
+    return result;
+}
+
+int
+main (int argc, char * argv [])
+{
+    std::string fname = argc > 1 ? argv[1] : "contrib/midi/songtest.midi" ;
+    std::string name = "seq66-mirror-test-" + std::to_string(::getpid());
+    seq66::performer p
+    (
+        seq66::choose_ppqn(), seq66::usr().mainwnd_rows(),
+        seq66::usr().mainwnd_cols()
+    );
+    (void) p.get_settings(seq66::rc(), seq66::usr());
+
+    std::string errmsg;
+    bool ok = expect
+    (
+        seq66::read_midi_file(p, fname, p.ppqn(), errmsg, false),
+        "reading the song"
+    );
+
+    seq66::statemirror mirror(p, name);
+    seq66::statemirror_view view;
+    if (ok)
+        ok = expect(mirror.start(), "starting the mirror");
+
+    if (ok)
+    {
+        settle();
+        ok = expect(view.attach(name), "attaching the view");
+    }
+    if (ok)
+        ok = expect(view.engine_alive(), "the heartbeat");
+
+    if (ok)
+    {
+        seq66::shm_transport st;
+        ok = expect
+        (
+            view.read_transport(st) && st.st_ppqn == p.ppqn() &&
+                st.st_sequence_high == int(p.sequence_high()),
+            "the transport"
+        );
+    }
+    if (ok)
+        ok = expect(patterns_match(p, view), "the patterns");
+
+    if (ok)
+    {
+        seq66::mirrorwatch::summary s = seq66::mirrorwatch::check(view);
+        ok = expect
+        (
+            s.ms_errors == 0 && s.ms_patterns > 0, "the --mirror checks"
+        );
+    }
+
+    int first = 0;
+    while (ok && first < p.sequence_high() && ! p.is_seq_active(first))
+        ++first;
+
+    if (ok)
+    {
+        seq66::seq::pointer sp = p.get_sequence(first);
+        bool armed = ! sp->armed();
+        (void) sp->set_armed(armed);
+        settle();
+
+        seq66::statemirror_view::pattern vp;
+        ok = expect
+        (
+            view.read_pattern(first, vp, false) &&
+                (vp.p_info.pi_armed != 0) == armed,
+            "a change of the arming"
+        );
+    }
+    if (ok)
+    {
+        mirror.stop();
+        ok = expect(! view.engine_alive(), "the end of the engine");
+    }
+    view.detach();
+    std::printf("%s: %s\n", fname.c_str(), ok ? "passed" : "FAILED");
+    return ok ? 0 : 1 ;
+}
+
+/*
+ * statemirror_view.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
@@ -0,0 +1,132 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          wrkfile_tracks.cpp
+ *
+ *  This module tests the import of selected tracks of a WRK file.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The file is read whole, then with a track that is not in the file, and
+ *  then one track at a time, as done by "seq66cli --batch --tracks n".
+ *  The missing track gives only the patterns of the global chunks, such as
+ *  the tempo and meter, which are always read.  Each track adds at most one
+ *  pattern to those, and the tracks together add all of the other patterns
+ *  of the whole file.  Run it from the top of the tree, or give it a WRK
+ *  file.  Build it against libseq66, for example:
+ *
+\verbatim
+    g++ -std=c++14 -I include -I libseq66/include -I seq_rtmidi/include \
+        contrib/code/test/wrkfile_tracks.cpp libseq66/src/.libs/libseq66.a
+\endverbatim
+ *
+ *  It returns 0 if all of the checks pass.
+ */
+
+#include <cstdio>                       /* std::printf()                    */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/midifile.hpp"            /* seq66::read_midi_file()          */
+#include "play/performer.hpp"           /* seq66::performer                 */
+
+/**
+ *  The largest track number tried.  The test files have far fewer.
+ */
+
+static const int c_tracks_max = 256;
+
+/**
+ *  Reads the file, or some of its tracks, into the performer.
+ *
+ * \return
+ *      Returns the number of patterns read, or -1 if the read failed.
+ */
+
+static int
+pattern_count
+(
+    seq66::performer & p,
+    const std::string & fname,
+    const std::vector<int> & tracks
+)
+{
+    std::string errmsg;
+    seq66::usr().clear_global_seq_features();
+    bool ok = seq66::read_midi_file
+    (
+        p, fname, p.ppqn(), errmsg, false, tracks
+    );
+    if (! ok)
+    {
+        std::printf("%s: %s\n", fname.c_str(), errmsg.c_str());
+        return (-1);
+    }
+
+    int result = 0;
+    for (int s = 0; s < p.sequence_high(); ++s)
+    {
+        if (p.is_seq_active(s))
+            ++result;
+    }
+    return result;
+}
+
+int
+main (int argc, char * argv [])
+{
+    std::string fname = argc > 1 ? argv[1] : "data/wrk/longhair.wrk" ;
+    seq66::performer p
+    (
+        seq66::choose_ppqn(), seq66::usr().mainwnd_rows(),
+        seq66::usr().mainwnd_cols()
+    );
+    (void) p.get_settings(seq66::rc(), seq66::usr());
+
+    int whole = pattern_count(p, fname, std::vector<int>());
+    int global = pattern_count(p, fname, std::vector<int>{c_tracks_max});
+    bool ok = global >= 0 && whole > global;
+    int sum = 0;
+    for (int t = 0; ok && t < c_tracks_max; ++t)
+    {
+        int count = pattern_count(p, fname, std::vector<int>{t}) - global;
+        ok = count == 0 || count == 1;
+        sum += count;
+    }
+    if (ok)
+        ok = global + sum == whole;
+
+    std::printf
+    (
+        "%s: %d patterns, %d global, %d from single tracks: %s\n",
+        fname.c_str(), whole, global, sum, ok ? "passed" : "FAILED"
+    );
+    return ok ? 0 : 1 ;
+}
+
+/*
+ * wrkfile_tracks.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
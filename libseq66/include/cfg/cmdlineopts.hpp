@@ -27,7 +27,7 @@
  *
  * \author  Chris Ahlstrom
  * \date    2015-11-20
- * \updates 2023-12-13
+ * \updates 2026-10-14
  * \version $Revision$
  *
  *    Also see the filefunctions.cpp and strfunctions modules.
@@ -108,6 +108,7 @@ public:
     static bool parse_o_sets (const std::string & arg);
     static bool parse_o_mutes (const std::string & arg);
     static bool parse_o_virtual (const std::string & arg);
+    static bool parse_o_latency_test (const std::string & arg);
     static bool parse_log_option (int argc, char * argv []);
     static int parse_command_line_options (int argc, char * argv []);
     static std::string env_session_tag ();
@@ -28,15 +28,24 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2025-01-19
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This is actually an elegant little parser, and works well as long as one
  *  respects its limitations.
+ *
+ *  The parser used to rescan the file from its start for each section that
+ *  was looked up, and so for each variable read by get_variable(), making
+ *  the reading of a large 'ctrl' or 'playlist' file quadratic in effect.
+ *  Now the section lines are indexed in one pass when the stream is set up
+ *  (see index_sections()), and line_after() and find_tag() seek straight to
+ *  the section.  The lines within a section are still read from the stream,
+ *  as before, so the file classes see no difference.
  */
 
 #include <fstream>                      /* std::streampos                   */
 #include <string>                       /* std::string, the ubiquitous one  */
+#include <vector>                       /* std::vector<>                    */
 
 #include "util/basic_macros.hpp"        /* seq66::tokenization vector       */
 #include "util/strfunctions.hpp"        /* seq66::string_to_int()           */
@@ -87,6 +96,23 @@ class configfile
 
 private:
 
+    /**
+     *  One section-tag line of the file being parsed, as found by
+     *  index_sections().
+     */
+
+    class section
+    {
+
+    public:
+
+        std::string s_tag;              /**< The trimmed tag line.          */
+        std::streampos s_pos;           /**< The position of the tag line.  */
+        std::streampos s_next;          /**< The position of the next line. */
+        int s_line_number;              /**< The number of the tag line.    */
+
+    };
+
     /**
      *  Holds the last error message, if any.  Not a 100% foolproof yet.
      */
@@ -165,6 +191,16 @@ private:
 
     std::string m_file_version;
 
+    /**
+     *  The section lines of the file being parsed, in file order, and the
+     *  stream they were read from.  The index is used only with that stream,
+     *  and is rebuilt by index_sections() each time a file is opened for
+     *  parsing.
+     */
+
+    std::vector<section> m_sections;
+    const std::ifstream * m_indexed_file;
+
 protected:
 
     /**
@@ -293,6 +329,7 @@ public:
 protected:
 
     bool set_up_ifstream (std::ifstream & instream);
+    void index_sections (std::ifstream & file);
 
     static void append_error_message (const std::string & msg);
     static bool make_error_message
@@ -360,6 +397,33 @@ protected:
 
     std::string trimline () const;
 
+    /**
+     *  Indicates that a lookup of the tag can use the section index.  The
+     *  stream must be the one indexed, and the tag must be a section tag.
+     */
+
+    bool file_is_indexed
+    (
+        const std::ifstream & file,
+        const std::string & tag
+    ) const
+    {
+        return &file == m_indexed_file && ! tag.empty() && tag[0] == '[';
+    }
+
+    const section * find_section
+    (
+        const std::ifstream & file,
+        const std::string & tag,
+        int position
+    ) const;
+    bool seek_section
+    (
+        std::ifstream & file,
+        const std::string & tag,
+        int position
+    );
+
     /**
      *  Provides a pointer to the input string in a form that sscanf() can use.
      *
@@ -383,6 +447,8 @@ protected:
     int find_tag (std::ifstream & file, const std::string & tag);
     int get_tag_value (const std::string & tag);
     void write_date (std::ofstream & file, const std::string & tag);
+    std::string write_name () const;
+    bool finish_write (std::ofstream & file, bool ok);
     bool next_data_line (std::ifstream & file, bool strip = true);
     bool next_section (std::ifstream & file, const std::string & tag);
     std::string get_variable
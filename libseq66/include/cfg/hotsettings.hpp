@@ -0,0 +1,183 @@
+#if ! defined SEQ66_HOTSETTINGS_HPP
+#define SEQ66_HOTSETTINGS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          hotsettings.hpp
+ *
+ *  This module declares the copy of the settings read by the real-time
+ *  threads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The output, input, and JACK process threads used to call rc() for a few
+ *  settings in their loops, including lookups of the thru-route and
+ *  input-latency std::maps, which the options dialog (or the reset of the
+ *  whole rcsettings object on Cancel) could be changing at the same time.
+ *  Now those settings are copied, by publish_hot_settings(), into this
+ *  small object, whose members are atomics read with relaxed ordering,
+ *  which costs no more than a plain load.  Each setting is independent of
+ *  the others, so no lock or versioning is needed to keep them consistent.
+ *
+ *  Call publish_hot_settings() after the 'rc' settings change:
+ *  the performer does it in get_settings(), and the options dialog does it
+ *  when an item is modified.
+ */
+
+#include <array>                        /* std::array<>                     */
+#include <atomic>                       /* std::atomic<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::c_busscount_max           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class rcsettings;
+
+/**
+ *  The settings used by the real-time threads.  Aligned to a cache line, so
+ *  that it shares none with data written often.
+ */
+
+class alignas(64) hotsettings
+{
+
+private:
+
+    std::atomic<bool> m_verbose;            /**< rcsettings::verbose().     */
+    std::atomic<bool> m_investigate;        /**< rcsettings::investigate(). */
+    std::atomic<bool> m_rt_safe;            /**< rcsettings::rt_safe().     */
+    std::atomic<bool> m_midi_clock_follow;  /**< Follow the MIDI clock.     */
+    std::atomic<int> m_sysex_rate;          /**< rcsettings::sysex_rate().  */
+
+    /**
+     *  The thru-route output buss of each input buss, or -1, the input
+     *  latency of each input buss in microseconds, and the bandwidth of
+     *  each output buss in bytes per second, or 0.  Busses past the end of
+     *  these arrays have no route, no latency, and no pacing.
+     */
+
+    std::array<std::atomic<int>, c_busscount_max> m_thru_routes;
+    std::array<std::atomic<int>, c_busscount_max> m_input_latencies;
+    std::array<std::atomic<int>, c_busscount_max> m_output_bandwidths;
+
+public:
+
+    hotsettings ();
+    hotsettings (const hotsettings &) = delete;
+    hotsettings & operator = (const hotsettings &) = delete;
+
+    void publish (const rcsettings & rcs);
+
+    bool verbose () const
+    {
+        return m_verbose.load(std::memory_order_relaxed);
+    }
+
+    bool investigate () const
+    {
+        return m_investigate.load(std::memory_order_relaxed);
+    }
+
+    bool rt_safe () const
+    {
+        return m_rt_safe.load(std::memory_order_relaxed);
+    }
+
+    bool midi_clock_follow () const
+    {
+        return m_midi_clock_follow.load(std::memory_order_relaxed);
+    }
+
+    int sysex_rate () const
+    {
+        return m_sysex_rate.load(std::memory_order_relaxed);
+    }
+
+    int thru_route (int inbus) const
+    {
+        return in_range(inbus) ?
+            m_thru_routes[inbus].load(std::memory_order_relaxed) : (-1) ;
+    }
+
+    bool thru_routed (int inbus) const
+    {
+        return thru_route(inbus) >= 0;
+    }
+
+    int input_latency_us (int inbus) const
+    {
+        return in_range(inbus) ?
+            m_input_latencies[inbus].load(std::memory_order_relaxed) : 0 ;
+    }
+
+    int output_bandwidth (int outbus) const
+    {
+        return in_range(outbus) ?
+            m_output_bandwidths[outbus].load(std::memory_order_relaxed) : 0 ;
+    }
+
+    void input_latency_us (int inbus, int us)
+    {
+        if (in_range(inbus))
+        {
+            m_input_latencies[inbus].store
+            (
+                us > 0 ? us : 0, std::memory_order_relaxed
+            );
+        }
+    }
+
+private:
+
+    static bool in_range (int inbus)
+    {
+        return inbus >= 0 && inbus < c_busscount_max;
+    }
+
+};          // class hotsettings
+
+/*
+ *  Free functions for the global hotsettings object, in the manner of rc()
+ *  and usr().
+ */
+
+extern const hotsettings & hot ();
+extern void publish_hot_settings ();
+extern void publish_input_latency (int inbus, int us);
+
+}           // namespace seq66
+
+#endif      // SEQ66_HOTSETTINGS_HPP
+
+/*
+ * hotsettings.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-13
- * \updates       2022-07-22
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -198,6 +198,7 @@ private:
     );
     bool parse_control_stanza (automation::category opcat, int index = 0);
     bool parse_midi_control_out (std::ifstream & file);
+    void parse_pad_control (std::ifstream & file);
     bool add_default_automation_stanzas (int count);
     void show_stanza (const stanza & stan) const;
     bussbyte get_buss_number
@@ -222,6 +223,7 @@ private:
 
     bool write_midi_control (std::ofstream & file);
     bool write_midi_control_out (std::ofstream & file);
+    bool write_pad_control (std::ofstream & file);
     bool read_triples
     (
         std::ifstream & file,
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2025-01-18
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This collection of variables describes the options of the application,
@@ -55,9 +55,7 @@
  *  on configuration file-extensions in copying and deleting a configuration.
  */
 
-#if defined SEQ66_KEEP_RC_FILE_LIST
 #include <map>                          /* std::map class                   */
-#endif
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -73,6 +71,85 @@ namespace seq66
 
 static const int c_thread_priority = 10;
 
+/**
+ *  The largest ALSA queue lookahead, in milliseconds, that is accepted for
+ *  the "alsa-lookahead" option.  Zero means direct (immediate) delivery.
+ */
+
+const int c_alsa_lookahead_max  = 50;
+
+/**
+ *  The largest PortMidi output latency, in milliseconds, that is accepted
+ *  for the "portmidi-latency" option.  Zero means immediate delivery, with
+ *  the timestamps ignored.
+ */
+
+const int c_portmidi_latency_max = 50;
+
+/**
+ *  The SysEx output rate, in bytes per second, used for "sysex-rate" by
+ *  default:  that of a MIDI cable, 31250 baud at 10 bits a byte.  And the
+ *  largest rate accepted.  Zero means no limit.
+ */
+
+const int c_sysex_rate_default = 3125;
+const int c_sysex_rate_max = 1000000;
+
+/**
+ *  The size, in messages, of the ring-buffer of each JACK port, for the
+ *  "jack-ringbuffer" option, and its limits.  It is rounded up to a power
+ *  of two.
+ */
+
+const int c_jack_ringbuffer_default = 2048;
+const int c_jack_ringbuffer_min = 64;
+const int c_jack_ringbuffer_max = 65536;
+
+/**
+ *  The largest number of extra output-worker threads accepted for the
+ *  "output-workers" option.  Zero means that patterns are played serially
+ *  by the output thread.
+ */
+
+const int c_output_workers_max  = 16;
+
+/**
+ *  The longest interval, in seconds, accepted for the "output-stats"
+ *  option, which logs the output timing statistics periodically.  Zero
+ *  disables the log line.
+ */
+
+const int c_output_stats_max    = 3600;
+
+/**
+ *  The range of the UDP ports of the "metrics-port" and "osc-control-port"
+ *  options, which serve the engine metrics and take controls over OSC.
+ *  Zero disables the server.
+ */
+
+const int c_osc_port_min        = 1024;
+const int c_osc_port_max        = 65535;
+
+/**
+ *  The number of beats over which Ableton Link aligns the phase, for the
+ *  "link-quantum" option, and its limits.  Usually one bar.
+ */
+
+const int c_link_quantum_default = 4;
+const int c_link_quantum_min    = 1;
+const int c_link_quantum_max    = 16;
+
+/**
+ *  The local AppleMIDI control port of the "rtp-midi-port" option (the data
+ *  port is the next one), and the largest lookahead, in milliseconds, of
+ *  "rtp-midi-lookahead", which timestamps each network event that far
+ *  ahead.
+ */
+
+const int c_rtp_midi_port_default = 5004;
+const int c_rtp_midi_lookahead_default = 10;
+const int c_rtp_midi_lookahead_max = 50;
+
 /**
  *  These control sizes.  We'll try changing them and see what happens.
  *  Increasing these value spreads out the pattern grids a little bit and
@@ -216,6 +293,38 @@ public:
         max             /**< Keep this last... a size value.                */
     };
 
+    /**
+     *  Selects how the performer's output thread waits between frames.
+     *  The legacy method wakes every "trigger width" and uses microsleep().
+     *  The deadline method calculates the time of the next event or clock
+     *  pulse and sleeps until that absolute time.  The JACK method hands
+     *  playback to the JACK MIDI process callback, which plays each cycle
+     *  and writes the events at their frame offsets.
+     */
+
+    enum class scheduler
+    {
+        microsleep,     /**< Fixed wake-up interval, relative sleeping.     */
+        deadline,       /**< Sleep until next event/clock absolute time.    */
+        jack,           /**< The JACK process cycle drives the playback.    */
+        max             /**< Keep this last... a size value.                */
+    };
+
+    /**
+     *  The part this instance plays in a mirrored pair of machines, for a
+     *  hot spare.  The primary streams its controls and transport to the
+     *  replica, which follows them with its output silenced, and takes over
+     *  the output if the primary goes quiet.
+     */
+
+    enum class mirrorrole
+    {
+        none,           /**< No mirroring, the normal case.                 */
+        primary,        /**< Plays, and sends its state to the replica.     */
+        replica,        /**< Follows the primary, and stands by.            */
+        max             /**< Keep this last... a size value.                */
+    };
+
 #if defined SEQ66_KEEP_RC_FILE_LIST
 
     /**
@@ -257,6 +366,47 @@ private:
 
     inputslist m_inputs;
 
+    /**
+     *  The MIDI thru routes, from the [midi-thru] section, each from an input
+     *  buss to an output buss.  Events from a routed input are sent to the
+     *  output by the MIDI engine as they arrive, before the performer sees
+     *  them, and the thru of the recording pattern skips them.
+     */
+
+    std::map<int, int> m_thru_routes;
+
+    /**
+     *  The recording latencies, from the [midi-input-latency] section, each
+     *  an input buss and the microseconds by which its recorded events are
+     *  moved earlier.  Busses not listed have none.
+     */
+
+    std::map<int, int> m_input_latencies;
+
+    /**
+     *  The output filters, from the [midi-output-filter] section, each the
+     *  text stages (see the outputfilter class) of an output buss.  They
+     *  are given to the busses as they are created.
+     */
+
+    std::map<int, std::string> m_output_filters;
+
+    /**
+     *  The input filters, from the [midi-input-filter] section, each the
+     *  text stages (see the inputfilter class) of an input buss.
+     */
+
+    std::map<int, std::string> m_input_filters;
+
+    /**
+     *  The output bandwidths, from the [midi-output-bandwidth] section, each
+     *  an output buss and the bytes per second its interface can carry,
+     *  such as 3125 for a 5-pin DIN port.  The events of a frame for such
+     *  a buss are paced (see framebatch).  Busses not listed are not paced.
+     */
+
+    std::map<int, int> m_output_bandwidths;
+
     /**
      *  Settings for the metronome.
      */
@@ -330,20 +480,36 @@ private:
 
     bool m_save_old_triggers;       /**< Save c_triggers_ex, no transpose.  */
     bool m_save_old_mutes;          /**< Save mutes as bytes, not longs.    */
+    bool m_save_in_background;      /**< Session saves write in a thread.   */
+    int m_journal_interval;         /**< Seconds between journal writes.    */
     bool m_allow_mod4_mode;         /**< Allow Mod4 to hold drawing mode.   */
     bool m_allow_snap_split;        /**< Allow snap-split of a trigger.     */
     bool m_allow_click_edit;        /**< Allow double-click edit pattern.   */
     bool m_show_midi;               /**< Show MIDI events to console.       */
     bool m_priority;                /**< Run at high priority (Linux only). */
     int m_thread_priority;          /**< The desired priority (Linux only). */
+    bool m_rt_safe;                 /**< Lock memory, check RT allocations. */
+    std::string m_output_policy;    /**< Output "fifo", "rr", or "other".   */
+    int m_output_priority;          /**< Output priority, 0 = 'priority'.   */
+    std::string m_output_cpus;      /**< Output thread CPU list, e.g. "2".  */
+    std::string m_input_policy;     /**< Input "fifo", "rr", or "other".    */
+    int m_input_priority;           /**< Input priority, 0 = 'priority'.    */
+    std::string m_input_cpus;       /**< Input thread CPU list.             */
+    std::string m_worker_cpus;      /**< Output-worker CPUs, one each.      */
     bool m_pass_sysex;              /**< Pass SysEx to outputs, not ready.  */
     bool m_with_jack_transport;     /**< Enable synchrony with JACK.        */
     bool m_with_jack_master;        /**< Serve as a JACK transport Master.  */
     bool m_with_jack_master_cond;   /**< Serve as JACK Master if possible.  */
     bool m_with_jack_midi;          /**< Use JACK MIDI.                     */
     bool m_with_alsa_midi;          /**< Use ALSA MIDI.                     */
+    bool m_with_null_midi;          /**< Use the null (no-device) MIDI API. */
+    std::string m_last_midi_api;    /**< The MIDI API found at the last run.*/
+    bool m_null_midi_loopback;      /**< Null MIDI output loops to input.   */
+    std::string m_session_log;      /**< Control-input log file, or none.   */
     bool m_jack_auto_connect;       /**< Connect JACK ports in normal mode. */
+    bool m_jack_lazy_connect;       /**< Make JACK connections in the back. */
     bool m_jack_use_offset;         /**< Try to calculate output offset.    */
+    bool m_jack_period_sync;        /**< Transport tick from each period.   */
     int m_jack_buffer_size;         /**< The desired power-of-2 size, or 0. */
     sequence::playback m_song_start_mode; /**< Song mode versus Live mode.  */
     bool m_song_start_is_auto;      /**< True if "auto" read from 'rc'.     */
@@ -358,6 +524,29 @@ private:
     bool m_print_keys;              /**< Show hot-key in main window slot.  */
     interaction m_interaction_method; /**< Interaction method: no support.  */
     setsmode m_sets_mode;           /**< How to handle set changes.         */
+    scheduler m_output_scheduler;   /**< How the output thread waits.       */
+    int m_alsa_lookahead_ms;        /**< ALSA queue lookahead, 0 = direct.  */
+    int m_portmidi_latency_ms;      /**< PortMidi latency, 0 = immediate.   */
+    int m_latency_probe_out;        /**< Probe click output buss, -1 = off. */
+    int m_latency_probe_in;         /**< Probe click input buss.            */
+    int m_latency_test_clicks;      /**< Clicks of a latency test, 0 = off. */
+    int m_sysex_rate;               /**< SysEx output bytes/s, 0 = no limit.*/
+    int m_jack_ringbuffer_size;     /**< Messages per JACK port buffer.     */
+    int m_output_workers;           /**< Pattern-playing threads, 0 = none. */
+    int m_output_stats_s;           /**< Timing-statistics log, 0 = none.   */
+    bool m_midi_clock_follow;       /**< Smooth incoming MIDI clock.        */
+    std::string m_input_capture;    /**< Input-capture directory, or none.  */
+    int m_metrics_port;             /**< OSC metrics UDP port, 0 = none.    */
+    int m_osc_control_port;         /**< OSC control UDP port, 0 = none.    */
+    bool m_link_sync;               /**< Join an Ableton Link session.      */
+    int m_link_quantum;             /**< Link phase quantum, in beats.      */
+    mirrorrole m_mirror_role;       /**< Primary or replica, or neither.    */
+    std::string m_mirror_host;      /**< The replica's host, for a primary. */
+    int m_mirror_port;              /**< The replica's UDP port, 0 = none.  */
+    std::string m_rtp_midi_peers;   /**< RTP-MIDI peers, "host[:port] ...". */
+    int m_rtp_midi_port;            /**< Local AppleMIDI control port.      */
+    int m_rtp_midi_lookahead_ms;    /**< RTP-MIDI timestamp lookahead.      */
+    std::string m_state_mirror;     /**< Shared-memory state, "" = none.    */
     portname m_port_naming;         /**< How to display port names.         */
 
     /**
@@ -702,6 +891,125 @@ public:
         return m_inputs;
     }
 
+    const std::map<int, int> & thru_routes () const
+    {
+        return m_thru_routes;
+    }
+
+    int thru_route (int inbus) const
+    {
+        auto it = m_thru_routes.find(inbus);
+        return it != m_thru_routes.end() ? it->second : (-1) ;
+    }
+
+    bool thru_routed (int inbus) const
+    {
+        return m_thru_routes.find(inbus) != m_thru_routes.end();
+    }
+
+    void thru_route (int inbus, int outbus)
+    {
+        if (inbus >= 0 && outbus >= 0)
+            m_thru_routes[inbus] = outbus;
+    }
+
+    void clear_thru_routes ()
+    {
+        m_thru_routes.clear();
+    }
+
+    const std::map<int, int> & input_latencies () const
+    {
+        return m_input_latencies;
+    }
+
+    int input_latency_us (int inbus) const
+    {
+        auto it = m_input_latencies.find(inbus);
+        return it != m_input_latencies.end() ? it->second : 0 ;
+    }
+
+    void input_latency_us (int inbus, int us)
+    {
+        if (inbus >= 0 && us > 0)
+            m_input_latencies[inbus] = us;
+        else
+            m_input_latencies.erase(inbus);
+    }
+
+    void clear_input_latencies ()
+    {
+        m_input_latencies.clear();
+    }
+
+    const std::map<int, int> & output_bandwidths () const
+    {
+        return m_output_bandwidths;
+    }
+
+    int output_bandwidth (int outbus) const
+    {
+        auto it = m_output_bandwidths.find(outbus);
+        return it != m_output_bandwidths.end() ? it->second : 0 ;
+    }
+
+    void output_bandwidth (int outbus, int bytespersec)
+    {
+        if (outbus >= 0 && bytespersec > 0)
+            m_output_bandwidths[outbus] = bytespersec;
+        else
+            m_output_bandwidths.erase(outbus);
+    }
+
+    void clear_output_bandwidths ()
+    {
+        m_output_bandwidths.clear();
+    }
+
+    const std::map<int, std::string> & output_filters () const
+    {
+        return m_output_filters;
+    }
+
+    std::string output_filter (int outbus) const
+    {
+        auto it = m_output_filters.find(outbus);
+        return it != m_output_filters.end() ? it->second : std::string("") ;
+    }
+
+    void output_filter (int outbus, const std::string & spec)
+    {
+        if (outbus >= 0 && ! spec.empty())
+            m_output_filters[outbus] = spec;
+    }
+
+    void clear_output_filters ()
+    {
+        m_output_filters.clear();
+    }
+
+    const std::map<int, std::string> & input_filters () const
+    {
+        return m_input_filters;
+    }
+
+    std::string input_filter (int inbus) const
+    {
+        auto it = m_input_filters.find(inbus);
+        return it != m_input_filters.end() ? it->second : std::string("") ;
+    }
+
+    void input_filter (int inbus, const std::string & spec)
+    {
+        if (inbus >= 0 && ! spec.empty())
+            m_input_filters[inbus] = spec;
+    }
+
+    void clear_input_filters ()
+    {
+        m_input_filters.clear();
+    }
+
     metrosettings & metro_settings ()
     {
         return m_metro_settings;
@@ -856,6 +1164,16 @@ public:
         return m_save_old_mutes;
     }
 
+    bool save_in_background () const
+    {
+        return m_save_in_background;
+    }
+
+    int journal_interval () const
+    {
+        return m_journal_interval;
+    }
+
     bool allow_mod4_mode () const
     {
         return m_allow_mod4_mode;
@@ -886,6 +1204,46 @@ public:
         return m_thread_priority;
     }
 
+    bool rt_safe () const
+    {
+        return m_rt_safe;
+    }
+
+    const std::string & output_policy () const
+    {
+        return m_output_policy;
+    }
+
+    int output_priority () const
+    {
+        return m_output_priority;
+    }
+
+    const std::string & output_cpus () const
+    {
+        return m_output_cpus;
+    }
+
+    const std::string & input_policy () const
+    {
+        return m_input_policy;
+    }
+
+    int input_priority () const
+    {
+        return m_input_priority;
+    }
+
+    const std::string & input_cpus () const
+    {
+        return m_input_cpus;
+    }
+
+    const std::string & worker_cpus () const
+    {
+        return m_worker_cpus;
+    }
+
     bool pass_sysex () const
     {
         return m_pass_sysex;
@@ -911,11 +1269,31 @@ public:
         return m_with_jack_midi;
     }
 
+    const std::string & last_midi_api () const
+    {
+        return m_last_midi_api;
+    }
+
     bool with_alsa_midi () const
     {
         return m_with_alsa_midi;
     }
 
+    bool with_null_midi () const
+    {
+        return m_with_null_midi;
+    }
+
+    bool null_midi_loopback () const
+    {
+        return m_null_midi_loopback;
+    }
+
+    const std::string & session_log () const
+    {
+        return m_session_log;
+    }
+
     bool with_port_midi () const
     {
 #if defined SEQ66_PORTMIDI_SUPPORT
@@ -932,11 +1310,21 @@ public:
         return m_jack_auto_connect;
     }
 
+    bool jack_lazy_connect () const
+    {
+        return m_jack_lazy_connect;
+    }
+
     bool jack_use_offset () const
     {
         return m_jack_use_offset;
     }
 
+    bool jack_period_sync () const
+    {
+        return m_jack_period_sync;
+    }
+
     int jack_buffer_size () const
     {
         return m_jack_buffer_size;
@@ -989,21 +1377,51 @@ public:
         m_with_jack_midi = flag;
     }
 
+    void last_midi_api (const std::string & name)
+    {
+        m_last_midi_api = name;
+    }
+
     void with_alsa_midi (bool flag)
     {
         m_with_alsa_midi = flag;
     }
 
+    void with_null_midi (bool flag)
+    {
+        m_with_null_midi = flag;
+    }
+
+    void null_midi_loopback (bool flag)
+    {
+        m_null_midi_loopback = flag;
+    }
+
+    void session_log (const std::string & filename)
+    {
+        m_session_log = filename;
+    }
+
     void jack_auto_connect (bool flag)
     {
         m_jack_auto_connect = flag;
     }
 
+    void jack_lazy_connect (bool flag)
+    {
+        m_jack_lazy_connect = flag;
+    }
+
     void jack_use_offset (bool flag)
     {
         m_jack_use_offset = flag;
     }
 
+    void jack_period_sync (bool flag)
+    {
+        m_jack_period_sync = flag;
+    }
+
     /*
      * This check is the same as is_power_of_2() in the calculations module.
      */
@@ -1117,6 +1535,166 @@ public:
     std::string sets_mode_string () const;
     std::string sets_mode_string (setsmode v) const;
 
+    scheduler output_scheduler () const
+    {
+        return m_output_scheduler;
+    }
+
+    bool is_scheduler_deadline () const
+    {
+        return m_output_scheduler == scheduler::deadline;
+    }
+
+    bool is_scheduler_jack () const
+    {
+        return m_output_scheduler == scheduler::jack;
+    }
+
+    std::string output_scheduler_string () const;
+    std::string output_scheduler_string (scheduler v) const;
+
+    int alsa_lookahead_ms () const
+    {
+        return m_alsa_lookahead_ms;
+    }
+
+    int portmidi_latency_ms () const
+    {
+        return m_portmidi_latency_ms;
+    }
+
+    int latency_probe_out () const
+    {
+        return m_latency_probe_out;
+    }
+
+    int latency_probe_in () const
+    {
+        return m_latency_probe_in;
+    }
+
+    /**
+     *  A latency test, from the seq66cli "-o latency-test" option, runs the
+     *  probe with this many clicks, reports the round trips, and exits.
+     *  It is not saved.
+     */
+
+    int latency_test_clicks () const
+    {
+        return m_latency_test_clicks;
+    }
+
+    bool latency_test () const
+    {
+        return m_latency_test_clicks > 0;
+    }
+
+    int sysex_rate () const
+    {
+        return m_sysex_rate;
+    }
+
+    int jack_ringbuffer_size () const
+    {
+        return m_jack_ringbuffer_size;
+    }
+
+    bool latency_probe () const
+    {
+        return m_latency_probe_out >= 0 && m_latency_probe_in >= 0;
+    }
+
+    int output_workers () const
+    {
+        return m_output_workers;
+    }
+
+    int output_stats_s () const
+    {
+        return m_output_stats_s;
+    }
+
+    bool midi_clock_follow () const
+    {
+        return m_midi_clock_follow;
+    }
+
+    const std::string & input_capture () const
+    {
+        return m_input_capture;
+    }
+
+    std::string input_capture_directory () const;
+    std::string session_log_filename () const;
+
+    int metrics_port () const
+    {
+        return m_metrics_port;
+    }
+
+    int osc_control_port () const
+    {
+        return m_osc_control_port;
+    }
+
+    bool link_sync () const
+    {
+        return m_link_sync;
+    }
+
+    int link_quantum () const
+    {
+        return m_link_quantum;
+    }
+
+    mirrorrole mirror_role () const
+    {
+        return m_mirror_role;
+    }
+
+    bool is_mirror_primary () const
+    {
+        return m_mirror_role == mirrorrole::primary && m_mirror_port > 0;
+    }
+
+    bool is_mirror_replica () const
+    {
+        return m_mirror_role == mirrorrole::replica && m_mirror_port > 0;
+    }
+
+    std::string mirror_role_string () const;
+    std::string mirror_role_string (mirrorrole v) const;
+
+    const std::string & mirror_host () const
+    {
+        return m_mirror_host;
+    }
+
+    int mirror_port () const
+    {
+        return m_mirror_port;
+    }
+
+    const std::string & rtp_midi_peers () const
+    {
+        return m_rtp_midi_peers;
+    }
+
+    int rtp_midi_port () const
+    {
+        return m_rtp_midi_port;
+    }
+
+    int rtp_midi_lookahead_ms () const
+    {
+        return m_rtp_midi_lookahead_ms;
+    }
+
+    const std::string & state_mirror () const
+    {
+        return m_state_mirror;
+    }
+
     portname port_naming () const
     {
         return m_port_naming;
@@ -1452,6 +2030,16 @@ public:
         m_save_old_mutes = flag;
     }
 
+    void save_in_background (bool flag)
+    {
+        m_save_in_background = flag;
+    }
+
+    void journal_interval (int seconds)
+    {
+        m_journal_interval = seconds > 0 ? seconds : 0 ;
+    }
+
     void allow_mod4_mode (bool /*flag*/)
     {
         m_allow_mod4_mode = false;
@@ -1485,6 +2073,51 @@ public:
         m_thread_priority = p;
     }
 
+    void rt_safe (bool flag)
+    {
+        m_rt_safe = flag;
+    }
+
+    void output_policy (const std::string & v)
+    {
+        m_output_policy = thread_policy(v);
+    }
+
+    void output_priority (int p)
+    {
+        if (p >= 0 && p <= 99)
+            m_output_priority = p;
+    }
+
+    void output_cpus (const std::string & v)
+    {
+        m_output_cpus = cpu_list(v);
+    }
+
+    void input_policy (const std::string & v)
+    {
+        m_input_policy = thread_policy(v);
+    }
+
+    void input_priority (int p)
+    {
+        if (p >= 0 && p <= 99)
+            m_input_priority = p;
+    }
+
+    void input_cpus (const std::string & v)
+    {
+        m_input_cpus = cpu_list(v);
+    }
+
+    void worker_cpus (const std::string & v)
+    {
+        m_worker_cpus = cpu_list(v);
+    }
+
+    static std::string thread_policy (const std::string & v);
+    static std::string cpu_list (const std::string & v);
+
     void pass_sysex (bool flag)
     {
         m_pass_sysex = flag;
@@ -1617,6 +2250,129 @@ public:
     }
 
     void sets_mode (const std::string & v);
+
+    void output_scheduler (scheduler s)
+    {
+        m_output_scheduler = s;
+    }
+
+    void output_scheduler (const std::string & v);
+
+    void alsa_lookahead_ms (int ms)
+    {
+        if (ms >= 0 && ms <= c_alsa_lookahead_max)
+            m_alsa_lookahead_ms = ms;
+    }
+
+    void portmidi_latency_ms (int ms)
+    {
+        if (ms >= 0 && ms <= c_portmidi_latency_max)
+            m_portmidi_latency_ms = ms;
+    }
+
+    void sysex_rate (int rate)
+    {
+        if (rate >= 0 && rate <= c_sysex_rate_max)
+            m_sysex_rate = rate;
+    }
+
+    void jack_ringbuffer_size (int count)
+    {
+        if (count >= c_jack_ringbuffer_min && count <= c_jack_ringbuffer_max)
+            m_jack_ringbuffer_size = count;
+    }
+
+    void latency_probe (int outbus, int inbus)
+    {
+        bool ok = outbus >= 0 && outbus < c_busscount_max &&
+            inbus >= 0 && inbus < c_busscount_max;
+
+        m_latency_probe_out = ok ? outbus : (-1) ;
+        m_latency_probe_in = ok ? inbus : (-1) ;
+    }
+
+    void latency_test_clicks (int count)
+    {
+        m_latency_test_clicks = count > 0 ? count : 0 ;
+    }
+
+    void output_workers (int count)
+    {
+        if (count >= 0 && count <= c_output_workers_max)
+            m_output_workers = count;
+    }
+
+    void output_stats_s (int seconds)
+    {
+        if (seconds >= 0 && seconds <= c_output_stats_max)
+            m_output_stats_s = seconds;
+    }
+
+    void midi_clock_follow (bool flag)
+    {
+        m_midi_clock_follow = flag;
+    }
+
+    void input_capture (const std::string & v);
+
+    void metrics_port (int port)
+    {
+        bool ok = port >= c_osc_port_min && port <= c_osc_port_max;
+        if (ok || port == 0)
+            m_metrics_port = port;
+    }
+
+    void osc_control_port (int port)
+    {
+        bool ok = port >= c_osc_port_min && port <= c_osc_port_max;
+        if (ok || port == 0)
+            m_osc_control_port = port;
+    }
+
+    void link_sync (bool flag)
+    {
+        m_link_sync = flag;
+    }
+
+    void link_quantum (int beats)
+    {
+        if (beats >= c_link_quantum_min && beats <= c_link_quantum_max)
+            m_link_quantum = beats;
+    }
+
+    void mirror_role (const std::string & v);
+
+    void mirror_host (const std::string & host)
+    {
+        m_mirror_host = host.empty() ? std::string("localhost") : host ;
+    }
+
+    void mirror_port (int port)
+    {
+        bool ok = port >= c_osc_port_min && port <= c_osc_port_max;
+        if (ok || port == 0)
+            m_mirror_port = port;
+    }
+
+    void rtp_midi_peers (const std::string & peers)
+    {
+        m_rtp_midi_peers = peers;
+    }
+
+    void rtp_midi_port (int port)
+    {
+        if (port >= c_osc_port_min && port < c_osc_port_max)
+            m_rtp_midi_port = port;                 /* the data port is +1  */
+    }
+
+    void rtp_midi_lookahead_ms (int ms)
+    {
+        if (ms >= 0 && ms <= c_rtp_midi_lookahead_max)
+            m_rtp_midi_lookahead_ms = ms;
+    }
+
+    void state_mirror (const std::string & name);
+
     void port_naming (const std::string & v);
 
     /*
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2023-05-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  These values were moved from the Seq64 globals module.  Includes the
@@ -196,8 +196,8 @@ extern bool chord_number_valid (int number);
 extern const char * chord_name_ptr (int number);
 extern const chord_notes & chord_entry (int number);
 extern bool scales_policy (scales s, int k);
-extern const int * scales_up (int scale, int key = 0);
-extern const int * scales_down (int scale, int key = 0);
+extern bool scales_policy (scales s, int key, int note);
+extern int harmonic_transpose (int scale, int key, int note, int steps);
 extern double midi_note_frequency (midibyte note);
 extern int analyze_notes
 (
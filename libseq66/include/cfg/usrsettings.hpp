@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2024-12-01
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module defines the following categories of "global" variables that
@@ -118,6 +118,15 @@ const int c_use_default_ppqn = (-1);
 
 const int c_use_file_ppqn = 0;
 
+/**
+ *  Provides the default and maximum amount of undo/redo history kept for
+ *  each pattern, in megabytes.  A setting of 0 removes the limit.  See
+ *  the eventstack class.
+ */
+
+const int c_undo_limit_default = 64;
+const int c_undo_limit_max = 4096;
+
 /**
  *  Provides settings for tempo recording.  Currently not used, though the
  *  functionality of logging and recording tempo is in place.
@@ -525,6 +534,14 @@ private:
 
     int m_window_redraw_rate_ms;
 
+    /**
+     *  If true (the default is false), the piano roll and the song editor
+     *  are drawn by the GPU, via OpenGL, if the build supports it.  See the
+     *  qglroll class.
+     */
+
+    bool m_gpu_rendering;
+
     /**
      *  Constants for the mainwnd class.  The m_seqchars_x and
      *  m_seqchars_y constants help define the "seqarea" size.  These look
@@ -1005,6 +1022,14 @@ private:
 
     bool m_pattern_wraparound;
 
+    /**
+     *  The maximum memory, in megabytes, used by the undo and the redo
+     *  history of each pattern.  The oldest history is dropped to stay
+     *  within it.  0 means no limit.
+     */
+
+    int m_undo_limit;
+
     /**
      *  Normal (none = no alteration), tighten, quantize, or note-map (jitter
      *  and random are not supported during recording at this time).
@@ -1439,6 +1464,11 @@ public:
         return m_window_redraw_rate_ms;
     }
 
+    bool gpu_rendering () const
+    {
+        return m_gpu_rendering;
+    }
+
 protected:
 
     bool test_option_bit (int b)
@@ -1882,6 +1912,11 @@ public:
         return m_pattern_wraparound;
     }
 
+    int undo_limit () const
+    {
+        return m_undo_limit;
+    }
+
     std::string pattern_record_string () const;
 
     /*
@@ -1964,6 +1999,11 @@ public:         // used in main application module and the usrfile class
         m_progress_bar_thick = flag;
     }
 
+    void gpu_rendering (bool flag)
+    {
+        m_gpu_rendering = flag;
+    }
+
     void progress_bar_thickness (int t)
     {
         m_progress_bar_thickness = t;
@@ -2144,6 +2184,12 @@ public:         // used in main application module and the usrfile class
         m_pattern_wraparound = flag;
     }
 
+    void undo_limit (int mb)
+    {
+        if (mb >= 0 && mb <= c_undo_limit_max)
+            m_undo_limit = mb;
+    }
+
     void grid_mode (gridmode mode)
     {
         m_grid_mode = mode;
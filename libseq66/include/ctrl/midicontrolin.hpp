@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2024-01-01
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This container holds a map of midicontrol objects keyed by a key ordinal
@@ -37,12 +37,15 @@
  *  It requires C++11 and above.
  */
 
+#include <bitset>                       /* std::bitset<> status bitmap      */
 #include <map>                          /* std::map<> and multimap<>        */
 #include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<> for lookup table   */
 
 #include "cfg/comments.hpp"             /* seq66::comments class            */
 #include "ctrl/midicontrol.hpp"         /* seq66::midicontrol event item    */
 #include "ctrl/midicontrolbase.hpp"     /* seq66::midicontrolbase class     */
+#include "ctrl/padmap.hpp"              /* seq66::padmap drum-pad table     */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -116,11 +119,40 @@ private:
 
     bool m_have_controls;
 
+    /**
+     *  A dense lookup table for channel messages (status 0x80 to 0xEF),
+     *  indexed by the status byte (which includes the channel) and d0.  Each
+     *  entry points to the control that m_container.find() returns for that
+     *  key, or is null.  This makes control() a single array access for the
+     *  stream of CC and note events a control surface sends.  It is filled
+     *  by add(), and rebuilt on copy, as it points into m_container.  Other
+     *  statuses fall back to the multimap.
+     */
+
+    std::vector<const midicontrol *> m_lookup;
+
+    /**
+     *  One bit for each status byte (channel included) used by any control
+     *  in the container.  It lets performer::midi_control_event() skip the
+     *  lookup entirely for the notes and aftertouch being recorded, which are
+     *  rarely bound to controls.
+     */
+
+    std::bitset<256> m_bound_statuses;
+
+    /**
+     *  The drum pads, from the [pad-control] section of the 'ctrl' file.
+     *  The pads are not controls, and are not in the container; they are
+     *  checked by performer::pad_event() before the controls are.
+     */
+
+    padmap m_pad_map;
+
 public:
 
     midicontrolin (const std::string & name);
-    midicontrolin (const midicontrolin &) = default;
-    midicontrolin & operator = (const midicontrolin &) = default;
+    midicontrolin (const midicontrolin & rhs);
+    midicontrolin & operator = (const midicontrolin & rhs);
     midicontrolin (midicontrolin &&) = default;
     midicontrolin & operator = (midicontrolin &&) = default;
     virtual ~midicontrolin () = default;
@@ -136,10 +168,7 @@ public:
         return m_comments_block;
     }
 
-    void clear ()
-    {
-        m_container.clear();
-    }
+    void clear ();
 
     int count () const
     {
@@ -151,11 +180,26 @@ public:
         return m_have_controls;
     }
 
+    bool status_bound (midibyte status) const
+    {
+        return m_bound_statuses.test(status);
+    }
+
     const mccontainer & container () const
     {
         return m_container;
     }
 
+    padmap & pad_map ()
+    {
+        return m_pad_map;
+    }
+
+    const padmap & pad_map () const
+    {
+        return m_pad_map;
+    }
+
     bool add (const midicontrol & mc);
     void add_blank_controls (const keycontainer & kc);
     const midicontrol & control (const midicontrol::key & k) const;
@@ -286,6 +330,11 @@ public:
 
     void show () const;
 
+private:
+
+    static int lookup_index (midibyte status, midibyte d0);
+    void rebuild_lookup ();
+
 };              // class midicontrolin
 
 }               // namespace seq66
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Igor Angst (major modifications by C. Ahlstrom)
  * \date          2018-03-28
- * \updates       2023-04-10
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  * The class contained in this file encapsulates most of the
@@ -38,12 +38,14 @@
  *
  */
 
+#include <map>                          /* std::map<>                       */
 #include <vector>                       /* std::vector<>                    */
 
 #include "ctrl/midicontrolbase.hpp"     /* seq66::midicontrolbase class     */
 #include "ctrl/midimacros.hpp"          /* seq66::midimacros class          */
 #include "midi/event.hpp"               /* seq66::event class               */
 #include "midi/mastermidibus.hpp"       /* seq66::mastermidibus class       */
+#include "util/recmutex.hpp"            /* seq66::recmutex class            */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -231,6 +233,23 @@ private:
 
     using uiactions = std::vector<actiontriplet>;
 
+    /**
+     *  Part of a compiled macro: a run of channel (or system) messages,
+     *  ready for one play_batch() call, then a SysEx message, if any.
+     */
+
+    using macrosegment = struct
+    {
+        std::vector<batchevent> ms_messages;
+        event ms_sysex;
+    };
+
+    /**
+     *  A macro compiled for sending, in the order of its bytes.
+     */
+
+    using macroburst = std::vector<macrosegment>;
+
     /**
      *  Provides a type for a vector of uiaction pairs, which can be
      *  essentially unlimited in size.  However, the number needed is
@@ -278,12 +297,68 @@ private:
 
     midimacros m_macro_events;
 
+    /**
+     *  The macros compiled by expand_macros(), indexed by the handle of each
+     *  macro (see midimacros::handle()), and the handles of the startup and
+     *  shutdown macros, or -1.
+     */
+
+    std::vector<macroburst> m_macro_bursts;
+    int m_startup_macro;
+    int m_shutdown_macro;
+
     /**
      *  Holds the screenset size, to use rather than calling the container.
      */
 
     int m_screenset_size;
 
+    /**
+     *  The last value sent to each address of the control surface, or -1 if
+     *  not known.  An address is a channel message and channel plus, for
+     *  most messages, the first data byte (e.g. the note of a Launchpad
+     *  pad).  Feedback that would set an address to the value it already has
+     *  is not sent.  A Note Off counts as a Note On of velocity 0.
+     */
+
+    std::vector<short> m_sent_values;
+
+    /**
+     *  If true (the default), skip feedback that changes nothing on the
+     *  device.  The "feedback-changes-only" option of the 'ctrl' file.
+     */
+
+    bool m_changes_only;
+
+    /**
+     *  The most feedback messages to send per second, or 0 for no limit.
+     *  The "feedback-rate" option of the 'ctrl' file.  For a slow USB
+     *  device on a buss shared with notes.
+     */
+
+    int m_feedback_rate;
+
+    /**
+     *  The rate is enforced over tenths of a second.  These hold the start
+     *  of the current tenth and the count sent in it.
+     */
+
+    long m_window_start_us;
+    int m_window_count;
+
+    /**
+     *  Feedback held back by the rate limit, by address, so that only the
+     *  last value for an address is sent.  See send_pending().
+     */
+
+    std::map<int, event> m_pending;
+
+    /**
+     *  Guards the feedback state, which several threads can change.
+     */
+
+    mutable recmutex m_feedback_mutex;
+
 public:
 
     midicontrolout (const std::string & name);
@@ -328,7 +403,7 @@ public:
         int group, int * onp, int * offp, int * delp = nullptr
     );
     bool mutes_event_is_active (int group) const;
-    void send_mutes_event (int group, actionindex which);
+    void send_mutes_event (int group, actionindex which, bool flush = true);
     void send_event (uiaction what, actionindex which);
     void send_learning (bool learning);
     void send_automation (bool activate);
@@ -341,6 +416,8 @@ public:
     void clear_macros ()
     {
         m_macro_events.clear();
+        m_macro_bursts.clear();
+        m_startup_macro = m_shutdown_macro = (-1);
     }
 
     bool add_macro (const tokenization & tokens)
@@ -363,12 +440,52 @@ public:
         m_macro_events.active(flag);
     }
 
-    bool expand_macros ()
+    bool expand_macros ();
+
+    int macro_handle (const std::string & name) const
+    {
+        return m_macro_events.handle(name);
+    }
+
+    int startup_macro () const
+    {
+        return m_startup_macro;
+    }
+
+    int shutdown_macro () const
+    {
+        return m_shutdown_macro;
+    }
+
+    void send_macro (const std::string & name, bool flush = true)
     {
-        return m_macro_events.expand();
+        send_macro(macro_handle(name), flush);
     }
 
-    void send_macro (const std::string & name, bool flush = true);
+    void send_macro (int handle, bool flush = true);
+    void reset_feedback ();
+    int send_pending ();
+    bool feedback_pending () const;
+
+    bool changes_only () const
+    {
+        return m_changes_only;
+    }
+
+    void changes_only (bool flag)
+    {
+        m_changes_only = flag;
+    }
+
+    int feedback_rate () const
+    {
+        return m_feedback_rate;
+    }
+
+    void feedback_rate (int rate)
+    {
+        m_feedback_rate = rate > 0 ? rate : 0 ;
+    }
 
     std::string macro_lines () const
     {
@@ -395,6 +512,13 @@ public:
         return m_macro_events.make_defaults();
     }
 
+private:
+
+    static int feedback_address (const event & ev, short & value);
+    static macroburst compile_macro (const midistring & byts);
+    void send_feedback (const event & ev, bool flush);
+    bool within_rate ();
+
 };          // class midicontrolout
 
 /*
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        C. Ahlstrom
  * \date          2021-11-22
- * \updates       2022-08-08
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Provides the base class for midicontrolout.
@@ -116,6 +116,7 @@ public:
     }
 
     bool expand ();
+    int handle (const std::string & name) const;
     midistring bytes (const std::string & name) const;
     std::string lines () const;
     tokenization names () const;
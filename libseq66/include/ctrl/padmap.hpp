@@ -0,0 +1,202 @@
+#if ! defined SEQ66_PADMAP_HPP
+#define SEQ66_PADMAP_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          padmap.hpp
+ *
+ *  This module declares the note-to-pattern table of the drum pads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Set up in the [pad-control] section of the 'ctrl' file, and held by the
+ *  midicontrolin object.  A Note On on the pad channel of the control buss
+ *  is looked up by note number, a single array access, to get the pattern
+ *  (slot) of the playing set that it launches.  See padlauncher.hpp for the
+ *  playing of the pads.
+ */
+
+#include <array>                        /* std::array<>                     */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midipulse       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds the pad settings and the note-to-slot table.
+ */
+
+class padmap
+{
+
+public:
+
+    /**
+     *  The number of notes, and so of pads, that can be mapped.
+     */
+
+    static const int c_notes = 128;
+
+    /**
+     *  The largest slot number a pad can launch, the same as for the loop
+     *  controls.
+     */
+
+    static const int c_slot_max = 1023;
+
+private:
+
+    /**
+     *  The slot launched by each note, relative to the playing set, or -1.
+     */
+
+    std::array<short, c_notes> m_slots;
+
+    /**
+     *  The number of notes mapped.
+     */
+
+    int m_count;
+
+    /**
+     *  Turns the pads on.  Even if true, the pads are off while no note is
+     *  mapped.
+     */
+
+    bool m_enabled;
+
+    /**
+     *  The channel of the pads, 0 to 15.  The default is 9, the General
+     *  MIDI drum channel.
+     */
+
+    midibyte m_channel;
+
+    /**
+     *  The lowest velocity that launches a pattern.  A softer hit is
+     *  swallowed, so that a pad brushed in passing plays nothing.
+     */
+
+    midibyte m_min_velocity;
+
+    /**
+     *  If true, the velocity of the hit scales the velocities of the Note
+     *  Ons of the pattern, with 127 keeping them as they are.
+     */
+
+    bool m_velocity_scale;
+
+    /**
+     *  The note value of the quantization grid, such as 16 for sixteenth
+     *  notes.  Zero starts a pattern at once.
+     */
+
+    int m_quantize;
+
+public:
+
+    padmap ();
+
+    void clear ();
+    bool assign (int note, int slot);
+
+    /**
+     * \return
+     *      Returns the slot of the note, or -1 if it is not a pad.
+     */
+
+    int slot (midibyte note) const
+    {
+        return note < c_notes ? int(m_slots[note]) : -1 ;
+    }
+
+    int count () const
+    {
+        return m_count;
+    }
+
+    bool active () const
+    {
+        return m_enabled && m_count > 0;
+    }
+
+    bool enabled () const
+    {
+        return m_enabled;
+    }
+
+    void enabled (bool flag)
+    {
+        m_enabled = flag;
+    }
+
+    midibyte channel () const
+    {
+        return m_channel;
+    }
+
+    void channel (int ch);
+
+    midibyte min_velocity () const
+    {
+        return m_min_velocity;
+    }
+
+    void min_velocity (int v);
+
+    bool velocity_scale () const
+    {
+        return m_velocity_scale;
+    }
+
+    void velocity_scale (bool flag)
+    {
+        m_velocity_scale = flag;
+    }
+
+    int quantize () const
+    {
+        return m_quantize;
+    }
+
+    void quantize (int notevalue);
+    midipulse quantum (int ppqn) const;
+
+};              // class padmap
+
+}               // namespace seq66
+
+#endif          // SEQ66_PADMAP_HPP
+
+/*
+ * padmap.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,144 @@
+#if ! defined SEQ66_BATCHCONVERT_HPP
+#define SEQ66_BATCHCONVERT_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          batchconvert.hpp
+ *
+ *  This module declares the headless conversion of a list of MIDI and WRK
+ *  files, as done by "seq66cli --batch".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The files are parsed into a performer that is never launched, so that no
+ *  MIDI ports are enumerated and no I/O threads are started, then written
+ *  as Seq66 MIDI files.  SMF 0 files are split into tracks by the parser.
+ *  With "--summary", a song summary of each file is written instead.  With
+ *  "--tracks", only the given tracks of each WRK file are imported.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Holds the options of a batch conversion and runs it.
+ */
+
+class batchconvert
+{
+
+private:
+
+    /**
+     *  The input files, MIDI or WRK, in command-line order.
+     */
+
+    std::vector<std::string> m_files;
+
+    /**
+     *  The directory for the output files.  If empty, each output file is
+     *  written next to its input file.
+     */
+
+    std::string m_output_dir;
+
+    /**
+     *  The number of worker processes.  Each one converts every n-th file.
+     */
+
+    int m_workers;
+
+    /**
+     *  If true, the song (triggers) is exported, as in "Export Song".
+     *  Otherwise the patterns are written as a normal Seq66 file.
+     */
+
+    bool m_export_song;
+
+    /**
+     *  If true, every pattern is quantized to its snap value, via
+     *  sequence::fix_pattern().
+     */
+
+    bool m_quantize;
+
+    /**
+     *  If true, every pattern is shifted so that its first note is at 0,
+     *  via sequence::fix_pattern().
+     */
+
+    bool m_align_left;
+
+    /**
+     *  If not empty, the format ("text", "json", or "csv") of a song
+     *  summary written for each file, instead of a converted MIDI file.
+     */
+
+    std::string m_summary_format;
+
+    /**
+     *  If not empty, the Cakewalk track numbers to import from each WRK
+     *  file, as given by "--tracks".  MIDI files are always read whole.
+     */
+
+    std::vector<int> m_wrk_tracks;
+
+public:
+
+    batchconvert ();
+
+    static bool requested (int argc, char * argv []);
+    static void show_help ();
+
+    bool parse (int argc, char * argv []);
+    int run ();
+
+private:
+
+    bool parse_tracks (const std::string & tracklist);
+    int convert_files (int worker);
+    bool convert (performer & p, const std::string & infile);
+    bool fix_patterns (performer & p);
+    std::string output_name (const std::string & infile) const;
+
+};          // class batchconvert
+
+}           // namespace seq66
+
+#endif      // SEQ66_BATCHCONVERT_HPP
+
+/*
+ * batchconvert.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-31
- * \updates       2023-06-28
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The businfo module defines the businfo and busarray classes so that we can
@@ -215,6 +215,11 @@ private:
         bus()->sysex(ev);
     }
 
+    void sysex_chunk (const midibyte * data, int len)
+    {
+        bus()->sysex_chunk(data, len);
+    }
+
 private:
 
     void print () const;
@@ -237,6 +242,17 @@ private:
 
     std::vector<businfo> m_container;
 
+    /**
+     *  The busses whose clock is enabled, so that clock() visits no others,
+     *  and the tick of the next clock pulse due on any of them.  Updated by
+     *  update_clocks() whenever the clocking can have changed: when busses
+     *  are added or initialized, when a clock is set, and when the clocks
+     *  are started, continued, or initialized.
+     */
+
+    std::vector<midibus *> m_clock_busses;
+    midipulse m_next_clock_tick;
+
 public:
 
     busarray ();
@@ -270,6 +286,8 @@ public:
     {
         for (auto & bi : m_container)       /* vector of businfo copies     */
             bi.start();
+
+        update_clocks();
     }
 
     /**
@@ -281,6 +299,8 @@ public:
     {
         for (auto & bi : m_container)       /* vector of businfo copies     */
             bi.stop();
+
+        update_clocks();
     }
 
     /**
@@ -295,6 +315,8 @@ public:
     {
         for (auto & bi : m_container)       /* vector of businfo copies     */
             bi.continue_from(tick);
+
+        update_clocks();
     }
 
     /**
@@ -309,11 +331,14 @@ public:
     {
         for (auto & bi : m_container)       /* vector of businfo copies     */
             bi.init_clock(tick);
+
+        update_clocks();
     }
 
     /**
-     *  Clocks at the given tick for all of the busses; used for output busses
-     *  only.
+     *  Clocks at the given tick for all of the clocked busses; used for
+     *  output busses only.  Called for every output frame, so it does
+     *  nothing until a clock pulse is due.
      *
      * \param tick
      *      Provides the tick value for all busses use as the clock tick.
@@ -321,12 +346,18 @@ public:
 
     void clock (midipulse tick)
     {
-        for (auto & bi : m_container)       /* vector of businfo copies     */
-            bi.clock(tick);
+        if (tick >= m_next_clock_tick)
+            clock_busses(tick);
     }
 
+    void update_clocks ();
+
     void play (bussbyte bus, const event * e24, midibyte channel);
+    void play_batch (bussbyte bus, const batchevent * evs, int n);
+    void retract (bussbyte bus, midibyte tag);
     void sysex (bussbyte bus, const event * ev);
+    void sysex_chunk (bussbyte bus, const midibyte * data, int len);
+    bool buffer_stats (int & size, int & highwater, int & dropped);
     bool set_clock (bussbyte bus, e_clock clocktype);
 
     /**
@@ -339,6 +370,8 @@ public:
     {
         for (auto & bi : m_container)           /* vector of businfo copies */
             bi.bus()->set_clock(bi.init_clock());
+
+        update_clocks();
     }
 
     e_clock get_clock (bussbyte bus) const;
@@ -347,6 +380,11 @@ public:
     std::string get_midi_alias (int bus) const;
     void print () const;
     void port_exit (int client, int port);
+    bool port_restart
+    (
+        int client, int port,
+        const std::string & busname, const std::string & portname
+    );
     bool set_input (bussbyte bus, bool inputing);
 
     /**
@@ -371,6 +409,10 @@ public:
     bool get_midi_event (event * inev);
     int replacement_port (int bus, int port);
 
+private:
+
+    void clock_busses (midipulse tick);
+
 };          // class busarray
 
 /*
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-07
- * \updates       2025-01-23
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  These items were moved from the globals.h module so that only the modules
@@ -243,6 +243,10 @@ extern std::string pulses_to_time_string
 (
     midipulse pulses, midibpm bp, int ppq, bool showus = true
 );
+extern std::string microseconds_to_time_string
+(
+    unsigned long microseconds, bool showus = true
+);
 extern int pulses_to_hours (midipulse pulses, midibpm bp, int ppq);
 extern double trunc_measures (double measures);
 extern midipulse measurestring_to_pulses
@@ -717,6 +721,7 @@ extern int pulses_per_pixel (midipulse ppq, int zoom = 2);
 #endif
 
 extern double wave_func (double angle, waveform wavetype);
+extern void wave_values (double * values, std::size_t count, waveform w);
 extern double unit_truncation (double angle);
 extern double exp_normalize (double angle, bool negate = false);
 extern bool extract_port_names
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-28
- * \updates       2023-05-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module extends the event class to support conversions between events
@@ -62,7 +62,10 @@ class editable_events;                  /* forward reference to container   */
  *  make events out of them (SysEx is partly supported).
  *
  *  To the concepts of event, the editable_event class adds a category field
- *  and strings to represent all of these members.
+ *  and functions that render all of these members as strings.  The strings
+ *  are made only when asked for, such as when a row of the event table is
+ *  shown, so that a long pattern in the editor does not carry a half-dozen
+ *  strings per event.
  */
 
 class editable_event final : public event
@@ -232,6 +235,14 @@ private:
 
     midipulse m_link_time;
 
+    /**
+     *  Holds the key of the linked event (if applicable), to find it in the
+     *  editable-event container.  The event link itself is an index into
+     *  the pattern's event list, which the editable event is not in.
+     */
+
+    event::key m_link_key;
+
     /**
      *  Indicates the overall category of this event, which will be
      *  subgroup::channel_message, subgroup::system_message,
@@ -242,12 +253,6 @@ private:
 
     subgroup m_category;
 
-    /**
-     *  Holds the name of the event category for this event.
-     */
-
-    std::string m_name_category;
-
     /**
      *  Indicates the format to display the time-stamp.  The default is to
      *  display in timestamp_measures format.
@@ -255,47 +260,6 @@ private:
 
     timestamp_format_t m_format_timestamp;
 
-    /**
-     *  Holds the string version of the MIDI pulse's time-stamp.
-     */
-
-    std::string m_name_timestamp;
-
-    /**
-     *  Holds the name of the status value for this event.  It will include
-     *  the names of the channel messages and the system messages.  The latter
-     *  includes SysEx and Meta messages.
-     */
-
-    std::string m_name_status;
-
-    /**
-     *  Holds the name of the meta message, if applicable.  If not applicable,
-     *  this name will be empty.
-     */
-
-    std::string m_name_meta;
-
-    /**
-     *  If we eventually implement the editing of the Seq24/Seq66
-     *  "proprietary" meta sequencer-specific events, the name of the SeqSpec
-     *  will be stored here.
-     */
-
-    std::string m_name_seqspec;
-
-    /**
-     *  Holds the channel description, if applicable.
-     */
-
-    std::string m_name_channel;
-
-    /**
-     *  Holds the data description, if applicable.
-     */
-
-    std::string m_name_data;
-
 public:
 
     editable_event () = default;
@@ -326,6 +290,17 @@ public:
         m_link_time = lt;
     }
 
+    const event::key & link_key () const
+    {
+        return m_link_key;
+    }
+
+    void linked_event (const event & ev)
+    {
+        m_link_time = ev.timestamp();
+        m_link_key = event::key(ev);
+    }
+
 public:
 
     subgroup category () const
@@ -335,16 +310,12 @@ public:
 
     void category (subgroup c);
 
-    const std::string & category_string () const
-    {
-        return m_name_category;
-    }
-
+    std::string category_string () const;
     void category (const std::string & cs);
 
-    const std::string & timestamp_string () const
+    std::string timestamp_string () const
     {
-        return m_name_timestamp;
+        return format_timestamp();
     }
 
     /**
@@ -366,13 +337,13 @@ public:
      *  pulses.
      */
 
-    std::string time_as_pulses ()
+    std::string time_as_pulses () const
     {
         return pulses_to_string(timestamp());
     }
 
-    std::string time_as_measures ();
-    std::string time_as_minutes ();
+    std::string time_as_measures () const;
+    std::string time_as_minutes () const;
     void set_status_from_string
     (
         const std::string & ts,
@@ -388,36 +359,13 @@ public:
         const std::string & sd1,
         const std::string & chan
     );
-    std::string format_timestamp ();
-    std::string stock_event_string ();
+    std::string format_timestamp () const;
+    std::string stock_event_string () const;
     std::string ex_data_string () const;
     std::string ex_text_string () const;
-
-    std::string status_string () const
-    {
-        return m_name_status;
-    }
-
-    std::string meta_string () const
-    {
-        return m_name_meta;
-    }
-
-    std::string seqspec_string () const
-    {
-        return m_name_seqspec;
-    }
-
-    std::string channel_string () const
-    {
-        return m_name_channel;
-    }
-
-    std::string data_string () const
-    {
-        return m_name_data;
-    }
-
+    std::string status_string () const;
+    std::string channel_string () const;
+    std::string data_string () const;
     void analyze ();
 
     static std::string category_name (int index);
@@ -29,7 +29,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-12-04
- * \updates       2023-07-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module extends the event class to support conversions between events
@@ -127,14 +127,9 @@ public:
     editable_events (const editable_events & rhs);
     editable_events & operator = (const editable_events & rhs);
 
-    /**
-     *  This destructor current is a rote virtual function override.
-     */
+    virtual ~editable_events ();
 
-    virtual ~editable_events ()
-    {
-        // Empty body
-    }
+    static std::size_t open_bytes ();
 
 public:
 
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-12-18
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module also declares/defines the various constants, status-byte
@@ -49,10 +49,12 @@
  *          data.
  */
 
+#include <memory>                       /* std::shared_ptr<> SysEx data     */
 #include <string>                       /* used in to_string()              */
 #include <vector>                       /* SYSEX data stored in vector      */
 
 #include "midi/midibytes.hpp"           /* seq66::midibyte alias, etc.      */
+#include "util/pagedvector.hpp"         /* seq66::pagedvector<> for buffer  */
 
 #define SEQ66_STAZED_SELECT_EVENT_HANDLE
 
@@ -288,15 +290,68 @@ public:
     /**
      *  The data buffer for MIDI events.  This item replaces the
      *  eventlist::Events type definition so that we can replace event
-     *  pointers with iterators, safely.
+     *  pointers with iterators, safely.  It is paged, so that a very long
+     *  recording grows without reallocating the whole list.
      */
 
-    using buffer = std::vector<event>;
+    using buffer = pagedvector<event>;
     using iterator = buffer::iterator;
     using const_iterator = buffer::const_iterator;
     using reverse_iterator = buffer::reverse_iterator;
     using const_reverse_iterator = buffer::const_reverse_iterator;
 
+    /**
+     *  Holds a mask of property bits for each of the 256 byte values.  The
+     *  tables are built at compile time in event.cpp, so that each of the
+     *  static status tests below is one load and one bit test, instead of a
+     *  chain of comparisons and masks.  These tests are made for every
+     *  event in the playback, drawing, and editing loops.
+     */
+
+    class bytetable
+    {
+
+    public:
+
+        unsigned m_bits[256];
+
+    };
+
+    /**
+     *  The property bits of a status byte, with or without the channel
+     *  nybble.  See sm_status_bits.
+     */
+
+    static const unsigned c_bit_status      = 0x00001;  /**< 0x80 to 0xFF.  */
+    static const unsigned c_bit_channel     = 0x00002;  /**< 0x80 to 0xEF.  */
+    static const unsigned c_bit_note        = 0x00004;  /**< 0x80 to 0xAF.  */
+    static const unsigned c_bit_strict_note = 0x00008;  /**< 0x80 to 0x9F.  */
+    static const unsigned c_bit_note_on     = 0x00010;  /**< 0x90 to 0x9F.  */
+    static const unsigned c_bit_note_off    = 0x00020;  /**< 0x80 to 0x8F.  */
+    static const unsigned c_bit_controller  = 0x00040;  /**< 0xB0 to 0xBF.  */
+    static const unsigned c_bit_program     = 0x00080;  /**< 0xC0 to 0xCF.  */
+    static const unsigned c_bit_pitchbend   = 0x00100;  /**< 0xE0 to 0xEF.  */
+    static const unsigned c_bit_one_byte    = 0x00200;  /**< 0xC0 to 0xDF.  */
+    static const unsigned c_bit_two_byte    = 0x00400;  /**< Not one-byte.  */
+    static const unsigned c_bit_system      = 0x00800;  /**< 0xF0 to 0xFF.  */
+    static const unsigned c_bit_sysex       = 0x01000;  /**< 0xF0 and 0xF7. */
+    static const unsigned c_bit_ex_data     = 0x02000;  /**< 0xF0 and 0xFF. */
+    static const unsigned c_bit_playable    = 0x04000;  /**< Not ex-data.   */
+    static const unsigned c_bit_common      = 0x08000;  /**< 0xF0 to 0xF7.  */
+    static const unsigned c_bit_realtime    = 0x10000;  /**< 0xF8 to 0xFF.  */
+    static const unsigned c_bit_sense_reset = 0x20000;  /**< 0xFE and 0xFF. */
+
+    /**
+     *  The property bits of a Meta event type, which is stored in
+     *  m_channel.  See sm_meta_bits.
+     */
+
+    static const unsigned c_bit_meta_type   = 0x01;     /**< 0x00 to 0x7F.  */
+    static const unsigned c_bit_meta_text   = 0x02;     /**< 0x01 to 0x07.  */
+    static const unsigned c_bit_meta_tempo  = 0x04;     /**< 0x51.          */
+    static const unsigned c_bit_meta_timesig = 0x08;    /**< 0x58.          */
+    static const unsigned c_bit_meta_keysig = 0x10;     /**< 0x59.          */
+
 public:
 
     /**
@@ -335,6 +390,15 @@ private:
 
     bussbyte m_input_buss;
 
+    /**
+     *  For an incoming event, the time at which it arrived, in the
+     *  microtime() time base, if the MIDI API knows it, otherwise 0.  Used
+     *  to place a recorded event at its exact tick, however late the input
+     *  thread gets to it.  Not saved.
+     */
+
+    long m_arrival_us;
+
     /**
      *  Provides the MIDI timestamp in ticks, otherwise known as the "pulses"
      *  in "pulses per quarter note" (PPQN).
@@ -389,21 +453,47 @@ private:
      *  for Meta events.  Compare is_sysex() to is_meta() and is_ex_data()
      *  [which tests for both]. In addition, detect and handle the other
      *  Meta message that hold variable amounts of bytes.
+     *
+     *  The data is held out-of-line and shared, copy-on-write, between the
+     *  copies of an event, so that copying, sorting, and snapshotting event
+     *  lists does not copy it.  For the most common events, which have no
+     *  such data, this pointer is null, and copying it touches no heap
+     *  memory or reference count.  See writable_sysex().
      */
 
-    sysex m_sysex;
+    std::shared_ptr<sysex> m_sysex;
+
+    /**
+     *  The value of get_sysex() for an event without SysEx/Meta data.
+     */
+
+    static const sysex sm_no_sysex;
+
+    /**
+     *  The properties of each status byte and of each Meta event type.
+     *  Constant-initialized in event.cpp.
+     */
+
+    static const bytetable sm_status_bits;
+    static const bytetable sm_meta_bits;
 
     /**
      *  This event is used to link NoteOns and NoteOffs together.  The NoteOn
      *  points to the NoteOff, and the NoteOff points to the NoteOn.  See, for
      *  example, eventlist::link_notes().
      *
+     *  The link is the index of the other event in the event::buffer, not an
+     *  iterator, so that it survives the buffer growing (and reallocating)
+     *  as events are appended while recording.  It is still made stale by a
+     *  sort or by an erasure before the other event, which relink anyway.
+     *  See eventlist::linked() to get at the other event.
+     *
      *  We currently do not link tempo events; this would be necessary to
      *  display a line from one tempo event to the next.  Currently we display
      *  a small circle for each tempo event.
      */
 
-    iterator m_linked;
+    int m_linked;
 
     /**
      *  Indicates that a link has been made.  This item is used [via
@@ -452,6 +542,8 @@ public:
     );
     event (const event & rhs);
     event & operator = (const event & rhs);
+    event (event && rhs) noexcept;
+    event & operator = (event && rhs) noexcept;
     virtual ~event ();
 
     /*
@@ -462,6 +554,10 @@ public:
     bool operator < (const event & rhsevent) const;
     bool match (const event & target) const;
     void prep_for_send (midipulse tick, const event & source);
+    void prep_for_send
+    (
+        midipulse tick, midibyte status, midibyte d0, midibyte d1
+    );
 
     void set_input_bus (bussbyte b)
     {
@@ -474,6 +570,16 @@ public:
         return m_input_buss;
     }
 
+    void arrival_us (long us)
+    {
+        m_arrival_us = us;
+    }
+
+    long arrival_us () const
+    {
+        return m_arrival_us;
+    }
+
     void set_timestamp (midipulse time)
     {
         m_timestamp = time;
@@ -523,6 +629,23 @@ public:
         return m & EVENT_GET_STATUS_MASK;
     }
 
+    /**
+     *  Looks up the property bits of a status byte or a Meta event type.
+     *
+     * \return
+     *      Returns true if any of the given bits are set.
+     */
+
+    static bool status_has (midibyte m, unsigned bits)
+    {
+        return (sm_status_bits.m_bits[m] & bits) != 0;
+    }
+
+    static bool meta_has (midibyte m, unsigned bits)
+    {
+        return (sm_meta_bits.m_bits[m] & bits) != 0;
+    }
+
     /**
      *  Static test for the status bit.  The "opposite" test is is_data().
      *  Currently used only in midifile.
@@ -582,17 +705,17 @@ public:
 
     static bool is_ex_data_msg (midibyte m)
     {
-        return m == EVENT_MIDI_META || m == EVENT_MIDI_SYSEX;
+        return status_has(m, c_bit_ex_data);
     }
 
     static bool is_pitchbend_msg (midibyte m)
     {
-        return mask_status(m) == EVENT_PITCH_WHEEL;
+        return status_has(m, c_bit_pitchbend);
     }
 
     static bool is_controller_msg (midibyte m)
     {
-        return mask_status(m) == EVENT_CONTROL_CHANGE;
+        return status_has(m, c_bit_controller);
     }
 
     /**
@@ -602,8 +725,7 @@ public:
      * \param m
      *      The channel status or message byte to be tested, and the channel
      *      bits are masked off before testing.  Actually, no longer
-     *      necessary, we have a faster test, since these three events have
-     *      values in an easy range to check.
+     *      necessary, the status table covers all channels.
      *
      * \return
      *      Returns true if the byte represents a MIDI note message.
@@ -611,7 +733,7 @@ public:
 
     static bool is_note_msg (midibyte m)
     {
-        return m >= EVENT_NOTE_OFF && m < EVENT_CONTROL_CHANGE;
+        return status_has(m, c_bit_note);
     }
 
     /**
@@ -627,12 +749,17 @@ public:
 
     static bool is_strict_note_msg (midibyte m)
     {
-        return m >= EVENT_NOTE_OFF && m < EVENT_AFTERTOUCH;
+        return status_has(m, c_bit_strict_note);
     }
 
     static bool is_note_on_msg (midibyte m)
     {
-        return m >= EVENT_NOTE_ON && m < EVENT_AFTERTOUCH;
+        return status_has(m, c_bit_note_on);
+    }
+
+    static bool is_note_off_msg (midibyte m)
+    {
+        return status_has(m, c_bit_note_off);
     }
 
     /**
@@ -643,7 +770,7 @@ public:
 
     static bool is_playable_msg (midibyte m)
     {
-        return m != EVENT_MIDI_META && m != EVENT_MIDI_SYSEX;
+        return status_has(m, c_bit_playable);
     }
 
 public:
@@ -669,7 +796,7 @@ public:
 
     static bool is_channel_msg (midibyte m)
     {
-        return m >= EVENT_NOTE_OFF && m < EVENT_MIDI_REALTIME;
+        return status_has(m, c_bit_channel);
     }
 
     /**
@@ -688,8 +815,7 @@ public:
 
     static bool is_one_byte_msg (midibyte m)
     {
-        m = mask_status(m);
-        return m == EVENT_PROGRAM_CHANGE || m == EVENT_CHANNEL_PRESSURE;
+        return status_has(m, c_bit_one_byte);
     }
 
     /**
@@ -707,11 +833,7 @@ public:
 
     static bool is_two_byte_msg (midibyte m)
     {
-        return
-        (
-            (m >= EVENT_NOTE_OFF && m < EVENT_PROGRAM_CHANGE) ||
-            mask_status(m) == EVENT_PITCH_WHEEL
-        );
+        return status_has(m, c_bit_two_byte);
     }
 
     /**
@@ -728,12 +850,12 @@ public:
 
     static bool is_note_off_velocity (midibyte status, midibyte vel)
     {
-        return mask_status(status) == EVENT_NOTE_ON && vel == 0;
+        return vel == 0 && is_note_on_msg(status);
     }
 
     static bool is_program_change_msg (midibyte m)
     {
-        return mask_status(m) == EVENT_PROGRAM_CHANGE;
+        return status_has(m, c_bit_program);
     }
 
     /*
@@ -743,7 +865,7 @@ public:
 
     static bool is_meta_status (midibyte m)
     {
-        return m <= EVENT_META_SEQSPEC;
+        return meta_has(m, c_bit_meta_type);
     }
 
     /*
@@ -753,7 +875,7 @@ public:
 
     static bool is_meta_text_msg (midibyte m)
     {
-        return m >= EVENT_META_TEXT_EVENT && m <= EVENT_META_CUE_POINT;
+        return meta_has(m, c_bit_meta_text);
     }
 
     static bool is_tempo_status (midibyte m)
@@ -772,8 +894,7 @@ public:
 
     static bool is_sysex_msg (midibyte m)
     {
-        return m == EVENT_MIDI_SYSEX ||
-            m == EVENT_MIDI_SYSEX_CONTINUE;     /* 0xF7 as SysEx Continue   */
+        return status_has(m, c_bit_sysex);      /* 0xF7 as SysEx Continue   */
     }
 
     /**
@@ -802,8 +923,7 @@ public:
         midibyte m, midibyte cc, midibyte datum
     )
     {
-        m = mask_status(m);
-        return (m != EVENT_CONTROL_CHANGE) || (datum == cc);
+        return ! is_controller_msg(m) || (datum == cc);
     }
 
     /**
@@ -813,7 +933,7 @@ public:
 
     static bool is_system_common_msg (midibyte m)
     {
-        return m >= EVENT_MIDI_SYSEX && m < EVENT_MIDI_CLOCK;
+        return status_has(m, c_bit_common);
     }
 
     /**
@@ -833,7 +953,7 @@ public:
 
     static bool is_sense_or_reset (midibyte m)
     {
-        return m == EVENT_MIDI_ACTIVE_SENSE || m == EVENT_MIDI_RESET;
+        return status_has(m, c_bit_sense_reset);
     }
 
 public:
@@ -1063,27 +1183,43 @@ public:
 
     void reset_sysex ()
     {
-        m_sysex.clear();
+        m_sysex.reset();
     }
 
+    /**
+     *  Provides write access to the SysEx/Meta data, first making a private
+     *  copy of it if it is shared with another event.
+     */
+
     sysex & get_sysex ()
     {
-        return m_sysex;
+        return writable_sysex();
     }
 
     const sysex & get_sysex () const
     {
-        return m_sysex;
+        return m_sysex ? *m_sysex : sm_no_sysex ;
     }
 
     midibyte get_sysex (size_t i) const
     {
-        return i < m_sysex.size() ? m_sysex[i] : 0 ;
+        return i < get_sysex().size() ? (*m_sysex)[i] : 0 ;
     }
 
     int sysex_size () const
     {
-        return int(m_sysex.size());
+        return int(get_sysex().size());
+    }
+
+    /**
+     *  Shares the SysEx/Meta data, without copying it, with something that
+     *  might outlive this event, such as a sysexstream.  Null if the event
+     *  has no such data.
+     */
+
+    std::shared_ptr<const sysex> shared_sysex () const
+    {
+        return m_sysex;
     }
 
     /**
@@ -1112,29 +1248,29 @@ public:
      *      this note, and the Note Off is not yet linked.
      */
 
-    bool off_linkable (buffer::iterator & eoff) const
+    bool off_linkable (const event & eoff) const
     {
-        return eoff->off_linkable() ? eoff->get_note() == get_note() : false ;
+        return eoff.off_linkable() ? eoff.get_note() == get_note() : false ;
     }
 
     /**
-     *  Sets m_has_link and sets m_link to the provided event pointer.
+     *  Sets m_has_link and sets m_linked to the provided event index.
      *
-     * \param ev
-     *      Provides a pointer to the event value to set.  Since we're using
-     *      an iterator, we can't use a null-pointer test that.  We assume the
-     *      caller has checked that the value is not end() for the container.
+     * \param index
+     *      Provides the index of the linked event in the buffer holding
+     *      both events.  We assume the caller has checked that it is in
+     *      range.
      */
 
-    void link (iterator ev)
+    void link (int index)
     {
-        m_linked = ev;
+        m_linked = index;
         m_has_link = true;
     }
 
-    iterator link () const
+    int link () const
     {
-        return m_linked;        /* iterator could be invalid, though    */
+        return m_linked;        /* the index could be stale, though     */
     }
 
     bool is_linked () const
@@ -1266,7 +1402,7 @@ public:
 
     bool is_note_on () const
     {
-        return mask_status(m_status) == EVENT_NOTE_ON;
+        return is_note_on_msg(m_status);
     }
 
     /**
@@ -1279,7 +1415,7 @@ public:
 
     bool is_note_off () const
     {
-        return mask_status(m_status) == EVENT_NOTE_OFF;
+        return is_note_off_msg(m_status);
     }
 
     /**
@@ -1440,8 +1576,7 @@ public:
 
     bool is_sense_reset ()
     {
-        return m_status == EVENT_MIDI_ACTIVE_SENSE ||
-            m_status == EVENT_MIDI_RESET;
+        return is_sense_or_reset(m_status);
     }
 
     /**
@@ -1460,7 +1595,7 @@ public:
 
     bool is_meta_text () const
     {
-        return is_meta() && is_meta_text_msg(m_channel);
+        return is_meta() && meta_has(m_channel, c_bit_meta_text);
     }
 
     /**
@@ -1484,7 +1619,7 @@ public:
 
     bool is_tempo () const
     {
-        return is_meta() && m_channel == EVENT_META_SET_TEMPO;      /* 0x51 */
+        return is_meta() && meta_has(m_channel, c_bit_meta_tempo);  /* 0x51 */
     }
 
     midibpm tempo () const;
@@ -1498,7 +1633,7 @@ public:
 
     bool is_time_signature () const
     {
-        return is_meta() && m_channel == EVENT_META_TIME_SIGNATURE; /* 0x58 */
+        return is_meta() && meta_has(m_channel, c_bit_meta_timesig);
     }
 
     /**
@@ -1508,11 +1643,14 @@ public:
 
     bool is_key_signature () const
     {
-        return is_meta() && m_channel == EVENT_META_KEY_SIGNATURE;  /* 0x59 */
+        return is_meta() && meta_has(m_channel, c_bit_meta_keysig); /* 0x59 */
     }
 
     void print (const std::string & tag = "") const;
-    void print_note (bool showlink = true) const;
+    void print_note
+    (
+        bool showlink = true, const event * linked = nullptr
+    ) const;
     std::string to_string () const;
     int get_rank () const;
     void rescale (int newppqn, int oldppqn);
@@ -1533,6 +1671,10 @@ private:    // used by friend eventlist
 
     bool randomize (int range);
 
+private:
+
+    sysex & writable_sysex ();
+
 };          // class event
 
 /*
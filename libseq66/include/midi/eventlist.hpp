@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-19
- * \updates       2024-12-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module extracts the event-list functionality from the sequencer
@@ -49,7 +49,9 @@
  *
  * https://baptiste-wicht.com/posts/2012/12/cpp-benchmark-vector-list-deque.html
  *
- *  we will now use std::vector for the event list.
+ *  we will now use std::vector for the event list.  It is now a vector
+ *  stored in pages (see pagedvector), so that an hour-long recording does
+ *  not need one huge block that is copied each time it grows.
  */
 
 /**
@@ -98,7 +100,13 @@
 #include <atomic>                       /* std::atomic<bool> usage          */
 #endif
 
+#include <algorithm>                    /* std::remove_if()                 */
+#include <deque>                        /* std::deque for eventstack        */
+#include <utility>                      /* std::forward(), std::move()      */
+
 #include "midi/event.hpp"               /* seq66::event, event::buffer      */
+#include "midi/notespans.hpp"           /* seq66::notespans note index      */
+#include "util/cowvector.hpp"           /* seq66::cowvector<> storage       */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -116,6 +124,7 @@ class eventlist
     friend class editable_events;       /* access to verify_and_link()      */
     friend class midifile;              /* access to print()                */
     friend class sequence;              /* any_selected_notes()             */
+    friend class eventstack;            /* access to m_events               */
 
 public:
 
@@ -168,11 +177,13 @@ public:
 private:
 
     /**
-     *  This list holds the current pattern/sequence events. Note that
-     *  is std::vector<event>.
+     *  This list holds the current pattern/sequence events, a std::vector of
+     *  events shared with the copies of the list (another pattern copied
+     *  from this one, or an undo entry) until one of them changes it.  The
+     *  const functions of eventlist do not unshare it.
      */
 
-    event::buffer m_events;
+    cowvector<event, event::buffer> m_events;
 
     /**
      *  Eventually we want to be able to move through events of a given type,
@@ -259,6 +270,31 @@ private:
 
     bool m_link_wraparound;
 
+    /**
+     *  The index of the linked notes, used to find the notes sounding at a
+     *  given tick.  Built by verify_and_link(), and dropped by any change
+     *  that moves the events around in the vector.
+     */
+
+    notespans m_note_spans;
+
+    /**
+     *  The index of the note events by note number, used to select the
+     *  notes in a rectangle of the piano roll.  Built only when first used
+     *  after a change, and not copied with the events.
+     */
+
+    notegrid m_note_grid;
+
+    /**
+     *  Counts the changes that add, remove, or move events in the vector,
+     *  or relink them.  A counter must not be copied with the events, so
+     *  that assigning an older list, such as an undo, still counts as a
+     *  change.  See sequence::refresh_stats().
+     */
+
+    unsigned m_changes;
+
 public:
 
     eventlist ();
@@ -294,6 +330,9 @@ public:
         return m_events.cend();
     }
 
+    event::const_iterator cbegin (midipulse tick, bool notes = false) const;
+    bool cend (event::const_iterator evi, midipulse tick) const;
+
     /**
      *  Returns the number of events stored in m_events.  We like returning
      *  an integer instead of size_t, and rename the function so nobody is
@@ -310,13 +349,72 @@ public:
     midipulse get_min_timestamp () const;
     midipulse get_max_timestamp () const;
     bool add (const event & e);
+    bool add (event && e);
     bool append (const event & e);
+    bool append (event && e);
+
+    /**
+     *  Constructs an event in place at the end of the list, with the same
+     *  arguments as an event constructor, as append() would add it.
+     *
+     * \return
+     *      Returns true.
+     */
+
+    template <typename... Args>
+    bool emplace (Args &&... args)
+    {
+        m_events.emplace_back(std::forward<Args>(args)...);
+        return appended();
+    }
 
     bool empty () const
     {
         return m_events.empty();
     }
 
+    void reserve (std::size_t n)
+    {
+        m_events.reserve(n);
+    }
+
+    void shrink_to_fit ()
+    {
+        m_events.shrink_to_fit();
+    }
+
+    std::size_t capacity () const
+    {
+        return m_events.capacity();
+    }
+
+    std::size_t bytes () const
+    {
+        return m_events.capacity() * sizeof(event);
+    }
+
+    std::size_t sysex_bytes () const;
+
+    /**
+     *  Gets the event linked to the given one, which must be linked, and
+     *  must be in this list.  See event::link().
+     */
+
+    event::iterator linked (const event & e)
+    {
+        return m_events.begin() + e.link();
+    }
+
+    event::const_iterator linked (const event & e) const
+    {
+        return m_events.cbegin() + e.link();
+    }
+
+    int index_of (event::const_iterator ei) const
+    {
+        return int(ei - m_events.cbegin());
+    }
+
     midipulse get_length () const
     {
         return m_length;
@@ -332,6 +430,21 @@ public:
         return m_is_modified;
     }
 
+    const notespans & note_spans () const
+    {
+        return m_note_spans;
+    }
+
+    bool note_spans_valid () const
+    {
+        return m_note_spans.valid(m_events.size());
+    }
+
+    unsigned changes () const
+    {
+        return m_changes;
+    }
+
     bool has_tempo () const
     {
         return m_has_tempo;
@@ -369,6 +482,7 @@ public:
     event::iterator remove (event::iterator ie)
     {
         event::iterator result = m_events.erase(ie);
+        invalidate_indexes();
         m_is_modified = true;
         return result;
     }
@@ -413,7 +527,49 @@ public:
 private:                                /* internal quantization functions  */
 
     bool add (event::buffer & evlist, const event & e);
+    bool appended ();
+    bool linkable (const event & e, int & on, bool & found);
+    void link_appended (int on, bool found, midipulse slength);
     void merge (const event::buffer & evlist);
+    void merge_runs (std::size_t oldsize);
+    static void sort_events (event::buffer & evlist);
+    static void merge_sorted_runs (event::buffer & evlist);
+    static void key_sort (event::buffer & evlist);
+
+    void invalidate_indexes ()
+    {
+        m_note_spans.invalidate();
+        m_note_grid.invalidate();
+        ++m_changes;
+    }
+
+    /**
+     *  Removes all of the events that pass the test in one pass, instead of
+     *  erasing them one at a time, each erasure moving all of the events
+     *  after it.  The links of the remaining events are then stale, so the
+     *  caller must call verify_and_link().
+     *
+     * \param test
+     *      A callable taking a const event reference, and returning true if
+     *      the event is to be removed.
+     *
+     * \return
+     *      Returns true if at least one event was removed.
+     */
+
+    template <typename P>
+    bool remove_if (P test)
+    {
+        auto it = std::remove_if(m_events.begin(), m_events.end(), test);
+        bool result = it != m_events.end();
+        if (result)
+        {
+            m_events.erase(it, m_events.end());
+            invalidate_indexes();
+            m_is_modified = true;
+        }
+        return result;
+    }
 
 private:                                /* functions for friend sequence    */
 
@@ -428,6 +584,12 @@ private:                                /* functions for friend sequence    */
     void scan_meta_events ();
 #endif
     bool verify_and_link (midipulse slength = 0, bool wrap = false);
+    bool append_linked (const event & e, midipulse slength = 0);
+    bool append_linked (event && e, midipulse slength = 0);
+    bool insert_note
+    (
+        const event & eon, const event & eoff, midipulse slength = 0
+    );
     bool edge_fix (midipulse snap, midipulse seqlength);
     bool remove_unlinked_notes ();
     bool quantize_events
@@ -515,11 +677,11 @@ private:                                /* functions for friend sequence    */
     (
         midipulse & first, midipulse & last
     ) const;
-    bool rescale (int oldppqn, int newppqn);
+    bool rescale (int newppqn, int oldppqn);
     bool stretch_selected (midipulse delta);
     bool grow_selected (midipulse delta, int snap);
     bool copy_selected (eventlist & clipbd);
-    bool paste_selected (eventlist & clipbd, midipulse tick, int note);
+    bool paste_selected (const eventlist & clipbd, midipulse tick, int note);
     midipulse trim_timestamp (midipulse t) const;
     midipulse clip_timestamp
     (
@@ -547,6 +709,83 @@ private:                                /* functions for friend sequence    */
 
 };          // class eventlist
 
+/**
+ *  Provides the undo and redo stacks of a sequence.  It has the std::stack
+ *  interface used by sequence, but stores only the newest event list in
+ *  full.  Each older list is stored as the range of events in which it
+ *  differs from the list pushed after it.  The ranges found are the common
+ *  leading and trailing events.  So an edit of a few nearby events in a
+ *  big pattern costs only those events.  The oldest entries are dropped to
+ *  keep memory within usr().undo_limit().
+ */
+
+class eventstack
+{
+
+private:
+
+    /**
+     *  An entry in the stack.  If "full" is false, list.m_events holds only
+     *  the events that differ from the next newer entry, which has
+     *  "prefix" events in common at the start and "suffix" events in
+     *  common at the end.
+     */
+
+    struct entry
+    {
+        eventlist list;
+        std::size_t prefix;
+        std::size_t suffix;
+        bool full;
+    };
+
+    /**
+     *  The entries, oldest first.  The last one is full.
+     */
+
+    std::deque<entry> m_entries;
+
+    /**
+     *  The approximate number of bytes held by the events in m_entries.
+     */
+
+    std::size_t m_bytes;
+
+public:
+
+    eventstack ();
+
+    bool empty () const
+    {
+        return m_entries.empty();
+    }
+
+    std::size_t size () const
+    {
+        return m_entries.size();
+    }
+
+    const eventlist & top () const
+    {
+        return m_entries.back().list;
+    }
+
+    void push (const eventlist & evl);
+    void pop ();
+
+    std::size_t bytes () const
+    {
+        return m_bytes;
+    }
+
+private:
+
+    static bool same (const event & e1, const event & e2);
+    static std::size_t bytes (const entry & ent);
+    void trim ();
+
+};          // class eventstack
+
 }           // namespace seq66
 
 #endif      // SEQ66_EVENTLIST_HPP
@@ -0,0 +1,126 @@
+#if ! defined SEQ66_FILEBENCH_HPP
+#define SEQ66_FILEBENCH_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          filebench.hpp
+ *
+ *  This module declares a measurement of the file loaders and writers, as
+ *  run by "seq66cli --file-bench".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A companion to the playback benchmark (see playbench.hpp).  Each file
+ *  is handled according to its extension:
+ *
+ *      -   MIDI and WRK files are read several times, then written (SMF
+ *          only) several times, and the written file is read back and
+ *          compared to the original.
+ *      -   Play-lists and 'rc' files are read several times.
+ *
+ *  If no files are given, a large synthetic SMF is generated and measured.
+ *  No ports are opened, and the performer is never launched.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Holds the options of a file benchmark and runs it.
+ */
+
+class filebench
+{
+
+private:
+
+    /**
+     *  The files to measure, one after the other.  If empty, a synthetic
+     *  song is measured.
+     */
+
+    std::vector<std::string> m_files;
+
+    /**
+     *  The number of patterns of the synthetic song.
+     */
+
+    int m_synthetic;
+
+    /**
+     *  The number of measures in each pattern of the synthetic song.
+     */
+
+    int m_measures;
+
+    /**
+     *  The number of times each file is read, and written.
+     */
+
+    int m_repeat;
+
+public:
+
+    filebench ();
+
+    static bool requested (int argc, char * argv []);
+    static void show_help ();
+
+    bool parse (int argc, char * argv []);
+    int run ();
+
+private:
+
+    bool make_synthetic (const std::string & fname);
+    bool measure_midi (const std::string & fname);
+    bool measure_playlist (const std::string & fname);
+    bool measure_config (const std::string & fname);
+    void report
+    (
+        const std::string & name, const std::string & what,
+        size_t bytes, double ns
+    ) const;
+    static long events_of (performer & p, int & patterns);
+    static long peak_rss_kb ();
+
+};          // class filebench
+
+}           // namespace seq66
+
+#endif      // SEQ66_FILEBENCH_HPP
+
+/*
+ * filebench.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,114 @@
+#if ! defined SEQ66_GUIBENCH_HPP
+#define SEQ66_GUIBENCH_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          guibench.hpp
+ *
+ *  This module declares the settings of the user-interface benchmark, as
+ *  run by "qseq66 --gui-bench".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The benchmark writes a large synthetic song, with the given numbers of
+ *  patterns, events, and song triggers, to a scratch file.  The main
+ *  window opens it, then plays it while scrolling and zooming the song and
+ *  pattern editors and flipping between the tabs, for the given number of
+ *  seconds.  The paint trace points (see perftrace.hpp) time each frame of
+ *  each window, and a summary of the frame times is printed at the end.
+ *
+ *  The option is "--gui-bench[=spec]", where the spec is a list such as
+ *  "patterns=256,events=1024,triggers=64,seconds=20".
+ */
+
+#include <string>                       /* std::string                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds the settings of the user-interface benchmark, and makes its song.
+ */
+
+class guibench
+{
+
+private:
+
+    bool m_active;                      /**< The --gui-bench option given.  */
+    int m_patterns;                     /**< The number of patterns.        */
+    int m_events;                       /**< The notes in each pattern.     */
+    int m_triggers;                     /**< The triggers of each pattern.  */
+    int m_seconds;                      /**< The duration of the script.    */
+
+public:
+
+    guibench ();
+
+    bool parse (const std::string & spec);
+    bool write_song (const std::string & fname) const;
+
+    bool active () const
+    {
+        return m_active;
+    }
+
+    int patterns () const
+    {
+        return m_patterns;
+    }
+
+    int events () const
+    {
+        return m_events;
+    }
+
+    int triggers () const
+    {
+        return m_triggers;
+    }
+
+    int seconds () const
+    {
+        return m_seconds;
+    }
+
+};          // class guibench
+
+extern guibench & gui_bench ();
+
+}           // namespace seq66
+
+#endif      // SEQ66_GUIBENCH_HPP
+
+/*
+ * guibench.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,158 @@
+#if ! defined SEQ66_INPUTFILTER_HPP
+#define SEQ66_INPUTFILTER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          inputfilter.hpp
+ *
+ *  This module declares a chain of filters applied to the messages of an
+ *  input buss as they arrive.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The counterpart of the outputfilter.  It is run by the MIDI backend
+ *  itself, in the JACK process callback or as the ALSA event is decoded,
+ *  before the message is queued for the input thread (or routed thru).  So
+ *  a message that is not wanted, such as the clock and active sensing that
+ *  some controllers send without end, costs no queue slot, no wake-up of
+ *  the input thread, and no look-up in the MIDI controls.
+ *
+ *  The stages are a flat array, made once from the text form.  apply() works
+ *  in place on the bytes of the message, and allocates nothing, so that it
+ *  can be called from the real-time thread.  The stages are:
+ *
+ *      -   channel:C or channel:C-D.  Passes only the channel messages on
+ *          channel C, or channels C to D, from 1 to 16.
+ *      -   notes:L-H.  Passes only the notes, and their polyphonic
+ *          aftertouch, from note number L to H, for a keyboard split.
+ *      -   curve:N.  Bends the Note On velocities through a power curve,
+ *          N percent (25 to 400): below 100 is softer to reach a loud
+ *          note, above 100 harder.  Made into a table when parsed.
+ *      -   noclock.  Drops the MIDI clock.  Do not use it on a buss that
+ *          the clock is followed from.
+ *      -   nosense.  Drops active sensing.
+ *
+ *  System messages, including SysEx, pass the first two stages as is.
+ *  A buss's filter comes from the [midi-input-filter] section of the 'rc'
+ *  file.
+ */
+
+#include <cstddef>                      /* std::size_t                      */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midibytes       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A chain of input filter stages.
+ */
+
+class inputfilter
+{
+
+public:
+
+    /**
+     *  The kinds of stages.
+     */
+
+    enum class stage
+    {
+        channel,                        /**< Values: channels, 0 to 15.     */
+        notes,                          /**< Values: the note range.        */
+        curve,                          /**< Uses the velocity table.       */
+        noclock,                        /**< Drops the MIDI clock.          */
+        nosense                         /**< Drops active sensing.          */
+    };
+
+private:
+
+    /**
+     *  One stage and its range.
+     */
+
+    class step
+    {
+
+    public:
+
+        stage fs_kind;                  /**< What the stage does.           */
+        int fs_low;                     /**< The low value, or the value.   */
+        int fs_high;                    /**< The high value.                */
+
+    };
+
+    /**
+     *  The stages, in the order they are applied.
+     */
+
+    std::vector<step> m_steps;
+
+    /**
+     *  The velocity for each velocity, made for a curve stage; empty if
+     *  there is none.  Only one curve is kept, the last one added.
+     */
+
+    midibytes m_curve_table;
+
+public:
+
+    inputfilter ();
+    inputfilter (const std::string & spec);
+
+    bool parse (const std::string & spec);
+    std::string to_string () const;
+    bool add (stage kind, int low = 0, int high = 0);
+    bool apply (midibyte * bytes, std::size_t count) const;
+
+    bool empty () const
+    {
+        return m_steps.empty();
+    }
+
+    void clear ()
+    {
+        m_steps.clear();
+        m_curve_table.clear();
+    }
+
+};          // class inputfilter
+
+}           // namespace seq66
+
+#endif      // SEQ66_INPUTFILTER_HPP
+
+/*
+ * inputfilter.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-23
- * \updates       2022-09-26
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class contains a number of functions that used to reside in the
@@ -40,6 +40,8 @@
 
 #if defined SEQ66_JACK_SUPPORT
 
+#include <atomic>                       /* std::atomic<> for engine hook    */
+
 #include <jack/jack.h>
 #include <jack/transport.h>
 
@@ -183,6 +185,48 @@ public:
         int alsa_nperiod;                       /* usually 2 or 3   */
     };
 
+    /**
+     *  For the JACK-driven engine ("output-scheduler = jack"), describes
+     *  how the ticks played in a process cycle map onto its frames, so that
+     *  each event can be written at its own frame offset.
+     */
+
+    using engine_window = struct
+    {
+        double ew_start_tick;                   /* tick at frame 0  */
+        double ew_ticks_per_frame;              /* tempo, in frames */
+    };
+
+    /**
+     *  The JACK-driven engine hook.  Called at the start of each JACK MIDI
+     *  process cycle to play the patterns for that cycle.  Returns false if
+     *  nothing was played.
+     */
+
+    using engine_function = bool (*)
+    (
+        void * arg,
+        jack_nframes_t nframes,
+        jack_nframes_t rate,
+        engine_window & window
+    );
+
+    /**
+     *  For "jack-period-sync", the transport position at the start of the
+     *  latest JACK period, as found by the process callback.  The tick of
+     *  any later moment is pm_tick plus the frames since pm_frame_time
+     *  times pm_ticks_per_frame.  See publish_period().
+     */
+
+    using period_map = struct
+    {
+        jack_nframes_t pm_frame_time;           /* the period's start   */
+        jack_nframes_t pm_frame;                /* transport frame      */
+        double pm_tick;                         /* MIDI tick at start   */
+        double pm_ticks_per_frame;              /* the tempo, in frames */
+        jack_transport_state_t pm_state;        /* rolling, etc.        */
+    };
+
 private:
 
     /**
@@ -200,6 +244,18 @@ private:
 
     static parameters sm_jack_parameters;
 
+    /**
+     *  The JACK-driven engine hook, its argument (the performer), and a
+     *  count of JACK MIDI process cycles, which tells the performer that a
+     *  JACK MIDI client is active and will call the hook.  The function is
+     *  published after the argument, so a non-null function always has a
+     *  valid argument.
+     */
+
+    static std::atomic<engine_function> sm_engine_function;
+    static void * sm_engine_arg;
+    static std::atomic<unsigned> sm_process_cycles;
+
     /**
      *  Provides the performer object that needs this JACK assistant/scratchpad
      *  class.
@@ -342,6 +398,31 @@ private:
 
     midibpm m_beats_per_minute;
 
+    /**
+     *  The latest period map, and its sequence count, which is odd while the
+     *  process callback is writing it.  A reader copies the map and retries
+     *  if the count changed meanwhile (a sequence lock), so neither side
+     *  ever waits.  The count is 0 until the first period is published.
+     */
+
+    period_map m_period;
+    std::atomic<unsigned> m_period_sequence;
+
+    /**
+     *  Set from rc().jack_period_sync() when JACK is initialized.
+     */
+
+    bool m_period_sync;
+
+    /**
+     *  The latest transport frame asked for by position(), or -1.  The
+     *  process callback locates the transport to it, once a period, so
+     *  that a burst of seeks while scrubbing makes one JACK request per
+     *  period, to the last target, rather than one each.
+     */
+
+    std::atomic<long> m_locate_frame;
+
 public:
 
     jack_assistant
@@ -360,6 +441,18 @@ public:
         int alsanperiod = 0
     );
     static const parameters & get_jack_parameters ();
+    static void engine (engine_function f, void * arg);
+    static bool run_engine
+    (
+        jack_nframes_t nframes,
+        jack_nframes_t rate,
+        engine_window & window
+    );
+
+    static bool engine_available ()
+    {
+        return sm_process_cycles.load() > 0;
+    }
 
     performer & parent ()       /* getter needed for external callbacks.    */
     {
@@ -468,6 +561,12 @@ public:
     void position (bool state, midipulse tick = 0);
     bool output (jack_scratchpad & pad);
 
+private:
+
+    void apply_locate ();
+
+public:
+
     /**
      * \setter m_ppqn
      *      For the future, changing the PPQN internally.  We should consider
@@ -597,6 +696,12 @@ private:
     jack_client_t * client_open (const std::string & clientname);
     void get_jack_client_info ();
     long current_jack_position () const;
+    void publish_period
+    (
+        const jack_position_t & pos, jack_transport_state_t state
+    );
+    bool period_position (double & tick, jack_transport_state_t & state) const;
+    bool output_period (jack_scratchpad & pad);
 
 #if defined SEQ66_USE_JACK_SYNC_CALLBACK
     int sync (jack_transport_state_t state = (jack_transport_state_t)(-1));
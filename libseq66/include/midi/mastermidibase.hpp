@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-23
- * \updates       2023-12-03
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The mastermidibase module is the base-class version of the mastermidibus
@@ -36,10 +36,15 @@
  *  PortMidi.
  */
 
+#include <atomic>                       /* std::atomic<long>                */
+#include <mutex>                        /* std::unique_lock<>               */
+#include <shared_mutex>                 /* std::shared_timed_mutex          */
 #include <vector>                       /* for channel-filtered recording   */
 
 #include "midi/businfo.hpp"             /* seq66::businfo & busarray        */
-#include "midi/midibase.hpp"            /* seq66::midibase::io & recmutex   */
+#include "midi/midibase.hpp"            /* seq66::midibase::io              */
+#include "midi/recordroutes.hpp"        /* seq66::recordroutes table        */
+#include "midi/sysexstream.hpp"         /* seq66::sysexstream large SysEx   */
 #include "play/clockslist.hpp"          /* list of seq66::e_clock settings  */
 #include "play/inputslist.hpp"          /* list of boolean input settings   */
 
@@ -163,6 +168,14 @@ protected:
 
     bool m_record_by_channel;
 
+    /**
+     *  The record-by-channel routing table, built from m_vector_sequence
+     *  whenever it or a recording pattern's channel changes, and read by
+     *  dump_midi_input() via std::atomic_load().  Null if empty.
+     */
+
+    recordroutes::pointer m_record_routes;
+
     /**
      *  Points to the sequence object.  Set in set_sequence_input().  See that
      *  function's description.
@@ -171,11 +184,58 @@ protected:
     sequence * m_seq;
 
     /**
-     *  The locking mutex.  This object is passed to an automutex object that
-     *  lends exception-safety to the mutex locking.
+     *  The locking mutex.  Sending output (play(), flush(), sysex(),
+     *  emit_clock(), and the like) takes it shared, so that the output
+     *  thread, MIDI thru, and the control-output paths do not wait on one
+     *  another; each bus is serialized by its own midibase mutex, and an
+     *  API whose ports share one handle (ALSA) serializes that handle
+     *  itself.  Changes to the ports, the clocks, the inputs, the transport,
+     *  or the recording setup take it exclusive.  It is not recursive, so a
+     *  function holding it must not call another one that locks it.
      */
 
-    recmutex m_mutex;
+    std::shared_timed_mutex m_mutex;
+    using sharedlock = std::shared_lock<std::shared_timed_mutex>;
+    using exclusivelock = std::unique_lock<std::shared_timed_mutex>;
+
+    /**
+     *  The number of events sent by play() and play_and_flush(), so that the
+     *  output thread can count the events in each frame.
+     */
+
+    std::atomic<long> m_play_count;
+
+    /**
+     *  If true, nothing is sent out:  no events, SysEx, clock, or start and
+     *  stop messages.  The busses and the playback go on as usual.  Set for
+     *  a mirroring replica, a hot spare standing by until the primary fails;
+     *  see performer::mirror_takeover().
+     */
+
+    std::atomic<bool> m_standby;
+
+    /**
+     *  The same count for each output buss, for the metrics of the
+     *  throughput of each buss.
+     */
+
+    std::atomic<long> m_bus_play_counts[c_busscount_max];
+
+    /**
+     *  Indicates that the 'rc' file has [midi-thru] routes, so that
+     *  get_midi_event() can skip looking them up otherwise.
+     */
+
+    const bool m_thru_routed;
+
+    /**
+     *  The large SysEx messages being sent, a chunk at a time, by
+     *  pump_sysex().  They have their own lock, since sysex() and
+     *  pump_sysex() hold m_mutex only shared.
+     */
+
+    std::vector<sysexstream> m_sysex_streams;
+    std::mutex m_sysex_mutex;
 
 public:
 
@@ -235,6 +295,7 @@ public:
     void record_by_channel (bool flag)
     {
         m_record_by_channel = flag;
+        rebuild_record_routes();
     }
 
     midibpm get_beats_per_minute () const
@@ -266,16 +327,64 @@ public:
     void stop ();
     void port_start (int client, int port);
     void port_exit (int client, int port);
+    void route_thru (event * ev);
+    bool port_restart
+    (
+        int client, int port,
+        const std::string & busname, const std::string & portname
+    );
     void play (bussbyte bus, event * e24, midibyte channel);
     void play_and_flush (bussbyte bus, event * e24, midibyte channel);
+    void play_batch (bussbyte bus, const batchevent * evs, int count);
+    void retract (bussbyte bus, midibyte tag);
+    bool buffer_stats (int & size, int & highwater, int & dropped);
+    bool input_buffer_stats (int & size, int & highwater, int & dropped);
+
+    long play_count () const
+    {
+        return m_play_count.load(std::memory_order_relaxed);
+    }
+
+    bool standby () const
+    {
+        return m_standby.load(std::memory_order_relaxed);
+    }
+
+    void standby (bool flag)
+    {
+        m_standby.store(flag, std::memory_order_relaxed);
+    }
+
+    long play_count (bussbyte bus) const
+    {
+        return int(bus) < c_busscount_max ?
+            m_bus_play_counts[bus].load(std::memory_order_relaxed) : 0 ;
+    }
+
     void sysex (bussbyte bus, const event * event);
+    bool pump_sysex ();
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
     void emit_clock (midipulse tick);
     void print () const;
     void flush ();
+
+    /**
+     *  Tells the MIDI API the tick of the output frame about to be played.
+     *  Lock-free, as it is called by the output thread every frame.  The
+     *  tick has a fraction, the exact play position, so that an API that
+     *  schedules ahead can place each event (in particular, each clock
+     *  pulse) to the microsecond, rather than to the tick.
+     */
+
+    void frame_tick (double tick)
+    {
+        api_frame_tick(tick);
+    }
+
     void panic (int displaybuss = c_bussbyte_max);          /* kepler34 func  */
-    bool dump_midi_input (event in);                        /* seq32 function */
+    bool dump_midi_input (event & ev);                      /* seq32 function */
+    void rebuild_record_routes ();
     std::string get_midi_bus_name (bussbyte bus, midibase::io iotype) const;
 
     void set_midi_alias
@@ -300,9 +409,16 @@ public:
     bool set_sequence_input (bool state, sequence * seq);
     bool is_more_input ();
 
+private:
+
+    void build_record_routes ();
+
+public:
+
     /**
-     *  Grab a MIDI event via the currently-selected MIDI API.
-     *  No locking, so we make it an inline function.
+     *  Grab a MIDI event via the currently-selected MIDI API, and send it
+     *  along any [midi-thru] route the API does not handle itself.  No
+     *  locking, so we make it an inline function.
      *
      * \param ev
      *      The event to be set based on the found input event.
@@ -310,7 +426,11 @@ public:
 
     bool get_midi_event (event * in)
     {
-        return api_get_midi_event(in);
+        bool result = api_get_midi_event(in);
+        if (result && m_thru_routed && ! api_routes_thru())
+            route_thru(in);
+
+        return result;
     }
 
     e_clock get_clock (bussbyte bus) const;
@@ -425,6 +545,16 @@ protected:
         // no code for base or portmidi
     }
 
+    /**
+     *  Provides MIDI API-specific functionality for the frame_tick()
+     *  function.
+     */
+
+    virtual void api_frame_tick (double /* tick */)
+    {
+        // no code for base or portmidi
+    }
+
     /**
      *  Provides MIDI API-specific functionality for the clock() function.
      */
@@ -442,6 +572,16 @@ protected:
     virtual bool api_get_midi_event (event * inev) = 0;
     virtual int api_poll_for_midi ();
 
+    /**
+     *  Indicates that the API sends the [midi-thru] routes itself, in its
+     *  input callback, as JACK does.
+     */
+
+    virtual bool api_routes_thru () const
+    {
+        return false;
+    }
+
 /*
  *  So far, there is no need for these API-specific functions.
  *
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-24
- * \updates       2021-06-10
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Seq66 can also split an SMF 0 file into multiple tracks, effectively
@@ -109,13 +109,18 @@ public:
 
 private:
 
-    bool split_channel
+    void setup_channel
     (
         const performer & p,
         const sequence & main_seq,
         sequence * seq,
         int channel
     );
+    void split_events
+    (
+        const sequence & main_seq,
+        sequence * seqs []
+    );
 
 };          // class midi_splitter
 
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-11
- * \updates       2021-10-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This implementation attempts to avoid the reversals that can occur using
@@ -95,6 +95,16 @@ public:
         return unsigned(m_char_vector.size());
     }
 
+    /**
+     * \return
+     *      Returns the bytes of the container, for copying them in bulk.
+     */
+
+    const midibyte * data () const
+    {
+        return m_char_vector.data();
+    }
+
     /**
      *  For iterating through the data in the MIDI vector, we are done when
      *  we've gotten the last element of the container.
@@ -147,6 +157,15 @@ public:
         m_char_vector.clear();
     }
 
+    /**
+     *  Frees the container's memory, once its bytes have been copied out.
+     */
+
+    void release ()
+    {
+        bytes().swap(m_char_vector);
+    }
+
 };
 
 }           // namespace seq66
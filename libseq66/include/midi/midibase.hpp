@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-24
- * \updates       2023-05-14
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The midibase module is the new base class for the various implementations
@@ -37,6 +37,9 @@
 
 #include "midi/midibus_common.hpp"      /* values and e_clock enumeration   */
 #include "midi/midibytes.hpp"           /* seq66::midibyte alias            */
+#include "midi/event.hpp"               /* seq66::event class               */
+#include "midi/inputfilter.hpp"         /* seq66::inputfilter class         */
+#include "midi/outputfilter.hpp"        /* seq66::outputfilter class        */
 #include "util/automutex.hpp"           /* seq66::recmutex recursive mutex  */
 #include "util/basic_macros.h"          /* not_nullptr() macro              */
 
@@ -48,7 +51,31 @@
 
 namespace seq66
 {
-    class event;
+
+/**
+ *  An event and the channel it is to be played on, as gathered for one
+ *  buss by the output thread during a frame (see framebatch), so that the
+ *  buss is locked and written to once per frame instead of once per event.
+ */
+
+class batchevent
+{
+
+public:
+
+    event be_event;                     /**< The event, timestamped.        */
+    midibyte be_channel;                /**< The channel to play it on.     */
+    midibyte be_tag;                    /**< The pattern's tag, 0 if none.  */
+
+    batchevent (const event & ev, midibyte channel, midibyte tag = 0) :
+        be_event    (ev),
+        be_channel  (channel),
+        be_tag      (tag)
+    {
+        // no code
+    }
+
+};
 
 /**
  *  This class implements with ALSA version of the midibase object.
@@ -241,6 +268,23 @@ private:
 
     port m_port_type;
 
+    /**
+     *  The output filter of an output port, from the [midi-output-filter]
+     *  section of the 'rc' file, run over each message played on the port,
+     *  after the filter of the pattern.  Guarded by m_mutex.
+     */
+
+    outputfilter m_output_filter;
+
+    /**
+     *  The input filter of an input port, from the [midi-input-filter]
+     *  section of the 'rc' file.  It is run by the backend as messages
+     *  arrive, so it is set only at creation, and never changed while the
+     *  port is open.
+     */
+
+    inputfilter m_input_filter;
+
     /**
      *  Locking mutex. This one is based on std:::recursive_mutex.
      */
@@ -505,16 +549,39 @@ public:
     }
 
     void play (const event * e24, midibyte channel);
+    void play_batch (const batchevent * evs, int count);
+    void retract (midibyte tag);
+    bool output_filter (const std::string & spec);
+    std::string output_filter () const;
+
+    const inputfilter & input_filter () const
+    {
+        return m_input_filter;
+    }
+
+    /**
+     *  Tells the API that it may use running status, if it builds its own
+     *  byte stream.  Called by api_play(), with m_mutex held.
+     */
+
+    bool running_status () const
+    {
+        return m_output_filter.has(outputfilter::stage::running);
+    }
+
     void sysex (const event * e24);
+    void sysex_chunk (const midibyte * data, int len);
+    bool buffer_stats (int & size, int & highwater, int & dropped);
     void flush ();
     void start ();
     void stop ();
-    void clock (midipulse tick);
+    midipulse clock (midipulse tick);
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
     void print ();
     bool set_input (bool inputing);
     bool initialize (bool initdisabled);
+    bool reconnect (int bus, int port);
 
 private:
 
@@ -633,6 +700,29 @@ public:
 
     virtual void api_play (const event * e24, midibyte channel) = 0;
 
+    /**
+     *  Plays a batch of events.  An API that can write them all at once,
+     *  such as JACK, overrides this function.
+     */
+
+    virtual void api_play_batch (const batchevent * evs, int count)
+    {
+        for (int i = 0; i < count; ++i)
+            api_play(&evs[i].be_event, evs[i].be_channel);
+    }
+
+    /**
+     *  Takes back the events with the given pattern tag that have not yet
+     *  been sent, except the Note Offs.  Only an API that holds events
+     *  ahead of their time, such as ALSA with "alsa-lookahead", has any to
+     *  take back.
+     */
+
+    virtual void api_retract (midibyte /* tag */)
+    {
+        // no code
+    }
+
     /**
      *  Handles implementation details for SysEx messages.
      *
@@ -644,6 +734,8 @@ public:
         // no code for portmidi
     }
 
+    virtual void api_sysex_chunk (const midibyte * data, int len);
+
     /**
      *  Handles implementation details for the flush() function.
      */
@@ -653,6 +745,34 @@ public:
         // no code for portmidi
     }
 
+    /**
+     *  Gets the size, the high-water mark, and the number of dropped items
+     *  of the port's output buffer, if the API has one.  Used in the JACK
+     *  implementation.
+     *
+     * \return
+     *      Returns false if there is no output buffer.
+     */
+
+    virtual bool api_buffer_stats
+    (
+        int & /* size */, int & /* highwater */, int & /* dropped */
+    )
+    {
+        return false;
+    }
+
+    /**
+     *  Connects the already-initialized port to a system port that has come
+     *  back, without creating a new port.  Not supported in the PortMidi
+     *  implementation.
+     */
+
+    virtual bool api_reconnect ()
+    {
+        return false;
+    }
+
 protected:
 
     virtual bool api_init_in () = 0;
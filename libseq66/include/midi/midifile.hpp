@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-05-20
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The Seq24 MIDI file is a standard, Format 1 MIDI file, with some extra
@@ -43,13 +43,14 @@
  *  converting it to SMF 1.
  */
 
+#include <functional>
 #include <string>
-#include <list>
 #include <vector>
 
 #include "cfg/rcsettings.hpp"           /* enum class rsaction              */
 #include "midi/midibytes.hpp"           /* midishort, midibyte, etc.        */
 #include "midi/midi_splitter.hpp"       /* seq66::midi_splitter             */
+#include "os/mappedfile.hpp"            /* seq66::mappedfile                */
 #include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
 
 /*
@@ -87,6 +88,23 @@ public:
         export_midi
     };
 
+    /**
+     *  The outcome of parsing one track.  Anything but "ok" ends the reading
+     *  of tracks:  "failed" fails the parse, "seqspec" means the track is the
+     *  Seq66 SeqSpec track, "abort" means a bad event was found with
+     *  running-status action "abort", and "stop" means the file ended early
+     *  with that action.
+     */
+
+    enum class trackstatus
+    {
+        ok,
+        failed,
+        seqspec,
+        abort,
+        stop
+    };
+
     static const std::string sm_meta_text_labels[8];
 
 private:
@@ -147,11 +165,19 @@ private:
      *  Holds the position in the MIDI file.  This is at least a 31-bit
      *  value in the recent architectures running Linux and Windows, so it
      *  will handle up to 2 Gb of data.  This member is used as the offset
-     *  into the m_data vector.
+     *  into the m_data array.
      */
 
     size_t m_pos;
 
+    /**
+     *  The offset just past the SeqSpec section being parsed, from its
+     *  length, or 0 if the section has no length (the old format).  See
+     *  parse_seqspec_header().
+     */
+
+    size_t m_seqspec_end;
+
     /**
      *  The unchanging name of the MIDI file.
      */
@@ -159,24 +185,29 @@ private:
     const std::string m_name;
 
     /**
-     *  This vector of characters holds our MIDI data.  We could also use
-     *  a string of characters, unsigned.  This member is resized to the
-     *  putative size of the MIDI file, in the parse() function.  Then the
-     *  whole file is read into it, as if it were an array.  This member is an
-     *  input buffer.
+     *  Holds our MIDI data, the whole file.  It is memory-mapped where
+     *  possible, so that parsing reads the file in place, with no copy.
+     *  Otherwise the file is read into a buffer.  See grab_input_stream().
+     */
+
+    mappedfile m_input;
+
+    /**
+     *  The start of the MIDI data, m_input.data(), to be read as an array of
+     *  m_file_size bytes.  It is null until grab_input_stream() succeeds.
      */
 
-    std::vector<midibyte> m_data;
+    const midibyte * m_data;
 
     /**
-     *  Provides a list of characters.  The class pushes each MIDI byte into
-     *  this list using the write_byte() function.  Also note that the write()
-     *  function calls sequence::fill_list() to fill a temporary
-     *  std::list<char> (!) buffer, then writes that data <i> backwards </i> to
-     *  this member.  This member is an output buffer.
+     *  Provides the output buffer.  The class appends each MIDI byte to it
+     *  using the write_byte() function, and write_track() appends a whole
+     *  track at once.  The write() functions reserve the full size of the
+     *  file up front, then write the buffer to the file in one call; see
+     *  write_buffer().
      */
 
-    std::list<midibyte> m_char_list;
+    std::vector<midibyte> m_char_list;
 
     /**
      *  Indicates to store the new key, scale, and background
@@ -216,6 +247,21 @@ private:
 
     midi_splitter m_smf0_splitter;
 
+    /**
+     *  Set by parse_detached(), so that the tracks are kept in
+     *  m_detached_tracks instead of being installed, and the performer is
+     *  left alone.
+     */
+
+    bool m_detached;
+
+    /**
+     *  The sequences read by parse_detached(), each holding its number in
+     *  the file as its seq_number().  Owned until move_detached().
+     */
+
+    std::vector<sequence *> m_detached_tracks;
+
 public:
 
     midifile
@@ -234,6 +280,12 @@ public:
     );
     virtual bool write (performer & p, bool doseqspec = true);
 
+    bool parse_detached (performer & p);
+    void move_detached (int offset, std::vector<sequence *> & dest);
+
+    bool encode (performer & p, bool doseqspec = true);
+    bool write_encoded ();
+
     bool write_song (performer & p);
 
     const std::string & error_message () const
@@ -286,6 +338,26 @@ public:
 
 protected:
 
+    size_t data_size () const
+    {
+        return m_file_size;
+    }
+
+    /**
+     *  Limits the reading of the data, so that an image embedded in other
+     *  data can be parsed.  Used by midijournal.
+     */
+
+    void data_size (size_t sz)
+    {
+        m_file_size = sz;
+    }
+
+    std::vector<midibyte> & char_list ()
+    {
+        return m_char_list;
+    }
+
     virtual sequence * create_sequence (performer & p);
     virtual bool finalize_sequence
     (
@@ -336,8 +408,26 @@ protected:
     }
 
     bool grab_input_stream (const std::string & tag);
+    bool parse_data (performer & p, int screenset, bool importing);
     bool parse_smf_0 (performer & p, int screenset);
     bool parse_smf_1 (performer & p, int screenset, bool is_smf0 = false);
+    trackstatus parse_track
+    (
+        performer & p, sequence & s, midishort trk,
+        size_t track_position, bool is_smf0, midishort & seqnum
+    );
+    void install_track
+    (
+        performer & p, sequence * sp, midishort seqnum,
+        int screenset, bool is_smf0
+    );
+    std::vector<size_t> scan_tracks (midishort track_count) const;
+    void share_input (const midifile & source, size_t pos);
+    bool parse_tracks_parallel
+    (
+        performer & p, int screenset,
+        const std::vector<size_t> & offsets, bool & result
+    );
 
     midilong parse_seqspec_header (int file_size);
     bool parse_seqspec_track (performer & p, int file_size);
@@ -347,12 +437,6 @@ protected:
     bool parse_c_notes (performer & p);
     bool parse_c_bpmtag (performer & p);
     bool parse_c_mutegroups (performer & p);
-    bool parse_c_mutegroups_legacy
-    (
-        performer & p,
-        unsigned groupcount,
-        unsigned groupsize
-    );
     bool parse_c_musickey ();
     bool parse_c_musicscale ();
     bool parse_c_backsequence ();
@@ -367,8 +451,57 @@ protected:
     midilong read_long ();
     midilong read_split_long (unsigned & highbytes, unsigned & lowbytes);
     midishort read_short ();
-    midibyte read_byte ();
-    midilong read_varinum ();
+    midibyte read_end ();
+    midilong read_varinum_tail (midilong result);
+
+    /**
+     *  Reads 1 byte of data directly from the m_data array, incrementing
+     *  m_pos after doing so.  Inline, as it is called for nearly every
+     *  byte of the file.
+     *
+     * \return
+     *      Returns the byte that was read.  Returns 0 if past the end of the
+     *      data, though there's no way for the caller to determine if this
+     *      is an error or a good value.  See read_end().
+     */
+
+    midibyte read_byte ()
+    {
+        return m_pos < m_file_size ? m_data[m_pos++] : read_end() ;
+    }
+
+    /**
+     *  Reads a MIDI Variable-Length Value (VLV).  Each byte supplies 7 bits,
+     *  and bit 7 is set in all but the last byte.  Nearly all values, such
+     *  as delta times and Meta lengths, are one or two bytes long, and are
+     *  decoded here without bounds checks on each byte.  Longer values, and
+     *  values at the end of the data, are finished by read_varinum_tail().
+     *
+     * \return
+     *      Returns the accumulated values as a single number.
+     */
+
+    midilong read_varinum ()
+    {
+        if (m_pos + 2 <= m_file_size)
+        {
+            midibyte c = m_data[m_pos];
+            if ((c & 0x80) == 0x00)
+            {
+                ++m_pos;
+                return midilong(c);
+            }
+
+            midibyte c1 = m_data[m_pos + 1];
+            if ((c1 & 0x80) == 0x00)
+            {
+                m_pos += 2;
+                return (midilong(c & 0x7F) << 7) + midilong(c1);
+            }
+        }
+        return read_varinum_tail(0);
+    }
+
     bool read_byte_array (midibyte * b, size_t len);
     bool read_byte_array (midistring & b, size_t len);
     bool read_string (std::string & b, size_t len);
@@ -382,7 +515,8 @@ protected:
 
     midibyte peek (size_t ahead = 0) const
     {
-        return m_data[m_pos + ahead];
+        size_t p = m_pos + ahead;
+        return p < m_file_size ? m_data[p] : 0 ;
     }
 
     void skip (size_t sz)                       /* compare to read_gap()    */
@@ -404,7 +538,7 @@ protected:
     void write_short (midishort value);
 
     /**
-     *  Writes 1 byte.  The byte is written to the m_char_list member, using a
+     *  Writes 1 byte.  The byte is appended to the m_char_list member, using a
      *  call to push_back().
      *
      * \param c
@@ -418,6 +552,24 @@ protected:
 
     void write_varinum (midilong);
     void write_track (const midi_vector & lst);
+    void reserve_tracks (const std::vector<midi_vector> & tracks);
+    bool fill_song_tracks
+    (
+        std::vector<midi_vector> & tracks,
+        const std::vector<int> & numbers
+    );
+    void fill_seq_tracks
+    (
+        std::vector<midi_vector> & tracks,
+        const std::vector<int> & numbers,
+        const performer & p, bool doseqspec
+    );
+    bool fill_tracks
+    (
+        size_t count,
+        const std::function<bool (size_t)> & fillone
+    );
+    bool write_buffer (const std::string & failmsg);
     void write_track_name (const std::string & trackname);
     void write_track_end ();
     std::string read_track_name ();
@@ -491,7 +643,8 @@ extern bool read_midi_file
     const std::string & fn,
     int ppqn,
     std::string & errmsg,
-    bool addtorecent = true
+    bool addtorecent = true,
+    const std::vector<int> & wrktracks = std::vector<int>()
 );
 extern bool write_midi_file
 (
@@ -499,6 +652,13 @@ extern bool write_midi_file
     const std::string & fn,
     std::string & errmsg
 );
+extern int import_midi_files
+(
+    performer & p,
+    const std::vector<std::string> & files,
+    int firstset,
+    std::string & errmsg
+);
 
 }           // namespace seq66
 
@@ -0,0 +1,158 @@
+#if ! defined SEQ66_MIDIJOURNAL_HPP
+#define SEQ66_MIDIJOURNAL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midijournal.hpp
+ *
+ *  This module declares the edit journal of a song, an append-only log of
+ *  the patterns changed since the song was saved.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The journal of "song.midi" is "song.midi.journal".  It is a series of
+ *  chunks, in the manner of an SMF, each a 4-byte tag, a 4-byte length, and
+ *  the data:
+ *
+ *      -   "MJnl": The header: the version, the PPQN of the records, and the
+ *          SMF format of the song.
+ *      -   "JSmf": A whole SMF image of the song, written by compact().
+ *          It replaces the song file as the base of the later records.
+ *      -   "JTrk": The number of a pattern, and its MTrk chunk, as it
+ *          would be saved in the song file.
+ *      -   "JDel": The number of a pattern that was deleted.
+ *      -   "JSsp": The Seq66 SeqSpec track (mute-groups, set names, etc.).
+ *
+ *  The records are whole patterns, each logged only if its edit stamp (see
+ *  sequence::edit_stamp()) changed; the SeqSpec track is logged only if
+ *  its bytes changed.  So a write costs the size of the change, not of the
+ *  song.  Replaying the records over the song file, as read_midi_file() does
+ *  after a crash, gives the song as journaled.  A record cut short by the
+ *  crash is ignored.  When the journal grows large, compact() rewrites it as
+ *  one JSmf image.  Saving the song makes the journal obsolete, so the
+ *  savers discard() it.
+ */
+
+#include <map>                          /* std::map<>                       */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midifile.hpp"            /* seq66::midifile base class       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Writes and replays the edit journal of one song.
+ */
+
+class midijournal final : public midifile
+{
+
+private:
+
+    /**
+     *  The song file whose changes are journaled, and the journal file.
+     */
+
+    std::string m_song_name;
+    std::string m_journal_name;
+
+    /**
+     *  The edit stamp of each pattern number as last journaled (or saved).
+     */
+
+    std::map<int, unsigned> m_stamps;
+
+    /**
+     *  The SeqSpec track as last journaled.
+     */
+
+    std::vector<midibyte> m_seqspec;
+
+    /**
+     *  The size of the journal file, as far as this object knows.
+     */
+
+    size_t m_journal_size;
+
+public:
+
+    midijournal (const std::string & songname, int ppqn);
+    virtual ~midijournal ();
+
+    static std::string journal_name (const std::string & songname);
+    static bool pending (const std::string & songname);
+    static bool discard (const std::string & songname);
+
+    const std::string & song_name () const
+    {
+        return m_song_name;
+    }
+
+    size_t journal_size () const
+    {
+        return m_journal_size;
+    }
+
+    void start (performer & p);
+    bool append (performer & p);
+    bool compact (performer & p);
+    bool replay (performer & p);
+
+private:
+
+    void current_state
+    (
+        performer & p,
+        std::map<int, unsigned> & stamps,
+        std::vector<midibyte> & seqspec
+    );
+    size_t begin_record (miditag tag);
+    void end_record (size_t start);
+    void write_journal_header (performer & p);
+    bool write_track_record (performer & p, int track);
+    bool append_buffer ();
+    bool replace_journal ();
+    void journal_timing (int journalppqn);
+    void replay_track (performer & p, size_t end);
+    bool replay_image (performer & p, size_t end);
+
+};          // class midijournal
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIDIJOURNAL_HPP
+
+/*
+ * midijournal.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,170 @@
+#if ! defined SEQ66_MODLANE_HPP
+#define SEQ66_MODLANE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          modlane.hpp
+ *
+ *  This module declares a modulation lane, a control or pitch-bend curve
+ *  that a pattern generates while it plays, rather than storing events.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The LFO window rewrites the data of the existing control events of a
+ *  pattern, so that the shape of the modulation is limited by the events
+ *  already there, and is lost once applied.  A modulation lane instead
+ *  holds the LFO parameters themselves (the wave, DC offset, range, speed,
+ *  and phase), and sequence::play() sends a value at each step of the lane
+ *  while the pattern plays.  Nothing is added to the event list, so the
+ *  lane can be changed or removed at any time, and costs only the few
+ *  bytes of a c_seq_modlanes SeqSpec in the MIDI file.
+ *
+ *  The lanes are copied into the playback snapshot (see the playevents
+ *  class), so that the output thread can play them without the mutex.
+ */
+
+#include "midi/calculations.hpp"        /* seq66::waveform, wave_func()     */
+#include "midi/event.hpp"               /* seq66::event, midibyte           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  One modulation lane of a pattern.
+ */
+
+class modlane
+{
+
+public:
+
+    /**
+     *  The default number of values sent per quarter note.  Sixteen is
+     *  smooth enough for most controls without flooding the port.
+     */
+
+    static const int c_steps_default = 16;
+
+    /**
+     *  The most lanes a pattern can have.
+     */
+
+    static const int c_lanes_max = 8;
+
+    /**
+     *  The number of bytes of one lane in the c_seq_modlanes SeqSpec:
+     *  status, controller, wave, and steps, one byte each, then the DC
+     *  offset and range (times 10) and the speed and phase (times 100), as
+     *  shorts.
+     */
+
+    static const int c_data_size = 12;
+
+private:
+
+    midibyte m_status;                  /**< Control or pitch, with channel. */
+    midibyte m_cc;                      /**< The controller, if a control.  */
+    waveform m_wave;                    /**< The shape of the modulation.   */
+    int m_steps;                        /**< Values sent per quarter note.  */
+    double m_dcoffset;                  /**< The center value, 0 to 127.    */
+    double m_range;                     /**< The depth, 0 to 127.           */
+    double m_speed;                     /**< Periods per pattern length.    */
+    double m_phase;                     /**< Phase shift, in periods.       */
+
+public:
+
+    modlane ();
+    modlane
+    (
+        midibyte status, midibyte cc, waveform w,
+        double dcoffset, double range, double speed, double phase,
+        int steps = c_steps_default
+    );
+
+    bool valid () const;
+    midipulse step_length (int ppqn) const;
+    int value (midipulse local, midipulse length) const;
+    void data (int value, midibyte & d0, midibyte & d1) const;
+
+    midibyte status () const
+    {
+        return m_status;
+    }
+
+    midibyte cc () const
+    {
+        return m_cc;
+    }
+
+    waveform wave () const
+    {
+        return m_wave;
+    }
+
+    int steps () const
+    {
+        return m_steps;
+    }
+
+    double dcoffset () const
+    {
+        return m_dcoffset;
+    }
+
+    double range () const
+    {
+        return m_range;
+    }
+
+    double speed () const
+    {
+        return m_speed;
+    }
+
+    double phase () const
+    {
+        return m_phase;
+    }
+
+    bool is_pitchbend () const
+    {
+        return event::is_pitchbend_msg(m_status);
+    }
+
+};          // class modlane
+
+}           // namespace seq66
+
+#endif      // SEQ66_MODLANE_HPP
+
+/*
+ * modlane.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
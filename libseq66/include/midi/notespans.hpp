@@ -0,0 +1,294 @@
+#if ! defined SEQ66_NOTESPANS_HPP
+#define SEQ66_NOTESPANS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          notespans.hpp
+ *
+ *  This module declares indexes of the notes of an event list, used to
+ *  find the notes sounding at a given tick, or lying in a rectangle of the
+ *  piano roll.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  When playback resumes in the middle of a pattern, or a trigger starts
+ *  partway into one, the notes that would already be sounding are sent
+ *  again.  Finding them used to mean walking every event of the pattern.
+ *  The index holds one span (start, end, event slot) per linked note,
+ *  sorted by start tick, as the events are, plus a binary tree holding the
+ *  latest end of the spans below each node.  A lookup then takes the spans
+ *  starting before the tick and descends only into the subtrees whose
+ *  latest end is past it, which is O(log n + k) for k sounding notes.
+ *
+ *  A note whose Note Off comes before its Note On wraps around the end of
+ *  the pattern, and is sounding from its start onward; it is given an
+ *  endless span.
+ *
+ *  The notegrid keeps one such index for each note number, so that the
+ *  rubber-band selection and hit-testing of the pattern editor look only
+ *  at the rows and ticks inside the rectangle, instead of at every event.
+ *
+ *  The eventlist builds the notespans at the end of verify_and_link(), and
+ *  the notegrid only when a selection needs it.  It drops both whenever the
+ *  events are added to, removed, or sorted.  The indexes hold slots in the
+ *  event vector, not pointers, but those slots are good only as long as
+ *  the eventlist left it alone.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event::buffer             */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  An interval index of the linked notes of an event buffer.
+ */
+
+class notespans
+{
+
+public:
+
+    /**
+     *  One linked note, or a range of ticks standing for an event.
+     */
+
+    class span
+    {
+
+    public:
+
+        midipulse ns_start;             /**< The tick of the Note On.       */
+        midipulse ns_end;               /**< The tick of the Note Off.      */
+        std::size_t ns_slot;            /**< The index of the event.        */
+
+    };
+
+private:
+
+    /**
+     *  The spans, sorted by start tick by finish().
+     */
+
+    std::vector<span> m_spans;
+
+    /**
+     *  The latest end tick of the spans under each node of the tree.  Node
+     *  1 is the root, covering all spans, and the children of node i are
+     *  2i and 2i + 1.  Node 0 is not used.
+     */
+
+    std::vector<midipulse> m_max_ends;
+
+    /**
+     *  The size of the event buffer when the index was built, used as a
+     *  sanity check when the index is used.
+     */
+
+    std::size_t m_event_count;
+
+    /**
+     *  Indicates that build() was called since the last invalidate().
+     */
+
+    bool m_valid;
+
+    /**
+     *  Indicates that build() found at least one wrapped note.
+     */
+
+    bool m_wrapped;
+
+public:
+
+    notespans ();
+
+    void build (const event::buffer & evlist);
+    void clear ();
+    void add (midipulse start, midipulse end, std::size_t slot);
+    void finish (std::size_t eventcount);
+
+    void invalidate ()
+    {
+        m_valid = false;
+    }
+
+    bool valid (std::size_t eventcount) const
+    {
+        return m_valid && m_event_count == eventcount;
+    }
+
+    std::size_t count () const
+    {
+        return m_spans.size();
+    }
+
+    bool wrapped () const
+    {
+        return m_wrapped;
+    }
+
+    std::size_t bytes () const
+    {
+        return m_spans.capacity() * sizeof(span) +
+            m_max_ends.capacity() * sizeof(midipulse);
+    }
+
+    /**
+     *  Calls the function for the slot of each note starting before the
+     *  tick and ending after it, in no particular order.
+     *
+     * \param tick
+     *      The tick, which is already reduced to the pattern length.
+     *
+     * \param f
+     *      A callable taking the std::size_t slot of the Note On.
+     */
+
+    template <typename F>
+    void sounding (midipulse tick, F f) const
+    {
+        overlapping(tick + 1, tick - 1, f);
+    }
+
+    /**
+     *  Calls the function for the slot of each span that starts at or
+     *  before the last tick and ends at or after the first tick.
+     *
+     * \param first
+     *      The first tick of the range.
+     *
+     * \param last
+     *      The last tick of the range.
+     *
+     * \param f
+     *      A callable taking the std::size_t slot of the span.
+     */
+
+    template <typename F>
+    void overlapping (midipulse first, midipulse last, F & f) const
+    {
+        std::size_t limit = first_after(last);
+        if (limit > 0)
+            descend(1, 0, m_spans.size(), limit, first, f);
+    }
+
+private:
+
+    std::size_t first_after (midipulse tick) const;
+    midipulse fill (std::size_t node, std::size_t lo, std::size_t hi);
+
+    template <typename F>
+    void descend
+    (
+        std::size_t node, std::size_t lo, std::size_t hi,
+        std::size_t limit, midipulse first, F & f
+    ) const
+    {
+        if (lo >= limit || m_max_ends[node] < first)
+            return;
+
+        if (hi - lo == 1)
+        {
+            f(m_spans[lo].ns_slot);
+        }
+        else
+        {
+            std::size_t mid = lo + (hi - lo) / 2;
+            descend(2 * node, lo, mid, limit, first, f);
+            descend(2 * node + 1, mid, hi, limit, first, f);
+        }
+    }
+
+};          // class notespans
+
+/**
+ *  An index of the note events of an event buffer for each note number.
+ *  Besides the linked notes, it holds the unlinked note events (including
+ *  Aftertouch), which eventlist::select_note_events() also looks at.
+ */
+
+class notegrid
+{
+
+private:
+
+    /**
+     *  The spans of each note number.
+     */
+
+    std::vector<notespans> m_rows;
+
+    /**
+     *  The size of the event buffer when the index was built.
+     */
+
+    std::size_t m_event_count;
+
+    /**
+     *  Indicates that build() was called since the last invalidate().
+     */
+
+    bool m_valid;
+
+public:
+
+    notegrid ();
+
+    void build (const event::buffer & evlist);
+    void candidates
+    (
+        const event::buffer & evlist,
+        midipulse tick_s, int note_h, midipulse tick_f, int note_l,
+        std::vector<std::size_t> & slots
+    ) const;
+
+    void invalidate ()
+    {
+        m_valid = false;
+    }
+
+    bool valid (std::size_t eventcount) const
+    {
+        return m_valid && m_event_count == eventcount;
+    }
+
+};          // class notegrid
+
+}           // namespace seq66
+
+#endif      // SEQ66_NOTESPANS_HPP
+
+/*
+ * notespans.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
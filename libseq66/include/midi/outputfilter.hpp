@@ -0,0 +1,230 @@
+#if ! defined SEQ66_OUTPUTFILTER_HPP
+#define SEQ66_OUTPUTFILTER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          outputfilter.hpp
+ *
+ *  This module declares a chain of filters applied to the channel messages
+ *  of a pattern or an output buss as they are sent.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Transposition, channel override, and note remapping used to be done at
+ *  scattered points of the output path, each with its own test.  An
+ *  outputfilter holds them as a flat array of stages, in the order given,
+ *  which apply() runs over the bytes of each message while the outgoing
+ *  event is being filled.  No copy of the event is made for the filter,
+ *  and an empty filter costs one test.
+ *
+ *  The stages are:
+ *
+ *      -   transpose:N.  Adds N semitones to the notes.  A note pushed out
+ *          of range is left as is, as with the performer's transpose.
+ *      -   velocity:P.  Scales the Note On velocities to P percent,
+ *          keeping them in the range 1 to 127.
+ *      -   channel:C.  Sends on channel C, from 1 to 16.
+ *      -   notemap.  Converts the notes through a table, such as the one
+ *          loaded from a note-map file.  It has no text form; the table is
+ *          set by note_table().
+ *      -   thin:D.  Drops a continuous message that differs from the
+ *          last one sent on the same lane by less than D.  The lanes are
+ *          each controller, each note's polyphonic aftertouch, the channel
+ *          pressure, and the pitch bend (whose D is scaled by 128) of each
+ *          channel.  The end values (and the pitch-bend center) are always
+ *          sent, so that a sweep reaches its ends.
+ *      -   rate:N.  Sends at most N messages a second on each lane,
+ *          dropping the others, except for the end values.  A sweep of the
+ *          mod wheel or aftertouch drawn densely in the data pane can
+ *          otherwise fill a 5-pin DIN port (about 1000 three-byte messages
+ *          a second) by itself.
+ *      -   dedup.  Drops a controller, program, pressure, or pitch-bend
+ *          message that repeats the last one sent on the same lane in the
+ *          same frame, as when two patterns on one channel send the same
+ *          value.  The frame is the batch of events of one output cycle,
+ *          which only a buss has, so this stage does nothing in the filter
+ *          of a pattern.
+ *      -   running.  Asks the port to use running status, leaving out the
+ *          status byte of a channel message that has the same status as
+ *          the one before it.  Only a port that builds its own byte stream
+ *          can do so, which is an RTP-MIDI port; ALSA and JACK always take
+ *          whole messages, and ignore it.
+ *
+ *  A pattern's filter is set with sequence::output_filter(), and a buss's
+ *  filter comes from the [midi-output-filter] section of the 'rc' file.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midibytes       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A chain of output filter stages.
+ */
+
+class outputfilter
+{
+
+public:
+
+    /**
+     *  The kinds of stages.
+     */
+
+    enum class stage
+    {
+        transpose,                      /**< Value: semitones, +/-.         */
+        velocity,                       /**< Value: percent of velocity.    */
+        channel,                        /**< Value: the channel, 0 to 15.   */
+        notemap,                        /**< Uses the note table.           */
+        thin,                           /**< Value: the least change.       */
+        rate,                           /**< Value: messages per second.    */
+        dedup,                          /**< Drops repeats in a frame.      */
+        running                         /**< Port uses running status.      */
+    };
+
+private:
+
+    /**
+     *  One stage and its parameter.
+     */
+
+    class step
+    {
+
+    public:
+
+        stage fs_kind;                  /**< What the stage does.           */
+        int fs_value;                   /**< The parameter of the stage.    */
+
+    };
+
+    /**
+     *  The stages, in the order they are applied.
+     */
+
+    std::vector<step> m_steps;
+
+    /**
+     *  The note table of a notemap stage; empty if there is none.
+     */
+
+    midibytes m_note_table;
+
+    /**
+     *  The last value sent on each lane (see lane()), used by a thin stage,
+     *  or -1 if none was sent.  Allocated only if there is a thin stage.
+     *  It is mutable, since it is altered by apply(), which only the output
+     *  thread calls.
+     */
+
+    mutable std::vector<int> m_last_values;
+
+    /**
+     *  The time, in microseconds, of the last message sent on each lane,
+     *  used by a rate stage, or 0 if none was sent.  Allocated only if
+     *  there is a rate stage.
+     */
+
+    mutable std::vector<long> m_last_times;
+
+    /**
+     *  The value sent on each lane in the current frame, used by a dedup
+     *  stage, valid only if its mark is the current frame number.  Frame 0
+     *  is no frame; see new_frame().  Allocated only if there is a dedup
+     *  stage.
+     */
+
+    mutable std::vector<int> m_frame_values;
+    mutable std::vector<unsigned> m_frame_marks;
+    mutable unsigned m_frame;
+
+public:
+
+    outputfilter ();
+    outputfilter (const std::string & spec);
+
+    bool parse (const std::string & spec);
+    std::string to_string () const;
+    bool add (stage kind, int value = 0);
+    void remove (stage kind);
+    bool has (stage kind) const;
+    void note_table (const midibytes & table);
+    void reset () const;
+    void new_frame () const;
+    midibyte out_channel (midibyte channel) const;
+    bool apply
+    (
+        midibyte status, midibyte & channel,
+        midibyte & d0, midibyte & d1
+    ) const;
+
+    bool empty () const
+    {
+        return m_steps.empty();
+    }
+
+    const midibytes & note_table () const
+    {
+        return m_note_table;
+    }
+
+    void clear ()
+    {
+        m_steps.clear();
+        m_note_table.clear();
+        m_last_values.clear();
+        m_last_times.clear();
+        m_frame_values.clear();
+        m_frame_marks.clear();
+    }
+
+private:
+
+    static int lane
+    (
+        midibyte kind, midibyte channel,
+        midibyte d0, midibyte d1, int & value, bool & end
+    );
+
+};          // class outputfilter
+
+}           // namespace seq66
+
+#endif      // SEQ66_OUTPUTFILTER_HPP
+
+/*
+ * outputfilter.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
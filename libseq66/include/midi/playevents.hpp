@@ -0,0 +1,299 @@
+#if ! defined SEQ66_PLAYEVENTS_HPP
+#define SEQ66_PLAYEVENTS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playevents.hpp
+ *
+ *  This module declares a compact, playback-only copy of a pattern's events.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The event class is large: besides the status and data bytes it carries
+ *  a vector for SysEx/Meta data, a link iterator, and editing flags.  The
+ *  output thread needs only the timestamp, status, channel, and data bytes
+ *  of each event, so sequence::play() walks a vector of the small
+ *  playevent objects instead, touching under a quarter of the memory.  The
+ *  few events that need more (tempo and SysEx) are kept out-of-line as full
+ *  event objects.  Other Meta events are never played, and are left out.
+ */
+
+#include <vector>                       /* std::vector                      */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "midi/modlane.hpp"             /* seq66::modlane                   */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds an event in 16 bytes, enough to play a channel message.  For tempo
+ *  and SysEx events, it also holds the index of the full event in the
+ *  playevents::ex_data() vector.
+ */
+
+class playevent
+{
+
+private:
+
+    midipulse m_timestamp;              /**< Same as event::timestamp().    */
+    int m_ex_index;                     /**< Index of full event, or -1.    */
+    midibyte m_status;                  /**< Same as event::get_status().   */
+    midibyte m_channel;                 /**< Same as event::channel().      */
+    midibyte m_d0;                      /**< The first data byte.           */
+    midibyte m_d1;                      /**< The second data byte.          */
+
+public:
+
+    playevent (const event & ev, int exindex = (-1)) :
+        m_timestamp (ev.timestamp()),
+        m_ex_index  (exindex),
+        m_status    (ev.get_status()),
+        m_channel   (ev.channel()),
+        m_d0        (0),
+        m_d1        (0)
+    {
+        ev.get_data(m_d0, m_d1);
+    }
+
+    /**
+     *  Makes a channel message from its bytes, as a modulation lane does.
+     */
+
+    playevent (midipulse ts, midibyte status, midibyte d0, midibyte d1) :
+        m_timestamp (ts),
+        m_ex_index  (-1),
+        m_status    (status),
+        m_channel   (event::mask_channel(status)),
+        m_d0        (d0),
+        m_d1        (d1)
+    {
+        // no code
+    }
+
+    midipulse timestamp () const
+    {
+        return m_timestamp;
+    }
+
+    int ex_index () const
+    {
+        return m_ex_index;
+    }
+
+    bool is_ex_data () const
+    {
+        return m_ex_index >= 0;
+    }
+
+    midibyte status () const
+    {
+        return m_status;
+    }
+
+    midibyte channel () const
+    {
+        return m_channel;
+    }
+
+    midibyte d0 () const
+    {
+        return m_d0;
+    }
+
+    midibyte d1 () const
+    {
+        return m_d1;
+    }
+
+    bool is_note () const
+    {
+        return event::is_note_msg(m_status);
+    }
+
+    bool is_note_on () const
+    {
+        return event::mask_status(m_status) == EVENT_NOTE_ON;
+    }
+
+    bool is_note_off () const
+    {
+        return event::mask_status(m_status) == EVENT_NOTE_OFF;
+    }
+
+    /**
+     *  The playevent version of event::transpose_note(), which leaves this
+     *  event alone and returns the note to send.
+     */
+
+    midibyte transposed_note (int tn) const
+    {
+        int note = int(m_d0) + tn;
+        return (note >= 0 && note < c_midibyte_data_max) ?
+            midibyte(note) : m_d0 ;
+    }
+
+};          // class playevent
+
+/**
+ *  The playback copy of an event::buffer.  It is rebuilt from the event list
+ *  whenever the sequence is modified; see sequence::publish_snapshot().
+ */
+
+class playevents
+{
+
+public:
+
+    using buffer = std::vector<playevent>;
+
+private:
+
+    /**
+     *  The playable events, in the order of the event list.
+     */
+
+    buffer m_events;
+
+    /**
+     *  The tempo and SysEx events, referenced by playevent::ex_index().
+     */
+
+    event::buffer m_ex_data;
+
+    /**
+     *  A copy of the modulation lanes of the sequence, which are generated
+     *  at play time rather than stored as events.
+     */
+
+    std::vector<modlane> m_lanes;
+
+    /**
+     *  The number of events in the source list.  Lets the caller notice a
+     *  change in the event list that was not followed by a rebuild.
+     */
+
+    std::size_t m_source_count;
+
+    /**
+     *  True if a tempo event is present.  Playing it changes the tempo of
+     *  the performer, which the playpool cannot do from a worker thread.
+     */
+
+    bool m_has_tempo;
+
+public:
+
+    playevents () :
+        m_events        (),
+        m_ex_data       (),
+        m_lanes         (),
+        m_source_count  (0),
+        m_has_tempo     (false)
+    {
+        // no code
+    }
+
+    explicit playevents
+    (
+        const event::buffer & evs,
+        const std::vector<modlane> & lanes = std::vector<modlane>()
+    ) :
+        m_events        (),
+        m_ex_data       (),
+        m_lanes         (lanes),
+        m_source_count  (evs.size()),
+        m_has_tempo     (false)
+    {
+        m_events.reserve(evs.size());
+        for (const auto & ev : evs)
+        {
+            if (ev.is_tempo() || ev.is_sysex())
+            {
+                if (ev.is_tempo())
+                    m_has_tempo = true;
+
+                m_events.emplace_back(ev, int(m_ex_data.size()));
+                m_ex_data.push_back(ev);
+            }
+            else if (! ev.is_ex_data())             /* other Metas not sent */
+                m_events.emplace_back(ev);
+        }
+    }
+
+    const buffer & events () const
+    {
+        return m_events;
+    }
+
+    const event & ex_data (const playevent & pe) const
+    {
+        return m_ex_data[std::size_t(pe.ex_index())];
+    }
+
+    const std::vector<modlane> & lanes () const
+    {
+        return m_lanes;
+    }
+
+    std::size_t source_count () const
+    {
+        return m_source_count;
+    }
+
+    bool has_tempo () const
+    {
+        return m_has_tempo;
+    }
+
+    /**
+     *  The memory held by the snapshot, for memoryusage.  The modulation
+     *  lanes are small, and only their objects are counted.
+     */
+
+    std::size_t bytes () const
+    {
+        return sizeof(playevents) +
+            m_events.capacity() * sizeof(playevent) +
+            m_ex_data.capacity() * sizeof(event) +
+            m_lanes.capacity() * sizeof(modlane);
+    }
+
+};          // class playevents
+
+}           // namespace seq66
+
+#endif      // SEQ66_PLAYEVENTS_HPP
+
+/*
+ * playevents.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
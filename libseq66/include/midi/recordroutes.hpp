@@ -0,0 +1,158 @@
+#if ! defined SEQ66_RECORDROUTES_HPP
+#define SEQ66_RECORDROUTES_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          recordroutes.hpp
+ *
+ *  This module declares the table that routes incoming events to the
+ *  recording patterns.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  With record-by-buss or record-by-channel, each incoming event used to be
+ *  offered to the candidate patterns one after the other, each checking
+ *  its buss or channel.  Now the candidates are sorted out beforehand, when
+ *  the recording setup changes, into a table indexed by input buss and
+ *  channel, and an event goes straight to its cell.  The table is
+ *  immutable once built, and is swapped in whole (see std::atomic_load()),
+ *  so that the input thread never sees one half built.
+ *
+ *  Each cell keeps the old rules:
+ *
+ *      -   By buss:  the first pattern of the play-set with the event's
+ *          input buss takes the event, if its channel accepts it.  There is
+ *          one row per buss.
+ *      -   By channel:  the recording patterns, in the order they started
+ *          recording, take the event, up to and including the first one
+ *          that matches its channel; a pattern that takes any channel does
+ *          not stop the search.  There is one row, for any buss.
+ */
+
+#include <memory>                       /* std::shared_ptr<>                */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, c_midichannel.. */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class event;
+class sequence;
+
+/**
+ *  The recording routing table.
+ */
+
+class recordroutes
+{
+
+public:
+
+    using pointer = std::shared_ptr<const recordroutes>;
+    using targets = std::vector<sequence *>;
+
+    /**
+     *  One cell:  the patterns to stream the event to, in order, and
+     *  whether the last one matched the channel, meaning that the event
+     *  was claimed.
+     */
+
+    class route
+    {
+
+    public:
+
+        targets rr_targets;             /**< The patterns to record to.     */
+        bool rr_claimed;                /**< The last matched the channel.  */
+
+        route () : rr_targets (), rr_claimed (false)
+        {
+            // no code
+        }
+
+    };
+
+private:
+
+    /**
+     *  The number of rows:  one past the highest input buss used, or 1 if
+     *  the table is by channel only.
+     */
+
+    int m_rows;
+
+    /**
+     *  True if the table is by channel only, and its one row serves every
+     *  input buss.
+     */
+
+    bool m_any_buss;
+
+    /**
+     *  The cells, c_midichannel_max per row.
+     */
+
+    std::vector<route> m_routes;
+
+public:
+
+    recordroutes ();
+
+    static pointer by_buss (const targets & patterns);
+    static pointer by_channel (const targets & recorders);
+
+    const route * find (const event & ev) const;
+    bool stream (event & ev) const;
+
+    bool empty () const
+    {
+        return m_routes.empty();
+    }
+
+private:
+
+    static bool accepts (const sequence * s, midibyte channel);
+
+    route & cell (int row, int channel)
+    {
+        return m_routes[std::size_t(row * c_midichannel_max + channel)];
+    }
+
+};          // class recordroutes
+
+}           // namespace seq66
+
+#endif      // SEQ66_RECORDROUTES_HPP
+
+/*
+ * recordroutes.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,119 @@
+#if ! defined SEQ66_SYSEXSTREAM_HPP
+#define SEQ66_SYSEXSTREAM_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sysexstream.hpp
+ *
+ *  This module declares the paced, chunked output of a large SysEx message.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A SysEx dump of a synthesizer's patch banks can run to hundreds of
+ *  kilobytes.  Sent in one go, it was copied into a JACK message too big
+ *  for the port buffer, or written to ALSA in a loop that slept with the
+ *  output mutex held, and a device that takes MIDI at cable speed dropped
+ *  what it could not keep up with.  Now mastermidibase::sysex() hands a
+ *  large message to a sysexstream, which shares the event's data (no copy
+ *  is made), and mastermidibase::pump_sysex() writes it, a chunk at a time,
+ *  no faster than the "sysex-rate" of the 'rc' file.  Each chunk is passed
+ *  to the buss as a pointer into the data; see midibase::sysex_chunk().
+ */
+
+#include <memory>                       /* std::shared_ptr<>                */
+
+#include "midi/event.hpp"               /* seq66::event::sysex              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The largest chunk written at once.  Small enough for the buffers of the
+ *  MIDI APIs, and to keep the pacing smooth.
+ */
+
+const int c_sysex_chunk_size = 256;
+
+/**
+ *  A SysEx message being sent, chunk by chunk, to one output buss.
+ */
+
+class sysexstream
+{
+
+public:
+
+    using pointer = std::shared_ptr<const event::sysex>;
+
+    /**
+     *  A view of the next part of the message.  It points into the shared
+     *  data, which the stream keeps alive while it is being sent.
+     */
+
+    struct chunk
+    {
+        const midibyte * sc_data;       /**< The first byte of the chunk.   */
+        int sc_size;                    /**< The number of bytes.           */
+    };
+
+private:
+
+    bussbyte m_buss;                    /**< The output buss.               */
+    pointer m_data;                     /**< The shared message bytes.      */
+    std::size_t m_offset;               /**< The next byte to send.         */
+    int m_rate;                         /**< Bytes per second, 0 = no limit.*/
+    long m_due_us;                      /**< When the next chunk is due.    */
+
+public:
+
+    sysexstream (bussbyte bus, pointer data, int rate);
+
+    bool next (long now, chunk & c);
+
+    bussbyte buss () const
+    {
+        return m_buss;
+    }
+
+    bool done () const
+    {
+        return ! m_data || m_offset >= m_data->size();
+    }
+
+};          // class sysexstream
+
+}           // namespace seq66
+
+#endif      // SEQ66_SYSEXSTREAM_HPP
+
+/*
+ * sysexstream.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,139 @@
+#if ! defined SEQ66_TEMPOMAP_HPP
+#define SEQ66_TEMPOMAP_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          tempomap.hpp
+ *
+ *  This module declares the tempo map, which converts between ticks and
+ *  time in a song whose tempo changes.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The functions in calculations.cpp, such as ticks_to_delta_time_us(),
+ *  assume one tempo for the whole song.  The tempo map holds the tempo
+ *  segments of the song, sorted by tick, each with the time at which it
+ *  starts.  A conversion is a binary search for the segment, plus the
+ *  single-tempo calculation within it, so it costs O(log n) and does not
+ *  accumulate rounding errors from segment to segment.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse, midibpm        */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A sorted list of tempo segments.
+ */
+
+class tempomap
+{
+
+public:
+
+    /**
+     *  One tempo segment, which lasts until the start of the next one.
+     */
+
+    class segment
+    {
+
+    public:
+
+        midipulse tm_tick;              /**< The first tick of the segment. */
+        double tm_us_per_tick;          /**< The length of one tick.        */
+        double tm_start_us;             /**< The time at tm_tick.           */
+        midibpm tm_bpm;                 /**< The tempo of the segment.      */
+
+    };
+
+    using segments = std::vector<segment>;
+
+private:
+
+    /**
+     *  The segments, sorted by tick.  There is always at least one, starting
+     *  at tick 0, once the map is built.
+     */
+
+    segments m_segments;
+
+    /**
+     *  The tempo changes given to add(), not yet built into segments.
+     */
+
+    segments m_pending;
+
+    /**
+     *  The PPQN of the song.
+     */
+
+    int m_ppqn;
+
+public:
+
+    tempomap ();
+
+    void clear (int ppqn, midibpm bpm);
+    void add (midipulse tick, midibpm bpm);
+    void build ();
+
+    int count () const
+    {
+        return int(m_segments.size());
+    }
+
+    bool has_changes () const
+    {
+        return m_segments.size() > 1;
+    }
+
+    double tick_to_us (midipulse tick) const;
+    midipulse us_to_tick (double us) const;
+    midibpm bpm_at (midipulse tick) const;
+    midipulse next_change (midipulse tick) const;
+
+private:
+
+    const segment * find (midipulse tick) const;
+
+};          // class tempomap
+
+}           // namespace seq66
+
+#endif      // SEQ66_TEMPOMAP_HPP
+
+/*
+ * tempomap.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-04
- * \updates       2022-05-14
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the WRK format, see, for example:
@@ -36,6 +36,8 @@
  */
 
 #include <list>                         /* std::list                        */
+#include <set>                          /* std::set                         */
+#include <vector>                       /* std::vector                      */
 
 #include "midi/midifile.hpp"            /* seq66::midifile base class       */
 
@@ -66,6 +68,18 @@ private:
         double seconds;
     };
 
+    /**
+     *  An entry of the chunk index built by index_chunks().
+     */
+
+    struct chunkinfo
+    {
+        int ck_id;              /**< The chunk type, such as WC_STREAM_CHUNK. */
+        size_t offset;          /**< The offset of the chunk data.          */
+        size_t length;          /**< The number of bytes of chunk data.     */
+        int track;              /**< The track of the chunk, or -1.         */
+    };
+
 private:
 
     /**
@@ -120,6 +134,21 @@ private:
 
     wrkfile_private m_wrk_data;
 
+    /**
+     *  The chunks of the file, in file order, found by a first pass over the
+     *  chunk headers.  The chunk data is then read in place, from the
+     *  offsets, with no copy.
+     */
+
+    std::vector<chunkinfo> m_chunks;
+
+    /**
+     *  The track numbers to import.  If empty, all tracks are imported.
+     *  The chunks of other tracks are skipped, not decoded.
+     */
+
+    std::set<int> m_selected_tracks;
+
     /**
      *  Holds a pointer to the (single) performer object in the Seq66
      *  session.  We save it in order to avoid having to pass it around to the
@@ -202,6 +231,7 @@ public:
         performer & p, int screenset = 0, bool importing = false
     ) override;
     double get_real_time (midipulse ticks) const;
+    void select_tracks (const std::vector<int> & tracks);
 
 private:
 
@@ -243,7 +273,9 @@ private:
     std::string read_string (int len);
     std::string read_var_string ();
     void read_raw_data (int size);
-    int read_chunk ();
+    bool index_chunks ();
+    bool selected (const chunkinfo & c) const;
+    void read_chunk (const chunkinfo & c);
     void NoteArray (int track, int events);
     void TrackChunk ();
     void VarsChunk ();
@@ -23,7 +23,7 @@
  * \file          daemonize.hpp
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (from xpc-suite project)
- * \updates       2023-10-31
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *    Daemonization of POSIX C Wrapper (PSXC) library
@@ -138,6 +138,15 @@ extern bool session_close ();
 extern bool session_save ();
 extern bool session_restart ();
 
+/*
+ *  Lets a main loop sleep until there is something to do.  session_wake()
+ *  is safe to call from any thread, and is called by the signal handler and
+ *  the signal_for_xxx() functions.
+ */
+
+extern bool session_wait (int ms);
+extern void session_wake ();
+
 /*
  *  Useful for the performer to flag an application exit.  Be freakin' careful
  *  with this one!  :-D
@@ -0,0 +1,141 @@
+#if ! defined SEQ66_MAPPEDFILE_HPP
+#define SEQ66_MAPPEDFILE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          mappedfile.hpp
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *    This module provides read-only access to the whole of a file as an
+ *    array of bytes.  With the POSIX API, the file is memory-mapped, so that
+ *    no copy is made and pages are read in by the kernel as they are
+ *    touched.  Otherwise (e.g. Windows), the file is read into a buffer.
+ *
+ *    A few whole-file images can also be held in memory by preload(), which
+ *    the play-list does for the songs next to the current one.  open() then
+ *    uses the image, if the file still has the size and modification time
+ *    it had when read, and the song switch does not touch the storage at
+ *    all, even if the system's file cache has dropped the file meanwhile.
+ */
+
+#include <memory>                       /* std::shared_ptr<>                */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A read-only view of a whole file.  The data stays valid until close()
+ *  is called or the object is destroyed.
+ */
+
+class mappedfile
+{
+
+private:
+
+    /**
+     *  The start of the file data, either the mapping or m_buffer's data.
+     */
+
+    const midibyte * m_data;
+
+    /**
+     *  The size of the file data, in bytes.
+     */
+
+    size_t m_size;
+
+    /**
+     *  Indicates that m_data is a memory mapping, to be unmapped.
+     */
+
+    bool m_mapped;
+
+    /**
+     *  The fallback storage, used when the file cannot be mapped.
+     */
+
+    std::vector<midibyte> m_buffer;
+
+    /**
+     *  The preloaded image in use, if open() found one.  Holding it keeps
+     *  it alive even if the cache drops it.
+     */
+
+    std::shared_ptr<const std::vector<midibyte>> m_image;
+
+public:
+
+    mappedfile ();
+    ~mappedfile ();
+
+    mappedfile (const mappedfile &) = delete;
+    mappedfile & operator = (const mappedfile &) = delete;
+
+    bool open (const std::string & filename);
+    void close ();
+
+    static bool prefetch (const std::string & filename);
+    static bool preload (const std::string & filename);
+
+    const midibyte * data () const
+    {
+        return m_data;
+    }
+
+    size_t size () const
+    {
+        return m_size;
+    }
+
+    bool mapped () const
+    {
+        return m_mapped;
+    }
+
+private:
+
+    bool map_file (const std::string & filename);
+    bool read_file (const std::string & filename);
+    bool use_image (const std::string & filename);
+
+};          // class mappedfile
+
+}           // namespace seq66
+
+#endif      // SEQ66_MAPPEDFILE_HPP
+
+/*
+ * mappedfile.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
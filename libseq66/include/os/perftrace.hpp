@@ -0,0 +1,110 @@
+#if ! defined SEQ66_PERFTRACE_HPP
+#define SEQ66_PERFTRACE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          perftrace.hpp
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *    This module provides trace points for a timeline of what the engine
+ *    does while running: output cycles, pattern playback, input polling,
+ *    the JACK process callback, MIDI file parsing, and the painting of the
+ *    main windows.  The trace points are always compiled in, and cost one
+ *    test of a flag unless the --trace option is given.  Then each thread
+ *    that passes a trace point gets its own ring of events, which it fills
+ *    without a lock, and which keeps the most recent events.
+ *
+ *    The rings are written as a Chrome trace (JSON) file, to be loaded in
+ *    chrome://tracing or in Perfetto, when the session is saved, whether by
+ *    the user, by a session manager, or by SIGUSR1, and when it is closed.
+ *    That allows looking back at a glitch after it happened.
+ *
+ *    Times are counted from the loading of the library, as are those of the
+ *    startup profile, so that the two traces line up.
+ */
+
+#include <iosfwd>                       /* std::ostream                     */
+#include <string>                       /* std::string                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Traces the time from its construction to its destruction as one event.
+ *  The name must be a string literal; it is kept as a pointer.
+ */
+
+class trace_scope
+{
+
+private:
+
+    /**
+     *  The name of the event.
+     */
+
+    const char * m_name;
+
+    /**
+     *  The start of the event, or -1 if tracing is off.
+     */
+
+    long m_start_us;
+
+public:
+
+    trace_scope (const char * name);
+    ~trace_scope ();
+
+    trace_scope (const trace_scope &) = delete;
+    trace_scope & operator = (const trace_scope &) = delete;
+
+};          // class trace_scope
+
+extern void perftrace (bool flag, const std::string & tracefile = "");
+extern bool perftrace ();
+extern const std::string & perftrace_file ();
+extern void perftrace_mark (const char * name);
+extern bool perftrace_dump (const std::string & filename);
+extern long perftrace_clock ();
+extern int perftrace_summary
+(
+    std::ostream & out,
+    long since_us = 0,
+    const std::string & match = ""
+);
+
+}           // namespace seq66
+
+#endif      // SEQ66_PERFTRACE_HPP
+
+/*
+ * perftrace.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,72 @@
+#if ! defined SEQ66_RTSAFE_HPP
+#define SEQ66_RTSAFE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          rtsafe.hpp
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *    This module provides the "rt-safe" mode, which keeps the memory of the
+ *    process in RAM so that the output, input, and JACK threads take no
+ *    page faults, plus, in debug builds, a count of the allocations made by
+ *    those threads.
+ *
+ *    The check replaces the global operator new and operator delete, so it
+ *    sees C++ allocations only, not calls to malloc() made by C libraries.
+ *    Set a breakpoint on rt_allocation_seen() to find the culprit.  To build
+ *    it into a release, define SEQ66_RTSAFE_CHECK.
+ */
+
+#include <cstddef>                      /* std::size_t                      */
+
+#include "seq66_platform_macros.h"      /* SEQ66_PLATFORM_DEBUG             */
+
+#if defined SEQ66_PLATFORM_DEBUG && ! defined SEQ66_RTSAFE_CHECK
+#define SEQ66_RTSAFE_CHECK
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+extern bool lock_memory (std::size_t heapbytes = 0);
+extern void prefault_stack ();
+extern void rt_thread (bool flag);
+extern bool rt_thread ();
+extern bool rt_check_enabled ();
+extern long rt_allocations ();
+extern void rt_allocation_seen ();
+
+}           // namespace seq66
+
+#endif      // SEQ66_RTSAFE_HPP
+
+/*
+ * rtsafe.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
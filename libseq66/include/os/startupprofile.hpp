@@ -0,0 +1,92 @@
+#if ! defined SEQ66_STARTUPPROFILE_HPP
+#define SEQ66_STARTUPPROFILE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          startupprofile.hpp
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *    This module provides the timing of the phases of start-up: option
+ *    parsing, reading the configuration, setting up the session, creating
+ *    the ports, loading the MIDI file, and creating the window.  The phases
+ *    are always timed, which costs next to nothing; the --startup-profile
+ *    option prints the breakdown once start-up is done and can also write it
+ *    as a Chrome trace (JSON) file, to be loaded in chrome://tracing or in
+ *    Perfetto.
+ *
+ *    Times are counted from the loading of the library, which is as close
+ *    to the start of the process as we can portably get.  Phases are timed
+ *    only in the main thread, and may nest.
+ */
+
+#include <string>                       /* std::string                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Times one phase of start-up, from its construction to its destruction or
+ *  to the call of finish(), whichever comes first.
+ */
+
+class startup_phase
+{
+
+private:
+
+    /**
+     *  The slot of the phase in the list of phases, or -1 once finished.
+     */
+
+    int m_index;
+
+public:
+
+    startup_phase (const std::string & name);
+    ~startup_phase ();
+
+    startup_phase (const startup_phase &) = delete;
+    startup_phase & operator = (const startup_phase &) = delete;
+
+    void finish ();
+
+};          // class startup_phase
+
+extern void startup_profile (bool flag, const std::string & tracefile = "");
+extern bool startup_profile ();
+extern void startup_report ();
+
+}           // namespace seq66
+
+#endif      // SEQ66_STARTUPPROFILE_HPP
+
+/*
+ * startupprofile.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -23,17 +23,19 @@
  * \file          timing.hpp
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (from xpc-suite project)
- * \updates       2021-11-19
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *    Daemonization of POSIX C Wrapper (PSXC) library
  *    Copyright (C) 2005-2025 by Chris Ahlstrom
  *
  *    This module provides functions for timing and increasing thread
- *    priority.
+ *    priority, and for pinning threads to CPUs.
  */
 
+#include <string>                       /* std::string                      */
 #include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector                      */
 
 #include "seq66_platform_macros.h"      /* for detecting 32-bit builds      */
 
@@ -50,11 +52,22 @@ namespace seq66
 
 extern int std_sleep_us ();
 extern bool microsleep (int us);
+extern bool microsleep_until (long abstime_us);
 extern bool millisleep (int ms);
 extern void thread_yield ();
 extern long microtime ();
 extern long millitime ();
 extern bool set_thread_priority (std::thread & t, int p = 1);
+extern bool set_thread_scheduling
+(
+    std::thread & t, const std::string & policy, int p
+);
+extern bool set_thread_affinity
+(
+    std::thread & t, const std::vector<int> & cpus
+);
+extern std::vector<int> parse_cpu_list (const std::string & cpus);
+extern std::string thread_scheduling (std::thread & t);
 extern bool set_timer_services (bool on);
 
 }        // namespace seq66
@@ -0,0 +1,223 @@
+#if ! defined SEQ66_BLOCKENGINE_HPP
+#define SEQ66_BLOCKENGINE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          blockengine.hpp
+ *
+ *  This module declares the playback of a performer one audio block at a
+ *  time, for a plugin host.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Normally the performer owns its output and input threads and its MIDI
+ *  ports (see performer::launch()).  A plugin (e.g. LV2 or CLAP) cannot
+ *  work that way: the host calls it once per audio block, from its own
+ *  real-time thread, with the transport state and the incoming MIDI, and
+ *  expects the outgoing MIDI of that block back, stamped with frame
+ *  offsets.  The blockengine does that for a performer that is never
+ *  launched, in the manner of "--render" (see songrender): each block is
+ *  played as one frame inside a playpool run, which captures the events
+ *  instead of sending them.  The event ticks are then converted to frame
+ *  offsets, so the output is sample-accurate.
+ *
+ *  The host's transport rules: its tempo and position are used as is, and
+ *  any tempo change posted by the patterns is ignored.  A stop, or a jump
+ *  of the position, ends the notes that are sounding.
+ *
+ *  The incoming events are handled as MIDI controls (see
+ *  performer::midi_control_event()), or else recorded by the patterns that
+ *  are recording.  Without a master buss, there is no MIDI thru.
+ *
+ *  process() takes no locks that another thread holds for long, and makes
+ *  no allocations once the capture buffers and the output vector have grown
+ *  to the size of a busy block.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "play/playpool.hpp"            /* seq66::playpool                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Plays a performer in blocks of audio frames.
+ */
+
+class blockengine
+{
+
+public:
+
+    /**
+     *  The host's transport at the start of a block.  The position is in
+     *  quarter notes from the start of the song.  If the host does not
+     *  provide it, m_has_position is false, and the position simply
+     *  follows on from the previous block.
+     */
+
+    class transport
+    {
+
+    public:
+
+        bool m_playing;
+        double m_bpm;
+        bool m_has_position;
+        double m_beats;
+
+        transport () :
+            m_playing       (false),
+            m_bpm           (120.0),
+            m_has_position  (false),
+            m_beats         (0.0)
+        {
+            // no code
+        }
+
+    };
+
+    /**
+     *  A MIDI event at a frame offset in the block.  For output, the
+     *  channel of the pattern is already applied, and the buss is the one
+     *  the pattern plays to, which the host can map to a MIDI port of the
+     *  plugin, or ignore.  For input, the buss is given to the MIDI
+     *  controls as the input buss.
+     */
+
+    class blockevent
+    {
+
+    public:
+
+        int m_frame;
+        bussbyte m_bus;
+        event m_event;
+
+        blockevent (int frame, bussbyte bus, const event & ev) :
+            m_frame     (frame),
+            m_bus       (bus),
+            m_event     (ev)
+        {
+            // no code
+        }
+
+    };
+
+    using blockevents = std::vector<blockevent>;
+
+private:
+
+    /**
+     *  The performer played.  It is not launched.
+     */
+
+    performer & m_perf;
+
+    /**
+     *  A pool without extra threads, used only to capture the events of the
+     *  patterns.  See playpool::capture().
+     */
+
+    playpool m_pool;
+
+    /**
+     *  The jobs given to the pool: playing the play-set up to m_block_tick,
+     *  as performer::play() does, and stopping it.  They are made once, so
+     *  that no std::function is built for each block.
+     */
+
+    playpool::job m_play_job;
+    playpool::job m_stop_job;
+
+    /**
+     *  The last tick of the current block, used by m_play_job.
+     */
+
+    midipulse m_block_tick;
+
+    /**
+     *  Indicates that the previous block was played, so that a stop of the
+     *  transport ends the notes.
+     */
+
+    bool m_playing;
+
+    /**
+     *  The position expected at the start of the next block, in fractional
+     *  ticks, so that blocks shorter than a tick lose no time.
+     */
+
+    double m_position;
+
+public:
+
+    explicit blockengine (performer & p);
+    blockengine (const blockengine &) = delete;
+    blockengine & operator = (const blockengine &) = delete;
+
+    void process
+    (
+        int frames,
+        int samplerate,
+        const transport & t,
+        const blockevents & in,
+        blockevents & out
+    );
+    void reset (blockevents & out);
+
+    double position () const
+    {
+        return m_position;
+    }
+
+private:
+
+    void handle_input (const blockevent & be, midipulse tick);
+    void stop_patterns (blockevents & out);
+    void collect
+    (
+        playpool::messages & msgs, double start,
+        double ticksperframe, int frames, blockevents & out
+    );
+
+};          // class blockengine
+
+}           // namespace seq66
+
+#endif      // SEQ66_BLOCKENGINE_HPP
+
+/*
+ * blockengine.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
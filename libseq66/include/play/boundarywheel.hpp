@@ -0,0 +1,181 @@
+#if ! defined SEQ66_BOUNDARYWHEEL_HPP
+#define SEQ66_BOUNDARYWHEEL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          boundarywheel.hpp
+ *
+ *  This module declares a timer wheel of the queued and one-shot
+ *  boundaries of the patterns.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  In Live mode, every pattern used to check, every frame, whether it had
+ *  reached its queued or one-shot tick.  Now, when a pattern is queued or
+ *  set to one-shot (see sequence::toggle_queued() and toggle_one_shot()),
+ *  its boundary tick is posted here, and each frame the output thread
+ *  visits only the slots of the wheel that the frame spans, and gets back
+ *  the patterns whose boundary has come.
+ *
+ *  The wheel has a fixed number of slots, each a span of ticks one
+ *  sixteenth note wide, so that it turns over once every sixteen measures
+ *  of 4/4.  A boundary further out than that stays in its slot until the
+ *  wheel comes round to it.  Going backward, such as on a rewind, makes
+ *  the output thread sweep the whole wheel once.
+ *
+ *  A boundary can go stale, when a pattern is unqueued and queued again,
+ *  for example.  That is harmless, because the pattern checks its own
+ *  status again before acting.
+ *
+ *  Posting is done by the user-interface and input threads, under a mutex
+ *  held only to append to a small list.  The wheel itself belongs to the
+ *  output thread.
+ */
+
+#include <atomic>                       /* std::atomic<bool>                */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse alias           */
+#include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class sequence;
+
+/**
+ *  The queued and one-shot boundaries to come.
+ */
+
+class boundarywheel
+{
+
+public:
+
+    /**
+     *  The patterns whose boundary has come.
+     */
+
+    using patterns = std::vector<sequence *>;
+
+private:
+
+    /**
+     *  One boundary.  The pattern pointer is only compared to those of the
+     *  play-set, and is never followed unless found there.
+     */
+
+    class boundary
+    {
+
+    public:
+
+        sequence * bw_seq;              /**< The pattern queued.            */
+        midipulse bw_tick;              /**< The queued or one-shot tick.   */
+
+    };
+
+    using slot = std::vector<boundary>;
+
+    /**
+     *  The slots of the wheel.
+     */
+
+    std::vector<slot> m_slots;
+
+    /**
+     *  The boundaries posted since the last frame.
+     */
+
+    std::vector<boundary> m_posted;
+
+    /**
+     *  Tells the output thread to take the posted boundaries, so that it
+     *  need not lock the mutex when nothing was posted.
+     */
+
+    std::atomic<bool> m_have_posted;
+
+    /**
+     *  Guards m_posted.
+     */
+
+    recmutex m_mutex;
+
+    /**
+     *  The width of a slot, in ticks.
+     */
+
+    midipulse m_width;
+
+    /**
+     *  The tick of the last frame advanced to.
+     */
+
+    midipulse m_cursor;
+
+    /**
+     *  The number of boundaries in the slots.
+     */
+
+    int m_count;
+
+public:
+
+    boundarywheel ();
+
+    boundarywheel (const boundarywheel &) = delete;
+    boundarywheel & operator = (const boundarywheel &) = delete;
+
+    void post (sequence * s, midipulse tick);
+    void advance (midipulse tick, int ppqn, patterns & due);
+
+    int count () const
+    {
+        return m_count;
+    }
+
+private:
+
+    int slot_index (midipulse tick) const;
+    void take_posted ();
+    void insert (const boundary & b);
+    void regauge (midipulse width);
+    void sweep (slot & s, midipulse tick, patterns & due);
+
+};          // class boundarywheel
+
+}           // namespace seq66
+
+#endif      // SEQ66_BOUNDARYWHEEL_HPP
+
+/*
+ * boundarywheel.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,152 @@
+#if ! defined SEQ66_BULKOPS_HPP
+#define SEQ66_BULKOPS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          bulkops.hpp
+ *
+ *  This module declares the pending bulk operations on whole screen-sets.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Muting, unmuting, or toggling all of the patterns, or toggling all of
+ *  their song-mutes, used to lock and change each pattern in the thread
+ *  that asked, so that a big "mute all" landed wherever the pattern loop
+ *  happened to be.  While playing, the performer now only posts such an
+ *  operation here, as bits, one per set, and the output thread applies
+ *  it, at the start of its next frame, to the patterns it is playing.
+ *
+ *  Each set's armed status goes through (armed & and-bit) ^ xor-bit:
+ *
+ *      -   Mute:       and 0, xor 0.
+ *      -   Arm:        and 0, xor 1.
+ *      -   Toggle:     and 1, xor 1.
+ *      -   Nothing:    and 1, xor 0.
+ *
+ *  Two such operations make one more:  (a1, x1) then (a2, x2) is
+ *  (a1 & a2, (x1 & a2) ^ x2).  So posting folds the operation into the
+ *  pending one by one compare-and-swap of a 64-bit word, the and-mask in
+ *  the low half, the xor-mask in the high half, however many operations
+ *  pile up during a frame, and however many patterns they cover.  The
+ *  song-mute toggles are a separate xor-mask.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstdint>                      /* std::uint32_t, std::uint64_t     */
+#include <vector>                       /* std::vector<>                    */
+
+#include "play/seq.hpp"                 /* seq66::seq::pointer              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds the pending bulk operations on the armed and song-mute statuses of
+ *  the sets.
+ */
+
+class bulkops
+{
+
+public:
+
+    /**
+     *  One bit per set.  There are no more than c_max_sets (32) sets.
+     */
+
+    using bits = std::uint32_t;
+
+    /**
+     *  The patterns of a play-set, as in playset.
+     */
+
+    using array = std::vector<seq::pointer>;
+
+    /**
+     *  The operations on the armed status of the patterns of a set.
+     */
+
+    enum class op
+    {
+        mute,                           /**< Unarm all of the patterns.     */
+        arm,                            /**< Arm all of the patterns.       */
+        toggle                          /**< Flip the armed status of each. */
+    };
+
+private:
+
+    /**
+     *  The pending and-mask (low half) and xor-mask (high half) of the
+     *  armed statuses.  The identity is all ones in the low half.
+     */
+
+    std::atomic<std::uint64_t> m_armed_masks;
+
+    /**
+     *  The sets whose song-mutes are to be toggled an odd number of times.
+     */
+
+    std::atomic<bits> m_song_toggles;
+
+public:
+
+    bulkops ();
+
+    bulkops (const bulkops &) = delete;
+    bulkops & operator = (const bulkops &) = delete;
+
+    static bits set_bit (int setno);
+
+    void post (op o, bits sets);
+    void post_song_toggle (bits sets);
+    int apply (array & seqs, int setsize);
+
+    bool armed_pending () const;
+
+    bool song_pending () const
+    {
+        return m_song_toggles.load(std::memory_order_acquire) != 0;
+    }
+
+    bool pending () const
+    {
+        return armed_pending() || song_pending();
+    }
+
+};          // class bulkops
+
+}           // namespace seq66
+
+#endif      // SEQ66_BULKOPS_HPP
+
+/*
+ * bulkops.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,132 @@
+#if ! defined SEQ66_CLOCKFOLLOWER_HPP
+#define SEQ66_CLOCKFOLLOWER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          clockfollower.hpp
+ *
+ *  This module declares a follower for incoming MIDI clock.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  When Seq66 follows MIDI clock, each clock used to add a fixed number of
+ *  ticks (PPQN / 24) in the next output frame, so that playback advanced in
+ *  steps of one clock, and jittered with the arrival of the clocks.  The
+ *  clock follower is a delay-locked loop, as described by Fons Adriaensen
+ *  in "Using a DLL to filter time".  It filters the arrival times of the
+ *  clocks to estimate the clock period (the tempo) and the time of the
+ *  latest clock (the phase), so that the output thread can interpolate the
+ *  tick at full PPQN resolution between clocks.
+ *
+ *  The input thread calls pulse() for each clock, and the output thread
+ *  calls advance() in each frame, so the state is guarded by a mutex.
+ */
+
+#include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Tracks the tempo and phase of incoming MIDI clock.
+ */
+
+class clockfollower
+{
+
+private:
+
+    /**
+     *  Guards the state between the input and output threads.
+     */
+
+    mutable recmutex m_mutex;
+
+    /**
+     *  The number of MIDI ticks per clock, PPQN / 24.
+     */
+
+    int m_increment;
+
+    /**
+     *  The number of clocks received since the reset.
+     */
+
+    long m_pulses;
+
+    /**
+     *  True once two clocks have arrived and the period is known.
+     */
+
+    bool m_locked;
+
+    /**
+     *  The filtered time of the latest clock, and the predicted time of the
+     *  next one, in microseconds.
+     */
+
+    double m_t0;
+    double m_t1;
+
+    /**
+     *  The filtered clock period in microseconds.
+     */
+
+    double m_period;
+
+    /**
+     *  The ticks handed out by advance() since the reset.  They never go
+     *  backward.
+     */
+
+    long m_reported;
+
+public:
+
+    clockfollower ();
+
+    clockfollower (const clockfollower &) = delete;
+    clockfollower & operator = (const clockfollower &) = delete;
+
+    void reset (int increment);
+    void pulse (long us);
+    long advance (long us);
+    double bpm () const;
+
+};          // class clockfollower
+
+}           // namespace seq66
+
+#endif      // SEQ66_CLOCKFOLLOWER_HPP
+
+/*
+ * clockfollower.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,218 @@
+#if ! defined SEQ66_EDITJOB_HPP
+#define SEQ66_EDITJOB_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          editjob.hpp
+ *
+ *  This module declares the running of a long pattern edit on a worker
+ *  thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A big transform, such as the pattern-fix dialog's rescale or quantize
+ *  of a long recording, used to run on the GUI thread with the pattern
+ *  locked, so that the user interface froze.  (The playback did not, as
+ *  the output thread plays the published snapshot of the events.)  An
+ *  editjob instead:
+ *
+ *      -#  Copies the pattern into a scratch pattern on its own thread,
+ *          holding the pattern's lock only for the copy, and keeps the
+ *          pattern's playback snapshot, which changes with its events.
+ *      -#  Runs the operation on the scratch pattern, which nothing else
+ *          sees.  The loops of the heavy edits call checkpoint(), which
+ *          reports the progress and returns false once the job is
+ *          cancelled; the operation then stops early, and its result is
+ *          thrown away.
+ *      -#  Once finished, apply(), called by the GUI thread, hands the
+ *          scratch events to sequence::adopt_edit(), which swaps them in
+ *          under the lock, with an undo, and publishes a new snapshot.
+ *          If the pattern was changed in the meantime (by recording, for
+ *          example), the edit is refused rather than losing that change.
+ *
+ *  An operation must touch only the pattern it is given, and nothing in
+ *  the user interface.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstddef>                      /* std::size_t                      */
+#include <functional>                   /* std::function<>                  */
+#include <memory>                       /* std::unique_ptr<>                */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+
+#include "play/seq.hpp"                 /* seq66::seq::pointer              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class playevents;
+
+/**
+ *  One pattern edit run on a worker thread.
+ */
+
+class editjob
+{
+
+public:
+
+    /**
+     *  The edit to make.  It is called on the worker thread with the
+     *  scratch copy of the pattern, and returns true if it changed it.
+     */
+
+    using operation = std::function<bool (sequence &)>;
+
+    /**
+     *  The states of the job.
+     */
+
+    enum class status
+    {
+        idle,                           /**< Not started yet.               */
+        running,                        /**< The worker is editing.         */
+        done,                           /**< Ready for apply().             */
+        unchanged,                      /**< The edit changed nothing.      */
+        cancelled,                      /**< Stopped by cancel().           */
+        conflict,                       /**< The pattern changed meanwhile. */
+        applied                         /**< Swapped into the pattern.      */
+    };
+
+private:
+
+    /**
+     *  The job running on the current thread, if any, for checkpoint().
+     */
+
+    static thread_local editjob * st_current;
+
+    /**
+     *  The pattern edited, held so that it outlives the job even if it is
+     *  deleted from the set meanwhile.
+     */
+
+    seq::pointer m_target;
+
+    /**
+     *  The copy the operation works on.
+     */
+
+    std::unique_ptr<sequence> m_scratch;
+
+    /**
+     *  The name of the edit, for messages.
+     */
+
+    std::string m_name;
+
+    /**
+     *  The edit.
+     */
+
+    operation m_operation;
+
+    /**
+     *  The target's playback snapshot when it was copied, by which a
+     *  change to its events meanwhile is detected.
+     */
+
+    std::shared_ptr<const playevents> m_base;
+
+    /**
+     *  The worker thread.
+     */
+
+    std::thread m_thread;
+
+    /**
+     *  The state, the progress in percent, and the cancel flag, shared by
+     *  the worker and the GUI thread.
+     */
+
+    std::atomic<status> m_status;
+    std::atomic<int> m_percent;
+    std::atomic<bool> m_cancel;
+
+public:
+
+    editjob (seq::pointer target, const std::string & name, operation op);
+    ~editjob ();
+
+    editjob (const editjob &) = delete;
+    editjob & operator = (const editjob &) = delete;
+
+    bool start ();
+    void cancel ();
+    bool apply ();
+
+    static bool checkpoint (std::size_t done, std::size_t total);
+
+    const std::string & name () const
+    {
+        return m_name;
+    }
+
+    status state () const
+    {
+        return m_status.load(std::memory_order_acquire);
+    }
+
+    bool finished () const
+    {
+        status s = state();
+        return s != status::idle && s != status::running;
+    }
+
+    int percent () const
+    {
+        return m_percent.load(std::memory_order_relaxed);
+    }
+
+    bool cancelled () const
+    {
+        return m_cancel.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    void run ();
+    void join ();
+
+};          // class editjob
+
+}           // namespace seq66
+
+#endif      // SEQ66_EDITJOB_HPP
+
+/*
+ * editjob.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
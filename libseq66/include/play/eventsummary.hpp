@@ -0,0 +1,157 @@
+#if ! defined SEQ66_EVENTSUMMARY_HPP
+#define SEQ66_EVENTSUMMARY_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          eventsummary.hpp
+ *
+ *  This module declares a summary of a stream of events at a ladder of time
+ *  resolutions, used to draw patterns that are zoomed far out.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  When a pattern editor is zoomed out on a long recording, hundreds of
+ *  notes or controller events land on each pixel column, yet each one used
+ *  to be drawn by itself.  The summary keeps the events as spans of ticks
+ *  with the lowest and highest value seen in each.  Level 0 holds the
+ *  events as added.  At each further level the spans are widened to
+ *  buckets of a power of two ticks, and spans that then share a bucket are
+ *  merged.  A level is kept only if it is a good deal smaller than the one
+ *  below it, which bounds the memory used.  In "run" mode, spans in
+ *  adjacent buckets are merged as well, as is wanted for the notes of one
+ *  piano-roll row; otherwise each bucket stays apart, which keeps the
+ *  per-column height of a controller.
+ *
+ *  A view picks the level whose bucket is no wider than the ticks covered
+ *  by one pixel, and so draws at most a couple of spans per pixel column.
+ *  The summary knows nothing of patterns, so the views build it, and build
+ *  it again when the pattern's redraw generation changes.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse alias           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A min/max pyramid of event spans.
+ */
+
+class eventsummary
+{
+
+public:
+
+    /**
+     *  One event, or a run of events merged at the level's resolution.
+     */
+
+    class span
+    {
+
+    public:
+
+        midipulse sp_start;             /**< The first tick covered.        */
+        midipulse sp_end;               /**< The last tick covered.         */
+        int sp_min;                     /**< The lowest value merged.       */
+        int sp_max;                     /**< The highest value merged.      */
+        bool sp_selected;               /**< Any merged event is selected.  */
+        bool sp_flagged;                /**< Any is flagged, e.g. unlinked. */
+
+    };
+
+    using spans = std::vector<span>;
+
+private:
+
+    /**
+     *  Merges spans in adjacent buckets, not just in the same bucket.
+     */
+
+    bool m_runs;
+
+    /**
+     *  The levels of the pyramid, and the bucket width of each level, a
+     *  power of two, 1 for level 0.
+     */
+
+    std::vector<spans> m_levels;
+    std::vector<midipulse> m_widths;
+
+public:
+
+    eventsummary (bool runs = false);
+
+    void clear ();
+    void add
+    (
+        midipulse start, midipulse end, int value,
+        bool selected = false, bool flagged = false
+    );
+    void build ();
+    int level_for (midipulse ticks_per_pixel) const;
+    spans::const_iterator first (int lvl, midipulse tick) const;
+
+    int level_count () const
+    {
+        return int(m_levels.size());
+    }
+
+    bool empty () const
+    {
+        return m_levels.empty() || m_levels[0].empty();
+    }
+
+    const spans & level (int lvl) const
+    {
+        return m_levels[std::size_t(lvl)];
+    }
+
+    midipulse width (int lvl) const
+    {
+        return m_widths[std::size_t(lvl)];
+    }
+
+private:
+
+    void merge (spans & sp, midipulse bucket);
+
+};          // class eventsummary
+
+}           // namespace seq66
+
+#endif      // SEQ66_EVENTSUMMARY_HPP
+
+/*
+ * eventsummary.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,165 @@
+#if ! defined SEQ66_FRAMEBATCH_HPP
+#define SEQ66_FRAMEBATCH_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          framebatch.hpp
+ *
+ *  This module declares the per-buss batches of a frame's output.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The patterns are played one after the other, so that their events come
+ *  out interleaved across the busses, each one taking the master buss's
+ *  lock and the port's lock, and being written to the API by itself.
+ *  While performer::play() plays a frame, the output thread instead puts
+ *  the events into one batch per buss (see sequence::put_event_on_bus()).
+ *  At the end of the frame, each batch is sorted by timestamp, stably, so
+ *  that the events of a tick keep their order, and handed to its buss in
+ *  one call, which the JACK implementation turns into one write to its
+ *  ring-buffer.  Then the master buss is flushed once, as before.
+ *
+ *  The capture is thread-local, as that of the playpool is, so that events
+ *  played by other threads meanwhile, from an editor or the input thread,
+ *  go straight to the buss.
+ *
+ *  Each event carries the tag of its pattern, which an API that holds
+ *  events ahead of their time (ALSA with "alsa-lookahead") keeps with
+ *  them, so that it can take back those of a pattern muted by the user
+ *  (see sequence::set_armed() and midibase::api_retract()).
+ *
+ *  A buss with an output bandwidth (see the [midi-output-bandwidth]
+ *  section of the 'rc' file) is paced.  Its interface is modelled as a
+ *  wire that is busy until the bytes already given to it are sent.  Within
+ *  a tick, the Note Offs go first, then the other messages (such as
+ *  program changes), then the Note Ons, then the continuous controllers.
+ *  A controller change that would leave more than the pacing window of
+ *  bytes queued is put off to the next frame, where a later value of the
+ *  same controller replaces it.  The notes are never put off, so a frame
+ *  with too many of them is counted as an overload in the output
+ *  statistics, rather than being smeared unpredictably by the interface.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibase.hpp"            /* seq66::batchevent class          */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class mastermidibus;
+    class outputstats;
+
+/**
+ *  The output of a frame, by buss.
+ */
+
+class framebatch
+{
+
+private:
+
+    /**
+     *  One batch per buss.  Reused from frame to frame, so that no
+     *  allocations are made once they have grown to the size of a busy
+     *  frame.
+     */
+
+    std::vector<std::vector<batchevent>> m_batches;
+
+    /**
+     *  The busses with events in the current frame, in the order first
+     *  used.
+     */
+
+    std::vector<bussbyte> m_used;
+
+    /**
+     *  The wire model of a paced buss, and the controller changes it put
+     *  off to the next frame, with the time they were put off.
+     */
+
+    using pacing = struct
+    {
+        long pc_free_us;
+        long pc_deferred_us;
+        std::vector<batchevent> pc_deferred;
+    };
+
+    std::vector<pacing> m_pacing;
+
+    /**
+     *  The busses with deferred events, and the events of a paced batch
+     *  that are sent in the current frame.
+     */
+
+    std::vector<bussbyte> m_pending;
+    std::vector<batchevent> m_sending;
+
+public:
+
+    framebatch ();
+
+    framebatch (const framebatch &) = delete;
+    framebatch & operator = (const framebatch &) = delete;
+
+    void begin ();
+    void end (mastermidibus & mmb, outputstats & stats);
+    void add
+    (
+        bussbyte bus, const event & ev, midibyte channel, midibyte tag = 0
+    );
+
+    static bool capture
+    (
+        bussbyte bus, const event & ev, midibyte channel, midibyte tag = 0
+    );
+    static bool active ();
+
+private:
+
+    void pace
+    (
+        bussbyte bus, std::vector<batchevent> & b,
+        int bytespersec, outputstats & stats
+    );
+    static void defer (pacing & pc, const batchevent & be);
+    static int rank (const event & ev);
+    static int wire_bytes (const event & ev);
+
+};          // class framebatch
+
+}           // namespace seq66
+
+#endif      // SEQ66_FRAMEBATCH_HPP
+
+/*
+ * framebatch.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
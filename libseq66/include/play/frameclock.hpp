@@ -0,0 +1,110 @@
+#if ! defined SEQ66_FRAMECLOCK_HPP
+#define SEQ66_FRAMECLOCK_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          frameclock.hpp
+ *
+ *  This module declares the time and tick of the last output frame.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Recorded events used to get the tick of the last output frame at the
+ *  moment the input thread got to them, so that they landed late by however
+ *  long the event waited in the MIDI API, plus however long the output
+ *  thread had been asleep.  Now the MIDI APIs that can do so mark each
+ *  incoming event with its arrival time (see event::arrival_us()), and the
+ *  output thread notes the time and tick of each frame here.  The recorder
+ *  then works out, with the tempo map, the tick at which the event
+ *  arrived, going backward or forward from the frame.
+ *
+ *  The output thread writes the frame, and the input thread reads it, with
+ *  a sequence count instead of a lock:  the count is odd while the frame is
+ *  being written, and a reader that sees it odd, or changed, reads again.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The position in time and ticks of the last output frame.
+ */
+
+class frameclock
+{
+
+private:
+
+    /**
+     *  Counts the writes, twice each.  Odd while a write is under way.
+     */
+
+    std::atomic<unsigned> m_sequence;
+
+    /**
+     *  The microtime() of the frame.  Zero means no frame since the frame
+     *  clock was cleared.
+     */
+
+    std::atomic<long> m_frame_us;
+
+    /**
+     *  The tick of the frame.
+     */
+
+    std::atomic<double> m_frame_tick;
+
+public:
+
+    frameclock ();
+
+    frameclock (const frameclock &) = delete;
+    frameclock & operator = (const frameclock &) = delete;
+
+    void set (long us, double tick);
+    bool get (long & us, double & tick) const;
+
+    void clear ()
+    {
+        set(0, 0.0);
+    }
+
+};          // class frameclock
+
+}           // namespace seq66
+
+#endif      // SEQ66_FRAMECLOCK_HPP
+
+/*
+ * frameclock.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
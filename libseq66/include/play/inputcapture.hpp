@@ -0,0 +1,202 @@
+#if ! defined SEQ66_INPUTCAPTURE_HPP
+#define SEQ66_INPUTCAPTURE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          inputcapture.hpp
+ *
+ *  This module declares an always-on recorder of all incoming MIDI.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The "input-capture" rc option names a directory.  When set, every
+ *  channel message arriving on any input buss is captured, whether or not
+ *  a pattern is armed for recording, and whether or not playback runs, so
+ *  that each rehearsal is kept.  The input thread only stamps the message
+ *  with the time and pushes it into a preallocated single-producer,
+ *  single-consumer ring_buffer; it never locks, allocates, or touches a
+ *  file.  A low-priority writer thread drains the ring a couple of times a
+ *  second and appends the messages to a format-0 MIDI file, patching the
+ *  track length and End of Track each time, so that the file on disk is
+ *  always a complete SMF, even if Seq66 is killed.  A new file is begun
+ *  every hour.
+ *
+ *  The file uses 960 PPQN at a fixed 120 BPM, so a tick is about half a
+ *  millisecond of wall-clock time.  A change of input buss is marked with
+ *  a MIDI Port meta event.  System messages (clock, SysEx) are not kept.
+ */
+
+#include <atomic>                       /* std::atomic<bool>                */
+#include <condition_variable>           /* std::condition_variable          */
+#include <fstream>                      /* std::ofstream                    */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector                      */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "util/ring_buffer.hpp"         /* seq66::ring_buffer<>             */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Captures the incoming channel messages into a rolling MIDI file.
+ */
+
+class inputcapture
+{
+
+public:
+
+    /**
+     *  One incoming message, as pushed by the input thread.
+     */
+
+    class record
+    {
+
+    public:
+
+        long cr_us;                     /**< The microtime() of arrival.    */
+        midibyte cr_status;             /**< The status, with channel.      */
+        midibyte cr_d0;                 /**< The first data byte.           */
+        midibyte cr_d1;                 /**< The second data byte, if any.  */
+        bussbyte cr_bus;                /**< The input buss.                */
+
+    };
+
+private:
+
+    /**
+     *  The messages waiting for the writer thread.
+     */
+
+    ring_buffer<record> m_records;
+
+    /**
+     *  A batch of records popped at once, allocated once.
+     */
+
+    std::vector<record> m_batch;
+
+    /**
+     *  The directory to write the files to.
+     */
+
+    std::string m_directory;
+
+    /**
+     *  The writer thread, and what it waits on between drains.
+     */
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stopping;
+
+    /**
+     *  Set while the writer thread accepts messages.
+     */
+
+    std::atomic<bool> m_running;
+
+    /**
+     *  The file being written, its name, and the microtime() of its tick 0.
+     */
+
+    std::ofstream m_file;
+    std::string m_filename;
+    long m_file_start_us;
+
+    /**
+     *  The tick and buss of the last message written, for the delta times
+     *  and the MIDI Port events.
+     */
+
+    midipulse m_last_tick;
+    int m_last_bus;
+
+    /**
+     *  The file offset of the End of Track event, which is overwritten by
+     *  the next messages.
+     */
+
+    long m_track_end;
+
+    /**
+     *  The encoded messages not yet written.  Used only by the writer.
+     */
+
+    midibytes m_pending;
+
+public:
+
+    inputcapture (const std::string & directory);
+    ~inputcapture ();
+
+    inputcapture (const inputcapture &) = delete;
+    inputcapture & operator = (const inputcapture &) = delete;
+
+    bool start ();
+    void stop ();
+    void capture (const event & ev);
+
+    const std::string & filename () const
+    {
+        return m_filename;
+    }
+
+    int dropped () const
+    {
+        return m_records.dropped();
+    }
+
+private:
+
+    void writer_func ();
+    void drain ();
+    void add_record (const record & r);
+    bool open_file (long us);
+    void close_file ();
+    void flush_pending ();
+    void put_varinum (midipulse v);
+    void put_long (long v);
+
+};          // class inputcapture
+
+}           // namespace seq66
+
+#endif      // SEQ66_INPUTCAPTURE_HPP
+
+/*
+ * inputcapture.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,132 @@
+#if ! defined SEQ66_INPUTMONITOR_HPP
+#define SEQ66_INPUTMONITOR_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          inputmonitor.hpp
+ *
+ *  This module declares the tap of the MIDI input for the input monitor of
+ *  the user interface.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The input thread hands each incoming message, of any kind, to tap(),
+ *  which copies its time, buss, and first bytes into a preallocated
+ *  single-producer, single-consumer ring_buffer.  Nothing is decoded or
+ *  allocated there.  Unless a monitor window is open, the tap is a single
+ *  relaxed load of an atomic flag.  The window drains the ring into its own
+ *  history at its own, capped, rate, and decodes only the rows it shows.
+ *  If the window falls behind, the newest messages are dropped and counted,
+ *  rather than blocking the input thread.
+ */
+
+#include <atomic>                       /* std::atomic<bool>                */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, bussbyte        */
+#include "util/ring_buffer.hpp"         /* seq66::ring_buffer<>             */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class event;
+
+/**
+ *  Passes the incoming messages to the input monitor window.
+ */
+
+class inputmonitor
+{
+
+public:
+
+    /**
+     *  One incoming message, as pushed by the input thread.  For a SysEx
+     *  message, only the first two data bytes are kept.
+     */
+
+    class record
+    {
+
+    public:
+
+        long mr_us;                     /**< The microtime() of arrival.    */
+        int mr_size;                    /**< The message length, in bytes.  */
+        midibyte mr_status;             /**< The status, with channel.      */
+        midibyte mr_d0;                 /**< The first data byte.           */
+        midibyte mr_d1;                 /**< The second data byte, if any.  */
+        bussbyte mr_bus;                /**< The input buss.                */
+
+    };
+
+private:
+
+    /**
+     *  The messages waiting for the monitor window.
+     */
+
+    ring_buffer<record> m_records;
+
+    /**
+     *  Set while a monitor window is open.  Read by the input thread for
+     *  every message, so it is kept apart from the ring's indices.
+     */
+
+    std::atomic<bool> m_enabled;
+
+public:
+
+    inputmonitor ();
+
+    inputmonitor (const inputmonitor &) = delete;
+    inputmonitor & operator = (const inputmonitor &) = delete;
+
+    void enable (bool flag);
+    void tap (const event & ev);
+    int drain (record * dest, int count);
+
+    bool enabled () const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    int dropped () const
+    {
+        return m_records.dropped();
+    }
+
+};          // class inputmonitor
+
+}           // namespace seq66
+
+#endif      // SEQ66_INPUTMONITOR_HPP
+
+/*
+ * inputmonitor.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,126 @@
+#if ! defined SEQ66_LATENCYPROBE_HPP
+#define SEQ66_LATENCYPROBE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          latencyprobe.hpp
+ *
+ *  This module declares the measurement of the round-trip latency of an
+ *  input port.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Each input buss can have a latency, given in the [midi-input-latency]
+ *  section of the 'rc' file, by which recorded events are moved earlier.
+ *  See performer::input_tick().  Rather than guess it, the user can have it
+ *  measured:  the probe sends a few clicks (short notes) out one output
+ *  buss, and times their return on an input buss, looped back by a cable,
+ *  a JACK connection, or a null MIDI device.  The average round trip is
+ *  what a player overdubbing to what they hear is late by, and becomes the
+ *  latency of the input buss.
+ *
+ *  The probe belongs to the input thread, which sends the clicks between
+ *  polls and sees them come back.
+ *
+ *  Each round trip is kept, so that the seq66cli "-o latency-test" option
+ *  can report their spread (the jitter) as well as their average, for
+ *  comparing MIDI engines, schedulers, and interfaces.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::bussbyte, midibyte        */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class event;
+
+/**
+ *  Times clicks sent out one buss and received on another.
+ */
+
+class latencyprobe
+{
+
+private:
+
+    bussbyte m_out_buss;                /**< Where the clicks are sent.     */
+    bussbyte m_in_buss;                 /**< Where they should come back.   */
+    bool m_running;                     /**< A measurement is under way.    */
+    int m_clicks;                       /**< The clicks left to send.       */
+    int m_replies;                      /**< The clicks that came back.     */
+    long m_total_us;                    /**< The sum of their round trips.  */
+    long m_sent_us;                     /**< When the last was sent, or 0.  */
+    long m_next_us;                     /**< When to send the next one.     */
+    int m_sent;                         /**< The clicks sent so far.        */
+    std::vector<long> m_trips;          /**< Each round trip, microseconds. */
+
+public:
+
+    latencyprobe ();
+
+    latencyprobe (const latencyprobe &) = delete;
+    latencyprobe & operator = (const latencyprobe &) = delete;
+
+    bool start (int outbuss, int inbuss, int clicks = 0);
+    bool send_due (long now);
+    void sent (long now);
+    bool take_reply (const event & ev, long arrival);
+    bool finished (int & latencyus);
+    std::string report () const;
+
+    bool active () const
+    {
+        return m_running;
+    }
+
+    bussbyte out_buss () const
+    {
+        return m_out_buss;
+    }
+
+    bussbyte in_buss () const
+    {
+        return m_in_buss;
+    }
+
+    static event click (bool on);
+
+};          // class latencyprobe
+
+}           // namespace seq66
+
+#endif      // SEQ66_LATENCYPROBE_HPP
+
+/*
+ * latencyprobe.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,164 @@
+#if ! defined SEQ66_LINKSYNC_HPP
+#define SEQ66_LINKSYNC_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          linksync.hpp
+ *
+ *  This module declares the Ableton Link network tempo and phase sync.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Ableton Link shares a tempo, a beat timeline, and a start/stop state
+ *  among the applications on a LAN that take part in a session, with no
+ *  master, no cable, and no server.  With 'link-sync' set in the 'rc' file,
+ *  and a build with the Link SDK (configure --with-link=DIR), Seq66 joins
+ *  the session:
+ *
+ *      -   The output thread takes the ticks of each frame from the Link
+ *          beat timeline, rather than from the elapsed time, so that it
+ *          stays phase-locked to the session.  Playback starts on the next
+ *          boundary of the quantum ('link-quantum', in beats, usually one
+ *          bar), so that the bars line up across the machines.
+ *      -   A tempo change by the user goes to the session, and one made by
+ *          a peer is taken up.
+ *      -   Starting or stopping on one machine starts or stops the others,
+ *          via performer::poll_cycle().
+ *
+ *  The output thread uses the "audio" session state of Link, which is safe
+ *  for it to use without blocking.  The Link header is included only in
+ *  the implementation, so that the rest of Seq66 does not depend on it.
+ *  Without Link support, enable() fails and the rest does nothing.
+ */
+
+#include <atomic>                       /* std::atomic<bool>                */
+#include <memory>                       /* std::unique_ptr<>                */
+
+#include "midi/midibytes.hpp"           /* seq66::midibpm, midipulse        */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Joins the Link session and follows its timeline.
+ */
+
+class linksync
+{
+
+private:
+
+    /**
+     *  Holds the ableton::Link object, when built with Link support.
+     */
+
+    class session;
+
+    std::unique_ptr<session> m_session;
+
+    /**
+     *  The number of beats over which the phase is aligned, usually the
+     *  beats in one bar.
+     */
+
+    double m_quantum;
+
+    /**
+     *  The beat, on the session timeline, at which the current playback
+     *  started.  Ticks are counted from there.
+     */
+
+    double m_origin_beat;
+
+    /**
+     *  The ticks given out since playback started.  A double so that the
+     *  fractions of a tick are carried from frame to frame.
+     */
+
+    double m_ticks;
+
+    /**
+     *  The tempo last agreed with the session.
+     */
+
+    midibpm m_tempo;
+
+    /**
+     *  True while the output thread is playing to the session timeline.
+     */
+
+    bool m_playing;
+
+    /**
+     *  Set by the Link thread when a peer starts or stops the session, and
+     *  polled by the input thread, which starts or stops Seq66 to match.
+     */
+
+    std::atomic<bool> m_session_playing;
+    std::atomic<bool> m_session_changed;
+
+public:
+
+    linksync ();
+    ~linksync ();
+
+    linksync (const linksync &) = delete;
+    linksync & operator = (const linksync &) = delete;
+
+    bool enable (midibpm bpm, int quantum);
+    void disable ();
+    int peers () const;
+    void start (midibpm & bpm);
+    long advance (double ticksperbeat, midibpm & bpm);
+    void stop ();
+    bool session_change (bool & playing);
+
+    bool enabled () const
+    {
+        return bool(m_session);
+    }
+
+    bool playing () const
+    {
+        return m_playing;
+    }
+
+    static bool supported ();
+
+};          // class linksync
+
+}           // namespace seq66
+
+#endif      // SEQ66_LINKSYNC_HPP
+
+/*
+ * linksync.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
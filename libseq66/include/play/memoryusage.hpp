@@ -0,0 +1,131 @@
+#if ! defined SEQ66_MEMORYUSAGE_HPP
+#define SEQ66_MEMORYUSAGE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          memoryusage.hpp
+ *
+ *  This module declares a reading of the memory held by the song data.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Nothing is counted as it is allocated.  Instead, performer::
+ *  memory_usage() walks the patterns, each of which adds the capacity of
+ *  its containers to the categories below, so that the accounting costs
+ *  the playback nothing.  The figures are estimates: the node overhead of
+ *  the maps is guessed, and storage shared by copies (the events of a
+ *  copied pattern, of its newest undo entry, or of the clipboard, and the
+ *  SysEx data of copied events) is counted by each owner.
+ */
+
+#include <array>                        /* std::array<>                     */
+#include <cstddef>                      /* std::size_t                      */
+#include <string>                       /* std::string                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The bytes held by each kind of song data.
+ */
+
+class memoryusage
+{
+
+public:
+
+    /**
+     *  The categories.  The caches are the parts of a pattern rebuilt from
+     *  its events: the note index and the playback snapshot.
+     */
+
+    enum class category
+    {
+        events,         /**< The events of the patterns.                    */
+        sysex,          /**< The SysEx and Meta data of the events.         */
+        triggers,       /**< The triggers of the song.                      */
+        undo,           /**< The undo and redo history, events and triggers.*/
+        clipboard,      /**< The copied events.                             */
+        editables,      /**< The events open in the event editors.          */
+        caches,         /**< The note indices and playback snapshots.       */
+        max
+    };
+
+private:
+
+    static const int c_categories = static_cast<int>(category::max);
+
+    std::array<std::size_t, c_categories> m_bytes;
+
+    /**
+     *  The number of patterns walked.
+     */
+
+    int m_patterns;
+
+public:
+
+    memoryusage ();
+
+    static std::string name (category c);
+
+    void add (category c, std::size_t bytes)
+    {
+        m_bytes[static_cast<int>(c)] += bytes;
+    }
+
+    std::size_t bytes (category c) const
+    {
+        return m_bytes[static_cast<int>(c)];
+    }
+
+    void add_pattern ()
+    {
+        ++m_patterns;
+    }
+
+    int patterns () const
+    {
+        return m_patterns;
+    }
+
+    std::size_t total () const;
+    std::string to_string () const;
+
+};          // class memoryusage
+
+}           // namespace seq66
+
+#endif      // SEQ66_MEMORYUSAGE_HPP
+
+/*
+ * memoryusage.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
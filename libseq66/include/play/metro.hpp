@@ -29,7 +29,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-08-05
- * \updates       2022-08-18
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The metro is a sequence with a special configuration.  It can be added
@@ -37,6 +37,11 @@
  *  patterns.  It is not visible and it is not editable once created.
  *  There is also a lot of stuff in seq66::sequence not needed here.
  *
+ *  The clicks are worked out from the beat length and the number of beats
+ *  per bar, not found in the event list, and each is sent with its exact
+ *  tick, so that the ALSA lookahead queue or the JACK engine places it at
+ *  its own time rather than at the start of the output frame.
+ *
  *  The recorder class extends the metro class for recording in the background
  *  automatically.
  */
@@ -401,6 +406,38 @@ private:
 
     metrosettings m_metro_settings;
 
+    /**
+     *  The events of one click, and their offsets from the beat: the
+     *  program change at the beat, the Note On a tick later, and the Note
+     *  Off at the end of the note.
+     */
+
+    class click
+    {
+
+    public:
+
+        event ck_events[3];             /**< The events; times not used.    */
+        midipulse ck_offsets[3];        /**< The ticks after the beat.      */
+
+    };
+
+    /**
+     *  The click of the first beat of the bar, and of the other beats.
+     *  Made by initialize(), so that live_play_frame() uses neither the
+     *  event list nor the heap.
+     */
+
+    click m_clicks[2];
+
+    /**
+     *  The length of a beat, zero until initialize() is done, and the number
+     *  of beats in a bar.
+     */
+
+    midipulse m_beat_length;
+    int m_beats_per_bar;
+
 private:
 
     metro & operator = (const metro & rhs);
@@ -425,6 +462,7 @@ public:
 protected:
 
     bool init_setup (performer * p, int measures);
+    virtual void live_play_frame (midipulse first, midipulse last) override;
 
 };          // class metro
 
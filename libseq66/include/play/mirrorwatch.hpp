@@ -0,0 +1,140 @@
+#if ! defined SEQ66_MIRRORWATCH_HPP
+#define SEQ66_MIRRORWATCH_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          mirrorwatch.hpp
+ *
+ *  This module declares the client of the state mirror that is run by
+ *  "seq66cli --mirror".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A second seq66cli attaches to the state mirror of a running engine (see
+ *  statemirror.hpp) through a statemirror_view, never touching the engine
+ *  itself.  It checks that each copy it reads is consistent (the transport
+ *  is sane, the events of each pattern are in time order and fit in their
+ *  room, the triggers are ordered), prints a summary, and can send the
+ *  engine a few controls through the command queue.  With "--watch" it
+ *  keeps at it, and it reports when the engine stops beating.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class statemirror_view;
+
+/**
+ *  Holds the options of a mirror client and runs it.
+ */
+
+class mirrorwatch
+{
+
+public:
+
+    /**
+     *  The totals of one look at the mirror.
+     */
+
+    class summary
+    {
+
+    public:
+
+        int ms_patterns;                /**< The active patterns.           */
+        int ms_armed;                   /**< The unmuted patterns.          */
+        long ms_events;                 /**< The events of all patterns.    */
+        long ms_triggers;               /**< The triggers of all patterns.  */
+        int ms_errors;                  /**< The inconsistencies found.     */
+
+        summary ();
+
+    };
+
+private:
+
+    /**
+     *  The engine's "state-mirror" name.
+     */
+
+    std::string m_name;
+
+    /**
+     *  If true, the mirror is checked again every interval, until the count
+     *  runs out or the engine is gone.
+     */
+
+    bool m_watch;
+
+    /**
+     *  The time between looks, in milliseconds, and the number of looks,
+     *  where 0 means no limit.
+     */
+
+    int m_interval_ms;
+    int m_count;
+
+    /**
+     *  The controls to send once attached:  start or stop the transport,
+     *  and the patterns to toggle.
+     */
+
+    bool m_start;
+    bool m_stop;
+    std::vector<int> m_toggles;
+
+public:
+
+    mirrorwatch ();
+
+    static bool requested (int argc, char * argv []);
+    static void show_help ();
+
+    bool parse (int argc, char * argv []);
+    int run ();
+
+    static summary check (const statemirror_view & view);
+
+private:
+
+    bool send_controls (statemirror_view & view) const;
+
+};          // class mirrorwatch
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIRRORWATCH_HPP
+
+/*
+ * mirrorwatch.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
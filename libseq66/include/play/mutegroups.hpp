@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-12-01
- * \updates       2023-10-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module is meant to support the main mute groups and the mute groups
@@ -47,6 +47,7 @@
  */
 
 #include <map>                          /* std::map<> for mutegroup storage */
+#include <memory>                       /* std::shared_ptr<>                */
 
 #include "cfg/basesettings.hpp"         /* seq66::basesettings class        */
 #include "play/mutegroup.hpp"           /* seq66::mutegroup stanza class    */
@@ -139,6 +140,19 @@ public:
 
 private:
 
+    /**
+     *  The raw bytes of a MIDI file's c_mutegroups SeqSpec section, kept
+     *  until the mute-groups are first used.  See defer_midi().
+     */
+
+    struct deferral
+    {
+        midibytes d_bytes;              /**< The groups, after the counts.  */
+        unsigned d_group_count;         /**< The number of groups.          */
+        unsigned d_group_size;          /**< The number of bits per group.  */
+        bool d_legacy;                  /**< Values stored as longs.        */
+    };
+
     /**
      *  The virtual number of rows in a grid of mute-groups.  This number is
      *  constant in order to indicate that there are always 4 rows in the
@@ -312,6 +326,13 @@ private:
 
     bool m_legacy_mutes;
 
+    /**
+     *  Mute-groups read from a MIDI file but not yet decoded.  Published
+     *  with std::atomic_store(), as the first user might be any thread.
+     */
+
+    std::shared_ptr<const deferral> m_deferred;
+
 public:
 
     mutegroups
@@ -503,6 +524,23 @@ public:
      */
 
     bool reset_defaults ();                         /* used in mutegroupsfile */
+    std::size_t load_midi
+    (
+        const midibyte * data, std::size_t len,
+        unsigned groupcount, unsigned groupsize, bool legacy
+    );
+    void defer_midi
+    (
+        midibytes && data,
+        unsigned groupcount, unsigned groupsize, bool legacy
+    );
+    void resolve ();
+
+    bool deferred () const
+    {
+        return bool(std::atomic_load(&m_deferred));
+    }
+
     bool load (mutegroup::number gmute, const midibooleans & bits);
     bool set (mutegroup::number gmute, const midibooleans & bits);
     midibooleans get (mutegroup::number gmute) const;
@@ -30,7 +30,7 @@
  * \library       libseq66
  * \author        Chris Ahlstrom
  * \date          2014-04-24
- * \updates       2025-01-09
+ * \updates       2026-10-14
  * \version       $Revision$
  * \license       GNU GPL
  *
@@ -323,7 +323,9 @@ private:
     map m_note_map;
 
     /**
-     *  Provides a quick translation "map" for use while recording.
+     *  Provides a quick translation "map" for use while recording or
+     *  playing, and by convert().  Filled by add(), along with the map.
+     *  Each unmapped note maps to itself.
      */
 
     midibyte m_note_array[c_notes_count];
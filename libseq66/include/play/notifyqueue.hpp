@@ -0,0 +1,198 @@
+#if ! defined SEQ66_NOTIFYQUEUE_HPP
+#define SEQ66_NOTIFYQUEUE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          notifyqueue.hpp
+ *
+ *  This module declares the queue that carries performer notifications
+ *  from the output, input, and JACK threads to the user-interface thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The performer::callbacks clients are mostly windows and frames, and
+ *  their handlers can do a lot of work, such as repainting a grid of
+ *  buttons.  A notification raised on the output thread (e.g. a trigger
+ *  grown while song-recording) must not wait for that.  So such a
+ *  notification is posted here, and performer::deliver_notifications(),
+ *  called on the thread that registered the clients, hands it on.
+ *
+ *  Any number of threads can post, without locking.  Only one thread may
+ *  deliver.  The queue is the bounded queue of Dmitry Vyukov: each cell
+ *  carries a sequence number that tells the producers when it is free and
+ *  the consumer when it is filled.
+ *
+ *  A notice about a numbered item (a pattern, a set, a mute-group, or an
+ *  automation slot) is dropped if the same notice is already waiting.  A
+ *  pattern that grows its trigger in every output frame is announced only
+ *  once per delivery.  The other notices are rare, and carry values, so
+ *  they are not merged.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstddef>                      /* std::size_t                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "ctrl/keystroke.hpp"           /* seq66::keystroke                 */
+#include "midi/midibytes.hpp"           /* seq66::midibpm                   */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A multi-producer, single-consumer queue of notifications.
+ */
+
+class notifyqueue
+{
+
+public:
+
+    /**
+     *  The kinds of notification, one per performer::callbacks function.
+     */
+
+    enum class kind
+    {
+        group_learn,
+        group_learn_complete,
+        mutes_change,
+        set_change,
+        sequence_change,
+        automation_change,
+        ui_change,
+        trigger_change,
+        resolution_change,
+        song_action,
+        max
+    };
+
+    /**
+     *  One notification.  The performer::change and playlist::action values
+     *  are stored as integers, to keep this module free of the performer.
+     */
+
+    class notice
+    {
+
+    public:
+
+        kind n_kind;                    /**< The callback to call.          */
+        int n_number;                   /**< Pattern, set, group, or slot.  */
+        int n_change;                   /**< The performer::change value.   */
+        int n_value;                    /**< PPQN, "learning", "signalit".  */
+        int n_action;                   /**< A playlist::action value.      */
+        midibpm n_bpm;                  /**< For resolution_change.         */
+        keystroke n_key;                /**< For group_learn_complete.      */
+
+        notice () :
+            n_kind      (kind::max),
+            n_number    (0),
+            n_change    (0),
+            n_value     (0),
+            n_action    (0),
+            n_bpm       (0.0),
+            n_key       ()
+        {
+            // no code
+        }
+
+    };
+
+private:
+
+    /**
+     *  A slot of the queue.
+     */
+
+    class cell
+    {
+
+    public:
+
+        std::atomic<std::size_t> c_sequence;
+        notice c_notice;
+        int c_key;                      /**< The coalescing key, or -1.     */
+
+    };
+
+    std::vector<cell> m_cells;
+    std::size_t m_mask;
+
+    /**
+     *  The next cell to fill, shared by the producers, and the next cell to
+     *  read, used by the consumer alone.
+     */
+
+    std::atomic<std::size_t> m_enqueue;
+    std::size_t m_dequeue;
+
+    /**
+     *  One flag per coalescing key, set while a notice with that key is
+     *  waiting.
+     */
+
+    std::vector<std::atomic<bool>> m_pending;
+
+    /**
+     *  The number of notices that found the queue full.
+     */
+
+    std::atomic<int> m_dropped;
+
+public:
+
+    explicit notifyqueue (std::size_t sz = 1024);
+
+    notifyqueue (const notifyqueue &) = delete;
+    notifyqueue & operator = (const notifyqueue &) = delete;
+
+    int dropped () const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    bool post (const notice & n);
+    bool pop (notice & n);
+
+private:
+
+    int coalescing_key (const notice & n) const;
+
+};          // class notifyqueue
+
+}           // namespace seq66
+
+#endif      // SEQ66_NOTIFYQUEUE_HPP
+
+/*
+ * notifyqueue.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,185 @@
+#if ! defined SEQ66_OUTPUTSTATS_HPP
+#define SEQ66_OUTPUTSTATS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          outputstats.hpp
+ *
+ *  This module declares the timing statistics of the output thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The output thread records how late each wake-up was, how long each frame
+ *  took to play, and how many events it sent.  The frame times are also
+ *  kept in a histogram with the buckets of the lateness, from which a
+ *  percentile can be estimated.  sequence::play() records how long it
+ *  waited for a pattern lock held by an editor, and the framebatch records
+ *  the load of each buss that has an output bandwidth.  The counters are
+ *  relaxed atomics, so that recording costs the output thread next to
+ *  nothing, and any thread can read them at any time.  A reading is not an
+ *  exact snapshot, but each counter is exact.
+ */
+
+#include <atomic>                       /* std::atomic<long>                */
+#include <string>                       /* std::string                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Accumulates the output timing statistics.
+ */
+
+class outputstats
+{
+
+public:
+
+    /**
+     *  The number of buckets in the histogram of wake-up lateness.  See
+     *  bucket_limit_us() for their limits.
+     */
+
+    static const int c_lateness_buckets = 8;
+
+    /**
+     *  A reading of the statistics, plus the ring-buffer figures that the
+     *  caller fills in from the output busses.
+     */
+
+    class values
+    {
+
+    public:
+
+        long ov_wakeups;
+        long ov_lateness[c_lateness_buckets];
+        long ov_late_max_us;
+        long ov_underruns;
+        long ov_frames;
+        long ov_frame_sum_us;
+        long ov_frame_max_us;
+        long ov_frame_times[c_lateness_buckets];
+        long ov_events_sum;
+        long ov_events_max;
+        long ov_lock_waits;
+        long ov_lock_wait_max_us;
+        long ov_paced_frames;
+        long ov_overloads;
+        long ov_deferred;
+        long ov_backlog_max_us;
+        int ov_buffer_size;
+        int ov_buffer_max;
+        int ov_buffer_dropped;
+        int ov_input_buffer_size;
+        int ov_input_buffer_max;
+        int ov_input_dropped;
+        long ov_rt_allocations;         /* -1 if not counted, see rtsafe    */
+
+        values ();
+
+        long frame_mean_us () const
+        {
+            return ov_frames > 0 ? ov_frame_sum_us / ov_frames : 0 ;
+        }
+
+        double events_mean () const
+        {
+            return ov_frames > 0 ?
+                double(ov_events_sum) / double(ov_frames) : 0.0 ;
+        }
+
+        long frame_percentile_us (int percent) const;
+
+        std::string to_string () const;
+
+    };
+
+private:
+
+    using counter = std::atomic<long>;
+
+    counter m_wakeups;
+    counter m_lateness[c_lateness_buckets];
+    counter m_late_max_us;
+    counter m_underruns;
+    counter m_frames;
+    counter m_frame_sum_us;
+    counter m_frame_max_us;
+    counter m_frame_times[c_lateness_buckets];
+    counter m_events_sum;
+    counter m_events_max;
+    counter m_lock_waits;
+    counter m_lock_wait_max_us;
+
+    /**
+     *  The frames played on the paced busses, those in which a buss was
+     *  given more bytes than its interface could carry in the pacing
+     *  window, the controller changes put off to a later frame, and the
+     *  most time the bytes queued in an interface would take to send.
+     */
+
+    counter m_paced_frames;
+    counter m_overloads;
+    counter m_deferred;
+    counter m_backlog_max_us;
+
+public:
+
+    outputstats ();
+
+    outputstats (const outputstats &) = delete;
+    outputstats & operator = (const outputstats &) = delete;
+
+    static long bucket_limit_us (int bucket);
+    static std::string bucket_label (int bucket);
+
+    void clear ();
+    void wakeup (long lateness_us);
+    void underrun (long lateness_us);
+    void frame (long frame_us, long events);
+    void lock_wait (long wait_us);
+    void paced (long backlog_us, long deferred, bool overload);
+    values get () const;
+
+private:
+
+    static void raise_max (counter & c, long value);
+
+};          // class outputstats
+
+}           // namespace seq66
+
+#endif      // SEQ66_OUTPUTSTATS_HPP
+
+/*
+ * outputstats.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
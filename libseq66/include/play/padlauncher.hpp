@@ -0,0 +1,197 @@
+#if ! defined SEQ66_PADLAUNCHER_HPP
+#define SEQ66_PADLAUNCHER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          padlauncher.hpp
+ *
+ *  This module declares the voice pool that plays the patterns launched by
+ *  the drum pads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A pad hit (see padmap.hpp) does not go through the MIDI controls, the
+ *  one-shot status of the pattern, or the boundary wheel.  The input thread
+ *  posts the hit to a single-producer, single-consumer ring_buffer, and the
+ *  output thread, at the next frame, gives it a voice from a fixed pool.  A
+ *  voice plays the pattern once, from its start, at the tick of the frame
+ *  or at the next step of the quantization grid.  The voice keeps its own
+ *  start and position, so any number of hits of the same pattern can sound
+ *  at once, and the pattern need not be armed; its own playing state is
+ *  not touched.  Each frame visits the voices in use only.
+ *
+ *  When the pool is full, the hit is refused and counted, as ring_buffer
+ *  does, rather than cutting off a voice in the middle of its notes.
+ */
+
+#include <atomic>                       /* std::atomic<bool>, <int>         */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midipulse       */
+#include "play/seq.hpp"                 /* seq66::seq::pointer              */
+#include "util/ring_buffer.hpp"         /* seq66::ring_buffer<> SPSC queue  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Plays the patterns launched by the pads.
+ */
+
+class padlauncher
+{
+
+public:
+
+    /**
+     *  The default number of voices.
+     */
+
+    static const int c_voices = 64;
+
+private:
+
+    /**
+     *  A hit, posted by the input thread.
+     */
+
+    class hit
+    {
+
+    public:
+
+        seq::pointer ph_seq;            /**< The pattern to launch.         */
+        midibyte ph_velocity;           /**< The velocity of the hit.       */
+
+    };
+
+    /**
+     *  A pattern playing once.  A voice is in use while its pattern is set.
+     */
+
+    class voice
+    {
+
+    public:
+
+        seq::pointer pv_seq;            /**< The pattern being played.      */
+        midipulse pv_start;             /**< The tick of its start.         */
+        midipulse pv_next;              /**< The first tick not yet played. */
+        midibyte pv_velocity;           /**< The scaling velocity, or 0.    */
+
+    };
+
+    /**
+     *  The hits not yet given a voice.
+     */
+
+    ring_buffer<hit> m_hits;
+
+    /**
+     *  The voice pool.  The voices in use are kept at the front.
+     */
+
+    std::vector<voice> m_voices;
+
+    /**
+     *  The number of voices in use.  Written only by the output thread.
+     */
+
+    std::atomic<int> m_active;
+
+    /**
+     *  The hits refused because every voice was in use.
+     */
+
+    std::atomic<int> m_refused;
+
+    /**
+     *  Set by stop or pause, in any thread, to have the output thread drop
+     *  the voices and the posted hits at its next frame.
+     */
+
+    std::atomic<bool> m_reset;
+
+    /**
+     *  The tick of the last frame played, or -1 before the first.
+     */
+
+    midipulse m_last_tick;
+
+public:
+
+    padlauncher (int voices = c_voices);
+
+    padlauncher (const padlauncher &) = delete;
+    padlauncher & operator = (const padlauncher &) = delete;
+
+    bool post (seq::pointer s, midibyte velocity);
+    void play (midipulse tick, midipulse quantum, bool scaled);
+
+    void reset ()
+    {
+        m_reset.store(true, std::memory_order_release);
+    }
+
+    int active () const
+    {
+        return m_active.load(std::memory_order_relaxed);
+    }
+
+    int refused () const
+    {
+        return m_refused.load(std::memory_order_relaxed);
+    }
+
+    int dropped () const
+    {
+        return m_hits.dropped();
+    }
+
+    bool pending () const
+    {
+        return active() > 0 || ! m_hits.empty();
+    }
+
+private:
+
+    void clear (bool hits);
+    void take_hits (midipulse first, midipulse quantum, bool scaled);
+
+};              // class padlauncher
+
+}               // namespace seq66
+
+#endif          // SEQ66_PADLAUNCHER_HPP
+
+/*
+ * padlauncher.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-12
- * \updates       2025-01-09
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The main player!  Coordinates sets, patterns, mutes, playlists, you name
@@ -44,7 +44,10 @@
  *      play/mutegroups.hpp
  */
 
+#include <array>                        /* std::array<>                     */
+#include <atomic>                       /* std::atomic<>                    */
 #include <memory>                       /* std::shared_ptr<>, unique_ptr<>  */
+#include <mutex>                        /* std::mutex, std::lock_guard<>    */
 #include <vector>                       /* std::vector<>                    */
 #include <thread>                       /* std::thread                      */
 
@@ -52,11 +55,27 @@
 #include "ctrl/opcontainer.hpp"         /* class seq66::opcontainer         */
 #include "midi/jack_assistant.hpp"      /* optional seq66::jack_assistant   */
 #include "midi/mastermidibus.hpp"       /* seq66::mastermidibus ALSA/JACK   */
+#include "midi/tempomap.hpp"            /* seq66::tempomap tick/time        */
+#include "play/boundarywheel.hpp"       /* seq66::boundarywheel for queues  */
+#include "play/bulkops.hpp"             /* seq66::bulkops set-wide mutes    */
+#include "play/clockfollower.hpp"       /* seq66::clockfollower MIDI clock  */
+#include "play/framebatch.hpp"          /* seq66::framebatch per-buss batch */
+#include "play/frameclock.hpp"          /* seq66::frameclock input timing   */
+#include "play/inputmonitor.hpp"        /* seq66::inputmonitor for the GUI  */
+#include "play/latencyprobe.hpp"        /* seq66::latencyprobe for inputs   */
+#include "play/memoryusage.hpp"         /* seq66::memoryusage reading       */
+#include "play/linksync.hpp"            /* seq66::linksync, Ableton Link    */
 #include "play/metro.hpp"               /* seq66::metro metronome pattern   */
+#include "play/notifyqueue.hpp"         /* seq66::notifyqueue for callbacks */
+#include "play/outputstats.hpp"         /* seq66::outputstats timing stats  */
+#include "play/padlauncher.hpp"         /* seq66::padlauncher drum pads     */
 #include "play/playlist.hpp"            /* seq66::playlist                  */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "play/sessionlog.hpp"          /* seq66::sessionlog of inputs      */
+#include "play/songtimeline.hpp"        /* seq66::songtimeline              */
 #include "play/setmapper.hpp"           /* seq66::seqmanager and seqstatus  */
 #include "util/condition.hpp"           /* seq66::condition/synchronizer    */
+#include "util/ring_buffer.hpp"         /* seq66::ring_buffer<> SPSC queue  */
 
 #if defined USE_SONG_BOX_SELECT
 #include <set>                          /* std::set, arbitary selection     */
@@ -84,6 +103,8 @@ const int c_transpose_up_limit = -c_transpose_down_limit;
 
 class keystroke;
 class notemapper;
+class inputcapture;
+class playpool;
 class rcsettings;
 class usrsettings;
 
@@ -93,6 +114,7 @@ class usrsettings;
 
 class performer
 {
+    friend class blockengine;
     friend class jack_assistant;
     friend class midifile;
     friend class rcfile;
@@ -190,6 +212,72 @@ public:
 
     };
 
+    /**
+     *  A nested class to hold one control from a remote surface (e.g. OSC),
+     *  queued by post_remote_control() for dispatch_remote_controls().  The
+     *  slot is automation::slot::loop for a pattern, ::mute_group for a
+     *  group, or an automation slot.
+     */
+
+    class remotecontrol
+    {
+
+    public:
+
+        automation::slot rc_slot;       /**< The operation to call.         */
+        automation::action rc_action;   /**< Toggle, on, or off.            */
+        int rc_index;                   /**< Pattern, group, or slot number.*/
+        int rc_d1;                      /**< The value, not limited to 127. */
+        int rc_d0;                      /**< MIDI d0, or -1 for a key.      */
+        bool rc_inverse;                /**< A key release or inverse MIDI. */
+
+        remotecontrol () :
+            rc_slot     (automation::slot::none),
+            rc_action   (automation::action::none),
+            rc_index    (0),
+            rc_d1       (0),
+            rc_d0       (-1),
+            rc_inverse  (false)
+        {
+            // no code
+        }
+
+    };
+
+    /**
+     *  A nested class to hold the state that a mirroring primary sends to
+     *  its replica several times a second, so that the replica catches up
+     *  with whatever the control actions did not cover (e.g. clicks in the
+     *  user interface), and with any that were lost.
+     */
+
+    class mirrorstate
+    {
+
+    public:
+
+        bool ms_running;                /**< The primary is playing.        */
+        bool ms_song_mode;              /**< Song mode, versus Live mode.   */
+        midipulse ms_tick;              /**< The primary's current tick.    */
+        midibpm ms_bpm;                 /**< The primary's tempo.           */
+        int ms_playscreen;              /**< The playing screen-set.        */
+        std::string ms_armed;           /**< '1' or '0' for each slot.      */
+        long ms_received_us;            /**< microtime() of its arrival.    */
+
+        mirrorstate () :
+            ms_running      (false),
+            ms_song_mode    (false),
+            ms_tick         (0),
+            ms_bpm          (0.0),
+            ms_playscreen   (0),
+            ms_armed        (),
+            ms_received_us  (0)
+        {
+            // no code
+        }
+
+    };
+
     /**
      *  A nested class used for notification of group-learn and other changes.
      *  The easiest way to use this class is by inheriting from it, then
@@ -587,6 +675,94 @@ private:                            /* key, midi, and op container section  */
 
     opcontainer m_operations;
 
+    /**
+     *  The keystroke dispatch table, indexed by the key ordinal: the bound
+     *  keycontrol and its midioperation, both null for an unbound key.  It
+     *  points into m_key_controls and m_operations, and is rebuilt by
+     *  bind_keys() whenever either one is replaced or added to, so that
+     *  midi_control_keystroke() does no map lookups.
+     */
+
+    using keybinding = struct
+    {
+        const keycontrol * kb_control;
+        const midioperation * kb_operation;
+    };
+
+    std::array<keybinding, 256> m_key_bindings;
+
+    /**
+     *  Holds the controls posted by a remote surface, such as the OSC
+     *  control server or the state mirror's client, until the input thread
+     *  dispatches them, as it does MIDI controls.  The one consumer needs
+     *  no lock; the producers are serialized by m_remote_mutex, which no
+     *  other thread takes.
+     */
+
+    ring_buffer<remotecontrol> m_remote_controls;
+    std::mutex m_remote_mutex;
+
+    /**
+     *  For a mirroring primary, holds the controls done here, from MIDI, the
+     *  keyboard, or OSC, until the mirror thread sends them to the replica.
+     *  The input and user-interface threads both push, under m_mirror_mutex;
+     *  the mirror thread is the one consumer.
+     */
+
+    ring_buffer<remotecontrol> m_mirror_actions;
+
+    /**
+     *  Serializes the pushes to m_mirror_actions on a primary, and guards
+     *  m_mirror_state on a replica.  Never taken by the output thread.
+     */
+
+    std::mutex m_mirror_mutex;
+
+    /**
+     *  For a replica, the latest state from the primary, and whether the
+     *  input thread has yet to apply it.  See mirror_follow().
+     */
+
+    mirrorstate m_mirror_state;
+    bool m_mirror_state_new;
+
+    /**
+     *  For a replica, the microtime() of the last message from the primary,
+     *  or 0 if none has come yet.
+     */
+
+    std::atomic<long> m_mirror_heard_us;
+
+    /**
+     *  For a replica, a position to jump to, set by the input thread when
+     *  the replica has drifted from the primary, and applied by the output
+     *  thread at the top of its next frame.  -1 if none.
+     */
+
+    std::atomic<long> m_mirror_pos;
+
+    /**
+     *  True for a mirroring primary, which queues its controls to
+     *  m_mirror_actions.  Set at launch.
+     */
+
+    bool m_mirror_primary;
+
+    /**
+     *  True for a replica that is still following a primary, with the
+     *  output on standby.  Cleared by mirror_takeover().  Input thread only.
+     */
+
+    bool m_mirror_following;
+
+    /**
+     *  Holds the mutes, unmutes, and toggles of whole sets posted while
+     *  playing, until the output thread applies them at the top of its
+     *  next frame.  See the bulkops module.
+     */
+
+    bulkops m_bulk_ops;
+
     /**
      *  Pulls out the set-specific manipulations needed by the qsetmaster
      *  user-interface class.  These are moved out of setmapper for increased
@@ -633,6 +809,95 @@ private:                            /* key, midi, and op container section  */
 
     bool m_in_thread_launched;
 
+    /**
+     *  The optional pool of threads that helps the output thread play the
+     *  patterns in Live mode.  Created with the output thread when the
+     *  "output-workers" option is non-zero.  See performer::play().
+     */
+
+    std::unique_ptr<playpool> m_play_pool;
+
+    /**
+     *  The patterns handed to m_play_pool in the current frame.  Kept as a
+     *  member so that its storage is reused.
+     */
+
+    std::vector<sequence *> m_play_jobs;
+
+    /**
+     *  The queued and one-shot boundaries to come, so that the Live-mode
+     *  loop of play() handles only the patterns whose boundary falls in the
+     *  frame.  See schedule_boundary().
+     */
+
+    boundarywheel m_boundary_wheel;
+
+    /**
+     *  The patterns whose boundary has come in the current frame.  Kept as
+     *  a member so that its storage is reused.
+     */
+
+    boundarywheel::patterns m_due_boundaries;
+
+    /**
+     *  Plays the patterns launched by the drum pads, each once, in a voice
+     *  of its own.  See pad_event().
+     */
+
+    padlauncher m_pad_launcher;
+
+    /**
+     *  The output of the frame being played by play(), gathered by buss, so
+     *  that each buss is written to once per frame.
+     */
+
+    framebatch m_frame_batch;
+
+    /**
+     *  The time and tick of the last frame played, used to place recorded
+     *  events at the tick at which they arrived.  See input_tick().
+     */
+
+    frameclock m_frame_clock;
+
+    /**
+     *  Measures the latency of an input buss, when "latency-probe-out" and
+     *  "latency-probe-in" are set.  Used by the input thread only.
+     */
+
+    latencyprobe m_latency_probe;
+
+    /**
+     *  Joins an Ableton Link session, when "link-sync" is set.  The output
+     *  thread then takes its ticks from the Link beat timeline, and the
+     *  input thread follows the starts and stops of the session.
+     */
+
+    linksync m_link_sync;
+
+    /**
+     *  The optional recorder of all MIDI input, fed by the input thread.
+     *  Created with the input thread when "input-capture" names a
+     *  directory.  See performer::poll_cycle().
+     */
+
+    std::unique_ptr<inputcapture> m_input_capture;
+
+    /**
+     *  The tap of all MIDI input for the input monitor window, fed by the
+     *  input thread only while the window is open.
+     */
+
+    inputmonitor m_input_monitor;
+
+    /**
+     *  The optional log of the control inputs, for "seq66cli --replay".
+     *  Started by launch() when "-o session-log" names a file, and written
+     *  by finish().
+     */
+
+    sessionlog m_session_log;
+
     /**
      *  Indicates merely that the input and output thread functions can keep
      *  running.  Replaces m_inputing and m_outputing.
@@ -665,12 +930,29 @@ private:                            /* key, midi, and op container section  */
 
     mutable bool m_needs_update;
 
+    /**
+     *  A counter bumped by set_needs_update(), which, unlike the flag, is
+     *  not consumed by the first GUI to read it.  See update_generation().
+     */
+
+    std::atomic<unsigned> m_update_generation;
+
     /**
      *  Indicates to belay updates during critical work.
      */
 
     bool m_is_busy;
 
+    /**
+     *  Counts the nested batches of output in progress.  While it is not zero,
+     *  the note-offs of patterns being muted and the control-out feedback are
+     *  queued in the master bus without a flush, and the closing of the
+     *  outermost batch flushes them as one burst.  Atomic, as the output
+     *  thread checks it when it mutes or unmutes a pattern.
+     */
+
+    std::atomic<int> m_output_batch;
+
     /**
      *  Indicates that status of the "loop" button in the performance editor.
      *  If true, the performance will loop between the L and R markers in the
@@ -751,6 +1033,13 @@ private:                            /* key, midi, and op container section  */
 
     std::atomic<bool> m_resolution_change;
 
+    /**
+     *  True while the JACK process callback is inside jack_engine_cycle(),
+     *  so that output_func() can wait for it before stopping.
+     */
+
+    std::atomic<bool> m_jack_engine_busy;
+
     /**
      *  Indicates the number of beats considered in calculating the BPM via
      *  button tapping.  This value is displayed in the button.
@@ -766,6 +1055,58 @@ private:                            /* key, midi, and op container section  */
 
     long m_delta_us;
 
+    /**
+     *  The timing statistics of the output thread: wake-up lateness,
+     *  underruns, frame time, events per frame, and pattern-lock waits.
+     *  See output_statistics().
+     */
+
+    outputstats m_output_stats;
+
+    /**
+     *  The compiled song, used by the output thread to skip the patterns
+     *  that have nothing to do in a Song-mode frame.  It is compiled again
+     *  by the output thread when m_trigger_generation changes, which
+     *  happens whenever any trigger is edited or the play-set changes.
+     */
+
+    songtimeline m_song_timeline;
+    std::atomic<unsigned> m_trigger_generation;
+
+    /**
+     *  Counts the loop wraps, and holds the left tick of the last one.  A
+     *  pattern that sees a new count resets itself the first time it plays
+     *  (see sequence::loop_wrapped()), so that the wrap does not stop and
+     *  rewind every pattern in the frame that crosses the loop point.
+     */
+
+    std::atomic<unsigned> m_wrap_generation;
+    std::atomic<midipulse> m_wrap_tick;
+
+    /**
+     *  The tempo map of the song, built from the tempo events of the tempo
+     *  track, starting at m_tempo_map_bpm.  It is built again when first
+     *  needed after m_tempo_map_stale is set, which happens when the tempo
+     *  track is edited, the PPQN changes, or the user sets the tempo.  The
+     *  output thread and the user interface both use it, hence the mutex.
+     */
+
+    mutable recmutex m_tempo_map_mutex;
+    mutable tempomap m_tempo_map;
+    mutable std::atomic<bool> m_tempo_map_stale;
+    midibpm m_tempo_map_bpm;
+
+    /**
+     *  A tempo event met by a pattern while playing a frame, and its tick.
+     *  The patterns only post it here (see schedule_tempo()); play() sets
+     *  the tempo once the frame is played, outside the pattern locks.  If
+     *  several are met in a frame, the latest in the song wins.  A tempo of
+     *  0 means there is none pending.
+     */
+
+    std::atomic<midibpm> m_tempo_pending;
+    std::atomic<midipulse> m_tempo_pending_tick;
+
     /**
      *  Indicates the first time the tap button was ... tapped.
      */
@@ -857,6 +1198,14 @@ private:                            /* key, midi, and op container section  */
 
     std::vector<sequence *> m_buss_patterns;
 
+    /**
+     *  The routing table built from m_buss_patterns by
+     *  sequence_inbus_setup(), so that the input thread finds the pattern
+     *  for a buss and channel directly.  Swapped with std::atomic_store().
+     */
+
+    recordroutes::pointer m_buss_routes;
+
     /**
      *  Holds the "one measure's worth" of pulses (ticks), which is normally
      *  m_ppqn * 4.  We can save some multiplications, and, more importantly,
@@ -960,6 +1309,13 @@ private:                            /* key, midi, and op container section  */
 
     int m_midiclockpos;
 
+    /**
+     *  Tracks the tempo and phase of incoming MIDI clock, so that playback
+     *  can follow it at full PPQN resolution.  See rc().midi_clock_follow().
+     */
+
+    clockfollower m_clock_follower;
+
     /**
      *  Support for pause, which does not reset the "last tick" when playback
      *  stops/starts.  All this member is used for is keeping the last tick
@@ -1051,6 +1407,16 @@ private:                            /* key, midi, and op container section  */
 
     callbacks::clients m_notify;
 
+    /**
+     *  Holds the notifications raised on threads other than the one that
+     *  registered the first client (normally the user-interface thread),
+     *  until that thread calls deliver_notifications(). The output thread
+     *  then never runs a client's handler.
+     */
+
+    notifyqueue m_notify_queue;
+    std::atomic<std::thread::id> m_notify_thread;
+
     /**
      *  If true, indicate certain events, like song-changes, occur via a
      *  signal.  In a headless run, there's no conflict with Qt's threads, but
@@ -1123,6 +1489,17 @@ public:
 
     void enregister (callbacks * pfcb);             /* for notifications    */
     void unregister (callbacks * pfcb);
+    int deliver_notifications ();
+
+    int send_pending_feedback ()
+    {
+        return midi_control_out().send_pending();
+    }
+
+    bool feedback_pending () const
+    {
+        return midi_control_out().feedback_pending();
+    }
     void notify_automation_change (automation::slot s);
     void notify_set_change (screenset::number setno, change mod = change::yes);
     void notify_mutes_change (mutegroup::number setno, change mod = change::yes);
@@ -1240,6 +1617,7 @@ public:
 
     bool add_to_play_set (sequence * s);
     bool fill_play_set (bool clearit = true);
+    bool output_tag_shared (const sequence & s) const;
 
     /*
      * Start of playlist accessors.  Playlist functionality.  Note that we
@@ -1386,6 +1764,18 @@ public:
             m_play_list->song_filename() : std::string("") ;
     }
 
+    bool playlist_item (int index, int & midinumber, std::string & name) const
+    {
+        return bool(m_play_list) ?
+            m_play_list->list_item(index, midinumber, name) : false ;
+    }
+
+    bool song_item (int index, int & midinumber, std::string & name) const
+    {
+        return bool(m_play_list) ?
+            m_play_list->song_item(index, midinumber, name) : false ;
+    }
+
     std::string song_filepath () const
     {
         return bool(m_play_list) ?
@@ -1502,6 +1892,7 @@ public:
     bool repitch_all (const std::string & nmapfile, seq::ref s);
     bool repitch_selected (const std::string & nmapfile, seq::ref s);
     bool repitch_fix (const std::string & nmapfile, seq::ref s, bool reverse);
+    bool live_notemap (seq::ref s, bool on);
 
     setmapper & set_mapper ()
     {
@@ -1537,6 +1928,11 @@ public:
         return set_master().screenset_active_count();
     }
 
+    int screenset_seq_count (screenset::number setno) const
+    {
+        return set_master().active_count(setno);
+    }
+
     int highest_set () const
     {
         return set_master().highest_set();
@@ -2236,6 +2632,7 @@ public:
     bool clear_all (bool clearplaylist = false);
     bool clear_song ();
     bool launch (int ppqn);
+    bool launch_offline (int ppqn);
     bool finish ();
     bool activate ();
     bool new_sequence
@@ -2292,6 +2689,7 @@ public:
 
     bool auto_play_start ();
     bool auto_play_stop (midipulse tick);
+    bool gapless_handover (midipulse tick);
     void auto_stop (bool rewind = false);
     void auto_pause ();
     void auto_play ();
@@ -2455,6 +2853,68 @@ public:
         return m_delta_us;
     }
 
+    outputstats & output_stats ()
+    {
+        return m_output_stats;
+    }
+
+    inputmonitor & input_monitor ()
+    {
+        return m_input_monitor;
+    }
+
+    const sessionlog & session_log () const
+    {
+        return m_session_log;
+    }
+
+    bool dispatch_midi_input (event & ev);
+
+    outputstats::values output_statistics ();
+    memoryusage memory_usage () const;
+    static long frame_budget_us ();
+    int captures_dropped () const;
+
+    int notices_dropped () const
+    {
+        return m_notify_queue.dropped();
+    }
+
+    void clear_output_statistics ()
+    {
+        m_output_stats.clear();
+    }
+
+    void song_timeline_stale ()
+    {
+        m_trigger_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    unsigned trigger_generation () const
+    {
+        return m_trigger_generation.load(std::memory_order_acquire);
+    }
+
+    unsigned wrap_generation () const
+    {
+        return m_wrap_generation.load(std::memory_order_acquire);
+    }
+
+    midipulse wrap_tick () const
+    {
+        return m_wrap_tick.load(std::memory_order_relaxed);
+    }
+
+    void tempo_map_stale ()
+    {
+        m_tempo_map_stale = true;
+    }
+
+    double tick_to_us (midipulse tick) const;
+    midipulse us_to_tick (double us) const;
+    midibpm tempo_at (midipulse tick) const;
+    midipulse next_tempo_change (midipulse tick) const;
+
     void clear_current_beats ()
     {
         m_current_beats = m_base_time_ms = m_last_time_ms = 0;
@@ -2535,7 +2995,7 @@ public:
 
     void mute_all_tracks (bool flag = true)
     {
-        set_mapper().mute_all_tracks(flag);
+        post_bulk_op(flag ? bulkops::op::mute : bulkops::op::arm);
     }
 
     /**
@@ -2548,9 +3008,17 @@ public:
 
     void toggle_all_tracks ()
     {
-        set_mapper().toggle();
+        post_bulk_op(bulkops::op::toggle);
     }
 
+    void post_bulk_op (bulkops::op o);
+
+    void schedule_boundary (sequence * s, midipulse tick)
+    {
+        m_boundary_wheel.post(s, tick);
+    }
+    void toggle_all_song_mutes ();
+
     void set_song_mute (mutegroups::action op);
     void mute_screenset (int ss, bool flag = true);
 
@@ -2567,7 +3035,10 @@ public:
     void toggle_playing_tracks ()
     {
         if (! song_mode())
+        {
+            (void) apply_bulk_ops();
             set_mapper().toggle_playing_tracks();
+        }
     }
 
     bool any_group_unmutes () const
@@ -2581,6 +3052,7 @@ public:
         seq::number & seqno,
         bool fileload = false
     );
+    int install_sequences (const std::vector<sequence *> & seqs);
     bool install_metronome ();
     bool reload_metronome ();
     void remove_metronome ();
@@ -2989,7 +3461,7 @@ public:
     );
     void send_onoff_play_states (midicontrolout::uiaction a);
     void send_mutes_event (int group, bool on);
-    void send_mutes_events (int groupon, int groupoff);
+    void send_mutes_events (int groupon, int groupoff, bool flush = true);
     void send_mutes_inactive (int group);
     void announce_playscreen ();
     void announce_automation (bool activate = true);
@@ -3012,13 +3484,32 @@ public:
     void set_needs_update (bool flag = true)
     {
         m_needs_update = flag;
+        if (flag)
+            m_update_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned update_generation () const
+    {
+        return m_update_generation.load(std::memory_order_relaxed);
     }
 
     void send_seq_event (int seqno, midicontrolout::seqaction what)
     {
-        midi_control_out().send_seq_event(seqno, what);
+        midi_control_out().send_seq_event(seqno, what, ! output_batched());
+    }
+
+    bool output_batched () const
+    {
+        return m_output_batch.load(std::memory_order_acquire) > 0;
+    }
+
+    void begin_output_batch ()
+    {
+        m_output_batch.fetch_add(1, std::memory_order_acq_rel);
     }
 
+    void end_output_batch ();
+
     void send_macro (const std::string & name)
     {
         midi_control_out().send_macro(name);
@@ -3386,6 +3877,8 @@ public:         /* GUI-support functions */
     }
 
     bool set_beats_per_minute (midibpm bp, bool user_change = false);
+    void schedule_tempo (midipulse tick, midibpm bp);
+    bool apply_scheduled_tempo ();
     bool set_ppqn (int p);
     bool change_ppqn (int p);
     bool ui_change_set_bus (int b);
@@ -3399,6 +3892,8 @@ private:
     }
 
     bool calculate_snap (midipulse & tick);
+    bool apply_ppqn (int p);
+    void rescale_patterns (int p);
     void show_cpu ();
     bool playlist_activate (bool on);
     void playlist_auto_arm (bool on);
@@ -3470,6 +3965,38 @@ public:                                 /* access functions for the containers *
 
     bool midi_control_keystroke (const keystroke & k);
     bool midi_control_event (const event & ev, bool recording = false);
+    bool pad_event (const event & ev);
+
+    const padlauncher & pad_launcher () const
+    {
+        return m_pad_launcher;
+    }
+
+    bool post_remote_control
+    (
+        automation::slot s, automation::action a, int index, int d1 = 0,
+        int d0 = (-1), bool inverse = false
+    );
+    int dispatch_remote_controls ();
+    bool pop_mirror_action (remotecontrol & c);
+    void get_mirror_state (mirrorstate & ms);
+    void post_mirror_state (const mirrorstate & ms);
+
+    bool mirror_following () const
+    {
+        return m_mirror_following;
+    }
+
+    int mirror_actions_dropped () const
+    {
+        return m_mirror_actions.dropped();
+    }
+
+    int remote_controls_dropped () const
+    {
+        return m_remote_controls.dropped();
+    }
+
     void signal_save ();
     void signal_quit ();
 
@@ -3567,13 +4094,24 @@ public:                                 /* access functions for the containers *
 
     bool strip_empty (bool flag);
 
+    /*
+     *  The mute-groups of a MIDI file are decoded when they are first
+     *  asked for; see mutegroups::defer_midi().
+     */
+
     const mutegroups & mutes () const
     {
+        if (m_mute_groups.deferred())
+            const_cast<mutegroups &>(m_mute_groups).resolve();
+
         return m_mute_groups;
     }
 
     mutegroups & mutes ()
     {
+        if (m_mute_groups.deferred())
+            m_mute_groups.resolve();
+
         return m_mute_groups;
     }
 
@@ -3614,6 +4152,49 @@ private:
 private:
 
     void output_func ();
+    midipulse next_output_tick (midipulse tick) const;
+    void update_tempo_map () const;
+    midipulse input_tick (const event & ev) const;
+    void probe_latency ();
+    void link_follow ();
+    void mirror_control
+    (
+        automation::slot s, automation::action a,
+        int d0, int d1, int index, bool inverse
+    );
+    void mirror_follow ();
+    void apply_mirror_state (const mirrorstate & ms);
+    void mirror_takeover ();
+    long output_deadline (long basetime, double pus, double dct);
+    void play_cycle (long delta_tick);
+    void play_parallel (midipulse tick);
+    void play_song (midipulse tick);
+    int apply_bulk_ops ();
+    void play_boundaries (midipulse tick, bool resume);
+    void play_pads (midipulse tick);
+    void schedule_boundaries ();
+    bulkops::bits play_set_bits () const;
+    bool jack_engine_start ();
+    void jack_engine_stop ();
+
+#if defined SEQ66_JACK_SUPPORT
+
+    static bool jack_engine_callback
+    (
+        void * arg,
+        jack_nframes_t nframes,
+        jack_nframes_t rate,
+        jack_assistant::engine_window & window
+    );
+    bool jack_engine_cycle
+    (
+        jack_nframes_t nframes,
+        jack_nframes_t rate,
+        jack_assistant::engine_window & window
+    );
+
+#endif
+
     void input_func ();
     bool poll_cycle ();
     void launch_input_thread ();
@@ -3648,6 +4229,10 @@ private:
         return mod == change::yes || mod == change::removed;
     }
 
+    bool notify_deferred () const;
+    void dispatch_notice (const notifyqueue::notice & n);
+    void deliver_notice (const notifyqueue::notice & n);
+
 public:
 
     bool signalled_changes () const
@@ -3750,6 +4335,7 @@ public:
         int index, bool inverse
     );
     bool populate_default_ops ();
+    void bind_keys ();
     bool add_automation                 /* [automation-control] */
     (
         automation::slot s,
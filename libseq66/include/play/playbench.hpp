@@ -0,0 +1,113 @@
+#if ! defined SEQ66_PLAYBENCH_HPP
+#define SEQ66_PLAYBENCH_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playbench.hpp
+ *
+ *  This module declares a measurement of the pattern playback engine, as
+ *  run by "seq66cli --bench".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The patterns of a MIDI file, or of a synthetic song, are armed in a
+ *  performer that is never launched, and are played frame by frame over
+ *  simulated time, as the output thread does in Live mode.  There is no
+ *  master buss: the patterns are played inside a playpool run, which
+ *  captures the outgoing events instead of sending them.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Holds the options of a playback benchmark and runs it.
+ */
+
+class playbench
+{
+
+private:
+
+    /**
+     *  The MIDI files to measure, one after the other.  If empty, a
+     *  synthetic song is measured.
+     */
+
+    std::vector<std::string> m_files;
+
+    /**
+     *  The number of patterns of the synthetic song.
+     */
+
+    int m_synthetic;
+
+    /**
+     *  The number of frames to play for each measurement.
+     */
+
+    int m_frames;
+
+    /**
+     *  The number of worker threads of the playpool, as with the
+     *  "output-workers" option.  Zero plays the patterns serially.
+     */
+
+    int m_workers;
+
+public:
+
+    playbench ();
+
+    static bool requested (int argc, char * argv []);
+    static void show_help ();
+
+    bool parse (int argc, char * argv []);
+    int run ();
+
+private:
+
+    bool make_synthetic (performer & p);
+    void measure (performer & p, const std::string & name);
+
+};          // class playbench
+
+}           // namespace seq66
+
+#endif      // SEQ66_PLAYBENCH_HPP
+
+/*
+ * playbench.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
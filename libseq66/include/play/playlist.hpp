@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-26
- * \updates       2023-07-13
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  * \todo
@@ -36,6 +36,7 @@
  */
 
 #include <map>                          /* std::map<>                       */
+#include <thread>                       /* std::thread                      */
 
 #include "cfg/basesettings.hpp"         /* seq66::basesettings class        */
 
@@ -280,6 +281,16 @@ private:
 
     bool m_auto_advance;
 
+    /**
+     *  If true, and auto-advance is engaged, the next song takes over at the
+     *  first bar line at or after the end of the current song, without
+     *  stopping playback.  No MIDI Stop or Start is sent, and the MIDI clock
+     *  carries on at the tempo of the new song.  See performer::
+     *  gapless_handover().
+     */
+
+    bool m_gapless;
+
     /**
      *  If non-empty, this provides the base directory for all MIDI files in
      *  all playlists.  Sometimes we need this, for example when importing
@@ -295,6 +306,14 @@ private:
 
     bool m_show_on_stdout;
 
+    /**
+     *  Reads the files of the songs before and after the current song into
+     *  the system's file cache after each song is opened, so that the next
+     *  song switch does not wait on the disk.  See prefetch_neighbors().
+     */
+
+    std::thread m_prefetch_thread;
+
 public:
 
     playlist
@@ -411,6 +430,21 @@ public:
         m_auto_advance = flag;
     }
 
+    bool gapless () const
+    {
+        return m_gapless;
+    }
+
+    bool gapless_engaged () const
+    {
+        return auto_advance_engaged() && gapless();
+    }
+
+    void gapless (bool flag)
+    {
+        m_gapless = flag;
+    }
+
     void midi_base_directory (const std::string & basedir);
 
     const std::string & midi_base_directory () const
@@ -466,6 +500,8 @@ public:
 
     std::string song_filename () const; /* base-name, optional directory    */
     std::string song_filepath () const; /* for current song                 */
+    bool list_item (int index, int & midinumber, std::string & name) const;
+    bool song_item (int index, int & midinumber, std::string & name) const;
 
     int song_count () const
     {
@@ -502,6 +538,7 @@ public:
     bool select_song_by_midi (int ctrl);
     bool next_song ();
     bool previous_song ();
+    void prefetch_neighbors ();
     int next_available_song_number () const;
     int next_available_list_number () const;
 
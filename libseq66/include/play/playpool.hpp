@@ -0,0 +1,207 @@
+#if ! defined SEQ66_PLAYPOOL_HPP
+#define SEQ66_PLAYPOOL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playpool.hpp
+ *
+ *  This module declares a small pool of threads that play patterns in
+ *  parallel for the output thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  With a large playscreen, the output thread spends most of each frame
+ *  walking the patterns one after the other.  The playpool lets the output
+ *  thread hand the patterns to a few worker threads (and work on them
+ *  itself), each pattern being claimed by exactly one thread.  While a
+ *  pattern is played by the pool, sequence::put_event_on_bus() does not
+ *  write to the master buss; it appends the outgoing event to the buffer of
+ *  the thread doing the work.  When all patterns are done, the buffers are
+ *  merged by timestamp (ties keep the pattern order) and the output thread
+ *  sends the result, so that the buss is only touched by one thread and the
+ *  output is the same as playing the patterns serially.
+ */
+
+#include <atomic>                       /* std::atomic<int>                 */
+#include <condition_variable>           /* std::condition_variable          */
+#include <functional>                   /* std::function<>                  */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector                      */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Runs a frame's worth of pattern playback across a set of threads, and
+ *  gathers the resulting output.
+ */
+
+class playpool
+{
+
+public:
+
+    /**
+     *  An event captured from sequence::put_event_on_bus(), along with the
+     *  buss and channel it is destined for, the index of the job (the
+     *  pattern) that produced it, and the pattern's tag (see framebatch).
+     */
+
+    class message
+    {
+
+    public:
+
+        event m_event;
+        int m_order;
+        bussbyte m_bus;
+        midibyte m_channel;
+        midibyte m_tag;
+
+        message
+        (
+            const event & ev, int order,
+            bussbyte bus, midibyte ch, midibyte tag
+        ) :
+            m_event     (ev),
+            m_order     (order),
+            m_bus       (bus),
+            m_channel   (ch),
+            m_tag       (tag)
+        {
+            // no code
+        }
+
+    };
+
+    using messages = std::vector<message>;
+    using job = std::function<void (int)>;
+
+private:
+
+    /**
+     *  The extra threads.  The calling thread is a worker, too.
+     */
+
+    std::vector<std::thread> m_threads;
+
+    /**
+     *  One capture buffer per thread, the first one belonging to the caller
+     *  of run().  Reused from frame to frame, so that no allocations are
+     *  made once the buffers have grown to the size of a busy frame.
+     */
+
+    std::vector<messages> m_buffers;
+
+    /**
+     *  The output of the last call to run(), in timestamp order.
+     */
+
+    messages m_merged;
+
+    /**
+     *  Synchronizes the start and the end of each frame.
+     */
+
+    std::mutex m_mutex;
+    std::condition_variable m_start_cond;
+    std::condition_variable m_done_cond;
+
+    /**
+     *  Incremented for each frame, so that a worker can tell a new frame
+     *  from a spurious wake-up.
+     */
+
+    unsigned m_generation;
+
+    /**
+     *  The number of extra threads that have not finished the frame.
+     */
+
+    int m_pending;
+
+    /**
+     *  The job of the current frame, the number of jobs, and the index of
+     *  the next job to be claimed.
+     */
+
+    const job * m_job;
+    int m_job_count;
+    std::atomic<int> m_next_job;
+
+    /**
+     *  Set in the destructor to make the worker threads exit.
+     */
+
+    bool m_quit;
+
+public:
+
+    explicit playpool (int workers);
+    ~playpool ();
+
+    playpool (const playpool &) = delete;
+    playpool & operator = (const playpool &) = delete;
+
+    int workers () const
+    {
+        return int(m_threads.size());
+    }
+
+    std::thread & worker_thread (int w)
+    {
+        return m_threads[std::size_t(w)];
+    }
+
+    messages & run (int count, const job & fn);
+
+    static bool capture
+    (
+        bussbyte bus, const event & ev, midibyte channel, midibyte tag = 0
+    );
+
+private:
+
+    void worker (std::size_t index);
+    void work (std::size_t index);
+
+};          // class playpool
+
+}           // namespace seq66
+
+#endif      // SEQ66_PLAYPOOL_HPP
+
+/*
+ * playpool.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
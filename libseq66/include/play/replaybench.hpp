@@ -0,0 +1,201 @@
+#if ! defined SEQ66_REPLAYBENCH_HPP
+#define SEQ66_REPLAYBENCH_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          replaybench.hpp
+ *
+ *  This module declares the replay of a session log against the engine, as
+ *  run by "seq66cli --replay".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A companion to the playback benchmark (see playbench.hpp).  The inputs
+ *  of a session log (see sessionlog.hpp) are fed to a performer that uses
+ *  the null MIDI API, and that is launched without its input and output
+ *  threads (see performer::launch_offline()).  The harness plays the frames
+ *  itself, on a virtual clock that advances a 64th note per frame while
+ *  the transport runs.  Each input is applied at the first frame at or
+ *  past its tick, or at once while the transport is stopped, so a run
+ *  depends only on the log, the song, and the default settings, and not
+ *  on the speed of the machine.
+ *
+ *  The events played by the patterns are captured inside a playpool run,
+ *  as in the playback benchmark, and make up the output stream.  The
+ *  stream and the frame-time statistics can be saved as a baseline, or
+ *  compared to one: the stream must match exactly, and the mean frame
+ *  time may be checked against a tolerance.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midipulse       */
+#include "play/sessionlog.hpp"          /* seq66::sessionlog::entry         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Holds the options of a replay and runs it.
+ */
+
+class replaybench
+{
+
+public:
+
+    /**
+     *  One event of the output stream.
+     */
+
+    class sample
+    {
+
+    public:
+
+        midipulse rs_tick;              /**< The timestamp of the event.    */
+        bussbyte rs_bus;                /**< The output buss.               */
+        midibyte rs_status;             /**< The status of the event.       */
+        midibyte rs_channel;            /**< The channel it is sent on.     */
+        midibyte rs_d0;                 /**< The first data byte.           */
+        midibyte rs_d1;                 /**< The second data byte.          */
+
+        bool operator == (const sample & rhs) const;
+
+        bool operator != (const sample & rhs) const
+        {
+            return ! (*this == rhs);
+        }
+
+    };
+
+    using stream = std::vector<sample>;
+
+    /**
+     *  The frame-time statistics of a replay, in nanoseconds.
+     */
+
+    class timing
+    {
+
+    public:
+
+        long rt_frames;                 /**< The number of frames timed.    */
+        double rt_mean;                 /**< The mean frame time.           */
+        double rt_median;               /**< The median frame time.         */
+        double rt_p99;                  /**< The 99th percentile.           */
+        double rt_max;                  /**< The longest frame.             */
+
+        timing ();
+
+    };
+
+private:
+
+    /**
+     *  The session log to replay.
+     */
+
+    std::string m_logfile;
+
+    /**
+     *  The MIDI file to load first.  If empty, the log is replayed against
+     *  an empty song, which still exercises the controls.
+     */
+
+    std::string m_songfile;
+
+    /**
+     *  The baseline to compare to, and the baseline to write.  Either or
+     *  both can be empty.
+     */
+
+    std::string m_baseline;
+    std::string m_save_baseline;
+
+    /**
+     *  The number of times the log is replayed.  Every run must give the
+     *  same stream; the timing is gathered over all of them.
+     */
+
+    int m_repeat;
+
+    /**
+     *  The frames played after the last input while the transport runs.
+     */
+
+    int m_tail;
+
+    /**
+     *  The allowed increase of the mean frame time over the baseline, in
+     *  percent.  Zero only reports the change.
+     */
+
+    double m_tolerance;
+
+public:
+
+    replaybench ();
+
+    static bool requested (int argc, char * argv []);
+    static void show_help ();
+
+    bool parse (int argc, char * argv []);
+    int run ();
+
+private:
+
+    bool replay
+    (
+        const sessionlog & log, stream & out,
+        std::vector<double> & frametimes
+    );
+    static void apply (performer & p, const sessionlog::entry & e);
+    static timing statistics (std::vector<double> & frametimes);
+    bool write_baseline (const stream & s, const timing & t) const;
+    bool read_baseline (stream & s, timing & t) const;
+    bool compare
+    (
+        const stream & s, const timing & t,
+        const stream & base, const timing & basetime
+    ) const;
+
+};          // class replaybench
+
+}           // namespace seq66
+
+#endif      // SEQ66_REPLAYBENCH_HPP
+
+/*
+ * replaybench.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
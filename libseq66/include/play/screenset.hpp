@@ -29,7 +29,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2024-11-17
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module also creates a small structure for managing sequence
@@ -220,6 +220,17 @@ private:
 
     container m_container;
 
+    /**
+     *  Holds a dense list of the active sequences of m_container, sorted by
+     *  output buss, so that play() visits only the patterns that exist,
+     *  and for locality, each buss's patterns in a row.  It is kept up to
+     *  date by add(), remove(), and clear().  The pointers are owned by the
+     *  seq objects in m_container.  A later change of buss leaves the order
+     *  a bit less local, but is otherwise harmless.
+     */
+
+    std::vector<sequence *> m_active_seqs;
+
     /**
      *  Indicates the the set (bank) number represented by this screenset
      *  object.  If set to sm_number_none, this screenset is not active.
@@ -367,7 +378,10 @@ public:
         return m_is_playscreen;
     }
 
+    static bool default_name (const std::string & nm);
+
     bool active () const;
+    bool vacant () const;
     int active_count () const;
     seq::number first_seq () const;
 
@@ -588,6 +602,11 @@ private:
         return m_container;
     }
 
+    const std::vector<sequence *> & active_seqs () const
+    {
+        return m_active_seqs;
+    }
+
     container & seq_container ()
     {
         return m_container;
@@ -613,6 +632,7 @@ private:
     void arm (seq::number seqno);
     void mute (seq::number seqno);
     void all_notes_off ();
+    static bool bus_order (const sequence * a, const sequence * b);
 
 };              // class screenset
 
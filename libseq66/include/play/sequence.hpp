@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-30
- * \updates       2025-01-07
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The functions add_list_var() and add_long_list() have been replaced by
@@ -38,16 +38,22 @@
  *  module, and now just call its member functions to do the actual work.
  */
 
+#include <array>                        /* std::array<>                     */
 #include <atomic>                       /* std::atomic<bool> for dirt       */
-#include <stack>                        /* std::stack<eventlist>            */
+#include <cstdint>                      /* std::uint64_t                    */
+#include <memory>                       /* std::shared_ptr<>                */
 #include <string>                       /* std::string                      */
+#include <unordered_set>                /* std::unordered_set<>             */
 
 #include "seq66_features.hpp"           /* various feature #defines         */
 #include "cfg/usrsettings.hpp"          /* enum class record                */
 #include "midi/calculations.hpp"        /* seq66::lengthfix, alteration     */
 #include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+#include "midi/outputfilter.hpp"        /* seq66::outputfilter              */
+#include "midi/playevents.hpp"         /* seq66::playevents                */
 #include "play/triggers.hpp"            /* seq66::triggers, etc.            */
-#include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
+#include "util/recmutex.hpp"            /* seq66::recmutex                  */
+#include "util/rwmutex.hpp"             /* seq66::rwmutex, read/writelock   */
 
 /**
  *  Provides an integer value for color that matches PaletteColor::none.  That
@@ -65,8 +71,10 @@ namespace seq66
 {
 
 class mastermidibus;
+class memoryusage;
 class notemapper;
 class performer;
+class tempomap;
 
 /**
  *  Provides a way to save a sequence palette color in a single byte.  This
@@ -180,6 +188,20 @@ class sequence
 
 public:
 
+    /**
+     *  An immutable, compact copy of the events, used for playback.  See
+     *  publish_snapshot().
+     */
+
+    using snapshot = std::shared_ptr<const playevents>;
+
+    /**
+     *  An immutable output filter, swapped in whole when it is changed.
+     *  See output_filter().
+     */
+
+    using filter = std::shared_ptr<const outputfilter>;
+
     /**
      *  Provides a setting for Live vs. Song mode.  Much easier to grok and
      *  expand than a boolean.
@@ -193,6 +215,38 @@ public:
         max
     };
 
+    /**
+     *  One consistent copy of the settings and counts of the pattern, for
+     *  the song summary, taken under one lock by get_summary().  The event
+     *  counts come from the cached statistics.
+     */
+
+    class summary
+    {
+
+    public:
+
+        int sm_number;                  /**< The pattern number.            */
+        std::string sm_name;            /**< The pattern name.              */
+        int sm_in_bus;                  /**< The nominal input buss.        */
+        int sm_true_in_bus;             /**< The actual input buss.         */
+        int sm_bus;                     /**< The nominal output buss.       */
+        int sm_true_bus;                /**< The actual output buss.        */
+        int sm_channel;                 /**< The channel, or 0x80 (free).   */
+        int sm_beats_per_bar;           /**< The time signature numerator.  */
+        int sm_beat_width;              /**< Its denominator.               */
+        midipulse sm_length;            /**< The length in ticks.           */
+        int sm_event_count;             /**< All events.                    */
+        int sm_note_count;              /**< The Note Ons.                  */
+        int sm_playable_count;          /**< The playable events.           */
+        bool sm_transposable;           /**< Affected by song transpose.    */
+        int sm_key;                     /**< The musical key.               */
+        int sm_scale;                   /**< The musical scale.             */
+        int sm_color;                   /**< The palette color, -1 if none. */
+        std::vector<trigger> sm_triggers;       /**< A copy of the triggers.*/
+
+    };
+
     /**
      *  Provides a set of methods for drawing certain items.  These values are
      *  used in the sequence, seqroll, perfroll, and main window classes.
@@ -292,15 +346,6 @@ public:
 
     };      // nested class note_info
 
-private:
-
-    /**
-     *  Provides a stack of event-lists for use with the undo and redo
-     *  facility.
-     */
-
-    using eventstack = std::stack<eventlist>;
-
 public:
 
     /**
@@ -325,8 +370,59 @@ public:
 
     using timesig_list = std::vector<timesig>;
 
+    /**
+     *  The part of the pattern changed by an edit, as a range of ticks and
+     *  a range of notes, so that a view can repaint only that part.  Edits
+     *  of other events than notes use the whole range of notes.  A region
+     *  with a finish before its start is empty.  See dirty_region().
+     */
+
+    using region = struct
+    {
+        unsigned r_generation;      /* The redraw generation of the edit.   */
+        midipulse r_start;          /* The first tick changed.              */
+        midipulse r_finish;         /* The last tick changed.               */
+        int r_low;                  /* The lowest note changed.             */
+        int r_high;                 /* The highest note changed.            */
+    };
+
+    static bool region_empty (const region & r)
+    {
+        return r.r_finish < r.r_start;
+    }
+
+    static region note_region (const event & eon, const event & eoff)
+    {
+        int n = int(eon.get_note());
+        return region{0, eon.timestamp(), eoff.timestamp(), n, n};
+    }
+
 private:
 
+    /**
+     *  The bits of the playback state, packed into m_play_state so that the
+     *  user interface can poll them without the pattern's mutex, and so
+     *  that a change of several of them (such as arming, which also clears
+     *  the queue and one-shot) is seen all at once.
+     */
+
+    enum class playbit : unsigned
+    {
+        none            = 0x00,
+        armed           = 0x01,         /* playback is on ("unmuted")       */
+        queued          = 0x02,         /* waiting for the next boundary    */
+        one_shot        = 0x04,         /* play once from the next boundary */
+        song_mute       = 0x08,         /* muted by song playback           */
+        off_from_snap   = 0x10          /* turned off by a snap operation   */
+    };
+
+    /**
+     *  The memory order of the changes to m_play_state.
+     */
+
+    static constexpr std::memory_order c_play_order =
+        std::memory_order_acq_rel;
+
     /**
      *  The number of MIDI notes in what?  This value is used in the sequence
      *  module.  It looks like it is the maximum number of notes that
@@ -349,7 +445,7 @@ private:
      * Documented at the definition point in the cpp module.
      */
 
-    static eventlist sm_clipboard;      /* shared between sequences */
+    static std::shared_ptr<const eventlist> sm_clipboard;   /* shared   */
 
     /*
      * For fingerprinting check with speed.
@@ -357,6 +453,20 @@ private:
 
     static int sm_fingerprint_size;
 
+    /**
+     *  Counts the calls to set_dirty_mp() made on any pattern, so that the
+     *  user interface can tell, without locking any pattern, that nothing
+     *  has changed since it last looked.
+     */
+
+    static std::atomic<unsigned> sm_change_generation;
+
+    /**
+     *  Hands out the edit stamps of all patterns; see m_edit_stamp.
+     */
+
+    static std::atomic<unsigned> sm_edit_stamps;
+
 private:
 
     /**
@@ -389,7 +499,9 @@ private:
     /**
      *  Holds a list of time-signatures in the pattern, for use when drawing
      *  the vertical grid-lines in the pattern-editor time, piano roll, and
-     *  event (qstriggereditor) panes.
+     *  event (qstriggereditor) panes.  The list is sorted by start tick, and
+     *  analyze_time_signatures() fills in the starting measure of each, so
+     *  that it is also a cumulative measure table, searched by bisection.
      */
 
     timesig_list m_time_signatures;
@@ -416,7 +528,9 @@ private:
     bool m_have_redo;
 
     /**
-     *  Provides a list of event actions to undo.
+     *  Provides a list of event actions to undo.  The eventstack stores
+     *  only the differences between successive event lists, within the
+     *  memory limit of usr().undo_limit().
      */
 
     eventstack m_events_undo;
@@ -478,12 +592,6 @@ private:
     bussbyte m_nominal_in_bus;
     bussbyte m_true_in_bus;
 
-    /**
-     *  Provides a flag for pattern playback song muting.
-     */
-
-    bool m_song_mute;
-
     /**
      *  Indicate if the sequence is transposable or not.  A potential feature
      *  from stazed's seq32 project.  Now it is an actual, configurable
@@ -499,6 +607,35 @@ private:
 
     short m_notes_on;
 
+    /**
+     *  Holds a key (timestamp, status, and first data byte) for each event
+     *  recorded while the pattern plays, since recording was turned on.  A
+     *  loop overdub of a drum part hits the same quantized ticks over and
+     *  over, and stream_event() drops the events it has already recorded
+     *  without scanning the events.  Note Offs are not keyed; they are
+     *  dropped along with their duplicate Note On.
+     */
+
+    std::unordered_set<std::uint64_t> m_recorded_keys;
+
+    /**
+     *  Counts, for each note number, the duplicate Note Ons dropped whose
+     *  Note Off has not come in yet.
+     */
+
+    std::vector<short> m_dropped_note_ons;
+
+    /**
+     *  Holds the events of the current pass of a merge-style (overdub) loop
+     *  recording, once the pattern has events that they would sort before.
+     *  They are merged into the pattern, and linked, once per pass, instead
+     *  of each Note Off sorting and relinking all of the events.  The pass
+     *  is the playback tick divided by the length; see take_event().
+     */
+
+    event::buffer m_take;
+    midipulse m_take_pass;
+
     /**
      *  Provides the master MIDI buss which handles the output of the sequence
      *  to the proper buss and MIDI channel.
@@ -507,11 +644,88 @@ private:
     mastermidibus * m_master_bus;
 
     /**
-     *  Provides a "map" for Note On events.  It is used when muting, to shut
-     *  off the notes that are playing.
+     *  The notes sounding from this pattern: a count of the Note Ons sent
+     *  for each note number, as the old array was, plus a packed list of the
+     *  note numbers whose count is not 0.  The slot of each note in the list
+     *  is kept, so that a note is added and dropped in constant time, and
+     *  off_playing_notes() walks only the sounding notes, not all 128.
      */
 
-    unsigned short m_playing_notes[c_notes_count];
+    class activenotes
+    {
+
+    private:
+
+        unsigned short an_counts[c_notes_count];    /**< Note Ons pending.  */
+        midibyte an_notes[c_notes_count];           /**< Notes sounding.    */
+        midibyte an_slots[c_notes_count];           /**< Slot in an_notes.  */
+        int an_size;                                /**< Notes in an_notes. */
+
+    public:
+
+        activenotes () : an_size (0)
+        {
+            for (auto & c : an_counts)
+                c = 0;
+        }
+
+        void clear ()
+        {
+            for (int i = 0; i < an_size; ++i)
+                an_counts[an_notes[i]] = 0;
+
+            an_size = 0;
+        }
+
+        bool empty () const
+        {
+            return an_size == 0;
+        }
+
+        int size () const
+        {
+            return an_size;
+        }
+
+        midibyte note (int i) const
+        {
+            return an_notes[i];
+        }
+
+        unsigned short count (midibyte n) const
+        {
+            return n < c_notes_count ? an_counts[n] : 0 ;
+        }
+
+        void on (midibyte n)
+        {
+            if (n < c_notes_count && an_counts[n]++ == 0)
+            {
+                an_slots[n] = midibyte(an_size);
+                an_notes[an_size++] = n;
+            }
+        }
+
+        /**
+         *  Counts off one Note On of the note.  Returns false if the note
+         *  is not sounding, in which case the Note Off is not to be sent.
+         */
+
+        bool off (midibyte n)
+        {
+            bool result = count(n) > 0;
+            if (result && --an_counts[n] == 0)
+            {
+                midibyte last = an_notes[--an_size];    /* fill the hole    */
+                an_notes[an_slots[n]] = last;
+                an_slots[last] = an_slots[n];
+            }
+            return result;
+        }
+
+    };
+
+    activenotes m_playing_notes;
 
     /**
      *  Indicates if the sequence was playing.  This value is set at the end
@@ -522,11 +736,15 @@ private:
      */
 
     /**
-     *  True if sequence playback currently is possible for this sequence.
-     *  In other words, the sequence is armed.
+     *  The playback state bits (see the playbit enumeration):  armed, that
+     *  is, playback currently is possible for this sequence; queued;
+     *  one-shot, a Kepler34 feature; song-muted; and turned off from a
+     *  snap.  Read with no lock.  Changed by atomic read-modify-write
+     *  operations, so that the output thread and the user interface never
+     *  need the mutex for them.  The mutex is left to protect the events.
      */
 
-    bool m_armed;
+    std::atomic<unsigned> m_play_state;
 
     /**
      *  True if sequence recording currently is in progress for this sequence.
@@ -554,24 +772,17 @@ private:
 
     bool m_thru;
 
-    /**
-     *  True if the events are queued.
-     */
-
-    bool m_queued;
-
-    /**
-     *  A member from the Kepler34 project to indicate we are in one-shot mode
-     *  for triggering.  Set to false whenever playing-state changes.  Used in
-     *  sequence :: play_queue() to maybe play from the one-shot tick, then
-     *  toggle play and toggle queuing before playing normally.
+    /*
+     *  The one-shot flag, a member from the Kepler34 project, indicates we
+     *  are in one-shot mode for triggering.  Set to false whenever
+     *  playing-state changes.  Used in sequence :: play_queue() to maybe
+     *  play from the one-shot tick, then toggle play and toggle queuing
+     *  before playing normally.  It is now a bit of m_play_state.
      *
      *  One-shot mode is entered when the MIDI control c_status_oneshot event
      *  is received.  Kepler34 reserves the period '.' to initiate this event.
      */
 
-    bool m_one_shot;
-
     /**
      *  A member from the Kepler34 project, set in sequence ::
      *  toggle_one_shot() to m_last_tick adjusted to the length of the
@@ -590,10 +801,29 @@ private:
     int m_loop_count_max;
 
     /**
-     *  Indicates if we have turned off from a snap operation.
+     *  The modulation lanes, whose values are generated at play time (see
+     *  the modlane class), and are stored in a c_seq_modlanes SeqSpec.  The
+     *  last value sent by each lane, or -1, is also kept, so that a value
+     *  is sent only when it changes.  That is a fixed array, so that the
+     *  output thread never allocates.
      */
 
-    bool m_off_from_snap;
+    std::vector<modlane> m_mod_lanes;
+    std::array<int, modlane::c_lanes_max> m_mod_values;
+
+    /**
+     *  The output filter of the pattern, whose stages are run over each
+     *  message as it is sent, or null if there is none.  The live note-map
+     *  is a notemap stage holding a copy of the note table of a notemapper,
+     *  so that a pattern can be heard through a drum-kit mapping without
+     *  rewriting its events, and without depending on the notemapper of
+     *  the performer, which is replaced when a note-map file is opened.
+     *  Like the playback snapshot, it is never altered once published, and
+     *  the output thread gets it once a frame via std::atomic_load().  The
+     *  text stages are stored in a c_seq_filter SeqSpec.
+     */
+
+    filter m_output_filter;
 
     /**
      *  Used to temporarily block Song Mode events while recording new
@@ -625,6 +855,15 @@ private:
 
     midipulse m_song_record_tick;
 
+    /**
+     *  The end of the song-recorded trigger as last committed to the
+     *  triggers container.  The output thread tracks the open span and only
+     *  grows the trigger, and notifies the song editor, when the play tick
+     *  comes near this end.  See song_record_commit().
+     */
+
+    midipulse m_song_record_end;
+
     /**
      *  Indicates if the play marker has gone to the beginning of the sequence
      *  upon looping.
@@ -693,6 +932,65 @@ private:
 
     mutable std::atomic<bool> m_dirty_names;
 
+    /**
+     *  Counts the calls to set_dirty_mp(), that is, the changes that can
+     *  alter how the pattern looks, plus the changes of the selection of
+     *  events (see selection_changed()).  Unlike the dirty flags, it is not
+     *  reset when read, so that any number of views can tell if their
+     *  cached drawing of the pattern (e.g. a qloopbutton thumbnail) is out
+     *  of date.
+     */
+
+    std::atomic<unsigned> m_redraw_generation;
+
+    /**
+     *  The regions of the latest edits, indexed by redraw generation modulo
+     *  the size.  A change of the whole pattern (set_dirty() with no
+     *  region) sets m_region_floor to its generation, as does overwriting a
+     *  region that is still recorded.  A view that last looked before the
+     *  floor must repaint everything.  The mutex is taken only to record
+     *  and to read a region, never with m_mutex held for long.
+     */
+
+    std::array<region, 16> m_regions;
+    unsigned m_region_floor;
+    mutable recmutex m_region_mutex;
+
+    /**
+     *  Statistics of the events, gathered in one pass and kept until the
+     *  events change.  The live grid, the song editor, and the song summary
+     *  ask for them often, and each used to be a scan of the events under
+     *  the lock.  They are good while neither the change count of the
+     *  event list nor the redraw generation has moved; the latter catches
+     *  the edits made in place, such as transposition, which do not touch
+     *  the vector itself.
+     */
+
+    class eventstats
+    {
+
+    public:
+
+        bool es_valid;                  /**< False until first gathered.    */
+        unsigned es_changes;            /**< The eventlist::changes() used. */
+        unsigned es_generation;         /**< The redraw generation used.    */
+        int es_note_count;              /**< The number of Note Ons.        */
+        int es_playable_count;          /**< The number of playable events. */
+        bool es_minmax;                 /**< Result of minmax_notes().      */
+        int es_lowest;                  /**< The lowest note (or tempo).    */
+        int es_highest;                 /**< The highest note (or tempo).   */
+
+    };
+
+    mutable eventstats m_stats;
+
+    /**
+     *  Guards m_stats only, so that the getters of the statistics can take
+     *  a readlock on m_mutex rather than a writelock.
+     */
+
+    mutable recmutex m_stats_mutex;
+
     /**
      *  Indicates the pattern was modified.  Unlike the is_dirty_xxx flags,
      *  this one is not reset when checked.  Useful when closing a file or the
@@ -701,6 +999,16 @@ private:
 
     mutable bool m_is_modified;
 
+    /**
+     *  Changed by every modification of the pattern, its events, or its
+     *  triggers, so that the edit journal (see midijournal) can tell which
+     *  patterns to log.  The stamps come from one counter shared by all
+     *  patterns, so that a new pattern never has the stamp of an old one.
+     *  Unlike m_is_modified, it is not reset by a save.
+     */
+
+    std::atomic<unsigned> m_edit_stamp;
+
     /**
      *  Indicates that the sequence is currently being edited.
      */
@@ -731,10 +1039,35 @@ private:
      *  including triggering.
      */
 
-    midipulse m_last_tick;          /**< Provides the last tick played.     */
+    std::atomic<midipulse> m_last_tick; /**< The last tick played.          */
     midipulse m_queued_tick;        /**< Provides the tick for queuing.     */
     midipulse m_trigger_offset;     /**< Provides the trigger offset.       */
 
+    /**
+     *  Provides a persistent playback cursor, the index of the first event
+     *  that has not yet been played in the current pass through the events.
+     *  It lets play() start where the previous frame stopped, instead of
+     *  walking the events from the beginning.  It is an index into the
+     *  playback snapshot rather than an iterator, so that a new snapshot
+     *  cannot leave it dangling.  It is validated against the timestamps on
+     *  each use (see play_cursor()), so edits, loop wraps, and
+     *  repositioning simply cause a binary search for a fresh position.
+     */
+
+    std::size_t m_play_cursor;
+
+    /**
+     *  Holds the immutable playback snapshot of the events, published by
+     *  modify() and read by the output thread, which plays only these
+     *  compact events.  If an editor holds m_mutex, the output thread gets it
+     *  via std::atomic_load().  Also holds the previously published
+     *  snapshot, so that it is normally freed by the editing thread rather
+     *  than by the output thread.
+     */
+
+    snapshot m_play_snapshot;
+    snapshot m_retired_snapshot;
+
     /**
      *  This constant provides the scaling used to calculate the time position
      *  in ticks (pulses), based also on the PPQN value.  Hardwired to
@@ -789,6 +1122,16 @@ private:
 
     midipulse m_next_boundary;
 
+    /**
+     *  The count of loop wraps last seen by this pattern.  When it differs
+     *  from performer::wrap_generation(), the pattern resets itself to the
+     *  left tick before playing.  Read and written by the output thread
+     *  without a lock, and written by stop() and set_parent() in other
+     *  threads, so it is atomic.
+     */
+
+    std::atomic<unsigned> m_wrap_generation;
+
     /**
      *  Holds the last number of measures, purely for detecting changes that
      *  affect the measure count.  Normally, get_measures() makes a live
@@ -912,10 +1255,13 @@ private:
 
     /**
      *  Provides locking for the sequence.  Made mutable for use in
-     *  certain locked getter functions.
+     *  certain locked getter functions.  Functions that only read the
+     *  events or triggers take a readlock, so that the editors and the
+     *  output thread do not shut each other out; the rest take a
+     *  writelock.  See the rwmutex module for the rules.
      */
 
-    mutable recmutex m_mutex;
+    mutable rwmutex m_mutex;
 
 private:
 
@@ -937,6 +1283,8 @@ public:
     virtual ~sequence ();
 
     void partial_assign (const sequence & rhs, bool toclipboard = false);
+    snapshot copy_for_edit (sequence & scratch);
+    bool adopt_edit (sequence & scratch, const snapshot & base);
 
     static short maximum ()
     {
@@ -1105,6 +1453,18 @@ public:
         return int(m_seq_number);
     }
 
+    /**
+     *  The tag given to the pattern's batched events (see framebatch).  It
+     *  is a byte, as in an ALSA event, and 0 means no tag, so patterns 255
+     *  apart share one.  A shared tag is not retracted; see
+     *  performer::output_tag_shared().
+     */
+
+    midibyte output_tag () const
+    {
+        return midibyte(seq_number() % 255 + 1);
+    }
+
     std::string seq_number_string () const
     {
         return std::to_string(seq_number());
@@ -1145,7 +1505,11 @@ public:
     }
 
     bool loop_count_max (int m, bool user_change = false);
+    bool add_mod_lane (const modlane & ml, bool user_change = false);
+    bool remove_mod_lane (int index);
+    void clear_mod_lanes (bool user_change = false);
     void modify (bool notifychange = true);
+    void modify (const region & r, bool notifychange = true);
 
     void unmodify ()
     {
@@ -1154,10 +1518,12 @@ public:
 
     int event_count () const;
     int note_count () const;
+    void get_summary (summary & sm) const;
+    void memory_usage (memoryusage & mu) const;
     bool first_notes (midipulse & ts, int & n) const;
     int playable_count () const;
     bool is_playable () const;
-    bool minmax_notes (int & lowest, int & highest);
+    bool minmax_notes (int & lowest, int & highest) const;
 
     bool have_undo () const
     {
@@ -1271,7 +1637,7 @@ public:
 
     bool get_song_mute () const
     {
-        return m_song_mute;
+        return play_bit(playbit::song_mute);
     }
 
     void apply_song_transpose ();
@@ -1365,7 +1731,26 @@ public:
 
     midipulse last_tick () const
     {
-        return m_last_tick;
+        return m_last_tick.load(std::memory_order_relaxed);
+    }
+
+    /**
+     *  Used by performer::play() in place of play() when the song timeline
+     *  shows that the pattern has nothing to do in the frame.  It keeps the
+     *  start of the next frame where play() would have put it.
+     */
+
+    void song_skip (midipulse tick);
+
+    /**
+     *  True if, apart from its triggers, nothing needs the pattern to play
+     *  in Song mode.  See songtimeline::skippable().
+     */
+
+    bool song_idle () const
+    {
+        return ! armed() && ! get_queued() && ! one_shot() &&
+            ! song_recording() && ! is_metro_seq();
     }
 
     /**
@@ -1377,7 +1762,8 @@ public:
 
     midipulse mod_last_tick ()
     {
-        return (m_length > 1) ? (m_last_tick % m_length) : m_last_tick ;
+        midipulse t = last_tick();
+        return (m_length > 1) ? (t % m_length) : t ;
     }
 
     /*
@@ -1388,12 +1774,12 @@ public:
 
     bool armed () const
     {
-        return m_armed;
+        return play_bit(playbit::armed);
     }
 
     bool muted () const
     {
-        return ! m_armed;
+        return ! armed();
     }
 
     bool sequence_playing_toggle ();
@@ -1403,7 +1789,7 @@ public:
 
     bool get_queued () const
     {
-        return m_queued;
+        return play_bit(playbit::queued);
     }
 
     midipulse get_queued_tick () const
@@ -1521,7 +1907,7 @@ public:
 
     bool one_shot () const
     {
-        return m_one_shot;
+        return play_bit(playbit::one_shot);
     }
 
     midipulse one_shot_tick () const
@@ -1539,6 +1925,11 @@ public:
         return m_loop_count_max;
     }
 
+    const std::vector<modlane> & mod_lanes () const
+    {
+        return m_mod_lanes;
+    }
+
     bool song_recording () const
     {
         return m_song_recording;
@@ -1546,7 +1937,7 @@ public:
 
     bool off_from_snap () const
     {
-        return m_off_from_snap;
+        return play_bit(playbit::off_from_snap);
     }
 
     bool snap_it () const
@@ -1577,12 +1968,43 @@ public:
         return m_is_modified;
     }
 
+    unsigned edit_stamp () const
+    {
+        return m_edit_stamp.load(std::memory_order_relaxed);
+    }
+
     bool is_dirty_main () const;
     bool is_dirty_edit () const;
     bool is_dirty_perf () const;
     bool is_dirty_names () const;
+
+    unsigned redraw_generation () const
+    {
+        return m_redraw_generation.load(std::memory_order_relaxed);
+    }
+
+    bool dirty_region (unsigned & since, region & r) const;
+    bool partial_change () const;
+
+    static unsigned change_generation ()
+    {
+        return sm_change_generation.load(std::memory_order_relaxed);
+    }
+
+    /**
+     *  The playback snapshot as last published, without the lock and
+     *  without publishing a new one.  Null if none was published yet.  For
+     *  readers outside the output thread, such as the state mirror.
+     */
+
+    snapshot play_snapshot () const
+    {
+        return std::atomic_load(&m_play_snapshot);
+    }
+
     void set_dirty_mp ();
     void set_dirty ();
+    void set_dirty (const region & r);
     std::string channel_string () const;            /* "F" or "<channel+1>" */
     bool set_channels (int channel);                /* modifies event list  */
 
@@ -1619,6 +2041,15 @@ public:
     void play (midipulse tick, bool playback_mode, bool resume = false);
     void live_play (midipulse tick);
     void play_queue (midipulse tick, bool playbackmode, bool resume);
+    void play_boundaries (midipulse tick, bool playbackmode, bool resume);
+    void play_frame (midipulse tick, bool playbackmode, bool resume);
+    bool play_voice
+    (
+        midipulse start, midipulse first, midipulse last,
+        midibyte velscale = 0
+    );
+    bool parallel_playable () const;
+    midipulse next_event_tick (midipulse tick, bool playbackmode) const;
     bool push_add_note
     (
         midipulse tick, midipulse len, int note,
@@ -1643,6 +2074,7 @@ public:
         int velocity = sm_preserve_velocity
     );
     bool add_tempo (midipulse tick, midibpm tempo, bool repaint = false);
+    void fill_tempo_map (tempomap & tm) const;
     bool add_tempos
     (
         midipulse tick_s, midipulse tick_f,
@@ -1659,18 +2091,23 @@ public:
         midipulse limit = c_null_midipulse
     );
     bool add_event (const event & er);      /* another one declared below */
+    bool add_event (event && er);
     bool add_event
     (
         midipulse tick, midibyte status,
         midibyte d0, midibyte d1, bool repaint = false
     );
     bool append_event (const event & er);
+    bool append_event (event && er);
+    void reserve_events (std::size_t n);
+    void trim_events ();
     void sort_events ();
     event find_event (const event & e, bool nextmatch = false);
     note_info find_note (midipulse tick, int note);
     bool remove_duplicate_events (midipulse tick, int note = (-1));
     void notify_change (bool userchange = true);
     void notify_trigger ();
+    void notify_triggers_edited ();
     void print_triggers () const;
     bool add_trigger
     (
@@ -1681,7 +2118,7 @@ public:
     );
     bool split_trigger (midipulse tick, trigger::splitpoint splittype);
     bool grow_trigger (midipulse tick_from, midipulse tick_to, midipulse len);
-    bool grow_trigger (midipulse tick_from, midipulse tick_to);
+    bool close_trigger (midipulse tick_from, midipulse tick_to);
     const trigger & find_trigger (midipulse tick) const;
     bool delete_trigger (midipulse tick);
     bool clear_triggers ();
@@ -1816,6 +2253,11 @@ public:
     void select_notes_by_channel (int channel);
     void unselect ();
     bool repitch (const notemapper & nmap, bool all = false);
+    void live_notemap (const notemapper * nmap);
+    bool live_notemap () const;
+    bool output_filter (const std::string & spec, bool user_change = false);
+    std::string output_filter () const;
+
     bool copy_selected ();
     bool cut_selected (bool copyevents = true);
     bool paste_selected (midipulse tick, int note);
@@ -1854,7 +2296,8 @@ public:
     void change_event_data_lfo
     (
         double dcoffset, double range, double speed, double phase,
-        waveform w, midibyte status, midibyte cc, bool usemeasure = false
+        waveform w, midibyte status, midibyte cc, bool usemeasure = false,
+        bool pushundo = true
     );
     bool fix_pattern (fixparameters & param);   /* for qpatternfix dialog   */
     void increment_selected (midibyte status, midibyte /*control*/);
@@ -1901,6 +2344,25 @@ public:
         return evi == m_events.cend();
     }
 
+    /**
+     *  These overloads limit a drawing loop to the visible ticks.  The
+     *  notes flag also gets the notes that start before the left edge but
+     *  reach into it.  See eventlist::cbegin() and eventlist::cend().
+     */
+
+    event::buffer::const_iterator cbegin
+    (
+        midipulse tick, bool notes = false
+    ) const
+    {
+        return m_events.cbegin(tick, notes);
+    }
+
+    bool cend (event::buffer::const_iterator & evi, midipulse tick) const
+    {
+        return m_events.cend(evi, tick);
+    }
+
     bool reset_interval
     (
         midipulse t0, midipulse t1,
@@ -1916,19 +2378,19 @@ public:
     (
         midibyte status, midibyte cc,
         event::buffer::const_iterator & evi
-    );
+    ) const;
     bool get_next_meta_match
     (
         midibyte metamsg,
         event::buffer::const_iterator & evi,
         midipulse start = 0,
         midipulse range = c_null_midipulse
-    );
+    ) const;
     bool get_next_event
     (
         midibyte & status, midibyte & cc,
         event::buffer::const_iterator & evi
-    );
+    ) const;
     bool next_trigger (trigger & trig);
     bool push_quantize (midibyte status, midibyte cc, int divide);
     bool push_quantize_notes (int divide);
@@ -1989,9 +2451,11 @@ public:
 
     static void clear_clipboard ()
     {
-        sm_clipboard.clear();                   /* shared between sequences */
+        sm_clipboard.reset();                   /* shared between sequences */
     }
 
+    static std::size_t clipboard_bytes ();
+
     static recordstyle loop_record_style (int ri);
 
     /**
@@ -2021,10 +2485,15 @@ public:
 protected:
 
     void set_parent (performer * p);
+    virtual void live_play_frame (midipulse first, midipulse last);
+    void put_event_on_bus
+    (
+        const event & ev, midipulse tick = c_null_midipulse
+    );
 
     void armed (bool flag)
     {
-        m_armed = flag;
+        play_bit(playbit::armed, flag);
     }
 
     void free_channel (bool flag)
@@ -2040,6 +2509,7 @@ private:
         bool savenotelength = false,
         bool relink = false
     );
+    eventstats refresh_stats () const;
 
     mastermidibus * master_bus ()
     {
@@ -2060,7 +2530,36 @@ private:
     bool quantize_events (midibyte status, midibyte cc, int divide = 1);
     bool quantize_notes (int divide = 1);
     bool change_ppqn (int p);
-    void put_event_on_bus (const event & ev);
+    void put_event_on_bus
+    (
+        const playevent & pe, midipulse tick, int transpose = 0,
+        const outputfilter * of = nullptr, midibyte velscale = 0
+    );
+    void set_output_filter (const outputfilter & of);
+    void play_frame
+    (
+        const playevents & evs,
+        midipulse tick, bool playback_mode, bool resume
+    );
+    void play_mod_lanes
+    (
+        const std::vector<modlane> & lanes,
+        midipulse first, midipulse last, midipulse len,
+        const outputfilter * of
+    );
+    void reset_mod_values ();
+    bool loop_wrapped (midipulse & lefttick);
+    void wrap_loop
+    (
+        midipulse lefttick, midipulse tick, bool songmode, bool locked
+    );
+    void send_playing_notes_off ();
+    playevents::buffer::const_iterator play_cursor
+    (
+        const playevents::buffer & evs, midipulse local
+    );
+    void publish_snapshot ();
+    snapshot current_snapshot ();
     void set_trigger_offset (midipulse trigger_offset);
     void adjust_trigger_offsets_to_length (midipulse newlen);
     midipulse adjust_offset (midipulse offset);
@@ -2071,6 +2570,18 @@ private:
     ) const;
 
     void push_default_time_signature ();
+    bool recorded_duplicate (const event & ev);
+    void clear_recorded_keys ();
+    void reserve_for_recording ();
+    bool take_event (const event & ev);
+    bool merge_take ();
+    bool insert_note (const event & eon, const event & eoff, bool & inplace);
+    void add_region (const region * r);
+    region event_region (const event & ev) const;
+    void modify_region (const region * r, bool notifychange);
+    void stamp_edit ();
+    int time_signature_at (midipulse p) const;
+    int time_signature_at_measure (double m) const;
 
 #if defined USE_SEQUENCE_REMOVE_EVENTS
     void remove (event::buffer::iterator i);
@@ -2104,16 +2615,53 @@ private:
         m_draw_locked = flag;
     }
 
+    /**
+     *  Selecting events does not dirty the pattern, but does change how the
+     *  editors draw it, so the caches of drawn events must know.
+     */
+
+    void selection_changed ()
+    {
+        add_region(nullptr);
+    }
+
     void one_shot (bool f)
     {
-        m_one_shot = f;
+        play_bit(playbit::one_shot, f);
     }
 
     void off_from_snap (bool f)
     {
-        m_off_from_snap = f;
+        play_bit(playbit::off_from_snap, f);
     }
 
+    /**
+     *  Lock-free access to the bits of m_play_state.  See also
+     *  change_play_state(), which changes several bits at once.
+     */
+
+    bool play_bit (playbit b) const
+    {
+        return (m_play_state.load(std::memory_order_acquire) & unsigned(b))
+            != 0;
+    }
+
+    void play_bit (playbit b, bool on)
+    {
+        if (on)
+            (void) m_play_state.fetch_or(unsigned(b), c_play_order);
+        else
+            (void) m_play_state.fetch_and(~unsigned(b), c_play_order);
+    }
+
+    bool flip_play_bit (playbit b)          /* returns the new value        */
+    {
+        unsigned old = m_play_state.fetch_xor(unsigned(b), c_play_order);
+        return (old & unsigned(b)) == 0;
+    }
+
+    bool change_play_state (playbit b, bool on, unsigned clearbits);
+
     void song_playback_block (bool f)
     {
         m_song_playback_block = f;
@@ -2134,6 +2682,8 @@ private:
         m_song_record_tick = t;
     }
 
+    bool song_record_commit (midipulse tick);
+
     void channel_match (bool flag)
     {
         m_channel_match = flag;
@@ -0,0 +1,221 @@
+#if ! defined SEQ66_SESSIONLOG_HPP
+#define SEQ66_SESSIONLOG_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sessionlog.hpp
+ *
+ *  This module declares the log of the control inputs of a session, as
+ *  replayed by "seq66cli --replay".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  With "-o session-log=filename", the performer logs each control input
+ *  with the tick at which it came in:
+ *
+ *      -   Each MIDI message from the input thread, other than SysEx and
+ *          MIDI clock.
+ *      -   Each keystroke passed to performer::midi_control_keystroke().
+ *      -   Each pattern toggle, as from a click on a pattern button.
+ *      -   Each start, stop, or pause of the transport.
+ *
+ *  Only the outermost input is logged.  A key bound to "start" logs the
+ *  key, but not the start it causes; a scope object marks the nesting,
+ *  per thread.  The entries are kept in memory, under a mutex, and written
+ *  when the session ends.  When the log is off, each input costs a single
+ *  relaxed load.
+ *
+ *  The file is plain text, one entry per line, "#" starting a comment:
+ *
+\verbatim
+        tick midi bus status d0 d1
+        tick key ordinal press|release modifiers
+        tick toggle seqno
+        tick play|stop|pause
+\endverbatim
+ */
+
+#include <atomic>                       /* std::atomic<bool>                */
+#include <mutex>                        /* std::mutex, std::lock_guard      */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midipulse       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class event;
+    class keystroke;
+
+/**
+ *  Logs the control inputs of a session, and reads them back.
+ */
+
+class sessionlog
+{
+
+public:
+
+    /**
+     *  The kinds of input that are logged.
+     */
+
+    enum class kind
+    {
+        midi,                           /**< A MIDI message from a buss.    */
+        key,                            /**< A key press or release.        */
+        toggle,                         /**< A pattern toggle.              */
+        play,                           /**< A start of the transport.      */
+        stop,                           /**< A stop of the transport.       */
+        pause                           /**< A pause of the transport.      */
+    };
+
+    /**
+     *  One control input.  Only the members for its kind are used.
+     */
+
+    class entry
+    {
+
+    public:
+
+        midipulse se_tick;              /**< The performer tick.            */
+        kind se_kind;                   /**< The kind of input.             */
+        bussbyte se_bus;                /**< The input buss of a message.   */
+        midibyte se_status;             /**< The status, with channel.      */
+        midibyte se_d0;                 /**< The first data byte.           */
+        midibyte se_d1;                 /**< The second data byte.          */
+        unsigned se_key;                /**< The key ordinal.               */
+        bool se_press;                  /**< True for a key press.          */
+        unsigned se_modifiers;          /**< The key modifiers.             */
+        int se_seqno;                   /**< The toggled pattern.           */
+
+        entry ();
+
+    };
+
+    /**
+     *  Marks the inputs caused by a logged input, which are not logged.
+     *  Create one while dispatching an input.
+     */
+
+    class scope
+    {
+
+    public:
+
+        scope ();
+        ~scope ();
+
+        scope (const scope &) = delete;
+        scope & operator = (const scope &) = delete;
+
+    };
+
+private:
+
+    /**
+     *  The inputs logged so far, or read from a file.
+     */
+
+    std::vector<entry> m_entries;
+
+    /**
+     *  Serializes the logging by the input and user-interface threads.
+     */
+
+    mutable std::mutex m_mutex;
+
+    /**
+     *  Set while logging.  Read for every input, so kept apart from the
+     *  rest.
+     */
+
+    std::atomic<bool> m_enabled;
+
+    /**
+     *  The file to write when logging stops.
+     */
+
+    std::string m_filename;
+
+public:
+
+    sessionlog ();
+
+    sessionlog (const sessionlog &) = delete;
+    sessionlog & operator = (const sessionlog &) = delete;
+
+    void start (const std::string & filename);
+    bool stop ();
+    bool read (const std::string & filename);
+    void log_midi (midipulse tick, const event & ev);
+    void log_key (midipulse tick, const keystroke & k);
+    void log_toggle (midipulse tick, int seqno);
+    void log_transport (midipulse tick, kind k);
+
+    bool enabled () const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    const std::vector<entry> & entries () const
+    {
+        return m_entries;
+    }
+
+    const std::string & filename () const
+    {
+        return m_filename;
+    }
+
+    static bool nested ();
+
+private:
+
+    bool loggable () const
+    {
+        return enabled() && ! nested();
+    }
+
+    void add (const entry & e);
+    bool write () const;
+    static bool parse_line (const std::string & line, entry & e);
+
+};          // class sessionlog
+
+}           // namespace seq66
+
+#endif      // SEQ66_SESSIONLOG_HPP
+
+/*
+ * sessionlog.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
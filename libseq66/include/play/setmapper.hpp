@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2023-11-17
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module also creates a small structure for managing sequence
@@ -42,6 +42,7 @@
  *  allowed in a given run of the application.
  */
 
+#include "play/bulkops.hpp"             /* seq66::bulkops set-wide mutes    */
 #include "play/mutegroups.hpp"          /* seq66::mutegroups & mutegroup    */
 #include "play/setmaster.hpp"           /* seq66::seqmanager and seqstatus  */
 
@@ -169,6 +170,15 @@ private:
 
     midibooleans m_tracks_mute_state;
 
+    /**
+     *  Holds the active sequences of all of the sets, sorted by output
+     *  buss, for play_all_sets().  It is rebuilt from the lists kept by
+     *  each screenset whenever a sequence or set is added or removed,
+     *  rather than looking through every set and slot for each frame.
+     */
+
+    std::vector<sequence *> m_play_index;
+
 public:
 
     setmapper () = delete;
@@ -292,6 +302,7 @@ private:
         master().clear();
         m_sequence_count = 0;
         m_sequence_high = m_edit_sequence = seq::unassigned();
+        m_play_index.clear();
     }
 
     int sequence_count () const
@@ -761,6 +772,9 @@ private:
             arm();
     }
 
+    void bulk_op (bulkops::op o, bulkops::bits skip = 0);
+    void bulk_song_toggle (bulkops::bits skip = 0);
+
     void apply_armed_statuses ()
     {
         for (auto & sset : sets())
@@ -869,7 +883,8 @@ public:
     bool is_screenset_available (screenset::number setno) const
     {
         /*
-         * Now all 32 slots have a screenset, but inactive vs. active.
+         * Sets are created when first used, so a set that exists need not
+         * be active (e.g. the play-screen).
          *
          * return master().is_screenset_available(setno);
          */
@@ -909,7 +924,9 @@ public:
 
     bool swap_sets (seq::number set0, seq::number set1)
     {
-        return master().swap_sets(set0, set1);
+        bool result = master().swap_sets(set0, set1);  /* copies patterns */
+        refresh_play_index();
+        return result;
     }
 
     bool set_mutes (mutegroup::number gmute, const midibooleans & bits)
@@ -945,12 +962,18 @@ private:
     bool add_to_play_set (playset & p, screenset & s);
     bool add_all_sets_to_play_set (playset & p);
     void recount_sequences ();
+    void refresh_play_index ();
 
     setmaster::container::iterator add_set (screenset::number setno)
     {
         return master().add_set(setno);
     }
 
+    setmaster::container::iterator ensure_set (screenset::number setno)
+    {
+        return master().ensure_set(setno);
+    }
+
     setmaster::container::iterator find_by_value (screenset::number setno)
     {
         return master().find_by_value(setno);
@@ -958,12 +981,19 @@ private:
 
     bool remove_set (screenset::number setno)
     {
-        return master().remove_set(setno);
+        bool result = master().remove_set(setno);
+        refresh_play_index();
+        return result;
     }
 
     bool clear_set (screenset::number setno)
     {
-        return master().clear_set(setno);
+        bool result = master().clear_set(setno);
+        if (result)
+            (void) master().compact_set(setno);
+
+        refresh_play_index();
+        return result;
     }
 
     mutegroup::number clamp_group (mutegroup::number group) const
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-08-10
- * \updates       2021-11-13
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The setmaster class is meant to encapsulate the sets and their layout,
@@ -123,7 +123,11 @@ private:
     int m_highest_set;
 
     /**
-     *  Holds a vector of screenset objects.  This container starts out empty.
+     *  Holds the screenset objects.  It is sparse: after reset() only set 0
+     *  and the dummy set exist, another set is added when first used (see
+     *  setmapper::screen()), and a set is dropped again when it becomes
+     *  vacant (see compact_set()).  So "for all sets" loops visit only the
+     *  sets in use.
      */
 
     container m_container;
@@ -202,6 +206,12 @@ public:
         return m_container.find(setno) != m_container.end();
     }
 
+    int active_count (screenset::number setno) const
+    {
+        return is_screenset_available(setno) ?
+            m_container.at(setno).active_count() : 0 ;
+    }
+
     bool is_screenset_valid (screenset::number setno) const
     {
         return setno >= 0 && setno < m_set_count;
@@ -270,6 +280,9 @@ private:
 
     bool reset ();
     container::iterator add_set (screenset::number setno);
+    container::iterator ensure_set (screenset::number setno);
+    bool compact_set (screenset::number setno);
+    void reset_highest_set ();
     container::iterator find_by_value (screenset::number setno);
     bool remove_set (screenset::number setno);
     bool clear_set (screenset::number setno);
@@ -0,0 +1,127 @@
+#if ! defined SEQ66_SONGRENDER_HPP
+#define SEQ66_SONGRENDER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songrender.hpp
+ *
+ *  This module declares the offline rendering of a song to a MIDI file, as
+ *  run by "seq66cli --render".
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Unlike "Export Song", which copies the events under each trigger, a
+ *  render records what playback actually sends: the patterns are played,
+ *  frame by frame, against a virtual clock that runs as fast as the CPU
+ *  allows.  Trigger offsets and transpositions, pattern repeats, loop
+ *  counts, the L/R loop, and tempo changes all come out exactly as they
+ *  would be heard.  As with "--bench", the performer is never launched;
+ *  the frames are played inside a playpool run, which captures the events.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse alias           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Holds the options of an offline render and runs it.
+ */
+
+class songrender
+{
+
+private:
+
+    /**
+     *  The MIDI files to render, one after the other.
+     */
+
+    std::vector<std::string> m_files;
+
+    /**
+     *  The directory for the rendered files.  If empty, each is written
+     *  next to its input, with a "-render.mid" suffix.
+     */
+
+    std::string m_output_dir;
+
+    /**
+     *  If true, every pattern is armed and played in Live mode, instead of
+     *  following the triggers in Song mode.
+     */
+
+    bool m_live;
+
+    /**
+     *  The number of measures to render.  Zero means the end of the last
+     *  trigger in Song mode, or of the longest pattern in Live mode.
+     */
+
+    int m_measures;
+
+    /**
+     *  The L/R loop, in measures, the right one exclusive, and the number
+     *  of extra times to play it.  The loop is not used if m_loops is 0.
+     */
+
+    int m_loop_left;
+    int m_loop_right;
+    int m_loops;
+
+public:
+
+    songrender ();
+
+    static bool requested (int argc, char * argv []);
+    static void show_help ();
+
+    bool parse (int argc, char * argv []);
+    int run ();
+
+private:
+
+    bool render (performer & p, const std::string & infile);
+    std::string output_name (const std::string & infile) const;
+
+};          // class songrender
+
+}           // namespace seq66
+
+#endif      // SEQ66_SONGRENDER_HPP
+
+/*
+ * songrender.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -27,14 +27,18 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2021-01-22
- * \updates       2021-01-24
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
+ *  The summary is formatted into one buffer, from one consistent copy of
+ *  each pattern (see sequence::get_summary()), and written to the file in
+ *  one go.  Besides the text listing, it can be JSON or CSV, for tools that
+ *  parse it; the CSV has one row per pattern, and no song-wide items.
  */
 
-#include <string>
+#include <string>                       /* std::string                      */
 
-#include "play/seq.hpp"                 /* seq66::seq pattern class         */
+#include "play/sequence.hpp"            /* seq66::sequence::summary         */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -51,6 +55,20 @@ namespace seq66
 class songsummary
 {
 
+public:
+
+    /**
+     *  The output formats.
+     */
+
+    enum class format
+    {
+        text,           /**< The human-readable listing, the default.       */
+        json,           /**< One JSON object for the song.                  */
+        csv,            /**< One line per pattern, after a header line.     */
+        max             /**< Keep this last... a size value.                */
+    };
+
 private:
 
     /**
@@ -59,9 +77,27 @@ private:
 
     const std::string m_name;
 
+    /**
+     *  The format of the summary.
+     */
+
+    format m_format;
+
+    /**
+     *  The summary, formatted before it is written.
+     */
+
+    std::string m_buffer;
+
+    /**
+     *  Reused for each pattern.
+     */
+
+    sequence::summary m_summary;
+
 public:
 
-    songsummary (const std::string & name);
+    songsummary (const std::string & name, format f = format::text);
     ~songsummary ();
     bool write (performer & p, bool doseqspec = true);
 
@@ -72,40 +108,31 @@ public:
         return m_name;
     }
 
+    const std::string & text () const
+    {
+        return m_buffer;
+    }
+
+    static format format_from_name (const std::string & filename);
+    static format format_from_string (const std::string & s);
+    static std::string format_extension (format f);
+
 protected:
 
-    bool write_sequence (std::ofstream & file, seq::pointer s);
-    bool write_header (std::ofstream & file, const performer & p);
-    void write_mute_groups (std::ofstream & file, const performer & p);
-    void write_prop_header
-    (
-        std::ofstream & file,
-        midilong control_tag,
-        int value
-    );
-    void write_set_names
-    (
-        std::ofstream & file,
-        const performer & p
-    );
-    bool write_proprietary_track (std::ofstream & file, performer & p);
-    void write_bpm
-    (
-        std::ofstream & file,
-        const performer & p
-    );
-    void write_mutes
-    (
-        std::ofstream & file,
-        const performer & p
-    );
-
-    void write_global_bg (std::ofstream & file);
-    void write_beat_info
-    (
-        std::ofstream & file,
-        const performer & p
-    );
+    bool format_summary (performer & p, bool doseqspec);
+    void write_sequence (const sequence::summary & sm);
+    void write_sequence_json (const sequence::summary & sm, bool first);
+    void write_sequence_csv (const sequence::summary & sm);
+    bool write_header (const performer & p, int numtracks);
+    void write_mute_groups (const performer & p);
+    void write_prop_header (midilong control_tag, int value);
+    void write_set_names (const performer & p);
+    bool write_proprietary_track (performer & p);
+    void write_proprietary_json (performer & p);
+    void write_bpm (const performer & p);
+    void write_mutes (const performer & p);
+    void write_global_bg ();
+    void write_beat_info (const performer & p);
 
 };          // class songsummary
 
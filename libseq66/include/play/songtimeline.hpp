@@ -0,0 +1,173 @@
+#if ! defined SEQ66_SONGTIMELINE_HPP
+#define SEQ66_SONGTIMELINE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songtimeline.hpp
+ *
+ *  This module declares the compiled song: the triggers of all patterns,
+ *  merged into one time-ordered schedule.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  In Song mode every pattern of the play-set is played in every frame,
+ *  even though, in a large arrangement, most of them have no trigger
+ *  anywhere near the current tick.  The song timeline flattens the
+ *  triggers into spans sorted by their start tick, and the output thread
+ *  walks it, one frame after the other, keeping the (short) list of spans
+ *  that overlap the frame.  A pattern that is not "busy" in the frame, and
+ *  is not armed, queued, recording, or otherwise doing something on its
+ *  own, has nothing to do, and performer::play() skips it.
+ *
+ *  The timeline is owned and used only by the output thread.  It is
+ *  compiled again whenever the performer's trigger generation changes
+ *  (see performer::song_timeline_stale()), from copies of the triggers
+ *  taken under each pattern's lock.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse alias           */
+#include "play/seq.hpp"                 /* seq66::seq::number, seq::pointer */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class sequence;
+
+/**
+ *  The flattened triggers of a song, and the output thread's place in it.
+ */
+
+class songtimeline
+{
+
+public:
+
+    /**
+     *  One trigger of one pattern.
+     */
+
+    class span
+    {
+
+    public:
+
+        midipulse sp_start;             /**< The first tick of the trigger. */
+        midipulse sp_end;               /**< The last tick of the trigger.  */
+        seq::number sp_seqno;           /**< The pattern triggered.         */
+        midipulse sp_offset;            /**< The trigger's pattern offset.  */
+        int sp_transpose;               /**< The trigger's transposition.   */
+
+    };
+
+    using spans = std::vector<span>;
+
+private:
+
+    /**
+     *  The spans of all of the patterns, sorted by start tick.
+     */
+
+    spans m_spans;
+
+    /**
+     *  The pattern compiled for each pattern number, or null.  A pattern
+     *  that is not the one compiled, such as a new one, or one added to the
+     *  play-set since, is never skipped.
+     */
+
+    std::vector<const sequence *> m_compiled;
+
+    /**
+     *  The trigger generation that was compiled.
+     */
+
+    unsigned m_generation;
+
+    /**
+     *  The index of the first span not yet reached.
+     */
+
+    std::size_t m_cursor;
+
+    /**
+     *  The spans reached that have not yet ended, as indices.
+     */
+
+    std::vector<std::size_t> m_open;
+
+    /**
+     *  The tick at which the next frame should start, to tell a frame that
+     *  follows on from one that jumps back (a loop or a reposition).
+     */
+
+    midipulse m_next_tick;
+
+    /**
+     *  The number of the current frame, and, for each pattern number, the
+     *  last frame in which it was busy.  This avoids clearing a set of flags
+     *  in every frame.
+     */
+
+    unsigned m_frame;
+    std::vector<unsigned> m_busy_frame;
+
+public:
+
+    songtimeline ();
+
+    unsigned generation () const
+    {
+        return m_generation;
+    }
+
+    const spans & schedule () const
+    {
+        return m_spans;
+    }
+
+    void compile (const std::vector<seq::pointer> & seqs, unsigned generation);
+    void advance (midipulse tick);
+    bool skippable (const sequence & s) const;
+
+private:
+
+    void rewind (midipulse tick);
+
+};          // class songtimeline
+
+}           // namespace seq66
+
+#endif      // SEQ66_SONGTIMELINE_HPP
+
+/*
+ * songtimeline.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,384 @@
+#if ! defined SEQ66_STATEMIRROR_HPP
+#define SEQ66_STATEMIRROR_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          statemirror.hpp
+ *
+ *  This module declares the shared-memory mirror of the engine's state,
+ *  which another process can read without touching the engine.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  With the 'rc' option "state-mirror" set to a name, the engine (normally
+ *  seq66cli) creates the POSIX shared-memory segment "/name", and its
+ *  mirror thread, which is not a real-time thread and takes none of the
+ *  locks of the output thread, keeps it up to date:
+ *
+ *      -   The transport (running, song mode, tick, tempo, PPQN) and the
+ *          playscreen, every 10 ms.
+ *      -   The status of each pattern (armed, queued, recording, one-shot,
+ *          buss, channel, length, name), when it changes.
+ *      -   The events of each pattern, copied from its playback snapshot,
+ *          and its triggers, when the pattern's redraw generation moves.
+ *      -   A heartbeat, so that a client can tell that the engine is gone.
+ *
+ *  The segment is read-mostly.  Each part has its own sequence lock:  the
+ *  engine bumps the version to an odd value, writes, and bumps it to an
+ *  even value; a reader copies the part and keeps it only if the version
+ *  was even and did not change.  Readers never block the engine, and a
+ *  reader that crashes leaves nothing behind.
+ *
+ *  The one writable part is the command queue, a single-producer ring of
+ *  automation controls (slot, action, index, d0, d1, inverse) that the
+ *  client pushes.  The mirror thread hands each to
+ *  performer::post_remote_control(), so that it is done by the input
+ *  thread exactly as an OSC or MIDI control would be.  One client at a
+ *  time holds the queue, claimed by its process ID; a client that died is
+ *  replaced by the next one.
+ *
+ *  The client side is statemirror_view, which reads the state and sends
+ *  the controls.  Its client in the tree is "seq66cli --mirror" (see
+ *  mirrorwatch.hpp), which checks the mirror of a running engine.  The Qt
+ *  user interface still drives its own performer.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstdint>                      /* std::int32_t, std::int64_t       */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "ctrl/automation.hpp"          /* seq66::automation::slot, action  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class performer;
+
+/**
+ *  The identity and capacities of the segment.  A client checks the magic
+ *  number and the version before using anything else.
+ */
+
+const std::uint32_t c_shm_magic             = 0x53513636;   /* "SQ66"   */
+const std::uint32_t c_shm_version           = 1;
+const int c_shm_patterns                    = 1024;
+const int c_shm_events                      = 1 << 19;
+const int c_shm_triggers                    = 1 << 16;
+const int c_shm_commands                    = 256;
+const int c_shm_name_size                   = 64;
+
+/**
+ *  One event of a pattern, as played:  the status includes the channel.
+ */
+
+struct shm_event
+{
+    std::int64_t se_tick;               /**< The event's timestamp.         */
+    std::uint8_t se_status;             /**< The status byte.               */
+    std::uint8_t se_d0;                 /**< The first data byte.           */
+    std::uint8_t se_d1;                 /**< The second data byte.          */
+    std::uint8_t se_pad[5];             /**< Pads the event to 16 bytes.    */
+};
+
+/**
+ *  One trigger of a pattern, for the song views.
+ */
+
+struct shm_trigger
+{
+    std::int64_t st_start;              /**< The first tick of the trigger. */
+    std::int64_t st_end;                /**< The last tick of the trigger.  */
+    std::int64_t st_offset;             /**< The offset of the pattern.     */
+    std::int32_t st_transpose;          /**< The transposition, semitones.  */
+    std::int32_t st_pad;                /**< Pads the trigger to 32 bytes.  */
+};
+
+/**
+ *  The state of one pattern slot.  The events and triggers are ranges of
+ *  the pools of the segment.
+ */
+
+struct shm_pattern_info
+{
+    std::uint32_t pi_generation;        /**< The pattern redraw generation. */
+    std::int32_t pi_active;             /**< 1 if the slot has a pattern.   */
+    std::int32_t pi_armed;              /**< 1 if unmuted.                  */
+    std::int32_t pi_queued;             /**< 1 if queued to toggle.         */
+    std::int32_t pi_recording;          /**< 1 if recording.                */
+    std::int32_t pi_one_shot;           /**< 1 if one-shot is pending.      */
+    std::int32_t pi_bus;                /**< The output buss.               */
+    std::int32_t pi_channel;            /**< The channel, or 0x80 (free).   */
+    std::int32_t pi_event_start;        /**< First event in the event pool. */
+    std::int32_t pi_event_count;        /**< The number of events.          */
+    std::int32_t pi_event_room;         /**< The pool room reserved.        */
+    std::int32_t pi_trigger_start;      /**< First in the trigger pool.     */
+    std::int32_t pi_trigger_count;      /**< The number of triggers.        */
+    std::int32_t pi_trigger_room;       /**< The pool room reserved.        */
+    std::int64_t pi_length;             /**< The length in ticks.           */
+    char pi_name[c_shm_name_size];      /**< The name, null-terminated.     */
+};
+
+/**
+ *  A pattern slot and its sequence lock.
+ */
+
+struct shm_pattern
+{
+    std::atomic<std::uint32_t> sp_version;  /**< Sequence lock, odd = busy. */
+    shm_pattern_info sp_info;               /**< The state of the slot.     */
+};
+
+/**
+ *  The transport and the playscreen.
+ */
+
+struct shm_transport
+{
+    std::int32_t st_running;            /**< 1 if playing.                  */
+    std::int32_t st_song_mode;          /**< 1 in Song mode; 0 in Live.     */
+    std::int32_t st_playscreen;         /**< The playing screen-set.        */
+    std::int32_t st_screenset_size;     /**< The slots in a screen-set.     */
+    std::int32_t st_ppqn;               /**< The pulses per quarter note.   */
+    std::int32_t st_sequence_high;      /**< One past the highest pattern.  */
+    std::int64_t st_tick;               /**< The current tick.              */
+    double st_bpm;                      /**< The tempo.                     */
+};
+
+/**
+ *  One automation control sent back by the client.  The fields are those
+ *  of performer::post_remote_control().
+ */
+
+struct shm_command
+{
+    std::int32_t sc_slot;               /**< An automation::slot value.     */
+    std::int32_t sc_action;             /**< An automation::action value.   */
+    std::int32_t sc_index;              /**< Pattern, group, or slot.       */
+    std::int32_t sc_d0;                 /**< MIDI d0, or -1 as for a key.   */
+    std::int32_t sc_d1;                 /**< The value of the control.      */
+    std::int32_t sc_inverse;            /**< 1 for a release or inverse.    */
+};
+
+/**
+ *  The whole segment.  Its pages are touched only as far as the pools are
+ *  used, so its size costs little.
+ */
+
+struct shm_segment
+{
+    std::uint32_t ss_magic;             /**< c_shm_magic once it is ready.  */
+    std::uint32_t ss_version;           /**< c_shm_version.                 */
+    std::uint32_t ss_size;              /**< sizeof(shm_segment).           */
+    std::int32_t ss_engine_pid;         /**< The process ID of the engine.  */
+    std::atomic<std::int64_t> ss_heartbeat_us;  /**< Engine's microtime(). */
+    std::atomic<std::uint32_t> ss_layout;       /**< Pool lock, odd = busy. */
+    std::atomic<std::uint32_t> ss_transport_version;    /**< Its lock.      */
+    shm_transport ss_transport;         /**< The transport.                 */
+    std::atomic<std::int32_t> ss_client_pid;    /**< Commanding client.     */
+    std::atomic<std::uint32_t> ss_command_head; /**< Written by the client. */
+    std::atomic<std::uint32_t> ss_command_tail; /**< Written by the engine. */
+    std::atomic<std::uint32_t> ss_commands_dropped; /**< Refused controls.  */
+    shm_command ss_commands[c_shm_commands];    /**< The command ring.      */
+    shm_pattern ss_patterns[c_shm_patterns];    /**< The pattern slots.     */
+    std::int32_t ss_events_used;        /**< The event pool allocated.      */
+    std::int32_t ss_triggers_used;      /**< The trigger pool allocated.    */
+    shm_event ss_events[c_shm_events];          /**< The event pool.        */
+    shm_trigger ss_triggers[c_shm_triggers];    /**< The trigger pool.      */
+};
+
+/**
+ *  The engine side:  creates the segment and keeps it up to date.
+ */
+
+class statemirror
+{
+
+private:
+
+    /**
+     *  The performer mirrored.
+     */
+
+    performer & m_perf;
+
+    /**
+     *  The segment name, with its leading slash.
+     */
+
+    std::string m_name;
+
+    /**
+     *  The mapping of the segment, or null.
+     */
+
+    shm_segment * m_segment;
+
+    /**
+     *  The mirror thread and its flag.
+     */
+
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+
+    /**
+     *  The last sequence::change_generation() seen, to skip the scan of the
+     *  patterns while nothing has changed, and a countdown to a scan
+     *  anyway, which catches the changes of status that do not move it.
+     */
+
+    unsigned m_change_generation;
+    int m_rescan_countdown;
+
+    /**
+     *  True once the pools overflowed, so that it is reported only once.
+     */
+
+    bool m_overflow_reported;
+
+public:
+
+    statemirror (performer & p, const std::string & name);
+    ~statemirror ();
+
+    statemirror (const statemirror &) = delete;
+    statemirror & operator = (const statemirror &) = delete;
+
+    bool start ();
+    void stop ();
+
+    const std::string & name () const
+    {
+        return m_name;
+    }
+
+private:
+
+    bool create_segment ();
+    void remove_segment ();
+    void mirror_loop ();
+    void publish_transport ();
+    void publish_patterns ();
+    void publish_pattern (int seqno);
+    bool reserve_events (shm_pattern_info & pi, int count);
+    bool reserve_triggers (shm_pattern_info & pi, int count);
+    void compact_pools ();
+    int take_commands ();
+
+};          // class statemirror
+
+/**
+ *  The client side:  maps the segment of a running engine.  Every read is
+ *  a copy, taken without blocking the engine.
+ */
+
+class statemirror_view
+{
+
+public:
+
+    /**
+     *  A copy of one pattern slot, and of its events and triggers.
+     */
+
+    class pattern
+    {
+
+    public:
+
+        shm_pattern_info p_info;        /**< The slot, as copied.           */
+        std::string p_name;             /**< The name, copied.              */
+        std::vector<shm_event> p_events;        /**< The events.            */
+        std::vector<shm_trigger> p_triggers;    /**< The triggers.          */
+
+    };
+
+private:
+
+    /**
+     *  The segment name, with its leading slash.
+     */
+
+    std::string m_name;
+
+    /**
+     *  The read-write mapping of the segment, or null.  Only the command
+     *  queue is written.
+     */
+
+    shm_segment * m_segment;
+
+    /**
+     *  True once this client claimed the command queue.
+     */
+
+    bool m_commander;
+
+public:
+
+    statemirror_view ();
+    ~statemirror_view ();
+
+    statemirror_view (const statemirror_view &) = delete;
+    statemirror_view & operator = (const statemirror_view &) = delete;
+
+    bool attach (const std::string & name);
+    void detach ();
+
+    bool attached () const
+    {
+        return m_segment != nullptr;
+    }
+
+    bool engine_alive (long timeoutus = 500000) const;
+    bool read_transport (shm_transport & st) const;
+    bool read_pattern (int seqno, pattern & p, bool events = true) const;
+    bool pattern_generation (int seqno, std::uint32_t & generation) const;
+    bool post_control
+    (
+        automation::slot s, automation::action a, int index,
+        int d1 = 0, int d0 = (-1), bool inverse = false
+    );
+
+private:
+
+    bool claim_commands ();
+
+};          // class statemirror_view
+
+}           // namespace seq66
+
+#endif      // SEQ66_STATEMIRROR_HPP
+
+/*
+ * statemirror.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-30
- * \updates       2023-12-20
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  By segregating trigger support into its own module, the sequence class is
@@ -36,7 +36,6 @@
  */
 
 #include <string>
-#include <stack>
 #include <vector>
 
 #include "midi/midibytes.hpp"           /* seq66::midipulse alias, etc.     */
@@ -312,7 +311,7 @@ public:
 
 private:
 
-    void rescale (int oldppqn, int newppqn);
+    void rescale (int newppqn, int oldppqn);
 
 };          // class trigger
 
@@ -352,10 +351,11 @@ private:
 
     /**
      *  Provides a stack for use with the undo/redo features of the
-     *  trigger support.
+     *  trigger support.  A vector, used as a stack, rather than a
+     *  std::stack, so that undo_bytes() can walk it.
      */
 
-    using stack = std::stack<container>;
+    using stack = std::vector<container>;
 
 private:
 
@@ -403,6 +403,15 @@ private:
 
     container::iterator m_draw_iterator;
 
+    /**
+     *  The index of the first trigger that had not ended at the start of the
+     *  last frame played in Song mode.  Used only by play(), in the output
+     *  thread.  It is a hint, checked before each use, so that an edit of the
+     *  triggers never leaves it pointing at the wrong one.  See play_cursor().
+     */
+
+    std::size_t m_play_cursor;
+
     /**
      *  Set to true if there is an active trigger in the trigger clipboard.
      */
@@ -482,6 +491,12 @@ public:
         return int(m_triggers.size());
     }
 
+    std::size_t bytes () const
+    {
+        return m_triggers.capacity() * sizeof(trigger);
+    }
+
+    std::size_t undo_bytes () const;
     int datasize (midilong seqspec) const;
     bool any_transposed () const;
 
@@ -508,6 +523,7 @@ public:
     void adjust_offsets_to_length (midipulse newlen);
     bool split (midipulse tick, trigger::splitpoint splittype);
     bool grow_trigger (midipulse tickfrom, midipulse tickto, midipulse length);
+    bool close_trigger (midipulse tickfrom, midipulse tickto);
     const trigger & find_trigger (midipulse tick) const;
     const trigger & find_trigger_by_index (int index) const;
     bool remove (midipulse tick);
@@ -530,6 +546,7 @@ public:
     midipulse get_selected_start ();
     midipulse get_selected_end ();
     midipulse get_maximum () const;
+    midipulse next_transition (midipulse tick) const;
     bool move
     (
         midipulse starttick, midipulse distance,
@@ -550,6 +567,7 @@ public:
     {
         m_triggers.clear();
         m_number_selected = 0;
+        changed();
     }
 
     trigger next ();
@@ -576,12 +594,17 @@ public:
 private:
 
     void sort ();
+    void changed ();
     bool split (trigger & t, midipulse splittick);
-    bool rescale (int oldppqn, int newppqn);
+    bool rescale (int newppqn, int oldppqn);
     midipulse adjust_offset (midipulse offset);
     void offset_selected (midipulse tick, grow editmode);
     void select (trigger & t, bool count = true);
     void unselect (trigger & t, bool count = true);
+    container::const_iterator first_unended (midipulse tick) const;
+    container::iterator covering (midipulse tick);
+    void insert_sorted (const trigger & t);
+    std::size_t play_cursor (midipulse tick);
 
     bool cend (container::iterator & evi) const // no can do const_iterator
     {
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-24
- * \updates       2025-01-19
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *    Some options (the "USE_xxx" options) specify experimental and
@@ -87,15 +87,6 @@
 
 #define SEQ66_USE_DEFAULT_PORT_MAPPING
 
-/**
- *  For issue #100, this macro enables using our new ring_buffer instead of
- *  jack_ringbuffer_t. We no longer attempt to add the timestamp to the
- *  JACK ringbuffer, even if this macro is disabled.  Too many side issues,
- *  too much code, so disabling this macro preserves the old behavior.
- */
-
-#define SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-
 /**
  *  Choose between C++ or bare pthreads.  Affects only the performer class.
  *  For condition_variables and mutexes, we are forced to stick with the
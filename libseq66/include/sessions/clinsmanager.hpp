@@ -28,7 +28,7 @@
  * \library       clinsmanager application
  * \author        Chris Ahlstrom
  * \date          2020-08-31
- * \updates       2024-11-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Provides a base class that can be used to manage the command-line version
@@ -40,10 +40,14 @@
 
 #include <memory>                       /* std::unique_ptr, shared_ptr<>    */
 
+#include "play/statemirror.hpp"        /* seq66::statemirror               */
 #include "sessions/smanager.hpp"        /* seq66::smanager                  */
 
 #if defined SEQ66_NSM_SUPPORT
 #include "nsm/nsmclient.hpp"            /* seq66::nsmclient                 */
+#include "nsm/osccontrol.hpp"           /* seq66::osccontrol                */
+#include "nsm/oscmirror.hpp"            /* seq66::oscmirror                 */
+#include "nsm/oscmetrics.hpp"           /* seq66::oscmetrics                */
 #endif
 
 /**
@@ -84,8 +88,37 @@ private:
 
     std::unique_ptr<nsmclient> m_nsm_client;
 
+    /**
+     *  The optional OSC server of the engine metrics, for a headless run.
+     *  Created by run() if the 'rc' "metrics-port" is set.
+     */
+
+    std::unique_ptr<oscmetrics> m_osc_metrics;
+
+    /**
+     *  The optional OSC control server.  Created by run() if the 'rc'
+     *  "osc-control-port" is set.
+     */
+
+    std::unique_ptr<osccontrol> m_osc_control;
+
+    /**
+     *  The optional link to a mirroring replica, or from the primary.
+     *  Created by run() if the 'rc' "mirror-role" and "mirror-port" are set.
+     */
+
+    std::unique_ptr<oscmirror> m_osc_mirror;
+
 #endif
 
+    /**
+     *  The optional shared-memory mirror of the engine's state, for a user
+     *  interface in another process.  Created by run() if the 'rc'
+     *  "state-mirror" is set.
+     */
+
+    std::unique_ptr<statemirror> m_state_mirror;
+
     /**
      *  This value indicates that the nsmclient is active. It is roughly
      *  similar in meaning to the "global" value usr().in_nsm_session().
@@ -94,7 +127,9 @@ private:
     bool m_nsm_active;
 
     /**
-     *  Holds a copy of the user-interface redraw rate.
+     *  Holds a copy of the user-interface redraw rate.  This is how long
+     *  run() sleeps while control-out feedback is being held back by its
+     *  rate limit.  Otherwise it sleeps until woken (see session_wait()).
      */
 
     int m_poll_period_ms;
@@ -156,6 +191,11 @@ private:
     );
     bool detect_session (std::string & url);
 
+protected:
+
+    void start_osc_servers ();
+    void stop_osc_servers ();
+
 };          // class clinsmanager
 
 }           // namespace seq66
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-05-30
- * \updates       2025-01-23
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class provides a process for starting, running, restarting, and
@@ -38,7 +38,10 @@
  */
 
 #include <memory>                       /* std::shared_ptr<>, unique_ptr<>  */
+#include <mutex>                        /* std::mutex, std::lock_guard<>    */
+#include <thread>                       /* std::thread                      */
 
+#include "midi/midijournal.hpp"         /* seq66::midijournal               */
 #include "play/performer.hpp"           /* seq66::performer                 */
 
 /*
@@ -131,6 +134,48 @@ private:
 
     mutable bool m_extant_msg_active;
 
+    /**
+     *  The thread that writes the MIDI file encoded by save_in_background().
+     *  Only one background save runs at a time.
+     */
+
+    std::thread m_save_thread;
+
+    /**
+     *  Guards the three members that report the outcome of the background
+     *  save to check_background_save().
+     */
+
+    std::mutex m_save_mutex;
+
+    /**
+     *  Set by the save thread when the file has been written, or the write
+     *  has failed.
+     */
+
+    bool m_save_done;
+
+    /**
+     *  Indicates that the background save succeeded.
+     */
+
+    bool m_save_ok;
+
+    /**
+     *  The name of the file written by the background save, or the error
+     *  message if it failed.
+     */
+
+    std::string m_save_message;
+
+    /**
+     *  The edit journal of the current song, if the 'rc' "journal-interval"
+     *  is set, and the time of its last write, in microseconds.
+     */
+
+    std::unique_ptr<midijournal> m_journal;
+    long m_journal_time;
+
 public:
 
     smanager (const std::string & caps = "");
@@ -180,6 +225,11 @@ public:
 
     bool internal_error_check (std::string & msg) const;
     void error_handling ();
+    bool save_in_background (const std::string & filename, std::string & msg);
+    void check_background_save ();
+    void finish_background_save ();
+    void journal_edits ();
+    void write_trace () const;
 
     bool internal_error_pending () const
     {
@@ -0,0 +1,301 @@
+#if ! defined SEQ66_COWVECTOR_HPP
+#define SEQ66_COWVECTOR_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          cowvector.hpp
+ *
+ *  This module defines a std::vector whose storage is shared by its copies
+ *  until one of them is changed.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Used for the events of an eventlist, so that copying a pattern, or
+ *  pushing an undo entry, does not copy the events.  The class provides
+ *  the part of the std::vector interface that eventlist uses.  The const
+ *  functions read the shared storage; the non-const ones first make a
+ *  private copy of it if it is shared ("detaching").  So, as with any
+ *  copy-on-write container, taking a non-const iterator counts as a change,
+ *  and the iterators taken from a shared vector are not valid after a
+ *  non-const call, except as the position given to insert() or erase().
+ *
+ *  The container defaults to std::vector; eventlist uses event::buffer, a
+ *  pagedvector.
+ *
+ *  The storage is never written while shared, so the copies can be read by
+ *  different threads.  A given cowvector is not thread-safe, any more than
+ *  a std::vector is; eventlist is protected by its sequence's mutex.
+ */
+
+#include <memory>                       /* std::shared_ptr<>                */
+#include <utility>                      /* std::forward(), std::move()      */
+#include <vector>                       /* std::vector<>                    */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A copy-on-write vector.
+ */
+
+template <typename T, typename C = std::vector<T>>
+class cowvector
+{
+
+public:
+
+    using container = C;
+    using value_type = T;
+    using size_type = typename container::size_type;
+    using iterator = typename container::iterator;
+    using const_iterator = typename container::const_iterator;
+    using reverse_iterator = typename container::reverse_iterator;
+    using const_reverse_iterator =
+        typename container::const_reverse_iterator;
+
+private:
+
+    /**
+     *  The storage, shared by the copies of this vector.  Never null.
+     */
+
+    std::shared_ptr<container> m_data;
+
+public:
+
+    cowvector () :
+        m_data  (std::make_shared<container>())
+    {
+        // no code
+    }
+
+    /*
+     *  Copying shares the storage.  There is no move, which would leave the
+     *  source without storage; a copy is just as cheap.
+     */
+
+    cowvector (const cowvector &) = default;
+    cowvector & operator = (const cowvector &) = default;
+
+    /**
+     *  True if another copy uses the same storage.
+     */
+
+    bool shared () const
+    {
+        return m_data.use_count() > 1;
+    }
+
+    operator const container & () const
+    {
+        return *m_data;
+    }
+
+    operator container & ()
+    {
+        detach();
+        return *m_data;
+    }
+
+    const_iterator begin () const   { return m_data->cbegin(); }
+    const_iterator end () const     { return m_data->cend(); }
+    const_iterator cbegin () const  { return m_data->cbegin(); }
+    const_iterator cend () const    { return m_data->cend(); }
+    const_reverse_iterator rbegin () const { return m_data->crbegin(); }
+    const_reverse_iterator rend () const   { return m_data->crend(); }
+
+    iterator begin ()
+    {
+        detach();
+        return m_data->begin();
+    }
+
+    iterator end ()
+    {
+        detach();
+        return m_data->end();
+    }
+
+    reverse_iterator rbegin ()
+    {
+        detach();
+        return m_data->rbegin();
+    }
+
+    reverse_iterator rend ()
+    {
+        detach();
+        return m_data->rend();
+    }
+
+    size_type size () const
+    {
+        return m_data->size();
+    }
+
+    size_type capacity () const
+    {
+        return m_data->capacity();
+    }
+
+    bool empty () const
+    {
+        return m_data->empty();
+    }
+
+    const T & operator [] (size_type i) const
+    {
+        return (*m_data)[i];
+    }
+
+    T & operator [] (size_type i)
+    {
+        detach();
+        return (*m_data)[i];
+    }
+
+    const T & back () const
+    {
+        return m_data->back();
+    }
+
+    T & back ()
+    {
+        detach();
+        return m_data->back();
+    }
+
+    void reserve (size_type n)
+    {
+        detach();
+        m_data->reserve(n);
+    }
+
+    void shrink_to_fit ()
+    {
+        detach();
+        m_data->shrink_to_fit();
+    }
+
+    /**
+     *  A shared vector is cleared by letting go of the storage, rather than
+     *  copying it first.
+     */
+
+    void clear ()
+    {
+        if (shared())
+            m_data = std::make_shared<container>();
+        else
+            m_data->clear();
+    }
+
+    void push_back (const T & t)
+    {
+        detach();
+        m_data->push_back(t);
+    }
+
+    void push_back (T && t)
+    {
+        detach();
+        m_data->push_back(std::move(t));
+    }
+
+    template <typename... Args>
+    void emplace_back (Args &&... args)
+    {
+        detach();
+        m_data->emplace_back(std::forward<Args>(args)...);
+    }
+
+    /*
+     *  The position is moved before m_data is used, since detach() can
+     *  replace the storage.
+     */
+
+    iterator insert (const_iterator pos, const T & t)
+    {
+        const_iterator p = detach(pos);
+        return m_data->insert(p, t);
+    }
+
+    template <typename InputIt>
+    iterator insert (const_iterator pos, InputIt first, InputIt last)
+    {
+        const_iterator p = detach(pos);
+        return m_data->insert(p, first, last);
+    }
+
+    iterator erase (const_iterator pos)
+    {
+        const_iterator p = detach(pos);
+        return m_data->erase(p);
+    }
+
+    iterator erase (const_iterator first, const_iterator last)
+    {
+        const_iterator f = detach(first);
+        return m_data->erase(f, f + (last - first));
+    }
+
+private:
+
+    /**
+     *  Detaches, and moves a position in the old storage to the new one.
+     */
+
+    const_iterator detach (const_iterator pos)
+    {
+        auto offset = pos - m_data->cbegin();
+        detach();
+        return m_data->cbegin() + offset;
+    }
+
+    /**
+     *  Gives this vector its own copy of the storage, if it is shared.
+     */
+
+    void detach ()
+    {
+        if (shared())
+            m_data = std::make_shared<container>(*m_data);
+    }
+
+};          // class cowvector
+
+}           // namespace seq66
+
+#endif      // SEQ66_COWVECTOR_HPP
+
+/*
+ * cowvector.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
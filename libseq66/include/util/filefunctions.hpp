@@ -27,7 +27,7 @@
  *
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2025-02-01
+ * \updates       2026-10-14
  * \version       $Revision$
  *
  *    Also see the filefunctions.cpp module.  The functions here use
@@ -64,6 +64,7 @@ extern bool file_is_directory (const std::string & targetfile);
 extern bool file_name_good (const std::string & filename);
 extern bool file_mode_good (const std::string & mode);
 extern size_t file_size (const std::string & filename);
+extern long file_mod_time (const std::string & filename);
 extern std::FILE * file_open
 (
     const std::string & filename,
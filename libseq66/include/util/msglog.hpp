@@ -0,0 +1,233 @@
+#if ! defined SEQ66_MSGLOG_HPP
+#define SEQ66_MSGLOG_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          msglog.hpp
+ *
+ *  This module declares the asynchronous writer of the console messages.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The message functions of basic_macros.cpp, such as error_message() and
+ *  msgprintf(), used to write to std::cout or std::cerr in the calling
+ *  thread.  When called from the output or input thread, that is a lock and
+ *  a write(2), and perhaps a wait on a slow terminal or disk.  While the
+ *  msglog runs, those functions instead copy the text into a fixed-size
+ *  record of a preallocated ring, which any number of threads can fill
+ *  without a lock, and a background thread writes the records out.  If the
+ *  ring is full, the message is dropped and counted; the caller never
+ *  waits.  Since the log file is std::cout and std::cerr rerouted, the log
+ *  file and the log view get the same text as before.
+ *
+ *  A message repeated in a burst, such as one per MIDI event, is limited per
+ *  message site: after twenty in a second, the rest of that second's are
+ *  counted, and a "similar messages suppressed" note is written instead.
+ *
+ *  Before start_msglog() and after stop_msglog(), the messages are written
+ *  directly, as always.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <condition_variable>           /* std::condition_variable          */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector                      */
+
+#include "seq66_features.hpp"           /* seq66::msglevel                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A lock-free, multiple-producer queue of console messages and the thread
+ *  that writes them.
+ */
+
+class msglog
+{
+
+public:
+
+    /**
+     *  The room for the text of one message, including the null.  A longer
+     *  message is cut.
+     */
+
+    static const int c_text_size = 500;
+
+private:
+
+    /**
+     *  One slot of the ring.  The sequence number tells whether the slot is
+     *  free for the producer of a given position or full for the writer, as
+     *  in Dmitry Vyukov's bounded queue.
+     */
+
+    class record
+    {
+
+    public:
+
+        std::atomic<std::size_t> mr_sequence;   /**< Position handshake.    */
+        msglevel mr_level;                      /**< The message level.     */
+        char mr_text[c_text_size];              /**< The text, sans tag.    */
+
+    };
+
+    /**
+     *  The count of message sites kept for the rate limit.  Sites that hash
+     *  to the same slot take it over from each other.
+     */
+
+    static const int c_site_count = 64;
+
+    /**
+     *  The rate-limit state of one message site.
+     */
+
+    class site
+    {
+
+    public:
+
+        std::atomic<std::size_t> ms_key;        /**< Hash of the site text. */
+        std::atomic<long> ms_second;            /**< The current second.    */
+        std::atomic<int> ms_count;              /**< Messages this second.  */
+        std::atomic<int> ms_suppressed;         /**< Messages not posted.   */
+
+    };
+
+    /**
+     *  The ring, allocated by start(), and one less than its size.
+     */
+
+    std::vector<record> m_records;
+    std::size_t m_mask;
+
+    /**
+     *  The next position to fill and the next to write.
+     */
+
+    std::atomic<std::size_t> m_head;
+    std::size_t m_tail;
+
+    /**
+     *  The rate-limit table.
+     */
+
+    std::vector<site> m_sites;
+
+    /**
+     *  The writer thread, and what it waits on between drains.  Producers do
+     *  not notify it; it wakes up every so often.
+     */
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stopping;
+
+    /**
+     *  Set while messages are accepted, and the count of producers inside
+     *  post(), which stop() waits out before the last drain.
+     */
+
+    std::atomic<bool> m_running;
+    std::atomic<int> m_posting;
+
+    /**
+     *  The count of messages dropped because the ring was full, and the
+     *  part of that count already reported.
+     */
+
+    std::atomic<int> m_dropped;
+    int m_reported;
+
+public:
+
+    msglog ();
+    ~msglog ();
+
+    msglog (const msglog &) = delete;
+    msglog & operator = (const msglog &) = delete;
+
+    bool start ();
+    void stop ();
+    bool post
+    (
+        msglevel lev, const std::string & sitetext,
+        const std::string & msg, const std::string & data = ""
+    );
+
+    bool running () const
+    {
+        return m_running;
+    }
+
+    int dropped () const
+    {
+        return m_dropped;
+    }
+
+private:
+
+    bool limited (const std::string & sitetext, int & suppressed);
+    bool push
+    (
+        msglevel lev, const std::string & msg, const std::string & data
+    );
+    void writer_func ();
+    void drain ();
+    void report_dropped ();
+
+};          // class msglog
+
+/*
+ *  Free functions for the application's single msglog.
+ */
+
+extern bool start_msglog ();
+extern void stop_msglog ();
+extern bool post_msglog
+(
+    msglevel lev, const std::string & sitetext,
+    const std::string & msg, const std::string & data = ""
+);
+
+}           // namespace seq66
+
+#endif      // SEQ66_MSGLOG_HPP
+
+/*
+ * msglog.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
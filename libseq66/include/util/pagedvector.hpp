@@ -0,0 +1,577 @@
+#if ! defined SEQ66_PAGEDVECTOR_HPP
+#define SEQ66_PAGEDVECTOR_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          pagedvector.hpp
+ *
+ *  This module defines a vector stored in fixed-size pages, so that it grows
+ *  without moving its elements.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Used for the events of an eventlist (event::buffer).  A std::vector
+ *  doubles its storage as it grows, so that recording a long improvisation
+ *  means ever larger blocks, each copied into the next, with the old and
+ *  new block held at once: a list of 300 MB briefly needs 900 MB.  Here the
+ *  elements are kept in pages of c_page_size elements.  Only the first page
+ *  grows as a std::vector does, so that a short pattern costs no more than
+ *  before; after it, each page is allocated full size, once, and never
+ *  moves.  So appending, as recording does, never copies what is already
+ *  there, and the memory grows one page at a time.
+ *
+ *  Every page but the last is full, so element i is at page i / c_page_size,
+ *  offset i % c_page_size, both a shift and a mask.  The iterators are
+ *  random-access, holding the container and an index, so the standard
+ *  algorithms (sort, lower_bound, remove_if) work as they do on a vector,
+ *  and an iterator stays valid, at its index, when elements are appended.
+ *  Inserting or erasing in the middle moves the elements after the position,
+ *  as with a vector.  A page's time range, for a sorted event list, is that
+ *  of its first and last events, so the binary searches of
+ *  eventlist::cbegin() touch only the pages they need.
+ *
+ *  The elements are not contiguous, so there is no data() function.
+ */
+
+#include <algorithm>                    /* std::move(), std::rotate()       */
+#include <cstddef>                      /* std::size_t, std::ptrdiff_t      */
+#include <iterator>                     /* std::reverse_iterator<>          */
+#include <type_traits>                  /* std::conditional<>, enable_if<>  */
+#include <utility>                      /* std::forward(), std::swap()      */
+#include <vector>                       /* std::vector<>                    */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A vector of elements held in fixed-size pages.
+ */
+
+template <typename T>
+class pagedvector
+{
+
+public:
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+    /**
+     *  The number of elements in a page, a power of two.  For events, a
+     *  page is a few hundred kilobytes.
+     */
+
+    static const size_type c_page_shift = 12;
+    static const size_type c_page_size = size_type(1) << c_page_shift;
+    static const size_type c_page_mask = c_page_size - 1;
+
+    /**
+     *  The iterators, const or not.  Comparing or subtracting a const and
+     *  a non-const one works, as for a vector.
+     */
+
+    template <bool CONST>
+    class basic_iterator
+    {
+
+        friend class pagedvector;
+
+        template <bool C>
+        friend class basic_iterator;
+
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer =
+            typename std::conditional<CONST, const T *, T *>::type;
+        using reference =
+            typename std::conditional<CONST, const T &, T &>::type;
+        using owner = typename std::conditional
+        <
+            CONST, const pagedvector *, pagedvector *
+        >::type;
+
+    private:
+
+        owner m_owner;
+        difference_type m_index;
+
+    public:
+
+        basic_iterator () : m_owner (nullptr), m_index (0)
+        {
+            // no code
+        }
+
+        basic_iterator (owner o, difference_type i) :
+            m_owner (o), m_index (i)
+        {
+            // no code
+        }
+
+        /*
+         *  An iterator converts to a const_iterator, not the reverse.
+         */
+
+        template
+        <
+            bool C, typename = typename std::enable_if<CONST && ! C>::type
+        >
+        basic_iterator (const basic_iterator<C> & rhs) :
+            m_owner (rhs.m_owner), m_index (rhs.m_index)
+        {
+            // no code
+        }
+
+        reference operator * () const
+        {
+            return (*m_owner)[size_type(m_index)];
+        }
+
+        pointer operator -> () const
+        {
+            return &(*m_owner)[size_type(m_index)];
+        }
+
+        reference operator [] (difference_type n) const
+        {
+            return (*m_owner)[size_type(m_index + n)];
+        }
+
+        basic_iterator & operator ++ ()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        basic_iterator operator ++ (int)
+        {
+            basic_iterator result = *this;
+            ++m_index;
+            return result;
+        }
+
+        basic_iterator & operator -- ()
+        {
+            --m_index;
+            return *this;
+        }
+
+        basic_iterator operator -- (int)
+        {
+            basic_iterator result = *this;
+            --m_index;
+            return result;
+        }
+
+        basic_iterator & operator += (difference_type n)
+        {
+            m_index += n;
+            return *this;
+        }
+
+        basic_iterator & operator -= (difference_type n)
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        basic_iterator operator + (difference_type n) const
+        {
+            return basic_iterator(m_owner, m_index + n);
+        }
+
+        friend basic_iterator operator +
+        (
+            difference_type n, const basic_iterator & it
+        )
+        {
+            return it + n;
+        }
+
+        basic_iterator operator - (difference_type n) const
+        {
+            return basic_iterator(m_owner, m_index - n);
+        }
+
+        template <bool C>
+        difference_type operator - (const basic_iterator<C> & rhs) const
+        {
+            return m_index - rhs.m_index;
+        }
+
+        template <bool C>
+        bool operator == (const basic_iterator<C> & rhs) const
+        {
+            return m_index == rhs.m_index;
+        }
+
+        template <bool C>
+        bool operator != (const basic_iterator<C> & rhs) const
+        {
+            return m_index != rhs.m_index;
+        }
+
+        template <bool C>
+        bool operator < (const basic_iterator<C> & rhs) const
+        {
+            return m_index < rhs.m_index;
+        }
+
+        template <bool C>
+        bool operator > (const basic_iterator<C> & rhs) const
+        {
+            return m_index > rhs.m_index;
+        }
+
+        template <bool C>
+        bool operator <= (const basic_iterator<C> & rhs) const
+        {
+            return m_index <= rhs.m_index;
+        }
+
+        template <bool C>
+        bool operator >= (const basic_iterator<C> & rhs) const
+        {
+            return m_index >= rhs.m_index;
+        }
+
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+
+    using page = std::vector<T>;
+
+    /**
+     *  The pages.  All but the last one in use are full.  Pages after that
+     *  one are empty, kept by reserve() or by removals.
+     */
+
+    std::vector<page> m_pages;
+
+    /**
+     *  The number of elements.
+     */
+
+    size_type m_size;
+
+public:
+
+    pagedvector () : m_pages (), m_size (0)
+    {
+        // no code
+    }
+
+    explicit pagedvector (size_type n) : m_pages (), m_size (0)
+    {
+        resize(n);
+    }
+
+    template <typename InputIt>
+    pagedvector (InputIt first, InputIt last) : m_pages (), m_size (0)
+    {
+        for ( ; first != last; ++first)
+            push_back(*first);
+    }
+
+    pagedvector (const pagedvector &) = default;
+    pagedvector & operator = (const pagedvector &) = default;
+
+    pagedvector (pagedvector && rhs) noexcept :
+        m_pages (std::move(rhs.m_pages)),
+        m_size  (rhs.m_size)
+    {
+        rhs.m_pages.clear();
+        rhs.m_size = 0;
+    }
+
+    pagedvector & operator = (pagedvector && rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            m_pages = std::move(rhs.m_pages);
+            m_size = rhs.m_size;
+            rhs.m_pages.clear();
+            rhs.m_size = 0;
+        }
+        return *this;
+    }
+
+    iterator begin ()               { return iterator(this, 0); }
+    iterator end ()                 { return iterator(this, ssize()); }
+    const_iterator begin () const   { return const_iterator(this, 0); }
+    const_iterator end () const     { return const_iterator(this, ssize()); }
+    const_iterator cbegin () const  { return begin(); }
+    const_iterator cend () const    { return end(); }
+
+    reverse_iterator rbegin ()      { return reverse_iterator(end()); }
+    reverse_iterator rend ()        { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin () const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend () const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin () const { return rbegin(); }
+    const_reverse_iterator crend () const   { return rend(); }
+
+    size_type size () const
+    {
+        return m_size;
+    }
+
+    bool empty () const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     *  The number of elements that fit without allocating.
+     */
+
+    size_type capacity () const
+    {
+        size_type result = 0;
+        for (const auto & p : m_pages)
+            result += p.capacity();
+
+        return result;
+    }
+
+    T & operator [] (size_type i)
+    {
+        return m_pages[i >> c_page_shift][i & c_page_mask];
+    }
+
+    const T & operator [] (size_type i) const
+    {
+        return m_pages[i >> c_page_shift][i & c_page_mask];
+    }
+
+    T & front ()                { return (*this)[0]; }
+    const T & front () const    { return (*this)[0]; }
+    T & back ()                 { return (*this)[m_size - 1]; }
+    const T & back () const     { return (*this)[m_size - 1]; }
+
+    /**
+     *  Allocates the pages for n elements.  For the first page, only what
+     *  is asked for, so that a short list stays small.
+     */
+
+    void reserve (size_type n)
+    {
+        size_type pages = (n + c_page_mask) >> c_page_shift;
+        if (m_pages.size() < pages)
+            m_pages.reserve(pages);
+
+        for (size_type p = 0; p < pages; ++p)
+        {
+            if (p == m_pages.size())
+                m_pages.emplace_back();
+
+            size_type want = p == 0 && pages == 1 ? n : c_page_size ;
+            if (m_pages[p].capacity() < want)
+                m_pages[p].reserve(want);
+        }
+    }
+
+    /**
+     *  Frees the pages that are not in use, and the unused room of the last
+     *  page in use.  That page grows as a vector does if more is appended.
+     */
+
+    void shrink_to_fit ()
+    {
+        size_type used = (m_size + c_page_mask) >> c_page_shift;
+        m_pages.resize(used);
+        m_pages.shrink_to_fit();
+        if (used > 0)
+            m_pages.back().shrink_to_fit();
+    }
+
+    /**
+     *  Unlike std::vector::clear(), the pages past the first are freed,
+     *  so that clearing a long recording gives back its memory.
+     */
+
+    void clear ()
+    {
+        if (m_pages.size() > 1)
+            m_pages.resize(1);
+
+        if (! m_pages.empty())
+            m_pages[0].clear();
+
+        m_size = 0;
+    }
+
+    void push_back (const T & t)
+    {
+        next_page().push_back(t);
+        ++m_size;
+    }
+
+    void push_back (T && t)
+    {
+        next_page().push_back(std::move(t));
+        ++m_size;
+    }
+
+    template <typename... Args>
+    void emplace_back (Args &&... args)
+    {
+        next_page().emplace_back(std::forward<Args>(args)...);
+        ++m_size;
+    }
+
+    void pop_back ()
+    {
+        --m_size;
+        m_pages[m_size >> c_page_shift].pop_back();
+    }
+
+    void resize (size_type n)
+    {
+        while (m_size > n)
+            pop_back();
+
+        while (m_size < n)
+            emplace_back();
+    }
+
+    /*
+     *  Insertions append, then rotate the new elements into place.  The
+     *  iterators hold indices, so the source range of an insert can even
+     *  be in this vector.
+     */
+
+    iterator insert (const_iterator pos, const T & t)
+    {
+        difference_type index = pos.m_index;
+        push_back(t);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    iterator insert (const_iterator pos, T && t)
+    {
+        difference_type index = pos.m_index;
+        push_back(std::move(t));
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    template <typename InputIt>
+    iterator insert (const_iterator pos, InputIt first, InputIt last)
+    {
+        difference_type index = pos.m_index;
+        difference_type old = ssize();
+        for ( ; first != last; ++first)
+            push_back(*first);
+
+        std::rotate(begin() + index, begin() + old, end());
+        return begin() + index;
+    }
+
+    iterator erase (const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase (const_iterator first, const_iterator last)
+    {
+        difference_type index = first.m_index;
+        difference_type count = last.m_index - first.m_index;
+        if (count > 0)
+        {
+            std::move(begin() + last.m_index, end(), begin() + index);
+            for (difference_type i = 0; i < count; ++i)
+                pop_back();
+        }
+        return begin() + index;
+    }
+
+    void swap (pagedvector & rhs)
+    {
+        m_pages.swap(rhs.m_pages);
+        std::swap(m_size, rhs.m_size);
+    }
+
+private:
+
+    difference_type ssize () const
+    {
+        return difference_type(m_size);
+    }
+
+    /**
+     *  Gets the page the next element goes into, allocating it at full size
+     *  if needed.  The first page grows as a vector does.
+     */
+
+    page & next_page ()
+    {
+        size_type p = m_size >> c_page_shift;
+        if (p == m_pages.size())
+        {
+            m_pages.emplace_back();
+            if (p > 0)
+                m_pages.back().reserve(c_page_size);
+        }
+        return m_pages[p];
+    }
+
+};          // class pagedvector
+
+}           // namespace seq66
+
+#endif      // SEQ66_PAGEDVECTOR_HPP
+
+/*
+ * pagedvector.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
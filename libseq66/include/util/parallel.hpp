@@ -0,0 +1,72 @@
+#if ! defined SEQ66_PARALLEL_HPP
+#define SEQ66_PARALLEL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          parallel.hpp
+ *
+ *  This module declares a helper to spread a batch of independent jobs
+ *  over a few short-lived threads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  This is for work done off the output thread, such as reading the tracks
+ *  of a file or fixing the patterns of a batch, where the jobs take long
+ *  enough to be worth a thread.  The playback of patterns uses the
+ *  persistent seq66::playpool instead.
+ */
+
+#include <cstddef>                      /* std::size_t                      */
+#include <functional>                   /* std::function<>                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+extern std::size_t parallel_cores ();
+extern void parallel_for
+(
+    std::size_t count,
+    const std::function<void (std::size_t)> & job,
+    std::size_t workers
+);
+extern void parallel_for
+(
+    std::size_t count,
+    const std::function<void (std::size_t)> & job
+);
+
+}               // namespace seq66
+
+#endif          // SEQ66_PARALLEL_HPP
+
+/*
+ * parallel.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
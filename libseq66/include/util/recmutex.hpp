@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-01-16
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This recursive mutex is implemented in pthreads due to difficulties we had
@@ -137,10 +137,7 @@ public:
 
     void lock () const;
     void unlock () const;
-
-    /*
-     * bool try_lock () noexcept;
-     */
+    bool try_lock () const;
 
     native & native_locker () const
     {
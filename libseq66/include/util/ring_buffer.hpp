@@ -28,17 +28,21 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-09-19
- * \updates       2022-10-31
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  */
 
+#include <atomic>                       /* std::atomic<std::size_t>         */
 #include <cstddef>
 #include <sys/types.h>
+#include <utility>                      /* std::move()                      */
 #include <vector>
 
 #include "seq66_features.h"             /* SEQ66_PLATFORM_DEBUG macro       */
 
-#undef  SEQ66_USE_MEMORY_LOCK           /* TODO: needs a lot of work !      */
+#if defined SEQ66_PLATFORM_UNIX
+#define SEQ66_USE_MEMORY_LOCK           /* mlock() the element storage      */
+#endif
 
 #if defined SEQ66_USE_MEMORY_LOCK
 #include <sys/mman.h>
@@ -47,6 +51,34 @@
 namespace seq66
 {
 
+/**
+ *  The size of a cache line on the common processors.  Used to keep the
+ *  producer's and the consumer's indices from sharing one.
+ */
+
+const std::size_t c_cache_line_size = 64;
+
+/**
+ *  A single-producer/single-consumer FIFO of objects.  One thread (e.g. the
+ *  output thread calling midi_jack::send_message()) calls only the
+ *  producer functions: write(), push_back(), push(), write_space(), and
+ *  back().  One other thread (e.g. the JACK process callback) calls only the
+ *  consumer functions: read(), pop(), front(), pop_front(), and
+ *  read_space().  Under that rule no lock is needed.
+ *
+ *  The head and tail are free-running counters, masked only when used as
+ *  indices, so that a full buffer and an empty buffer are distinguishable
+ *  without a shared element counter.  Each index is written by only one
+ *  side, and is published with a release store and read with an acquire
+ *  load, so that the element written before an index update is visible
+ *  once the other side sees the update.
+ *
+ *  When the buffer is full, the new item is refused and counted as dropped.
+ *  The producer cannot discard the front item without racing the consumer.
+ *  The dropped count and the high-water mark are written by the producer
+ *  only, but are atomic so that any thread can read them for statistics.
+ */
+
 template <typename TYPE>
 class ring_buffer
 {
@@ -58,22 +90,27 @@ public:
     using const_reference = const TYPE &;
     using size_type = std::size_t;
     using container = std::vector<value_type>;
+    using index = std::atomic<size_type>;
 
 private:
 
     container m_buffer;         /**< Container for all push/popped items.   */
     size_type m_buffer_size;    /**< Constant power-of-two container size.  */
-    size_type m_contents_size;  /**< Number of active entries in container. */
-    volatile size_type m_tail;  /**< Index where next item is written.      */
-    volatile size_type m_head;  /**< Index where next item is read.         */
     size_type m_size_mask;      /**< Restricts index to < buffer size.      */
-    bool m_locked;              /**< Is memory locked? NOT YET SUPPORTED.   */
-    size_type m_contents_max;   /**< Useful in trouble-shooting.            */
-    int m_dropped;              /**< Number of items overwritten in run.    */
+    bool m_locked;              /**< Is the element storage mlock()ed?      */
+    char m_pad_0[c_cache_line_size];
+    index m_tail;               /**< Count of items written (producer).     */
+    char m_pad_1[c_cache_line_size - sizeof(index)];
+    index m_head;               /**< Count of items read (consumer).        */
+    char m_pad_2[c_cache_line_size - sizeof(index)];
+    index m_contents_max;       /**< Useful in trouble-shooting (producer). */
+    std::atomic<int> m_dropped; /**< Number of items refused (producer).    */
 
 public:
 
     explicit ring_buffer (size_type sz);
+    ring_buffer (const ring_buffer &) = delete;
+    ring_buffer & operator = (const ring_buffer &) = delete;
     ~ring_buffer ();
 
     bool mlock ();
@@ -85,12 +122,14 @@ public:
 
     void reset ()
     {
-        m_head = m_tail = 0;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
     }
 
     void clear ()
     {
-        m_dropped = m_contents_size = 0;
+        m_dropped.store(0, std::memory_order_relaxed);
+        m_contents_max.store(0, std::memory_order_relaxed);
         reset();
         initialize();
     }
@@ -100,14 +139,23 @@ public:
         return int(m_buffer_size);
     }
 
+    /**
+     *  The number of items stored.  Exact for either side while the other
+     *  side is idle; otherwise a snapshot.
+     */
+
     int count () const
     {
-        return int(m_contents_size);
+        return int
+        (
+            m_tail.load(std::memory_order_acquire) -
+            m_head.load(std::memory_order_acquire)
+        );
     }
 
     int count_max () const
     {
-        return int(m_contents_max);
+        return int(m_contents_max.load(std::memory_order_relaxed));
     }
 
     bool empty () const
@@ -117,7 +165,7 @@ public:
 
     int dropped () const
     {
-        return m_dropped;
+        return m_dropped.load(std::memory_order_relaxed);
     }
 
     void write_advance ();
@@ -127,11 +175,15 @@ public:
     size_type read (reference dest);
     size_type write (const_reference src);
     bool push_back (const value_type & value);
+    bool push_back (value_type && value);
+    bool pop_front (reference dest);
+    size_type push (const value_type * src, size_type count);
+    size_type pop (value_type * dest, size_type count);
 
     void pop_front ()
     {
-        if (m_contents_size > 0)
-            increment_head();
+        if (read_space() > 0)
+            read_advance();
     }
 
     /*
@@ -144,12 +196,12 @@ public:
 
     reference front ()
     {
-        return m_buffer[m_head];
+        return m_buffer[head_index()];
     }
 
     const_reference front () const
     {
-        return m_buffer[m_head];
+        return m_buffer[head_index()];
     }
 
     /**
@@ -170,12 +222,30 @@ public:
 private:    // helper functions
 
     void initialize ();
-    void increment_head ();
-    void increment_tail ();
 
-    size_t previous_tail ()
+    size_type head_index () const
+    {
+        return m_head.load(std::memory_order_relaxed) & m_size_mask;
+    }
+
+    size_type tail_index () const
+    {
+        return m_tail.load(std::memory_order_relaxed) & m_size_mask;
+    }
+
+    size_type previous_tail () const
     {
-        return m_tail > 0 ? m_tail - 1 : m_buffer_size -1  ;
+        return (m_tail.load(std::memory_order_relaxed) - 1) & m_size_mask;
+    }
+
+    void publish_tail (size_type n)
+    {
+        size_type t = m_tail.load(std::memory_order_relaxed) + n;
+        m_tail.store(t, std::memory_order_release);
+
+        size_type c = t - m_head.load(std::memory_order_acquire);
+        if (c > m_contents_max.load(std::memory_order_relaxed))
+            m_contents_max.store(c, std::memory_order_relaxed);
     }
 
 };          // class ring_buffer<TYPE>
@@ -189,11 +259,13 @@ template<typename TYPE>
 ring_buffer<TYPE>::ring_buffer (size_type sz) :
     m_buffer        (),
     m_buffer_size   (0),
-    m_contents_size (0),
-    m_tail          (0),
-    m_head          (0),                    /* supports empty buffer case   */
     m_size_mask     (0),
     m_locked        (false),
+    m_pad_0         (),
+    m_tail          (0),
+    m_pad_1         (),
+    m_head          (0),                    /* supports empty buffer case   */
+    m_pad_2         (),
     m_contents_max  (0),
     m_dropped       (0)
 {
@@ -208,11 +280,8 @@ ring_buffer<TYPE>::ring_buffer (size_type sz) :
 }
 
 /**
- *  Free all data associated with the ringbuffer `m_rb'.
- *
- *  Note that we will have some work to do (like writing an allocator that
- *  uses an unswappable block of memory for the vector data) if we define this
- *  macro.
+ *  Free all data associated with the ringbuffer, unlocking the element
+ *  storage first if it was locked.
  */
 
 template<typename TYPE>
@@ -220,50 +289,42 @@ ring_buffer<TYPE>::~ring_buffer ()
 {
 #if defined SEQ66_USE_MEMORY_LOCK
     if (m_locked)
-        ::munlock(m_buffer, m_buffer_size);
+        (void) ::munlock(m_buffer.data(), m_buffer_size * sizeof(TYPE));
 #endif
 }
 
+/**
+ *  Fills the container with default values.  Since the container is
+ *  reallocated, any memory lock is lost and must be reapplied.
+ */
+
 template<typename TYPE>
 void
 ring_buffer<TYPE>::initialize ()
 {
     TYPE empty_value;
+#if defined SEQ66_USE_MEMORY_LOCK
+    if (m_locked)
+    {
+        (void) ::munlock(m_buffer.data(), m_buffer_size * sizeof(TYPE));
+        m_locked = false;
+    }
+#endif
     m_buffer.clear();
+    m_buffer.shrink_to_fit();
     m_buffer.reserve(m_buffer_size);
     for (size_t i = 0; i < m_buffer_size; ++i)
         (void) m_buffer.push_back(empty_value); /* prepare buffer for usage */
 }
 
-template<typename TYPE>
-void
-ring_buffer<TYPE>::increment_head ()
-{
-    if (m_contents_size > 0)
-    {
-        ++m_head;
-        --m_contents_size;
-        if (m_head == m_buffer_size)
-            m_head = 0;                                 /* wrap around  */
-    }
-}
-
-template<typename TYPE>
-void
-ring_buffer<TYPE>::increment_tail ()
-{
-    ++m_tail;
-    ++m_contents_size;
-    if (m_contents_size > m_contents_max)               /* for checking */
-        m_contents_max = m_contents_size;
-
-    if (m_tail == m_buffer_size)
-        m_tail = 0;                                     /* wrap around  */
-}
-
 /**
- *  Lock the data block of `rb' using the system call 'mlock'.
- *  Not nearly ready for prime time!
+ *  Locks the element storage into RAM with the mlock() system call, so that
+ *  the real-time side never page-faults on it.  Note that only the objects
+ *  themselves are locked, not any heap memory they own.  This can fail for
+ *  lack of privilege (see RLIMIT_MEMLOCK), which is harmless.
+ *
+ * \return
+ *      Returns true if the memory is now locked.
  */
 
 template<typename TYPE>
@@ -271,41 +332,41 @@ bool
 ring_buffer<TYPE>::mlock ()
 {
 #if defined SEQ66_USE_MEMORY_LOCK
-    if (::mlock(m_buffer, m_buffer_size) != 0)
-        return false;
-
-    m_locked = true;
-    return true;
+    if (! m_locked)
+    {
+        void * b = m_buffer.data();
+        m_locked = ::mlock(b, m_buffer_size * sizeof(TYPE)) == 0;
+    }
+    return m_locked;
 #else
     return false;
 #endif
 }
 
 /**
- *  Return the number of elements available for writing.  This is the number
- *  of elements in front of the write/tail pointer and behind the read/head
- *  pointer.
+ *  Return the number of elements available for writing.  Called by the
+ *  producer.
  */
 
 template<typename TYPE>
 std::size_t
 ring_buffer<TYPE>::write_space () const
 {
-    size_type t = m_tail;                           /* index for writing    */
-    size_type h = m_head;                           /* index for reading    */
-    if (t > h)
-        return ((h - t + m_buffer_size) & m_size_mask) - 1;
-    else if (t < h)
-        return (h - t) - 1;
-    else
-        return m_buffer_size - m_contents_size;
+    size_type t = m_tail.load(std::memory_order_relaxed);
+    size_type h = m_head.load(std::memory_order_acquire);
+    return m_buffer_size - (t - h);
 }
 
+/**
+ *  Makes the item at back()... er, the tail, available to the consumer.
+ *  The caller must have checked write_space().
+ */
+
 template<typename TYPE>
 void
 ring_buffer<TYPE>::write_advance ()
 {
-    increment_tail();
+    publish_tail(1);
 }
 
 /**
@@ -319,46 +380,37 @@ std::size_t
 ring_buffer<TYPE>::write (const_reference src)
 {
     size_type result = 0;
-    size_type write_cnt = write_space();
-    if (write_cnt > 0)
-    {
-        (void) push_back(src);
-        result = m_contents_size;
-    }
+    if (push_back(src))
+        result = size_type(count());
+
     return result;
 }
 
 /**
- *  Return the number of elements (TYPE) available for reading.  This is the
- *  number of elements in front of the read pointer and behind the write
- *  pointer.
+ *  Return the number of elements (TYPE) available for reading.  Called by
+ *  the consumer.
  */
 
 template<typename TYPE>
 std::size_t
 ring_buffer<TYPE>::read_space () const
 {
-    if (count() > 0)
-    {
-        size_type t = m_tail;                       /* index for writing    */
-        size_type h = m_head;                       /* index for reading    */
-        if (t > h)
-            return t - h;
-        else if (t == h)
-            return m_contents_size;
-        else
-            return (t - h + m_buffer_size) & m_size_mask;
-    }
-    else
-        return 0;
+    size_type h = m_head.load(std::memory_order_relaxed);
+    size_type t = m_tail.load(std::memory_order_acquire);
+    return t - h;
 }
 
+/**
+ *  Releases the front() item back to the producer.  The caller must have
+ *  checked read_space().
+ */
+
 template<typename TYPE>
 void
 ring_buffer<TYPE>::read_advance ()
 {
-    ++m_head;
-    m_head &= m_size_mask;
+    size_type h = m_head.load(std::memory_order_relaxed) + 1;
+    m_head.store(h, std::memory_order_release);
 }
 
 /**
@@ -378,41 +430,146 @@ ring_buffer<TYPE>::read (reference dest)
     size_type read_cnt = read_space();
     if (read_cnt > 0)
     {
-        dest = m_buffer[m_head];
-        pop_front();
-        result = m_contents_size;
+        dest = m_buffer[head_index()];
+        read_advance();
+        result = read_cnt - 1;
     }
     return result;
 }
 
 /**
- *  Increment the tail, then increment the head. This function supports the
- *  special case of an empty buffer.
+ *  Copies the item to the tail and publishes it.  If the buffer is full,
+ *  the item is refused and counted.
+ *
+ * \return
+ *      Returns true if the item was stored.
  */
 
 template<typename TYPE>
 bool
 ring_buffer<TYPE>::push_back (const value_type & item)
 {
-    if (m_contents_size == 0)
+    bool result = write_space() > 0;
+    if (result)
     {
-        m_tail = m_head;
-        m_buffer[m_tail] = item;
-        increment_tail();
+        m_buffer[tail_index()] = item;
+        publish_tail(1);
     }
-    else if (m_contents_size < m_buffer_size)
+    else
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+    return result;
+}
+
+/**
+ *  Moves the item to the tail, for an item the caller is done with, so that
+ *  any heap storage it has is handed over instead of copied.
+ *
+ * \return
+ *      Returns true if the item was stored.
+ */
+
+template<typename TYPE>
+bool
+ring_buffer<TYPE>::push_back (value_type && item)
+{
+    bool result = write_space() > 0;
+    if (result)
     {
-        m_buffer[m_tail] = item;
-        increment_tail();
+        m_buffer[tail_index()] = std::move(item);
+        publish_tail(1);
     }
-    else                                    /* accept item and drop front() */
+    else
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+    return result;
+}
+
+/**
+ *  Moves the front item out, and removes it.  Called by the consumer.  The
+ *  emptied slot is refilled by assignment when the producer gets to it.
+ *
+ * \param [out] dest
+ *      The destination of the item.
+ *
+ * \return
+ *      Returns true if there was an item.
+ */
+
+template<typename TYPE>
+bool
+ring_buffer<TYPE>::pop_front (reference dest)
+{
+    bool result = read_space() > 0;
+    if (result)
     {
-        increment_head();
-        m_buffer[m_tail] = item;
-        increment_tail();
-        ++m_dropped;                        /* for future use in expansion  */
+        dest = std::move(m_buffer[head_index()]);
+        read_advance();
     }
-    return true;
+    return result;
+}
+
+/**
+ *  The batch version of push_back().  All of the items that fit are copied,
+ *  then published with a single index update.
+ *
+ * \param src
+ *      The array of items to store.
+ *
+ * \param count
+ *      The number of items in the array.
+ *
+ * \return
+ *      Returns the number of items stored.  The rest are counted as dropped.
+ */
+
+template<typename TYPE>
+std::size_t
+ring_buffer<TYPE>::push (const value_type * src, size_type count)
+{
+    size_type space = write_space();
+    size_type n = count < space ? count : space ;
+    size_type t = m_tail.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < n; ++i)
+        m_buffer[(t + i) & m_size_mask] = src[i];
+
+    if (n > 0)
+        publish_tail(n);
+
+    if (n < count)
+        m_dropped.fetch_add(int(count - n), std::memory_order_relaxed);
+
+    return n;
+}
+
+/**
+ *  The batch version of read().  Copies up to count items, then releases
+ *  them to the producer with a single index update.
+ *
+ * \param dest
+ *      The array to fill.
+ *
+ * \param count
+ *      The capacity of the array.
+ *
+ * \return
+ *      Returns the number of items copied.
+ */
+
+template<typename TYPE>
+std::size_t
+ring_buffer<TYPE>::pop (value_type * dest, size_type count)
+{
+    size_type space = read_space();
+    size_type n = count < space ? count : space ;
+    size_type h = m_head.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < n; ++i)
+        dest[i] = m_buffer[(h + i) & m_size_mask];
+
+    if (n > 0)
+        m_head.store(h + n, std::memory_order_release);
+
+    return n;
 }
 
 /*
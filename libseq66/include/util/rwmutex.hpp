@@ -0,0 +1,183 @@
+#if ! defined SEQ66_RWMUTEX_HPP
+#define SEQ66_RWMUTEX_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          rwmutex.hpp
+ *
+ *  This module declares a reader/writer mutex that is recursive for the
+ *  writer, and its lock guards.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The sequence mutex used to be a recmutex, so that every reader of a
+ *  pattern (the output thread, each pattern editor, the live-grid
+ *  thumbnails) shut out all of the others, even though none of them
+ *  changes the events.  The rwmutex lets any number of readers in at once,
+ *  and shuts them out only while a writer holds it.
+ *
+ *  The writer lock is recursive, as the sequence functions that change the
+ *  events call each other freely.  A thread that holds the writer lock can
+ *  also take the reader lock, which then just counts as one more level of
+ *  the writer lock.  But a thread that holds only the reader lock must not
+ *  ask for the writer lock, or it waits on itself forever.  Only functions
+ *  that never change the object, and call nothing that does, take the
+ *  reader lock, and they should not nest reader locks either, as some
+ *  implementations of std::shared_timed_mutex favor a waiting writer.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <shared_mutex>                 /* std::shared_timed_mutex          */
+#include <thread>                       /* std::thread::id                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A reader/writer mutex, recursive for the writer.
+ */
+
+class rwmutex
+{
+
+private:
+
+    /**
+     *  The lock itself.  C++14 provides only the timed flavor.
+     */
+
+    mutable std::shared_timed_mutex m_lock;
+
+    /**
+     *  The thread holding the writer lock, if any.  Only that thread ever
+     *  sets it to its own ID, so a thread comparing it to its own ID gets a
+     *  reliable answer without holding anything.
+     */
+
+    mutable std::atomic<std::thread::id> m_owner;
+
+    /**
+     *  The levels of the writer lock held by the owner.  Touched only by
+     *  the owner.
+     */
+
+    mutable int m_depth;
+
+public:
+
+    rwmutex ();
+    rwmutex (const rwmutex &);                          /* a new mutex      */
+    rwmutex & operator = (const rwmutex &);             /* keeps its own    */
+    ~rwmutex () = default;
+
+    void lock () const;
+    void unlock () const;
+    bool try_lock () const;
+    void lock_shared () const;
+    void unlock_shared () const;
+
+private:
+
+    bool owned () const
+    {
+        return m_owner.load(std::memory_order_relaxed) ==
+            std::this_thread::get_id();
+    }
+
+};          // class rwmutex
+
+/**
+ *  Takes the writer lock of an rwmutex for the scope, like automutex does
+ *  for a recmutex.
+ */
+
+class writelock
+{
+
+private:
+
+    const rwmutex & m_safety_mutex;
+
+public:
+
+    writelock () = delete;
+    writelock (const writelock &) = delete;
+    writelock & operator = (const writelock &) = delete;
+
+    writelock (const rwmutex & my_mutex) : m_safety_mutex (my_mutex)
+    {
+        m_safety_mutex.lock();
+    }
+
+    ~writelock ()
+    {
+        m_safety_mutex.unlock();
+    }
+
+};          // class writelock
+
+/**
+ *  Takes the reader lock of an rwmutex for the scope.  See the rules in the
+ *  banner of this module.
+ */
+
+class readlock
+{
+
+private:
+
+    const rwmutex & m_safety_mutex;
+
+public:
+
+    readlock () = delete;
+    readlock (const readlock &) = delete;
+    readlock & operator = (const readlock &) = delete;
+
+    readlock (const rwmutex & my_mutex) : m_safety_mutex (my_mutex)
+    {
+        m_safety_mutex.lock_shared();
+    }
+
+    ~readlock ()
+    {
+        m_safety_mutex.unlock_shared();
+    }
+
+};          // class readlock
+
+}           // namespace seq66
+
+#endif      // SEQ66_RWMUTEX_HPP
+
+/*
+ * rwmutex.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -43,6 +43,13 @@ contains (CONFIG, rtmidi) {
    DEFINES += "SEQ66_PORTMIDI_SUPPORT=1"
 }
 
+# "qmake CONFIG+=lean" leaves the GUI-only code out, for a headless seq66cli
+# only; see ./configure --enable-lean.
+
+contains (CONFIG, lean) {
+   DEFINES += "SEQ66_LEAN_ENGINE=1"
+}
+
 HEADERS += include/seq66_features.h \
  include/seq66_features.hpp \
  include/seq66_platform_macros.h \
@@ -50,6 +57,7 @@ HEADERS += include/seq66_features.h \
  include/cfg/cmdlineopts.hpp \
  include/cfg/comments.hpp \
  include/cfg/configfile.hpp \
+ include/cfg/hotsettings.hpp \
  include/cfg/midicontrolfile.hpp \
  include/cfg/mutegroupsfile.hpp \
  include/cfg/notemapfile.hpp \
@@ -79,6 +87,8 @@ HEADERS += include/seq66_features.h \
  include/ctrl/midioperation.hpp \
  include/ctrl/opcontainer.hpp \
  include/ctrl/opcontrol.hpp \
+ include/ctrl/padmap.hpp \
+ include/midi/batchconvert.hpp \
  include/midi/businfo.hpp \
  include/midi/calculations.hpp \
  include/midi/controllers.hpp \
@@ -86,46 +96,90 @@ HEADERS += include/seq66_features.h \
  include/midi/editable_events.hpp \
  include/midi/event.hpp \
  include/midi/eventlist.hpp \
+ include/midi/filebench.hpp \
+ include/midi/guibench.hpp \
+ include/midi/inputfilter.hpp \
  include/midi/jack_assistant.hpp \
  include/midi/mastermidibase.hpp \
  include/midi/midibase.hpp \
  include/midi/midibytes.hpp \
  include/midi/midifile.hpp \
+ include/midi/midijournal.hpp \
  include/midi/midi_splitter.hpp \
  include/midi/midi_vector_base.hpp \
  include/midi/midi_vector.hpp \
+ include/midi/modlane.hpp \
+ include/midi/notespans.hpp \
+ include/midi/outputfilter.hpp \
+ include/midi/playevents.hpp \
+ include/midi/recordroutes.hpp \
+ include/midi/sysexstream.hpp \
+ include/midi/tempomap.hpp \
  include/midi/wrkfile.hpp \
+ include/play/blockengine.hpp \
+ include/play/boundarywheel.hpp \
+ include/play/bulkops.hpp \
+ include/play/clockfollower.hpp \
  include/play/clockslist.hpp \
+ include/play/editjob.hpp \
+ include/play/eventsummary.hpp \
+ include/play/framebatch.hpp \
+ include/play/frameclock.hpp \
+ include/play/inputcapture.hpp \
+ include/play/inputmonitor.hpp \
  include/play/inputslist.hpp \
+ include/play/latencyprobe.hpp \
+ include/play/linksync.hpp \
+ include/play/memoryusage.hpp \
  include/play/metro.hpp \
+ include/play/mirrorwatch.hpp \
  include/play/mutegroup.hpp \
  include/play/mutegroups.hpp \
  include/play/notemapper.hpp \
+ include/play/notifyqueue.hpp \
+ include/play/outputstats.hpp \
+ include/play/padlauncher.hpp \
  include/play/performer.hpp \
+ include/play/playbench.hpp \
  include/play/playlist.hpp \
+ include/play/playpool.hpp \
  include/play/portslist.hpp \
+ include/play/replaybench.hpp \
  include/play/screenset.hpp \
  include/play/seq.hpp \
  include/play/sequence.hpp \
+ include/play/sessionlog.hpp \
  include/play/setmapper.hpp \
  include/play/setmaster.hpp \
  include/play/songsummary.hpp \
+ include/play/songrender.hpp \
+ include/play/songtimeline.hpp \
+ include/play/statemirror.hpp \
  include/play/triggers.hpp \
  include/sessions/clinsmanager.hpp \
  include/sessions/smanager.hpp \
  include/os/daemonize.hpp \
+ include/os/mappedfile.hpp \
+ include/os/perftrace.hpp \
+ include/os/rtsafe.hpp \
  include/os/shellexecute.hpp \
+ include/os/startupprofile.hpp \
  include/os/timing.hpp \
  include/util/automutex.hpp \
  include/util/basic_macros.h \
  include/util/basic_macros.hpp \
  include/util/condition.hpp \
+ include/util/cowvector.hpp \
  include/util/filefunctions.hpp \
+ include/util/msglog.hpp \
  include/util/named_bools.hpp \
+ include/util/pagedvector.hpp \
  include/util/palette.hpp \
+ include/util/parallel.hpp \
  include/util/recmutex.hpp \
  include/util/rect.hpp \
  include/util/ring_buffer.hpp \
+ include/util/rwmutex.hpp \
  include/util/strfunctions.hpp
 
 SOURCES += src/seq66_features.cpp \
@@ -133,6 +187,7 @@ SOURCES += src/seq66_features.cpp \
  src/cfg/cmdlineopts.cpp \
  src/cfg/comments.cpp \
  src/cfg/configfile.cpp \
+ src/cfg/hotsettings.cpp \
  src/cfg/midicontrolfile.cpp \
  src/cfg/mutegroupsfile.cpp \
  src/cfg/notemapfile.cpp \
@@ -162,6 +217,8 @@ SOURCES += src/seq66_features.cpp \
  src/ctrl/midioperation.cpp \
  src/ctrl/opcontainer.cpp \
  src/ctrl/opcontrol.cpp \
+ src/ctrl/padmap.cpp \
+ src/midi/batchconvert.cpp \
  src/midi/businfo.cpp \
  src/midi/calculations.cpp \
  src/midi/controllers.cpp \
@@ -169,45 +226,86 @@ SOURCES += src/seq66_features.cpp \
  src/midi/editable_events.cpp \
  src/midi/event.cpp \
  src/midi/eventlist.cpp \
+ src/midi/filebench.cpp \
+ src/midi/guibench.cpp \
+ src/midi/inputfilter.cpp \
  src/midi/jack_assistant.cpp \
  src/midi/mastermidibase.cpp \
  src/midi/midibase.cpp \
  src/midi/midibytes.cpp \
  src/midi/midifile.cpp \
+ src/midi/midijournal.cpp \
  src/midi/midi_splitter.cpp \
  src/midi/midi_vector_base.cpp \
  src/midi/midi_vector.cpp \
+ src/midi/modlane.cpp \
+ src/midi/notespans.cpp \
+ src/midi/outputfilter.cpp \
+ src/midi/recordroutes.cpp \
+ src/midi/sysexstream.cpp \
+ src/midi/tempomap.cpp \
  src/midi/wrkfile.cpp \
+ src/play/blockengine.cpp \
+ src/play/boundarywheel.cpp \
+ src/play/bulkops.cpp \
+ src/play/clockfollower.cpp \
  src/play/clockslist.cpp \
+ src/play/editjob.cpp \
+ src/play/eventsummary.cpp \
+ src/play/framebatch.cpp \
+ src/play/frameclock.cpp \
+ src/play/inputcapture.cpp \
+ src/play/inputmonitor.cpp \
  src/play/inputslist.cpp \
+ src/play/latencyprobe.cpp \
+ src/play/linksync.cpp \
+ src/play/memoryusage.cpp \
  src/play/metro.cpp \
+ src/play/mirrorwatch.cpp \
  src/play/mutegroup.cpp \
  src/play/mutegroups.cpp \
  src/play/notemapper.cpp \
+ src/play/notifyqueue.cpp \
+ src/play/outputstats.cpp \
+ src/play/padlauncher.cpp \
  src/play/performer.cpp \
+ src/play/playbench.cpp \
  src/play/playlist.cpp \
+ src/play/playpool.cpp \
  src/play/portslist.cpp \
+ src/play/replaybench.cpp \
  src/play/screenset.cpp \
  src/play/seq.cpp \
  src/play/sequence.cpp \
+ src/play/sessionlog.cpp \
  src/play/setmapper.cpp \
  src/play/setmaster.cpp \
  src/play/songsummary.cpp \
+ src/play/songrender.cpp \
+ src/play/songtimeline.cpp \
+ src/play/statemirror.cpp \
  src/play/triggers.cpp \
  src/sessions/clinsmanager.cpp \
  src/sessions/smanager.cpp \
  src/os/daemonize.cpp \
+ src/os/mappedfile.cpp \
+ src/os/perftrace.cpp \
+ src/os/rtsafe.cpp \
  src/os/shellexecute.cpp \
+ src/os/startupprofile.cpp \
  src/os/timing.cpp \
  src/util/automutex.cpp \
  src/util/basic_macros.cpp \
  src/util/condition.cpp \
  src/util/filefunctions.cpp \
+ src/util/msglog.cpp \
  src/util/named_bools.cpp \
  src/util/palette.cpp \
+ src/util/parallel.cpp \
  src/util/recmutex.cpp \
  src/util/rect.cpp \
  src/util/ring_buffer.cpp \
+ src/util/rwmutex.cpp \
  src/util/strfunctions.cpp
 
 INCLUDEPATH = \
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2024-08-08
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The "rc" command-line options override setting that are first read from
@@ -53,6 +53,9 @@
 #include "cfg/rcfile.hpp"               /* seq66::rcfile class              */
 #include "cfg/settings.hpp"             /* seq66::rc() and usr() access     */
 #include "cfg/usrfile.hpp"              /* seq66::usrfile class             */
+#include "midi/guibench.hpp"            /* seq66::gui_bench()               */
+#include "os/perftrace.hpp"             /* seq66::perftrace()               */
+#include "os/startupprofile.hpp"        /* seq66::startup_profile()         */
 #include "util/basic_macros.hpp"        /* not_nullptr() and other macros   */
 #include "util/filefunctions.hpp"       /* file_read_writable(), etc.       */
 #include "util/strfunctions.hpp"        /* string-to-numbers functions      */
@@ -74,6 +77,12 @@ static const int c_null_option = 99999;
 static const int c_missing_arg = ':';       /* only if ':' starts optstring */
 static const int c_bad_option  = '?';
 
+/**
+ *  The clicks of a latency test, if not given.
+ */
+
+static const int c_latency_test_clicks = 100;
+
 /**
  *  Sets up the "hardwired" version text for Seq66.  This value
  *  ultimately comes from the configure.ac script, and available in the
@@ -149,6 +158,10 @@ cmdlineopts::s_long_options [] =
     {"reveal-ports",        no_argument,       0, 'r'},
     {"hide-ports",          no_argument,       0, 'R'},
     {"alsa",                no_argument,       0, 'A'},
+    {"null-midi",           optional_argument, 0, 'Y'},
+    {"startup-profile",     optional_argument, 0, 'E'},
+    {"trace",               optional_argument, 0, 'G'},
+    {"gui-bench",           optional_argument, 0, 'Q'},
     {"pass-sysex",          no_argument,       0, 'P'},
     {"user-save",           no_argument,       0, 'u'},
     {"record-by-channel",   no_argument,       0, 'd'},
@@ -191,7 +204,7 @@ cmdlineopts::s_long_options [] =
  *
 \verbatim
         0123456789#@AaBbCcDdEeFfGgHhIiJjKkLlMmNnOoPpQqRrSsTtUuVvWwXxYyZz
-        xx       xx xx::x:xx  :: x:x xxxxx::xxxx *x: :xx:xxxx:xxxx::  aa
+        xx       xx xx::x:xx: :: x:x xxxxx::xxxx *x:::xx:xxxx:xxxx::: aa
 \endverbatim
  *
  *  The I (inspect) options has been replaced by the S (session) option
@@ -218,10 +231,11 @@ cmdlineopts::s_long_options [] =
 
 #if defined SEQ66_JACK_SUPPORT      // how to handle no SEQ66_NSM_SUPPORT (n)?
 #define CMD_OPTS \
-    "01#AaB:b:Cc:DdF:f:gH:hiJjKkL:l:M:mNnoPp::q:RrS:sTtU:uVvWwX:x:Zz"
+    "01#AaB:b:Cc:DdE::F:f:G::gH:hiJjKkL:l:M:mNnoPp::Q::q:RrS:sTtU:uVvWw" \
+    "X:x:Y::Zz"
 #else
 #define CMD_OPTS \
-    "0#AaB:b:c:DdF:f:H:hI:iKkL:l:M:mnoPpq:RrS:sTuVvX:x:Zz#"
+    "0#AaB:b:c:DdE::F:f:G::H:hI:iKkL:l:M:mnoPpQ::q:RrS:sTuVvX:x:Y::Zz#"
 #endif
 
 const std::string cmdlineopts::s_optstring = CMD_OPTS;
@@ -269,6 +283,8 @@ static const std::string s_help_1b =
 "   -R, --hide-ports        Show 'usr' definitions for port names.\n"
 #if ! defined SEQ66_PLATFORM_WINDOWS
 "   -A, --alsa              Use ALSA, not JACK. A sticky option.\n"
+"   -Y, --null-midi[=loop]  Use no MIDI devices; output is discarded or, with\n"
+"                           'loop', fed back to input. For profiling.\n"
 #endif
 "   -b, --bus b             Global override of bus number (for testing).\n"
 "   -B, --buss b            Covers the bus/buss confusion.\n"
@@ -280,6 +296,16 @@ static const std::string s_help_1b =
 "   -P, --pass-sysex        Passes incoming SysEx messages to all outputs.\n"
 "                           Not yet fully implemented.\n"
 "   -s, --show-midi         Dump incoming MIDI events to the console.\n"
+"   -E, --startup-profile[=file]\n"
+"                           Show the time taken by each phase of start-up;\n"
+"                           with a file, also write it as a Chrome trace.\n"
+"   -G, --trace[=file]      Trace the engine, writing a Chrome trace when the\n"
+"                           session is saved or closed.  The default file is\n"
+"                           seq66-trace.json in the configuration directory.\n"
+"   -Q, --gui-bench[=spec]  Open a large generated song, then scroll, zoom,\n"
+"                           and play it, and print the frame times of each\n"
+"                           window. The spec, default shown, is a list:\n"
+"                           patterns=128,events=512,triggers=32,seconds=20\n"
 ;
 
 /*
@@ -354,12 +380,22 @@ static const std::string s_help_4b =
 "      mutes=value   Saving of mute-groups: 'mutes', 'midi', or 'both'.\n"
 "      virtual=o,i   Like --manual-ports, except that the count of output and\n"
 "                    input ports are specified. Defaults are 8 & 4.\n"
+"      session-log=filename\n"
+"                    Logs the MIDI input, keystrokes, pattern toggles, and\n"
+"                    transport actions, by tick, to a file that can be\n"
+"                    replayed by 'seq66cli --replay'. Not saved.\n"
 "\n"
 " seq66cli:\n\n"
 "      daemonize     Sets this application up to fork to the background.\n"
 "      no-daemonize  Or not. These options do not apply to Windows. If given,\n"
 "                    the application writes these options to the 'usr' file\n"
 "                    and exits. Subsequent runs are thus affected. Tricky!\n"
+"      latency-test=o,i[,n]\n"
+"                    Sends n clicks (default 100), four a second, out output\n"
+"                    buss o, times their return on input buss i (via a loop-\n"
+"                    back cable or connection), reports the round trips and\n"
+"                    their jitter, with the MIDI engine and scheduler, and\n"
+"                    exits.\n"
 "\n"
 "Add '--user-save' to make these options permanent.\n"
 "\n"
@@ -620,6 +656,17 @@ cmdlineopts::parse_o_options (int argc, char * argv [])
                             {
                                 result = parse_o_virtual(arg);
                             }
+                            else if (optionname == "latency-test")
+                            {
+                                result = parse_o_latency_test(arg);
+                            }
+                            else if (optionname == "session-log")
+                            {
+                                arg = strip_quotes(arg);
+                                result = ! arg.empty();
+                                if (result)
+                                    rc().session_log(arg);
+                            }
                         }
                         if (! result)
                         {
@@ -927,6 +974,34 @@ cmdlineopts::parse_o_virtual (const std::string & arg)
     return true;
 }
 
+/**
+ *  Sets up a latency test, "o,i[,n]": the output and input busses of the
+ *  clicks, and the number of them.  See performer::probe_latency().
+ *
+ * \return
+ *      Returns false if the busses are missing or bad.
+ */
+
+bool
+cmdlineopts::parse_o_latency_test (const std::string & arg)
+{
+    bool result = false;
+    tokenization values = tokenize(arg, ",");
+    if (values.size() == 2 || values.size() == 3)
+    {
+        int out = string_to_int(values[0], -1);
+        int in = string_to_int(values[1], -1);
+        int clicks = values.size() == 3 ?
+            string_to_int(values[2], 0) : c_latency_test_clicks ;
+
+        rc().latency_probe(out, in);
+        result = rc().latency_probe() && clicks > 0;
+        if (result)
+            rc().latency_test_clicks(clicks);
+    }
+    return result;
+}
+
 /**
  *  Parses the command-line options on behalf of the application.  Note that,
  *  since we call this function twice (once before the configuration files are
@@ -1022,6 +1097,12 @@ cmdlineopts::parse_command_line_options (int argc, char * argv [])
             rc().manual_ports(false);
             break;
 
+        case 'Y':
+            rc().with_null_midi(true);
+            rc().null_midi_loopback(soptarg == "loop");
+            infoprint("Using the null MIDI API");
+            break;
+
         case 'B':                           /* --buss for the oldsters      */
         case 'b':                           /* --bus for the youngsters     */
             usr().midi_buss_override(string_to_midibyte(soptarg));
@@ -1214,6 +1295,21 @@ cmdlineopts::parse_command_line_options (int argc, char * argv [])
             rc().verbose(true);
             break;
 
+        case 'E':
+            startup_profile(true, soptarg);
+            break;
+
+        case 'G':
+            perftrace(true, soptarg);
+            break;
+
+        case 'Q':
+            if (! gui_bench().parse(soptarg))
+                result = c_null_option;
+            else
+                perftrace(true);
+            break;
+
 #if defined SEQ66_JACK_SUPPORT
 
         case 'W':
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2025-01-19
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  std::streamoff is a signed integral type (usually long long) that can
@@ -48,7 +48,9 @@
  */
 
 #include <cctype>                       /* std::isspace(), std::isdigit()   */
+#include <cstdio>                       /* std::rename()                    */
 #include <iomanip>                      /* std::hex, std::setw()            */
+#include <sstream>                      /* std::ostringstream               */
 
 #include "cfg/configfile.hpp"           /* seq66:: configfile class         */
 #include "cfg/rcsettings.hpp"           /* seq66::rcsettings class          */
@@ -109,6 +111,8 @@ configfile::configfile
     m_name              (name),
     m_version           ("0"),
     m_file_version      ("0"),
+    m_sections          (),
+    m_indexed_file      (nullptr),
     m_line              (),
     m_line_number       (0),
     m_line_pos          (0)
@@ -696,6 +700,119 @@ configfile::write_comment
         ;
 }
 
+/**
+ *  Reads the whole file once, noting each line that starts a section, so
+ *  that line_after() and find_tag() need not rescan the file from the start
+ *  for every lookup.  The lines are trimmed and stripped of comments as
+ *  get_line() does it, and a last line that has no newline is skipped, as
+ *  the scanning functions skip it.  The stream is left at its start.
+ *
+ * \param file
+ *      The stream just opened for parsing.
+ */
+
+void
+configfile::index_sections (std::ifstream & file)
+{
+    m_sections.clear();
+    m_indexed_file = nullptr;
+    file.clear();
+    file.seekg(0, std::ios::beg);
+
+    std::string text;
+    int linenumber = 0;
+    for (;;)
+    {
+        std::streampos pos = file.tellg();
+        (void) std::getline(file, text);
+        if (! file.good())
+            break;
+
+        ++linenumber;
+        if (text.find('[') == std::string::npos)
+            continue;                           /* cannot be a tag line     */
+
+        text = strip_comments(trim(text));
+        if (! text.empty() && text[0] == '[')
+        {
+            section s;
+            s.s_tag = text;
+            s.s_pos = pos;
+            s.s_next = file.tellg();
+            s.s_line_number = linenumber;
+            m_sections.push_back(s);
+        }
+    }
+    if (! file.bad())
+        m_indexed_file = &file;
+
+    file.clear();
+    file.seekg(0, std::ios::beg);
+}
+
+/**
+ *  Looks up the first indexed section line at or after the given position
+ *  that matches the tag in the manner of line_after().
+ *
+ * \return
+ *      Returns a pointer to the section, or null if there is none.
+ */
+
+const configfile::section *
+configfile::find_section
+(
+    const std::ifstream & file,
+    const std::string & tag,
+    int position
+) const
+{
+    if (file_is_indexed(file, tag))
+    {
+        std::streampos start = std::streampos(position);
+        for (const auto & s : m_sections)
+        {
+            if (s.s_pos >= start && strncompare(s.s_tag, tag))
+                return &s;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ *  The indexed part of line_after() and find_tag().  It leaves the stream and
+ *  the current line as the scan would have left them.  If the tag is not
+ *  there, the stream is put at its end, as after a failed scan.
+ *
+ * \return
+ *      Returns true if the tag was found, and m_line now holds it.
+ */
+
+bool
+configfile::seek_section
+(
+    std::ifstream & file,
+    const std::string & tag,
+    int position
+)
+{
+    const section * s = find_section(file, tag, position);
+    file.clear();
+    if (not_nullptr(s))
+    {
+        file.seekg(s->s_next);
+        m_line = s->s_tag;
+        m_line_pos = s->s_pos;
+        m_line_number = s->s_line_number;
+        return true;
+    }
+    else
+    {
+        file.seekg(0, std::ios::end);
+        (void) get_line(file);                  /* sets EOF, empties m_line */
+        return false;
+    }
+}
+
 /**
  *  Looks for the next named section.  Unlike line_after(), it does not
  *  restart from the beginning of the file.  Like next_data_line(), it starts
@@ -790,6 +907,8 @@ configfile::next_section (std::ifstream & file, const std::string & tag)
  *
  * \return
  *      Returns true if the tag was found.  Otherwise, false is returned.
+ *      If the file has been indexed, the tag is looked up in the index
+ *      instead of being scanned for.
  */
 
 bool
@@ -801,6 +920,15 @@ configfile::line_after
     bool strip
 )
 {
+    if (file_is_indexed(file, tag))
+    {
+        bool result = seek_section(file, tag, position);
+        if (result)
+            result = next_data_line(file, strip);
+
+        return result;
+    }
+
     bool result = false;
     file.clear();                               /* clear the file flags     */
     file.seekg(std::streampos(position), std::ios::beg); /* seek to spot    */
@@ -849,6 +977,9 @@ configfile::line_after
 int
 configfile::find_tag (std::ifstream & file, const std::string & tag)
 {
+    if (file_is_indexed(file, tag))
+        return seek_section(file, tag, 0) ? line_position() : (-1) ;
+
     int result = (-1);
     file.clear();                               /* clear the file flags     */
     file.seekg(0, std::ios::beg);               /* seek to the beginning    */
@@ -913,6 +1044,88 @@ configfile::write_date (std::ofstream & file, const std::string & tag)
         ;
 }
 
+/**
+ *  Reads a configuration file for comparison, leaving out the "# Written"
+ *  line of write_date(), which changes with every write.
+ *
+ * \return
+ *      Returns the contents, or an empty string if the file cannot be read.
+ */
+
+static std::string
+contents_to_compare (const std::string & filename)
+{
+    std::ostringstream result;
+    std::ifstream file(filename, std::ios::in);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.compare(0, 10, "# Written ") != 0)
+            result << line << "\n";
+    }
+    return result.str();
+}
+
+/**
+ *  The name of the file that write() actually opens.  The settings are
+ *  written to this temporary file, which finish_write() then renames to
+ *  name(), so that an interrupted write never leaves a truncated
+ *  configuration file.  An empty name stays empty, so that the open fails.
+ */
+
+std::string
+configfile::write_name () const
+{
+    return name().empty() ? name() : name() + ".tmp" ;
+}
+
+/**
+ *  Closes the file written by write(), and puts it in place.  If it is the
+ *  same as the existing file, except for the date, it is removed instead, so
+ *  that saving settings that did not change does not rewrite the file.  This
+ *  is the common case on exit and on a session save, which write every file
+ *  whose save is enabled.
+ *
+ * \param file
+ *      The stream opened on write_name().
+ *
+ * \param ok
+ *      The outcome of the writing.  If false, the temporary file is removed
+ *      and false is returned.
+ *
+ * \return
+ *      Returns true if the file is now the one written, or was unchanged.
+ */
+
+bool
+configfile::finish_write (std::ofstream & file, bool ok)
+{
+    std::string tmpname = write_name();
+    file.close();
+    bool result = ok && ! file.fail();
+    if (result)
+    {
+        bool unchanged = file_exists(name()) &&
+            contents_to_compare(tmpname) == contents_to_compare(name());
+
+        if (unchanged)
+        {
+            (void) file_delete(tmpname);
+            file_message("Unchanged", name());
+        }
+        else
+        {
+            result = std::rename(tmpname.c_str(), name().c_str()) == 0;
+            if (! result)
+                file_error("Rename fail", name());
+        }
+    }
+    if (! result)
+        (void) file_delete(tmpname);
+
+    return result;
+}
+
 /**
  *  Sets the error message, which can later be displayed to the user.
  *  Actually, it now appends the error message, so all can be displayed in the
@@ -949,7 +1162,7 @@ configfile::set_up_ifstream (std::ifstream & instream)
     bool result = instream.is_open();
     if (result)
     {
-        instream.seekg(0, std::ios::beg);                   /* seek to start */
+        index_sections(instream);                           /* seeks to 0   */
 
         std::string s = get_variable(instream, "[Seq66]", "version");
         if (s.empty())
@@ -0,0 +1,149 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          hotsettings.cpp
+ *
+ *  This module defines the copy of the settings read by the real-time
+ *  threads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Publishing is done by the thread that changed the settings.  It is
+ *  rare, so it can afford to walk the maps.
+ */
+
+#include "cfg/hotsettings.hpp"          /* seq66::hotsettings               */
+#include "cfg/settings.hpp"             /* seq66::rc()                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+namespace
+{
+
+/**
+ *  The global object.  Not exposed as writable except via the publish
+ *  functions.
+ */
+
+hotsettings &
+hot_settings ()
+{
+    static hotsettings s_hot_settings;
+    return s_hot_settings;
+}
+
+}           // namespace (anonymous)
+
+/**
+ *  Starts with the defaults of the settings, so that a thread that runs
+ *  before the first publish() sees sane values.
+ */
+
+hotsettings::hotsettings () :
+    m_verbose           (false),
+    m_investigate       (false),
+    m_rt_safe           (false),
+    m_midi_clock_follow (false),
+    m_sysex_rate        (0),
+    m_thru_routes       (),
+    m_input_latencies   (),
+    m_output_bandwidths ()
+{
+    for (auto & r : m_thru_routes)
+        r.store(-1, std::memory_order_relaxed);
+
+    for (auto & u : m_input_latencies)
+        u.store(0, std::memory_order_relaxed);
+
+    for (auto & w : m_output_bandwidths)
+        w.store(0, std::memory_order_relaxed);
+}
+
+/**
+ *  Copies the settings used by the real-time threads.
+ *
+ * \param rcs
+ *      The 'rc' settings, normally rc().
+ */
+
+void
+hotsettings::publish (const rcsettings & rcs)
+{
+    static const std::memory_order relaxed = std::memory_order_relaxed;
+    m_verbose.store(rcs.verbose(), relaxed);
+    m_investigate.store(rcs.investigate(), relaxed);
+    m_rt_safe.store(rcs.rt_safe(), relaxed);
+    m_midi_clock_follow.store(rcs.midi_clock_follow(), relaxed);
+    m_sysex_rate.store(rcs.sysex_rate(), relaxed);
+    for (int b = 0; b < c_busscount_max; ++b)
+    {
+        m_thru_routes[b].store(rcs.thru_route(b), relaxed);
+        m_input_latencies[b].store(rcs.input_latency_us(b), relaxed);
+        m_output_bandwidths[b].store(rcs.output_bandwidth(b), relaxed);
+    }
+}
+
+/**
+ *  Provides read access to the settings for the real-time threads.
+ */
+
+const hotsettings &
+hot ()
+{
+    return hot_settings();
+}
+
+/**
+ *  Copies the current rc() settings for the real-time threads.
+ */
+
+void
+publish_hot_settings ()
+{
+    hot_settings().publish(rc());
+}
+
+/**
+ *  Sets one input latency, as measured by the latency probe, without
+ *  reading rc() from the input thread.
+ */
+
+void
+publish_input_latency (int inbus, int us)
+{
+    hot_settings().input_latency_us(inbus, us);
+}
+
+}           // namespace seq66
+
+/*
+ * hotsettings.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
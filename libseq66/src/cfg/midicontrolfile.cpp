@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-13
- * \updates       2023-12-30
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class handles the 'ctrl' file.
@@ -232,7 +232,7 @@ bool
 midicontrolfile::parse_stream (std::ifstream & file)
 {
     bool result = true;
-    file.seekg(0, std::ios::beg);                   /* seek to the start    */
+    index_sections(file);                           /* index and rewind     */
     (void) parse_version(file);
 
     std::string s = parse_comments(file);
@@ -353,10 +353,50 @@ midicontrolfile::parse_stream (std::ifstream & file)
         rc_ref().key_controls().clear();
         rc_ref().key_controls() = m_temp_key_controls;
     }
+    parse_pad_control(file);
     (void) parse_midi_control_out(file);
     return result;
 }
 
+/**
+ *  Reads the [pad-control-settings] and [pad-control] sections into the
+ *  pad map of the MIDI control input.  Both sections are optional; without
+ *  them the pads are off.  Each line of [pad-control] is a note number and
+ *  the slot, in the playing set, that it launches.  A bad line is reported
+ *  and skipped.
+ */
+
+void
+midicontrolfile::parse_pad_control (std::ifstream & file)
+{
+    padmap & pm = rc_ref().midi_control_in().pad_map();
+    std::string tag = "[pad-control-settings]";
+    pm.clear();
+    if (! bad_position(find_tag(file, tag)))
+    {
+        pm.enabled(get_boolean(file, tag, "pad-enabled"));
+        pm.channel(get_integer(file, tag, "pad-channel"));
+        pm.min_velocity(get_integer(file, tag, "min-velocity"));
+        pm.velocity_scale(get_boolean(file, tag, "velocity-scale"));
+        pm.quantize(get_integer(file, tag, "quantize"));
+    }
+
+    bool good = line_after(file, "[pad-control]");
+    while (good)
+    {
+        if (! line().empty())
+        {
+            int note = -1, slot = -1;
+            int count = std::sscanf(scanline(), "%d %d", &note, &slot);
+            if (count != 2 || ! pm.assign(note, slot))
+                warnprint("Bad [pad-control] line skipped");
+        }
+        good = next_data_line(file);
+    }
+    if (pm.count() > 0)
+        infoprintf("%d pad-control lines", pm.count());
+}
+
 /**
  *  A helper function for parsing the MIDI Control I/O sections.
  */
@@ -493,6 +533,9 @@ midicontrolfile::parse_midi_control_out (std::ifstream & file)
      * will determine if they are used.
      */
 
+    s = get_variable(file, mctag, "feedback-changes-only");
+    bool changesonly = string_to_bool(s, true);
+    int rate = get_integer(file, mctag, "feedback-rate");
     int offset = 0, rows = 0, columns = 0;
     result = parse_control_sizes(file, mctag, offset, rows, columns);
     if (result)
@@ -518,6 +561,8 @@ midicontrolfile::parse_midi_control_out (std::ifstream & file)
             mco.configure_enabled(enabled);
             mco.offset(offset);
             mco.configured_buss(buss);
+            mco.changes_only(changesonly);
+            mco.feedback_rate(rate);
         }
         if (file_version_number() < 2)
         {
@@ -750,6 +795,9 @@ midicontrolfile::write_stream (std::ofstream & file)
     write_comment(file, s);
 
     bool result = write_midi_control(file);
+    if (result)
+        result = write_pad_control(file);
+
     if (result)
         result = write_midi_control_out(file);
 
@@ -770,7 +818,7 @@ midicontrolfile::write_stream (std::ofstream & file)
 bool
 midicontrolfile::write ()
 {
-    std::ofstream file(name(), std::ios::out | std::ios::trunc);
+    std::ofstream file(write_name(), std::ios::out | std::ios::trunc);
     bool result = file.is_open();
     if (result)
     {
@@ -782,7 +830,7 @@ midicontrolfile::write ()
             if (! result)
                 file_error("Write fail", name());
         }
-        file.close();
+        result = finish_write(file, result);
     }
     else
     {
@@ -944,6 +992,54 @@ midicontrolfile::write_midi_control (std::ofstream & file)
     return result;
 }
 
+/**
+ *  Writes the [pad-control-settings] and [pad-control] sections.
+ *
+ * \param file
+ *      Provides the output file stream to write to.
+ *
+ * \return
+ *      Returns true if the write operations all succeeded.
+ */
+
+bool
+midicontrolfile::write_pad_control (std::ofstream & file)
+{
+    bool result = file.is_open();
+    if (result)
+    {
+        const padmap & pm = rc_ref().midi_control_in().pad_map();
+        file <<
+"\n[pad-control-settings]\n\n"
+"# Drum pads. A Note On on 'pad-channel' (0 to 15; 9 is the General MIDI drum\n"
+"# channel) of the control-buss launches the pattern mapped to the note in\n"
+"# [pad-control], if its velocity is at least 'min-velocity'. The pattern plays\n"
+"# once, from its start, alongside any other hits of it. 'quantize' is the note\n"
+"# value of the grid the start is put on (e.g. 16); 0 starts it at once. With\n"
+"# 'velocity-scale', the hit scales the velocity of the pattern's notes. The\n"
+"# pads work only while playing. Their notes are not recorded or used as\n"
+"# controls.\n\n"
+        ;
+        write_boolean(file, "pad-enabled", pm.enabled());
+        write_integer(file, "pad-channel", int(pm.channel()));
+        write_integer(file, "min-velocity", int(pm.min_velocity()));
+        write_boolean(file, "velocity-scale", pm.velocity_scale());
+        write_integer(file, "quantize", pm.quantize());
+        file <<
+"\n[pad-control]\n\n"
+"# Each line is a note number and the slot (0 to 1023, in the playing set) it\n"
+"# launches, e.g. '36 0' for the General MIDI Bass Drum 1 launching slot 0.\n\n"
+        ;
+        for (int note = 0; note < padmap::c_notes; ++note)
+        {
+            int slot = pm.slot(midibyte(note));
+            if (slot >= 0)
+                file << std::setw(3) << note << " " << slot << "\n";
+        }
+    }
+    return result;
+}
+
 /**
  *  Writes a MIDI user-interface-related data stanza of the form
  *  "1 [ 0 0x00 0 ] [ 0 0x00 0 ] [ 0 0x00 0 ]".  Here, action_del is
@@ -1043,6 +1139,15 @@ midicontrolfile::write_midi_control_out (std::ofstream & file)
         write_integer(file, "button-columns", mco.columns());
         file <<
 "\n"
+"# feedback-changes-only skips status messages that would not change what\n"
+"# the device shows. feedback-rate limits the status messages to that many\n"
+"# per second, for slow devices; 0 means no limit.\n"
+"\n"
+            ;
+        write_boolean(file, "feedback-changes-only", mco.changes_only());
+        write_integer(file, "feedback-rate", mco.feedback_rate());
+        file <<
+"\n"
 "[midi-control-out]\n"
 "\n"
 "# This section determines how pattern statuses are to be displayed.\n"
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2018-11-13
- * \updates       2023-12-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -109,7 +109,7 @@ bool
 mutegroupsfile::parse_stream (std::ifstream & file)
 {
     bool result = true;
-    file.seekg(0, std::ios::beg);                   /* seek to start    */
+    index_sections(file);                           /* index, rewind    */
     (void) parse_version(file);
 
     std::string s = parse_comments(file);
@@ -326,13 +326,12 @@ mutegroupsfile::write_stream (std::ofstream & file)
 bool
 mutegroupsfile::write ()
 {
-    std::ofstream file(name(), std::ios::out | std::ios::trunc);
+    std::ofstream file(write_name(), std::ios::out | std::ios::trunc);
     bool result = file.is_open();
     if (result)
     {
         file_message("Write mutes", name());
-        result = write_stream(file);
-        file.close();
+        result = finish_write(file, write_stream(file));
     }
     else
     {
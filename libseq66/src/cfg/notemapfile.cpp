@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2019-11-05
- * \updates       2025-01-09
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -88,7 +88,7 @@ bool
 notemapfile::parse_stream (std::ifstream & file)
 {
     bool result = true;
-    file.seekg(0, std::ios::beg);                   /* seek to start    */
+    index_sections(file);                           /* index, rewind    */
     (void) parse_version(file);
 
     std::string s = parse_comments(file);
@@ -276,13 +276,12 @@ notemapfile::write_stream (std::ofstream & file)
 bool
 notemapfile::write ()
 {
-    std::ofstream file(name(), std::ios::out | std::ios::trunc);
+    std::ofstream file(write_name(), std::ios::out | std::ios::trunc);
     bool result = ! name().empty() && file.is_open();
     if (result)
     {
         file_message("Write drums", name());
-        result = write_stream(file);
-        file.close();
+        result = finish_write(file, write_stream(file));
     }
     else
     {
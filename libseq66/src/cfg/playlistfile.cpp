@@ -26,7 +26,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-09-19
- * \updates       2023-12-05
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Here is a skeletal representation of a Seq66 playlist file:
@@ -211,7 +211,7 @@ playlistfile::parse ()
     if (result)
     {
         file_message("Read", name());
-        file.seekg(0, std::ios::beg);                   /* seek to start    */
+        index_sections(file);                           /* index, rewind    */
         play_list().clear();
         (void) parse_version(file);
 
@@ -240,6 +240,8 @@ playlistfile::parse ()
             play_list().auto_play(flag);
             flag = get_boolean(file, tag, "auto-advance");
             play_list().auto_advance(flag);
+            flag = get_boolean(file, tag, "gapless");
+            play_list().gapless(flag);
             flag = get_boolean(file, tag, "deep-verify");
             play_list().deep_verify(flag);
         }
@@ -451,7 +453,7 @@ playlistfile::scan_song_file (int & song_number, std::string & song_file)
 bool
 playlistfile::write ()
 {
-    std::ofstream file(name(), std::ios::out | std::ios::trunc);
+    std::ofstream file(write_name(), std::ios::out | std::ios::trunc);
     bool result = ! name().empty() && file.is_open();
     if (result)
     {
@@ -495,14 +497,18 @@ playlistfile::write ()
 "# songs with triggers for Song mode. 'auto-play' causes songs to start play\n"
 "# automatically when loaded. 'auto-advance' implies the settings noted\n"
 "# above. It automatically loads the next song in the play-list when the\n"
-"# current song ends. 'deep-verify' causes each tune in the play-list to be\n"
-"# loaded to make sure each one can be loaded. Otherwise, only file existence\n"
-"# is checked.\n\n"
+"# current song ends. 'gapless' makes auto-advance switch songs at the bar\n"
+"# line ending the current song without stopping, sending no MIDI Stop or\n"
+"# Start, and the MIDI clock goes on at the tempo of the next song. (Not\n"
+"# done with JACK transport.) 'deep-verify' causes each tune in the play-list\n"
+"# to be loaded to make sure each one can be loaded. Otherwise, only file\n"
+"# existence is checked.\n\n"
         ;
 
     write_boolean(file, "unmute-next-song", play_list().auto_arm());
     write_boolean(file, "auto-play", play_list().auto_play());
     write_boolean(file, "auto-advance", play_list().auto_advance());
+    write_boolean(file, "gapless", play_list().gapless());
     write_boolean(file, "deep-verify", play_list().deep_verify());
     file << "\n"
 "# Here are the playlist settings, default storage folder, and then a list of\n"
@@ -560,8 +566,7 @@ playlistfile::write ()
             ;
     }
     write_seq66_footer(file);
-    file.close();
-    return true;
+    return finish_write(file, true);
 }
 
 /*
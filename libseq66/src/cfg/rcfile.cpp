@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2025-01-22
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The <code> ~/.config/seq66.rc </code> configuration file is fairly simple
@@ -47,6 +47,8 @@
 #include "cfg/rcfile.hpp"               /* seq66::rcfile class              */
 #include "cfg/settings.hpp"             /* seq66::rc() accessor             */
 #include "midi/midibus.hpp"             /* seq66::midibus class             */
+#include "midi/inputfilter.hpp"         /* seq66::inputfilter class         */
+#include "midi/outputfilter.hpp"        /* seq66::outputfilter class        */
 #include "util/filefunctions.hpp"       /* seq66::filename_base() etc.      */
 #include "util/strfunctions.hpp"        /* seq66::strip_quotes() function   */
 
@@ -224,6 +226,93 @@ rcfile::parse ()
         rc().thread_priority(priority);
     }
 
+    bool rtsafe = get_boolean(file, tag, "rt-safe");
+    rc_ref().rt_safe(rtsafe);
+    s = get_variable(file, tag, "output-policy");
+    rc_ref().output_policy(s);
+    priority = get_integer(file, tag, "output-priority", 0);
+    rc_ref().output_priority(priority);
+    s = get_variable(file, tag, "output-cpus");
+    rc_ref().output_cpus(s);
+    s = get_variable(file, tag, "input-policy");
+    rc_ref().input_policy(s);
+    priority = get_integer(file, tag, "input-priority", 0);
+    rc_ref().input_priority(priority);
+    s = get_variable(file, tag, "input-cpus");
+    rc_ref().input_cpus(s);
+    s = get_variable(file, tag, "worker-cpus");
+    rc_ref().worker_cpus(s);
+    s = get_variable(file, tag, "output-scheduler");
+    rc_ref().output_scheduler(s);
+
+    int lookahead = get_integer(file, tag, "alsa-lookahead", 0);
+    rc_ref().alsa_lookahead_ms(lookahead);
+
+    int latency = get_integer(file, tag, "portmidi-latency", 0);
+    rc_ref().portmidi_latency_ms(latency);
+
+    int probeout = get_integer(file, tag, "latency-probe-out", -1);
+    int probein = get_integer(file, tag, "latency-probe-in", -1);
+    rc_ref().latency_probe(probeout, probein);
+
+    int rate = get_integer(file, tag, "sysex-rate", c_sysex_rate_default);
+    rc_ref().sysex_rate(rate);
+
+    int rbsize = get_integer
+    (
+        file, tag, "jack-ringbuffer", c_jack_ringbuffer_default
+    );
+    rc_ref().jack_ringbuffer_size(rbsize);
+
+    int workers = get_integer(file, tag, "output-workers", 0);
+    rc_ref().output_workers(workers);
+
+    int statsecs = get_integer(file, tag, "output-stats", 0);
+    rc_ref().output_stats_s(statsecs);
+
+    bool follow = get_boolean(file, tag, "midi-clock-follow", 0, true);
+    rc_ref().midi_clock_follow(follow);
+    s = get_variable(file, tag, "input-capture");
+    rc_ref().input_capture(s);
+
+    int metricsport = get_integer(file, tag, "metrics-port", 0);
+    rc_ref().metrics_port(metricsport);
+
+    int controlport = get_integer(file, tag, "osc-control-port", 0);
+    rc_ref().osc_control_port(controlport);
+
+    bool linksync = get_boolean(file, tag, "link-sync");
+    rc_ref().link_sync(linksync);
+
+    int quantum = get_integer
+    (
+        file, tag, "link-quantum", c_link_quantum_default
+    );
+    rc_ref().link_quantum(quantum);
+    s = get_variable(file, tag, "mirror-role");
+    rc_ref().mirror_role(s);
+    s = get_variable(file, tag, "mirror-host");
+    rc_ref().mirror_host(s);
+
+    int mirrorport = get_integer(file, tag, "mirror-port", 0);
+    rc_ref().mirror_port(mirrorport);
+    s = get_variable(file, tag, "rtp-midi-peers");
+    rc_ref().rtp_midi_peers(s);
+
+    int rtpport = get_integer
+    (
+        file, tag, "rtp-midi-port", c_rtp_midi_port_default
+    );
+    rc_ref().rtp_midi_port(rtpport);
+
+    int rtplookahead = get_integer
+    (
+        file, tag, "rtp-midi-lookahead", c_rtp_midi_lookahead_default
+    );
+    rc_ref().rtp_midi_lookahead_ms(rtplookahead);
+    s = get_variable(file, tag, "state-mirror");
+    rc_ref().state_mirror(s);
+
     /*
      * [comments] Header comments (hash-tag lead) are skipped during parsing.
      * However, we now try to read an optional comment block.
@@ -309,10 +398,16 @@ rcfile::parse ()
 
         bool flag = get_boolean(file, tag, "jack-midi");
         rc_ref().with_jack_midi(flag);
+        s = get_variable(file, tag, "last-midi-api");
+        rc_ref().last_midi_api(strip_quotes(s));
         flag = get_boolean(file, tag, "jack-auto-connect", 0, true);
         rc_ref().jack_auto_connect(flag);
+        flag = get_boolean(file, tag, "jack-lazy-connect", 0, false);
+        rc_ref().jack_lazy_connect(flag);
         flag = get_boolean(file, tag, "jack-use-offset", 0, true);
         rc_ref().jack_use_offset(flag);
+        flag = get_boolean(file, tag, "jack-period-sync", 0, false);
+        rc_ref().jack_period_sync(flag);
 
         int buffersize = rc().jack_buffer_size();
         buffersize = get_integer(file, tag, "jack-buffer-size", 0);
@@ -363,6 +458,31 @@ rcfile::parse ()
         return make_error_message(tag, "section missing");
     }
 
+    /*
+     *  Check for the optional recording latencies.  A bad line ends the list.
+     */
+
+    tag = "[midi-input-latency]";
+    rc_ref().clear_input_latencies();
+    if (line_after(file, tag))
+    {
+        int latencies = 0;
+        int count = std::sscanf(scanline(), "%d", &latencies);
+        for (int i = 0; count > 0 && i < latencies; ++i)
+        {
+            int inbus;
+            double ms;
+            if (! next_data_line(file))
+                break;
+
+            count = std::sscanf(scanline(), "%d %lf", &inbus, &ms);
+            if (count == 2 && inbus >= 0 && ms >= 0.0)
+                rc_ref().input_latency_us(inbus, int(ms * 1000.0 + 0.5));
+            else
+                break;
+        }
+    }
+
     /*
      *  Check for an optional input port map section.
      */
@@ -476,6 +596,110 @@ rcfile::parse ()
     rc().portmaps_present(portmaps_present);
     rc().portmaps_active(inportmap_active && outportmap_active);
 
+    /*
+     *  Check for the optional MIDI thru routes.  A bad line ends the list.
+     */
+
+    tag = "[midi-thru]";
+    rc_ref().clear_thru_routes();
+    if (line_after(file, tag))
+    {
+        while (next_data_line(file))
+        {
+            int inbus, outbus;
+            int count = std::sscanf(scanline(), "%d %d", &inbus, &outbus);
+            if (count == 2 && inbus >= 0 && outbus >= 0)
+                rc_ref().thru_route(inbus, outbus);
+            else
+                break;
+        }
+    }
+
+    /*
+     *  Check for the optional output filters, each an output buss number
+     *  followed by the filter stages.  A bad line ends the list.
+     */
+
+    tag = "[midi-output-filter]";
+    rc_ref().clear_output_filters();
+    if (line_after(file, tag))
+    {
+        while (next_data_line(file))
+        {
+            int outbus, offset;
+            int count = std::sscanf(scanline(), "%d %n", &outbus, &offset);
+            if (count == 1 && outbus >= 0)
+            {
+                std::string spec = line().substr(std::size_t(offset));
+                auto hash = spec.find('#');
+                if (hash != std::string::npos)
+                    spec = spec.substr(0, hash);
+
+                spec = trim(spec);
+                if (outputfilter(spec).empty())
+                    return make_error_message(tag, "bad filter stages");
+
+                rc_ref().output_filter(outbus, spec);
+            }
+            else
+                break;
+        }
+    }
+
+    /*
+     *  Check for the optional input filters, in the same form.
+     */
+
+    tag = "[midi-input-filter]";
+    rc_ref().clear_input_filters();
+    if (line_after(file, tag))
+    {
+        while (next_data_line(file))
+        {
+            int inbus, offset;
+            int count = std::sscanf(scanline(), "%d %n", &inbus, &offset);
+            if (count == 1 && inbus >= 0)
+            {
+                std::string spec = line().substr(std::size_t(offset));
+                auto hash = spec.find('#');
+                if (hash != std::string::npos)
+                    spec = spec.substr(0, hash);
+
+                spec = trim(spec);
+                if (inputfilter(spec).empty())
+                    return make_error_message(tag, "bad filter stages");
+
+                rc_ref().input_filter(inbus, spec);
+            }
+            else
+                break;
+        }
+    }
+
+    /*
+     *  Check for the optional output bandwidths.  A bad line ends the list.
+     */
+
+    tag = "[midi-output-bandwidth]";
+    rc_ref().clear_output_bandwidths();
+    if (line_after(file, tag))
+    {
+        int bandwidths = 0;
+        int count = std::sscanf(scanline(), "%d", &bandwidths);
+        for (int i = 0; count > 0 && i < bandwidths; ++i)
+        {
+            int outbus, bytespersec;
+            if (! next_data_line(file))
+                break;
+
+            count = std::sscanf(scanline(), "%d %d", &outbus, &bytespersec);
+            if (count == 2 && outbus >= 0 && bytespersec > 0)
+                rc_ref().output_bandwidth(outbus, bytespersec);
+            else
+                break;
+        }
+    }
+
     /*
      * Moved from original location above so that we have the port-mapping
      * in place for use here.
@@ -631,6 +855,9 @@ rcfile::parse ()
     rc_ref().save_old_triggers(flag);
     flag = get_boolean(file, tag, "save-old-mutes");
     rc_ref().save_old_mutes(flag);
+    flag = get_boolean(file, tag, "save-in-background");
+    rc_ref().save_in_background(flag);
+    rc_ref().journal_interval(get_integer(file, tag, "journal-interval"));
 
     /*
      * [recent-files]
@@ -727,7 +954,7 @@ rcfile::get_usr_file ()
 bool
 rcfile::write ()
 {
-    std::ofstream file(name(), std::ios::out | std::ios::trunc);
+    std::ofstream file(write_name(), std::ios::out | std::ios::trunc);
     bool ok = file.is_open();
     if (ok)
     {
@@ -771,6 +998,121 @@ rcfile::write ()
 "#\n"
 "# 'priority' greater than 0 is meant to increase the priority of the I/O\n"
 "# threads. It needs Seq66 to run as root, or be installed as setuid 0.\n"
+"#\n"
+"# 'rt-safe' locks the memory of Seq66 into RAM (mlockall()) and prefaults\n"
+"# the heap and the I/O thread stacks, so that the output, input, and JACK\n"
+"# threads take no page faults. It needs a large enough 'memlock' limit,\n"
+"# as given to the 'audio' group. Debug builds also count allocations made\n"
+"# by those threads, shown in the 'output-stats' line.\n"
+"#\n"
+"# 'output-policy' and 'input-policy' ('fifo', 'rr', or 'other') and\n"
+"# 'output-priority' and 'input-priority' (1 to 99, 0 to use 'priority')\n"
+"# set the scheduling of the I/O threads; a thread gets a real-time policy\n"
+"# only when it has a priority. 'output-cpus', 'input-cpus', and\n"
+"# 'worker-cpus' (e.g. \"2,3\" or \"4-7\", empty for any) pin the threads to\n"
+"# CPUs, such as those set aside by 'isolcpus'. Each output worker gets the\n"
+"# next CPU of 'worker-cpus' in turn, and the output thread's scheduling.\n"
+"# The result is logged at startup.\n"
+"#\n"
+"# 'output-scheduler' sets how the output thread waits between frames.\n"
+"# 'microsleep' wakes every few milliseconds (the legacy method). 'deadline'\n"
+"# sleeps until the absolute time of the next event or MIDI clock pulse,\n"
+"# reducing idle wake-ups and jitter. Ignored when following MIDI clock.\n"
+"# 'jack' lets the JACK MIDI process callback play each cycle, writing each\n"
+"# event at its frame offset. Falls back to 'microsleep' without JACK MIDI.\n"
+"#\n"
+"# 'alsa-lookahead' (0 to 50 ms) schedules ALSA output on a real-time queue\n"
+"# that many milliseconds ahead, so the kernel timer delivers each event on\n"
+"# time. It adds that much latency. 0 (the default) delivers immediately.\n"
+"# Muting a pattern takes back its queued events, bar the Note Offs, so\n"
+"# that the mute is not delayed.\n"
+"#\n"
+"# 'portmidi-latency' (0 to 50 ms) opens PortMidi outputs with that\n"
+"# latency, and timestamps each event, so that PortMidi (Windows, macOS)\n"
+"# schedules its delivery; each frame's events go out in one write. 0 (the\n"
+"# default) delivers immediately, ignoring the timestamps.\n"
+"#\n"
+"# 'latency-probe-out' and 'latency-probe-in' (buss numbers, -1 for none)\n"
+"# measure the latency of an input: at startup, a few clicks go out the\n"
+"# output buss, looped back (by a cable, a JACK connection, or a null\n"
+"# device) to the input buss, and their average round trip becomes that\n"
+"# buss's entry in [midi-input-latency]. The probe is then turned off.\n"
+"#\n"
+"# 'sysex-rate' (bytes per second, 0 for no limit) paces the output of\n"
+"# large SysEx dumps, sent in chunks, so as not to overrun the device. The\n"
+"# default, 3125, is the rate of a MIDI cable.\n"
+"#\n"
+"# 'jack-ringbuffer' (64 to 65536) is the number of messages each JACK port\n"
+"# can hold between the JACK process callback and the output or input\n"
+"# thread. Messages that do not fit are dropped, and counted in the output\n"
+"# statistics (see 'output-stats'). The default is 2048.\n"
+"#\n"
+"# 'output-workers' (0 to 16) adds that many threads that play the patterns\n"
+"# of the playscreen in parallel in Live mode, merging their output in time\n"
+"# order. Useful only with many busy patterns. 0 (the default) plays them\n"
+"# one after the other in the output thread.\n"
+"#\n"
+"# 'output-stats' (0 to 3600 s) logs a line of output timing statistics\n"
+"# (wake-up lateness, underruns, frame time, events per frame, the longest\n"
+"# pattern-lock wait, and output buffer high-water marks) every that many\n"
+"# seconds while playing. 0 (the default) logs nothing.\n"
+"#\n"
+"# 'midi-clock-follow' (the default) smooths incoming MIDI clock, tracking\n"
+"# its tempo and phase, so that a slaved Seq66 plays at full PPQN resolution\n"
+"# rather than in steps of one clock. 'false' uses the clocks as they come.\n"
+"#\n"
+"# 'input-capture' names a directory (relative to the configuration\n"
+"# directory unless a full path) in which all MIDI channel messages from\n"
+"# every input port are recorded, whether or not a pattern is armed, to one\n"
+"# MIDI file per hour, e.g. \"capture\". The file is kept complete as it\n"
+"# grows. Empty (the default) records nothing.\n"
+"#\n"
+"# 'metrics-port' (1024 to 65535) serves the engine metrics over OSC on that\n"
+"# UDP port, for monitoring headless machines. Send '/seq66/metrics' to get\n"
+"# one '/seq66/metrics/<name>' reply per metric, or '/seq66/metrics/text'\n"
+"# for all of them as Prometheus text. 0 (the default) serves nothing. Needs\n"
+"# a build with NSM (liblo) support.\n"
+"#\n"
+"# 'osc-control-port' (1024 to 65535) takes controls over OSC on that UDP\n"
+"# port, as MIDI control does: '/seq66/control/automation i:slot [i:action\n"
+"# [i:value]]', '/seq66/control/loop i:pattern [i:action]', and\n"
+"# '/seq66/control/mute_group i:group [i:action]'. The action is 1 (toggle,\n"
+"# the default), 2 (on), or 3 (off); the slot numbers are those of the\n"
+"# 'ctrl' file. 0 (the default) takes nothing. Needs liblo support.\n"
+"#\n"
+"# 'link-sync' joins the Ableton Link session on the LAN: tempo, beats, and\n"
+"# start/stop are shared with the other Link applications (including other\n"
+"# Seq66 machines), which stay phase-locked with no MIDI clock or JACK\n"
+"# server. Playback starts on the next 'link-quantum' boundary (1 to 16\n"
+"# beats, 4 by default). Needs a build with the Link SDK (configure\n"
+"# --with-link=DIR). 'false' (the default) does not join.\n"
+"#\n"
+"# 'mirror-role' pairs two machines for a show, one a hot spare. The\n"
+"# 'primary' sends its controls (from MIDI, keys, and OSC), its playscreen,\n"
+"# pattern mutes, tempo, and position over OSC to 'mirror-host' (localhost\n"
+"# by default) at UDP 'mirror-port'. The 'replica' listens on 'mirror-port',\n"
+"# follows the primary with its output silenced, and takes over the output\n"
+"# when nothing has come from the primary for a quarter of a second. 'none'\n"
+"# (the default), or a 'mirror-port' of 0, does not mirror. Needs liblo.\n"
+"#\n"
+"# 'rtp-midi-peers' lists network MIDI (RTP-MIDI, AppleMIDI) devices, as\n"
+"# \"host\" or \"host:port\" separated by spaces or commas; the port is the\n"
+"# control port, 5004 by default. Each peer adds an output and an input\n"
+"# buss after the native ones, used like any other buss in the clocks and\n"
+"# inputs lists. Seq66 invites each peer from UDP 'rtp-midi-port' (5004 by\n"
+"# default; the data port is the next one), sends each frame's events in\n"
+"# one packet per peer, timestamped 'rtp-midi-lookahead' ms ahead (0 to 50,\n"
+"# 10 by default), and recovers lost packets from the recovery journal.\n"
+"# Empty (the default) adds no network busses.\n"
+"#\n"
+"# 'state-mirror' names a shared-memory segment (/dev/shm/NAME on Linux)\n"
+"# in which the engine publishes its state, many times a second: transport,\n"
+"# tempo, the playscreen, and each pattern's status, events, and triggers.\n"
+"# Another process can read it and send automation commands back through\n"
+"# its command queue, without touching the playback: 'seq66cli --mirror\n"
+"# NAME' checks and prints the mirrored state, and can start, stop, and\n"
+"# toggle patterns. Meant for seq66cli; empty (the default) publishes\n"
+"# nothing.\n"
         ;
 
     write_seq66_header(file, "rc", version());
@@ -780,6 +1122,42 @@ rcfile::write ()
     write_string(file, "port-naming", rc_ref().port_naming_string());
     write_boolean(file, "init-disabled-ports", rc_ref().init_disabled_ports());
     write_integer(file, "priority", rc_ref().thread_priority());
+    write_boolean(file, "rt-safe", rc_ref().rt_safe());
+    write_string(file, "output-policy", rc_ref().output_policy());
+    write_integer(file, "output-priority", rc_ref().output_priority());
+    write_string(file, "output-cpus", rc_ref().output_cpus(), true);
+    write_string(file, "input-policy", rc_ref().input_policy());
+    write_integer(file, "input-priority", rc_ref().input_priority());
+    write_string(file, "input-cpus", rc_ref().input_cpus(), true);
+    write_string(file, "worker-cpus", rc_ref().worker_cpus(), true);
+    write_string
+    (
+        file, "output-scheduler", rc_ref().output_scheduler_string()
+    );
+    write_integer(file, "alsa-lookahead", rc_ref().alsa_lookahead_ms());
+    write_integer(file, "portmidi-latency", rc_ref().portmidi_latency_ms());
+    write_integer(file, "latency-probe-out", rc_ref().latency_probe_out());
+    write_integer(file, "latency-probe-in", rc_ref().latency_probe_in());
+    write_integer(file, "sysex-rate", rc_ref().sysex_rate());
+    write_integer(file, "jack-ringbuffer", rc_ref().jack_ringbuffer_size());
+    write_integer(file, "output-workers", rc_ref().output_workers());
+    write_integer(file, "output-stats", rc_ref().output_stats_s());
+    write_boolean(file, "midi-clock-follow", rc_ref().midi_clock_follow());
+    write_string(file, "input-capture", rc_ref().input_capture(), true);
+    write_integer(file, "metrics-port", rc_ref().metrics_port());
+    write_integer(file, "osc-control-port", rc_ref().osc_control_port());
+    write_boolean(file, "link-sync", rc_ref().link_sync());
+    write_integer(file, "link-quantum", rc_ref().link_quantum());
+    write_string(file, "mirror-role", rc_ref().mirror_role_string());
+    write_string(file, "mirror-host", rc_ref().mirror_host(), true);
+    write_integer(file, "mirror-port", rc_ref().mirror_port());
+    write_string(file, "rtp-midi-peers", rc_ref().rtp_midi_peers(), true);
+    write_integer(file, "rtp-midi-port", rc_ref().rtp_midi_port());
+    write_integer
+    (
+        file, "rtp-midi-lookahead", rc_ref().rtp_midi_lookahead_ms()
+    );
+    write_string(file, "state-mirror", rc_ref().state_mirror(), true);
 
     /*
      * [comments]
@@ -943,6 +1321,25 @@ rcfile::write ()
     std::string listlines = rc_ref().inputs().io_list_lines();
     file << listlines;
 
+    int latencies = int(rc_ref().input_latencies().size());
+    file << "\n"
+"# Recording latencies. Each line is an input buss number, then the time,\n"
+"# in milliseconds, by which the events recorded from it are moved earlier,\n"
+"# to make up for the delay of the device, the driver, and the period of\n"
+"# the MIDI engine. See 'latency-probe-out' to have it measured.\n"
+"\n[midi-input-latency]\n\n"
+        << std::setw(2) << latencies << "      # number of input latencies\n\n"
+        ;
+    for (const auto & lat : rc_ref().input_latencies())
+    {
+        file
+            << std::setw(2) << lat.first << " " << std::fixed
+            << std::setprecision(3) << double(lat.second) / 1000.0
+            << "   # input buss, latency (ms)\n"
+            ;
+    }
+    file.unsetf(std::ios_base::floatfield);
+
     const inputslist & inpsref = input_port_map();
     if (inpsref.not_empty())
     {
@@ -1025,6 +1422,73 @@ rcfile::write ()
         ;
     }
 
+    int routes = int(rc_ref().thru_routes().size());
+    file << "\n"
+"# MIDI thru routes. Events from the input buss (the first number) are sent\n"
+"# at once to the output buss (the second number) by the MIDI engine, with\n"
+"# JACK in the same process cycle, rather than by the pattern doing the\n"
+"# recording. The events are still recorded, but that pattern's MIDI thru\n"
+"# skips them. Channel messages only; SysEx and real-time are not routed.\n"
+"\n[midi-thru]\n\n"
+        << std::setw(2) << routes << "      # number of thru routes\n\n"
+        ;
+    for (const auto & route : rc_ref().thru_routes())
+    {
+        file
+            << std::setw(2) << route.first << " " << std::setw(2)
+            << route.second << "   # input buss, output buss\n"
+            ;
+    }
+
+    file << "\n"
+"# Output filters. Each line is an output buss number, then the stages that\n"
+"# are run, in order, over each message played on that buss: 'transpose:N'\n"
+"# (semitones), 'velocity:P' (percent of Note On velocity), 'channel:C' (1 to\n"
+"# 16), 'thin:D' (drop controller, aftertouch, and pitch-bend changes\n"
+"# within D of the last value sent), and 'rate:N' (send at most N of them a\n"
+"# second per controller, note, or channel). Example: '1 thin:2 rate:200'.\n"
+"# 'dedup' drops a controller, program, pressure, or pitch-bend message that\n"
+"# repeats one already sent in the same output cycle, as from two patterns on\n"
+"# one channel. 'running' uses running status on a port that builds its own\n"
+"# bytes (RTP-MIDI); ALSA and JACK ports always send whole messages.\n"
+"\n[midi-output-filter]\n\n"
+        ;
+    for (const auto & of : rc_ref().output_filters())
+        file << std::setw(2) << of.first << " " << of.second << "\n";
+
+    file << "\n"
+"# Input filters. Each line is an input buss number, then the stages run, in\n"
+"# order, over each message as it arrives, before it is queued: 'channel:C'\n"
+"# or 'channel:C-D' (pass only channels C to D, 1 to 16), 'notes:L-H' (pass\n"
+"# only notes L to H, for a split), 'curve:N' (velocity curve, N percent from\n"
+"# 25, softer, to 400, harder), 'noclock' (drop MIDI clock; not on a buss the\n"
+"# clock is followed from) and 'nosense' (drop active sensing). Example:\n"
+"# '0 noclock nosense curve:80'.\n"
+"\n[midi-input-filter]\n\n"
+        ;
+    for (const auto & inf : rc_ref().input_filters())
+        file << std::setw(2) << inf.first << " " << inf.second << "\n";
+
+    int bandwidths = int(rc_ref().output_bandwidths().size());
+    file << "\n"
+"# Output bandwidths. Each line is an output buss number, then the bytes per\n"
+"# second its interface can carry: 3125 for a 5-pin DIN port. The events of\n"
+"# each output cycle for such a buss are ordered Note Offs first, then other\n"
+"# messages, Note Ons, and controllers, and a controller change that would\n"
+"# queue more than 10 ms of bytes in the interface waits for the next cycle.\n"
+"# The overloads are shown in the output statistics.\n"
+"\n[midi-output-bandwidth]\n\n"
+        << std::setw(2) << bandwidths
+        << "      # number of output bandwidths\n\n"
+        ;
+    for (const auto & bw : rc_ref().output_bandwidths())
+    {
+        file
+            << std::setw(2) << bw.first << " " << bw.second
+            << "   # output buss, bytes per second\n"
+            ;
+    }
+
     /*
      * MIDI clock modulo value, and filter by channel, new option as of
      * 2016-08-20.
@@ -1204,17 +1668,30 @@ rcfile::write ()
 "# jack-midi sets/unsets JACK MIDI, separate from JACK transport.\n"
 "# jack-auto-connect sets connecting to JACK ports found. Default = true; use\n"
 "# false to have a session manager make the connections.\n"
+"# jack-lazy-connect makes those connections in a background thread, the\n"
+"# ports enabled in the clocks and inputs lists first, so that start-up does\n"
+"# not wait on them when many JACK clients are running.  Default = false.\n"
 "# jack-use-offset attempts to calculate timestamp offsets to improve accuracy\n"
 "# at high-buffer sizes. Still a work in progress.\n"
+"# jack-period-sync takes the transport tick from the position of each JACK\n"
+"# period, found in the process callback, instead of querying transport at\n"
+"# each output wake-up and accumulating frame differences. Frame-exact, and\n"
+"# follows the BBT of an external JACK master.  Default = false.\n"
 "# jack-buffer-size allows for changing the frame-count, a power of 2.\n"
+"# last-midi-api is set by Seq66: the MIDI engine found at the last run.\n"
+"# It is tried first at start-up, and, if it is not JACK, the check for a\n"
+"# running JACK server is given less time.\n"
 "\n[jack-transport]\n\n"
         << "transport-type = " << jacktransporttype << "\n"
         << "song-start-mode = " << rc_ref().song_mode_string() << "\n"
         ;
     write_boolean(file, "jack-midi", rc_ref().with_jack_midi());
     write_boolean(file, "jack-auto-connect", rc_ref().jack_auto_connect());
+    write_boolean(file, "jack-lazy-connect", rc_ref().jack_lazy_connect());
     write_boolean(file, "jack-use-offset", rc_ref().jack_use_offset());
+    write_boolean(file, "jack-period-sync", rc_ref().jack_period_sync());
     write_integer(file, "jack-buffer-size", rc_ref().jack_buffer_size());
+    write_string(file, "last-midi-api", rc_ref().last_midi_api(), true);
     file << "\n"
 "# 'auto-save-rc' sets automatic saving of the  'rc' and other files. If set\n"
 "# (true if changes were made in Preferences), settings are saved.\n"
@@ -1222,11 +1699,21 @@ rcfile::write ()
 "# 'old-triggers' saves triggers in a format compatible with Seq24. Otherwise,\n"
 "# triggers are saved with an additional 'transpose' setting. The old-mutes\n"
 "# value, if true, saves mute-groups as long values (!) instead of bytes.\n"
+"#\n"
+"# 'save-in-background', if true, makes a session save (e.g. from NSM) take\n"
+"# a snapshot of the song and write the MIDI file in a background thread.\n"
+"#\n"
+"# 'journal-interval', if not 0, is the number of seconds between writes of\n"
+"# the edit journal, 'song.midi.journal', which logs the patterns changed\n"
+"# since the song was last saved. After a crash, opening the song replays the\n"
+"# journal. Saving the song, or exiting normally, removes the journal.\n"
 "\n[auto-option-save]\n\n"
         ;
     write_boolean(file, "auto-save-rc", rc_ref().auto_rc_save());
     write_boolean(file, "save-old-triggers", rc_ref().save_old_triggers());
     write_boolean(file, "save-old-mutes", rc_ref().save_old_mutes());
+    write_boolean(file, "save-in-background", rc_ref().save_in_background());
+    write_integer(file, "journal-interval", rc_ref().journal_interval());
 
     std::string lud = rc_ref().last_used_dir();
     file << "\n"
@@ -1259,8 +1746,7 @@ rcfile::write ()
         }
     }
     write_seq66_footer(file);
-    file.close();
-    return true;
+    return finish_write(file, true);
 }
 
 /*
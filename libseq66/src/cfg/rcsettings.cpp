@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2025-01-22
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Note that this module also sets the legacy global variables, so that
@@ -69,6 +69,11 @@ rcsettings::rcsettings () :
 #endif
     m_clocks                    (),         /* vector wrapper class         */
     m_inputs                    (),         /* vector wrapper class         */
+    m_thru_routes               (),         /* input buss to output buss    */
+    m_input_latencies           (),         /* input buss to microseconds   */
+    m_output_filters            (),         /* output buss to filter stages */
+    m_input_filters             (),         /* input buss to filter stages  */
+    m_output_bandwidths         (),         /* output buss to bytes/second  */
     m_metro_settings            (),
     m_mute_group_save           (mutegroups::saving::midi),
     m_keycontainer              ("rc"),
@@ -84,12 +89,22 @@ rcsettings::rcsettings () :
     m_save_list                 (),         /* std::map<string, bool>       */
     m_save_old_triggers         (false),
     m_save_old_mutes            (false),
+    m_save_in_background        (false),
+    m_journal_interval          (0),
     m_allow_mod4_mode           (false),
     m_allow_snap_split          (false),
     m_allow_click_edit          (true),
     m_show_midi                 (false),
     m_priority                  (false),
     m_thread_priority           (0),        /* c_thread_priority            */
+    m_rt_safe                   (false),
+    m_output_policy             ("fifo"),
+    m_output_priority           (0),
+    m_output_cpus               (),
+    m_input_policy              ("fifo"),
+    m_input_priority            (0),
+    m_input_cpus                (),
+    m_worker_cpus               (),
     m_pass_sysex                (false),
     m_with_jack_transport       (false),
     m_with_jack_master          (false),
@@ -100,8 +115,14 @@ rcsettings::rcsettings () :
     m_with_jack_midi            (false),
 #endif
     m_with_alsa_midi            (false),    /* unless ALSA gets selected    */
+    m_with_null_midi            (false),    /* only from the command line   */
+    m_last_midi_api             (),         /* "jack", "alsa", or "null"    */
+    m_null_midi_loopback        (false),
+    m_session_log               (),         /* only from the command line   */
     m_jack_auto_connect         (true),
+    m_jack_lazy_connect         (false),
     m_jack_use_offset           (true),
+    m_jack_period_sync          (false),
     m_jack_buffer_size          (0),
     m_song_start_mode           (sequence::playback::automatic),
     m_song_start_is_auto        (true),
@@ -116,6 +137,29 @@ rcsettings::rcsettings () :
     m_print_keys                (false),
     m_interaction_method        (interaction::seq24),
     m_sets_mode                 (setsmode::normal),
+    m_output_scheduler          (scheduler::microsleep),
+    m_alsa_lookahead_ms         (0),
+    m_portmidi_latency_ms       (0),
+    m_latency_probe_out         (-1),
+    m_latency_probe_in          (-1),
+    m_latency_test_clicks       (0),        /* only from the command line   */
+    m_sysex_rate                (c_sysex_rate_default),
+    m_jack_ringbuffer_size      (c_jack_ringbuffer_default),
+    m_output_workers            (0),
+    m_output_stats_s            (0),
+    m_midi_clock_follow         (true),
+    m_input_capture             (),
+    m_metrics_port              (0),
+    m_osc_control_port          (0),
+    m_link_sync                 (false),
+    m_link_quantum              (c_link_quantum_default),
+    m_mirror_role               (mirrorrole::none),
+    m_mirror_host               ("localhost"),
+    m_mirror_port               (0),
+    m_rtp_midi_peers            (),
+    m_rtp_midi_port             (c_rtp_midi_port_default),
+    m_rtp_midi_lookahead_ms     (c_rtp_midi_lookahead_default),
+    m_state_mirror              (),
     m_port_naming               (portname::brief),
     m_midi_filename             (),
     m_midi_filepath             (),
@@ -171,6 +215,11 @@ rcsettings::rcsettings () :
  *
  *      m_clocks.clear();
  *      m_inputs.clear();
+ *      m_thru_routes.clear();
+ *      m_input_latencies.clear();
+ *      m_output_filters.clear();
+ *      m_input_filters.clear();
+ *      m_output_bandwidths.clear();
  *      m_mute_groups.clear();
  *      m_keycontainer.clear();              // what is best?
  *      m_midi_control_in.clear();           // what is best?
@@ -184,6 +233,11 @@ rcsettings::set_defaults ()
      * basesettings
      * m_clocks
      * m_inputs
+     * m_thru_routes
+     * m_input_latencies
+     * m_output_filters
+     * m_input_filters
+     * m_output_bandwidths
      * m_keycontainer
      * m_midi_control_in
      * m_midi_control_out
@@ -200,12 +254,22 @@ rcsettings::set_defaults ()
     m_session_tag.clear();
     m_save_old_triggers         = false;
     m_save_old_mutes            = false;
+    m_save_in_background        = false;
+    m_journal_interval          = 0;
     m_allow_mod4_mode           = false;
     m_allow_snap_split          = false;
     m_allow_click_edit          = true;
     m_show_midi                 = false;
     m_priority                  = false;
     m_thread_priority           = 0;        /* c_thread_priority            */
+    m_rt_safe                   = false;
+    m_output_policy             = "fifo";
+    m_output_priority           = 0;
+    m_output_cpus.clear();
+    m_input_policy              = "fifo";
+    m_input_priority            = 0;
+    m_input_cpus.clear();
+    m_worker_cpus.clear();
     m_pass_sysex                = false;
     m_with_jack_transport       = false;
     m_with_jack_master          = false;
@@ -216,8 +280,14 @@ rcsettings::set_defaults ()
     m_with_jack_midi            = false;
 #endif
     m_with_alsa_midi            = false;    /* unless ALSA gets selected    */
+    m_with_null_midi            = false;    /* only from the command line   */
+    m_last_midi_api.clear();
+    m_null_midi_loopback        = false;
+    m_session_log.clear();
     m_jack_auto_connect         = true;
+    m_jack_lazy_connect         = false;
     m_jack_use_offset           = true;
+    m_jack_period_sync          = false;
     m_jack_buffer_size          = 0;
     m_song_start_mode           = sequence::playback::automatic;
     m_song_start_is_auto        = true;
@@ -232,6 +302,29 @@ rcsettings::set_defaults ()
     m_print_keys                = false;
     m_interaction_method        = interaction::seq24;
     m_sets_mode                 = setsmode::normal;
+    m_output_scheduler          = scheduler::microsleep;
+    m_alsa_lookahead_ms         = 0;
+    m_portmidi_latency_ms       = 0;
+    m_latency_probe_out         = -1;
+    m_latency_probe_in          = -1;
+    m_latency_test_clicks       = 0;
+    m_sysex_rate                = c_sysex_rate_default;
+    m_jack_ringbuffer_size      = c_jack_ringbuffer_default;
+    m_output_workers            = 0;
+    m_output_stats_s            = 0;
+    m_midi_clock_follow         = true;
+    m_input_capture.clear();
+    m_metrics_port              = 0;
+    m_osc_control_port          = 0;
+    m_link_sync                 = false;
+    m_link_quantum              = c_link_quantum_default;
+    m_mirror_role               = mirrorrole::none;
+    m_mirror_host               = "localhost";
+    m_mirror_port               = 0;
+    m_rtp_midi_peers.clear();
+    m_rtp_midi_port             = c_rtp_midi_port_default;
+    m_rtp_midi_lookahead_ms     = c_rtp_midi_lookahead_default;
+    m_state_mirror.clear();
     m_port_naming               = portname::brief;
     m_midi_filename.clear();
     m_midi_filepath.clear();
@@ -1593,6 +1686,177 @@ rcsettings::sets_mode_string (setsmode v) const
     return result;
 }
 
+void
+rcsettings::output_scheduler (const std::string & v)
+{
+    if (v == "deadline")
+        m_output_scheduler = scheduler::deadline;
+    else if (v == "jack")
+        m_output_scheduler = scheduler::jack;
+    else
+        m_output_scheduler = scheduler::microsleep;
+}
+
+/**
+ *  Checks a thread scheduling policy from the 'rc' file.
+ *
+ * \return
+ *      Returns "rr" or "other" if given, and "fifo" for anything else.
+ */
+
+std::string
+rcsettings::thread_policy (const std::string & v)
+{
+    if (v == "rr" || v == "other")
+        return v;
+
+    return std::string("fifo");
+}
+
+/**
+ *  Sets the directory for the capture of all MIDI input, or turns the
+ *  capture off if the name is empty or missing.
+ */
+
+void
+rcsettings::input_capture (const std::string & v)
+{
+    std::string d = strip_quotes(v);
+    if (is_questionable_string(d) || is_missing_string(d))
+        d.clear();
+
+    m_input_capture = d;
+}
+
+/**
+ *  Gets the input-capture directory, relative to the home configuration
+ *  directory unless it is a full path.
+ *
+ * \return
+ *      Returns an empty string if input capture is off.
+ */
+
+std::string
+rcsettings::input_capture_directory () const
+{
+    std::string result = m_input_capture;
+    if (! result.empty() && ! name_has_root_path(result))
+        result = pathname_concatenate(home_config_directory(), result);
+
+    return result;
+}
+
+/**
+ *  Gets the session-log file name, relative to the home configuration
+ *  directory unless it is a full path.
+ *
+ * \return
+ *      Returns an empty string if the session log is off.
+ */
+
+std::string
+rcsettings::session_log_filename () const
+{
+    std::string result = m_session_log;
+    if (! result.empty() && ! name_has_root_path(result))
+        result = filename_concatenate(home_config_directory(), result);
+
+    return result;
+}
+
+/**
+ *  Checks a CPU list from the 'rc' file, such as "2,3" or "4-7".
+ *
+ * \return
+ *      Returns the list, or an empty string if it is missing or has anything
+ *      but digits, commas, and dashes.
+ */
+
+std::string
+rcsettings::cpu_list (const std::string & v)
+{
+    std::string result;
+    if (! is_questionable_string(v) && ! is_missing_string(v))
+    {
+        if (v.find_first_not_of("0123456789,-") == std::string::npos)
+            result = v;
+    }
+    return result;
+}
+
+std::string
+rcsettings::output_scheduler_string () const
+{
+    return output_scheduler_string(output_scheduler());
+}
+
+std::string
+rcsettings::output_scheduler_string (scheduler v) const
+{
+    std::string result;
+    switch (v)
+    {
+        case scheduler::microsleep: result = "microsleep";  break;
+        case scheduler::deadline:   result = "deadline";    break;
+        case scheduler::jack:       result = "jack";        break;
+        default:                    result = "unknown";     break;
+    }
+    return result;
+}
+
+void
+rcsettings::mirror_role (const std::string & v)
+{
+    if (v == "primary")
+        m_mirror_role = mirrorrole::primary;
+    else if (v == "replica")
+        m_mirror_role = mirrorrole::replica;
+    else
+        m_mirror_role = mirrorrole::none;
+}
+
+std::string
+rcsettings::mirror_role_string () const
+{
+    return mirror_role_string(mirror_role());
+}
+
+std::string
+rcsettings::mirror_role_string (mirrorrole v) const
+{
+    std::string result;
+    switch (v)
+    {
+        case mirrorrole::none:      result = "none";        break;
+        case mirrorrole::primary:   result = "primary";     break;
+        case mirrorrole::replica:   result = "replica";     break;
+        default:                    result = "unknown";     break;
+    }
+    return result;
+}
+
+/**
+ *  Sets the name of the shared-memory segment of the state mirror.  A
+ *  leading slash is dropped, as the segment's path adds one.  A name with
+ *  any other slash is not valid for shm_open(), and disables the mirror.
+ *
+ * \param name
+ *      The segment name, such as "seq66".  Empty means no mirror.
+ */
+
+void
+rcsettings::state_mirror (const std::string & name)
+{
+    std::string n = name;
+    if (! n.empty() && n[0] == '/')
+        n.erase(0, 1);
+
+    if (n.find('/') == std::string::npos)
+        m_state_mirror = n;
+    else
+        m_state_mirror.clear();
+}
+
 void
 rcsettings::port_naming (const std::string & v)
 {
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-10-04
- * \updates       2023-09-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Here is a list of many scale interval patterns if working with
@@ -208,269 +208,162 @@ rotate_scale_right (bool p [c_octave_size])
     p[0] = last;
 }
 
-static void
-rotate_transpose_right (int p [c_octave_size])
-{
-    int lastindex = c_octave_size - 1;
-    int last = p[lastindex];                    /* p[11]            */
-    for (int n = lastindex; n > 0; --n)         /* p[11] to p[1]    */
-        p[n] = p[n - 1];
-
-    p[0] = last;
-}
-
 /**
- *  Increment values needed to transpose each scale up so that it remains in
- *  the exact same key, for harmonic transposition.  For example, if we simply
- *  add 1 semitone to each note, it remains a minor key, but it is in a
- *  different minor key.  Using the transpositions in these arrays, the minor
- *  key remains the same minor key.
+ *  Lookup tables for each scale, key, and note, built once from the
+ *  c_scales_policy[] arrays.
+ *
+ *  Each scale and key is laid out as a ladder of its notes, from an octave
+ *  below note 0 to an octave above note 127.  Each note then gets the rung
+ *  of the nearest scale note at or below it, and its distance above that
+ *  rung, which is 0 for a note in the scale.  Transposing harmonically by
+ *  some steps moves that many rungs up or down the ladder and adds the
+ *  distance back, so that, for example, if we simply add 1 semitone to
+ *  each note, it remains a minor key, but it is in a different minor key;
+ *  moving up the ladder, the minor key remains the same minor key.
  *
 \verbatim
     Major               C  .  D  .  E  F  .  G  .  A  .  B
-    Transpose up        2  .  2  .  1  2  .  2  .  2  .  1
     Result up           D  .  E  .  F  G  .  A  .  B  .  C
+    Result down         B  .  C  .  D  E  .  F  .  G  .  A
 \endverbatim
  *
-\verbatim
-    Minor               C  .  D  D# .  F  .  G  G# .  A# .
-    Transpose up        2  .  1  2  .  2  .  1  2  .  2  .
-    Result up           D  .  D# F  .  G  .  G# A# .  C  .
-\endverbatim
- *
-\verbatim
-    Harmonic minor      C  .  D  Eb .  F  .  G  Ab .  .  B
-    Transpose up        2  .  1  2  .  2  .  1  3  .  .  1
-    Result up           D  .  Eb F  .  G  .  Ab B  .  .  C
-\endverbatim
- *
-\verbatim
-    Melodic minor       C  .  D  Eb .  F  .  G  .  A  .  B
-    Transpose up        2  .  1  2  .  2  .  2  .  2  .  1
-    Result up           D  .  Eb F  .  G  .  A  .  B  .  C
-\endverbatim
- *
-\verbatim
-    C Whole Tone        C  .  D  .  E  .  F# .  G# .  A# .
-    Transpose up        2  .  2  .  2  .  2  .  2  .  2  .
-    Result up           D  .  E  .  F# .  G# .  A# .  C  .
-\endverbatim
- *
-\verbatim
-    Minor Blues         C  .  .  Eb .  F  Gb G  .  .  Bb .
-    Transpose up        3  .  .  2  .  1  1  3  .  .  2  .
-    Result up           Eb .  .  F  .  Gb G  Bb .  .  C  .
-\endverbatim
- *
-\verbatim
-    Major Pentatonic    C  .  D  .  E  .  .  G  .  A  .  .
-    Transpose up        2  .  2  .  3  .  .  2  .  3  .  .
-    Result up           D  .  E  .  G  .  .  A  .  C  .  .
-\endverbatim
- *
-\verbatim
-    Minor Pentatonic    C  .  .  Eb .  F  .  G  .  .  Bb .
-    Transpose up        3  .  .  2  .  2  .  3  .  .  2  .
-    Result up           Eb .  .  F  .  G  .  Bb .  .  C  .
-\endverbatim
- *
- \verbatim
-    Phrygian            C  Db .  Eb .  F  .  G  Ab .  Bb .
-    Transpose up        1  2  .  2  .  2  .  1  2  .  2  .
-    Result up           D  Eb .  F  .  G  .  A  Bb .  C  .
-\endverbatim
- *
- \verbatim
-    Enigmatic           C  Db .  .  E  .  F# .  G# .  A# B
-    Transpose up        1  3  .  .  2  .  2  .  2  .  1  1
-    Result up           Db E  .  .  F# .  G# .  A# .  B  C
-\endverbatim
- *
- \verbatim
-    Diminished          C  .  D  Eb .  F  Gb .  Ab A  .  B
-    Transpose up        2  .  1  2  .  1  2  .  1  2  .  1
-    Result up           D  .  Eb F  .  Gb Ab .  A  B  .  C
-\endverbatim
- *
- \verbatim
-    Dorian Mode         C  .  D  Eb .  F  .  G  .  A  Bb .
-    Transpose up        2  .  1  2  .  2  .  2  .  1  2  .
-    Result up           D  .  Eb F  .  G  .  A  .  Bb C  .
-\endverbatim
- *
- \verbatim
-    Mixolydian Mode     C  .  D  .  E  F  .  G  .  A  Bb .
-    Transpose up        2  .  2  .  1  2  .  2  .  1  2  .
-    Result up           D  .  E  .  F  G  .  A  .  Bb .  C
-\endverbatim
- *
- *  Note that the D Dorian scale is all white keys: D E F G A B C D.
- *  The "result up" shown above is for a transposition that preserves the
- *  C Dorian scale.
+ *  A note off the scale moves with the scale note below it.  For the
+ *  chromatic scale ("off"), every note is a rung, and this is plain
+ *  transposition.
  *
- *  The Mixolydian scale starts on the 5th note of the Major scale and ends on
- *  the fifth note. For instance, the C Major scale is C, D, E, F, G, A, B,
- *  and C. The fifth note of C Major is G. Therefore the 5th mode of C Major
- *  is G Mixolydian: G, A, B, C, D, E, F, and G.  It is sometimes referred to
- *  as the Dominant 7th scale.
+ *  These tables replace the hand-written per-scale increments formerly
+ *  used by sequence::transpose_notes(), which rotated a copy of them for
+ *  every call with a key, and had a few entries that did not match the
+ *  scales (Phrygian and Major Pentatonic down, Mixolydian down from F).
  */
 
-const int *
-scales_up (int scale, int key)
+class scale_tables
 {
-    static const int c_scales_transpose_up [c_scales_max] [c_octave_size] =
-    {
-        { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},          /* off = chromatic  */
-        { 2, 0, 2, 0, 1, 2, 0, 2, 0, 2, 0, 1},          /* major            */
-        { 2, 0, 1, 2, 0, 2, 0, 1, 2, 0, 2, 0},          /* minor            */
-        { 2, 0, 1, 2, 0, 2, 0, 1, 3, 0, 0, 1},          /* harmonic minor   */
-        { 2, 0, 1, 2, 0, 2, 0, 2, 0, 2, 0, 1},          /* melodic minor    */
-        { 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0},          /* C whole tone     */
-        { 3, 0, 0, 2, 0, 1, 1, 3, 0, 0, 2, 0},          /* minor blues      */
-        { 2, 0, 2, 0, 3, 0, 0, 2, 0, 3, 0, 0},          /* maj pentatonic   */
-        { 3, 0, 0, 2, 0, 2, 0, 3, 0, 0, 2, 0},          /* min pentatonic   */
-        { 1, 2, 0, 2, 0, 2, 0, 1, 2, 0, 2, 0},          /* phrygian         */
-        { 1, 3, 0, 0, 2, 0, 2, 0, 2, 0, 1, 1},          /* enigmatic        */
-        { 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1},          /* diminished       */
-        { 2, 0, 1, 2, 0, 2, 0, 2, 0, 1, 2, 0},          /* dorian           */
-        { 2, 0, 2, 0, 1, 2, 0, 2, 0, 1, 2, 0}           /* mixolydian       */
-    };
-    if (key > 0)
+
+public:
+
+    /**
+     *  The most rungs in a ladder: the chromatic scale over the 128 notes
+     *  plus an octave at each end.
+     */
+
+    static const int c_rungs_max = c_notes_count + 2 * c_octave_size;
+
+    int st_rung_count [c_scales_max] [c_octave_size];
+    short st_rungs [c_scales_max] [c_octave_size] [c_rungs_max];
+    midibyte st_rung [c_scales_max] [c_octave_size] [c_notes_count];
+    midibyte st_above [c_scales_max] [c_octave_size] [c_notes_count];
+
+public:
+
+    scale_tables ();
+
+};
+
+scale_tables::scale_tables ()
+{
+    for (int s = 0; s < c_scales_max; ++s)
     {
-        static int rotated_scale[c_octave_size];
         for (int k = 0; k < c_octave_size; ++k)
-            rotated_scale[k] = c_scales_transpose_up[scale][k];
+        {
+            int count = 0;
+            for (int n = -c_octave_size; n < c_notes_count + c_octave_size; ++n)
+            {
+                int degree = (n - k + 2 * c_octave_size) % c_octave_size;
+                if (c_scales_policy[s][degree])
+                    st_rungs[s][k][count++] = short(n);
+            }
+            st_rung_count[s][k] = count;
 
-        for (int count = key; count > 0; --count)
-            rotate_transpose_right(rotated_scale);
+            int r = 0;
+            for (int n = 0; n < c_notes_count; ++n)
+            {
+                while (r + 1 < count && st_rungs[s][k][r + 1] <= n)
+                    ++r;
 
-        return &rotated_scale[0];
+                st_rung[s][k][n] = midibyte(r);
+                st_above[s][k][n] = midibyte(n - st_rungs[s][k][r]);
+            }
+        }
     }
-    else
-        return &c_scales_transpose_up[scale][0];
 }
 
 /**
- *  Making these positive makes it easier to read, but the actual array
- *  contains negative values.
- *
-\verbatim
-    Semitone Number     1  2  3  4  5  6  7  8  9 10 11 12
-    Chromatic (Off)     C  .  D  .  E  F  .  G  .  A  .  B
-\endverbatim
- *
-\verbatim
-    Major               C  .  D  .  E  F  .  G  .  A  .  B
-    Transpose down      1  .  2  .  2  1  .  2  .  2  .  2
-    Result down         B  .  C  .  D  E  .  F  .  G  .  A
-\endverbatim
- *
-\verbatim
-    Minor               C  .  D  D# .  F  .  G  G# .  A# .
-    Transpose down      2  .  2  1  .  2  .  2  1  .  2  .
-    Result down         A# .  C  D  .  D# .  F  G  .  G# .
-\endverbatim
- *
-\verbatim
-    Harmonic minor      C  .  D  Eb .  F  .  G  Ab .  .  B
-    Transpose down      1  .  2  1  .  2  .  2  1  .  .  3
-    Result down         B  .  C  D  .  Eb .  F  G  .  .  Ab
-\endverbatim
- *
-\verbatim
-    Melodic minor       C  .  D  Eb .  F  .  G  .  A  .  B
-    Transpose down      1  .  2  1  .  2  .  2  .  2  .  2
-    Result down         B  .  C  D  .  Eb .  F  .  G  .  A
-\endverbatim
+ *  The tables are built on first use, which the C++11 rules for local
+ *  statics make thread-safe.  They take about 90 KB.
+ */
+
+static const scale_tables &
+tables ()
+{
+    static const scale_tables s_tables;
+    return s_tables;
+}
+
+/**
+ *  Indicates if a note is in a scale of the given key.
  *
-\verbatim
-    C whole tone        C  .  D  .  E  .  F# .  G# .  A# .
-    Transpose down      2  .  2  .  2  .  2  .  2  .  2  .
-    Result down         A# .  C  .  D  .  E  .  F# .  G# .
-\endverbatim
+ * \param s
+ *      The scale.
  *
-\verbatim
-    Minor Blues         C  .  .  Eb .  F  Gb G  .  .  Bb .
-    Transpose down      2  .  .  3  .  2  1  1  .  .  3  .
-    Result down         Bb .  .  C  .  Eb F  Gb .  .  G  .
-\endverbatim
+ * \param key
+ *      The key, where 0 is C.
  *
-\verbatim
-    Major Pentatonic    C  .  D  .  E  .  .  G  .  A  .  .
-    Transpose down      3  .  2  .  2  .  .  3  .  2  .  .
-    Result down         A  .  C  .  D  .  .  E  .  G  .  .
-\endverbatim
+ * \param note
+ *      The note, 0 to 127.
  *
-\verbatim
-    Minor Pentatonic    C  .  .  Eb .  F  .  G  .  .  Bb .
-    Transpose down      2  .  .  3  .  2  .  2  .  .  3  .
-    Result down         Bb .  .  C  .  Eb .  F  .  .  G  .
-\endverbatim
+ * \return
+ *      Returns true if the note is in the scale, or if any value is out of
+ *      range.
+ */
+
+bool
+scales_policy (scales s, int key, int note)
+{
+    int sc = int(s);
+    bool result = true;
+    if (legal_scale(sc) && legal_key(key) && legal_note(note))
+        result = tables().st_above[sc][key][note] == 0;
+
+    return result;
+}
+
+/**
+ *  Transposes a note by the given number of steps of a scale.
  *
-  \verbatim
-    Phrygian            C  Db .  Eb .  F  .  G  Ab .  Bb .
-    Transpose down      1  1  .  1  .  1  .  1  1  .  1  .
-    Result down         B  C  .  D  .  E  .  Fb G  .  A  .
-\endverbatim
+ * \param scale
+ *      The scale.  If 0 (scales::off), this is straight transposition.
  *
-  \verbatim
-    Enigmatic           C  Db .  .  E  .  F# .  G# .  A# B
-    Transpose down      1  1  .  .  3  .  2  .  2  .  2  1
-    Result down         B  C  .  .  Db .  E  .  F# .  G# A#
-\endverbatim
+ * \param key
+ *      The key, where 0 is C.
  *
-  \verbatim
-    Diminished          C  .  D  Eb .  F  Gb .  Ab A  .  B
-    Transpose down      1  .  2  1  .  2  1  .  2  1  .  2
-    Result down         B  .  C  D  .  Eb F  .  Gb Ab .  A
-\endverbatim
+ * \param note
+ *      The note to transpose.
  *
- \verbatim
-    Dorian Mode         C  .  D  Eb .  F  .  G  .  A  Bb .
-    Transpose down      2  .  2  1  .  2  .  2  .  2  1  .
-    Result down         Bb .  C  D  .  Eb .  F  .  G  A  .
-\endverbatim
+ * \param steps
+ *      The number of scale steps, up if positive.
  *
- \verbatim
-    Mixolydian Mode     C  .  D  .  E  F  .  G  .  A  Bb .
-    Transpose down      2  .  2  .  2  1  .  2  .  2  1  .
-    Result down         Bb .  C  .  D  E  .  F  .  G  A  .
-\endverbatim
+ * \return
+ *      Returns the transposed note.  If it does not fit in 0 to 127, or a
+ *      parameter is out of range, the note is returned unchanged.
  */
 
-const int *
-scales_down (int scale, int key)
+int
+harmonic_transpose (int scale, int key, int note, int steps)
 {
-    static const int c_scales_transpose_dn [c_scales_max] [c_octave_size] =
+    int result = note;
+    if (legal_scale(scale) && legal_key(key) && legal_note(note))
     {
-        { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* off = chromatic */
-        { -1,  0, -2,  0, -2, -1,  0, -2,  0, -2,  0, -2}, /* major (ionian)  */
-        { -2,  0, -2, -1,  0, -2,  0, -2, -1,  0, -2,  0}, /* minor (aeolian) */
-        { -1,  0, -2, -1,  0, -2,  0, -2, -1,  0,  0, -3}, /* harmonic minor  */
-        { -1,  0, -2, -1,  0, -2,  0, -2,  0, -2,  0, -2}, /* melodic minor   */
-        { -2,  0, -2,  0, -2,  0, -2,  0, -2,  0, -2,  0}, /* C whole tone    */
-        { -2,  0,  0, -3,  0, -2, -1, -1,  0,  0, -3,  0}, /* minor blues     */
-        { -3,  0, -2, -0,  2,  0,  0, -3,  0, -2,  0,  0}, /* maj pentatonic  */
-        { -2,  0,  0, -3,  0, -2,  0, -2,  0,  0, -3,  0}, /* min pentatonic  */
-        { -1, -1,  0, -1,  0, -1,  0, -1, -1,  0, -1,  0}, /* phrygian        */
-        { -1, -1,  0,  0, -3,  0, -2,  0, -2,  0, -2, -1}, /* enigmatic       */
-        { -1,  0, -2, -1,  0, -2, -1,  0, -2, -1,  0, -2}, /* diminished      */
-        { -2,  0, -2, -1,  0, -2,  0, -2,  0, -2, -1,  0}, /* dorian          */
-        { -2,  0, -2,  0, -2,  1,  0, -2,  0, -2, -1,  0}  /* mixolydian      */
-    };
-    if (key > 0)
-    {
-        static int rotated_scale[c_octave_size];
-        for (int k = 0; k < c_octave_size; ++k)
-            rotated_scale[k] = c_scales_transpose_dn[scale][k];
-
-        for (int count = key; count > 0; --count)
-            rotate_transpose_right(rotated_scale);
-
-        return &rotated_scale[0];
+        const scale_tables & t = tables();
+        int rung = int(t.st_rung[scale][key][note]) + steps;
+        if (rung >= 0 && rung < t.st_rung_count[scale][key])
+        {
+            int n = t.st_rungs[scale][key][rung] + t.st_above[scale][key][note];
+            if (legal_note(n))
+                result = n;
+        }
     }
-    else
-        return &c_scales_transpose_dn[scale][0];
+    return result;
 }
 
 static const std::string
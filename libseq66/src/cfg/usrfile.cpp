@@ -26,7 +26,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2024-12-24
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Note that the parse function has some code that is not yet enabled.
@@ -50,7 +50,7 @@ namespace seq66
 
 static const int s_usr_legacy       =  5;
 static const int s_usr_smf_1        =  8;
-static const int s_usr_file_version = 14;
+static const int s_usr_file_version = 15;
 
 /**
  *  Principal constructor.
@@ -69,6 +69,7 @@ static const int s_usr_file_version = 14;
  *     12:  2023-11-02: Moved style-sheets to the 'rc' file.
  *     13:  2024-02-23: Added elliptical progress-box option.
  *     14:  2024-02-23: Added progress-bar-thickness and gridlines-thick.
+ *     15:  2026-10-14: Added gpu-rendering.
  *
  * \param name
  *      Provides the full file path specification to the configuration file.
@@ -286,13 +287,20 @@ usrfile::parse ()
 
         int cols = get_integer(file, tag, "mainwnd-columns");
         (void) usr().mainwnd_cols(cols);
+        flag = get_boolean(file, tag, "global-seq-feature");
+        usr().global_seq_feature(flag);
+
+#if ! defined SEQ66_LEAN_ENGINE
+
+        /*
+         * The rest of this section is look-and-feel, which the lean engine
+         * leaves at the defaults.
+         */
 
         int scratch = get_integer(file, tag, "mainwnd-spacing");
         usr().mainwnd_spacing(scratch);
         scratch = get_integer(file, tag, "default-zoom");
         usr().zoom(scratch);
-        flag = get_boolean(file, tag, "global-seq-feature");
-        usr().global_seq_feature(flag);
         flag = get_boolean(file, tag, "progress-bar-thick");
         usr().progress_bar_thick(flag);
         scratch = get_integer(file, tag, "progress-bar-thickness");
@@ -327,6 +335,8 @@ usrfile::parse ()
         usr().dark_theme(flag);
         scratch = get_integer(file, tag, "window-redraw-rate");
         usr().window_redraw_rate(scratch);
+        flag = get_boolean(file, tag, "gpu-rendering");
+        usr().gpu_rendering(flag);
 
         double scale = get_float(file, tag, "window-scale");
         double scaley = get_float(file, tag, "window-scale-y");
@@ -336,6 +346,7 @@ usrfile::parse ()
             file, tag, "enable-learn-confirmation", 0, true
         );
         usr().enable_learn_confirmation(flag);
+#endif
     }
     usr().normalize();                                  /* recalculate      */
 
@@ -469,6 +480,7 @@ usrfile::parse ()
     tag = "[user-ui-tweaks]";
     if (line_after(file, tag))
     {
+#if ! defined SEQ66_LEAN_ENGINE
         int scratch = 0;
         int count = sscanf(scanline(), "%d", &scratch);
         if (count == 1)
@@ -482,12 +494,13 @@ usrfile::parse ()
             usr().key_height(h);
         }
 
-        std::string s = get_variable(file, tag, "key-view");
-        usr().key_view(s);
+        usr().key_view(get_variable(file, tag, "key-view"));
+#endif
 
         bool flag = get_boolean(file, tag, "note-resume");
         usr().resume_note_ons(flag);
 
+#if ! defined SEQ66_LEAN_ENGINE
 #if defined USE_USR_STYLE_SHEET
 
         /*
@@ -497,14 +510,14 @@ usrfile::parse ()
         flag = get_boolean(file, tag, "style-sheet-active");
         usr().style_sheet_active(flag);
 
-        s = get_variable(file, tag, "style-sheet");
+        std::string s = get_variable(file, tag, "style-sheet");
         usr().style_sheet(strip_quotes(s));
         if (s.empty())
             usr().style_sheet_active(false);
 
 #else
 
-        s = get_variable(file, tag, "style-sheet");
+        std::string s = get_variable(file, tag, "style-sheet");
         if (! is_questionable_string(s))
         {
             rc().style_sheet_filename(strip_quotes(s));
@@ -537,6 +550,7 @@ usrfile::parse ()
         usr().progress_note_min_max(v, x);
         flag = get_boolean(file, tag, "lock-main-window");
         usr().lock_main_window(flag);
+#endif  // ! defined SEQ66_LEAN_ENGINE
     }
     tag = "[user-session]";
 
@@ -585,6 +599,9 @@ usrfile::parse ()
     flag = get_boolean(file, tag, "wrap-around");
     usr().pattern_wraparound(flag);
 
+    int undolimit = get_integer(file, tag, "undo-limit");
+    usr().undo_limit(undolimit);                /* ignored if missing   */
+
     /*
      * Consider:
      *
@@ -673,7 +690,7 @@ usrfile::parse_daemonization (bool & startdaemon, std::string & logfile)
 bool
 usrfile::write ()
 {
-    std::ofstream file(name().c_str(), std::ios::out | std::ios::trunc);
+    std::ofstream file(write_name(), std::ios::out | std::ios::trunc);
     if (file.is_open())
     {
         file_message("Write usr", name());
@@ -872,6 +889,10 @@ usrfile::write ()
 "# 'window-redraw-rate' specifies the base window redraw rate for all windows.\n"
 "# From 10 to 100; default = 40 ms (25 ms for Windows).\n"
 "#\n"
+"# 'gpu-rendering' draws the piano roll and the song editor with OpenGL, for\n"
+"# large songs on high-resolution displays. Needs a build with OpenGL support\n"
+"# (./configure --enable-opengl, or qmake CONFIG+=opengl). Default = false.\n"
+"#\n"
 "# Window-scale (option '-o scale=m.n[xp.q]') specifies scaling the main\n"
 "# window at startup. Defaults to 1.0 x 1.0. If between 0.5 and 3.0, it\n"
 "# changes the size of the main window proportionately.\n"
@@ -902,6 +923,7 @@ usrfile::write ()
     write_string(file, "time-bg-color", usr().time_bg_color(true), true);
     write_boolean(file, "dark-theme", usr().dark_theme());
     write_integer(file, "window-redraw-rate", usr().window_redraw_rate());
+    write_boolean(file, "gpu-rendering", usr().gpu_rendering());
     write_float(file, "window-scale", usr().window_scale());
     write_float(file, "window-scale-y", usr().window_scale_y());
     write_boolean
@@ -1117,6 +1139,10 @@ usrfile::write ()
 "# 'expand', and 'one-shot'. 'wrap-around' allows recorded notes to wrap\n"
 "# to the pattern beginning. Currently 'notemap' and quantizing are\n"
 "# are mutually exclusive.\n"
+"#\n"
+"# 'undo-limit' is the memory, in megabytes (0 to 4096), kept for the\n"
+"# undo/redo history of each pattern.  The oldest changes are forgotten\n"
+"# first.  0 means no limit.\n"
 "\n[pattern-editor]\n\n"
         ;
     write_boolean(file, "escape-pattern", usr().escape_pattern());
@@ -1129,9 +1155,9 @@ usrfile::write ()
     write_boolean(file, "notemap", usr().pattern_notemap());
     write_string(file, "record-style", usr().pattern_record_string());
     write_boolean(file, "wrap-around", usr().pattern_wraparound());
+    write_integer(file, "undo-limit", usr().undo_limit());
     write_seq66_footer(file);
-    file.close();
-    return true;
+    return finish_write(file, true);
 }
 
 }           // namespace seq66
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-23
- * \updates       2024-12-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Note that this module also sets the remaining legacy global variables, so
@@ -345,6 +345,7 @@ usrsettings::usrsettings () :
     m_time_bg_color             ("default"),
     m_dark_theme                (false),
     m_window_redraw_rate_ms     (c_default_redraw_ms),
+    m_gpu_rendering             (false),
 
     /*
      * The members that follow are not yet part of the .usr file.
@@ -426,6 +427,7 @@ usrsettings::usrsettings () :
     m_pattern_new_only          (false),
     m_pattern_record_style      (recordstyle::merge),
     m_pattern_wraparound        (false),
+    m_undo_limit                (c_undo_limit_default),
     m_record_alteration         (alteration::none),
     m_grid_mode                 (gridmode::loop),
     m_enable_learn_confirmation (true)
@@ -468,6 +470,7 @@ usrsettings::set_defaults ()
     m_time_bg_color = "default";
     m_dark_theme = false;
     m_window_redraw_rate_ms = c_default_redraw_ms;
+    m_gpu_rendering = false;
     m_seqchars_x = 15;
     m_seqchars_y =  5;
     m_convert_to_smf_1 = true;
@@ -537,6 +540,7 @@ usrsettings::set_defaults ()
     m_pattern_new_only = false;
     m_pattern_record_style = recordstyle::merge;
     m_pattern_wraparound = false;
+    m_undo_limit = c_undo_limit_default;
     m_record_alteration = alteration::none;
     m_grid_mode = gridmode::loop;
     m_enable_learn_confirmation = true;
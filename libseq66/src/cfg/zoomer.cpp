@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2023-09-08
- * \updates       2024-12-17
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Refactoring:
@@ -57,6 +57,15 @@
  *      ||...:...:...:...|...:...:. . . . ..:...|...:...:...:...||
  */
 
+#include "seq66_features.h"             /* SEQ66_LEAN_ENGINE                */
+
+/*
+ *  Only the user-interface uses the zoomer, so the lean engine leaves it
+ *  out.
+ */
+
+#if ! defined SEQ66_LEAN_ENGINE
+
 #include "cfg/settings.hpp"             /* seq66::zoom_items()              */
 #include "cfg/zoomer.hpp"               /* seq66::zoomer class              */
 
@@ -269,8 +278,10 @@ zoomer::zoom_power_of_2 (int ppqn)
 
 }           // namespace seq66
 
+#endif      // ! defined SEQ66_LEAN_ENGINE
+
 /*
- * settings.cpp
+ * zoomer.cpp
  *
  * vim: sw=4 ts=4 wm=4 et ft=cpp
  */
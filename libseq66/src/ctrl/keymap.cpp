@@ -25,11 +25,13 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-12
- * \updates       2023-12-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  */
 
+#include <array>                        /* std::array<>                     */
 #include <map>                          /* std::map and std::multimap       */
+#include <vector>                       /* std::vector<>                    */
 
 #include "ctrl/keymap.hpp"              /* keymap function declarations     */
 #include "util/strfunctions.hpp"        /* contains()                       */
@@ -787,6 +789,133 @@ keyname_map ()
     return s_keyname_map;
 }
 
+/**
+ *  The direct table used by qt_modkey_ordinal() for the keys pressed while
+ *  playing, so that a key is found without searching the multimap above.
+ *  It is rebuilt with the key maps, so it follows a change of the keyboard
+ *  layout.
+ *
+ *  The Qt key-codes are either below 0x100 (Latin-1) or just above
+ *  0x01000000 (Key_Escape and the other special keys); both ranges are
+ *  folded into c_key_slots entries.  A key made by just one entry of the
+ *  multimap has its ordinal in its entry, as the multimap search then
+ *  ignores the modifiers.  A key with several entries has a row of
+ *  ordinals indexed by the six Qt modifier bits (Shift to GroupSwitch).
+ *  Keys outside the ranges, and modifiers with other bits, are rare, and
+ *  still go to the multimap.
+ */
+
+static const int c_key_slots = 0x300;
+static const int c_modifier_shift = 25;
+static const int c_modifier_rows = 64;
+static const unsigned c_modifier_mask = 0x7e000000;
+
+/**
+ *  One modifier of a key with several entries.  The virtual key is checked
+ *  when the caller gives one; if it does not match and another entry has
+ *  the same modifier, the multimap settles it.
+ */
+
+struct qt_keyslot
+{
+    ctrlkey ks_ordinal;                     /**< The ordinal, or 0xff.      */
+    bool ks_shared;                         /**< Another entry, same mods.  */
+    eventkey ks_virtkey;                    /**< The entry's virtual key.   */
+};
+
+using qt_keyrow = std::array<qt_keyslot, c_modifier_rows>;
+
+/**
+ *  One key.  The row is -1 for a key with one entry (or none).
+ */
+
+struct qt_keyentry
+{
+    ctrlkey ke_ordinal;                     /**< The ordinal, or 0xff.      */
+    short ke_row;                           /**< The row of modifiers.      */
+};
+
+static std::vector<qt_keyentry> &
+key_table ()
+{
+    static std::vector<qt_keyentry> s_key_table;
+    return s_key_table;
+}
+
+static std::vector<qt_keyrow> &
+key_rows ()
+{
+    static std::vector<qt_keyrow> s_key_rows;
+    return s_key_rows;
+}
+
+/**
+ *  Folds a Qt key-code into the index of its key_table() entry.
+ *
+ * \return
+ *      Returns -1 if the key is not in the table's ranges.
+ */
+
+static int
+key_slot (eventkey qtkey)
+{
+    if (qtkey < 0x100)
+        return int(qtkey);
+    else if ((qtkey & 0xfffffe00) == 0x01000000)
+        return 0x100 + int(qtkey & 0x1ff);
+    else
+        return (-1);
+}
+
+/**
+ *  Fills the direct table from the key-code multimap.
+ */
+
+static void
+build_key_table (const qt_keycode_map & codes)
+{
+    const qt_keyentry noentry = { invalid_ordinal(), -1 };
+    const qt_keyslot noslot = { invalid_ordinal(), false, 0 };
+    key_table().assign(std::size_t(c_key_slots), noentry);
+    key_rows().clear();
+    for (auto ki = codes.begin(); ki != codes.end(); )
+    {
+        eventkey qtkey = ki->first;
+        auto range = codes.equal_range(qtkey);
+        int k = key_slot(qtkey);
+        ki = range.second;
+        if (k < 0)
+            continue;
+
+        qt_keyentry & ke = key_table()[std::size_t(k)];
+        if (codes.count(qtkey) == 1)
+        {
+            ke.ke_ordinal = range.first->second.qtk_ordinal;
+            continue;
+        }
+
+        qt_keyrow row;
+        row.fill(noslot);
+        for (auto ri = range.first; ri != range.second; ++ri)
+        {
+            unsigned mods = unsigned(ri->second.qtk_modifier);
+            if ((mods & ~c_modifier_mask) != 0)
+                continue;                   /* the fast lookup cannot match */
+
+            qt_keyslot & ks = row[mods >> c_modifier_shift];
+            if (is_invalid_ordinal(ks.ks_ordinal))
+            {
+                ks.ks_ordinal = ri->second.qtk_ordinal;
+                ks.ks_virtkey = ri->second.qtk_virtkey;
+            }
+            else
+                ks.ks_shared = true;
+        }
+        ke.ke_row = short(key_rows().size());
+        key_rows().push_back(row);
+    }
+}
+
 /**
  *  Returns the keymap's size.
  */
@@ -832,7 +961,9 @@ initialize_key_maps (bool reinit)
             (void) keyname_map().insert(pn);
         }
         s_are_maps_initialized = keymap_size() >= 0xfe;
-        if (! s_are_maps_initialized)
+        if (s_are_maps_initialized)
+            build_key_table(keycode_map());
+        else
             error_message("Key map unable to be initialized");
 
 #if defined SEQ66_PLATFORM_DEBUG_TMI
@@ -910,6 +1041,44 @@ ordinal_to_qt_key (ctrlkey ordinal)
     return result;
 }
 
+/**
+ *  Searches the key-code multimap for qt_modkey_ordinal(), for the keys and
+ *  modifiers that the direct table does not cover.  The maps must already
+ *  be initialized.
+ */
+
+static ctrlkey
+search_key_maps (eventkey qtkey, unsigned qtmodifier, eventkey virtkey)
+{
+    ctrlkey result = invalid_ordinal();
+    auto cqi = keycode_map().find(qtkey);      /* copy modified later! */
+    if (cqi != keycode_map().end())
+    {
+        /*
+         * std::multimap<unsigned, qt_keycodes>::size_type
+         */
+
+        auto c = keycode_map().count(qtkey);
+        bool found = c == 1;
+        if (c > 1)
+        {
+            auto p = keycode_map().equal_range(qtkey);
+            for (cqi = p.first; cqi != p.second; ++cqi)
+            {
+                found = cqi->second.qtk_modifier == qtmodifier;
+                if (found && virtkey > 0)
+                    found = cqi->second.qtk_virtkey == virtkey;
+
+                if (found)
+                    break;
+            }
+        }
+        if (found)
+            result = cqi->second.qtk_ordinal;
+    }
+    return result;
+}
+
 /**
  *  This function searches for a given keystroke, including the specified
  *  modifier.  This function lets us return different ordinals for variations
@@ -948,31 +1117,27 @@ qt_modkey_ordinal (eventkey qtkey, unsigned qtmodifier, eventkey virtkey)
     ctrlkey result = invalid_ordinal();
     if (initialize_key_maps(false))
     {
-        auto cqi = keycode_map().find(qtkey);      /* copy modified later! */
-        if (cqi != keycode_map().end())
+        int k = key_slot(qtkey);
+        bool search = k < 0 || (qtmodifier & ~c_modifier_mask) != 0;
+        if (! search)
         {
-            /*
-             * std::multimap<unsigned, qt_keycodes>::size_type
-             */
-
-            auto c = keycode_map().count(qtkey);
-            bool found = c == 1;
-            if (c > 1)
+            const qt_keyentry & ke = key_table()[std::size_t(k)];
+            if (ke.ke_row < 0)
+            {
+                result = ke.ke_ordinal;
+            }
+            else
             {
-                auto p = keycode_map().equal_range(qtkey);
-                for (cqi = p.first; cqi != p.second; ++cqi)
-                {
-                    found = cqi->second.qtk_modifier == qtmodifier;
-                    if (found && virtkey > 0)
-                        found = cqi->second.qtk_virtkey == virtkey;
-
-                    if (found)
-                        break;
-                }
+                const qt_keyrow & row = key_rows()[std::size_t(ke.ke_row)];
+                const qt_keyslot & ks = row[qtmodifier >> c_modifier_shift];
+                if (virtkey == 0 || ks.ks_virtkey == virtkey)
+                    result = ks.ks_ordinal;
+                else
+                    search = ks.ks_shared;
             }
-            if (found)
-                result = cqi->second.qtk_ordinal;
         }
+        if (search)
+            result = search_key_maps(qtkey, qtmodifier, virtkey);
     }
 
 #if defined SEQ66_PLATFORM_DEBUG_TMI
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2023-11-18
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  * MIDI control container:
@@ -71,11 +71,13 @@
  *      exits.
  */
 
+#include <algorithm>                    /* std::fill()                      */
 #include <iomanip>                      /* std::setw() manipulator          */
 #include <iostream>                     /* std::cerr                        */
 
 #include "ctrl/keycontainer.hpp"        /* seq66::keycontainer class        */
 #include "ctrl/midicontrolin.hpp"       /* seq66::midicontrolin class       */
+#include "util/basic_macros.hpp"        /* not_nullptr() macros             */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -84,6 +86,17 @@
 namespace seq66
 {
 
+/**
+ *  The range of the midicontrolin::m_lookup table: channel-message status
+ *  bytes 0x80 to 0xEF, times 128 values of d0.
+ */
+
+static const int c_lookup_status_min    = 0x80;
+static const int c_lookup_status_count  = 0x70;
+static const int c_lookup_d0_count      = 128;
+static const int c_lookup_size          =
+    c_lookup_status_count * c_lookup_d0_count;
+
 /**
  *  This constructor assigns the basic values of control name, number, and
  *  action code.  The rest of the members can be set via the set() function.
@@ -93,12 +106,58 @@ midicontrolin::midicontrolin (const std::string & name) :
     midicontrolbase     (name),
     m_container         (),
     m_comments_block    (),
+    m_inactive_allowed  (false),
     m_control_status    (automation::ctrlstatus::none),
-    m_have_controls     (false)
+    m_have_controls     (false),
+    m_lookup            (c_lookup_size, nullptr),
+    m_bound_statuses    (),
+    m_pad_map           ()
 {
    // no code
 }
 
+/**
+ *  The copy constructor.  The lookup table cannot be copied, as it points
+ *  into the container, so it is rebuilt for the new container.  (Moving
+ *  transfers the container's nodes, so the defaulted moves are fine.)
+ */
+
+midicontrolin::midicontrolin (const midicontrolin & rhs) :
+    midicontrolbase     (rhs),
+    m_container         (rhs.m_container),
+    m_comments_block    (rhs.m_comments_block),
+    m_inactive_allowed  (rhs.m_inactive_allowed),
+    m_control_status    (rhs.m_control_status),
+    m_have_controls     (rhs.m_have_controls),
+    m_lookup            (c_lookup_size, nullptr),
+    m_bound_statuses    (rhs.m_bound_statuses),
+    m_pad_map           (rhs.m_pad_map)
+{
+    rebuild_lookup();
+}
+
+/**
+ *  The copy assignment operator.  See the copy constructor.
+ */
+
+midicontrolin &
+midicontrolin::operator = (const midicontrolin & rhs)
+{
+    if (this != &rhs)
+    {
+        midicontrolbase::operator =(rhs);
+        m_container = rhs.m_container;
+        m_comments_block = rhs.m_comments_block;
+        m_inactive_allowed = rhs.m_inactive_allowed;
+        m_control_status = rhs.m_control_status;
+        m_have_controls = rhs.m_have_controls;
+        m_bound_statuses = rhs.m_bound_statuses;
+        m_pad_map = rhs.m_pad_map;
+        rebuild_lookup();
+    }
+    return *this;
+}
+
 bool
 midicontrolin::initialize (int buss, int rows, int columns)
 {
@@ -133,6 +192,11 @@ midicontrolin::add (const midicontrol & mc)
     result = m_container.size() == (sz + 1);
     if (result)
     {
+        int index = lookup_index(k.status(), k.d0());
+        if (index >= 0)
+            m_lookup[index] = &m_container.find(k)->second;
+
+        m_bound_statuses.set(k.status());
         if (! mc.blank())
             m_have_controls = true;
     }
@@ -148,6 +212,55 @@ midicontrolin::add (const midicontrol & mc)
     return result;
 }
 
+/**
+ *  Empties the container, the lookup table, and the status bitmap.
+ */
+
+void
+midicontrolin::clear ()
+{
+    m_container.clear();
+    std::fill(m_lookup.begin(), m_lookup.end(), nullptr);
+    m_bound_statuses.reset();
+}
+
+/**
+ *  Gets the index of a key's entry in the lookup table.
+ *
+ * \return
+ *      Returns the index, or -1 if the status is not a channel message, in
+ *      which case the multimap must be searched.
+ */
+
+int
+midicontrolin::lookup_index (midibyte status, midibyte d0)
+{
+    int s = int(status) - c_lookup_status_min;
+    if (s >= 0 && s < c_lookup_status_count && d0 < c_lookup_d0_count)
+        return s * c_lookup_d0_count + int(d0);
+    else
+        return (-1);
+}
+
+/**
+ *  Refills the lookup table from the container.  Used when copying.  Each
+ *  entry is set from m_container.find(), so that it is the same control
+ *  that the multimap lookup would have found.
+ */
+
+void
+midicontrolin::rebuild_lookup ()
+{
+    m_lookup.assign(c_lookup_size, nullptr);
+    for (const auto & mcpair : m_container)
+    {
+        const midicontrol::key & k = mcpair.first;
+        int index = lookup_index(k.status(), k.d0());
+        if (index >= 0 && is_nullptr(m_lookup[index]))
+            m_lookup[index] = &m_container.find(k)->second;
+    }
+}
+
 /**
  *  This function is needed for running the application for the first time,
  *  when there is no "rc" or "ctrl" file.  We want to be able to write out the
@@ -182,6 +295,9 @@ midicontrolin::add_blank_controls (const keycontainer & kc)
  *  now part of the key, not for operator <, but for checking the source of
  *  the event.  The source should match this container's true buss, if it
  *  isn't the "null" buss (0xFF).
+ *
+ *  Channel messages are looked up in the dense m_lookup table, anything
+ *  else in the multimap.
  */
 
 const midicontrol &
@@ -191,12 +307,23 @@ midicontrolin::control (const midicontrol::key & k) const
     bool ok = have_controls();
     if (ok)
     {
-        const auto & cki = m_container.find(k);
-        ok = cki != m_container.end();
+        const midicontrol * mcp = nullptr;
+        int index = lookup_index(k.status(), k.d0());
+        if (index >= 0)
+        {
+            mcp = m_lookup[index];                  /* O(1) channel message */
+        }
+        else
+        {
+            const auto & cki = m_container.find(k);
+            if (cki != m_container.end())
+                mcp = &cki->second;
+        }
+        ok = not_nullptr(mcp);
         if (ok)
             ok = is_null_buss(nominal_buss()) || k.buss() == true_buss();
 
-        return ok ? cki->second : sm_midicontrol_dummy;
+        return ok ? *mcp : sm_midicontrol_dummy;
     }
     else
         return sm_midicontrol_dummy;
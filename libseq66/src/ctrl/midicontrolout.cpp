@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Igor Angst (with refactoring by C. Ahlstrom)
  * \date          2018-03-28
- * \updates       2023-09-05
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  * The class contained in this file encapsulates most of the functionality to
@@ -64,6 +64,12 @@
  *      visibility:         Hmmmmm.
  *      alt_2 to alt_7      Unused at present.
  *
+ *  All feedback goes through send_feedback(), which remembers the last value
+ *  sent to each address of the device, and drops a message that would not
+ *  change it.  Changing the set or applying a mute-group thus sends only the
+ *  pads that change colour.  An optional rate limit holds back the excess,
+ *  keeping only the latest value per address, for send_pending() to send
+ *  later; the performer calls it along with the delivery of notifications.
  */
 
 #include <iomanip>                      /* std::setw() manipulator          */
@@ -71,7 +77,10 @@
 
 #include "ctrl/opcontrol.hpp"           /* seq66::automation & opcontrol    */
 #include "ctrl/midicontrolout.hpp"      /* seq66::midicontrolout class      */
+#include "os/daemonize.hpp"             /* seq66::session_wake()            */
+#include "os/timing.hpp"                /* seq66::microtime()               */
 #include "play/mutegroups.hpp"          /* seq66::mutegroups::Size()        */
+#include "util/automutex.hpp"           /* seq66::automutex                 */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -92,7 +101,17 @@ midicontrolout::midicontrolout (const std::string & name) :
     m_ui_events         (),
     m_mutes_events      (),
     m_macro_events      (),
-    m_screenset_size    (0)
+    m_macro_bursts      (),
+    m_startup_macro     (-1),
+    m_shutdown_macro    (-1),
+    m_screenset_size    (0),
+    m_sent_values       (),
+    m_changes_only      (true),
+    m_feedback_rate     (0),
+    m_window_start_us   (0),
+    m_window_count      (0),
+    m_pending           (),
+    m_feedback_mutex    ()
 {
    // no code
 }
@@ -126,6 +145,7 @@ midicontrolout::initialize (int buss, int rows, int columns)
     m_seq_events.clear();
     m_ui_events.clear();
     m_mutes_events.clear();
+    reset_feedback();
     if (result)
     {
         int count = rows * columns;
@@ -376,11 +396,7 @@ midicontrolout::send_seq_event (int index, seqaction what, bool flush)
                     "send_seq_event(%s): %s\n", act.c_str(), evstring.c_str()
                 );
 #endif
-                bussbyte tb = true_buss();
-                if (flush)
-                    m_master_bus->play_and_flush(tb, &ev, ev.channel());
-                else
-                    m_master_bus->play(tb, &ev, ev.channel());
+                send_feedback(ev, flush);
             }
         }
     }
@@ -519,7 +535,7 @@ midicontrolout::send_event (uiaction what, actionindex which)
             ev = m_ui_events[w].att_action_event_del;
 
         if (ev.valid_status())
-            m_master_bus->play_and_flush(true_buss(), &ev, ev.channel());
+            send_feedback(ev, true);
     }
 }
 
@@ -538,43 +554,155 @@ midicontrolout::send_automation (bool activate)
         send_event(uia, ai);
 }
 
+/**
+ *  Expands the macros read from the 'ctrl' file, then compiles each into the
+ *  messages to send, so that sending a macro does no lookup of names and no
+ *  parsing of bytes.
+ *
+ * \return
+ *      Returns the result of midimacros::expand(), false if a macro refers
+ *      to one that does not exist.
+ */
+
+bool
+midicontrolout::expand_macros ()
+{
+    bool result = m_macro_events.expand();
+    m_macro_bursts.clear();
+    for (const auto & name : m_macro_events.names())
+        m_macro_bursts.push_back(compile_macro(m_macro_events.bytes(name)));
+
+    m_startup_macro = macro_handle(midimacros::startup);
+    m_shutdown_macro = macro_handle(midimacros::shutdown);
+    return result;
+}
+
+/**
+ *  Splits the bytes of a macro into MIDI messages.  A SysEx message runs
+ *  from 0xF0 to the next 0xF7 (or the end).  Channel messages take their
+ *  one or two data bytes, and running status is allowed.  System common and
+ *  real-time messages are kept as well, though few devices want them in a
+ *  macro.  Stray data bytes and an incomplete last message are dropped.
+ *
+ * \param byts
+ *      The expanded bytes of the macro.
+ *
+ * \return
+ *      Returns the segments to send, empty if there are no messages.
+ */
+
+midicontrolout::macroburst
+midicontrolout::compile_macro (const midistring & byts)
+{
+    macroburst result;
+    macrosegment seg;
+    midibyte status = 0;                            /* for running status   */
+    std::size_t len = byts.length();
+    std::size_t i = 0;
+    while (i < len)
+    {
+        midibyte b = byts[i];
+        if (b == EVENT_MIDI_SYSEX)
+        {
+            std::size_t end = byts.find(EVENT_MIDI_SYSEX_END, i);
+            end = end == midistring::npos ? len : end + 1 ;
+            (void) seg.ms_sysex.set_sysex(midi_bytes(byts) + i, int(end - i));
+            result.push_back(seg);
+            seg = macrosegment();
+            status = 0;
+            i = end;
+            continue;
+        }
+        if (b >= EVENT_MIDI_CLOCK)                  /* real-time, no data   */
+        {
+            event ev(0, b, 0, 0);
+            seg.ms_messages.emplace_back(ev, ev.channel());
+            ++i;
+            continue;
+        }
+        if (b >= 0x80)
+        {
+            status = b;
+            ++i;
+        }
+        else if (status == 0)
+        {
+            ++i;                                    /* stray data byte      */
+            continue;
+        }
+
+        int count;
+        if (event::is_channel_msg(status))
+            count = event::is_one_byte_msg(status) ? 1 : 2 ;
+        else if (status == EVENT_MIDI_SONG_POS)
+            count = 2;
+        else if (status == EVENT_MIDI_QUARTER_FRAME ||
+            status == EVENT_MIDI_SONG_SELECT)
+            count = 1;
+        else
+            count = 0;
+
+        if (i + count > len)
+            break;
+
+        if (status != EVENT_MIDI_SYSEX_END)
+        {
+            midibyte d0 = count > 0 ? byts[i] : 0 ;
+            midibyte d1 = count > 1 ? byts[i + 1] : 0 ;
+            event ev(0, status, d0, d1);
+            seg.ms_messages.emplace_back(ev, ev.channel());
+        }
+        i += std::size_t(count);
+        if (! event::is_channel_msg(status))
+            status = 0;                             /* system common        */
+    }
+    if (! seg.ms_messages.empty())
+        result.push_back(seg);
+
+    return result;
+}
+
+/**
+ *  Sends a compiled macro.  Each run of messages is handed to the buss in
+ *  one batch, which the JACK buss writes at once, and the buss is flushed
+ *  once at the end.
+ *
+ * \param handle
+ *      The macro, from macro_handle(), startup_macro(), or shutdown_macro().
+ *
+ * \param flush
+ *      If true (the default), the messages are flushed out at once.
+ */
+
 void
-midicontrolout::send_macro (const std::string & name, bool flush)
+midicontrolout::send_macro (int handle, bool flush)
 {
     bool enabled = is_enabled() && not_nullptr(m_master_bus);
     if (enabled)
         enabled = m_macro_events.active();              /* ca 2022-08-08    */
 
+    if (enabled)
+        enabled = handle >= 0 && handle < int(m_macro_bursts.size());
+
     if (enabled)
     {
-        midistring byts = m_macro_events.bytes(name);
-        if (! byts.empty())
+        const macroburst & mb = m_macro_bursts[std::size_t(handle)];
+        if (! mb.empty())
         {
-            int len = int(byts.length());
             bussbyte tb = true_buss();
-
-            /*
-             * This test is inadequate.
-             *
-             * if (len > 3)                                // assume sysex  //
-             */
-
-            if (event::is_ex_data_msg(byts[0]))
-            {
-                event ev;
-                const midibyte * b = midi_bytes(byts);
-                (void) ev.set_sysex(b, len);
-                m_master_bus->sysex(tb, &ev);               /* flushes      */
-            }
-            else
+            for (const auto & seg : mb)
             {
-                midibyte d1 = len == 3 ? byts[2] : 0 ;
-                event ev(0, byts[0], byts[1], d1);
-                if (flush)
-                    m_master_bus->play_and_flush(tb, &ev, ev.channel());
-                else
-                    m_master_bus->play(tb, &ev, ev.channel());
+                int count = int(seg.ms_messages.size());
+                if (count > 0)
+                    m_master_bus->play_batch(tb, seg.ms_messages.data(), count);
+
+                if (seg.ms_sysex.is_ex_data())
+                    m_master_bus->sysex(tb, &seg.ms_sysex);     /* flushes  */
             }
+            if (flush)
+                m_master_bus->flush();
+
+            reset_feedback();                   /* device state unknown now */
         }
     }
 }
@@ -731,8 +859,16 @@ midicontrolout::mutes_event_is_active (int group) const
         m_mutes_events[group].att_action_status : false ;
 }
 
+/**
+ *  Sends the event for the given mute-group action.
+ *
+ * \param flush
+ *      Flush MIDI buffer after sending (default true).  A caller sending a
+ *      batch of events flushes once at the end.
+ */
+
 void
-midicontrolout::send_mutes_event (int group, actionindex which)
+midicontrolout::send_mutes_event (int group, actionindex which, bool flush)
 {
     bool ok = is_enabled() && mutes_event_is_active(group);
     if (ok)
@@ -746,10 +882,197 @@ midicontrolout::send_mutes_event (int group, actionindex which)
             ev = m_mutes_events[group].att_action_event_del;
 
         if (ev.valid_status() && not_nullptr(m_master_bus))
-            m_master_bus->play_and_flush(true_buss(), &ev, ev.channel());
+            send_feedback(ev, flush);
     }
 }
 
+/**
+ *  Finds the address of a feedback event on the device.
+ *
+ * \param ev
+ *      The event to be sent.
+ *
+ * \param [out] value
+ *      The value the event sets at that address.
+ *
+ * \return
+ *      Returns the index of the address in m_sent_values, or -1 if the event
+ *      is not a channel message, and so is always sent.
+ */
+
+int
+midicontrolout::feedback_address (const event & ev, short & value)
+{
+    midibyte status = event::mask_status(ev.get_status());
+    if (! event::is_channel_msg(status))
+        return (-1);
+
+    midibyte d0, d1;
+    ev.get_data(d0, d1);
+
+    int key = int(d0);
+    value = short(d1);
+    if (status == EVENT_NOTE_OFF)
+    {
+        status = EVENT_NOTE_ON;
+        value = 0;
+    }
+    else if (event::is_pitchbend_msg(status))
+    {
+        key = 0;
+        value = short(int(d0) + int(d1) * 128);
+    }
+    else if (event::is_one_byte_msg(status))
+    {
+        key = 0;
+        value = short(d0);
+    }
+
+    int kind = (int(status) >> 4) - 8;                  /* 0x80 to 0xE0     */
+    int channel = int(ev.channel()) & 0x0F;
+    return ((kind * 16 + channel) * 128) + key;
+}
+
+/**
+ *  Forgets what the device shows, so that all feedback is sent again.  Done
+ *  at initialization and after a macro, which can change the device in ways
+ *  we cannot follow.
+ */
+
+void
+midicontrolout::reset_feedback ()
+{
+    automutex locker(m_feedback_mutex);
+    m_sent_values.assign(7 * 16 * 128, short(-1));
+    m_pending.clear();
+    m_window_count = 0;
+}
+
+/**
+ *  Checks and counts one message against the rate limit.
+ *
+ * \return
+ *      Returns true if the message can be sent now.
+ */
+
+bool
+midicontrolout::within_rate ()
+{
+    if (m_feedback_rate == 0)
+        return true;
+
+    long now = microtime();
+    if (now - m_window_start_us >= 100000 || now < m_window_start_us)
+    {
+        m_window_start_us = now;
+        m_window_count = 0;
+    }
+
+    int budget = m_feedback_rate / 10;
+    if (budget < 1)
+        budget = 1;
+
+    bool result = m_window_count < budget;
+    if (result)
+        ++m_window_count;
+
+    return result;
+}
+
+/**
+ *  Sends one feedback event, unless it would change nothing on the device,
+ *  or the rate limit holds it back for send_pending().
+ *
+ * \param ev
+ *      The event to send.
+ *
+ * \param flush
+ *      If true, flush the buss after sending.
+ */
+
+void
+midicontrolout::send_feedback (const event & ev, bool flush)
+{
+    if (is_nullptr(m_master_bus))
+        return;
+
+    automutex locker(m_feedback_mutex);
+    short value = 0;
+    int address = feedback_address(ev, value);
+    bool known = address >= 0 && address < int(m_sent_values.size());
+    if (known)
+    {
+        if (m_changes_only && m_sent_values[address] == value)
+        {
+            (void) m_pending.erase(address);    /* a newer value cancels it */
+            return;
+        }
+        if (! within_rate())
+        {
+            if (m_pending.empty())
+                session_wake();                 /* let the CLI loop send it */
+
+            m_pending[address] = ev;            /* keep only the latest     */
+            return;
+        }
+        m_sent_values[address] = value;
+        (void) m_pending.erase(address);
+    }
+
+    event e = ev;
+    bussbyte tb = true_buss();
+    if (flush)
+        m_master_bus->play_and_flush(tb, &e, e.channel());
+    else
+        m_master_bus->play(tb, &e, e.channel());
+}
+
+/**
+ *  Sends the feedback held back by the rate limit, as much as the limit
+ *  allows, with one flush.
+ *
+ * \return
+ *      Returns the number of events sent.
+ */
+
+int
+midicontrolout::send_pending ()
+{
+    int result = 0;
+    if (is_enabled() && not_nullptr(m_master_bus))
+    {
+        automutex locker(m_feedback_mutex);
+        while (! m_pending.empty() && within_rate())
+        {
+            auto it = m_pending.begin();
+            short value = 0;
+            int address = feedback_address(it->second, value);
+            if (address >= 0 && address < int(m_sent_values.size()))
+                m_sent_values[address] = value;
+
+            event e = it->second;
+            m_master_bus->play(true_buss(), &e, e.channel());
+            (void) m_pending.erase(it);
+            ++result;
+        }
+        if (result > 0)
+            m_master_bus->flush();
+    }
+    return result;
+}
+
+/**
+ *  Indicates that the rate limit is holding back some feedback, so that the
+ *  caller of send_pending() should call it again soon.
+ */
+
+bool
+midicontrolout::feedback_pending () const
+{
+    automutex locker(m_feedback_mutex);
+    return ! m_pending.empty();
+}
+
 }           // namespace seq66
 
 /*
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        C. Ahlstrom
  * \date          2021-11-21
- * \updates       2021-12-29
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The specification for the midimacros is of the following format:
@@ -45,6 +45,8 @@
  *
  */
 
+#include <iterator>                     /* std::distance()                  */
+
 #include "ctrl/midimacros.hpp"          /* seq66::midimacros class          */
 #include "util/strfunctions.hpp"        /* seq66::tokenize()                */
 
@@ -157,6 +159,23 @@ midimacros::expand (midimacro & m)
     return result;
 }
 
+/**
+ *  Gets the handle of a macro, which is its position in the (sorted) list of
+ *  names.  The midicontrolout class keeps the compiled macros in that order,
+ *  so that a macro can be sent without looking up its name.
+ *
+ * \return
+ *      Returns -1 if there is no such macro.
+ */
+
+int
+midimacros::handle (const std::string & name) const
+{
+    const auto cit = m_macros.find(name);
+    return cit != m_macros.end() ?
+        int(std::distance(m_macros.begin(), cit)) : (-1) ;
+}
+
 midistring
 midimacros::bytes (const std::string & name) const
 {
@@ -0,0 +1,153 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          padmap.cpp
+ *
+ *  This module defines the note-to-pattern table of the drum pads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include "ctrl/padmap.hpp"              /* seq66::padmap class              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+padmap::padmap () :
+    m_slots             (),
+    m_count             (0),
+    m_enabled           (false),
+    m_channel           (9),
+    m_min_velocity      (1),
+    m_velocity_scale    (false),
+    m_quantize          (0)
+{
+    m_slots.fill(-1);
+}
+
+/**
+ *  Unmaps all of the notes.  The settings are kept.
+ */
+
+void
+padmap::clear ()
+{
+    m_slots.fill(-1);
+    m_count = 0;
+}
+
+/**
+ *  Maps a note to a slot, replacing any earlier mapping of the note.
+ *
+ * \param note
+ *      The note, 0 to 127.
+ *
+ * \param slot
+ *      The slot, relative to the playing set, from 0 to c_slot_max.  A
+ *      value of -1 unmaps the note.
+ *
+ * \return
+ *      Returns true if the parameters are in range.
+ */
+
+bool
+padmap::assign (int note, int slot)
+{
+    bool result = note >= 0 && note < c_notes;
+    if (result)
+        result = slot >= -1 && slot <= c_slot_max;
+
+    if (result)
+    {
+        short & s = m_slots[std::size_t(note)];
+        if (s >= 0)
+            --m_count;
+
+        s = short(slot);
+        if (s >= 0)
+            ++m_count;
+    }
+    return result;
+}
+
+void
+padmap::channel (int ch)
+{
+    if (ch >= 0 && ch < 16)
+        m_channel = midibyte(ch);
+}
+
+void
+padmap::min_velocity (int v)
+{
+    if (v >= 1 && v <= 127)
+        m_min_velocity = midibyte(v);
+}
+
+/**
+ *  Sets the quantization.  Only 0 (none) and the powers of two from 1
+ *  (whole notes) to 64 are accepted.
+ */
+
+void
+padmap::quantize (int notevalue)
+{
+    bool ok = notevalue == 0;
+    for (int v = 1; ! ok && v <= 64; v *= 2)
+        ok = notevalue == v;
+
+    if (ok)
+        m_quantize = notevalue;
+}
+
+/**
+ * \return
+ *      Returns the width of the quantization grid in ticks, or 0 if the
+ *      pads start at once.
+ */
+
+midipulse
+padmap::quantum (int ppqn) const
+{
+    midipulse result = 0;
+    if (m_quantize > 0)
+    {
+        result = midipulse(ppqn) * 4 / m_quantize;
+        if (result < 1)
+            result = 1;
+    }
+    return result;
+}
+
+}               // namespace seq66
+
+/*
+ * padmap.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,484 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          batchconvert.cpp
+ *
+ *  This module defines the headless conversion of MIDI and WRK files.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Usage:
+ *
+\verbatim
+    seq66cli --batch [--jobs n] [--output-dir dir] [--song]
+        [--quantize] [--align-left] [--summary text|json|csv]
+        [--tracks n,m,...] file ...
+\endverbatim
+ *
+ *  The parsers modify some global settings (e.g. the file PPQN and the
+ *  background sequence), so parallel work is done by worker processes, each
+ *  with its own performer and settings, rather than by threads.  Without
+ *  fork() (Windows), the files are converted serially.  The fixes of the
+ *  patterns of one file touch only the patterns, and so are spread over
+ *  the cores left over by the worker processes.
+ */
+
+#include <cstdlib>                      /* EXIT_SUCCESS, EXIT_FAILURE       */
+#include <iostream>                     /* std::cout                        */
+
+#include "seq66_platform_macros.h"      /* detecting Linux vs Windows       */
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/batchconvert.hpp"        /* seq66::batchconvert class        */
+#include "midi/midifile.hpp"            /* seq66::midifile, read_midi_file()*/
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/sequence.hpp"            /* seq66::sequence, fixparameters   */
+#include "play/songsummary.hpp"         /* seq66::songsummary               */
+#include "util/filefunctions.hpp"       /* seq66::filename_concatenate()    */
+#include "util/parallel.hpp"            /* seq66::parallel_for()            */
+#include "util/strfunctions.hpp"        /* seq66::tokenize()                */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <sys/types.h>                  /* pid_t                            */
+#include <sys/wait.h>                   /* ::waitpid()                      */
+#include <unistd.h>                     /* ::fork(), ::_exit()              */
+#endif
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The largest number of worker processes allowed by "--jobs".
+ */
+
+static const int c_batch_workers_max = 64;
+
+/**
+ *  A worker process exits with the number of files it failed to convert,
+ *  up to this value.
+ */
+
+static const int c_batch_status_max = 125;
+
+/**
+ *  The smallest number of patterns for which fix_patterns() uses threads.
+ *  For fewer, starting the threads costs more than it saves.
+ */
+
+static const int c_parallel_patterns_min = 8;
+
+batchconvert::batchconvert () :
+    m_files         (),
+    m_output_dir    (),
+    m_workers       (1),
+    m_export_song   (false),
+    m_quantize      (false),
+    m_align_left    (false),
+    m_summary_format (),
+    m_wrk_tracks    ()
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if "--batch" or "--convert" is on the command line.
+ */
+
+bool
+batchconvert::requested (int argc, char * argv [])
+{
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--batch" || arg == "--convert")
+            return true;
+    }
+    return false;
+}
+
+void
+batchconvert::show_help ()
+{
+    std::cout <<
+"Batch conversion options (no MIDI ports are opened):\n\n"
+"  --batch, --convert   Convert the given MIDI/WRK files to Seq66 MIDI files.\n"
+"  --jobs n             Use n worker processes (default 1).\n"
+"  --output-dir dir     Write the files to dir, not next to the inputs.\n"
+"  --song               Export the song (triggers), as in 'Export Song'.\n"
+"  --quantize           Quantize each pattern to its snap value.\n"
+"  --align-left         Shift each pattern so its first note is at 0.\n"
+"  --summary format     Write a song summary (text, json, or csv) of each\n"
+"                       file instead of converting it.\n"
+"  --tracks n,m,...     Import only these tracks of each WRK file, numbered\n"
+"                       from 0, as in the file.  MIDI files are read whole.\n"
+    ;
+}
+
+/**
+ *  Gets the batch options and the list of files.  The other options of
+ *  seq66cli are not allowed.
+ *
+ * \return
+ *      Returns true if the options are good and at least one file is given.
+ */
+
+bool
+batchconvert::parse (int argc, char * argv [])
+{
+    bool result = true;
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--batch" || arg == "--convert")
+        {
+            // already handled by requested()
+        }
+        else if
+        (
+            arg == "--jobs" || arg == "--output-dir" ||
+            arg == "--summary" || arg == "--tracks"
+        )
+        {
+            if (++argn < argc)
+            {
+                if (arg == "--jobs")
+                {
+                    m_workers = std::atoi(argv[argn]);
+                    result = m_workers > 0 && m_workers <= c_batch_workers_max;
+                }
+                else if (arg == "--summary")
+                {
+                    m_summary_format = argv[argn];
+                    result = m_summary_format == "text" ||
+                        m_summary_format == "json" || m_summary_format == "csv";
+                }
+                else if (arg == "--tracks")
+                    result = parse_tracks(argv[argn]);
+                else
+                    m_output_dir = argv[argn];
+            }
+            else
+                result = false;
+        }
+        else if (arg == "--song")
+            m_export_song = true;
+        else if (arg == "--quantize")
+            m_quantize = true;
+        else if (arg == "--align-left")
+            m_align_left = true;
+        else if (arg.length() > 1 && arg[0] == '-')
+            result = false;
+        else
+            m_files.push_back(arg);
+
+        if (! result)
+        {
+            errprintf("Bad batch option '%s'", arg.c_str());
+            break;
+        }
+    }
+    if (result && m_files.empty())
+    {
+        errprint("No files to convert");
+        result = false;
+    }
+    if (! result)
+        show_help();
+
+    return result;
+}
+
+/**
+ *  Gets the list of WRK tracks of "--tracks", such as "0,2,5".
+ *
+ * \param tracklist
+ *      The track numbers, separated by commas.
+ *
+ * \return
+ *      Returns true if there is at least one track, and every track number
+ *      is a number from 0 up.
+ */
+
+bool
+batchconvert::parse_tracks (const std::string & tracklist)
+{
+    tokenization tokens = tokenize(tracklist, ",");
+    bool result = ! tokens.empty();
+    m_wrk_tracks.clear();
+    for (const auto & t : tokens)
+    {
+        result = ! t.empty() &&
+            t.find_first_not_of("0123456789") == std::string::npos;
+
+        if (result)
+            m_wrk_tracks.push_back(string_to_int(t));
+        else
+            break;
+    }
+    return result;
+}
+
+/**
+ *  Converts all of the files, using the given number of worker processes.
+ *
+ * \return
+ *      Returns EXIT_SUCCESS if every file was converted.
+ */
+
+int
+batchconvert::run ()
+{
+    int workers = m_workers;
+    if (workers > int(m_files.size()))
+        workers = int(m_files.size());
+
+    int failures = 0;
+
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (workers > 1)
+    {
+        std::vector<pid_t> children;
+        for (int w = 0; w < workers; ++w)
+        {
+            pid_t pid = ::fork();
+            if (pid == 0)
+            {
+                int count = convert_files(w);       /* the exit status      */
+                if (count > c_batch_status_max)
+                    count = c_batch_status_max;
+
+                std::cout.flush();
+                ::_exit(count);
+            }
+            else if (pid > 0)
+                children.push_back(pid);
+            else
+            {
+                errprint("Batch fork() failed, converting here");
+                failures += convert_files(w);
+            }
+        }
+        for (auto pid : children)
+        {
+            int status = 0;
+            if (::waitpid(pid, &status, 0) == pid && WIFEXITED(status))
+                failures += WEXITSTATUS(status);
+            else
+                ++failures;                         /* the worker crashed   */
+        }
+    }
+    else
+        failures = convert_files(0);
+#else
+    failures = convert_files(0);
+#endif
+
+    if (failures > 0)
+        errprintf("Batch conversion: %d failure(s)", failures);
+    else
+        infoprintf("Batch conversion: %d file(s)", int(m_files.size()));
+
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS ;
+}
+
+/**
+ *  Converts every n-th file, starting at the given worker index, where n is
+ *  the number of workers.  One performer, never launched, is reused for all
+ *  of the files.
+ *
+ * \return
+ *      Returns the number of files that failed.
+ */
+
+int
+batchconvert::convert_files (int worker)
+{
+    int workers = m_workers;
+    if (workers > int(m_files.size()))
+        workers = int(m_files.size());
+
+    int failures = 0;
+    int ppqn = choose_ppqn();
+    performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) p.get_settings(rc(), usr());
+    for (size_t f = size_t(worker); f < m_files.size(); f += size_t(workers))
+    {
+        if (! convert(p, m_files[f]))
+            ++failures;
+    }
+    return failures;
+}
+
+/**
+ *  Reads one file into the performer, applies the pattern fixes, if any,
+ *  and writes the output file, or its summary.
+ */
+
+bool
+batchconvert::convert (performer & p, const std::string & infile)
+{
+    std::string errmsg;
+    std::string outfile = output_name(infile);
+    bool result = outfile != infile;
+    if (result)
+    {
+        usr().clear_global_seq_features();
+        result = read_midi_file
+        (
+            p, infile, p.ppqn(), errmsg, false, m_wrk_tracks
+        );
+    }
+    else
+        errmsg = "Output would replace the input; use --output-dir";
+
+    if (result)
+        result = fix_patterns(p);
+
+    if (result && ! m_summary_format.empty())
+    {
+        songsummary::format sf =
+            songsummary::format_from_string(m_summary_format);
+
+        songsummary s(outfile, sf);
+        result = s.write(p);
+        if (result)
+            file_message("Summarized", outfile);
+        else
+            file_error("Summary failed", infile);
+
+        return result;
+    }
+    if (result)
+    {
+        bool glob = usr().global_seq_feature();
+        midifile f(outfile, p.ppqn(), glob);
+        result = m_export_song ? f.write_song(p) : f.write(p) ;
+        if (! result)
+            errmsg = f.error_message();
+    }
+    if (result)
+        file_message("Converted", outfile);
+    else
+        file_error(errmsg, infile);
+
+    return result;
+}
+
+/**
+ *  Applies the quantize and align-left fixes to every pattern.  A pattern
+ *  that needs no change (e.g. it already starts at 0) is not an error.
+ *
+ *  Each fix locks and alters only its own pattern, so for a song with many
+ *  patterns the fixes are shared out to threads by parallel_for(), as in
+ *  midifile::parse_smf_1().  Afterward, this thread tells the performer
+ *  of the changes, as performer::fix_pattern() does.
+ */
+
+bool
+batchconvert::fix_patterns (performer & p)
+{
+    if (! m_quantize && ! m_align_left)
+        return true;
+
+    std::vector<seq::number> seqs;
+    std::vector<seq::pointer> patterns;
+    for (int s = 0; s < p.sequence_high(); ++s)
+    {
+        if (p.is_seq_active(s))
+        {
+            seqs.push_back(s);
+            patterns.push_back(p.get_sequence(s));
+        }
+    }
+
+    size_t count = patterns.size();
+    std::vector<char> fixed(count, 0);
+    auto fix = [&] (size_t i)
+    {
+        seq::pointer sp = patterns[i];
+        alteration alt = m_quantize ? alteration::quantize :
+            alteration::none ;
+
+        fixparameters fp =
+        {
+            lengthfix::none, alt, sp->get_length(),
+            int(sp->snap() / 2), int(sp->snap()), 0, 0,
+            m_align_left, false, false, false,
+            false, false, sp->get_beats_per_bar(),
+            sp->get_beat_width(), double(sp->get_measures()), 1.0,
+            std::string(), false, fixeffect::none
+        };
+        fixed[i] = sp->fix_pattern(fp) ? 1 : 0 ;
+    };
+
+    size_t threadcount = 1;
+    if (int(count) >= c_parallel_patterns_min)
+        threadcount = parallel_cores() / size_t(m_workers); /* share cores  */
+
+    parallel_for(count, fix, threadcount);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (fixed[i] != 0)
+            p.notify_trigger_change(seqs[i]);
+    }
+    return true;
+}
+
+/**
+ * \return
+ *      Returns the input file's name with a ".midi" extension (or that of
+ *      the summary format), in the output directory, if one was given.
+ */
+
+std::string
+batchconvert::output_name (const std::string & infile) const
+{
+    std::string ext = m_summary_format.empty() ? std::string(".midi") :
+        songsummary::format_extension
+        (
+            songsummary::format_from_string(m_summary_format)
+        );
+
+    if (m_output_dir.empty())
+        return file_extension_set(infile, ext);
+    else
+        return filename_concatenate
+        (
+            m_output_dir, filename_base(infile, true), ext
+        );
+}
+
+}           // namespace seq66
+
+/*
+ * batchconvert.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
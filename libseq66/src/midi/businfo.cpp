@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-31
- * \updates       2023-09-20
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a base-class implementation for various master MIDI
@@ -46,6 +46,8 @@
  *          businfo container.
  */
 
+#include <limits>                       /* std::numeric_limits<>            */
+
 #include "cfg/settings.hpp"             /* seq66::rc() and seq66::usr()     */
 #include "midi/businfo.hpp"             /* seq66::businfo class             */
 #include "midi/event.hpp"               /* seq66::event class               */
@@ -256,7 +258,10 @@ businfo::print () const
  *  access than using arrays of booleans and pointers.
  */
 
-busarray::busarray () : m_container()
+busarray::busarray () :
+    m_container         (),
+    m_clock_busses      (),
+    m_next_clock_tick   (0)
 {
     // Empty body
 }
@@ -306,6 +311,7 @@ busarray::add (midibus * bus, e_clock clock)
         b.init_clock(clock);
         m_container.push_back(b);                       /* creates a copy   */
         result = m_container.size() == (count + 1);
+        update_clocks();
     }
     return result;
 }
@@ -363,6 +369,7 @@ busarray::initialize ()
         if (! bi.initialize())
             result = false;
     }
+    update_clocks();
     return result;
 }
 
@@ -390,6 +397,28 @@ busarray::play (bussbyte bus, const event * e24, midibyte channel)
         m_container[bus].bus()->play(e24, channel);
 }
 
+/**
+ *  Plays a batch of events on one buss, if active.
+ */
+
+void
+busarray::play_batch (bussbyte bus, const batchevent * evs, int n)
+{
+    if (bus < count() && m_container[bus].active())
+        m_container[bus].bus()->play_batch(evs, n);
+}
+
+/**
+ *  Takes back the unsent events of a pattern on one buss, if active.
+ */
+
+void
+busarray::retract (bussbyte bus, midibyte tag)
+{
+    if (bus < count() && m_container[bus].active())
+        m_container[bus].bus()->retract(tag);
+}
+
 /**
  *  Handles SysEx events; used for output busses.
  *
@@ -404,6 +433,47 @@ busarray::sysex (bussbyte bus, const event * e24)
         m_container[bus].bus()->sysex(e24);
 }
 
+/**
+ *  Sends a chunk of a streamed SysEx message; used for output busses.
+ */
+
+void
+busarray::sysex_chunk (bussbyte bus, const midibyte * data, int len)
+{
+    if (bus < count() && m_container[bus].active())
+        m_container[bus].bus()->sysex_chunk(data, len);
+}
+
+/**
+ *  Gathers the output-buffer statistics of the active busses.  The sizes
+ *  and the dropped counts are summed; the high-water mark is the largest
+ *  of any one buss.
+ *
+ * \return
+ *      Returns true if any buss has an output buffer.
+ */
+
+bool
+busarray::buffer_stats (int & size, int & highwater, int & dropped)
+{
+    bool result = false;
+    size = highwater = dropped = 0;
+    for (auto & bi : m_container)
+    {
+        int sz, hw, dr;
+        if (bi.active() && bi.bus()->buffer_stats(sz, hw, dr))
+        {
+            size += sz;
+            dropped += dr;
+            if (hw > highwater)
+                highwater = hw;
+
+            result = true;
+        }
+    }
+    return result;
+}
+
 /**
  *  Sets the clock type for the given bus, usually the output buss.
  *  This code is a bit more restrictive than the original code in
@@ -439,11 +509,54 @@ busarray::set_clock (bussbyte bus, e_clock clocktype)
         businfo & bi = m_container[bus];
         result = bi.active() || current == e_clock::disabled;
         if (result)
+        {
             bi.init_clock(clocktype);           /* also handles set_clock() */
+            update_clocks();
+        }
     }
     return result;
 }
 
+/**
+ *  Rebuilds the list of the busses whose clock is enabled, and makes the
+ *  next call to clock() visit them, to find the tick of the next pulse.
+ */
+
+void
+busarray::update_clocks ()
+{
+    m_clock_busses.clear();
+    for (auto & bi : m_container)               /* vector of businfo copies */
+    {
+        midibus * b = bi.bus();
+        if (not_nullptr(b) && b->clock_enabled())
+            m_clock_busses.push_back(b);
+    }
+    m_next_clock_tick = 0;
+}
+
+/**
+ *  Clocks the clocked busses, and notes the earliest tick at which one of
+ *  them has a pulse due.  If none has (their clocks have been turned off in
+ *  the meantime), no more clocking is done until update_clocks() is called.
+ *
+ * \param tick
+ *      Provides the tick value for all busses use as the clock tick.
+ */
+
+void
+busarray::clock_busses (midipulse tick)
+{
+    midipulse next = std::numeric_limits<midipulse>::max();
+    for (auto b : m_clock_busses)
+    {
+        midipulse t = b->clock(tick);
+        if (! is_null_midipulse(t) && t < next)
+            next = t;
+    }
+    m_next_clock_tick = next;
+}
+
 /**
  *  Gets the clock type for the given bus, usually the output buss.
  *
@@ -617,6 +730,62 @@ busarray::port_exit (int client, int port)
     }
 }
 
+/**
+ *  Brings back the inactive busses that used a port which has come back,
+ *  as when a USB device is plugged in again.  The system can give the device
+ *  a new client number, so the busses are matched by the names of the
+ *  client and the port.  A buss with a user-defined name (see the 'usr'
+ *  file) no longer has the client name, and is matched by the port name
+ *  alone.  A buss that could not be set up at start-up stays unavailable.
+ *  Only the matching busses are touched; their indices do not
+ *  change, and the other busses keep playing.
+ *
+ * \param client
+ *      The system's client number of the port that started.
+ *
+ * \param port
+ *      The system's port number of the port that started.
+ *
+ * \param busname
+ *      The name of the client that owns the port.
+ *
+ * \param portname
+ *      The name of the port.
+ *
+ * \return
+ *      Returns true if a buss was reconnected.
+ */
+
+bool
+busarray::port_restart
+(
+    int client, int port,
+    const std::string & busname, const std::string & portname
+)
+{
+    bool result = false;
+    for (auto & bi : m_container)               /* vector of businfo copies */
+    {
+        midibus * b = bi.bus();
+        if (bi.active() || is_nullptr(b) || b->port_unavailable())
+            continue;
+
+        if (b->port_name() != portname)
+            continue;
+
+        bool aliased = ! usr().bus_name(b->bus_index()).empty();
+        if (b->bus_name() != busname && ! aliased)
+            continue;
+
+        if (b->reconnect(client, port))
+        {
+            bi.activate();
+            result = true;
+        }
+    }
+    return result;
+}
+
 /**
  *  Set the status of the given input buss, if a legal buss number.  There's
  *  currently no implementation-specific API function called directly here.
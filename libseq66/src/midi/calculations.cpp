@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-07
- * \updates       2024-12-30
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This code was moved from the globals module so that other modules
@@ -471,7 +471,31 @@ pulses_to_time_string (midipulse p, const midi_timing & timinginfo)
 std::string
 pulses_to_time_string (midipulse p, midibpm bpm, int ppqn, bool showus)
 {
-    unsigned long microseconds = ticks_to_delta_time_us(p, bpm, ppqn);
+    return microseconds_to_time_string
+    (
+        ticks_to_delta_time_us(p, bpm, ppqn), showus
+    );
+}
+
+/**
+ *  Converts a time in microseconds into a string that represents
+ *  "hours:minutes:seconds.fraction".  This is the formatting part of
+ *  pulses_to_time_string(), for callers who have the time of a tick
+ *  already, as from a tempo map.
+ *
+ * \param microseconds
+ *      The time to format.
+ *
+ * \param showus
+ *      If true (the default), shows the hundredths of a second as well.
+ *
+ * \return
+ *      Returns the time-string representation.
+ */
+
+std::string
+microseconds_to_time_string (unsigned long microseconds, bool showus)
+{
     int seconds = int(microseconds / 1000000UL);
     int minutes = seconds / 60;
     int hours = seconds / (60 * 60);
@@ -1427,6 +1451,13 @@ combine_bytes (midibyte b0, midibyte b1)
  *  is 2147483647.  At the highest PPQN that's almost 28000 measures.  64-bit
  *  code maxes at over 9E18.
  *
+ *  The product is done in 64-bit integers and rounded to the nearest tick
+ *  (halves away from zero), so that the result is exact at any tick, which
+ *  a double is not past 2^53, and the same on every platform.  The mapping
+ *  never decreases:  ticks in order stay in order (ties can merge), so a
+ *  sorted list of events or triggers stays sorted, and need not be sorted
+ *  again.
+ *
  * \param tick
  *      The tick value to be rescaled.
  *
@@ -1443,7 +1474,12 @@ combine_bytes (midibyte b0, midibyte b1)
 midipulse
 rescale_tick (midipulse tick, int newppqn, int oldppqn)
 {
-    return midipulse(double(tick) * newppqn / oldppqn + 0.5);
+    long long product = (long long)(tick) * newppqn;
+    long long half = oldppqn / 2;
+    if (product < 0)
+        return midipulse((product - half) / oldppqn);
+    else
+        return midipulse((product + half) / oldppqn);
 }
 
 /**
@@ -1526,6 +1562,57 @@ wave_func (double angle, waveform wavetype)
     return result;
 }
 
+/**
+ *  The batch version of wave_func(), which replaces each angle with its wave
+ *  value.  The switch on the wave is made once, and the loops are simple
+ *  enough for the compiler to vectorize, except those calling sin() or
+ *  exp().  Used for all the events changed by one move of an LFO slider.
+ *
+ * \param values
+ *      Provides the angles, and gets the values, ranging from -1.0 to 1.0.
+ *
+ * \param count
+ *      The number of angles.
+ *
+ * \param w
+ *      The wave to generate.
+ */
+
+void
+wave_values (double * values, std::size_t count, waveform w)
+{
+    double * v = values;
+    switch (w)
+    {
+    case waveform::sine:
+        for (std::size_t i = 0; i < count; ++i)
+            v[i] = sin(2.0 * M_PI * v[i]);
+        break;
+
+    case waveform::sawtooth:
+        for (std::size_t i = 0; i < count; ++i)
+            v[i] = 2.0 * (v[i] - int(v[i])) - 1.0;
+        break;
+
+    case waveform::reverse_sawtooth:
+        for (std::size_t i = 0; i < count; ++i)
+            v[i] = 1.0 - 2.0 * (v[i] - int(v[i]));
+        break;
+
+    case waveform::exponential:
+    case waveform::reverse_exponential:
+    case waveform::triangle:
+        for (std::size_t i = 0; i < count; ++i)
+            v[i] = wave_func(v[i], w);
+        break;
+
+    default:
+        for (std::size_t i = 0; i < count; ++i)
+            v[i] = 0.0;
+        break;
+    }
+}
+
 /**
  *  Converts a double value to range from 0.0 to 1.0. That is, it returns the
  *  fractional portion.  For example, 4.145 would become 0.145.
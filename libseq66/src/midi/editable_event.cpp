@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-12-29
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  A MIDI editable event is encapsulated by the seq66::editable_event
@@ -541,15 +541,9 @@ editable_event::editable_event (const editable_events & parent) :
     event               (),
     m_parent            (&parent),
     m_link_time         (c_null_midipulse),
+    m_link_key          (c_null_midipulse, 0),
     m_category          (subgroup::name),
-    m_name_category     (),
-    m_format_timestamp  (timestamp_measures),
-    m_name_timestamp    (),
-    m_name_status       (),
-    m_name_meta         (),
-    m_name_seqspec      (),
-    m_name_channel      (),
-    m_name_data         ()
+    m_format_timestamp  (timestamp_measures)
 {
     // No code needed
 }
@@ -557,7 +551,8 @@ editable_event::editable_event (const editable_events & parent) :
 /**
  *  Event constructor.  This function basically adds all of the extra
  *  editable_event stuff to a standard event, so that the resulting
- *  editable_event is container-ready.
+ *  editable_event is container-ready.  Only the category is worked out
+ *  here; the strings are made when the event is shown.
  */
 
 editable_event::editable_event
@@ -568,24 +563,16 @@ editable_event::editable_event
     event               (ev),
     m_parent            (&parent),
     m_link_time         (c_null_midipulse),
+    m_link_key          (c_null_midipulse, 0),
     m_category          (subgroup::name),
-    m_name_category     (),
-    m_format_timestamp  (timestamp_measures),
-    m_name_timestamp    (),
-    m_name_status       (),
-    m_name_meta         (),
-    m_name_seqspec      (),
-    m_name_channel      (),
-    m_name_data         ()
+    m_format_timestamp  (timestamp_measures)
 {
-    if (is_linked())
-        m_link_time = ev.link()->timestamp();
+    analyze();                      /* see editable_events::add() for link  */
 }
 
 /**
  * \setter m_category by value
- *      Also keeps the m_name_category member in synchrony.  Note that a bad
- *      value is translated to the enum value subgroup::name.
+ *      Note that a bad value is translated to the enum value subgroup::name.
  *
  * \param c
  *      Provides the category value to set.
@@ -598,18 +585,22 @@ editable_event::category (editable_event::subgroup c)
         m_category = c;
     else
         m_category = subgroup::name;
+}
 
-    std::string name = value_to_name(static_cast<midibyte>(c), subgroup::name);
-    if (! name.empty())
-        m_name_category = name;
+/**
+ * \getter m_category as a name
+ *      Looks up the name of the category, rather than storing it.
+ */
+
+std::string
+editable_event::category_string () const
+{
+    return value_to_name(static_cast<midibyte>(m_category), subgroup::name);
 }
 
 /**
  * \setter m_category by name
- *      Also keeps the m_name_category member in synchrony, but looks up the
- *      name, rather than using the name parameter, to avoid storing
- *      abbreviations.  Note that a bad value is translated to the value of
- *      subgroup::name.
+ *      Note that a bad value is translated to the value of subgroup::name.
  *
  * \param name
  *      Provides the category name for the category value to set.
@@ -623,21 +614,12 @@ editable_event::category (const std::string & name)
         m_category = static_cast<subgroup>(catcode);
     else
         m_category = subgroup::name;
-
-    m_name_category = value_to_name
-    (
-        static_cast<midibyte>(m_category), subgroup::name
-    );
 }
 
 /**
  * \setter event::set_timestamp()
  *      Implemented to allow a uniform naming convention that is not
- *      slavish to the get/set crowd [this ain't Java].  Plus, we also
- *      have to set the string version at the same time.
- *
- *  The format of the string representation is of the format selected by the
- *  m_format_timestamp member and is set by the format_timestamp() function.
+ *      slavish to the get/set crowd [this ain't Java].
  *
  * \param ts
  *      Provides the timestamp in units of MIDI pulses.
@@ -647,14 +629,12 @@ void
 editable_event::timestamp (midipulse ts)
 {
     event::set_timestamp(ts);
-    (void) format_timestamp();
 }
 
 /**
  * \setter event::set_timestamp() [string version]
  *
- *  The format of the string representation is of the format selected by the
- *  m_format_timestamp member and is set by the format_timestamp() function.
+ *  The string is parsed by the parent container, in the format it uses.
  *
  * \param ts_string
  *      Provides the timestamp in units of MIDI pulses.
@@ -667,7 +647,6 @@ editable_event::timestamp (const std::string & ts_string)
     {
         midipulse ts = parent()->string_to_pulses(ts_string);
         event::set_timestamp(ts);
-        (void) format_timestamp();
     }
 }
 
@@ -678,18 +657,16 @@ editable_event::timestamp (const std::string & ts_string)
  */
 
 std::string
-editable_event::format_timestamp ()
+editable_event::format_timestamp () const
 {
     if (m_format_timestamp == timestamp_measures)
-        m_name_timestamp = time_as_measures();
+        return time_as_measures();
     else if (m_format_timestamp == timestamp_time)
-        m_name_timestamp = time_as_minutes();
+        return time_as_minutes();
     else if (m_format_timestamp == timestamp_pulses)
-        m_name_timestamp = time_as_pulses();
+        return time_as_pulses();
     else
-        m_name_timestamp = "unsupported category in editable event";
-
-    return m_name_timestamp;
+        return std::string("unsupported category in editable event");
 }
 
 /**
@@ -699,7 +676,7 @@ editable_event::format_timestamp ()
  */
 
 std::string
-editable_event::time_as_measures ()
+editable_event::time_as_measures () const
 {
     if (not_nullptr(parent()))
     {
@@ -720,7 +697,7 @@ editable_event::time_as_measures ()
  */
 
 std::string
-editable_event::time_as_minutes ()
+editable_event::time_as_minutes () const
 {
     if (not_nullptr(parent()))
     {
@@ -754,8 +731,8 @@ editable_event::time_as_minutes ()
  *  string; the slash (solidus) is required.  Then get the cc and bb metronome
  *  values, if present.  Otherwise, hardwired them to values of 0x18 and 0x08.
  *
- *  After all of the numbering member items have been set, they are converted
- *  and assigned to the string versions via a call to the analyze() function.
+ *  After all of the numbering member items have been set, the category is
+ *  brought up to date via a call to the analyze() function.
  *
  * \param ts
  *      Provides the time-stamp string of the event.
@@ -855,7 +832,7 @@ editable_event::set_status_from_string
             }
         }
     }
-    analyze();                          /* create the strings   */
+    analyze();                          /* set the category     */
 }
 
 /**
@@ -898,13 +875,12 @@ editable_event::modify_channel_status_from_string
         }
         set_data(d0, d1);
     }
-    analyze();                              /* (re)create the strings       */
+    analyze();                              /* reset the category           */
 }
 
 /**
- *  Converts the event into a string desribing the full event.  We get the
- *  time-stamp as a string, make sure the event is fully analyzed so that all
- *  items and strings are set correctly.
+ *  Converts the event into a string desribing the full event, from the
+ *  time-stamp, status, channel, and data strings.
  *
  * \return
  *      Returns a human-readable string describing this event.  This string is
@@ -912,11 +888,12 @@ editable_event::modify_channel_status_from_string
  */
 
 std::string
-editable_event::stock_event_string ()
+editable_event::stock_event_string () const
 {
     char temp[64];
     std::string ts = format_timestamp();
-    analyze();
+    std::string status = status_string();
+    std::string data = data_string();
     if (is_ex_data())
     {
         if (is_tempo() || is_time_signature())
@@ -924,7 +901,7 @@ editable_event::stock_event_string ()
             snprintf
             (
                 temp, sizeof temp, "%9s %-11s %-10s",
-                ts.c_str(), m_name_status.c_str(), m_name_data.c_str()
+                ts.c_str(), status.c_str(), data.c_str()
             );
         }
         else
@@ -932,17 +909,17 @@ editable_event::stock_event_string ()
             snprintf
             (
                 temp, sizeof temp, "%9s %-11s %-12s",
-                ts.c_str(), m_name_status.c_str(), m_name_data.c_str()
+                ts.c_str(), status.c_str(), data.c_str()
             );
         }
     }
     else
     {
+        std::string channel = channel_string();
         snprintf
         (
             temp, sizeof temp, "%9s %-11s %-10s %-20s",
-            ts.c_str(), m_name_status.c_str(),
-            m_name_channel.c_str(), m_name_data.c_str()
+            ts.c_str(), status.c_str(), channel.c_str(), data.c_str()
         );
     }
     return std::string(temp);
@@ -950,62 +927,115 @@ editable_event::stock_event_string ()
 
 /**
  *  Analyzes an editable-event to make all the settings it needs.  Used in the
- *  constructors.  Some of the setters indirectly set the appropriate string
- *  representation, as well.
+ *  constructors and after the event is changed.
  *
  * Category:
  *
  *      This function can figure out if the status byte implies a channel
- *      message or a system message, and set the category string as well.
+ *      message or a system message, and set the category as well.
  *      However, at this time, detection of Meta events (0xFF) or
  *      Proprietary/SeqSpec events (0xFF with 0x2424) doesn't work due to lack
  *      of context here (and due to the fact that currently such events are
  *      not yet stored in a Seq66 sequence/track, and the
  *      least-significant-byte gets masked off anyway.)
  *
- * Status:
- *
- *      We distinguish between channel and system messages, and then one- and
- *      two-byte messages, but don't yet distinguish the data values fully.
- *
- * Sysex and Meta events:
+ *  The strings that describe the event are no longer stored, but made on
+ *  demand by status_string(), channel_string(), and data_string().
+ */
+
+void
+editable_event::analyze ()
+{
+    midibyte status = get_status();
+    if (is_channel_msg(status))
+        category(subgroup::channel_message);
+    else if (is_meta_msg(status))
+        category(subgroup::meta_event);
+    else if (is_system_msg(status))
+        category(subgroup::system_message);
+}
+
+/**
+ *  Gets the name of the status value for this event, such as "Program
+ *  change".  It covers the names of the channel messages and the system
+ *  messages.  The latter includes SysEx and Meta messages.
  *
- *      We are starting to support events with statuses ranging from 0xF0 to
- *      0xFF, with a concentration on Set Tempo and Time Signature events.
- *      We want them to be full-fledged Seq66 events.
+ * \return
+ *      Returns the name, or an empty string if the status is not known.
+ */
+
+std::string
+editable_event::status_string () const
+{
+    std::string result;
+    midibyte status = get_status();
+    if (is_channel_msg(status))
+    {
+        status = event::mask_status(status);
+        result = value_to_name(status, subgroup::channel_message);
+    }
+    else if (is_meta_msg(status))
+    {
+        midibyte metatype = get_meta_status();  /* stored in channel!   */
+        result = value_to_name(metatype, subgroup::meta_event);
+    }
+    else if (is_system_msg(status))
+        result = value_to_name(status, subgroup::system_message);
+
+    return result;
+}
+
+/**
+ *  Gets the channel description.  For a channel message, this is the
+ *  channel number, starting at 1.  For a Meta event, it is the meta type
+ *  in hex.
  *
- *      The 0xFF byte represents a Meta event, not a Reset event, when we're
- *      dealing with data from a MIDI file, as we are here. And we need to get
- *      the next byte after the status byte.
+ * \return
+ *      Returns the channel string, empty for other system messages.
+ */
+
+std::string
+editable_event::channel_string () const
+{
+    std::string result;
+    midibyte status = get_status();
+    if (is_channel_msg(status))
+    {
+        result = std::to_string(int(channel()) + 1);    /* no "Ch"      */
+    }
+    else if (is_meta_msg(status))
+    {
+        char tmp[32];
+        snprintf(tmp, sizeof tmp, "0x%02x", int(channel()));
+        result = tmp;
+    }
+    return result;
+}
+
+/**
+ *  Gets the data description.  We distinguish between channel and system
+ *  messages, and then one- and two-byte messages, but don't yet distinguish
+ *  the data values fully.  Set Tempo events appear as "Tempo 120.0" and
+ *  Time Signature events appear as "Time Sig 4/4"; see ex_data_string().
  *
- *      We want Set Tempo events to appear as "Tempo 120.0" and Time Signature
- *      events to appear as "Time Sig 4/4".
+ * \return
+ *      Returns the data string, empty for other system messages.
  */
 
-void
-editable_event::analyze ()
+std::string
+editable_event::data_string () const
 {
+    std::string result;
     midibyte status = get_status();
-    (void) format_timestamp();
     if (is_channel_msg(status))
     {
         char tmp[32];
-        int ch = int(channel()) + 1;
         int di0, di1;
         midibyte d0, d1;
         get_data(d0, d1);
         di0 = int(d0);
         di1 = int(d1);
-        category(subgroup::channel_message);
         status = event::mask_status(status);
-
-        /*
-         * Get channel message name (e.g. "Program change");
-         */
-
-        m_name_status = value_to_name(status, subgroup::channel_message);
-        snprintf(tmp, sizeof tmp, "%d", ch);        /* no "Ch", too much    */
-        m_name_channel = std::string(tmp);
         if (is_one_byte_msg(status))
         {
             snprintf(tmp, sizeof tmp, "Data %d", di0);
@@ -1017,41 +1047,12 @@ editable_event::analyze ()
             else
                 snprintf(tmp, sizeof tmp, "Data %d, %d", di0, di1);
         }
-        m_name_data = std::string(tmp);
-    }
-    else if (is_system_msg(status))
-    {
-        if (is_meta_msg(status))
-        {
-            char tmp[32];
-            int ch = int(channel());
-            snprintf(tmp, sizeof tmp, "0x%02x", ch);
-            midibyte metatype = get_meta_status();  /* stored in channel!   */
-            category(subgroup::meta_event);
-            m_name_status = value_to_name(metatype, subgroup::meta_event);
-            m_name_channel = std::string(tmp);
-            m_name_data = ex_data_string();
-        }
-        else
-        {
-            /*
-             * Get system message name (e.g. "SysEx start");
-             */
-
-            category(subgroup::system_message);
-            m_name_status = value_to_name(status, subgroup::system_message);
-            m_name_channel.clear();
-            m_name_data.clear();
-        }
-    }
-    else
-    {
-        /*
-         * Would try to detect SysEx versus Meta message versus SeqSpec here.
-         * Then set either m_name_meta and/or m_name_seqspec.
-         * ALso see eventslots::set_current_event().
-         */
+        result = tmp;
     }
+    else if (is_meta_msg(status))
+        result = ex_data_string();
+
+    return result;
 }
 
 /**
@@ -25,13 +25,16 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-12-04
- * \updates       2023-07-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  A MIDI editable event is encapsulated by the seq66::editable_events
  *  object.
  */
 
+#include <mutex>                        /* std::mutex, std::lock_guard<>    */
+#include <set>                          /* std::set<>                       */
+
 #include "midi/editable_events.hpp"     /* seq66::editable_events           */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
 
@@ -42,6 +45,40 @@
 namespace seq66
 {
 
+namespace
+{
+
+/**
+ *  The editable_events objects in existence, so that open_bytes() can add
+ *  up the memory held by the event editors.  Each object registers itself
+ *  on construction and unregisters on destruction, under the mutex.
+ */
+
+using registry = std::set<const editable_events *>;
+
+std::mutex &
+registry_mutex ()
+{
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+registry &
+open_containers ()
+{
+    static registry s_open_containers;
+    return s_open_containers;
+}
+
+void
+register_container (const editable_events * ee)
+{
+    std::lock_guard<std::mutex> guard(registry_mutex());
+    (void) open_containers().insert(ee);
+}
+
+}           // namespace (anonymous)
+
 /*
  * We will get the default controller name from the controllers module.
  * We should also be able to look up the selected buss's entries for a
@@ -69,7 +106,7 @@ editable_events::editable_events (sequence & s, midibpm bp) :
         bp, s.get_beats_per_bar(), s.get_beat_width(), s.get_ppqn()
     )
 {
-    // Empty body
+    register_container(this);
 }
 
 /**
@@ -90,7 +127,33 @@ editable_events::editable_events (const editable_events & rhs) :
     m_seq               (rhs.m_seq),
     m_midi_parameters   (rhs.m_midi_parameters)
 {
-    // no code
+    register_container(this);
+}
+
+editable_events::~editable_events ()
+{
+    std::lock_guard<std::mutex> guard(registry_mutex());
+    (void) open_containers().erase(this);
+}
+
+/**
+ *  Estimates the memory held by all of the editable_events objects, for
+ *  memoryusage.  A node of the multimap holds the key, the event, and
+ *  about four words of tree links and color.
+ */
+
+std::size_t
+editable_events::open_bytes ()
+{
+    static const std::size_t s_node_bytes =
+        sizeof(Events::value_type) + 4 * sizeof(void *);
+
+    std::size_t result = 0;
+    std::lock_guard<std::mutex> guard(registry_mutex());
+    for (const auto * ee : open_containers())
+        result += ee->m_events.size() * s_node_bytes;
+
+    return result;
 }
 
 /**
@@ -140,6 +203,8 @@ editable_events::get_length () const
 
 /**
  *  Adds an event, converted to an editable_event, to the internal event list.
+ *  The event is one of the pattern's, so its link, if any, is an index into
+ *  the pattern's event list, where the linked event is looked up.
  *
  * \param e
  *      Provides the regular event to be added to the list of editable events.
@@ -153,6 +218,12 @@ bool
 editable_events::add (const event & e)
 {
     editable_event ed(*this, e);            /* make the event "editable"    */
+    if (e.is_linked())
+    {
+        const eventlist & evl = track().events();
+        if (e.link() >= 0 && e.link() < evl.count())
+            ed.linked_event(*evl.linked(e));
+    }
     return add(ed);
 }
 
@@ -296,7 +367,7 @@ editable_events::count_to_link (const editable_event & ee) const
             const editable_event & e = i.second;
             if (e.is_linked())
             {
-                event::key k2(*e.link());
+                const event::key & k2 = e.link_key();
                 if (k2 == k)
                     return index;
             }
@@ -323,7 +394,7 @@ editable_events::lookup_link (const editable_event & ee)
             editable_event & e = i.second;
             if (e.is_linked())
             {
-                event::key k2(*e.link());
+                const event::key & k2 = e.link_key();
                 if (k2 == k)
                     return e;
             }
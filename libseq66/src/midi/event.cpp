@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-11-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  A MIDI event (i.e. "track event") is encapsulated by the seq66::event
@@ -74,6 +74,7 @@
  */
 
 #include <cstring>                      /* std::memcpy()                    */
+#include <utility>                      /* std::move()                      */
 
 #include "midi/event.hpp"               /* seq66::event class               */
 #include "midi/calculations.hpp"        /* seq66::rescale_tick()            */
@@ -106,6 +107,128 @@ namespace seq66
  * --------------------------------------------------------------
  */
 
+/**
+ *  The SysEx/Meta data of events that have none.
+ */
+
+const event::sysex event::sm_no_sysex;
+
+/**
+ *  Classifies one status byte, using the same comparisons formerly used by
+ *  each of the static status tests.  Evaluated only at compile time.
+ */
+
+static constexpr unsigned
+status_properties (unsigned m)
+{
+    unsigned result = 0;
+    if (m >= EVENT_NOTE_OFF)
+    {
+        result |= event::c_bit_status;
+        if (m < EVENT_MIDI_SYSEX)
+        {
+            unsigned s = m & EVENT_GET_STATUS_MASK;
+            result |= event::c_bit_channel;
+            if (s == EVENT_NOTE_OFF || s == EVENT_NOTE_ON)
+                result |= event::c_bit_strict_note;
+
+            if (s == EVENT_NOTE_OFF)
+                result |= event::c_bit_note_off;
+            else if (s == EVENT_NOTE_ON)
+                result |= event::c_bit_note_on;
+            else if (s == EVENT_CONTROL_CHANGE)
+                result |= event::c_bit_controller;
+            else if (s == EVENT_PROGRAM_CHANGE)
+                result |= event::c_bit_program;
+            else if (s == EVENT_PITCH_WHEEL)
+                result |= event::c_bit_pitchbend;
+
+            if (s < EVENT_CONTROL_CHANGE)
+                result |= event::c_bit_note;
+
+            if (s == EVENT_PROGRAM_CHANGE || s == EVENT_CHANNEL_PRESSURE)
+                result |= event::c_bit_one_byte;
+            else
+                result |= event::c_bit_two_byte;
+        }
+        else
+        {
+            result |= event::c_bit_system;
+            if (m < EVENT_MIDI_CLOCK)
+                result |= event::c_bit_common;
+            else
+                result |= event::c_bit_realtime;
+
+            if (m == EVENT_MIDI_SYSEX || m == EVENT_MIDI_SYSEX_CONTINUE)
+                result |= event::c_bit_sysex;
+
+            if (m == EVENT_MIDI_ACTIVE_SENSE || m == EVENT_MIDI_RESET)
+                result |= event::c_bit_sense_reset;
+        }
+    }
+    if (m == EVENT_MIDI_META || m == EVENT_MIDI_SYSEX)
+        result |= event::c_bit_ex_data;
+    else
+        result |= event::c_bit_playable;
+
+    return result;
+}
+
+/**
+ *  Classifies one Meta event type, as stored in event::m_channel.
+ */
+
+static constexpr unsigned
+meta_properties (unsigned m)
+{
+    unsigned result = 0;
+    if (m <= EVENT_META_SEQSPEC)
+        result |= event::c_bit_meta_type;
+
+    if (m >= EVENT_META_TEXT_EVENT && m <= EVENT_META_CUE_POINT)
+        result |= event::c_bit_meta_text;
+
+    if (m == EVENT_META_SET_TEMPO)
+        result |= event::c_bit_meta_tempo;
+    else if (m == EVENT_META_TIME_SIGNATURE)
+        result |= event::c_bit_meta_timesig;
+    else if (m == EVENT_META_KEY_SIGNATURE)
+        result |= event::c_bit_meta_keysig;
+
+    return result;
+}
+
+static constexpr event::bytetable
+make_bytetable (bool meta)
+{
+    event::bytetable result {};
+    for (unsigned m = 0; m < 256; ++m)
+        result.m_bits[m] = meta ? meta_properties(m) : status_properties(m);
+
+    return result;
+}
+
+/*
+ *  The initializers are constant expressions, so these tables are filled
+ *  by the compiler, not at start-up.  A few spot checks of the generator:
+ */
+
+static_assert
+(
+    (status_properties(0x93) & event::c_bit_note_on) != 0 &&
+    (status_properties(0xA0) & event::c_bit_strict_note) == 0 &&
+    (status_properties(0xE5) & event::c_bit_two_byte) != 0 &&
+    (status_properties(0xD0) & event::c_bit_one_byte) != 0 &&
+    (status_properties(0xF7) & event::c_bit_sysex) != 0 &&
+    (status_properties(0xFF) & event::c_bit_playable) == 0 &&
+    (status_properties(0x40) & event::c_bit_playable) != 0 &&
+    (meta_properties(0x51) & event::c_bit_meta_tempo) != 0,
+    "event status table generator is wrong"
+);
+
+const event::bytetable event::sm_status_bits = make_bytetable(false);
+const event::bytetable event::sm_meta_bits = make_bytetable(true);
+
 /**
  *  This constructor simply initializes all of the class members to default
  *  values.
@@ -113,12 +236,13 @@ namespace seq66
 
 event::event () :
     m_input_buss    (null_buss()),              /* 0xFF                     */
+    m_arrival_us    (0),
     m_timestamp     (0),
     m_status        (EVENT_NOTE_OFF),           /* note-off, channel 0      */
     m_channel       (null_channel()),           /* 0x80                     */
     m_data          (),                         /* a two-element array      */
-    m_sysex         (),                         /* an std::vector           */
-    m_linked        (),                         /* uninit'd iterator #124   */
+    m_sysex         (),                         /* null, no SysEx data      */
+    m_linked        (-1),                       /* no link, see m_has_link  */
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -147,12 +271,13 @@ event::event () :
 
 event::event (midipulse tstamp, midibyte status, midibyte d0, midibyte d1) :
     m_input_buss    (null_buss()),          /* 0xFF                 */
+    m_arrival_us    (0),
     m_timestamp     (tstamp),
     m_status        (status),               /* keep the channel 2021-08-09  */
     m_channel       (mask_channel(status)),
     m_data          (),                     /* two-element array, midibytes */
-    m_sysex         (),                     /* an std::vector of midibytes  */
-    m_linked        (),                     /* removed nullptr issue #124   */
+    m_sysex         (),                     /* null, no SysEx/Meta data     */
+    m_linked        (-1),                   /* no link, see m_has_link      */
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -167,18 +292,19 @@ event::event (midipulse tstamp, midibyte status, midibyte d0, midibyte d1) :
 
 event::event (midipulse tstamp, midibpm tempo) :
     m_input_buss    (null_buss()),
+    m_arrival_us    (0),
     m_timestamp     (tstamp),
     m_status        (EVENT_MIDI_META),
     m_channel       (EVENT_META_SET_TEMPO),
     m_data          (),                     /* two-element array, midibytes */
-    m_sysex         (),                     /* an std::vector of midibytes  */
-    m_linked        (),                     /* removed nullptr issue #124   */
+    m_sysex         (),                     /* null, no SysEx/Meta data     */
+    m_linked        (-1),                   /* no link, see m_has_link      */
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
     m_painted       (false)
 {
-    set_tempo(tempo);                       /* fills the m_sysex vector     */
+    set_tempo(tempo);                       /* fills the m_sysex data       */
 }
 
 /**
@@ -194,12 +320,13 @@ event::event
     int velocity
 ) :
     m_input_buss    (null_buss()),
+    m_arrival_us    (0),
     m_timestamp     (tstamp),
     m_status        (notekind),
     m_channel       (channel),
     m_data          (),                     /* two-element array, midibytes */
-    m_sysex         (),                     /* an std::vector of midibytes  */
-    m_linked        (),                     /* removed nullptr issue #124   */
+    m_sysex         (),                     /* null, no SysEx/Meta data     */
+    m_linked        (-1),                   /* no link, see m_has_link      */
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -244,11 +371,12 @@ event::event
 
 event::event (const event & rhs) :
     m_input_buss    (rhs.m_input_buss),
+    m_arrival_us    (rhs.m_arrival_us),
     m_timestamp     (rhs.m_timestamp),
     m_status        (rhs.m_status),
     m_channel       (rhs.m_channel),
     m_data          (),                     /* a two-element array      */
-    m_sysex         (rhs.m_sysex),          /* copies a vector of data  */
+    m_sysex         (rhs.m_sysex),          /* shares any SysEx data    */
     m_linked        (rhs.m_linked),         /* for vector implemenation */
     m_has_link      (rhs.m_has_link),       /* m_linked has 2 linkers!  */
     m_selected      (rhs.m_selected),
@@ -259,6 +387,34 @@ event::event (const event & rhs) :
     m_data[1] = rhs.m_data[1];
 }
 
+/**
+ *  The move constructor.  The same as the copy constructor, except that any
+ *  SysEx data is taken over instead of shared.  Being noexcept, it is what
+ *  std::vector uses when it grows, which saves a shared-pointer increment
+ *  and decrement for each event moved.
+ *
+ * \param rhs
+ *      Provides the event object to be moved.
+ */
+
+event::event (event && rhs) noexcept :
+    m_input_buss    (rhs.m_input_buss),
+    m_arrival_us    (rhs.m_arrival_us),
+    m_timestamp     (rhs.m_timestamp),
+    m_status        (rhs.m_status),
+    m_channel       (rhs.m_channel),
+    m_data          (),                     /* a two-element array      */
+    m_sysex         (std::move(rhs.m_sysex)),
+    m_linked        (rhs.m_linked),
+    m_has_link      (rhs.m_has_link),
+    m_selected      (rhs.m_selected),
+    m_marked        (rhs.m_marked),
+    m_painted       (rhs.m_painted)
+{
+    m_data[0] = rhs.m_data[0];
+    m_data[1] = rhs.m_data[1];
+}
+
 /**
  *  This principal assignment operator sets most of the class members.  This
  *  function is currently geared only toward support of the SMF 0
@@ -285,6 +441,7 @@ event::operator = (const event & rhs)
     if (this != &rhs)
     {
         m_input_buss    = rhs.m_input_buss;
+        m_arrival_us    = rhs.m_arrival_us;
         m_timestamp     = rhs.m_timestamp;
         m_status        = rhs.m_status;
         m_channel       = rhs.m_channel;
@@ -300,10 +457,42 @@ event::operator = (const event & rhs)
     return *this;
 }
 
+/**
+ *  The move assignment operator, used by std::sort() and by erasures.
+ *
+ * \param rhs
+ *      Provides the event object to be moved.
+ *
+ * \return
+ *      Returns a reference to "this" object.
+ */
+
+event &
+event::operator = (event && rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        m_input_buss    = rhs.m_input_buss;
+        m_arrival_us    = rhs.m_arrival_us;
+        m_timestamp     = rhs.m_timestamp;
+        m_status        = rhs.m_status;
+        m_channel       = rhs.m_channel;
+        m_data[0]       = rhs.m_data[0];
+        m_data[1]       = rhs.m_data[1];
+        m_sysex         = std::move(rhs.m_sysex);
+        m_linked        = rhs.m_linked;
+        m_has_link      = rhs.m_has_link;
+        m_selected      = rhs.m_selected;
+        m_marked        = rhs.m_marked;
+        m_painted       = rhs.m_painted;
+    }
+    return *this;
+}
+
 /**
  *  This destructor explicitly deletes m_sysex and sets it to null.
  *  The reset_sysex() function does what we need.  But now that m_sysex is a
- *  vector, no action is needed.
+ *  shared pointer, no action is needed.
  */
 
 event::~event ()
@@ -339,6 +528,7 @@ void
 event::prep_for_send (midipulse tick, const event & source)
 {
     m_input_buss    = source.m_input_buss;
+    m_arrival_us    = source.m_arrival_us;
     m_timestamp     = tick;
     m_status        = source.m_status;
     m_data[0]       = source.m_data[0];
@@ -346,6 +536,61 @@ event::prep_for_send (midipulse tick, const event & source)
     m_sysex         = source.m_sysex;
 }
 
+/**
+ *  A version of prep_for_send() that takes the bytes of the event, as held
+ *  by a playevent, rather than a whole event.  The SysEx data is cleared.
+ *
+ * \param tick
+ *      The tick at which the event is played.
+ *
+ * \param status
+ *      The status byte, as returned by get_status().
+ *
+ * \param d0
+ *      The first data byte.
+ *
+ * \param d1
+ *      The second data byte.
+ */
+
+void
+event::prep_for_send
+(
+    midipulse tick,
+    midibyte status, midibyte d0, midibyte d1
+)
+{
+    m_timestamp     = tick;
+    m_status        = status;
+    m_data[0]       = d0;
+    m_data[1]       = d1;
+    m_sysex.reset();
+}
+
+/**
+ *  Provides the SysEx/Meta data for modification.  If there is none yet, an
+ *  empty buffer is allocated.  If the data is shared with copies of this
+ *  event (and perhaps with a playback snapshot), this event gets its own
+ *  copy first, so that the other events are unaffected.
+ *
+ *  Like the rest of event, this is not thread-safe; the containing event
+ *  list is protected by the sequence's mutex.
+ *
+ * \return
+ *      Returns a reference to data that only this event holds.
+ */
+
+event::sysex &
+event::writable_sysex ()
+{
+    if (! m_sysex)
+        m_sysex = std::make_shared<sysex>();
+    else if (m_sysex.use_count() > 1)
+        m_sysex = std::make_shared<sysex>(*m_sysex);
+
+    return *m_sysex;
+}
+
 /**
  *  If the current timestamp equal the event's timestamp, then this
  *  function returns true if the current rank is less than the event's
@@ -804,10 +1049,11 @@ std::string
 event::get_text () const
 {
     std::string result;
-    size_t dsize = m_sysex.size();
+    const sysex & data = get_sysex();
+    size_t dsize = data.size();
     for (size_t i = 0; i < dsize; ++i)
     {
-        char c = char(m_sysex[i]);
+        char c = char(data[i]);
         result.push_back(c);
     }
     return result;
@@ -815,7 +1061,7 @@ event::get_text () const
 
 /**
  *  This base-class version unconditionally loads bytes into the
- *  m_sysex vector.
+ *  m_sysex data.
  */
 
 bool
@@ -824,9 +1070,10 @@ event::set_text (const std::string & s)
     bool result = ! s.empty();
     if (result)
     {
-        m_sysex.clear();
+        sysex & data = writable_sysex();
+        data.clear();
         for (const auto c : s)
-            m_sysex.push_back(c);
+            data.push_back(c);
     }
     return result;
 }
@@ -869,8 +1116,10 @@ event::append_meta_data (midibyte metatype, const midibyte * data, int dsize)
     if (result)
     {
         set_meta_status(metatype);
+
+        sysex & ex = writable_sysex();
         for (int i = 0; i < dsize; ++i)
-            m_sysex.push_back(data[i]);
+            ex.push_back(data[i]);
     }
     else
     {
@@ -902,8 +1151,10 @@ event::append_meta_data (midibyte metatype, const midibytes & data)
     if (result)
     {
         set_meta_status(metatype);
+
+        sysex & ex = writable_sysex();
         for (int i = 0; i < dsize; ++i)
-             m_sysex.push_back(data[i]);
+             ex.push_back(data[i]);
     }
     else
     {
@@ -930,8 +1181,9 @@ event::append_meta_data (midibyte metatype, const midibytes & data)
 bool
 event::append_sysex_byte (midibyte data)
 {
-    bool firstbyte = m_sysex.empty();
-    m_sysex.push_back(data);
+    sysex & ex = writable_sysex();
+    bool firstbyte = ex.empty();
+    ex.push_back(data);
     return firstbyte || data != EVENT_MIDI_SYSEX_END;
 }
 
@@ -960,8 +1212,8 @@ event::append_sysex (const midibyte * data, int dsize)
     bool result = not_nullptr(data) && (dsize > 0);
     if (result)
     {
-        for (int i = 0; i < dsize; ++i)
-            m_sysex.push_back(data[i]);
+        sysex & ex = writable_sysex();
+        ex.insert(ex.end(), data, data + dsize);
     }
     else
     {
@@ -976,8 +1228,8 @@ event::append_sysex (const midibytes & data)
     bool result = ! data.empty();
     if (result)
     {
-        for (auto b : data)
-            m_sysex.push_back(b);
+        sysex & ex = writable_sysex();
+        ex.insert(ex.end(), data.begin(), data.end());
     }
     else
     {
@@ -1018,9 +1270,9 @@ void
 event::set_sysex_size (int len)
 {
     if (len == 0)
-        m_sysex.clear();
+        reset_sysex();
     else if (len > 0)
-        m_sysex.resize(len);
+        writable_sysex().resize(len);
 }
 
 /**
@@ -1043,8 +1295,20 @@ event::print (const std::string & tag) const
         printf("%s: %s", tag.c_str(), buffer.c_str());
 }
 
+/**
+ *  Prints a note, and, if linked and shown, the note it is linked to.
+ *
+ * \param showlink
+ *      If true, a Note On is followed by its linked Note Off, and a linked
+ *      Note Off is not printed on its own.
+ *
+ * \param linked
+ *      The linked event, which the caller has to look up in its list, since
+ *      the link is an index.  If null, the link is not printed.
+ */
+
 void
-event::print_note (bool showlink) const
+event::print_note (bool showlink, const event * linked) const
 {
     if (is_note())
     {
@@ -1068,11 +1332,10 @@ event::print_note (bool showlink) const
                 long(m_timestamp), type.c_str(), channel,
                 int(m_data[0]), int(m_data[1])
             );
-            if (is_linked() && showlink)
+            if (is_linked() && showlink && not_nullptr(linked))
             {
-                const_iterator mylink = link();
                 printf(" --> ");
-                mylink->print_note(false);
+                linked->print_note(false);
             }
             else
                 printf("\n");
@@ -1120,7 +1383,7 @@ event::to_string () const
             if (use_linefeeds && (i % 16) == 0)
                 result += "\n         ";
 
-            (void) snprintf(tmp, sizeof tmp, "%02X ", m_sysex[i]);
+            (void) snprintf(tmp, sizeof tmp, "%02X ", get_sysex(i));
             result += tmp;
         }
         result += "\n";
@@ -1221,9 +1484,9 @@ event::tempo () const
     if (is_tempo() && sysex_size() == 3)
     {
         midibyte b[3];
-        b[0] = m_sysex[0];                  /* convert vector to array type */
-        b[1] = m_sysex[1];
-        b[2] = m_sysex[2];
+        b[0] = get_sysex(0);                /* convert vector to array type */
+        b[1] = get_sysex(1);
+        b[2] = get_sysex(2);
         result = bpm_from_bytes(b);
     }
     return result;
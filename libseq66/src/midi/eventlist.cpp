@@ -25,17 +25,19 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-19
- * \updates       2024-12-28
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This container now can indicate if certain Meta events (time-signaure or
  *  tempo) have been added to the container.
  */
 
-#include <algorithm>                    /* std::sort(), std::merge()        */
+#include <algorithm>                    /* std::stable_sort(), etc.         */
+#include <cstdint>                      /* std::uint64_t, std::uint32_t     */
 
 #include "cfg/settings.hpp"             /* seq66::usr()                     */
 #include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+#include "play/editjob.hpp"             /* seq66::editjob::checkpoint()     */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -51,7 +53,7 @@ namespace seq66
 eventlist::eventlist () :
     m_events                (),
     m_match_iterating       (false),
-    m_match_iterator        (m_events.end()),
+    m_match_iterator        (),
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
     m_action_in_progress    (false),                    /* atomic boolean   */
 #endif
@@ -62,7 +64,10 @@ eventlist::eventlist () :
     m_has_tempo             (false),
     m_has_time_signature    (false),
     m_has_key_signature     (false),
-    m_link_wraparound       (usr().pattern_wraparound())
+    m_link_wraparound       (usr().pattern_wraparound()),
+    m_note_spans            (),
+    m_note_grid             (),
+    m_changes               (0)
 {
     // No code needed
 }
@@ -70,13 +75,14 @@ eventlist::eventlist () :
 /**
  *  We have to now define this copy constructor because the atomic copy
  *  constructor is deleted, making the compiler-generated copy constructor
- *  ill-formed.
+ *  ill-formed.  The events are shared, not copied (see cowvector), so the
+ *  match iterator, which would unshare them, is left unset.
  */
 
 eventlist::eventlist (const eventlist & rhs) :
     m_events                (rhs.m_events),
     m_match_iterating       (false),
-    m_match_iterator        (m_events.end()),
+    m_match_iterator        (),
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
     m_action_in_progress    (false),                    /* atomic boolean   */
 #endif
@@ -87,7 +93,10 @@ eventlist::eventlist (const eventlist & rhs) :
     m_has_tempo             (rhs.m_has_tempo),
     m_has_time_signature    (rhs.m_has_time_signature),
     m_has_key_signature     (rhs.m_has_key_signature),
-    m_link_wraparound       (rhs.m_link_wraparound)
+    m_link_wraparound       (rhs.m_link_wraparound),
+    m_note_spans            (rhs.m_note_spans),
+    m_note_grid             (),
+    m_changes               (0)
 {
     // no code
 }
@@ -97,9 +106,8 @@ eventlist::operator = (const eventlist & rhs)
 {
     if (this != &rhs)
     {
-        m_events                = rhs.m_events;
-        m_match_iterating       = rhs.m_match_iterating;    /* ok? */
-        m_match_iterator        = rhs.m_match_iterator;     /* ok? */
+        m_events                = rhs.m_events;     /* shared storage   */
+        m_match_iterating       = false;            /* rhs's iterator   */
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
         m_action_in_progress    = false;                /* atomic boolean   */
 #endif
@@ -111,6 +119,9 @@ eventlist::operator = (const eventlist & rhs)
         m_has_time_signature    = rhs.m_has_time_signature;
         m_has_key_signature     = rhs.m_has_key_signature;
         m_link_wraparound       = rhs.m_link_wraparound;
+        m_note_spans            = rhs.m_note_spans;
+        m_note_grid.invalidate();
+        ++m_changes;                            /* not copied, see hpp  */
     }
     return *this;
 }
@@ -187,6 +198,38 @@ bool
 eventlist::append (const event & e)
 {
     m_events.push_back(e);                      /* std::vector operation    */
+    return appended();
+}
+
+/**
+ *  Moves an event to the end of the list.  Used in reading a MIDI file and
+ *  in recording, where the event is a temporary, so that any SysEx or meta
+ *  data it holds is handed over instead of being shared.
+ *
+ * \param e
+ *      Provides the event to be moved into the list.  It is left empty.
+ *
+ * \return
+ *      Returns true.
+ */
+
+bool
+eventlist::append (event && e)
+{
+    m_events.push_back(std::move(e));
+    return appended();
+}
+
+/**
+ *  The bookkeeping common to all of the ways to append an event.  The flags
+ *  are set from the event now at the back of the list.
+ */
+
+bool
+eventlist::appended ()
+{
+    const event & e = m_events.back();
+    invalidate_indexes();
     m_is_modified = true;
     if (e.is_tempo())
         m_has_tempo = true;
@@ -208,8 +251,8 @@ eventlist::append (const event & e)
 bool
 eventlist::add (event::buffer & evlist, const event & e)
 {
-    evlist.push_back(e);                        /* std::vector operation    */
-    std::sort(evlist.begin(), evlist.end());
+    auto pos = std::upper_bound(evlist.begin(), evlist.end(), e);
+    (void) evlist.insert(pos, e);               /* stays sorted, no re-sort */
     return true;
 }
 
@@ -238,24 +281,213 @@ eventlist::add (const event & e)
     return result;
 }
 
+bool
+eventlist::add (event && e)
+{
+    bool result = append(std::move(e));
+    if (result)
+        sort();                         /* by time-stamp and "rank" */
+
+    return result;
+}
+
 /**
- *  Sorts the event list.  For the vector, equivalent elements are not
- *  guaranteed to keep their original relative order [see
- *  std::stable_sort(), which we could try at some point].
- *
- *  This method is probably flawed.
+ *  Sorts the event list.  See sort_events().  Equivalent events now keep
+ *  their original relative order.  Events shared with another list, as
+ *  when a pattern has just been copied, have not been changed since that
+ *  list had them, and are left shared if they are already sorted.
  */
 
 void
 eventlist::sort ()
 {
+    if (m_events.shared())
+    {
+        if (std::is_sorted(m_events.cbegin(), m_events.cend()))
+            return;
+    }
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
     m_action_in_progress = true;
-    std::sort(m_events.begin(), m_events.end());
+    sort_events(m_events);
     m_action_in_progress = false;
 #else
-    std::sort(m_events.begin(), m_events.end());
+    sort_events(m_events);
 #endif
+    invalidate_indexes();               /* the caller might have relinked   */
+}
+
+/**
+ *  Event lists are nearly always sorted, or made of a few sorted runs, as
+ *  when a recording or a paste is appended to a pattern.  So this function
+ *  first counts the runs, which for a sorted list is the one cheap pass it
+ *  needs.  A few runs are merged in place.  Otherwise the events are
+ *  sorted by key; see key_sort().  All of these are stable.
+ *
+ * \param evlist
+ *      The events to sort.  Their links are not fixed up; as before, the
+ *      caller relinks them if needed.
+ */
+
+void
+eventlist::sort_events (event::buffer & evlist)
+{
+    static const std::size_t s_merge_runs_max = 8;
+    static const std::size_t s_key_sort_min = 64;
+    std::size_t runs = 1;
+    for (std::size_t i = 1; i < evlist.size(); ++i)
+    {
+        if (evlist[i] < evlist[i - 1])
+        {
+            if (++runs > s_merge_runs_max)
+                break;
+        }
+    }
+    if (runs == 1)
+        return;                         /* the usual case                   */
+
+    if (runs <= s_merge_runs_max)
+        merge_sorted_runs(evlist);
+    else if (evlist.size() < s_key_sort_min)
+        std::stable_sort(evlist.begin(), evlist.end());
+    else
+        key_sort(evlist);
+}
+
+/**
+ *  A natural merge sort:  finds the sorted runs and merges neighbors until
+ *  one run is left.  Each pass halves the number of runs, so the cost is
+ *  the size of the list times the logarithm of the number of runs.
+ */
+
+void
+eventlist::merge_sorted_runs (event::buffer & evlist)
+{
+    std::vector<std::size_t> bounds;    /* run starts, plus the end         */
+    bounds.push_back(0);
+    for (std::size_t i = 1; i < evlist.size(); ++i)
+    {
+        if (evlist[i] < evlist[i - 1])
+            bounds.push_back(i);
+    }
+    bounds.push_back(evlist.size());
+    while (bounds.size() > 2)
+    {
+        std::vector<std::size_t> merged;
+        std::size_t r = 0;
+        for ( ; r + 2 < bounds.size(); r += 2)
+        {
+            auto first = evlist.begin() + std::ptrdiff_t(bounds[r]);
+            auto middle = evlist.begin() + std::ptrdiff_t(bounds[r + 1]);
+            auto last = evlist.begin() + std::ptrdiff_t(bounds[r + 2]);
+            std::inplace_merge(first, middle, last);
+            merged.push_back(bounds[r]);
+        }
+        if (r < bounds.size() - 1)
+            merged.push_back(bounds[r]);    /* an odd run waits a pass      */
+
+        merged.push_back(evlist.size());
+        bounds.swap(merged);
+    }
+}
+
+/**
+ *  Sorts a badly shuffled list.  Rather than comparing and moving whole
+ *  events, which are large, it packs each event's timestamp and rank (see
+ *  event::operator <()) into one integer key, with the event's index,
+ *  sorts the keys with a least-significant-digit radix sort, skipping the
+ *  digits all the keys share, and then moves each event once, into its
+ *  place.  Timestamps are made relative to the earliest one, so that even
+ *  negative ones sort properly.
+ */
+
+void
+eventlist::key_sort (event::buffer & evlist)
+{
+    struct sortkey
+    {
+        std::uint64_t sk_key;
+        std::uint32_t sk_index;
+    };
+    static const int s_rank_bits = 16;  /* event::get_rank() < 0x4000       */
+    std::size_t count = evlist.size();
+    midipulse earliest = evlist.front().timestamp();
+    for (const auto & e : evlist)
+    {
+        if (e.timestamp() < earliest)
+            earliest = e.timestamp();
+    }
+
+    std::vector<sortkey> keys(count);
+    std::uint64_t all_or = 0;
+    std::uint64_t all_and = ~std::uint64_t(0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const event & e = evlist[i];
+        std::uint64_t ts = std::uint64_t(e.timestamp() - earliest);
+        std::uint64_t k = (ts << s_rank_bits) | std::uint64_t(e.get_rank());
+        keys[i].sk_key = k;
+        keys[i].sk_index = std::uint32_t(i);
+        all_or |= k;
+        all_and &= k;
+    }
+
+    std::vector<sortkey> scratch(count);
+    std::uint64_t differ = all_or ^ all_and;        /* bits that vary       */
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        if (((differ >> shift) & 0xFF) == 0)
+            continue;                               /* every key the same   */
+
+        std::size_t buckets[256] = { 0 };
+        for (const auto & k : keys)
+            ++buckets[(k.sk_key >> shift) & 0xFF];
+
+        std::size_t offset = 0;
+        for (auto & b : buckets)
+        {
+            std::size_t n = b;
+            b = offset;
+            offset += n;
+        }
+        for (const auto & k : keys)
+            scratch[buckets[(k.sk_key >> shift) & 0xFF]++] = k;
+
+        keys.swap(scratch);
+    }
+
+    event::buffer sorted;
+    sorted.reserve(count);
+    for (const auto & k : keys)
+        sorted.push_back(std::move(evlist[k.sk_index]));
+
+    evlist.swap(sorted);
+}
+
+/**
+ *  Merges the events appended after the first \a oldsize events into those
+ *  before them.  When both runs are sorted, as they nearly always are, this
+ *  is a linear merge instead of a sort of the whole list.
+ *
+ * \param oldsize
+ *      The number of events before the append.
+ */
+
+void
+eventlist::merge_runs (std::size_t oldsize)
+{
+    auto middle = m_events.begin() + std::ptrdiff_t(oldsize);
+    if
+    (
+        std::is_sorted(m_events.begin(), middle) &&
+        std::is_sorted(middle, m_events.end())
+    )
+    {
+        std::inplace_merge(m_events.begin(), middle, m_events.end());
+    }
+    else
+        sort_events(m_events);
+
+    invalidate_indexes();
 }
 
 /**
@@ -266,10 +498,10 @@ eventlist::sort ()
 void
 eventlist::merge (const event::buffer & evlist)
 {
-    std::size_t totalsize = m_events.size() + evlist.size();
-    m_events.reserve(totalsize);
+    std::size_t oldsize = m_events.size();
+    m_events.reserve(oldsize + evlist.size());
     m_events.insert(m_events.end(), evlist.begin(), evlist.end());
-    sort();
+    merge_runs(oldsize);
 }
 
 /**
@@ -291,27 +523,23 @@ eventlist::merge (const event::buffer & evlist)
  * \param el
  *      Provides the event list to be merged into the current event list.
  *
+ *  Both lists are normally sorted already, so the two runs are merged in
+ *  linear time by merge_runs(), and verify_and_link() finds nothing left to
+ *  sort.  The source is no longer sorted in place behind its const.
+ *
  * \param presort
- *      If true (the default), then the events are presorted.  This is a
- *      requirement for merging an std::list or std::vector, but is a no-op
- *      for the std::multimap implementation (which no longer exists).
+ *      No longer used; merge_runs() checks the order of both runs, and sorts
+ *      the whole list if either is out of order.
  */
 
 bool
-eventlist::merge (const eventlist & el, bool presort)
+eventlist::merge (const eventlist & el, bool /* presort */)
 {
-    if (presort)                            /* not really necessary here    */
-    {
-        eventlist & el_nc = const_cast<eventlist &>(el);
-        el_nc.sort();
-    }
-    std::size_t totalsize = m_events.size() + el.m_events.size();
+    std::size_t oldsize = m_events.size();
+    std::size_t totalsize = oldsize + el.m_events.size();
     m_events.reserve(totalsize);
     m_events.insert(m_events.end(), el.m_events.begin(), el.m_events.end());
-
-    /*
-     * Done via verify_and_link(): sort();
-     */
+    merge_runs(oldsize);
 
     bool result = m_events.size() == totalsize;
     if (result)
@@ -343,6 +571,12 @@ eventlist::merge (const eventlist & el, bool presort)
  *
  *      We could add a feature to truncate the note.  Think!
  *
+ *  This used to scan forward from each Note On to find its Note Off, which
+ *  is quadratic in the number of events.  Now a single pass keeps, for each
+ *  note value, a FIFO of pending Note Ons (and of unused Note Offs).  The
+ *  links made are the same: each Note Off goes to the oldest pending Note
+ *  On of the same note.
+ *
  * \param wrap
  *      Optionally (the default is false) wrap when relinking.  Can be used to
  *      override usr().pattern_wraparound().  Defaults to false.
@@ -354,37 +588,77 @@ eventlist::merge (const eventlist & el, bool presort)
 bool
 eventlist::link_new (bool wrap)
 {
+    static const int c_note_count = 128;
+    static const int c_none = (-1);
     bool result = false;
-    for (auto eon = m_events.begin(); eon != m_events.end(); ++eon)
-    {
-        if (eon->on_linkable())                     /* note-on, not linked  */
+    int count = int(m_events.size());
+    std::vector<int> chain(count, c_none);          /* per-note FIFO links  */
+    int onhead[c_note_count];                       /* oldest pending on    */
+    int ontail[c_note_count];                       /* newest pending on    */
+    int offhead[c_note_count];                      /* oldest unused off    */
+    int offtail[c_note_count];                      /* newest unused off    */
+    std::fill(onhead, onhead + c_note_count, c_none);
+    std::fill(ontail, ontail + c_note_count, c_none);
+    std::fill(offhead, offhead + c_note_count, c_none);
+    std::fill(offtail, offtail + c_note_count, c_none);
+    for (int i = 0; i < count; ++i)
+    {
+        auto ev = m_events.begin() + i;
+        if (ev->on_linkable())                      /* note-on, not linked  */
         {
-            bool endfound = false;                  /* end-of-note flag     */
-            auto eoff = eon;                        /* point to note on     */
-            ++eoff;                                 /* get next element     */
-            while (eoff != m_events.end())
+            int n = int(ev->get_note()) & 0x7F;
+            if (ontail[n] == c_none)
+                onhead[n] = i;
+            else
+                chain[ontail[n]] = i;
+
+            ontail[n] = i;
+        }
+        else if (ev->off_linkable())                /* note-off, not linked */
+        {
+            int n = int(ev->get_note()) & 0x7F;
+            int on = onhead[n];
+            if (on != c_none)
             {
-                endfound = link_notes(eon, eoff);   /* calls off_linkable() */
-                if (endfound)
-                {
+                onhead[n] = chain[on];
+                if (onhead[n] == c_none)
+                    ontail[n] = c_none;
+
+                if (link_notes(m_events.begin() + on, ev))
                     result = true;
-                    break;
-                }
-                ++eoff;
             }
-            if (! endfound)
+            else
             {
-                eoff = m_events.begin();
-                while (eoff != eon)
+                if (offtail[n] == c_none)
+                    offhead[n] = i;
+                else
+                    chain[offtail[n]] = i;
+
+                offtail[n] = i;
+            }
+        }
+    }
+
+    /*
+     *  Any Note Off left over precedes every Note On still pending for its
+     *  note, so the oldest of these Note Ons takes them all, wrapping
+     *  around to the beginning of the pattern.
+     */
+
+    for (int n = 0; n < c_note_count; ++n)
+    {
+        if (onhead[n] != c_none)
+        {
+            auto eon = m_events.begin() + onhead[n];
+            for (int off = offhead[n]; off != c_none; off = chain[off])
+            {
+                auto eoff = m_events.begin() + off;
+                bool wrapped = eoff->timestamp() < eon->timestamp();
+                if (link_notes(eon, eoff))
                 {
-                    bool wrapped = eoff->timestamp() < eon->timestamp();
-                    if (link_notes(eon, eoff))
-                    {
-                        result = true;
-                        if (wrapped && ! wrap)
-                            eoff->set_timestamp(get_length() - 1);
-                    }
-                    ++eoff;
+                    result = true;
+                    if (wrapped && ! wrap)
+                        eoff->set_timestamp(get_length() - 1);
                 }
             }
         }
@@ -503,11 +777,11 @@ eventlist::link_new_note ()
 bool
 eventlist::link_notes (event::iterator eon, event::iterator eoff)
 {
-    bool result = eon->off_linkable(eoff);
+    bool result = eon->off_linkable(*eoff);
     if (result)
     {
-        eon->link(eoff);
-        eoff->link(eon);
+        eon->link(index_of(eoff));
+        eoff->link(index_of(eon));
         if (eon->timestamp() == eoff->timestamp())
         {
             long ts = eon->timestamp();
@@ -521,6 +795,252 @@ eventlist::link_notes (event::iterator eon, event::iterator eoff)
     return result;
 }
 
+/**
+ *  Appends a Note Off and links it incrementally, as recording does for
+ *  every Note Off that comes in.  This avoids the clear/sort/relink of
+ *  verify_and_link(), but gives the same result.  That requires that:
+ *
+ *  -   The list is sorted and the Note Off sorts to the end of it, so
+ *      nothing moves.  (The vector may reallocate, since the links are
+ *      indexes, which do not change when it does.)
+ *  -   The oldest pending Note On of the same note is not wrapped around
+ *      to an earlier Note Off, which a full relink would undo.
+ *
+ *  The Note Off goes to the oldest unlinked Note On of its note, just as
+ *  link_new() would do it.  If any requirement is not met, nothing is done
+ *  and the caller must append and call verify_and_link() instead.  While
+ *  recording, that fallback is rare.
+ *
+ * \threadunsafe
+ *      The caller must lock.
+ *
+ * \param e
+ *      Provides the Note Off to be appended.
+ *
+ * \param slength
+ *      Provides the length beyond which events will be pruned, as in
+ *      verify_and_link().  Can be 0.
+ *
+ * \return
+ *      Returns true if the event was appended and linked here.
+ */
+
+bool
+eventlist::append_linked (const event & e, midipulse slength)
+{
+    int on;
+    bool found;
+    bool result = linkable(e, on, found);
+    if (result)
+    {
+        (void) append(e);
+        link_appended(on, found, slength);
+    }
+    return result;
+}
+
+/**
+ *  The same as append_linked(const event &), but the event is moved into
+ *  the list.  It is left alone if the function fails, so that the caller
+ *  can still append it.
+ */
+
+bool
+eventlist::append_linked (event && e, midipulse slength)
+{
+    int on;
+    bool found;
+    bool result = linkable(e, on, found);
+    if (result)
+    {
+        (void) append(std::move(e));
+        link_appended(on, found, slength);
+    }
+    return result;
+}
+
+/**
+ *  Checks the requirements of append_linked(), and finds the Note On the
+ *  Note Off is to be linked to.
+ *
+ * \param e
+ *      Provides the Note Off to be appended.
+ *
+ * \param [out] on
+ *      Set to the index of the Note On, if found.
+ *
+ * \param [out] found
+ *      Set to true if there is a Note On to link.
+ *
+ * \return
+ *      Returns true if the event can be appended and linked incrementally.
+ */
+
+bool
+eventlist::linkable (const event & e, int & on, bool & found)
+{
+    bool result = e.is_note_off() && ! m_events.empty();
+    on = 0;
+    found = false;
+    if (result)
+        result = ! (e < m_events.back()) &&
+            std::is_sorted(m_events.begin(), m_events.end());
+
+    if (result)
+    {
+        auto eon = m_events.begin();
+        for ( ; eon != m_events.end(); ++eon)
+        {
+            if (eon->is_note_on() && eon->get_note() == e.get_note())
+            {
+                if (! eon->is_linked())
+                {
+                    found = true;                   /* oldest pending on    */
+                    break;
+                }
+                else if (eon->link() < index_of(eon))   /* wrapped, bail  */
+                {
+                    result = false;
+                    break;
+                }
+            }
+        }
+        if (result)
+            on = index_of(eon);                     /* survives the append  */
+    }
+    return result;
+}
+
+/**
+ *  Links the Note Off just appended by append_linked() to its Note On, and
+ *  prunes the events past the slength.
+ */
+
+void
+eventlist::link_appended (int on, bool found, midipulse slength)
+{
+    if (found)
+    {
+        auto eoff = m_events.end() - 1;
+        (void) link_notes(m_events.begin() + on, eoff);
+        if (slength > 0 && eoff->timestamp() > slength)
+        {
+            if (mark_out_of_range(slength))
+                (void) remove_marked();
+        }
+    }
+}
+
+/**
+ *  Inserts a Note On and its Note Off in their sorted places and links
+ *  them to each other, as entering a note in the pattern editor does.
+ *  This avoids the sort and relink of verify_and_link(), which would give
+ *  the same links as long as:
+ *
+ *  -   The list is sorted.
+ *  -   The note has a length, and does not reach past the slength.
+ *  -   Every event of the same note is linked, without wrapping around,
+ *      and none of these notes overlaps the new one.
+ *
+ *  The events after each insertion move up by one, so the links pointing
+ *  to them are moved up too.  If any requirement is not met, nothing is
+ *  done and the caller must append and call verify_and_link() instead.
+ *
+ * \threadunsafe
+ *      The caller must lock.
+ *
+ * \param eon
+ *      Provides the Note On to be inserted.
+ *
+ * \param eoff
+ *      Provides the Note Off to be inserted.
+ *
+ * \param slength
+ *      Provides the length beyond which events would be pruned, as in
+ *      verify_and_link().  Can be 0.
+ *
+ * \return
+ *      Returns true if the note was inserted and linked here.
+ */
+
+bool
+eventlist::insert_note
+(
+    const event & eon, const event & eoff, midipulse slength
+)
+{
+    bool result = eon.is_note_on() && eon.off_linkable(eoff) &&
+        eoff.timestamp() > eon.timestamp() && eon.timestamp() >= 0;
+
+    if (result && slength > 0)
+        result = eoff.timestamp() <= slength;
+
+    if (result)
+        result = std::is_sorted(m_events.begin(), m_events.end());
+
+    if (result)
+    {
+        for (auto ei = m_events.begin(); ei != m_events.end(); ++ei)
+        {
+            if (ei->is_note_on() && ei->get_note() == eon.get_note())
+            {
+                int off = ei->link();
+                bool ok = ei->is_linked() && off > index_of(ei);
+                if (ok)
+                {
+                    midipulse offtick = m_events[off].timestamp();
+                    ok = ei->timestamp() >= eoff.timestamp() ||
+                        offtick <= eon.timestamp();
+                }
+                if (! ok)
+                {
+                    result = false;
+                    break;
+                }
+            }
+            else if (ei->is_note_off() && ei->get_note() == eon.get_note())
+            {
+                if (! ei->is_linked())
+                {
+                    result = false;
+                    break;
+                }
+            }
+        }
+    }
+    if (result)
+    {
+        auto onpos = std::upper_bound(m_events.begin(), m_events.end(), eon);
+        int on = index_of(onpos);
+        (void) m_events.insert(onpos, eon);
+
+        auto offpos = std::upper_bound
+        (
+            m_events.begin() + on + 1, m_events.end(), eoff
+        );
+        int off = index_of(offpos);
+        (void) m_events.insert(offpos, eoff);
+        for (auto & e : m_events)
+        {
+            if (e.is_linked())
+            {
+                int index = e.link();
+                if (index >= on)
+                    ++index;
+
+                if (index >= off)
+                    ++index;
+
+                e.link(index);
+            }
+        }
+        (void) link_notes(m_events.begin() + on, m_events.begin() + off);
+        m_is_modified = true;
+        m_note_spans.build(m_events);       /* for resume_note_ons()        */
+    }
+    return result;
+}
+
 /**
  *  This function verifies state: all note-ons have an off, and it links
  *  note-offs with their note-ons.
@@ -536,6 +1056,10 @@ eventlist::link_notes (event::iterator eon, event::iterator eoff)
  *      resize or move of notes must modify for wrapping if Note Off is >=
  *      m_length.
  *
+ *  Events still shared with the list they were copied from, with a valid
+ *  note index and nothing out of range, were linked by that list, and are
+ *  left shared.
+ *
  * \threadunsafe
  *      As in most case, the caller will use an automutex to call this
  *      function safely.
@@ -557,6 +1081,14 @@ eventlist::link_notes (event::iterator eon, event::iterator eoff)
 bool
 eventlist::verify_and_link (midipulse slength, bool wrap)
 {
+    if (m_events.shared() && ! wrap && note_spans_valid())
+    {
+        bool inrange = slength <= 0 ||
+            (get_min_timestamp() >= 0 && get_max_timestamp() <= slength);
+
+        if (inrange)
+            return true;                    /* linked by the list copied    */
+    }
     clear_links();                          /* unlink, no unmark all events */
     sort();                                 /* important, but be careful... */
 
@@ -575,6 +1107,7 @@ eventlist::verify_and_link (midipulse slength, bool wrap)
      * link_tempos();
      */
 
+    m_note_spans.build(m_events);           /* for resume_note_ons()        */
     return result;
 }
 
@@ -594,10 +1127,28 @@ eventlist::clear ()
 #else
         m_events.clear();
 #endif
+        invalidate_indexes();
         m_is_modified = true;
     }
 }
 
+/**
+ *  Adds up the SysEx and Meta data held by the events, for memoryusage.
+ *  Data shared by copies of an event is counted for each copy.
+ */
+
+std::size_t
+eventlist::sysex_bytes () const
+{
+    std::size_t result = 0;
+    for (const auto & e : m_events)
+    {
+        if (e.is_ex_data())
+            result += e.get_sysex().capacity();
+    }
+    return result;
+}
+
 /**
  *  Clears all event links and unmarks them all. We get a segfault here
  *  pretty regulary when recording is enabled and the pattern's event list
@@ -616,9 +1167,80 @@ eventlist::clear_links ()
             e.clear_link();                 /* does unmark() and unlink()   */
         }
     }
+    invalidate_indexes();
     return result;
 }
 
+/**
+ *  Finds where to start drawing the events from the given tick onward.  The
+ *  events are surely sorted only while the note index is valid, so
+ *  otherwise this function returns the first event.
+ *
+ * \param tick
+ *      The first tick to be drawn, such as the left edge of the view.
+ *
+ * \param notes
+ *      If true, also start early enough to get the linked notes that start
+ *      before the tick and end at or after it.
+ *
+ * \return
+ *      Returns the first event at or after the tick, or the first Note On
+ *      of the notes reaching it, whichever comes first.
+ */
+
+event::const_iterator
+eventlist::cbegin (midipulse tick, bool notes) const
+{
+    if (! note_spans_valid())
+        return m_events.cbegin();
+
+    auto result = std::lower_bound
+    (
+        m_events.cbegin(), m_events.cend(), tick,
+        [] (const event & e, midipulse t)
+        {
+            return e.timestamp() < t;
+        }
+    );
+    if (notes)
+    {
+        std::size_t least = std::size_t(result - m_events.cbegin());
+        auto earliest = [&least] (std::size_t slot)
+        {
+            if (slot < least)
+                least = slot;
+        };
+        m_note_spans.overlapping(tick, tick - 1, earliest);
+        result = m_events.cbegin() + least;
+    }
+    return result;
+}
+
+/**
+ *  Checks for the end of the events, or for an event past the last tick to
+ *  be drawn.  The latter check is skipped if the events might not be
+ *  sorted, or if a wrapped note might be drawn from an event past the end.
+ *
+ * \param evi
+ *      The iterator to check.
+ *
+ * \param tick
+ *      The last tick to be drawn, such as the right edge of the view.
+ *
+ * \return
+ *      Returns true if the drawing loop is done.
+ */
+
+bool
+eventlist::cend (event::const_iterator evi, midipulse tick) const
+{
+    if (evi == m_events.cend())
+        return true;
+
+    return note_spans_valid() && ! m_note_spans.wrapped() &&
+        evi->timestamp() > tick;
+}
+
 int
 eventlist::playable_count () const
 {
@@ -746,11 +1368,11 @@ eventlist::edge_fix (midipulse snap, midipulse seqlength)
             if (onstamp > maximum)
             {
                 midipulse delta = seqlength - onstamp;
-                midipulse offstamp = e.link()->timestamp();
+                midipulse offstamp = linked(e)->timestamp();
                 if (offstamp < onstamp)
                 {
                     e.set_timestamp(0);         /* move to beginning    */
-                    e.link()->set_timestamp(offstamp + delta);
+                    linked(e)->set_timestamp(offstamp + delta);
                     result = true;
                 }
             }
@@ -770,18 +1392,13 @@ eventlist::edge_fix (midipulse snap, midipulse seqlength)
 bool
 eventlist::remove_unlinked_notes ()
 {
-    bool result = false;
-    for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
-    {
-        if (i->is_note_unlinked())
+    bool result = remove_if
+    (
+        [] (const event & e)
         {
-            auto t = remove(i);
-            i = t;
-            result = true;
+            return e.is_note_unlinked();
         }
-        else
-            ++i;
-    }
+    );
     if (result)
         verify_and_link();                      /* sorts as well        */
 
@@ -868,7 +1485,7 @@ eventlist::quantize_events
                      * are closer than half the snap, add the snap.
                      */
 
-                    event::iterator f = er.link();
+                    event::iterator f = linked(er);
                     if (tight)
                         f->tighten(snap, len);
                     else
@@ -924,8 +1541,13 @@ eventlist::quantize_events (int snap, int divide, bool all)
     bool tight = divide == 2;
     bool found_note = false;
     midipulse len = get_length();
+    std::size_t count = m_events.size();
+    std::size_t done = 0;
     for (auto & er : m_events)
     {
+        if (! editjob::checkpoint(++done, count))
+            break;
+
         if (all || er.is_selected())
         {
             bool ok = tight ? er.tighten(snap, len) : er.quantize(snap, len) ;
@@ -966,8 +1588,13 @@ eventlist::quantize_notes (int snap, int divide, bool all)
     bool result = false;
     midipulse len = get_length();
     bool tight = divide == 2;
+    std::size_t count = m_events.size();
+    std::size_t done = 0;
     for (auto & er : m_events)
     {
+        if (! editjob::checkpoint(++done, count))
+            break;
+
         if (all || er.is_selected_note())
         {
             if (er.is_marked())                 /* ignore marked events     */
@@ -978,7 +1605,7 @@ eventlist::quantize_notes (int snap, int divide, bool all)
             result = tight ? er.tighten(snap, len) : er.quantize(snap, len) ;
             if (er.is_note_on_linked())
             {
-                event::iterator f = er.link();
+                event::iterator f = linked(er);
                 if (tight)
                     f->tighten(snap, len);
                 else
@@ -1278,25 +1905,30 @@ eventlist::apply_time_factor (double factor, bool savenotelength, bool relink)
     bool ok = ! empty() && factor > 0.01;
     if (ok)
     {
+        std::size_t count = m_events.size();
+        std::size_t done = 0;
         for (auto & ev : m_events)
         {
+            if (! editjob::checkpoint(++done, count))
+                break;
+
             midipulse stamp = ev.timestamp();
-            bool linked = ev.is_linked();           /* do note on and off   */
+            bool haslink = ev.is_linked();          /* do note on and off   */
             if (ev.is_note_on())
             {
                 midipulse newstamp = midipulse(stamp * factor);
-                if (linked)
+                if (haslink)
                 {
-                    midipulse offstamp = ev.link()->timestamp();
+                    midipulse offstamp = linked(ev)->timestamp();
                     if (savenotelength)
                     {
                         midipulse len = offstamp - stamp;
-                        ev.link()->set_timestamp(newstamp + len);
+                        linked(ev)->set_timestamp(newstamp + len);
                     }
                     else
                     {
                         offstamp = midipulse(offstamp * factor);
-                        scale_note_off(*ev.link(), factor);
+                        scale_note_off(*linked(ev), factor);
                     }
                 }
                 ev.set_timestamp(newstamp);
@@ -1313,10 +1945,8 @@ eventlist::apply_time_factor (double factor, bool savenotelength, bool relink)
             }
         }
         if (relink)
-        {
-            sort();
-            verify_and_link();
-        }
+            verify_and_link();                  /* sorts them as well   */
+
         result = get_max_timestamp();
     }
     return result;
@@ -1347,14 +1977,14 @@ eventlist::reverse_events (bool inplace, bool relink)
             midipulse newstamp = ending - stamp + offset;
             if (ev.is_note_on())
             {
-                bool linked = ev.is_linked();   /* do note on and off   */
-                if (linked)
+                bool haslink = ev.is_linked();  /* do note on and off   */
+                if (haslink)
                 {
-                    midipulse offstamp = ev.link()->timestamp();
+                    midipulse offstamp = linked(ev)->timestamp();
                     midipulse duration = offstamp - stamp + 1;
                     newstamp = ending - offstamp + offset;
                     ev.set_timestamp(newstamp);
-                    ev.link()->set_timestamp(newstamp + duration);
+                    linked(ev)->set_timestamp(newstamp + duration);
                 }
                 else
                     ev.set_timestamp(newstamp);
@@ -1368,10 +1998,7 @@ eventlist::reverse_events (bool inplace, bool relink)
                 ev.set_timestamp(newstamp);
         }
         if (relink)
-        {
-            sort();
-            verify_and_link();
-        }
+            verify_and_link();                  /* sorts them as well   */
     }
     return result;
 }
@@ -1439,8 +2066,13 @@ eventlist::randomize_notes (int range, bool all)
     bool result = false;
     if (range > 0)
     {
+        std::size_t count = m_events.size();
+        std::size_t done = 0;
         for (auto & e : m_events)
         {
+            if (! editjob::checkpoint(++done, count))
+                break;
+
             if (all || e.is_selected_note())        /* randomizable event?  */
             {
                 if (! e.is_note_off_recorded())     /* don't ruin fake Off  */
@@ -1506,7 +2138,7 @@ eventlist::jitter_events (int snap, int jitr)
                      * Hmmmm, how about the zero-length correction???
                      */
 
-                    event::iterator f = e.link();
+                    event::iterator f = linked(e);
                     f->jitter(snap, jitr, get_length());
 
                     midipulse ts1 = e.timestamp();
@@ -1559,8 +2191,13 @@ eventlist::jitter_notes (int snap, int jitr, bool all)
     bool result = false;
     if (jitr > 0)
     {
+        std::size_t count = m_events.size();
+        std::size_t done = 0;
         for (auto & e : m_events)
         {
+            if (! editjob::checkpoint(++done, count))
+                break;
+
             if (all || e.is_selected_note())
             {
                 if (e.jitter(snap, jitr, get_length()))
@@ -1631,7 +2268,7 @@ eventlist::link_tempos ()
                 if (t2->is_tempo())
                 {
                     result = true;
-                    t->link(t2);
+                    t->link(index_of(t2));
                     break;                  /* tempos link only one way     */
                 }
                 ++t2;
@@ -1753,7 +2390,7 @@ eventlist::mark_out_of_range (midipulse slength)
             result = true;
             e.mark();
             if (e.is_linked())
-                e.link()->mark();
+                linked(e)->mark();
         }
     }
     return result;
@@ -1899,8 +2536,7 @@ eventlist::remove_first_match (const event & e, midipulse starttick)
 }
 
 /**
- *  Removes marked events.  Note how this function handles removing a
- *  value to avoid incrementing a now-invalid iterator.
+ *  Removes marked events, all in one pass.  See remove_if().
  *
  * \threadsafe
  *
@@ -1911,18 +2547,13 @@ eventlist::remove_first_match (const event & e, midipulse starttick)
 bool
 eventlist::remove_marked ()
 {
-    bool result = false;
-    for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
-    {
-        if (i->is_marked())
+    bool result = remove_if
+    (
+        [] (const event & e)
         {
-            auto t = remove(i);
-            i = t;
-            result = true;
+            return e.is_marked();
         }
-        else
-            ++i;
-    }
+    );
     if (result)
         verify_and_link();
 
@@ -1939,6 +2570,9 @@ eventlist::remove_marked ()
  *
  *  TO BE DETERMINED.
  *
+ *  The notes crossing the limit are shortened first, while their links are
+ *  still good, and then the events past it are removed in one pass.
+ *
  * \param limit
  *      The time stamp at or after which events are to be remove.
  */
@@ -1946,30 +2580,23 @@ eventlist::remove_marked ()
 bool
 eventlist::remove_trailing_events (midipulse limit)
 {
-    bool result = false;
-    for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
+    for (auto & e : m_events)
     {
-        if (i->timestamp() >= limit)
+        if (e.timestamp() < limit && e.is_note_on_linked())
         {
-            /*
-             * TODO: handled linked notes
-             */
-
-            auto t = remove(i);
-            i = t;
-            result = true;
+            auto ioff = linked(e);
+            if (ioff->timestamp() >= limit)
+                ioff->set_timestamp(limit - 1);
         }
-        else
+    }
+
+    bool result = remove_if
+    (
+        [limit] (const event & e)
         {
-            if (i->is_note_on_linked())
-            {
-                auto ioff = i->link();
-                if (ioff->timestamp() >= limit)
-                    ioff->set_timestamp(limit - 1);
-            }
-            ++i;
+            return e.timestamp() >= limit;
         }
-    }
+    );
     if (result)
         verify_and_link();
 
@@ -1977,8 +2604,7 @@ eventlist::remove_trailing_events (midipulse limit)
 }
 
 /**
- *  Removes selected events.  Note how this function handles removing a
- *  value to avoid incrementing a now-invalid iterator.
+ *  Removes selected events, all in one pass.  See remove_if().
  *
  *  We want to get rid of the concept of marking events.  Selected events can
  *  be handled directly in the event container.
@@ -1990,18 +2616,13 @@ eventlist::remove_trailing_events (midipulse limit)
 bool
 eventlist::remove_selected ()
 {
-    bool result = false;
-    for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
-    {
-        if (i->is_selected())
+    bool result = remove_if
+    (
+        [] (const event & e)
         {
-            auto t = remove(i);
-            i = t;
-            result = true;
+            return e.is_selected();
         }
-        else
-            ++i;
-    }
+    );
     if (result)
         verify_and_link();
 
@@ -2454,6 +3075,12 @@ eventlist::select_event_handle
  *  depends on the sequence::select enumeration, and we're too lazy at the
  *  moment to move that enumeration to eventlist.
  *
+ *  Rubber-banding calls this function for every move of the mouse.  So,
+ *  instead of testing every event, we get the events that might be in the
+ *  rectangle from the note grid (see the notegrid class), building it
+ *  first if the events were changed, and test only those, in the order of
+ *  the events.
+ *
  * \threadsafe
  *
  * \param tick_s
@@ -2485,15 +3112,21 @@ eventlist::select_note_events
 )
 {
     int result = 0;
-    for (auto & er : m_events)
+    std::vector<std::size_t> slots;
+    if (! m_note_grid.valid(m_events.size()))
+        m_note_grid.build(m_events);
+
+    m_note_grid.candidates(m_events, tick_s, note_h, tick_f, note_l, slots);
+    for (auto s : slots)
     {
+        event & er = m_events[s];
         int n = int(er.get_note());                 /* gets byte m_data[0]  */
         if (er.is_note() && n <= note_h && n >= note_l)
         {
             midipulse stick = 0, ftick = 0;
             if (er.is_linked())
             {
-                event::iterator ev = er.link();
+                event::iterator ev = linked(er);
                 if (er.is_note_off())
                 {
                     stick = ev->timestamp();        /* time of the Note On  */
@@ -2713,6 +3346,22 @@ eventlist::get_selected_events_interval
     return result;
 }
 
+/**
+ *  Rescales the timestamps of all events to a new PPQN.  Since
+ *  rescale_tick() never decreases, the events stay in time order, and,
+ *  since no event is moved in the container, the note links stay valid.
+ *  So there is no need to sort or to verify-and-link afterward.
+ *
+ * \param newppqn
+ *      The new PPQN.
+ *
+ * \param oldppqn
+ *      The current PPQN.
+ *
+ * \return
+ *      Returns false if the old PPQN is not valid.
+ */
+
 bool
 eventlist::rescale (int newppqn, int oldppqn)
 {
@@ -2828,7 +3477,7 @@ eventlist::grow_selected (midipulse delta, int snap)
             {
                 if (er.is_note_on() && er.is_linked())
                 {
-                    event::iterator off = er.link();
+                    event::iterator off = linked(er);
                     midipulse offtime = off->timestamp();
                     midipulse newtime = trim_timestamp(offtime + delta);
                     off->set_timestamp(newtime);    /* new off-time         */
@@ -2853,6 +3502,18 @@ eventlist::grow_selected (midipulse delta, int snap)
     return result;
 }
 
+/**
+ *  Copies the selected events to a clipboard, sliding them left so that
+ *  the first starts at tick 0.  The events are appended and sorted once,
+ *  rather than sorted as each one is added.
+ *
+ * \param [out] clipbd
+ *      The destination, normally empty.
+ *
+ * \return
+ *      Returns true if any events were copied.
+ */
+
 bool
 eventlist::copy_selected (eventlist & clipbd)
 {
@@ -2860,10 +3521,12 @@ eventlist::copy_selected (eventlist & clipbd)
     for (auto & e : m_events)
     {
         if (e.is_selected())
-            clipbd.add(e);                              /* sorts every time */
+            (void) clipbd.append(e);
     }
     if (! clipbd.empty())
     {
+        clipbd.sort();                                  /* once, at the end */
+
         midipulse first_tick = dref(clipbd.begin()).timestamp();
         if (first_tick >= 0)
         {
@@ -2876,25 +3539,41 @@ eventlist::copy_selected (eventlist & clipbd)
                     result = true;
                 }
             }
-            if (result)
-                std::sort(clipbd.m_events.begin(), clipbd.m_events.end());
         }
     }
     return result;
 }
 
+/**
+ *  Pastes the clipboard at the given tick, with the highest note moved to
+ *  the given note.  The clipboard is left alone, as it may be shared; each
+ *  event is copied once, straight into this list, and moved there.
+ *
+ * \param clipbd
+ *      The events from copy_selected().
+ *
+ * \param tick
+ *      The destination of the first event.
+ *
+ * \param note
+ *      The destination of the highest note.
+ *
+ * \return
+ *      Returns true if there were events to paste.
+ */
+
 bool
-eventlist::paste_selected (eventlist & clipbd, midipulse tick, int note)
+eventlist::paste_selected
+(
+    const eventlist & clipbd, midipulse tick, int note
+)
 {
-    bool result = false;
-    if (! clipbd.empty())
+    bool result = ! clipbd.empty();
+    if (result)
     {
         int highest_note = 0;
-        for (auto & e : clipbd)
+        for (const auto & e : clipbd.m_events)
         {
-            midipulse t = e.timestamp();
-            e.set_timestamp(t + tick);
-            result = true;
             if (e.is_note())                    /* includes Aftertouch      */
             {
                 midibyte n = e.get_note();
@@ -2904,17 +3583,16 @@ eventlist::paste_selected (eventlist & clipbd, midipulse tick, int note)
         }
 
         int note_delta = note - highest_note;
-        for (auto & e : clipbd)
+        m_events.reserve(m_events.size() + clipbd.m_events.size());
+        for (const auto & e : clipbd.m_events)
         {
-            if (e.is_note())                    /* includes Aftertouch      */
-            {
-                midibyte n = e.get_note();
-                e.set_note(n + note_delta);
-                result = true;
-            }
+            m_events.push_back(e);
+            event & er = m_events.back();
+            er.set_timestamp(e.timestamp() + tick);
+            if (er.is_note())                   /* includes Aftertouch      */
+                er.set_note(e.get_note() + note_delta);
         }
-        merge(clipbd);                          /* will presort clipboard   */
-        verify_and_link();                      /* vice remove_selected()   */
+        verify_and_link();                      /* sorts and links          */
     }
     return result;
 }
@@ -2997,7 +3675,7 @@ eventlist::print_notes (const std::string & tag) const
     if (count() > 0)
     {
         for (auto & e : m_events)
-            e.print_note();
+            e.print_note(true, e.is_linked() ? &*linked(e) : nullptr);
     }
 }
 
@@ -3017,6 +3695,147 @@ eventlist::to_string () const
     return result;
 }
 
+/*
+ * --------------------------------------------------------------
+ *  eventstack
+ * --------------------------------------------------------------
+ */
+
+eventstack::eventstack () :
+    m_entries   (),
+    m_bytes     (0)
+{
+    // no code
+}
+
+/**
+ *  Pushes a copy of the event list.  The previous top of the stack is then
+ *  reduced to the events in which it differs from the new top.
+ *
+ * \param evl
+ *      The event list to push, normally the events of the sequence just
+ *      before an edit.
+ */
+
+void
+eventstack::push (const eventlist & evl)
+{
+    if (! m_entries.empty())
+    {
+        entry & older = m_entries.back();
+        event::buffer & oldevs = older.list.m_events;
+        const event::buffer & newevs = evl.m_events;
+        std::size_t limit = std::min(oldevs.size(), newevs.size());
+        std::size_t p = 0;
+        while (p < limit && same(oldevs[p], newevs[p]))
+            ++p;
+
+        std::size_t s = 0;
+        while
+        (
+            s < limit - p &&
+            same(oldevs[oldevs.size() - 1 - s], newevs[newevs.size() - 1 - s])
+        )
+        {
+            ++s;
+        }
+        m_bytes -= bytes(older);
+
+        event::buffer middle(oldevs.begin() + p, oldevs.end() - s);
+        oldevs.swap(middle);                        /* frees the full list  */
+        older.prefix = p;
+        older.suffix = s;
+        older.full = false;
+        m_bytes += bytes(older);
+    }
+    m_entries.push_back(entry{evl, 0, 0, true});
+    m_bytes += bytes(m_entries.back());
+    trim();
+}
+
+/**
+ *  Removes the top of the stack, after rebuilding the full event list of
+ *  the entry below it from the differences stored in that entry.  As with
+ *  std::stack, the caller must first make sure the stack is not empty.
+ */
+
+void
+eventstack::pop ()
+{
+    const event::buffer & newevs = m_entries.back().list.m_events;
+    m_bytes -= bytes(m_entries.back());
+    if (m_entries.size() > 1)
+    {
+        entry & older = m_entries[m_entries.size() - 2];
+        event::buffer & middle = older.list.m_events;
+        event::buffer full;
+        full.reserve(older.prefix + middle.size() + older.suffix);
+        full.insert
+        (
+            full.end(), newevs.begin(), newevs.begin() + older.prefix
+        );
+        full.insert(full.end(), middle.begin(), middle.end());
+        full.insert(full.end(), newevs.end() - older.suffix, newevs.end());
+        m_bytes -= bytes(older);
+        middle.swap(full);
+        older.prefix = older.suffix = 0;
+        older.full = true;
+        m_bytes += bytes(older);
+    }
+    m_entries.pop_back();
+}
+
+/**
+ *  Compares all of the event members that are saved in the undo history.
+ *  The links are not compared, since they are rebuilt after an undo.
+ */
+
+bool
+eventstack::same (const event & e1, const event & e2)
+{
+    return
+        e1.timestamp() == e2.timestamp() &&
+        e1.get_status() == e2.get_status() &&
+        e1.channel() == e2.channel() &&
+        e1.d0() == e2.d0() && e1.d1() == e2.d1() &&
+        e1.input_bus() == e2.input_bus() &&
+        e1.is_selected() == e2.is_selected() &&
+        e1.is_marked() == e2.is_marked() &&
+        e1.is_painted() == e2.is_painted() &&
+        e1.get_sysex() == e2.get_sysex();
+}
+
+/**
+ *  Estimates the memory held by the events of an entry.  The SysEx data is
+ *  shared between the copies of an event, and so is not counted.
+ */
+
+std::size_t
+eventstack::bytes (const entry & ent)
+{
+    return ent.list.m_events.capacity() * sizeof(event);
+}
+
+/**
+ *  Forgets the oldest entries while the memory used exceeds the limit.  An
+ *  entry depends only on the newer entry above it, so the oldest one can
+ *  always be dropped.  The newest entry is always kept.
+ */
+
+void
+eventstack::trim ()
+{
+    std::size_t limit = std::size_t(usr().undo_limit()) * 1024 * 1024;
+    if (limit > 0)
+    {
+        while (m_bytes > limit && m_entries.size() > 1)
+        {
+            m_bytes -= bytes(m_entries.front());
+            m_entries.pop_front();
+        }
+    }
+}
+
 }           // namespace seq66
 
 /*
@@ -0,0 +1,539 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          filebench.cpp
+ *
+ *  This module defines the measurement of the file loaders and writers.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Usage:
+ *
+\verbatim
+    seq66cli --file-bench [--synthetic n] [--measures n] [--repeat n]
+        [file ...]
+\endverbatim
+ *
+ *  For example, "seq66cli --file-bench data/midi/\*.midi data/samples/\*"
+ *  measures the sample corpus.  Throughput is the size of the file over the
+ *  time of one pass.  The peak resident size is that of the whole run so
+ *  far, as reported by getrusage(), where available.  Allocations are not
+ *  counted, as that would need a global operator new hook in the library.
+ *
+ *  The written files go to the home configuration directory, and are
+ *  removed afterward.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdlib>                      /* EXIT_SUCCESS, EXIT_FAILURE       */
+#include <iostream>                     /* std::cout                        */
+
+#include "seq66_platform_macros.h"      /* detecting Linux vs Windows       */
+#include "cfg/playlistfile.hpp"         /* seq66::open_playlist()           */
+#include "cfg/rcfile.hpp"               /* seq66::rcfile                    */
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/filebench.hpp"           /* seq66::filebench class           */
+#include "midi/midifile.hpp"            /* seq66::midifile, read_midi_file()*/
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/playlist.hpp"            /* seq66::playlist                  */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "util/filefunctions.hpp"       /* seq66::file_size(), etc.         */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <sys/resource.h>               /* ::getrusage()                    */
+#endif
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The synthetic SMF has one pattern per slot, up to seq::maximum(), and
+ *  4096 measures of 16th notes is some 150,000 events a pattern, so these
+ *  bound the size of the file built in memory.  The repeat count bounds
+ *  the run time, as each repeat reads and writes every file again.
+ */
+
+static const int c_bench_patterns_max = 1024;
+static const int c_bench_measures_max = 4096;
+static const int c_bench_repeat_max = 10000;
+
+/**
+ *  Times one call of a function.
+ *
+ * \return
+ *      Returns the elapsed time in nanoseconds.
+ */
+
+template <typename F>
+static double
+time_ns (F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    return double
+    (
+        std::chrono::duration_cast<std::chrono::nanoseconds>
+        (
+            finish - start
+        ).count()
+    );
+}
+
+filebench::filebench () :
+    m_files         (),
+    m_synthetic     (64),
+    m_measures      (256),
+    m_repeat        (10)
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if "--file-bench" is on the command line.
+ */
+
+bool
+filebench::requested (int argc, char * argv [])
+{
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--file-bench")
+            return true;
+    }
+    return false;
+}
+
+void
+filebench::show_help ()
+{
+    std::cout <<
+"File benchmark options (no MIDI ports are opened):\n\n"
+"  --file-bench         Measure reading (and, for SMF, writing) of MIDI,\n"
+"                       WRK, play-list, and 'rc' files, or of a synthetic\n"
+"                       SMF if no files are given.\n"
+"  --synthetic n        Patterns in the synthetic SMF (default 64).\n"
+"  --measures n         Measures in each synthetic pattern (default 256).\n"
+"  --repeat n           Times to read and write each file (default 10).\n"
+    ;
+}
+
+/**
+ *  Gets the benchmark options and the list of files.
+ *
+ * \return
+ *      Returns true if the options are good.
+ */
+
+bool
+filebench::parse (int argc, char * argv [])
+{
+    bool result = true;
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--file-bench")
+        {
+            // already handled by requested()
+        }
+        else if
+        (
+            arg == "--synthetic" || arg == "--measures" || arg == "--repeat"
+        )
+        {
+            if (++argn < argc)
+            {
+                int value = std::atoi(argv[argn]);
+                if (arg == "--synthetic")
+                {
+                    m_synthetic = value;
+                    result = value > 0 && value <= c_bench_patterns_max;
+                }
+                else if (arg == "--measures")
+                {
+                    m_measures = value;
+                    result = value > 0 && value <= c_bench_measures_max;
+                }
+                else
+                {
+                    m_repeat = value;
+                    result = value > 0 && value <= c_bench_repeat_max;
+                }
+            }
+            else
+                result = false;
+        }
+        else if (arg.length() > 1 && arg[0] == '-')
+            result = false;
+        else
+            m_files.push_back(arg);
+
+        if (! result)
+        {
+            errprintf("Bad file-bench option '%s'", arg.c_str());
+            break;
+        }
+    }
+    if (! result)
+        show_help();
+
+    return result;
+}
+
+/**
+ *  Measures each file, or a generated one.
+ *
+ * \return
+ *      Returns EXIT_SUCCESS if every measurement could be made.
+ */
+
+int
+filebench::run ()
+{
+    int failures = 0;
+    if (m_files.empty())
+    {
+        std::string fname = filename_concatenate
+        (
+            rc().home_config_directory(), "filebench-synthetic.midi"
+        );
+        if (make_synthetic(fname))
+        {
+            if (! measure_midi(fname))
+                ++failures;
+
+            (void) file_delete(fname);
+        }
+        else
+            ++failures;
+    }
+    else
+    {
+        for (const auto & fname : m_files)
+        {
+            bool ok;
+            if (file_extension_match(fname, "playlist"))
+                ok = measure_playlist(fname);
+            else if (file_extension_match(fname, "rc"))
+                ok = measure_config(fname);
+            else
+                ok = measure_midi(fname);
+
+            if (! ok)
+                ++failures;
+        }
+    }
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS ;
+}
+
+/**
+ *  Writes an SMF of long patterns of 16th notes, with a control change on
+ *  each beat, so that the reader has plenty of running status and
+ *  note-linking to do.
+ */
+
+bool
+filebench::make_synthetic (const std::string & fname)
+{
+    int ppqn = choose_ppqn();
+    performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) p.get_settings(rc(), usr());
+    midipulse sixteenth = p.ppqn() / 4;
+    midipulse measure = p.ppqn() * 4;
+    midipulse length = measure * m_measures;
+    for (int s = 0; s < m_synthetic; ++s)
+    {
+        seq::number seqno = seq::number(s);
+        if (! p.new_sequence(seqno, seqno))
+            return false;
+
+        seq::pointer sp = p.get_sequence(seqno);
+        if (! sp)
+            return false;
+
+        midibyte channel = midibyte(s % 16);
+        (void) sp->set_length(length);
+        (void) sp->set_midi_channel(channel);
+        int note = 36 + s % 48;
+        for (midipulse t = 0; t < length; t += sixteenth)
+        {
+            (void) sp->add_painted_note(t, sixteenth / 2, note, false, 100);
+            if (t % p.ppqn() == 0)
+            {
+                midibyte value = midibyte((t / p.ppqn()) % 128);
+                event e(t, EVENT_CONTROL_CHANGE, 7, value);
+                e.set_channel(channel);
+                (void) sp->add_event(e);
+            }
+        }
+    }
+
+    midifile f(fname, p.ppqn(), false);
+    bool result = f.write(p);
+    if (! result)
+        file_error(f.error_message(), fname);
+
+    return result;
+}
+
+/**
+ *  Reads a MIDI or WRK file several times.  For an SMF, it then writes the
+ *  song several times and reads the result back, comparing its patterns
+ *  and events to those first read.
+ */
+
+bool
+filebench::measure_midi (const std::string & fname)
+{
+    size_t bytes = file_size(fname);
+    int ppqn = choose_ppqn();
+    performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) p.get_settings(rc(), usr());
+
+    std::string errmsg;
+    bool result = true;
+    double ns = 0.0;
+    for (int r = 0; r < m_repeat && result; ++r)
+    {
+        usr().clear_global_seq_features();
+        ns += time_ns
+        (
+            [&] ()
+            {
+                result = read_midi_file(p, fname, p.ppqn(), errmsg, false);
+            }
+        );
+    }
+    if (! result)
+    {
+        file_error(errmsg, fname);
+        return false;
+    }
+
+    int patterns = 0;
+    long events = events_of(p, patterns);
+    report(fname, "read", bytes, ns / m_repeat);
+    std::cout
+        << "    " << patterns << " patterns, " << events << " events"
+        << std::endl
+        ;
+    if (file_extension_match(fname, "wrk"))
+        return true;                            /* no WRK writer        */
+
+    std::string outname = filename_concatenate
+    (
+        rc().home_config_directory(), "filebench-output.midi"
+    );
+    bool glob = usr().global_seq_feature();
+    ns = 0.0;
+    for (int r = 0; r < m_repeat && result; ++r)
+    {
+        midifile f(outname, p.ppqn(), glob);
+        ns += time_ns
+        (
+            [&] ()
+            {
+                result = f.write(p);
+            }
+        );
+        if (! result)
+            errmsg = f.error_message();
+    }
+    if (result)
+    {
+        report(fname, "write", file_size(outname), ns / m_repeat);
+
+        performer q(p.ppqn(), usr().mainwnd_rows(), usr().mainwnd_cols());
+        (void) q.get_settings(rc(), usr());
+        usr().clear_global_seq_features();
+        result = read_midi_file(q, outname, q.ppqn(), errmsg, false);
+        if (result)
+        {
+            int qpatterns = 0;
+            long qevents = events_of(q, qpatterns);
+            bool same = qpatterns == patterns && qevents == events;
+            std::cout
+                << "    round trip: "
+                << (same ? "same patterns and events" : "DIFFERS: ")
+                ;
+            if (! same)
+                std::cout << qpatterns << " patterns, " << qevents << " events";
+
+            std::cout << std::endl;
+        }
+    }
+    if (! result)
+        file_error(errmsg, outname);
+
+    (void) file_delete(outname);
+    return result;
+}
+
+/**
+ *  Reads a play-list file several times.  The song files it names are
+ *  checked for, but not read.
+ */
+
+bool
+filebench::measure_playlist (const std::string & fname)
+{
+    size_t bytes = file_size(fname);
+    int ppqn = choose_ppqn();
+    performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) p.get_settings(rc(), usr());
+
+    bool result = true;
+    double ns = 0.0;
+    for (int r = 0; r < m_repeat && result; ++r)
+    {
+        playlist pl(&p, fname, false);
+        ns += time_ns
+        (
+            [&] ()
+            {
+                result = open_playlist(pl, fname, false);
+            }
+        );
+    }
+    if (result)
+        report(fname, "read", bytes, ns / m_repeat);
+    else
+        file_error("Play-list read failed", fname);
+
+    return result;
+}
+
+/**
+ *  Reads an 'rc' file several times, into a copy of the settings, so that
+ *  the settings of this run are not changed.
+ */
+
+bool
+filebench::measure_config (const std::string & fname)
+{
+    size_t bytes = file_size(fname);
+    bool result = true;
+    double ns = 0.0;
+    for (int r = 0; r < m_repeat && result; ++r)
+    {
+        rcsettings rcs = rc();
+        rcfile options(fname, rcs);
+        ns += time_ns
+        (
+            [&] ()
+            {
+                result = options.parse();
+            }
+        );
+    }
+    if (result)
+        report(fname, "read", bytes, ns / m_repeat);
+    else
+        file_error("Configuration read failed", fname);
+
+    return result;
+}
+
+/**
+ *  Shows one throughput line.
+ */
+
+void
+filebench::report
+(
+    const std::string & name, const std::string & what,
+    size_t bytes, double ns
+) const
+{
+    double seconds = ns / 1.0e9;
+    double mbps = seconds > 0.0 ? double(bytes) / 1.0e6 / seconds : 0.0 ;
+    std::cout
+        << name << ": " << what << " " << bytes << " bytes, "
+        << ns / 1.0e6 << " ms, " << mbps << " MB/s";
+
+    long rss = peak_rss_kb();
+    if (rss > 0)
+        std::cout << ", peak RSS " << rss << " kB";
+
+    std::cout << std::endl;
+}
+
+/**
+ *  Counts the patterns and events of the performer.
+ */
+
+long
+filebench::events_of (performer & p, int & patterns)
+{
+    long result = 0;
+    patterns = 0;
+    for (int s = 0; s < p.sequence_high(); ++s)
+    {
+        if (p.is_seq_active(s))
+        {
+            seq::pointer sp = p.get_sequence(s);
+            result += long(sp->event_count());
+            ++patterns;
+        }
+    }
+    return result;
+}
+
+/**
+ * \return
+ *      Returns the peak resident size of the process, in kB, or 0 if it is
+ *      not available.
+ */
+
+long
+filebench::peak_rss_kb ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined SEQ66_PLATFORM_MACOSX
+        return long(usage.ru_maxrss / 1024);    /* bytes on macOS       */
+#else
+        return long(usage.ru_maxrss);           /* kB on Linux          */
+#endif
+    }
+#endif
+    return 0;
+}
+
+}           // namespace seq66
+
+/*
+ * filebench.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
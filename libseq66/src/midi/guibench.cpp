@@ -0,0 +1,200 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          guibench.cpp
+ *
+ *  This module defines the settings and the song of the user-interface
+ *  benchmark.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The song is built in a scratch performer and written as an SMF, so that
+ *  the main window loads it exactly as it would a real song.
+ */
+
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/guibench.hpp"            /* seq66::guibench class            */
+#include "midi/midifile.hpp"            /* seq66::midifile                  */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "util/basic_macros.hpp"        /* errprint(), etc.                 */
+#include "util/strfunctions.hpp"        /* seq66::tokenize(), etc.          */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The defaults make a song of 65536 notes in 128 patterns, with 4096 song
+ *  triggers.
+ */
+
+guibench::guibench () :
+    m_active    (false),
+    m_patterns  (128),
+    m_events    (512),
+    m_triggers  (32),
+    m_seconds   (20)
+{
+    // no code
+}
+
+/**
+ *  Activates the benchmark and reads its settings.
+ *
+ * \param spec
+ *      The argument of --gui-bench, such as "patterns=64,seconds=10".  An
+ *      empty spec keeps the defaults.
+ *
+ * \return
+ *      Returns false if an item is not understood; the benchmark is still
+ *      active, with the items that were understood.
+ */
+
+bool
+guibench::parse (const std::string & spec)
+{
+    bool result = true;
+    m_active = true;
+    tokenization items = tokenize(spec, ",");
+    for (const auto & item : items)
+    {
+        std::string::size_type eq = item.find('=');
+        std::string key = item.substr(0, eq);
+        int value = eq != std::string::npos ?
+            string_to_int(item.substr(eq + 1), 0) : 0 ;
+
+        if (value <= 0)
+            result = false;
+        else if (key == "patterns")
+            m_patterns = value;
+        else if (key == "events")
+            m_events = value;
+        else if (key == "triggers")
+            m_triggers = value;
+        else if (key == "seconds")
+            m_seconds = value;
+        else
+            result = false;
+
+        if (! result)
+        {
+            errprintf("--gui-bench: bad item '%s'", item.c_str());
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Writes the benchmark song.  Each pattern holds 16th notes on its own
+ *  note and channel, with a control change on each beat, and is rounded up
+ *  to whole measures.  Its triggers are spaced one pattern length apart,
+ *  the odd patterns falling in the gaps of the even ones, so that the song
+ *  editor has a checkerboard to draw.
+ *
+ * \param fname
+ *      The file to write, which is replaced.
+ *
+ * \return
+ *      Returns true if the song was built and written.
+ */
+
+bool
+guibench::write_song (const std::string & fname) const
+{
+    int ppqn = choose_ppqn();
+    performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) p.get_settings(rc(), usr());
+
+    midipulse sixteenth = p.ppqn() / 4;
+    midipulse measure = p.ppqn() * 4;
+    midipulse length = sixteenth * m_events;
+    length = ((length + measure - 1) / measure) * measure;
+    for (int s = 0; s < m_patterns; ++s)
+    {
+        seq::number seqno = seq::number(s);
+        seq::pointer sp;
+        if (p.new_sequence(seqno, seqno))
+            sp = p.get_sequence(seqno);
+
+        if (! sp)
+        {
+            errprintf("--gui-bench: cannot make pattern %d", s);
+            return false;
+        }
+
+        midibyte channel = midibyte(s % 16);
+        int note = 36 + s % 48;
+        (void) sp->set_length(length);
+        (void) sp->set_midi_channel(channel);
+        for (int n = 0; n < m_events; ++n)
+        {
+            midipulse t = sixteenth * n;
+            (void) sp->add_painted_note(t, sixteenth / 2, note, false, 100);
+            if (t % p.ppqn() == 0)
+            {
+                midibyte value = midibyte((t / p.ppqn()) % 128);
+                event e(t, EVENT_CONTROL_CHANGE, 7, value);
+                e.set_channel(channel);
+                (void) sp->add_event(e);
+            }
+        }
+        for (int k = 0; k < m_triggers; ++k)
+        {
+            midipulse tick = length * (2 * k + s % 2);
+            (void) sp->add_trigger(tick, length);
+        }
+    }
+
+    midifile f(fname, p.ppqn(), false);
+    bool result = f.write(p);
+    if (! result)
+        file_error(f.error_message(), fname);
+
+    return result;
+}
+
+/**
+ *  The global object, set by the --gui-bench option and read by the main
+ *  window.
+ */
+
+guibench &
+gui_bench ()
+{
+    static guibench s_gui_bench;
+    return s_gui_bench;
+}
+
+}           // namespace seq66
+
+/*
+ * guibench.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,350 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          inputfilter.cpp
+ *
+ *  This module defines the chain of input filters.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The text form of a filter is a list of stages separated by spaces, each
+ *  a name and a number or range separated by a colon, such as:
+ *
+ *      noclock nosense channel:1-2 notes:0-59 curve:70
+ *
+ *  The noclock and nosense stages take no number.  The cheap stages, which
+ *  drop the most messages, are best put first.
+ */
+
+#include <cmath>                        /* std::pow()                       */
+
+#include "midi/event.hpp"               /* seq66::event and MIDI statuses   */
+#include "midi/inputfilter.hpp"         /* seq66::inputfilter class         */
+#include "util/strfunctions.hpp"        /* seq66::tokenize()                */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Gets a number, or a range of numbers such as "36-59".
+ *
+ * \param text
+ *      The text after the colon of the stage.
+ *
+ * \param [out] low
+ *      The number, or the low end of the range.
+ *
+ * \param [out] high
+ *      The number, or the high end of the range.
+ *
+ * \return
+ *      Returns false if the text is empty.
+ */
+
+static bool
+get_range (const std::string & text, int & low, int & high)
+{
+    bool result = ! text.empty();
+    if (result)
+    {
+        if (! string_to_int_pair(text, low, high, "-"))
+        {
+            low = string_to_int(text);
+            high = low;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Creates an empty filter, which passes everything.
+ */
+
+inputfilter::inputfilter () :
+    m_steps         (),
+    m_curve_table   ()
+{
+    // no code
+}
+
+/**
+ *  Creates a filter from its text form.  If that is bad, the filter is
+ *  empty.
+ */
+
+inputfilter::inputfilter (const std::string & spec) :
+    m_steps         (),
+    m_curve_table   ()
+{
+    (void) parse(spec);
+}
+
+/**
+ *  Replaces the stages with those of the text form.
+ *
+ * \param spec
+ *      The stages, such as "noclock channel:10".
+ *
+ * \return
+ *      Returns false if a stage is unknown or its value is out of range,
+ *      in which case the filter is left empty.
+ */
+
+bool
+inputfilter::parse (const std::string & spec)
+{
+    bool result = true;
+    clear();
+    tokenization tokens = tokenize(spec, " ");
+    for (const auto & t : tokens)
+    {
+        auto colon = t.find(':');
+        std::string name = t.substr(0, colon);
+        std::string value = colon != std::string::npos ?
+            t.substr(colon + 1) : std::string("") ;
+
+        int low = 0, high = 0;
+        if (name.empty())
+            continue;
+        else if (name == "channel")
+        {
+            result = get_range(value, low, high);
+            if (result)
+                result = add(stage::channel, low - 1, high - 1);
+        }
+        else if (name == "notes")
+        {
+            result = get_range(value, low, high);
+            if (result)
+                result = add(stage::notes, low, high);
+        }
+        else if (name == "curve")
+            result = add(stage::curve, string_to_int(value));
+        else if (name == "noclock")
+            result = add(stage::noclock);
+        else if (name == "nosense")
+            result = add(stage::nosense);
+        else
+            result = false;
+
+        if (! result)
+        {
+            clear();
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Makes the text form of the stages.
+ */
+
+std::string
+inputfilter::to_string () const
+{
+    std::string result;
+    for (const auto & s : m_steps)
+    {
+        std::string text;
+        switch (s.fs_kind)
+        {
+        case stage::channel:
+            text = "channel:" + std::to_string(s.fs_low + 1);
+            if (s.fs_high != s.fs_low)
+                text += "-" + std::to_string(s.fs_high + 1);
+            break;
+
+        case stage::notes:
+            text = "notes:" + std::to_string(s.fs_low) +
+                "-" + std::to_string(s.fs_high);
+            break;
+
+        case stage::curve:
+            text = "curve:" + std::to_string(s.fs_low);
+            break;
+
+        case stage::noclock:
+            text = "noclock";
+            break;
+
+        case stage::nosense:
+            text = "nosense";
+            break;
+        }
+        if (! result.empty())
+            result += " ";
+
+        result += text;
+    }
+    return result;
+}
+
+/**
+ *  Appends a stage.
+ *
+ * \param kind
+ *      The kind of stage.
+ *
+ * \param low
+ *      The parameter of the stage, or the low end of its range.  A channel
+ *      is 0 to 15 here.
+ *
+ * \param high
+ *      The high end of the range of a channel or notes stage.
+ *
+ * \return
+ *      Returns false if the values are out of range for the stage.
+ */
+
+bool
+inputfilter::add (stage kind, int low, int high)
+{
+    bool result;
+    switch (kind)
+    {
+    case stage::channel:
+        result = low >= 0 && low <= high && high < c_midichannel_max;
+        break;
+
+    case stage::notes:
+        result = low >= 0 && low <= high && high < c_notes_count;
+        break;
+
+    case stage::curve:
+        result = low >= 25 && low <= 400;
+        if (result)
+        {
+            double power = double(low) / 100.0;
+            m_curve_table.assign(std::size_t(c_notes_count), 0);
+            for (int v = 1; v < c_notes_count; ++v)
+            {
+                double x = double(v) / double(c_notes_count - 1);
+                int vel = int(std::pow(x, power) * (c_notes_count - 1) + 0.5);
+                if (vel < 1)
+                    vel = 1;
+
+                m_curve_table[std::size_t(v)] = midibyte(vel);
+            }
+        }
+        break;
+
+    default:
+        result = true;
+        break;
+    }
+    if (result)
+    {
+        step s;
+        s.fs_kind = kind;
+        s.fs_low = low;
+        s.fs_high = high;
+        m_steps.push_back(s);
+    }
+    return result;
+}
+
+/**
+ *  Runs the stages over a message.  Called from the real-time thread of the
+ *  backend, so it only reads the stages, and changes nothing but the bytes
+ *  of the message.
+ *
+ * \param [inout] bytes
+ *      The bytes of the message, starting with its status.  A curve stage
+ *      can change the velocity.  A part of a SysEx message, or of a
+ *      message without a status byte, passes as is.
+ *
+ * \param count
+ *      The number of bytes.
+ *
+ * \return
+ *      Returns false if the message is to be dropped.
+ */
+
+bool
+inputfilter::apply (midibyte * bytes, std::size_t count) const
+{
+    if (count == 0 || bytes[0] < EVENT_NOTE_OFF)
+        return true;
+
+    midibyte status = bytes[0];
+    bool channelmsg = status < EVENT_MIDI_REALTIME;
+    midibyte kind = status & EVENT_GET_STATUS_MASK;
+    bool note = channelmsg && count >= 3 && kind <= EVENT_AFTERTOUCH;
+    for (const auto & s : m_steps)
+    {
+        switch (s.fs_kind)
+        {
+        case stage::channel:
+            if (channelmsg)
+            {
+                int channel = int(status & EVENT_GET_CHAN_MASK);
+                if (channel < s.fs_low || channel > s.fs_high)
+                    return false;
+            }
+            break;
+
+        case stage::notes:
+            if (note)
+            {
+                int n = int(bytes[1]);
+                if (n < s.fs_low || n > s.fs_high)
+                    return false;
+            }
+            break;
+
+        case stage::curve:
+            if (note && kind == EVENT_NOTE_ON && ! m_curve_table.empty())
+            {
+                midibyte & vel = bytes[2];
+                if (vel < midibyte(c_notes_count))
+                    vel = m_curve_table[vel];
+            }
+            break;
+
+        case stage::noclock:
+            if (status == EVENT_MIDI_CLOCK)
+                return false;
+            break;
+
+        case stage::nosense:
+            if (status == EVENT_MIDI_ACTIVE_SENSE)
+                return false;
+            break;
+        }
+    }
+    return true;
+}
+
+}           // namespace seq66
+
+/*
+ * inputfilter.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
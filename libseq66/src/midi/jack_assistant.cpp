@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-14
- * \updates       2022-10-11
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module was created from code that existed in the performer object.
@@ -105,6 +105,7 @@
 #include <string.h>                     /* strdup() <gasp!>                 */
 
 #include "midi/jack_assistant.hpp"      /* this seq66::jack_ass class       */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
 #include "play/performer.hpp"           /* seq66::performer class           */
 #include "cfg/settings.hpp"             /* "rc" and "user" settings         */
 
@@ -185,6 +186,77 @@ jack_assistant::get_jack_parameters ()
     return sm_jack_parameters;
 }
 
+/**
+ *  Storage for the JACK-driven engine hook.
+ */
+
+std::atomic<jack_assistant::engine_function>
+jack_assistant::sm_engine_function(nullptr);
+
+void * jack_assistant::sm_engine_arg = nullptr;
+
+std::atomic<unsigned> jack_assistant::sm_process_cycles(0);
+
+/**
+ *  Installs or removes the JACK-driven engine hook.  The performer installs
+ *  it when playback starts with "output-scheduler = jack", and removes it
+ *  when playback stops.
+ *
+ * \param f
+ *      The function to call in each JACK MIDI process cycle, or nullptr to
+ *      remove the hook.
+ *
+ * \param arg
+ *      The argument to pass to the function.  Ignored when removing.
+ */
+
+void
+jack_assistant::engine (engine_function f, void * arg)
+{
+    if (not_nullptr(f))
+    {
+        sm_engine_arg = arg;
+        sm_engine_function.store(f, std::memory_order_release);
+    }
+    else
+        sm_engine_function.store(nullptr, std::memory_order_release);
+}
+
+/**
+ *  Called by the JACK MIDI process callback (see midi_jack_info) at the
+ *  beginning of each cycle, before the output ports are emptied.  Also
+ *  counts the cycles so that engine_available() can be checked.
+ *
+ * \param nframes
+ *      The number of frames in this process cycle.
+ *
+ * \param rate
+ *      The JACK sample rate.
+ *
+ * \param [out] window
+ *      Filled with the tick-to-frame mapping for this cycle.
+ *
+ * \return
+ *      Returns true if the engine hook ran and played this cycle.
+ */
+
+bool
+jack_assistant::run_engine
+(
+    jack_nframes_t nframes,
+    jack_nframes_t rate,
+    engine_window & window
+)
+{
+    bool result = false;
+    engine_function f = sm_engine_function.load(std::memory_order_acquire);
+    sm_process_cycles.fetch_add(1, std::memory_order_relaxed);
+    if (not_nullptr(f))
+        result = f(sm_engine_arg, nframes, rate, window);
+
+    return result;
+}
+
 /**
  *  Apparently, MIDI pulses are 10 times the size of JACK ticks. So we need,
  *  in some places, to convert pulses (ticks) to JACK ticks by multiplying by
@@ -319,12 +391,17 @@ jack_dummy_callback (jack_nframes_t nframes, void * arg)
 int
 jack_transport_callback (jack_nframes_t /*nframes*/, void * arg)
 {
+    trace_scope ts("JACK transport");
     jack_assistant * j = reinterpret_cast<jack_assistant *>(arg);
     if (not_nullptr(j))
     {
         jack_position_t pos;
+        j->apply_locate();                      /* one seek per period      */
+
         jack_transport_state_t s = ::jack_transport_query(j->client(), &pos);
         performer & p = j->parent();
+        if (j->m_period_sync)
+            j->publish_period(pos, s);
 
         /*
          * int psize = ::jack_get_buffer_size(j->client());
@@ -891,7 +968,11 @@ jack_assistant::jack_assistant
     m_ppqn                      (choose_ppqn(ppqn)),
     m_beats_per_measure         (bpmeasure),
     m_beat_width                (beatwidth),
-    m_beats_per_minute          (bpminute)
+    m_beats_per_minute          (bpminute),
+    m_period                    (),
+    m_period_sequence           (0),
+    m_period_sync               (false),
+    m_locate_frame              (-1)
 {
     /*
      * Do this in the rtmidi constructor.
@@ -1009,6 +1090,8 @@ bool
 jack_assistant::init ()
 {
     bool result = rc().with_jack_transport() && ! m_jack_running;
+    m_period_sync = rc().jack_period_sync();
+    m_period_sequence.store(0);
     if (result)
     {
         std::string kind = rc().with_jack_master() ? "master" : "slave" ;
@@ -1200,6 +1283,7 @@ jack_assistant::start ()
 {
     if (m_jack_running)
     {
+        apply_locate();                         /* locate, then roll        */
         ::jack_transport_start(m_jack_client);
         if (is_master())
             set_position(parent().get_tick());
@@ -1314,33 +1398,58 @@ void
 jack_assistant::position (bool songmode, midipulse tick)
 {
 #if defined SEQ66_JACK_SUPPORT
-    if (songmode)                               /* master in song mode  */
-        tick = is_null_midipulse(tick) ? 0 : tick * c_jack_factor ;
-    else
+    if (! songmode || is_null_midipulse(tick))  /* master in song mode  */
         tick = 0;
 
-    int ticks_per_beat = m_ppqn * c_jack_factor;
-    int beats_per_minute = parent().get_beats_per_minute();
-    uint64_t tick_rate = (uint64_t(m_frame_rate) * tick * 60.0);
-    long tpb_bpm = ticks_per_beat * beats_per_minute * 4.0 / m_beat_width;
-    uint64_t jack_frame = tick_rate / tpb_bpm;
+    /*
+     * The time of the tick comes from the tempo map, so that the frame is
+     * right even when the tempo changes before the tick.  The beat-width
+     * factor is kept from the old single-tempo calculation.
+     */
+
+    double seconds = parent().tick_to_us(tick) / 1000000.0;
+    uint64_t jack_frame = uint64_t
+    (
+        seconds * double(m_frame_rate) * double(m_beat_width) / 4.0
+    );
     if (is_master())
     {
         /*
          * We don't want to do this unless we are JACK Master.  Otherwise,
          * other JACK clients never advance if Seq66 won't advance.
          * However, according to JACK docs, "Any client can start or stop
-         * playback, or seek to a new location."
+         * playback, or seek to a new location."  The locate is made by
+         * apply_locate(), at the next period; a later position() before
+         * then replaces this one.
          */
 
-        if (::jack_transport_locate(m_jack_client, jack_frame) != 0)
-            (void) info_message("jack_transport_locate() failed");
+        m_locate_frame.store(long(jack_frame));
     }
     if (parent().is_running())
         parent().set_reposition(false);
 #endif
 }
 
+/**
+ *  Locates the transport to the frame last asked for by position(), if
+ *  any.  Called by the process callback at the start of each period, and
+ *  by start(), so that the transport rolls from the new place.
+ *  jack_transport_locate() is realtime-safe; the exchange makes sure that
+ *  each request is applied only once.
+ */
+
+void
+jack_assistant::apply_locate ()
+{
+    long frame = m_locate_frame.exchange(-1);
+    if (frame >= 0 && not_nullptr(m_jack_client))
+    {
+        jack_nframes_t f = jack_nframes_t(frame);
+        if (::jack_transport_locate(m_jack_client, f) != 0)
+            (void) info_message("jack_transport_locate() failed");
+    }
+}
+
 /**
  *  Computing the BBT information from the frame number is relatively simple
  *  here, but would become complex if we supported tempo or time signature
@@ -1485,6 +1594,7 @@ jack_sync_callback
     void * arg
 )
 {
+    trace_scope ts("JACK sync");
     int result = 0;
     jack_assistant * jack = static_cast<jack_assistant *>(arg);
     if (not_nullptr(jack))
@@ -1697,6 +1807,14 @@ jack_session_callback (jack_session_event_t * ev, void * arg)
  *      but this is not true, and prevents Seq66 from playing back when not
  *      the Master.
  *
+ * Period sync:
+ *
+ *      With the "jack-period-sync" option, the position is taken from the
+ *      period map that the process callback publishes, rather than by a
+ *      transport query at every wake-up of the output thread.  See
+ *      output_period().  Until the first period arrives, the old code is
+ *      used.
+ *
  * \param pad
  *      Provides a JACK scratchpad for sharing certain items between the
  *      performer object and the jack_assistant object.
@@ -1708,6 +1826,9 @@ jack_session_callback (jack_session_event_t * ev, void * arg)
 bool
 jack_assistant::output (jack_scratchpad & pad)
 {
+    if (m_jack_running && m_period_sync && output_period(pad))
+        return true;
+
     if (m_jack_running)
     {
         pad.js_init_clock = false;              /* no init until a good lock */
@@ -1813,6 +1934,188 @@ jack_assistant::output (jack_scratchpad & pad)
     return m_jack_running;
 }
 
+/**
+ *  Records the transport position at the start of a JACK period, for
+ *  output_period().  Called in the process callback, so it takes no locks,
+ *  and cannot consult the performer's tempo map.
+ *
+ *  If we are a slave and the master supplies valid BBT, the tick comes from
+ *  the bar, beat, and tick, adjusted by the BBT frame offset, and so follows
+ *  any tempo map the master has.  Otherwise it is the frame converted at
+ *  the current tempo, as in output().  As there, the beat width is not
+ *  used.
+ *
+ * \param pos
+ *      The position just obtained by jack_transport_query().
+ *
+ * \param state
+ *      The transport state just obtained.
+ */
+
+void
+jack_assistant::publish_period
+(
+    const jack_position_t & pos,
+    jack_transport_state_t state
+)
+{
+    double rate = pos.frame_rate > 0 ? double(pos.frame_rate) : m_frame_rate ;
+    if (rate <= 0.0)
+        return;
+
+    bool bbt = (pos.valid & JackPositionBBT) != 0 && pos.ticks_per_beat > 0.0;
+    double bpm = is_slave() && bbt && pos.beats_per_minute > 1.0 ?
+        pos.beats_per_minute : parent().get_beats_per_minute() ;
+
+    period_map pm;
+    pm.pm_frame_time = ::jack_last_frame_time(m_jack_client);
+    pm.pm_frame = pos.frame;
+    pm.pm_ticks_per_frame = double(m_ppqn) * bpm / (rate * 60.0);
+    pm.pm_state = state;
+    if (is_slave() && bbt && pos.bar > 0 && pos.beat > 0)
+    {
+        double beats = double(pos.bar - 1) * pos.beats_per_bar +
+            double(pos.beat - 1) + pos.tick / pos.ticks_per_beat;
+
+        pm.pm_tick = beats * m_ppqn;
+        if ((pos.valid & JackBBTFrameOffset) != 0)
+            pm.pm_tick -= pos.bbt_offset * pm.pm_ticks_per_frame;
+    }
+    else
+        pm.pm_tick = double(pos.frame) * pm.pm_ticks_per_frame;
+
+    if (pm.pm_tick < 0.0)
+        pm.pm_tick = 0.0;
+
+    unsigned seq = m_period_sequence.load(std::memory_order_relaxed);
+    m_period_sequence.store(seq + 1, std::memory_order_relaxed);    /* odd  */
+    std::atomic_thread_fence(std::memory_order_release);
+    m_period = pm;
+    m_period_sequence.store(seq + 2, std::memory_order_release);    /* even */
+}
+
+/**
+ *  Gets the MIDI tick of the present moment from the latest period map.
+ *  While rolling, the frames elapsed since the start of the period are added
+ *  at the period's tempo, so that the result is exact to the frame, rather
+ *  than to the last query.
+ *
+ * \param [out] tick
+ *      The MIDI tick, with its fraction.
+ *
+ * \param [out] state
+ *      The transport state of the latest period.
+ *
+ * \return
+ *      Returns false if no period has been published yet.
+ */
+
+bool
+jack_assistant::period_position
+(
+    double & tick,
+    jack_transport_state_t & state
+) const
+{
+    period_map pm;
+    unsigned seq;
+    do
+    {
+        seq = m_period_sequence.load(std::memory_order_acquire);
+        if (seq == 0)
+            return false;
+
+        pm = m_period;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+    } while ((seq & 1) != 0 ||
+        seq != m_period_sequence.load(std::memory_order_relaxed));
+
+    tick = pm.pm_tick;
+    state = pm.pm_state;
+    if (state == JackTransportRolling)
+    {
+        jack_nframes_t now = ::jack_frame_time(m_jack_client);
+        jack_nframes_t elapsed = now - pm.pm_frame_time;    /* wraps fine   */
+        if (elapsed < jack_nframes_t(0x80000000))           /* not behind   */
+            tick += double(elapsed) * pm.pm_ticks_per_frame;
+    }
+    return true;
+}
+
+/**
+ *  The period-sync version of output().  The tick is not accumulated from
+ *  frame differences, which drifts from the master, but is set afresh from
+ *  the period map, and the delta since the last call is applied to the
+ *  scratchpad.  A jump (a reposition or a loop by the master) is a delta
+ *  like any other, so it cannot restart the left-right loop counting.
+ *
+ * \param pad
+ *      Provides the JACK scratchpad shared with the performer.
+ *
+ * \return
+ *      Returns false if there is no period map yet, so that output() falls
+ *      back to querying the transport.
+ */
+
+bool
+jack_assistant::output_period (jack_scratchpad & pad)
+{
+    double tick;
+    jack_transport_state_t state;
+    if (! period_position(tick, state))
+        return false;
+
+    pad.js_init_clock = false;
+    m_transport_state = state;
+    if (transport_rolling_now())
+    {
+        midipulse midi_ticks = midipulse(tick + 0.5);
+        pad.js_dumping = true;                  /* "[Start JACK Playback]"  */
+        parent().set_last_ticks(midi_ticks);
+        pad.set_current_tick_ex(midi_ticks);
+        pad.js_ticks_converted_last = tick;
+        pad.js_init_clock = true;
+        if (pad.js_looping && pad.js_playback_mode)
+        {
+            if (pad.js_current_tick >= parent().get_right_tick())
+            {
+                double r_minus_l = parent().left_right_size();
+                while (pad.js_current_tick >= parent().get_right_tick())
+                    pad.js_current_tick -= r_minus_l;
+
+                parent().off_sequences();
+                parent().set_last_ticks(midipulse(pad.js_current_tick));
+            }
+        }
+    }
+    if (transport_stopped_now())
+    {
+        m_transport_state_last = JackTransportStopped;
+        pad.js_jack_stopped = true;
+    }
+    if (pad.js_dumping)
+    {
+        double delta = tick - pad.js_ticks_converted_last;
+        if (delta > 0.0)
+        {
+            pad.js_clock_tick += delta;
+            pad.js_current_tick += delta;
+            pad.js_total_tick += delta;
+            pad.js_ticks_converted_last = tick;
+        }
+        else if (delta < 0.0)                   /* the master went back     */
+            pad.js_ticks_converted_last = tick;
+
+        m_transport_state_last = m_transport_state;
+
+#if defined USE_JACK_DEBUG_PRINT
+        jack_debug_print(*this, pad.js_current_tick, delta);
+#endif
+    }
+    return true;
+}
+
 #if defined USE_TIMEBASE_MASTER
 
 /**
@@ -2127,6 +2430,7 @@ jack_timebase_callback
     void * arg
 )
 {
+    trace_scope ts("JACK timebase");
     jack_assistant * jack = static_cast<jack_assistant *>(arg);
     pos->beats_per_minute = jack->get_beats_per_minute();   /* sooperlooper */
     pos->beats_per_bar = jack->beats_per_measure();
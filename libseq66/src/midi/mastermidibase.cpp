@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-23
- * \updates       2024-08-16
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a base-class implementation for various master MIDI
@@ -33,11 +33,14 @@
  *  buss classes.
  */
 
+#include <algorithm>                    /* std::remove_if()                 */
+
+#include "cfg/hotsettings.hpp"          /* seq66::hot() for the RT threads  */
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
 #include "midi/event.hpp"               /* seq66::event                     */
 #include "midi/mastermidibase.hpp"      /* seq66::mastermidibase            */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
-#include "os/timing.hpp"                /* seq66::microsleep()              */
+#include "os/timing.hpp"                /* seq66::microsleep(), microtime() */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -79,10 +82,18 @@ mastermidibase::mastermidibase
     m_vector_sequence   (),             /* stazed feature                   */
     m_record_by_buss    (false),        /* set based on configuration       */
     m_record_by_channel (false),        /* ditto, but mutually exclusive    */
+    m_record_routes     (),
     m_seq               (nullptr),
-    m_mutex             ()
+    m_mutex             (),
+    m_play_count        (0),
+    m_standby           (false),
+    m_bus_play_counts   (),
+    m_thru_routed       (! rc().thru_routes().empty()),
+    m_sysex_streams     (),
+    m_sysex_mutex       ()
 {
-    // Empty body now
+    for (auto & c : m_bus_play_counts)
+        c.store(0, std::memory_order_relaxed);
 }
 
 /**
@@ -135,9 +146,10 @@ mastermidibase::activate ()
 void
 mastermidibase::start ()
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     api_start();
-    m_outbus_array.start();
+    if (! standby())
+        m_outbus_array.start();
 }
 
 /**
@@ -154,9 +166,10 @@ mastermidibase::start ()
 void
 mastermidibase::continue_from (midipulse tick)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     api_continue_from(tick);
-    m_outbus_array.continue_from(tick);
+    if (! standby())
+        m_outbus_array.continue_from(tick);
 }
 
 /**
@@ -173,7 +186,7 @@ mastermidibase::continue_from (midipulse tick)
 void
 mastermidibase::init_clock (midipulse tick)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     api_init_clock(tick);
     m_outbus_array.init_clock(tick);
 }
@@ -190,8 +203,10 @@ mastermidibase::init_clock (midipulse tick)
 void
 mastermidibase::stop ()
 {
-    automutex locker(m_mutex);
-    m_outbus_array.stop();
+    exclusivelock locker(m_mutex);
+    if (! standby())
+        m_outbus_array.stop();
+
     api_stop();
 }
 
@@ -212,8 +227,9 @@ mastermidibase::stop ()
 void
 mastermidibase::emit_clock (midipulse tick)
 {
-    automutex locker(m_mutex);
-    m_outbus_array.clock(tick);
+    sharedlock locker(m_mutex);
+    if (! standby())
+        m_outbus_array.clock(tick);
 }
 
 /**
@@ -229,9 +245,10 @@ mastermidibase::emit_clock (midipulse tick)
 void
 mastermidibase::set_ppqn (int ppqn)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     m_ppqn = choose_ppqn(ppqn);                     /* m_ppqn = ppqn        */
     api_set_ppqn(ppqn);
+    m_outbus_array.update_clocks();                 /* pulses are moved     */
 }
 
 /**
@@ -247,7 +264,7 @@ mastermidibase::set_ppqn (int ppqn)
 void
 mastermidibase::set_beats_per_minute (midibpm bpm)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     m_beats_per_minute = bpm;
     api_set_beats_per_minute(bpm);
 }
@@ -263,7 +280,7 @@ mastermidibase::set_beats_per_minute (midibpm bpm)
 void
 mastermidibase::flush ()
 {
-    automutex locker(m_mutex);
+    sharedlock locker(m_mutex);
     api_flush();
 }
 
@@ -276,7 +293,7 @@ mastermidibase::flush ()
 void
 mastermidibase::panic (int displaybuss)
 {
-    automutex locker(m_mutex);
+    sharedlock locker(m_mutex);
     for (int bus = 0; bus < c_busscount_max; ++bus)
     {
         if (bus == displaybuss)             /* do not clear the Launchpad   */
@@ -295,8 +312,10 @@ mastermidibase::panic (int displaybuss)
 }
 
 /**
- *  Handle the sending of SYSEX events.  There's currently no
- *  implementation-specific API function for this call.
+ *  Handle the sending of SYSEX events.  A message larger than a chunk, or
+ *  one for a buss that is still streaming another, is queued, sharing the
+ *  event's data, and sent by pump_sysex() at the "sysex-rate" of the 'rc'
+ *  file.  A small one is sent at once.
  *
  * \threadsafe
  *
@@ -307,14 +326,95 @@ mastermidibase::panic (int displaybuss)
 void
 mastermidibase::sysex (bussbyte bus, const event * ev)
 {
-    automutex locker(m_mutex);
-    m_outbus_array.sysex(bus, ev);
+    if (standby())
+        return;
+
+    sharedlock locker(m_mutex);
+    bool streamed = ev->sysex_size() > c_sysex_chunk_size;
+    {
+        std::lock_guard<std::mutex> slock(m_sysex_mutex);
+        if (! streamed)
+        {
+            for (const auto & s : m_sysex_streams)
+            {
+                if (s.buss() == bus)
+                {
+                    streamed = true;                /* keep them in order   */
+                    break;
+                }
+            }
+        }
+        if (streamed)
+        {
+            m_sysex_streams.emplace_back
+            (
+                bus, ev->shared_sysex(), hot().sysex_rate()
+            );
+        }
+    }
+    if (! streamed)
+        m_outbus_array.sysex(bus, ev);
+}
+
+/**
+ *  Sends the chunks of the queued SysEx messages that are due.  Only the
+ *  oldest message for each buss is sent from, so that one message is not
+ *  interleaved with another.  Called regularly by the input thread.
+ *
+ * \threadsafe
+ *
+ * \return
+ *      Returns true if any messages remain to be sent.
+ */
+
+bool
+mastermidibase::pump_sysex ()
+{
+    sharedlock locker(m_mutex);
+    std::lock_guard<std::mutex> slock(m_sysex_mutex);
+    if (m_sysex_streams.empty())
+        return false;
+
+    long now = microtime();
+    bool busy[c_busscount_max] = { false };
+    bool sent = false;
+    for (auto & s : m_sysex_streams)
+    {
+        bussbyte bus = s.buss();
+        if (int(bus) >= c_busscount_max || busy[bus])
+            continue;
+
+        sysexstream::chunk c;
+        while (s.next(now, c))
+        {
+            m_outbus_array.sysex_chunk(bus, c.sc_data, c.sc_size);
+            sent = true;
+        }
+        busy[bus] = ! s.done();
+    }
+    if (sent)
+        api_flush();
+
+    auto finished = [] (const sysexstream & s)
+    {
+        return s.done() || int(s.buss()) >= c_busscount_max;
+    };
+    m_sysex_streams.erase
+    (
+        std::remove_if
+        (
+            m_sysex_streams.begin(), m_sysex_streams.end(), finished
+        ),
+        m_sysex_streams.end()
+    );
+    return ! m_sysex_streams.empty();
 }
 
 /**
  *  Handle the playing of MIDI events on the MIDI buss given by the parameter,
  *  as long as it is a legal buss number.  There's currently no
- *  implementation-specific API function here.
+ *  implementation-specific API function here.  In standby, the event is
+ *  counted but not sent.
  *
  * \threadsafe
  *
@@ -333,18 +433,107 @@ mastermidibase::sysex (bussbyte bus, const event * ev)
 void
 mastermidibase::play (bussbyte bus, event * e24, midibyte channel)
 {
-    automutex locker(m_mutex);
-    m_outbus_array.play(bus, e24, channel);
+    sharedlock locker(m_mutex);
+    if (! standby())
+        m_outbus_array.play(bus, e24, channel);
+
+    m_play_count.fetch_add(1, std::memory_order_relaxed);
+    if (int(bus) < c_busscount_max)
+        m_bus_play_counts[bus].fetch_add(1, std::memory_order_relaxed);
 }
 
 void
 mastermidibase::play_and_flush (bussbyte bus, event * e24, midibyte channel)
 {
-    automutex locker(m_mutex);
-    m_outbus_array.play(bus, e24, channel);
+    sharedlock locker(m_mutex);
+    if (! standby())
+        m_outbus_array.play(bus, e24, channel);
+
+    m_play_count.fetch_add(1, std::memory_order_relaxed);
+    if (int(bus) < c_busscount_max)
+        m_bus_play_counts[bus].fetch_add(1, std::memory_order_relaxed);
     api_flush();
 }
 
+/**
+ *  Plays the events of one buss gathered by the output thread for a frame,
+ *  taking the lock once for all of them.  Not flushed; the frame's flush
+ *  follows.
+ *
+ * \threadsafe
+ *
+ * \param bus
+ *      The buss to play on.
+ *
+ * \param evs
+ *      The events and their channels, in timestamp order.
+ *
+ * \param count
+ *      The number of events.
+ */
+
+void
+mastermidibase::play_batch (bussbyte bus, const batchevent * evs, int count)
+{
+    sharedlock locker(m_mutex);
+    if (! standby())
+        m_outbus_array.play_batch(bus, evs, count);
+
+    m_play_count.fetch_add(count, std::memory_order_relaxed);
+    if (int(bus) < c_busscount_max)
+        m_bus_play_counts[bus].fetch_add(count, std::memory_order_relaxed);
+}
+
+/**
+ *  Takes back the events of a muted pattern that the buss's API holds,
+ *  not yet sent.  The caller then sends the Note Offs it needs, as
+ *  sequence::set_armed() does.
+ *
+ * \threadsafe
+ *
+ * \param bus
+ *      The buss of the pattern.
+ *
+ * \param tag
+ *      The pattern's tag, as given in its batched events.
+ */
+
+void
+mastermidibase::retract (bussbyte bus, midibyte tag)
+{
+    sharedlock locker(m_mutex);
+    if (! standby())
+        m_outbus_array.retract(bus, tag);
+}
+
+/**
+ *  Gets the output-buffer statistics of the output busses, for the output
+ *  timing statistics.
+ *
+ * \threadsafe
+ */
+
+bool
+mastermidibase::buffer_stats (int & size, int & highwater, int & dropped)
+{
+    sharedlock locker(m_mutex);
+    return m_outbus_array.buffer_stats(size, highwater, dropped);
+}
+
+/**
+ *  The same, for the buffers of the input busses, which carry messages from
+ *  the MIDI API (JACK) to the input thread.
+ *
+ * \threadsafe
+ */
+
+bool
+mastermidibase::input_buffer_stats (int & size, int & highwater, int & dropped)
+{
+    sharedlock locker(m_mutex);
+    return m_inbus_array.buffer_stats(size, highwater, dropped);
+}
+
 /**
  *  Set the clock for the given (legal) buss number.  The legality checks
  *  are a little loose, however.
@@ -364,11 +553,11 @@ mastermidibase::play_and_flush (bussbyte bus, event * e24, midibyte channel)
 bool
 mastermidibase::set_clock (bussbyte bus, e_clock clocktype)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     bool result = m_outbus_array.set_clock(bus, clocktype);
     if (result)
     {
-        flush();
+        api_flush();                            /* flush() would relock */
         result = save_clock(bus, clocktype);    /* save into the vector */
     }
     return result;
@@ -548,11 +737,11 @@ mastermidibase::get_in_port_statuses (inputslist & ins)
 bool
 mastermidibase::set_input (bussbyte bus, bool inputing)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     bool result = m_inbus_array.set_input(bus, inputing);
     if (result)
     {
-        flush();
+        api_flush();                            /* flush() would relock */
         result = save_input(bus, inputing);     /* save into the vector */
     }
     return result;
@@ -782,7 +971,7 @@ mastermidibase::api_poll_for_midi ()
 bool
 mastermidibase::is_more_input ()
 {
-    automutex locker(m_mutex);
+    sharedlock locker(m_mutex);
     return m_inbus_array.poll_for_midi() > 0;
 }
 
@@ -806,7 +995,7 @@ mastermidibase::is_more_input ()
 void
 mastermidibase::port_start (int client, int port)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     api_client_port_start(client, port);
 }
 
@@ -833,11 +1022,74 @@ mastermidibase::port_start (int client, int port)
 void
 mastermidibase::port_exit (int client, int port)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     m_outbus_array.port_exit(client, port);
     m_inbus_array.port_exit(client, port);
 }
 
+/**
+ *  Sends a channel message straight to the output buss of the [midi-thru]
+ *  route of its input buss, if any, and flushes it.  This is done as soon
+ *  as the event is read, before the performer looks at it for control,
+ *  recording, or the thru of the recording pattern.  Used for the APIs
+ *  that do not route thru in their input callback.
+ *
+ * \threadsafe
+ *
+ * \param ev
+ *      The event just read.  Its channel is kept.
+ */
+
+void
+mastermidibase::route_thru (event * ev)
+{
+    if (ev->below_sysex())
+    {
+        int outbus = hot().thru_route(int(ev->input_bus()));
+        if (outbus >= 0)
+            play_and_flush(bussbyte(outbus), ev, ev->channel());
+    }
+}
+
+/**
+ *  Reconnects the busses that used a port which has come back.  Unlike
+ *  port_start(), no buss is created or removed, so the buss numbers, and
+ *  the clock and input lists that are indexed by them, stay as they are.
+ *  The output thread waits only for the lock, not for a rebuild of the
+ *  busses.  A port that no buss used before is left alone, to be picked up
+ *  at the next start.
+ *
+ * \threadsafe
+ *
+ * \param client
+ *      The client number of the port that started.
+ *
+ * \param port
+ *      The port number of the port that started.
+ *
+ * \param busname
+ *      The name of the client, used to find the buss.
+ *
+ * \param portname
+ *      The name of the port, used to find the buss.
+ *
+ * \return
+ *      Returns true if any buss was reconnected.
+ */
+
+bool
+mastermidibase::port_restart
+(
+    int client, int port,
+    const std::string & busname, const std::string & portname
+)
+{
+    exclusivelock locker(m_mutex);
+    bool outok = m_outbus_array.port_restart(client, port, busname, portname);
+    bool inok = m_inbus_array.port_restart(client, port, busname, portname);
+    return outok || inok;
+}
+
 /**
  *  Set the input sequence object, and set the m_dumping_input value to
  *  the given state.
@@ -877,7 +1129,7 @@ mastermidibase::port_exit (int client, int port)
 bool
 mastermidibase::set_sequence_input (bool state, sequence * seqp)
 {
-    automutex locker(m_mutex);
+    exclusivelock locker(m_mutex);
     bool result = not_nullptr(seqp);
     if (m_record_by_buss)
     {
@@ -917,6 +1169,8 @@ mastermidibase::set_sequence_input (bool state, sequence * seqp)
         }
         else if (! state)
             m_vector_sequence.clear();  /* don't record, and clear vector   */
+
+        build_record_routes();
     }
     else
     {
@@ -942,6 +1196,36 @@ mastermidibase::set_sequence_input (bool state, sequence * seqp)
     return result;
 }
 
+/**
+ *  Rebuilds the record-by-channel routing table from the recording
+ *  patterns.  Must be called with the mutex held exclusively.  See the
+ *  recordroutes class.
+ */
+
+void
+mastermidibase::build_record_routes ()
+{
+    recordroutes::pointer routes;
+    if (m_record_by_channel && ! m_vector_sequence.empty())
+        routes = recordroutes::by_channel(m_vector_sequence);
+
+    std::atomic_store(&m_record_routes, routes);
+}
+
+/**
+ *  Rebuilds the routing table, as when the record-by-channel setting or a
+ *  recording pattern's channel changes.
+ *
+ * \threadsafe
+ */
+
+void
+mastermidibase::rebuild_record_routes ()
+{
+    exclusivelock locker(m_mutex);
+    build_record_routes();
+}
+
 /**
  *  This function augments the recording functionality by looking for a
  *  sequence that has a matching channel number, logging the event to that
@@ -953,39 +1237,22 @@ mastermidibase::set_sequence_input (bool state, sequence * seqp)
  *  sequence will get the events.  So now we add an additional call to the new
  *  sequence::channel_match() function.
  *
+ *  The patterns for each channel are now looked up in the routing table,
+ *  built by set_sequence_input(), rather than tried one by one.
+ *
  * \param ev
- *      The event that was recorded, passed as a copy.  (Do we really need a
- *      copy?)
+ *      The event that was recorded.  It is adjusted by the (last) pattern
+ *      that takes it.
+ *
+ * \return
+ *      Returns true if a pattern matching the channel took the event.
  */
 
 bool
-mastermidibase::dump_midi_input (event ev)
+mastermidibase::dump_midi_input (event & ev)
 {
-    bool result = false;
-    size_t sz = m_vector_sequence.size();
-    for (size_t i = 0; i < sz; ++i)
-    {
-        if (is_nullptr(m_vector_sequence[i]))          // error check
-        {
-            errprint("dump_midi_input(): bad sequence");
-            continue;
-        }
-        else if (m_vector_sequence[i]->stream_event(ev))
-        {
-            /*
-             * Did we find a match to the sequence channel?  Then don't
-             * bother with the remaining sequences.  Otherwise, pass the
-             * event to any other recording sequences.
-             */
-
-            if (m_vector_sequence[i]->channel_match())
-            {
-                result = true;
-                break;
-            }
-        }
-    }
-    return result;
+    recordroutes::pointer routes = std::atomic_load(&m_record_routes);
+    return routes ? routes->stream(ev) : false ;
 }
 
 }           // namespace seq66
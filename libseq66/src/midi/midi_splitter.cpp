@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-24
- * \updates       2022-10-26
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  We have recently updated this module to put Set Tempo events into the
@@ -167,22 +167,29 @@ midi_splitter::split (performer & p, int screenset, int ppqn)
     {
         if (m_smf0_channels_count > 0)
         {
-            int seqnum = screenset * usr().seqs_in_set();
-            for (int chan = 0; chan < c_midichannel_max; ++chan, ++seqnum)
+            sequence * seqs[c_midichannel_max];
+            for (int chan = 0; chan < c_midichannel_max; ++chan)
             {
+                /*
+                 * The master MIDI buss must be set before the split,
+                 * otherwise the null pointer causes a segfault.
+                 */
+
                 if (m_smf0_channels[chan])
                 {
-                    /*
-                     * The master MIDI buss must be set before the split,
-                     * otherwise the null pointer causes a segfault.
-                     */
-
-                    sequence * s = new sequence(ppqn);
-                    if (split_channel(p, *m_smf0_main_sequence, s, chan))
-                        p.install_sequence(s, seqnum);
-                    else
-                        delete s;   /* empty sequence, not even meta events */
+                    seqs[chan] = new sequence(ppqn);
+                    setup_channel(p, *m_smf0_main_sequence, seqs[chan], chan);
                 }
+                else
+                    seqs[chan] = nullptr;
+            }
+            split_events(*m_smf0_main_sequence, seqs);
+
+            int seqnum = screenset * usr().seqs_in_set();
+            for (int chan = 0; chan < c_midichannel_max; ++chan, ++seqnum)
+            {
+                if (not_nullptr(seqs[chan]))
+                    p.install_sequence(seqs[chan], seqnum);
             }
             m_smf0_main_sequence->set_midi_channel(null_channel());
             p.install_sequence(m_smf0_main_sequence, seqnum);
@@ -192,18 +199,8 @@ midi_splitter::split (performer & p, int screenset, int ppqn)
 }
 
 /**
- *  This function splits the given sequence into a new sequence, for the given
- *  channel found in the SMF 0 track.  It is called for each possible channel,
- *  resulting in multiple passes over the SMF 0 track.
- *
- *  Note that the events that are read from the MIDI file have delta times.
- *  Seq66 converts these delta times to cumulative times.    We
- *  need to preserve that here.  Conversion back to delta times is needed only
- *  when saving the sequences to a file.  This is done in
- *  midi_vector_base::fill().
- *
- *  We have to accumulate the delta times in order to be able to set the
- *  length of the sequence in pulses.
+ *  This function makes the settings of the new sequence for the given
+ *  channel found in the SMF 0 track.
  *
  *  Luckily, we don't have to worry about copying triggers, since the imported
  *  SMF 0 track won't have any Seq24/Sequencer24 triggers.
@@ -213,27 +210,17 @@ midi_splitter::split (performer & p, int screenset, int ppqn)
  *
  * \param main_seq
  *      This parameter is the whole SMF 0 track that was read from the MIDI
- *      file.  It contains all of the channel data that needs to be split into
- *      separate sequences.
+ *      file.
  *
  * \param s
- *      Provides the new sequence that needs to have its settings made, and
- *      all of the selected channel events added to it.
+ *      Provides the new sequence that needs to have its settings made.
  *
  * \param channel
- *      Provides the MIDI channel number (re 0) that marks the channel data
- *      the needs to be extracted and added to the new sequence.  If this
- *      channel is 0, then we need to add certain Meta events to this
- *      sequence, as well.  So far we support only Tempo Meta events.
- *
- * \return
- *      Returns true if at least one event got added.   If none were added,
- *      the caller should delete the sequence object represented by parameter
- *      \a s.
+ *      Provides the MIDI channel number (re 0) of the new sequence.
  */
 
-bool
-midi_splitter::split_channel
+void
+midi_splitter::setup_channel
 (
     const performer & p,
     const sequence & main_seq,
@@ -241,7 +228,6 @@ midi_splitter::split_channel
     int channel
 )
 {
-    bool result = false;
     char tmp[32];
     if (main_seq.name().empty())
     {
@@ -265,38 +251,142 @@ midi_splitter::split_channel
     s->set_midi_channel(channel);
     s->set_midi_bus(main_seq.seq_midi_bus());
     s->zero_markers();
+}
+
+/**
+ *  Deals the events of the SMF 0 track out to the channel sequences, in one
+ *  pass.  This used to be one pass over the SMF 0 track for each channel,
+ *  each growing its sequence an event at a time.  Now a first pass counts
+ *  the events of each channel, so that each sequence can reserve its room,
+ *  and a second pass copies each event to where it goes:
+ *
+ *      -   Channel events go to the sequence of their channel.  An event
+ *          with no channel goes to every sequence, as match_channel()
+ *          would have it.
+ *      -   SysEx events go to every sequence.
+ *      -   Other Meta events, such as Set Tempo, go to the sequence of
+ *          channel 0.
+ *
+ *  Note that the events that are read from the MIDI file have delta times.
+ *  Seq66 converts these delta times to cumulative times.    We
+ *  need to preserve that here.  Conversion back to delta times is needed only
+ *  when saving the sequences to a file.  This is done in
+ *  midi_vector_base::fill().
+ *
+ *  The source is sorted, and so is what comes out of it; the final
+ *  sort_events() only checks that.  The length of each sequence is the
+ *  time-stamp of the last event logged for its channel.  A sequence that
+ *  got no events, not even Meta events, is deleted and its pointer nulled.
+ *
+ * \param main_seq
+ *      The SMF 0 track, after log_main_sequence() sorted it.
+ *
+ * \param seqs
+ *      The sequence of each channel, or null for a channel not used.
+ */
+
+void
+midi_splitter::split_events
+(
+    const sequence & main_seq,
+    sequence * seqs []
+)
+{
+    std::size_t counts[c_midichannel_max];
+    bool added[c_midichannel_max];
+    midipulse lengths[c_midichannel_max];
+    std::size_t metas = 0;
+    std::size_t sysexes = 0;
+    std::size_t anychannel = 0;
+    for (int c = 0; c < c_midichannel_max; ++c)
+    {
+        counts[c] = 0;
+        added[c] = false;
+        lengths[c] = 0;
+    }
 
-    midipulse length_in_ticks = 0;      /* an accumulator of delta times    */
     const eventlist & evl = main_seq.events();
     for (auto i = evl.cbegin(); i != evl.cend(); ++i)
     {
         const event & er = eventlist::cdref(i);
         if (er.is_ex_data())
         {
-            if (channel == 0 || er.is_sysex())
+            if (er.is_sysex())
+                ++sysexes;
+            else
+                ++metas;
+        }
+        else if (is_null_channel(er.channel()))
+            ++anychannel;
+        else if (er.channel() < c_midichannel_max)
+            ++counts[er.channel()];
+    }
+    for (int c = 0; c < c_midichannel_max; ++c)
+    {
+        if (not_nullptr(seqs[c]))
+        {
+            std::size_t n = counts[c] + sysexes + anychannel;
+            if (c == 0)
+                n += metas;
+
+            seqs[c]->reserve_events(n);
+        }
+    }
+
+    auto log_event = [&] (int c, const event & er)
+    {
+        lengths[c] = er.timestamp();
+        if (seqs[c]->append_event(er))          /* adds event, no sorting   */
+            added[c] = true;                    /* the event got added      */
+    };
+    for (auto i = evl.cbegin(); i != evl.cend(); ++i)
+    {
+        const event & er = eventlist::cdref(i);
+        if (er.is_ex_data())
+        {
+            for (int c = 0; c < c_midichannel_max; ++c)
             {
-                length_in_ticks = er.timestamp();
-                if (s->append_event(er))    /* adds event, no sorting       */
-                    result = true;          /* the event got added          */
+                if (not_nullptr(seqs[c]) && (c == 0 || er.is_sysex()))
+                    log_event(c, er);
             }
         }
-        else if (er.match_channel(channel))
+        else if (is_null_channel(er.channel()))
         {
-            length_in_ticks = er.timestamp();
-            if (s->append_event(er))        /* adds event, no sorting       */
-                result = true;              /* the event got added          */
+            for (int c = 0; c < c_midichannel_max; ++c)
+            {
+                if (not_nullptr(seqs[c]))
+                    log_event(c, er);
+            }
+        }
+        else
+        {
+            int c = int(er.channel());
+            if (c < c_midichannel_max && not_nullptr(seqs[c]))
+                log_event(c, er);
         }
     }
 
     /*
      * No triggers to add.  Whew!  And setting the length is now a no-brainer,
      * since the tick value is that of the last logged event in the sequence.
-     * Also, sort all the events after they have been appended.
      */
 
-    s->set_length(length_in_ticks);
-    s->sort_events();
-    return result;
+    for (int c = 0; c < c_midichannel_max; ++c)
+    {
+        if (not_nullptr(seqs[c]))
+        {
+            if (added[c])
+            {
+                seqs[c]->set_length(lengths[c]);
+                seqs[c]->sort_events();         /* a check, already sorted  */
+            }
+            else
+            {
+                delete seqs[c];             /* empty, not even meta events  */
+                seqs[c] = nullptr;
+            }
+        }
+    }
 }
 
 }           // namespace seq66
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-11
- * \updates       2021-10-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -77,6 +77,11 @@ midi_vector::midi_vector (sequence & seq) :
  *
  *  tick_end() isn't quite a trigger length, off by 1.  Subtracting tick_start()
  *  can really screw it up.
+ *
+ *  The container is sized once, from the number of events and the number of
+ *  times each trigger plays them, so that it does not grow (and copy itself)
+ *  over and over for a long song.  This function touches only its own
+ *  sequence, so that write_song() can fill several tracks at once.
  */
 
 bool
@@ -105,7 +110,17 @@ midi_vector::song_fill_track (int track, bool standalone)
         }
 
         midipulse last_ts = 0;
+        midipulse len = seq().get_length();
         const auto & trigs = seq().get_triggers();
+        if (len > 0)
+        {
+            std::size_t passes = 0;
+            for (auto & t : trigs)
+                passes += std::size_t(2 + (t.length() - 1) / len);
+
+            std::size_t bytes = std::size_t(seq().events().count()) * 4;
+            m_char_vector.reserve(m_char_vector.size() + passes * bytes);
+        }
         for (auto & t : trigs)
             last_ts = song_fill_seq_event(t, last_ts);
 
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-10 (as midi_container.cpp)
- * \updates       2023-12-12
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class is important when writing the MIDI and sequencer data out to a
@@ -53,6 +53,8 @@
             c_seq_color (performance colors for a sequence)
             c_seq_edit_mode (unused by Seq66)
             c_seq_loopcount
+            c_seq_modlanes
+            c_seq_filter
             c_midiinbus (new)
 \endverbatim
  *
@@ -597,6 +599,42 @@ midi_vector_base::fill_proprietary ()
         put_seqspec(c_seq_loopcount, 2);                        /* short    */
         add_short(midishort(seq().loop_count_max()));
     }
+
+    /**
+     *  The modulation lanes: a count, then modlane::c_data_size bytes for
+     *  each lane.  The doubles are stored as scaled shorts.
+     */
+
+    const std::vector<modlane> & lanes = seq().mod_lanes();
+    if (! lanes.empty())
+    {
+        int datalen = 1 + int(lanes.size()) * modlane::c_data_size;
+        put_seqspec(c_seq_modlanes, datalen);
+        put(midibyte(lanes.size()));
+        for (const auto & ml : lanes)
+        {
+            put(ml.status());
+            put(ml.cc());
+            put(midibyte(cast(ml.wave())));
+            put(midibyte(ml.steps()));
+            add_short(midishort(ml.dcoffset() * 10.0 + 0.5));
+            add_short(midishort(ml.range() * 10.0 + 0.5));
+            add_short(midishort(ml.speed() * 100.0 + 0.5));
+            add_short(midishort(ml.phase() * 100.0 + 0.5));
+        }
+    }
+
+    /**
+     *  The text stages of the output filter, without a terminating null.
+     */
+
+    std::string spec = seq().output_filter();
+    if (! spec.empty())
+    {
+        put_seqspec(c_seq_filter, int(spec.size()));
+        for (char ch : spec)
+            put(midibyte(ch));
+    }
 }
 
 /**
@@ -612,6 +650,13 @@ midi_vector_base::fill_proprietary ()
  *      int times_played = 1;
  *      times_played += (trig.tick_end() - trig.tick_start()) / len;
  *
+ *  When the events are known to be sorted (the note index is valid), each
+ *  pass starts at the first event that can reach the trigger, found by
+ *  binary search, and the export stops at the first event past the end of
+ *  the trigger once no note is left sounding, as nothing after it could be
+ *  written.  Otherwise each pass walks all of the events, as before.  An
+ *  event is copied only if it needs to be transposed.
+ *
  * \param trig
  *      The current trigger to be processed.
  *
@@ -641,65 +686,75 @@ midi_vector_base::song_fill_seq_event
     for (int i = 0; i < c_notes_count; ++i)
         note_is_used[i] = 0;                        /* initialize to off    */
 
-    for (int p = 0; p <= times_played; ++p, time_offset += len)
+    const eventlist & evl = seq().events();
+    bool sorted = evl.note_spans_valid();           /* can seek and stop    */
+    int sounding = 0;                               /* total of note_is_used */
+    bool finished = false;
+    for (int p = 0; p <= times_played && ! finished; ++p, time_offset += len)
     {
         midipulse delta_time = 0;
-        for (auto e : seq().events())               /* use a copy of event  */
+        auto ei = evl.cbegin(trig.tick_start() - time_offset);
+        for ( ; ei != evl.cend(); ++ei)
         {
-            midipulse timestamp = e.timestamp() + time_offset;
-            if (timestamp >= trig.tick_start())     /* at/after trigger     */
+            const event & ev = *ei;
+            midipulse timestamp = ev.timestamp() + time_offset;
+            if (timestamp < trig.tick_start())      /* before trigger, skip */
+                continue;
+
+            if (sorted && timestamp > trig.tick_end() && sounding == 0)
             {
-                /*
-                 * Save the note; eliminate Note Off if Note On is unused.
-                 */
+                finished = true;                    /* nothing more to add  */
+                break;
+            }
 
-                if (e.is_note())                    /* includes aftertouch  */
-                {
-                    midibyte note = e.get_note();
-                    if (trig.transposed())
-                        e.transpose_note(trig.transpose());
+            /*
+             * Save the note; eliminate Note Off if Note On is unused.
+             */
 
-                    if (e.is_note_on())
+            if (ev.is_note())                       /* includes aftertouch  */
+            {
+                midibyte note = ev.get_note();
+                if (ev.is_note_on())
+                {
+                    if (timestamp <= trig.tick_end())
                     {
-                        if (timestamp <= trig.tick_end())
-                            ++note_is_used[note];   /* count the note       */
-                        else
-                            continue;               /* skip                 */
+                        ++note_is_used[note];       /* count the note       */
+                        ++sounding;
                     }
-                    else if (e.is_note_off())
+                    else
+                        continue;                   /* skip                 */
+                }
+                else if (ev.is_note_off())
+                {
+                    if (note_is_used[note] > 0)
                     {
-                        if (note_is_used[note] > 0)
-                        {
-                            /*
-                             * We have a Note On, and if past the end of trigger,
-                             * use the trigger end.
-                             */
-
-                            --note_is_used[note];   /* turn off the note    */
-                            if (timestamp > trig.tick_end())
-                                timestamp = trig.tick_end();
-                        }
-                        else
-                            continue;               /* if no Note On, skip  */
+                        /*
+                         * We have a Note On, and if past the end of trigger,
+                         * use the trigger end.
+                         */
+
+                        --note_is_used[note];       /* turn off the note    */
+                        --sounding;
+                        if (timestamp > trig.tick_end())
+                            timestamp = trig.tick_end();
                     }
+                    else
+                        continue;                   /* if no Note On, skip  */
                 }
             }
-            else
-                continue;                           /* before trigger, skip */
-
-            /*
-             * If the event is past the trigger end, for non-notes, skip.
-             */
-
-            if (timestamp >= trig.tick_end())       /* event past trigger   */
-            {
-                if (! e.is_note())                  /* (also aftertouch)    */
-                    continue;                       /* drop the event       */
-            }
+            else if (timestamp >= trig.tick_end())  /* event past trigger   */
+                continue;                           /* drop the event       */
 
             delta_time = timestamp - prev_timestamp;
             prev_timestamp = timestamp;
-            add_event(e, delta_time);               /* does it sort???      */
+            if (trig.transposed() && ev.is_note())
+            {
+                event e = ev;                       /* use a copy of event  */
+                e.transpose_note(trig.transpose());
+                add_event(e, delta_time);
+            }
+            else
+                add_event(ev, delta_time);
         }
     }
     return prev_timestamp;
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-25
- * \updates       2024-06-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a cross-platform implementation of MIDI support.
@@ -175,8 +175,15 @@ midibase::midibase
     m_lasttick          (0),
     m_io_type           (iotype),
     m_port_type         (porttype),
+    m_output_filter     (),
+    m_input_filter      (),
     m_mutex             ()
 {
+    if (m_io_type == io::output)
+        (void) m_output_filter.parse(rc().output_filter(index));
+    else if (m_io_type == io::input)
+        (void) m_input_filter.parse(rc().input_filter(index));
+
     if (m_port_type != port::manual)
     {
         if (! busname.empty() && ! portname.empty())
@@ -426,6 +433,31 @@ midibase::initialize (bool initdisabled)
     return result;
 }
 
+/**
+ *  Connects the port again after the system port it was connected to went
+ *  away and came back, as when a USB device is unplugged and plugged in
+ *  again.  The buss and port IDs are updated, since the system can give the
+ *  device new ones, but the buss index is kept, so the patterns and the
+ *  clock and input settings that refer to it are unaffected.
+ *
+ * \param bus
+ *      The system's new buss (client) number for the port.
+ *
+ * \param port
+ *      The system's new port number.
+ *
+ * \return
+ *      Returns true if the API reconnected the port.
+ */
+
+bool
+midibase::reconnect (int bus, int port)
+{
+    set_bus_id(bus);
+    set_port_id(port);
+    return api_reconnect();
+}
+
 /**
  *  Prints m_name.
  */
@@ -452,14 +484,98 @@ midibase::print ()
  *      check the pointer.
  *
  * \param channel
- *      The channel of the playback.
+ *      The channel of the playback.  An output filter can change it.
  */
 
 void
 midibase::play (const event * e24, midibyte channel)
 {
     automutex locker(m_mutex);
-    api_play(e24, channel);
+    if (m_output_filter.empty() || ! e24->has_channel())
+    {
+        api_play(e24, channel);
+    }
+    else
+    {
+        midibyte d0, d1;
+        e24->get_data(d0, d1);
+        if (m_output_filter.apply(e24->get_status(), channel, d0, d1))
+        {
+            event ev(*e24);                 /* a copy only for a filter     */
+            ev.set_data(d0, d1);
+            api_play(&ev, channel);
+        }
+    }
+}
+
+/**
+ *  Plays a frame's events for this buss, in order, under one lock.  If the
+ *  port has an output filter, the events go through play()'s code one at a
+ *  time, in a new frame of the filter, so that its dedup stage compares
+ *  them only with each other; otherwise they are handed to the API all
+ *  together.
+ *
+ * \param evs
+ *      The events and their channels, sorted by timestamp.
+ *
+ * \param count
+ *      The number of events.
+ */
+
+void
+midibase::play_batch (const batchevent * evs, int count)
+{
+    automutex locker(m_mutex);
+    if (m_output_filter.empty())
+    {
+        api_play_batch(evs, count);
+    }
+    else
+    {
+        m_output_filter.new_frame();
+        for (int i = 0; i < count; ++i)
+            play(&evs[i].be_event, evs[i].be_channel);  /* recursive mutex  */
+    }
+}
+
+/**
+ *  Takes back the events of a pattern that the API has not sent yet, when
+ *  the pattern is muted.  See api_retract().
+ *
+ * \param tag
+ *      The tag of the pattern, as given in its batched events.
+ */
+
+void
+midibase::retract (midibyte tag)
+{
+    automutex locker(m_mutex);
+    api_retract(tag);
+}
+
+/**
+ *  Replaces the output filter of the port.
+ *
+ * \param spec
+ *      The stages, such as "velocity:80 thin:2".  An empty string removes
+ *      the filter.
+ *
+ * \return
+ *      Returns false if the stages are not valid, in which case the port
+ *      has no filter.
+ */
+
+bool
+midibase::output_filter (const std::string & spec)
+{
+    automutex locker(m_mutex);
+    return m_output_filter.parse(spec);
+}
+
+std::string
+midibase::output_filter () const
+{
+    return m_output_filter.to_string();
 }
 
 /**
@@ -477,6 +593,51 @@ midibase::sysex (const event * e24)
     api_sysex(e24);
 }
 
+/**
+ *  Sends one chunk of a SysEx message that is being streamed.  See the
+ *  sysexstream class.
+ *
+ * \param data
+ *      Points to the bytes of the chunk, inside the whole message.
+ *
+ * \param len
+ *      The number of bytes in the chunk.
+ */
+
+void
+midibase::sysex_chunk (const midibyte * data, int len)
+{
+    automutex locker(m_mutex);
+    api_sysex_chunk(data, len);
+}
+
+/**
+ *  The default for an API that cannot take a pointer to the bytes:  it puts
+ *  the chunk in an event and sends that.
+ */
+
+void
+midibase::api_sysex_chunk (const midibyte * data, int len)
+{
+    event ev;
+    if (ev.set_sysex(data, len))
+        api_sysex(&ev);
+}
+
+/**
+ *  Gets the output-buffer statistics of the port.  No lock is needed; the
+ *  figures are read from the buffer's own counters.
+ *
+ * \return
+ *      Returns false if the port has no output buffer.
+ */
+
+bool
+midibase::buffer_stats (int & size, int & highwater, int & dropped)
+{
+    return api_buffer_stats(size, highwater, dropped);
+}
+
 /**
  *  Flushes our local queue events out into ALSA.
  */
@@ -619,32 +780,46 @@ midibase::stop ()
 }
 
 /**
- *  Generates the MIDI clock, starting at the given tick value.  The number
- *  of ticks needed is calculated.
+ *  Generates the MIDI clock, starting at the given tick value.  The clock
+ *  pulses that fall after the last tick clocked, up to this tick, are sent.
+ *  Each clock is passed the tick at which it falls, not the frame's tick, so
+ *  that an API that timestamps or schedules output can place it exactly.
+ *  The pulses are stepped through directly, rather than by testing each
+ *  tick.
  *
  * \threadsafe
  *
  * \param tick
  *      Provides the starting tick.
+ *
+ * \return
+ *      Returns the tick of the next pulse due, so that the caller need not
+ *      call this function again before then.  If clocking is not enabled,
+ *      c_null_midipulse is returned.
  */
 
-void
+midipulse
 midibase::clock (midipulse tick)
 {
     automutex locker(m_mutex);
-    if (clock_enabled())
+    midipulse result = c_null_midipulse;
+    midipulse ct = clock_ticks_from_ppqn(m_ppqn);       /* ppqn / 24        */
+    if (clock_enabled() && ct > 0)
     {
-        bool done = m_lasttick >= tick;
-        int ct = clock_ticks_from_ppqn(m_ppqn);         /* ppqn / 24        */
-        while (! done)
+        midipulse pulse = ((m_lasttick + ct) / ct) * ct; /* > m_lasttick    */
+        if (m_lasttick < tick)
         {
-            ++m_lasttick;
-            done = m_lasttick >= tick;
-            if ((m_lasttick % ct) == 0)                 /* tick time yet?   */
-                api_clock(tick);
+            bool sent = pulse <= tick;
+            for ( ; pulse <= tick; pulse += ct)
+                api_clock(pulse);                       /* pulse's own tick */
+
+            m_lasttick = tick;
+            if (sent)
+                api_flush();                            /* and send it out  */
         }
-        api_flush();                                    /* and send it out  */
+        result = pulse;
     }
+    return result;
 }
 
 /**
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-12-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the MIDI format, see, for example:
@@ -84,17 +84,23 @@
  *      -#  Any data bytes are ignored when the buffer is 0.
  */
 
-#include <fstream>                      /* std::ifstream and std::ofstream  */
+#include <algorithm>                    /* std::find()                      */
+#include <cstring>                      /* std::memcpy()                    */
+#include <fstream>                      /* std::ofstream                    */
 #include <memory>                       /* std::unique_ptr<>                */
+#include <utility>                      /* std::move()                      */
 
 #include "cfg/settings.hpp"             /* seq66::rc() and choose_ppqn()    */
 #include "midi/midifile.hpp"            /* seq66::midifile                  */
+#include "midi/midijournal.hpp"         /* seq66::midijournal               */
 #include "midi/midi_vector.hpp"         /* seq66::midi_vector container     */
 #include "midi/wrkfile.hpp"             /* seq66::wrkfile class             */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
 #include "play/performer.hpp"           /* seq66::performer                 */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
 #include "util/filefunctions.hpp"       /* seq66::get_full_path()           */
 #include "util/palette.hpp"             /* seq66::palette_to_int(), colors  */
+#include "util/parallel.hpp"            /* seq66::parallel_for()            */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -138,17 +144,40 @@ static const size_t c_minimum_midi_file_size = 14;
 static const unsigned c_legacy_mute_group = 1024;           /* 0x0400       */
 
 /**
- *  A manifest constant for controlling the length of the stream buffering
- *  array in a MIDI file.
+ *  The maximum length of a Seq24/Seq66 track nam3.
  */
 
-static const int c_midi_line_max = 1024;
+static const int c_trackname_max =  256;
 
 /**
- *  The maximum length of a Seq24/Seq66 track nam3.
+ *  The smallest number of tracks for which parse_smf_1() decodes the tracks,
+ *  or encode() and write_song() fill them, in parallel.  For fewer,
+ *  starting the threads costs more than it saves.
  */
 
-static const int c_trackname_max =  256;
+static const int c_parallel_tracks_min = 4;
+
+/**
+ *  The bytes typical of an event in a track chunk: a one-byte delta time
+ *  and two data bytes under running status.  Dividing the length of the
+ *  chunk by this value estimates its number of events, which parse_track()
+ *  reserves, so that the event storage of a pattern is not grown (and
+ *  copied) a dozen times as the events are appended.  It is only an
+ *  estimate.  A track of program changes or channel pressure, two bytes
+ *  per event, still grows a little past it; a track of SysEx, meta, or
+ *  text events, which are long, gets far more than it needs, hence
+ *  c_track_events_reserve_max and the trim at the end of parse_track().
+ */
+
+static const size_t c_track_event_bytes = 3;
+
+/**
+ *  The most events reserved ahead for a track, four pages of the event
+ *  storage, about a megabyte.  A longer track grows page by page, which
+ *  does not copy the pages already filled.
+ */
+
+static const size_t c_track_events_reserve_max = 16384;
 
 /**
  *  The maximum allowed variable length value for a MIDI file, which allows
@@ -297,26 +326,32 @@ midifile::midifile
     m_disable_reported          (false),
     m_running_status_action     (rc().running_status_action()),
     m_pos                       (0),
+    m_seqspec_end               (0),
     m_name                      (name),
-    m_data                      (),
+    m_input                     (),
+    m_data                      (nullptr),
     m_char_list                 (),
     m_global_bgsequence         (globalbgs),
     m_use_scaled_ppqn           (false),                /* scaled()         */
     m_ppqn                      (ppqn),                 /* can start as 0   */
     m_file_ppqn                 (0),                    /* can change       */
     m_ppqn_ratio                (1.0),                  /* for scaled()     */
-    m_smf0_splitter             ()
+    m_smf0_splitter             (),
+    m_detached                  (false),
+    m_detached_tracks           ()
 {
     // no other code needed
 }
 
 /**
- *  A rote destructor.
+ *  Deletes any sequences read by parse_detached() that were never
+ *  installed.
  */
 
 midifile::~midifile ()
 {
-    // empty body
+    for (auto sp : m_detached_tracks)
+        delete sp;
 }
 
 /**
@@ -345,23 +380,17 @@ midifile::read_seek (size_t pos)
 }
 
 /**
- *  Reads 1 byte of data directly from the m_data vector, incrementing
- *  m_pos after doing so.
+ *  The out-of-line part of read_byte(), called when reading past the end
+ *  of the data.
  *
  * \return
- *      Returns the byte that was read.  Returns 0 if there was an error,
- *      though there's no way for the caller to determine if this is an error
- *      or a good value.
+ *      Always returns 0.
  */
 
 midibyte
-midifile::read_byte ()
+midifile::read_end ()
 {
-    if (m_pos < m_file_size)
-    {
-        return m_data[m_pos++];
-    }
-    else if (! m_disable_reported)
+    if (! m_disable_reported)
         (void) set_error_dump("End-of-file; aborting reading");
 
     return 0;
@@ -486,8 +515,16 @@ midifile::read_byte_array (midibyte * b, size_t len)
     bool result = not_nullptr(b) && len > 0;
     if (result)
     {
-        for (size_t i = 0; i < len; ++i)
-            *b++ = read_byte();
+        if (m_pos + len <= m_file_size)                 /* copy in one go   */
+        {
+            std::memcpy(b, m_data + m_pos, len);
+            m_pos += len;
+        }
+        else
+        {
+            for (size_t i = 0; i < len; ++i)
+                *b++ = read_byte();
+        }
     }
     return result;
 }
@@ -508,7 +545,7 @@ midifile::read_meta_data (sequence & s, event & e, midibyte metatype, size_t len
 
         result = e.append_meta_data(metatype, bt);
         if (result)
-            result = s.append_event(e);
+            result = s.append_event(std::move(e));
     }
     return result;
 }
@@ -576,7 +613,7 @@ midifile::read_sysex_data
                 }
             }
             if (result)
-                result = s.append_event(e);
+                result = s.append_event(std::move(e));
         }
         else
             result = false;
@@ -606,11 +643,19 @@ midifile::read_string (std::string & b, size_t len)
     b.clear();
     if (result)
     {
-        if (len > b.capacity())
-            b.reserve(len);
+        if (m_pos + len <= m_file_size)                 /* copy in one go   */
+        {
+            b.assign(reinterpret_cast<const char *>(m_data + m_pos), len);
+            m_pos += len;
+        }
+        else
+        {
+            if (len > b.capacity())
+                b.reserve(len);
 
-        for (size_t i = 0; i < len; ++i)
-            b.push_back(read_byte());
+            for (size_t i = 0; i < len; ++i)
+                b.push_back(read_byte());
+        }
     }
     return result;
 }
@@ -637,29 +682,39 @@ midifile::read_byte_array (midistring & b, size_t len)
     b.clear();
     if (result)
     {
-        if (len > b.capacity())
-            b.reserve(len);
+        if (m_pos + len <= m_file_size)                 /* copy in one go   */
+        {
+            b.assign(m_data + m_pos, len);
+            m_pos += len;
+        }
+        else
+        {
+            if (len > b.capacity())
+                b.reserve(len);
 
-        for (size_t i = 0; i < len; ++i)
-            b.push_back(read_byte());
+            for (size_t i = 0; i < len; ++i)
+                b.push_back(read_byte());
+        }
     }
     return result;
 }
 
 /**
- *  Read a MIDI Variable-Length Value (VLV), which has a variable number
- *  of bytes.  This function reads the bytes while bit 7 is set in each
- *  byte.  Bit 7 is a continuation bit.  See write_varinum() for more
- *  information.
+ *  Finishes reading a MIDI Variable-Length Value (VLV) for read_varinum().
+ *  This function reads the bytes while bit 7 is set in each byte.  Bit 7 is
+ *  a continuation bit.  See write_varinum() for more information.
+ *
+ * \param result
+ *      The value accumulated so far.  read_varinum() passes 0, and starts
+ *      over here.
  *
  * \return
  *      Returns the accumulated values as a single number.
  */
 
 midilong
-midifile::read_varinum ()
+midifile::read_varinum_tail (midilong result)
 {
-    midilong result = 0;
     midibyte c;
     while (((c = read_byte()) & 0x80) != 0x00)      /* while bit 7 is set  */
     {
@@ -697,18 +752,11 @@ midifile::read_gap (size_t sz)
 }
 
 /**
- *  Creates the stream input, reads it into the "buffer", and then closes
- *  the file.  No file buffering needed on these beefy machines!  :-)
+ *  Makes the whole file available as the m_data array.  With the POSIX API
+ *  the file is memory-mapped, so that parsing a large file does not first
+ *  copy it; otherwise, it is read into a buffer.  See the mappedfile class.
  *  As a side-effect, also sets m_file_size.
  *
- *  We were using the assignment operator, but this caused an error using old
- *  32-bit debian stable, g++ 4.9 on one of our old laptops.  The assignment
- *  operator was deleted by the compiler.  So now we use constructor notation.
- *  A little bit odd, since we thought the compiler would convert assignment
- *  operator notation to constructor notation, but hey, compilers are not
- *  perfect.  Also, no need to use the krufty string pointer for the
- *  file-name.
- *
  * \param tag
  *      Basically an informative string to denote what kind of file is being
  *      opened, "MIDI" or "WRK".
@@ -727,29 +775,14 @@ midifile::grab_input_stream (const std::string & tag)
         return set_error("No MIDI file or data.");
     }
 
-    std::ifstream file(m_name, std::ios::in | std::ios::binary | std::ios::ate);
-    bool result = file.is_open();
+    bool result = m_input.open(m_name);
     m_error_is_fatal = false;
     if (result)
     {
+        m_data = m_input.data();
+        m_file_size = m_input.size();
         if (m_file_size < c_minimum_midi_file_size)
-        {
             result = set_error("File too small.");
-        }
-        else
-        {
-            file.seekg(0, std::ios::beg);       /* seek to the file's start */
-            try
-            {
-                m_data.resize(m_file_size);     /* allocate the data        */
-                file.read((char *)(&m_data[0]), m_file_size);
-            }
-            catch (const std::bad_alloc & ex)
-            {
-                result = set_error("File stream memory allocation failed.");
-            }
-            file.close();
-        }
     }
     else
     {
@@ -845,50 +878,128 @@ midifile::grab_input_stream (const std::string & tag)
 bool
 midifile::parse (performer & p, int screenset, bool importing)
 {
+    trace_scope ts("MIDI file parse");
     bool result = grab_input_stream(std::string("MIDI"));
     if (result)
     {
-        midilong ID = read_long();                      /* hdr chunk info   */
-        midilong hdrlength = read_long();               /* MThd length      */
-        clear_errors();
-        if (ID != c_mthd_tag && hdrlength != 6)     /* magic 'MThd'     */
-            return set_error_dump("Invalid MIDI header chunk detected", ID);
+        result = parse_data(p, screenset, importing);
+    }
+    else
+    {
+        m_error_is_fatal = true;
+        result = set_error_dump("Cannot open MIDI", 0);
+    }
+    return result;
+}
 
-        midishort Format = read_short();                /* 0, 1, or 2       */
-        m_smf0_splitter.initialize();                   /* SMF 0 support    */
-        if (Format == 0)
-        {
-            result = parse_smf_0(p, screenset);
+/**
+ *  Reads a MIDI file, as for an import, into sequences that are not
+ *  installed, and without changing the performer, so that several files can
+ *  be read at once in different threads; see import_midi_files().  The
+ *  performer is only asked for its master buss.  So the tempo, time
+ *  signature, and song information of the file are not applied, an SMF 0
+ *  file is read as one pattern, without splitting, and the events are
+ *  scaled to the PPQN given to the constructor.
+ *
+ * \param p
+ *      The performer for which the sequences are made.
+ *
+ * \return
+ *      Returns true if the parsing succeeded.  The sequences are then
+ *      obtained from move_detached().
+ */
+
+bool
+midifile::parse_detached (performer & p)
+{
+    trace_scope ts("MIDI file parse detached");
+    m_detached = true;
+    bool result = grab_input_stream(std::string("MIDI"));
+    if (result)
+    {
+        result = parse_data(p, 0, true);
+    }
+    else
+    {
+        m_error_is_fatal = true;
+        result = set_error_dump("Cannot open MIDI", 0);
+    }
+    return result;
+}
+
+/**
+ *  Hands over the sequences read by parse_detached(), in file order.
+ *
+ * \param offset
+ *      Added to the number of each sequence, to put it in the desired
+ *      screen-set.
+ *
+ * \param [out] dest
+ *      The sequences are appended to this vector, and are then owned by
+ *      the caller.
+ */
+
+void
+midifile::move_detached (int offset, std::vector<sequence *> & dest)
+{
+    for (auto sp : m_detached_tracks)
+    {
+        sp->seq_number(sp->seq_number() + offset);
+        dest.push_back(sp);
+    }
+    m_detached_tracks.clear();
+}
+
+/**
+ *  The body of parse(), which reads an SMF image from m_pos to the end of
+ *  the data.  Also used by midijournal to read the image of the song held
+ *  by an edit journal.
+ *
+ * \return
+ *      Returns true if the parsing succeeded.
+ */
+
+bool
+midifile::parse_data (performer & p, int screenset, bool importing)
+{
+    bool result = true;
+    midilong ID = read_long();                          /* hdr chunk info   */
+    midilong hdrlength = read_long();                   /* MThd length      */
+    clear_errors();
+    if (ID != c_mthd_tag && hdrlength != 6)         /* magic 'MThd'     */
+        return set_error_dump("Invalid MIDI header chunk detected", ID);
+
+    midishort Format = read_short();                    /* 0, 1, or 2       */
+    m_smf0_splitter.initialize();                       /* SMF 0 support    */
+    if (Format == 0)
+    {
+        result = parse_smf_0(p, screenset);
+        if (! m_detached)
             p.smf_format(0);
-        }
-        else if (Format == 1)
-        {
-            result = parse_smf_1(p, screenset);
+    }
+    else if (Format == 1)
+    {
+        result = parse_smf_1(p, screenset);
+        if (! m_detached)
             p.smf_format(1);
-        }
-        else
-        {
-            m_error_is_fatal = true;
-            result = set_error_dump
-            (
-                "Unsupported MIDI format number", midilong(Format)
-            );
-        }
-        if (result)
-        {
-            if (m_pos < m_file_size)                    /* any data left?   */
-            {
-                if (! importing)
-                    result = parse_seqspec_track(p, m_file_size);
-            }
-            if (result && importing)
-                 p.modify();                            /* modify flag      */
-        }
     }
     else
     {
         m_error_is_fatal = true;
-        result = set_error_dump("Cannot open MIDI", 0);
+        result = set_error_dump
+        (
+            "Unsupported MIDI format number", midilong(Format)
+        );
+    }
+    if (result)
+    {
+        if (m_pos < m_file_size)                        /* any data left?   */
+        {
+            if (! importing)
+                result = parse_seqspec_track(p, m_file_size);
+        }
+        if (result && importing && ! m_detached)
+             p.modify();                                /* modify flag      */
     }
     return result;
 }
@@ -915,7 +1026,7 @@ midifile::parse (performer & p, int screenset, bool importing)
 bool
 midifile::parse_smf_0 (performer & p, int screenset)
 {
-    bool c = usr().convert_to_smf_1();              /* true by default      */
+    bool c = usr().convert_to_smf_1() && ! m_detached;  /* not if detached  */
     bool result = parse_smf_1(p, screenset, c);     /* format 0 conversion? */
     if (c)
     {
@@ -931,7 +1042,7 @@ midifile::parse_smf_0 (performer & p, int screenset)
                 result = append_error("SMF 0 split failed.");
         }
     }
-    else if (result)
+    else if (result && ! m_detached)
     {
         seq::pointer s = p.get_sequence(0);
         if (s)
@@ -1130,13 +1241,11 @@ bool
 midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
 {
     bool result = true;
-    bool got_song_info = false;
     midibyte buss_override = usr().midi_buss_override();
     midishort track_count = read_short();
     midishort fileppqn = read_short();
-    bool gotfirst_bpm = false;
     file_ppqn(int(fileppqn));                       /* original file PPQN   */
-    if (usr().use_file_ppqn())
+    if (usr().use_file_ppqn() && ! m_detached)
     {
         p.file_ppqn(file_ppqn());                   /* let performer know   */
         ppqn(file_ppqn());                          /* PPQN == file PPQN    */
@@ -1156,620 +1265,977 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
             infoprintf("Buss override %d", int(buss_override));
         }
     }
+    std::vector<size_t> offsets;
+    if (! is_smf0 && ! m_detached)                  /* already in a thread  */
+        offsets = scan_tracks(track_count);         /* empty if serial only */
+
     for (midishort trk = 0; trk < track_count; ++trk)
     {
-        midibyte tentative_channel = null_channel();
+        if (trk == 1 && ! offsets.empty() && m_pos == offsets[1])
+        {
+            if (parse_tracks_parallel(p, screenset, offsets, result))
+                break;                              /* all tracks are done  */
+        }
+
         size_t track_position = m_pos;              /* save for SeqSpec'ing */
         midilong ID = read_long();                  /* get track marker     */
         midilong TrackLength = read_long();         /* get track length     */
         if (ID == c_mtrk_tag)                       /* magic number 'MTrk'  */
         {
-            int evcount = 0;                        /* for sanity checking  */
-            bool timesig_set = false;               /* first time-sig wins  */
-            bool error_reported = false;            /* for handling message */
-            midipulse runningtime = 0;              /* reset time           */
-            midipulse currenttime = 0;              /* adjusted by PPQN     */
-            midishort seqnum = c_midishort_max;     /* either read or set   */
-            midibyte status = 0;
-            midilong seqspec = 0;                   /* sequencer-specific   */
-            midibyte last_runningstatus = 0;
-            bool skip_to_end = false;
-            midibyte runningstatus = 0;
-            bool done = false;                      /* done for each track  */
             sequence * sp = create_sequence(p);     /* create new sequence  */
             if (is_nullptr(sp))
             {
                 set_error_dump("MIDI file parse: sequence allocation failed");
                 return false;
             }
+            sp->seq_number(int(trk));               /* tentative number     */
+
+            midishort seqnum;
+            trackstatus ts = parse_track
+            (
+                p, *sp, trk, track_position, is_smf0, seqnum
+            );
+            if (ts == trackstatus::ok)
+            {
+                install_track(p, sp, seqnum, screenset, is_smf0);
+            }
             else
-                sp->seq_number(int(trk));           /* tentative number     */
+            {
+                delete sp;                          /* never installed      */
+                if (ts == trackstatus::failed)
+                    return false;
+                else if (ts == trackstatus::stop)
+                    break;
+                else
+                    return true;                    /* SeqSpec track, abort */
+            }
+        }
+        else
+        {
+            if (trk > 0)                              /* non-fatal later  */
+            {
+                (void) set_error_dump("Bad track ID", ID);
+                break;
+            }
+            else                                        /* fatal in 1st one */
+            {
+                result = set_error_dump("First track has bad ID", ID);
+                break;
+            }
+            skip(TrackLength);
+        }
+    }                                                   /* for each track   */
+    return result;
+}
+
+/**
+ *  Parses one MTrk chunk into a sequence, for parse_smf_1().  The "MTrk"
+ *  marker and the chunk length have already been read.  This function
+ *  reaches the performer only for track 0 (for the first tempo and the song
+ *  information), so that other tracks can be decoded in any thread; see
+ *  parse_tracks_parallel().
+ *
+ * \param p
+ *      Provides the performer, used for track 0 only.
+ *
+ * \param s
+ *      The new, not yet installed, sequence to fill.
+ *
+ * \param trk
+ *      The track number.
+ *
+ * \param track_position
+ *      The offset of the start of the chunk.  If the track turns out to be
+ *      the Seq66 SeqSpec track, m_pos is reset to it.
+ *
+ * \param is_smf0
+ *      True if an SMF 0 file is being converted.
+ *
+ * \param [out] seqnum
+ *      The sequence number read from the track, or the track number.
+ *
+ * \return
+ *      Returns trackstatus::ok if the sequence is to be installed.  For
+ *      other values, the caller deletes the sequence and stops reading
+ *      tracks.
+ */
+
+midifile::trackstatus
+midifile::parse_track
+(
+    performer & p,
+    sequence & s,
+    midishort trk,
+    size_t track_position,
+    bool is_smf0,
+    midishort & seqnum
+)
+{
+    midibyte buss_override = usr().midi_buss_override();
+    midibyte tentative_channel = null_channel();
+    bool gotfirst_bpm = false;              /* used in track 0 only */
+    bool got_song_info = false;             /* ditto                */
+    int evcount = 0;                        /* for sanity checking  */
+    bool timesig_set = false;               /* first time-sig wins  */
+    bool error_reported = false;            /* for handling message */
+    midipulse runningtime = 0;              /* reset time           */
+    midipulse currenttime = 0;              /* adjusted by PPQN     */
+    midibyte status = 0;
+    midilong seqspec = 0;                   /* sequencer-specific   */
+    midibyte last_runningstatus = 0;
+    bool skip_to_end = false;
+    midibyte runningstatus = 0;
+    bool done = false;                      /* done for each track  */
+    seqnum = c_midishort_max;               /* either read or set   */
+    if (track_position + 8 <= m_file_size)
+    {
+        const midibyte * h = m_data + track_position + 4;
+        size_t len =
+            (size_t(h[0]) << 24) | (size_t(h[1]) << 16) |
+            (size_t(h[2]) << 8) | size_t(h[3]);
+
+        if (track_position + 8 + len <= m_file_size)
+        {
+            size_t estimate = len / c_track_event_bytes;
+            if (estimate > c_track_events_reserve_max)
+                estimate = c_track_events_reserve_max;
+
+            s.reserve_events(estimate);
+        }
+    }
+    while (! done)                          /* get events in track  */
+    {
+        event e;                            /* note-off, no channel */
+        midilong len;                       /* important counter!   */
+        midibyte d0, d1;                    /* the two data bytes   */
+        midipulse delta = read_varinum();   /* time delta from prev */
+        status = peek();                    /* current event byte   */
+        if (event::is_status(status))       /* is there a 0x80 bit? */
+        {
+            /*
+             * For SysEx, the skip is undone. For meta events, the
+             * correct event type is obtained anyway.
+             */
 
-            sequence & s = *sp;                     /* references better    */
-            while (! done)                          /* get events in track  */
+            skip(1);                                /* get to d0    */
+            if (event::is_system_common_msg(status))
             {
-                event e;                            /* note-off, no channel */
-                midilong len;                       /* important counter!   */
-                midibyte d0, d1;                    /* the two data bytes   */
-                midipulse delta = read_varinum();   /* time delta from prev */
-                status = m_data[m_pos];             /* current event byte   */
-                if (event::is_status(status))       /* is there a 0x80 bit? */
-                {
-                    /*
-                     * For SysEx, the skip is undone. For meta events, the
-                     * correct event type is obtained anyway.
-                     */
+                runningstatus = 0;                  /* clear it     */
+            }
+            else if (! event::is_realtime_msg(status))
+            {
+                runningstatus = status;             /* log status   */
+                if (m_running_status_action == rsaction::recover)
+                    last_runningstatus = status;
+            }
+        }
+        else                                /* there's no 0x80 bit  */
+        {
+            /*
+             * Handle data values. If in running status, set that as
+             * status; the next value to be read is the d0 value.  If
+             * not running status, is this an error?
+             */
 
-                    skip(1);                                /* get to d0    */
-                    if (event::is_system_common_msg(status))
-                    {
-                        runningstatus = 0;                  /* clear it     */
-                    }
-                    else if (! event::is_realtime_msg(status))
-                    {
-                        runningstatus = status;             /* log status   */
-                        if (m_running_status_action == rsaction::recover)
-                            last_runningstatus = status;
-                    }
-                }
-                else                                /* there's no 0x80 bit  */
-                {
-                    /*
-                     * Handle data values. If in running status, set that as
-                     * status; the next value to be read is the d0 value.  If
-                     * not running status, is this an error?
-                     */
+            if (skip_to_end)
+                continue;
 
-                    if (skip_to_end)
-                        continue;
+            if (runningstatus > 0)      /* running status in force? */
+            {
+                status = runningstatus; /* yes, use running status  */
+            }
+            else if (last_runningstatus > 0)
+            {
+                runningstatus = last_runningstatus;
+                status = runningstatus;
+            }
+        }
+        e.set_status_keep_channel(status);  /* set status, channel  */
 
-                    if (runningstatus > 0)      /* running status in force? */
-                    {
-                        status = runningstatus; /* yes, use running status  */
-                    }
-                    else if (last_runningstatus > 0)
-                    {
-                        runningstatus = last_runningstatus;
-                        status = runningstatus;
-                    }
-                }
-                e.set_status_keep_channel(status);  /* set status, channel  */
+        /*
+         *  See "PPQN" section in banner.
+         */
 
-                /*
-                 *  See "PPQN" section in banner.
-                 */
+        runningtime += delta;           /* add in the time          */
+        currenttime = runningtime;
+        if (scaled())                   /* adjust time via ppqn     */
+            currenttime = midipulse(currenttime * ppqn_ratio());
 
-                runningtime += delta;           /* add in the time          */
-                currenttime = runningtime;
-                if (scaled())                   /* adjust time via ppqn     */
-                    currenttime = midipulse(currenttime * ppqn_ratio());
+        e.set_timestamp(currenttime);
 
-                e.set_timestamp(currenttime);
+        midibyte eventcode = event::mask_status(status);    /* F0 */
+        midibyte channel = event::mask_channel(status);     /* 0F */
+        switch (eventcode)
+        {
+        case EVENT_NOTE_OFF:                    /* 3-byte events    */
+        case EVENT_NOTE_ON:
+        case EVENT_AFTERTOUCH:
+        case EVENT_CONTROL_CHANGE:
+        case EVENT_PITCH_WHEEL:
 
-                midibyte eventcode = event::mask_status(status);    /* F0 */
-                midibyte channel = event::mask_channel(status);     /* 0F */
-                switch (eventcode)
-                {
-                case EVENT_NOTE_OFF:                    /* 3-byte events    */
-                case EVENT_NOTE_ON:
-                case EVENT_AFTERTOUCH:
-                case EVENT_CONTROL_CHANGE:
-                case EVENT_PITCH_WHEEL:
+            d0 = read_byte();
+            d1 = read_byte();
+            if (event::is_note_off_velocity(eventcode, d1))
+                e.set_channel_status(EVENT_NOTE_OFF, channel);
+
+            e.set_data(d0, d1);               /* set data and add   */
+
+            /*
+             * s.append_event() doesn't sort events; sort after we
+             * get them all.  Also, it is kind of weird we change the
+             * channel for the whole sequence here.
+             */
 
-                    d0 = read_byte();
-                    d1 = read_byte();
-                    if (event::is_note_off_velocity(eventcode, d1))
-                        e.set_channel_status(EVENT_NOTE_OFF, channel);
+            if (s.append_event(std::move(e)))  /* does not sort    */
+                ++evcount;
 
-                    e.set_data(d0, d1);               /* set data and add   */
+            tentative_channel = channel;        /* log MIDI channel */
+            if (is_smf0)
+                m_smf0_splitter.increment(channel); /* count chan.  */
+            break;
 
-                    /*
-                     * s.append_event() doesn't sort events; sort after we
-                     * get them all.  Also, it is kind of weird we change the
-                     * channel for the whole sequence here.
-                     */
+        case EVENT_PROGRAM_CHANGE:              /* 1-data-byte event*/
+        case EVENT_CHANNEL_PRESSURE:
 
-                    if (s.append_event(e))              /* does not sort    */
-                        ++evcount;
+            d0 = read_byte();                   /* was data[0]      */
+            e.set_data(d0);                     /* set data and add */
 
-                    tentative_channel = channel;        /* log MIDI channel */
-                    if (is_smf0)
-                        m_smf0_splitter.increment(channel); /* count chan.  */
-                    break;
+            /*
+             * s.append_event() doesn't sort events; they're sorted
+             * after we read them all.
+             */
 
-                case EVENT_PROGRAM_CHANGE:              /* 1-data-byte event*/
-                case EVENT_CHANNEL_PRESSURE:
+            if (s.append_event(std::move(e)))  /* does not sort    */
+                ++evcount;
 
-                    d0 = read_byte();                   /* was data[0]      */
-                    e.set_data(d0);                     /* set data and add */
+            tentative_channel = channel;
+            if (is_smf0)
+                m_smf0_splitter.increment(channel); /* count chan.  */
+            break;
+
+        case EVENT_MIDI_REALTIME:               /* 0xFn MIDI events */
+
+            if (status == EVENT_MIDI_META)      /* 0xFF             */
+            {
+                midibyte mtype = read_byte();   /* get meta type    */
+                len = read_varinum();           /* if 0 catch later */
+                switch (mtype)
+                {
+                case EVENT_META_SEQ_NUMBER:     /* FF 00 02 ss      */
+
+                    if (! checklen(len, mtype)) /* might log error  */
+                        return trackstatus::failed;
 
                     /*
-                     * s.append_event() doesn't sort events; they're sorted
-                     * after we read them all.
+                     * If this number is the highly unlikely value of
+                     * 0x3fff, then we assume this track is the Seq66
+                     * SeqSpec track, the last track in the song. So
+                     * we delete the sequence and exit so that that
+                     * last track can be processed. The reason this
+                     * can happen is if a MIDI app saves the SeqSpec
+                     * track unaltered.
                      */
 
-                    if (s.append_event(e))              /* does not sort    */
-                        ++evcount;
-
-                    tentative_channel = channel;
-                    if (is_smf0)
-                        m_smf0_splitter.increment(channel); /* count chan.  */
+                    seqnum = read_short();
+                    if (seqnum == c_prop_seq_number)    /* 0x3ffff  */
+                    {
+                        m_pos = track_position; /* caller deletes   */
+                        return trackstatus::seqspec;
+                    }
                     break;
 
-                case EVENT_MIDI_REALTIME:               /* 0xFn MIDI events */
+                case EVENT_META_TRACK_NAME:     /* FF 03 len text   */
 
-                    if (status == EVENT_MIDI_META)      /* 0xFF             */
+                    if (checklen(len, mtype))
                     {
-                        midibyte mtype = read_byte();   /* get meta type    */
-                        len = read_varinum();           /* if 0 catch later */
-                        switch (mtype)
+                        int count = 0;
+                        char trackname[c_trackname_max];
+                        for (int i = 0; i < int(len); ++i)
                         {
-                        case EVENT_META_SEQ_NUMBER:     /* FF 00 02 ss      */
-
-                            if (! checklen(len, mtype)) /* might log error  */
-                                return false;
-
-                            /*
-                             * If this number is the highly unlikely value of
-                             * 0x3fff, then we assume this track is the Seq66
-                             * SeqSpec track, the last track in the song. So
-                             * we delete the sequence and exit so that that
-                             * last track can be processed. The reason this
-                             * can happen is if a MIDI app saves the SeqSpec
-                             * track unaltered.
-                             */
-
-                            seqnum = read_short();
-                            if (seqnum == c_prop_seq_number)    /* 0x3ffff  */
+                            char ch = char(read_byte());
+                            if (count < c_trackname_max)
                             {
-                                delete sp;              /* remove pattern   */
-                                m_pos = track_position;
-                                return true;            /* fake it          */
+                                trackname[count] = ch;
+                                ++count;
                             }
-                            break;
-
-                        case EVENT_META_TRACK_NAME:     /* FF 03 len text   */
+                        }
+                        trackname[count] = '\0';
+                        s.set_name(trackname);
+                    }
+                    else
+                        return trackstatus::failed;
 
-                            if (checklen(len, mtype))
-                            {
-                                int count = 0;
-                                char trackname[c_trackname_max];
-                                for (int i = 0; i < int(len); ++i)
-                                {
-                                    char ch = char(read_byte());
-                                    if (count < c_trackname_max)
-                                    {
-                                        trackname[count] = ch;
-                                        ++count;
-                                    }
-                                }
-                                trackname[count] = '\0';
-                                s.set_name(trackname);
-                            }
-                            else
-                                return false;
+                    break;
 
-                            break;
+                case EVENT_META_END_OF_TRACK:   /* FF 2F 00         */
 
-                        case EVENT_META_END_OF_TRACK:   /* FF 2F 00         */
+                    /*
+                     * This is an optional event according to the MIDI
+                     * specification.
+                     */
 
-                            /*
-                             * This is an optional event according to the MIDI
-                             * specification.
-                             */
+                    s.set_length(currenttime, false);
+                    s.zero_markers();
+                    done = true;
+                    break;
 
-                            s.set_length(currenttime, false);
-                            s.zero_markers();
-                            done = true;
-                            break;
+                case EVENT_META_SET_TEMPO:      /* FF 51 03 tttttt  */
 
-                        case EVENT_META_SET_TEMPO:      /* FF 51 03 tttttt  */
+                    if (! checklen(len, mtype))
+                        return trackstatus::failed;
 
-                            if (! checklen(len, mtype))
-                                return false;
+                    if (len == 3)
+                    {
+                        midibyte bt[4];         /* "Tempo events"   */
+                        bt[0] = read_byte();                /* tt   */
+                        bt[1] = read_byte();                /* tt   */
+                        bt[2] = read_byte();                /* tt   */
 
-                            if (len == 3)
+                        double tt = tempo_us_from_bytes(bt);
+                        if (tt > 0)
+                        {
+                            if (trk == 0 && ! m_detached)
                             {
-                                midibyte bt[4];         /* "Tempo events"   */
-                                bt[0] = read_byte();                /* tt   */
-                                bt[1] = read_byte();                /* tt   */
-                                bt[2] = read_byte();                /* tt   */
-
-                                double tt = tempo_us_from_bytes(bt);
-                                if (tt > 0)
+                                midibpm bpm = bpm_from_tempo_us(tt);
+                                if (! gotfirst_bpm)
                                 {
-                                    if (trk == 0)
-                                    {
-                                        midibpm bpm = bpm_from_tempo_us(tt);
-                                        if (! gotfirst_bpm)
-                                        {
-                                            gotfirst_bpm = true;
-                                            p.set_beats_per_minute(bpm);
-                                            p.us_per_quarter_note(int(tt));
-                                            s.us_per_quarter_note(int(tt));
-                                        }
-                                    }
-
-                                    bool ok = e.append_meta_data(mtype, bt, 3);
-                                    if (ok)
-                                    {
-                                        if (s.append_event(e))
-                                            ++evcount;
-                                    }
+                                    gotfirst_bpm = true;
+                                    p.set_beats_per_minute(bpm);
+                                    p.us_per_quarter_note(int(tt));
+                                    s.us_per_quarter_note(int(tt));
                                 }
                             }
-                            else
-                                skip(len);              /* eat it           */
-                            break;
 
-                        case EVENT_META_TIME_SIGNATURE: /* FF 58 04 n d c b */
-
-                            if (! checklen(len, mtype))
-                                return false;
-
-                            if (len == 4)
+                            bool ok = e.append_meta_data(mtype, bt, 3);
+                            if (ok)
                             {
-                                int bpb = int(read_byte());         // nn
-                                int logbase2 = int(read_byte());    // dd
-                                int cc = read_byte();               // cc
-                                int bb = read_byte();               // bb
-
-#if defined SEQ66_USE_TRACK_0_AS_GLOBAL_TIME_SIG    /* undefined */
-
-                                /*
-                                 * Could use c_perf_bp_mes and c_perf_bw
-                                 * instead.
-                                 */
-
-                                if (trk == 0)
-                                {
-                                    p.set_beats_per_bar(bpb);
-                                    p.set_beat_width(bw);
-                                    p.clocks_per_metronome(cc);
-                                    p.set_32nds_per_quarter(bb);
-                                }
-#endif
-
-                                midibyte bt[4];
-                                bt[0] = midibyte(bpb);
-                                bt[1] = midibyte(logbase2);
-                                bt[2] = midibyte(cc);
-                                bt[3] = midibyte(bb);
-
-                                bool ok = e.append_meta_data(mtype, bt, 4);
-                                if (ok)
-                                {
-                                    if (s.add_timesig_event(e, ! timesig_set))
-                                    {
-                                        timesig_set = true;
-                                        ++evcount;
-                                    }
-                                }
+                                if (s.append_event(std::move(e)))
+                                    ++evcount;
                             }
-                            else
-                                skip(len);              /* eat it           */
-                            break;
+                        }
+                    }
+                    else
+                        skip(len);              /* eat it           */
+                    break;
 
-                        case EVENT_META_KEY_SIGNATURE:  /* FF 59 02 ss kk   */
+                case EVENT_META_TIME_SIGNATURE: /* FF 58 04 n d c b */
 
-                            if (len == 2)
-                            {
-                                midibyte bt[2];
-                                bt[0] = read_byte();            /* #/b no.  */
-                                bt[1] = read_byte();            /* min/maj  */
+                    if (! checklen(len, mtype))
+                        return trackstatus::failed;
 
-                                bool ok = e.append_meta_data(mtype, bt, 2);
-                                if (ok)
-                                {
-                                    if (s.append_event(e))
-                                        ++evcount;
-                                }
-                            }
-                            else
-                                skip(len);              /* eat it           */
-                            break;
+                    if (len == 4)
+                    {
+                        int bpb = int(read_byte());         // nn
+                        int logbase2 = int(read_byte());    // dd
+                        int cc = read_byte();               // cc
+                        int bb = read_byte();               // bb
 
-                        case EVENT_META_SEQSPEC:      /* FF F7 = SeqSpec    */
+#if defined SEQ66_USE_TRACK_0_AS_GLOBAL_TIME_SIG    /* undefined */
 
-                            if (len > 4)              /* FF 7F len data     */
-                            {
-                                seqspec = read_long();
-                                len -= 4;
-                            }
-                            else if (! checklen(len, mtype))
-                                return false;
+                        /*
+                         * Could use c_perf_bp_mes and c_perf_bw
+                         * instead.
+                         */
 
-                            if (seqspec == c_midibus)
-                            {
-                                (void) s.set_midi_bus(read_byte());
-                                --len;
-                            }
-                            else if (seqspec == c_midiinbus)
-                            {
-                                (void) s.set_midi_in_bus(read_byte());
-                                --len;
-                            }
-                            else if (seqspec == c_midichannel)
-                            {
-                                midibyte channel = read_byte();
-                                tentative_channel = channel;
-                                --len;
-                                if (is_smf0)
-                                    m_smf0_splitter.increment(channel);
-                            }
-                            else if (seqspec == c_timesig)
-                            {
-                                /*
-                                 * This can override an early time-signature.
-                                 */
+                        if (trk == 0)
+                        {
+                            p.set_beats_per_bar(bpb);
+                            p.set_beat_width(bw);
+                            p.clocks_per_metronome(cc);
+                            p.set_32nds_per_quarter(bb);
+                        }
+#endif
 
-                                int bpb = int(read_byte());
-                                int bw = int(read_byte());
-                                if (s.add_c_timesig(bpb, bw, ! timesig_set))
-                                    timesig_set = true;
+                        midibyte bt[4];
+                        bt[0] = midibyte(bpb);
+                        bt[1] = midibyte(logbase2);
+                        bt[2] = midibyte(cc);
+                        bt[3] = midibyte(bb);
 
-                                len -= 2;
-                            }
-                            else if (seqspec == c_triggers)
-                            {
-                                int sz = trigger::datasize(c_triggers);
-                                int num_triggers = len / sz;
-                                for (int i = 0; i < num_triggers; ++i)
-                                {
-                                    add_old_trigger(s);
-                                    len -= sz;
-                                }
-                            }
-                            else if (seqspec == c_triggers_ex)
-                            {
-                                int sz = trigger::datasize(c_triggers_ex);
-                                int num_triggers = len / sz;
-                                midishort p = scaled() ? file_ppqn() : 0 ;
-                                for (int i = 0; i < num_triggers; ++i)
-                                {
-                                    add_trigger(s, p, false);
-                                    len -= sz;
-                                }
-                            }
-                            else if (seqspec == c_trig_transpose)
-                            {
-                                int sz = trigger::datasize(c_trig_transpose);
-                                int num_triggers = len / sz;
-                                midishort p = scaled() ? file_ppqn() : 0 ;
-                                for (int i = 0; i < num_triggers; ++i)
-                                {
-                                    add_trigger(s, p, true);
-                                    len -= sz;
-                                }
-                            }
-                            else if (seqspec == c_musickey)
-                            {
-                                s.musical_key(read_byte());
-                                --len;
-                            }
-                            else if (seqspec == c_musicscale)
-                            {
-                                s.musical_scale(read_byte());
-                                --len;
-                            }
-                            else if (seqspec == c_backsequence)
-                            {
-                                s.background_sequence(int(read_long()));
-                                len -= 4;
-                            }
-                            else if (seqspec == c_transpose)
-                            {
-                                s.set_transposable(read_byte() != 0);
-                                --len;
-                            }
-                            else if (seqspec == c_seq_color)
-                            {
-                                s.set_color(read_byte());
-                                --len;
-                            }
-                            else if (seqspec == c_seq_loopcount)
-                            {
-                                s.loop_count_max(int(read_short()));
-                                len -= 2;
-                            }
-                            else if (seqspec == c_mutegroups)
-                            {
-                                /* handled in parse_seqspec_track() */
-                            }
-                            else if (is_proptag(seqspec))
-                            {
-                                (void) set_error_dump
-                                (
-                                    "Unknown Seq66 SeqSpec, skipping",
-                                    seqspec
-                                );
-                            }
-                            else
+                        bool ok = e.append_meta_data(mtype, bt, 4);
+                        if (ok)
+                        {
+                            if (s.add_timesig_event(e, ! timesig_set))
                             {
-                                /* will skip all other SeqSpecs */
+                                timesig_set = true;
+                                ++evcount;
                             }
-                            skip(len);                  /* eat it           */
-                            break;
-
-                        /*
-                         * Handled above: EVENT_META_TRACK_NAME
-                         */
+                        }
+                    }
+                    else
+                        skip(len);              /* eat it           */
+                    break;
 
-                        case EVENT_META_TEXT_EVENT:      /* FF 01 len text  */
-                        case EVENT_META_COPYRIGHT:       /* FF 02 ...       */
-                        case EVENT_META_INSTRUMENT:      /* FF 04 ...       */
-                        case EVENT_META_LYRIC:           /* FF 05 ...       */
-                        case EVENT_META_MARKER:          /* FF 06 ...       */
-                        case EVENT_META_CUE_POINT:       /* FF 07 ...       */
+                case EVENT_META_KEY_SIGNATURE:  /* FF 59 02 ss kk   */
 
-                            if (checklen(len, mtype))
-                            {
-                                int count = 0;
-                                midibyte mt[c_meta_text_limit];
-                                for (int i = 0; i < int(len); ++i)
-                                {
-                                    char ch = char(read_byte());
-                                    if (count < int(c_meta_text_limit))
-                                    {
-                                        mt[count] = ch;
-                                        ++count;
-                                    }
-                                }
-                                mt[count] = '\0';
-
-                                bool ok = e.append_meta_data(mtype, mt, count);
-                                if (ok)
-                                {
-                                    if (s.append_event(e))
-                                    {
-                                        bool get_song_info =
-                                            trk == 0 &&
-                                            mtype == EVENT_META_TEXT_EVENT &&
-                                            ! got_song_info;
-
-                                        if (get_song_info)
-                                        {
-                                            got_song_info = true;
-                                            p.song_info(e.get_text());
-                                        }
-                                        ++evcount;
-                                    }
-                                }
-                            }
-                            else
-                                return false;
+                    if (len == 2)
+                    {
+                        midibyte bt[2];
+                        bt[0] = read_byte();            /* #/b no.  */
+                        bt[1] = read_byte();            /* min/maj  */
 
-                            break;
+                        bool ok = e.append_meta_data(mtype, bt, 2);
+                        if (ok)
+                        {
+                            if (s.append_event(std::move(e)))
+                                ++evcount;
+                        }
+                    }
+                    else
+                        skip(len);              /* eat it           */
+                    break;
 
-                        case EVENT_META_MIDI_CHANNEL:   /* FF 20 01 cc      */
-                        case EVENT_META_MIDI_PORT:      /* FF 21 01 pp      */
-                        case EVENT_META_SMPTE_OFFSET:   /* FF 54 03 t t t   */
+                case EVENT_META_SEQSPEC:      /* FF F7 = SeqSpec    */
 
-                            /*
-                             * The first two events are obsolete, the SMPTE is
-                             * not supported. But we append them anyway to
-                             * preserve, somewhat, the original file.
-                             * read_meta_data() appends the event.
-                             */
+                    if (len > 4)              /* FF 7F len data     */
+                    {
+                        seqspec = read_long();
+                        len -= 4;
+                    }
+                    else if (! checklen(len, mtype))
+                        return trackstatus::failed;
 
-                            if (read_meta_data(s, e, mtype, len))
-                                ++evcount;
+                    if (seqspec == c_midibus)
+                    {
+                        (void) s.set_midi_bus(read_byte());
+                        --len;
+                    }
+                    else if (seqspec == c_midiinbus)
+                    {
+                        (void) s.set_midi_in_bus(read_byte());
+                        --len;
+                    }
+                    else if (seqspec == c_midichannel)
+                    {
+                        midibyte channel = read_byte();
+                        tentative_channel = channel;
+                        --len;
+                        if (is_smf0)
+                            m_smf0_splitter.increment(channel);
+                    }
+                    else if (seqspec == c_timesig)
+                    {
+                        /*
+                         * This can override an early time-signature.
+                         */
 
-                            break;
+                        int bpb = int(read_byte());
+                        int bw = int(read_byte());
+                        if (s.add_c_timesig(bpb, bw, ! timesig_set))
+                            timesig_set = true;
 
-                        default:
+                        len -= 2;
+                    }
+                    else if (seqspec == c_triggers)
+                    {
+                        int sz = trigger::datasize(c_triggers);
+                        int num_triggers = len / sz;
+                        for (int i = 0; i < num_triggers; ++i)
+                        {
+                            add_old_trigger(s);
+                            len -= sz;
+                        }
+                    }
+                    else if (seqspec == c_triggers_ex)
+                    {
+                        int sz = trigger::datasize(c_triggers_ex);
+                        int num_triggers = len / sz;
+                        midishort p = scaled() ? file_ppqn() : 0 ;
+                        for (int i = 0; i < num_triggers; ++i)
+                        {
+                            add_trigger(s, p, false);
+                            len -= sz;
+                        }
+                    }
+                    else if (seqspec == c_trig_transpose)
+                    {
+                        int sz = trigger::datasize(c_trig_transpose);
+                        int num_triggers = len / sz;
+                        midishort p = scaled() ? file_ppqn() : 0 ;
+                        for (int i = 0; i < num_triggers; ++i)
+                        {
+                            add_trigger(s, p, true);
+                            len -= sz;
+                        }
+                    }
+                    else if (seqspec == c_musickey)
+                    {
+                        s.musical_key(read_byte());
+                        --len;
+                    }
+                    else if (seqspec == c_musicscale)
+                    {
+                        s.musical_scale(read_byte());
+                        --len;
+                    }
+                    else if (seqspec == c_backsequence)
+                    {
+                        s.background_sequence(int(read_long()));
+                        len -= 4;
+                    }
+                    else if (seqspec == c_transpose)
+                    {
+                        s.set_transposable(read_byte() != 0);
+                        --len;
+                    }
+                    else if (seqspec == c_seq_color)
+                    {
+                        s.set_color(read_byte());
+                        --len;
+                    }
+                    else if (seqspec == c_seq_loopcount)
+                    {
+                        s.loop_count_max(int(read_short()));
+                        len -= 2;
+                    }
+                    else if (seqspec == c_seq_modlanes)
+                    {
+                        int count = int(read_byte());
+                        --len;
+                        for (int i = 0; i < count; ++i)
+                        {
+                            if (len < modlane::c_data_size)
+                                break;
 
-                            if (rc().verbose())
-                            {
-                                std::string m = "Illegal meta value skipped";
-                                (void) set_error_dump(m);
-                            }
-                            break;
+                            midibyte status = read_byte();
+                            midibyte cc = read_byte();
+                            waveform w = static_cast<waveform>(read_byte());
+                            int steps = int(read_byte());
+                            double dc = double(read_short()) / 10.0;
+                            double range = double(read_short()) / 10.0;
+                            double speed = double(read_short()) / 100.0;
+                            double phase = double(read_short()) / 100.0;
+                            modlane ml
+                            (
+                                status, cc, w, dc, range, speed, phase, steps
+                            );
+                            (void) s.add_mod_lane(ml);
+                            len -= modlane::c_data_size;
                         }
                     }
-                    else if (status == EVENT_MIDI_SYSEX)    /* 0xF0 len syx */
+                    else if (seqspec == c_seq_filter)
                     {
-                        len = read_varinum();
-                        if (read_sysex_data(s, e, len))
-                            ++evcount;
+                        std::string spec;
+                        for ( ; len > 0; --len)
+                            spec += char(read_byte());
+
+                        if (! s.output_filter(spec))
+                            (void) set_error_dump("Bad output filter, ignored");
                     }
-                    else if (status == EVENT_MIDI_SYSEX_END) /* 0xF7 contin */
+                    else if (seqspec == c_mutegroups)
                     {
-                        len = read_varinum();
-                        if (read_sysex_data(s, e, len, true))
-                            ++evcount;
+                        /* handled in parse_seqspec_track() */
                     }
-                    else
+                    else if (is_proptag(seqspec))
                     {
                         (void) set_error_dump
                         (
-                            "Unexpected meta code", midilong(status)
+                            "Unknown Seq66 SeqSpec, skipping",
+                            seqspec
                         );
                     }
+                    else
+                    {
+                        /* will skip all other SeqSpecs */
+                    }
+                    skip(len);                  /* eat it           */
                     break;
 
-                default:
+                /*
+                 * Handled above: EVENT_META_TRACK_NAME
+                 */
 
-                    if (! error_reported)
+                case EVENT_META_TEXT_EVENT:      /* FF 01 len text  */
+                case EVENT_META_COPYRIGHT:       /* FF 02 ...       */
+                case EVENT_META_INSTRUMENT:      /* FF 04 ...       */
+                case EVENT_META_LYRIC:           /* FF 05 ...       */
+                case EVENT_META_MARKER:          /* FF 06 ...       */
+                case EVENT_META_CUE_POINT:       /* FF 07 ...       */
+
+                    if (checklen(len, mtype))
                     {
-                        /*
-                         * Some files (e.g. 2rock.mid, which has "00 24 40"
-                         * hanging out there all alone at offset 0xba) have
-                         * junk in them. Others (trilogy.mid) try to use
-                         * running status after a SysEx event.
-                         */
+                        int count = 0;
+                        midibyte mt[c_meta_text_limit];
+                        for (int i = 0; i < int(len); ++i)
+                        {
+                            char ch = char(read_byte());
+                            if (count < int(c_meta_text_limit))
+                            {
+                                mt[count] = ch;
+                                ++count;
+                            }
+                        }
+                        mt[count] = '\0';
+
+                        bool ok = e.append_meta_data(mtype, mt, count);
+                        if (ok)
+                        {
+                            if (s.append_event(e))
+                            {
+                                bool get_song_info =
+                                    trk == 0 && ! m_detached &&
+                                    mtype == EVENT_META_TEXT_EVENT &&
+                                    ! got_song_info;
 
-                        std::string msg = "Bad event";
-                        skip_to_end = track_error(msg, trk);
-                        if (m_running_status_action == rsaction::abort)
-                            return true;    /* don't process more tracks    */
-                        else
-                            error_reported = true;
+                                if (get_song_info)
+                                {
+                                    got_song_info = true;
+                                    p.song_info(e.get_text());
+                                }
+                                ++evcount;
+                            }
+                        }
                     }
+                    else
+                        return trackstatus::failed;
+
                     break;
-                }
-                if (at_end())
+
+                case EVENT_META_MIDI_CHANNEL:   /* FF 20 01 cc      */
+                case EVENT_META_MIDI_PORT:      /* FF 21 01 pp      */
+                case EVENT_META_SMPTE_OFFSET:   /* FF 54 03 t t t   */
+
+                    /*
+                     * The first two events are obsolete, the SMPTE is
+                     * not supported. But we append them anyway to
+                     * preserve, somewhat, the original file.
+                     * read_meta_data() appends the event.
+                     */
+
+                    if (read_meta_data(s, e, mtype, len))
+                        ++evcount;
+
                     break;
-            }                               /* while loading Trk chunks     */
 
-            /*
-             * Sequence has been filled, add it to the performance or SMF 0
-             * splitter.  If there was no sequence number embedded in the
-             * track, use the for-loop track number.  It's not fool-proof.
-             * "If the ID numbers are omitted, the sequences' locations in
-             * order in the file are used as defaults."
-             */
+                default:
 
-            if (at_end() && ! done)         /* done == end-of-track found   */
-            {
-                std::string msg = "Premature end-of-file";
-                (void) track_error(msg, trk);
-                if (m_running_status_action == rsaction::abort)
+                    if (rc().verbose())
+                    {
+                        std::string m = "Illegal meta value skipped";
+                        (void) set_error_dump(m);
+                    }
                     break;
+                }
             }
-            if (seqnum == c_midishort_max)
-                seqnum = trk;
+            else if (status == EVENT_MIDI_SYSEX)    /* 0xF0 len syx */
+            {
+                len = read_varinum();
+                if (read_sysex_data(s, e, len))
+                    ++evcount;
+            }
+            else if (status == EVENT_MIDI_SYSEX_END) /* 0xF7 contin */
+            {
+                len = read_varinum();
+                if (read_sysex_data(s, e, len, true))
+                    ++evcount;
+            }
+            else
+            {
+                (void) set_error_dump
+                (
+                    "Unexpected meta code", midilong(status)
+                );
+            }
+            break;
+
+        default:
 
-            if (seqnum < c_prop_seq_number)
+            if (! error_reported)
             {
-                s.set_midi_channel(tentative_channel);
-                if (! is_null_buss(buss_override))
-                    (void) s.set_midi_bus(buss_override);
+                /*
+                 * Some files (e.g. 2rock.mid, which has "00 24 40"
+                 * hanging out there all alone at offset 0xba) have
+                 * junk in them. Others (trilogy.mid) try to use
+                 * running status after a SysEx event.
+                 */
 
-                if (rc().verbose())
-                {
-                    char temp[64];
-                    snprintf
-                    (
-                        temp, sizeof temp, "%d events in track  %d",
-                        evcount, trk
-                    );
-                    info_message(temp);
-                }
-                if (is_smf0)
-                    (void) m_smf0_splitter.log_main_sequence(s, seqnum);
+                std::string msg = "Bad event";
+                skip_to_end = track_error(msg, trk);
+                if (m_running_status_action == rsaction::abort)
+                    return trackstatus::abort;   /* no more tracks */
                 else
-                    finalize_sequence(p, s, seqnum, screenset);
+                    error_reported = true;
             }
+            break;
+        }
+        if (at_end())
+            break;
+    }                               /* while loading Trk chunks     */
+
+    /*
+     * Sequence has been filled; the caller adds it to the performance or SMF
+     * 0 splitter.  If there was no sequence number embedded in the track,
+     * use the for-loop track number.  It's not fool-proof.  "If the ID
+     * numbers are omitted, the sequences' locations in order in the file are
+     * used as defaults."
+     */
+
+    if (at_end() && ! done)         /* done == end-of-track found   */
+    {
+        std::string msg = "Premature end-of-file";
+        (void) track_error(msg, trk);
+        if (m_running_status_action == rsaction::abort)
+            return trackstatus::stop;
+    }
+    s.trim_events();                /* give back an over-reservation    */
+    if (seqnum == c_midishort_max)
+        seqnum = trk;
+
+    if (seqnum < c_prop_seq_number)
+    {
+        s.set_midi_channel(tentative_channel);
+        if (! is_null_buss(buss_override))
+            (void) s.set_midi_bus(buss_override);
+
+        if (rc().verbose())
+        {
+            char temp[64];
+            snprintf
+            (
+                temp, sizeof temp, "%d events in track  %d",
+                evcount, trk
+            );
+            info_message(temp);
         }
+    }
+    return trackstatus::ok;
+}
+
+/**
+ *  Adds a parsed sequence to the performance, the SMF 0 splitter, or the
+ *  detached tracks.  A sequence with a number that is out of range is
+ *  deleted.
+ */
+
+void
+midifile::install_track
+(
+    performer & p,
+    sequence * sp,
+    midishort seqnum,
+    int screenset,
+    bool is_smf0
+)
+{
+    if (seqnum < c_prop_seq_number)
+    {
+        if (m_detached)
+        {
+            sp->seq_number(int(seqnum));
+            m_detached_tracks.push_back(sp);
+        }
+        else if (is_smf0)
+            (void) m_smf0_splitter.log_main_sequence(*sp, seqnum);
         else
+            (void) finalize_sequence(p, *sp, seqnum, screenset);
+    }
+    else
+        delete sp;
+}
+
+/**
+ *  Walks the MTrk chunk headers, starting at m_pos, without moving m_pos.
+ *  The tracks can be decoded in parallel only if every chunk is an MTrk
+ *  chunk that fits in the file, so that its extent is known in advance.
+ *
+ * \param track_count
+ *      The number of tracks given in the MThd chunk.
+ *
+ * \return
+ *      Returns the offset of each track, plus the offset of the end of the
+ *      last track, for a total of track_count + 1 entries.  Empty if the
+ *      file is not worth or not fit for parallel decoding.
+ */
+
+std::vector<size_t>
+midifile::scan_tracks (midishort track_count) const
+{
+    std::vector<size_t> result;
+    if (parallel_cores() > 1 && int(track_count) >= c_parallel_tracks_min)
+    {
+        size_t pos = m_pos;
+        result.reserve(size_t(track_count) + 1);
+        for (midishort trk = 0; trk < track_count; ++trk)
         {
-            if (trk > 0)                              /* non-fatal later  */
-            {
-                (void) set_error_dump("Bad track ID", ID);
-                break;
-            }
-            else                                        /* fatal in 1st one */
-            {
-                result = set_error_dump("First track has bad ID", ID);
-                break;
-            }
-            skip(TrackLength);
+            if (pos + 8 > m_file_size)
+                return std::vector<size_t>();
+
+            const midibyte * h = m_data + pos;
+            miditag id =
+                (miditag(h[0]) << 24) | (miditag(h[1]) << 16) |
+                (miditag(h[2]) << 8) | miditag(h[3]);
+
+            size_t len =
+                (size_t(h[4]) << 24) | (size_t(h[5]) << 16) |
+                (size_t(h[6]) << 8) | size_t(h[7]);
+
+            if (id != c_mtrk_tag || pos + 8 + len > m_file_size)
+                return std::vector<size_t>();
+
+            result.push_back(pos);
+            pos += 8 + len;
         }
-    }                                                   /* for each track   */
+        result.push_back(pos);
+    }
     return result;
 }
 
+/**
+ *  Makes this object read the MIDI data of another midifile, starting at
+ *  the given offset, with the same PPQN scaling.  Used for the decoders of
+ *  parse_tracks_parallel(), which share the file data of the parser.
+ */
+
+void
+midifile::share_input (const midifile & source, size_t pos)
+{
+    m_data = source.m_data;
+    m_file_size = source.m_file_size;
+    m_pos = pos;
+    m_running_status_action = source.m_running_status_action;
+    m_use_scaled_ppqn = source.m_use_scaled_ppqn;
+    m_ppqn = source.m_ppqn;
+    m_file_ppqn = source.m_file_ppqn;
+    m_ppqn_ratio = source.m_ppqn_ratio;
+}
+
+/**
+ *  Decodes tracks 1 and up of an SMF 1 file across several threads, then
+ *  installs them in track order, as the serial loop of parse_smf_1() would.
+ *  Track 0 has already been parsed by the caller, as it can set the tempo
+ *  and song information of the performer.  The sequences are created up
+ *  front, in this thread, and each track is decoded by its own midifile
+ *  object sharing the file data.
+ *
+ *  Each decoder's end position is then checked against the extent of its
+ *  chunk.  If one stopped short of its chunk or read past it (a bad chunk
+ *  length), the results are dropped and the caller parses the tracks
+ *  serially, so that the outcome never depends on the method.
+ *
+ * \param p
+ *      Provides the performer in which to install the sequences.
+ *
+ * \param screenset
+ *      The screen-set offset for the sequences.
+ *
+ * \param offsets
+ *      The offsets of the tracks and the end of the last one, from
+ *      scan_tracks().  m_pos must be at the start of track 1.
+ *
+ * \param [out] result
+ *      Set to the value for parse_smf_1() to return, if this function
+ *      returns true.
+ *
+ * \return
+ *      Returns true if the tracks were handled.  If false, nothing has been
+ *      changed.
+ */
+
+bool
+midifile::parse_tracks_parallel
+(
+    performer & p,
+    int screenset,
+    const std::vector<size_t> & offsets,
+    bool & result
+)
+{
+    struct decoded
+    {
+        sequence * sp = nullptr;
+        midishort seqnum = 0;
+        trackstatus status = trackstatus::failed;
+        size_t end = 0;
+        std::string error;
+        bool fatal = false;
+        bool disabled = false;
+    };
+
+    size_t count = offsets.size() - 1;              /* the track count      */
+    std::vector<decoded> tracks(count);
+    for (size_t t = 1; t < count; ++t)              /* not thread-safe      */
+    {
+        tracks[t].sp = create_sequence(p);
+        if (is_nullptr(tracks[t].sp))
+        {
+            for (auto & d : tracks)
+                delete d.sp;
+
+            return false;                           /* the caller reports   */
+        }
+        tracks[t].sp->seq_number(int(t));           /* tentative number     */
+    }
+
+    auto decode = [&] (size_t i)
+    {
+        size_t t = i + 1;                           /* track 0 is done      */
+        decoded & d = tracks[t];
+        midifile decoder
+        (
+            m_name, ppqn(), m_global_bgsequence, verify_mode()
+        );
+        decoder.share_input(*this, offsets[t] + 8);
+        d.status = decoder.parse_track
+        (
+            p, *d.sp, midishort(t), offsets[t], false, d.seqnum
+        );
+        d.end = decoder.m_pos;
+        d.error = decoder.m_error_message;
+        d.fatal = decoder.m_error_is_fatal;
+        d.disabled = decoder.m_disable_reported;
+    };
+    parallel_for(count - 1, decode);
+
+    for (size_t t = 1; t < count; ++t)              /* chunk lengths good?  */
+    {
+        const decoded & d = tracks[t];
+        if (d.status != trackstatus::ok)
+            break;
+
+        if (d.end != offsets[t + 1])
+        {
+            for (auto & dd : tracks)
+                delete dd.sp;
+
+            return false;
+        }
+    }
+
+    bool finished = false;
+    result = true;
+    for (size_t t = 1; t < count; ++t)
+    {
+        decoded & d = tracks[t];
+        if (finished)
+        {
+            delete d.sp;                            /* never reached        */
+            continue;
+        }
+        if (! d.error.empty())
+            m_error_message = d.error;
+
+        if (d.fatal)
+            m_error_is_fatal = true;
+
+        if (d.disabled)
+            m_disable_reported = true;
+
+        m_pos = d.end;
+        if (d.status == trackstatus::ok)
+        {
+            install_track(p, d.sp, d.seqnum, screenset, false);
+        }
+        else
+        {
+            delete d.sp;                            /* never installed      */
+            finished = true;
+            if (d.status == trackstatus::failed)
+                result = false;
+        }
+    }
+    return true;
+}
+
 sequence *
 midifile::create_sequence (performer & p)
 {
@@ -1852,6 +2318,7 @@ midilong
 midifile::parse_seqspec_header (int file_size)
 {
     midilong result = 0;
+    m_seqspec_end = 0;
     if ((file_size - m_pos) > int(sizeof(midilong)))
     {
         result = read_long();                   /* status (new), or C_tag   */
@@ -1863,7 +2330,8 @@ midifile::parse_seqspec_header (int file_size)
             midibyte type = read_byte();        /* get meta type            */
             if (type == EVENT_META_SEQSPEC)     /* 0x7F event marker        */
             {
-                (void) read_varinum();          /* prop section length      */
+                size_t len = size_t(read_varinum());    /* section length   */
+                m_seqspec_end = m_pos + len;
                 result = read_long();           /* control tag              */
             }
             else if (type == EVENT_META_END_OF_TRACK)
@@ -2004,6 +2472,7 @@ midifile::parse_seqspec_track (performer & p, int file_size)
  *      c_midibus          c_timesig         c_midichannel    c_musickey *
  *      c_musicscale *     c_backsequence *  c_transpose *    c_seq_color
  *      c_seq_loopcount   c_triggers       c_triggers_ex      c_trig_transpose
+ *      c_seq_modlanes    c_seq_filter
  *
  * Global SeqSpecs handled here:
  *
@@ -2014,7 +2483,7 @@ midifile::parse_seqspec_track (performer & p, int file_size)
  *
  * Not handled:
  *
- *      c_gap_A to _F      c_reserved_3      c_reserved_4     c_seq_edit_mode
+ *      c_gap_A to _F      c_seq_edit_mode
  */
 
 bool
@@ -2052,8 +2521,8 @@ midifile::prop_header_loop (performer & p, int file_size)
              * case c_seq_color:
              * case c_seq_edit_mode:    (unhandled)
              * case c_seq_loopcount:
-             * case c_reserved_3:       (unhandled)
-             * case c_reserved_4:       (unhandled)
+             * case c_seq_modlanes:
+             * case c_seq_filter:
              * case c_trig_transpose:
              */
 
@@ -2177,130 +2646,54 @@ midifile::parse_c_bpmtag (performer & p)
  *  specified by the application's user-interface as must the rows and
  *  columns.
  *
- * New:  We write the group name.  So the new format of mute-groups is:
- *
- *      -#  Split byte count for the number of groups and the size of each
- *          group. Long, 4 bytes.
- *      -#  Group number.  Byte value.
- *      -#  Mute-group bit values, 1 byte each, and group-size of them.
- *      -#  Optional:  The mute-group name in double quotes.
- */
-
-bool
-midifile::parse_c_mutegroups (performer & p)
-{
-    mutegroups & mutes = p.mutes();
-    bool result = mutes.group_load_from_midi();
-    if (result)
-        result = ! mutes.loaded_from_mutes();       /* loaded from config?  */
-
-    if (result)
-    {
-        unsigned groupcount, groupsize;
-        long len = long(read_split_long(groupcount, groupsize));
-        if (len > 0)
-        {
-            bool legacyformat = len == c_legacy_mute_group;
-            (void) p.mutes().reset_defaults();      /* makes it empty       */
-            if (legacyformat)
-            {
-                result = parse_c_mutegroups_legacy(p, groupcount, groupsize);
-            }
-            else
-            {
-                std::string gname;
-                mutes.legacy_mutes(false);
-                for (unsigned g = 0; g < groupcount; ++g)
-                {
-                    midibooleans mutebits;
-                    midilong group = read_byte();
-                    gname.clear();
-                    for (unsigned s = 0; s < groupsize; ++s)
-                    {
-                        midibyte gmutestate = read_byte();  /* byte for bit */
-                        bool status = gmutestate != 0;
-                        mutebits.push_back(midibool(status));
-                    }
-                    char letter = (char) read_byte();
-                    if (letter == '"')                      /* next a quote? */
-                    {
-                        for (;;)
-                        {
-                            char letter = (char) read_byte();
-                            if (letter == '"')
-                                break;
-                            else
-                                gname += letter;
-                        }
-                    }
-                    else
-                        --m_pos;                            /* put it back  */
-
-                    if (mutes.load(group, mutebits))
-                    {
-                        /*
-                         * Related to issue #87.
-                         */
-
-                        mutes.group_name(group, gname);
-                        if (mutebits.size() != size_t(p.group_count()))
-                        {
-                            mutebits = fix_midibooleans
-                            (
-                                mutebits, p.group_count()
-                            );
-                            rc().auto_mutes_save(true);
-                        }
-                    }
-                    else
-                        break;                              /* a duplicate  */
-                }
-            }
-        }
-    }
-    return result;
-}
+ * New:  We write the group name.  So the new format of mute-groups is:
+ *
+ *      -#  Split byte count for the number of groups and the size of each
+ *          group. Long, 4 bytes.
+ *      -#  Group number.  Byte value.
+ *      -#  Mute-group bit values, 1 byte each, and group-size of them.
+ *      -#  Optional:  The mute-group name in double quotes.
+ *
+ *  The groups are decoded by mutegroups::load_midi().  If the section has a
+ *  length, as it does in the new format, the decoding is put off until the
+ *  mute-groups are first used; see mutegroups::defer_midi().  Otherwise the
+ *  groups are decoded now, to find the end of the section.
+ */
 
 bool
-midifile::parse_c_mutegroups_legacy
-(
-    performer & p,
-    unsigned groupcount,
-    unsigned groupsize
-)
+midifile::parse_c_mutegroups (performer & p)
 {
-    bool result = true;
     mutegroups & mutes = p.mutes();
-    mutes.legacy_mutes(true);
-    for (unsigned g = 0; g < groupcount; ++g)
+    bool result = mutes.group_load_from_midi();
+    if (result)
+        result = ! mutes.loaded_from_mutes();       /* loaded from config?  */
+
+    if (result)
     {
-        midibooleans mutebits;
-        midilong group = read_long();
-        for (unsigned s = 0; s < groupsize; ++s)
-        {
-            midilong gmutestate = read_long();  /* long bit !?      */
-            bool status = gmutestate != 0;
-            mutebits.push_back(midibool(status));
-        }
-        if (mutes.load(group, mutebits))
+        unsigned groupcount, groupsize;
+        long len = long(read_split_long(groupcount, groupsize));
+        if (len > 0)
         {
-            /*
-             * Related to issue #87.
-             */
-
-            if (mutebits.size() != size_t(p.group_count()))
+            bool legacyformat = len == c_legacy_mute_group;
+            bool sized = m_seqspec_end > m_pos && m_seqspec_end <= m_file_size;
+            if (sized)
             {
-                mutebits = fix_midibooleans
+                const midibyte * first = m_data + m_pos;
+                midibytes raw(first, m_data + m_seqspec_end);
+                mutes.defer_midi
                 (
-                    mutebits, p.group_count()
+                    std::move(raw), groupcount, groupsize, legacyformat
+                );
+                m_pos = m_seqspec_end;
+            }
+            else
+            {
+                m_pos += mutes.load_midi
+                (
+                    m_data + m_pos, m_file_size - m_pos,
+                    groupcount, groupsize, legacyformat
                 );
-                rc().auto_mutes_save(true);
             }
-        }
-        else
-        {
-            result = false;
-            break;                              /* a duplicate?     */
         }
     }
     return result;
@@ -2809,8 +3202,173 @@ midifile::write_track (const midi_vector & lst)
     midilong tracksize = midilong(lst.size());
     write_long(c_mtrk_tag);                 /* magic number 'MTrk'          */
     write_long(tracksize);
-    while (! lst.done())                    /* write the track data         */
-        write_byte(lst.get());
+    m_char_list.insert                      /* write the track data         */
+    (
+        m_char_list.end(), lst.data(), lst.data() + tracksize
+    );
+}
+
+/**
+ *  Makes room in the output buffer for the given filled tracks, plus their
+ *  MTrk headers, so that the buffer does not grow while they are written.
+ *  The SeqSpec track, if any, reserves its own room.
+ */
+
+void
+midifile::reserve_tracks (const std::vector<midi_vector> & tracks)
+{
+    size_t total = m_char_list.size();
+    for (const auto & lst : tracks)
+        total += 8 + lst.size();            /* 'MTrk', length, and data     */
+
+    m_char_list.reserve(total);
+}
+
+/**
+ *  Fills the tracks of a song export.  Each track unrolls only its own
+ *  pattern's triggers and events; see fill_tracks().  The caller holds
+ *  m_mutex, and the performer is not changed while exporting.
+ *
+ * \param tracks
+ *      The containers to fill, one for each exportable pattern.
+ *
+ * \param numbers
+ *      The track number of each container.
+ *
+ * \return
+ *      Returns true if every track was filled.
+ */
+
+bool
+midifile::fill_song_tracks
+(
+    std::vector<midi_vector> & tracks,
+    const std::vector<int> & numbers
+)
+{
+    return fill_tracks
+    (
+        tracks.size(),
+        [&tracks, &numbers] (size_t t)
+        {
+            return tracks[t].song_fill_track(numbers[t]);
+        }
+    );
+}
+
+/**
+ *  Fills the tracks of a normal save.  Each track encodes only its own
+ *  pattern; see fill_tracks().  The caller holds m_mutex.
+ *
+ * \param tracks
+ *      The containers to fill, one for each active pattern.
+ *
+ * \param numbers
+ *      The track number of each container.
+ *
+ * \param p
+ *      The performer, passed along to midi_vector_base::fill().
+ *
+ * \param doseqspec
+ *      If true, the SeqSpec data of each pattern is added to its track.
+ */
+
+void
+midifile::fill_seq_tracks
+(
+    std::vector<midi_vector> & tracks,
+    const std::vector<int> & numbers,
+    const performer & p, bool doseqspec
+)
+{
+    (void) fill_tracks
+    (
+        tracks.size(),
+        [&tracks, &numbers, &p, doseqspec] (size_t t)
+        {
+            tracks[t].fill(numbers[t], p, doseqspec);
+            return true;
+        }
+    );
+}
+
+/**
+ *  Fills a number of independent tracks.  Only the order of the tracks in
+ *  the file matters, not the order of filling, so when there are enough of
+ *  them, they are filled across several threads by parallel_for(), as in
+ *  parse_tracks_parallel().  Each track is filled into its own container,
+ *  so nothing is shared.
+ *
+ * \param count
+ *      The number of tracks.
+ *
+ * \param fillone
+ *      Fills the given track, returning false if it failed.
+ *
+ * \return
+ *      Returns true if every track was filled.
+ */
+
+bool
+midifile::fill_tracks
+(
+    size_t count,
+    const std::function<bool (size_t)> & fillone
+)
+{
+    std::vector<char> filled(count, 0);             /* not vector<bool>     */
+    size_t workers = 1;
+    if (int(count) >= c_parallel_tracks_min)
+        workers = parallel_cores();
+
+    parallel_for
+    (
+        count, [&filled, &fillone] (size_t t)
+        {
+            filled[t] = fillone(t) ? 1 : 0 ;
+        },
+        workers
+    );
+
+    return std::find(filled.begin(), filled.end(), 0) == filled.end();
+}
+
+/**
+ *  Writes the whole output buffer to the file, in one call, then clears the
+ *  buffer.
+ *
+ * \param failmsg
+ *      The error message to use if the file cannot be opened.
+ *
+ * \return
+ *      Returns true if the file was written.
+ */
+
+bool
+midifile::write_buffer (const std::string & failmsg)
+{
+    bool result = false;
+    std::ofstream file
+    (
+        m_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc
+    );
+    if (file.is_open())
+    {
+        file.write
+        (
+            reinterpret_cast<const char *>(m_char_list.data()),
+            std::streamsize(m_char_list.size())
+        );
+        file.close();
+        result = ! file.fail();
+        if (! result)
+            m_error_message = "Error writing MIDI file.";
+    }
+    else
+        m_error_message = failmsg;
+
+    m_char_list.clear();
+    return result;
 }
 
 /**
@@ -2844,6 +3402,40 @@ midifile::prop_item_size (long data_length) const
 /**
  *  Write the whole MIDI data and Seq24 information out to the file.
  *  Also see the write_song() function, for exporting to standard MIDI.
+ *  This is encode() followed by write_encoded().
+ *
+ * \param p
+ *      Provides the object that will contain and manage the entire
+ *      performance.
+ *
+ * \param doseqspec
+ *      If true (the default, then the Seq66-specific SeqSpec sections
+ *      are written to the file.
+ *
+ * \return
+ *      Returns true if the write operations succeeded.  If false is returned,
+ *      then m_error_message will contain a description of the error.
+ */
+
+bool
+midifile::write (performer & p, bool doseqspec)
+{
+    bool result = encode(p, doseqspec);
+    if (result)
+        result = write_encoded();
+
+    if (result)
+        p.unmodify();               /* it worked, tell performer about it   */
+
+    return result;
+}
+
+/**
+ *  Converts the whole MIDI data and Seq24 information to the bytes of the
+ *  file, in the output buffer, without writing anything to disk.  The
+ *  result is a snapshot of the performance; the performer can change, or be
+ *  saved again, while write_encoded() writes the buffer, even from another
+ *  thread.
  *
  *  Seq66 sometimes reverses the order of some events, due to popping
  *  from its container.  Not an issue, but can make a file slightly different
@@ -2859,16 +3451,14 @@ midifile::prop_item_size (long data_length) const
  *      basic MIDI sequence (which is not the same as exporting a Song, with
  *      triggers, as a MIDI sequence).
  *
- * \param smfformat
- *      Defaults to 1.  Can be set to 0 for writing an SMF 0 file.
- *
  * \return
- *      Returns true if the write operations succeeded.  If false is returned,
- *      then m_error_message will contain a description of the error.
+ *      Returns true if the data was encoded.  If false is returned, then
+ *      m_error_message will contain a description of the error, and the
+ *      buffer is empty.
  */
 
 bool
-midifile::write (performer & p, bool doseqspec)
+midifile::encode (performer & p, bool doseqspec)
 {
     automutex locker(m_mutex);
     bool result = usr().is_ppqn_valid(m_ppqn);
@@ -2913,12 +3503,20 @@ midifile::write (performer & p, bool doseqspec)
     }
 
     /*
-     * Write out the active tracks.
-     * Note that we don't need to check the sequence pointer.
+     * Write out the active tracks.  They are all filled first, each into its
+     * own container and in parallel if there are enough of them, so that
+     * the output buffer can be sized once.  Then they are appended in
+     * order.  Note that we don't need to check the sequence pointer.
+     *
+     * midi_vector_base::fill() also handles the time-signature and tempo
+     * meta events, if they are not part of the file's MIDI data.
      */
 
     if (result)
     {
+        std::vector<midi_vector> tracks;
+        std::vector<int> numbers;
+        tracks.reserve(size_t(p.sequence_high()));
         for (int track = 0; track < p.sequence_high(); ++track)
         {
             if (p.is_seq_active(track))
@@ -2926,22 +3524,18 @@ midifile::write (performer & p, bool doseqspec)
                 seq::pointer s = p.get_sequence(track);
                 if (s)
                 {
-                    sequence & seq = *s;
-                    midi_vector lst(seq);
-
-                    /*
-                     * midi_vector_base::fill() also handles the time-signature
-                     * and tempo meta events, if they are not part of the
-                     * file's MIDI data.  All the events are put into the
-                     * container, and then the container's bytes are written
-                     * out below.
-                     */
-
-                    lst.fill(track, p, doseqspec);
-                    write_track(lst);
+                    tracks.emplace_back(*s);
+                    numbers.push_back(track);
                 }
             }
         }
+        fill_seq_tracks(tracks, numbers, p, doseqspec);
+        reserve_tracks(tracks);
+        for (auto & lst : tracks)
+        {
+            write_track(lst);
+            lst.release();                          /* free it as we go     */
+        }
     }
     if (result && doseqspec)
     {
@@ -2949,36 +3543,31 @@ midifile::write (performer & p, bool doseqspec)
         if (! result)
             m_error_message = "Could not write SeqSpec.";
     }
+    if (! result)
+        m_char_list.clear();
+
+    return result;
+}
+
+/**
+ *  Writes the buffer filled by encode() to the file.  This function does not
+ *  touch the performer or the settings, so that it can be called from a
+ *  background thread; see smanager::save_in_background().
+ *
+ * \return
+ *      Returns true if the file was written.  If false is returned, then
+ *      m_error_message will contain a description of the error.
+ */
+
+bool
+midifile::write_encoded ()
+{
+    automutex locker(m_mutex);
+    bool result = ! m_char_list.empty();
     if (result)
-    {
-        std::ofstream file
-        (
-            m_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc
-        );
-        if (file.is_open())
-        {
-            char file_buffer[c_midi_line_max];      /* enable bufferization */
-            file.rdbuf()->pubsetbuf(file_buffer, sizeof file_buffer);
-            for (auto c : m_char_list)              /* list of midibytes    */
-            {
-                char kc = char(c);
-                file.write(&kc, 1);
-                if (file.fail())
-                {
-                    m_error_message = "Error writing byte.";
-                    result = false;
-                }
-            }
-            m_char_list.clear();
-        }
-        else
-        {
-            m_error_message = "Failed to open MIDI file for writing.";
-            result = false;
-        }
-    }
-    if (result)
-        p.unmodify();               /* it worked, tell performer about it   */
+        result = write_buffer("Failed to open MIDI file for writing.");
+    else
+        m_error_message = "No MIDI data encoded to write.";
 
     return result;
 }
@@ -3095,42 +3684,34 @@ midifile::write_song (performer & p)
          * fill() function for normal Seq66 file writing.
          */
 
+        std::vector<midi_vector> tracks;
+        std::vector<int> numbers;
+        tracks.reserve(size_t(numtracks));
         for (int track = 0; track < p.sequence_high(); ++track)
         {
             if (p.is_exportable(track))
             {
                 seq::pointer s = p.get_sequence(track); /* guaranteed good  */
-                sequence & seq = *s;
-                midi_vector lst(seq);
-                result = lst.song_fill_track(track);    /* standalone fill  */
-                if (result)
-                    write_track(lst);
+                tracks.emplace_back(*s);
+                numbers.push_back(track);
             }
         }
-    }
-    if (result)
-    {
-        std::ofstream file
-        (
-            m_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc
-        );
-        if (file.is_open())
+        result = fill_song_tracks(tracks, numbers);
+        if (result)
         {
-            char file_buffer[c_midi_line_max];      /* enable bufferization */
-            file.rdbuf()->pubsetbuf(file_buffer, sizeof file_buffer);
-            for (auto c : m_char_list)
+            reserve_tracks(tracks);
+            for (auto & lst : tracks)
             {
-                char kc = char(c);
-                file.write(&kc, 1);
+                write_track(lst);
+                lst.release();                      /* free it as we go     */
             }
-            m_char_list.clear();
-        }
-        else
-        {
-            m_error_message = "Failed to open MIDI file for export.";
-            result = false;
         }
     }
+    if (result)
+        result = write_buffer("Failed to open MIDI file for export.");
+    else
+        m_char_list.clear();
+
     return result;
 }
 
@@ -3220,6 +3801,7 @@ midifile::write_seqspec_track (performer & p)
         tracklength += prop_item_size(4);       /* c_tempo_track            */
     }
     tracklength += track_end_size();            /* Meta TrkEnd              */
+    m_char_list.reserve(m_char_list.size() + 8 + size_t(tracklength));
     write_long(c_prop_chunk_tag);               /* "MTrk" or something else */
     write_long(tracklength);
     write_seq_number(c_prop_seq_number);        /* bogus sequence number    */
@@ -3556,6 +4138,13 @@ midifile::set_error_dump (const std::string & msg, unsigned long value)
  * \param [out] errmsg
  *      If the function fails, this string is filled with the error message.
  *
+ * \param addtorecent
+ *      If true (the default), the file is added to the recent-files list.
+ *
+ * \param wrktracks
+ *      If not empty, only these tracks of a WRK file are imported; see
+ *      wrkfile::select_tracks().  Ignored for a MIDI file.
+ *
  * \return
  *      Returns true if reading the MIDI/WRK file succeeded. As a side-effect,
  *      the usrsettings::file_ppqn() is set to return the final PPQN to be
@@ -3569,7 +4158,8 @@ read_midi_file
     const std::string & fn,
     int ppqn,                                   /* might get altered        */
     std::string & errmsg,
-    bool addtorecent
+    bool addtorecent,
+    const std::vector<int> & wrktracks
 )
 {
     bool result = file_readable(fn);            /* how to disable Save?     */
@@ -3581,9 +4171,17 @@ read_midi_file
 
         ppqn = choose_ppqn(ppqn);               /* no usr().file_ppqn() yet */
 
-        midifile * fp = is_wrk ?
-            new (std::nothrow) wrkfile(fn, ppqn) :
-            new (std::nothrow) midifile(fn, ppqn) ;
+        midifile * fp = nullptr;
+        if (is_wrk)
+        {
+            wrkfile * wp = new (std::nothrow) wrkfile(fn, ppqn);
+            if (not_nullptr(wp))
+                wp->select_tracks(wrktracks);
+
+            fp = wp;
+        }
+        else
+            fp = new (std::nothrow) midifile(fn, ppqn);
 
         std::unique_ptr<midifile> f(fp);
         p.clear_all();                          /* see banner notes         */
@@ -3613,6 +4211,16 @@ read_midi_file
             file_message("Read", fn);
             if (! f->error_message().empty())   /* actually a warning here  */
                 errmsg = f->error_message();
+
+            if (! is_wrk && midijournal::pending(fn))   /* lost in a crash  */
+            {
+                std::string jname = midijournal::journal_name(fn);
+                midijournal j(fn, p.ppqn());
+                if (j.replay(p))
+                    file_message("Replayed journal", jname);
+                else
+                    file_error("Journal replay failed", jname);
+            }
         }
         else
         {
@@ -3634,6 +4242,118 @@ read_midi_file
     return result;
 }
 
+/**
+ *  Imports several MIDI files, each into its own screen-set.  The files are
+ *  read at once, across up to one thread per core, by
+ *  midifile::parse_detached(), which does not touch the performer.  Then
+ *  the patterns of all of them are installed by
+ *  performer::install_sequences() as one change, so that the play-set is
+ *  refilled, and the user interface is told, only once.  WRK files cannot
+ *  be read detached, and so are imported afterward, one at a time, as by
+ *  the single-file import.
+ *
+ * \param p
+ *      The performer to import into.  Call this function from the thread
+ *      that owns the patterns, normally the GUI thread.
+ *
+ * \param files
+ *      The full paths of the files.  The first goes into the set firstset,
+ *      the next into the one after, and so on.  The files for which there
+ *      is no set are not read.
+ *
+ * \param firstset
+ *      The set for the first file.
+ *
+ * \param [out] errmsg
+ *      Collects the error messages of the files that could not be read.
+ *
+ * \return
+ *      Returns the number of files imported.
+ */
+
+int
+import_midi_files
+(
+    performer & p,
+    const std::vector<std::string> & files,
+    int firstset,
+    std::string & errmsg
+)
+{
+    struct job
+    {
+        std::unique_ptr<midifile> f;
+        std::string name;
+        int setno = 0;
+        bool is_wrk = false;
+        bool ok = false;
+    };
+
+    int setmax = p.screenset_max();
+    std::vector<job> jobs;
+    for (const auto & fn : files)
+    {
+        int setno = firstset + int(jobs.size());
+        if (setno >= setmax)
+            break;
+
+        job j;
+        j.name = fn;
+        j.setno = setno;
+        j.is_wrk = file_extension_match(fn, "wrk");
+        if (! j.is_wrk)
+            j.f.reset(new (std::nothrow) midifile(fn, p.ppqn()));
+
+        if (j.is_wrk || j.f)
+            jobs.push_back(std::move(j));
+    }
+
+    parallel_for
+    (
+        jobs.size(), [&jobs, &p] (size_t i)
+        {
+            if (! jobs[i].is_wrk)
+                jobs[i].ok = jobs[i].f->parse_detached(p);
+        }
+    );
+
+    int result = 0;
+    std::vector<sequence *> seqs;
+    for (auto & j : jobs)
+    {
+        if (j.ok)
+        {
+            j.f->move_detached(j.setno * p.screenset_size(), seqs);
+            ++result;
+        }
+    }
+    (void) p.install_sequences(seqs);
+    for (auto & j : jobs)
+    {
+        std::string error;
+        if (j.is_wrk)
+        {
+            wrkfile w(j.name, p.ppqn());
+            j.ok = w.parse(p, j.setno, true);
+            if (j.ok)
+                ++result;
+            else
+                error = w.error_message();
+        }
+        else if (! j.ok)
+            error = j.f->error_message();
+
+        if (! j.ok)
+        {
+            if (! errmsg.empty())
+                errmsg += "\n";
+
+            errmsg += j.name + ": " + error;
+        }
+    }
+    return result;
+}
+
 bool
 write_midi_file
 (
@@ -3655,6 +4375,11 @@ write_midi_file
         result = f.write(p);
         if (result)
         {
+            std::string oldname = rc().midi_filename();
+            if (oldname != fname)
+                (void) midijournal::discard(oldname);   /* a "Save As"      */
+
+            (void) midijournal::discard(fname);         /* all edits saved  */
             rc().midi_filename(fname);
             rc().last_used_dir(fname.substr(0, fname.rfind("/") + 1));
             rc().add_recent_file(fname);            /* rc().midi_filename() */
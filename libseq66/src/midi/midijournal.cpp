@@ -0,0 +1,567 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midijournal.cpp
+ *
+ *  This module defines the edit journal of a song.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The journal is written by the thread that owns the performer (the
+ *  session manager's loop or timer), like a save.  Each write is appended
+ *  and flushed at once, so a crash of the application loses at most the
+ *  edits since the last write.  A compaction writes a new file and renames
+ *  it over the journal, so that there is always a whole journal on disk.
+ */
+
+#include <cstdio>                       /* std::rename()                    */
+#include <fstream>                      /* std::ofstream                    */
+
+#include "cfg/settings.hpp"             /* seq66::rc()                      */
+#include "midi/midi_vector.hpp"         /* seq66::midi_vector container     */
+#include "midi/midijournal.hpp"         /* seq66::midijournal class         */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "util/basic_macros.hpp"        /* is_nullptr(), not_nullptr()      */
+#include "util/filefunctions.hpp"       /* seq66::file_size(), etc.         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The chunk tags of the journal.  See the banner of midijournal.hpp.
+ */
+
+static const miditag c_journal_tag  = 0x4D4A6E6C;      /* 'MJnl' header    */
+static const miditag c_jsmf_tag     = 0x4A536D66;      /* 'JSmf' image     */
+static const miditag c_jtrk_tag     = 0x4A54726B;      /* 'JTrk' pattern   */
+static const miditag c_jdel_tag     = 0x4A44656C;      /* 'JDel' deletion  */
+static const miditag c_jssp_tag     = 0x4A537370;      /* 'JSsp' SeqSpec   */
+static const miditag c_mtrk_tag     = 0x4D54726B;      /* 'MTrk' track     */
+
+/**
+ *  The version of the journal format, and the length of the data of the
+ *  header chunk: the version, the PPQN, and the SMF format, as shorts.
+ */
+
+static const midishort c_journal_version = 1;
+static const midilong c_journal_header_length = 6;
+
+/**
+ *  The size of a journal holding no records.
+ */
+
+static const size_t c_journal_header_size = 8 + c_journal_header_length;
+
+/**
+ *  Principal constructor.
+ *
+ * \param songname
+ *      The full path to the song file.
+ *
+ * \param ppqn
+ *      The PPQN of the performer.
+ */
+
+midijournal::midijournal (const std::string & songname, int ppqn) :
+    midifile        (journal_name(songname), ppqn),
+    m_song_name     (songname),
+    m_journal_name  (journal_name(songname)),
+    m_stamps        (),
+    m_seqspec       (),
+    m_journal_size  (file_size(m_journal_name))
+{
+    // no code
+}
+
+midijournal::~midijournal ()
+{
+    // no code
+}
+
+/**
+ *  The name of the journal of a song: the name of the song file plus
+ *  ".journal".
+ */
+
+std::string
+midijournal::journal_name (const std::string & songname)
+{
+    return songname + ".journal";
+}
+
+/**
+ *  True if the song has a journal holding records, which means that the
+ *  application did not exit normally after the song was last edited.
+ */
+
+bool
+midijournal::pending (const std::string & songname)
+{
+    return ! songname.empty() &&
+        file_size(journal_name(songname)) > c_journal_header_size;
+}
+
+/**
+ *  Removes the journal of a song, once the song has been saved, or the
+ *  application exits normally.
+ *
+ * \return
+ *      Returns true if there was no journal, or it was removed.
+ */
+
+bool
+midijournal::discard (const std::string & songname)
+{
+    bool result = true;
+    if (! songname.empty())
+    {
+        std::string jname = journal_name(songname);
+        if (file_exists(jname))
+            result = file_delete(jname);
+    }
+    return result;
+}
+
+/**
+ *  Gets the edit stamp of each pattern, and the bytes of the SeqSpec
+ *  track.  The stamps are read before anything is encoded, so that a
+ *  pattern changed while being encoded is journaled again later.
+ */
+
+void
+midijournal::current_state
+(
+    performer & p,
+    std::map<int, unsigned> & stamps,
+    std::vector<midibyte> & seqspec
+)
+{
+    stamps.clear();
+    for (int track = 0; track < p.sequence_high(); ++track)
+    {
+        if (p.is_seq_active(track))
+        {
+            seq::pointer s = p.get_sequence(track);
+            if (s)
+                stamps[track] = s->edit_stamp();
+        }
+    }
+    char_list().clear();
+    (void) write_seqspec_track(p);
+    seqspec = char_list();
+    char_list().clear();
+}
+
+/**
+ *  Takes the current state of the song as the journaled state, without
+ *  writing anything.  Called when the song has just been read or saved.
+ */
+
+void
+midijournal::start (performer & p)
+{
+    current_state(p, m_stamps, m_seqspec);
+}
+
+/**
+ *  Starts a record in the output buffer, with a length to be filled in by
+ *  end_record().
+ *
+ * \return
+ *      Returns the offset of the record in the buffer.
+ */
+
+size_t
+midijournal::begin_record (miditag tag)
+{
+    size_t result = char_list().size();
+    write_long(tag);
+    write_long(0);
+    return result;
+}
+
+void
+midijournal::end_record (size_t start)
+{
+    std::vector<midibyte> & buffer = char_list();
+    midilong len = midilong(buffer.size() - start - 8);
+    buffer[start + 4] = midibyte((len >> 24) & 0xFF);
+    buffer[start + 5] = midibyte((len >> 16) & 0xFF);
+    buffer[start + 6] = midibyte((len >> 8) & 0xFF);
+    buffer[start + 7] = midibyte(len & 0xFF);
+}
+
+void
+midijournal::write_journal_header (performer & p)
+{
+    write_long(c_journal_tag);
+    write_long(c_journal_header_length);
+    write_short(c_journal_version);
+    write_short(midishort(p.ppqn()));
+    write_short(midishort(p.smf_format()));
+}
+
+/**
+ *  Writes a JTrk record, holding the pattern as it would be saved.
+ */
+
+bool
+midijournal::write_track_record (performer & p, int track)
+{
+    seq::pointer s = p.get_sequence(track);
+    bool result = bool(s);
+    if (result)
+    {
+        size_t r = begin_record(c_jtrk_tag);
+        midi_vector lst(*s);
+        write_short(midishort(track));
+        lst.fill(track, p, true);
+        write_track(lst);
+        end_record(r);
+    }
+    return result;
+}
+
+/**
+ *  Appends the buffer to the journal file, and flushes it.
+ */
+
+bool
+midijournal::append_buffer ()
+{
+    bool result = false;
+    std::ofstream file
+    (
+        m_journal_name.c_str(), std::ios::out | std::ios::binary | std::ios::app
+    );
+    if (file.is_open())
+    {
+        const std::vector<midibyte> & buffer = char_list();
+        file.write
+        (
+            reinterpret_cast<const char *>(buffer.data()),
+            std::streamsize(buffer.size())
+        );
+        file.close();
+        result = ! file.fail();
+        if (result)
+            m_journal_size += buffer.size();
+    }
+    char_list().clear();
+    return result;
+}
+
+/**
+ *  Logs the patterns changed since the last write: a JTrk record for each
+ *  new or changed pattern, a JDel record for each deleted one, and a JSsp
+ *  record if the SeqSpec track changed.  If nothing changed, nothing is
+ *  written.  If the journal is missing (it was discarded by a save), it is
+ *  begun again with a header.
+ *
+ * \return
+ *      Returns true if the journal is up to date.
+ */
+
+bool
+midijournal::append (performer & p)
+{
+    std::map<int, unsigned> stamps;
+    std::vector<midibyte> seqspec;
+    current_state(p, stamps, seqspec);
+
+    bool fresh = file_size(m_journal_name) == 0;
+    if (fresh)
+    {
+        m_journal_size = 0;
+        write_journal_header(p);
+    }
+
+    size_t headed = char_list().size();
+    for (const auto & st : stamps)
+    {
+        auto old = m_stamps.find(st.first);
+        if (old == m_stamps.end() || old->second != st.second)
+            (void) write_track_record(p, st.first);
+    }
+    for (const auto & st : m_stamps)
+    {
+        if (stamps.find(st.first) == stamps.end())
+        {
+            size_t r = begin_record(c_jdel_tag);
+            write_short(midishort(st.first));
+            end_record(r);
+        }
+    }
+    if (seqspec != m_seqspec)
+    {
+        size_t r = begin_record(c_jssp_tag);
+        char_list().insert(char_list().end(), seqspec.begin(), seqspec.end());
+        end_record(r);
+    }
+
+    bool result = true;
+    if (char_list().size() > headed)
+    {
+        result = append_buffer();
+        if (result)
+        {
+            m_stamps.swap(stamps);
+            m_seqspec.swap(seqspec);
+        }
+    }
+    else
+        char_list().clear();
+
+    return result;
+}
+
+/**
+ *  Writes the buffer to a new file, and renames it over the journal.
+ */
+
+bool
+midijournal::replace_journal ()
+{
+    std::string tmpname = m_journal_name + ".tmp";
+    bool result = false;
+    {
+        std::ofstream file
+        (
+            tmpname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc
+        );
+        if (file.is_open())
+        {
+            const std::vector<midibyte> & buffer = char_list();
+            file.write
+            (
+                reinterpret_cast<const char *>(buffer.data()),
+                std::streamsize(buffer.size())
+            );
+            file.close();
+            result = ! file.fail();
+        }
+    }
+    if (result)
+        result = std::rename(tmpname.c_str(), m_journal_name.c_str()) == 0;
+
+    if (result)
+        m_journal_size = char_list().size();
+    else
+        (void) file_delete(tmpname);
+
+    char_list().clear();
+    return result;
+}
+
+/**
+ *  Rewrites the journal as a header and one JSmf image of the whole song,
+ *  which replaces the records.  This costs as much as a save, so it is done
+ *  only when the journal has grown large.
+ *
+ * \return
+ *      Returns true if the journal was rewritten.  If false, the old
+ *      journal is left as it was.
+ */
+
+bool
+midijournal::compact (performer & p)
+{
+    std::map<int, unsigned> stamps;
+    std::vector<midibyte> seqspec;
+    current_state(p, stamps, seqspec);
+    write_journal_header(p);
+
+    size_t r = begin_record(c_jsmf_tag);
+    bool result = encode(p, true);
+    if (result)
+    {
+        end_record(r);
+        result = replace_journal();
+        if (result)
+        {
+            m_stamps.swap(stamps);
+            m_seqspec.swap(seqspec);
+        }
+    }
+    else
+        char_list().clear();
+
+    return result;
+}
+
+/**
+ *  Sets up the scaling of the ticks of the records, which were written at
+ *  the PPQN given in the journal header, in the manner of parse_smf_1().
+ */
+
+void
+midijournal::journal_timing (int journalppqn)
+{
+    file_ppqn(journalppqn);
+    scaled(journalppqn != ppqn());
+    if (scaled())
+        ppqn_ratio(double(ppqn()) / double(journalppqn));
+}
+
+/**
+ *  Replays a JTrk record: the pattern is decoded, and replaces the pattern
+ *  of the same number, if any.
+ */
+
+void
+midijournal::replay_track (performer & p, size_t end)
+{
+    midishort trk = read_short();
+    size_t chunk = pos();
+    midilong ID = read_long();
+    (void) read_long();                             /* the MTrk length      */
+    if (ID == c_mtrk_tag)
+    {
+        sequence * sp = create_sequence(p);
+        if (not_nullptr(sp))
+        {
+            size_t limit = data_size();
+            midishort seqnum;
+            sp->seq_number(int(trk));               /* tentative number     */
+            data_size(end);
+            trackstatus ts = parse_track(p, *sp, trk, chunk, false, seqnum);
+            data_size(limit);
+            if (ts == trackstatus::ok)
+            {
+                if (p.is_seq_active(int(seqnum)))
+                    (void) p.remove_sequence(int(seqnum));
+
+                install_track(p, sp, seqnum, 0, false);
+            }
+            else
+                delete sp;
+        }
+    }
+}
+
+/**
+ *  Replays a JSmf record: the song is cleared, and read from the image.
+ */
+
+bool
+midijournal::replay_image (performer & p, size_t end)
+{
+    size_t limit = data_size();
+    data_size(end);
+    (void) p.clear_all();
+    bool result = parse_data(p, 0, false);
+    data_size(limit);
+    return result;
+}
+
+/**
+ *  Applies the journal to the song just read from the song file.  A record
+ *  cut short, as by a crash during the write, ends the replay without an
+ *  error.
+ *
+ * \return
+ *      Returns true if the journal was read.
+ */
+
+bool
+midijournal::replay (performer & p)
+{
+    bool result = grab_input_stream(std::string("journal"));
+    if (result)
+    {
+        int journalppqn = 0;
+        midilong ID = read_long();
+        midilong len = read_long();
+        result = ID == c_journal_tag && len >= c_journal_header_length;
+        if (result)
+        {
+            midishort version = read_short();
+            journalppqn = int(read_short());
+            (void) read_short();                    /* the SMF format       */
+            skip(size_t(len - c_journal_header_length));
+            result = version <= c_journal_version && journalppqn > 0;
+            if (result)
+                journal_timing(journalppqn);
+            else
+                result = set_error("Unsupported journal version or PPQN.");
+        }
+        else
+            result = set_error("Not a Seq66 journal.");
+
+        int records = 0;
+        while (result && pos() + 8 <= data_size())
+        {
+            miditag tag = read_long();
+            size_t end = pos() + size_t(read_long());
+            if (end > data_size())
+            {
+                file_error("Partial record ignored", m_journal_name);
+                break;
+            }
+            switch (tag)
+            {
+            case c_jsmf_tag:
+                result = replay_image(p, end);
+                journal_timing(journalppqn);        /* image changed it     */
+                break;
+
+            case c_jtrk_tag:
+                replay_track(p, end);
+                break;
+
+            case c_jdel_tag:
+            {
+                int trk = int(read_short());
+                if (p.is_seq_active(trk))
+                    (void) p.remove_sequence(trk);
+                break;
+            }
+
+            case c_jssp_tag:
+                result = parse_seqspec_track(p, int(end));
+                break;
+
+            default:
+                break;                              /* a later record type  */
+            }
+            ++records;
+            (void) read_seek(end);
+        }
+        if (records > 0)
+            p.modify();                             /* the song is unsaved  */
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * midijournal.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
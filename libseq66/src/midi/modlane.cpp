@@ -0,0 +1,183 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          modlane.cpp
+ *
+ *  This module defines a modulation lane, generated at play time.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The values follow the formula of sequence::change_event_data_lfo(), so
+ *  that a lane sounds like the LFO window applied to a control event at
+ *  every step.
+ */
+
+#include "midi/modlane.hpp"             /* seq66::modlane class             */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The largest pitch-bend value, 14 bits.
+ */
+
+static const int c_pitchbend_max = 16383;
+
+/**
+ *  Creates an invalid lane, for reading into.
+ */
+
+modlane::modlane () :
+    m_status    (0),
+    m_cc        (0),
+    m_wave      (waveform::none),
+    m_steps     (c_steps_default),
+    m_dcoffset  (64.0),
+    m_range     (64.0),
+    m_speed     (1.0),
+    m_phase     (0.0)
+{
+    // no code
+}
+
+/**
+ *  Creates a lane from the settings of the LFO window.
+ *
+ * \param status
+ *      The Control Change or Pitch Wheel status, including the channel.
+ *
+ * \param cc
+ *      The controller number, ignored for pitch-bend.
+ *
+ * \param steps
+ *      The number of values per quarter note, at least 1.
+ */
+
+modlane::modlane
+(
+    midibyte status, midibyte cc, waveform w,
+    double dcoffset, double range, double speed, double phase,
+    int steps
+) :
+    m_status    (status),
+    m_cc        (cc),
+    m_wave      (w),
+    m_steps     (steps > 0 ? steps : 1),
+    m_dcoffset  (dcoffset),
+    m_range     (range),
+    m_speed     (speed),
+    m_phase     (phase)
+{
+    // no code
+}
+
+/**
+ *  A lane needs a wave and a control or pitch-bend status.
+ */
+
+bool
+modlane::valid () const
+{
+    bool result = m_wave != waveform::none && m_wave != waveform::max;
+    if (result)
+        result = event::is_controller_msg(m_status) || is_pitchbend();
+
+    return result;
+}
+
+/**
+ *  The ticks between two values; never less than 1.
+ */
+
+midipulse
+modlane::step_length (int ppqn) const
+{
+    midipulse result = midipulse(ppqn / m_steps);
+    return result > 0 ? result : 1 ;
+}
+
+/**
+ *  Gets the value at a tick of the pattern.
+ *
+ * \param local
+ *      The tick, from 0 to the length of the pattern.
+ *
+ * \param length
+ *      The length of the pattern, over which the lane repeats speed times.
+ *
+ * \return
+ *      Returns 0 to 127 for a control, or 0 to 16383 for pitch-bend.
+ */
+
+int
+modlane::value (midipulse local, midipulse length) const
+{
+    double angle = m_speed * double(local) / double(length) + m_phase;
+    double v = m_range * wave_func(angle, m_wave) + m_dcoffset;
+    int result;
+    if (is_pitchbend())
+    {
+        result = int(v * 128.0);
+        if (result < 0)
+            result = -result;
+
+        if (result > c_pitchbend_max)
+            result = c_pitchbend_max;
+    }
+    else
+        result = int(abs_midibyte_value(int(v)));   /* as the LFO window    */
+
+    return result;
+}
+
+/**
+ *  Gets the data bytes of the message for a value.
+ */
+
+void
+modlane::data (int value, midibyte & d0, midibyte & d1) const
+{
+    if (is_pitchbend())
+    {
+        d0 = midibyte(value & 0x7F);                /* least significant    */
+        d1 = midibyte((value >> 7) & 0x7F);         /* most significant     */
+    }
+    else
+    {
+        d0 = m_cc;
+        d1 = midibyte(value);
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * modlane.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,299 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          notespans.cpp
+ *
+ *  This module defines the index of the notes of an event list.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The events are already sorted by timestamp when verify_and_link() is
+ *  done, so the spans come out sorted by start, and building the index is
+ *  one pass over the events plus one over the tree.  The notegrid adds the
+ *  end of each wrapped note as a second span, which is out of order, and
+ *  so it sorts a row only if needed.
+ */
+
+#include <algorithm>                    /* std::upper_bound(), std::sort()  */
+
+#include "midi/notespans.hpp"           /* seq66::notespans class           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Creates an empty, invalid index.
+ */
+
+notespans::notespans () :
+    m_spans         (),
+    m_max_ends      (),
+    m_event_count   (0),
+    m_valid         (false),
+    m_wrapped       (false)
+{
+    // no code
+}
+
+/**
+ *  Makes the spans of the linked notes, then the tree over them.
+ *
+ * \param evlist
+ *      The events, which must be sorted and linked.
+ */
+
+void
+notespans::build (const event::buffer & evlist)
+{
+    clear();
+    for (std::size_t i = 0; i < evlist.size(); ++i)
+    {
+        const event & ev = evlist[i];
+        if (ev.is_note_on_linked())
+        {
+            midipulse on = ev.timestamp();
+            midipulse off = evlist[std::size_t(ev.link())].timestamp();
+            if (off < on)
+            {
+                off = c_midipulse_max;          /* wraps around the end     */
+                m_wrapped = true;
+            }
+
+            add(on, off, i);
+        }
+    }
+    finish(evlist.size());
+}
+
+void
+notespans::clear ()
+{
+    m_spans.clear();
+    m_max_ends.clear();
+    m_valid = false;
+    m_wrapped = false;
+}
+
+void
+notespans::add (midipulse start, midipulse end, std::size_t slot)
+{
+    span s;
+    s.ns_start = start;
+    s.ns_end = end;
+    s.ns_slot = slot;
+    m_spans.push_back(s);
+}
+
+/**
+ *  Sorts the spans, if not already sorted, and builds the tree over them.
+ *
+ * \param eventcount
+ *      The size of the event buffer indexed.
+ */
+
+void
+notespans::finish (std::size_t eventcount)
+{
+    auto bystart = [] (const span & a, const span & b)
+    {
+        return a.ns_start < b.ns_start;
+    };
+    if (! std::is_sorted(m_spans.begin(), m_spans.end(), bystart))
+        std::sort(m_spans.begin(), m_spans.end(), bystart);
+
+    m_max_ends.assign(4 * m_spans.size() + 1, 0);
+    if (! m_spans.empty())
+        (void) fill(1, 0, m_spans.size());
+
+    m_event_count = eventcount;
+    m_valid = true;
+}
+
+/**
+ *  Sets the latest end of each node of the tree, from the bottom up.
+ *
+ * \return
+ *      Returns the latest end of the spans from lo up to hi.
+ */
+
+midipulse
+notespans::fill (std::size_t node, std::size_t lo, std::size_t hi)
+{
+    midipulse result;
+    if (hi - lo == 1)
+    {
+        result = m_spans[lo].ns_end;
+    }
+    else
+    {
+        std::size_t mid = lo + (hi - lo) / 2;
+        result = std::max(fill(2 * node, lo, mid), fill(2 * node + 1, mid, hi));
+    }
+    m_max_ends[node] = result;
+    return result;
+}
+
+/**
+ *  Finds the first span that starts after the tick.  Only the spans before
+ *  it can reach back to the tick.
+ */
+
+std::size_t
+notespans::first_after (midipulse tick) const
+{
+    auto it = std::upper_bound
+    (
+        m_spans.cbegin(), m_spans.cend(), tick,
+        [] (midipulse tk, const span & s)
+        {
+            return tk < s.ns_start;
+        }
+    );
+    return std::size_t(it - m_spans.cbegin());
+}
+
+/**
+ *  Creates an empty, invalid grid.
+ */
+
+notegrid::notegrid () :
+    m_rows          (),
+    m_event_count   (0),
+    m_valid         (false)
+{
+    // no code
+}
+
+/**
+ *  Fills the row of each note event, with spans that make the tests of
+ *  eventlist::select_note_events() a matter of overlapping ticks:
+ *
+ *      -   A linked note is the span from its Note On to its Note Off.
+ *      -   A wrapped note is the span from its Note On onward, plus the
+ *          span up to its Note Off.
+ *      -   An unlinked event, which is selectable 16 ticks before it, is
+ *          the span from it to 16 ticks after.
+ *
+ *  The linked Note Offs are not added; candidates() adds them through the
+ *  link of their Note On.
+ *
+ * \param evlist
+ *      The events, which must be sorted and linked.
+ */
+
+void
+notegrid::build (const event::buffer & evlist)
+{
+    m_rows.resize(std::size_t(c_notes_count));
+    for (auto & row : m_rows)
+        row.clear();
+
+    for (std::size_t i = 0; i < evlist.size(); ++i)
+    {
+        const event & ev = evlist[i];
+        int n = int(ev.get_note());
+        if (! ev.is_note() || n >= c_notes_count)
+            continue;
+
+        notespans & row = m_rows[std::size_t(n)];
+        if (ev.is_linked())
+        {
+            if (ev.is_note_on())
+            {
+                midipulse on = ev.timestamp();
+                midipulse off = evlist[std::size_t(ev.link())].timestamp();
+                if (off < on)
+                {
+                    row.add(on, c_midipulse_max, i);
+                    row.add(-c_midipulse_max, off, i);
+                }
+                else
+                    row.add(on, off, i);
+            }
+        }
+        else
+        {
+            midipulse t = ev.timestamp();
+            row.add(t, t + 16, i);
+        }
+    }
+    for (auto & row : m_rows)
+        row.finish(evlist.size());
+
+    m_event_count = evlist.size();
+    m_valid = true;
+}
+
+/**
+ *  Gets the slots of the note events that might be in the rectangle.  The
+ *  caller still applies its own tests to each.
+ *
+ * \param evlist
+ *      The events indexed, used to get the Note Off of each linked note.
+ *
+ * \param slots
+ *      Gets the slots found, sorted and without repeats, so that they can
+ *      be visited in the same order as the events are.
+ */
+
+void
+notegrid::candidates
+(
+    const event::buffer & evlist,
+    midipulse tick_s, int note_h, midipulse tick_f, int note_l,
+    std::vector<std::size_t> & slots
+) const
+{
+    slots.clear();
+    if (note_l < 0)
+        note_l = 0;
+
+    if (note_h >= int(m_rows.size()))
+        note_h = int(m_rows.size()) - 1;
+
+    auto take = [&evlist, &slots] (std::size_t slot)
+    {
+        const event & ev = evlist[slot];
+        slots.push_back(slot);
+        if (ev.is_linked())
+            slots.push_back(std::size_t(ev.link()));
+    };
+    for (int n = note_l; n <= note_h; ++n)
+        m_rows[std::size_t(n)].overlapping(tick_s, tick_f, take);
+
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+}
+
+}           // namespace seq66
+
+/*
+ * notespans.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,627 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          outputfilter.cpp
+ *
+ *  This module defines the chain of output filters.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The text form of a filter is a list of stages separated by spaces, each
+ *  a name and a number separated by a colon, such as:
+ *
+ *      transpose:-12 velocity:80 channel:10 thin:2 rate:200 dedup running
+ *
+ *  The dedup and running stages take no number.
+ *
+ *  The thin and rate stages only record a message once it has passed all
+ *  the stages, so that one stage does not count a message that another
+ *  stage drops.
+ */
+
+#include "midi/event.hpp"               /* seq66::event and MIDI statuses   */
+#include "midi/outputfilter.hpp"        /* seq66::outputfilter class        */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "util/strfunctions.hpp"        /* seq66::tokenize()                */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The marker of a lane for which no value has been sent.
+ */
+
+static const int c_no_value = (-1);
+
+/**
+ *  The lanes of the thin, rate, and dedup stages: the controllers of each
+ *  channel, then the polyphonic aftertouch of each note of each channel,
+ *  then a pitch-bend lane, a channel-pressure lane, and a program lane for
+ *  each channel.  The thin and rate stages leave the program lanes alone.
+ */
+
+static const int c_poly_lanes = c_midichannel_max * c_notes_count;
+static const int c_bend_lanes = 2 * c_poly_lanes;
+static const int c_pressure_lanes = c_bend_lanes + c_midichannel_max;
+static const int c_program_lanes = c_pressure_lanes + c_midichannel_max;
+static const int c_lane_count = c_program_lanes + c_midichannel_max;
+
+/**
+ *  The center and top of the pitch bend.
+ */
+
+static const int c_bend_center = 0x2000;
+static const int c_bend_max = 0x3FFF;
+
+/**
+ *  Creates an empty filter, which passes everything.
+ */
+
+outputfilter::outputfilter () :
+    m_steps         (),
+    m_note_table    (),
+    m_last_values   (),
+    m_last_times    (),
+    m_frame_values  (),
+    m_frame_marks   (),
+    m_frame         (0)
+{
+    // no code
+}
+
+/**
+ *  Creates a filter from its text form.  If that is bad, the filter is
+ *  empty.
+ */
+
+outputfilter::outputfilter (const std::string & spec) :
+    m_steps         (),
+    m_note_table    (),
+    m_last_values   (),
+    m_last_times    (),
+    m_frame_values  (),
+    m_frame_marks   (),
+    m_frame         (0)
+{
+    (void) parse(spec);
+}
+
+/**
+ *  Replaces the stages with those of the text form.
+ *
+ * \param spec
+ *      The stages, such as "transpose:-12 velocity:80".
+ *
+ * \return
+ *      Returns false if a stage is unknown or its value is out of range,
+ *      in which case the filter is left empty.
+ */
+
+bool
+outputfilter::parse (const std::string & spec)
+{
+    bool result = true;
+    clear();
+    tokenization tokens = tokenize(spec, " ");
+    for (const auto & t : tokens)
+    {
+        auto colon = t.find(':');
+        std::string name = t.substr(0, colon);
+        int value = colon != std::string::npos ?
+            string_to_int(t.substr(colon + 1)) : 0 ;
+
+        if (name.empty())
+            continue;
+        else if (name == "transpose")
+            result = add(stage::transpose, value);
+        else if (name == "velocity")
+            result = add(stage::velocity, value);
+        else if (name == "channel")
+            result = add(stage::channel, value - 1);
+        else if (name == "thin")
+            result = add(stage::thin, value);
+        else if (name == "rate")
+            result = add(stage::rate, value);
+        else if (name == "dedup")
+            result = add(stage::dedup);
+        else if (name == "running")
+            result = add(stage::running);
+        else
+            result = false;
+
+        if (! result)
+        {
+            clear();
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Makes the text form of the stages, leaving out any notemap stage.
+ */
+
+std::string
+outputfilter::to_string () const
+{
+    std::string result;
+    for (const auto & s : m_steps)
+    {
+        std::string text;
+        switch (s.fs_kind)
+        {
+        case stage::transpose:
+            text = "transpose:" + std::to_string(s.fs_value);
+            break;
+
+        case stage::velocity:
+            text = "velocity:" + std::to_string(s.fs_value);
+            break;
+
+        case stage::channel:
+            text = "channel:" + std::to_string(s.fs_value + 1);
+            break;
+
+        case stage::thin:
+            text = "thin:" + std::to_string(s.fs_value);
+            break;
+
+        case stage::rate:
+            text = "rate:" + std::to_string(s.fs_value);
+            break;
+
+        case stage::dedup:
+            text = "dedup";
+            break;
+
+        case stage::running:
+            text = "running";
+            break;
+
+        case stage::notemap:
+            break;
+        }
+        if (! text.empty())
+        {
+            if (! result.empty())
+                result += " ";
+
+            result += text;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Appends a stage.
+ *
+ * \param kind
+ *      The kind of stage.  A notemap stage converts nothing until a table
+ *      is given by note_table().
+ *
+ * \param value
+ *      The parameter of the stage.  A channel is 0 to 15 here.
+ *
+ * \return
+ *      Returns false if the value is out of range for the stage.
+ */
+
+bool
+outputfilter::add (stage kind, int value)
+{
+    bool result;
+    switch (kind)
+    {
+    case stage::transpose:
+        result = value > -c_notes_count && value < c_notes_count;
+        break;
+
+    case stage::velocity:
+        result = value > 0 && value <= 1000;
+        break;
+
+    case stage::channel:
+        result = value >= 0 && value < c_midichannel_max;
+        break;
+
+    case stage::thin:
+        result = value > 0 && value < c_notes_count;
+        if (result && m_last_values.empty())
+            m_last_values.assign(std::size_t(c_lane_count), c_no_value);
+        break;
+
+    case stage::rate:
+        result = value > 0 && value <= 10000;
+        if (result && m_last_times.empty())
+            m_last_times.assign(std::size_t(c_lane_count), 0);
+        break;
+
+    case stage::dedup:
+        result = true;
+        if (m_frame_values.empty())
+        {
+            m_frame_values.assign(std::size_t(c_lane_count), c_no_value);
+            m_frame_marks.assign(std::size_t(c_lane_count), 0);
+        }
+        break;
+
+    default:
+        result = true;
+        break;
+    }
+    if (result)
+    {
+        step s;
+        s.fs_kind = kind;
+        s.fs_value = value;
+        m_steps.push_back(s);
+    }
+    return result;
+}
+
+/**
+ *  Removes all the stages of the given kind.
+ */
+
+void
+outputfilter::remove (stage kind)
+{
+    for (auto s = m_steps.begin(); s != m_steps.end(); /* in loop */)
+    {
+        if (s->fs_kind == kind)
+            s = m_steps.erase(s);
+        else
+            ++s;
+    }
+    if (kind == stage::notemap)
+        m_note_table.clear();
+    else if (kind == stage::thin)
+        m_last_values.clear();
+    else if (kind == stage::rate)
+        m_last_times.clear();
+    else if (kind == stage::dedup)
+    {
+        m_frame_values.clear();
+        m_frame_marks.clear();
+    }
+}
+
+bool
+outputfilter::has (stage kind) const
+{
+    for (const auto & s : m_steps)
+    {
+        if (s.fs_kind == kind)
+            return true;
+    }
+    return false;
+}
+
+/**
+ *  Sets the table of a notemap stage, adding the stage at the end if there
+ *  is none.
+ *
+ * \param table
+ *      The note for each note number.  If it does not have c_notes_count
+ *      entries, the notemap stage is removed.
+ */
+
+void
+outputfilter::note_table (const midibytes & table)
+{
+    if (int(table.size()) == c_notes_count)
+    {
+        m_note_table = table;
+        if (! has(stage::notemap))
+            (void) add(stage::notemap);
+    }
+    else
+        remove(stage::notemap);
+}
+
+/**
+ *  Forgets the values sent, so that the next value of each lane is sent.
+ *  Called when playback stops.
+ */
+
+void
+outputfilter::reset () const
+{
+    if (! m_last_values.empty())
+        m_last_values.assign(m_last_values.size(), c_no_value);
+
+    if (! m_last_times.empty())
+        m_last_times.assign(m_last_times.size(), 0);
+
+    new_frame();
+}
+
+/**
+ *  Starts a frame for the dedup stage, which forgets the values sent in the
+ *  previous one.  Rather than clearing the values, the frame number is
+ *  bumped, so that the marks of the old frame no longer match.  Called by
+ *  midibase::play_batch().
+ */
+
+void
+outputfilter::new_frame () const
+{
+    if (! m_frame_marks.empty())
+    {
+        if (++m_frame == 0)                     /* wrapped, clear the marks */
+        {
+            m_frame_marks.assign(m_frame_marks.size(), 0);
+            m_frame = 1;
+        }
+    }
+}
+
+/**
+ *  Gets the channel the filter sends on, used for the Note Offs of the
+ *  notes still sounding, which are not run through the filter again.
+ *
+ * \param channel
+ *      The channel without the filter.
+ *
+ * \return
+ *      Returns the value of the last channel stage, if any, or the channel.
+ */
+
+midibyte
+outputfilter::out_channel (midibyte channel) const
+{
+    midibyte result = channel;
+    for (const auto & s : m_steps)
+    {
+        if (s.fs_kind == stage::channel)
+            result = midibyte(s.fs_value);
+    }
+    return result;
+}
+
+/**
+ *  Gets the lane of a continuous message, for the thin and rate stages.
+ *
+ * \param kind
+ *      The status of the message, without the channel.
+ *
+ * \param channel
+ *      The channel the message is sent on.
+ *
+ * \param d0
+ *      The first data byte.
+ *
+ * \param d1
+ *      The second data byte.
+ *
+ * \param [out] value
+ *      The value of the message: 0 to 16383 for a pitch bend, and 0 to 127
+ *      otherwise.
+ *
+ * \param [out] end
+ *      Set to true if the value is one that is always sent.
+ *
+ * \return
+ *      Returns the lane, or -1 if the message is not continuous.
+ */
+
+int
+outputfilter::lane
+(
+    midibyte kind, midibyte channel,
+    midibyte d0, midibyte d1, int & value, bool & end
+)
+{
+    int c = int(channel) & 0x0F;
+    int result = (-1);
+    if (d0 < c_notes_count && d1 < c_notes_count)
+    {
+        switch (kind)
+        {
+        case EVENT_CONTROL_CHANGE:
+            result = c * c_notes_count + d0;
+            value = int(d1);
+            end = d1 == 0 || d1 == c_notes_count - 1;
+            break;
+
+        case EVENT_AFTERTOUCH:
+            result = c_poly_lanes + c * c_notes_count + d0;
+            value = int(d1);
+            end = d1 == 0 || d1 == c_notes_count - 1;
+            break;
+
+        case EVENT_PITCH_WHEEL:
+            result = c_bend_lanes + c;
+            value = (int(d1) << 7) | int(d0);
+            end = value == 0 || value == c_bend_center || value == c_bend_max;
+            break;
+
+        case EVENT_CHANNEL_PRESSURE:
+            result = c_pressure_lanes + c;
+            value = int(d0);
+            end = d0 == 0 || d0 == c_notes_count - 1;
+            break;
+
+        case EVENT_PROGRAM_CHANGE:
+            result = c_program_lanes + c;
+            value = int(d0);
+            end = false;
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Runs the stages over the bytes of a message.  Only channel messages are
+ *  altered; others are passed as they are.
+ *
+ * \param status
+ *      The status of the message.  Any channel nybble is ignored.
+ *
+ * \param [inout] channel
+ *      The channel the message is to be sent on, which a channel stage
+ *      replaces.
+ *
+ * \param [inout] d0
+ *      The first data byte, such as the note number.
+ *
+ * \param [inout] d1
+ *      The second data byte, such as the velocity.
+ *
+ * \return
+ *      Returns false if the message is to be dropped.
+ */
+
+bool
+outputfilter::apply
+(
+    midibyte status, midibyte & channel,
+    midibyte & d0, midibyte & d1
+) const
+{
+    midibyte kind = event::mask_status(status);
+    if (! event::is_channel_msg(kind))
+        return true;
+
+    bool note = event::is_note_msg(kind);
+    int i = (-1);                       /* lane of a thin or rate stage     */
+    int value = 0;
+    long now = 0;
+    for (const auto & s : m_steps)
+    {
+        switch (s.fs_kind)
+        {
+        case stage::transpose:
+            if (note)
+            {
+                int n = int(d0) + s.fs_value;
+                if (n >= 0 && n < c_notes_count)
+                    d0 = midibyte(n);
+            }
+            break;
+
+        case stage::velocity:
+            if (event::is_note_on_msg(kind) && d1 > 0)
+            {
+                int v = int(d1) * s.fs_value / 100;
+                if (v < 1)
+                    v = 1;
+                else if (v >= c_notes_count)
+                    v = c_notes_count - 1;
+
+                d1 = midibyte(v);
+            }
+            break;
+
+        case stage::channel:
+            channel = midibyte(s.fs_value);
+            break;
+
+        case stage::notemap:
+            if (note && ! m_note_table.empty() && d0 < c_notes_count)
+                d0 = m_note_table[d0];
+            break;
+
+        case stage::thin:
+        case stage::rate:
+            if (! note && kind != EVENT_PROGRAM_CHANGE)
+            {
+                bool end = false;
+                i = lane(kind, channel, d0, d1, value, end);
+                if (i >= 0 && ! end)
+                {
+                    if (s.fs_kind == stage::thin)
+                    {
+                        int last = m_last_values[i];
+                        if (last != c_no_value)
+                        {
+                            int delta = value - last;
+                            if (delta < 0)
+                                delta = -delta;
+
+                            if (kind == EVENT_PITCH_WHEEL)
+                                delta /= c_notes_count;
+
+                            if (delta < s.fs_value)
+                                return false;
+                        }
+                    }
+                    else
+                    {
+                        long last = m_last_times[i];
+                        now = microtime();
+                        if (last > 0 && now - last < 1000000 / s.fs_value)
+                            return false;
+                    }
+                }
+            }
+            break;
+
+        case stage::dedup:
+            if (! note && m_frame > 0)
+            {
+                bool end = false;
+                i = lane(kind, channel, d0, d1, value, end);
+                if (i >= 0 && m_frame_marks[i] == m_frame)
+                {
+                    if (m_frame_values[i] == value)
+                        return false;
+                }
+            }
+            break;
+
+        case stage::running:
+            break;
+        }
+    }
+    if (i >= 0)
+    {
+        if (! m_last_values.empty())
+            m_last_values[i] = value;
+
+        if (! m_frame_marks.empty())
+        {
+            m_frame_values[i] = value;
+            m_frame_marks[i] = m_frame;
+        }
+
+        if (! m_last_times.empty())
+            m_last_times[i] = now > 0 ? now : microtime();
+    }
+    return true;
+}
+
+}           // namespace seq66
+
+/*
+ * outputfilter.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
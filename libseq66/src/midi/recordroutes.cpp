@@ -0,0 +1,201 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          recordroutes.cpp
+ *
+ *  This module defines the table that routes incoming events to the
+ *  recording patterns.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Building a table walks the candidates once per channel, which is
+ *  nothing next to the events it saves walking them for.
+ */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "midi/recordroutes.hpp"        /* seq66::recordroutes class        */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+recordroutes::recordroutes () :
+    m_rows      (0),
+    m_any_buss  (false),
+    m_routes    ()
+{
+    // no code
+}
+
+/**
+ *  Tells if a pattern would take an event on a channel, as
+ *  sequence::channels_match() would.
+ */
+
+bool
+recordroutes::accepts (const sequence * s, midibyte channel)
+{
+    return ! s->channel_match() || s->seq_midi_channel() == channel;
+}
+
+/**
+ *  Builds the table for record-by-buss.
+ *
+ * \param patterns
+ *      The patterns of the play-set that have an input buss, in play-set
+ *      order.  See performer::sequence_inbus_setup().
+ *
+ * \return
+ *      Returns the new table, with a row for each buss up to the highest
+ *      one used.
+ */
+
+recordroutes::pointer
+recordroutes::by_buss (const targets & patterns)
+{
+    std::shared_ptr<recordroutes> result = std::make_shared<recordroutes>();
+    int rows = 0;
+    for (const sequence * s : patterns)
+    {
+        bussbyte b = s->true_in_bus();
+        if (! is_null_buss(b) && int(b) >= rows)
+            rows = int(b) + 1;
+    }
+    result->m_rows = rows;
+    result->m_routes.resize(std::size_t(rows * c_midichannel_max));
+    for (sequence * s : patterns)
+    {
+        bussbyte b = s->true_in_bus();
+        if (is_null_buss(b))
+            continue;
+
+        for (int ch = 0; ch < c_midichannel_max; ++ch)
+        {
+            route & r = result->cell(int(b), ch);
+            if (r.rr_claimed)
+                continue;                       /* an earlier pattern has it */
+
+            r.rr_claimed = true;
+            if (accepts(s, midibyte(ch)))
+                r.rr_targets.push_back(s);
+        }
+    }
+    return result;
+}
+
+/**
+ *  Builds the table for record-by-channel.
+ *
+ * \param recorders
+ *      The recording patterns, in the order they started recording.  See
+ *      mastermidibase::set_sequence_input().
+ *
+ * \return
+ *      Returns the new table, with one row for all busses.
+ */
+
+recordroutes::pointer
+recordroutes::by_channel (const targets & recorders)
+{
+    std::shared_ptr<recordroutes> result = std::make_shared<recordroutes>();
+    result->m_rows = 1;
+    result->m_any_buss = true;
+    result->m_routes.resize(std::size_t(c_midichannel_max));
+    for (int ch = 0; ch < c_midichannel_max; ++ch)
+    {
+        route & r = result->cell(0, ch);
+        for (sequence * s : recorders)
+        {
+            if (is_nullptr(s) || ! accepts(s, midibyte(ch)))
+                continue;
+
+            r.rr_targets.push_back(s);
+            if (s->channel_match())
+            {
+                r.rr_claimed = true;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ *  Looks up the cell of an event.
+ *
+ * \return
+ *      Returns null if the event's buss is outside of the table.
+ */
+
+const recordroutes::route *
+recordroutes::find (const event & ev) const
+{
+    int row = m_any_buss ? 0 : int(ev.input_bus()) ;
+    if (row >= m_rows)
+        return nullptr;
+
+    int ch = int(event::mask_channel(ev.get_status()));
+    return &m_routes[std::size_t(row * c_midichannel_max + ch)];
+}
+
+/**
+ *  Streams an event to the patterns of its cell.  Each pattern but the
+ *  last gets its own copy, as sequence::stream_event() adjusts the event
+ *  to the pattern (its timestamp to the pattern's length, for one).
+ *
+ * \param ev
+ *      The event, which the last pattern may adjust.
+ *
+ * \return
+ *      Returns true if a pattern matched the channel and claimed the event.
+ */
+
+bool
+recordroutes::stream (event & ev) const
+{
+    const route * r = find(ev);
+    if (is_nullptr(r) || r->rr_targets.empty())
+        return false;
+
+    std::size_t last = r->rr_targets.size() - 1;
+    for (std::size_t i = 0; i < last; ++i)
+    {
+        event copy = ev;
+        (void) r->rr_targets[i]->stream_event(copy);
+    }
+    (void) r->rr_targets[last]->stream_event(ev);
+    return r->rr_claimed;
+}
+
+}           // namespace seq66
+
+/*
+ * recordroutes.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,108 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sysexstream.cpp
+ *
+ *  This module defines the paced, chunked output of a large SysEx message.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include "midi/sysexstream.hpp"         /* seq66::sysexstream class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Principal constructor.
+ *
+ * \param bus
+ *      The output buss to which the message goes.
+ *
+ * \param data
+ *      The message bytes, shared with the event that holds them.
+ *
+ * \param rate
+ *      The output rate, in bytes per second.  Zero sends every chunk at
+ *      once.
+ */
+
+sysexstream::sysexstream (bussbyte bus, pointer data, int rate) :
+    m_buss      (bus),
+    m_data      (data),
+    m_offset    (0),
+    m_rate      (rate > 0 ? rate : 0),
+    m_due_us    (0)
+{
+    // no code
+}
+
+/**
+ *  Gets the next chunk, if it is due, and schedules the one after, at the
+ *  time the device takes to receive this one at the configured rate.
+ *
+ * \param now
+ *      The current microtime().
+ *
+ * \param [out] c
+ *      The chunk to send.
+ *
+ * \return
+ *      Returns true if a chunk is to be sent now.
+ */
+
+bool
+sysexstream::next (long now, chunk & c)
+{
+    bool result = ! done() && now >= m_due_us;
+    if (result)
+    {
+        std::size_t left = m_data->size() - m_offset;
+        std::size_t n = left < std::size_t(c_sysex_chunk_size) ?
+            left : std::size_t(c_sysex_chunk_size) ;
+
+        c.sc_data = m_data->data() + m_offset;
+        c.sc_size = int(n);
+        m_offset += n;
+        if (m_rate > 0)
+        {
+            long span = long(n) * 1000000L / long(m_rate);
+            bool behind = m_due_us == 0 || now - m_due_us >= span;
+            m_due_us = (behind ? now : m_due_us) + span;    /* no bursts    */
+        }
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * sysexstream.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
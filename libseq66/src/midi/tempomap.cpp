@@ -0,0 +1,244 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          tempomap.cpp
+ *
+ *  This module defines the tempo map.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The map is filled by clear(), which sets the tempo at tick 0, then any
+ *  number of add() calls, in any order, then build().  A tempo change at
+ *  tick 0 replaces the starting tempo, and of several changes at the same
+ *  tick, the last one added wins, as it would in playback.
+ */
+
+#include <algorithm>                    /* std::stable_sort(), upper_bound  */
+
+#include "midi/calculations.hpp"        /* seq66::tempo_us_from_bpm()       */
+#include "midi/tempomap.hpp"            /* seq66::tempomap class            */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+tempomap::tempomap () :
+    m_segments  (),
+    m_pending   (),
+    m_ppqn      (0)
+{
+    // no code
+}
+
+/**
+ *  Starts a new map.
+ *
+ * \param ppqn
+ *      The PPQN of the song.
+ *
+ * \param bpm
+ *      The tempo at the start of the song.
+ */
+
+void
+tempomap::clear (int ppqn, midibpm bpm)
+{
+    m_segments.clear();
+    m_pending.clear();
+    m_ppqn = ppqn > 0 ? ppqn : 1 ;
+    add(0, bpm);
+}
+
+/**
+ *  Adds a tempo change.  Invalid values are ignored.  The map is not
+ *  usable until build() is called.
+ */
+
+void
+tempomap::add (midipulse tick, midibpm bpm)
+{
+    if (tick >= 0 && bpm > 0.0)
+    {
+        segment s;
+        s.tm_tick = tick;
+        s.tm_us_per_tick = tempo_us_from_bpm(bpm) / double(m_ppqn);
+        s.tm_start_us = 0.0;
+        s.tm_bpm = bpm;
+        m_pending.push_back(s);
+    }
+}
+
+/**
+ *  Sorts the tempo changes and calculates the start time of each segment.
+ */
+
+void
+tempomap::build ()
+{
+    std::stable_sort
+    (
+        m_pending.begin(), m_pending.end(),
+        [] (const segment & a, const segment & b)
+        {
+            return a.tm_tick < b.tm_tick;
+        }
+    );
+    m_segments.clear();
+    for (const auto & s : m_pending)
+    {
+        if (! m_segments.empty() && m_segments.back().tm_tick == s.tm_tick)
+        {
+            double start = m_segments.back().tm_start_us;
+            m_segments.back() = s;              /* the last one wins        */
+            m_segments.back().tm_start_us = start;
+        }
+        else if
+        (
+            ! m_segments.empty() && m_segments.back().tm_bpm == s.tm_bpm
+        )
+        {
+            continue;                           /* not really a change      */
+        }
+        else
+        {
+            segment seg = s;
+            if (! m_segments.empty())
+            {
+                const segment & prev = m_segments.back();
+                seg.tm_start_us = prev.tm_start_us +
+                    double(s.tm_tick - prev.tm_tick) * prev.tm_us_per_tick;
+            }
+            m_segments.push_back(seg);
+        }
+    }
+    m_pending.clear();
+}
+
+/**
+ * \return
+ *      Returns the segment holding the tick, or null if the map is empty.
+ */
+
+const tempomap::segment *
+tempomap::find (midipulse tick) const
+{
+    if (m_segments.empty())
+        return nullptr;
+
+    auto s = std::upper_bound
+    (
+        m_segments.cbegin(), m_segments.cend(), tick,
+        [] (midipulse tk, const segment & seg)
+        {
+            return tk < seg.tm_tick;
+        }
+    );
+    if (s != m_segments.cbegin())
+        --s;
+
+    return &(*s);
+}
+
+/**
+ * \return
+ *      Returns the time of the tick, in microseconds from the start of the
+ *      song.
+ */
+
+double
+tempomap::tick_to_us (midipulse tick) const
+{
+    const segment * s = find(tick);
+    return not_nullptr(s) ?
+        s->tm_start_us + double(tick - s->tm_tick) * s->tm_us_per_tick : 0.0 ;
+}
+
+/**
+ * \return
+ *      Returns the tick at the given time, in microseconds from the start
+ *      of the song, rounded down.
+ */
+
+midipulse
+tempomap::us_to_tick (double us) const
+{
+    if (m_segments.empty() || us <= 0.0)
+        return 0;
+
+    auto s = std::upper_bound
+    (
+        m_segments.cbegin(), m_segments.cend(), us,
+        [] (double t, const segment & seg)
+        {
+            return t < seg.tm_start_us;
+        }
+    );
+    if (s != m_segments.cbegin())
+        --s;
+
+    return s->tm_tick + midipulse((us - s->tm_start_us) / s->tm_us_per_tick);
+}
+
+/**
+ * \return
+ *      Returns the tempo in force at the tick, or 0 if the map is empty.
+ */
+
+midibpm
+tempomap::bpm_at (midipulse tick) const
+{
+    const segment * s = find(tick);
+    return not_nullptr(s) ? s->tm_bpm : 0.0 ;
+}
+
+/**
+ * \return
+ *      Returns the tick of the first tempo change after the tick, or
+ *      c_null_midipulse if there is none.
+ */
+
+midipulse
+tempomap::next_change (midipulse tick) const
+{
+    auto s = std::upper_bound
+    (
+        m_segments.cbegin(), m_segments.cend(), tick,
+        [] (midipulse tk, const segment & seg)
+        {
+            return tk < seg.tm_tick;
+        }
+    );
+    return s != m_segments.cend() ? s->tm_tick : c_null_midipulse ;
+}
+
+}           // namespace seq66
+
+/*
+ * tempomap.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
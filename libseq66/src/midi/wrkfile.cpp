@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-04
- * \updates       2022-09-11
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the WRK format, see, for example:
@@ -78,6 +78,7 @@
  */
 
 #include <cmath>                        /* for the pow() function           */
+#include <utility>                      /* std::move()                      */
 
 #include "cfg/settings.hpp"             /* seq66::rc().show_midi() etc.     */
 #include "midi/wrkfile.hpp"             /* seq66::wrkfile                   */
@@ -205,6 +206,8 @@ wrkfile::wrkfile
 ) :
     midifile        (name, ppqn, true, playlistmode),
     m_wrk_data      (),
+    m_chunks        (),
+    m_selected_tracks (),
     m_performer     (nullptr),
     m_screen_set    (seq::unassigned()),
     m_importing     (false),
@@ -471,19 +474,18 @@ wrkfile::parse (performer & p, int screenset, bool importing)
 
         int vme = int(read_byte());     /* minor WRK version number         */
         int vma = int(read_byte());     /* major WRK version number         */
-        int ck_id;
         msgprintf(msglevel::status, "WRK Version: %d.%d", vma, vme);
-
-        do
+        if (index_chunks())
         {
-            ck_id = read_chunk();
+            for (const auto & c : m_chunks)
+            {
+                if (selected(c))
+                    read_chunk(c);
+            }
+            EndChunk();
         }
-        while (ck_id != WC_END_CHUNK && ! at_end());
-
-        if (! at_end())
-            result = set_error("Corrupted WRK file.");
         else
-            EndChunk();
+            result = set_error("Corrupted WRK file.");
     }
     else
         result = set_error("Invalid WRK file format.");
@@ -491,6 +493,21 @@ wrkfile::parse (performer & p, int screenset, bool importing)
     return result;
 }
 
+/**
+ *  Restricts the next parse() to the given Cakewalk track numbers.  The
+ *  global chunks (tempo, meter, etc.) are always read.
+ *
+ * \param tracks
+ *      The track numbers to import.  If empty, all tracks are imported.
+ */
+
+void
+wrkfile::select_tracks (const std::vector<int> & tracks)
+{
+    m_selected_tracks.clear();
+    m_selected_tracks.insert(tracks.begin(), tracks.end());
+}
+
 /**
  *  An override of the midifile function.  All it does is set the m_track_time
  *  value to 0, so far.
@@ -676,7 +693,9 @@ wrkfile::next_track
 
 /**
  *  This override finalizes a WRK track, if the sequence doesn't already
- *  exist.
+ *  exist.  If no track chunk was read, as when select_tracks() names none
+ *  of the tracks of the file, the sequence holds only the meter or tempo of
+ *  the global chunks, and gets the first pattern slot.
  */
 
 void
@@ -688,10 +707,13 @@ wrkfile::finalize_track ()
         if (scaled())
             duration = midipulse(duration * ppqn_ratio());
 
+        int seqnum = m_track_number == seq::unassigned() ?
+            0 : m_track_number ;
+
         m_current_seq->set_length(duration);
         (void) finalize_sequence
         (
-            *m_performer, *m_current_seq, m_track_number, m_screen_set
+            *m_performer, *m_current_seq, seqnum, m_screen_set
         );
     }
 }
@@ -929,7 +951,7 @@ wrkfile::NoteArray (int track, int events)
                     e.set_channel_status(EVENT_NOTE_OFF, channel);
 
                 e.set_data(d0, d1);
-                m_current_seq->append_event(e);
+                m_current_seq->append_event(std::move(e));
                 if (eventcode == EVENT_NOTE_ON && ! isnoteoff)
                 {
                     event e;
@@ -937,7 +959,7 @@ wrkfile::NoteArray (int track, int events)
                     Set_timestamp(e, timemax);
                     e.set_channel_status(EVENT_NOTE_OFF, channel);
                     e.set_data(d0, 0);
-                    m_current_seq->append_event(e);
+                    m_current_seq->append_event(std::move(e));
                 }
                 m_current_seq->set_midi_channel(channel);
                 if (timemax > m_track_time)
@@ -953,7 +975,7 @@ wrkfile::NoteArray (int track, int events)
                 // Q_EMIT signalWRKChanPress(track, time, channel, d0);
 
                 e.set_data(d0);
-                m_current_seq->append_event(e);
+                m_current_seq->append_event(std::move(e));
                 m_current_seq->set_midi_channel(channel);
 
                 /*
@@ -969,7 +991,7 @@ wrkfile::NoteArray (int track, int events)
 
                 value = (d1 << 7) + d0 - 8192;
                 e.set_data(d0, d1);
-                m_current_seq->append_event(e);
+                m_current_seq->append_event(std::move(e));
                 m_current_seq->set_midi_channel(channel);
 
                 /*
@@ -1024,7 +1046,7 @@ wrkfile::NoteArray (int track, int events)
             event e;
             e.set_channel_status(EVENT_CONTROL_CHANGE, channel);
             e.set_data(EVENT_CTRL_EXPRESSION, d1);
-            m_current_seq->append_event(e);
+            m_current_seq->append_event(std::move(e));
         }
         else if (status == 6)               /* not supported in Seq66     */
         {
@@ -1228,7 +1250,7 @@ wrkfile::StreamChunk ()
                 e.set_channel_status(EVENT_NOTE_OFF, channel);
 
             e.set_data(d0, d1);
-            m_current_seq->append_event(e);
+            m_current_seq->append_event(std::move(e));
             if (eventcode == EVENT_NOTE_ON && ! isnoteoff)
             {
                 event e;
@@ -1236,7 +1258,7 @@ wrkfile::StreamChunk ()
                 Set_timestamp(e, timemax);
                 e.set_channel_status(EVENT_NOTE_OFF, channel);
                 e.set_data(d0, 0);
-                m_current_seq->append_event(e);
+                m_current_seq->append_event(std::move(e));
             }
             m_current_seq->set_midi_channel(channel);
             if (timemax > m_track_time)
@@ -1256,7 +1278,7 @@ wrkfile::StreamChunk ()
             // Q_EMIT signalWRKChanPress(track, time, channel, d0);
 
             e.set_data(d0);
-            m_current_seq->append_event(e);
+            m_current_seq->append_event(std::move(e));
             m_current_seq->set_midi_channel(channel);
 
             /*
@@ -1272,7 +1294,7 @@ wrkfile::StreamChunk ()
 
             value = (d1 << 7) + d0 - 8192;                      // hmmmm
             e.set_data(d0, d1);
-            m_current_seq->append_event(e);
+            m_current_seq->append_event(std::move(e));
             m_current_seq->set_midi_channel(channel);
 
             /*
@@ -1432,7 +1454,7 @@ wrkfile::MeterKeyChunk ()
                 bt[1] = 0;                  /* indicates a major key        */
                 bool ok = e.append_meta_data(EVENT_META_KEY_SIGNATURE, bt, 2);
                 if (ok)
-                    m_current_seq->append_event(e);
+                    m_current_seq->append_event(std::move(e));
             }
         }
     }
@@ -1543,7 +1565,7 @@ wrkfile::TempoChunk (int factor)
         if (ok)
         {
             Set_timestamp(e, time);
-            m_current_seq->append_event(e);
+            m_current_seq->append_event(std::move(e));
         }
     }
 }
@@ -1781,7 +1803,7 @@ wrkfile::TrackPatch ()
     event e;
     e.set_channel_status(EVENT_PROGRAM_CHANGE, m_track_channel);
     e.set_data(patch);
-    m_current_seq->append_event(e);
+    m_current_seq->append_event(std::move(e));
 }
 
 /**
@@ -1877,6 +1899,7 @@ void
 wrkfile::UnknownChunk (int id)
 {
     // Q_EMIT signalWRKUnknownChunk(id, m_wrk_data.m_lastChunkData);
+    // The raw data is read only for this chunk; see read_chunk().
 
     if (rc().show_midi())
     {
@@ -2097,7 +2120,7 @@ wrkfile::TrackVol ()
     event e;
     e.set_channel_status(EVENT_CONTROL_CHANGE, m_track_channel);
     e.set_data(EVENT_CTRL_VOLUME, midibyte(vol));
-    m_current_seq->append_event(e);
+    m_current_seq->append_event(std::move(e));
 }
 
 /**
@@ -2235,142 +2258,223 @@ wrkfile::EndChunk ()
     finalize_track();
 }
 
-int
-wrkfile::read_chunk ()
+/**
+ *  Walks the chunk headers, from the current position to the end chunk, and
+ *  records the type, extent, and track number of each chunk in m_chunks.
+ *  The position is restored afterward.  Each chunk starts with a type byte
+ *  and a 32-bit length, except the end chunk, which is the type byte alone.
+ *  The track number of a per-track chunk is the 16-bit value at the start
+ *  of its data.
+ *
+ *  As with the previous one-pass reader, a file that ends without an end
+ *  chunk is accepted, and a truncated last chunk is read as far as it goes.
+ *
+ * \return
+ *      Returns false if data follows the end chunk, meaning the file is
+ *      corrupted.
+ */
+
+bool
+wrkfile::index_chunks ()
 {
-    int ck = int(read_byte());
-    if (ck != WC_END_CHUNK)
+    bool result = true;
+    size_t start = pos();
+    m_chunks.clear();
+    while (! at_end())
     {
-        int ck_len = read_32_bit();
-        size_t start_pos = pos();
-        size_t final_pos = start_pos + ck_len;
-        read_raw_data(ck_len);
-        read_seek(start_pos);
+        int ck = int(read_byte());
+        if (ck == WC_END_CHUNK)
+        {
+            result = at_end();
+            break;
+        }
+
+        size_t len = size_t(read_32_bit());
+        chunkinfo c;
+        c.ck_id = ck;
+        c.offset = pos();
+        c.length = len;
+        c.track = (-1);
         switch (ck)
         {
         case WC_TRACK_CHUNK:
-            TrackChunk();          // names, number, velocity, mute/loop status
+        case WC_STREAM_CHUNK:
+        case WC_TRKOFFS_CHUNK:
+        case WC_TRKREPS_CHUNK:
+        case WC_TRKPATCH_CHUNK:
+        case WC_LYRICS_CHUNK:
+        case WC_TRKVOL_CHUNK:
+        case WC_TRKNAME_CHUNK:
+        case WC_NTRKOFS_CHUNK:
+        case WC_TRKBANK_CHUNK:
+        case WC_NTRACK_CHUNK:
+        case WC_NSTREAM_CHUNK:
+        case WC_SGMNT_CHUNK:
+            c.track = int(to_16_bit(peek(1), peek(0)));
             break;
 
-        case WC_VARS_CHUNK:
-            VarsChunk();           // Cakewalk global variables
+        default:
             break;
+        }
+        m_chunks.push_back(c);
+        if (c.offset + len > data_size())
+            break;                              /* truncated, the last one  */
 
-        case WC_TIMEBASE_CHUNK:
-            TimebaseChunk();       // gets PPQN value m_division for whole tune
-            break;
+        skip(len);
+    }
+    (void) read_seek(start);
+    return result;
+}
 
-        case WC_STREAM_CHUNK:
-            StreamChunk();         // note, control, program, pitchbend, etc.
-            break;
+/**
+ * \return
+ *      Returns true if the chunk is global, or belongs to a track that is to
+ *      be imported.
+ */
 
-        case WC_METER_CHUNK:
-            MeterChunk();          // gets a time signature
-            break;
+bool
+wrkfile::selected (const chunkinfo & c) const
+{
+    return
+    (
+        m_selected_tracks.empty() || c.track < 0 ||
+        m_selected_tracks.count(c.track) > 0
+    );
+}
 
-        case WC_TEMPO_CHUNK:
-            TempoChunk(100);       // gets the BPM tempo
-            break;
+/**
+ *  Decodes one chunk from the index, reading its data in place.
+ */
 
-        case WC_NTEMPO_CHUNK:
-            TempoChunk();          // gets the BPM tempo
-            break;
+void
+wrkfile::read_chunk (const chunkinfo & c)
+{
+    int ck = c.ck_id;
+    int ck_len = int(c.length);
+    (void) read_seek(c.offset);
+    switch (ck)
+    {
+    case WC_TRACK_CHUNK:
+        TrackChunk();          // names, number, velocity, mute/loop status
+        break;
 
-        case WC_SYSEX_CHUNK:
-            SysexChunk();          // handle SysEx messages
-            break;
+    case WC_VARS_CHUNK:
+        VarsChunk();           // Cakewalk global variables
+        break;
 
-        case WC_THRU_CHUNK:
-            ThruChunk();           // Extended Thru: mode, port, channel, ...
-            break;
+    case WC_TIMEBASE_CHUNK:
+        TimebaseChunk();       // gets PPQN value m_division for whole tune
+        break;
 
-        case WC_TRKOFFS_CHUNK:
-            TrackOffset();          // "short" track offset
-            break;
+    case WC_STREAM_CHUNK:
+        StreamChunk();         // note, control, program, pitchbend, etc.
+        break;
 
-        case WC_TRKREPS_CHUNK:
-            TrackReps();            // repetition count for a track
-            break;
+    case WC_METER_CHUNK:
+        MeterChunk();          // gets a time signature
+        break;
 
-        case WC_TRKPATCH_CHUNK:
-            TrackPatch();           // track number and patch number
-            break;
+    case WC_TEMPO_CHUNK:
+        TempoChunk(100);       // gets the BPM tempo
+        break;
 
-        case WC_TIMEFMT_CHUNK:
-            TimeFormat();           // SMPTE frames, frames/sec, offset
-            break;
+    case WC_NTEMPO_CHUNK:
+        TempoChunk();          // gets the BPM tempo
+        break;
 
-        case WC_COMMENTS_CHUNK:
-            Comments();             // data file text comments
-            break;
+    case WC_SYSEX_CHUNK:
+        SysexChunk();          // handle SysEx messages
+        break;
 
-        case WC_VARIABLE_CHUNK:
-            VariableRecord(ck_len); // record identifier & variable data
-            break;
+    case WC_THRU_CHUNK:
+        ThruChunk();           // Extended Thru: mode, port, channel, ...
+        break;
 
-        case WC_NTRACK_CHUNK:
-            NewTrack();             // track #, channel, pitch, mute/loop...
-            break;
+    case WC_TRKOFFS_CHUNK:
+        TrackOffset();          // "short" track offset
+        break;
 
-        case WC_SOFTVER_CHUNK:
-            SoftVer();              // software version string
-            break;
+    case WC_TRKREPS_CHUNK:
+        TrackReps();            // repetition count for a track
+        break;
 
-        case WC_TRKNAME_CHUNK:
-            TrackName();            // track number and name
-            break;
+    case WC_TRKPATCH_CHUNK:
+        TrackPatch();           // track number and patch number
+        break;
 
-        case WC_STRTAB_CHUNK:
-            StringTable();          // list of declared string event types
-            break;
+    case WC_TIMEFMT_CHUNK:
+        TimeFormat();           // SMPTE frames, frames/sec, offset
+        break;
 
-        case WC_LYRICS_CHUNK:
-            LyricsStream();         // processes the note array
-            break;
+    case WC_COMMENTS_CHUNK:
+        Comments();             // data file text comments
+        break;
 
-        case WC_TRKVOL_CHUNK:
-            TrackVol();             // Cakewalk style track volume
-            break;
+    case WC_VARIABLE_CHUNK:
+        VariableRecord(ck_len); // record identifier & variable data
+        break;
 
-        case WC_NTRKOFS_CHUNK:
-            NewTrackOffset();       // "long" track offset
-            break;
+    case WC_NTRACK_CHUNK:
+        NewTrack();             // track #, channel, pitch, mute/loop...
+        break;
 
-        case WC_TNUMPLUS_CHUNK:
-            TrackNumPlusChunk();
-            break;
+    case WC_SOFTVER_CHUNK:
+        SoftVer();              // software version string
+        break;
 
-        case WC_TRKBANK_CHUNK:
-            TrackBank();            // the bank ID of the track
-            break;
+    case WC_TRKNAME_CHUNK:
+        TrackName();            // track number and name
+        break;
 
-        case WC_METERKEY_CHUNK:
-            MeterKeyChunk();       // gets a time signature and key (scale)
-            break;
+    case WC_STRTAB_CHUNK:
+        StringTable();          // list of declared string event types
+        break;
 
-        case WC_SYSEX2_CHUNK:
-            Sysex2Chunk();         // handle SysEx messages
-            break;
+    case WC_LYRICS_CHUNK:
+        LyricsStream();         // processes the note array
+        break;
 
-        case WC_NSYSEX_CHUNK:
-            NewSysexChunk();
-            break;
+    case WC_TRKVOL_CHUNK:
+        TrackVol();             // Cakewalk style track volume
+        break;
 
-        case WC_SGMNT_CHUNK:
-            SegmentChunk();        // processes a note array
-            break;
+    case WC_NTRKOFS_CHUNK:
+        NewTrackOffset();       // "long" track offset
+        break;
 
-        case WC_NSTREAM_CHUNK:
-            NewStream();            // processes a note array
-            break;
+    case WC_TNUMPLUS_CHUNK:
+        TrackNumPlusChunk();
+        break;
 
-        default:
-            UnknownChunk(ck);
-            break;
-        }
-        read_seek(final_pos);
+    case WC_TRKBANK_CHUNK:
+        TrackBank();            // the bank ID of the track
+        break;
+
+    case WC_METERKEY_CHUNK:
+        MeterKeyChunk();       // gets a time signature and key (scale)
+        break;
+
+    case WC_SYSEX2_CHUNK:
+        Sysex2Chunk();         // handle SysEx messages
+        break;
+
+    case WC_NSYSEX_CHUNK:
+        NewSysexChunk();
+        break;
+
+    case WC_SGMNT_CHUNK:
+        SegmentChunk();        // processes a note array
+        break;
+
+    case WC_NSTREAM_CHUNK:
+        NewStream();            // processes a note array
+        break;
+
+    default:
+        read_raw_data(ck_len);
+        UnknownChunk(ck);
+        break;
     }
-    return ck;
 }
 
 }        // namespace seq66
@@ -21,7 +21,7 @@
  * \library       seq66 application (from PSXC library)
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (pre-Sequencer24/64)
- * \updates       2024-11-07
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Daemonization module of the POSIX C Wrapper (PSXC) library
@@ -80,6 +80,7 @@
  */
 
 #include <atomic>                       /* std::atomic<bool>                */
+#include <errno.h>                      /* errno                            */
 #include <stdlib.h>                     /* EXIT_FAILURE for 32-bit builds   */
 #include <string.h>                     /* memset()                         */
 
@@ -87,10 +88,12 @@
 #include "os/daemonize.hpp"             /* daemonization functions & macros */
 #include "util/basic_macros.hpp"        /* errprint()                       */
 #include "util/filefunctions.hpp"       /* seq66::get_full_path() etc.      */
+#include "os/timing.hpp"                /* seq66::millisleep()              */
 
 #if defined SEQ66_PLATFORM_UNIX         /* it's not just LINUX, dude!       */
 
 #include <fcntl.h>                      /* O_RDWR flag                      */
+#include <poll.h>                       /* poll()                           */
 #include <signal.h>                     /* struct sigaction                 */
 #include <sys/stat.h>                   /* umask(), etc.                    */
 #include <syslog.h>                     /* syslog() and related constants   */
@@ -540,6 +543,13 @@ static std::atomic<bool> sg_needs_close {};
 static std::atomic<bool> sg_needs_save {};
 static std::atomic<bool> sg_restart {};
 
+/*
+ *  Set while a wake-up is waiting to be seen by session_wait(), so that
+ *  repeated wakes write no more than one byte into the pipe.
+ */
+
+static std::atomic<bool> sg_wake_pending {};
+
 bool
 session_restart ()
 {
@@ -584,11 +594,13 @@ session_save ()
 void signal_for_save ()
 {
     sg_needs_save = true;
+    session_wake();
 }
 
 void signal_for_exit ()
 {
     sg_needs_close = true;
+    session_wake();
 }
 
 /**
@@ -599,6 +611,7 @@ void
 signal_for_restart ()
 {
     sg_restart = true;
+    session_wake();
 }
 
 void
@@ -615,6 +628,71 @@ signal_end_restart ()
 
 #if defined SEQ66_PLATFORM_UNIX         // LINUX
 
+/*
+ *  The self-pipe that wakes session_wait().  Created by session_setup().
+ */
+
+static int sg_wake_pipe [2] = { (-1), (-1) };
+
+/**
+ *  Wakes a thread sleeping in session_wait().  Only a lock-free atomic and
+ *  write(2) are used, so this function is safe to call from the signal
+ *  handler, as well as from any thread.
+ */
+
+void
+session_wake ()
+{
+    if (sg_wake_pipe[1] >= 0 && ! sg_wake_pending.exchange(true))
+    {
+        int saved_errno = errno;
+        char c = 0;
+        ssize_t rc = write(sg_wake_pipe[1], &c, 1);
+        (void) rc;
+        errno = saved_errno;
+    }
+}
+
+/**
+ *  Sleeps until session_wake() is called or the time is up.  The pending
+ *  flag is cleared before the pipe is drained, so that a wake that comes in
+ *  meanwhile leaves a byte for the next call, and is not lost.
+ *
+ * \param ms
+ *      The longest time to sleep, in milliseconds.
+ *
+ * \return
+ *      Returns true if woken before the time was up.
+ */
+
+bool
+session_wait (int ms)
+{
+    if (sg_wake_pipe[0] < 0)
+    {
+        (void) millisleep(ms);
+        return false;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = sg_wake_pipe[0];
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int rc = poll(&pfd, 1, ms);
+    bool result = rc > 0 && (pfd.revents & POLLIN) != 0;
+    if (result)
+    {
+        char buffer[32];
+        sg_wake_pending = false;
+        while (read(sg_wake_pipe[0], buffer, sizeof buffer) > 0)
+        {
+            // drain it
+        }
+    }
+    return result;
+}
+
 /**
  *  Provides a basic session handler, called upon receipt of a POSIX signal.
  *  Note that SIGSTOP and SIGKILL cannot be blocked, ignored, or caught by a
@@ -643,6 +721,7 @@ session_handler (int sig)
         sg_needs_save = true;
         break;
     }
+    session_wake();
 }
 
 /**
@@ -667,6 +746,14 @@ session_setup (bool earlyexit)
         memset(&action, 0, sizeof action);
         action.sa_handler = session_handler;
         sg_needs_close = sg_needs_save = sg_restart = false;
+        if (sg_wake_pipe[0] < 0 && pipe(sg_wake_pipe) == 0)
+        {
+            for (int fd : sg_wake_pipe)
+            {
+                (void) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                (void) fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+        }
         sigaction(SIGINT, &action, NULL);               /* SIGINT is 2      */
         sigaction(SIGTERM, &action, NULL);              /* SIGTERM is 15    */
         sigaction(SIGUSR1, &action, NULL);              /* SIGUSR1 is 10    */
@@ -792,6 +879,23 @@ session_setup (bool earlyexit)
     return result;
 }
 
+/*
+ *  No self-pipe yet on Windows, so session_wait() just sleeps.
+ */
+
+void
+session_wake ()
+{
+    sg_wake_pending = true;
+}
+
+bool
+session_wait (int ms)
+{
+    (void) millisleep(ms);
+    return sg_wake_pending.exchange(false);
+}
+
 bool
 pid_exists (const std::string & /*exename*/)
 {
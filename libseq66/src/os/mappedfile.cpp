@@ -0,0 +1,367 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          mappedfile.cpp
+ *
+ *  This module defines the read-only, whole-file view used by midifile.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ */
+
+#include <deque>                        /* std::deque<> of cached images    */
+#include <fstream>                      /* std::ifstream                    */
+#include <mutex>                        /* std::mutex, std::lock_guard<>    */
+#include <new>                          /* std::bad_alloc                   */
+
+#include "seq66_platform_macros.h"      /* detecting Linux vs Windows       */
+#include "os/mappedfile.hpp"            /* seq66::mappedfile class          */
+#include "util/filefunctions.hpp"       /* seq66::file_mod_time()           */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <fcntl.h>                      /* ::open(), O_RDONLY               */
+#include <sys/mman.h>                   /* ::mmap(), ::munmap(), madvise()  */
+#include <sys/stat.h>                   /* ::fstat()                        */
+#include <unistd.h>                     /* ::close()                        */
+#endif
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The stride used by prefetch() to touch each page of a mapped file.  The
+ *  page size is at least this large on the systems we support.
+ */
+
+static const size_t c_prefetch_stride = 4096;
+
+/**
+ *  The number of whole-file images kept by preload().  The play-list keeps
+ *  the songs before and after the current one; the rest is slack for a
+ *  quick back-and-forth.
+ */
+
+static const size_t c_image_cache_max = 4;
+
+/**
+ *  A file image held by preload(), with the size and modification time the
+ *  file had when it was read.
+ */
+
+class file_image
+{
+
+public:
+
+    std::string fi_name;                            /**< The full path.     */
+    size_t fi_size;                                 /**< The file size.     */
+    long fi_mod_time;                               /**< Its last change.   */
+    std::shared_ptr<const std::vector<midibyte>> fi_data;   /**< The bytes. */
+
+};
+
+/*
+ *  The images, newest last, shared by the play-list's prefetch thread and
+ *  the thread opening songs.
+ */
+
+static std::mutex s_image_mutex;
+static std::deque<file_image> s_images;
+
+mappedfile::mappedfile () :
+    m_data      (nullptr),
+    m_size      (0),
+    m_mapped    (false),
+    m_buffer    (),
+    m_image     ()
+{
+    // no code
+}
+
+mappedfile::~mappedfile ()
+{
+    close();
+}
+
+/**
+ *  Makes the whole file available via data().  Mapping is tried first, and
+ *  reading the file into a buffer is the fallback.
+ *
+ * \param filename
+ *      The full path to the file.
+ *
+ * \return
+ *      Returns true if the file was opened.  An empty file is treated as a
+ *      failure, so that data() is never null when true is returned.
+ */
+
+bool
+mappedfile::open (const std::string & filename)
+{
+    close();
+    if (filename.empty())
+        return false;
+
+    bool result = use_image(filename);
+    if (! result)
+        result = map_file(filename);
+
+    if (! result)
+        result = read_file(filename);
+
+    return result;
+}
+
+/**
+ *  Uses the preloaded image of the file, if there is one and the file has
+ *  not changed since.  A stale image is dropped.
+ */
+
+bool
+mappedfile::use_image (const std::string & filename)
+{
+    std::lock_guard<std::mutex> lock(s_image_mutex);
+    bool result = false;
+    for (auto it = s_images.begin(); it != s_images.end(); ++it)
+    {
+        if (it->fi_name == filename)
+        {
+            result = it->fi_size == file_size(filename) &&
+                it->fi_mod_time == file_mod_time(filename);
+
+            if (result)
+            {
+                m_image = it->fi_data;
+                m_data = m_image->data();
+                m_size = m_image->size();
+            }
+            else
+                (void) s_images.erase(it);
+
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Reads the whole of a file into an image held in memory, for a later
+ *  open() to use.  The oldest image is dropped once there are too many.
+ *  Meant to be run in a background thread.
+ *
+ * \param filename
+ *      The full path to the file.
+ *
+ * \return
+ *      Returns true if the file was read, or its image was already current.
+ */
+
+bool
+mappedfile::preload (const std::string & filename)
+{
+    size_t sz = file_size(filename);
+    long modtime = file_mod_time(filename);
+    {
+        std::lock_guard<std::mutex> lock(s_image_mutex);
+        for (const auto & fi : s_images)
+        {
+            if (fi.fi_name == filename && fi.fi_size == sz &&
+                fi.fi_mod_time == modtime)
+            {
+                return true;
+            }
+        }
+    }
+
+    mappedfile mf;
+    bool result = mf.read_file(filename);       /* outside of the lock      */
+    if (result)
+    {
+        file_image fi;
+        fi.fi_name = filename;
+        fi.fi_size = sz;
+        fi.fi_mod_time = modtime;
+        fi.fi_data = std::make_shared<const std::vector<midibyte>>
+        (
+            std::move(mf.m_buffer)
+        );
+        mf.m_data = nullptr;
+
+        std::lock_guard<std::mutex> lock(s_image_mutex);
+        for (auto it = s_images.begin(); it != s_images.end(); ++it)
+        {
+            if (it->fi_name == filename)
+            {
+                (void) s_images.erase(it);
+                break;
+            }
+        }
+        s_images.push_back(fi);
+        while (s_images.size() > c_image_cache_max)
+            s_images.pop_front();
+    }
+    return result;
+}
+
+/**
+ *  Reads a file into the system's file cache, so that a later open() and
+ *  parse does not wait on the disk.  With a mapping, one byte of each page is
+ *  touched; with the fallback, reading the file is enough.  Meant to be run
+ *  in a background thread.
+ *
+ * \param filename
+ *      The full path to the file.
+ *
+ * \return
+ *      Returns true if the file could be read.
+ */
+
+bool
+mappedfile::prefetch (const std::string & filename)
+{
+    mappedfile mf;
+    bool result = mf.open(filename);
+    if (result && mf.mapped())
+    {
+        const volatile midibyte * p = mf.data();
+        midibyte sum = 0;
+        for (size_t i = 0; i < mf.size(); i += c_prefetch_stride)
+            sum += p[i];
+
+        (void) sum;
+    }
+    return result;
+}
+
+/**
+ *  Releases the mapping or the buffer.
+ */
+
+void
+mappedfile::close ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (m_mapped)
+        (void) ::munmap(const_cast<midibyte *>(m_data), m_size);
+#endif
+
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_image.reset();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
+
+/**
+ *  Maps the file read-only.  The kernel is told that the file will be read
+ *  from start to end, so that it reads ahead aggressively.
+ */
+
+bool
+mappedfile::map_file (const std::string & filename)
+{
+    bool result = false;
+
+#if defined SEQ66_PLATFORM_POSIX_API
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size_t sz = size_t(st.st_size);
+            void * p = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                (void) ::madvise(p, sz, MADV_SEQUENTIAL);
+                (void) ::madvise(p, sz, MADV_WILLNEED);
+                m_data = static_cast<const midibyte *>(p);
+                m_size = sz;
+                m_mapped = true;
+                result = true;
+            }
+        }
+        (void) ::close(fd);                 /* the mapping stays valid      */
+    }
+#else
+    (void) filename;
+#endif
+
+    return result;
+}
+
+/**
+ *  Reads the whole file into m_buffer, in one read.
+ */
+
+bool
+mappedfile::read_file (const std::string & filename)
+{
+    std::ifstream file
+    (
+        filename, std::ios::in | std::ios::binary | std::ios::ate
+    );
+    bool result = file.is_open();
+    if (result)
+    {
+        std::streamoff sz = std::streamoff(file.tellg());
+        result = sz > 0;
+        if (result)
+        {
+            try
+            {
+                m_buffer.resize(size_t(sz));
+                file.seekg(0, std::ios::beg);
+                file.read((char *)(m_buffer.data()), sz);
+                result = bool(file);
+            }
+            catch (const std::bad_alloc &)
+            {
+                result = false;
+            }
+        }
+        if (result)
+        {
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+        else
+            m_buffer.clear();
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * mappedfile.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,384 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          perftrace.cpp
+ *
+ *  This module defines the trace points of the engine.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The rings are allocated when tracing is turned on, before any thread
+ *  runs, so that no I/O thread allocates.  A thread claims the next free
+ *  ring the first time it passes a trace point, by an atomic increment; if
+ *  none is left, the thread is not traced.  The rings are never freed, so
+ *  that the events of a thread that has ended can still be written.  Only
+ *  the thread writes its ring; the count of events is published with a
+ *  release store, and the dump reads up to that count.  An event that is
+ *  overwritten while being dumped can come out garbled, which is harmless
+ *  in a trace.
+ */
+
+#include <algorithm>                    /* std::sort()                      */
+#include <atomic>                       /* std::atomic<>                    */
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdio>                       /* std::snprintf()                  */
+#include <fstream>                      /* std::ofstream                    */
+#include <map>                          /* std::map<>                       */
+#include <memory>                       /* std::unique_ptr<>                */
+#include <ostream>                      /* std::ostream                     */
+#include <vector>                       /* std::vector<>                    */
+
+#include "os/perftrace.hpp"             /* seq66::trace_scope class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The count of events kept per thread.  At a thousand output cycles a
+ *  second, with a few patterns playing, this is a few seconds of the output
+ *  thread, and much more of the others.
+ */
+
+static const std::size_t c_trace_events = 65536;
+
+/**
+ *  The count of threads that can be traced: the output, input, and JACK
+ *  threads, the user interface, and some to spare.
+ */
+
+static const int c_trace_threads = 12;
+
+/**
+ *  One traced event.  A duration of -1 marks an instant, as made by
+ *  perftrace_mark().
+ */
+
+class trace_event
+{
+
+public:
+
+    const char * te_name;               /**< The event's string literal.    */
+    long te_start_us;                   /**< The start, from the origin.    */
+    long te_duration_us;                /**< The time taken, or -1.         */
+
+};
+
+/**
+ *  The ring of events of one thread.
+ */
+
+class trace_ring
+{
+
+public:
+
+    std::vector<trace_event> tr_events;         /**< The preallocated ring. */
+    std::atomic<std::size_t> tr_count;          /**< Events ever added.     */
+    int tr_tid;                                 /**< The trace's thread ID. */
+
+    trace_ring (int tid) :
+        tr_events   (c_trace_events),
+        tr_count    (0),
+        tr_tid      (tid)
+    {
+        // no code
+    }
+
+};
+
+/*
+ *  Internal state.  The origin is set when the library is loaded.  A
+ *  thread's ring index is -1 until it claims one, and c_trace_threads if
+ *  none was left.
+ */
+
+static const std::chrono::steady_clock::time_point s_origin =
+    std::chrono::steady_clock::now();
+
+static std::atomic<bool> s_trace_on(false);
+static std::string s_trace_file;
+static std::vector<std::unique_ptr<trace_ring>> s_rings;
+static std::atomic<int> s_rings_claimed(0);
+static thread_local int tl_ring = (-1);
+
+/**
+ *  Gets the microseconds since the origin.
+ */
+
+static long
+trace_us ()
+{
+    auto d = std::chrono::steady_clock::now() - s_origin;
+    return long
+    (
+        std::chrono::duration_cast<std::chrono::microseconds>(d).count()
+    );
+}
+
+/**
+ *  Adds an event to the calling thread's ring, claiming the ring first if
+ *  needed.
+ */
+
+static void
+trace_add (const char * name, long start_us, long duration_us)
+{
+    if (tl_ring < 0)
+    {
+        int r = s_rings_claimed++;
+        tl_ring = r < int(s_rings.size()) ? r : c_trace_threads ;
+    }
+    if (tl_ring >= int(s_rings.size()))
+        return;                                 /* no ring for this thread  */
+
+    trace_ring * ring = s_rings[std::size_t(tl_ring)].get();
+    std::size_t n = ring->tr_count.load(std::memory_order_relaxed);
+    trace_event & te = ring->tr_events[n % c_trace_events];
+    te.te_name = name;
+    te.te_start_us = start_us;
+    te.te_duration_us = duration_us;
+    ring->tr_count.store(n + 1, std::memory_order_release);
+}
+
+/**
+ *  Starts an event, if tracing is on.
+ *
+ * \param name
+ *      The name to show, such as "play cycle".  Must be a string literal.
+ */
+
+trace_scope::trace_scope (const char * name) :
+    m_name      (name),
+    m_start_us  (s_trace_on.load(std::memory_order_relaxed) ? trace_us() : -1)
+{
+    // no code
+}
+
+trace_scope::~trace_scope ()
+{
+    if (m_start_us >= 0)
+        trace_add(m_name, m_start_us, trace_us() - m_start_us);
+}
+
+/**
+ *  Turns on tracing, from the --trace option.  The first time, the rings
+ *  are allocated.
+ *
+ * \param flag
+ *      If true, the trace points record events.
+ *
+ * \param tracefile
+ *      If not empty, the name of the Chrome trace file to write.  Otherwise
+ *      the caller picks one.
+ */
+
+void
+perftrace (bool flag, const std::string & tracefile)
+{
+    if (flag && s_rings.empty())
+    {
+        for (int t = 0; t < c_trace_threads; ++t)
+            s_rings.emplace_back(new trace_ring(t + 1));
+    }
+    s_trace_on = flag;
+    if (! tracefile.empty())
+        s_trace_file = tracefile;
+}
+
+bool
+perftrace ()
+{
+    return s_trace_on;
+}
+
+const std::string &
+perftrace_file ()
+{
+    return s_trace_file;
+}
+
+/**
+ *  Records an instant, such as an output underrun, if tracing is on.
+ *
+ * \param name
+ *      The name to show.  Must be a string literal.
+ */
+
+void
+perftrace_mark (const char * name)
+{
+    if (s_trace_on.load(std::memory_order_relaxed))
+        trace_add(name, trace_us(), -1);
+}
+
+/**
+ *  Writes the events of all of the threads as "complete" and "instant"
+ *  events of the Chrome trace event format.  The names are fixed strings
+ *  in the code, and need no escaping.  Tracing goes on meanwhile.
+ *
+ * \param filename
+ *      The file to write, which is replaced.
+ *
+ * \return
+ *      Returns true if the file was written.
+ */
+
+bool
+perftrace_dump (const std::string & filename)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    bool result = file.is_open();
+    if (result)
+    {
+        int claimed = s_rings_claimed;
+        bool first = true;
+        file << "{\n\"traceEvents\": [\n";
+        for (int r = 0; r < claimed && r < int(s_rings.size()); ++r)
+        {
+            const trace_ring * ring = s_rings[std::size_t(r)].get();
+            std::size_t n = ring->tr_count.load(std::memory_order_acquire);
+            std::size_t i = n > c_trace_events ? n - c_trace_events : 0 ;
+            for ( ; i < n; ++i)
+            {
+                const trace_event & te = ring->tr_events[i % c_trace_events];
+                if (! first)
+                    file << ",\n";
+
+                first = false;
+                file
+                    << "{ \"name\": \"" << te.te_name << "\""
+                    << ", \"cat\": \"engine\", \"ts\": " << te.te_start_us
+                    ;
+                if (te.te_duration_us < 0)
+                    file << ", \"ph\": \"i\", \"s\": \"t\"";
+                else
+                    file << ", \"ph\": \"X\", \"dur\": " << te.te_duration_us;
+
+                file << ", \"pid\": 1, \"tid\": " << ring->tr_tid << " }";
+            }
+        }
+        file << "\n],\n\"displayTimeUnit\": \"ms\"\n}\n";
+        result = file.good();
+    }
+    return result;
+}
+
+/**
+ *  Gets the time on the trace clock, so that a caller can later summarize
+ *  only the events that came after it.
+ */
+
+long
+perftrace_clock ()
+{
+    return trace_us();
+}
+
+/**
+ *  Writes a table of the durations of the traced events, grouped by name:
+ *  the count, mean, median, 95th percentile, and maximum, in milliseconds.
+ *  Used by the --gui-bench option to report the frame times of each
+ *  window's paintEvent().  Instants are skipped.  Only the events still in
+ *  the rings can be counted, so a long run reports its most recent events.
+ *
+ * \param out
+ *      The stream to write, such as std::cout.
+ *
+ * \param since_us
+ *      Events that started before this time, as got from perftrace_clock(),
+ *      are skipped.
+ *
+ * \param match
+ *      If not empty, only names that contain this string are reported, such
+ *      as "paint".
+ *
+ * \return
+ *      Returns the number of names reported.
+ */
+
+int
+perftrace_summary (std::ostream & out, long since_us, const std::string & match)
+{
+    std::map<std::string, std::vector<long>> durations;
+    int claimed = s_rings_claimed;
+    for (int r = 0; r < claimed && r < int(s_rings.size()); ++r)
+    {
+        const trace_ring * ring = s_rings[std::size_t(r)].get();
+        std::size_t n = ring->tr_count.load(std::memory_order_acquire);
+        std::size_t i = n > c_trace_events ? n - c_trace_events : 0 ;
+        for ( ; i < n; ++i)
+        {
+            const trace_event & te = ring->tr_events[i % c_trace_events];
+            if (te.te_duration_us < 0 || te.te_start_us < since_us)
+                continue;
+
+            std::string name = te.te_name;
+            if (match.empty() || name.find(match) != std::string::npos)
+                durations[name].push_back(te.te_duration_us);
+        }
+    }
+
+    char line[128];
+    (void) std::snprintf
+    (
+        line, sizeof line, "%-24s %8s %8s %8s %8s %8s\n",
+        "event", "count", "mean", "p50", "p95", "max"
+    );
+    out << line;
+    for (auto & d : durations)
+    {
+        std::vector<long> & v = d.second;
+        std::sort(v.begin(), v.end());
+
+        double total = 0.0;
+        for (long us : v)
+            total += double(us);
+
+        std::size_t count = v.size();
+        (void) std::snprintf
+        (
+            line, sizeof line, "%-24s %8lu %8.3f %8.3f %8.3f %8.3f\n",
+            d.first.c_str(), static_cast<unsigned long>(count),
+            total / double(count) / 1000.0,
+            double(v[count / 2]) / 1000.0,
+            double(v[(count * 95) / 100]) / 1000.0,
+            double(v.back()) / 1000.0
+        );
+        out << line;
+    }
+    return int(durations.size());
+}
+
+}           // namespace seq66
+
+/*
+ * perftrace.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,286 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          rtsafe.cpp
+ *
+ *  This module defines the memory locking and allocation checks of the
+ *  "rt-safe" mode.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Locking follows the usual recipe for real-time Linux programs: stop
+ *  glibc from handing freed memory back to the kernel or using mmap() for
+ *  big blocks, lock all current and future pages, then touch a block of
+ *  heap so that later allocations are served from memory already locked.
+ *  Pages locked with MCL_FUTURE, such as the stacks of the threads made
+ *  afterward, are faulted in when they are mapped.
+ */
+
+#include <atomic>                       /* std::atomic<long>                */
+#include <cstdlib>                      /* std::malloc(), std::free()       */
+#include <new>                          /* std::bad_alloc, std::nothrow_t   */
+
+#include "os/rtsafe.hpp"                /* seq66::lock_memory() etc.        */
+
+#if defined SEQ66_PLATFORM_LINUX
+#include <malloc.h>                     /* ::mallopt()                      */
+#endif
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <sys/mman.h>                   /* ::mlockall()                     */
+#include <unistd.h>                     /* ::sysconf()                      */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  How much of the stack prefault_stack() touches, and how much heap
+ *  lock_memory() touches by default.
+ */
+
+static const std::size_t c_stack_prefault = 256 * 1024;
+static const std::size_t c_heap_prefault = 8 * 1024 * 1024;
+
+/*
+ *  Marks the threads that must not allocate.  A plain bool needs no
+ *  dynamic initialization, so it can be read from operator new.
+ */
+
+static thread_local bool st_rt_thread = false;
+
+/*
+ *  The count of allocations seen on those threads.
+ */
+
+static std::atomic<long> s_rt_allocations {0};
+
+static std::size_t
+page_size ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    long result = ::sysconf(_SC_PAGESIZE);
+    return result > 0 ? std::size_t(result) : 4096 ;
+#else
+    return 4096;
+#endif
+}
+
+/**
+ *  Locks the process's memory into RAM, and prefaults a block of heap.
+ *  Needs the RLIMIT_MEMLOCK limit to be large enough, e.g. by membership
+ *  in the "audio" group.
+ *
+ * \param heapbytes
+ *      The amount of heap to prefault.  If 0, 8 MB is used.
+ *
+ * \return
+ *      Returns true if the memory could be locked.
+ */
+
+bool
+lock_memory (std::size_t heapbytes)
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+#if defined SEQ66_PLATFORM_LINUX
+    (void) ::mallopt(M_TRIM_THRESHOLD, -1);         /* never give it back   */
+    (void) ::mallopt(M_MMAP_MAX, 0);                /* keep it in the heap  */
+#endif
+    bool result = ::mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    if (result)
+    {
+        if (heapbytes == 0)
+            heapbytes = c_heap_prefault;
+
+        volatile char * heap = static_cast<char *>(std::malloc(heapbytes));
+        if (heap != nullptr)
+        {
+            std::size_t step = page_size();
+            for (std::size_t i = 0; i < heapbytes; i += step)
+                heap[i] = 0;
+
+            std::free(const_cast<char *>(heap));
+        }
+    }
+    return result;
+#else
+    (void) heapbytes;
+    return false;
+#endif
+}
+
+/**
+ *  Touches the top of the calling thread's stack, so that its pages are
+ *  present before the thread's real-time work starts.
+ */
+
+void
+prefault_stack ()
+{
+    volatile char stack[c_stack_prefault];
+    std::size_t step = page_size();
+    for (std::size_t i = 0; i < sizeof stack; i += step)
+        stack[i] = 0;
+}
+
+/**
+ *  Marks or unmarks the calling thread as one that must not allocate.
+ */
+
+void
+rt_thread (bool flag)
+{
+    st_rt_thread = flag;
+}
+
+bool
+rt_thread ()
+{
+    return st_rt_thread;
+}
+
+/**
+ *  Indicates that allocations are checked in this build.
+ */
+
+bool
+rt_check_enabled ()
+{
+#if defined SEQ66_RTSAFE_CHECK
+    return true;
+#else
+    return false;
+#endif
+}
+
+long
+rt_allocations ()
+{
+    return s_rt_allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ *  Called for each allocation made by a marked thread.  It is kept out of
+ *  line, as a place to set a breakpoint.
+ */
+
+void
+rt_allocation_seen ()
+{
+    s_rt_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+}           // namespace seq66
+
+#if defined SEQ66_RTSAFE_CHECK
+
+/*
+ *  The replacements of the global allocation functions.  They behave as
+ *  the standard ones do, apart from the check.
+ */
+
+static void *
+checked_alloc (std::size_t sz)
+{
+    if (seq66::st_rt_thread)
+        seq66::rt_allocation_seen();
+
+    return std::malloc(sz > 0 ? sz : 1);
+}
+
+void *
+operator new (std::size_t sz)
+{
+    void * result = checked_alloc(sz);
+    if (result == nullptr)
+        throw std::bad_alloc();
+
+    return result;
+}
+
+void *
+operator new [] (std::size_t sz)
+{
+    return operator new(sz);
+}
+
+void *
+operator new (std::size_t sz, const std::nothrow_t &) noexcept
+{
+    return checked_alloc(sz);
+}
+
+void *
+operator new [] (std::size_t sz, const std::nothrow_t &) noexcept
+{
+    return checked_alloc(sz);
+}
+
+void
+operator delete (void * p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete [] (void * p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete (void * p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete [] (void * p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete (void * p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete [] (void * p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif      // SEQ66_RTSAFE_CHECK
+
+/*
+ * rtsafe.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,250 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          startupprofile.cpp
+ *
+ *  This module defines the timing of the phases of start-up.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The phases are kept in the order they start, with their nesting depth,
+ *  which is the order in which both the report and the trace list them.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdio>                       /* std::snprintf()                  */
+#include <fstream>                      /* std::ofstream                    */
+#include <vector>                       /* std::vector<>                    */
+
+#include "os/startupprofile.hpp"        /* seq66::startup_phase class       */
+#include "util/basic_macros.hpp"        /* seq66::status_message()          */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  One timed phase.  A duration of -1 marks a phase not yet finished.
+ */
+
+class phase_record
+{
+
+public:
+
+    std::string pr_name;                /**< The name shown for the phase.  */
+    long pr_start_us;                   /**< The start, from the origin.    */
+    long pr_duration_us;                /**< The time taken, or -1.         */
+    int pr_depth;                       /**< The nesting level.             */
+
+};
+
+/*
+ *  Internal state.  The origin is set when the library is loaded.
+ */
+
+static const std::chrono::steady_clock::time_point s_origin =
+    std::chrono::steady_clock::now();
+
+static std::vector<phase_record> s_phases;
+static int s_depth = 0;
+static bool s_profile = false;
+static std::string s_trace_file;
+
+/**
+ *  Gets the microseconds since the origin.
+ */
+
+static long
+elapsed_us ()
+{
+    auto d = std::chrono::steady_clock::now() - s_origin;
+    return long
+    (
+        std::chrono::duration_cast<std::chrono::microseconds>(d).count()
+    );
+}
+
+/**
+ *  Starts a phase.
+ *
+ * \param name
+ *      The name to show, such as "configuration".
+ */
+
+startup_phase::startup_phase (const std::string & name) :
+    m_index (int(s_phases.size()))
+{
+    phase_record pr;
+    pr.pr_name = name;
+    pr.pr_start_us = elapsed_us();
+    pr.pr_duration_us = (-1);
+    pr.pr_depth = s_depth++;
+    s_phases.push_back(pr);
+}
+
+startup_phase::~startup_phase ()
+{
+    finish();
+}
+
+/**
+ *  Ends the phase, if not already ended.
+ */
+
+void
+startup_phase::finish ()
+{
+    if (m_index >= 0)
+    {
+        phase_record & pr = s_phases[std::size_t(m_index)];
+        pr.pr_duration_us = elapsed_us() - pr.pr_start_us;
+        --s_depth;
+        m_index = (-1);
+    }
+}
+
+/**
+ *  Turns on the report, from the --startup-profile option.
+ *
+ * \param flag
+ *      If true, startup_report() shows the phases.
+ *
+ * \param tracefile
+ *      If not empty, the name of a Chrome trace file that startup_report()
+ *      also writes.
+ */
+
+void
+startup_profile (bool flag, const std::string & tracefile)
+{
+    s_profile = flag;
+    if (! tracefile.empty())
+        s_trace_file = tracefile;
+}
+
+bool
+startup_profile ()
+{
+    return s_profile;
+}
+
+/**
+ *  Writes the phases as "complete" events of the Chrome trace event format.
+ *  The names are fixed strings in the code, and need no escaping.
+ */
+
+static bool
+write_trace (const std::string & filename)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    bool result = file.is_open();
+    if (result)
+    {
+        bool first = true;
+        file << "{\n\"traceEvents\": [\n";
+        for (const auto & pr : s_phases)
+        {
+            if (pr.pr_duration_us < 0)
+                continue;
+
+            if (! first)
+                file << ",\n";
+
+            first = false;
+            file
+                << "{ \"name\": \"" << pr.pr_name << "\", \"cat\": \"startup\""
+                << ", \"ph\": \"X\", \"ts\": " << pr.pr_start_us
+                << ", \"dur\": " << pr.pr_duration_us
+                << ", \"pid\": 1, \"tid\": 1 }"
+                ;
+        }
+        file << "\n],\n\"displayTimeUnit\": \"ms\"\n}\n";
+        result = file.good();
+    }
+    return result;
+}
+
+/**
+ *  Shows each phase, indented by its depth, with its start and its
+ *  duration in milliseconds, then the time to this call.  Does nothing
+ *  unless --startup-profile was given.  Called once start-up is done.
+ */
+
+void
+startup_report ()
+{
+    if (! s_profile)
+        return;
+
+    char temp[128];
+    status_message("Startup profile", "start ms, duration ms, phase");
+    for (const auto & pr : s_phases)
+    {
+        std::string name = std::string(std::size_t(pr.pr_depth) * 2, ' ');
+        name += pr.pr_name;
+        if (pr.pr_duration_us < 0)
+        {
+            (void) std::snprintf
+            (
+                temp, sizeof temp, "%9.1f %9s  %s",
+                pr.pr_start_us / 1000.0, "-", name.c_str()
+            );
+        }
+        else
+        {
+            (void) std::snprintf
+            (
+                temp, sizeof temp, "%9.1f %9.1f  %s",
+                pr.pr_start_us / 1000.0, pr.pr_duration_us / 1000.0,
+                name.c_str()
+            );
+        }
+        status_message(temp);
+    }
+    (void) std::snprintf
+    (
+        temp, sizeof temp, "%9.1f %9s  %s", elapsed_us() / 1000.0, "",
+        "ready"
+    );
+    status_message(temp);
+    if (! s_trace_file.empty())
+    {
+        if (write_trace(s_trace_file))
+            file_message("Startup trace", s_trace_file);
+        else
+            file_error("Startup trace", s_trace_file);
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * startupprofile.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
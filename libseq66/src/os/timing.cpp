@@ -21,7 +21,7 @@
  * \library       seq66 application (from PSXC library)
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (pre-Sequencer24/64)
- * \updates       2023-12-22
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Provides support for cross-platform time-related functions.
@@ -50,6 +50,16 @@
 #include <mmsystem.h>                   /* Win32 timeGetTime() [!timeapi.h] */
 #include <synchapi.h>                   /* recent Windows "wait" functions  */
 
+#include <atomic>                       /* std::atomic<bool>                */
+
+/*
+ *  Windows 10 1803 and above.  Older SDKs (and MinGW) lack the flag.
+ */
+
+#if ! defined CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION   0x00000002
+#endif
+
 #endif
 
 /*
@@ -177,11 +187,104 @@ microsleep (int us)
     return result;
 }
 
+/**
+ *  Sleeps until the given absolute time, in microseconds, is reached.  The
+ *  time base is the same CLOCK_MONOTONIC clock used by microtime(), so that
+ *  a deadline can be calculated as "microtime() + delta".  Unlike
+ *  microsleep(), the setup time and any preemption before the call do not
+ *  accumulate, because clock_nanosleep(2) with TIMER_ABSTIME wakes at the
+ *  deadline no matter when it was called.  If interrupted by a signal, the
+ *  wait is resumed.
+ *
+ * \param abstime_us
+ *      Provides the CLOCK_MONOTONIC deadline in microseconds.  If it is
+ *      already in the past, the function returns immediately.
+ *
+ * \return
+ *      Returns true if the deadline was reached without error.
+ */
+
+bool
+microsleep_until (long abstime_us)
+{
+    struct timespec ts;
+    ts.tv_sec = abstime_us / 1000000;
+    ts.tv_nsec = (abstime_us % 1000000) * 1000;
+    int rc;
+    do
+    {
+        rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    } while (rc == EINTR);
+    return rc == 0;
+}
+
 #elif defined SEQ66_PLATFORM_WINDOWS
 
 /**
- *  This implementation comes from https://gist.github.com/ngryman/6482577 and
- *  performs busy-waiting, meaning it will NOT relinquish the processor.
+ *  Set by set_timer_services() if high-resolution waitable timers can be
+ *  made.  Otherwise the timers made are ordinary ones, whose resolution is
+ *  that of timeBeginPeriod().
+ */
+
+static std::atomic<bool> s_high_res_timers(true);
+
+/**
+ *  Creates a waitable timer, a high-resolution one if possible.
+ */
+
+static HANDLE
+create_sleep_timer ()
+{
+    HANDLE result = NULL;
+    if (s_high_res_timers)
+    {
+        result = CreateWaitableTimerExW
+        (
+            NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+            TIMER_ALL_ACCESS
+        );
+        if (result == NULL)
+            s_high_res_timers = false;
+    }
+    if (result == NULL)
+        result = CreateWaitableTimer(NULL, TRUE, NULL);
+
+    return result;
+}
+
+/**
+ *  The waitable timer of a thread, made the first time the thread sleeps
+ *  and closed when the thread ends, instead of being made and closed at
+ *  every sleep.
+ */
+
+class sleep_timer
+{
+
+public:
+
+    HANDLE st_handle;
+
+    sleep_timer () : st_handle (create_sleep_timer())
+    {
+        // no code
+    }
+
+    ~sleep_timer ()
+    {
+        if (st_handle != NULL)
+            CloseHandle(st_handle);
+    }
+
+};
+
+static thread_local sleep_timer tl_sleep_timer;
+
+/**
+ *  Waits on the calling thread's waitable timer, which is high-resolution
+ *  where Windows supports it, and otherwise has the resolution given by
+ *  set_timer_services().  Unlike the earlier version, no timer is created
+ *  or closed per call.
  *
  * \param us
  *      Provides the desired number of microseconds to wait. Must be greater
@@ -198,22 +301,40 @@ microsleep (int us)
     bool result = us > 0;
     if (result)
     {
-        HANDLE timer = CreateWaitableTimer(NULL, TRUE, NULL);
-        bool result = timer != NULL;
+        HANDLE timer = tl_sleep_timer.st_handle;
+        result = timer != NULL;
         if (result)
         {
             LARGE_INTEGER ft;
-            ft.QuadPart = -(10 * (__int64) us);
+            ft.QuadPart = -(10 * (__int64) us);     /* relative, 100 ns     */
             result = SetWaitableTimer(timer, &ft, 0, NULL, NULL, 0) != 0;
             if (result)
                 result = WaitForSingleObject(timer, INFINITE) != WAIT_FAILED;
-
-            CloseHandle(timer);
         }
     }
     return result;
 }
 
+/**
+ *  Windows has no absolute-time sleep on the microtime() clock, so we
+ *  convert the deadline to a relative delay based on microtime() and use
+ *  microsleep(), whose persistent high-resolution timer keeps the error of
+ *  the conversion to well under a millisecond.
+ *
+ * \param abstime_us
+ *      Provides the deadline in microseconds, in the microtime() time base.
+ *
+ * \return
+ *      Returns true if the deadline has passed or the sleep succeeded.
+ */
+
+bool
+microsleep_until (long abstime_us)
+{
+    long us = abstime_us - microtime();
+    return us > 0 ? microsleep(int(us)) : true ;
+}
+
 #endif
 
 /*
@@ -347,6 +468,53 @@ millitime ()
  * --------------------------------------------------------------------------
  */
 
+/**
+ *  Parses a CPU list such as "2,3" or "0,4-7".  Bad items are skipped.
+ *
+ * \param cpus
+ *      The list, as in the 'rc' file.  May be empty.
+ *
+ * \return
+ *      Returns the CPU numbers in the order given.
+ */
+
+std::vector<int>
+parse_cpu_list (const std::string & cpus)
+{
+    std::vector<int> result;
+    std::string::size_type pos = 0;
+    while (pos < cpus.size())
+    {
+        std::string::size_type comma = cpus.find(',', pos);
+        if (comma == std::string::npos)
+            comma = cpus.size();
+
+        std::string item = cpus.substr(pos, comma - pos);
+        std::string::size_type dash = item.find('-');
+        try
+        {
+            if (dash == std::string::npos)
+            {
+                if (! item.empty())
+                    result.push_back(std::stoi(item));
+            }
+            else
+            {
+                int first = std::stoi(item.substr(0, dash));
+                int last = std::stoi(item.substr(dash + 1));
+                for (int c = first; c <= last; ++c)
+                    result.push_back(c);
+            }
+        }
+        catch (...)
+        {
+            // skip a bad item
+        }
+        pos = comma + 1;
+    }
+    return result;
+}
+
 #if defined SEQ66_PLATFORM_UNIX             // LINUX
 
 /**
@@ -380,9 +548,42 @@ millitime ()
 bool
 set_thread_priority (std::thread & t, int p)
 {
-    const int policy = SCHED_FIFO;
-    int minp = sched_get_priority_min(policy);
-    int maxp = sched_get_priority_max(policy);
+    return set_thread_scheduling(t, "fifo", p);
+}
+
+/**
+ *  Sets the scheduling policy and priority of a thread.  SCHED_DEADLINE is
+ *  not offered; it needs the runtime, deadline, and period of the work,
+ *  and the sched_setattr() system call, which glibc does not wrap.
+ *
+ * \param t
+ *      The thread to set.
+ *
+ * \param policy
+ *      "fifo" (SCHED_FIFO), "rr" (SCHED_RR), or "other" (SCHED_OTHER, for
+ *      which the priority is ignored).
+ *
+ * \param p
+ *      The priority, 1 to 99 for the real-time policies.
+ *
+ * \return
+ *      Returns true if the scheduling call succeeded.
+ */
+
+bool
+set_thread_scheduling (std::thread & t, const std::string & policy, int p)
+{
+    int code = SCHED_FIFO;
+    if (policy == "rr")
+        code = SCHED_RR;
+    else if (policy == "other")
+        code = SCHED_OTHER;
+
+    if (code == SCHED_OTHER)
+        p = 0;
+
+    int minp = sched_get_priority_min(code);
+    int maxp = sched_get_priority_max(code);
     if (minp == (-1) || maxp == (-1))
     {
         error_message("Cannot get scheduler priority values");
@@ -394,9 +595,9 @@ set_thread_priority (std::thread & t, int p)
         memset(&schp, 0, sizeof(sched_param));
         schp.sched_priority = p;                /* Linux range: 1 to 99 */
 #if defined SEQ66_PLATFORM_PTHREADS
-        int rc = pthread_setschedparam(t.native_handle(), policy, &schp);
+        int rc = pthread_setschedparam(t.native_handle(), code, &schp);
 #else
-        int rc = sched_setscheduler(t.native_handle(), policy, &schp);
+        int rc = sched_setscheduler(t.native_handle(), code, &schp);
 #endif
         return rc == 0;
     }
@@ -413,6 +614,106 @@ set_thread_priority (std::thread & t, int p)
     }
 }
 
+/**
+ *  Pins a thread to a set of CPUs.  Only Linux supports this at present.
+ *
+ * \param t
+ *      The thread to pin.
+ *
+ * \param cpus
+ *      The CPU numbers.  If empty, nothing is done.
+ *
+ * \return
+ *      Returns true if the thread was pinned.
+ */
+
+bool
+set_thread_affinity (std::thread & t, const std::vector<int> & cpus)
+{
+#if defined SEQ66_PLATFORM_LINUX
+    bool result = false;
+    if (! cpus.empty())
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (int c : cpus)
+        {
+            if (c >= 0 && c < CPU_SETSIZE)
+            {
+                CPU_SET(c, &cpuset);
+                result = true;
+            }
+        }
+        if (result)
+        {
+            int rc = pthread_setaffinity_np
+            (
+                t.native_handle(), sizeof cpuset, &cpuset
+            );
+            result = rc == 0;
+        }
+    }
+    return result;
+#else
+    (void) t;
+    (void) cpus;
+    return false;
+#endif
+}
+
+/**
+ *  Describes the scheduling of a thread, for the log.
+ *
+ * \return
+ *      Returns a string such as "SCHED_FIFO 80, CPUs 2,3".
+ */
+
+std::string
+thread_scheduling (std::thread & t)
+{
+    std::string result;
+    int policy = SCHED_OTHER;
+    struct sched_param schp;
+    memset(&schp, 0, sizeof(sched_param));
+    if (pthread_getschedparam(t.native_handle(), &policy, &schp) == 0)
+    {
+        if (policy == SCHED_FIFO)
+            result = "SCHED_FIFO ";
+        else if (policy == SCHED_RR)
+            result = "SCHED_RR ";
+        else
+            result = "SCHED_OTHER ";
+
+        result += std::to_string(schp.sched_priority);
+    }
+#if defined SEQ66_PLATFORM_LINUX
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    int rc = pthread_getaffinity_np(t.native_handle(), sizeof cpuset, &cpuset);
+    if (rc == 0)
+    {
+        std::string list;
+        int count = 0;
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+        {
+            if (CPU_ISSET(c, &cpuset))
+            {
+                if (! list.empty())
+                    list += ",";
+
+                list += std::to_string(c);
+                ++count;
+            }
+        }
+        if (count < int(std::thread::hardware_concurrency()))
+            result += ", CPUs " + list;
+        else
+            result += ", any CPU";
+    }
+#endif
+    return result;
+}
+
 /**
  *  Linux doesn't need this, so we just act like it works.
  */
@@ -467,14 +768,48 @@ set_thread_priority (std::thread & t, int p)
 #endif
 }
 
+bool
+set_thread_scheduling (std::thread & t, const std::string & /*policy*/, int p)
+{
+    return set_thread_priority(t, p);
+}
+
+bool
+set_thread_affinity (std::thread & /*t*/, const std::vector<int> & /*cpus*/)
+{
+    return false;                       /* to do, if possible               */
+}
+
+std::string
+thread_scheduling (std::thread & /*t*/)
+{
+    return std::string();
+}
+
 /**
  *  Necessary for proper input and output timing using our portmidi
- *  implementation under windows.
+ *  implementation under windows.  Also checks, when turning the services
+ *  on, that high-resolution waitable timers can be made, so that the
+ *  sleeps of the I/O threads fall back to ordinary timers at the 1 ms
+ *  resolution set here if they cannot.
  */
 
 bool
 set_timer_services (bool on)
 {
+    if (on)
+    {
+        HANDLE probe = CreateWaitableTimerExW
+        (
+            NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+            TIMER_ALL_ACCESS
+        );
+        s_high_res_timers = probe != NULL;
+        if (probe != NULL)
+            CloseHandle(probe);
+        else
+            info_message("No high-resolution timers; using 1 ms timer period");
+    }
     MMRESULT mmr = on ? timeBeginPeriod(1) : timeEndPeriod(1) ;
     return mmr == TIMERR_NOERROR;
 }
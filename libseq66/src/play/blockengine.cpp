@@ -0,0 +1,292 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          blockengine.cpp
+ *
+ *  This module defines the playback of a performer one audio block at a
+ *  time, for a plugin host.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A block covers the ticks from its start position, inclusive, to the
+ *  start of the next block, exclusive.  The integer ticks in that range are
+ *  played as one frame, exactly as performer::play() plays the frame of the
+ *  output thread, so queueing, one-shots, and Song-mode triggers behave the
+ *  same.  The position is kept as a fractional tick, so that blocks shorter
+ *  than a tick, at a low PPQN, lose no time.
+ */
+
+#include <cmath>                        /* std::ceil(), std::fabs()         */
+
+#include "play/blockengine.hpp"         /* seq66::blockengine class         */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Principal constructor.  The performer must have its patterns, but is not
+ *  to be launched.
+ *
+ * \param p
+ *      The performer to play.
+ */
+
+blockengine::blockengine (performer & p) :
+    m_perf          (p),
+    m_pool          (0),
+    m_play_job
+    (
+        [this] (int)
+        {
+            bool resume = m_perf.resume_note_ons();
+            if (m_perf.song_mode())
+            {
+                m_perf.play_song(m_block_tick);
+            }
+            else
+            {
+                m_perf.play_boundaries(m_block_tick, resume);
+                for (auto seqi : m_perf.play_set().seq_container())
+                {
+                    if (seqi)
+                        seqi->play_frame(m_block_tick, false, resume);
+                }
+            }
+        }
+    ),
+    m_stop_job
+    (
+        [this] (int)
+        {
+            bool songmode = m_perf.song_mode();
+            for (auto seqi : m_perf.play_set().seq_container())
+            {
+                if (seqi)
+                    seqi->stop(songmode);
+            }
+        }
+    ),
+    m_block_tick    (0),
+    m_playing       (false),
+    m_position      (0.0)
+{
+    // no code
+}
+
+/**
+ *  Renders one block.  Called by the host from its audio thread.
+ *
+ * \param frames
+ *      The number of audio frames in the block.
+ *
+ * \param samplerate
+ *      The sample rate, in frames per second.
+ *
+ * \param t
+ *      The host's transport at the start of the block.
+ *
+ * \param in
+ *      The MIDI events received during the block, in frame order.
+ *
+ * \param [out] out
+ *      Cleared, then filled with the MIDI events of the block, in frame
+ *      order.  The host should reserve it, so that it does not grow while
+ *      playing.
+ */
+
+void
+blockengine::process
+(
+    int frames,
+    int samplerate,
+    const transport & t,
+    const blockevents & in,
+    blockevents & out
+)
+{
+    out.clear();
+    if (frames <= 0 || samplerate <= 0)
+        return;
+
+    midibpm bpm = t.m_bpm > 0.0 ? t.m_bpm : m_perf.get_beats_per_minute() ;
+    double ppqn = double(m_perf.ppqn());
+    double ticksperframe = bpm * ppqn / (60.0 * double(samplerate));
+    double start = t.m_has_position ? t.m_beats * ppqn : m_position ;
+    if (start < 0.0)
+        start = 0.0;
+
+    if (! t.m_playing)
+    {
+        if (m_playing)
+            stop_patterns(out);
+
+        m_playing = false;
+        m_position = start;
+        for (const auto & be : in)
+            handle_input(be, midipulse(start));
+
+        return;
+    }
+
+    bool jumped = m_playing && std::fabs(start - m_position) >= 1.0;
+    if (jumped)
+        stop_patterns(out);                     /* end the sounding notes   */
+
+    midipulse first = midipulse(std::ceil(start));
+    if (! m_playing || jumped)
+        m_perf.set_last_ticks(first);
+
+    m_playing = true;
+    for (const auto & be : in)
+        handle_input(be, midipulse(start + be.m_frame * ticksperframe));
+
+    double end = start + frames * ticksperframe;
+    midipulse last = midipulse(std::ceil(end)) - 1;
+    if (last >= first)
+    {
+        m_block_tick = last;
+        m_perf.set_tick(last);                  /* for the user interface   */
+        (void) m_perf.apply_bulk_ops();         /* frame boundary           */
+        collect(m_pool.run(1, m_play_job), start, ticksperframe, frames, out);
+    }
+    m_position = end;
+}
+
+/**
+ *  Stops the patterns and rewinds to the start of the song, as when the
+ *  plugin is deactivated.
+ *
+ * \param [out] out
+ *      Cleared, then filled with the note-offs of the notes that were
+ *      sounding, at frame 0.
+ */
+
+void
+blockengine::reset (blockevents & out)
+{
+    out.clear();
+    if (m_playing)
+        stop_patterns(out);
+
+    m_playing = false;
+    m_position = 0.0;
+}
+
+/**
+ *  Hands an incoming event to the MIDI controls, or, if not a control, to
+ *  the patterns that are recording, as performer::poll_cycle() does.
+ *  System messages are ignored; the host owns the transport.
+ */
+
+void
+blockengine::handle_input (const blockevent & be, midipulse tick)
+{
+    event ev = be.m_event;
+    ev.set_input_bus(be.m_bus);
+    ev.set_timestamp(tick);
+    if (ev.below_sysex())
+    {
+        bool recording = false;
+        for (auto seqi : m_perf.play_set().seq_container())
+        {
+            if (seqi && seqi->recording())
+            {
+                recording = true;
+                break;
+            }
+        }
+        if (! m_perf.midi_control_event(ev, recording) && recording)
+        {
+            for (auto seqi : m_perf.play_set().seq_container())
+            {
+                if (seqi && seqi->recording())
+                {
+                    event e = ev;                   /* each mods its copy   */
+                    (void) seqi->stream_event(e);
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  Stops the play-set, putting the resulting note-offs at the start of the
+ *  block.
+ */
+
+void
+blockengine::stop_patterns (blockevents & out)
+{
+    for (auto & m : m_pool.run(1, m_stop_job))
+    {
+        event ev = m.m_event;
+        if (ev.has_channel())
+            ev.set_status(ev.get_status(m.m_channel));
+
+        out.emplace_back(0, m.m_bus, ev);
+    }
+}
+
+/**
+ *  Converts the events captured from the patterns to frame offsets in the
+ *  block.  The events are in timestamp order, so the output is in frame
+ *  order.
+ */
+
+void
+blockengine::collect
+(
+    playpool::messages & msgs, double start,
+    double ticksperframe, int frames, blockevents & out
+)
+{
+    for (auto & m : msgs)
+    {
+        event ev = m.m_event;
+        int frame = int((double(ev.timestamp()) - start) / ticksperframe);
+        if (frame < 0)
+            frame = 0;
+        else if (frame >= frames)
+            frame = frames - 1;
+
+        if (ev.has_channel())
+            ev.set_status(ev.get_status(m.m_channel));
+
+        out.emplace_back(frame, m.m_bus, ev);
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * blockengine.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
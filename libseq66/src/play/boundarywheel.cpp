@@ -0,0 +1,225 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          boundarywheel.cpp
+ *
+ *  This module defines the timer wheel of the queued and one-shot
+ *  boundaries of the patterns.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The slots and lists are reserved up front, so that the output thread
+ *  does not allocate unless a great many patterns are queued at once.
+ */
+
+#include "play/boundarywheel.hpp"       /* seq66::boundarywheel class       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The number of slots in the wheel.  With a slot a sixteenth note wide,
+ *  the wheel spans sixteen measures of 4/4.
+ */
+
+static const int c_wheel_slots = 256;
+
+/**
+ *  The room reserved in each slot, and in the list of posted boundaries.
+ */
+
+static const std::size_t c_slot_reserve = 8;
+static const std::size_t c_posted_reserve = 64;
+
+boundarywheel::boundarywheel () :
+    m_slots         (c_wheel_slots),
+    m_posted        (),
+    m_have_posted   (false),
+    m_mutex         (),
+    m_width         (0),
+    m_cursor        (0),
+    m_count         (0)
+{
+    for (auto & s : m_slots)
+        s.reserve(c_slot_reserve);
+
+    m_posted.reserve(c_posted_reserve);
+}
+
+/**
+ *  Posts a boundary.  Called by whatever thread queues the pattern.
+ *
+ * \param s
+ *      The pattern.
+ *
+ * \param tick
+ *      The tick at which it is to change its playing status.
+ */
+
+void
+boundarywheel::post (sequence * s, midipulse tick)
+{
+    automutex locker(m_mutex);
+    boundary b;
+    b.bw_seq = s;
+    b.bw_tick = tick;
+    m_posted.push_back(b);
+    m_have_posted = true;
+}
+
+/**
+ *  Moves the wheel to the tick of the frame, and gets the patterns whose
+ *  boundary is no later than that tick.  Called by the output thread.
+ *
+ * \param tick
+ *      The tick of the frame.
+ *
+ * \param ppqn
+ *      The current PPQN, which sets the width of a slot.
+ *
+ * \param [out] due
+ *      The patterns due are appended here.  A pattern can show up more
+ *      than once.
+ */
+
+void
+boundarywheel::advance (midipulse tick, int ppqn, patterns & due)
+{
+    midipulse width = ppqn >= 4 ? midipulse(ppqn / 4) : 1 ;
+    if (width != m_width)
+        regauge(width);
+
+    if (m_have_posted)
+        take_posted();
+
+    if (m_count > 0)
+    {
+        midipulse slots = tick / m_width - m_cursor / m_width;
+        if (tick < m_cursor || slots >= c_wheel_slots)
+        {
+            for (auto & s : m_slots)                /* rewind or big jump   */
+                sweep(s, tick, due);
+        }
+        else
+        {
+            int index = slot_index(m_cursor);
+            for (midipulse n = 0; n <= slots; ++n)
+            {
+                sweep(m_slots[std::size_t(index)], tick, due);
+                if (++index == c_wheel_slots)
+                    index = 0;
+            }
+        }
+    }
+    m_cursor = tick;
+}
+
+int
+boundarywheel::slot_index (midipulse tick) const
+{
+    return int((tick / m_width) % c_wheel_slots);
+}
+
+/**
+ *  Moves the posted boundaries into the wheel.
+ */
+
+void
+boundarywheel::take_posted ()
+{
+    automutex locker(m_mutex);
+    for (const auto & b : m_posted)
+        insert(b);
+
+    m_posted.clear();
+    m_have_posted = false;
+}
+
+/**
+ *  Puts a boundary in its slot.  One already past goes into the slot of the
+ *  cursor, which the next advance() visits first.
+ */
+
+void
+boundarywheel::insert (const boundary & b)
+{
+    midipulse t = b.bw_tick > m_cursor ? b.bw_tick : m_cursor ;
+    m_slots[std::size_t(slot_index(t))].push_back(b);
+    ++m_count;
+}
+
+/**
+ *  Changes the width of the slots, as when a song of another PPQN is
+ *  loaded, and puts every boundary back in its proper slot.
+ */
+
+void
+boundarywheel::regauge (midipulse width)
+{
+    std::vector<boundary> all;
+    for (auto & s : m_slots)
+    {
+        all.insert(all.end(), s.begin(), s.end());
+        s.clear();
+    }
+    m_width = width;
+    m_count = 0;
+    for (const auto & b : all)
+        insert(b);
+}
+
+/**
+ *  Takes the due boundaries out of a slot.  The order within a slot does
+ *  not matter, so the last one fills each hole.
+ */
+
+void
+boundarywheel::sweep (slot & s, midipulse tick, patterns & due)
+{
+    std::size_t i = 0;
+    while (i < s.size())
+    {
+        if (s[i].bw_tick <= tick)
+        {
+            due.push_back(s[i].bw_seq);
+            s[i] = s.back();
+            s.pop_back();
+            --m_count;
+        }
+        else
+            ++i;
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * boundarywheel.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,201 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          bulkops.cpp
+ *
+ *  This module defines the pending bulk operations on whole screen-sets.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Posting never waits and never allocates, and is safe from any thread.
+ *  Applying takes the whole pending operation at once, by an exchange, so
+ *  that an operation posted meanwhile waits for the next frame instead of
+ *  being half applied.
+ */
+
+#include "cfg/rcsettings.hpp"           /* seq66::c_max_sets                */
+#include "play/bulkops.hpp"             /* seq66::bulkops class             */
+#include "play/sequence.hpp"            /* seq66::sequence class            */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+static_assert(c_max_sets <= 32, "bulkops has only 32 bits of sets");
+
+/**
+ *  The pending masks when nothing is pending: and with all ones, xor with
+ *  none.
+ */
+
+static const std::uint64_t c_identity = 0x00000000FFFFFFFFULL;
+
+bulkops::bulkops () :
+    m_armed_masks   (c_identity),
+    m_song_toggles  (0)
+{
+    // no code
+}
+
+/**
+ *  Gets the bit of a set.
+ *
+ * \param setno
+ *      The set number.
+ *
+ * \return
+ *      Returns the bit, or 0 if the set number is out of range.
+ */
+
+bulkops::bits
+bulkops::set_bit (int setno)
+{
+    return setno >= 0 && setno < c_max_sets ? bits(1) << setno : 0 ;
+}
+
+/**
+ *  Folds an operation on the armed statuses into the pending operation.
+ *
+ * \param o
+ *      The operation.
+ *
+ * \param sets
+ *      The sets it applies to.  The other sets are left alone.
+ */
+
+void
+bulkops::post (op o, bits sets)
+{
+    bits a2 = ~sets;                    /* the other sets keep their status */
+    bits x2 = 0;
+    if (o == op::arm)
+        x2 = sets;
+    else if (o == op::toggle)
+    {
+        a2 = ~bits(0);
+        x2 = sets;
+    }
+
+    std::uint64_t old = m_armed_masks.load(std::memory_order_relaxed);
+    std::uint64_t masks;
+    do
+    {
+        bits a1 = bits(old);
+        bits x1 = bits(old >> 32);
+        bits a = a1 & a2;
+        bits x = (x1 & a2) ^ x2;
+        masks = (std::uint64_t(x) << 32) | std::uint64_t(a);
+
+    } while
+    (
+        ! m_armed_masks.compare_exchange_weak
+        (
+            old, masks, std::memory_order_acq_rel, std::memory_order_relaxed
+        )
+    );
+}
+
+/**
+ *  Adds song-mute toggles of whole sets.  Two toggles cancel out.
+ */
+
+void
+bulkops::post_song_toggle (bits sets)
+{
+    (void) m_song_toggles.fetch_xor(sets, std::memory_order_acq_rel);
+}
+
+bool
+bulkops::armed_pending () const
+{
+    return m_armed_masks.load(std::memory_order_acquire) != c_identity;
+}
+
+/**
+ *  Takes the pending operations and applies them to the patterns of the
+ *  play-set.  Called by the output thread at the top of a frame, or by the
+ *  thread that changes the play-set, just before it does so.
+ *
+ * \param seqs
+ *      The patterns of the play-set.
+ *
+ * \param setsize
+ *      The number of patterns in a set, to find the set of each pattern.
+ *
+ * \return
+ *      Returns the number of patterns changed.
+ */
+
+int
+bulkops::apply (array & seqs, int setsize)
+{
+    int result = 0;
+    if (setsize <= 0 || ! pending())
+        return result;
+
+    std::uint64_t masks = m_armed_masks.exchange
+    (
+        c_identity, std::memory_order_acq_rel
+    );
+    bits toggles = m_song_toggles.exchange(0, std::memory_order_acq_rel);
+    bits a = bits(masks);
+    bits x = bits(masks >> 32);
+    for (auto & sp : seqs)
+    {
+        if (! sp || ! sequence::is_normal(sp->seq_number()))
+            continue;
+
+        bits b = set_bit(sp->seq_number() / setsize);
+        if (b == 0)
+            continue;
+
+        if ((toggles & b) != 0)
+        {
+            sp->toggle_song_mute();
+            ++result;
+        }
+        if ((a & b) == 0 || (x & b) != 0)
+        {
+            bool armed = sp->armed();
+            bool flag = ((a & b) != 0 && armed) != ((x & b) != 0);
+            if (flag != armed)
+            {
+                sp->set_armed(flag);
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * bulkops.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
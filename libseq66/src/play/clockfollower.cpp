@@ -0,0 +1,196 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          clockfollower.cpp
+ *
+ *  This module defines the follower for incoming MIDI clock.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The loop bandwidth is a fixed fraction of the clock rate.  With an omega
+ *  of 0.1 per clock, it is about 0.75 Hz at 120 BPM (48 clocks a second),
+ *  which rejects the millisecond-scale jitter of USB MIDI interfaces while
+ *  following a tempo change within a beat or two.
+ */
+
+#include "play/clockfollower.hpp"       /* seq66::clockfollower class       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The normalized bandwidth of the loop, 2 pi B T, and the loop
+ *  coefficients derived from it for critical damping (b = sqrt(2) omega).
+ */
+
+static const double c_omega = 0.1;
+static const double c_dll_b = 1.4142135623730951 * c_omega;
+static const double c_dll_c = c_omega * c_omega;
+
+/**
+ *  A clock that arrives more than this many periods late is taken as a
+ *  dropout (the master paused, or was changed), and the loop locks again
+ *  from scratch.
+ */
+
+static const double c_dropout_periods = 4.0;
+
+clockfollower::clockfollower () :
+    m_mutex         (),
+    m_increment     (0),
+    m_pulses        (0),
+    m_locked        (false),
+    m_t0            (0.0),
+    m_t1            (0.0),
+    m_period        (0.0),
+    m_reported      (0)
+{
+    // no code
+}
+
+/**
+ *  Starts over, as for MIDI Start or Continue.
+ *
+ * \param increment
+ *      The number of MIDI ticks per clock.
+ */
+
+void
+clockfollower::reset (int increment)
+{
+    automutex locker(m_mutex);
+    m_increment = increment;
+    m_pulses = 0;
+    m_locked = false;
+    m_t0 = m_t1 = m_period = 0.0;
+    m_reported = 0;
+}
+
+/**
+ *  Feeds the loop with the arrival of a clock.  The first clock sets the
+ *  phase, the second the period, and each later one corrects both by a
+ *  fraction of the error between its arrival and the predicted time.
+ *
+ * \param us
+ *      The arrival time of the clock, from microtime().
+ */
+
+void
+clockfollower::pulse (long us)
+{
+    automutex locker(m_mutex);
+    double t = double(us);
+    ++m_pulses;
+    if (m_pulses == 1)
+    {
+        m_t0 = m_t1 = t;
+    }
+    else if (! m_locked)
+    {
+        m_period = t - m_t0;
+        if (m_period > 0.0)
+        {
+            m_t0 = t;
+            m_t1 = t + m_period;
+            m_locked = true;
+        }
+        else
+            m_t0 = m_t1 = t;
+    }
+    else
+    {
+        double e = t - m_t1;
+        if (e > c_dropout_periods * m_period || e < -m_period)
+        {
+            m_t0 = m_t1 = t;                    /* lock again from here     */
+            m_locked = false;
+        }
+        else
+        {
+            m_t0 = m_t1;
+            m_t1 += c_dll_b * e + m_period;
+            m_period += c_dll_c * e;
+        }
+    }
+}
+
+/**
+ *  Gets the ticks to play since the last call.  The position is that of
+ *  the latest clock plus the fraction of the period elapsed since it, but
+ *  never beyond the next clock, which must arrive before playback goes on.
+ *
+ * \param us
+ *      The current time, from microtime().
+ *
+ * \return
+ *      Returns the whole ticks the position has advanced, which is never
+ *      negative.
+ */
+
+long
+clockfollower::advance (long us)
+{
+    automutex locker(m_mutex);
+    double position = double(m_pulses);
+    if (m_locked && m_t1 > m_t0)
+    {
+        double fraction = (double(us) - m_t0) / (m_t1 - m_t0);
+        if (fraction > 1.0)
+            fraction = 1.0;
+        else if (fraction < 0.0)
+            fraction = 0.0;
+
+        position += fraction;
+    }
+
+    long target = long(position * m_increment);
+    long result = target > m_reported ? target - m_reported : 0 ;
+    m_reported += result;
+    return result;
+}
+
+/**
+ * \return
+ *      Returns the tempo estimated from the clock period, or 0 if it is not
+ *      yet known.
+ */
+
+double
+clockfollower::bpm () const
+{
+    automutex locker(m_mutex);
+    return m_locked && m_period > 0.0 ? 60000000.0 / (24.0 * m_period) : 0.0 ;
+}
+
+}           // namespace seq66
+
+/*
+ * clockfollower.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,241 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          editjob.cpp
+ *
+ *  This module defines the running of a long pattern edit on a worker
+ *  thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The worker is an ordinary thread, not a real-time one, that lives for
+ *  one edit.  The edits that matter take a good fraction of a second or
+ *  more, next to which starting a thread costs nothing.
+ */
+
+#include <new>                          /* std::nothrow                     */
+
+#include "play/editjob.hpp"             /* seq66::editjob class             */
+#include "play/sequence.hpp"            /* seq66::sequence class            */
+#include "util/basic_macros.hpp"        /* seq66::warn_message()            */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/*
+ *  No job runs on a thread until run() sets it.
+ */
+
+thread_local editjob * editjob::st_current = nullptr;
+
+/**
+ *  Sets up the job.  Nothing is copied until start().
+ *
+ * \param target
+ *      The pattern to edit.
+ *
+ * \param name
+ *      The name of the edit, such as "Quantize", for messages.
+ *
+ * \param op
+ *      The edit.  See the operation type.
+ */
+
+editjob::editjob (seq::pointer target, const std::string & name, operation op) :
+    m_target        (target),
+    m_scratch       (),
+    m_name          (name),
+    m_operation     (op),
+    m_base          (),
+    m_thread        (),
+    m_status        (status::idle),
+    m_percent       (0),
+    m_cancel        (false)
+{
+    // no code
+}
+
+/**
+ *  A job dropped while running is cancelled, and waited for, as its thread
+ *  uses the members.
+ */
+
+editjob::~editjob ()
+{
+    cancel();
+    join();
+}
+
+/**
+ *  Starts the worker thread.
+ *
+ * \return
+ *      Returns false if the job has no pattern or operation, or was
+ *      already started.
+ */
+
+bool
+editjob::start ()
+{
+    bool result = m_target && bool(m_operation) && state() == status::idle;
+    if (result)
+    {
+        m_status.store(status::running, std::memory_order_release);
+        m_thread = std::thread(&editjob::run, this);
+    }
+    return result;
+}
+
+/**
+ *  Asks the operation to stop at its next checkpoint().  A job that is
+ *  done but not yet applied is cancelled at once.
+ */
+
+void
+editjob::cancel ()
+{
+    m_cancel.store(true, std::memory_order_relaxed);
+}
+
+/**
+ *  The worker thread.  The scratch pattern is made here, rather than by
+ *  the caller, so that the copy of a big pattern does not stall the user
+ *  interface either.
+ */
+
+void
+editjob::run ()
+{
+    st_current = this;
+    m_scratch.reset(new (std::nothrow) sequence(int(m_target->get_ppqn())));
+
+    status s = status::cancelled;
+    if (m_scratch)
+    {
+        m_base = m_target->copy_for_edit(*m_scratch);
+        if (! cancelled())
+        {
+            bool changed = m_operation(*m_scratch);
+            if (cancelled())
+                s = status::cancelled;
+            else
+                s = changed ? status::done : status::unchanged ;
+        }
+    }
+    else
+        s = status::unchanged;
+
+    m_percent.store(100, std::memory_order_relaxed);
+    st_current = nullptr;
+    m_status.store(s, std::memory_order_release);
+}
+
+void
+editjob::join ()
+{
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+/**
+ *  Swaps the result of a finished job into the pattern.  Must be called by
+ *  the thread that would otherwise have made the edit (the GUI thread),
+ *  once finished() is true.
+ *
+ * \return
+ *      Returns true if the edit was applied.  If the pattern was changed
+ *      while the job ran, a warning is logged, and nothing is changed.
+ */
+
+bool
+editjob::apply ()
+{
+    if (! finished())
+        return false;
+
+    join();
+
+    bool result = state() == status::done && ! cancelled();
+    if (result)
+    {
+        result = m_target->adopt_edit(*m_scratch, m_base);
+        if (result)
+        {
+            m_status.store(status::applied, std::memory_order_release);
+        }
+        else
+        {
+            m_status.store(status::conflict, std::memory_order_release);
+            warn_message(m_name, "pattern changed during the edit; not done");
+        }
+    }
+    else if (state() == status::done)
+        m_status.store(status::cancelled, std::memory_order_release);
+
+    m_scratch.reset();
+    m_base.reset();
+    return result;
+}
+
+/**
+ *  Called by the loops of the heavy edits.  On a thread with no job, such
+ *  as when the edit is made directly by the GUI, it does nothing.
+ *
+ * \param done
+ *      The items done so far.
+ *
+ * \param total
+ *      The items in all.
+ *
+ * \return
+ *      Returns false if the job was cancelled, and the loop should stop.
+ */
+
+bool
+editjob::checkpoint (std::size_t done, std::size_t total)
+{
+    editjob * job = st_current;
+    if (is_nullptr(job))
+        return true;
+
+    if (total > 0)
+    {
+        int p = int(done * 100 / total);
+        if (p != job->m_percent.load(std::memory_order_relaxed))
+            job->m_percent.store(p, std::memory_order_relaxed);
+    }
+    return ! job->cancelled();
+}
+
+}           // namespace seq66
+
+/*
+ * editjob.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
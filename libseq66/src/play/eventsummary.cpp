@@ -0,0 +1,252 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          eventsummary.cpp
+ *
+ *  This module defines the multi-resolution summary of events used for
+ *  drawing zoomed-out pattern editors.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Each level is made from the one below it, which is already sorted and
+ *  merged, so building the pyramid costs a sort plus one pass per width.
+ *  A level is kept only if it has at most 3/4 of the spans of the last
+ *  level kept, so the whole pyramid is at most four times the size of
+ *  level 0.  Building stops once the spans are down to one, or the buckets
+ *  are wider than everything summarized.
+ */
+
+#include <algorithm>                    /* std::sort(), std::lower_bound()  */
+
+#include "play/eventsummary.hpp"        /* seq66::eventsummary class        */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The bucket width is limited to 2^31 ticks, more than a day even at high
+ *  PPQN.
+ */
+
+static const int c_max_widths = 32;
+
+/**
+ *  Creates an empty summary.
+ *
+ * \param runs
+ *      If true, spans in adjacent buckets are merged into runs.
+ */
+
+eventsummary::eventsummary (bool runs) :
+    m_runs      (runs),
+    m_levels    (),
+    m_widths    ()
+{
+    // no code
+}
+
+void
+eventsummary::clear ()
+{
+    m_levels.clear();
+    m_widths.clear();
+}
+
+/**
+ *  Adds an event to level 0.  Call build() after adding all of them.
+ *
+ * \param start
+ *      The tick of the event, or of the start of the note.
+ *
+ * \param end
+ *      The last tick covered.  For an event with no length, this is the
+ *      same as the start.
+ *
+ * \param value
+ *      The value to summarize, such as the controller value.
+ *
+ * \param selected
+ *      Indicates that the event is selected.
+ *
+ * \param flagged
+ *      Marks the event as special, such as an unlinked note.
+ */
+
+void
+eventsummary::add
+(
+    midipulse start, midipulse end, int value, bool selected, bool flagged
+)
+{
+    if (m_levels.empty())
+    {
+        m_levels.push_back(spans());
+        m_widths.push_back(1);
+    }
+
+    span s;
+    s.sp_start = start;
+    s.sp_end = end >= start ? end : start ;
+    s.sp_min = s.sp_max = value;
+    s.sp_selected = selected;
+    s.sp_flagged = flagged;
+    m_levels[0].push_back(s);
+}
+
+/**
+ *  Snaps the spans to buckets of the given width and merges the ones that
+ *  share (or, in run mode, adjoin) a bucket.  The spans must be sorted by
+ *  start tick, and stay so.
+ */
+
+void
+eventsummary::merge (spans & sp, midipulse bucket)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < sp.size(); ++i)
+    {
+        span s = sp[i];
+        s.sp_start -= s.sp_start % bucket;
+        s.sp_end += bucket - 1 - s.sp_end % bucket;
+        if (kept > 0)
+        {
+            span & last = sp[kept - 1];
+            midipulse limit = m_runs ? last.sp_end + 1 : last.sp_end ;
+            if (s.sp_start <= limit)
+            {
+                if (s.sp_end > last.sp_end)
+                    last.sp_end = s.sp_end;
+
+                if (s.sp_min < last.sp_min)
+                    last.sp_min = s.sp_min;
+
+                if (s.sp_max > last.sp_max)
+                    last.sp_max = s.sp_max;
+
+                last.sp_selected = last.sp_selected || s.sp_selected;
+                last.sp_flagged = last.sp_flagged || s.sp_flagged;
+                continue;
+            }
+        }
+        sp[kept++] = s;
+    }
+    sp.resize(kept);
+}
+
+/**
+ *  Sorts level 0, then builds the coarser levels from it.
+ */
+
+void
+eventsummary::build ()
+{
+    if (empty())
+        return;
+
+    m_levels.resize(1);
+    m_widths.resize(1);
+
+    spans & base = m_levels[0];
+    std::stable_sort
+    (
+        base.begin(), base.end(),
+        [] (const span & a, const span & b)
+        {
+            return a.sp_start < b.sp_start;
+        }
+    );
+    merge(base, 1);
+
+    midipulse last = 0;
+    for (const auto & s : base)
+    {
+        if (s.sp_end > last)
+            last = s.sp_end;
+    }
+    spans current(base);
+    for (int power = 1; power < c_max_widths; ++power)
+    {
+        midipulse bucket = midipulse(1) << power;
+        if (current.size() <= 1 || bucket / 2 > last)
+            break;
+
+        merge(current, bucket);
+        if (current.size() * 4 <= m_levels.back().size() * 3)
+        {
+            m_levels.push_back(current);
+            m_widths.push_back(bucket);
+        }
+    }
+}
+
+/**
+ *  Finds the coarsest level whose buckets are no wider than a pixel.
+ *
+ * \param ticks_per_pixel
+ *      The number of ticks covered by one pixel column.
+ *
+ * \return
+ *      Returns the level number, 0 if the summary is empty.
+ */
+
+int
+eventsummary::level_for (midipulse ticks_per_pixel) const
+{
+    int result = 0;
+    while (result + 1 < level_count() && width(result + 1) <= ticks_per_pixel)
+        ++result;
+
+    return result;
+}
+
+/**
+ *  Finds the first span of a level that reaches the given tick.  The spans
+ *  of a level do not overlap, so their end ticks are sorted too.
+ */
+
+eventsummary::spans::const_iterator
+eventsummary::first (int lvl, midipulse tick) const
+{
+    const spans & sp = level(lvl);
+    return std::lower_bound
+    (
+        sp.cbegin(), sp.cend(), tick,
+        [] (const span & s, midipulse tk)
+        {
+            return s.sp_end < tk;
+        }
+    );
+}
+
+}           // namespace seq66
+
+/*
+ * eventsummary.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,357 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          framebatch.cpp
+ *
+ *  This module defines the per-buss batches of a frame's output.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include <algorithm>                    /* std::stable_sort()               */
+
+#include "cfg/hotsettings.hpp"          /* seq66::hot()                     */
+#include "midi/mastermidibus.hpp"       /* seq66::mastermidibus class       */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "play/framebatch.hpp"          /* seq66::framebatch class          */
+#include "play/outputstats.hpp"         /* seq66::outputstats class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The batches of the current thread, if it is playing a frame.
+ */
+
+static thread_local framebatch * tl_batch = nullptr;
+
+/**
+ *  The most time, in microseconds, that the bytes queued in a paced
+ *  interface may take to send before a controller change is put off.  At
+ *  3125 bytes a second, it is about ten three-byte messages.
+ */
+
+static const long c_pace_window_us = 10000;
+
+/**
+ *  Deferred events older than this, in microseconds, are dropped rather
+ *  than sent, as when playback has stopped and started again.
+ */
+
+static const long c_pace_stale_us = 100000;
+
+framebatch::framebatch () :
+    m_batches   (std::size_t(c_busscount_max)),
+    m_used      (),
+    m_pacing    (std::size_t(c_busscount_max)),
+    m_pending   (),
+    m_sending   ()
+{
+    m_used.reserve(std::size_t(c_busscount_max));
+    m_pending.reserve(std::size_t(c_busscount_max));
+    for (auto & pc : m_pacing)
+    {
+        pc.pc_free_us = 0;
+        pc.pc_deferred_us = 0;
+    }
+}
+
+/**
+ *  Starts capturing the output of the calling thread.  The events deferred
+ *  by paced busses in the last frame are put into their batches first.
+ */
+
+void
+framebatch::begin ()
+{
+    tl_batch = this;
+    if (! m_pending.empty())
+    {
+        long now = microtime();
+        for (auto bus : m_pending)
+        {
+            pacing & pc = m_pacing[bus];
+            if (now - pc.pc_deferred_us < c_pace_stale_us)
+            {
+                for (const auto & be : pc.pc_deferred)
+                    add(bus, be.be_event, be.be_channel, be.be_tag);
+            }
+            pc.pc_deferred.clear();
+        }
+        m_pending.clear();
+    }
+}
+
+/**
+ *  Stops capturing, and plays each buss's batch, in timestamp order.
+ *
+ * \param mmb
+ *      The master buss to play to.  The caller flushes it afterward.
+ *
+ * \param stats
+ *      The statistics, which get the load of the paced busses.
+ */
+
+void
+framebatch::end (mastermidibus & mmb, outputstats & stats)
+{
+    tl_batch = nullptr;
+    for (auto bus : m_used)
+    {
+        std::vector<batchevent> & b = m_batches[bus];
+        int bytespersec = hot().output_bandwidth(int(bus));
+        if (bytespersec > 0)
+        {
+            pace(bus, b, bytespersec, stats);
+            mmb.play_batch(bus, m_sending.data(), int(m_sending.size()));
+            m_sending.clear();
+        }
+        else
+        {
+            std::stable_sort
+            (
+                b.begin(), b.end(),
+                [] (const batchevent & x, const batchevent & y)
+                {
+                    return x.be_event.timestamp() < y.be_event.timestamp();
+                }
+            );
+            mmb.play_batch(bus, b.data(), int(b.size()));
+        }
+        b.clear();
+    }
+    m_used.clear();
+}
+
+/**
+ *  Orders a paced buss's batch by timestamp and then by rank, and moves
+ *  the events that fit the wire into m_sending, deferring the controller
+ *  changes that do not.
+ *
+ * \param bus
+ *      The buss of the batch.
+ *
+ * \param b
+ *      The batch.
+ *
+ * \param bytespersec
+ *      The bandwidth of the buss's interface.
+ *
+ * \param stats
+ *      The statistics to record the load in.
+ */
+
+void
+framebatch::pace
+(
+    bussbyte bus, std::vector<batchevent> & b,
+    int bytespersec, outputstats & stats
+)
+{
+    std::stable_sort
+    (
+        b.begin(), b.end(),
+        [] (const batchevent & x, const batchevent & y)
+        {
+            midipulse tx = x.be_event.timestamp();
+            midipulse ty = y.be_event.timestamp();
+            if (tx != ty)
+                return tx < ty;
+
+            return rank(x.be_event) < rank(y.be_event);
+        }
+    );
+
+    long now = microtime();
+    pacing & pc = m_pacing[bus];
+    if (pc.pc_free_us < now)
+        pc.pc_free_us = now;                    /* the wire has gone idle   */
+
+    long deferred = 0;
+    for (const auto & be : b)
+    {
+        long cost = long(wire_bytes(be.be_event)) * 1000000L / bytespersec;
+        bool late = pc.pc_free_us + cost - now > c_pace_window_us;
+        if (late && rank(be.be_event) == 3)
+        {
+            if (pc.pc_deferred.empty())
+            {
+                pc.pc_deferred_us = now;
+                m_pending.push_back(bus);
+            }
+            defer(pc, be);
+            ++deferred;
+        }
+        else
+        {
+            pc.pc_free_us += cost;
+            m_sending.push_back(be);
+        }
+    }
+
+    long backlog = pc.pc_free_us - now;
+    stats.paced(backlog, deferred, backlog > c_pace_window_us);
+}
+
+/**
+ *  Puts off a controller change to the next frame.  A change deferred
+ *  already for the same channel and controller (or the same channel, for
+ *  pitch bend and pressure) is replaced, since only the last value counts.
+ */
+
+void
+framebatch::defer (pacing & pc, const batchevent & be)
+{
+    const event & ev = be.be_event;
+    bool perkey = event::is_controller_msg(ev.get_status()) ||
+        event::mask_status(ev.get_status()) == EVENT_AFTERTOUCH;
+
+    for (auto & d : pc.pc_deferred)
+    {
+        const event & dev = d.be_event;
+        bool same = d.be_channel == be.be_channel &&
+            dev.get_status() == ev.get_status() &&
+            (! perkey || dev.d0() == ev.d0());
+
+        if (same)
+        {
+            d = be;
+            return;
+        }
+    }
+    pc.pc_deferred.push_back(be);
+}
+
+/**
+ *  Ranks an event for the order within a tick of a paced buss.
+ *
+ * \return
+ *      Returns 0 for a Note Off, 1 for a message that sets up the channel
+ *      (program change, bank select, channel mode) or is not a channel
+ *      message, 2 for a Note On, and 3 for a continuous change, which is
+ *      the only kind that can be deferred.
+ */
+
+int
+framebatch::rank (const event & ev)
+{
+    if (ev.is_note_off() || ev.is_note_off_recorded())
+        return 0;
+
+    if (ev.is_note_on())
+        return 2;
+
+    midibyte status = event::mask_status(ev.get_status());
+    if (event::is_controller_msg(status))
+    {
+        midibyte cc = ev.d0();
+        bool setup = cc == 0 || cc == 32 || cc >= 120;  /* bank, mode      */
+        return setup ? 1 : 3 ;
+    }
+    if (status == EVENT_PITCH_WHEEL || status == EVENT_CHANNEL_PRESSURE ||
+            status == EVENT_AFTERTOUCH)
+        return 3;
+
+    return 1;
+}
+
+/**
+ *  Gets the bytes that an event takes on the wire, with its status byte.
+ */
+
+int
+framebatch::wire_bytes (const event & ev)
+{
+    if (ev.is_sysex())
+        return int(ev.get_sysex().size());
+
+    if (ev.has_channel())
+        return ev.is_two_bytes() ? 3 : 2 ;
+
+    return 1;
+}
+
+/**
+ *  Adds an event to the batch of its buss.  The buss must be less than
+ *  c_busscount_max.
+ */
+
+void
+framebatch::add
+(
+    bussbyte bus, const event & ev, midibyte channel, midibyte tag
+)
+{
+    std::vector<batchevent> & b = m_batches[bus];
+    if (b.empty())
+        m_used.push_back(bus);
+
+    b.emplace_back(ev, channel, tag);
+}
+
+/**
+ *  Called by sequence::put_event_on_bus() instead of writing to the buss.
+ *
+ * \return
+ *      Returns true if the current thread is playing a frame, in which case
+ *      the event has been batched and must not be sent.
+ */
+
+bool
+framebatch::capture
+(
+    bussbyte bus, const event & ev, midibyte channel, midibyte tag
+)
+{
+    bool result = not_nullptr(tl_batch) && int(bus) < c_busscount_max;
+    if (result)
+        tl_batch->add(bus, ev, channel, tag);
+
+    return result;
+}
+
+/**
+ * \return
+ *      Returns true if the current thread is playing a frame, as when a
+ *      pattern reaches its queued boundary or the end of its trigger,
+ *      rather than being muted by the user.
+ */
+
+bool
+framebatch::active ()
+{
+    return not_nullptr(tl_batch);
+}
+
+}           // namespace seq66
+
+/*
+ * framebatch.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,104 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          frameclock.cpp
+ *
+ *  This module defines the time and tick of the last output frame.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include "play/frameclock.hpp"          /* seq66::frameclock class          */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+frameclock::frameclock () :
+    m_sequence      (0),
+    m_frame_us      (0),
+    m_frame_tick    (0.0)
+{
+    // no code
+}
+
+/**
+ *  Notes the frame.  Called by the output thread only.
+ *
+ * \param us
+ *      The microtime() of the frame.
+ *
+ * \param tick
+ *      The tick of the frame.
+ */
+
+void
+frameclock::set (long us, double tick)
+{
+    unsigned s = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_frame_us.store(us, std::memory_order_relaxed);
+    m_frame_tick.store(tick, std::memory_order_relaxed);
+    m_sequence.store(s + 2, std::memory_order_release);
+}
+
+/**
+ *  Gets the frame.  Called by any thread.
+ *
+ * \param [out] us
+ *      The microtime() of the frame.
+ *
+ * \param [out] tick
+ *      The tick of the frame.
+ *
+ * \return
+ *      Returns true if there is a frame, that is, if playback is under way.
+ */
+
+bool
+frameclock::get (long & us, double & tick) const
+{
+    for (;;)
+    {
+        unsigned s = m_sequence.load(std::memory_order_acquire);
+        us = m_frame_us.load(std::memory_order_relaxed);
+        tick = m_frame_tick.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((s & 1) == 0 && m_sequence.load(std::memory_order_relaxed) == s)
+            break;
+    }
+    return us > 0;
+}
+
+}           // namespace seq66
+
+/*
+ * frameclock.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,414 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          inputcapture.cpp
+ *
+ *  This module defines the always-on recorder of all incoming MIDI.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The file is laid out as a header chunk and one track chunk.  The track
+ *  length sits at a fixed offset, and the End of Track event is always the
+ *  last four bytes, so that an append is a seek to the End of Track, the
+ *  new bytes, a new End of Track, and a rewrite of the length.
+ */
+
+#include <chrono>                       /* std::chrono::milliseconds        */
+#include <ctime>                        /* std::strftime()                  */
+
+#include "play/inputcapture.hpp"        /* seq66::inputcapture class        */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "util/basic_macros.hpp"        /* seq66::file_message()            */
+#include "util/filefunctions.hpp"       /* seq66::make_directory_path()     */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The room for messages between two drains.  At a drain every half
+ *  second, this is more than any player or controller can send.
+ */
+
+static const int c_capture_records = 8192;
+
+/**
+ *  The number of records popped at a time.
+ */
+
+static const int c_capture_batch = 256;
+
+/**
+ *  The interval between drains by the writer thread.
+ */
+
+static const int c_capture_drain_ms = 500;
+
+/**
+ *  How long a file is written to before the next one is begun.
+ */
+
+static const long c_capture_roll_us = 3600L * 1000000L;
+
+/**
+ *  The resolution and tempo of the files.  At 120 BPM a quarter note lasts
+ *  500000 microseconds.
+ */
+
+static const int c_capture_ppqn = 960;
+static const long c_capture_us_per_qn = 500000L;
+
+/**
+ *  The offset of the track length, after the 14-byte header chunk and the
+ *  "MTrk" tag, and the offset of the first track event.
+ */
+
+static const long c_track_length_offset = 18;
+static const long c_track_data_offset = 22;
+
+inputcapture::inputcapture (const std::string & directory) :
+    m_records       (c_capture_records),
+    m_batch         (c_capture_batch),
+    m_directory     (directory),
+    m_thread        (),
+    m_mutex         (),
+    m_wakeup        (),
+    m_stopping      (false),
+    m_running       (false),
+    m_file          (),
+    m_filename      (),
+    m_file_start_us (0),
+    m_last_tick     (0),
+    m_last_bus      (-1),
+    m_track_end     (0),
+    m_pending       ()
+{
+    m_pending.reserve(std::size_t(c_capture_records) * 4);
+}
+
+inputcapture::~inputcapture ()
+{
+    stop();
+}
+
+/**
+ *  Makes the directory, if needed, and starts the writer thread.  The file
+ *  itself is created when the first message is written.
+ *
+ * \return
+ *      Returns true if the directory is usable and the thread was started.
+ */
+
+bool
+inputcapture::start ()
+{
+    bool result = ! m_running && make_directory_path(m_directory);
+    if (result)
+    {
+        (void) m_records.mlock();                   /* best effort          */
+        m_stopping = false;
+        m_running = true;
+        m_thread = std::thread(&inputcapture::writer_func, this);
+        file_message("Input capture", m_directory);
+    }
+    return result;
+}
+
+/**
+ *  Stops the writer thread, which writes the rest of the messages first.
+ */
+
+void
+inputcapture::stop ()
+{
+    if (m_running)
+    {
+        m_running = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+
+        if (dropped() > 0)
+        {
+            std::string msg = std::to_string(dropped()) + " messages dropped";
+            warn_message("Input capture", msg);
+        }
+    }
+}
+
+/**
+ *  Called by the input thread for each incoming event.  Keeps only the
+ *  channel messages.  Lock-free and allocation-free; if the ring is full,
+ *  the message is dropped and counted.
+ */
+
+void
+inputcapture::capture (const event & ev)
+{
+    if (m_running && ev.below_sysex())
+    {
+        record r;
+        r.cr_us = ev.arrival_us() > 0 ? ev.arrival_us() : microtime() ;
+        r.cr_status = ev.get_status();
+        ev.get_data(r.cr_d0, r.cr_d1);
+        r.cr_bus = ev.input_bus();
+        (void) m_records.push_back(r);
+    }
+}
+
+/**
+ *  Drains the ring every so often, until stopped, then once more.
+ */
+
+void
+inputcapture::writer_func ()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (! m_stopping)
+    {
+        (void) m_wakeup.wait_for
+        (
+            lock, std::chrono::milliseconds(c_capture_drain_ms)
+        );
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();
+    close_file();
+}
+
+void
+inputcapture::drain ()
+{
+    for (;;)
+    {
+        std::size_t count = m_records.pop(m_batch.data(), m_batch.size());
+        for (std::size_t i = 0; i < count; ++i)
+            add_record(m_batch[i]);
+
+        if (count < m_batch.size())
+            break;
+    }
+    flush_pending();
+}
+
+/**
+ *  Encodes one message, beginning a new file first if there is none yet,
+ *  or if the current one is an hour old.
+ */
+
+void
+inputcapture::add_record (const record & r)
+{
+    if (m_file.is_open() && r.cr_us - m_file_start_us >= c_capture_roll_us)
+    {
+        flush_pending();
+        close_file();
+    }
+    if (! m_file.is_open())
+    {
+        if (! open_file(r.cr_us))
+            return;
+    }
+
+    long long us = r.cr_us - m_file_start_us;
+    midipulse tick = midipulse(us * c_capture_ppqn / c_capture_us_per_qn);
+    if (tick < m_last_tick)
+        tick = m_last_tick;
+
+    if (is_good_buss(r.cr_bus) && int(r.cr_bus) != m_last_bus)
+    {
+        put_varinum(tick - m_last_tick);
+        m_pending.push_back(0xFF);                  /* MIDI Port meta event */
+        m_pending.push_back(0x21);
+        m_pending.push_back(0x01);
+        m_pending.push_back(midibyte(r.cr_bus));
+        m_last_bus = int(r.cr_bus);
+        m_last_tick = tick;
+    }
+    put_varinum(tick - m_last_tick);
+    m_pending.push_back(r.cr_status);
+    m_pending.push_back(r.cr_d0);
+    if (! event::is_one_byte_msg(r.cr_status))
+        m_pending.push_back(r.cr_d1);
+
+    m_last_tick = tick;
+}
+
+/**
+ *  Creates the next file, named for the local time, and writes its header,
+ *  a track name, and the tempo.
+ *
+ * \param us
+ *      The microtime() of the first message, which is tick 0.
+ */
+
+bool
+inputcapture::open_file (long us)
+{
+    char name[64];
+    std::time_t t = std::time(nullptr);
+    (void) std::strftime
+    (
+        name, sizeof name, "capture-%Y%m%d-%H%M%S.midi", std::localtime(&t)
+    );
+    m_filename = filename_concatenate(m_directory, name);
+    m_file.open
+    (
+        m_filename, std::ios::out | std::ios::binary | std::ios::trunc
+    );
+
+    bool result = m_file.is_open();
+    if (result)
+    {
+        static const midibyte s_header [] =
+        {
+            'M', 'T', 'h', 'd', 0, 0, 0, 6,
+            0, 0,                                   /* format 0             */
+            0, 1,                                   /* one track            */
+            midibyte(c_capture_ppqn >> 8), midibyte(c_capture_ppqn & 0xFF),
+            'M', 'T', 'r', 'k', 0, 0, 0, 0          /* length patched later */
+        };
+        (void) m_file.write
+        (
+            reinterpret_cast<const char *>(s_header), sizeof s_header
+        );
+        m_file_start_us = us;
+        m_last_tick = 0;
+        m_last_bus = (-1);
+        m_track_end = c_track_data_offset;
+        m_pending.clear();
+
+        std::string trackname = "Input capture " + current_date_time();
+        m_pending.push_back(0);
+        m_pending.push_back(0xFF);                  /* Track Name           */
+        m_pending.push_back(0x03);
+        m_pending.push_back(midibyte(trackname.size()));
+        m_pending.insert(m_pending.end(), trackname.begin(), trackname.end());
+        m_pending.push_back(0);
+        m_pending.push_back(0xFF);                  /* Set Tempo            */
+        m_pending.push_back(0x51);
+        m_pending.push_back(0x03);
+        m_pending.push_back(midibyte((c_capture_us_per_qn >> 16) & 0xFF));
+        m_pending.push_back(midibyte((c_capture_us_per_qn >> 8) & 0xFF));
+        m_pending.push_back(midibyte(c_capture_us_per_qn & 0xFF));
+        flush_pending();
+        file_message("Capturing to", m_filename);
+    }
+    else
+        file_error("Cannot capture to", m_filename);
+
+    return result;
+}
+
+void
+inputcapture::close_file ()
+{
+    if (m_file.is_open())
+        m_file.close();
+}
+
+/**
+ *  Writes the pending bytes over the old End of Track, adds a new one, and
+ *  patches the track length, leaving a complete file.
+ */
+
+void
+inputcapture::flush_pending ()
+{
+    if (m_pending.empty() || ! m_file.is_open())
+        return;
+
+    static const midibyte s_end_of_track [] = { 0, 0xFF, 0x2F, 0 };
+    (void) m_file.seekp(m_track_end);
+    (void) m_file.write
+    (
+        reinterpret_cast<const char *>(m_pending.data()),
+        std::streamsize(m_pending.size())
+    );
+    (void) m_file.write
+    (
+        reinterpret_cast<const char *>(s_end_of_track),
+        sizeof s_end_of_track
+    );
+    m_track_end += long(m_pending.size());
+    m_pending.clear();
+    (void) m_file.seekp(c_track_length_offset);
+    put_long(m_track_end + long(sizeof s_end_of_track) - c_track_data_offset);
+    (void) m_file.flush();
+}
+
+/**
+ *  Appends a MIDI variable-length number to the pending bytes.
+ */
+
+void
+inputcapture::put_varinum (midipulse v)
+{
+    midibyte bytes[5];
+    int count = 0;
+    unsigned long value = (unsigned long)(v) & 0x0FFFFFFF;
+    do
+    {
+        bytes[count++] = midibyte(value & 0x7F);
+        value >>= 7;
+    } while (value > 0);
+
+    while (count > 1)
+        m_pending.push_back(bytes[--count] | 0x80);
+
+    m_pending.push_back(bytes[0]);
+}
+
+/**
+ *  Writes a 32-bit big-endian value at the file's current position.
+ */
+
+void
+inputcapture::put_long (long v)
+{
+    char bytes[4];
+    bytes[0] = char((v >> 24) & 0xFF);
+    bytes[1] = char((v >> 16) & 0xFF);
+    bytes[2] = char((v >> 8) & 0xFF);
+    bytes[3] = char(v & 0xFF);
+    (void) m_file.write(bytes, sizeof bytes);
+}
+
+}           // namespace seq66
+
+/*
+ * inputcapture.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,131 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          inputmonitor.cpp
+ *
+ *  This module defines the tap of the MIDI input for the input monitor.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The only consumer is the monitor window, in the GUI thread, which calls
+ *  enable() and drain().  The only producer is the input thread.
+ */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "play/inputmonitor.hpp"        /* seq66::inputmonitor class        */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The number of messages the ring holds, a power of two.  At the usual
+ *  ten refreshes a second, this is room for a dense stream of clock,
+ *  notes, and controller sweeps.
+ */
+
+static const int c_monitor_records = 4096;
+
+inputmonitor::inputmonitor () :
+    m_records       (c_monitor_records),
+    m_enabled       (false)
+{
+    // no code
+}
+
+/**
+ *  Starts or stops the tap.  When started, whatever was left in the ring
+ *  from an earlier opening of the window is thrown away, which is safe
+ *  to do from the consumer side.
+ */
+
+void
+inputmonitor::enable (bool flag)
+{
+    if (flag)
+    {
+        record scratch[64];
+        while (m_records.pop(scratch, 64) > 0)
+            ;
+    }
+    m_enabled.store(flag, std::memory_order_relaxed);
+}
+
+/**
+ *  Called by the input thread for each incoming message, only when
+ *  enabled() is true.  A full ring drops the message.
+ */
+
+void
+inputmonitor::tap (const event & ev)
+{
+    record r;
+    r.mr_us = ev.arrival_us() > 0 ? ev.arrival_us() : microtime() ;
+    r.mr_status = ev.get_status();
+    if (ev.is_sysex())
+    {
+        const event::sysex & sx = ev.get_sysex();
+        r.mr_size = int(sx.size());
+        r.mr_d0 = sx.size() > 1 ? sx[1] : 0 ;
+        r.mr_d1 = sx.size() > 2 ? sx[2] : 0 ;
+    }
+    else
+    {
+        ev.get_data(r.mr_d0, r.mr_d1);
+        r.mr_size = ev.is_one_byte() ? 1 : (ev.is_two_bytes() ? 2 : 3) ;
+    }
+    r.mr_bus = ev.input_bus();
+    (void) m_records.push_back(r);
+}
+
+/**
+ *  Moves the waiting messages to the window.
+ *
+ * \param dest
+ *      The destination, with room for count records.
+ *
+ * \param count
+ *      The most records to move.
+ *
+ * \return
+ *      Returns the number of records moved.
+ */
+
+int
+inputmonitor::drain (record * dest, int count)
+{
+    return count > 0 ? int(m_records.pop(dest, std::size_t(count))) : 0 ;
+}
+
+}           // namespace seq66
+
+/*
+ * inputmonitor.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,275 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          latencyprobe.cpp
+ *
+ *  This module defines the measurement of the round-trip latency of an
+ *  input port.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include <algorithm>                    /* std::sort()                      */
+#include <cmath>                        /* std::sqrt()                      */
+#include <sstream>                      /* std::ostringstream               */
+
+#include "midi/event.hpp"               /* seq66::event class               */
+#include "play/latencyprobe.hpp"        /* seq66::latencyprobe class        */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The clicks:  a hi wood block on the General MIDI drum channel, so that
+ *  one that goes to a synthesizer instead of a loop-back is short and
+ *  quiet-ish.
+ */
+
+static const midibyte c_click_channel   = 9;
+static const midibyte c_click_note      = 76;
+static const midibyte c_click_velocity  = 100;
+
+/**
+ *  How many clicks, how far apart, and how long to wait for each.
+ */
+
+static const int c_click_count          = 8;
+static const int c_click_count_max      = 100000;
+static const long c_click_spacing_us    = 250000;
+static const long c_click_timeout_us    = 1000000;
+
+latencyprobe::latencyprobe () :
+    m_out_buss      (null_buss()),
+    m_in_buss       (null_buss()),
+    m_running       (false),
+    m_clicks        (0),
+    m_replies       (0),
+    m_total_us      (0),
+    m_sent_us       (0),
+    m_next_us       (0),
+    m_sent          (0),
+    m_trips         ()
+{
+    // no code
+}
+
+/**
+ *  Starts a measurement.
+ *
+ * \param outbuss
+ *      The output buss for the clicks.
+ *
+ * \param inbuss
+ *      The input buss on which they are to come back.
+ *
+ * \param clicks
+ *      The number of clicks to send, or 0 for the usual few.
+ *
+ * \return
+ *      Returns true if the busses are valid, and the measurement started.
+ */
+
+bool
+latencyprobe::start (int outbuss, int inbuss, int clicks)
+{
+    bool result = outbuss >= 0 && outbuss < c_busscount_max &&
+        inbuss >= 0 && inbuss < c_busscount_max &&
+        clicks >= 0 && clicks <= c_click_count_max;
+
+    if (result)
+    {
+        m_out_buss = bussbyte(outbuss);
+        m_in_buss = bussbyte(inbuss);
+        m_running = true;
+        m_clicks = clicks > 0 ? clicks : c_click_count ;
+        m_replies = 0;
+        m_total_us = 0;
+        m_sent_us = 0;
+        m_next_us = 0;
+        m_sent = 0;
+        m_trips.clear();
+        m_trips.reserve(std::size_t(m_clicks));     /* none in input thread */
+    }
+    return result;
+}
+
+/**
+ * \param now
+ *      The current microtime().
+ *
+ * \return
+ *      Returns true if a click is to be sent now.  A click that has not
+ *      come back in time is given up on.
+ */
+
+bool
+latencyprobe::send_due (long now)
+{
+    if (m_sent_us > 0 && now - m_sent_us > c_click_timeout_us)
+    {
+        m_sent_us = 0;                          /* lost, send the next one  */
+        m_next_us = now;
+    }
+    return m_sent_us == 0 && m_clicks > 0 && now >= m_next_us;
+}
+
+void
+latencyprobe::sent (long now)
+{
+    m_sent_us = now;
+    --m_clicks;
+    ++m_sent;
+}
+
+/**
+ *  Checks an incoming event for a returning click.  The note-offs of the
+ *  clicks, and clicks that come back after being given up on, are taken as
+ *  well, so that they are not recorded.
+ *
+ * \param ev
+ *      The incoming event.
+ *
+ * \param arrival
+ *      The time it arrived, in microtime().
+ *
+ * \return
+ *      Returns true if the event was a click, and is not to be processed
+ *      further.
+ */
+
+bool
+latencyprobe::take_reply (const event & ev, long arrival)
+{
+    bool result = m_running && ev.input_bus() == m_in_buss &&
+        ev.is_note() && ev.get_note() == c_click_note;
+
+    if (result && m_sent_us > 0 && ev.is_note_on() && ev.note_velocity() > 0)
+    {
+        long trip = arrival - m_sent_us;
+        m_total_us += trip;
+        m_trips.push_back(trip);
+        ++m_replies;
+        m_sent_us = 0;
+        m_next_us = arrival + c_click_spacing_us;
+    }
+    return result;
+}
+
+/**
+ *  Checks that the measurement is over, and, if so, stops it.
+ *
+ * \param [out] latencyus
+ *      The average round trip, in microseconds, or -1 if no click came
+ *      back.
+ *
+ * \return
+ *      Returns true if the measurement has just ended.  The caller then
+ *      reports it.
+ */
+
+bool
+latencyprobe::finished (int & latencyus)
+{
+    bool result = m_running && m_clicks == 0 && m_sent_us == 0;
+    if (result)
+    {
+        latencyus = m_replies > 0 ? int(m_total_us / m_replies) : (-1) ;
+        m_running = false;
+    }
+    return result;
+}
+
+/**
+ *  Sums up the round trips of the last measurement: the clicks lost, and
+ *  the least, average, and most round trip, some percentiles, and the
+ *  standard deviation, which is the jitter.  The times are in milliseconds.
+ *
+ * \return
+ *      Returns the lines of the report.
+ */
+
+std::string
+latencyprobe::report () const
+{
+    std::ostringstream os;
+    int count = int(m_trips.size());
+    os << "Clicks sent " << m_sent << ", returned " << count
+        << ", lost " << (m_sent - count) << "\n";
+
+    if (count > 0)
+    {
+        std::vector<long> trips = m_trips;
+        std::sort(trips.begin(), trips.end());
+
+        double mean = double(m_total_us) / count;
+        double sumsq = 0.0;
+        for (auto t : trips)
+        {
+            double d = double(t) - mean;
+            sumsq += d * d;
+        }
+
+        double jitter = std::sqrt(sumsq / count);
+        auto pct = [&trips, count] (int p)
+        {
+            int i = (p * (count - 1) + 50) / 100;
+            return double(trips[std::size_t(i)]) / 1000.0;
+        };
+        os << "Round trip (ms): min " << double(trips.front()) / 1000.0
+            << ", mean " << mean / 1000.0
+            << ", max " << double(trips.back()) / 1000.0 << "\n"
+            << "Percentiles (ms): 50% " << pct(50)
+            << ", 95% " << pct(95) << ", 99% " << pct(99) << "\n"
+            << "Jitter (std. dev., ms): " << jitter / 1000.0 << "\n"
+            ;
+    }
+    return os.str();
+}
+
+/**
+ * \param on
+ *      True for the note-on of the click, false for its note-off.
+ *
+ * \return
+ *      Returns the event to send.
+ */
+
+event
+latencyprobe::click (bool on)
+{
+    midibyte status = on ? EVENT_NOTE_ON : EVENT_NOTE_OFF ;
+    return event(0, status | c_click_channel, c_click_note, c_click_velocity);
+}
+
+}           // namespace seq66
+
+/*
+ * latencyprobe.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
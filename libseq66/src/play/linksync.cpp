@@ -0,0 +1,369 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          linksync.cpp
+ *
+ *  This module defines the Ableton Link network tempo and phase sync.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include <cmath>                        /* std::ceil(), std::fabs()         */
+#include <new>                          /* std::nothrow                     */
+
+#include "seq66_features.h"             /* SEQ66_LINK_SUPPORT, platform     */
+#include "play/linksync.hpp"            /* seq66::linksync class            */
+
+#if defined SEQ66_LINK_SUPPORT
+
+#if ! defined LINK_PLATFORM_LINUX && ! defined LINK_PLATFORM_MACOSX && \
+    ! defined LINK_PLATFORM_WINDOWS
+
+#if defined SEQ66_PLATFORM_WINDOWS
+#define LINK_PLATFORM_WINDOWS   1
+#elif defined SEQ66_PLATFORM_MACOSX
+#define LINK_PLATFORM_MACOSX    1
+#else
+#define LINK_PLATFORM_LINUX     1
+#endif
+
+#endif
+
+#include <ableton/Link.hpp>             /* ableton::Link, the Link SDK      */
+
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+#if defined SEQ66_LINK_SUPPORT
+
+/**
+ *  Tempos closer than this are the same.  Link keeps the tempo as a beat
+ *  duration in microseconds, so a tempo does not always come back exactly
+ *  as it was set.
+ */
+
+static const double c_tempo_tolerance = 0.005;
+
+static bool
+tempo_differs (midibpm a, midibpm b)
+{
+    return std::fabs(a - b) > c_tempo_tolerance;
+}
+
+/**
+ *  Wraps the Link object, to keep the Link header out of linksync.hpp.
+ */
+
+class linksync::session
+{
+
+public:
+
+    ableton::Link sl_link;
+
+    explicit session (midibpm bpm) :
+        sl_link (double(bpm))
+    {
+        // no code
+    }
+
+};
+
+#else
+
+class linksync::session
+{
+    // Nothing without Link support
+};
+
+#endif
+
+linksync::linksync () :
+    m_session           (),
+    m_quantum           (4.0),
+    m_origin_beat       (0.0),
+    m_ticks             (0.0),
+    m_tempo             (0.0),
+    m_playing           (false),
+    m_session_playing   (false),
+    m_session_changed   (false)
+{
+    // no code
+}
+
+/**
+ *  Defined here, where the session class is complete.
+ */
+
+linksync::~linksync ()
+{
+    disable();
+}
+
+/**
+ * \return
+ *      Returns true if this build can join a Link session.
+ */
+
+bool
+linksync::supported ()
+{
+#if defined SEQ66_LINK_SUPPORT
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ *  Joins the Link session on the LAN, or starts one.
+ *
+ * \param bpm
+ *      The tempo to offer, if there are no peers yet.  If there are, their
+ *      tempo wins, and is taken up at the first advance().
+ *
+ * \param quantum
+ *      The number of beats over which the phase is aligned.
+ *
+ * \return
+ *      Returns true if Link is enabled.  Always false without Link support.
+ */
+
+bool
+linksync::enable (midibpm bpm, int quantum)
+{
+#if defined SEQ66_LINK_SUPPORT
+    if (! m_session)
+    {
+        m_session.reset(new (std::nothrow) session(bpm));
+        if (m_session)
+        {
+            ableton::Link & link = m_session->sl_link;
+            m_quantum = quantum > 0 ? double(quantum) : 4.0 ;
+            m_tempo = bpm;
+            link.setStartStopCallback
+            (
+                [this] (bool isplaying)             /* on the Link thread   */
+                {
+                    m_session_playing = isplaying;
+                    m_session_changed = true;
+                }
+            );
+            link.enableStartStopSync(true);
+            link.enable(true);
+        }
+    }
+#else
+    (void) bpm;
+    (void) quantum;
+#endif
+    return enabled();
+}
+
+void
+linksync::disable ()
+{
+#if defined SEQ66_LINK_SUPPORT
+    if (m_session)
+        m_session->sl_link.enable(false);
+#endif
+    m_session.reset();
+    m_playing = false;
+}
+
+/**
+ * \return
+ *      Returns the number of other applications in the session.
+ */
+
+int
+linksync::peers () const
+{
+#if defined SEQ66_LINK_SUPPORT
+    return m_session ? int(m_session->sl_link.numPeers()) : 0 ;
+#else
+    return 0;
+#endif
+}
+
+/**
+ *  Called by the output thread as playback starts.  If the session is
+ *  already playing, Seq66 joins it at its next quantum boundary.  If not,
+ *  Seq66 starts the session, with beat 0 put by Link at the nearest time
+ *  that keeps the phase of the peers, and so that they start as well.
+ *  Either way, the ticks start at zero at the origin beat, and none are
+ *  given out before it.
+ *
+ *  If there are peers, their tempo is taken up; otherwise the tempo of
+ *  Seq66 goes to the session.
+ *
+ * \param [inout] bpm
+ *      The current tempo.  Changed to the session tempo if there are peers.
+ */
+
+void
+linksync::start (midibpm & bpm)
+{
+#if defined SEQ66_LINK_SUPPORT
+    if (m_session)
+    {
+        ableton::Link & link = m_session->sl_link;
+        auto now = link.clock().micros();
+        auto state = link.captureAudioSessionState();
+        if (link.numPeers() > 0)
+            bpm = midibpm(state.tempo());
+        else if (tempo_differs(bpm, midibpm(state.tempo())))
+            state.setTempo(double(bpm), now);
+
+        m_tempo = bpm;
+        if (state.isPlaying())
+        {
+            double beat = state.beatAtTime(now, m_quantum);
+            m_origin_beat = std::ceil(beat / m_quantum) * m_quantum;
+        }
+        else
+        {
+            state.setIsPlayingAndRequestBeatAtTime(true, now, 0.0, m_quantum);
+            m_origin_beat = 0.0;
+        }
+        link.commitAudioSessionState(state);
+        m_ticks = 0.0;
+        m_playing = true;
+    }
+#else
+    (void) bpm;
+#endif
+}
+
+/**
+ *  Called by the output thread in each frame.  Also exchanges the tempo
+ *  with the session:  if the tempo given differs from the last one agreed,
+ *  the user changed it, and it goes to the session; otherwise, if the
+ *  session tempo differs, a peer changed it, and it is handed back.  The
+ *  beat timeline is continuous across tempo changes.
+ *
+ * \param ticksperbeat
+ *      The ticks in one beat of the tempo, the PPQN scaled by the beat width.
+ *
+ * \param [inout] bpm
+ *      The current tempo.  Changed to the session tempo if a peer changed it.
+ *
+ * \return
+ *      Returns the number of ticks to play in this frame:  the distance from
+ *      the ticks given out so far to the current beat of the session.
+ */
+
+long
+linksync::advance (double ticksperbeat, midibpm & bpm)
+{
+    long result = 0;
+#if defined SEQ66_LINK_SUPPORT
+    if (m_session && m_playing)
+    {
+        ableton::Link & link = m_session->sl_link;
+        auto now = link.clock().micros();
+        auto state = link.captureAudioSessionState();
+        if (tempo_differs(bpm, m_tempo))            /* the user changed it  */
+        {
+            state.setTempo(double(bpm), now);
+            link.commitAudioSessionState(state);
+            m_tempo = bpm;
+        }
+        else if (tempo_differs(midibpm(state.tempo()), m_tempo))
+        {
+            m_tempo = bpm = midibpm(state.tempo()); /* a peer changed it    */
+        }
+
+        double beat = state.beatAtTime(now, m_quantum) - m_origin_beat;
+        if (beat > 0.0)
+        {
+            double delta = beat * ticksperbeat - m_ticks;
+            if (delta >= 1.0)
+            {
+                result = long(delta);
+                m_ticks += double(result);
+            }
+        }
+    }
+#else
+    (void) ticksperbeat;
+    (void) bpm;
+#endif
+    return result;
+}
+
+/**
+ *  Called by the output thread as playback stops.  Stops the session, and
+ *  so the peers.
+ */
+
+void
+linksync::stop ()
+{
+#if defined SEQ66_LINK_SUPPORT
+    if (m_session && m_playing)
+    {
+        ableton::Link & link = m_session->sl_link;
+        auto state = link.captureAudioSessionState();
+        state.setIsPlaying(false, link.clock().micros());
+        link.commitAudioSessionState(state);
+    }
+#endif
+    m_playing = false;
+}
+
+/**
+ *  Checks for a start or stop of the session.  Called by the input thread.
+ *
+ * \param [out] playing
+ *      The new state of the session, if it changed.
+ *
+ * \return
+ *      Returns true if the session was started or stopped since the last
+ *      call.
+ */
+
+bool
+linksync::session_change (bool & playing)
+{
+    bool result = m_session_changed.exchange(false);
+    if (result)
+        playing = m_session_playing;
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * linksync.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
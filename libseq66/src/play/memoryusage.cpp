@@ -0,0 +1,105 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          memoryusage.cpp
+ *
+ *  This module defines a reading of the memory held by the song data.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include "play/memoryusage.hpp"         /* seq66::memoryusage class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+memoryusage::memoryusage () :
+    m_bytes     (),
+    m_patterns  (0)
+{
+    m_bytes.fill(0);
+}
+
+/**
+ *  The short name of a category, for reports.
+ */
+
+std::string
+memoryusage::name (category c)
+{
+    static const char * const s_names [c_categories] =
+    {
+        "events", "sysex", "triggers", "undo",
+        "clipboard", "editables", "caches"
+    };
+    int i = static_cast<int>(c);
+    return i >= 0 && i < c_categories ? s_names[i] : "unknown" ;
+}
+
+std::size_t
+memoryusage::total () const
+{
+    std::size_t result = 0;
+    for (auto b : m_bytes)
+        result += b;
+
+    return result;
+}
+
+/**
+ *  Shows the categories in KiB (rounded up, so that no category in use
+ *  shows as 0), on one line, for the console.
+ */
+
+std::string
+memoryusage::to_string () const
+{
+    std::string result = std::to_string(m_patterns) + " patterns:";
+    for (int c = 0; c < c_categories; ++c)
+    {
+        std::size_t kib = (m_bytes[c] + 1023) / 1024;
+        result += " ";
+        result += name(static_cast<category>(c));
+        result += " ";
+        result += std::to_string(kib);
+        result += " KiB";
+        result += c < c_categories - 1 ? "," : ";" ;
+    }
+    result += " total ";
+    result += std::to_string((total() + 1023) / 1024);
+    result += " KiB";
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * memoryusage.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
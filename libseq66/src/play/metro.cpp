@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-08-05
- * \updates       2024-12-14
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -152,7 +152,10 @@ metrosettings::initialize (int increment)
 
 metro::metro () :
     sequence            (),
-    m_metro_settings    ()
+    m_metro_settings    (),
+    m_clicks            (),
+    m_beat_length       (0),
+    m_beats_per_bar     (0)
 {
     /*
      * See the initialize() function below.
@@ -165,7 +168,10 @@ metro::metro () :
 
 metro::metro (const metrosettings & mc) :
     sequence            (),
-    m_metro_settings    (mc)
+    m_metro_settings    (mc),
+    m_clicks            (),
+    m_beat_length       (0),
+    m_beats_per_bar     (0)
 {
     /*
      * See the initialize() function below.
@@ -244,7 +250,8 @@ metro::initialize (performer * p)
         midipulse tick = 0;
         for (int count = 0; count < bpb; ++count, tick += increment)
         {
-            midibyte patch, note, vel, len;
+            midibyte patch, note, vel;
+            midipulse len;
             if (count == 0)
             {
                 patch = settings().main_patch();
@@ -263,6 +270,16 @@ metro::initialize (performer * p)
             event prog(tick, EVENT_PROGRAM_CHANGE | channel, patch);
             event on(tick + 1, EVENT_NOTE_ON, channel, note, vel);
             event off(tick + len, EVENT_NOTE_OFF, channel, note, vel);
+            if (count < 2)
+            {
+                click & c = m_clicks[count];
+                c.ck_events[0] = prog;
+                c.ck_events[1] = on;
+                c.ck_events[2] = off;
+                c.ck_offsets[0] = 0;
+                c.ck_offsets[1] = 1;
+                c.ck_offsets[2] = len;
+            }
             result = add_event(prog);
             if (result)
                 result = add_event(on);
@@ -278,11 +295,58 @@ metro::initialize (performer * p)
             sort_events();
             armed(true);
             unmodify();                             /* not part of song     */
+            if (bpb == 1)
+                m_clicks[1] = m_clicks[0];
+
+            m_beats_per_bar = bpb;
+            m_beat_length = increment;
         }
     }
     return result;
 }
 
+/**
+ *  Plays the clicks falling in the frame.  The beats that can have an event
+ *  in the frame run from the one whose Note Off might still be due, up to
+ *  the last beat starting in the frame; that is one or two beats.  The
+ *  first beat of each bar gets the main click.  Each event goes out with
+ *  its own tick.
+ *
+ * \param first
+ *      The first global tick of the frame.
+ *
+ * \param last
+ *      The last global tick of the frame, which is played.
+ */
+
+void
+metro::live_play_frame (midipulse first, midipulse last)
+{
+    if (m_beat_length <= 0)
+    {
+        sequence::live_play_frame(first, last);
+        return;
+    }
+
+    midipulse reach = m_clicks[0].ck_offsets[2];
+    if (m_clicks[1].ck_offsets[2] > reach)
+        reach = m_clicks[1].ck_offsets[2];
+
+    midipulse k = first > reach ? (first - reach) / m_beat_length : 0 ;
+    midipulse klast = last / m_beat_length;
+    for ( ; k <= klast; ++k)
+    {
+        midipulse beat = k * m_beat_length;
+        const click & c = m_clicks[(k % m_beats_per_bar) == 0 ? 0 : 1];
+        for (int i = 0; i < 3; ++i)
+        {
+            midipulse t = beat + c.ck_offsets[i];
+            if (t >= first && t <= last)
+                put_event_on_bus(c.ck_events[i], t);
+        }
+    }
+}
+
 /*
  *---------------------------------------------------------------------
  *  recorder
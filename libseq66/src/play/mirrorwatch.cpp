@@ -0,0 +1,379 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          mirrorwatch.cpp
+ *
+ *  This module defines the client of the state mirror.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Usage:
+ *
+\verbatim
+    seq66cli --mirror name [--watch] [--interval ms] [--count n]
+        [--start] [--stop] [--toggle n] ...
+\endverbatim
+ *
+ *  The name is the "state-mirror" name of the engine's 'rc' file.  The
+ *  exit status is EXIT_FAILURE if the mirror cannot be attached, a control
+ *  cannot be queued, or any look at the mirror found an inconsistency.
+ */
+
+#include <chrono>                       /* std::chrono::milliseconds        */
+#include <cstdlib>                      /* EXIT_SUCCESS, EXIT_FAILURE       */
+#include <iostream>                     /* std::cout                        */
+#include <thread>                       /* std::this_thread::sleep_for()    */
+
+#include "play/mirrorwatch.hpp"         /* seq66::mirrorwatch class         */
+#include "play/statemirror.hpp"         /* seq66::statemirror_view          */
+#include "util/basic_macros.hpp"        /* seq66::errprint() macros         */
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The range of "--interval".  Below the mirror's own 10 ms period the
+ *  client would only see the same copy again; above a minute it would
+ *  not notice that the engine is gone.
+ */
+
+static const int c_watch_interval_min = 10;
+static const int c_watch_interval_max = 60000;
+
+mirrorwatch::summary::summary () :
+    ms_patterns     (0),
+    ms_armed        (0),
+    ms_events       (0),
+    ms_triggers     (0),
+    ms_errors       (0)
+{
+    // no code
+}
+
+mirrorwatch::mirrorwatch () :
+    m_name          (),
+    m_watch         (false),
+    m_interval_ms   (500),
+    m_count         (0),
+    m_start         (false),
+    m_stop          (false),
+    m_toggles       ()
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if "--mirror" is on the command line.
+ */
+
+bool
+mirrorwatch::requested (int argc, char * argv [])
+{
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--mirror")
+            return true;
+    }
+    return false;
+}
+
+void
+mirrorwatch::show_help ()
+{
+    std::cout <<
+"State mirror client options (the engine is not touched):\n\n"
+"  --mirror name        Attach to the 'state-mirror' of a running engine,\n"
+"                       check its state, and print a summary.\n"
+"  --watch              Keep checking until the engine is gone.\n"
+"  --interval ms        The time between checks (default 500).\n"
+"  --count n            Stop watching after n checks (default no limit).\n"
+"  --start, --stop      Start or stop the engine's transport.\n"
+"  --toggle n           Toggle the mute of pattern n; may be repeated.\n"
+    ;
+}
+
+/**
+ *  Gets the mirror options.
+ *
+ * \return
+ *      Returns true if the options are good and a mirror name is given.
+ */
+
+bool
+mirrorwatch::parse (int argc, char * argv [])
+{
+    bool result = true;
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if
+        (
+            arg == "--mirror" || arg == "--interval" ||
+            arg == "--count" || arg == "--toggle"
+        )
+        {
+            if (++argn < argc)
+            {
+                if (arg == "--mirror")
+                {
+                    m_name = argv[argn];
+                    result = ! m_name.empty();
+                }
+                else if (arg == "--interval")
+                {
+                    m_interval_ms = std::atoi(argv[argn]);
+                    result = m_interval_ms >= c_watch_interval_min &&
+                        m_interval_ms <= c_watch_interval_max;
+                }
+                else if (arg == "--count")
+                {
+                    m_count = std::atoi(argv[argn]);
+                    result = m_count > 0;
+                }
+                else
+                {
+                    int seqno = std::atoi(argv[argn]);
+                    result = seqno >= 0 && seqno < c_shm_patterns;
+                    if (result)
+                        m_toggles.push_back(seqno);
+                }
+            }
+            else
+                result = false;
+        }
+        else if (arg == "--watch")
+            m_watch = true;
+        else if (arg == "--start")
+            m_start = true;
+        else if (arg == "--stop")
+            m_stop = true;
+        else
+            result = false;
+
+        if (! result)
+        {
+            errprintf("Bad mirror option '%s'", arg.c_str());
+            break;
+        }
+    }
+    if (result && m_start && m_stop)
+    {
+        errprint("Give --start or --stop, not both");
+        result = false;
+    }
+    if (! result)
+        show_help();
+
+    return result;
+}
+
+/**
+ *  Attaches to the mirror, sends the controls, and checks the mirror once,
+ *  or until the count runs out or the engine is gone.
+ *
+ * \return
+ *      Returns EXIT_SUCCESS if every check passed.
+ */
+
+int
+mirrorwatch::run ()
+{
+    statemirror_view view;
+    if (! view.attach(m_name))
+    {
+        errprintf("Cannot attach to the state mirror '%s'", m_name.c_str());
+        return EXIT_FAILURE;
+    }
+    if (! view.engine_alive())
+    {
+        errprintf("The engine of '%s' is not running", m_name.c_str());
+        return EXIT_FAILURE;
+    }
+
+    bool result = send_controls(view);
+    int looks = 0;
+    for (;;)
+    {
+        shm_transport st;
+        summary s = check(view);
+        bool ok = view.read_transport(st);
+        if (ok)
+        {
+            std::cout
+                << (st.st_running != 0 ? "playing" : "stopped")
+                << (st.st_song_mode != 0 ? " song" : " live")
+                << ", tick " << st.st_tick << ", " << st.st_bpm
+                << " bpm, set " << st.st_playscreen << ": "
+                << s.ms_patterns << " patterns (" << s.ms_armed
+                << " armed), " << s.ms_events << " events, "
+                << s.ms_triggers << " triggers, " << s.ms_errors
+                << " errors" << std::endl
+                ;
+        }
+        if (s.ms_errors > 0)
+            result = false;
+
+        ++looks;
+        if (! m_watch || (m_count > 0 && looks >= m_count))
+            break;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_interval_ms));
+        if (! view.engine_alive())
+        {
+            errprintf("The engine of '%s' is gone", m_name.c_str());
+            break;
+        }
+    }
+    view.detach();
+    return result ? EXIT_SUCCESS : EXIT_FAILURE ;
+}
+
+/**
+ *  Reads the transport and every pattern slot, and checks that each copy
+ *  is one the engine could have published.
+ *
+ * \param view
+ *      The attached view.
+ *
+ * \return
+ *      Returns the totals, including the number of inconsistencies.  A copy
+ *      that cannot be read consistently counts as one.
+ */
+
+mirrorwatch::summary
+mirrorwatch::check (const statemirror_view & view)
+{
+    summary result;
+    shm_transport st;
+    if (! view.read_transport(st))
+    {
+        ++result.ms_errors;
+        return result;
+    }
+    if
+    (
+        st.st_ppqn <= 0 || st.st_bpm <= 0.0 || st.st_screenset_size <= 0 ||
+        st.st_sequence_high < 0 || st.st_sequence_high > c_shm_patterns
+    )
+    {
+        ++result.ms_errors;
+        return result;
+    }
+
+    statemirror_view::pattern p;
+    for (int seqno = 0; seqno < st.st_sequence_high; ++seqno)
+    {
+        if (! view.read_pattern(seqno, p))
+        {
+            ++result.ms_errors;
+            continue;
+        }
+
+        const shm_pattern_info & pi = p.p_info;
+        if (pi.pi_active == 0)
+            continue;
+
+        ++result.ms_patterns;
+        if (pi.pi_armed != 0)
+            ++result.ms_armed;
+
+        result.ms_events += long(p.p_events.size());
+        result.ms_triggers += long(p.p_triggers.size());
+
+        bool ok = pi.pi_length > 0 &&
+            pi.pi_event_count <= pi.pi_event_room &&
+            pi.pi_trigger_count <= pi.pi_trigger_room;
+
+        for (std::size_t i = 1; ok && i < p.p_events.size(); ++i)
+            ok = p.p_events[i - 1].se_tick <= p.p_events[i].se_tick;
+
+        for (std::size_t i = 0; ok && i < p.p_triggers.size(); ++i)
+        {
+            const shm_trigger & t = p.p_triggers[i];
+            ok = t.st_start <= t.st_end;
+            if (ok && i > 0)
+                ok = p.p_triggers[i - 1].st_start <= t.st_start;
+        }
+        if (! ok)
+            ++result.ms_errors;
+    }
+    return result;
+}
+
+/**
+ *  Queues the controls of the command line.  The engine applies them in
+ *  its input thread, as it would the same keys.
+ *
+ * \return
+ *      Returns false if a control could not be queued, as when another
+ *      client holds the queue.
+ */
+
+bool
+mirrorwatch::send_controls (statemirror_view & view) const
+{
+    bool result = true;
+    if (m_start)
+    {
+        result = view.post_control
+        (
+            automation::slot::start, automation::action::on, 0
+        );
+    }
+    if (m_stop && result)
+    {
+        result = view.post_control
+        (
+            automation::slot::stop, automation::action::on, 0
+        );
+    }
+    for (auto seqno : m_toggles)
+    {
+        if (! result)
+            break;
+
+        result = view.post_control
+        (
+            automation::slot::loop, automation::action::toggle, seqno
+        );
+    }
+    if (! result)
+        errprint("Cannot queue a control; another client holds the queue");
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * mirrorwatch.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-12-01
- * \updates       2023-10-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The mutegroups object contains the mute-group data read from a mute-group
@@ -37,6 +37,7 @@
 
 #include <iomanip>                      /* std::setw() manipulator          */
 #include <iostream>                     /* std::cerr to note errors         */
+#include <mutex>                        /* std::mutex, std::lock_guard<>    */
 
 #include "cfg/settings.hpp"             /* seq66::usr()                     */
 #include "play/mutegroups.hpp"          /* seq66::mutegroups class          */
@@ -161,7 +162,8 @@ mutegroups::mutegroups (int rows, int columns) :
     m_group_load                (loading::midi),    /* midi or mutes files? */
     m_toggle_active_only        (false),
     m_strip_empty               (true),
-    m_legacy_mutes              (false)
+    m_legacy_mutes              (false),
+    m_deferred                  ()
 {
     s_swap_coordinates = usr().swap_coordinates();
     create_empty_mutes();
@@ -200,7 +202,8 @@ mutegroups::mutegroups (const std::string & name, int rows, int columns) :
     m_group_save                (saving::midi),
     m_group_load                (loading::midi),
     m_toggle_active_only        (false),
-    m_legacy_mutes              (false)
+    m_legacy_mutes              (false),
+    m_deferred                  ()
 {
     s_swap_coordinates = usr().swap_coordinates();
     create_empty_mutes();
@@ -731,6 +734,150 @@ mutegroups::reset_defaults ()
     return true;
 }
 
+/**
+ *  Decodes the body of the c_mutegroups SeqSpec section of a MIDI file,
+ *  the part after the split long holding the counts.  It replaces all of
+ *  the mute-groups.  This decoding used to be done in midifile; see
+ *  midifile::parse_c_mutegroups() and defer_midi().
+ *
+ *  The legacy format stores the group number and each bit as a long.  The
+ *  new format uses bytes, and follows each group with its name in double
+ *  quotes.
+ *
+ * \param data
+ *      Points to the first byte of the groups.
+ *
+ * \param len
+ *      The number of bytes available.  Decoding stops there, if it has not
+ *      stopped at the end of the last group.
+ *
+ * \param groupcount
+ *      The number of groups.
+ *
+ * \param groupsize
+ *      The number of bits in each group.
+ *
+ * \param legacy
+ *      True if the groups are in the legacy format.
+ *
+ * \return
+ *      Returns the number of bytes used, so that the caller can skip them.
+ */
+
+std::size_t
+mutegroups::load_midi
+(
+    const midibyte * data, std::size_t len,
+    unsigned groupcount, unsigned groupsize, bool legacy
+)
+{
+    std::size_t pos = 0;
+    auto get_byte = [&] () -> midibyte
+    {
+        return pos < len ? data[pos++] : 0 ;
+    };
+    auto get_long = [&] () -> midilong
+    {
+        midilong result = 0;
+        for (int i = 0; i < 4; ++i)
+            result = (result << 8) | get_byte();
+
+        return result;
+    };
+
+    (void) reset_defaults();                        /* makes it empty       */
+    legacy_mutes(legacy);
+    for (unsigned g = 0; g < groupcount && pos < len; ++g)
+    {
+        midibooleans mutebits;
+        std::string gname;
+        midilong group = legacy ? get_long() : midilong(get_byte()) ;
+        for (unsigned s = 0; s < groupsize; ++s)
+        {
+            midilong gmutestate = legacy ? get_long() : get_byte() ;
+            mutebits.push_back(midibool(gmutestate != 0));
+        }
+        if (! legacy)
+        {
+            if (pos < len && data[pos] == '"')      /* next a quote?        */
+            {
+                ++pos;
+                while (pos < len)
+                {
+                    char letter = char(data[pos++]);
+                    if (letter == '"')
+                        break;
+
+                    gname += letter;
+                }
+            }
+        }
+        if (load(mutegroup::number(group), mutebits))
+        {
+            /*
+             * Related to issue #87.
+             */
+
+            if (! legacy)
+                group_name(mutegroup::number(group), gname);
+
+            if (mutebits.size() != size_t(group_count()))
+                rc().auto_mutes_save(true);
+        }
+        else
+            break;                                  /* a duplicate          */
+    }
+    return pos < len ? pos : len ;
+}
+
+/**
+ *  Keeps the mute-groups of a MIDI file as raw bytes, to be decoded by
+ *  resolve() when they are first used, rather than while the file is being
+ *  loaded.  Playback needs only the patterns and triggers, so a song from a
+ *  playlist starts sooner.  Data deferred earlier and never used is
+ *  replaced.
+ */
+
+void
+mutegroups::defer_midi
+(
+    midibytes && data,
+    unsigned groupcount, unsigned groupsize, bool legacy
+)
+{
+    std::shared_ptr<deferral> d = std::make_shared<deferral>();
+    d->d_bytes = std::move(data);
+    d->d_group_count = groupcount;
+    d->d_group_size = groupsize;
+    d->d_legacy = legacy;
+    std::atomic_store(&m_deferred, std::shared_ptr<const deferral>(d));
+}
+
+/**
+ *  Decodes deferred mute-groups, if any.  The performer calls this from its
+ *  mutes() accessors, so nothing else sees the mute-groups undecoded.  The
+ *  first user might be the user interface or a MIDI control, so the decode
+ *  is done once, under a lock, and the deferral cleared only after the
+ *  groups are loaded.
+ */
+
+void
+mutegroups::resolve ()
+{
+    static std::mutex s_resolve_mutex;
+    std::lock_guard<std::mutex> guard(s_resolve_mutex);
+    std::shared_ptr<const deferral> d = std::atomic_load(&m_deferred);
+    if (d)
+    {
+        const midibytes & b = d->d_bytes;
+        (void) load_midi
+        (
+            b.data(), b.size(), d->d_group_count, d->d_group_size, d->d_legacy
+        );
+        std::atomic_store(&m_deferred, std::shared_ptr<const deferral>());
+    }
+}
+
 /**
  *  Counts the letters of each mute-group name, adding 2 to account for the
  *  double-quote characters used in specifying a mute-group name.  The names
@@ -27,7 +27,7 @@
  * \library       libseq66
  * \author        Chris Ahlstrom
  * \date          2014-04-24
- * \updates       2025-01-09
+ * \updates       2026-10-14
  * \version       $Revision$
  * \license       GNU GPL
  *
@@ -185,8 +185,9 @@ notemapper::add
         {
             pair np(gmnote, devnote, devname, gmname, true);    /* reversed */
             auto p = std::make_pair(gmnote, np);
-            (void) m_note_map.insert(p);
-            m_note_array[gmnote] = devnote;
+            if (m_note_map.insert(p).second)                    /* not dup  */
+                m_note_array[gmnote] = midibyte(devnote);
+
             if (devnote < m_note_minimum)
                 m_note_minimum = devnote;
 
@@ -197,8 +198,9 @@ notemapper::add
         {
             pair np(devnote, gmnote, devname, gmname, false);   /* !reverse */
             auto p = std::make_pair(devnote, np);
-            (void) m_note_map.insert(p);
-            m_note_array[devnote] = gmnote;
+            if (m_note_map.insert(p).second)                    /* not dup  */
+                m_note_array[devnote] = midibyte(gmnote);
+
             if (gmnote < m_note_minimum)
                 m_note_minimum = gmnote;
 
@@ -222,6 +224,8 @@ notemapper::add
 
 /**
  *  Looks up an incoming note, and, if found, returns the mapped note value.
+ *  The lookup is done in the note table that add() fills alongside the map,
+ *  which holds the mapped note, or the note itself if not mapped.
  *
  * \param incoming
  *      The note to be remapped.
@@ -234,12 +238,8 @@ notemapper::add
 int
 notemapper::convert (int incoming) const
 {
-    int result = incoming;
-    auto noteiterator = m_note_map.find(incoming);
-    if (noteiterator != m_note_map.end())
-        result = noteiterator->second.gm_value();
-
-    return result;
+    return incoming >= 0 && incoming < c_notes_count ?
+        int(m_note_array[incoming]) : incoming ;
 }
 
 /**
@@ -0,0 +1,249 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          notifyqueue.cpp
+ *
+ *  This module defines the queue that carries performer notifications to
+ *  the user-interface thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The coalescing keys are laid out as one block per kind of numbered
+ *  notice, each block holding a row of change values for each number.
+ *  Numbers out of range are simply not merged.
+ */
+
+#include "play/notifyqueue.hpp"         /* seq66::notifyqueue class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/*
+ *  The numbers that are merged for each kind, and the number of
+ *  performer::change values (rounded up) kept apart for each.  The pattern
+ *  limit matches sequence::maximum().
+ */
+
+static const int s_pattern_keys     = 1024;
+static const int s_set_keys         = 64;
+static const int s_group_keys       = 64;
+static const int s_slot_keys        = 256;
+static const int s_change_keys      = 8;
+
+static const int s_sequence_base    = 0;
+static const int s_ui_base          = s_sequence_base + s_pattern_keys;
+static const int s_trigger_base     = s_ui_base + s_pattern_keys;
+static const int s_set_base         = s_trigger_base + s_pattern_keys;
+static const int s_group_base       = s_set_base + s_set_keys;
+static const int s_slot_base        = s_group_base + s_group_keys;
+static const int s_key_count        = (s_slot_base + s_slot_keys) *
+                                        s_change_keys;
+
+/**
+ *  Creates the queue.
+ *
+ * \param sz
+ *      The number of waiting notices the queue can hold, rounded up to a
+ *      power of two.
+ */
+
+notifyqueue::notifyqueue (std::size_t sz) :
+    m_cells     (),
+    m_mask      (0),
+    m_enqueue   (0),
+    m_dequeue   (0),
+    m_pending   (std::size_t(s_key_count)),
+    m_dropped   (0)
+{
+    std::size_t n = 2;
+    while (n < sz)
+        n <<= 1;
+
+    m_cells = std::vector<cell>(n);
+    m_mask = n - 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        m_cells[i].c_sequence.store(i, std::memory_order_relaxed);
+        m_cells[i].c_key = (-1);
+    }
+    for (auto & p : m_pending)
+        p.store(false, std::memory_order_relaxed);
+}
+
+/**
+ *  Finds the flag that marks a notice of the same kind, item, and change
+ *  as waiting.
+ *
+ * \return
+ *      Returns the key, or -1 if the notice is not merged.
+ */
+
+int
+notifyqueue::coalescing_key (const notice & n) const
+{
+    int base, limit;
+    switch (n.n_kind)
+    {
+    case kind::sequence_change:
+
+        base = s_sequence_base;
+        limit = s_pattern_keys;
+        break;
+
+    case kind::ui_change:
+
+        base = s_ui_base;
+        limit = s_pattern_keys;
+        break;
+
+    case kind::trigger_change:
+
+        base = s_trigger_base;
+        limit = s_pattern_keys;
+        break;
+
+    case kind::set_change:
+
+        base = s_set_base;
+        limit = s_set_keys;
+        break;
+
+    case kind::mutes_change:
+
+        base = s_group_base;
+        limit = s_group_keys;
+        break;
+
+    case kind::automation_change:
+
+        base = s_slot_base;
+        limit = s_slot_keys;
+        break;
+
+    default:
+
+        return (-1);
+    }
+    if (n.n_number < 0 || n.n_number >= limit)
+        return (-1);
+
+    if (n.n_change < 0 || n.n_change >= s_change_keys)
+        return (-1);
+
+    return (base + n.n_number) * s_change_keys + n.n_change;
+}
+
+/**
+ *  Adds a notice to the queue, from any thread.
+ *
+ * \return
+ *      Returns true if the notice was queued, or merged with one already
+ *      waiting.  Returns false if the queue was full.
+ */
+
+bool
+notifyqueue::post (const notice & n)
+{
+    int key = coalescing_key(n);
+    if (key >= 0)
+    {
+        if (m_pending[std::size_t(key)].exchange(true))
+            return true;                        /* the same one is waiting  */
+    }
+
+    std::size_t pos = m_enqueue.load(std::memory_order_relaxed);
+    cell * c = nullptr;
+    for (;;)
+    {
+        c = &m_cells[pos & m_mask];
+
+        std::size_t seq = c->c_sequence.load(std::memory_order_acquire);
+        long diff = long(seq) - long(pos);
+        if (diff == 0)
+        {
+            if
+            (
+                m_enqueue.compare_exchange_weak
+                (
+                    pos, pos + 1, std::memory_order_relaxed
+                )
+            )
+            {
+                break;
+            }
+        }
+        else if (diff < 0)                      /* full                     */
+        {
+            if (key >= 0)
+                m_pending[std::size_t(key)].store(false);
+
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+            pos = m_enqueue.load(std::memory_order_relaxed);
+    }
+    c->c_notice = n;
+    c->c_key = key;
+    c->c_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ *  Takes the oldest notice from the queue.  Only one thread may call this
+ *  function.  The notice's flag is cleared before it is delivered, so that
+ *  a change made during its delivery is posted again.
+ *
+ * \return
+ *      Returns true if a notice was taken.
+ */
+
+bool
+notifyqueue::pop (notice & n)
+{
+    cell & c = m_cells[m_dequeue & m_mask];
+    std::size_t seq = c.c_sequence.load(std::memory_order_acquire);
+    if (seq != m_dequeue + 1)
+        return false;                           /* empty, or being filled   */
+
+    n = c.c_notice;
+    if (c.c_key >= 0)
+        m_pending[std::size_t(c.c_key)].store(false);
+
+    c.c_sequence.store(m_dequeue + m_mask + 1, std::memory_order_release);
+    ++m_dequeue;
+    return true;
+}
+
+}           // namespace seq66
+
+/*
+ * notifyqueue.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,430 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          outputstats.cpp
+ *
+ *  This module defines the timing statistics of the output thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A wake-up is on time if it is less than 50 us late; the buckets double
+ *  (roughly) from there, the last one holding anything 5 ms late or worse.
+ */
+
+#include <cstdio>                       /* std::snprintf()                  */
+
+#include "play/outputstats.hpp"         /* seq66::outputstats class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The upper limits of the lateness buckets, in microseconds.  The last
+ *  bucket has no upper limit.
+ */
+
+static const long s_bucket_limits_us [outputstats::c_lateness_buckets] =
+{
+    50, 100, 250, 500, 1000, 2000, 5000, 0
+};
+
+outputstats::values::values () :
+    ov_wakeups          (0),
+    ov_lateness         (),
+    ov_late_max_us      (0),
+    ov_underruns        (0),
+    ov_frames           (0),
+    ov_frame_sum_us     (0),
+    ov_frame_max_us     (0),
+    ov_frame_times      (),
+    ov_events_sum       (0),
+    ov_events_max       (0),
+    ov_lock_waits       (0),
+    ov_lock_wait_max_us (0),
+    ov_paced_frames     (0),
+    ov_overloads        (0),
+    ov_deferred         (0),
+    ov_backlog_max_us   (0),
+    ov_buffer_size      (0),
+    ov_buffer_max       (0),
+    ov_buffer_dropped   (0),
+    ov_input_buffer_size(0),
+    ov_input_buffer_max (0),
+    ov_input_dropped    (0),
+    ov_rt_allocations   (-1)
+{
+    // no code
+}
+
+/**
+ *  Formats the reading as a single log line.
+ */
+
+std::string
+outputstats::values::to_string () const
+{
+    std::string result;
+    char tmp[128];
+    (void) std::snprintf
+    (
+        tmp, sizeof tmp, "frames %ld (mean %ld us, max %ld us), ",
+        ov_frames, frame_mean_us(), ov_frame_max_us
+    );
+    result += tmp;
+    (void) std::snprintf
+    (
+        tmp, sizeof tmp, "events/frame %.1f (max %ld), ",
+        events_mean(), ov_events_max
+    );
+    result += tmp;
+    (void) std::snprintf
+    (
+        tmp, sizeof tmp, "late max %ld us, underruns %ld, lateness",
+        ov_late_max_us, ov_underruns
+    );
+    result += tmp;
+    for (int b = 0; b < c_lateness_buckets; ++b)
+    {
+        result += b == 0 ? " " : "/" ;
+        result += std::to_string(ov_lateness[b]);
+    }
+    (void) std::snprintf
+    (
+        tmp, sizeof tmp, ", lock waits %ld (max %ld us)",
+        ov_lock_waits, ov_lock_wait_max_us
+    );
+    result += tmp;
+    if (ov_paced_frames > 0)
+    {
+        (void) std::snprintf
+        (
+            tmp, sizeof tmp,
+            ", paced %ld, overloads %ld, deferred %ld (backlog max %ld us)",
+            ov_paced_frames, ov_overloads, ov_deferred, ov_backlog_max_us
+        );
+        result += tmp;
+    }
+    if (ov_buffer_size > 0)
+    {
+        (void) std::snprintf
+        (
+            tmp, sizeof tmp, ", buffer max %d/%d, dropped %d",
+            ov_buffer_max, ov_buffer_size, ov_buffer_dropped
+        );
+        result += tmp;
+    }
+    if (ov_input_buffer_size > 0)
+    {
+        (void) std::snprintf
+        (
+            tmp, sizeof tmp, ", input buffer max %d/%d, dropped %d",
+            ov_input_buffer_max, ov_input_buffer_size, ov_input_dropped
+        );
+        result += tmp;
+    }
+    if (ov_rt_allocations >= 0)
+        result += ", rt allocations " + std::to_string(ov_rt_allocations);
+
+    return result;
+}
+
+/**
+ *  Estimates a percentile of the frame times from the histogram.
+ *
+ * \param percent
+ *      The percentile, such as 50 or 99.
+ *
+ * \return
+ *      Returns the upper limit of the bucket holding the percentile, which
+ *      is the longest frame time if that is the last bucket.  Returns 0 if
+ *      no frames were counted.
+ */
+
+long
+outputstats::values::frame_percentile_us (int percent) const
+{
+    long total = 0;
+    for (int b = 0; b < c_lateness_buckets; ++b)
+        total += ov_frame_times[b];
+
+    if (total == 0)
+        return 0;
+
+    long wanted = (total * percent + 99) / 100;
+    long count = 0;
+    for (int b = 0; b < c_lateness_buckets - 1; ++b)
+    {
+        count += ov_frame_times[b];
+        if (count >= wanted)
+            return s_bucket_limits_us[b];
+    }
+    return ov_frame_max_us;
+}
+
+outputstats::outputstats () :
+    m_wakeups           (0),
+    m_lateness          (),
+    m_late_max_us       (0),
+    m_underruns         (0),
+    m_frames            (0),
+    m_frame_sum_us      (0),
+    m_frame_max_us      (0),
+    m_frame_times       (),
+    m_events_sum        (0),
+    m_events_max        (0),
+    m_lock_waits        (0),
+    m_lock_wait_max_us  (0),
+    m_paced_frames      (0),
+    m_overloads         (0),
+    m_deferred          (0),
+    m_backlog_max_us    (0)
+{
+    clear();
+}
+
+/**
+ * \param bucket
+ *      The index of the lateness bucket.
+ *
+ * \return
+ *      Returns the exclusive upper limit of the bucket in microseconds, or
+ *      0 for the last bucket, which has no limit.
+ */
+
+long
+outputstats::bucket_limit_us (int bucket)
+{
+    return bucket >= 0 && bucket < c_lateness_buckets ?
+        s_bucket_limits_us[bucket] : 0 ;
+}
+
+/**
+ *  Provides a short label for the bucket, such as "< 250 us" or
+ *  ">= 5000 us", for the user interface.
+ */
+
+std::string
+outputstats::bucket_label (int bucket)
+{
+    long limit = bucket_limit_us(bucket);
+    if (limit > 0)
+        return "< " + std::to_string(limit) + " us";
+
+    return ">= " + std::to_string(bucket_limit_us(c_lateness_buckets - 2)) +
+        " us";
+}
+
+/**
+ *  Zeroes the statistics.  This can race with the output thread; a count
+ *  in progress may survive the clear, which does no harm.
+ */
+
+void
+outputstats::clear ()
+{
+    m_wakeups.store(0, std::memory_order_relaxed);
+    for (auto & c : m_lateness)
+        c.store(0, std::memory_order_relaxed);
+
+    m_late_max_us.store(0, std::memory_order_relaxed);
+    m_underruns.store(0, std::memory_order_relaxed);
+    m_frames.store(0, std::memory_order_relaxed);
+    m_frame_sum_us.store(0, std::memory_order_relaxed);
+    m_frame_max_us.store(0, std::memory_order_relaxed);
+    for (auto & c : m_frame_times)
+        c.store(0, std::memory_order_relaxed);
+
+    m_events_sum.store(0, std::memory_order_relaxed);
+    m_events_max.store(0, std::memory_order_relaxed);
+    m_lock_waits.store(0, std::memory_order_relaxed);
+    m_lock_wait_max_us.store(0, std::memory_order_relaxed);
+    m_paced_frames.store(0, std::memory_order_relaxed);
+    m_overloads.store(0, std::memory_order_relaxed);
+    m_deferred.store(0, std::memory_order_relaxed);
+    m_backlog_max_us.store(0, std::memory_order_relaxed);
+}
+
+/**
+ *  Raises a maximum atomically.  Only the output thread usually writes a
+ *  maximum, but lock waits can be recorded by the playpool workers too.
+ */
+
+void
+outputstats::raise_max (counter & c, long value)
+{
+    long current = c.load(std::memory_order_relaxed);
+    while (value > current)
+    {
+        if (c.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            break;
+    }
+}
+
+/**
+ *  Records the lateness of a wake-up of the output thread.
+ *
+ * \param lateness_us
+ *      How long after its target time the thread woke up.  Negative values
+ *      (an early wake-up) count as on time.
+ */
+
+void
+outputstats::wakeup (long lateness_us)
+{
+    if (lateness_us < 0)
+        lateness_us = 0;
+
+    int b = 0;
+    while (b < c_lateness_buckets - 1 && lateness_us >= s_bucket_limits_us[b])
+        ++b;
+
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    m_lateness[b].fetch_add(1, std::memory_order_relaxed);
+    raise_max(m_late_max_us, lateness_us);
+}
+
+/**
+ *  Records a frame that finished after the time the next one was due, so
+ *  that the output thread did not sleep at all.  It also counts as a
+ *  wake-up that late.
+ */
+
+void
+outputstats::underrun (long lateness_us)
+{
+    m_underruns.fetch_add(1, std::memory_order_relaxed);
+    wakeup(lateness_us);
+}
+
+/**
+ *  Records the playing of one frame.
+ *
+ * \param frame_us
+ *      The time taken to play the frame.
+ *
+ * \param events
+ *      The number of events sent to the output busses during the frame.
+ */
+
+void
+outputstats::frame (long frame_us, long events)
+{
+    int b = 0;
+    while (b < c_lateness_buckets - 1 && frame_us >= s_bucket_limits_us[b])
+        ++b;
+
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+    m_frame_times[b].fetch_add(1, std::memory_order_relaxed);
+    m_frame_sum_us.fetch_add(frame_us, std::memory_order_relaxed);
+    m_events_sum.fetch_add(events, std::memory_order_relaxed);
+    raise_max(m_frame_max_us, frame_us);
+    raise_max(m_events_max, events);
+}
+
+/**
+ *  Records a wait for a pattern's lock in sequence::play().
+ */
+
+void
+outputstats::lock_wait (long wait_us)
+{
+    m_lock_waits.fetch_add(1, std::memory_order_relaxed);
+    raise_max(m_lock_wait_max_us, wait_us);
+}
+
+/**
+ *  Records the pacing of one buss's batch in a frame.
+ *
+ * \param backlog_us
+ *      The time the interface would still need to send the bytes queued
+ *      in it, after the batch.
+ *
+ * \param deferred
+ *      The number of controller changes put off to the next frame.
+ *
+ * \param overload
+ *      True if the backlog is more than the pacing window.
+ */
+
+void
+outputstats::paced (long backlog_us, long deferred, bool overload)
+{
+    m_paced_frames.fetch_add(1, std::memory_order_relaxed);
+    if (overload)
+        m_overloads.fetch_add(1, std::memory_order_relaxed);
+
+    if (deferred > 0)
+        m_deferred.fetch_add(deferred, std::memory_order_relaxed);
+
+    raise_max(m_backlog_max_us, backlog_us);
+}
+
+/**
+ *  Reads the counters.  The buffer figures are left at zero.
+ */
+
+outputstats::values
+outputstats::get () const
+{
+    values result;
+    result.ov_wakeups = m_wakeups.load(std::memory_order_relaxed);
+    for (int b = 0; b < c_lateness_buckets; ++b)
+        result.ov_lateness[b] = m_lateness[b].load(std::memory_order_relaxed);
+
+    result.ov_late_max_us = m_late_max_us.load(std::memory_order_relaxed);
+    result.ov_underruns = m_underruns.load(std::memory_order_relaxed);
+    result.ov_frames = m_frames.load(std::memory_order_relaxed);
+    result.ov_frame_sum_us = m_frame_sum_us.load(std::memory_order_relaxed);
+    result.ov_frame_max_us = m_frame_max_us.load(std::memory_order_relaxed);
+    for (int b = 0; b < c_lateness_buckets; ++b)
+    {
+        result.ov_frame_times[b] =
+            m_frame_times[b].load(std::memory_order_relaxed);
+    }
+    result.ov_events_sum = m_events_sum.load(std::memory_order_relaxed);
+    result.ov_events_max = m_events_max.load(std::memory_order_relaxed);
+    result.ov_lock_waits = m_lock_waits.load(std::memory_order_relaxed);
+    result.ov_lock_wait_max_us =
+        m_lock_wait_max_us.load(std::memory_order_relaxed);
+
+    result.ov_paced_frames = m_paced_frames.load(std::memory_order_relaxed);
+    result.ov_overloads = m_overloads.load(std::memory_order_relaxed);
+    result.ov_deferred = m_deferred.load(std::memory_order_relaxed);
+    result.ov_backlog_max_us =
+        m_backlog_max_us.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * outputstats.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
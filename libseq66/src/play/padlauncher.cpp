@@ -0,0 +1,209 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          padlauncher.cpp
+ *
+ *  This module defines the voice pool that plays the patterns launched by
+ *  the drum pads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The input thread only calls post().  Everything else is called by the
+ *  thread that plays the frames, except reset(), which any thread can
+ *  call, and the statistics.
+ */
+
+#include <utility>                      /* std::move()                      */
+
+#include "play/padlauncher.hpp"         /* seq66::padlauncher class         */
+#include "play/sequence.hpp"            /* seq66::sequence::play_voice()    */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The number of hits that can wait for the next frame.  Far more than the
+ *  fingers of a drummer can make in a frame.
+ */
+
+static const int c_hits_max = 256;
+
+padlauncher::padlauncher (int voices) :
+    m_hits          (c_hits_max),
+    m_voices        (std::size_t(voices > 0 ? voices : c_voices)),
+    m_active        (0),
+    m_refused       (0),
+    m_reset         (false),
+    m_last_tick     (-1)
+{
+    // no code
+}
+
+/**
+ *  Posts a hit for the next frame.  Called by the input thread only.
+ *
+ * \param s
+ *      The pattern to launch.
+ *
+ * \param velocity
+ *      The velocity of the hit.
+ *
+ * \return
+ *      Returns false if the hit could not be posted.
+ */
+
+bool
+padlauncher::post (seq::pointer s, midibyte velocity)
+{
+    hit h;
+    h.ph_seq = std::move(s);
+    h.ph_velocity = velocity;
+    return m_hits.push_back(std::move(h));
+}
+
+/**
+ *  Plays a frame of the voices.  The posted hits are given voices first,
+ *  starting at the first tick of the frame, or at the next step of the grid
+ *  at or after it.  A voice whose pattern has played through is freed by
+ *  moving the last voice in use into its place.
+ *
+ *  Going backward, as when the transport is restarted at the beginning or
+ *  the loop is rewound, drops the voices.  A reset() also drops the hits
+ *  posted before it.
+ *
+ * \param tick
+ *      The last tick of the frame.
+ *
+ * \param quantum
+ *      The width of the quantization grid in ticks, or 0 to start the
+ *      launched patterns at once.
+ *
+ * \param scaled
+ *      If true, the velocity of each hit scales the Note Ons of its voice.
+ */
+
+void
+padlauncher::play (midipulse tick, midipulse quantum, bool scaled)
+{
+    if (m_reset.exchange(false, std::memory_order_acq_rel))
+        clear(true);
+    else if (tick < m_last_tick)
+        clear(false);
+
+    midipulse first = m_last_tick >= 0 && m_last_tick < tick ?
+        m_last_tick + 1 : tick ;
+
+    take_hits(first, quantum, scaled);
+
+    int count = m_active.load(std::memory_order_relaxed);
+    int v = 0;
+    while (v < count)
+    {
+        voice & pv = m_voices[std::size_t(v)];
+        bool more = pv.pv_seq->play_voice
+        (
+            pv.pv_start, pv.pv_next, tick, pv.pv_velocity
+        );
+        if (more)
+        {
+            pv.pv_next = tick + 1;
+            ++v;
+        }
+        else
+        {
+            voice & last = m_voices[std::size_t(--count)];
+            if (&pv != &last)
+                pv = std::move(last);
+
+            last.pv_seq.reset();
+        }
+    }
+    m_active.store(count, std::memory_order_relaxed);
+    m_last_tick = tick;
+}
+
+/**
+ *  Gives each posted hit a voice, if one is free.
+ */
+
+void
+padlauncher::take_hits (midipulse first, midipulse quantum, bool scaled)
+{
+    midipulse start = first;
+    if (quantum > 0)
+        start = ((first + quantum - 1) / quantum) * quantum;
+
+    int count = m_active.load(std::memory_order_relaxed);
+    int size = int(m_voices.size());
+    hit h;
+    while (m_hits.pop_front(h))
+    {
+        if (count < size && h.ph_seq)
+        {
+            voice & pv = m_voices[std::size_t(count++)];
+            pv.pv_seq = std::move(h.ph_seq);
+            pv.pv_start = pv.pv_next = start;
+            pv.pv_velocity = scaled ? h.ph_velocity : 0 ;
+        }
+        else
+        {
+            m_refused.fetch_add(1, std::memory_order_relaxed);
+            h.ph_seq.reset();
+        }
+    }
+    m_active.store(count, std::memory_order_relaxed);
+}
+
+/**
+ *  Drops the voices, and optionally the posted hits.  The notes the voices
+ *  left sounding are turned off with the rest of the notes of their
+ *  pattern, by the stop, pause, or rewind that led here.
+ */
+
+void
+padlauncher::clear (bool hits)
+{
+    hit h;
+    while (hits && m_hits.pop_front(h))
+        h.ph_seq.reset();
+
+    int count = m_active.load(std::memory_order_relaxed);
+    for (int v = 0; v < count; ++v)
+        m_voices[std::size_t(v)].pv_seq.reset();
+
+    m_active.store(0, std::memory_order_relaxed);
+    m_last_tick = -1;
+}
+
+}               // namespace seq66
+
+/*
+ * padlauncher.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
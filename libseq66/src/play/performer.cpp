@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom and others
  * \date          2018-11-12
- * \updates       2025-01-28
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Also read the comments in the Seq64 version of this module, perform.
@@ -118,7 +118,9 @@
  *        m_midiclockpos is set to the current tick (!), all_notes_off(), and
  *        inner_stop(true) [sets m_usemidiclock = true].
  *    -   If MIDI Clock is received, and m_midiclockrunning is true, then
- *        m_midiclocktick += m_midiclockincrement.
+ *        m_midiclocktick += m_midiclockincrement, and the clock is fed to
+ *        m_clock_follower, which, if rc().midi_clock_follow() is true,
+ *        provides the interpolated ticks in play_cycle() instead.
  *    -   If MIDI Song Position is received, then m_midiclockpos is set as per
  *        in data in this event.
  *    -   MIDI Active Sense and MIDI Reset are currently filtered by the JACK
@@ -239,22 +241,30 @@
  *      modify() function.
  */
 
-#include <algorithm>                    /* std::find() for std::vector      */
+#include <algorithm>                    /* std::find(), std::min()          */
 #include <cmath>                        /* std::round()                     */
 #include <iostream>                     /* std::cout                        */
 #include <sstream>                      /* std::ostringstream               */
 
+#include "cfg/hotsettings.hpp"          /* seq66::hot(), publish_...()      */
 #include "cfg/mutegroupsfile.hpp"       /* seq66::mutegroupsfile            */
 #include "cfg/notemapfile.hpp"          /* seq66::notemapfile               */
 #include "cfg/playlistfile.hpp"         /* seq66::playlistfile              */
 #include "cfg/settings.hpp"             /* seq66::rcsettings rc(), etc.     */
 #include "ctrl/keystroke.hpp"           /* seq66::keystroke class           */
+#include "midi/editable_events.hpp"     /* seq66::editable_events           */
 #include "midi/midifile.hpp"            /* seq66::read_midi_file()          */
+#include "play/inputcapture.hpp"        /* seq66::inputcapture              */
 #include "play/notemapper.hpp"          /* seq66::notemapper                */
 #include "play/performer.hpp"           /* seq66::performer, this class     */
+#include "play/playpool.hpp"            /* seq66::playpool                  */
 #include "os/daemonize.hpp"             /* seq66::signal_for_exit()         */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
+#include "os/rtsafe.hpp"                /* seq66::lock_memory(), etc.       */
+#include "os/startupprofile.hpp"        /* seq66::startup_phase             */
 #include "os/timing.hpp"                /* seq66::microsleep(), microtime() */
 #include "util/filefunctions.hpp"       /* seq66::filename_base(), etc.     */
+#include "util/parallel.hpp"            /* seq66::parallel_for()            */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -270,6 +280,24 @@ namespace seq66
 
 static const int c_thread_trigger_width_us = 4 * 1000;
 
+/**
+ *  When the "deadline" output scheduler is selected in the 'rc' file, this
+ *  value is the longest time the output thread will sleep, even if no event
+ *  or clock pulse is due.  It bounds the latency of live changes that the
+ *  output thread cannot predict, such as unmuting a pattern, changing the
+ *  tempo, or stopping playback, and it keeps the progress bars moving.
+ */
+
+static const long c_deadline_max_wait_us = 10 * 1000;
+
+/**
+ *  The longest sleep of the deadline output scheduler while the drum pads
+ *  are on, so that a hit is played within a millisecond or so of its
+ *  arrival.
+ */
+
+static const long c_pad_max_wait_us = 1000;
+
 /**
  *  When operating a playlist, especially from a headless seq66cli run, and
  *  with JACK transport active, the change from a playing tune to the next
@@ -324,6 +352,18 @@ performer::performer (int ppqn, int rows, int columns) :
     m_midi_control_out      ("Performer ctrl out"),
     m_mute_groups           ("Mute groups", rows, columns),     /* mutes()  */
     m_operations            ("Performer operations"),
+    m_key_bindings          (),
+    m_remote_controls       (256),
+    m_remote_mutex          (),
+    m_mirror_actions        (256),
+    m_mirror_mutex          (),
+    m_mirror_state          (),
+    m_mirror_state_new      (false),
+    m_mirror_heard_us       (0),
+    m_mirror_pos            (-1),
+    m_mirror_primary        (false),
+    m_mirror_following      (false),
+    m_bulk_ops              (),
     m_set_master            (rows, columns),    /* 32 row x column sets     */
     m_set_mapper                                /* access via set_mapper()  */
     (
@@ -334,11 +374,25 @@ performer::performer (int ppqn, int rows, int columns) :
     m_in_thread             (),
     m_out_thread_launched   (false),
     m_in_thread_launched    (false),
+    m_play_pool             (),
+    m_play_jobs             (),
+    m_boundary_wheel        (),
+    m_due_boundaries        (),
+    m_pad_launcher          (),
+    m_frame_batch           (),
+    m_frame_clock           (),
+    m_latency_probe         (),
+    m_link_sync             (),
+    m_input_capture         (),
+    m_input_monitor         (),
+    m_session_log           (),
     m_io_active             (false),            /* !done(), set in launch() */
     m_is_running            (false),
     m_is_pattern_playing    (false),
     m_needs_update          (true),
+    m_update_generation     (0),
     m_is_busy               (false),            /* try this flag for now    */
+    m_output_batch          (0),
     m_looping               (false),
     m_song_recording        (false),
     m_song_record_snap      (true),
@@ -350,8 +404,20 @@ performer::performer (int ppqn, int rows, int columns) :
     m_file_ppqn             (0),
     m_bpm                   (usr().midi_beats_per_minute()),
     m_resolution_change     (true),
+    m_jack_engine_busy      (false),
     m_current_beats         (0),
     m_delta_us              (0),
+    m_output_stats          (),
+    m_song_timeline         (),
+    m_trigger_generation    (1),                /* 0 is "never compiled"    */
+    m_wrap_generation       (0),
+    m_wrap_tick             (0),
+    m_tempo_map_mutex       (),
+    m_tempo_map             (),
+    m_tempo_map_stale       (true),
+    m_tempo_map_bpm         (m_bpm),
+    m_tempo_pending         (0.0),
+    m_tempo_pending_tick    (0),
     m_base_time_ms          (0),
     m_last_time_ms          (0),
     m_beats_per_bar         (usr().midi_beats_per_bar()),
@@ -363,6 +429,7 @@ performer::performer (int ppqn, int rows, int columns) :
     m_record_by_buss        (false),
     m_record_by_channel     (false),
     m_buss_patterns         (),
+    m_buss_routes           (),
     m_one_measure           (0),
     m_fast_ticks            (0),
     m_left_tick             (0),
@@ -377,6 +444,7 @@ performer::performer (int ppqn, int rows, int columns) :
     m_midiclocktick         (0),
     m_midiclockincrement    (clock_ticks_from_ppqn(m_ppqn)),
     m_midiclockpos          (0),
+    m_clock_follower        (),
     m_dont_reset_ticks      (false),            /* support for pausing      */
     m_is_modified           (false),
 #if defined USE_SONG_BOX_SELECT
@@ -396,6 +464,8 @@ performer::performer (int ppqn, int rows, int columns) :
     m_have_redo             (false),
     m_redo_vect             (),
     m_notify                (),
+    m_notify_queue          (),
+    m_notify_thread         (std::thread::id()),
     m_signalled_changes     (! seq_app_cli()),  /* !usr().app_is_headless() */
     m_seq_edit_pending      (false),
     m_event_edit_pending    (false),
@@ -439,6 +509,9 @@ performer::enregister (callbacks * pfcb)
         auto it = std::find(m_notify.begin(), m_notify.end(), pfcb);
         if (it == m_notify.end())
             m_notify.push_back(pfcb);
+
+        if (m_notify_thread.load() == std::thread::id())
+            m_notify_thread = std::this_thread::get_id();
     }
 }
 
@@ -628,11 +701,155 @@ performer::modified () const
     return result;
 }
 
+/**
+ *  Tells if a notification raised on the calling thread has to be queued
+ *  for the thread that registered the clients, rather than delivered right
+ *  away.  Until a client registers, nothing is queued.
+ */
+
+bool
+performer::notify_deferred () const
+{
+    std::thread::id t = m_notify_thread.load();
+    return t != std::thread::id() && t != std::this_thread::get_id();
+}
+
+/**
+ *  Delivers a notification now, or queues it, as per notify_deferred().
+ *  Only the calls to the clients are deferred; the callers do their own
+ *  work (modify(), announcing to the control-out port) right away.
+ */
+
 void
-performer::notify_automation_change (automation::slot s)
+performer::dispatch_notice (const notifyqueue::notice & n)
+{
+    if (notify_deferred())
+        (void) m_notify_queue.post(n);
+    else
+        deliver_notice(n);
+}
+
+/**
+ *  Calls the clients' callback for a notification.
+ */
+
+void
+performer::deliver_notice (const notifyqueue::notice & n)
 {
+    change mod = change(n.n_change);
     for (auto notify : m_notify)
-        (void) notify->on_automation_change(s);
+    {
+        switch (n.n_kind)
+        {
+        case notifyqueue::kind::group_learn:
+
+            (void) notify->on_group_learn(n.n_value != 0);
+            break;
+
+        case notifyqueue::kind::group_learn_complete:
+
+            (void) notify->on_group_learn_complete(n.n_key, n.n_value != 0);
+            break;
+
+        case notifyqueue::kind::mutes_change:
+
+            (void) notify->on_mutes_change(n.n_number, mod);
+            break;
+
+        case notifyqueue::kind::set_change:
+
+            (void) notify->on_set_change(n.n_number, mod);
+            break;
+
+        case notifyqueue::kind::sequence_change:
+
+            (void) notify->on_sequence_change(n.n_number, mod);
+            break;
+
+        case notifyqueue::kind::automation_change:
+
+            (void) notify->on_automation_change(automation::slot(n.n_number));
+            break;
+
+        case notifyqueue::kind::ui_change:
+
+            (void) notify->on_ui_change(n.n_number);
+            break;
+
+        case notifyqueue::kind::trigger_change:
+
+            (void) notify->on_trigger_change(n.n_number, mod);
+            break;
+
+        case notifyqueue::kind::resolution_change:
+
+            (void) notify->on_resolution_change(n.n_value, n.n_bpm, mod);
+            break;
+
+        case notifyqueue::kind::song_action:
+
+            (void) notify->on_song_action
+            (
+                n.n_value != 0, playlist::action(n.n_action)
+            );
+            break;
+
+        default:
+
+            break;
+        }
+    }
+}
+
+/**
+ *  Delivers the notifications queued by the other threads.  To be called
+ *  regularly by the thread that registered the clients, such as from the
+ *  user-interface's redraw timer.  Also sends any control-out feedback held
+ *  back by its rate limit.
+ *
+ * \return
+ *      Returns the number of notifications delivered.
+ */
+
+int
+performer::deliver_notifications ()
+{
+    int result = 0;
+    notifyqueue::notice n;
+    while (m_notify_queue.pop(n))
+    {
+        deliver_notice(n);
+        ++result;
+    }
+    (void) send_pending_feedback();
+    return result;
+}
+
+/**
+ *  A helper to fill in the common fields of a notification.
+ */
+
+static notifyqueue::notice
+make_notice
+(
+    notifyqueue::kind k, int number = 0,
+    performer::change mod = performer::change::no
+)
+{
+    notifyqueue::notice result;
+    result.n_kind = k;
+    result.n_number = number;
+    result.n_change = int(mod);
+    return result;
+}
+
+void
+performer::notify_automation_change (automation::slot s)
+{
+    dispatch_notice
+    (
+        make_notice(notifyqueue::kind::automation_change, int(s))
+    );
 }
 
 /*
@@ -648,15 +865,16 @@ performer::notify_set_change (screenset::number setno, change mod)
     if (changed(mod))
         modify();
 
-    for (auto notify : m_notify)
-        (void) notify->on_set_change(setno, mod);
+    dispatch_notice(make_notice(notifyqueue::kind::set_change, setno, mod));
 }
 
 void
 performer::notify_mutes_change (mutegroup::number mutesno, change mod)
 {
-    for (auto notify : m_notify)
-        (void) notify->on_mutes_change(mutesno, mod);
+    dispatch_notice
+    (
+        make_notice(notifyqueue::kind::mutes_change, mutesno, mod)
+    );
 
     if (mod == change::yes)
         modify();
@@ -677,8 +895,10 @@ performer::notify_sequence_change (seq::number seqno, change mod)
 
     if (get_sequence(seqno))
     {
-        for (auto notify : m_notify)
-            (void) notify->on_sequence_change(seqno, mod);
+        dispatch_notice
+        (
+            make_notice(notifyqueue::kind::sequence_change, seqno, mod)
+        );
     }
 }
 
@@ -689,15 +909,16 @@ performer::notify_sequence_change (seq::number seqno, change mod)
 void
 performer::notify_ui_change (seq::number seqno, change /*mod*/)
 {
-    for (auto notify : m_notify)
-        (void) notify->on_ui_change(seqno);
+    dispatch_notice(make_notice(notifyqueue::kind::ui_change, seqno));
 }
 
 void
 performer::notify_trigger_change (seq::number seqno, change mod)
 {
-    for (auto notify : m_notify)
-        (void) notify->on_trigger_change(seqno, mod);
+    dispatch_notice
+    (
+        make_notice(notifyqueue::kind::trigger_change, seqno, mod)
+    );
 
     if (mod == change::yes)
     {
@@ -722,9 +943,13 @@ performer::notify_trigger_change (seq::number seqno, change mod)
 void
 performer::notify_resolution_change (int ppqn, midibpm bpm, change mod)
 {
+    notifyqueue::notice n =
+        make_notice(notifyqueue::kind::resolution_change, 0, mod);
+
+    n.n_value = ppqn;
+    n.n_bpm = bpm;
     m_resolution_change = true;
-    for (auto notify : m_notify)
-        (void) notify->on_resolution_change(ppqn, bpm, mod);
+    dispatch_notice(n);
 
     if (mod == change::yes)
         modify();
@@ -740,8 +965,10 @@ performer::notify_resolution_change (int ppqn, midibpm bpm, change mod)
 void
 performer::notify_song_action (bool signalit, playlist::action act)
 {
-    for (auto notify : m_notify)
-        (void) notify->on_song_action(signalit, act);
+    notifyqueue::notice n = make_notice(notifyqueue::kind::song_action);
+    n.n_value = signalit ? 1 : 0;
+    n.n_action = int(act);
+    dispatch_notice(n);
 }
 
 /*
@@ -811,7 +1038,10 @@ performer::get_settings (const rcsettings & rcs, const usrsettings & usrs)
     int moacount = rcs.midi_control_out().action_count();
     int momcount = rcs.midi_control_out().macro_count();
     if (kcount > 0)
+    {
         m_key_controls = rcs.key_controls();
+        bind_keys();
+    }
 
     msgprintf
     (
@@ -843,6 +1073,23 @@ performer::get_settings (const rcsettings & rcs, const usrsettings & usrs)
     record_by_buss(rcs.record_by_buss());
     record_by_channel(rcs.record_by_channel());
     m_resume_note_ons = usrs.resume_note_ons();
+    publish_hot_settings();                         /* for the RT threads   */
+    if (rcs.latency_probe())
+    {
+        int out = rcs.latency_probe_out();
+        int clicks = rcs.latency_test_clicks();     /* 0 if not a test      */
+        (void) m_latency_probe.start(out, rcs.latency_probe_in(), clicks);
+    }
+    if (rcs.link_sync())
+    {
+        if (m_link_sync.enable(get_beats_per_minute(), rcs.link_quantum()))
+            info_message("Ableton Link sync enabled");
+        else if (! linksync::supported())
+            error_message("This build has no Ableton Link support");
+        else
+            error_message("Could not enable Ableton Link sync");
+    }
+
     return result;
 }
 
@@ -1629,10 +1876,15 @@ performer::pulses_to_measure_string (midipulse tick) const
     return seq66::pulses_to_measurestring(tick, mt);
 }
 
+/**
+ *  Uses the tempo map, so that the time is right in a song whose tempo
+ *  changes.
+ */
+
 std::string
 performer::pulses_to_time_string (midipulse tick) const
 {
-    return seq66::pulses_to_time_string(tick, bpm(), ppqn());
+    return microseconds_to_time_string((unsigned long) tick_to_us(tick));
 }
 
 std::string
@@ -1691,6 +1943,8 @@ performer::install_sequence (sequence * s, seq::number & seqno, bool fileload)
     if (result)
     {
         s->set_parent(this);                    /* also sets a lot of stuff */
+        song_timeline_stale();
+        tempo_map_stale();
         if (rc().is_setsmode_clear())           /* i.e. normal or auto-arm  */
         {
             /*
@@ -1726,10 +1980,69 @@ performer::install_sequence (sequence * s, seq::number & seqno, bool fileload)
     return result;
 }
 
+/**
+ *  Installs a batch of new sequences, such as those of import_midi_files(),
+ *  as one change.  Unlike a loop over install_sequence(), the play-set is
+ *  refilled, the song timeline and tempo map marked stale, and the set
+ *  change announced, once for the whole batch.
+ *
+ * \param seqs
+ *      The sequences, each holding its preferred number as its
+ *      seq_number().  If that slot is taken, the next open one is used.
+ *      The performer takes ownership of them all; one that cannot be
+ *      installed is deleted.
+ *
+ * \return
+ *      Returns the number of sequences installed.
+ */
+
+int
+performer::install_sequences (const std::vector<sequence *> & seqs)
+{
+    int result = 0;
+    bool refill = rc().is_setsmode_clear() && ! is_running();
+    bool add = ! refill &&
+        (rc().is_setsmode_clear() || rc().is_setsmode_allsets());
+
+    for (auto s : seqs)
+    {
+        seq::number seqno = seq::number(s->seq_number());
+        if (set_mapper().install_sequence(s, seqno))
+        {
+            s->set_parent(this);
+            if (add)
+                (void) add_to_play_set(s);
+
+            ++result;
+        }
+        else
+            delete s;
+    }
+    if (result > 0)
+    {
+        if (refill)
+            (void) fill_play_set();
+
+        song_timeline_stale();
+        tempo_map_stale();
+        notify_set_change(playscreen_number(), change::yes);
+    }
+    return result;
+}
+
 bool
 performer::add_to_play_set (sequence * s)
 {
     bool result = set_mapper().add_to_play_set(play_set(), s);
+    song_timeline_stale();
+    if (result && not_nullptr(s))
+    {
+        if (s->get_queued())
+            schedule_boundary(s, s->get_queued_tick());
+
+        if (s->one_shot())
+            schedule_boundary(s, s->one_shot_tick());
+    }
     if (result)
         record_by_buss(sequence_inbus_setup());             /* not a change */
 
@@ -1739,13 +2052,45 @@ performer::add_to_play_set (sequence * s)
 bool
 performer::fill_play_set (bool clearit)
 {
+    (void) apply_bulk_ops();                /* to the sets about to go      */
     bool result = set_mapper().fill_play_set(play_set(), clearit);
+    song_timeline_stale();
+    schedule_boundaries();
     if (result)
         record_by_buss(sequence_inbus_setup());             /* not a change */
 
     return result;
 }
 
+/**
+ *  The tag of a pattern's queued events is only a byte (see
+ *  sequence::output_tag()), so patterns 255 apart, and the metronome, can
+ *  share one.  A retraction removes every queued event with the tag, from
+ *  every port, so it is safe only if no other playing pattern has the tag.
+ *
+ * \param s
+ *      The pattern being muted.
+ *
+ * \return
+ *      Returns true if another armed pattern of the play-set, or the armed
+ *      metronome, has the tag of the pattern.
+ */
+
+bool
+performer::output_tag_shared (const sequence & s) const
+{
+    midibyte tag = s.output_tag();
+    for (auto seqi : play_set().seq_container())
+    {
+        if (seqi.get() != &s && seqi->armed() && seqi->output_tag() == tag)
+            return true;
+    }
+    if (m_metronome && m_metronome.get() != &s && m_metronome->armed())
+        return m_metronome->output_tag() == tag;
+
+    return false;
+}
+
 /**
  *  Retrieves the actual sequence, based on the pattern/sequence number.
  *  This is the const version.  Note that it is more efficient to call
@@ -2184,6 +2529,8 @@ performer::remove_sequence (seq::number seqno)
     bool result = set_mapper().remove_sequence(seqno);
     if (result)
     {
+        song_timeline_stale();
+        tempo_map_stale();
         seq::number buttonno = seqno - playscreen_offset();
         send_seq_event(buttonno, midicontrolout::seqaction::removed);
         record_by_buss(sequence_inbus_setup(true));
@@ -2358,6 +2705,26 @@ performer::fix_pattern (seq::number seqno, fixparameters & params)
 
 bool
 performer::set_ppqn (int p)
+{
+    bool result = apply_ppqn(p);
+    if (result)
+    {
+        notify_resolution_change                        /* ca 2023-10-30    */
+        (
+            ppqn(), get_beats_per_minute(), change::no
+        );
+    }
+    return result;
+}
+
+/**
+ *  Does the work of set_ppqn(), but without the notification, so that
+ *  change_ppqn() can notify the user-interface once, after the patterns
+ *  are rescaled.
+ */
+
+bool
+performer::apply_ppqn (int p)
 {
     bool result = m_ppqn != p && ppqn_in_range(p);
     if (result)
@@ -2366,12 +2733,9 @@ performer::set_ppqn (int p)
         {
             m_ppqn = p;
             m_one_measure = m_fast_ticks = 0;
+            tempo_map_stale();
             (void) jack_set_ppqn(p);
             m_master_bus->set_ppqn(p);
-            notify_resolution_change                    /* ca 2023-10-30    */
-            (
-                ppqn(), get_beats_per_minute(), change::no
-            );
         }
         else
         {
@@ -2423,37 +2787,92 @@ performer::ppqn () const
  *  Goes through all sets and sequences, updating the PPQN of the events and
  *  triggers.  It also, via notify_resolution_change(), sets the modify flag.
  *
- *  Currently operates only on the current screenset.
+ *  This is done only while stopped:  the output thread then is not walking
+ *  the patterns or the tempo map, and the current tick and the L and R
+ *  markers can be rescaled along with the patterns, so that nothing is left
+ *  in the old PPQN.  The user-interface is notified once, at the end; it
+ *  need not rebuild anything but what depends on the PPQN.
+ *
+ * \param p
+ *      The new PPQN.
+ *
+ * \return
+ *      Returns false if the PPQN is invalid or unchanged, or if playback is
+ *      under way.
  */
 
 bool
 performer::change_ppqn (int p)
 {
-    bool result = set_ppqn(p);                  /* performer & master bus   */
+    if (is_running())
+    {
+        append_error_message("Stop playback to change the PPQN");
+        return false;
+    }
+
+    int oldppqn = m_ppqn;
+    midipulse lefttick = m_left_tick;
+    midipulse righttick = m_right_tick;
+    midipulse tick = get_tick();
+    bool result = apply_ppqn(p);                /* performer & master bus   */
     if (result)
     {
-        set_mapper().exec_set_function
-        (
-            [p] (seq::pointer sp, seq::number /*sn*/)
-            {
-                bool result = bool(sp);
-                if (result)
-                    sp->change_ppqn(p);
+        rescale_patterns(p);
+        m_left_tick = rescale_tick(lefttick, p, oldppqn);
+        m_right_tick = rescale_tick(righttick, p, oldppqn);
+        if (m_right_tick <= m_left_tick)
+            m_right_tick = m_left_tick + m_one_measure;
 
-                return result;
-            }
-        );
-        if (result)
-        {
-            change ch = rc().midi_filename().empty() ?
-                change::no : change:: yes;
+        m_tick = rescale_tick(tick, p, oldppqn);
+        song_timeline_stale();
 
-            notify_resolution_change(ppqn(), get_beats_per_minute(), ch);
-        }
+        change ch = rc().midi_filename().empty() ?
+            change::no : change:: yes;
+
+        notify_resolution_change(ppqn(), get_beats_per_minute(), ch);
     }
     return result;
 }
 
+/**
+ *  Rescales every pattern to a new PPQN.  Each pattern is rescaled under
+ *  its own lock, and touches nothing shared (see sequence::change_ppqn()),
+ *  so a large tune is split among a few threads by parallel_for().  A
+ *  small one is done by the caller alone, as it takes less time than
+ *  starting a thread.
+ *
+ * \param p
+ *      The new PPQN.
+ */
+
+void
+performer::rescale_patterns (int p)
+{
+    static const std::size_t s_patterns_per_thread = 32;
+    std::vector<seq::pointer> patterns;
+    set_mapper().exec_set_function
+    (
+        [&patterns] (seq::pointer sp, seq::number /*sn*/)
+        {
+            if (sp)
+                patterns.push_back(sp);
+
+            return true;
+        }
+    );
+
+    std::size_t count = patterns.size();
+    std::size_t threads = count / s_patterns_per_thread;
+    parallel_for
+    (
+        count, [&patterns, p] (std::size_t i)
+        {
+            (void) patterns[i]->change_ppqn(p);
+        },
+        std::min(threads, parallel_cores())
+    );
+}
+
 /**
  *  Goes through all the sequences in the current play-set, updating the
  *  output buss to the same (global) buss number.
@@ -2587,6 +3006,7 @@ void
 performer::inner_stop (bool midiclock)
 {
     is_running(false);
+    m_frame_clock.clear();              /* no more frames to go by          */
     reset_sequences();                  /* resets, and flushes the buss     */
     m_usemidiclock = midiclock;
     send_onoff_event(midicontrolout::uiaction::stop, true);
@@ -2737,6 +3157,49 @@ performer::set_beats_per_minute (midibpm bp, bool user_change)
     return result;
 }
 
+/**
+ *  Called by sequence::play() for a tempo event in the frame, in place of
+ *  set_beats_per_minute(), which validates the tempo, updates JACK and the
+ *  master buss, and notifies the user interface, all of which once happened
+ *  with the pattern's lock held.  Cheap enough to be called for every beat
+ *  of a rubato tempo track.
+ *
+ * \param tick
+ *      The tick of the tempo event, in the song.
+ *
+ * \param bp
+ *      The new tempo.
+ */
+
+void
+performer::schedule_tempo (midipulse tick, midibpm bp)
+{
+    static const std::memory_order relaxed = std::memory_order_relaxed;
+    midibpm pending = m_tempo_pending.load(relaxed);
+    if (pending == 0.0 || tick >= m_tempo_pending_tick.load(relaxed))
+    {
+        m_tempo_pending_tick.store(tick, relaxed);
+        m_tempo_pending.store(bp, std::memory_order_release);
+    }
+}
+
+/**
+ *  Sets the tempo posted by schedule_tempo(), if any.  Called by play()
+ *  after the frame is played and flushed, and by the song renderer after
+ *  each of its frames.  The new tempo takes effect from the next frame, so
+ *  it lands at most one frame past the tick of its event.
+ *
+ * \return
+ *      Returns true if the tempo was changed.
+ */
+
+bool
+performer::apply_scheduled_tempo ()
+{
+    midibpm bp = m_tempo_pending.exchange(0.0, std::memory_order_acquire);
+    return bp > 0.0 ? set_beats_per_minute(bp) : false ;
+}
+
 /**
  *  This is a faster version, meant for jack_assistant to call.  This logic
  *  matches the original seq24, but is it really correct?  Well, we fixed it
@@ -2779,6 +3242,11 @@ performer::jack_set_beats_per_minute (midibpm bp, bool user_change)
 
         m_bpm = bp;
         m_us_per_quarter_note = tempo_us_from_bpm(bp);  /* seqfault cause?  */
+        if (user_change || ! is_running())              /* not a tempo event*/
+        {
+            m_tempo_map_bpm = bp;
+            tempo_map_stale();
+        }
 
         /*
          * ca 2023-04-06 During playlist, changing the BPM by loading the
@@ -3172,15 +3640,13 @@ performer::reset_sequences (bool p)
 {
     void (sequence::* f) (bool) = p ? &sequence::pause : &sequence::stop ;
     bool songmode = song_mode();
+    (void) apply_bulk_ops();                /* no longer for the output     */
+    begin_output_batch();                   /* one flush for all note-offs  */
     for (auto & seqi : play_set().seq_container())
         (seqi.get()->*f)(songmode);
 
-    /*
-     * Alread flushed in the loop above.
-     *
-     * if (m_master_bus)
-     *     m_master_bus->flush();
-     */
+    end_output_batch();                     /* flushes the master buss      */
+    m_pad_launcher.reset();                 /* the notes are off already    */
 }
 
 /**
@@ -3244,10 +3710,35 @@ performer::repitch_fix
     return result;
 }
 
+/**
+ *  Plays a pattern through the note-map, without changing its notes, for
+ *  example to hear a General MIDI drum part on a device's drum kit.  The
+ *  note-map is the one opened at startup, from the 'rc' setting.
+ *
+ * \param s
+ *      The pattern.
+ *
+ * \param on
+ *      If true, remap the notes as played, otherwise stop doing so.
+ *
+ * \return
+ *      Returns false if turning on and no note-map file is loaded.
+ */
+
 bool
-performer::repitch_selected (const std::string & nmapfile, seq::ref s)
+performer::live_notemap (seq::ref s, bool on)
 {
-    bool result = open_note_mapper(nmapfile);
+    bool result = ! on || (notemap_exists() && m_note_mapper->mode());
+    if (result)
+        s.live_notemap(on ? m_note_mapper.get() : nullptr);
+
+    return result;
+}
+
+bool
+performer::repitch_selected (const std::string & nmapfile, seq::ref s)
+{
+    bool result = open_note_mapper(nmapfile);
     if (result)
         result = s.repitch(*m_note_mapper);
 
@@ -3302,6 +3793,89 @@ performer::set_song_mute (mutegroups::action op)
     }
 }
 
+/**
+ *  Mutes, arms, or toggles all of the patterns.  When not playing, this is
+ *  done at once, as it always was.  While playing, the operation on the
+ *  sets of the play-set is posted, in constant time, for the output thread
+ *  to apply at the top of its next frame, so that all of the patterns
+ *  change together, and the rest of the sets, which are not playing, are
+ *  changed here.
+ *
+ *  Pending song-mute toggles are applied first, so that the operations
+ *  land in the order made.
+ *
+ * \param o
+ *      The operation, bulkops::op::mute, arm, or toggle.
+ */
+
+void
+performer::post_bulk_op (bulkops::op o)
+{
+    bulkops::bits playing = 0;
+    if (is_running())
+    {
+        if (m_bulk_ops.song_pending())
+            (void) apply_bulk_ops();
+
+        playing = play_set_bits();
+        if (playing != 0)
+            m_bulk_ops.post(o, playing);
+    }
+    set_mapper().bulk_op(o, playing);
+}
+
+/**
+ *  Toggles the song-mutes of all of the patterns, in the same way as
+ *  post_bulk_op().
+ */
+
+void
+performer::toggle_all_song_mutes ()
+{
+    bulkops::bits playing = 0;
+    if (is_running())
+    {
+        if (m_bulk_ops.armed_pending())
+            (void) apply_bulk_ops();
+
+        playing = play_set_bits();
+        if (playing != 0)
+            m_bulk_ops.post_song_toggle(playing);
+    }
+    set_mapper().bulk_song_toggle(playing);
+}
+
+/**
+ *  Applies the pending bulk operations to the play-set.  Called by the
+ *  output thread in play(), and by the threads that stop playback or
+ *  change the play-set.
+ *
+ * \return
+ *      Returns the number of patterns changed.
+ */
+
+int
+performer::apply_bulk_ops ()
+{
+    return m_bulk_ops.apply(play_set().seq_container(), screenset_size());
+}
+
+/**
+ *  Gets the bits of the sets in the play-set, as bulkops uses them.
+ */
+
+bulkops::bits
+performer::play_set_bits () const
+{
+    bulkops::bits result = 0;
+    for (int s = 0; s < c_max_sets; ++s)
+    {
+        if (play_set().set_found(s))
+            result |= bulkops::set_bit(s);
+    }
+    return result;
+}
+
 /**
  *  Creates the mastermidibus.  We need to delay creation until launch time,
  *  so that settings can be obtained before determining just how to set up the
@@ -3392,6 +3966,7 @@ performer::launch (int ppqn)
 #else
     bool allow_unavailable_devices = false;
 #endif
+    startup_phase ports("port enumeration");
     bool result = create_master_bus();      /* calls set_port_statuses()    */
     if (result)
     {
@@ -3400,7 +3975,15 @@ performer::launch (int ppqn)
 
         m_master_bus->init(ppqn, m_bpm);    /* calls api_init() per API     */
         debug_message("bus API init'd");
+        m_mirror_primary = rc().is_mirror_primary();
+        m_mirror_following = rc().is_mirror_replica();
+        if (m_mirror_following)
+            m_master_bus->standby(true);    /* a hot spare, silent for now  */
+        ports.finish();
+
+        startup_phase activation("port activation");
         result = activate();
+        activation.finish();
         if (result)
         {
             debug_message("master bus active");
@@ -3472,9 +4055,19 @@ performer::launch (int ppqn)
                 m_midi_control_out.true_buss(truebus);
             }
             m_io_active = true;                     /* set done()           */
+            if (! rc().session_log().empty())
+                m_session_log.start(rc().session_log_filename());
+
+            if (rc().rt_safe())
+            {
+                if (lock_memory())
+                    info_message("Memory locked for rt-safe mode");
+                else
+                    warn_message("Couldn't lock memory; raise memlock limit");
+            }
             launch_input_thread();
             launch_output_thread();
-            midi_control_out().send_macro(midimacros::startup);
+            midi_control_out().send_macro(midi_control_out().startup_macro());
             announce_playscreen();
             announce_mutes();
             announce_automation();
@@ -3502,6 +4095,53 @@ performer::launch (int ppqn)
     return result;
 }
 
+/**
+ *  Sets up the master buss and its ports as launch() does, but starts
+ *  neither the input and output threads nor JACK transport.  Used by the
+ *  replay harness (see replaybench.hpp), which calls dispatch_midi_input()
+ *  and play() itself from a virtual clock, so that a run does not depend
+ *  on the timing of the machine.  Meant for the null MIDI API.  finish()
+ *  works as usual afterward.
+ *
+ * \param ppqn
+ *      Provides the PPQN value, assumed to be valid.
+ *
+ * \return
+ *      Returns true if the master buss is active.
+ */
+
+bool
+performer::launch_offline (int ppqn)
+{
+    bool result = create_master_bus();
+    if (result)
+    {
+        m_master_bus->init(ppqn, m_bpm);
+        result = activate();
+        m_master_bus->copy_io_busses();
+        m_master_bus->get_port_statuses(m_clocks, m_inputs);
+    }
+    if (result)
+    {
+        if (midi_control_in().is_enabled())
+        {
+            bussbyte namedbus = m_midi_control_in.nominal_buss();
+            m_midi_control_in.true_buss(true_input_bus(namedbus));
+        }
+        if (midi_control_out().is_enabled())
+        {
+            bussbyte namedbus = m_midi_control_out.nominal_buss();
+            m_midi_control_out.true_buss(true_output_bus(namedbus));
+        }
+        m_io_active = true;                         /* set done()           */
+        (void) set_playing_screenset(screenset::number(0));
+    }
+    else
+        m_error_pending = true;
+
+    return result;
+}
+
 /**
  *  Iterate through the current set of patterns (in the playset only!) to find
  *  those that might specify an input buss. Only one pattern can grab ahold of
@@ -3566,6 +4206,12 @@ performer::sequence_inbus_setup (bool changed)
             }
         }
         record_by_buss(result);
+
+        recordroutes::pointer routes;
+        if (result)
+            routes = recordroutes::by_buss(m_buss_patterns);
+
+        std::atomic_store(&m_buss_routes, routes);
     }
     return result;
 }
@@ -3578,33 +4224,31 @@ void
 performer::sequence_inbus_clear ()
 {
     m_buss_patterns.clear();
+    std::atomic_store(&m_buss_routes, recordroutes::pointer());
     record_by_buss(false);
 }
 
 /**
- *  Looks for the first matching input-buss in the list of patterns that
- *  have an input bus set.
+ *  Looks up the first pattern with the event's input buss, via the routing
+ *  table, rather than searching the list of patterns that have an input
+ *  buss set.
+ *
+ * \return
+ *      Returns null if no pattern has the buss, or if the first one does
+ *      not take the event's channel.
  */
 
 sequence *
 performer::sequence_inbus_lookup (const event & ev)
 {
     sequence * result = nullptr;
-#if defined USE_OLD_CODE
-    size_t b = size_t(ev.input_bus());
-    if (b < m_buss_patterns.size())
-        result = m_buss_patterns[b];
-#else
-    bussbyte b = ev.input_bus();
-    for (auto seqi : m_buss_patterns)
+    recordroutes::pointer routes = std::atomic_load(&m_buss_routes);
+    if (routes)
     {
-        if (b == seqi->true_in_bus())
-        {
-            result = seqi;
-            break;
-        }
+        const recordroutes::route * r = routes->find(ev);
+        if (not_nullptr(r) && ! r->rr_targets.empty())
+            result = r->rr_targets.front();
     }
-#endif
     return result;
 }
 
@@ -3853,6 +4497,57 @@ performer::set_beat_width (int bw, bool user_change)
  *  member directly.
  */
 
+/**
+ *  Applies the 'rc' scheduling and CPU settings to an I/O thread, and logs
+ *  the result.  A failure is only a warning; the application can limp
+ *  along without real-time scheduling.
+ *
+ * \param t
+ *      The thread, already running.
+ *
+ * \param name
+ *      The name of the thread for the log.
+ *
+ * \param policy
+ *      The scheduling policy, "fifo", "rr", or "other".
+ *
+ * \param priority
+ *      The thread's own priority.  If 0, the 'priority' setting is used, if
+ *      enabled.  If there is none, the policy is not applied.
+ *
+ * \param cpus
+ *      The CPU list, such as "2,3".  If empty, the thread may run on any.
+ */
+
+static void
+schedule_thread
+(
+    std::thread & t, const std::string & name,
+    const std::string & policy, int priority, const std::string & cpus
+)
+{
+    if (priority == 0 && rc().priority())           /* Not in MinGW RCB     */
+        priority = rc().thread_priority();
+
+    bool changed = false;
+    if (priority > 0)
+    {
+        if (set_thread_scheduling(t, policy, priority))
+            changed = true;
+        else
+            warn_message(name + ": couldn't set priority; need RT rights.");
+    }
+    if (! cpus.empty())
+    {
+        if (set_thread_affinity(t, parse_cpu_list(cpus)))
+            changed = true;
+        else
+            warn_message(name + ": couldn't set CPUs", cpus);
+    }
+    if (changed || rc().verbose())
+        info_message(name + " thread", thread_scheduling(t));
+}
+
 void
 performer::launch_output_thread ()
 {
@@ -3863,30 +4558,36 @@ performer::launch_output_thread ()
     }
     if (! m_out_thread_launched)
     {
+        int workers = rc().output_workers();
+        if (workers > 0)
+        {
+            m_play_pool.reset(new (std::nothrow) playpool(workers));
+            if (m_play_pool)
+                infoprintf("%d output workers", workers);
+        }
         m_out_thread = std::thread(&performer::output_func, this);
         m_out_thread_launched = true;
         debug_message("Output thread launched");
-        if (rc().priority())                        /* Not in MinGW RCB     */
+        schedule_thread
+        (
+            m_out_thread, "Output", rc().output_policy(),
+            rc().output_priority(), rc().output_cpus()
+        );
+        if (m_play_pool)
         {
-            int p = rc().thread_priority();
-            bool ok = set_thread_priority(m_out_thread, p);
-            if (ok)
-            {
-                warn_message("Output priority", std::to_string(p));
-            }
-            else
+            std::vector<int> cpus = parse_cpu_list(rc().worker_cpus());
+            for (int w = 0; w < m_play_pool->workers(); ++w)
             {
-                warn_message
+                std::string cpu;
+                if (! cpus.empty())
+                    cpu = std::to_string(cpus[std::size_t(w) % cpus.size()]);
+
+                schedule_thread
                 (
-                    "Output: couldn't set priority; need root priviledges."
+                    m_play_pool->worker_thread(w),
+                    "Worker " + std::to_string(w + 1),
+                    rc().output_policy(), rc().output_priority(), cpu
                 );
-
-                /*
-                 * We don't need to exit. Let the app limp along.
-                 *
-                 *      pthread_exit(0);
-                 *      m_out_thread_launched = false;
-                 */
             }
         }
     }
@@ -3902,32 +4603,21 @@ performer::launch_input_thread ()
 {
     if (!  m_in_thread_launched)
     {
+        std::string capturedir = rc().input_capture_directory();
+        if (! capturedir.empty())
+        {
+            m_input_capture.reset(new (std::nothrow) inputcapture(capturedir));
+            if (m_input_capture && ! m_input_capture->start())
+                m_input_capture.reset();
+        }
         m_in_thread = std::thread(&performer::input_func, this);
         m_in_thread_launched = true;
         debug_message("Input thread launched");
-        if (rc().priority())                        /* Not in MinGW RCB     */
-        {
-            int p = rc().thread_priority();
-            bool ok = set_thread_priority(m_in_thread, p);
-            if (ok)
-            {
-                warn_message("Input priority", std::to_string(p));
-            }
-            else
-            {
-                warn_message
-                (
-                    "Input: couldn't set priority; need root priviledges."
-                );
-
-                /*
-                 * We don't need to exit. Let the app limp along.
-                 *
-                 *      pthread_exit(0);
-                 *      m_in_thread_launched = false;
-                 */
-            }
-        }
+        schedule_thread
+        (
+            m_in_thread, "Input", rc().input_policy(),
+            rc().input_priority(), rc().input_cpus()
+        );
     }
 }
 
@@ -3959,7 +4649,7 @@ performer::finish ()
         stop_playing();                     /* see notes in banner          */
         reset_sequences();                  /* stop all output upon exit    */
         announce_exit(true);                /* blank device completely      */
-        midi_control_out().send_macro(midimacros::shutdown);
+        midi_control_out().send_macro(midi_control_out().shutdown_macro());
         m_io_active = false;                /* set done() for predicate     */
         m_is_running = false;               /* set is_running() off         */
         cv().signal();                      /* signal the end of play       */
@@ -3968,11 +4658,16 @@ performer::finish ()
             m_out_thread.join();
             m_out_thread_launched = false;
         }
+        m_play_pool.reset();                /* joins any output workers     */
         if (m_in_thread_launched && m_in_thread.joinable())
         {
             m_in_thread.join();
             m_in_thread_launched = false;
         }
+        m_input_capture.reset();            /* writes the rest of the input */
+        if (m_session_log.stop())
+            info_message("Session log written", m_session_log.filename());
+
         result = deinit_jack_transport();
 
         /*
@@ -4606,6 +5301,25 @@ performer::jack_reposition (midipulse tick, midipulse stoptick)
  *
  *          if (next_clock_delta_us < (c_thread_trigger_width_us * 2.0))
  *
+ * Deadline scheduler:
+ *
+ *      If "output-scheduler = deadline" is set in the 'rc' file, the
+ *      relative sleep is replaced by an absolute one.  output_deadline()
+ *      finds the time of the next pattern event, MIDI clock pulse, or loop
+ *      point, and microsleep_until() waits for it, so that neither the time
+ *      spent in play() nor the sleep setup accumulates as jitter.  The wait
+ *      is capped by c_deadline_max_wait_us.  When following an external MIDI
+ *      clock, the legacy method is used, since the pace is not ours.
+ *
+ * JACK-driven engine:
+ *
+ *      If "output-scheduler = jack" is set, and a JACK MIDI client is
+ *      active, this thread only waits for the stop.  The JACK process
+ *      callback calls jack_engine_cycle(), which converts the frame count
+ *      to ticks and calls play_cycle() itself, so that the events are in
+ *      the port buffers of the very cycle they belong to, at frame offsets
+ *      derived from their ticks.
+ *
  * Stazed code (when ready):
  *
  *      If we reposition key-p, FF, rewind, adjust delta_tick for change then
@@ -4625,6 +5339,11 @@ performer::output_func ()
         return;
     }
     show_cpu();
+    if (rc().rt_safe())
+    {
+        prefault_stack();
+        rt_thread(true);                    /* count allocations here       */
+    }
     while (! done())                        /* the variable is atomic       */
     {
         cv().wait();                        /* lock mutex, predicate wait   */
@@ -4665,6 +5384,9 @@ performer::output_func ()
 
         pad().set_current_tick(startpoint);
         set_last_ticks(startpoint);
+        midibpm startbpm = tempo_at(startpoint);        /* tempo after seek */
+        if (startbpm > 0.0)
+            (void) set_beats_per_minute(startbpm);
 
         /*
          * We still need to make sure the BPM and PPQN changes are airtight!
@@ -4680,9 +5402,34 @@ performer::output_func ()
         long current;                           /* current time             */
         long elapsed_us, delta_us;              /* current - last           */
         long last = microtime();                /* beginning time           */
+        bool deadline = rc().is_scheduler_deadline();
+        bool jackdriven = jack_engine_start();  /* JACK cycle plays instead */
+        long waketarget = 0;                    /* when the sleep should end*/
+        long statinterval = long(rc().output_stats_s()) * 1000000L;
+        long statlast = last;                   /* last statistics log line */
         m_resolution_change = false;            /* BPM/PPQN                 */
+        if (m_link_sync.enabled() && ! jackdriven && ! m_usemidiclock)
+        {
+            midibpm bp = get_beats_per_minute();
+            m_link_sync.start(bp);              /* waits for the quantum    */
+            if (bp != get_beats_per_minute())
+                (void) set_beats_per_minute(bp);    /* the peers' tempo     */
+        }
         while (is_running())
         {
+            if (jackdriven)
+            {
+                /*
+                 * The JACK process callback is doing the playing.  Just
+                 * watch for a JACK transport stop.
+                 */
+
+                (void) microsleep(c_thread_trigger_width_us);
+                if (pad().js_jack_stopped)
+                    inner_stop();
+
+                continue;
+            }
             if (m_resolution_change)            /* an atomic boolean        */
             {
                 bwdenom = 4.0 / get_beat_width();
@@ -4700,137 +5447,102 @@ performer::output_func ()
              */
 
             current = microtime();
+            if (waketarget > 0)
+            {
+                m_output_stats.wakeup(current - waketarget);
+                waketarget = 0;
+            }
             delta_us = elapsed_us = current - last;
 
             long long delta_tick_num = bpm_times_ppqn * delta_us +
                 pad().js_delta_tick_frac;
 
             long delta_tick = long(delta_tick_num / 60000000LL);
+            long playcount = m_master_bus->play_count();
             pad().js_delta_tick_frac = long(delta_tick_num % 60000000LL);
-            if (m_usemidiclock)
-            {
-                delta_tick = m_midiclocktick;       /* int to long          */
-                m_midiclocktick = 0;
-                if (m_midiclockpos >= 0)            /* was after this if    */
-                {
-                    delta_tick = 0;
-                    pad().set_current_tick(midipulse(m_midiclockpos));
-                    m_midiclockpos = -1;
-                }
-            }
-
-            bool jackrunning = jack_output(pad());
-            if (jackrunning)
-            {
-                // No additional code needed besides the output() call above.
-            }
-            else
-                pad().add_delta_tick(delta_tick);   /* add to current ticks */
+            play_cycle(delta_tick);
 
             /*
-             * pad().js_init_clock will be true when we run for the first time,
-             * or as soon as JACK gets a good lock on playback.
+             *  See "microsleep() call" in banner.  Code is similar to line
+             *  3096 above.
              */
 
-            if (pad().js_init_clock)
+            last = current;
+            current = microtime();
+            elapsed_us = current - last;
+            m_output_stats.frame
+            (
+                elapsed_us, m_master_bus->play_count() - playcount
+            );
+            if (statinterval > 0 && current - statlast >= statinterval)
             {
-                m_master_bus->init_clock(midipulse(pad().js_clock_tick));
-                pad().js_init_clock = false;
+                info_message("Output", output_statistics().to_string());
+                statlast = current;
             }
-            if (pad().js_dumping)
+            if (deadline && ! m_usemidiclock)
             {
-                if (looping())
-                {
-                    /*
-                     * This stazed JACK code works better than the original
-                     * code, so it is now permanent code.
-                     */
-
-                    static bool jack_position_once = false;
-                    midipulse rtick = get_right_tick();     /* can change? */
-                    if (pad().js_current_tick >= rtick)
-                    {
-                        if (is_jack_master() && ! jack_position_once)
-                        {
-                            position_jack(true, get_left_tick());
-                            jack_position_once = true;
-                        }
-
-                        double leftover_tick = pad().js_current_tick - rtick;
-                        if (jack_transport_not_starting())  /* no FF/RW xrun */
-                        {
-                            play(rtick - 1);
-                        }
-                        reset_sequences();
-
-                        midipulse ltick = get_left_tick();
-                        set_last_ticks(ltick);
-                        pad().js_current_tick = double(ltick) + leftover_tick;
-                    }
-                    else
-                        jack_position_once = false;
-                }
-
                 /*
-                 * Don't play during JackTransportStarting to avoid xruns on
-                 * FF or RW.
+                 * Sleep until the absolute time of the next event, clock
+                 * pulse, or loop point.  A negative delta is lateness.
                  */
 
-                if (jack_transport_not_starting())
+                long target = output_deadline(last, pus, dct);
+                if (target > current)
                 {
-                    play(midipulse(pad().js_current_tick));
+                    (void) microsleep_until(target);
+                    m_delta_us = 0;
+                    waketarget = target;
+                }
+                else
+                {
+                    m_delta_us = target - current;
+                    m_output_stats.underrun(current - target);
+                    perftrace_mark("underrun");
                 }
-
-                /*
-                 * The next line enables proper pausing in both old and seq32
-                 * JACK builds.
-                 */
-
-                set_jack_tick(pad().js_current_tick);
-                m_master_bus->emit_clock(midipulse(pad().js_clock_tick));
-            }
-
-            /*
-             *  See "microsleep() call" in banner.  Code is similar to line
-             *  3096 above.
-             */
-
-            last = current;
-            current = microtime();
-            elapsed_us = current - last;
-            delta_us = c_thread_trigger_width_us - elapsed_us;
-
-            double next_clock_delta = dct - 1;
-            double next_clock_delta_us = next_clock_delta * pus;
-            if (next_clock_delta_us < (c_thread_trigger_width_us * 2.0))
-                delta_us = long(next_clock_delta_us);
-
-            if (delta_us > 0)
-            {
-                (void) microsleep(int(delta_us));           /* timing.hpp   */
-                m_delta_us = 0;
             }
             else
             {
-#if defined SEQ66_PLATFORM_DEBUG && ! defined SEQ66_PLATFORM_WINDOWS
-                if (seq_app_cli())
+                delta_us = c_thread_trigger_width_us - elapsed_us;
+
+                double next_clock_delta = dct - 1;
+                double next_clock_delta_us = next_clock_delta * pus;
+                if (next_clock_delta_us < (c_thread_trigger_width_us * 2.0))
+                    delta_us = long(next_clock_delta_us);
+
+                if (delta_us > 0)
                 {
-                    if (delta_us != 0)
+                    (void) microsleep(int(delta_us));       /* timing.hpp   */
+                    m_delta_us = 0;
+                    waketarget = current + delta_us;
+                }
+                else
+                {
+                    m_output_stats.underrun(-delta_us);
+                    perftrace_mark("underrun");
+#if defined SEQ66_PLATFORM_DEBUG && ! defined SEQ66_PLATFORM_WINDOWS
+                    if (seq_app_cli())
                     {
-                        print_client_tag(msglevel::warn);
-                        fprintf
-                        (
-                            stderr, "Play underrun %ld us          \r",
-                            delta_us
-                        );
+                        if (delta_us != 0)
+                        {
+                            print_client_tag(msglevel::warn);
+                            fprintf
+                            (
+                                stderr, "Play underrun %ld us          \r",
+                                delta_us
+                            );
+                        }
                     }
-                }
 #endif
-                m_delta_us = delta_us;
+                    m_delta_us = delta_us;
+                }
             }
             if (pad().js_jack_stopped)
                 inner_stop();
         }
+        if (jackdriven)
+            jack_engine_stop();
+
+        m_link_sync.stop();                     /* stops the Link peers     */
 
         /*
          * Disabling this setting allows all of the progress bars (seqroll,
@@ -4861,41 +5573,603 @@ performer::output_func ()
 }
 
 /**
- *  Trying to prevent seqfaults when stopping playback and starting the next
- *  song, as in play-lists.
+ *  Plays one cycle of output, starting at the scratchpad's current tick.
+ *  This is the body of the output_func() loop, and is also called from the
+ *  JACK process callback when the JACK-driven engine is in force.  It
+ *  applies MIDI clock or JACK transport, advances the current tick, handles
+ *  the loop markers, plays the patterns, and emits MIDI clock.
+ *
+ * \param delta_tick
+ *      The number of ticks the cycle covers, based on elapsed time or on the
+ *      frame count.  Replaced by the MIDI clock value if following MIDI
+ *      clock.
  */
 
 void
-performer::is_pattern_playing (bool flag)
+performer::play_cycle (long delta_tick)
 {
-    m_is_pattern_playing = flag;
-}
+    trace_scope ts("play cycle");
+    if (m_usemidiclock)
+    {
+        if (hot().midi_clock_follow())
+            delta_tick = m_clock_follower.advance(microtime());
+        else
+            delta_tick = m_midiclocktick;   /* int to long          */
 
-/**
- *  This function is called by input_thread_func().  It handles certain MIDI
- *  input events.  Many of them are now handled by functions for easier reading
- *  and trouble-shooting (of MIDI clock).
- *
- *  For events less than or equal to SysEx, we call midi_control_event() to
- *  handle the MIDI controls that Sequencer64 supports.  (These are
- *  configurable in the "rc" configuration file.) We test for MIDI control
- *  events even if "dumping".  Otherwise, we cannot handle any more control
- *  events once recording is turned on.  Warning:  This can slow down
- *  recording.
- *
- *  "Dumping" means that we are dumping MIDI input events into a sequence.
- *  It means "recording".
- *
- *  We currently ignore these events on input.  MIGHT NOT BE VALID.  STILL
- *  INVESTIGATING.  EVENT_MIDI_ACTIVE_SENSE and EVENT_MIDI_RESET are filtered
- *  in midi_jack.  Send out the current event, if "dumping".
- *
- *  ev.get_status() ==
- *
- *      EVENT_MIDI_ACTIVE_SENSE  handled elsewhere
- *      EVENT_MIDI_RESET handled elsewhere
- *      EVENT_MIDI_QUARTER_FRAME
- *      EVENT_MIDI_SONG_SELECT
+        m_midiclocktick = 0;
+        if (m_midiclockpos >= 0)            /* was after this if    */
+        {
+            delta_tick = 0;
+            pad().set_current_tick(midipulse(m_midiclockpos));
+            m_midiclockpos = -1;
+        }
+    }
+    else if (m_link_sync.playing() && ! is_jack_running())
+    {
+        midibpm bp = get_beats_per_minute();
+        double tpb = double(m_master_bus->get_ppqn()) * 4.0 /
+            double(get_beat_width());
+
+        delta_tick = m_link_sync.advance(tpb, bp);
+        if (bp != get_beats_per_minute())
+            (void) set_beats_per_minute(bp);    /* a peer changed it        */
+    }
+
+    if (m_mirror_pos.load(std::memory_order_relaxed) >= 0)
+    {
+        long mirrorpos = m_mirror_pos.exchange(-1); /* replica catching up */
+        delta_tick = 0;
+        pad().set_current_tick(midipulse(mirrorpos));
+        reset_sequences();
+        set_last_ticks(midipulse(mirrorpos));
+    }
+
+    bool jackrunning = jack_output(pad());
+    if (jackrunning)
+    {
+        // No additional code needed besides the output() call above.
+    }
+    else
+        pad().add_delta_tick(delta_tick);   /* add to current ticks */
+
+    /*
+     * pad().js_init_clock will be true when we run for the first time,
+     * or as soon as JACK gets a good lock on playback.
+     */
+
+    if (pad().js_init_clock)
+    {
+        m_master_bus->init_clock(midipulse(pad().js_clock_tick));
+        pad().js_init_clock = false;
+    }
+    if (pad().js_dumping)
+    {
+        if (looping())
+        {
+            /*
+             * This stazed JACK code works better than the original
+             * code, so it is now permanent code.
+             */
+
+            static bool jack_position_once = false;
+            midipulse rtick = get_right_tick();     /* can change? */
+            if (pad().js_current_tick >= rtick)
+            {
+                if (is_jack_master() && ! jack_position_once)
+                {
+                    position_jack(true, get_left_tick());
+                    jack_position_once = true;
+                }
+
+                /*
+                 * The frame is played in two slices, up to the right tick
+                 * and then from the left tick.  The patterns are not all
+                 * stopped and rewound here, which took every pattern's
+                 * lock at the loop point; each one does it the first time
+                 * it plays or is skipped after the wrap.
+                 */
+
+                double leftover_tick = pad().js_current_tick - rtick;
+                if (jack_transport_not_starting())  /* no FF/RW xrun */
+                {
+                    play(rtick - 1);
+                }
+
+                midipulse ltick = get_left_tick();
+                m_wrap_tick.store(ltick, std::memory_order_relaxed);
+                m_wrap_generation.fetch_add(1, std::memory_order_release);
+                pad().js_current_tick = double(ltick) + leftover_tick;
+            }
+            else
+                jack_position_once = false;
+        }
+
+        /*
+         * Don't play during JackTransportStarting to avoid xruns on
+         * FF or RW.
+         */
+
+        /*
+         * The clock pulses go out before the patterns are played, so that
+         * their timing does not depend on how busy the frame is.  The exact
+         * play position lets a scheduling API place each pulse at its own
+         * time.  The clock tick does not wrap at the loop, so it is the
+         * position for the pulses, and the current tick the one for the
+         * patterns.
+         */
+
+        m_master_bus->frame_tick(pad().js_clock_tick);  /* for lookahead    */
+        m_master_bus->emit_clock(midipulse(pad().js_clock_tick));
+        m_master_bus->frame_tick(pad().js_current_tick);
+        if (jack_transport_not_starting())
+        {
+            play(midipulse(pad().js_current_tick));
+        }
+
+        /*
+         * The next line enables proper pausing in both old and seq32
+         * JACK builds.
+         */
+
+        set_jack_tick(pad().js_current_tick);
+    }
+}
+
+/**
+ *  Installs the JACK-driven engine hook, if "output-scheduler = jack" is
+ *  set and a JACK MIDI client is running its process callback.
+ *
+ * \return
+ *      Returns true if the JACK process callback will now do the playing.
+ */
+
+bool
+performer::jack_engine_start ()
+{
+#if defined SEQ66_JACK_SUPPORT
+    bool result =
+        rc().is_scheduler_jack() && jack_assistant::engine_available();
+
+    if (result)
+        jack_assistant::engine(jack_engine_callback, this);
+
+    return result;
+#else
+    return false;
+#endif
+}
+
+/**
+ *  Removes the JACK-driven engine hook, then waits for a cycle that might
+ *  still be in progress, so that playback is really finished when the
+ *  output thread continues with flushing and stopping the busses.
+ */
+
+void
+performer::jack_engine_stop ()
+{
+#if defined SEQ66_JACK_SUPPORT
+    jack_assistant::engine(nullptr, nullptr);
+    while (m_jack_engine_busy)
+        (void) microsleep(100);
+#endif
+}
+
+#if defined SEQ66_JACK_SUPPORT
+
+/**
+ *  The jack_assistant::engine_function installed by jack_engine_start().
+ */
+
+bool
+performer::jack_engine_callback
+(
+    void * arg,
+    jack_nframes_t nframes,
+    jack_nframes_t rate,
+    jack_assistant::engine_window & window
+)
+{
+    performer * p = reinterpret_cast<performer *>(arg);
+    return not_nullptr(p) ?
+        p->jack_engine_cycle(nframes, rate, window) : false ;
+}
+
+/**
+ *  Plays one JACK process cycle.  This runs in the JACK process thread.
+ *  The frame count is converted to ticks with the same fractional
+ *  carry-over used by output_func() for microseconds, but in frames, so
+ *  that no tick is lost or doubled across cycles.
+ *
+ * \param nframes
+ *      The number of frames in this cycle.
+ *
+ * \param rate
+ *      The JACK sample rate.
+ *
+ * \param [out] window
+ *      Provides the tick at frame 0 of this cycle and the ticks per frame,
+ *      so that the JACK output code can calculate each event's frame
+ *      offset from its timestamp.
+ *
+ * \return
+ *      Returns true if the cycle was played.
+ */
+
+bool
+performer::jack_engine_cycle
+(
+    jack_nframes_t nframes,
+    jack_nframes_t rate,
+    jack_assistant::engine_window & window
+)
+{
+    bool result = is_running() && rate > 0;
+    if (result)
+    {
+        m_jack_engine_busy = true;
+        m_resolution_change = false;            /* recalculated each cycle  */
+
+        double bwdenom = 4.0 / get_beat_width();
+        midibpm bpmfactor = m_master_bus->get_beats_per_minute() * bwdenom;
+        long long bpm_times_ppqn =
+            (long long)(bpmfactor * m_master_bus->get_ppqn());
+
+        long long frames_per_minute = 60LL * rate;
+        long long delta_tick_num = bpm_times_ppqn * nframes +
+            pad().js_delta_tick_frac;
+
+        long delta_tick = long(delta_tick_num / frames_per_minute);
+        pad().js_delta_tick_frac = long(delta_tick_num % frames_per_minute);
+        window.ew_start_tick = pad().js_current_tick;
+        window.ew_ticks_per_frame =
+            double(bpm_times_ppqn) / double(frames_per_minute);
+
+        long start = microtime();
+        long playcount = m_master_bus->play_count();
+        play_cycle(delta_tick);
+        m_output_stats.frame
+        (
+            microtime() - start, m_master_bus->play_count() - playcount
+        );
+        m_jack_engine_busy = false;
+    }
+    return result;
+}
+
+#endif  // defined SEQ66_JACK_SUPPORT
+
+/**
+ *  Reads the output timing statistics, adding the ring-buffer figures of
+ *  the output and input busses.  Safe to call from any thread.
+ *
+ * \return
+ *      Returns the reading.  When the output thread is JACK-driven, there
+ *      are no wake-ups, and so no lateness figures.
+ */
+
+outputstats::values
+performer::output_statistics ()
+{
+    outputstats::values result = m_output_stats.get();
+    if (m_master_bus)
+    {
+        (void) m_master_bus->buffer_stats
+        (
+            result.ov_buffer_size, result.ov_buffer_max,
+            result.ov_buffer_dropped
+        );
+        (void) m_master_bus->input_buffer_stats
+        (
+            result.ov_input_buffer_size, result.ov_input_buffer_max,
+            result.ov_input_dropped
+        );
+    }
+    if (rc().rt_safe() && rt_check_enabled())
+        result.ov_rt_allocations = rt_allocations();
+
+    return result;
+}
+
+/**
+ *  Reads the memory held by the song data, by walking the patterns; see
+ *  memoryusage.  Meant for an occasional look from the user interface, not
+ *  for the output thread, since each pattern is locked in turn.
+ *
+ * \return
+ *      Returns the reading.  The event editors and the clipboard are
+ *      counted once, not per pattern.
+ */
+
+memoryusage
+performer::memory_usage () const
+{
+    memoryusage result;
+    for (int s = 0; s < sequence_high(); ++s)
+    {
+        if (is_seq_active(s))
+        {
+            const seq::pointer sp = get_sequence(s);
+            if (sp)
+                sp->memory_usage(result);
+        }
+    }
+    result.add
+    (
+        memoryusage::category::clipboard, sequence::clipboard_bytes()
+    );
+    result.add
+    (
+        memoryusage::category::editables, editable_events::open_bytes()
+    );
+    return result;
+}
+
+/**
+ *  The time the output thread has for one frame, its "trigger width".  A
+ *  frame that takes longer than this delays the next one.  The user
+ *  interface uses it to judge the load on the engine; see qframeclock.
+ */
+
+long
+performer::frame_budget_us ()
+{
+    return long(c_thread_trigger_width_us);
+}
+
+/**
+ *  Gets the count of incoming messages the input capture had no room for,
+ *  or 0 if there is no input capture.
+ */
+
+int
+performer::captures_dropped () const
+{
+    return m_input_capture ? m_input_capture->dropped() : 0 ;
+}
+
+/**
+ *  Finds the earliest tick, after the given tick, at which any pattern in
+ *  the play-set will emit an event or change state.  This is used by the
+ *  deadline output scheduler.
+ *
+ * \param tick
+ *      The tick that has just been played.
+ *
+ * \return
+ *      Returns the next tick of interest, or c_null_midipulse if none of the
+ *      patterns will produce any output.
+ */
+
+midipulse
+performer::next_output_tick (midipulse tick) const
+{
+    midipulse result = c_null_midipulse;
+    bool songmode = song_mode();
+    for (auto seqi : play_set().seq_container())
+    {
+        if (seqi)
+        {
+            midipulse t = seqi->next_event_tick(tick, songmode);
+            if (! is_null_midipulse(t))
+            {
+                if (is_null_midipulse(result) || t < result)
+                    result = t;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ *  Rebuilds the tempo map if it is stale.  The caller must hold
+ *  m_tempo_map_mutex.  Only the tempo track's tempo events are used, at
+ *  their own time stamps, as in the MIDI file.
+ */
+
+void
+performer::update_tempo_map () const
+{
+    if (m_tempo_map_stale.exchange(false))
+    {
+        m_tempo_map.clear(ppqn(), m_tempo_map_bpm);
+        const seq::pointer s = get_sequence(rc().tempo_track_number());
+        if (s)
+            s->fill_tempo_map(m_tempo_map);
+
+        m_tempo_map.build();
+    }
+}
+
+/**
+ *  Gets the tick at which an incoming event is to be recorded.  If the MIDI
+ *  API gave the time the event arrived, it is placed at that time, relative
+ *  to the last frame played, following the tempo map.  Otherwise, or when
+ *  not playing, it gets the current tick, as before.  The latency of the
+ *  event's input buss, if any, is taken off the arrival time; an event
+ *  without one is taken to arrive now.
+ *
+ * \param ev
+ *      The incoming event.
+ *
+ * \return
+ *      Returns the tick for the event's timestamp.
+ */
+
+midipulse
+performer::input_tick (const event & ev) const
+{
+    midipulse result = get_tick();
+    long arrival = ev.arrival_us();
+    long latency = long(hot().input_latency_us(int(ev.input_bus())));
+    long frameus;
+    double frametick;
+    if (arrival == 0 && latency > 0)
+        arrival = microtime();
+
+    if (arrival > 0 && m_frame_clock.get(frameus, frametick))
+    {
+        automutex locker(m_tempo_map_mutex);
+        update_tempo_map();
+
+        double us = m_tempo_map.tick_to_us(midipulse(frametick)) +
+            double(arrival - latency - frameus);
+
+        result = us > 0.0 ? m_tempo_map.us_to_tick(us) : 0 ;
+    }
+    return result;
+}
+
+/**
+ * \return
+ *      Returns the time of the tick from the start of the song, in
+ *      microseconds, following the tempo changes.
+ */
+
+double
+performer::tick_to_us (midipulse tick) const
+{
+    automutex locker(m_tempo_map_mutex);
+    update_tempo_map();
+    return m_tempo_map.tick_to_us(tick);
+}
+
+/**
+ * \return
+ *      Returns the tick at the time from the start of the song.
+ */
+
+midipulse
+performer::us_to_tick (double us) const
+{
+    automutex locker(m_tempo_map_mutex);
+    update_tempo_map();
+    return m_tempo_map.us_to_tick(us);
+}
+
+/**
+ * \return
+ *      Returns the tempo that playback has at the tick.
+ */
+
+midibpm
+performer::tempo_at (midipulse tick) const
+{
+    automutex locker(m_tempo_map_mutex);
+    update_tempo_map();
+    return m_tempo_map.bpm_at(tick);
+}
+
+/**
+ * \return
+ *      Returns the tick of the next tempo change after the tick, or
+ *      c_null_midipulse if there is none.
+ */
+
+midipulse
+performer::next_tempo_change (midipulse tick) const
+{
+    automutex locker(m_tempo_map_mutex);
+    update_tempo_map();
+    return m_tempo_map.next_change(tick);
+}
+
+/**
+ *  Calculates the absolute time (in the microtime() time base) at which the
+ *  output thread must wake up next.  This is the earliest of the next MIDI
+ *  clock pulse, the next event of any pattern in the play-set, the right
+ *  loop marker (when looping), the next tempo change, and the maximum wait,
+ *  c_deadline_max_wait_us.
+ *
+ * \param basetime
+ *      The time, in microseconds, at which the current tick of the
+ *      scratchpad was calculated.
+ *
+ * \param pus
+ *      The length of a pulse in microseconds.
+ *
+ * \param dct
+ *      The number of ticks per MIDI clock pulse.
+ *
+ * \return
+ *      Returns the deadline in microseconds.
+ */
+
+long
+performer::output_deadline (long basetime, double pus, double dct)
+{
+    double current = pad().js_current_tick;
+    double clock = pad().js_clock_tick;
+    double delta = (std::floor(clock / dct) + 1.0) * dct - clock;
+    midipulse next = next_output_tick(midipulse(current));
+    if (! is_null_midipulse(next))
+    {
+        double d = double(next) - current;
+        if (d < delta)
+            delta = d;
+    }
+    if (looping())
+    {
+        double d = double(get_right_tick()) - current;
+        if (d > 0.0 && d < delta)
+            delta = d;
+    }
+
+    midipulse change = next_tempo_change(midipulse(current));
+    if (! is_null_midipulse(change))
+    {
+        double d = double(change) - current;
+        if (d > 0.0 && d < delta)
+            delta = d;
+    }
+    long wait = long(std::ceil(delta * pus));
+    long maxwait = m_midi_control_in.pad_map().active() ?
+        c_pad_max_wait_us : c_deadline_max_wait_us ;
+
+    if (wait > maxwait)
+        wait = maxwait;
+    else if (wait < 0)
+        wait = 0;
+
+    return basetime + wait;
+}
+
+/**
+ *  Trying to prevent seqfaults when stopping playback and starting the next
+ *  song, as in play-lists.
+ */
+
+void
+performer::is_pattern_playing (bool flag)
+{
+    m_is_pattern_playing = flag;
+}
+
+/**
+ *  This function is called by input_thread_func().  It handles certain MIDI
+ *  input events.  Many of them are now handled by functions for easier reading
+ *  and trouble-shooting (of MIDI clock).
+ *
+ *  For events less than or equal to SysEx, we call midi_control_event() to
+ *  handle the MIDI controls that Sequencer64 supports.  (These are
+ *  configurable in the "rc" configuration file.) We test for MIDI control
+ *  events even if "dumping".  Otherwise, we cannot handle any more control
+ *  events once recording is turned on.  Warning:  This can slow down
+ *  recording.
+ *
+ *  "Dumping" means that we are dumping MIDI input events into a sequence.
+ *  It means "recording".
+ *
+ *  We currently ignore these events on input.  MIGHT NOT BE VALID.  STILL
+ *  INVESTIGATING.  EVENT_MIDI_ACTIVE_SENSE and EVENT_MIDI_RESET are filtered
+ *  in midi_jack.  Send out the current event, if "dumping".
+ *
+ *  ev.get_status() ==
+ *
+ *      EVENT_MIDI_ACTIVE_SENSE  handled elsewhere
+ *      EVENT_MIDI_RESET handled elsewhere
+ *      EVENT_MIDI_QUARTER_FRAME
+ *      EVENT_MIDI_SONG_SELECT
  *      EVENT_MIDI_SONG_F4
  *      EVENT_MIDI_SONG_F5
  *      EVENT_MIDI_TUNE_SELECT
@@ -4905,18 +6179,255 @@ performer::is_pattern_playing (bool flag)
  *      EVENT_MIDI_SONG_FD
  */
 
-void
-performer::input_func ()
-{
-    if (set_timer_services(true))       /* wrapper for a Windows-only func. */
+void
+performer::input_func ()
+{
+    if (set_timer_services(true))       /* wrapper for a Windows-only func. */
+    {
+        if (rc().rt_safe())
+        {
+            prefault_stack();
+            rt_thread(true);            /* count allocations here           */
+        }
+        while (! done())
+        {
+            if (! poll_cycle())
+                break;
+        }
+        set_timer_services(false);
+    }
+}
+
+/**
+ *  Sends the clicks of a latency measurement, and, when it is over, makes
+ *  the measured round trip the latency of the input buss, and turns the
+ *  probe off in the settings, so that it is not run again at the next
+ *  startup.  Called by the input thread, which also sees the clicks come
+ *  back; see poll_cycle().
+ *
+ *  A latency test (see rcsettings::latency_test()) instead reports the
+ *  round trips, along with the MIDI engine and the output scheduler they
+ *  were measured with, leaves the input latency as is, and exits.
+ */
+
+void
+performer::probe_latency ()
+{
+    long now = microtime();
+    if (m_latency_probe.send_due(now))
+    {
+        bussbyte bus = m_latency_probe.out_buss();
+        event on = latencyprobe::click(true);
+        event off = latencyprobe::click(false);
+        m_master_bus->play(bus, &on, on.channel());
+        m_master_bus->play(bus, &off, off.channel());
+        m_master_bus->flush();
+        m_latency_probe.sent(now);
+    }
+    else
+    {
+        int latencyus;
+        if (m_latency_probe.finished(latencyus))
+        {
+            int inbus = int(m_latency_probe.in_buss());
+            bool test = rc().latency_test();
+            std::ostringstream os;
+            if (test)
+            {
+                std::string engine = rc().last_midi_api();
+                if (engine.empty())
+                    engine = "default";
+
+                os
+                    << "Latency test, buss " << int(m_latency_probe.out_buss())
+                    << " to " << inbus << ", engine " << engine
+                    << ", scheduler " << rc().output_scheduler_string()
+                    << (rc().priority() ? ", high priority" : "") << "\n"
+                    << m_latency_probe.report()
+                    ;
+                rc().latency_test_clicks(0);
+            }
+            else
+            {
+                os << "Input buss " << inbus << " latency ";
+                if (latencyus >= 0)
+                {
+                    rc().input_latency_us(inbus, latencyus);
+                    publish_input_latency(inbus, latencyus);
+                    os << double(latencyus) / 1000.0 << " ms";
+                }
+                else
+                    os << "not measured; no clicks came back";
+
+                rc().auto_rc_save(true);
+            }
+            rc().latency_probe(-1, -1);
+            info_message(os.str());
+            if (test)
+                signal_quit();                      /* the test is done     */
+        }
+    }
+}
+
+/**
+ *  Starts or stops playback when a Link peer starts or stops the session.
+ *  Our own starts and stops come back here as well, but then the state
+ *  already matches, and nothing is done.  Called by the input thread; see
+ *  poll_cycle().
+ */
+
+void
+performer::link_follow ()
+{
+    bool playing = false;
+    if (m_link_sync.session_change(playing))
+    {
+        if (playing && ! is_running())
+            start_playing();
+        else if (! playing && is_running())
+            stop_playing();
+    }
+}
+
+/**
+ *  Acts on one incoming MIDI message, as the input thread does for each
+ *  message it gets.  Also called by the replay harness (see replaybench),
+ *  with messages read from a session log.  The inputs that the message
+ *  causes, such as a start from a MIDI control, are not logged again.
+ *
+ * \param ev
+ *      The message.  Its timestamp is set if it is recorded.
+ *
+ * \return
+ *      Returns false if the input cycle is to end.
+ */
+
+bool
+performer::dispatch_midi_input (event & ev)
+{
+    bool result = true;
+    sessionlog::scope nesting;
+#if defined USE_EXPERIMENTAL_CODE
+
+    /*
+     * EXPERIMENTAL: start playing on first event. This causes
+     * a barrage of notes!
+     */
+
+    if (! is_pattern_playing())                     /* ! is_running()       */
+        inner_start();                              /* start_playing()      */
+#endif
+    if
+    (
+        m_latency_probe.active() &&
+        m_latency_probe.take_reply(ev, ev.arrival_us() > 0 ?
+            ev.arrival_us() : microtime())
+    )
     {
-        while (! done())
+        // A returning click, not to be recorded or acted on
+    }
+    else if (pad_event(ev))
+    {
+        // A drum-pad note, launched or swallowed
+    }
+    else if (ev.below_sysex())                              /* below 0xF0   */
+    {
+        if (m_master_bus->is_dumping())                     /* see banner   */
         {
-            if (! poll_cycle())
-                break;
+            if (midi_control_event(ev, true))               /* quick check  */
+            {
+                // No code at this time
+            }
+            else
+            {
+                ev.set_timestamp(input_tick(ev));
+                if (record_by_buss())
+                {
+                    sequence * sp = sequence_inbus_lookup(ev);
+
+                    /*
+                     * mastermidibase::m_seq is not ever set here.
+                     *
+                     * if (is_nullptr(sp))
+                     *    sp = m_master_bus->get_sequence();
+                     */
+
+                    if (not_nullptr(sp))
+                        (void) sp->stream_event(ev);
+#if defined SEQ66_PLATFORM_DEBUG
+                    else
+                        warn_message("no buss-recording pattern");
+#endif
+                }
+                else if (record_by_channel())
+                {
+#if defined SEQ66_PLATFORM_DEBUG
+                    if (! m_master_bus->dump_midi_input(ev))
+                        warn_message("no matching channel");
+#else
+                    (void) m_master_bus->dump_midi_input(ev);
+#endif
+                }
+                else
+                {
+                    sequence * sp = m_master_bus->get_sequence();
+                    if (not_nullptr(sp))
+                        (void) sp->stream_event(ev);
+#if defined SEQ66_PLATFORM_DEBUG
+                    else
+                        error_message("no active pattern");
+#endif
+                }
+            }
         }
-        set_timer_services(false);
+        else
+            (void) midi_control_event(ev);
+    }
+    else if (ev.is_midi_start())
+    {
+        midi_start();
+    }
+    else if (ev.is_midi_continue())
+    {
+        midi_continue();
+    }
+    else if (ev.is_midi_stop())
+    {
+        midi_stop();
+    }
+    else if (ev.is_midi_clock())
+    {
+        midi_clock();
+    }
+    else if (ev.is_midi_song_pos())
+    {
+        midi_song_pos(ev);
+    }
+    else if (ev.is_tempo())                         /* added for issue #76  */
+    {
+        /*
+         * Should we do this only if JACK transport is not
+         * enabled?
+         */
+
+        if (is_jack_master() || ! is_jack_running())
+            (void) set_beats_per_minute(ev.tempo());
+    }
+    else if (ev.is_sysex())
+    {
+        midi_sysex(ev);
+    }
+#if defined USE_ACTIVE_SENSE_AND_RESET
+    else if (ev.is_sense_reset())
+    {
+        result = false;                             /* see note in banner   */
+    }
+#endif
+    else
+    {
+        /* ignore the event */
     }
+    return result;
 }
 
 /**
@@ -4927,8 +6438,23 @@ bool
 performer::poll_cycle ()
 {
     bool result = ! done();
+    if (result)
+    {
+        (void) dispatch_remote_controls();
+        (void) m_master_bus->pump_sysex();      /* paced large SysEx out    */
+        if (m_latency_probe.active())
+            probe_latency();
+
+        if (m_link_sync.enabled())
+            link_follow();
+
+        if (m_mirror_following)
+            mirror_follow();
+    }
+
     if (result && m_master_bus->poll_for_midi() > 0)
     {
+        trace_scope ts("poll cycle");           /* not the wait for input   */
         do
         {
             if (done())
@@ -4940,112 +6466,19 @@ performer::poll_cycle ()
             event ev;
             if (m_master_bus->get_midi_event(&ev))
             {
-#if defined USE_EXPERIMENTAL_CODE
+                if (m_input_capture)
+                    m_input_capture->capture(ev);
 
-                /*
-                 * EXPERIMENTAL: start playing on first event. This causes
-                 * a barrage of notes!
-                 */
+                if (m_input_monitor.enabled())
+                    m_input_monitor.tap(ev);
 
-                if (! is_pattern_playing())         /* ! is_running()       */
-                    inner_start();                  /* start_playing()      */
-#endif
-                if (ev.below_sysex())                       /* below 0xF0   */
-                {
-                    if (m_master_bus->is_dumping())         /* see banner   */
-                    {
-                        if (midi_control_event(ev, true))   /* quick check  */
-                        {
-                            // No code at this time
-                        }
-                        else
-                        {
-                            ev.set_timestamp(get_tick());
-                            if (record_by_buss())
-                            {
-                                sequence * sp = sequence_inbus_lookup(ev);
-
-                                /*
-                                 * mastermidibase::m_seq is not ever set here.
-                                 *
-                                 * if (is_nullptr(sp))
-                                 *    sp = m_master_bus->get_sequence();
-                                 */
-
-                                if (not_nullptr(sp))
-                                    (void) sp->stream_event(ev);
-#if defined SEQ66_PLATFORM_DEBUG
-                                else
-                                    warn_message("no buss-recording pattern");
-#endif
-                            }
-                            else if (record_by_channel())
-                            {
-#if defined SEQ66_PLATFORM_DEBUG
-                                if (! m_master_bus->dump_midi_input(ev))
-                                    warn_message("no matching channel");
-#else
-                                (void) m_master_bus->dump_midi_input(ev);
-#endif
-                            }
-                            else
-                            {
-                                sequence * sp = m_master_bus->get_sequence();
-                                if (not_nullptr(sp))
-                                    (void) sp->stream_event(ev);
-#if defined SEQ66_PLATFORM_DEBUG
-                                else
-                                    error_message("no active pattern");
-#endif
-                            }
-                        }
-                    }
-                    else
-                        (void) midi_control_event(ev);
-                }
-                else if (ev.is_midi_start())
-                {
-                    midi_start();
-                }
-                else if (ev.is_midi_continue())
-                {
-                    midi_continue();
-                }
-                else if (ev.is_midi_stop())
-                {
-                    midi_stop();
-                }
-                else if (ev.is_midi_clock())
-                {
-                    midi_clock();
-                }
-                else if (ev.is_midi_song_pos())
-                {
-                    midi_song_pos(ev);
-                }
-                else if (ev.is_tempo())             /* added for issue #76  */
-                {
-                    /*
-                     * Should we do this only if JACK transport is not
-                     * enabled?
-                     */
+                if (m_session_log.enabled())
+                    m_session_log.log_midi(get_tick(), ev);
 
-                    if (is_jack_master() || ! is_jack_running())
-                        (void) set_beats_per_minute(ev.tempo());
-                }
-                else if (ev.is_sysex())
-                {
-                    midi_sysex(ev);
-                }
-#if defined USE_ACTIVE_SENSE_AND_RESET
-                else if (ev.is_sense_reset())
-                {
-                    return false;                   /* see note in banner   */
-                }
-#endif
-                else
+                if (! dispatch_midi_input(ev))
                 {
-                    /* ignore the event */
+                    result = false;
+                    break;                          /* see note in banner   */
                 }
             }
         } while (m_master_bus->is_more_input());
@@ -5121,6 +6554,7 @@ performer::midi_start ()
     start_playing();
     m_midiclockrunning = m_usemidiclock = true;
     m_midiclocktick = m_midiclockpos = 0;
+    m_clock_follower.reset(m_midiclockincrement);
     if (rc().verbose())
         infoprint("MIDI Start");
 }
@@ -5147,6 +6581,7 @@ performer::midi_continue ()
     m_midiclockpos = get_tick();
     m_dont_reset_ticks = true;
     m_midiclockrunning = m_usemidiclock = true;
+    m_clock_follower.reset(m_midiclockincrement);
     start_playing();
     if (rc().verbose())
         infoprint("MIDI Continue");
@@ -5203,14 +6638,20 @@ performer::midi_clock ()
     {
         infoprint("MIDI Clock");
         if (m_midiclockrunning)
+        {
             m_midiclocktick += m_midiclockincrement;
+            m_clock_follower.pulse(microtime());
+        }
         else
             infoprint("Clock not running");
     }
     else
 #endif
     if (m_midiclockrunning)
+    {
         m_midiclocktick += m_midiclockincrement;
+        m_clock_follower.pulse(microtime());
+    }
 }
 
 /**
@@ -5460,6 +6901,10 @@ performer::stop_playing (bool rewind)
 void
 performer::auto_play ()
 {
+    if (m_session_log.enabled())
+        m_session_log.log_transport(get_tick(), sessionlog::kind::play);
+
+    sessionlog::scope nesting;
     bool isplaying = false;
     bool onekey = false;                /* keys().start() == keys().stop(); */
     if (onekey)
@@ -5497,6 +6942,10 @@ performer::auto_play ()
 void
 performer::auto_pause ()
 {
+    if (m_session_log.enabled())
+        m_session_log.log_transport(get_tick(), sessionlog::kind::pause);
+
+    sessionlog::scope nesting;
     bool isplaying = false;
     if (is_running())
     {
@@ -5531,6 +6980,10 @@ performer::auto_pause ()
 void
 performer::auto_stop (bool rewind)
 {
+    if (m_session_log.enabled())
+        m_session_log.log_transport(get_tick(), sessionlog::kind::stop);
+
+    sessionlog::scope nesting;
     if (is_pattern_playing() || is_running())       /* normal & JACK, hmmmm */
     {
         m_play_list->disengage_auto_play();
@@ -5605,6 +7058,76 @@ performer::auto_play_stop (midipulse tick)
     return result;
 }
 
+/**
+ *  In the gapless play-list mode, switches to the next song once the tick
+ *  reaches the first bar line at or after the end of the current song,
+ *  without stopping.  This is done in the output thread, as the switch done
+ *  by auto_play_stop() is, and the file is normally preloaded already (see
+ *  playlist::prefetch_neighbors()).
+ *
+ *  The notes of the old song are turned off and the song is cleared, the
+ *  next one is read, and playback goes on from its start, carrying over the
+ *  ticks past the bar line.  The clock tick does not wrap, so no Song
+ *  Position, Stop, or Start is sent; the MIDI clock simply goes on at the
+ *  tempo of the new song, which output_func() picks up through
+ *  m_resolution_change.  JACK transport needs a reposition, so the normal
+ *  stop-and-start is used with it.
+ *
+ * \param tick
+ *      The tick about to be played.
+ *
+ * \return
+ *      Returns true if the handover was made, or tried.  If the next song
+ *      could not be opened, playback is stopped.
+ */
+
+bool
+performer::gapless_handover (midipulse tick)
+{
+    bool result = m_max_extent > 0 && playlist_active() &&
+        m_play_list->gapless_engaged() && ! is_jack_running();
+
+    if (result)
+    {
+        midipulse bar = measures_to_ticks
+        (
+            get_beats_per_bar(), ppqn(), get_beat_width()
+        );
+        midipulse handover = m_max_extent;
+        if (bar > 0)
+            handover = ((m_max_extent + bar - 1) / bar) * bar;
+
+        result = tick >= handover && clear_song();  /* turns off the notes  */
+        if (result)
+        {
+            midipulse leftover = tick - handover;
+            if (m_play_list->open_next_song())
+            {
+                midibpm startbpm = tempo_at(0);
+                if (startbpm > 0.0)
+                    (void) set_beats_per_minute(startbpm);
+
+                m_resolution_change = true;
+                if (m_play_list->auto_arm())
+                    set_song_mute(mutegroups::action::off);
+
+                if (song_mode())
+                    off_sequences();
+
+                if (signalled_changes())
+                    notify_song_action(false);
+
+                set_last_ticks(0);
+                pad().js_current_tick = double(leftover);
+                set_tick(leftover);
+            }
+            else
+                stop_playing(true);
+        }
+    }
+    return result;
+}
+
 /**
  *  Starts the playing of all the patterns/sequences.  This function just runs
  *  down the list of sequences and has them dump their events.  It skips
@@ -5612,7 +7135,9 @@ performer::auto_play_stop (midipulse tick)
  *
  *  Note how often the "sp" (sequence) pointer was used.  It was worth
  *  offloading all these calls to a new sequence function.  Hence the new
- *  sequence::play_queue() function.
+ *  sequence::play_queue() function.  In Live mode, it is now split in two,
+ *  so that only the patterns with a queued or one-shot boundary in the
+ *  frame are checked for it (see play_boundaries()).
  *
  *  This function is called twice in a row with the same tick value, causing
  *  notes to be played twice. This happens because JACK "ticks" are 10 times
@@ -5631,7 +7156,11 @@ performer::play (midipulse tick)
 {
     if (tick != get_tick() || tick == 0)                /* avoid replays    */
     {
-        if (auto_play_stop(tick))
+        if (gapless_handover(tick))
+        {
+            // The next song has taken over, see the function
+        }
+        else if (auto_play_stop(tick))
         {
             (void) open_next_song();
             auto_play_start();
@@ -5640,14 +7169,173 @@ performer::play (midipulse tick)
         {
             bool songmode = song_mode();
             set_tick(tick);
-            for (auto seqi : play_set().seq_container())
+            m_frame_clock.set(microtime(), double(tick));   /* for input    */
+            (void) apply_bulk_ops();                    /* frame boundary   */
+            m_frame_batch.begin();                      /* batch by buss    */
+            if (m_play_pool && ! songmode)
             {
-                if (seqi)
-                    seqi->play_queue(tick, songmode, resume_note_ons());
-                else
-                    append_error_message("play on null sequence");
+                play_parallel(tick);
+            }
+            else if (songmode)
+            {
+                play_song(tick);
+            }
+            else
+            {
+                bool resume = resume_note_ons();
+                play_boundaries(tick, resume);
+                for (auto seqi : play_set().seq_container())
+                {
+                    if (seqi)
+                        seqi->play_frame(tick, false, resume);
+                    else
+                        append_error_message("play on null sequence");
+                }
             }
+            play_pads(tick);                            /* after the pool   */
+            m_frame_batch.end(*m_master_bus, m_output_stats);   /* by buss */
             m_master_bus->flush();                      /* flush MIDI buss  */
+            (void) apply_scheduled_tempo();             /* no locks held    */
+        }
+    }
+}
+
+/**
+ *  The Song-mode version of the loop in play().  The song timeline is
+ *  compiled again if any trigger has changed, then walked to the tick, and
+ *  the patterns it shows to have nothing to do in the frame are skipped.
+ *  The rest play as they always did, triggers and all.
+ *
+ * \param tick
+ *      Provides the tick at which to start playing.
+ */
+
+void
+performer::play_song (midipulse tick)
+{
+    const auto & seqs = play_set().seq_container();
+    unsigned generation = m_trigger_generation.load(std::memory_order_acquire);
+    if (generation != m_song_timeline.generation())
+        m_song_timeline.compile(seqs, generation);
+
+    m_song_timeline.advance(tick);
+    for (auto seqi : seqs)
+    {
+        if (seqi)
+        {
+            if (m_song_timeline.skippable(*seqi))
+                seqi->song_skip(tick);
+            else
+                seqi->play_queue(tick, true, resume_note_ons());
+        }
+        else
+            append_error_message("play on null sequence");
+    }
+}
+
+/**
+ *  The Live-mode version of the loop in play(), used when output workers
+ *  are configured.  Patterns that can be played in any thread (see
+ *  sequence::parallel_playable()) are played by the playpool, and the rest
+ *  are played here first, directly to the buss, as play() would.  Then the
+ *  events captured by the pool, already in timestamp order, are sent to
+ *  the buss.  Song mode is left to play(), because the triggers of a
+ *  pattern can reach the performer at any point in the frame.
+ *
+ * \param tick
+ *      Provides the tick at which to start playing.
+ */
+
+void
+performer::play_parallel (midipulse tick)
+{
+    bool resume = resume_note_ons();            /* the jobs re-read it      */
+    play_boundaries(tick, resume);
+    m_play_jobs.clear();
+    for (auto seqi : play_set().seq_container())
+    {
+        if (seqi)
+        {
+            if (seqi->parallel_playable())
+                m_play_jobs.push_back(seqi.get());
+            else
+                seqi->play_frame(tick, false, resume);
+        }
+        else
+            append_error_message("play on null sequence");
+    }
+    if (! m_play_jobs.empty())
+    {
+        playpool::messages & msgs = m_play_pool->run
+        (
+            int(m_play_jobs.size()), [this] (int j)
+            {
+                sequence * s = m_play_jobs[std::size_t(j)];
+                s->play_frame(get_tick(), false, resume_note_ons());
+            }
+        );
+        for (auto & m : msgs)
+        {
+            bool batched = framebatch::capture
+            (
+                m.m_bus, m.m_event, m.m_channel, m.m_tag
+            );
+            if (! batched)
+                m_master_bus->play(m.m_bus, &m.m_event, m.m_channel);
+        }
+    }
+}
+
+/**
+ *  Handles the queued and one-shot boundaries that fall in the frame, for
+ *  the Live-mode loops.  The boundary wheel gives the patterns that are
+ *  due; each is acted on only if it is (still) in the play-set, which also
+ *  makes sure the pointer is good.  A pattern that is not in the play-set
+ *  is posted again when the play-set takes it in, by
+ *  schedule_boundaries().
+ *
+ * \param tick
+ *      The tick of the frame.
+ *
+ * \param resume
+ *      The resume-note-ons setting.
+ */
+
+void
+performer::play_boundaries (midipulse tick, bool resume)
+{
+    m_boundary_wheel.advance(tick, ppqn(), m_due_boundaries);
+    if (! m_due_boundaries.empty())
+    {
+        auto b = m_due_boundaries.begin();
+        auto e = m_due_boundaries.end();
+        for (auto seqi : play_set().seq_container())
+        {
+            if (seqi && std::find(b, e, seqi.get()) != e)
+                seqi->play_boundaries(tick, false, resume);
+        }
+        m_due_boundaries.clear();
+    }
+}
+
+/**
+ *  Posts the boundaries of the queued and one-shot patterns of the
+ *  play-set, after it is filled, since a pattern queued while its set was
+ *  not playing was dropped from the wheel.  A repeat is harmless.
+ */
+
+void
+performer::schedule_boundaries ()
+{
+    for (auto seqi : play_set().seq_container())
+    {
+        if (seqi)
+        {
+            if (seqi->get_queued())
+                schedule_boundary(seqi.get(), seqi->get_queued_tick());
+
+            if (seqi->one_shot())
+                schedule_boundary(seqi.get(), seqi->one_shot_tick());
         }
     }
 }
@@ -5658,6 +7346,7 @@ performer::play_all_sets (midipulse tick)
     if (tick > get_tick() || tick == 0)                 /* avoid replays    */
     {
         set_tick(tick);
+        m_master_bus->frame_tick(double(tick));         /* for lookahead    */
         sequence::playback songmode = song_start_mode();
         set_mapper().play_all_sets(tick, songmode, resume_note_ons());
         m_master_bus->flush();                          /* flush MIDI buss  */
@@ -5808,9 +7497,9 @@ performer::convert_to_smf_0 (bool remove_old)
 void
 performer::all_notes_off ()
 {
+    begin_output_batch();                           /* no flush per seq */
     set_mapper().all_notes_off();
-    if (m_master_bus)
-        m_master_bus->flush();                      /* flush MIDI buss  */
+    end_output_batch();                             /* flush MIDI buss  */
 }
 
 /**
@@ -6876,17 +8565,36 @@ performer::send_mutes_event (int group, bool on)
 }
 
 void
-performer::send_mutes_events (int groupon, int groupoff)
+performer::send_mutes_events (int groupon, int groupoff, bool flush)
 {
     bool wasactive = mutes().group_valid(groupoff);
     if (wasactive && (groupoff != groupon))
     {
         midi_control_out().send_mutes_event
         (
-            groupoff, midicontrolout::action_off
+            groupoff, midicontrolout::action_off, flush
         );
     }
-    midi_control_out().send_mutes_event(groupon, midicontrolout::action_on);
+    midi_control_out().send_mutes_event
+    (
+        groupon, midicontrolout::action_on, flush
+    );
+}
+
+/**
+ *  Closes a batch of output begun by begin_output_batch().  The closing of
+ *  the outermost batch flushes the master bus, sending the note-offs and
+ *  the control-out events queued during the batch together.
+ */
+
+void
+performer::end_output_batch ()
+{
+    if (m_output_batch.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        if (not_nullptr(master_bus()))
+            master_bus()->flush();
+    }
 }
 
 void
@@ -6956,8 +8664,10 @@ performer::group_learn (bool learning)
     (void) set_ctrl_status(a, automation::ctrlstatus::learn);
     mutes().group_learn(learning);
     midi_control_out().send_learning(learning);
-    for (auto notify : m_notify)
-        (void) notify->on_group_learn(learning);
+
+    notifyqueue::notice n = make_notice(notifyqueue::kind::group_learn);
+    n.n_value = learning ? 1 : 0;
+    dispatch_notice(n);
 }
 
 /**
@@ -6978,9 +8688,13 @@ performer::group_learn (bool learning)
 void
 performer::group_learn_complete (const keystroke & k, bool good)
 {
+    notifyqueue::notice n =
+        make_notice(notifyqueue::kind::group_learn_complete);
+
+    n.n_value = good ? 1 : 0;
+    n.n_key = k;
     group_learn(false);
-    for (auto notify : m_notify)
-        (void) notify->on_group_learn_complete(k, good);
+    dispatch_notice(n);
 
     notify_mutes_change(0, change::yes);
 }
@@ -7018,6 +8732,10 @@ performer::group_learn_complete (const keystroke & k, bool good)
 bool
 performer::sequence_playing_toggle (seq::number seqno)
 {
+    if (m_session_log.enabled())
+        m_session_log.log_toggle(get_tick(), int(seqno));
+
+    sessionlog::scope nesting;
     seq::pointer s = get_sequence(seqno);
     bool result = bool(s);
     if (result)
@@ -7252,7 +8970,7 @@ performer::toggle_other_names (seq::number seqno, bool isshiftkey)
     if (result)
     {
         if (isshiftkey)
-            set_mapper().toggle_song_mute();
+            toggle_all_song_mutes();
         else
         {
             /*
@@ -7328,7 +9046,8 @@ performer::clear_seq_edits ()
  *  Next, we look up the keycontrol based on the ordinal value.  If this
  *  keycontrol is usable (it is not a default-constructed keycontrol), then we
  *  can use its slot value to look up the midioperation associated with this
- *  slot.
+ *  slot.  Both lookups are done ahead of time by bind_keys(), so here they
+ *  are one index into m_key_bindings.
  *
  *  Also part of keystroke is whether the key was pressed or released.  A
  *  press sets inverse = false, while a release sets inverse = true.  For some
@@ -7394,6 +9113,10 @@ performer::clear_seq_edits ()
 bool
 performer::midi_control_keystroke (const keystroke & k)
 {
+    if (m_session_log.enabled())
+        m_session_log.log_key(get_tick(), k);
+
+    sessionlog::scope nesting;
     bool result = true;
     keystroke kkey = k;
     if (is_group_learn())
@@ -7408,14 +9131,15 @@ performer::midi_control_keystroke (const keystroke & k)
     }
     if (result)
     {
-        const keycontrol & kc = m_key_controls.control(kkey.key());
-        result = kc.is_usable();
+        const keybinding & kb = m_key_bindings[kkey.key()];
+        result = not_nullptr(kb.kb_control);
         if (result)
         {
+            const keycontrol & kc = *kb.kb_control;
             automation::slot s = kc.slot_number();
-            const midioperation & mop = m_operations.operation(s);
-            if (mop.is_usable())
+            if (not_nullptr(kb.kb_operation))
             {
+                const midioperation & mop = *kb.kb_operation;
                 /*
                  * See Notes 1 (inverse) and 2 (group-learn) in the banner.
                  */
@@ -7449,6 +9173,9 @@ performer::midi_control_keystroke (const keystroke & k)
                 if (result)
                 {
                     bool ok = mop.call(a, d0, d1, index, invert);
+                    if (ok && m_mirror_primary)
+                        mirror_control(s, a, d0, d1, index, invert);
+
                     if (! ok)
                     {
                         if (rc().investigate())
@@ -7501,6 +9228,9 @@ performer::midi_control_keystroke (const keystroke & k)
  *      This parameter, if true, restricts the handled controls to start,
  *      stop, and record.
  *
+ *  Statuses that no control uses (normally the notes and aftertouch of a
+ *  recording) are rejected by a bitmap test before any key is made.
+ *
  * \return
  *      Returns true if the event was valid and usable, and the call to the
  *      automation function returned true. Also returns true if the event
@@ -7516,7 +9246,7 @@ performer::midi_control_event (const event & ev, bool recording)
     if (result)
         result = ev.input_bus() == m_midi_control_in.true_buss();
 
-    if (result)
+    if (result && m_midi_control_in.status_bound(ev.get_status()))
     {
         midicontrol::key k(ev);
         const midicontrol & incoming = m_midi_control_in.control(k);
@@ -7542,6 +9272,8 @@ performer::midi_control_event (const event & ev, bool recording)
                     int d1 = incoming.d1();
                     int index = incoming.control_code(); /* in lieu of d1() */
                     good = mop.call(a, d0, d1, index, invert);
+                    if (good && m_mirror_primary)
+                        mirror_control(s, a, d0, d1, index, invert);
                 }
                 else
                     good = false;
@@ -7559,6 +9291,436 @@ performer::midi_control_event (const event & ev, bool recording)
     return result;
 }
 
+/**
+ *  Checks for a drum-pad note, before the MIDI controls are checked.  A
+ *  Note On or Note Off on the pad channel of the control buss, for a note
+ *  mapped in the pad map, is a pad note, and goes no further.  While
+ *  playing, a Note On of at least the minimum velocity posts its pattern,
+ *  in the playing set, to the voice pool, which starts it at the next
+ *  frame.  The lookup is a single array access.
+ *
+ * \param ev
+ *      The incoming event.
+ *
+ * \return
+ *      Returns true if the event is a pad note.
+ */
+
+bool
+performer::pad_event (const event & ev)
+{
+    const padmap & pm = m_midi_control_in.pad_map();
+    bool result = pm.active() && ev.is_note();
+    if (result)
+        result = event::mask_channel(ev.get_status()) == pm.channel();
+
+    if (result)
+        result = ev.input_bus() == m_midi_control_in.true_buss();
+
+    if (result)
+    {
+        int slot = pm.slot(ev.d0());
+        result = slot >= 0;
+        if (result && ev.is_note_on() && ev.d1() >= pm.min_velocity())
+        {
+            if (is_running())
+            {
+                seq::pointer s = get_sequence(playscreen_offset() + slot);
+                if (s)
+                    (void) m_pad_launcher.post(s, ev.d1());
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ *  Plays a frame of the drum-pad voices, after the patterns, and so after
+ *  any playpool run, so that a voice and the pattern's own playback never
+ *  touch the pattern's sounding notes at the same time.
+ *
+ * \param tick
+ *      The last tick of the frame.
+ */
+
+void
+performer::play_pads (midipulse tick)
+{
+    const padmap & pm = m_midi_control_in.pad_map();
+    if (pm.active() || m_pad_launcher.pending())
+        m_pad_launcher.play(tick, pm.quantum(ppqn()), pm.velocity_scale());
+}
+
+/**
+ *  Queues a control from a remote surface, such as the OSC control server,
+ *  for the input thread, which calls dispatch_remote_controls().  Only one
+ *  thread may post.  Never waits and never locks.
+ *
+ * \param s
+ *      automation::slot::loop for a pattern, automation::slot::mute_group
+ *      for a mute-group, or the automation slot to call.
+ *
+ * \param a
+ *      The action: toggle, on, or off.
+ *
+ * \param index
+ *      The pattern (relative to the playing set, as for MIDI control) or the
+ *      mute-group number.  Ignored for an automation slot.
+ *
+ * \param d1
+ *      The value of the control, passed as the event's d1 would be.
+ *
+ * \param d0
+ *      The d0 of the MIDI control, or -1 (the default) for a key-like
+ *      control.  Set by a mirroring replica for a control it was sent.
+ *
+ * \param inverse
+ *      True for a key release or an inverse MIDI control.  False by default.
+ *
+ * \return
+ *      Returns false if the parameters are out of range or the queue is full.
+ */
+
+bool
+performer::post_remote_control
+(
+    automation::slot s, automation::action a, int index, int d1,
+    int d0, bool inverse
+)
+{
+    bool result = automation::actionable(a) || a == automation::action::off;
+    if (result)
+    {
+        if (s == automation::slot::loop || s == automation::slot::mute_group)
+            result = index >= 0;
+        else if (opcontrol::set_slot(int(s)) != automation::slot::none)
+            index = int(s);
+        else
+            result = false;
+    }
+    if (result)
+    {
+        remotecontrol c;
+        c.rc_slot = s;
+        c.rc_action = a;
+        c.rc_index = index;
+        c.rc_d1 = d1;
+        c.rc_d0 = d0;
+        c.rc_inverse = inverse;
+
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        result = m_remote_controls.push_back(c);
+    }
+    return result;
+}
+
+/**
+ *  Calls the operations queued by post_remote_control(), in the input
+ *  thread, just as midi_control_event() calls the operations of MIDI
+ *  controls.  A remote control from OSC acts like a key press (d0 = -1, not
+ *  inverse), so that it is not taken for a MIDI event; one mirrored from a
+ *  primary acts as the original control did.
+ *
+ * \return
+ *      Returns the number of controls dispatched.
+ */
+
+int
+performer::dispatch_remote_controls ()
+{
+    int result = 0;
+    while (m_remote_controls.read_space() > 0)
+    {
+        remotecontrol c = m_remote_controls.front();
+        m_remote_controls.pop_front();
+
+        const midioperation & mop = m_operations.operation(c.rc_slot);
+        if (mop.is_usable())
+        {
+            bool ok = mop.call
+            (
+                c.rc_action, c.rc_d0, c.rc_d1, c.rc_index, c.rc_inverse
+            );
+            if (ok && m_mirror_primary)
+            {
+                mirror_control
+                (
+                    c.rc_slot, c.rc_action, c.rc_d0, c.rc_d1,
+                    c.rc_index, c.rc_inverse
+                );
+            }
+            ++result;
+        }
+    }
+    return result;
+}
+
+/*
+ * Mirroring of a primary to a hot-spare replica.  See the oscmirror module
+ * for the protocol.
+ */
+
+/**
+ *  How long a replica waits, after the last message from the primary,
+ *  before it takes over the output.  The primary sends its state at least
+ *  every 50 ms, so this is five of them lost in a row.
+ */
+
+static const long c_mirror_timeout_us = 250000;
+
+/**
+ *  How far, as a fraction of a beat, a replica may drift from the primary
+ *  before it jumps to the primary's position.
+ */
+
+static const int c_mirror_drift_divisor = 16;
+
+/**
+ *  The controls that act on this machine only, and are not mirrored:  the
+ *  replica must not quit, save, or open editors because the primary did.
+ *  A tap tempo is measured on the primary and arrives as its tempo.
+ */
+
+static bool
+mirrorable (automation::slot s)
+{
+    switch (s)
+    {
+    case automation::slot::quit:
+    case automation::slot::save_session:
+    case automation::slot::pattern_edit:
+    case automation::slot::event_edit:
+    case automation::slot::toggle_jack:
+    case automation::slot::menu_mode:
+    case automation::slot::visibility:
+    case automation::slot::tap_bpm:
+        return false;
+
+    default:
+        return true;
+    }
+}
+
+/**
+ *  Queues a control just done on a mirroring primary, for the mirror thread
+ *  to send to the replica.  Called by the input thread and by the
+ *  user-interface thread, hence the lock.  If the queue is full, the
+ *  control is dropped (and counted); the next state sent covers it.
+ */
+
+void
+performer::mirror_control
+(
+    automation::slot s, automation::action a,
+    int d0, int d1, int index, bool inverse
+)
+{
+    if (mirrorable(s))
+    {
+        remotecontrol c;
+        c.rc_slot = s;
+        c.rc_action = a;
+        c.rc_index = index;
+        c.rc_d1 = d1;
+        c.rc_d0 = d0;
+        c.rc_inverse = inverse;
+
+        std::lock_guard<std::mutex> lock(m_mirror_mutex);
+        (void) m_mirror_actions.push_back(c);
+    }
+}
+
+/**
+ *  Gets the next control queued for the replica.  Called only by the mirror
+ *  thread of a primary.
+ *
+ * \param [out] c
+ *      The control.
+ *
+ * \return
+ *      Returns false if there was none.
+ */
+
+bool
+performer::pop_mirror_action (remotecontrol & c)
+{
+    bool result = m_mirror_actions.read_space() > 0;
+    if (result)
+    {
+        c = m_mirror_actions.front();
+        m_mirror_actions.pop_front();
+    }
+    return result;
+}
+
+/**
+ *  Gets the state a primary sends to its replica.  Called by the mirror
+ *  thread.
+ *
+ * \param [out] ms
+ *      The state:  transport, tempo, playscreen, and the armed status of
+ *      each slot of the playscreen.
+ */
+
+void
+performer::get_mirror_state (mirrorstate & ms)
+{
+    ms.ms_running = is_running();
+    ms.ms_song_mode = song_mode();
+    ms.ms_tick = get_tick();
+    ms.ms_bpm = get_beats_per_minute();
+    ms.ms_playscreen = int(playscreen_number());
+
+    seq::number offset = playscreen_offset();
+    int count = screenset_size();
+    ms.ms_armed.assign(std::size_t(count), '0');
+    for (int i = 0; i < count; ++i)
+    {
+        const seq::pointer sp = get_sequence(offset + i);
+        if (sp && sp->armed())
+            ms.ms_armed[std::size_t(i)] = '1';
+    }
+}
+
+/**
+ *  Takes the state sent by the primary, for the input thread to apply.
+ *  Called by the liblo thread of a replica's mirror server.  Only the
+ *  latest state is kept.
+ *
+ * \param ms
+ *      The state received.
+ */
+
+void
+performer::post_mirror_state (const mirrorstate & ms)
+{
+    long now = microtime();
+    std::lock_guard<std::mutex> lock(m_mirror_mutex);
+    m_mirror_state = ms;
+    m_mirror_state.ms_received_us = now;
+    m_mirror_state_new = true;
+    m_mirror_heard_us = now;
+}
+
+/**
+ *  Applies the latest state from the primary, or, if the primary has gone
+ *  quiet, takes over the output.  Called by the input thread of a replica
+ *  that is still following; see poll_cycle().  The watchdog starts only
+ *  once the primary has been heard, so that a replica started first waits.
+ */
+
+void
+performer::mirror_follow ()
+{
+    mirrorstate ms;
+    bool fresh = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mirror_mutex);
+        if (m_mirror_state_new)
+        {
+            ms = m_mirror_state;
+            m_mirror_state_new = false;
+            fresh = true;
+        }
+    }
+    if (fresh)
+    {
+        apply_mirror_state(ms);
+    }
+    else
+    {
+        long heard = m_mirror_heard_us;
+        if (heard > 0 && microtime() - heard > c_mirror_timeout_us)
+            mirror_takeover();
+    }
+}
+
+/**
+ *  Brings this replica into line with the primary.  Only what differs is
+ *  changed.  A running replica that has drifted by more than a fraction of
+ *  a beat from where the primary is now (its tick plus the time since the
+ *  state arrived) jumps there at the next output frame; with the output on
+ *  standby, nothing is heard.
+ *
+ * \param ms
+ *      The state from the primary.
+ */
+
+void
+performer::apply_mirror_state (const mirrorstate & ms)
+{
+    if (ms.ms_song_mode != song_mode() && ! is_running())
+        song_mode(ms.ms_song_mode);
+
+    if (ms.ms_playscreen != int(playscreen_number()))
+        (void) set_playing_screenset(screenset::number(ms.ms_playscreen));
+
+    if (usr().bpm_is_valid(ms.ms_bpm))
+        (void) set_beats_per_minute(ms.ms_bpm);     /* false if the same    */
+
+    seq::number offset = playscreen_offset();
+    int count = std::min(int(ms.ms_armed.size()), screenset_size());
+    for (int i = 0; i < count; ++i)
+    {
+        seq::number s = offset + i;
+        const seq::pointer sp = get_sequence(s);
+        if (sp)
+        {
+            bool armed = ms.ms_armed[std::size_t(i)] == '1';
+            if (sp->armed() != armed)
+                set_mapper().sequence_playscreen_change(s, armed, false);
+        }
+    }
+    if (ms.ms_running)
+    {
+        int p = ppqn();
+        double pus = pulse_length_us(ms.ms_bpm, p);
+        long late = microtime() - ms.ms_received_us;
+        midipulse now = ms.ms_tick;
+        if (pus > 0.0)
+            now += midipulse(double(late) / pus);
+
+        if (is_running())
+        {
+            midipulse drift = get_tick() - now;
+            if (drift < 0)
+                drift = -drift;
+
+            if (drift > midipulse(p / c_mirror_drift_divisor))
+                m_mirror_pos = long(now);
+        }
+        else
+        {
+            set_tick(now);
+            start_playing();
+        }
+    }
+    else
+    {
+        if (is_running())
+            stop_playing();
+
+        if (get_tick() != ms.ms_tick)
+            set_tick(ms.ms_tick);
+    }
+}
+
+/**
+ *  Takes over from a primary that has gone quiet:  the output comes off
+ *  standby, and the replica stops following, for good.  Playback goes on
+ *  from where the primary left it.  If the primary comes back, it is
+ *  ignored, so that the two do not both play; the operator restarts one of
+ *  them as the new replica.
+ */
+
+void
+performer::mirror_takeover ()
+{
+    m_mirror_following = false;
+    m_master_bus->standby(false);
+    warn_message("Mirror primary silent, replica takes over the output");
+}
+
 void
 performer::signal_save ()
 {
@@ -7677,9 +9839,38 @@ performer::populate_default_ops ()
         else
             break;
     }
+    bind_keys();
     return result;
 }
 
+/**
+ *  Fills the keystroke dispatch table from the key controls and the
+ *  operations.  Only usable controls and operations are bound, which are
+ *  the checks midi_control_keystroke() would otherwise make on each key.
+ */
+
+void
+performer::bind_keys ()
+{
+    for (std::size_t k = 0; k < m_key_bindings.size(); ++k)
+    {
+        keybinding & kb = m_key_bindings[k];
+        const keycontrol & kc = m_key_controls.control(ctrlkey(k));
+        kb.kb_control = nullptr;
+        kb.kb_operation = nullptr;
+        if (kc.is_usable())
+        {
+            const midioperation & mop = m_operations.operation
+            (
+                kc.slot_number()
+            );
+            kb.kb_control = &kc;
+            if (mop.is_usable())
+                kb.kb_operation = &mop;
+        }
+    }
+}
+
 /*
  * -------------------------------------------------------------------------
  *  Mutes / Mute-groups
@@ -7820,28 +10011,49 @@ performer::clear_mute_groups ()
     return result;
 }
 
+/**
+ *  Applies a mute-group to the playing set.  Only the patterns whose armed
+ *  state differs from the group's are changed (see screenset::apply_bits()).
+ *  Their note-offs, the pattern feedback, and the mute-group feedback are
+ *  batched, and go out in one flush of the master bus once the whole group
+ *  is applied, rather than pattern by pattern.  The same holds for the
+ *  other mute-group functions below.
+ */
+
 bool
 performer::apply_mutes (mutegroup::number group)
 {
     mutegroup::number oldgroup = mutes().group_selected();
+    begin_output_batch();
+
     bool result = set_mapper().apply_mutes(group);
     if (result)
-    {
-        send_mutes_events(group, oldgroup);
+        send_mutes_events(group, oldgroup, false);
+
+    end_output_batch();
+    if (result)
         notify_mutes_change(group, change::no);       /* ca 2023-11-06 */
-    }
+
     return result;
 }
 
 bool
 performer::unapply_mutes (mutegroup::number group)
 {
+    begin_output_batch();
+
     bool result = set_mapper().unapply_mutes(group);
     if (result)
     {
-        midi_control_out().send_mutes_event(group, midicontrolout::action_off);
-        notify_mutes_change(group, change::no);       /* ca 2023-11-06 */
+        midi_control_out().send_mutes_event
+        (
+            group, midicontrolout::action_off, false
+        );
     }
+    end_output_batch();
+    if (result)
+        notify_mutes_change(group, change::no);       /* ca 2023-11-06 */
+
     return result;
 }
 
@@ -7853,7 +10065,9 @@ performer::unapply_mutes (mutegroup::number group)
 void
 performer::select_and_mute_group (mutegroup::number mg)
 {
+    begin_output_batch();
     set_mapper().select_and_mute_group(mg);
+    end_output_batch();
     notify_mutes_change(mg, change::no);       /* ca 2023-11-06 */
 }
 
@@ -7861,13 +10075,19 @@ bool
 performer::toggle_mutes (mutegroup::number group)
 {
     mutegroup::number oldgroup = mutes().group_selected();
+    mutegroup::number newgroup = oldgroup;
+    begin_output_batch();
+
     bool result = set_mapper().toggle_mutes(group);
     if (result)
     {
-        mutegroup::number newgroup = mutes().group_selected();
-        send_mutes_events(newgroup, oldgroup);
-        notify_mutes_change(newgroup, change::no);       /* ca 2023-11-06 */
+        newgroup = mutes().group_selected();
+        send_mutes_events(newgroup, oldgroup, false);
     }
+    end_output_batch();
+    if (result)
+        notify_mutes_change(newgroup, change::no);       /* ca 2023-11-06 */
+
     return result;
 }
 
@@ -7875,13 +10095,18 @@ bool
 performer::toggle_active_mutes (mutegroup::number group)
 {
     mutegroup::number oldgroup = mutes().group_selected();
+    begin_output_batch();
+
     bool result = set_mapper().toggle_active_mutes(group);
     if (result)
     {
         mutegroup::number newgroup = mutes().group_selected();
-        send_mutes_events(newgroup, oldgroup);
-        notify_mutes_change(group, change::no);          /* ca 2023-11-06 */
+        send_mutes_events(newgroup, oldgroup, false);
     }
+    end_output_batch();
+    if (result)
+        notify_mutes_change(group, change::no);          /* ca 2023-11-06 */
+
     return result;
 }
 
@@ -0,0 +1,351 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playbench.cpp
+ *
+ *  This module defines the measurement of the pattern playback engine.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Usage:
+ *
+\verbatim
+    seq66cli --bench [--synthetic n] [--frames n] [--workers n] [file ...]
+\endverbatim
+ *
+ *  Each frame advances the tick by a 64th note, and plays every armed
+ *  pattern up to that tick, as performer::play_parallel() does.  The
+ *  patterns are never unarmed, because sequence::off_playing_notes() would
+ *  need a master buss.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdlib>                      /* EXIT_SUCCESS, EXIT_FAILURE       */
+#include <iostream>                     /* std::cout                        */
+
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/midifile.hpp"            /* seq66::read_midi_file()          */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/playbench.hpp"           /* seq66::playbench class           */
+#include "play/playpool.hpp"            /* seq66::playpool                  */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The synthetic patterns must fit in the slots (seq::maximum()), the
+ *  frame count bounds the run time of each measurement, and more playpool
+ *  workers than this would only measure the thread scheduling.
+ */
+
+static const int c_bench_patterns_max = 1024;
+static const int c_bench_frames_max = 10000000;
+static const int c_bench_workers_max = 64;
+
+playbench::playbench () :
+    m_files         (),
+    m_synthetic     (64),
+    m_frames        (100000),
+    m_workers       (0)
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if "--bench" is on the command line.
+ */
+
+bool
+playbench::requested (int argc, char * argv [])
+{
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--bench")
+            return true;
+    }
+    return false;
+}
+
+void
+playbench::show_help ()
+{
+    std::cout <<
+"Playback benchmark options (no MIDI ports are opened):\n\n"
+"  --bench              Measure pattern playback of the files, or of a\n"
+"                       synthetic song if no files are given.\n"
+"  --synthetic n        Patterns in the synthetic song (default 64).\n"
+"  --frames n           Frames to play per measurement (default 100000).\n"
+"  --workers n          Playpool threads, as with 'output-workers' (0).\n"
+    ;
+}
+
+/**
+ *  Gets the benchmark options and the list of files.
+ *
+ * \return
+ *      Returns true if the options are good.
+ */
+
+bool
+playbench::parse (int argc, char * argv [])
+{
+    bool result = true;
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--bench")
+        {
+            // already handled by requested()
+        }
+        else if
+        (
+            arg == "--synthetic" || arg == "--frames" || arg == "--workers"
+        )
+        {
+            if (++argn < argc)
+            {
+                int value = std::atoi(argv[argn]);
+                if (arg == "--synthetic")
+                {
+                    m_synthetic = value;
+                    result = value > 0 && value <= c_bench_patterns_max;
+                }
+                else if (arg == "--frames")
+                {
+                    m_frames = value;
+                    result = value > 0 && value <= c_bench_frames_max;
+                }
+                else
+                {
+                    m_workers = value;
+                    result = value >= 0 && value <= c_bench_workers_max;
+                }
+            }
+            else
+                result = false;
+        }
+        else if (arg.length() > 1 && arg[0] == '-')
+            result = false;
+        else
+            m_files.push_back(arg);
+
+        if (! result)
+        {
+            errprintf("Bad bench option '%s'", arg.c_str());
+            break;
+        }
+    }
+    if (! result)
+        show_help();
+
+    return result;
+}
+
+/**
+ *  Measures each file, or the synthetic song.  Each measurement gets its
+ *  own performer, never launched, so that there is no master buss.
+ *
+ * \return
+ *      Returns EXIT_SUCCESS if every measurement could be made.
+ */
+
+int
+playbench::run ()
+{
+    int failures = 0;
+    if (m_files.empty())
+    {
+        int ppqn = choose_ppqn();
+        performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+        (void) p.get_settings(rc(), usr());
+        if (make_synthetic(p))
+            measure(p, "synthetic");
+        else
+            ++failures;
+    }
+    else
+    {
+        for (const auto & fname : m_files)
+        {
+            std::string errmsg;
+            int ppqn = choose_ppqn();
+            performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+            (void) p.get_settings(rc(), usr());
+            usr().clear_global_seq_features();
+            if (read_midi_file(p, fname, p.ppqn(), errmsg, false))
+                measure(p, fname);
+            else
+            {
+                file_error(errmsg, fname);
+                ++failures;
+            }
+        }
+    }
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS ;
+}
+
+/**
+ *  Fills the performer with one-measure patterns of 16th notes, each on
+ *  its own channel and note, so that every frame has some work to do.
+ */
+
+bool
+playbench::make_synthetic (performer & p)
+{
+    midipulse sixteenth = p.ppqn() / 4;
+    midipulse measure = p.ppqn() * 4;
+    for (int s = 0; s < m_synthetic; ++s)
+    {
+        seq::number seqno = seq::number(s);
+        if (! p.new_sequence(seqno, seqno))
+            return false;
+
+        seq::pointer sp = p.get_sequence(seqno);
+        if (! sp)
+            return false;
+
+        (void) sp->set_length(measure);
+        (void) sp->set_midi_channel(midibyte(s % 16));
+        int note = 36 + s % 48;
+        for (midipulse t = 0; t < measure; t += sixteenth)
+            (void) sp->add_painted_note(t, sixteenth / 2, note, false, 100);
+    }
+    return true;
+}
+
+/**
+ *  Arms every pattern and plays the frames, reporting the throughput.
+ *  All of the playing is done inside playpool::run(), so that the events
+ *  are captured instead of going to a buss.  One serial frame is played
+ *  first, so that each pattern publishes its snapshot and becomes
+ *  parallel-playable.
+ */
+
+void
+playbench::measure (performer & p, const std::string & name)
+{
+    std::vector<sequence *> parallel;
+    std::vector<sequence *> serial;
+    for (int s = 0; s < p.sequence_high(); ++s)
+    {
+        if (p.is_seq_active(s))
+        {
+            seq::pointer sp = p.get_sequence(s);
+            (void) sp->set_armed(true);
+            serial.push_back(sp.get());
+        }
+    }
+    if (serial.empty())
+    {
+        errprintf("%s: no patterns to play", name.c_str());
+        return;
+    }
+
+    midipulse step = p.ppqn() / 16;
+    if (step < 1)
+        step = 1;
+
+    midipulse tick = 0;
+    playpool local(0);
+    (void) local.run
+    (
+        int(serial.size()), [&serial, &tick] (int j)
+        {
+            serial[std::size_t(j)]->play_queue(tick, false, false);
+        }
+    );
+
+    std::vector<sequence *> all;
+    all.swap(serial);
+    for (auto s : all)
+    {
+        if (s->parallel_playable())
+            parallel.push_back(s);
+        else
+            serial.push_back(s);
+    }
+
+    playpool pool(m_workers);
+    unsigned long events = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < m_frames; ++f)
+    {
+        tick += step;
+        if (! serial.empty())
+        {
+            events += local.run
+            (
+                int(serial.size()), [&serial, &tick] (int j)
+                {
+                    serial[std::size_t(j)]->play_queue(tick, false, false);
+                }
+            ).size();
+        }
+        if (! parallel.empty())
+        {
+            events += pool.run
+            (
+                int(parallel.size()), [&parallel, &tick] (int j)
+                {
+                    parallel[std::size_t(j)]->play_queue(tick, false, false);
+                }
+            ).size();
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    double ns = double
+    (
+        std::chrono::duration_cast<std::chrono::nanoseconds>
+        (
+            finish - start
+        ).count()
+    );
+    double seconds = ns / 1.0e9;
+    double eps = seconds > 0.0 ? double(events) / seconds : 0.0 ;
+    std::cout
+        << name << ": "
+        << all.size() << " patterns (" << parallel.size() << " parallel), "
+        << m_workers << " workers, " << m_frames << " frames, "
+        << events << " events\n    "
+        << ns / double(m_frames) << " ns/frame, "
+        << eps << " events/s"
+        << std::endl
+        ;
+}
+
+}           // namespace seq66
+
+/*
+ * playbench.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
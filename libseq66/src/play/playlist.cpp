@@ -25,22 +25,29 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-26
- * \updates       2023-10-31
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  See the playlistfile class for information on the file format.
  */
 
+#include <algorithm>                    /* std::max()                       */
 #include <cctype>                       /* std::toupper() function          */
+#include <fstream>                      /* std::ifstream, std::ofstream     */
 #include <iostream>                     /* std::cout                        */
+#include <iterator>                     /* std::next()                      */
+#include <map>                          /* std::map<> for the verify cache  */
 #include <utility>                      /* std::make_pair()                 */
-#include <string.h>                     /* memset()                         */
+#include <vector>                       /* std::vector<>                    */
+#include <string.h>                     /* memset(), memcmp()               */
 
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
 #include "midi/wrkfile.hpp"             /* seq66::midifile & seq66::wrkfile */
+#include "os/mappedfile.hpp"            /* seq66::mappedfile::preload()     */
 #include "play/playlist.hpp"            /* seq66::playlist support class    */
 #include "play/performer.hpp"           /* seq66::performer anchor class    */
 #include "util/filefunctions.hpp"       /* functions for file-names         */
+#include "util/parallel.hpp"            /* seq66::parallel_for()            */
 #include "util/strfunctions.hpp"        /* strip_quotes()                   */
 
 /*
@@ -90,19 +97,22 @@ playlist::playlist
     m_auto_play             (false),
     m_engage_auto_play      (false),
     m_auto_advance          (false),
+    m_gapless               (false),
     m_midi_base_directory   (rc().midi_base_directory()),
-    m_show_on_stdout        (show_on_stdout)
+    m_show_on_stdout        (show_on_stdout),
+    m_prefetch_thread       ()
 {
     // No code
 }
 
 /**
- *  This destructor unregisters this playlist from the performer object.
+ *  This destructor waits for any prefetching of song files to end.
  */
 
 playlist::~playlist ()
 {
-    // No code
+    if (m_prefetch_thread.joinable())
+        m_prefetch_thread.join();
 }
 
 /**
@@ -334,15 +344,199 @@ playlist::open_select_song_by_midi (int ctrl, bool opensong)
     return result;
 }
 
+/**
+ *  The smallest number of songs for which verify() checks the song files
+ *  across several threads.
+ */
+
+static const std::size_t c_parallel_songs_min = 8;
+
+/**
+ *  The outcome of the check of one song file by verify().
+ */
+
+enum class songcheck
+{
+    good,           /**< The file exists and looks like a song.             */
+    missing,        /**< The file does not exist.                           */
+    bad             /**< The file is not a MIDI or Cakewalk WRK file.       */
+};
+
+/**
+ *  One song file to check, with the name of its play-list, for messages.
+ */
+
+class song_check
+{
+
+public:
+
+    std::string sc_list_name;           /**< The list holding the song.     */
+    std::string sc_file_path;           /**< The full path to the song.     */
+    songcheck sc_status;                /**< The outcome of the check.      */
+
+};
+
+/**
+ *  The size and modification time of a song verified by a full parse, as
+ *  saved in the verification cache.
+ */
+
+using song_stamp = std::pair<std::size_t, long>;
+using song_stamps = std::map<std::string, song_stamp>;
+
+static unsigned long
+big_endian (const char * b, int count)
+{
+    unsigned long result = 0;
+    for (int i = 0; i < count; ++i)
+        result = (result << 8) | (unsigned char) b[i];
+
+    return result;
+}
+
+/**
+ *  Checks the start of a song file without parsing it.  A Cakewalk WRK
+ *  file needs only its tag.  A MIDI file must start with an MThd chunk.
+ *  For the deep check, the chunks of the file are also walked, by their
+ *  lengths alone: each must fit in the file, and there must be at least as
+ *  many MTrk chunks as the header says.  This touches a few bytes per
+ *  track, and is safe to run in any thread.
+ *
+ * \param fname
+ *      The full path to the song.
+ *
+ * \param chunks
+ *      If true, walk the chunks as well.
+ *
+ * \return
+ *      Returns true if the file looks like a song.
+ */
+
+static bool
+song_file_check (const std::string & fname, bool chunks)
+{
+    std::ifstream file(fname, std::ios::in | std::ios::binary);
+    bool result = file.is_open();
+    if (result)
+    {
+        char header[14];
+        result = bool(file.read(header, sizeof header));
+        if (result && memcmp(header, "CAKEWALK", 8) == 0)
+            return true;
+
+        unsigned long headerlength = big_endian(&header[4], 4);
+        result = result && memcmp(header, "MThd", 4) == 0 &&
+            headerlength >= 6;
+
+        if (result && chunks)
+        {
+            unsigned long tracks = big_endian(&header[10], 2);
+            unsigned long found = 0;
+            (void) file.seekg(0, std::ios::end);
+            unsigned long size = (unsigned long) file.tellg();
+            unsigned long pos = 8 + headerlength;
+            while (result && pos + 8 <= size)
+            {
+                char chunk[8];
+                (void) file.seekg(std::streamoff(pos));
+                result = bool(file.read(chunk, sizeof chunk));
+                if (result)
+                {
+                    if (memcmp(chunk, "MTrk", 4) == 0)
+                        ++found;
+
+                    pos += 8 + big_endian(&chunk[4], 4);
+                    result = pos <= size;       /* truncated chunk?     */
+                }
+            }
+            result = result && found >= tracks;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Checks the song files, spreading the checks over a few threads when
+ *  there are enough of them.  On SD-card and network storage the time is
+ *  nearly all spent waiting on the storage, which overlaps well.  Each
+ *  check writes only its own entry.
+ */
+
+static void
+song_files_check (std::vector<song_check> & checks, bool chunks)
+{
+    auto check = [&checks, chunks] (std::size_t i)
+    {
+        song_check & sc = checks[i];
+        if (! file_exists(sc.sc_file_path))
+            sc.sc_status = songcheck::missing;
+        else if (! song_file_check(sc.sc_file_path, chunks))
+            sc.sc_status = songcheck::bad;
+        else
+            sc.sc_status = songcheck::good;
+    };
+
+    std::size_t workers = 1;
+    if (checks.size() >= c_parallel_songs_min)
+        workers = std::max(parallel_cores(), std::size_t(2));
+
+    parallel_for(checks.size(), check, workers);
+}
+
+/**
+ *  Reads the cache of songs verified by a full parse.  Each line holds the
+ *  size, the modification time, and the full path of a song.
+ */
+
+static void
+read_song_stamps (const std::string & cachefile, song_stamps & stamps)
+{
+    std::ifstream file(cachefile);
+    std::size_t size;
+    long modtime;
+    while (file >> size >> modtime)
+    {
+        std::string path;
+        (void) file.get();                      /* the separating space     */
+        if (std::getline(file, path) && ! path.empty())
+            stamps[path] = std::make_pair(size, modtime);
+    }
+}
+
+static void
+write_song_stamps (const std::string & cachefile, const song_stamps & stamps)
+{
+    std::ofstream file(cachefile, std::ios::out | std::ios::trunc);
+    if (file.is_open())
+    {
+        for (const auto & st : stamps)
+        {
+            file << st.second.first << " " << st.second.second << " "
+                << st.first << "\n";
+        }
+    }
+}
+
 /**
  *  Goes through all of the playlists and makes sure that all of the song
  *  files are accessible.
  *
+ *  The existence of each file and its header are checked first, for all the
+ *  songs at once, in several threads if there are many songs.  Then the
+ *  results are reported in play-list order, stopping at the first problem,
+ *  as before.
+ *
  * \param strong
  *      If true, also make sure the MIDI files open without error as well.
  *      The code is similar to read_midi_file() in the midifile module, but it
  *      does not make configuration settings.  Setting this option to true can
- *      slow startup way down if there are a lot of big files in the playlist.
+ *      slow startup way down if there are a lot of big files in the playlist;
+ *      so each song that parses is logged, with its size and modification
+ *      time, in a ".verified" file beside the play-list file, and is not
+ *      parsed again until it changes.  The chunks of each file are walked
+ *      first, in the parallel check, so that a truncated file is caught
+ *      without a parse.
  *
  * \return
  *      Returns true if all of the MIDI files are verifiable.  A blank
@@ -369,52 +563,84 @@ playlist::verify (bool strong)
     }
     if (result)
     {
+        std::vector<song_check> checks;
         for (const auto & plpair : m_play_lists)
         {
             const song_list & sl = plpair.second.ls_song_list;
             for (const auto & sci : sl)
             {
-                const song_spec_t & s = sci.second;
-                std::string fname = song_filepath(s);
-                if (fname.empty())
-                {
-                    result = false;
-                    break;
-                }
-                if (file_exists(fname))
-                {
-                    if (strong)
-                    {
-                        /*
-                         * The file is parsed.  If the result is false, then
-                         * the play-list mode ends up false.  Let the caller
-                         * do the reporting on errors.
-                         */
+                song_check sc;
+                sc.sc_list_name = plpair.second.ls_list_name;
+                sc.sc_file_path = song_filepath(sci.second);
+                sc.sc_status = songcheck::missing;
+                checks.push_back(sc);
+            }
+        }
+        song_files_check(checks, strong);
 
-                        result = open_song(fname, true);
-                        if (result)
-                        {
-                            if (rc().verbose())
-                                file_message("Verified", fname);
-                        }
-                        else
-                        {
-                            set_file_error_message("song '%s' missing", fname);
-                            break;
-                        }
-                    }
+        std::string cachefile;
+        song_stamps stamps;
+        bool stamped = false;
+        if (strong && ! file_name().empty())
+        {
+            cachefile = file_extension_set(file_name(), ".verified");
+            read_song_stamps(cachefile, stamps);
+        }
+        for (const auto & sc : checks)
+        {
+            const std::string & fname = sc.sc_file_path;
+            if (fname.empty())
+            {
+                result = false;
+                break;
+            }
+            if (sc.sc_status == songcheck::missing)
+            {
+                std::string fmt = sc.sc_list_name;
+                fmt += ": song '%s' missing; check relative directories.";
+                result = set_file_error_message(fmt, fname);
+                break;
+            }
+            else if (sc.sc_status == songcheck::bad)
+            {
+                std::string fmt = sc.sc_list_name;
+                fmt += ": song '%s' is not a MIDI file.";
+                result = set_file_error_message(fmt, fname);
+                break;
+            }
+            else if (strong)
+            {
+                song_stamp stamp = std::make_pair
+                (
+                    file_size(fname), file_mod_time(fname)
+                );
+                auto st = stamps.find(fname);
+                if (st != stamps.end() && st->second == stamp)
+                    continue;                   /* unchanged since verified */
+
+                /*
+                 * The file is parsed.  If the result is false, then
+                 * the play-list mode ends up false.  Let the caller
+                 * do the reporting on errors.
+                 */
+
+                result = open_song(fname, true);
+                if (result)
+                {
+                    stamps[fname] = stamp;
+                    stamped = true;
+                    if (rc().verbose())
+                        file_message("Verified", fname);
                 }
                 else
                 {
-                    std::string fmt = plpair.second.ls_list_name;
-                    fmt += ": song '%s' missing; check relative directories.";
-                    result = set_file_error_message(fmt, fname);
+                    set_file_error_message("song '%s' missing", fname);
                     break;
                 }
             }
-            if (! result)
-                break;
         }
+        if (stamped)
+            write_song_stamps(cachefile, stamps);
     }
     else
     {
@@ -553,7 +779,11 @@ playlist::open_current_song ()
                 if (! fname.empty())
                 {
                     result = open_song(fname);
-                    if (! result)
+                    if (result)
+                    {
+                        prefetch_neighbors();
+                    }
+                    else
                     {
                         (void) set_file_error_message
                         (
@@ -1210,6 +1440,60 @@ playlist::song_filename () const
     return result;
 }
 
+/**
+ *  Gets the MIDI number and name of a playlist by its position, without
+ *  changing the current playlist.  Used by the playlist table of the user
+ *  interface, which asks only for the rows it shows.
+ *
+ * \param index
+ *      The position of the playlist, starting at 0.
+ *
+ * \param [out] midinumber
+ *      The MIDI control number of the playlist.
+ *
+ * \param [out] name
+ *      The name of the playlist.
+ *
+ * \return
+ *      Returns true if the index is in range.
+ */
+
+bool
+playlist::list_item (int index, int & midinumber, std::string & name) const
+{
+    bool result = index >= 0 && index < int(m_play_lists.size());
+    if (result)
+    {
+        auto pci = std::next(m_play_lists.cbegin(), index);
+        midinumber = pci->second.ls_midi_number;
+        name = pci->second.ls_list_name;
+    }
+    return result;
+}
+
+/**
+ *  Gets the MIDI number and file-name of a song of the current playlist by
+ *  its position, without selecting the song.  See list_item().
+ */
+
+bool
+playlist::song_item (int index, int & midinumber, std::string & name) const
+{
+    bool result = m_current_list != m_play_lists.end();
+    if (result)
+    {
+        const song_list & slist = m_current_list->second.ls_song_list;
+        result = index >= 0 && index < int(slist.size());
+        if (result)
+        {
+            auto sci = std::next(slist.cbegin(), index);
+            midinumber = sci->second.ss_midi_number;
+            name = sci->second.ss_filename;
+        }
+    }
+    return result;
+}
+
 void
 playlist::midi_base_directory (const std::string & basedir)
 {
@@ -1449,6 +1733,55 @@ playlist::previous_song ()
     return result;
 }
 
+/**
+ *  Starts reading the next and previous songs of the current playlist into
+ *  memory, in a background thread, without changing the selection.  A song
+ *  switch, which happens in the output thread when auto-advance is on, then
+ *  parses its file from the image held by mappedfile::preload(), checked
+ *  against the file's size and modification time, rather than from the
+ *  storage.  The parse itself still happens at the switch, as it fills the
+ *  one performer.  Any previous prefetch is waited for first; it has
+ *  normally long since finished.
+ */
+
+void
+playlist::prefetch_neighbors ()
+{
+    if (m_current_list == m_play_lists.end())
+        return;
+
+    song_list & sl = m_current_list->second.ls_song_list;
+    if (sl.size() < 2 || m_current_song == sl.end())
+        return;
+
+    auto nextsong = std::next(m_current_song);
+    if (nextsong == sl.end())
+        nextsong = sl.begin();
+
+    auto prevsong = m_current_song == sl.begin() ?
+        std::prev(sl.end()) : std::prev(m_current_song) ;
+
+    std::string nextname = song_filepath(nextsong->second);
+    std::string prevname = song_filepath(prevsong->second);
+    if (prevname == nextname)
+        prevname.clear();                       /* a two-song playlist      */
+
+    if (m_prefetch_thread.joinable())
+        m_prefetch_thread.join();
+
+    m_prefetch_thread = std::thread
+    (
+        [nextname, prevname] ()
+        {
+            if (! nextname.empty())
+                (void) mappedfile::preload(nextname);
+
+            if (! prevname.empty())
+                (void) mappedfile::preload(prevname);
+        }
+    );
+}
+
 /**
  *  Adds a song to the current playlist, if available.  Calls the add_song()
  *  overload taking the current song-list and the provided song-specification.
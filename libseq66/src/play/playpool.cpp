@@ -0,0 +1,246 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playpool.cpp
+ *
+ *  This module defines the pool of threads that play patterns in parallel.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ */
+
+#include <algorithm>                    /* std::stable_sort()               */
+
+#include "play/playpool.hpp"            /* seq66::playpool class            */
+#include "util/basic_macros.h"          /* not_nullptr() macro              */
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The capture buffer of the current thread, and the index of the job it is
+ *  working on.  The buffer pointer is null except while the thread is
+ *  running jobs for the pool, so that events are written directly to the
+ *  buss at all other times.
+ */
+
+static thread_local playpool::messages * tl_capture = nullptr;
+static thread_local int tl_order = 0;
+
+/**
+ *  Starts the worker threads.  They wait for the first call to run().
+ *
+ * \param workers
+ *      The number of threads to add to the calling thread.  Zero is allowed,
+ *      though not useful.
+ */
+
+playpool::playpool (int workers) :
+    m_threads       (),
+    m_buffers       (std::size_t(workers > 0 ? workers + 1 : 1)),
+    m_merged        (),
+    m_mutex         (),
+    m_start_cond    (),
+    m_done_cond     (),
+    m_generation    (0),
+    m_pending       (0),
+    m_job           (nullptr),
+    m_job_count     (0),
+    m_next_job      (0),
+    m_quit          (false)
+{
+    for (int w = 1; w <= workers; ++w)
+        m_threads.emplace_back(&playpool::worker, this, std::size_t(w));
+}
+
+/**
+ *  Tells the worker threads to quit, and waits for them.
+ */
+
+playpool::~playpool ()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_start_cond.notify_all();
+    for (auto & t : m_threads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+}
+
+/**
+ *  Runs a set of jobs, one per pattern, across the workers and the calling
+ *  thread, and returns their captured output.
+ *
+ * \param count
+ *      The number of jobs.  Each is run once, given its index.
+ *
+ * \param fn
+ *      The function to run for each job index.  It must be thread-safe
+ *      with respect to the other job indices.
+ *
+ * \return
+ *      Returns the events captured while running the jobs, sorted by
+ *      timestamp and then by job index.  The reference is valid until the
+ *      next call.
+ */
+
+playpool::messages &
+playpool::run (int count, const job & fn)
+{
+    for (auto & b : m_buffers)
+        b.clear();
+
+    m_merged.clear();
+    if (count <= 0)
+        return m_merged;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &fn;
+        m_job_count = count;
+        m_next_job.store(0);
+        m_pending = workers();
+        ++m_generation;
+    }
+    m_start_cond.notify_all();
+    work(0);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cond.wait(lock, [this] { return m_pending == 0; });
+        m_job = nullptr;
+    }
+
+    std::size_t total = 0;
+    for (const auto & b : m_buffers)
+        total += b.size();
+
+    m_merged.reserve(total);
+    for (const auto & b : m_buffers)
+        m_merged.insert(m_merged.end(), b.begin(), b.end());
+
+    std::stable_sort
+    (
+        m_merged.begin(), m_merged.end(),
+        [] (const message & a, const message & b)
+        {
+            midipulse ta = a.m_event.timestamp();
+            midipulse tb = b.m_event.timestamp();
+            return ta < tb || (ta == tb && a.m_order < b.m_order);
+        }
+    );
+    return m_merged;
+}
+
+/**
+ *  Called by sequence::put_event_on_bus() instead of writing to the buss.
+ *
+ * \return
+ *      Returns true if the current thread is running a job for the pool,
+ *      in which case the event has been saved and must not be sent.
+ */
+
+bool
+playpool::capture
+(
+    bussbyte bus, const event & ev, midibyte channel, midibyte tag
+)
+{
+    bool result = not_nullptr(tl_capture);
+    if (result)
+        tl_capture->emplace_back(ev, tl_order, bus, channel, tag);
+
+    return result;
+}
+
+/**
+ *  The loop of a worker thread, which runs jobs for each new frame until
+ *  the pool is destroyed.
+ */
+
+void
+playpool::worker (std::size_t index)
+{
+    unsigned generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start_cond.wait
+            (
+                lock, [this, generation]
+                {
+                    return m_quit || m_generation != generation;
+                }
+            );
+            if (m_quit)
+                break;
+
+            generation = m_generation;
+        }
+        work(index);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0)
+                m_done_cond.notify_one();
+        }
+    }
+}
+
+/**
+ *  Claims and runs jobs until none are left, capturing their output in the
+ *  buffer of the given thread.
+ */
+
+void
+playpool::work (std::size_t index)
+{
+    tl_capture = &m_buffers[index];
+    for (;;)
+    {
+        int j = m_next_job.fetch_add(1);
+        if (j >= m_job_count)
+            break;
+
+        tl_order = j;
+        (*m_job)(j);
+    }
+    tl_capture = nullptr;
+}
+
+}           // namespace seq66
+
+/*
+ * playpool.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,605 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          replaybench.cpp
+ *
+ *  This module defines the replay of a session log against the engine.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Usage:
+ *
+\verbatim
+    seq66cli --replay logfile [--baseline file] [--save-baseline file]
+        [--repeat n] [--tail n] [--tolerance pct] [midifile]
+\endverbatim
+ *
+ *  The log is made by running qseq66 or seq66cli with
+ *  "-o session-log=filename".  The configuration files are not read, so
+ *  the default keys and controls are used, as are eight null output
+ *  ports.  Events sent outside of the patterns, such as MIDI clock and
+ *  control output, are not part of the stream.
+ *
+ *  The baseline is plain text: a "timing" line (frames, then the mean,
+ *  median, 99th percentile, and longest frame times in nanoseconds), an
+ *  "events" line with the count, then one event per line, "tick bus status
+ *  channel d0 d1".
+ */
+
+#include <algorithm>                    /* std::sort()                      */
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdlib>                      /* EXIT_SUCCESS, EXIT_FAILURE       */
+#include <fstream>                      /* std::ifstream, std::ofstream     */
+#include <iostream>                     /* std::cout                        */
+#include <sstream>                      /* std::istringstream               */
+
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "ctrl/keystroke.hpp"           /* seq66::keystroke                 */
+#include "midi/midifile.hpp"            /* seq66::read_midi_file()          */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/playpool.hpp"            /* seq66::playpool                  */
+#include "play/replaybench.hpp"         /* seq66::replaybench class         */
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Each repeat replays the whole log, and the tail is played after its
+ *  last input, so those are bounded.  The frame limit stops a replay
+ *  whose log never stops the transport, which would otherwise never end.
+ */
+
+static const int c_replay_repeat_max = 1000;
+static const int c_replay_tail_max = 1000000;
+static const long c_replay_frames_max = 10000000;
+
+bool
+replaybench::sample::operator == (const sample & rhs) const
+{
+    return rs_tick == rhs.rs_tick && rs_bus == rhs.rs_bus &&
+        rs_status == rhs.rs_status && rs_channel == rhs.rs_channel &&
+        rs_d0 == rhs.rs_d0 && rs_d1 == rhs.rs_d1;
+}
+
+replaybench::timing::timing () :
+    rt_frames       (0),
+    rt_mean         (0.0),
+    rt_median       (0.0),
+    rt_p99          (0.0),
+    rt_max          (0.0)
+{
+    // no code
+}
+
+replaybench::replaybench () :
+    m_logfile       (),
+    m_songfile      (),
+    m_baseline      (),
+    m_save_baseline (),
+    m_repeat        (1),
+    m_tail          (256),
+    m_tolerance     (0.0)
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if "--replay" is on the command line.
+ */
+
+bool
+replaybench::requested (int argc, char * argv [])
+{
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--replay")
+            return true;
+    }
+    return false;
+}
+
+void
+replaybench::show_help ()
+{
+    std::cout <<
+"Replay options (no MIDI ports are opened):\n\n"
+"  --replay logfile     Replay a log made with '-o session-log=logfile'.\n"
+"  --baseline file      Compare the output and timing to a baseline.\n"
+"  --save-baseline file Write the output and timing as a baseline.\n"
+"  --repeat n           Replay n times; each must give the same output (1).\n"
+"  --tail n             Frames to play after the last input (256).\n"
+"  --tolerance pct      Fail if the mean frame time grows more (0 = off).\n"
+"  midifile             The song to load before replaying.\n"
+    ;
+}
+
+/**
+ *  Gets the replay options, the log, and the song.
+ *
+ * \return
+ *      Returns true if the options are good.
+ */
+
+bool
+replaybench::parse (int argc, char * argv [])
+{
+    bool result = true;
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if
+        (
+            arg == "--replay" || arg == "--baseline" ||
+            arg == "--save-baseline" || arg == "--repeat" ||
+            arg == "--tail" || arg == "--tolerance"
+        )
+        {
+            if (++argn < argc)
+            {
+                std::string value = argv[argn];
+                if (arg == "--replay")
+                    m_logfile = value;
+                else if (arg == "--baseline")
+                    m_baseline = value;
+                else if (arg == "--save-baseline")
+                    m_save_baseline = value;
+                else if (arg == "--repeat")
+                {
+                    m_repeat = std::atoi(value.c_str());
+                    result = m_repeat > 0 && m_repeat <= c_replay_repeat_max;
+                }
+                else if (arg == "--tail")
+                {
+                    m_tail = std::atoi(value.c_str());
+                    result = m_tail >= 0 && m_tail <= c_replay_tail_max;
+                }
+                else
+                {
+                    m_tolerance = std::atof(value.c_str());
+                    result = m_tolerance >= 0.0;
+                }
+            }
+            else
+                result = false;
+        }
+        else if (arg.length() > 1 && arg[0] == '-')
+            result = false;
+        else if (m_songfile.empty())
+            m_songfile = arg;
+        else
+            result = false;
+
+        if (! result)
+        {
+            errprintf("Bad replay option '%s'", arg.c_str());
+            break;
+        }
+    }
+    if (result)
+        result = ! m_logfile.empty();
+
+    if (! result)
+        show_help();
+
+    return result;
+}
+
+/**
+ *  Replays the log the given number of times, checks that every run gives
+ *  the same stream, then saves or compares the baseline.
+ *
+ * \return
+ *      Returns EXIT_SUCCESS if the replay could be made, every run matched,
+ *      and the baseline, if any, matched.
+ */
+
+int
+replaybench::run ()
+{
+    rc().with_null_midi(true);                  /* no devices, no threads   */
+    rc().null_midi_loopback(false);
+    rc().manual_ports(true);
+
+    sessionlog log;
+    bool result = log.read(m_logfile);
+    stream first;
+    std::vector<double> frametimes;
+    for (int r = 0; result && r < m_repeat; ++r)
+    {
+        stream out;
+        result = replay(log, out, frametimes);
+        if (result)
+        {
+            if (r == 0)
+            {
+                first.swap(out);
+            }
+            else if (out != first)
+            {
+                errprintf("Replay %d differs from the first", r + 1);
+                result = false;
+            }
+        }
+    }
+    if (result)
+    {
+        timing t = statistics(frametimes);
+        std::cout
+            << m_logfile << ": "
+            << log.entries().size() << " inputs, "
+            << m_repeat << " runs, " << t.rt_frames << " frames, "
+            << first.size() << " events\n    "
+            << t.rt_mean << " ns/frame mean, "
+            << t.rt_median << " median, "
+            << t.rt_p99 << " p99, "
+            << t.rt_max << " max"
+            << std::endl
+            ;
+        if (! m_save_baseline.empty())
+            result = write_baseline(first, t);
+
+        if (result && ! m_baseline.empty())
+        {
+            stream base;
+            timing basetime;
+            result = read_baseline(base, basetime);
+            if (result)
+                result = compare(first, t, base, basetime);
+        }
+    }
+    return result ? EXIT_SUCCESS : EXIT_FAILURE ;
+}
+
+/**
+ *  Replays the log once, with a new performer.  Each frame applies the
+ *  inputs that are due, then plays the patterns up to the next tick, all
+ *  inside a playpool run, so that whatever the patterns send, including
+ *  the Note Offs of a stop, is captured.  Only the frames are timed, not
+ *  the loading of the song or the setting up of the ports.
+ *
+ * \param log
+ *      The inputs to replay.
+ *
+ * \param [out] out
+ *      The events played.
+ *
+ * \param [inout] frametimes
+ *      The time of each frame, in nanoseconds, is appended.
+ *
+ * \return
+ *      Returns true if the song was loaded and the ports were set up.
+ */
+
+bool
+replaybench::replay
+(
+    const sessionlog & log, stream & out,
+    std::vector<double> & frametimes
+)
+{
+    int ppqn = choose_ppqn();
+    performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) p.get_settings(rc(), usr());
+    bool result = true;
+    if (! m_songfile.empty())
+    {
+        std::string errmsg;
+        usr().clear_global_seq_features();
+        result = read_midi_file(p, m_songfile, p.ppqn(), errmsg, false);
+        if (! result)
+            file_error(errmsg, m_songfile);
+    }
+    if (result)
+        result = p.launch_offline(p.ppqn());
+
+    if (result)
+    {
+        const std::vector<sessionlog::entry> & inputs = log.entries();
+        std::size_t next = 0;
+        midipulse step = p.ppqn() / 16;
+        if (step < 1)
+            step = 1;
+
+        playpool local(0);
+        int tail = m_tail;
+        for (long f = 0; f < c_replay_frames_max; ++f)
+        {
+            bool pending = next < inputs.size();
+            if (! pending && (! p.is_running() || tail-- <= 0))
+                break;
+
+            auto start = std::chrono::steady_clock::now();
+            const playpool::messages & played = local.run
+            (
+                1, [&p, &inputs, &next, step] (int)
+                {
+                    while
+                    (
+                        next < inputs.size() &&
+                        (! p.is_running() ||
+                            inputs[next].se_tick <= p.get_tick())
+                    )
+                    {
+                        apply(p, inputs[next++]);
+                    }
+                    if (p.is_running())
+                        p.play(p.get_tick() + step);
+                }
+            );
+            auto finish = std::chrono::steady_clock::now();
+            frametimes.push_back
+            (
+                double
+                (
+                    std::chrono::duration_cast<std::chrono::nanoseconds>
+                    (
+                        finish - start
+                    ).count()
+                )
+            );
+            for (const auto & m : played)
+            {
+                sample s;
+                s.rs_tick = m.m_event.timestamp();
+                s.rs_bus = m.m_bus;
+                s.rs_status = m.m_event.get_status();
+                s.rs_channel = m.m_channel;
+                m.m_event.get_data(s.rs_d0, s.rs_d1);
+                out.push_back(s);
+            }
+        }
+        if (next < inputs.size())
+            warnprint("Replay frame limit reached; inputs left over");
+
+        (void) p.finish();
+    }
+    return result;
+}
+
+/**
+ *  Applies one input through the same performer function that handled it
+ *  when it was logged.
+ */
+
+void
+replaybench::apply (performer & p, const sessionlog::entry & e)
+{
+    switch (e.se_kind)
+    {
+    case sessionlog::kind::midi:
+        {
+            event ev(0, e.se_status, e.se_d0, e.se_d1);
+            ev.set_input_bus(e.se_bus);
+            (void) p.dispatch_midi_input(ev);
+        }
+        break;
+
+    case sessionlog::kind::key:
+        {
+            keystroke k(ctrlkey(e.se_key), e.se_press, e.se_modifiers);
+            (void) p.midi_control_keystroke(k);
+        }
+        break;
+
+    case sessionlog::kind::toggle:
+
+        (void) p.sequence_playing_toggle(seq::number(e.se_seqno));
+        break;
+
+    case sessionlog::kind::play:
+
+        p.auto_play();
+        break;
+
+    case sessionlog::kind::stop:
+
+        p.auto_stop();
+        break;
+
+    case sessionlog::kind::pause:
+
+        p.auto_pause();
+        break;
+    }
+}
+
+/**
+ *  Gets the frame-time statistics.  The times are sorted in place.
+ */
+
+replaybench::timing
+replaybench::statistics (std::vector<double> & frametimes)
+{
+    timing result;
+    std::size_t count = frametimes.size();
+    if (count > 0)
+    {
+        double total = 0.0;
+        for (double ns : frametimes)
+            total += ns;
+
+        std::sort(frametimes.begin(), frametimes.end());
+        result.rt_frames = long(count);
+        result.rt_mean = total / double(count);
+        result.rt_median = frametimes[count / 2];
+        result.rt_p99 = frametimes[(count - 1) * 99 / 100];
+        result.rt_max = frametimes.back();
+    }
+    return result;
+}
+
+bool
+replaybench::write_baseline (const stream & s, const timing & t) const
+{
+    std::ofstream file(m_save_baseline, std::ios::out | std::ios::trunc);
+    bool result = file.is_open();
+    if (result)
+    {
+        file
+            << "# Seq66 replay baseline of " << m_logfile << "\n"
+            << "timing " << t.rt_frames << " " << t.rt_mean << " "
+            << t.rt_median << " " << t.rt_p99 << " " << t.rt_max << "\n"
+            << "events " << s.size() << "\n"
+            ;
+        for (const auto & e : s)
+        {
+            file
+                << e.rs_tick << " " << unsigned(e.rs_bus) << " "
+                << unsigned(e.rs_status) << " " << unsigned(e.rs_channel)
+                << " " << unsigned(e.rs_d0) << " " << unsigned(e.rs_d1)
+                << "\n"
+                ;
+        }
+        result = file.good();
+    }
+    if (! result)
+        file_error("Baseline write failed", m_save_baseline);
+
+    return result;
+}
+
+bool
+replaybench::read_baseline (stream & s, timing & t) const
+{
+    std::ifstream file(m_baseline);
+    bool result = file.is_open();
+    if (result)
+    {
+        std::string line;
+        while (result && std::getline(file, line))
+        {
+            std::istringstream is(line);
+            std::string word;
+            if (! (is >> word) || word[0] == '#')
+                continue;
+
+            if (word == "timing")
+            {
+                result = bool
+                (
+                    is >> t.rt_frames >> t.rt_mean >> t.rt_median >>
+                        t.rt_p99 >> t.rt_max
+                );
+            }
+            else if (word == "events")
+            {
+                std::size_t count;
+                result = bool(is >> count);
+                if (result)
+                    s.reserve(count);
+            }
+            else
+            {
+                unsigned bus, status, channel, d0, d1;
+                sample e;
+                e.rs_tick = std::atol(word.c_str());
+                result = bool(is >> bus >> status >> channel >> d0 >> d1);
+                if (result)
+                {
+                    e.rs_bus = bussbyte(bus);
+                    e.rs_status = midibyte(status);
+                    e.rs_channel = midibyte(channel);
+                    e.rs_d0 = midibyte(d0);
+                    e.rs_d1 = midibyte(d1);
+                    s.push_back(e);
+                }
+            }
+        }
+    }
+    if (! result)
+        file_error("Baseline read failed", m_baseline);
+
+    return result;
+}
+
+/**
+ *  Compares a replay to the baseline.  The streams must be the same, event
+ *  for event.  The change in the mean frame time is reported, and checked
+ *  if there is a tolerance.
+ *
+ * \return
+ *      Returns true if the streams match and the timing is within the
+ *      tolerance.
+ */
+
+bool
+replaybench::compare
+(
+    const stream & s, const timing & t,
+    const stream & base, const timing & basetime
+) const
+{
+    std::size_t count = std::min(s.size(), base.size());
+    std::size_t i = 0;
+    while (i < count && s[i] == base[i])
+        ++i;
+
+    bool result = i == s.size() && i == base.size();
+    if (result)
+    {
+        std::cout << "    output matches the baseline" << std::endl;
+    }
+    else
+    {
+        std::cout
+            << "    output differs from the baseline at event " << i
+            << " of " << s.size() << " (baseline " << base.size() << ")";
+
+        if (i < count)
+            std::cout << ", tick " << s[i].rs_tick << " vs " << base[i].rs_tick;
+
+        std::cout << std::endl;
+    }
+    if (basetime.rt_mean > 0.0)
+    {
+        double change = (t.rt_mean / basetime.rt_mean - 1.0) * 100.0;
+        std::cout
+            << "    mean frame time " << (change >= 0.0 ? "+" : "")
+            << change << "% versus the baseline (p99 "
+            << t.rt_p99 << " vs " << basetime.rt_p99 << " ns)"
+            << std::endl
+            ;
+        if (m_tolerance > 0.0 && change > m_tolerance)
+        {
+            errprintf("Frame time is over the %g%% tolerance", m_tolerance);
+            result = false;
+        }
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * replaybench.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2022-11-14
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Implements the screenset class.  The screenset class represent all of the
@@ -34,7 +34,7 @@
  *  interface.
  */
 
-#include <algorithm>                    /* std::find_if()                   */
+#include <algorithm>                    /* std::find_if(), std::upper_bound */
 #include <iomanip>                      /* std::setw() manipulator          */
 #include <iostream>                     /* std::cout                        */
 #include <sstream>                      /* std::ostringstream               */
@@ -57,6 +57,12 @@ namespace seq66
  * -------------------------------------------------------------------------
  */
 
+/**
+ *  The name of a set that has not been given one.
+ */
+
+static const char * const s_default_set_name = "empty";
+
 /**
  *  Principal constructor with optional parameters.
  *
@@ -77,10 +83,11 @@ screenset::screenset (screenset::number setnum, int rows, int columns) :
     m_swap_coordinates  (usr().swap_coordinates()),
     m_set_size          (rows * columns),
     m_container         (),
+    m_active_seqs       (),
     m_set_number        (setnum),
     m_set_offset        (m_set_number * m_set_size),
     m_set_maximum       (m_set_offset + m_set_size),
-    m_set_name          ("empty"),          /* usable() ? "New" : "Empty"   */
+    m_set_name          (s_default_set_name),   /* "New" or "Empty"?        */
     m_is_playscreen     (false),
     m_sequence_high     (0)
 {
@@ -116,10 +123,24 @@ screenset::clear ()
 {
     seq emptyseq;
     m_container.clear();
+    m_active_seqs.clear();
     for (int s = 0; s < m_set_size; ++s)
         m_container.push_back(emptyseq);
 }
 
+/**
+ *  The order of m_active_seqs: by output buss, then by pattern number.
+ */
+
+bool
+screenset::bus_order (const sequence * a, const sequence * b)
+{
+    if (a->true_bus() != b->true_bus())
+        return a->true_bus() < b->true_bus();
+
+    return a->seq_number() < b->seq_number();
+}
+
 void
 screenset::initialize (int rows, int columns)
 {
@@ -146,7 +167,8 @@ screenset::initialize (int rows, int columns)
  *
  * \return
  *      Returns true if the sequence number didn't already exist and the
- *      sequence pointer was able to be added and activated.
+ *      sequence pointer was able to be added and activated.  It is then
+ *      also added to the list of active sequences.
  */
 
 bool
@@ -165,6 +187,12 @@ screenset::add (sequence * s, seq::number & seqno)
                 if (result)
                 {
                     m_container[i] = sseq;
+                    auto pos = std::upper_bound
+                    (
+                        m_active_seqs.begin(), m_active_seqs.end(), s,
+                        bus_order
+                    );
+                    m_active_seqs.insert(pos, s);
                     break;
                 }
             }
@@ -195,12 +223,41 @@ screenset::remove (seq::number seqno)
     {
         seq newseq;                         /* non-functional pattern       */
         sp->set_armed(false);               /* turns off all notes as well  */
+        auto pos = std::find
+        (
+            m_active_seqs.begin(), m_active_seqs.end(), sp.get()
+        );
+        if (pos != m_active_seqs.end())
+            m_active_seqs.erase(pos);
+
         m_container[seqno - offset()] = newseq;
         result = true;
     }
     return result;
 }
 
+/**
+ *  Tests to see if a set name is empty or the name a set starts with, which
+ *  is what unnamed sets are saved with.
+ */
+
+bool
+screenset::default_name (const std::string & nm)
+{
+    return nm.empty() || nm == s_default_set_name;
+}
+
+/**
+ *  Tests to see if the screenset can be dropped from the setmaster: it has no
+ *  active pattern, no name of its own, and is not the play-screen.
+ */
+
+bool
+screenset::vacant () const
+{
+    return default_name(m_set_name) && ! m_is_playscreen && ! active();
+}
+
 /**
  *  Tests to see if the screenset is active.  By "active", we mean that the
  *  screen-set has at least one active pattern.
@@ -1120,18 +1177,16 @@ screenset::toggle (seq::number seqno)
 }
 
 /**
- *  This looks like a gprof hot-spot!
+ *  This looked like a gprof hot-spot, when it walked every slot of the set.
+ *  Now only the active sequences are visited.
  */
 
 void
 screenset::play (midipulse tick, sequence::playback mode, bool resumenoteons)
 {
     bool songmode = mode == sequence::playback::song;
-    for (auto & s : m_container)
-    {
-        if (s.active())
-            s.loop()->play_queue(tick, songmode, resumenoteons);
-    }
+    for (auto s : m_active_seqs)
+        s->play_queue(tick, songmode, resumenoteons);
 }
 
 void
@@ -1343,7 +1398,9 @@ screenset::unqueue (seq::number hotseq)
  *  quit if a sequence is missing.
  *
  *  Note that an unapply_bits() function is not needed here; we just follow the
- *  bits given.
+ *  bits given.  Patterns already in the wanted state are left alone, so that
+ *  applying a mute-group touches, announces, and silences only the patterns
+ *  that change.
  *
  * \param bits
  *      Provides the boolean container that is the source of mute statuses.
@@ -1367,7 +1424,8 @@ screenset::apply_bits (const midibooleans & bits)
             if (sp)
             {
                 bool armed = bits[bit];
-                sp->set_song_mute(! armed);         /* calls set_armed()    */
+                if (sp->armed() != armed || sp->get_song_mute() == armed)
+                    sp->set_song_mute(! armed);     /* calls set_armed()    */
             }
         }
     }
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2025-01-09
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The functionality of this class also includes handling some of the
@@ -48,17 +48,25 @@
  *      point, and add better locking coverage if necessary.
  */
 
+#include <algorithm>                    /* std::lower/upper_bound()         */
 #include <cstring>                      /* std::memset()                    */
 #include <cmath>                        /* std::trunc()                     */
 
+#include "cfg/hotsettings.hpp"          /* seq66::hot() for the RT threads  */
 #include "cfg/settings.hpp"             /* seq66::rc() and usr()            */
 #include "cfg/scales.hpp"               /* key and scale constants          */
 #include "midi/mastermidibus.hpp"       /* seq66::mastermidibus             */
 #include "midi/midibus.hpp"             /* seq66::midibus                   */
+#include "midi/tempomap.hpp"            /* seq66::tempomap                  */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "play/editjob.hpp"             /* seq66::editjob::checkpoint()     */
+#include "play/memoryusage.hpp"         /* seq66::memoryusage               */
 #include "play/notemapper.hpp"          /* seq66::notemapper                */
 #include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/framebatch.hpp"          /* seq66::framebatch::capture()     */
+#include "play/playpool.hpp"            /* seq66::playpool::capture()       */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
-#include "os/timing.hpp"                /* seq66::microsleep()              */
 #include "util/palette.hpp"             /* seq66::palette_to_int(), colors  */
 #include "util/strfunctions.hpp"        /* bool_to_string()                 */
 
@@ -73,6 +81,8 @@ namespace seq66
  *  This value is used as the minimal increment for growing a trigger during
  *  song-recording.  This value was originally 10, but let's use a power of 2.
  *  This increment allows the rest of the threads to notice the change.
+ *  Once recording is under way, the trigger is grown a beat (one PPQN) at a
+ *  time instead; see song_record_commit().
  */
 
 static const int c_song_record_incr = 16;
@@ -105,6 +115,16 @@ static const double c_measure_max   = 1000.00;
 
 static const midipulse c_reset_divisor = 4;
 
+/**
+ *  The expected density of a recording take, in events per beat, and the
+ *  most events to make room for ahead of one.  32 events per beat is a busy
+ *  take:  sixteenth notes (two events each) with a controller or two being
+ *  swept.  See sequence::reserve_for_recording().
+ */
+
+static const std::size_t c_record_events_per_beat = 32;
+static const std::size_t c_record_reserve_max     = 65536;
+
 /*
  * Member value.  A fingerprint size of 0 means to not use a fingerprint...
  * display the whole track in the progress box, no matter how long.
@@ -118,6 +138,18 @@ int sequence::sm_fingerprint_size   = 0;
 
 short sequence::sm_preserve_velocity;
 
+/*
+ * Bumped along with the redraw generation of every pattern.
+ */
+
+std::atomic<unsigned> sequence::sm_change_generation(0);
+
+/*
+ * The source of the edit stamps.
+ */
+
+std::atomic<unsigned> sequence::sm_edit_stamps(0);
+
 /**
  *  Provides the default name/title for the sequence.
  */
@@ -129,9 +161,13 @@ const std::string sequence::sm_default_name = "Untitled";
  *  allows for copy/paste between patterns.  Please note that this is used
  *  only for selected events.  For whole patterns, see the sequence object
  *  performer::m_seq_clipboard.
+ *
+ *  The clipboard is never changed once made; a copy replaces it with a new
+ *  one, and a paste holds a reference while it reads it, so no paste needs
+ *  a copy of its own.
  */
 
-eventlist sequence::sm_clipboard;
+std::shared_ptr<const eventlist> sequence::sm_clipboard;
 
 /**
  *  Shows the note_info values. Purely for dev trouble-shooting.
@@ -172,33 +208,44 @@ sequence::sequence (int ppqn) :
     m_true_bus                  (null_buss()),
     m_nominal_in_bus            (null_buss()),  /* optional input buss no.  */
     m_true_in_bus               (null_buss()),
-    m_song_mute                 (false),
     m_transposable              (true),
     m_notes_on                  (0),
+    m_recorded_keys             (),
+    m_dropped_note_ons          (),
+    m_take                      (),
+    m_take_pass                 (0),
     m_master_bus                (nullptr),
     m_playing_notes             (),
-    m_armed                     (false),
+    m_play_state                (unsigned(playbit::none)),
     m_recording                 (false),
     m_draw_locked               (false),
     m_recording_style           (usr().pattern_record_style()),
     m_record_alteration         (usr().record_alteration()),
     m_thru                      (false),
-    m_queued                    (false),
-    m_one_shot                  (false),
     m_one_shot_tick             (0),
     m_loop_count_max            (0),
-    m_off_from_snap             (false),
+    m_mod_lanes                 (),
+    m_mod_values                (),
+    m_output_filter             (),
     m_song_playback_block       (false),
     m_song_recording            (false),
     m_song_recording_snap       (true),
     m_song_record_tick          (0),
+    m_song_record_end           (0),
     m_loop_reset                (false),
     m_unit_measure              (0),
     m_dirty_main                (true),
     m_dirty_edit                (true),
     m_dirty_perf                (true),
     m_dirty_names               (true),
+    m_redraw_generation         (0),
+    m_regions                   (),
+    m_region_floor              (0),
+    m_region_mutex              (),
+    m_stats                     (),
+    m_stats_mutex               (),
     m_is_modified               (false),
+    m_edit_stamp                (0),
     m_seq_in_edit               (false),
     m_status                    (0),
     m_cc                        (0),
@@ -206,6 +253,9 @@ sequence::sequence (int ppqn) :
     m_last_tick                 (0),
     m_queued_tick               (0),
     m_trigger_offset            (0),
+    m_play_cursor               (0),
+    m_play_snapshot             (),
+    m_retired_snapshot          (),
     m_maxbeats                  (c_maxbeats),
     m_ppqn                      (choose_ppqn(ppqn)),
     m_seq_number                (unassigned()),
@@ -213,6 +263,7 @@ sequence::sequence (int ppqn) :
     m_seq_edit_mode             (sequence::editmode::note),
     m_length                    (4 * midipulse(m_ppqn)),  /* 1 bar of ticks */
     m_next_boundary             (0),
+    m_wrap_generation           (0),
     m_measures                  (0),
     m_snap_tick                 (int(m_ppqn) / 4),
     m_step_edit_note_length     (int(m_ppqn) / 4),
@@ -235,8 +286,8 @@ sequence::sequence (int ppqn) :
     m_events.zero_len_correction(m_snap_tick / 2);
     m_triggers.set_ppqn(int(m_ppqn));
     m_triggers.set_length(m_length);
-    for (auto & p : m_playing_notes)            /* no notes playing now     */
-        p = 0;
+    m_mod_values.fill(-1);
+    stamp_edit();                       /* no pattern shares a stamp        */
 }
 
 /**
@@ -282,14 +333,97 @@ sequence::~sequence ()
 
 void
 sequence::modify (bool notifychange)
+{
+    modify_region(nullptr, notifychange);
+}
+
+/**
+ *  Like modify(), for an edit that changes only a region of the pattern.
+ *
+ * \param r
+ *      The ticks and notes changed.
+ *
+ * \param notifychange
+ *      If true (the default), notify the performer's subscribers.
+ */
+
+void
+sequence::modify (const region & r, bool notifychange)
+{
+    modify_region(&r, notifychange);
+}
+
+/**
+ *  The body of the modify() functions.  A null region is the whole
+ *  pattern.
+ */
+
+void
+sequence::modify_region (const region * r, bool notifychange)
 {
     if (is_normal_seq())                /* currently, a seq-number < 1024   */
     {
         m_is_modified = true;
-        set_dirty();
+        stamp_edit();
+        m_events.m_note_grid.invalidate();      /* notes edited in place    */
+        publish_snapshot();
+        if (is_nullptr(r))
+            set_dirty();
+        else
+            set_dirty(*r);
+
         if (notifychange)
             notify_change();
+
+        if (not_nullptr(perf()) && seq_number() == rc().tempo_track_number())
+            perf()->tempo_map_stale();
+    }
+}
+
+/**
+ *  Publishes an immutable, compact copy of the events (see the playevents
+ *  class) for the output thread to play.  This is a read-copy-update
+ *  scheme: the new snapshot is swapped in atomically, and the output thread
+ *  keeps its own reference for the duration of a frame, so it can play
+ *  even when an editor holds the mutex (see play()).  The previous snapshot
+ *  is retired, not freed, so that the output thread normally does not end
+ *  up deallocating it.  It is freed on the next publication.
+ *
+ *  A playevent is under a quarter the size of an event, so this is cheap
+ *  enough to do for each event that arrives while recording.
+ *
+ *  Must be called with the mutex held.
+ */
+
+void
+sequence::publish_snapshot ()
+{
+    snapshot snap = std::make_shared<const playevents>
+    (
+        m_events.events(), m_mod_lanes
+    );
+    m_retired_snapshot = std::atomic_load(&m_play_snapshot);
+    std::atomic_store(&m_play_snapshot, snap);
+}
+
+/**
+ *  Gets the playback snapshot, publishing a fresh one if there is none yet
+ *  or if the event list has grown or shrunk without a call to modify() (as
+ *  when reading a MIDI file or building the metronome).
+ *
+ *  Must be called with the mutex held.
+ */
+
+sequence::snapshot
+sequence::current_snapshot ()
+{
+    snapshot result = std::atomic_load(&m_play_snapshot);
+    if (! result || result->source_count() != m_events.events().size())
+    {
+        publish_snapshot();
+        result = std::atomic_load(&m_play_snapshot);
     }
+    return result;
 }
 
 /**
@@ -306,7 +440,7 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
 {
     if (this != &rhs)
     {
-        automutex locker(m_mutex);
+        writelock locker(m_mutex);
         m_parent                    = rhs.m_parent;         /* a pointer    */
         m_events                    = rhs.m_events;         /* container!   */
         m_triggers                  = rhs.m_triggers;       /* 2021-07-27   */
@@ -329,8 +463,12 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
         m_true_bus                  = rhs.m_true_bus;
         m_nominal_in_bus            = rhs.m_nominal_in_bus;
         m_true_in_bus               = rhs.m_true_in_bus;
-        m_song_mute                 = rhs.m_song_mute;
+        play_bit(playbit::song_mute, rhs.get_song_mute());
         m_transposable              = rhs.m_transposable;
+        m_mod_lanes                 = rhs.m_mod_lanes;
+        m_output_filter             = rhs.m_output_filter ?  /* own copy */
+            std::make_shared<const outputfilter>(*rhs.m_output_filter) :
+            filter() ;
         m_notes_on                  = 0;
         m_master_bus                = rhs.m_master_bus;     /* a pointer    */
         m_unit_measure              = rhs.m_unit_measure;
@@ -341,7 +479,7 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
          *  These values are set fine for this purpose by the constructor
          *
          *  m_playing_notes
-         *  m_armed
+         *  m_play_state, except for the song mute
          *  m_recording
          *  m_draw_locked
          *  m_expanded_recording
@@ -349,16 +487,14 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
          *  m_oneshot_recording
          *  m_record_alteration
          *  m_thru
-         *  m_queued
          *  m_soloed
-         *  m_one_shot
          *  m_one_shot_tick
          *  m_loop_count_max
-         *  m_off_from_snap
          *  m_song_playback_block
          *  m_song_recording
          *  m_song_recording_snap
          *  m_song_record_tick
+         *  m_song_record_end
          *  m_loop_reset
          *  m_dirty_main
          *  m_dirty_edit
@@ -391,8 +527,7 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
         m_musical_key               = rhs.m_musical_key;
         m_musical_scale             = rhs.m_musical_scale;
         m_background_sequence       = rhs.m_background_sequence;
-        for (auto & p : m_playing_notes)            /* no notes playing now */
-            p = 0;
+        m_playing_notes.clear();                    /* no notes playing now */
 
         m_last_tick = 0;                            /* reset to tick 0      */
         (void) verify_and_link();                   /* NoteOn <---> NoteOff */
@@ -401,6 +536,72 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
     }
 }
 
+/**
+ *  Copies this pattern into a scratch pattern for an editjob, which edits
+ *  it on a worker thread.  Unlike a bare partial_assign(), this holds the
+ *  lock of this pattern during the copy.
+ *
+ * \threadsafe
+ *
+ * \param scratch
+ *      The pattern to receive the copy.  It is not in any set.
+ *
+ * \return
+ *      Returns the playback snapshot of the events copied, to be given to
+ *      adopt_edit().  Every change to the events publishes a new one.
+ */
+
+sequence::snapshot
+sequence::copy_for_edit (sequence & scratch)
+{
+    writelock locker(m_mutex);
+    scratch.partial_assign(*this, true);        /* no modify() of scratch   */
+    return current_snapshot();
+}
+
+/**
+ *  Takes the events, and the length and time signature, of a scratch
+ *  pattern edited by an editjob, as one change with one undo.  The scratch
+ *  events are moved, not copied.
+ *
+ * \threadsafe
+ *
+ * \param scratch
+ *      The pattern made by copy_for_edit(), then edited.
+ *
+ * \param base
+ *      The snapshot returned by copy_for_edit().  If the events have
+ *      changed since (as by recording, or another edit), nothing is done.
+ *      Muting, selecting, and the like do not count.
+ *
+ * \return
+ *      Returns true if the edit was taken.
+ */
+
+bool
+sequence::adopt_edit (sequence & scratch, const snapshot & base)
+{
+    writelock locker(m_mutex);
+    bool result = base && current_snapshot() == base;
+    if (result)
+    {
+        push_undo();
+        m_events = std::move(scratch.m_events);
+        m_time_beats_per_measure = scratch.m_time_beats_per_measure;
+        m_time_beat_width = scratch.m_time_beat_width;
+        if (scratch.m_length != m_length)
+        {
+            m_length = scratch.m_length;
+            m_triggers.set_length(m_length);
+        }
+        m_events.set_length(m_length);
+        (void) unit_measure(true);              /* for the new time-sig     */
+        (void) verify_and_link();
+        modify();                               /* publishes new snapshot   */
+    }
+    return result;
+}
+
 /*
  *  These two functions are an attempt to remove a seqfault that can occur
  *  in qseqdata, qseqroll, qloopbutton, etc. when processing multiple
@@ -495,7 +696,7 @@ sequence::background_sequence (int bs, bool user_change)
 bool
 sequence::set_color (int c, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     if (c >= 0 || c == c_seq_color_none)
     {
@@ -513,7 +714,7 @@ sequence::set_color (int c, bool user_change)
 bool
 sequence::loop_count_max (int m, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     if (m >= 0 && m != m_loop_count_max)
     {
@@ -527,6 +728,78 @@ sequence::loop_count_max (int m, bool user_change)
     return result;
 }
 
+/**
+ *  Adds a modulation lane, which plays from the next frame on.
+ *
+ * \param ml
+ *      The lane, which must be valid.
+ *
+ * \param user_change
+ *      If true, the pattern is marked as modified.  False when reading the
+ *      MIDI file.
+ *
+ * \return
+ *      Returns true if the lane was added.  At most modlane::c_lanes_max
+ *      lanes are allowed.
+ */
+
+bool
+sequence::add_mod_lane (const modlane & ml, bool user_change)
+{
+    writelock locker(m_mutex);
+    bool result = ml.valid() && int(m_mod_lanes.size()) < modlane::c_lanes_max;
+    if (result)
+    {
+        m_mod_lanes.push_back(ml);
+        reset_mod_values();
+        if (user_change)
+            modify();
+        else
+            publish_snapshot();
+    }
+    return result;
+}
+
+bool
+sequence::remove_mod_lane (int index)
+{
+    writelock locker(m_mutex);
+    bool result = index >= 0 && index < int(m_mod_lanes.size());
+    if (result)
+    {
+        m_mod_lanes.erase(m_mod_lanes.begin() + index);
+        reset_mod_values();
+        modify();
+    }
+    return result;
+}
+
+void
+sequence::clear_mod_lanes (bool user_change)
+{
+    writelock locker(m_mutex);
+    if (! m_mod_lanes.empty())
+    {
+        m_mod_lanes.clear();
+        reset_mod_values();
+        if (user_change)
+            modify();
+        else
+            publish_snapshot();
+    }
+}
+
+/**
+ *  Forgets the values last sent by the lanes, so that each lane sends its
+ *  next value even if unchanged.
+ */
+
+void
+sequence::reset_mod_values ()
+{
+    m_mod_values.fill(-1);
+}
+
 /**
  *  If empty, sets the color to classic Sequencer64 yellow.  Called by
  *  performer when installing a sequence.
@@ -542,7 +815,7 @@ sequence::empty_coloring ()
 bool
 sequence::clear_events ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = ! m_events.empty();
     if (result)
     {
@@ -566,15 +839,92 @@ sequence::clear_events ()
 int
 sequence::event_count () const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_events.count();
 }
 
 int
 sequence::note_count () const
 {
-    automutex locker(m_mutex);
-    return m_events.note_count();
+    readlock locker(m_mutex);
+    return refresh_stats().es_note_count;
+}
+
+/**
+ *  Fills in a summary of the pattern under one lock, rather than the lock
+ *  per item that event_count(), note_count(), etc. take.
+ *
+ * \param [out] sm
+ *      The summary.  The trigger vector is reused, so a caller summarizing
+ *      many patterns can keep one summary object.
+ */
+
+void
+sequence::get_summary (summary & sm) const
+{
+    readlock locker(m_mutex);
+    eventstats st = refresh_stats();
+    sm.sm_number = seq_number();
+    sm.sm_name = name();
+    sm.sm_in_bus = int(seq_midi_in_bus());
+    sm.sm_true_in_bus = int(true_in_bus());
+    sm.sm_bus = int(seq_midi_bus());
+    sm.sm_true_bus = int(true_bus());
+    sm.sm_channel = int(seq_midi_channel());
+    sm.sm_beats_per_bar = get_beats_per_bar();
+    sm.sm_beat_width = get_beat_width();
+    sm.sm_length = get_length();
+    sm.sm_event_count = m_events.count();
+    sm.sm_note_count = st.es_note_count;
+    sm.sm_playable_count = st.es_playable_count;
+    sm.sm_transposable = transposable();
+    sm.sm_key = int(musical_key());
+    sm.sm_scale = int(musical_scale());
+    sm.sm_color = color();
+    sm.sm_triggers.assign(triggerlist().begin(), triggerlist().end());
+}
+
+/**
+ *  Adds the memory held by the pattern to a reading of the memory usage.
+ *  The events of the newest undo entry are usually shared with the pattern,
+ *  and so are counted twice.
+ *
+ * \param [out] mu
+ *      The reading, to which the bytes of each category are added.
+ */
+
+void
+sequence::memory_usage (memoryusage & mu) const
+{
+    using cat = memoryusage::category;
+    snapshot playing = std::atomic_load(&m_play_snapshot);
+    readlock locker(m_mutex);
+    mu.add_pattern();
+    mu.add(cat::events, sizeof(sequence) + m_events.bytes());
+    mu.add(cat::sysex, m_events.sysex_bytes());
+    mu.add(cat::triggers, m_triggers.bytes());
+    mu.add
+    (
+        cat::undo, m_events_undo.bytes() + m_events_redo.bytes() +
+            m_events_undo_hold.bytes() + m_triggers.undo_bytes()
+    );
+    mu.add(cat::caches, m_events.note_spans().bytes());
+    if (playing)
+        mu.add(cat::caches, playing->bytes());
+
+    if (m_retired_snapshot && m_retired_snapshot != playing)
+        mu.add(cat::caches, m_retired_snapshot->bytes());
+}
+
+/**
+ *  The memory held by the clipboard shared by all patterns.
+ */
+
+std::size_t
+sequence::clipboard_bytes ()
+{
+    std::shared_ptr<const eventlist> clip = sm_clipboard;   /* GUI thread */
+    return clip ? clip->bytes() + clip->sysex_bytes() : 0 ;
 }
 
 /**
@@ -584,22 +934,103 @@ sequence::note_count () const
 bool
 sequence::first_notes (midipulse & ts, int & n) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_events.first_notes(ts, n, m_snap_tick);
 }
 
 int
 sequence::playable_count () const
 {
-    automutex locker(m_mutex);
-    return m_events.playable_count();
+    readlock locker(m_mutex);
+    return refresh_stats().es_playable_count;
 }
 
 bool
 sequence::is_playable () const
 {
-    automutex locker(m_mutex);
-    return m_events.is_playable();
+    readlock locker(m_mutex);
+    return refresh_stats().es_playable_count > 0;
+}
+
+/**
+ *  Gathers the statistics of the events in one pass, if the events have
+ *  changed since the last time.  The caller must hold the mutex, but a
+ *  readlock is enough, since the events cannot change under it.  The cache
+ *  has its own small mutex, so that several readers can look at it, and
+ *  fill it, at once.  Two readers can both gather the same statistics after
+ *  a change; this is harmless.
+ *
+ * \return
+ *      Returns a copy of the statistics.
+ */
+
+sequence::eventstats
+sequence::refresh_stats () const
+{
+    unsigned changes = m_events.changes();
+    unsigned generation = redraw_generation();
+    {
+        automutex locker(m_stats_mutex);
+        const eventstats & st = m_stats;
+        if (st.es_valid && st.es_changes == changes &&
+            st.es_generation == generation)
+        {
+            return st;
+        }
+    }
+
+    eventstats st;
+    bool minmax = false;
+    int notes = 0;
+    int playables = 0;
+    int low = int(max_midi_value());
+    int high = -1;
+    for (auto cev = m_events.cbegin(); cev != m_events.cend(); ++cev)
+    {
+        const event & er = *cev;
+        if (er.is_note_on())
+            ++notes;
+
+        if (er.is_playable())
+            ++playables;
+
+        if (er.is_strict_note())                    /* see minmax_notes()   */
+        {
+            if (er.get_note() < low)
+            {
+                low = er.get_note();
+                minmax = true;
+            }
+            else if (er.get_note() > high)
+            {
+                high = er.get_note();
+                minmax = true;
+            }
+        }
+        else if (er.is_tempo())
+        {
+            midibyte notebyte = tempo_to_note_value(er.tempo());
+            if (notebyte < low)
+                low = notebyte;
+            else if (notebyte > high)
+                high = notebyte;
+
+            minmax = true;
+        }
+    }
+    st.es_valid = true;
+    st.es_changes = changes;
+    st.es_generation = generation;
+    st.es_note_count = notes;
+    st.es_playable_count = playables;
+    st.es_minmax = minmax;
+    st.es_lowest = low;
+    st.es_highest = high;
+    {
+        automutex locker(m_stats_mutex);
+        m_stats = st;
+    }
+    return st;
 }
 
 /*-------------------------------------------------------------------------
@@ -734,6 +1165,60 @@ sequence::push_default_time_signature ()
     m_time_signatures.push_back(t);
 }
 
+/**
+ *  Finds the time-signature in force at the given tick, the last one
+ *  starting at or before it.  The list must not be empty.
+ *
+ * \param p
+ *      The tick to look up.
+ *
+ * \return
+ *      Returns the index of the time-signature, or 0 if the tick precedes
+ *      them all.
+ */
+
+int
+sequence::time_signature_at (midipulse p) const
+{
+    auto it = std::upper_bound
+    (
+        m_time_signatures.cbegin(), m_time_signatures.cend(), p,
+        [] (midipulse tick, const timesig & t)
+        {
+            return tick < t.sig_start_tick;
+        }
+    );
+    int result = int(it - m_time_signatures.cbegin()) - 1;
+    return result > 0 ? result : 0 ;
+}
+
+/**
+ *  Finds the time-signature in force at the given measure, the last one
+ *  starting at or before it.  The list must not be empty.
+ *
+ * \param m
+ *      The measure number (starting at 1) to look up.
+ *
+ * \return
+ *      Returns the index of the time-signature, or 0 if the measure precedes
+ *      them all.
+ */
+
+int
+sequence::time_signature_at_measure (double m) const
+{
+    auto it = std::upper_bound
+    (
+        m_time_signatures.cbegin(), m_time_signatures.cend(), m,
+        [] (double measure, const timesig & t)
+        {
+            return measure < t.sig_start_measure;
+        }
+    );
+    int result = int(it - m_time_signatures.cbegin()) - 1;
+    return result > 0 ? result : 0 ;
+}
+
 const sequence::timesig &
 sequence::get_time_signature (size_t index) const
 {
@@ -780,18 +1265,12 @@ sequence::current_time_signature
     int count = time_signature_count();
     if (count > 0)
     {
-        for (int i = 1; i < count; ++i)
+        const timesig & current = get_time_signature(time_signature_at(p));
+        if (p >= current.sig_start_tick && p < current.sig_end_tick)
         {
-            const timesig & current = get_time_signature(i);
-            midipulse p0 = current.sig_start_tick;
-            midipulse p1 = current.sig_end_tick;
-            if (p >= p0 && p < p1)
-            {
-                beats = current.sig_beats_per_bar;
-                beatwidth = current.sig_beat_width;
-                result = true;
-                break;
-            }
+            beats = current.sig_beats_per_bar;
+            beatwidth = current.sig_beat_width;
+            result = true;
         }
     }
     else
@@ -812,12 +1291,11 @@ sequence::current_time_signature
  *  This function is meant to be used in the time-lines of the pattern or song
  *  editors.
  *
- *  If the tick is past the start of the last time-signature (there is always
- *  one, the default time signature), then we get the duration since that start,
- *  convert it to a measure value, then add it to the firts measure of the last
- *  time-signature.
- *
- *  Note: for speed, we should use the old method, just incrementing the measure.
+ *  The time-signature in force at the tick is found by bisection (there is
+ *  always one, the default time signature); then we get the duration since
+ *  its start, convert it to a measure value, then add it to the first
+ *  measure of that time-signature.  This is called for every bar line drawn,
+ *  so it must not walk the list.
  *
  * \param p
  *      Provides the tick for which we want to get the measure it it in.
@@ -833,32 +1311,17 @@ sequence::measure_number (midipulse p) const
     int count = time_signature_count();
     if (count > 0)
     {
-        int ppq = get_ppqn();
-        for (int i = 0; i < count; ++i)
-        {
-            const timesig & t = get_time_signature(i);
-            midipulse p0 = t.sig_start_tick;
-            if (p >= p0)
-            {
-                midipulse p1 = t.sig_end_tick;
-                midipulse duration = p - p0;
-                double mnew = t.sig_start_measure;
-                double m = pulses_to_measures
-                (
-                    duration, ppq, t.sig_beats_per_bar,
-                    t.sig_beat_width
-                );
-                result += int(mnew + m + 0.5);      /* round up for now */
-                if (p >= p1)
-                {
-                    /*
-                     * We're past the last time-signature event. See banner.
-                     */
+        const timesig & t = get_time_signature(time_signature_at(p));
+        midipulse duration = p - t.sig_start_tick;
+        if (duration < 0)
+            duration = 0;
 
-                    break;
-                }
-            }
-        }
+        double mnew = t.sig_start_measure;
+        double m = pulses_to_measures
+        (
+            duration, get_ppqn(), t.sig_beats_per_bar, t.sig_beat_width
+        );
+        result = int(mnew + m + 0.5);               /* round up for now */
     }
     else
         result = measures();
@@ -876,7 +1339,7 @@ sequence::measure_number (midipulse p) const
  *          -   Extract the 4 (measures).
  *          -   Extract the 1 (beat).
  *          -   Extract the ticks.
- *      -   Iterate the time-signatures to get to the one where
+ *      -   Bisect the time-signatures to get to the one where
  *          measure >= t.sig_start_measure and if not at the end
  *          where measure < t+1.sig_start_measure.
  *          -   Set pulses = t.sig_start_tick.
@@ -900,32 +1363,15 @@ sequence::time_signature_pulses (const std::string & s) const
     if (count > 0)
     {
         double mtarget = double(mm.measures());
-        bool got_it = false;
-        for (int i = 0; i < count; ++i)
-        {
-            const timesig & t0 = get_time_signature(i);
-            double m0 = t0.sig_start_measure;
-            double m1;
-            if (i < (count - 1))
-            {
-                const timesig & t1 = get_time_signature(i + 1);
-                m1 = t1.sig_start_measure;
-                if (mtarget >= m0 && mtarget < m1)
-                    got_it = true;
-            }
-            else    /* target measure is after last time-signature change.  */
-                got_it = true;
-
-            if (got_it)
-            {
-                double mcount = double(mm.measures()) - m0; /* integral?    */
-                double tpb = double(t0.sig_ticks_per_beat);
-                double bpb = double(t0.sig_beats_per_bar);
-                midipulse added = midipulse(tpb * bpb * mcount);
-                result = t0.sig_start_tick + added + mm.divisions();
-                break;
-            }
-        }
+        const timesig & t0 = get_time_signature
+        (
+            time_signature_at_measure(mtarget)
+        );
+        double mcount = mtarget - t0.sig_start_measure;     /* integral?    */
+        double tpb = double(t0.sig_ticks_per_beat);
+        double bpb = double(t0.sig_beats_per_bar);
+        midipulse added = midipulse(tpb * bpb * mcount);
+        result = t0.sig_start_tick + added + mm.divisions();
     }
     else
     {
@@ -983,7 +1429,7 @@ sequence::apply_time_factor
 void
 sequence::push_undo (bool hold)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (hold)
         m_events_undo.push(m_events_undo_hold);     /* stazed   */
     else
@@ -1020,7 +1466,7 @@ sequence::set_have_undo ()
 void
 sequence::pop_undo ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (! m_events_undo.empty())
     {
         m_events_redo.push(m_events);
@@ -1045,7 +1491,7 @@ sequence::pop_undo ()
 void
 sequence::pop_redo ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (! m_events_redo.empty())                // move to triggers module?
     {
         m_events_undo.push(m_events);
@@ -1067,7 +1513,7 @@ sequence::pop_redo ()
 void
 sequence::push_trigger_undo ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.push_undo();
 }
 
@@ -1080,7 +1526,7 @@ sequence::push_trigger_undo ()
 void
 sequence::pop_trigger_undo ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.pop_undo();
 }
 
@@ -1093,7 +1539,7 @@ sequence::pop_trigger_undo ()
 void
 sequence::pop_trigger_redo ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.pop_redo();
 }
 
@@ -1112,7 +1558,7 @@ sequence::pop_trigger_redo ()
 bool
 sequence::set_master_midi_bus (const mastermidibus * mmb)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_master_bus = const_cast<mastermidibus *>(mmb);
     return not_nullptr(mmb);
 }
@@ -1133,7 +1579,7 @@ sequence::set_master_midi_bus (const mastermidibus * mmb)
 void
 sequence::set_beats_per_bar (int bpb, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool modded = false;
     if (bpb != int(m_time_beats_per_measure))
     {
@@ -1178,7 +1624,7 @@ sequence::set_beats_per_bar (int bpb, bool user_change)
 void
 sequence::set_beat_width (int bw, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool modded = false;
     if (bw != int(m_time_beat_width))
     {
@@ -1228,7 +1674,7 @@ sequence::set_time_signature (int bpb, int bw)
 midipulse
 sequence::unit_measure (bool reset) const
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (m_unit_measure == 0 || reset)
         m_unit_measure = measures_to_ticks();       /* length of 1 measure  */
 
@@ -1407,7 +1853,7 @@ sequence::get_measures () const
 void
 sequence::set_rec_vol (int recvol)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool valid = recvol > 0 && recvol <= usr().max_note_on_velocity();
     if (! valid)
         valid = recvol == usr().preserve_velocity();
@@ -1472,7 +1918,7 @@ sequence::toggle_playing (midipulse tick, bool resumenoteons)
 }
 
 /**
- * \setter m_song_mute
+ * \setter playbit::song_mute
  *      This function also calls set_dirty_mp() to make sure that the
  *      perfnames panel is updated to show the new mute status of the
  *      sequence.
@@ -1487,7 +1933,7 @@ sequence::toggle_playing (midipulse tick, bool resumenoteons)
 void
 sequence::set_song_mute (bool mute)
 {
-    m_song_mute = mute;
+    play_bit(playbit::song_mute, mute);
     set_armed(! mute);
     set_dirty_mp();
 }
@@ -1495,7 +1941,7 @@ sequence::set_song_mute (bool mute)
 void
 sequence::toggle_song_mute ()
 {
-    bool mute = ! m_song_mute;
+    bool mute = ! get_song_mute();
     set_song_mute(mute);
 }
 
@@ -1513,16 +1959,20 @@ sequence::toggle_song_mute ()
 bool
 sequence::toggle_queued ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     set_dirty_mp();
-    m_queued = ! m_queued;
+
+    bool queued = flip_play_bit(playbit::queued);
 
 #if defined SEQ66_PLATFORM_DEBUG_TMI
-    printf("seq %d: queuing %s\n", int(seq_number()), m_queued ? "on" : "off");
+    printf("seq %d: queuing %s\n", int(seq_number()), queued ? "on" : "off");
 #endif
 
-    m_queued_tick = m_last_tick - mod_last_tick() + get_length();
+    m_queued_tick = last_tick() - mod_last_tick() + get_length();
     off_from_snap(true);
+    if (queued)
+        perf()->schedule_boundary(this, m_queued_tick);
+
     perf()->announce_pattern(seq_number());     /* for issue #89        */
     return true;
 }
@@ -1566,6 +2016,12 @@ sequence::toggle_queued ()
  *
  *  Can we somehow reset the times-played?
  *
+ * Playback cursor:
+ *
+ *  The first pass through the events starts at play_cursor(), not at
+ *  m_events.begin(), so that the cost of a frame is proportional to the
+ *  number of events actually emitted, not the size of the pattern.
+ *
  * \param tick
  *      Provides the current end-tick value.  The tick comes in as a global
  *      tick.
@@ -1591,11 +2047,176 @@ sequence::play
     bool resumenoteons
 )
 {
-    automutex locker(m_mutex);
-    bool trigger_turning_off = false;       /* turn off after in-frame play */
-    int trigtranspose = 0;                  /* used with c_trig_transpose   */
-    midipulse start_tick = m_last_tick;     /* modified in triggers::play() */
-    midipulse len = get_length() > 0 ? get_length() : m_ppqn ;
+    trace_scope ts("sequence play");
+    midipulse lefttick;
+    bool wrapped = loop_wrapped(lefttick);
+    if (m_mutex.try_lock())
+    {
+        if (wrapped)
+            wrap_loop(lefttick, tick, playback_mode, true);
+
+        snapshot snap = current_snapshot();
+        play_frame(*snap, tick, playback_mode, resumenoteons);
+        m_mutex.unlock();
+    }
+    else
+    {
+        snapshot snap;
+        bool lockfree =
+            ! playback_mode && ! get_song_mute() && ! song_recording();
+        if (lockfree)
+            snap = std::atomic_load(&m_play_snapshot);
+
+        if (snap)
+        {
+            if (wrapped)
+                wrap_loop(lefttick, tick, false, false);
+
+            play_frame(*snap, tick, false, resumenoteons);
+        }
+        else
+        {
+            long start = microtime();           /* time an editor's hold    */
+            writelock locker(m_mutex);
+            if (not_nullptr(perf()))
+                perf()->output_stats().lock_wait(microtime() - start);
+
+            if (wrapped)
+                wrap_loop(lefttick, tick, playback_mode, true);
+
+            snap = current_snapshot();
+            play_frame(*snap, tick, playback_mode, resumenoteons);
+        }
+    }
+}
+
+/**
+ *  Used by performer::play() in place of play() when the song timeline
+ *  shows that the pattern has nothing to do in the frame.  It keeps the
+ *  start of the next frame where play() would have put it, after absorbing
+ *  a loop wrap, if any.
+ *
+ * \param tick
+ *      The end tick of the frame.
+ */
+
+void
+sequence::song_skip (midipulse tick)
+{
+    midipulse lefttick;
+    if (loop_wrapped(lefttick))
+        wrap_loop(lefttick, tick, true, false);
+
+    m_last_tick.store(tick + 1, std::memory_order_relaxed);
+}
+
+/**
+ *  Checks for a loop wrap that this pattern has not yet seen, and marks it
+ *  as seen.
+ *
+ * \param [out] lefttick
+ *      Set to the left tick of the loop, if the loop wrapped.
+ *
+ * \return
+ *      Returns true if the loop wrapped since the pattern last played.
+ */
+
+bool
+sequence::loop_wrapped (midipulse & lefttick)
+{
+    if (is_nullptr(perf()))
+        return false;
+
+    unsigned g = perf()->wrap_generation();
+    if (g == m_wrap_generation.load(std::memory_order_acquire))
+        return false;
+
+    m_wrap_generation.store(g, std::memory_order_release);
+    lefttick = perf()->wrap_tick();
+    return true;
+}
+
+/**
+ *  The lazy form of the stop() that performer once applied to every
+ *  pattern at the loop point, followed by setting the last tick to the
+ *  left tick.  It is done by the output thread just before the pattern
+ *  plays its first frame after the wrap.  A pattern that was not playing
+ *  when the loop wrapped, and whose last tick is not past the frame, keeps
+ *  its last tick.
+ *
+ * \param lefttick
+ *      The left tick of the loop.
+ *
+ * \param tick
+ *      The end tick of the frame about to be played.
+ *
+ * \param songmode
+ *      True if Song mode is in force, in which case the pattern is disarmed
+ *      until its triggers arm it again.
+ *
+ * \param locked
+ *      True if the mutex is held.  If false, only the output thread's own
+ *      playback state is touched, and the recording is not relinked.
+ */
+
+void
+sequence::wrap_loop
+(
+    midipulse lefttick, midipulse tick, bool songmode, bool locked
+)
+{
+    bool state = armed();
+    send_playing_notes_off();
+    if (last_tick() > tick)
+        set_last_tick(lefttick);
+
+    reset_mod_values();
+    filter of = std::atomic_load(&m_output_filter);
+    if (of)
+        of->reset();
+
+    if (locked && recording())
+        (void) verify_and_link();
+
+    set_armed(songmode ? false : state);
+    m_next_boundary = 0;
+}
+
+/**
+ *  The body of play(), which plays the compact playback snapshot of the
+ *  events, and runs in one of two ways.  Normally the mutex is held and the
+ *  snapshot is current.  When an editor holds the mutex (for example,
+ *  during a long quantization or while painting), and the pattern is
+ *  playing in Live mode, the mutex is not held.  In that case only the
+ *  output thread's own playback state is touched, and the triggers and
+ *  song-recording code are not reached.
+ *
+ * \param evs
+ *      The snapshot of the events to play.
+ *
+ * \param tick
+ *      Provides the current end-tick value, a global tick.
+ *
+ * \param playback_mode
+ *      True if Song mode is in force.
+ *
+ * \param resumenoteons
+ *      A song-recording parameter.
+ */
+
+void
+sequence::play_frame
+(
+    const playevents & pevs,
+    midipulse tick,
+    bool playback_mode,
+    bool resumenoteons
+)
+{
+    bool trigger_turning_off = false;       /* turn off after in-frame play */
+    int trigtranspose = 0;                  /* used with c_trig_transpose   */
+    midipulse start_tick = last_tick();     /* modified in triggers::play() */
+    midipulse len = get_length() > 0 ? get_length() : m_ppqn ;
 
     /*
      * Issue #103. This fix allows the progress bar to behave well under
@@ -1606,7 +2227,7 @@ sequence::play
 
     midipulse times_played = tick / len;
     m_trigger_offset = 0;                   /* from Seq24                   */
-    if (m_song_mute)
+    if (get_song_mute())
     {
         set_armed(false);
     }
@@ -1621,8 +2242,7 @@ sequence::play
         {
             (void) perf()->calculate_snap(tick);  /* issue #44 redux      */
 
-            bool added = grow_trigger(song_record_tick(), tick);
-            if (added)
+            if (song_record_commit(tick))
                 notify_trigger();
         }
         if (playback_mode)                          /* song mode: triggers  */
@@ -1654,67 +2274,50 @@ sequence::play
         if (transpose == 0)
             transpose = transposable() ? perf()->get_transpose() : 0 ;
 
-        auto e = m_events.begin();
-        while (e != m_events.end())
-        {
-#if defined USE_NULL_EVENT_DETECTION
+        /*
+         * The number of passes through the events is the number of pattern
+         * repeats that overlap the frame.  It is almost always 1, or 2 when
+         * the frame straddles the end of the pattern.  Short patterns at a
+         * high PPQN can need more, and they are simply counted out, with no
+         * looping back or sleeping while holding the mutex.
+         */
 
-            /*
-             * This doesn't solve the problem of hiccups when moving to the
-             * next song in the playlist.
-             */
+        midipulse passes = end_tick_offset >= offset_base ?
+            (end_tick_offset - offset_base) / len + 1 : 0 ;
 
-            if (is_nullptr(e))
-                return;
-#endif
-            event & er = eventlist::dref(e);
-            midipulse ts = er.timestamp();
-            midipulse stamp = ts + offset_base;
-            if (stamp >= start_tick_offset && stamp <= end_tick_offset)
+        filter of = std::atomic_load(&m_output_filter);
+        const playevents::buffer & evs = pevs.events();
+        auto e = play_cursor(evs, start_tick_offset - offset_base);
+        for (midipulse pass = 0; pass < passes; ++pass, offset_base += len)
+        {
+            if (pass > 0)
+                e = evs.cbegin();                   /* next pattern repeat  */
+
+            for ( ; e != evs.cend(); ++e)
             {
-                if (transpose != 0 && er.is_note()) /* includes Aftertouch  */
-                {
-                    event trans_event = er;         /* assign ALL members   */
-                    trans_event.transpose_note(transpose);
-                    put_event_on_bus(trans_event);
-                }
-                else
+                const playevent & pe = *e;
+                midipulse stamp = pe.timestamp() + offset_base;
+                if (stamp > end_tick_offset)
+                    break;                          /* frame is done        */
+
+                if (stamp < start_tick_offset)
+                    continue;                       /* before the frame     */
+
+                if (pe.is_ex_data())                /* tempo or SysEx only  */
                 {
+                    const event & er = pevs.ex_data(pe);
                     if (er.is_tempo())
-                    {
-                        perf()->set_beats_per_minute(er.tempo());
-                    }
+                        perf()->schedule_tempo(stamp - offset, er.tempo());
                     else
-                    {
-                        if (er.is_ex_data())
-                        {
-                            if (er.is_sysex())
-                                put_event_on_bus(er);   /* ca 2024-05-22    */
-                        }
-                        else
-                            put_event_on_bus(er);   /* frame still going    */
-                    }
+                        put_event_on_bus(er, stamp - offset); /* 2024-05-22 */
                 }
-            }
-            else if (stamp > end_tick_offset)
-                break;                              /* frame is done        */
-
-            ++e;                                    /* go to next event     */
-            if (e == m_events.end())                /* did we hit the end ? */
-            {
-                e = m_events.begin();               /* yes, start over      */
-                offset_base += len;              /* for another go at it */
-
-                /*
-                 * Putting this sleep here doesn't reduce the total CPU load,
-                 * but it does prevent one CPU from being hammered at 100%.
-                 * millisleep(1) made the live-grid progress bar jittery when
-                 * unmuting shorter patterns, which play() relentlessly.
-                 */
-
-                (void) microsleep(1);
+                else                                /* transposes notes     */
+                    put_event_on_bus(pe, stamp - offset, transpose, of.get());
             }
         }
+        m_play_cursor = std::size_t(e - evs.cbegin());
+        if (! pevs.lanes().empty())
+            play_mod_lanes(pevs.lanes(), start_tick, tick, len, of.get());
     }
     else
     {
@@ -1725,7 +2328,7 @@ sequence::play
     {
         set_armed(false);
     }
-    m_last_tick = tick + 1;                         /* for next frame       */
+    m_last_tick.store(tick + 1, std::memory_order_relaxed); /* next frame   */
 
     /*
      * This causes control-output spewage during playback, but we need to
@@ -1741,8 +2344,10 @@ sequence::play
 
 /**
  *  This function plays without supporting song-mode, triggers, transposing,
- *  resuming notes, loop count, meta events, and song recording.  It is
- *  meant to be used for a metronome pattern.
+ *  resuming notes, meta events, and song recording.  It is meant to be used
+ *  for a metronome pattern, and supports the loop count of the count-in.
+ *  The events of the frame are played by live_play_frame(), which the metro
+ *  class overrides to make the clicks without looking at the events.
  *
  *  Do we want to support tempo in a metronome pattern?
  *
@@ -1753,19 +2358,15 @@ sequence::play
 void
 sequence::live_play (midipulse tick)
 {
-    automutex locker(m_mutex);
-    midipulse start_tick = m_last_tick;     /* modified in triggers::play() */
-    midipulse end_tick = tick;              /* ditto                        */
-    if (m_song_mute)
+    writelock locker(m_mutex);
+    midipulse start_tick = last_tick();
+    if (get_song_mute())
         set_armed(false);
 
     if (armed())                            /* play notes in the frame      */
     {
         midipulse len = get_length() > 0 ? get_length() : m_ppqn ;
-        midipulse start_tick_offset = start_tick + len;
-        midipulse end_tick_offset = end_tick + len;
-        midipulse times_played = m_last_tick / len;
-        midipulse offset_base = times_played * len;
+        midipulse times_played = start_tick / len;
         if (loop_count_max() > 0)
         {
             if (times_played >= loop_count_max())
@@ -1776,35 +2377,318 @@ sequence::live_play (midipulse tick)
                 return;
             }
         }
+        live_play_frame(start_tick, tick);
+    }
+    m_last_tick.store(tick + 1, std::memory_order_relaxed); /* next frame   */
+}
 
-        auto e = m_events.begin();
-        while (e != m_events.end())
+/**
+ *  Plays the events of the pattern in the frame, for live_play(),
+ *  which holds the mutex.
+ *
+ * \param first
+ *      The first global tick of the frame.
+ *
+ * \param last
+ *      The last global tick of the frame, which is played.
+ */
+
+void
+sequence::live_play_frame (midipulse first, midipulse last)
+{
+    midipulse len = get_length() > 0 ? get_length() : m_ppqn ;
+    midipulse start_tick_offset = first + len;
+    midipulse end_tick_offset = last + len;
+    midipulse offset_base = (first / len) * len;
+    midipulse passes = end_tick_offset >= offset_base ?
+        (end_tick_offset - offset_base) / len + 1 : 0 ;
+
+    snapshot snap = current_snapshot();
+    filter of = std::atomic_load(&m_output_filter);
+    const playevents::buffer & evs = snap->events();
+    auto e = play_cursor(evs, start_tick_offset - offset_base);
+    for (midipulse pass = 0; pass < passes; ++pass, offset_base += len)
+    {
+        if (pass > 0)
+            e = evs.cbegin();                       /* next pattern repeat  */
+
+        for ( ; e != evs.cend(); ++e)
         {
-            event & er = eventlist::dref(e);
-            midipulse stamp = er.timestamp() + offset_base;
-            if (stamp >= start_tick_offset && stamp <= end_tick_offset)
+            const playevent & pe = *e;
+            midipulse stamp = pe.timestamp() + offset_base;
+            if (stamp > end_tick_offset)
+                break;                              /* frame is done        */
+
+            if (stamp < start_tick_offset)
+                continue;                           /* before the frame     */
+
+            if (pe.is_ex_data())                    /* tempo or SysEx       */
             {
+                const event & er = snap->ex_data(pe);
 #if defined SUPPORT_TEMPO_IN_LIVE_PLAY
                 if (er.is_tempo())
                 {
-                    perf()->set_beats_per_minute(er.tempo());
+                    perf()->schedule_tempo(stamp - len, er.tempo());
                 }
 #endif
-                put_event_on_bus(er);               /* frame still going    */
+                put_event_on_bus(er, stamp - len);
             }
-            else if (stamp > end_tick_offset)
-                break;                              /* frame is done        */
+            else
+                put_event_on_bus(pe, stamp - len, 0, of.get());
+        }
+    }
+    m_play_cursor = std::size_t(e - evs.cbegin());
+}
+
+/**
+ *  Plays one pass of the pattern, from its start, as a voice of the drum
+ *  pads (see padlauncher).  The voice has its own start, so the playing
+ *  state of the pattern (armed, last tick, play cursor) is not touched, and
+ *  the pattern plays whether it is armed or not.  Only the channel events
+ *  are played, with the transposition and the output filter; tempo and
+ *  SysEx are left to the pattern's normal playback.  Called only by the
+ *  thread that plays the frames.
+ *
+ * \param start
+ *      The global tick at which the voice started, or will start.
+ *
+ * \param first
+ *      The first tick of the frame not yet played by this voice.
+ *
+ * \param last
+ *      The last tick of the frame, which is played.
+ *
+ * \param velscale
+ *      If not 0, the velocity of the hit, which scales the Note Ons.
+ *
+ * \return
+ *      Returns true if the voice has more to play after this frame.
+ */
+
+bool
+sequence::play_voice
+(
+    midipulse start, midipulse first, midipulse last, midibyte velscale
+)
+{
+    midipulse len = get_length() > 0 ? get_length() : m_ppqn ;
+    midipulse end = start + len;                /* one past the last tick   */
+    if (first < start)
+        first = start;
+
+    midipulse stop = last < end ? last : end - 1 ;
+    if (first <= stop && ! get_song_mute())
+    {
+        snapshot snap = std::atomic_load(&m_play_snapshot);
+        if (! snap)
+        {
+            writelock locker(m_mutex);
+            snap = current_snapshot();
+        }
+
+        filter of = std::atomic_load(&m_output_filter);
+        int transpose = transposable() ? perf()->get_transpose() : 0 ;
+        const playevents::buffer & evs = snap->events();
+        auto e = std::lower_bound
+        (
+            evs.cbegin(), evs.cend(), first - start,
+            [] (const playevent & ev, midipulse t)
+            {
+                return ev.timestamp() < t;
+            }
+        );
+        for ( ; e != evs.cend(); ++e)
+        {
+            midipulse stamp = e->timestamp() + start;
+            if (stamp > stop)
+                break;
+
+            if (! e->is_ex_data())
+                put_event_on_bus(*e, stamp, transpose, of.get(), velscale);
+        }
+    }
+    return last + 1 < end;
+}
+
+/**
+ *  Sends the values of the modulation lanes at the steps falling in the
+ *  frame.  The steps are counted from the start of the pattern, as
+ *  displaced by a trigger offset, so that a lane lines up with the events.
+ *  A value is sent only if it differs from the last one the lane sent.
+ *
+ * \param lanes
+ *      The lanes, from the playback snapshot.
+ *
+ * \param first
+ *      The first tick of the frame, a global tick.
+ *
+ * \param last
+ *      The last tick of the frame.
+ *
+ * \param len
+ *      The length of the pattern, over which each lane repeats.
+ *
+ * \param of
+ *      The output filter of the frame, or null.
+ */
 
-            ++e;                                    /* go to next event     */
-            if (e == m_events.end())                /* did we hit the end ? */
+void
+sequence::play_mod_lanes
+(
+    const std::vector<modlane> & lanes,
+    midipulse first, midipulse last, midipulse len,
+    const outputfilter * of
+)
+{
+    std::size_t count = lanes.size();
+    if (count > m_mod_values.size())
+        count = m_mod_values.size();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const modlane & ml = lanes[i];
+        midipulse step = ml.step_length(int(m_ppqn));
+        midipulse r = (first - m_trigger_offset) % step;
+        if (r < 0)
+            r += step;
+
+        midipulse t = r == 0 ? first : first + step - r ;
+        for ( ; t <= last; t += step)
+        {
+            midipulse local = (t - m_trigger_offset) % len;
+            if (local < 0)
+                local += len;
+
+            int v = ml.value(local, len);
+            if (v != m_mod_values[i])
             {
-                e = m_events.begin();               /* yes, start over      */
-                offset_base += len;                 /* for another go at it */
-                (void) microsleep(1);
+                midibyte d0, d1;
+                ml.data(v, d0, d1);
+                put_event_on_bus(playevent(t, ml.status(), d0, d1), t, 0, of);
+                m_mod_values[i] = v;
             }
         }
     }
-    m_last_tick = end_tick + 1;                     /* for next frame       */
+}
+
+/**
+ *  Provides the event at which play() or live_play() starts the first pass
+ *  of a frame.  Events with a timestamp below the local start of the
+ *  frame are skipped by those functions anyway, so starting at the first
+ *  event with timestamp >= local is exactly equivalent to scanning from
+ *  m_events.begin().
+ *
+ *  The saved m_play_cursor is normally already at that position, since the
+ *  previous frame stopped just beyond its end tick.  We check that with two
+ *  timestamp comparisons. If an edit, a loop wrap, or a reposition has
+ *  made the cursor stale, a binary search finds the new position, and the
+ *  cost is O(log n) instead of O(n).
+ *
+ * \param evs
+ *      The events being played, from the playback snapshot.  The cursor is
+ *      validated against them, so a new snapshot is harmless.
+ *
+ * \param local
+ *      The start of the frame, in the pattern's timestamp units.
+ *
+ * \return
+ *      Returns an iterator to the first event to examine.
+ */
+
+playevents::buffer::const_iterator
+sequence::play_cursor (const playevents::buffer & evs, midipulse local)
+{
+    auto b = evs.cbegin();
+    std::size_t count = evs.size();
+    std::size_t c = m_play_cursor;
+    bool valid = c <= count;
+    if (valid && c > 0)
+        valid = (b + (c - 1))->timestamp() < local;
+
+    if (valid && c < count)
+        valid = (b + c)->timestamp() >= local;
+
+    if (! valid)
+    {
+        auto e = std::lower_bound
+        (
+            b, evs.cend(), local,
+            [] (const playevent & ev, midipulse t)
+            {
+                return ev.timestamp() < t;
+            }
+        );
+        c = std::size_t(e - b);
+        m_play_cursor = c;
+    }
+    return b + c;
+}
+
+/**
+ *  Calculates the earliest global tick after the given tick at which this
+ *  pattern would emit an event, or change its playing state, if play() were
+ *  called.  This is a hint for the deadline output scheduler in performer,
+ *  so that the output thread can sleep until exactly that time.
+ *
+ *  The play() function emits an event with timestamp ts when the global tick
+ *  t satisfies t = ts + m_trigger_offset (modulo the length).  The events are
+ *  sorted by timestamp, so we can do a binary search for the first event
+ *  beyond the local (pattern) position of the tick.  In Song mode the next
+ *  trigger boundary is also considered, and a queued or one-shot pattern also
+ *  considers its queued tick.
+ *
+ * \param tick
+ *      The current global tick, which has already been played.
+ *
+ * \param playbackmode
+ *      If true, Song mode is in force, and triggers are checked.
+ *
+ * \return
+ *      Returns the next tick of interest, or c_null_midipulse if this
+ *      pattern will produce nothing.
+ */
+
+midipulse
+sequence::next_event_tick (midipulse tick, bool playbackmode) const
+{
+    readlock locker(m_mutex);
+    midipulse result = c_null_midipulse;
+    auto earliest = [&result] (midipulse t)
+    {
+        if (! is_null_midipulse(t) && (is_null_midipulse(result) || t < result))
+            result = t;
+    };
+    if (playbackmode)
+        earliest(m_triggers.next_transition(tick));
+
+    if (get_queued() && get_queued_tick() > tick)
+        earliest(get_queued_tick());
+
+    if (one_shot() && one_shot_tick() > tick)
+        earliest(one_shot_tick());
+
+    if ((armed() || playbackmode) && ! m_events.empty())
+    {
+        midipulse len = get_length() > 0 ? get_length() : m_ppqn ;
+        midipulse local = (tick - m_trigger_offset) % len;
+        if (local < 0)
+            local += len;
+
+        midipulse base = tick - local;
+        auto e = std::upper_bound
+        (
+            m_events.cbegin(), m_events.cend(), local,
+            [] (midipulse t, const event & ev)
+            {
+                return t < ev.timestamp();
+            }
+        );
+        if (e == m_events.cend() || e->timestamp() >= len)
+            earliest(base + len + m_events.cbegin()->timestamp());
+        else
+            earliest(base + e->timestamp());
+    }
+    return result;
 }
 
 /**
@@ -1821,7 +2705,7 @@ sequence::live_play (midipulse tick)
 bool
 sequence::verify_and_link (bool wrap)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     midipulse len = expanded_recording() ? 0 : get_length() ;
     return m_events.verify_and_link(len, wrap);
 }
@@ -1835,7 +2719,7 @@ sequence::verify_and_link (bool wrap)
 bool
 sequence::edge_fix ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);                   /* push_undo(), no lock */
     bool result = m_events.edge_fix(snap(), get_length());
     if (result)
@@ -1851,7 +2735,7 @@ sequence::edge_fix ()
 bool
 sequence::remove_unlinked_notes ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);                   /* push_undo(), no lock */
     bool result = m_events.remove_unlinked_notes();
     if (result)
@@ -1884,11 +2768,9 @@ sequence::remove (event::buffer::iterator evi)
     if (evi != m_events.end())
     {
         event & er = eventlist::dref(evi);
-        if (er.is_note_off() && m_playing_notes[er.get_note()] > 0)
-        {
+        if (er.is_note_off() && m_playing_notes.off(er.get_note()))
             master_bus()->play_and_flush(m_true_bus, &er, midi_channel(er));
-            --m_playing_notes[er.get_note()];
-        }
+
         if (m_events.remove(evi))
             modify();
     }
@@ -1928,7 +2810,7 @@ sequence::remove (event & e)
 bool
 sequence::remove_first_match (const event & e, midipulse starttick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_events.remove_first_match(e, starttick);
 }
 
@@ -1939,7 +2821,7 @@ sequence::remove_first_match (const event & e, midipulse starttick)
 bool
 sequence::remove_all ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     int count = m_events.count();
     if (count > 0)
@@ -1961,7 +2843,7 @@ sequence::remove_all ()
 bool
 sequence::remove_orphaned_events ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = m_events.remove_trailing_events(get_length());
     if (result)
     {
@@ -1985,7 +2867,7 @@ sequence::remove_orphaned_events ()
 bool
 sequence::remove_marked ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     for (auto & e : m_events)
     {
         if (e.is_marked() && e.is_note_on())
@@ -2011,7 +2893,7 @@ sequence::remove_marked ()
 bool
 sequence::mark_selected ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_events.mark_selected();
 }
 
@@ -2027,7 +2909,7 @@ sequence::mark_selected ()
 bool
 sequence::remove_selected ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);               /* push_undo() without lock */
 
     bool result = m_events.remove_selected();
@@ -2046,7 +2928,7 @@ sequence::remove_selected ()
 void
 sequence::unpaint_all ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events.unpaint_all();
 }
 
@@ -2080,7 +2962,7 @@ sequence::selected_box
     midipulse & tick_f, int & note_l
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     tick_s = m_maxbeats * m_ppqn;       /* the largest tick/pulse we allow  */
     tick_f = 0;                         /* the smallest tick possible       */
     note_l = c_midibyte_data_max;       /* the largest note value possible  */
@@ -2144,7 +3026,7 @@ sequence::onsets_selected_box
     midipulse & tick_f, int & note_l
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     tick_s = m_maxbeats * m_ppqn;
     tick_f = note_h = 0;
@@ -2207,21 +3089,23 @@ sequence::clipboard_box
     midipulse & tick_f, int & note_l
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
+    std::shared_ptr<const eventlist> clipbd = sm_clipboard;
     bool result = false;
     tick_s = m_maxbeats * m_ppqn;
     tick_f = 0;
     note_h = 0;
     note_l = c_midibyte_data_max;
-    if (sm_clipboard.empty())
+    if (! clipbd || clipbd->empty())
     {
         tick_s = tick_f = note_h = note_l = 0;
     }
     else
     {
         result = true;                  /* FIXME */
-        for (auto & e : sm_clipboard)
+        for (auto cev = clipbd->cbegin(); cev != clipbd->cend(); ++cev)
         {
+            const event & e = *cev;
             midipulse time = e.timestamp();
             int note = e.get_note();
             if (time < tick_s)
@@ -2252,7 +3136,7 @@ sequence::clipboard_box
 int
 sequence::get_num_selected_notes () const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_events.count_selected_notes();
 }
 
@@ -2276,7 +3160,7 @@ sequence::get_num_selected_notes () const
 int
 sequence::get_num_selected_events (midibyte status, midibyte cc) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_events.count_selected_events(status, cc);
 }
 
@@ -2321,7 +3205,8 @@ sequence::select_note_events
     midipulse tick_f, int note_l, eventlist::select action
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
+    selection_changed();
 #if defined USE_TEST_CODE
     if (expanded_recording())           // for painting notes; TEST CODE ONLY
         return 0;                       // assume no note can be selected
@@ -2366,7 +3251,8 @@ sequence::select_events
     midibyte status, midibyte cc, eventlist::select action
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
+    selection_changed();
     return m_events.select_events(tick_s, tick_f, status, cc, action);
 }
 
@@ -2397,7 +3283,7 @@ sequence::select_events
 int
 sequence::select_events (midibyte status, midibyte cc, bool inverse)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     midibyte d0, d1;
     for (auto & er : m_events)
     {
@@ -2422,6 +3308,7 @@ sequence::select_events (midibyte status, midibyte cc, bool inverse)
                 er.select();
         }
     }
+    selection_changed();
     return 0;
 }
 
@@ -2432,7 +3319,7 @@ sequence::select_event_handle
     midibyte astatus, midibyte cc, midibyte data
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     int result = m_events.select_event_handle
     (
         tick_s, tick_f, astatus, cc, data
@@ -2450,8 +3337,9 @@ sequence::select_event_handle
 void
 sequence::select_all ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events.select_all();
+    selection_changed();
 }
 
 void
@@ -2459,8 +3347,9 @@ sequence::select_by_channel (int channel)
 {
     if (is_good_channel(midibyte(channel)))
     {
-        automutex locker(m_mutex);
+        writelock locker(m_mutex);
         m_events.select_by_channel(channel);
+        selection_changed();
     }
 }
 
@@ -2469,8 +3358,9 @@ sequence::select_notes_by_channel (int channel)
 {
     if (is_good_channel(midibyte(channel)))
     {
-        automutex locker(m_mutex);
+        writelock locker(m_mutex);
         m_events.select_notes_by_channel(channel);
+        selection_changed();
     }
 }
 
@@ -2483,8 +3373,9 @@ sequence::select_notes_by_channel (int channel)
 void
 sequence::unselect ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events.unselect_all();
+    selection_changed();
 }
 
 /**
@@ -2534,7 +3425,7 @@ sequence::unselect ()
 bool
 sequence::move_selected_notes (midipulse delta_tick, int delta_note)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);                  /* push_undo(), no lock */
     bool result = m_events.move_selected_notes(delta_tick, delta_note);
     if (result)
@@ -2546,7 +3437,7 @@ sequence::move_selected_notes (midipulse delta_tick, int delta_note)
 bool
 sequence::move_selected_events (midipulse delta_tick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);                  /* push_undo(), no lock */
     bool result = m_events.move_selected_events(delta_tick);
     if (result)
@@ -2569,7 +3460,7 @@ sequence::move_selected_events (midipulse delta_tick)
 bool
 sequence::stretch_selected (midipulse delta_tick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);           /* push_undo(), no lock  */
     bool result = m_events.stretch_selected(delta_tick);
     if (result)
@@ -2622,7 +3513,7 @@ sequence::stretch_selected (midipulse delta_tick)
 bool
 sequence::grow_selected (midipulse delta)
 {
-    automutex locker(m_mutex);                  /* lock it again, dude  */
+    writelock locker(m_mutex);                  /* lock it again, dude  */
     m_events_undo.push(m_events);               /* push_undo(), no lock */
 
     bool result = m_events.grow_selected(delta, snap());
@@ -2650,7 +3541,7 @@ sequence::grow_selected (midipulse delta)
 bool
 sequence::randomize (midibyte status, int range, bool all)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);               /* push_undo(), no lock  */
     if (range == (-1))
         range = usr().randomization_amount();
@@ -2665,7 +3556,7 @@ sequence::randomize (midibyte status, int range, bool all)
 bool
 sequence::randomize_notes (int range, bool all)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);               /* push_undo(), no lock  */
     if (range == (-1))
         range = usr().randomization_amount();
@@ -2696,7 +3587,7 @@ sequence::randomize_notes (int range, bool all)
 bool
 sequence::jitter_notes (int jitr, bool all)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = m_events.jitter_notes(snap(), jitr, all);
     if (result)
         modify();
@@ -2725,7 +3616,7 @@ sequence::adjust_event_handle (midibyte astatus, midibyte adata)
     midibyte data[2];
     midibyte datitem;
     int dataindex = event::is_two_byte_msg(astatus) ? 1 : 0 ;
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     for (auto & er : m_events)
     {
         if (er.is_selected_status(astatus))
@@ -2782,7 +3673,7 @@ sequence::adjust_event_handle (midibyte astatus, midibyte adata)
 void
 sequence::increment_selected (midibyte astat, midibyte /*acontrol*/)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool modded = false;
     for (auto & e : m_events)
     {
@@ -2830,7 +3721,7 @@ sequence::increment_selected (midibyte astat, midibyte /*acontrol*/)
 void
 sequence::decrement_selected (midibyte astat, midibyte /*acontrol*/)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool modded = false;
     for (auto & e : m_events)
     {
@@ -2859,16 +3750,23 @@ sequence::decrement_selected (midibyte astat, midibyte /*acontrol*/)
 bool
 sequence::repitch (const notemapper & nmap, bool all)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
+    std::size_t count = std::size_t(m_events.count());
+    std::size_t done = 0;
     push_undo();
     for (auto & e : m_events)
     {
+        if (! editjob::checkpoint(++done, count))
+            break;
+
         if (e.is_note() && (all || e.is_selected()))
         {
             midibyte pitch, velocity;                           /* d0 & d1  */
             e.get_data(pitch, velocity);
-            pitch = midibyte(nmap.convert(int(pitch)));
+            if (pitch < c_notes_count)
+                pitch = nmap.fast_convert(pitch);
+
             e.set_data(pitch, velocity);
             result = true;
         }
@@ -2881,6 +3779,106 @@ sequence::repitch (const notemapper & nmap, bool all)
     return result;
 }
 
+/**
+ *  Turns the remapping of notes at output time on or off, by adding or
+ *  removing the notemap stage of the output filter.  The other stages are
+ *  kept.
+ *
+ * \param nmap
+ *      The note-mapper whose table is copied.  If null, or not loaded from
+ *      a note-map file, the remapping is turned off.
+ */
+
+void
+sequence::live_notemap (const notemapper * nmap)
+{
+    writelock locker(m_mutex);
+    outputfilter of;
+    if (m_output_filter)
+        of = *m_output_filter;
+
+    midibytes table;
+    if (not_nullptr(nmap) && nmap->mode())
+    {
+        table.reserve(std::size_t(c_notes_count));
+        for (int n = 0; n < c_notes_count; ++n)
+            table.push_back(nmap->fast_convert(midibyte(n)));
+    }
+    of.note_table(table);
+    set_output_filter(of);
+}
+
+bool
+sequence::live_notemap () const
+{
+    filter of = std::atomic_load(&m_output_filter);
+    return of && of->has(outputfilter::stage::notemap);
+}
+
+/**
+ *  Replaces the text stages of the output filter, such as "transpose:-12
+ *  velocity:80".  Any notemap stage is kept, at the end.
+ *
+ * \param spec
+ *      The stages.  An empty string removes them.
+ *
+ * \param user_change
+ *      If true, the pattern is marked as modified, since the stages are
+ *      saved with it.
+ *
+ * \return
+ *      Returns false if the stages were not valid, in which case the filter
+ *      is left as it was.
+ */
+
+bool
+sequence::output_filter (const std::string & spec, bool user_change)
+{
+    writelock locker(m_mutex);
+    outputfilter of;
+    bool result = of.parse(spec);
+    if (result)
+    {
+        if (m_output_filter)
+            of.note_table(m_output_filter->note_table());
+
+        set_output_filter(of);
+        if (user_change)
+            modify();
+    }
+    return result;
+}
+
+/**
+ *  Gets the text stages of the output filter, for saving or display.
+ */
+
+std::string
+sequence::output_filter () const
+{
+    filter of = std::atomic_load(&m_output_filter);
+    return of ? of->to_string() : std::string("") ;
+}
+
+/**
+ *  Publishes a new output filter.  The notes sounding are turned off first,
+ *  since their Note Offs would otherwise be altered differently from their
+ *  Note Ons.
+ *
+ *  Must be called with the mutex held.
+ */
+
+void
+sequence::set_output_filter (const outputfilter & of)
+{
+    off_playing_notes();
+    filter f;
+    if (! of.empty())
+        f = std::make_shared<const outputfilter>(of);
+
+    std::atomic_store(&m_output_filter, f);
+}
+
 /**
  *  Copies the selected events.  This function also has the danger, discovered
  *  by user 0rel, of events being modified after being added to the clipboard.
@@ -2910,11 +3908,11 @@ sequence::repitch (const notemapper & nmap, bool all)
 bool
 sequence::copy_selected ()
 {
-    automutex locker(m_mutex);
-    eventlist clipbd;
-    bool result = m_events.copy_selected(clipbd);
+    writelock locker(m_mutex);
+    std::shared_ptr<eventlist> clipbd = std::make_shared<eventlist>();
+    bool result = m_events.copy_selected(*clipbd);
     if (result)
-        sm_clipboard = clipbd;
+        sm_clipboard = clipbd;                  /* no copy of the events    */
 
     return result;
 }
@@ -3000,12 +3998,16 @@ sequence::cut_selected (bool copyevents)
 bool
 sequence::paste_selected (midipulse tick, int note)
 {
-    automutex locker(m_mutex);
-    eventlist clipbd = sm_clipboard;            /* copy the clipboard   */
-    push_undo();                                /* push undo, no lock   */
-    bool result = m_events.paste_selected(clipbd, tick, note);
+    writelock locker(m_mutex);
+    std::shared_ptr<const eventlist> clipbd = sm_clipboard; /* a reference  */
+    bool result = bool(clipbd) && ! clipbd->empty();
     if (result)
-        modify();
+    {
+        push_undo();                            /* push undo, no lock   */
+        result = m_events.paste_selected(*clipbd, tick, note);
+        if (result)
+            modify();
+    }
 
     return result;
 }
@@ -3023,7 +4025,7 @@ sequence::merge_events (const sequence & source)
     int bw = source.get_beat_width();
     int bpb = source.get_beats_per_bar();
     midipulse len = source.get_length();
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     set_beat_width(bw);
     set_beats_per_bar(bpb);
 
@@ -3101,7 +4103,7 @@ sequence::change_event_data_range
     int data_s, int data_f, bool finalize
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     bool haveselection = any_selected_events(status, cc);
     for (auto & er : m_events)
@@ -3187,7 +4189,7 @@ sequence::change_event_data_relative
     int newval, bool finalize
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     bool haveselection = any_selected_events(status, cc);
     for (auto & er : m_events)
@@ -3275,17 +4277,22 @@ sequence::change_event_data_relative
  * \param usemeasure
  *      If true, then use a measure as the length for wave periodicity, rather
  *      than the full length of the sequence.
+ *
+ * \param pushundo
+ *      If true (the default), the events are pushed onto the undo stack
+ *      first, and the change is announced.  The LFO window does this for
+ *      its first change only; the later slider moves are a preview that
+ *      one undo reverts, and that the window announces when closed.
  */
 
 void
 sequence::change_event_data_lfo
 (
     double dcoffset, double range, double speed, double phase,
-    waveform w, midibyte status, midibyte cc, bool usemeasure
+    waveform w, midibyte status, midibyte cc, bool usemeasure, bool pushundo
 )
 {
-    automutex locker(m_mutex);
-    bool modified = false;
+    writelock locker(m_mutex);
     double dlength = double(get_length());
     bool noselection = ! any_selected_events(status, cc);
     if (get_length() == 0)                  /* should never happen, though  */
@@ -3294,41 +4301,58 @@ sequence::change_event_data_lfo
     if (usemeasure)
         dlength = double(measures_to_ticks());
 
-    m_events_undo.push(m_events);           /* experimental, seems to work  */
+    std::vector<event *> targets;
     for (auto & er : m_events)
     {
-        bool match = false;
         if (noselection || er.is_selected())
-            match = er.is_desired_ex(status, cc);
+        {
+            if (er.is_desired_ex(status, cc))
+                targets.push_back(&er);
+        }
+    }
+    if (targets.empty())
+        return;
 
-        if (match)
+    if (pushundo)
+        m_events_undo.push(m_events);
+
+    /*
+     * The angle of each event, then all the wave values in one batch.
+     */
+
+    std::size_t count = targets.size();
+    std::vector<double> values(count);
+    double increment = speed / dlength;
+    for (std::size_t i = 0; i < count; ++i)
+        values[i] = increment * double(targets[i]->timestamp()) + phase;
+
+    wave_values(values.data(), count, w);
+
+    bool onebyte = event::is_one_byte_msg(status);
+    bool twobyte = event::is_two_byte_msg(status);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        event & er = *targets[i];
+        int newdata = int(range * values[i] + dcoffset);
+        newdata = int(abs_midibyte_value(newdata));     /* keep at 0 to 127 */
+        if (er.is_tempo())
+        {
+            midibpm tempo = note_value_to_tempo(midibyte(newdata));
+            (void) er.set_tempo(tempo);
+        }
+        else
         {
-            double dtick = double(er.timestamp());
-            double angle = speed * dtick / dlength + phase;
-            double value = wave_func(angle, w);
-            int newdata = int(range * value + dcoffset);
-            newdata = int(abs_midibyte_value(newdata)); /* keep at 0 to 127 */
-            if (er.is_tempo())
-            {
-                midibpm tempo = note_value_to_tempo(midibyte(newdata));
-                (void) er.set_tempo(tempo);
-            }
-            else
-            {
-                midibyte d0, d1;
-                er.get_data(d0, d1);
-                if (event::is_one_byte_msg(status))
-                    d0 = midibyte(newdata);
-                else if (event::is_two_byte_msg(status))
-                    d1 = midibyte(newdata);
+            midibyte d0, d1;
+            er.get_data(d0, d1);
+            if (onebyte)
+                d0 = midibyte(newdata);
+            else if (twobyte)
+                d1 = midibyte(newdata);
 
-                er.set_data(d0, d1);
-            }
-            modified = true;
+            er.set_data(d0, d1);
         }
     }
-    if (modified)
-        modify();
+    modify(pushundo);
 }
 
 /**
@@ -3427,7 +4451,7 @@ sequence::trunc_measures (double measures)
 bool
 sequence::fix_pattern (fixparameters & fp)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     double newmeasures = fp.fp_measures;
     double newscalefactor = fp.fp_scale_factor;
     bool result = valid_scale_factor(newscalefactor) &&
@@ -3696,7 +4720,7 @@ sequence::add_painted_note
     bool ignore = false;
     if (repaint)                                    /* see banner above     */
     {
-        automutex locker(m_mutex);
+        writelock locker(m_mutex);
         ignore = remove_duplicate_events(tick, note);
     }
     if (ignore)
@@ -3711,20 +4735,21 @@ sequence::add_painted_note
         if (repaint)
             e.paint();
 
-        result = add_event(e);
-        if (result)
+        midibyte voff = hardwire ? midibyte(m_note_off_velocity) : 0 ;
+        event eoff(tick + len, EVENT_NOTE_OFF, midi_channel(), note, voff);
+        bool inplace;
+        if (insert_note(e, eoff, inplace))
         {
-            midibyte v = hardwire ? midibyte(m_note_off_velocity) : 0 ;
-            event e(tick + len, EVENT_NOTE_OFF, midi_channel(), note, v);
-            result = add_event(e);
+            if (inplace)
+                modify(note_region(e, eoff));   /* no easy way to undo this */
+            else
+                modify();
         }
-        if (result && expanded_recording())
+
+        if (expanded_recording())
             set_last_tick(tick + len);
-    }
-    if (result)
-    {
-        if (verify_and_link())
-            modify();                           /* no easy way to undo this */
+
+        result = true;
     }
     return result;
 }
@@ -3747,17 +4772,11 @@ sequence::add_painted_note
 bool
 sequence::add_note (midipulse len, const event & e)
 {
-    bool result = add_event(e);
-    if (result)
-    {
-        midipulse tick = e.timestamp() + len;
-        midibyte v = midibyte(m_note_off_velocity);
-        event eoff(tick, EVENT_NOTE_OFF, e.channel(), e.get_note(), v);
-        result = add_event(eoff);
-    }
-    if (result)
-        result = verify_and_link();
-
+    midipulse tick = e.timestamp() + len;
+    midibyte v = midibyte(m_note_off_velocity);
+    event eoff(tick, EVENT_NOTE_OFF, e.channel(), e.get_note(), v);
+    bool inplace;
+    bool result = insert_note(e, eoff, inplace);
     if (result)
     {
         /*
@@ -3772,8 +4791,11 @@ sequence::add_note (midipulse len, const event & e)
          *      modify(false);
          */
 
-        m_is_modified = true;
-        set_dirty();
+        if (inplace)
+            modify(note_region(e, eoff), false);    /* publish, set dirty   */
+        else
+            modify(false);
+
         perf()->notify_sequence_change(seq_number(), performer::change::no);
     }
     return result;
@@ -3871,7 +4893,7 @@ sequence::add_chord
 bool
 sequence::add_tempo (midipulse tick, midibpm tempo, bool repaint)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool valid = tempo >= usr().midi_bpm_minimum() &&
         tempo <= usr().midi_bpm_maximum();
 
@@ -3899,6 +4921,25 @@ sequence::add_tempo (midipulse tick, midibpm tempo, bool repaint)
     return result;
 }
 
+/**
+ *  Adds the tempo events of this pattern to a tempo map, at their own time
+ *  stamps.  Used by the performer for the tempo track.
+ *
+ * \param tm
+ *      The map to add to.  The caller builds it afterward.
+ */
+
+void
+sequence::fill_tempo_map (tempomap & tm) const
+{
+    readlock locker(m_mutex);
+    for (auto e = m_events.cbegin(); e != m_events.cend(); ++e)
+    {
+        if (e->is_tempo())
+            tm.add(e->timestamp(), e->tempo());
+    }
+}
+
 /**
  *  Use for adding Tempo events via a drag-line in qseqdata. The events are
  *  added at each snap point in the tick range. Currently only a linear
@@ -3937,7 +4978,7 @@ sequence::add_tempos
     int data_s, int data_f
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     midipulse S = snap();
     midibpm B0 = note_value_to_tempo(midibyte(data_s));
@@ -3969,7 +5010,7 @@ sequence::add_tempos
 bool
 sequence::log_time_signature (midipulse tick, int beats, int bw)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = beats > 0 && is_power_of_2(bw);
     if (result)
     {
@@ -4022,7 +5063,7 @@ sequence::log_time_signature (midipulse tick, int beats, int bw)
 bool
 sequence::add_timesig_event (const event & e, bool main_ts)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = e.is_time_signature();
     if (result)
     {
@@ -4046,7 +5087,7 @@ sequence::add_timesig_event (const event & e, bool main_ts)
 bool
 sequence::add_c_timesig (int bpb, int bw, bool main_ts)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (main_ts)
     {
         set_beats_per_bar(bpb);
@@ -4146,7 +5187,9 @@ sequence::detect_time_signature
  *
  *  To speed things up a bit, do not try to verify and link notes unless the
  *  incoming event is a note.  We will first try allowing it only for a Note
- *  Off for even more savings :-D
+ *  Off for even more savings :-D  Better yet, a Note Off that sorts to the end
+ *  is linked by itself via eventlist::append_linked(), skipping the full
+ *  relink.
  *
  *  Also, instead of modifying and notifying, we just modify. We need to see
  *  if this prevents a weird unknown-signal error in qseqeditframe64 in the
@@ -4173,15 +5216,42 @@ sequence::detect_time_signature
 bool
 sequence::add_event (const event & er)
 {
-    automutex locker(m_mutex);
-    bool result = m_events.append(er);  /* no-sort insertion of event       */
+    event e(er);                        /* the one copy made               */
+    return add_event(std::move(e));
+}
+
+/**
+ *  The same as add_event(const event &), but the event is moved into the
+ *  events container.  What is needed from the event is gotten before the
+ *  move.
+ */
+
+bool
+sequence::add_event (event && er)
+{
+    writelock locker(m_mutex);
+    midipulse len = expanded_recording() ? 0 : get_length() ;
+    bool noteoff = er.is_note_off();
+    region r = event_region(er);
+    bool relinked = false;
+    bool result = m_events.append_linked(std::move(er), len);
+    if (! result)                       /* er is untouched, still usable    */
+    {
+        result = m_events.append(std::move(er));    /* no-sort insertion    */
+        if (result && noteoff)
+        {
+            (void) verify_and_link();   /* for proper seqroll draw; sorts   */
+            relinked = true;
+        }
+    }
     if (result)
     {
-        if (er.is_note_off())
-            (void) verify_and_link();   /* for proper seqroll draw; sorts   */
-
-        modify(false);                  /* do not call notify_change()      */
+        if (relinked)
+            modify(false);              /* do not call notify_change()      */
+        else
+            modify(r, false);
     }
+
     return result;
 }
 
@@ -4203,21 +5273,56 @@ sequence::add_event (const event & er)
 bool
 sequence::append_event (const event & er)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_events.append(er);     /* does *not* sort, too time-consuming  */
 }
 
+/**
+ *  The same as append_event(const event &), but the event, usually a
+ *  temporary built while parsing, is moved into the events container.
+ */
+
+bool
+sequence::append_event (event && er)
+{
+    writelock locker(m_mutex);
+    return m_events.append(std::move(er));      /* does *not* sort either   */
+}
+
+/**
+ *  Makes room for the given number of events, ahead of a run of
+ *  append_event() calls.
+ */
+
+void
+sequence::reserve_events (std::size_t n)
+{
+    writelock locker(m_mutex);
+    m_events.reserve(n);
+}
+
+/**
+ *  Frees the event storage reserved by reserve_events() but not used.
+ */
+
+void
+sequence::trim_events ()
+{
+    writelock locker(m_mutex);
+    m_events.shrink_to_fit();
+}
+
 void
 sequence::sort_events ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events.sort();
 }
 
 event
 sequence::find_event (const event & e, bool nextmatch)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     static event s_null_result{0, 0, 0};
     event::iterator evi = nextmatch ?
         m_events.find_next_match(e) : m_events.find_first_match(e) ;
@@ -4251,7 +5356,7 @@ sequence::find_note (midipulse tick, int note)
 bool
 sequence::remove_duplicate_events (midipulse tick, int note)
 {
-    automutex locker(m_mutex);                  /* ca 2023-04-29    */
+    writelock locker(m_mutex);                  /* ca 2023-04-29    */
     bool ignore = false;
     for (auto & er : m_events)
     {
@@ -4264,7 +5369,7 @@ sequence::remove_duplicate_events (midipulse tick, int note)
             }
             er.mark();
             if (er.is_linked())
-                er.link()->mark();
+                m_events.linked(er)->mark();
 
             set_dirty();
         }
@@ -4308,7 +5413,7 @@ sequence::add_event
     midibyte d0, midibyte d1, bool repaint
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = tick >= 0;
     if (result)
     {
@@ -4319,7 +5424,7 @@ sequence::add_event
         if (repaint)
             e.paint();
 
-        result = m_events.append(e);    /* (add_event(e) locks & verifies)  */
+        result = m_events.append(std::move(e)); /* add_event() would lock   */
         if (result)
         {
             (void) verify_and_link();   /* might be no note events to link  */
@@ -4329,6 +5434,190 @@ sequence::add_event
     return result;
 }
 
+/**
+ *  Checks an event recorded during playback against those already recorded
+ *  in this session.  An event with the same timestamp, status, and first
+ *  data byte as one already recorded is a duplicate.  A duplicate Note On
+ *  also causes the next Note Off of the note to be dropped, so that it
+ *  does not leave an unlinked Note Off behind.  The caller must hold the
+ *  mutex.
+ *
+ * \param ev
+ *      The event, already adjusted for the pattern length and quantized,
+ *      if called for.
+ *
+ * \return
+ *      Returns true if the event is to be dropped.
+ */
+
+bool
+sequence::recorded_duplicate (const event & ev)
+{
+    bool result = false;
+    if (ev.is_note_off())
+    {
+        std::size_t n = std::size_t(ev.get_note());
+        if (n < m_dropped_note_ons.size() && m_dropped_note_ons[n] > 0)
+        {
+            --m_dropped_note_ons[n];
+            result = true;
+        }
+    }
+    else
+    {
+        std::uint64_t key = (std::uint64_t(ev.timestamp()) << 16) |
+            (std::uint64_t(ev.get_status()) << 8) | std::uint64_t(ev.d0());
+
+        result = ! m_recorded_keys.insert(key).second;
+        if (result && ev.is_note_on())
+        {
+            if (m_dropped_note_ons.empty())
+                m_dropped_note_ons.assign(std::size_t(c_notes_count), 0);
+
+            std::size_t n = std::size_t(ev.get_note());
+            if (n < m_dropped_note_ons.size())
+                ++m_dropped_note_ons[n];
+        }
+    }
+    return result;
+}
+
+void
+sequence::clear_recorded_keys ()
+{
+    m_recorded_keys.clear();
+    m_dropped_note_ons.clear();
+}
+
+/**
+ *  Makes room in the event list, when recording starts, for a take of the
+ *  expected density over the length of the pattern (twice that, if the
+ *  pattern expands as it is recorded), or for as many events again as are
+ *  already there, whichever is more.  The vector then does not reallocate,
+ *  and copy every event, in the middle of the take.  The note links are
+ *  indexes, so a reallocation would not need a relink anyway.
+ */
+
+void
+sequence::reserve_for_recording ()
+{
+    std::size_t beats = std::size_t(get_length() / midipulse(m_ppqn)) + 1;
+    if (expanded_recording())
+        beats *= 2;
+
+    std::size_t expected = beats * c_record_events_per_beat;
+    std::size_t current = std::size_t(m_events.count());
+    if (expected < current)
+        expected = current;
+
+    if (expected > c_record_reserve_max)
+        expected = c_record_reserve_max;
+
+    if (m_events.capacity() < current + expected)
+        m_events.reserve(current + expected);
+}
+
+/**
+ *  Adds an event recorded during a merge-style (overdub) pass to the take,
+ *  if the take is in use or the event would sort before the last event of
+ *  the pattern.  Otherwise the event is left for add_event(), which links a
+ *  Note Off at the end of the pattern by itself.  An event for a new pass
+ *  first merges the take of the previous one.
+ *
+ * \threadunsafe
+ *      The caller locks.
+ *
+ * \param ev
+ *      The recorded event, its timestamp already wrapped to the length.
+ *
+ * \return
+ *      Returns true if the event went into the take.
+ */
+
+bool
+sequence::take_event (const event & ev)
+{
+    midipulse len = get_length();
+    bool result = m_recording_style == recordstyle::merge && len > 0;
+    if (result)
+    {
+        midipulse pass = perf()->get_tick() / len;
+        if (! m_take.empty() && pass != m_take_pass)
+            (void) merge_take();
+
+        result = ! m_take.empty() ||
+            (! m_events.empty() && ev < *(m_events.cend() - 1));
+
+        if (result)
+        {
+            m_take_pass = pass;
+            m_take.push_back(ev);
+        }
+    }
+    return result;
+}
+
+/**
+ *  Merges the take into the pattern, with a linear merge when both are
+ *  sorted, as they nearly always are, and links the notes once.
+ *
+ * \threadunsafe
+ *      The caller locks.
+ *
+ * \return
+ *      Returns true if there was a take to merge.
+ */
+
+bool
+sequence::merge_take ()
+{
+    bool result = ! m_take.empty();
+    if (result)
+    {
+        m_events.merge(m_take);
+        m_take.clear();
+        (void) verify_and_link();
+        modify(false);                  /* do not call notify_change()      */
+    }
+    return result;
+}
+
+/**
+ *  Adds an entered note.  Normally the note is inserted in place and
+ *  linked by itself, rather than appended and followed by a sort and full
+ *  relink of the pattern.  If it cannot be, as when it overlaps another
+ *  note of the same pitch, the events are appended and relinked.
+ *
+ * \param eon
+ *      The Note On of the note.
+ *
+ * \param eoff
+ *      The Note Off of the note.
+ *
+ * \param [out] inplace
+ *      Set to true if only the note itself changed, so that the caller can
+ *      dirty only its region.
+ *
+ * \return
+ *      Returns true if the note was linked.
+ */
+
+bool
+sequence::insert_note (const event & eon, const event & eoff, bool & inplace)
+{
+    writelock locker(m_mutex);
+    midipulse len = expanded_recording() ? 0 : get_length() ;
+    bool result = m_events.insert_note(eon, eoff, len);
+    inplace = result;
+    if (! result)
+    {
+        (void) m_events.append(eon);
+        (void) m_events.append(eoff);
+        result = m_events.verify_and_link(len);
+    }
+    return result;
+}
+
 /**
  *  Handles loop/replace status on behalf of seqrolls.  This sets the
  *  loop-reset status, which is checked in the stream_event() function in
@@ -4336,6 +5625,10 @@ sequence::add_event
  *  set when the time-stamp remainder is less than a quarter note,
  *  meaning we have just gotten back to the beginning of the loop.
  *  See the call in qseqeditframe64.
+ *
+ *  Also merges the take of an overdub pass once the playback has gone past
+ *  it, so that the editor shows the notes without waiting for the next one
+ *  to come in.
  */
 
 bool
@@ -4344,6 +5637,12 @@ sequence::check_loop_reset ()
     bool result = false;
     midipulse ts = perf()->get_tick();
     midipulse len = get_length();
+    if (recording() && m_recording_style == recordstyle::merge && len > 0)
+    {
+        writelock locker(m_mutex);
+        if (! m_take.empty() && ts / len != m_take_pass)
+            result = merge_take();
+    }
     if (len > 0 && ts > len)
     {
         midipulse tsmod = ts % len;
@@ -4454,16 +5753,18 @@ sequence::check_oneshot_recording ()
 bool
 sequence::stream_event (event & ev)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = channels_match(ev);           /* set if channel matches   */
     if (result)
     {
+        bool linked = false;                    /* add_event() linked it    */
         if (loop_reset())
         {
             if (overwriting())
             {
                 loop_reset(false);
                 remove_all();                   /* vs m_events.clear()      */
+                clear_recorded_keys();          /* nothing left to match    */
                 set_dirty();
             }
             else if (oneshot_recording())       /* is this necessary???     */
@@ -4527,7 +5828,13 @@ sequence::stream_event (event & ev)
 
                 modify(false);                          /* no notify call   */
 #else
-                add_event(ev);                          /* locks and sorts  */
+                if (! recorded_duplicate(ev))           /* still sent thru  */
+                {
+                    if (! take_event(ev))               /* overdub pass?    */
+                        add_event(ev);                  /* locks and links  */
+                }
+
+                linked = true;                          /* or not needed    */
 #endif
             }
             else                                        /* use auto-step    */
@@ -4582,13 +5889,16 @@ sequence::stream_event (event & ev)
                 }
                 else
                 {
-                    if (rc().verbose())
+                    if (hot().verbose())
                         ev.print();
                 }
             }
         }
-        if (m_thru)
-            put_event_on_bus(ev);
+        if (m_thru && ! hot().thru_routed(int(ev.input_bus())))
+        {
+            put_event_on_bus(ev);       /* not if already sent by the route */
+            master_bus()->flush();                  /* not in play() frame  */
+        }
 
         /*
          * We don't need to link note events until a note-off comes in.
@@ -4598,9 +5908,12 @@ sequence::stream_event (event & ev)
          * ca 2024-12-27 Shouldn't this be verify_and_link()???
          *
          *      (void) m_events.link_new();
+         *
+         * A recorded Note Off has already been linked by add_event(), and
+         * if not recording, nothing was added that needs linking.
          */
 
-        if (ev.is_note_off())
+        if (ev.is_note_off() && recording() && ! linked)
             (void) m_events.verify_and_link();
     }
     return result;
@@ -4622,18 +5935,157 @@ void
 sequence::set_dirty_mp ()
 {
     m_dirty_names = m_dirty_main = m_dirty_perf = true;
+    add_region(nullptr);                /* the whole pattern may change     */
+    sm_change_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ *  Call set_dirty_mp() and then sets the dirty flag for editing. Note that it
+ *  does not call performer::modify().
+ */
+
+void
+sequence::set_dirty ()
+{
+    set_dirty_mp();
+    m_dirty_edit = true;
+}
+
+/**
+ *  Like set_dirty(), but records the part of the pattern that changed, so
+ *  that the views can repaint only that part.
+ *
+ * \param r
+ *      The ticks and notes changed.  The generation is filled in here.
+ */
+
+void
+sequence::set_dirty (const region & r)
+{
+    m_dirty_names = m_dirty_main = m_dirty_perf = true;
+    add_region(&r);
+    sm_change_generation.fetch_add(1, std::memory_order_relaxed);
+    m_dirty_edit = true;
+}
+
+/**
+ *  Bumps the redraw generation, and records the region changed under the
+ *  new generation.  With no region, the whole pattern is deemed changed.
+ *
+ * \param r
+ *      The region, or a null pointer.
+ */
+
+void
+sequence::add_region (const region * r)
+{
+    unsigned g = m_redraw_generation.fetch_add(1, std::memory_order_relaxed);
+    ++g;
+
+    automutex locker(m_region_mutex);
+    if (is_nullptr(r))
+    {
+        m_region_floor = g;
+    }
+    else
+    {
+        region & slot = m_regions[g % m_regions.size()];
+        if (int(slot.r_generation - m_region_floor) > 0)
+            m_region_floor = slot.r_generation;     /* it is now forgotten  */
+
+        slot = *r;
+        slot.r_generation = g;
+    }
+}
+
+/**
+ *  The region changed by adding one event.  A note can be linked to one
+ *  anywhere in the pattern, so the whole row of the note is changed.  Any
+ *  other event changes only its tick, in every row.
+ */
+
+sequence::region
+sequence::event_region (const event & ev) const
+{
+    if (ev.is_note())
+    {
+        int n = int(ev.get_note());
+        return region{0, 0, get_length(), n, n};
+    }
+    else
+    {
+        midipulse t = ev.timestamp();
+        return region{0, t, t, 0, 127};
+    }
+}
+
+/**
+ *  Gets the union of the regions changed since a view last looked.  Each
+ *  view keeps its own generation, so any number of views can ask.
+ *
+ * \param [inout] since
+ *      The redraw generation the view last looked at.  It is set to the
+ *      current generation, whatever the result.
+ *
+ * \param [out] r
+ *      The union of the regions, empty if nothing changed.
+ *
+ * \return
+ *      Returns true if the changes, if any, are all covered by the region.
+ *      Returns false if the view must repaint the whole pattern.
+ */
+
+bool
+sequence::dirty_region (unsigned & since, region & r) const
+{
+    automutex locker(m_region_mutex);
+    unsigned current = redraw_generation();
+    unsigned count = current - since;
+    bool result = int(since - m_region_floor) >= 0 &&
+        count <= unsigned(m_regions.size());
+
+    r.r_generation = current;
+    r.r_start = 0;
+    r.r_finish = -1;                        /* empty                        */
+    r.r_low = 127;
+    r.r_high = 0;
+    for (unsigned g = since + 1; result && count > 0; ++g, --count)
+    {
+        const region & slot = m_regions[g % m_regions.size()];
+        result = slot.r_generation == g;    /* else not recorded yet        */
+        if (result)
+        {
+            if (region_empty(r))
+            {
+                r.r_start = slot.r_start;
+                r.r_finish = slot.r_finish;
+            }
+            else
+            {
+                r.r_start = std::min(r.r_start, slot.r_start);
+                r.r_finish = std::max(r.r_finish, slot.r_finish);
+            }
+            r.r_low = std::min(r.r_low, slot.r_low);
+            r.r_high = std::max(r.r_high, slot.r_high);
+        }
+    }
+    since = current;
+    return result;
 }
 
 /**
- *  Call set_dirty_mp() and then sets the dirty flag for editing. Note that it
- *  does not call performer::modify().
+ *  Tells if the latest change has a region, so that a caller that is
+ *  notified of it can leave the repaint to the views.
  */
 
-void
-sequence::set_dirty ()
+bool
+sequence::partial_change () const
 {
-    set_dirty_mp();
-    m_dirty_edit = true;
+    automutex locker(m_region_mutex);
+    unsigned current = redraw_generation();
+    const region & slot = m_regions[current % m_regions.size()];
+    return slot.r_generation == current &&
+        int(current - m_region_floor) > 0;
 }
 
 /**
@@ -4729,7 +6181,7 @@ sequence::is_dirty_edit () const
 void
 sequence::play_note_on (int note)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     event e(0, EVENT_NOTE_ON, midibyte(note), midibyte(m_note_on_velocity));
     if (rc().investigate())
         perf()->repitch(e);
@@ -4751,7 +6203,7 @@ sequence::play_note_on (int note)
 void
 sequence::play_note_off (int note)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     event e(0, EVENT_NOTE_OFF, midibyte(note), midibyte(m_note_on_velocity));
     if (rc().investigate())
         perf()->repitch(e);
@@ -4767,7 +6219,7 @@ sequence::play_note_off (int note)
 bool
 sequence::clear_triggers ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     int count = m_triggers.count();
     bool result = count > 0;
     m_triggers.clear();
@@ -4780,7 +6232,7 @@ sequence::clear_triggers ()
 void
 sequence::print_triggers () const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     m_triggers.print(m_name);
 }
 
@@ -4810,7 +6262,7 @@ sequence::add_trigger
     midibyte tpose, bool fixoffset
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.add(tick, len, offset, tpose, fixoffset);
     modify(false);                      /* issue #90 flag change w/o notify */
     return true;
@@ -4847,14 +6299,14 @@ sequence::intersect_triggers
     midipulse position, midipulse & start, midipulse & ender
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.intersect(position, start, ender);
 }
 
 bool
 sequence::intersect_triggers (midipulse position)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.intersect(position);
 }
 
@@ -4896,7 +6348,7 @@ sequence::intersect_notes
     midipulse & start, midipulse & ender, int & note
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     auto on = m_events.begin();
     auto off = m_events.begin();
     while (on != m_events.end())
@@ -4974,7 +6426,7 @@ sequence::intersect_events
     midibyte status, midipulse & start
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     midipulse poslength = posend - posstart;
     for (auto & eon : m_events)
     {
@@ -5015,7 +6467,7 @@ sequence::intersect_events
 bool
 sequence::grow_trigger (midipulse tickfrom, midipulse tickto, midipulse len)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.grow_trigger(tickfrom, tickto, len);
     modify(false);                      /* issue #90 flag change w/o notify */
     set_dirty_mp();                     /* force redraw                     */
@@ -5023,23 +6475,39 @@ sequence::grow_trigger (midipulse tickfrom, midipulse tickto, midipulse len)
 }
 
 /**
- *  This grows a trigger continuously.
+ *  Sets the end of the trigger that covers tickfrom to exactly tickto,
+ *  growing or shrinking it.  Used to close a song-recorded trigger, which
+ *  was grown ahead of the play tick while recording.
+ *
+ * \threadsafe
+ *
+ * \param tickfrom
+ *      A tick inside the trigger, normally its start.
+ *
+ * \param tickto
+ *      The new end tick of the trigger.
+ *
+ * \return
+ *      Returns true if a trigger covered tickfrom.
  */
 
 bool
-sequence::grow_trigger (midipulse tickfrom, midipulse tickto)
+sequence::close_trigger (midipulse tickfrom, midipulse tickto)
 {
-    automutex locker(m_mutex);
-    m_triggers.grow_trigger(tickfrom, tickto, c_song_record_incr);
-    modify(false);                      /* issue #90 flag change w/o notify */
-    set_dirty_mp();                     /* force redraw                     */
-    return true;
+    writelock locker(m_mutex);
+    bool result = m_triggers.close_trigger(tickfrom, tickto);
+    if (result)
+    {
+        modify(false);                  /* issue #90 flag change w/o notify */
+        set_dirty_mp();                 /* force redraw                     */
+    }
+    return result;
 }
 
 const trigger &
 sequence::find_trigger (midipulse tick) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_triggers.find_trigger(tick);
 }
 
@@ -5056,7 +6524,7 @@ sequence::find_trigger (midipulse tick) const
 bool
 sequence::delete_trigger (midipulse tick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = m_triggers.remove(tick);
     if (result)
         modify(false);                  /* issue #90 flag change w/o notify */
@@ -5077,7 +6545,7 @@ sequence::delete_trigger (midipulse tick)
 void
 sequence::set_trigger_offset (midipulse trigger_offset)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (get_length() > 0)
     {
         m_trigger_offset = trigger_offset % get_length();
@@ -5103,7 +6571,7 @@ sequence::set_trigger_offset (midipulse trigger_offset)
 bool
 sequence::split_trigger (midipulse splittick, trigger::splitpoint splittype)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result =  m_triggers.split(splittick, splittype);
     if (result)
         modify(false);                  /* issue #90 flag change w/o notify */
@@ -5126,7 +6594,7 @@ sequence::split_trigger (midipulse splittick, trigger::splitpoint splittype)
 void
 sequence::adjust_trigger_offsets_to_length (midipulse newlength)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.adjust_offsets_to_length(newlength);
 }
 
@@ -5146,7 +6614,7 @@ sequence::adjust_trigger_offsets_to_length (midipulse newlength)
 void
 sequence::copy_triggers (midipulse starttick, midipulse distance)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.copy(starttick, distance);
 }
 
@@ -5156,7 +6624,7 @@ sequence::selected_trigger
     midipulse droptick, midipulse & tick0, midipulse & tick1
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = m_triggers.select(droptick);
     tick0 = m_triggers.get_selected_start();
     tick1 = m_triggers.get_selected_end();
@@ -5176,7 +6644,7 @@ sequence::selected_trigger
 midipulse
 sequence::selected_trigger_start ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.get_selected_start();
 }
 
@@ -5193,7 +6661,7 @@ sequence::selected_trigger_start ()
 midipulse
 sequence::selected_trigger_end ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.get_selected_end();
 }
 
@@ -5230,7 +6698,7 @@ sequence::move_triggers
     bool direction, bool single
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.move(starttick, distance, direction, single);
     modify(false);                      /* issue #90 flag change w/o notify */
     return true;
@@ -5273,7 +6741,7 @@ sequence::move_triggers
     midipulse tick, bool adjustoffset, triggers::grow which
 )
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result =  m_triggers.move_selected(tick, adjustoffset, which);
     if (result)
         modify(false);                  /* issue #90 flag change w/o notify */
@@ -5288,7 +6756,7 @@ sequence::move_triggers
 void
 sequence::offset_triggers (midipulse tick, triggers::grow editmode)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.offset_selected(tick, editmode);
 }
 
@@ -5304,28 +6772,28 @@ sequence::offset_triggers (midipulse tick, triggers::grow editmode)
 midipulse
 sequence::get_max_trigger () const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_triggers.get_maximum();
 }
 
 midipulse
 sequence::get_max_timestamp () const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_events.get_max_timestamp();
 }
 
 bool
 sequence::get_trigger_state (midipulse tick) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return m_triggers.get_state(tick);
 }
 
 bool
 sequence::transpose_trigger (midipulse tick, int transposition)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = m_triggers.transpose(tick, transposition);
     if (result)
         modify(false);                          /* no easy way to undo this */
@@ -5344,7 +6812,7 @@ sequence::transpose_trigger (midipulse tick, int transposition)
 triggers::container
 sequence::get_triggers () const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     return triggerlist();
 }
 
@@ -5364,7 +6832,7 @@ sequence::get_triggers () const
 bool
 sequence::select_trigger (midipulse tick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.select(tick);
 }
 
@@ -5378,7 +6846,7 @@ sequence::select_trigger (midipulse tick)
 bool
 sequence::unselect_trigger (midipulse tick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.unselect(tick);
 }
 
@@ -5392,7 +6860,7 @@ sequence::unselect_trigger (midipulse tick)
 bool
 sequence::unselect_triggers ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     return m_triggers.unselect();
 }
 
@@ -5406,7 +6874,7 @@ sequence::unselect_triggers ()
 bool
 sequence::delete_selected_triggers ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = m_triggers.remove_selected();
     if (result)
         modify(false);                  /* issue #90 flag change w/o notify */
@@ -5424,7 +6892,7 @@ sequence::delete_selected_triggers ()
 bool
 sequence::cut_selected_triggers ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     copy_selected_triggers();                   /* locks itself (recursive) */
     return m_triggers.remove_selected();
 }
@@ -5437,7 +6905,7 @@ sequence::cut_selected_triggers ()
 bool
 sequence::copy_selected_triggers ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     set_trigger_paste_tick(c_no_paste_trigger);
     m_triggers.copy_selected();
     return true;
@@ -5459,7 +6927,7 @@ sequence::copy_selected_triggers ()
 bool
 sequence::paste_trigger (midipulse paste_tick)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.paste(paste_tick);
     return true;
 }
@@ -5482,11 +6950,23 @@ sequence::stop (bool songmode)
     bool state = armed();
     off_playing_notes();
     zero_markers();                         /* sets the "last-tick" value   */
+    reset_mod_values();
+    filter of = std::atomic_load(&m_output_filter);
+    if (of)
+        of->reset();                        /* resend the first CC values   */
+
     if (recording())                        /* ca 2023-04-25                */
         (void) verify_and_link();
 
     set_armed(songmode ? false : state);
     m_next_boundary = 0;
+    if (not_nullptr(perf()))                /* nothing to redo, below       */
+    {
+        m_wrap_generation.store
+        (
+            perf()->wrap_generation(), std::memory_order_release
+        );
+    }
 }
 
 /**
@@ -5521,7 +7001,7 @@ sequence::pause (bool song_mode)
 void
 sequence::reset_draw_trigger_marker ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_triggers.reset_draw_trigger_marker();
 }
 
@@ -5551,41 +7031,13 @@ sequence::reset_draw_trigger_marker ()
  */
 
 bool
-sequence::minmax_notes (int & lowest, int & highest) // const
+sequence::minmax_notes (int & lowest, int & highest) const
 {
-    automutex locker(m_mutex);
-    bool result = false;
-    int low = int(max_midi_value());
-    int high = -1;
-    for (auto & er : m_events)
-    {
-        if (er.is_strict_note())
-        {
-            if (er.get_note() < low)
-            {
-                low = er.get_note();
-                result = true;
-            }
-            else if (er.get_note() > high)
-            {
-                high = er.get_note();
-                result = true;
-            }
-        }
-        else if (er.is_tempo())
-        {
-            midibyte notebyte = tempo_to_note_value(er.tempo());
-            if (notebyte < low)
-                low = notebyte;
-            else if (notebyte > high)
-                high = notebyte;
-
-            result = true;
-        }
-    }
-    lowest = low;
-    highest = high;
-    return result;
+    readlock locker(m_mutex);
+    eventstats st = refresh_stats();
+    lowest = st.es_lowest;
+    highest = st.es_highest;
+    return st.es_minmax;
 }
 
 /**
@@ -5619,7 +7071,7 @@ sequence::get_next_note
     event::buffer::const_iterator & evi
 ) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     while (evi != m_events.cend())
     {
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
@@ -5663,7 +7115,7 @@ sequence::get_note_info
     {
         if (islinked)
         {
-            niout.ni_tick_finish = drawevent.link()->timestamp();
+            niout.ni_tick_finish = m_events.linked(drawevent)->timestamp();
             return draw::linked;
         }
         else
@@ -5687,7 +7139,7 @@ sequence::get_note_info
          */
 
         if (islinked)
-            niout.ni_tick_finish = drawevent.link()->timestamp();
+            niout.ni_tick_finish = m_events.linked(drawevent)->timestamp();
         else
             niout.ni_tick_finish = get_length();
 
@@ -5739,7 +7191,7 @@ sequence::reset_interval
             }
             if (iter->is_linked())
             {
-                event::buffer::const_iterator ev = iter->link();
+                event::buffer::const_iterator ev = m_events.linked(*iter);
                 if (ev->timestamp() >= t1)
                 {
                     result = true;  // What about terminating iterator ??
@@ -5784,10 +7236,10 @@ sequence::get_next_event
 (
     midibyte & status, midibyte & cc,
     event::buffer::const_iterator & evi
-)
+) const
 {
-    automutex locker(m_mutex);
-    bool result = evi != m_events.end();
+    readlock locker(m_mutex);
+    bool result = evi != m_events.cend();
     if (result)
     {
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
@@ -5843,11 +7295,11 @@ sequence::get_next_event_match
 (
     midibyte status, midibyte cc,
     event::buffer::const_iterator & evi
-)
+) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     bool ismeta = event::is_meta_msg(status);
-    while (evi != m_events.end())
+    while (evi != m_events.cend())
     {
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
         if (m_events.action_in_progress())      /* atomic boolean check     */
@@ -5921,13 +7373,13 @@ sequence::get_next_meta_match
     event::buffer::const_iterator & evi,
     midipulse start,
     midipulse range
-)
+) const
 {
-    automutex locker(m_mutex);
+    readlock locker(m_mutex);
     if (range != c_null_midipulse)
         range += start;
 
-    while (evi != m_events.end())
+    while (evi != m_events.cend())
     {
 #if defined SEQ66_USE_ACTION_IN_PROGRESS_FLAG
         if (m_events.action_in_progress())      /* atomic boolean check     */
@@ -5971,7 +7423,8 @@ sequence::next_trigger (trigger & trig)
 /**
  * \setter m_last_tick
  *      This function used to be called "set_orig_tick()", now renamed to
- *      match up with get_last_tick().
+ *      match up with get_last_tick().  The tick is atomic, so no lock is
+ *      needed.
  *
  * \threadsafe
  */
@@ -5979,7 +7432,6 @@ sequence::next_trigger (trigger & trig)
 void
 sequence::set_last_tick (midipulse tick)
 {
-    automutex locker(m_mutex);
     if (is_null_midipulse(tick))
         tick = m_length;
 
@@ -6019,9 +7471,10 @@ sequence::get_tick () const
 midipulse
 sequence::get_last_tick () const
 {
+    midipulse t = last_tick();
     return get_length() > 0 ?
-        (m_last_tick + get_length() - m_trigger_offset) % get_length() :
-        m_last_tick - m_trigger_offset
+        (t + get_length() - m_trigger_offset) % get_length() :
+        t - m_trigger_offset
         ;
 }
 
@@ -6050,7 +7503,7 @@ sequence::get_last_tick () const
 bool
 sequence::set_midi_bus (bussbyte nominalbus, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = is_valid_buss(nominalbus);
     if (result)
     {
@@ -6086,7 +7539,7 @@ sequence::set_midi_bus (bussbyte nominalbus, bool user_change)
 bool
 sequence::set_midi_in_bus (bussbyte nominalbus, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = is_valid_buss(nominalbus);
     if (result)
     {
@@ -6177,7 +7630,7 @@ sequence::set_midi_in_bus (bussbyte nominalbus, bool user_change)
 bool
 sequence::set_length (midipulse len, bool adjust_triggers, bool verify)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = len != m_length;
     if (result)
     {
@@ -6319,7 +7772,7 @@ sequence::apply_length
 bool
 sequence::extend_length ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     midipulse len = m_events.get_max_timestamp();
     bool result = len > get_length();
     if (len > get_length())
@@ -6338,7 +7791,7 @@ sequence::extend_length ()
 bool
 sequence::double_length ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     int m = get_measures();
     bool result = m > 0;
     if (result)
@@ -6387,6 +7840,71 @@ sequence::notify_trigger ()
         perf()->notify_trigger_change(seq_number(), performer::change::no);
 }
 
+/**
+ *  Called by the triggers object whenever a trigger is added, removed, or
+ *  changed, so that the performer compiles its song timeline again.
+ */
+
+void
+sequence::notify_triggers_edited ()
+{
+    stamp_edit();
+    if (not_nullptr(perf()))
+        perf()->song_timeline_stale();
+}
+
+/**
+ *  Gives the pattern a new edit stamp.
+ */
+
+void
+sequence::stamp_edit ()
+{
+    unsigned s = sm_edit_stamps.fetch_add(1, std::memory_order_relaxed) + 1;
+    m_edit_stamp.store(s, std::memory_order_relaxed);
+}
+
+/**
+ *  Changes one bit of the playback state, and clears others, in one atomic
+ *  compare-and-swap, so that no reader sees the bit changed but the others
+ *  not yet cleared.  If the bit already has the value, nothing is changed.
+ *
+ * \param b
+ *      The bit to set or clear.
+ *
+ * \param on
+ *      The new value of the bit.
+ *
+ * \param clearbits
+ *      The playbit values, OR'ed, to clear along with the change.
+ *
+ * \return
+ *      Returns true if the bit changed.
+ */
+
+bool
+sequence::change_play_state (playbit b, bool on, unsigned clearbits)
+{
+    unsigned bit = unsigned(b);
+    unsigned old = m_play_state.load(std::memory_order_acquire);
+    unsigned desired;
+    do
+    {
+        if (((old & bit) != 0) == on)
+            return false;
+
+        desired = (on ? (old | bit) : (old & ~bit)) & ~clearbits;
+
+    } while
+    (
+        ! m_play_state.compare_exchange_weak
+        (
+            old, desired, c_play_order, std::memory_order_acquire
+        )
+    );
+    return true;
+}
+
 /**
  *  Sets the playing state of this sequence.  When playing, and the sequencer
  *  is running, notes get dumped to the ALSA buffers.
@@ -6396,6 +7914,17 @@ sequence::notify_trigger ()
  *  This covers the case where the user enables and then disables a mute
  *  group, which sets song-mute to true on all sequences.
  *
+ *  The flags are changed without the mutex (see change_play_state()), and
+ *  only one caller wins a change.  The mutex is still taken, by
+ *  off_playing_notes(), to stop the notes that are sounding.
+ *
+ *  When the user (or a MIDI control) mutes a playing pattern, rather than
+ *  the pattern reaching a queued boundary or the end of a trigger in the
+ *  frame being played, the events that the buss's API still holds for it,
+ *  bar the Note Offs, are taken back first, so that, with a lookahead
+ *  queue, the mute is heard at once.  This is not done if another playing
+ *  pattern has the same tag, since its events would go too.
+ *
  * \param p
  *      Provides the playing status to set.  True means to turn on the
  *      playing, false means to turn it off, and turn off any notes still
@@ -6405,15 +7934,25 @@ sequence::notify_trigger ()
 bool
 sequence::set_armed (bool p)
 {
-    automutex locker(m_mutex);
-    bool result = p != armed();
+    unsigned unqueue = unsigned(playbit::queued) | unsigned(playbit::one_shot);
+    bool result = change_play_state(playbit::armed, p, unqueue);
     if (result)
     {
-        armed(p);
         if (p)
+        {
             set_song_mute(false);                   /* see banner notes     */
+        }
         else
+        {
+            bool muted = ! framebatch::active() && perf()->is_running();
+            if (muted && not_nullptr(master_bus()))
+            {
+                if (! perf()->output_tag_shared(*this))
+                    master_bus()->retract(m_true_bus, output_tag());
+            }
+
             off_playing_notes();
+        }
 
         /*
          * This call is meant to allow the grid slot and the pattern-editor
@@ -6427,7 +7966,6 @@ sequence::set_armed (bool p)
          */
 
         set_dirty();
-        m_queued = m_one_shot = false;
         perf()->announce_pattern(seq_number());     /* for issue #89        */
 #if defined SEQ66_PLATFORM_DEBUG_TMI
         printf("seq %d: playing %s\n", int(seq_number()), p ? "on" : "off");
@@ -6436,11 +7974,9 @@ sequence::set_armed (bool p)
 
     /*
      * Let's move these above so that announce_pattern() behaves properly.
-     * Whenever playing state changes, we are unqueued.  Not yet sure
-     * about one-shot.
-     *
-     * m_queued = false;
-     * m_one_shot = false;
+     * Whenever playing state changes, we are unqueued, and also not in
+     * one-shot mode.  This is now done with the change of the armed bit,
+     * in change_play_state().
      */
 
     return result;
@@ -6481,31 +8017,48 @@ sequence::set_armed (bool p)
 bool
 sequence::set_recording (toggler flag)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool recordon = m_recording;
     if (flag == toggler::flip)
         recordon = ! recordon;
     else
         recordon = flag == toggler::on;
 
+    /*
+     * The channel-match flag is set first, as set_sequence_input() builds
+     * the record-by-channel routing table from it.
+     */
+
+    bool oldmatch = channel_match();
+    channel_match
+    (
+        recordon && ! perf()->record_by_buss() && perf()->record_by_channel()
+    );
+
     bool result = master_bus()->set_sequence_input(recordon, this);
     if (result)
     {
-        channel_match(false);
         m_recording = recordon;
         m_notes_on = 0;                 /* reset the step-edit note counter */
         m_last_tick = 0;
+        (void) merge_take();            /* the last pass of an overdub      */
+        clear_recorded_keys();          /* a new recording session          */
         if (recordon)
         {
-            if (! perf()->record_by_buss() && perf()->record_by_channel())
-                channel_match(true);
+            reserve_for_recording();
         }
         else
+        {
             m_record_alteration = alteration::none;
-
+            if (is_normal_seq())
+                publish_snapshot();
+        }
         set_dirty();
         notify_trigger();
     }
+    else
+        channel_match(oldmatch);
+
     return result;
 }
 
@@ -6526,7 +8079,7 @@ sequence::set_recording (toggler flag)
 bool
 sequence::set_recording (alteration q, toggler flag)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = true;
     if (flag == toggler::on)
     {
@@ -6575,7 +8128,7 @@ sequence::set_recording (alteration q, toggler flag)
 bool
 sequence::set_recording_style (recordstyle rs)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = rs != recordstyle::max;
     if (result)
     {
@@ -6608,7 +8161,7 @@ sequence::set_recording_style (recordstyle rs)
 bool
 sequence::set_thru (bool thruon, bool toggle)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (toggle)
         thruon = ! m_thru;
 
@@ -6634,7 +8187,7 @@ sequence::set_thru (bool thruon, bool toggle)
 void
 sequence::snap (int st)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_snap_tick = midipulse(st);
     m_events.zero_len_correction(snap() / 2);
 }
@@ -6642,14 +8195,14 @@ sequence::snap (int st)
 void
 sequence::step_edit_note_length (int len)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_step_edit_note_length = midipulse(len);
 }
 
 void
 sequence::loop_reset (bool reset)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_loop_reset = reset;
 }
 
@@ -6743,7 +8296,7 @@ sequence::title () const
 bool
 sequence::set_midi_channel (midibyte ch, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = ch != m_midi_channel;
     if (result)
         result = is_valid_channel(ch);      /* 0 to 15 or null_channel()    */
@@ -6753,6 +8306,9 @@ sequence::set_midi_channel (midibyte ch, bool user_change)
         off_playing_notes();
         m_free_channel = is_null_channel(ch);
         m_midi_channel = ch;                /* if (! m_free_channel)        */
+        if (m_recording && not_nullptr(master_bus()))
+            master_bus()->rebuild_record_routes();  /* the channel moved    */
+
         if (user_change)
             modify();                       /* no easy way to undo this     */
 
@@ -6826,47 +8382,155 @@ sequence::to_string () const
     return result;
 }
 
+/**
+ *  Captures an event played by a playpool worker, or by the output thread
+ *  in a frame.
+ *
+ * \return
+ *      Returns true if the event was captured, and must not be sent.
+ */
+
+static bool
+captured (bussbyte bus, const event & ev, midibyte channel, midibyte tag = 0)
+{
+    return playpool::capture(bus, ev, channel, tag) ||
+        framebatch::capture(bus, ev, channel, tag);
+}
+
 /**
  *  Takes an event that this sequence is holding, and places it on the MIDI
  *  buss.  This function does not bother checking if m_master_bus is a null
  *  pointer.
  *
+ *  The event is not flushed.  During playback, performer::play() flushes
+ *  the busses once, after all patterns have played the frame, so that ALSA
+ *  drains its output buffer once per frame rather than once per event.
+ *  Other callers must call mastermidibus::flush() themselves.  When the
+ *  pattern is played by a playpool worker, the event is captured for the
+ *  output thread to send, instead, and when played by the output thread,
+ *  it goes into the batch of its buss (see framebatch).
+ *
  *  Note that the call to midi_channel() yields the event channel if
  *  free_channel() is true.  Otherwise the global pattern channel is true.
+ *  The output filter, if any, is then run over the channel and data bytes,
+ *  before the sounding notes are tracked, so that the Note Offs sent by
+ *  off_playing_notes() are for the notes actually sent.
  *
  * \param ev
  *      The event to put on the buss.
  *
+ * \param tick
+ *      The tick at which the event is played, which becomes its timestamp.
+ *      play() passes the exact tick of each event, so that the JACK-driven
+ *      engine can give each event its own frame offset.  If null (the
+ *      default), the performer's current tick is used.
+ *
  * \threadsafe
  */
 
 void
-sequence::put_event_on_bus (const event & ev)
+sequence::put_event_on_bus (const event & ev, midipulse tick)
 {
-    midibyte note = ev.get_note();
+    midibyte channel = midi_channel(ev);
+    midibyte d0, d1;
+    ev.get_data(d0, d1);
+
+    filter of = std::atomic_load(&m_output_filter);
+    bool filtered = of && ev.has_channel();
+    if (filtered && ! of->apply(ev.get_status(), channel, d0, d1))
+        return;
+
     bool skip = false;
     if (ev.is_note_on())
+        m_playing_notes.on(d0);
+    else if (ev.is_note_off())
+        skip = ! m_playing_notes.off(d0);
+
+    if (! skip)
     {
-        ++m_playing_notes[note];
+        event evout;
+        if (is_null_midipulse(tick))
+            tick = perf()->get_tick();
+
+        evout.prep_for_send(tick, ev);                      /* issue #100   */
+        if (filtered)
+            evout.set_data(d0, d1);
+
+        if (! captured(m_true_bus, evout, channel, output_tag()))
+            master_bus()->play(m_true_bus, &evout, channel);
     }
-    else if (ev.is_note_off())
+}
+
+/**
+ *  The playevent version of put_event_on_bus(), used by play() for all but
+ *  tempo and SysEx events.  It fills the outgoing event from the compact
+ *  event's bytes.  Transposition and the output filter are applied while
+ *  doing that, so that no copy of the event needs to be made just to change
+ *  its bytes.
+ *
+ * \param pe
+ *      The compact event to put on the buss.
+ *
+ * \param tick
+ *      The tick at which the event is played, which becomes its timestamp.
+ *
+ * \param transpose
+ *      The number of semitones by which to transpose a note event.  The
+ *      default is 0.  Unlike the transposed note, the playevent itself is
+ *      not altered.
+ *
+ * \param of
+ *      The output filter, as loaded once for the frame by the caller, or
+ *      null if there is none.
+ *
+ * \param velscale
+ *      If not 0, the velocity of a pad hit, which scales the velocity of a
+ *      Note On, 127 leaving it as is.  The default is 0.
+ *
+ * \threadsafe
+ */
+
+void
+sequence::put_event_on_bus
+(
+    const playevent & pe, midipulse tick, int transpose,
+    const outputfilter * of, midibyte velscale
+)
+{
+    midibyte note = transpose != 0 && pe.is_note() ?
+        pe.transposed_note(transpose) : pe.d0() ;
+    midibyte velocity = pe.d1();
+    if (velscale > 0 && velocity > 0 && pe.is_note_on())
     {
-        if (m_playing_notes[note] == 0)
-            skip = true;
-        else
-            --m_playing_notes[note];
+        int v = int(velocity) * int(velscale) / 127;
+        velocity = midibyte(v > 0 ? v : 1);
     }
+    midibyte channel = m_free_channel ? pe.channel() : m_midi_channel ;
+    if (not_nullptr(of) && ! of->apply(pe.status(), channel, note, velocity))
+        return;
+
+    bool skip = false;
+    if (pe.is_note_on())
+        m_playing_notes.on(note);
+    else if (pe.is_note_off())
+        skip = ! m_playing_notes.off(note);
+
     if (! skip)
     {
         event evout;
-        evout.prep_for_send(perf()->get_tick(), ev);      /* issue #100   */
-        master_bus()->play_and_flush(m_true_bus, &evout, midi_channel(ev));
+        evout.prep_for_send(tick, pe.status(), note, velocity);
+        if (! captured(m_true_bus, evout, channel, output_tag()))
+            master_bus()->play(m_true_bus, &evout, channel);
     }
 }
 
 /**
- *  Sends a note-off event for all active notes.  This function does not
- *  bother checking if m_master_bus is a null pointer.
+ *  Sends a note-off event for all active notes.  Inside a playpool run,
+ *  as in an offline render, the note-offs are captured like any other
+ *  played event.  With no master buss, they are simply dropped.  The buss
+ *  is flushed only if a note-off was sent, and not while the performer
+ *  batches its output, as when applying a mute-group or stopping.  Only the
+ *  sounding notes are visited, so a silent pattern costs nothing here.
  *
  * \threadsafe
  */
@@ -6874,20 +8538,51 @@ sequence::put_event_on_bus (const event & ev)
 void
 sequence::off_playing_notes ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
+    send_playing_notes_off();
+}
+
+/**
+ *  The body of off_playing_notes(), for callers that hold the mutex, or
+ *  that, like the lock-free path of play(), touch only the playback state.
+ */
+
+void
+sequence::send_playing_notes_off ()
+{
+    if (m_playing_notes.empty())
+        return;
+
     int channel = free_channel() ? 0 : seq_midi_channel() ;
+    filter of = std::atomic_load(&m_output_filter);
+    if (of)
+        channel = of->out_channel(midibyte(channel));
+
     event e(0, EVENT_NOTE_OFF, channel, 0, 0);
-    for (int x = 0; x < c_notes_count; ++x)
+    bool sent = false;
+    for (int i = 0; i < m_playing_notes.size(); ++i)
     {
-        while (m_playing_notes[x] > 0)
+        midibyte x = m_playing_notes.note(i);
+        for (int n = m_playing_notes.count(x); n > 0; --n)
         {
             e.set_data(x);
-            master_bus()->play(m_true_bus, &e, channel);
-            --m_playing_notes[x];
+            if (! captured(m_true_bus, e, midibyte(channel)))
+            {
+                if (not_nullptr(master_bus()))
+                {
+                    master_bus()->play(m_true_bus, &e, channel);
+                    sent = true;
+                }
+            }
         }
     }
-    if (not_nullptr(master_bus()))
-        master_bus()->flush();
+    m_playing_notes.clear();
+    if (sent)
+    {
+        bool batched = not_nullptr(perf()) && perf()->output_batched();
+        if (! batched)
+            master_bus()->flush();          /* else flushed with the batch  */
+    }
 }
 
 /**
@@ -6911,43 +8606,23 @@ sequence::off_playing_notes ()
  * \param scale
  *      The scale to make the notes adhere to while transposing.  If the scale
  *      is 0, it is straight transposition.  If greater than 0, then the
- *      transposition is harmonic, and based on the "up" or "down" settings in
- *      the scales module for that scale.
+ *      transposition is harmonic, moving each note by steps of the scale,
+ *      a table lookup done by harmonic_transpose() in the scales module.
  */
 
 bool
 sequence::transpose_notes (int steps, int scale, int key)
 {
-    automutex locker(m_mutex);
-    const int * transposetable;
+    writelock locker(m_mutex);
     bool result = false;
     m_events_undo.push(m_events);                   /* push_undo(), no lock */
-    if (steps < 0)
-    {
-        transposetable = scales_down(scale, key);   /* 0 = chromatic scale  */
-        steps *= -1;
-    }
-    else
-        transposetable = scales_up(scale, key);     /* 0 = chromatic scale  */
-
     for (auto & er : m_events)
     {
         if (er.is_selected_note())                  /* transposable event?  */
         {
-            int note = er.get_note();
-            bool off_scale = false;
-            if (transposetable[note % c_octave_size] == 0)
-            {
-                off_scale = true;
-                note -= 1;
-            }
-            for (int x = 0; x < steps; ++x)
-                note += transposetable[note % c_octave_size];
-
-            if (off_scale)
-                note += 1;
-
-            er.set_note(note);
+            int note = er.get_note();               /* 0 = chromatic scale  */
+            note = harmonic_transpose(scale, key, note, steps);
+            er.set_note(midibyte(note));
             result = true;
         }
     }
@@ -6966,7 +8641,7 @@ sequence::transpose_notes (int steps, int scale, int key)
 void
 sequence::shift_notes (midipulse ticks)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (get_length() > 0)
     {
         m_events_undo.push(m_events);               /* push_undo(), no lock */
@@ -7005,7 +8680,7 @@ sequence::apply_song_transpose ()
     int transpose = transposable() ? perf()->get_transpose() : 0 ;
     if (transpose != 0)
     {
-        automutex locker(m_mutex);
+        writelock locker(m_mutex);
         m_events_undo.push(m_events);               /* push_undo(), no lock */
         for (auto & er : m_events)
         {
@@ -7034,7 +8709,7 @@ sequence::apply_song_transpose ()
 void
 sequence::set_transposable (bool flag, bool user_change)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool modded = flag != m_transposable && user_change;
     m_transposable = flag;
     if (modded)
@@ -7073,7 +8748,7 @@ sequence::set_transposable (bool flag, bool user_change)
 bool
 sequence::quantize_events (midibyte status, midibyte cc, int divide)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (divide == 0)
         return false;
 
@@ -7087,7 +8762,7 @@ sequence::quantize_events (midibyte status, midibyte cc, int divide)
 bool
 sequence::quantize_notes (int divide)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     if (divide == 0)
         return false;
 
@@ -7099,26 +8774,49 @@ sequence::quantize_notes (int divide)
 }
 
 /**
- *  We set the beats and width to 0 to use the current values.
+ *  Rescales the events, triggers, length, and PPQN-based settings of the
+ *  pattern to a new PPQN in a single pass.  The tick mapping never
+ *  decreases (see rescale_tick()), so the events and triggers stay in
+ *  order and the note links stay valid:  there is no sort, no
+ *  verify-and-link, and no call to apply_length() (which would snap the
+ *  length to whole measures and relink if that changed it).  This leaves
+ *  the pattern armed or not, and touches nothing in the performer but the
+ *  song-timeline generation, so that patterns can be rescaled in parallel.
+ *
+ * \param p
+ *      The new PPQN.
+ *
+ * \return
+ *      Returns true if the PPQN was valid and different, and the pattern
+ *      was rescaled.
  */
 
 bool
 sequence::change_ppqn (int p)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = p != m_ppqn;
     if (result)
         result = ppqn_in_range(p);
 
     if (result)
     {
-        result = m_events.rescale(p, m_ppqn);           /* new & old PPQNs  */
+        int oldppqn = int(m_ppqn);
+        result = m_events.rescale(p, oldppqn);          /* new & old PPQNs  */
         if (result)
         {
-            m_length = rescale_tick(m_length, p, m_ppqn);
+            m_length = rescale_tick(m_length, p, oldppqn);
+            m_snap_tick = rescale_tick(m_snap_tick, p, oldppqn);
+            m_step_edit_note_length = rescale_tick
+            (
+                m_step_edit_note_length, p, oldppqn
+            );
             m_ppqn = p;
-            result = apply_length(0, 0, 0);             /* use new PPQN     */
-            m_triggers.change_ppqn(p);
+            m_events.set_length(m_length);
+            (void) m_triggers.change_ppqn(p);
+            m_triggers.set_length(m_length);
+            (void) unit_measure(true);                  /* use new PPQN     */
+            set_dirty();
         }
     }
     return result;
@@ -7150,7 +8848,7 @@ sequence::change_ppqn (int p)
 bool
 sequence::push_quantize (midibyte status, midibyte cc, int divide)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);
     return quantize_events(status, cc, divide);
 }
@@ -7158,7 +8856,7 @@ sequence::push_quantize (midibyte status, midibyte cc, int divide)
 bool
 sequence::push_quantize_notes (int divide)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);
     return quantize_notes(divide);
 }
@@ -7166,7 +8864,7 @@ sequence::push_quantize_notes (int divide)
 bool
 sequence::push_jitter_notes (int range)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     m_events_undo.push(m_events);
     if (range == (-1))
         range = usr().jitter_range(snap());
@@ -7225,7 +8923,7 @@ sequence::show_events () const
 bool
 sequence::copy_events (const eventlist & newevents)
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     bool result = false;
     m_events.clear();
     m_events = newevents;
@@ -7305,6 +9003,10 @@ sequence::set_parent (performer * p)
         midipulse barlength = ppnote * bpb;     /* get_beats_per_bar();     */
         bussbyte buss_override = usr().midi_buss_override();
         m_parent = p;                           /* perf() is the accessor   */
+        m_wrap_generation.store
+        (
+            p->wrap_generation(), std::memory_order_release
+        );
         set_master_midi_bus(p->master_bus());
         sort_events();                      /* sort the events now          */
         set_length();                       /* final verify_and_link()      */
@@ -7341,6 +9043,23 @@ sequence::set_parent (performer * p)
 
 void
 sequence::play_queue (midipulse tick, bool playbackmode, bool resumenoteons)
+{
+    play_boundaries(tick, playbackmode, resumenoteons);
+    play_frame(tick, playbackmode, resumenoteons);
+}
+
+/**
+ *  The first half of play_queue().  If the queued or one-shot boundary has
+ *  been reached, plays up to it, then toggles the playing status.  The
+ *  performer's Live-mode loop calls this function only for the patterns
+ *  whose boundary falls in the frame (see boundarywheel).
+ */
+
+void
+sequence::play_boundaries
+(
+    midipulse tick, bool playbackmode, bool resumenoteons
+)
 {
     if (check_queued_tick(tick))
     {
@@ -7363,6 +9082,15 @@ sequence::play_queue (midipulse tick, bool playbackmode, bool resumenoteons)
             automation::action::off, automation::ctrlstatus::oneshot
         );
     }
+}
+
+/**
+ *  The second half of play_queue(), which plays the frame.
+ */
+
+void
+sequence::play_frame (midipulse tick, bool playbackmode, bool resumenoteons)
+{
     if (is_metro_seq())
     {
         live_play(tick);
@@ -7373,6 +9101,31 @@ sequence::play_queue (midipulse tick, bool playbackmode, bool resumenoteons)
     }
 }
 
+/**
+ *  Indicates if play_queue() can be called from a playpool worker thread,
+ *  in Live mode.  It can if playing the frame changes nothing but the state
+ *  of this pattern.  Queuing, one-shots, song-recording, and tempo events
+ *  reach into the performer, and the metronome has its own play function,
+ *  so such patterns are played by the output thread.  If there is no
+ *  snapshot yet, one needs to be published, which is also left to the
+ *  output thread.
+ */
+
+bool
+sequence::parallel_playable () const
+{
+    bool result = ! is_metro_seq() && ! get_queued() && ! one_shot();
+    if (result)
+        result = ! get_song_mute() && ! song_recording();
+
+    if (result)
+    {
+        snapshot snap = std::atomic_load(&m_play_snapshot);
+        result = snap && ! snap->has_tempo();
+    }
+    return result;
+}
+
 /**
  *  Actually, useful mainly for the user-interface, this function calculates
  *  the size of the left and right handles of a note.
@@ -7400,24 +9153,28 @@ sequence::handle_size (midipulse start, midipulse finish)
 }
 
 /**
- *  Toggles the m_one_shot flag, sets m_off_from_snap to true, and adjusts
+ *  Toggles the one-shot flag, sets off-from-snap to true, and adjusts
  *  m_one_shot_tick according to m_last_tick and m_length.
  */
 
 bool
 sequence::toggle_one_shot ()
 {
-    automutex locker(m_mutex);
+    writelock locker(m_mutex);
     set_dirty_mp();
-    m_one_shot = ! m_one_shot;
-    m_one_shot_tick = m_last_tick - mod_last_tick() + get_length();
+
+    bool oneshot = flip_play_bit(playbit::one_shot);
+    m_one_shot_tick = last_tick() - mod_last_tick() + get_length();
+    if (oneshot)
+        perf()->schedule_boundary(this, m_one_shot_tick);
+
     perf()->announce_pattern(seq_number());     /* for issue #89        */
     off_from_snap(true);
-    return m_one_shot;
+    return oneshot;
 }
 
 /**
- *  Sets the dirty flag, sets m_one_shot to false, and m_off_from_snap to
+ *  Sets the dirty flag, sets one-shot to false, and off-from-snap to
  *  true. This function remains unused here and in Kepler34. Instead, see
  *  the set_armed() function above.
  */
@@ -7425,9 +9182,8 @@ sequence::toggle_one_shot ()
 void
 sequence::off_one_shot ()
 {
-    automutex locker(m_mutex);
     set_dirty_mp();
-    m_one_shot = false;
+    one_shot(false);
     off_from_snap(true);
     perf()->announce_pattern(seq_number());     /* for issue #89        */
 }
@@ -7459,9 +9215,45 @@ sequence::song_recording_start (midipulse tick, bool snap)
         (void) perf()->calculate_snap(tick);      /* issue #44 redux  */
 
     song_record_tick(tick);                         /* snapped or not   */
+    m_song_record_end = tick + c_song_record_incr - 1;
     add_trigger(tick, c_song_record_incr);
 }
 
+/**
+ *  Called by play() for each output frame while song-recording.  Formerly
+ *  every frame grew the trigger and notified the song editor, about a
+ *  thousand times a second for each recording pattern, each time editing
+ *  the triggers container and marking the song timeline stale.  Now the
+ *  open span is tracked in m_song_record_end, and the trigger is grown, a
+ *  beat ahead of the play tick, only when the tick comes within
+ *  c_song_record_incr of that end.  The trigger thus always covers the play
+ *  tick, and the song editor sees a few updates a second.  The exact end is
+ *  set by song_recording_stop().
+ *
+ * \param tick
+ *      The current play tick.
+ *
+ * \return
+ *      Returns true if the trigger was committed, so that the caller can
+ *      send the notification.
+ */
+
+bool
+sequence::song_record_commit (midipulse tick)
+{
+    bool result = tick + c_song_record_incr > m_song_record_end;
+    if (result)
+    {
+        midipulse lead = m_ppqn > c_song_record_incr ?
+            midipulse(m_ppqn) : midipulse(c_song_record_incr) ;
+
+        result = grow_trigger(song_record_tick(), tick, lead);
+        if (result)
+            m_song_record_end = tick + lead - 1;
+    }
+    return result;
+}
+
 /**
  *  Stops the growing of the sequence for Song recording.  If we have been
  *  recording, we snap the end of the trigger segment to the next whole
@@ -7477,7 +9269,9 @@ sequence::song_recording_start (midipulse tick, bool snap)
  *      -   Length:  len = seq_length() - (tick % seq_length()).
  *
  *  That length snaps the end of the trigger to the next whole sequence
- *  interval.
+ *  interval.  Since the trigger is grown ahead of the play tick while
+ *  recording, its end is now set to the (snapped) tick exactly, which also
+ *  removes the up-to-16-tick overshoot of the old per-frame growing.
  *
  * \question
  *      Do we need to call set_dirty_mp() here?
@@ -7491,7 +9285,9 @@ void
 sequence::song_recording_stop (midipulse tick)
 {
     (void) perf()->calculate_snap(tick);      /* issue #44 redux  */
-    grow_trigger(song_record_tick(), tick, 1);
+    if (close_trigger(song_record_tick(), tick))
+        notify_trigger();                       /* one notice per span  */
+
     if (song_recording_snap())
         off_from_snap(true);
 
@@ -7545,6 +9341,11 @@ sequence::song_recording_stop (midipulse tick)
  *  One question is where is best to do the locking of put_event_on_bus().  In
  *  retrospect, probably better to do it just once, instead of for each event.
  *
+ *  The note index of the event list, built by verify_and_link(), finds the
+ *  notes of cases A and D without walking the whole pattern.  If the events
+ *  were changed since the last relinking, the index is not valid, and we
+ *  fall back to checking every event.
+ *
  * \param tick
  *      The current tick-time, in MIDI pulses.
  */
@@ -7552,18 +9353,32 @@ sequence::song_recording_stop (midipulse tick)
 void
 sequence::resume_note_ons (midipulse tick)
 {
-    automutex locker(m_mutex);                          /* better here?     */
+    writelock locker(m_mutex);                          /* better here?     */
     if (get_length() > 0)
     {
-        for (auto & ei : m_events)
+        midipulse rem = tick % get_length();
+        if (m_events.note_spans_valid())
+        {
+            const event::buffer & evs = m_events.events();
+            m_events.note_spans().sounding
+            (
+                rem, [this, &evs] (std::size_t slot)
+                {
+                    put_event_on_bus(evs[slot]);
+                }
+            );
+        }
+        else
         {
-            if (ei.is_note_on_linked())                 /* note on linked   */
+            for (auto & ei : m_events)
             {
-                midipulse on = ei.timestamp();          /* see banner notes */
-                midipulse off = ei.link()->timestamp();
-                midipulse rem = tick % get_length();
-                if (on < rem && (off > rem || on > off))
-                    put_event_on_bus(ei);
+                if (ei.is_note_on_linked())             /* note on linked   */
+                {
+                    midipulse on = ei.timestamp();      /* see banner notes */
+                    midipulse off = m_events.linked(ei)->timestamp();
+                    if (on < rem && (off > rem || on > off))
+                        put_event_on_bus(ei);
+                }
             }
         }
     }
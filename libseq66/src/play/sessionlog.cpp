@@ -0,0 +1,396 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sessionlog.cpp
+ *
+ *  This module defines the log of the control inputs of a session.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The producers are the input thread and the user-interface thread; the
+ *  file is written by the performer when the session ends.  The replay
+ *  harness reads the file without ever enabling the log.
+ */
+
+#include <fstream>                      /* std::ifstream, std::ofstream     */
+#include <sstream>                      /* std::istringstream               */
+
+#include "ctrl/keystroke.hpp"           /* seq66::keystroke                 */
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "play/sessionlog.hpp"          /* seq66::sessionlog class          */
+#include "util/basic_macros.hpp"        /* seq66::file_error()              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The depth of the inputs being dispatched in this thread.  Anything
+ *  logged while it is above zero was caused by an input already logged.
+ */
+
+static thread_local int s_nesting = 0;
+
+/**
+ *  The names of the kinds, in the order of sessionlog::kind.
+ */
+
+static const char * const s_kind_names [] =
+{
+    "midi", "key", "toggle", "play", "stop", "pause"
+};
+
+static const int c_kind_count = 6;
+
+sessionlog::entry::entry () :
+    se_tick         (0),
+    se_kind         (kind::midi),
+    se_bus          (0),
+    se_status       (0),
+    se_d0           (0),
+    se_d1           (0),
+    se_key          (0),
+    se_press        (false),
+    se_modifiers    (0),
+    se_seqno        (0)
+{
+    // no code
+}
+
+sessionlog::scope::scope ()
+{
+    ++s_nesting;
+}
+
+sessionlog::scope::~scope ()
+{
+    --s_nesting;
+}
+
+sessionlog::sessionlog () :
+    m_entries       (),
+    m_mutex         (),
+    m_enabled       (false),
+    m_filename      ()
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if an input is being dispatched in this thread.
+ */
+
+bool
+sessionlog::nested ()
+{
+    return s_nesting > 0;
+}
+
+/**
+ *  Starts logging, throwing away any earlier entries.
+ *
+ * \param filename
+ *      The full path of the file to write when logging stops.
+ */
+
+void
+sessionlog::start (const std::string & filename)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_entries.reserve(4096);
+    m_filename = filename;
+    m_enabled.store(! filename.empty(), std::memory_order_relaxed);
+}
+
+/**
+ *  Stops logging and writes the file.
+ *
+ * \return
+ *      Returns true if there was a log, and it was written.
+ */
+
+bool
+sessionlog::stop ()
+{
+    bool result = enabled();
+    if (result)
+    {
+        m_enabled.store(false, std::memory_order_relaxed);
+        result = write();
+    }
+    return result;
+}
+
+void
+sessionlog::add (const entry & e)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.push_back(e);
+}
+
+/**
+ *  Logs a MIDI message arriving on an input buss.  SysEx and MIDI clock
+ *  are left out; the clock would swamp the log, and the replay runs on its
+ *  own clock anyway.
+ */
+
+void
+sessionlog::log_midi (midipulse tick, const event & ev)
+{
+    if (loggable() && ! ev.is_ex_data() && ! ev.is_midi_clock())
+    {
+        entry e;
+        e.se_tick = tick;
+        e.se_kind = kind::midi;
+        e.se_bus = ev.input_bus();
+        e.se_status = ev.get_status();
+        ev.get_data(e.se_d0, e.se_d1);
+        add(e);
+    }
+}
+
+void
+sessionlog::log_key (midipulse tick, const keystroke & k)
+{
+    if (loggable())
+    {
+        entry e;
+        e.se_tick = tick;
+        e.se_kind = kind::key;
+        e.se_key = unsigned(k.key());
+        e.se_press = k.is_press();
+        e.se_modifiers = unsigned(k.modifiers());
+        add(e);
+    }
+}
+
+void
+sessionlog::log_toggle (midipulse tick, int seqno)
+{
+    if (loggable())
+    {
+        entry e;
+        e.se_tick = tick;
+        e.se_kind = kind::toggle;
+        e.se_seqno = seqno;
+        add(e);
+    }
+}
+
+/**
+ *  Logs a start, stop, or pause of the transport.
+ *
+ * \param k
+ *      One of kind::play, kind::stop, or kind::pause.
+ */
+
+void
+sessionlog::log_transport (midipulse tick, kind k)
+{
+    if (loggable())
+    {
+        entry e;
+        e.se_tick = tick;
+        e.se_kind = k;
+        add(e);
+    }
+}
+
+/**
+ *  Writes the entries, one per line.  See the format in sessionlog.hpp.
+ */
+
+bool
+sessionlog::write () const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ofstream file(m_filename, std::ios::out | std::ios::trunc);
+    bool result = file.is_open();
+    if (result)
+    {
+        file
+            << "# Seq66 session log, replayed by 'seq66cli --replay'\n"
+            << "# " << m_entries.size() << " entries\n"
+            ;
+        for (const auto & e : m_entries)
+        {
+            file << e.se_tick << " " << s_kind_names[int(e.se_kind)];
+            switch (e.se_kind)
+            {
+            case kind::midi:
+
+                file
+                    << " " << unsigned(e.se_bus)
+                    << " " << unsigned(e.se_status)
+                    << " " << unsigned(e.se_d0)
+                    << " " << unsigned(e.se_d1)
+                    ;
+                break;
+
+            case kind::key:
+
+                file
+                    << " " << e.se_key
+                    << (e.se_press ? " press " : " release ")
+                    << e.se_modifiers
+                    ;
+                break;
+
+            case kind::toggle:
+
+                file << " " << e.se_seqno;
+                break;
+
+            default:
+
+                break;
+            }
+            file << "\n";
+        }
+        result = file.good();
+    }
+    if (! result)
+        file_error("Session log write failed", m_filename);
+
+    return result;
+}
+
+/**
+ *  Parses one line of a log file.
+ *
+ * \return
+ *      Returns true if the line holds an entry.  Blank lines and comments
+ *      return false, as do bad lines.
+ */
+
+bool
+sessionlog::parse_line (const std::string & line, entry & e)
+{
+    std::istringstream is(line);
+    std::string name;
+    bool result = bool(is >> e.se_tick >> name);
+    if (result)
+    {
+        int k = 0;
+        while (k < c_kind_count && name != s_kind_names[k])
+            ++k;
+
+        result = k < c_kind_count;
+        if (result)
+            e.se_kind = static_cast<kind>(k);
+    }
+    if (result)
+    {
+        if (e.se_kind == kind::midi)
+        {
+            unsigned bus, status, d0, d1;
+            result = bool(is >> bus >> status >> d0 >> d1);
+            if (result)
+                result = bus < 256 && status < 256 && d0 < 128 && d1 < 128;
+
+            if (result)
+            {
+                e.se_bus = bussbyte(bus);
+                e.se_status = midibyte(status);
+                e.se_d0 = midibyte(d0);
+                e.se_d1 = midibyte(d1);
+            }
+        }
+        else if (e.se_kind == kind::key)
+        {
+            std::string action;
+            result = bool(is >> e.se_key >> action >> e.se_modifiers);
+            if (result)
+            {
+                result = action == "press" || action == "release";
+                e.se_press = action == "press";
+            }
+        }
+        else if (e.se_kind == kind::toggle)
+            result = bool(is >> e.se_seqno);
+    }
+    return result;
+}
+
+/**
+ *  Reads a log file written by write(), for the replay.
+ *
+ * \return
+ *      Returns true if the file was read and every line was good.
+ */
+
+bool
+sessionlog::read (const std::string & filename)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ifstream file(filename);
+    bool result = file.is_open();
+    m_entries.clear();
+    m_filename = filename;
+    if (result)
+    {
+        std::string line;
+        int lineno = 0;
+        while (std::getline(file, line))
+        {
+            ++lineno;
+            std::size_t pos = line.find_first_not_of(" \t\r");
+            if (pos == std::string::npos || line[pos] == '#')
+                continue;
+
+            entry e;
+            if (parse_line(line, e))
+            {
+                m_entries.push_back(e);
+            }
+            else
+            {
+                msgprintf
+                (
+                    msglevel::error, "%s:%d: bad entry",
+                    filename.c_str(), lineno
+                );
+                result = false;
+                break;
+            }
+        }
+    }
+    else
+        file_error("Session log read failed", filename);
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * sessionlog.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2023-11-14
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Implements three classes:  seq, screenset, and setmapper, which replace a
@@ -73,6 +73,7 @@
  *      -#  TO BE CONTINUED...
  */
 
+#include <algorithm>                    /* std::sort()                      */
 #include <iostream>                     /* std::cout                        */
 
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
@@ -127,7 +128,8 @@ setmapper::setmapper
     m_set_clipboard         (seq::unassigned(), rows, columns),
     m_playscreen            (seq::unassigned()),
     m_playscreen_pointer    (nullptr),
-    m_tracks_mute_state     (m_set_size, false)
+    m_tracks_mute_state     (m_set_size, false),
+    m_play_index            ()
 {
     (void) reset();
 }
@@ -212,10 +214,10 @@ bool
 setmapper::copy_screenset (screenset::number srcset, screenset::number destset)
 {
     const screenset & src = master().screen(srcset);
-    screenset & dest = master().screen(destset);
-    bool result = src.usable() && dest.usable();
+    bool result = src.usable() && ensure_set(destset) != sets().end();
     if (result)
     {
+        screenset & dest = master().screen(destset);
         result = dest.copy_patterns(src);
         if (result)
             recount_sequences();
@@ -245,7 +247,7 @@ bool
 setmapper::paste_screenset (screenset::number destset)
 {
     const screenset & src = m_set_clipboard;
-    bool result = src.usable();
+    bool result = src.usable() && ensure_set(destset) != sets().end();
     if (result)
     {
         screenset & dest = master().screen(destset);
@@ -274,6 +276,24 @@ setmapper::recount_sequences ()
         if (high > m_sequence_high)
             m_sequence_high = high;
     }
+    refresh_play_index();
+}
+
+/**
+ *  Rebuilds the list of active sequences of all sets, from the lists that
+ *  the sets keep, and sorts it by output buss.
+ */
+
+void
+setmapper::refresh_play_index ()
+{
+    m_play_index.clear();
+    for (auto & sset : sets())
+    {
+        const auto & actives = sset.second.active_seqs();
+        m_play_index.insert(m_play_index.end(), actives.begin(), actives.end());
+    }
+    std::sort(m_play_index.begin(), m_play_index.end(), screenset::bus_order);
 }
 
 /**
@@ -365,6 +385,8 @@ setmapper::add_sequence (sequence * s, seq::number & seqno)
             ++m_sequence_count;
             if (n > m_sequence_high)
                 m_sequence_high = n;            /* no way to back out, tho  */
+
+            refresh_play_index();
         }
     }
     return result;
@@ -509,10 +531,55 @@ setmapper::toggle_song_mute (seq::number seqno)
     }
 }
 
+/**
+ *  Mutes, arms, or toggles all of the patterns of the sets, except those
+ *  sets whose bulk operation has been posted for the output thread (see
+ *  performer::post_bulk_op()).
+ *
+ * \param o
+ *      The operation.
+ *
+ * \param skip
+ *      The bits of the sets to leave alone.  The default is none.
+ */
+
+void
+setmapper::bulk_op (bulkops::op o, bulkops::bits skip)
+{
+    for (auto & sset : sets())              /* screenset reference          */
+    {
+        if ((bulkops::set_bit(sset.first) & skip) == 0)
+        {
+            if (o == bulkops::op::mute)
+                sset.second.mute();
+            else if (o == bulkops::op::arm)
+                sset.second.arm();
+            else
+                sset.second.toggle();
+        }
+    }
+}
+
+/**
+ *  Toggles the song-mutes of all of the patterns of the sets, except those
+ *  posted for the output thread.
+ */
+
+void
+setmapper::bulk_song_toggle (bulkops::bits skip)
+{
+    for (auto & sset : sets())
+    {
+        if ((bulkops::set_bit(sset.first) & skip) == 0)
+            sset.second.toggle_song_mute();
+    }
+}
+
 /**
  *  This plays all sets at once.  Could be a useful feature, but the very
  *  large b4uacuse-stress MIDI file reveals a lot of crackling in Yoshimi
- *  playback.  Compare it to the plain play() function.
+ *  playback.  Compare it to the plain play() function.  Only the active
+ *  sequences, as listed in m_play_index, are visited.
  */
 
 void
@@ -523,8 +590,9 @@ setmapper::play_all_sets
     bool resumenoteons
 )
 {
-    for (auto & sset : sets())
-        sset.second.play(tick, mode, resumenoteons);
+    bool songmode = mode == sequence::playback::song;
+    for (auto s : m_play_index)
+        s->play_queue(tick, songmode, resumenoteons);
 }
 
 /**
@@ -579,7 +647,8 @@ setmapper::install_sequence (sequence * s, seq::number & seqno)
 bool
 setmapper::remove_sequence (seq::number seqno)
 {
-    screenset & sset = screen(seqno);       /* tricky                       */
+    screenset::number setno = seq_set(seqno);
+    screenset & sset = master().screen(setno);  /* does not create the set  */
     bool result = ! sset.usable();          /* doesn't exist, we're golden  */
     if (! result)
     {
@@ -588,6 +657,9 @@ setmapper::remove_sequence (seq::number seqno)
         {
             if (m_sequence_count > 1)       /* allow for the dummy sequence */
                 --m_sequence_count;
+
+            (void) master().compact_set(setno);     /* drop it if vacant    */
+            refresh_play_index();
         }
     }
     return result;
@@ -900,8 +972,11 @@ setmapper::set_playscreen (screenset::number setno)
         {
             auto oldset = sets().find(m_playscreen);
             if (oldset != sets().end())
+            {
                 oldset->second.is_playscreen(false);
-
+                if (m_playscreen != setno)
+                    (void) master().compact_set(m_playscreen);
+            }
             m_playscreen = setno;
             sset->second.is_playscreen(true);
             result = true;
@@ -1188,6 +1263,9 @@ setmapper::mute_group_tracks ()
     {
         for (auto & sset : sets())
         {
+            if (! sset.second.active())
+                continue;                           /* nothing to mute      */
+
             bool pscreen = sset.second.is_playscreen();
             int seqoffset = sset.second.offset();
             for (int s = 0; s < m_set_size; ++s)
@@ -1274,15 +1352,22 @@ setmapper::name (screenset::number setno) const
     return result;
 }
 
+/**
+ *  Names a set.  A set that does not exist yet is created to hold a name
+ *  (e.g. one read from a MIDI file), but not just to hold an empty or
+ *  default one, as older files have for every set.
+ */
+
 bool
 setmapper::name (screenset::number setno, const std::string & nm)
 {
-    bool result = sets().find(setno) != sets().end();
+    auto sset = screenset::default_name(nm) ?
+        sets().find(setno) : ensure_set(setno) ;
+
+    bool result = sset != sets().end();
     if (result)
-    {
-        auto & s = sets().at(setno);
-        s.name(nm);
-    }
+        sset->second.name(nm);
+
     return result;
 }
 
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-08-10
- * \updates       2023-11-13
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Implements setmaster.  The difference between the setmaster and setmapper
@@ -71,24 +71,21 @@ setmaster::setmaster (int setrows, int setcolumns) :
 
 /**
  *  Resets back to the constructor set.  This means we have one set, the empty
- *  play-screen, plus a "dummy" set.
+ *  play-screen, plus a "dummy" set.  The other sets are created when first
+ *  used, rather than all Size() of them up front with their slot storage.
  */
 
 bool
 setmaster::reset ()
 {
-    bool result = false;
     clear();
-    for (int i = 0; i < Size(); ++i)
-    {
-        auto setp = add_set(screenset::number(i));
-        result = setp != m_container.end();
-        if (! result)
-            break;
-    }
+    m_highest_set = (-1);
+
+    auto setp = add_set(screenset::number(0));      /* always-present set 0 */
+    bool result = setp != m_container.end();
     if (result)
     {
-        auto setp = add_set(screenset::limit());    /* create the dummy set */
+        setp = add_set(screenset::limit());         /* create the dummy set */
         result = setp != m_container.end();
     }
     return result;
@@ -204,25 +201,82 @@ setmaster::add_set (screenset::number setno)
 }
 
 /**
- *  Removes a set, replacing it with an empty screenset.
- *  This basically just clears the set, and should (must check) remove
- *  it's sequences.
+ *  Gets an existing set, or adds an empty one if the set number is valid.
+ *
+ * \return
+ *      Returns the iterator to the set, or m_container.end() if the number
+ *      is not valid.
+ */
+
+setmaster::container::iterator
+setmaster::ensure_set (screenset::number setno)
+{
+    auto result = m_container.find(setno);
+    if (result == m_container.end() && is_screenset_valid(setno))
+        result = add_set(setno);
+
+    return result;
+}
+
+/**
+ *  Drops a set that has become vacant (see screenset::vacant()), so that it
+ *  no longer takes memory or time in the "for all sets" loops.  Set 0 and
+ *  the play-screen are never dropped; setmapper keeps a pointer to the
+ *  play-screen.
+ *
+ * \return
+ *      Returns true if the set was dropped.
  */
 
 bool
-setmaster::remove_set (screenset::number setno)
+setmaster::compact_set (screenset::number setno)
 {
-    auto item = find_by_value(setno);
-    bool result = item != m_container.end();
-    if (result)
+    bool result = false;
+    if (setno != 0 && setno != screenset::limit())
     {
-        (void) m_container.erase(item);
+        auto item = m_container.find(setno);
+        if (item != m_container.end() && item->second.vacant())
+        {
+            (void) m_container.erase(item);
+            reset_highest_set();
+            result = true;
+        }
+    }
+    return result;
+}
 
-        screenset newset(setno, m_screenset_rows, m_screenset_columns);
-        auto setpair = std::make_pair(setno, newset);
-        auto resultpair = m_container.insert(setpair);
-        result = resultpair.second;
+/**
+ *  Recalculates the highest-numbered set, after a set is dropped.  The map
+ *  is ordered, and the dummy set has the highest key.
+ */
+
+void
+setmaster::reset_highest_set ()
+{
+    m_highest_set = (-1);
+    for (auto it = m_container.rbegin(); it != m_container.rend(); ++it)
+    {
+        if (it->first != screenset::limit())
+        {
+            m_highest_set = it->first;
+            break;
+        }
     }
+}
+
+/**
+ *  Removes a set.  It is cleared, and then dropped unless it is set 0 or the
+ *  play-screen.  Erasing the play-screen's map entry would leave setmapper's
+ *  pointer to it dangling, so that set is cleared in place.
+ */
+
+bool
+setmaster::remove_set (screenset::number setno)
+{
+    bool result = clear_set(setno);
+    if (result)
+        (void) compact_set(setno);
+
     return result;
 }
 
@@ -268,7 +322,7 @@ setmaster::screenset_active_count () const
     int result = 0;
     for (auto & sset : m_container)                 /* screenset reference  */
     {
-        if (sset.second.active_count() > 0)
+        if (sset.second.active())
             ++result;
     }
     return result;
@@ -313,7 +367,8 @@ setmaster::screenset_index (screenset::number setno) const
 }
 
 /**
- *  For each screenset that exists, execute a set-handler function.
+ *  For each screenset that exists, execute a set-handler function.  This
+ *  includes sets that are named but empty, for the set-master list.
  */
 
 bool
@@ -354,7 +409,8 @@ setmaster::exec_set_function (screenset::sethandler s, screenset::slothandler p)
 }
 
 /**
- *  Runs only a slot-handler for each slot (pattern) in each set.
+ *  Runs only a slot-handler for each slot (pattern) in each set.  A set with
+ *  no active pattern has nothing for the handler, and is skipped.
  */
 
 bool
@@ -363,7 +419,7 @@ setmaster::exec_set_function (screenset::slothandler p)
     bool result = false;
     for (auto & sset : m_container)                 /* screenset reference  */
     {
-        if (sset.second.usable())
+        if (sset.second.usable() && sset.second.active())
         {
             result = sset.second.exec_slot_function(p);
             if (! result)
@@ -434,16 +490,20 @@ setmaster::swap_sets (screenset::number set0, screenset::number set1)
 bool
 setmaster::swap_sets (screenset::number set0, screenset::number set1)
 {
-    screenset & copy0 = screen(set0);
-    screenset & copy1 = screen(set1);
-    bool result = copy0.usable() && copy1.usable();
+    bool result = ensure_set(set0) != m_container.end() &&
+        ensure_set(set1) != m_container.end();
+
     if (result)
     {
+        screenset & copy0 = screen(set0);
+        screenset & copy1 = screen(set1);
         screenset tempsrc = screen(set0);
         copy0.change_set_number(set1);              /* also changes seq #s  */
         copy1.change_set_number(set0);              /* also changes seq #s  */
         copy0.copy_patterns(copy1);
         copy1.copy_patterns(tempsrc);
+        (void) compact_set(set0);
+        (void) compact_set(set1);
     }
     return result;
 }
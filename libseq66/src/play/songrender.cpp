@@ -0,0 +1,451 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songrender.cpp
+ *
+ *  This module defines the offline rendering of a song to a MIDI file.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Usage:
+ *
+\verbatim
+    seq66cli --render [--live] [--measures n] [--loop l r n]
+        [--output-dir dir] file ...
+\endverbatim
+ *
+ *  Each frame ends at the next tick at which any pattern has something to
+ *  do (as in performer::next_output_tick(), but over all of the sets), and
+ *  at most a measure later.
+ *  A tempo event changes the tempo in the frame that ends on it, so the
+ *  tempo changes land at their exact ticks.  The virtual clock never jumps
+ *  back: after each pass of the L/R loop, the output ticks are offset by
+ *  the length of the loop, so the rendered file plays straight through.
+ *
+ *  The whole song is played by one thread, in the order of the patterns,
+ *  as performer::play() does with no output workers.
+ */
+
+#include <cstdlib>                      /* EXIT_SUCCESS, EXIT_FAILURE       */
+#include <iostream>                     /* std::cout                        */
+#include <map>                          /* std::map                         */
+
+#include "cfg/settings.hpp"             /* seq66::rc(), usr(), choose_ppqn()*/
+#include "midi/midifile.hpp"            /* seq66::midifile, read_midi_file()*/
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/playpool.hpp"            /* seq66::playpool                  */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "play/songrender.hpp"          /* seq66::songrender class          */
+#include "util/filefunctions.hpp"       /* seq66::filename_concatenate()    */
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Every rendered event is held in memory until the file is written, so
+ *  the measures, and the extra passes of a loop, are bounded to keep the
+ *  output file (and the memory) a size a MIDI player can still load.
+ */
+
+static const int c_render_measures_max = 100000;
+static const int c_render_loops_max = 1000;
+
+songrender::songrender () :
+    m_files         (),
+    m_output_dir    (),
+    m_live          (false),
+    m_measures      (0),
+    m_loop_left     (0),
+    m_loop_right    (0),
+    m_loops         (0)
+{
+    // no code
+}
+
+/**
+ * \return
+ *      Returns true if "--render" is on the command line.
+ */
+
+bool
+songrender::requested (int argc, char * argv [])
+{
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--render")
+            return true;
+    }
+    return false;
+}
+
+void
+songrender::show_help ()
+{
+    std::cout <<
+"Offline render options (no MIDI ports are opened):\n\n"
+"  --render             Play the songs of the files offline, as fast as\n"
+"                       possible, and write what they send to MIDI files.\n"
+"  --live               Arm every pattern and play in Live mode, instead\n"
+"                       of following the triggers in Song mode.\n"
+"  --measures n         Measures to render (default: the whole song, or\n"
+"                       the longest pattern in Live mode).\n"
+"  --loop l r n         Play measures l up to r an extra n times.\n"
+"  --output-dir dir     Write the files to dir, not next to the inputs.\n"
+    ;
+}
+
+/**
+ *  Gets the render options and the list of files.
+ *
+ * \return
+ *      Returns true if the options are good and at least one file is given.
+ */
+
+bool
+songrender::parse (int argc, char * argv [])
+{
+    bool result = true;
+    for (int argn = 1; argn < argc; ++argn)
+    {
+        std::string arg = argv[argn];
+        if (arg == "--render")
+        {
+            // already handled by requested()
+        }
+        else if (arg == "--live")
+            m_live = true;
+        else if (arg == "--measures" || arg == "--output-dir")
+        {
+            if (++argn < argc)
+            {
+                if (arg == "--measures")
+                {
+                    m_measures = std::atoi(argv[argn]);
+                    result = m_measures > 0 &&
+                        m_measures <= c_render_measures_max;
+                }
+                else
+                    m_output_dir = argv[argn];
+            }
+            else
+                result = false;
+        }
+        else if (arg == "--loop")
+        {
+            result = argn + 3 < argc;
+            if (result)
+            {
+                m_loop_left = std::atoi(argv[++argn]);
+                m_loop_right = std::atoi(argv[++argn]);
+                m_loops = std::atoi(argv[++argn]);
+                result = m_loop_left >= 0 && m_loop_right > m_loop_left &&
+                    m_loops > 0 && m_loops <= c_render_loops_max;
+            }
+        }
+        else if (arg.length() > 1 && arg[0] == '-')
+            result = false;
+        else
+            m_files.push_back(arg);
+
+        if (! result)
+        {
+            errprintf("Bad render option '%s'", arg.c_str());
+            break;
+        }
+    }
+    if (result && m_files.empty())
+    {
+        errprint("No files to render");
+        result = false;
+    }
+    if (! result)
+        show_help();
+
+    return result;
+}
+
+/**
+ *  Renders each file.  Each render gets its own performer, never launched,
+ *  so that there is no master buss.
+ *
+ * \return
+ *      Returns EXIT_SUCCESS if every file was rendered.
+ */
+
+int
+songrender::run ()
+{
+    int failures = 0;
+    for (const auto & fname : m_files)
+    {
+        int ppqn = choose_ppqn();
+        performer p(ppqn, usr().mainwnd_rows(), usr().mainwnd_cols());
+        (void) p.get_settings(rc(), usr());
+        if (! render(p, fname))
+            ++failures;
+    }
+    if (failures > 0)
+        errprintf("Render: %d failure(s)", failures);
+
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS ;
+}
+
+/**
+ *  Reads one file, plays it offline, and writes what was played, one track
+ *  for each output buss, plus a first track for the tempo changes.  The
+ *  tracks are free-channel, so each event keeps the channel it was played
+ *  on.
+ *
+ *  The events captured in a frame fall in the frame, except for the
+ *  note-offs of sequence::off_playing_notes(), which have no time stamp;
+ *  those are placed at the start of the frame.
+ */
+
+bool
+songrender::render (performer & p, const std::string & infile)
+{
+    std::string errmsg;
+    std::string outfile = output_name(infile);
+    usr().clear_global_seq_features();
+    bool result = read_midi_file(p, infile, p.ppqn(), errmsg, false);
+    if (! result)
+    {
+        file_error(errmsg, infile);
+        return false;
+    }
+
+    bool songmode = ! m_live;
+    std::vector<sequence *> seqs;
+    midipulse longest = 0;
+    p.song_mode(songmode);
+    for (int s = 0; s < p.sequence_high(); ++s)
+    {
+        if (p.is_seq_active(s))
+        {
+            seq::pointer sp = p.get_sequence(s);
+            if (m_live)
+                (void) sp->set_armed(true);
+
+            if (sp->get_length() > longest)
+                longest = sp->get_length();
+
+            seqs.push_back(sp.get());
+        }
+    }
+
+    midipulse measure = midipulse(p.ppqn()) * 4 * p.get_beats_per_bar() /
+        p.get_beat_width();
+
+    midipulse endtick = m_measures > 0 ? m_measures * measure :
+        (songmode ? p.get_max_trigger() : longest) ;
+
+    if (seqs.empty() || endtick <= 0)
+    {
+        file_error("Nothing to render", infile);
+        return false;
+    }
+
+    midipulse ltick = m_loop_left * measure;
+    midipulse rtick = m_loop_right * measure;
+    int loopsleft = rtick <= endtick ? m_loops : 0 ;
+    midibpm bpm = p.get_beats_per_minute();
+    std::vector<event> tempos;
+    std::map<bussbyte, std::vector<event>> tracks;
+    tempos.push_back(create_tempo_event(0, bpm));
+
+    midipulse base = 0;                         /* output offset of loops   */
+    midipulse tick = 0;                         /* performer's virtual tick */
+    midipulse framestart = 0;
+    playpool local(0);
+    auto collect = [&] (playpool::messages & msgs)
+    {
+        for (auto & m : msgs)
+        {
+            event ev = m.m_event;
+            if (ev.timestamp() < framestart)
+                ev.set_timestamp(framestart);
+
+            ev.set_timestamp(ev.timestamp() + base);
+            if (ev.has_channel())
+                ev.set_status(ev.get_status(m.m_channel));
+
+            tracks[m.m_bus].push_back(ev);
+        }
+    };
+    auto stop = [&seqs, songmode] (int j)
+    {
+        seqs[std::size_t(j)]->stop(songmode);   /* as reset_sequences()     */
+    };
+    auto nexttick = [&seqs, songmode] (midipulse tk)
+    {
+        midipulse result = c_null_midipulse;    /* as next_output_tick()    */
+        for (auto sp : seqs)
+        {
+            midipulse t = sp->next_event_tick(tk, songmode);
+            if (! is_null_midipulse(t))
+            {
+                if (is_null_midipulse(result) || t < result)
+                    result = t;
+            }
+        }
+        return result;
+    };
+    p.set_last_ticks(0);
+    for (;;)
+    {
+        p.set_tick(tick);
+        collect
+        (
+            local.run
+            (
+                int(seqs.size()), [&seqs, &tick, songmode] (int j)
+                {
+                    seqs[std::size_t(j)]->play_queue(tick, songmode, false);
+                }
+            )
+        );
+
+        (void) p.apply_scheduled_tempo();       /* posted by the patterns   */
+        midibpm newbpm = p.get_beats_per_minute();
+        if (newbpm != bpm)
+        {
+            bpm = newbpm;
+            tempos.push_back(create_tempo_event(tick + base, bpm));
+        }
+        if (loopsleft > 0 && tick == rtick - 1)
+        {
+            framestart = tick;
+            collect(local.run(int(seqs.size()), stop));
+            p.set_last_ticks(ltick);
+            base += rtick - ltick;
+            framestart = tick = ltick;
+            --loopsleft;
+            continue;
+        }
+        if (tick >= endtick)
+            break;
+
+        midipulse next = nexttick(tick);
+        if (is_null_midipulse(next) || next > tick + measure)
+            next = tick + measure;
+        else if (next <= tick)
+            next = tick + 1;
+
+        if (loopsleft > 0 && next >= rtick)
+            next = rtick - 1;
+
+        if (next > endtick)
+            next = endtick;
+
+        framestart = tick + 1;
+        tick = next;
+    }
+    framestart = tick;
+    collect(local.run(int(seqs.size()), stop));
+
+    /*
+     *  Now fill a fresh performer with the tracks and write it as a plain
+     *  SMF 1 file.
+     */
+
+    midipulse outlength = ((tick + base) / measure + 1) * measure;
+    performer out(p.ppqn(), usr().mainwnd_rows(), usr().mainwnd_cols());
+    (void) out.get_settings(rc(), usr());
+    out.set_beats_per_bar(p.get_beats_per_bar());
+    (void) out.set_beat_width(p.get_beat_width());
+    (void) out.set_beats_per_minute(tempos.front().tempo());
+    auto fill = [&out, outlength]
+    (
+        seq::number seqno, const std::string & name,
+        const std::vector<event> & evs
+    )
+    {
+        seq::number finalseq = seqno;
+        bool ok = out.new_sequence(finalseq, seqno);
+        if (ok)
+        {
+            seq::pointer sp = out.get_sequence(finalseq);
+            (void) sp->set_length(outlength);
+            (void) sp->set_midi_channel(null_channel());
+            sp->set_name(name);
+            for (const auto & ev : evs)
+                (void) sp->append_event(ev);
+
+            sp->sort_events();
+        }
+        return ok;
+    };
+    seq::number seqno = 0;
+    result = fill(seqno++, "Tempo", tempos);
+    for (const auto & t : tracks)
+    {
+        if (! result)
+            break;
+
+        std::string name = "Buss " + std::to_string(int(t.first));
+        result = fill(seqno++, name, t.second);
+    }
+    if (result)
+    {
+        midifile f(outfile, p.ppqn(), false);
+        result = f.write(out, false);
+        if (! result)
+            errmsg = f.error_message();
+    }
+    else
+        errmsg = "Could not create the rendered tracks";
+
+    if (result)
+        file_message("Rendered", outfile);
+    else
+        file_error(errmsg, infile);
+
+    return result;
+}
+
+std::string
+songrender::output_name (const std::string & infile) const
+{
+    if (m_output_dir.empty())
+        return file_extension_set(infile, "-render.mid");
+    else
+        return filename_concatenate
+        (
+            m_output_dir, filename_base(infile, true), "-render.mid"
+        );
+}
+
+}           // namespace seq66
+
+/*
+ * songrender.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,13 +25,13 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2021-01-22
- * \updates       2023-09-17
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
 
+#include <cstdio>                       /* std::snprintf()                  */
 #include <fstream>                      /* std::ifstream and std::ofstream  */
-#include <iomanip>                      /* std::hex etc.                    */
 #include <map>                          /* std::map<> template              */
 
 #include "cfg/settings.hpp"             /* seq66::rc() and choose_ppqn()    */
@@ -39,6 +39,7 @@
 #include "play/performer.hpp"           /* must precede songsummary.hpp !   */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
 #include "play/songsummary.hpp"         /* seq66::songsummary               */
+#include "util/filefunctions.hpp"       /* seq66::file_extension()          */
 #include "util/strfunctions.hpp"        /* seq66::bool_to_string()          */
 
 /*
@@ -80,20 +81,106 @@ s_tag_names_container
     { c_seq_color,      "Color" },
     { c_seq_edit_mode,  "Normal/drum edit mode, not saved/used" },
     { c_seq_loopcount,  "N-repeat for pattern" },
-    { c_reserved_3,     "Reserved 3" },
-    { c_reserved_4,     "Reserved 4" },
+    { c_seq_modlanes,   "Modulation lanes" },
+    { c_seq_filter,     "Output filter" },
     { c_trig_transpose, "Transposable trigger" }
 };
 
+
+/**
+ *  The room reserved in the buffer for each pattern, and for each trigger,
+ *  so that it is rarely grown while formatting.
+ */
+
+static const std::size_t c_pattern_room = 320;
+static const std::size_t c_trigger_room = 64;
+
+/**
+ *  Appends a string as a JSON string, quoted and escaped.
+ */
+
+static void
+append_json (std::string & b, const std::string & s)
+{
+    b += '"';
+    for (char c : s)
+    {
+        switch (c)
+        {
+        case '"':   b += "\\\"";    break;
+        case '\\':  b += "\\\\";    break;
+        case '\n':  b += "\\n";     break;
+        case '\r':  b += "\\r";     break;
+        case '\t':  b += "\\t";     break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char tmp[8];
+                (void) std::snprintf(tmp, sizeof tmp, "\\u%04x", unsigned(c));
+                b += tmp;
+            }
+            else
+                b += c;
+            break;
+        }
+    }
+    b += '"';
+}
+
+/**
+ *  Appends a string as a CSV field, quoted (with quotes doubled) if it has
+ *  a comma, a quote, or a line break.
+ */
+
+static void
+append_csv (std::string & b, const std::string & s)
+{
+    if (s.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        b += s;
+    }
+    else
+    {
+        b += '"';
+        for (char c : s)
+        {
+            if (c == '"')
+                b += '"';
+
+            b += c;
+        }
+        b += '"';
+    }
+}
+
+/**
+ *  Appends a number in the default format of an ostream, so that the text
+ *  summary reads as it always has.
+ */
+
+static void
+append_number (std::string & b, double d)
+{
+    char tmp[32];
+    (void) std::snprintf(tmp, sizeof tmp, "%g", d);
+    b += tmp;
+}
+
 /**
  *  Principal constructor.
  *
  * \param name
  *      Provides the name of the MIDI file to be read or written.
+ *
+ * \param f
+ *      The format of the summary, text by default.
  */
 
-songsummary::songsummary (const std::string & name) :
-    m_name (name)
+songsummary::songsummary (const std::string & name, format f) :
+    m_name      (name),
+    m_format    (f),
+    m_buffer    (),
+    m_summary   ()
 {
     // no other code needed
 }
@@ -107,8 +194,49 @@ songsummary::~songsummary ()
     // empty body
 }
 
+/**
+ * \return
+ *      Returns the format implied by the extension of the file name:
+ *      ".json", ".csv", or anything else for text.
+ */
+
+songsummary::format
+songsummary::format_from_name (const std::string & filename)
+{
+    return format_from_string(file_extension(filename));
+}
+
+/**
+ * \return
+ *      Returns the format named "json" or "csv"; otherwise, text.
+ */
+
+songsummary::format
+songsummary::format_from_string (const std::string & s)
+{
+    if (s == "json")
+        return format::json;
+    else if (s == "csv")
+        return format::csv;
+    else
+        return format::text;
+}
+
+std::string
+songsummary::format_extension (format f)
+{
+    switch (f)
+    {
+    case format::json:  return ".json";
+    case format::csv:   return ".csv";
+    default:            return ".text";
+    }
+}
+
 /**
  *  Write the whole MIDI data and Seq24 information out to a text file.
+ *  The summary is formatted into a buffer (see format_summary()), which is
+ *  written with one call.
  *
  * \param p
  *      Provides the object that will contain and manage the entire
@@ -131,10 +259,38 @@ songsummary::write (performer & p, bool doseqspec)
     bool result = file.is_open();
     if (result)
     {
-        result = write_header(file, p);
+        result = format_summary(p, doseqspec);
+        file.write(m_buffer.data(), std::streamsize(m_buffer.size()));
+        if (! file.good())
+            result = false;
     }
+    return result;
+}
+
+/**
+ *  Formats the whole summary into m_buffer.
+ *
+ * \return
+ *      Returns false if the song has no patterns, or the SeqSpec section
+ *      failed.
+ */
+
+bool
+songsummary::format_summary (performer & p, bool doseqspec)
+{
+    int numtracks = 0;
+    for (int i = 0; i < p.sequence_high(); ++i)
+    {
+        if (p.is_seq_active(i))
+            ++numtracks;             /* count number of active tracks   */
+    }
+    m_buffer.clear();
+    m_buffer.reserve(std::size_t(numtracks + 1) * c_pattern_room);
+
+    bool result = write_header(p, numtracks);
     if (result)
     {
+        bool first = true;
         for (int track = 0; track < p.sequence_high(); ++track)
         {
             if (p.is_seq_active(track))
@@ -142,67 +298,212 @@ songsummary::write (performer & p, bool doseqspec)
                 seq::pointer s = p.get_sequence(track);
                 if (s)
                 {
-                    result = write_sequence(file, s);
-                    if (! result)
-                        break;
+                    s->get_summary(m_summary);
+                    m_buffer.reserve
+                    (
+                        m_buffer.size() + c_pattern_room +
+                            m_summary.sm_triggers.size() * c_trigger_room
+                    );
+                    if (m_format == format::json)
+                        write_sequence_json(m_summary, first);
+                    else if (m_format == format::csv)
+                        write_sequence_csv(m_summary);
+                    else
+                        write_sequence(m_summary);
+
+                    first = false;
                 }
             }
         }
+        if (m_format == format::json)
+            m_buffer += "\n  ]";
     }
     if (result && doseqspec)
     {
-        result = write_proprietary_track(file, p);
+        if (m_format == format::json)
+            write_proprietary_json(p);
+        else if (m_format == format::text)
+            result = write_proprietary_track(p);
+
         if (! result)
         {
             file_error("SeqSpec write failed", name());
         }
     }
+    if (m_format == format::json && numtracks > 0)
+        m_buffer += "\n}\n";
+
     return result;
 }
 
-bool
-songsummary::write_sequence (std::ofstream & file, seq::pointer s)
+void
+songsummary::write_sequence (const sequence::summary & sm)
 {
-    int triggercount = s->trigger_count();
-    file
-        << "Sequence #" << s->seq_number() << " '" << s->name() << "'\n"
-        << "   Input port #: " << int(s->seq_midi_in_bus()) << "-->"
-                               << int(s->true_in_bus()) << "\n"
-        << "  Output port #: " << int(s->seq_midi_bus()) << "-->"
-                               << int(s->true_bus()) << "\n"
-        << "        Channel: " << int(s->seq_midi_channel()) << "\n"
-        << "          Beats: " << s->get_beats_per_bar() << "/"
-                               << s->get_beat_width() << "\n"
-        << " Length (ticks): " << long(s->get_length()) << "\n"
-        << "Events;triggers: " << s->event_count() << "; "
-                               << triggercount << "\n"
-        << "   Transposable: " << bool_to_string(s->transposable()) << "\n"
-        << "  Key and scale: " << int(s->musical_key()) << "; "
-                               << int(s->musical_scale()) << "\n"
-        ;
-    if (s->color() >= 0)
+    std::string & b = m_buffer;
+    int triggercount = int(sm.sm_triggers.size());
+    b += "Sequence #";
+    b += std::to_string(sm.sm_number);
+    b += " '";
+    b += sm.sm_name;
+    b += "'\n   Input port #: ";
+    b += std::to_string(sm.sm_in_bus);
+    b += "-->";
+    b += std::to_string(sm.sm_true_in_bus);
+    b += "\n  Output port #: ";
+    b += std::to_string(sm.sm_bus);
+    b += "-->";
+    b += std::to_string(sm.sm_true_bus);
+    b += "\n        Channel: ";
+    b += std::to_string(sm.sm_channel);
+    b += "\n          Beats: ";
+    b += std::to_string(sm.sm_beats_per_bar);
+    b += "/";
+    b += std::to_string(sm.sm_beat_width);
+    b += "\n Length (ticks): ";
+    b += std::to_string(long(sm.sm_length));
+    b += "\nEvents;triggers: ";
+    b += std::to_string(sm.sm_event_count);
+    b += "; ";
+    b += std::to_string(triggercount);
+    b += "\n   Transposable: ";
+    b += bool_to_string(sm.sm_transposable);
+    b += "\n  Key and scale: ";
+    b += std::to_string(sm.sm_key);
+    b += "; ";
+    b += std::to_string(sm.sm_scale);
+    b += "\n";
+    if (sm.sm_color >= 0)
     {
+        b += "          Color: ";
+        b += std::to_string(sm.sm_color);
 #if defined SEQ66_COLORS_NOT_REQUIRING_A_GUI
-        PaletteColor pc = PaletteColor(s->color());
-        std::string colorname = get_color_name(pc);
-        file << "          Color: " << s->color() << " " << colorname << "\n";
-#else
-        file << "          Color: " << s->color() << "\n";
+        PaletteColor pc = PaletteColor(sm.sm_color);
+        b += " ";
+        b += get_color_name(pc);
 #endif
+        b += "\n";
     }
 
     /*
      * The format of c_triggers_ex:  0x24240008, followed by a length value
      * of 4 + triggercount * 12.  Each trigger has three 4-byte values:
      * trigger-on, trigger-off, and trigger-offset.  The c_trig_transpose
-     * (0x24240020) tag adds a byte value for trigger transposition.
+     * (0x24240020) tag adds a byte value for trigger transposition.  The
+     * listing is that of triggers::to_string().
      */
 
     if (triggercount > 0)
     {
-        file << s->trigger_listing() << std::endl;
+        b += std::to_string(triggercount);
+        b += " triggers:\n";
+        for (const auto & t : sm.sm_triggers)
+        {
+            b += "   ";
+            b += t.to_string();
+            b += "\n";
+        }
+        b += "\n";
+    }
+}
+
+void
+songsummary::write_sequence_json (const sequence::summary & sm, bool first)
+{
+    std::string & b = m_buffer;
+    b += first ? "\n    {" : ",\n    {" ;
+    b += "\"number\": ";
+    b += std::to_string(sm.sm_number);
+    b += ", \"name\": ";
+    append_json(b, sm.sm_name);
+    b += ", \"input_bus\": ";
+    b += std::to_string(sm.sm_in_bus);
+    b += ", \"true_input_bus\": ";
+    b += std::to_string(sm.sm_true_in_bus);
+    b += ", \"bus\": ";
+    b += std::to_string(sm.sm_bus);
+    b += ", \"true_bus\": ";
+    b += std::to_string(sm.sm_true_bus);
+    b += ", \"channel\": ";
+    b += std::to_string(sm.sm_channel);
+    b += ", \"beats_per_bar\": ";
+    b += std::to_string(sm.sm_beats_per_bar);
+    b += ", \"beat_width\": ";
+    b += std::to_string(sm.sm_beat_width);
+    b += ", \"length\": ";
+    b += std::to_string(long(sm.sm_length));
+    b += ", \"events\": ";
+    b += std::to_string(sm.sm_event_count);
+    b += ", \"notes\": ";
+    b += std::to_string(sm.sm_note_count);
+    b += ", \"playables\": ";
+    b += std::to_string(sm.sm_playable_count);
+    b += ", \"transposable\": ";
+    b += bool_to_string(sm.sm_transposable);
+    b += ", \"key\": ";
+    b += std::to_string(sm.sm_key);
+    b += ", \"scale\": ";
+    b += std::to_string(sm.sm_scale);
+    b += ", \"color\": ";
+    b += std::to_string(sm.sm_color);
+    b += ", \"triggers\": [";
+
+    bool firsttrigger = true;
+    for (const auto & t : sm.sm_triggers)
+    {
+        b += firsttrigger ? "{\"start\": " : ", {\"start\": " ;
+        b += std::to_string(long(t.tick_start()));
+        b += ", \"end\": ";
+        b += std::to_string(long(t.tick_end()));
+        b += ", \"offset\": ";
+        b += std::to_string(long(t.offset()));
+        b += ", \"transpose\": ";
+        b += std::to_string(t.transpose());
+        b += "}";
+        firsttrigger = false;
     }
-    return true;
+    b += "]}";
+}
+
+void
+songsummary::write_sequence_csv (const sequence::summary & sm)
+{
+    std::string & b = m_buffer;
+    b += std::to_string(sm.sm_number);
+    b += ',';
+    append_csv(b, sm.sm_name);
+    b += ',';
+    b += std::to_string(sm.sm_in_bus);
+    b += ',';
+    b += std::to_string(sm.sm_true_in_bus);
+    b += ',';
+    b += std::to_string(sm.sm_bus);
+    b += ',';
+    b += std::to_string(sm.sm_true_bus);
+    b += ',';
+    b += std::to_string(sm.sm_channel);
+    b += ',';
+    b += std::to_string(sm.sm_beats_per_bar);
+    b += ',';
+    b += std::to_string(sm.sm_beat_width);
+    b += ',';
+    b += std::to_string(long(sm.sm_length));
+    b += ',';
+    b += std::to_string(sm.sm_event_count);
+    b += ',';
+    b += std::to_string(sm.sm_note_count);
+    b += ',';
+    b += std::to_string(sm.sm_playable_count);
+    b += ',';
+    b += std::to_string(sm.sm_triggers.size());
+    b += ',';
+    b += bool_to_string(sm.sm_transposable);
+    b += ',';
+    b += std::to_string(sm.sm_key);
+    b += ',';
+    b += std::to_string(sm.sm_scale);
+    b += ',';
+    b += std::to_string(sm.sm_color);
+    b += '\n';
 }
 
 /**
@@ -213,11 +514,9 @@ songsummary::write_sequence (std::ofstream & file, seq::pointer s)
  */
 
 void
-songsummary::write_mute_groups
-(
-    std::ofstream & file, const performer & p
-)
+songsummary::write_mute_groups (const performer & p)
 {
+    std::string & b = m_buffer;
     bool got_mutes = false;
     const mutegroups & mutes = p.mutes();
     for (const auto & stz : mutes.list())
@@ -231,56 +530,87 @@ songsummary::write_mute_groups
             ok = mutebits.size() > 0;
             if (ok)
             {
+                char tmp[32];
                 int count = 0;
                 got_mutes = true;
-                file << "Mute group #" << std::setw(2) << groupnumber << ": ";
+                (void) std::snprintf
+                (
+                    tmp, sizeof tmp, "Mute group #%2d: ", groupnumber
+                );
+                b += tmp;
                 for (auto mutestatus : mutebits)
                 {
-                    file << (bool(mutestatus) ? "1" : "0");
+                    b += bool(mutestatus) ? '1' : '0' ;
                     if (++count % 8 == 0)
-                        file << " ";
+                        b += ' ';
                 }
-                file << " \"" << m.name() << "\"" << std::endl;
+                b += " \"";
+                b += m.name();
+                b += "\"\n";
             }
             else
-                file << "Mute group #" << groupnumber << " error" << std::endl;
+            {
+                b += "Mute group #";
+                b += std::to_string(groupnumber);
+                b += " error\n";
+            }
         }
         else
         {
-            file << "Mute group #" << groupnumber << " empty" << std::endl;
+            b += "Mute group #";
+            b += std::to_string(groupnumber);
+            b += " empty\n";
         }
     }
     if (! got_mutes)
-        file << "All mute-groups are of size 0" << std::endl;
+        b += "All mute-groups are of size 0\n";
 }
 
 bool
-songsummary::write_header (std::ofstream & file, const performer & p)
+songsummary::write_header (const performer & p, int numtracks)
 {
-    int numtracks = 0;
-    for (int i = 0; i < p.sequence_high(); ++i)
+    std::string & b = m_buffer;
+    bool result = numtracks > 0;
+    if (m_format == format::json)
     {
-        if (p.is_seq_active(i))
-            ++numtracks;             /* count number of active tracks   */
+        if (result)
+        {
+            b += "{\n  \"file\": ";
+            append_json(b, name());
+            b += ",\n  \"sets\": ";
+            b += std::to_string(p.screenset_count());
+            b += ",\n  \"tracks\": ";
+            b += std::to_string(numtracks);
+            b += ",\n  \"midi_format\": 1,\n  \"ppqn\": ";
+            b += std::to_string(p.ppqn());
+            b += ",\n  \"patterns\": [";
+        }
     }
-
-    bool result = numtracks > 0;
-    if (result)
+    else if (m_format == format::csv)
     {
-        file
-            << "File name:      " << name() << "\n"
-            << "No. of sets:    " << p.screenset_count() << "\n"
-            << "No. of tracks:  " << numtracks << "\n"
-            << "MIDI format:    " << 1 << "\n"
-            << "PPQN:           " << p.ppqn() << "\n"
+        b +=
+            "number,name,input_bus,true_input_bus,bus,true_bus,channel,"
+            "beats_per_bar,beat_width,length,events,notes,playables,"
+            "triggers,transposable,key,scale,color\n"
             ;
     }
+    else if (result)
+    {
+        b += "File name:      ";
+        b += name();
+        b += "\nNo. of sets:    ";
+        b += std::to_string(p.screenset_count());
+        b += "\nNo. of tracks:  ";
+        b += std::to_string(numtracks);
+        b += "\nMIDI format:    1\nPPQN:           ";
+        b += std::to_string(p.ppqn());
+        b += "\n";
+    }
     else
     {
-        file
-            << "File name:      " << name() << "\n"
-            << "No. of tracks:  " << 0 << "! Aborting!\n"
-            ;
+        b += "File name:      ";
+        b += name();
+        b += "\nNo. of tracks:  0! Aborting!\n";
     }
     return result;
 }
@@ -313,62 +643,56 @@ songsummary::write_header (std::ofstream & file, const performer & p)
  */
 
 void
-songsummary::write_prop_header
-(
-    std::ofstream & file,
-    midilong control_tag,
-    int value
-)
+songsummary::write_prop_header (midilong control_tag, int value)
 {
-    std::string ctagname = "Unknown";
+    static const std::string s_unknown = "Unknown";
     std::map<midilong, std::string>::const_iterator ci =
         s_tag_names_container.find(control_tag);
 
-    if (ci != s_tag_names_container.end())
-        ctagname = ci->second;
-
-    file
-        << "0xFF 0x7F " << std::hex << control_tag << std::dec
-        << " " << ctagname << " = "
-        << value << "\n"
-        ;
+    const std::string & ctagname = ci != s_tag_names_container.end() ?
+        ci->second : s_unknown ;
+
+    char tmp[32];
+    (void) std::snprintf
+    (
+        tmp, sizeof tmp, "0xFF 0x7F %lx ",
+        static_cast<unsigned long>(control_tag)
+    );
+    m_buffer += tmp;
+    m_buffer += ctagname;
+    m_buffer += " = ";
+    m_buffer += std::to_string(value);
+    m_buffer += "\n";
 }
 
 void
-songsummary::write_set_names
-(
-    std::ofstream & file,
-    const performer & p
-)
+songsummary::write_set_names (const performer & p)
 {
-    int setcount = p.screenset_count();
-    file << "Screen-set Notes:" << "\n";
-    write_prop_header(file, c_notes, setcount);
+    int setcount = p.highest_set() + 1;         /* sets are sparse          */
+    m_buffer += "Screen-set Notes:\n";
+    write_prop_header(c_notes, setcount);
     for (int s = 0; s < setcount; ++s)
     {
-        const std::string & note = p.set_name(s);
-        file << "   Set #" <<std::dec << s << ": '" << note << "'\n";
+        m_buffer += "   Set #";
+        m_buffer += std::to_string(s);
+        m_buffer += ": '";
+        m_buffer += p.set_name(s);
+        m_buffer += "'\n";
     }
 }
 
 void
-songsummary::write_bpm
-(
-    std::ofstream & file,
-    const performer & p
-)
+songsummary::write_bpm (const performer & p)
 {
     midibpm bpm = p.get_beats_per_minute();
-    write_prop_header(file, c_bpmtag, bpm);
-    file << "        BPM: " << bpm << "\n";
+    write_prop_header(c_bpmtag, bpm);
+    m_buffer += "        BPM: ";
+    append_number(m_buffer, bpm);
+    m_buffer += "\n";
 }
 
 void
-songsummary::write_mutes
-(
-    std::ofstream & file,
-    const performer & p
-)
+songsummary::write_mutes (const performer & p)
 {
     const mutegroups & mutes = p.mutes();
     unsigned groupcount = c_max_groups;         /* 32, the maximum          */
@@ -379,31 +703,31 @@ songsummary::write_mutes
         setsize = unsigned(mutes.group_count());
     }
 
-    write_prop_header(file, c_mutegroups, c_max_groups);
-    file << "Mute Groups: " << groupcount << " of size " << setsize << "\n";
-    write_mute_groups(file, p);
+    write_prop_header(c_mutegroups, c_max_groups);
+    m_buffer += "Mute Groups: ";
+    m_buffer += std::to_string(groupcount);
+    m_buffer += " of size ";
+    m_buffer += std::to_string(setsize);
+    m_buffer += "\n";
+    write_mute_groups(p);
 }
 
 void
-songsummary::write_global_bg (std::ofstream & file)
+songsummary::write_global_bg ()
 {
-    file << "Global key, scale, and background sequence:" << "\n";
-    write_prop_header(file, c_musickey, usr().seqedit_key());
-    write_prop_header(file, c_musicscale, usr().seqedit_scale());
-    write_prop_header(file, c_backsequence, usr().seqedit_bgsequence());
+    m_buffer += "Global key, scale, and background sequence:\n";
+    write_prop_header(c_musickey, usr().seqedit_key());
+    write_prop_header(c_musicscale, usr().seqedit_scale());
+    write_prop_header(c_backsequence, usr().seqedit_bgsequence());
 }
 
 void
-songsummary::write_beat_info
-(
-    std::ofstream & file,
-    const performer & p
-)
+songsummary::write_beat_info (const performer & p)
 {
-    file << "Global beats, beat width, and tempo track:" << "\n";
-    write_prop_header(file, c_perf_bp_mes, p.get_beats_per_bar());
-    write_prop_header(file, c_perf_bw, p.get_beat_width());
-    write_prop_header(file, c_tempo_track, rc().tempo_track_number());
+    m_buffer += "Global beats, beat width, and tempo track:\n";
+    write_prop_header(c_perf_bp_mes, p.get_beats_per_bar());
+    write_prop_header(c_perf_bw, p.get_beat_width());
+    write_prop_header(c_tempo_track, rc().tempo_track_number());
 }
 
 /**
@@ -414,28 +738,83 @@ songsummary::write_beat_info
  *      performance.
  *
  * \return
- *      Always returns true.  No efficient way to check all of the writes that
- *      can happen.  Might revisit this issue if some bug crops up.
+ *      Always returns true.
  */
 
 bool
-songsummary::write_proprietary_track (std::ofstream & file, performer & p)
+songsummary::write_proprietary_track (performer & p)
 {
-    file << "Start of SeqSpecs:" << "\n";
-    write_prop_header(file, c_midictrl, 0);     /* midi control tag + 4     */
-    write_prop_header(file, c_midiclocks, 0);   /* bus mute/unmute data + 4 */
-    write_set_names(file, p);
-    write_bpm(file, p);
-    write_mutes(file, p);
-    write_global_bg(file);
-    write_beat_info(file, p);
+    m_buffer += "Start of SeqSpecs:\n";
+    write_prop_header(c_midictrl, 0);           /* midi control tag + 4     */
+    write_prop_header(c_midiclocks, 0);         /* bus mute/unmute data + 4 */
+    write_set_names(p);
+    write_bpm(p);
+    write_mutes(p);
+    write_global_bg();
+    write_beat_info(p);
     return true;
 }
 
+/**
+ *  The JSON version of the SeqSpec section:  the song-wide items, by name
+ *  rather than by tag.
+ */
+
+void
+songsummary::write_proprietary_json (performer & p)
+{
+    std::string & b = m_buffer;
+    b += ",\n  \"bpm\": ";
+    append_number(b, p.get_beats_per_minute());
+    b += ",\n  \"beats_per_bar\": ";
+    b += std::to_string(p.get_beats_per_bar());
+    b += ",\n  \"beat_width\": ";
+    b += std::to_string(p.get_beat_width());
+    b += ",\n  \"tempo_track\": ";
+    b += std::to_string(rc().tempo_track_number());
+    b += ",\n  \"set_names\": [";
+
+    int setcount = p.highest_set() + 1;         /* sets are sparse          */
+    for (int s = 0; s < setcount; ++s)
+    {
+        if (s > 0)
+            b += ", ";
+
+        append_json(b, p.set_name(s));
+    }
+    b += "],\n  \"mute_groups\": [";
+
+    bool first = true;
+    const mutegroups & mutes = p.mutes();
+    for (const auto & stz : mutes.list())
+    {
+        const mutegroup & m = stz.second;
+        if (! m.any())
+            continue;
+
+        b += first ? "\n    {\"group\": " : ",\n    {\"group\": " ;
+        b += std::to_string(stz.first);
+        b += ", \"name\": ";
+        append_json(b, m.name());
+        b += ", \"mutes\": \"";
+        for (auto mutestatus : m.get())
+            b += bool(mutestatus) ? '1' : '0' ;
+
+        b += "\"}";
+        first = false;
+    }
+    b += first ? "]" : "\n  ]" ;
+}
+
+/**
+ *  Writes the summary in the format given by the extension of the file
+ *  name; see songsummary::format_from_name().
+ */
+
 bool
 write_song_summary (performer & p, const std::string & fname)
 {
-    songsummary f(fname);
+    songsummary f(fname, songsummary::format_from_name(fname));
     bool result = f.write(p);
     if (result)
     {
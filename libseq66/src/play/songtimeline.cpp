@@ -0,0 +1,217 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songtimeline.cpp
+ *
+ *  This module defines the compiled song used by Song-mode playback.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A frame covers the ticks from the end of the last frame up to the
+ *  current tick.  The spans that start by the end of the frame are added
+ *  to the open list as the cursor reaches them; every open span makes its
+ *  pattern busy for the frame; and the spans that end within the frame are
+ *  then dropped.  The cost of a frame is proportional to the number of
+ *  triggers in progress, not to the size of the song.
+ */
+
+#include <algorithm>                    /* std::sort(), std::upper_bound()  */
+
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "play/songtimeline.hpp"        /* seq66::songtimeline              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+songtimeline::songtimeline () :
+    m_spans         (),
+    m_compiled      (),
+    m_generation    (0),
+    m_cursor        (0),
+    m_open          (),
+    m_next_tick     (c_null_midipulse),
+    m_frame         (0),
+    m_busy_frame    ()
+{
+    // no code
+}
+
+/**
+ *  Flattens the triggers of the patterns into the schedule.  The next
+ *  frame starts the walk over, as after a reposition.
+ *
+ * \param seqs
+ *      The patterns of the play-set.
+ *
+ * \param generation
+ *      The trigger generation of the performer, which this compilation
+ *      represents.
+ */
+
+void
+songtimeline::compile
+(
+    const std::vector<seq::pointer> & seqs,
+    unsigned generation
+)
+{
+    m_spans.clear();
+    m_compiled.clear();
+    for (const auto & sp : seqs)
+    {
+        if (! sp)
+            continue;
+
+        seq::number seqno = sp->seq_number();
+        if (seqno < 0)
+            continue;
+
+        if (std::size_t(seqno) >= m_compiled.size())
+            m_compiled.resize(std::size_t(seqno) + 1, nullptr);
+
+        m_compiled[std::size_t(seqno)] = sp.get();
+        for (const auto & t : sp->get_triggers())   /* copied under lock    */
+        {
+            span s;
+            s.sp_start = t.tick_start();
+            s.sp_end = t.tick_end();
+            s.sp_seqno = seqno;
+            s.sp_offset = t.offset();
+            s.sp_transpose = t.transpose();
+            m_spans.push_back(s);
+        }
+    }
+    std::stable_sort
+    (
+        m_spans.begin(), m_spans.end(),
+        [] (const span & a, const span & b)
+        {
+            return a.sp_start < b.sp_start;
+        }
+    );
+    m_busy_frame.assign(m_compiled.size(), 0);
+    m_frame = 0;
+    m_generation = generation;
+    m_next_tick = c_null_midipulse;             /* forces a rewind()        */
+}
+
+/**
+ *  Starts the walk over for a frame that does not follow on from the last
+ *  one.  Every span that has started by the tick is opened, so that each
+ *  such pattern plays this frame as it always did, and finds its state.
+ *
+ * \param tick
+ *      The last tick of the frame.
+ */
+
+void
+songtimeline::rewind (midipulse tick)
+{
+    m_open.clear();
+    auto last = std::upper_bound
+    (
+        m_spans.cbegin(), m_spans.cend(), tick,
+        [] (midipulse tk, const span & s)
+        {
+            return tk < s.sp_start;
+        }
+    );
+    m_cursor = std::size_t(last - m_spans.cbegin());
+    for (std::size_t i = 0; i < m_cursor; ++i)
+        m_open.push_back(i);
+}
+
+/**
+ *  Walks the schedule to the end of the frame, then marks the patterns
+ *  that are busy in it.
+ *
+ * \param tick
+ *      The last tick of the frame, as passed to performer::play().
+ */
+
+void
+songtimeline::advance (midipulse tick)
+{
+    if (is_null_midipulse(m_next_tick) || tick < m_next_tick - 1)
+    {
+        rewind(tick);
+    }
+    else
+    {
+        while (m_cursor < m_spans.size() && m_spans[m_cursor].sp_start <= tick)
+            m_open.push_back(m_cursor++);
+    }
+
+    if (++m_frame == 0)                         /* wrapped; start over      */
+    {
+        std::fill(m_busy_frame.begin(), m_busy_frame.end(), 0);
+        m_frame = 1;
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_open.size(); ++i)
+    {
+        const span & s = m_spans[m_open[i]];
+        m_busy_frame[std::size_t(s.sp_seqno)] = m_frame;
+        if (s.sp_end > tick)
+            m_open[kept++] = m_open[i];         /* still going next frame   */
+    }
+    m_open.resize(kept);
+    m_next_tick = tick + 1;
+}
+
+/**
+ *  Tells if the pattern has nothing to do in this frame.  That is, it was
+ *  compiled, it has no trigger in the frame, and nothing else is needing
+ *  it to play.
+ *
+ * \param s
+ *      The pattern from the play-set.
+ *
+ * \return
+ *      Returns true if performer::play() can skip the pattern.
+ */
+
+bool
+songtimeline::skippable (const sequence & s) const
+{
+    std::size_t seqno = std::size_t(s.seq_number());
+    bool result = seqno < m_compiled.size() && m_compiled[seqno] == &s;
+    if (result)
+        result = m_busy_frame[seqno] != m_frame && s.song_idle();
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * songtimeline.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
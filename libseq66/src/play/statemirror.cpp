@@ -0,0 +1,920 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          statemirror.cpp
+ *
+ *  This module defines the shared-memory mirror of the engine's state.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The data of each part is written and read with plain copies between
+ *  the accesses of its version, with the fences of the usual sequence
+ *  lock.  The engine is the only writer of everything but the command
+ *  queue, and the client the only writer of the queue's head.
+ */
+
+#include <algorithm>                    /* std::sort()                      */
+#include <chrono>                       /* std::chrono::milliseconds        */
+#include <cstring>                      /* std::memcpy(), std::memmove()    */
+#include <new>                          /* placement new                    */
+
+#include "seq66_platform_macros.h"      /* detecting Linux vs Windows       */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "play/performer.hpp"           /* seq66::performer class           */
+#include "play/statemirror.hpp"         /* seq66::statemirror classes       */
+#include "util/basic_macros.hpp"        /* seq66::error_message()           */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <cerrno>                       /* errno, ESRCH                     */
+#include <fcntl.h>                      /* O_CREAT, O_EXCL, O_RDWR          */
+#include <signal.h>                     /* ::kill()                         */
+#include <sys/mman.h>                   /* ::shm_open(), ::mmap()           */
+#include <sys/stat.h>                   /* ::fstat()                        */
+#include <unistd.h>                     /* ::ftruncate(), ::getpid()        */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  How often the mirror thread publishes the transport and takes the
+ *  commands, and how many of its passes may go by before it looks at the
+ *  status of the patterns even though no pattern changed.
+ */
+
+static const int c_mirror_period_ms = 10;
+static const int c_mirror_rescan_passes = 5;
+
+/**
+ *  How many times a reader tries to get a consistent copy before it gives
+ *  up.  The engine's writes are short, so a few tries are normally plenty.
+ */
+
+static const int c_read_tries = 100;
+
+/**
+ *  The sequence-lock helpers.  The writer makes the version odd, writes,
+ *  and makes it even.  The reader keeps its copy only if the version was
+ *  even before and the same after.
+ */
+
+static void
+write_begin (std::atomic<std::uint32_t> & v)
+{
+    v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+static void
+write_end (std::atomic<std::uint32_t> & v)
+{
+    v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+static bool
+read_begin (const std::atomic<std::uint32_t> & v, std::uint32_t & ver)
+{
+    ver = v.load(std::memory_order_acquire);
+    return (ver & 1) == 0;
+}
+
+static bool
+read_end (const std::atomic<std::uint32_t> & v, std::uint32_t ver)
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return v.load(std::memory_order_relaxed) == ver;
+}
+
+/**
+ *  Gives the segment name its leading slash.
+ */
+
+static std::string
+segment_path (const std::string & name)
+{
+    return name.empty() || name[0] == '/' ? name : "/" + name ;
+}
+
+/*
+ * -------------------------------------------------------------------------
+ *  statemirror
+ * -------------------------------------------------------------------------
+ */
+
+statemirror::statemirror (performer & p, const std::string & name) :
+    m_perf                  (p),
+    m_name                  (segment_path(name)),
+    m_segment               (nullptr),
+    m_running               (false),
+    m_thread                (),
+    m_change_generation     (0),
+    m_rescan_countdown      (0),
+    m_overflow_reported     (false)
+{
+    // no code
+}
+
+statemirror::~statemirror ()
+{
+    stop();
+}
+
+/**
+ *  Creates the segment, publishes everything once, and starts the mirror
+ *  thread.
+ *
+ * \return
+ *      Returns true if the mirror is running.
+ */
+
+bool
+statemirror::start ()
+{
+    bool result = ! m_running && m_name.size() > 1;
+    if (result)
+        result = create_segment();
+
+    if (result)
+    {
+        publish_transport();
+        publish_patterns();
+        m_change_generation = sequence::change_generation();
+        m_running = true;
+        m_thread = std::thread(&statemirror::mirror_loop, this);
+        info_message("State mirror in shared memory", m_name);
+    }
+    else
+        error_message("Cannot create the state mirror", m_name);
+
+    return result;
+}
+
+void
+statemirror::stop ()
+{
+    if (m_running)
+    {
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+    remove_segment();
+}
+
+/**
+ *  Creates the segment afresh.  A segment left by an engine that crashed
+ *  is unlinked first; a client still mapping it sees its heartbeat stop,
+ *  and attaches again.
+ */
+
+bool
+statemirror::create_segment ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    std::atomic<std::uint32_t> probe;
+    if (! probe.is_lock_free())                 /* must be address-free     */
+        return false;
+
+    (void) ::shm_unlink(m_name.c_str());
+
+    int fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        return false;
+
+    std::size_t sz = sizeof(shm_segment);
+    bool result = ::ftruncate(fd, off_t(sz)) == 0;
+    void * p = nullptr;
+    if (result)
+    {
+        p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        result = p != MAP_FAILED;
+    }
+    (void) ::close(fd);
+    if (result)
+    {
+        m_segment = new (p) shm_segment;        /* the pages are zeroed     */
+        m_segment->ss_version = c_shm_version;
+        m_segment->ss_size = std::uint32_t(sz);
+        m_segment->ss_engine_pid = std::int32_t(::getpid());
+        m_segment->ss_heartbeat_us = microtime();
+        std::atomic_thread_fence(std::memory_order_release);
+        m_segment->ss_magic = c_shm_magic;
+    }
+    else
+        (void) ::shm_unlink(m_name.c_str());
+
+    return result;
+#else
+    return false;
+#endif
+}
+
+void
+statemirror::remove_segment ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (not_nullptr(m_segment))
+    {
+        m_segment->ss_magic = 0;                /* tell the clients         */
+        (void) ::munmap(m_segment, sizeof(shm_segment));
+        (void) ::shm_unlink(m_name.c_str());
+        m_segment = nullptr;
+    }
+#endif
+}
+
+/**
+ *  The mirror thread.  The transport and the commands are handled on every
+ *  pass, the patterns only when one of them changed, or every few passes
+ *  for the status changes that do not count as a change.
+ */
+
+void
+statemirror::mirror_loop ()
+{
+    while (m_running)
+    {
+        m_segment->ss_heartbeat_us.store
+        (
+            microtime(), std::memory_order_release
+        );
+        publish_transport();
+        (void) take_commands();
+
+        unsigned g = sequence::change_generation();
+        if (g != m_change_generation || --m_rescan_countdown <= 0)
+        {
+            m_change_generation = g;
+            m_rescan_countdown = c_mirror_rescan_passes;
+            publish_patterns();
+        }
+        std::this_thread::sleep_for
+        (
+            std::chrono::milliseconds(c_mirror_period_ms)
+        );
+    }
+}
+
+void
+statemirror::publish_transport ()
+{
+    shm_transport st;
+    st.st_running = m_perf.is_running() ? 1 : 0 ;
+    st.st_song_mode = m_perf.song_mode() ? 1 : 0 ;
+    st.st_playscreen = int(m_perf.playscreen_number());
+    st.st_screenset_size = m_perf.screenset_size();
+    st.st_ppqn = m_perf.ppqn();
+    st.st_sequence_high = int(m_perf.sequence_high());
+    st.st_tick = std::int64_t(m_perf.get_tick());
+    st.st_bpm = double(m_perf.get_beats_per_minute());
+    write_begin(m_segment->ss_transport_version);
+    m_segment->ss_transport = st;
+    write_end(m_segment->ss_transport_version);
+}
+
+void
+statemirror::publish_patterns ()
+{
+    int high = int(m_perf.sequence_high());
+    if (high > c_shm_patterns)
+        high = c_shm_patterns;
+
+    for (int s = 0; s < c_shm_patterns; ++s)
+    {
+        if (s < high || m_segment->ss_patterns[s].sp_info.pi_active != 0)
+            publish_pattern(s);
+    }
+}
+
+/**
+ *  Rewrites one pattern slot if its status changed, along with its events
+ *  and triggers if its redraw generation moved.  The events come from the
+ *  playback snapshot, which needs no lock; the triggers are copied under
+ *  the pattern's lock, as the song editor does, but only when the pattern
+ *  changed.
+ *
+ * \param seqno
+ *      The pattern number, less than c_shm_patterns.
+ */
+
+void
+statemirror::publish_pattern (int seqno)
+{
+    shm_pattern & sp = m_segment->ss_patterns[seqno];
+    shm_pattern_info & pi = sp.sp_info;
+    seq::pointer s = m_perf.get_sequence(seq::number(seqno));
+    if (! s)
+    {
+        if (pi.pi_active != 0)
+        {
+            write_begin(sp.sp_version);
+            pi.pi_active = 0;
+            pi.pi_event_count = pi.pi_trigger_count = 0;
+            pi.pi_name[0] = 0;
+            write_end(sp.sp_version);
+        }
+        return;
+    }
+
+    shm_pattern_info now = pi;
+    now.pi_active = 1;
+    now.pi_armed = s->armed() ? 1 : 0 ;
+    now.pi_queued = s->get_queued() ? 1 : 0 ;
+    now.pi_recording = s->recording() ? 1 : 0 ;
+    now.pi_one_shot = s->one_shot() ? 1 : 0 ;
+    now.pi_bus = int(s->seq_midi_bus());
+    now.pi_channel = int(s->seq_midi_channel());
+    now.pi_length = std::int64_t(s->get_length());
+    now.pi_generation = s->redraw_generation();
+
+    bool events = pi.pi_active == 0 || now.pi_generation != pi.pi_generation;
+    if (! events && std::memcmp(&now, &pi, sizeof now) == 0)
+        return;
+
+    sequence::snapshot snap;
+    std::vector<trigger> tl;
+    if (events)
+    {
+        snap = s->play_snapshot();
+        tl = s->get_triggers();
+
+        const std::string & n = s->name();
+        std::size_t len = n.size() < std::size_t(c_shm_name_size - 1) ?
+            n.size() : std::size_t(c_shm_name_size - 1) ;
+
+        std::memcpy(now.pi_name, n.data(), len);
+        now.pi_name[len] = 0;
+    }
+    write_begin(sp.sp_version);
+    pi = now;
+    if (events)
+    {
+        int count = snap ? int(snap->events().size()) : 0 ;
+        if (reserve_events(pi, count))
+        {
+            shm_event * se = &m_segment->ss_events[pi.pi_event_start];
+            for (const auto & pe : snap->events())
+            {
+                se->se_tick = std::int64_t(pe.timestamp());
+                se->se_status = pe.status();
+                se->se_d0 = pe.d0();
+                se->se_d1 = pe.d1();
+                ++se;
+            }
+            pi.pi_event_count = count;
+        }
+        else
+            pi.pi_event_count = 0;
+
+        count = int(tl.size());
+        if (reserve_triggers(pi, count))
+        {
+            shm_trigger * st = &m_segment->ss_triggers[pi.pi_trigger_start];
+            for (const auto & t : tl)
+            {
+                st->st_start = std::int64_t(t.tick_start());
+                st->st_end = std::int64_t(t.tick_end());
+                st->st_offset = std::int64_t(t.offset());
+                st->st_transpose = t.transpose();
+                st->st_pad = 0;
+                ++st;
+            }
+            pi.pi_trigger_count = count;
+        }
+        else
+            pi.pi_trigger_count = 0;
+    }
+    write_end(sp.sp_version);
+}
+
+/**
+ *  Makes room for the events of a pattern.  The room given has some spare,
+ *  so that small edits are written in place.  When the pool is used up,
+ *  the pools are compacted (the pattern's old room is dropped first); a
+ *  pattern that still does not fit is published without its events.
+ *
+ * \return
+ *      Returns true if pi_event_start has room for the count.
+ */
+
+bool
+statemirror::reserve_events (shm_pattern_info & pi, int count)
+{
+    if (count <= pi.pi_event_room)
+        return true;
+
+    int room = count + count / 4 + 16;
+    pi.pi_event_count = pi.pi_event_room = 0;
+    if (m_segment->ss_events_used + room > c_shm_events)
+        compact_pools();
+
+    if (m_segment->ss_events_used + room > c_shm_events)
+        room = count;
+
+    bool result = m_segment->ss_events_used + room <= c_shm_events;
+    if (result)
+    {
+        pi.pi_event_start = m_segment->ss_events_used;
+        pi.pi_event_room = room;
+        m_segment->ss_events_used += room;
+    }
+    else if (! m_overflow_reported)
+    {
+        m_overflow_reported = true;
+        error_message("State mirror event pool is full");
+    }
+    return result;
+}
+
+bool
+statemirror::reserve_triggers (shm_pattern_info & pi, int count)
+{
+    if (count <= pi.pi_trigger_room)
+        return true;
+
+    int room = count + count / 4 + 4;
+    pi.pi_trigger_count = pi.pi_trigger_room = 0;
+    if (m_segment->ss_triggers_used + room > c_shm_triggers)
+        compact_pools();
+
+    if (m_segment->ss_triggers_used + room > c_shm_triggers)
+        room = count;
+
+    bool result = m_segment->ss_triggers_used + room <= c_shm_triggers;
+    if (result)
+    {
+        pi.pi_trigger_start = m_segment->ss_triggers_used;
+        pi.pi_trigger_room = room;
+        m_segment->ss_triggers_used += room;
+    }
+    else if (! m_overflow_reported)
+    {
+        m_overflow_reported = true;
+        error_message("State mirror trigger pool is full");
+    }
+    return result;
+}
+
+/**
+ *  Packs the events and triggers of all the patterns to the start of their
+ *  pools, in the order they sit, so each move is downward.  The spare room
+ *  is dropped.  The layout version is odd meanwhile, so that every reader
+ *  of a pattern tries again.
+ */
+
+void
+statemirror::compact_pools ()
+{
+    shm_pattern * patterns = m_segment->ss_patterns;
+    std::vector<int> order;
+    order.reserve(std::size_t(c_shm_patterns));
+    write_begin(m_segment->ss_layout);
+
+    for (int s = 0; s < c_shm_patterns; ++s)
+    {
+        if (patterns[s].sp_info.pi_event_room > 0)
+            order.push_back(s);
+    }
+    std::sort
+    (
+        order.begin(), order.end(), [patterns] (int a, int b)
+        {
+            return patterns[a].sp_info.pi_event_start <
+                patterns[b].sp_info.pi_event_start;
+        }
+    );
+    int pos = 0;
+    for (int s : order)
+    {
+        shm_pattern_info & pi = patterns[s].sp_info;
+        if (pi.pi_event_start != pos && pi.pi_event_count > 0)
+        {
+            std::memmove
+            (
+                &m_segment->ss_events[pos],
+                &m_segment->ss_events[pi.pi_event_start],
+                std::size_t(pi.pi_event_count) * sizeof(shm_event)
+            );
+        }
+        pi.pi_event_start = pos;
+        pi.pi_event_room = pi.pi_event_count;
+        pos += pi.pi_event_count;
+    }
+    m_segment->ss_events_used = pos;
+
+    order.clear();
+    for (int s = 0; s < c_shm_patterns; ++s)
+    {
+        if (patterns[s].sp_info.pi_trigger_room > 0)
+            order.push_back(s);
+    }
+    std::sort
+    (
+        order.begin(), order.end(), [patterns] (int a, int b)
+        {
+            return patterns[a].sp_info.pi_trigger_start <
+                patterns[b].sp_info.pi_trigger_start;
+        }
+    );
+    pos = 0;
+    for (int s : order)
+    {
+        shm_pattern_info & pi = patterns[s].sp_info;
+        if (pi.pi_trigger_start != pos && pi.pi_trigger_count > 0)
+        {
+            std::memmove
+            (
+                &m_segment->ss_triggers[pos],
+                &m_segment->ss_triggers[pi.pi_trigger_start],
+                std::size_t(pi.pi_trigger_count) * sizeof(shm_trigger)
+            );
+        }
+        pi.pi_trigger_start = pos;
+        pi.pi_trigger_room = pi.pi_trigger_count;
+        pos += pi.pi_trigger_count;
+    }
+    m_segment->ss_triggers_used = pos;
+    write_end(m_segment->ss_layout);
+}
+
+/**
+ *  Hands the client's controls to the performer's remote-control queue.
+ *  A control the performer refuses, or cannot queue, is counted as
+ *  dropped.
+ *
+ * \return
+ *      Returns the number of controls taken.
+ */
+
+int
+statemirror::take_commands ()
+{
+    int result = 0;
+    std::uint32_t head =
+        m_segment->ss_command_head.load(std::memory_order_acquire);
+
+    std::uint32_t tail =
+        m_segment->ss_command_tail.load(std::memory_order_relaxed);
+
+    if (head - tail > std::uint32_t(c_shm_commands))    /* a bad client     */
+        tail = head;
+
+    while (tail != head)
+    {
+        shm_command c = m_segment->ss_commands[tail % c_shm_commands];
+        ++tail;
+
+        bool ok = c.sc_action > int(automation::action::none) &&
+            c.sc_action < int(automation::action::max);
+
+        if (ok)
+        {
+            ok = m_perf.post_remote_control
+            (
+                automation::slot(c.sc_slot),
+                static_cast<automation::action>(c.sc_action),
+                c.sc_index, c.sc_d1, c.sc_d0, c.sc_inverse != 0
+            );
+        }
+        if (! ok)
+            m_segment->ss_commands_dropped.fetch_add(1);
+
+        ++result;
+    }
+    m_segment->ss_command_tail.store(tail, std::memory_order_release);
+    return result;
+}
+
+/*
+ * -------------------------------------------------------------------------
+ *  statemirror_view
+ * -------------------------------------------------------------------------
+ */
+
+statemirror_view::statemirror_view () :
+    m_name          (),
+    m_segment       (nullptr),
+    m_commander     (false)
+{
+    // no code
+}
+
+statemirror_view::~statemirror_view ()
+{
+    detach();
+}
+
+/**
+ *  Maps the segment of a running engine.  It is mapped for writing too,
+ *  but only the command queue is written.
+ *
+ * \param name
+ *      The engine's "state-mirror" name.
+ *
+ * \return
+ *      Returns true if the segment is there, complete, and of this version.
+ */
+
+bool
+statemirror_view::attach (const std::string & name)
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    detach();
+    m_name = segment_path(name);
+    if (m_name.size() < 2)
+        return false;
+
+    int fd = ::shm_open(m_name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        return false;
+
+    std::size_t sz = sizeof(shm_segment);
+    struct stat st;
+    bool result = ::fstat(fd, &st) == 0 && std::size_t(st.st_size) >= sz;
+    void * p = nullptr;
+    if (result)
+    {
+        p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        result = p != MAP_FAILED;
+    }
+    (void) ::close(fd);
+    if (result)
+    {
+        shm_segment * seg = static_cast<shm_segment *>(p);
+        result = seg->ss_magic == c_shm_magic &&
+            seg->ss_version == c_shm_version &&
+            seg->ss_size == std::uint32_t(sz);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (result)
+            m_segment = seg;
+        else
+            (void) ::munmap(p, sz);
+    }
+    return result;
+#else
+    (void) name;
+    return false;
+#endif
+}
+
+/**
+ *  Gives up the command queue, if this client held it, and unmaps the
+ *  segment.
+ */
+
+void
+statemirror_view::detach ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (not_nullptr(m_segment))
+    {
+        if (m_commander)
+        {
+            std::int32_t pid = std::int32_t(::getpid());
+            (void) m_segment->ss_client_pid.compare_exchange_strong(pid, 0);
+            m_commander = false;
+        }
+        (void) ::munmap(m_segment, sizeof(shm_segment));
+        m_segment = nullptr;
+    }
+#endif
+}
+
+/**
+ * \param timeoutus
+ *      How old the heartbeat may be, in microseconds.  The mirror thread
+ *      beats every 10 ms; the default allows half a second.
+ *
+ * \return
+ *      Returns true if the engine's mirror is beating.  False means that
+ *      the engine stopped, stalled, or exited; the client should detach(),
+ *      and attach() again later.
+ */
+
+bool
+statemirror_view::engine_alive (long timeoutus) const
+{
+    if (is_nullptr(m_segment) || m_segment->ss_magic != c_shm_magic)
+        return false;
+
+    long beat = long(m_segment->ss_heartbeat_us.load());
+    return microtime() - beat < timeoutus;
+}
+
+bool
+statemirror_view::read_transport (shm_transport & st) const
+{
+    if (is_nullptr(m_segment))
+        return false;
+
+    const std::atomic<std::uint32_t> & v = m_segment->ss_transport_version;
+    for (int tries = 0; tries < c_read_tries; ++tries)
+    {
+        std::uint32_t ver;
+        if (read_begin(v, ver))
+        {
+            st = m_segment->ss_transport;
+            if (read_end(v, ver))
+                return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+/**
+ *  Copies a pattern slot, and its name, events, and triggers.
+ *
+ * \param seqno
+ *      The pattern number.
+ *
+ * \param [out] p
+ *      The copy.  Check p.p_info.pi_active for an empty slot.
+ *
+ * \param events
+ *      If false, only the slot and the name are copied; this is enough for
+ *      a live grid that does not draw the events.
+ *
+ * \return
+ *      Returns true if a consistent copy was made.
+ */
+
+bool
+statemirror_view::read_pattern (int seqno, pattern & p, bool events) const
+{
+    if (is_nullptr(m_segment) || seqno < 0 || seqno >= c_shm_patterns)
+        return false;
+
+    const shm_pattern & sp = m_segment->ss_patterns[seqno];
+    const std::atomic<std::uint32_t> & layout = m_segment->ss_layout;
+    for (int tries = 0; tries < c_read_tries; ++tries)
+    {
+        std::uint32_t lver, pver;
+        if (read_begin(layout, lver) && read_begin(sp.sp_version, pver))
+        {
+            p.p_info = sp.sp_info;
+
+            const shm_pattern_info & pi = p.p_info;
+            bool ok = pi.pi_event_start >= 0 && pi.pi_event_count >= 0 &&
+                pi.pi_event_start + pi.pi_event_count <= c_shm_events &&
+                pi.pi_trigger_start >= 0 && pi.pi_trigger_count >= 0 &&
+                pi.pi_trigger_start + pi.pi_trigger_count <= c_shm_triggers;
+
+            if (ok && events)
+            {
+                const shm_event * se = &m_segment->ss_events[pi.pi_event_start];
+                p.p_events.assign(se, se + pi.pi_event_count);
+
+                const shm_trigger * st =
+                    &m_segment->ss_triggers[pi.pi_trigger_start];
+
+                p.p_triggers.assign(st, st + pi.pi_trigger_count);
+            }
+            if (ok && read_end(sp.sp_version, pver) && read_end(layout, lver))
+            {
+                p.p_info.pi_name[c_shm_name_size - 1] = 0;
+                p.p_name = p.p_info.pi_name;
+                if (! events)
+                {
+                    p.p_events.clear();
+                    p.p_triggers.clear();
+                }
+                return true;
+            }
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+/**
+ *  Gets the redraw generation of a pattern, which tells a view whether
+ *  its copy is still good, without copying anything else.
+ */
+
+bool
+statemirror_view::pattern_generation
+(
+    int seqno, std::uint32_t & generation
+) const
+{
+    if (is_nullptr(m_segment) || seqno < 0 || seqno >= c_shm_patterns)
+        return false;
+
+    const shm_pattern & sp = m_segment->ss_patterns[seqno];
+    for (int tries = 0; tries < c_read_tries; ++tries)
+    {
+        std::uint32_t ver;
+        if (read_begin(sp.sp_version, ver))
+        {
+            generation = sp.sp_info.pi_generation;
+            if (read_end(sp.sp_version, ver))
+                return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+/**
+ *  Queues an automation control for the engine.  The parameters are those
+ *  of performer::post_remote_control().
+ *
+ * \return
+ *      Returns false if another client holds the queue, or it is full.
+ */
+
+bool
+statemirror_view::post_control
+(
+    automation::slot s, automation::action a, int index,
+    int d1, int d0, bool inverse
+)
+{
+    if (is_nullptr(m_segment) || ! claim_commands())
+        return false;
+
+    std::uint32_t head =
+        m_segment->ss_command_head.load(std::memory_order_relaxed);
+
+    std::uint32_t tail =
+        m_segment->ss_command_tail.load(std::memory_order_acquire);
+
+    if (head - tail >= std::uint32_t(c_shm_commands))
+    {
+        m_segment->ss_commands_dropped.fetch_add(1);
+        return false;
+    }
+
+    shm_command & c = m_segment->ss_commands[head % c_shm_commands];
+    c.sc_slot = int(s);
+    c.sc_action = int(a);
+    c.sc_index = index;
+    c.sc_d0 = d0;
+    c.sc_d1 = d1;
+    c.sc_inverse = inverse ? 1 : 0 ;
+    m_segment->ss_command_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ *  Claims the command queue for this process, if no live process has it.
+ */
+
+bool
+statemirror_view::claim_commands ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    std::int32_t pid = std::int32_t(::getpid());
+    std::int32_t holder = m_segment->ss_client_pid.load();
+    if (holder == pid)
+    {
+        m_commander = true;
+        return true;
+    }
+    if (holder != 0 && (::kill(pid_t(holder), 0) == 0 || errno != ESRCH))
+        return false;
+
+    m_commander = m_segment->ss_client_pid.compare_exchange_strong
+    (
+        holder, pid
+    );
+    return m_commander;
+#else
+    return false;
+#endif
+}
+
+}           // namespace seq66
+
+/*
+ * statemirror.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
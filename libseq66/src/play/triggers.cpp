@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-30
- * \updates       2022-10-03
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Man, we need to learn a lot more about triggers.  One important thing to
@@ -59,7 +59,7 @@
  *      location.
  */
 
-#include <algorithm>                    /* std::sort(), std::merge()        */
+#include <algorithm>                    /* std::upper_bound(), etc.         */
 
 #include "cfg/settings.hpp"             /* seq66::rc() settings access      */
 #include "midi/midi_vector_base.hpp"    /* c_triggers_ex, c_trig_transpose  */
@@ -102,11 +102,20 @@ trigger::trigger
     transpose_byte(tpose);                  /* convert byte to scaled int   */
 }
 
+/**
+ *  The end tick is inclusive, so it is the tick after it that is rescaled,
+ *  so that a trigger that ends right before the next one starts still does
+ *  so.  Rescaling the end tick itself could round it onto the start of the
+ *  next trigger.
+ */
+
 void
 trigger::rescale (int newppqn, int oldppqn)
 {
-    m_tick_start = rescale_tick(m_tick_start, newppqn, oldppqn);
-    m_tick_end = rescale_tick(m_tick_end, newppqn, oldppqn);
+    midipulse start = rescale_tick(m_tick_start, newppqn, oldppqn);
+    midipulse end = rescale_tick(m_tick_end + 1, newppqn, oldppqn) - 1;
+    m_tick_start = start;
+    m_tick_end = end < start ? start : end ;
     m_offset = rescale_tick(m_offset, newppqn, oldppqn);
 }
 
@@ -161,6 +170,7 @@ triggers::triggers (sequence & parent) :
     m_undo_stack                (),
     m_redo_stack                (),
     m_draw_iterator             (),
+    m_play_cursor               (0),
     m_trigger_copied            (false),
     m_paste_tick                (c_no_paste_trigger),   // stazed
     m_ppqn                      (0),
@@ -195,9 +205,11 @@ triggers::operator = (const triggers & rhs)
         m_undo_stack = rhs.m_undo_stack;
         m_redo_stack = rhs.m_redo_stack;
         m_draw_iterator = rhs.m_draw_iterator;
+        m_play_cursor = 0;
         m_trigger_copied = rhs.m_trigger_copied;
         m_ppqn = rhs.m_ppqn;
         m_length = rhs.m_length;
+        changed();
     }
     return *this;
 }
@@ -213,6 +225,7 @@ triggers::rescale (int newppqn, int oldppqn)
 
         set_length(rescale_tick(m_length, newppqn, oldppqn));
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -244,13 +257,18 @@ triggers::any_transposed () const
     return result;
 }
 
+/**
+ *  Rescales the triggers to the new PPQN.  They stay in order and do not
+ *  come to overlap (see trigger::rescale()), so they are not sorted again.
+ */
+
 bool
 triggers::change_ppqn (int p)
 {
     bool result = p > 0;
     if (result)
     {
-        bool result = rescale(p, m_ppqn);               /* new & old PPQN   */
+        result = rescale(p, m_ppqn);                    /* new & old PPQN   */
         if (result)
             set_ppqn(p);
     }
@@ -265,8 +283,8 @@ triggers::change_ppqn (int p)
 void
 triggers::push_undo ()
 {
-    m_undo_stack.push(m_triggers);
-    for (auto & t : m_undo_stack.top())
+    m_undo_stack.push_back(m_triggers);
+    for (auto & t : m_undo_stack.back())
         unselect(t, false);             /* do not count this unselection    */
 }
 
@@ -281,10 +299,11 @@ triggers::pop_undo ()
 {
     if (m_undo_stack.size() > 0)
     {
-        m_redo_stack.push(m_triggers);
-        m_triggers = m_undo_stack.top();
-        m_undo_stack.pop();
+        m_redo_stack.push_back(m_triggers);
+        m_triggers = m_undo_stack.back();
+        m_undo_stack.pop_back();
     }
+    changed();                          /* for the song timeline    */
 }
 
 /**
@@ -298,10 +317,29 @@ triggers::pop_redo ()
 {
     if (m_redo_stack.size() > 0)
     {
-        m_undo_stack.push(m_triggers);
-        m_triggers = m_redo_stack.top();
-        m_redo_stack.pop();
+        m_undo_stack.push_back(m_triggers);
+        m_triggers = m_redo_stack.back();
+        m_redo_stack.pop_back();
     }
+    changed();                          /* for the song timeline    */
+}
+
+/**
+ *  The memory held by the undo and redo lists, for memoryusage.  Unlike
+ *  the event history, these lists have no limit.
+ */
+
+std::size_t
+triggers::undo_bytes () const
+{
+    std::size_t result = 0;
+    for (const auto & c : m_undo_stack)
+        result += c.capacity() * sizeof(trigger);
+
+    for (const auto & c : m_redo_stack)
+        result += c.capacity() * sizeof(trigger);
+
+    return result;
 }
 
 /**
@@ -309,7 +347,8 @@ triggers::pop_redo ()
  *  and on/off triggers, this function handles that kind of playback.
  *  This is a new function for sequence :: play() to call.
  *
- *  The for-loop goes through all the triggers, determining if there are
+ *  The for-loop goes through the triggers, starting at the play cursor (see
+ *  play_cursor()), determining if there are
  *  trigger start/end values before the \a end_tick.  If so, then the trigger
  *  state is set to true (start only within the tick range) or false (end is
  *  within the tick range), and the trigger tick is set to start or end.  The
@@ -375,8 +414,26 @@ triggers::play
     midipulse trigger_tick = 0;
     int tp = 0;
     transpose = 0;
-    for (auto & t : m_triggers)
+
+    /*
+     *  The triggers that ended before start_tick cannot be at a transition,
+     *  and only the last of them matters: it leaves the state off, at its
+     *  end.  So only the triggers from the cursor onward are examined, and
+     *  the loop below stops at the first one that has not ended.
+     */
+
+    std::size_t first = play_cursor(start_tick);
+    if (first > 0)
     {
+        const trigger & t = m_triggers[first - 1];
+        trigger_tick = t.tick_end();
+        trigger_offset = t.offset();
+        tp = t.transpose();
+    }
+    for (std::size_t ti = first; ti < m_triggers.size(); ++ti)
+    {
+        trigger & t = m_triggers[ti];
+
         /*
          *  See the song_playback_block() function note in the banner.
          */
@@ -457,6 +514,117 @@ triggers::play
     return result;
 }
 
+/**
+ *  Tells the parent pattern that the triggers have been edited, so that
+ *  the performer's song timeline is compiled again before it is used.
+ *  It is called after the edit, while the caller still holds the
+ *  pattern's lock, so that a compile that sees the new generation cannot
+ *  read the triggers from before the edit.
+ */
+
+void
+triggers::changed ()
+{
+    m_parent.notify_triggers_edited();
+}
+
+/**
+ *  Finds the first trigger that has not ended by the given tick, by binary
+ *  search.  The triggers are sorted and do not overlap, so their end ticks
+ *  are sorted as well.
+ *
+ * \param tick
+ *      The tick of interest.
+ *
+ * \return
+ *      Returns an iterator to the first trigger whose end is at or after the
+ *      tick, or the end iterator if there is none.  It is the trigger that
+ *      covers the tick, if any does.
+ */
+
+triggers::container::const_iterator
+triggers::first_unended (midipulse tick) const
+{
+    return std::lower_bound
+    (
+        m_triggers.cbegin(), m_triggers.cend(), tick,
+        [] (const trigger & t, midipulse tk)
+        {
+            return t.tick_end() < tk;
+        }
+    );
+}
+
+/**
+ *  Finds the trigger that covers the given tick, by binary search.
+ *
+ * \param tick
+ *      The tick of interest.
+ *
+ * \return
+ *      Returns an iterator to the trigger, or the end iterator if no
+ *      trigger covers the tick.
+ */
+
+triggers::container::iterator
+triggers::covering (midipulse tick)
+{
+    auto offset = first_unended(tick) - m_triggers.cbegin();
+    auto result = m_triggers.begin() + offset;
+    if (result != m_triggers.end() && result->tick_start() > tick)
+        result = m_triggers.end();
+
+    return result;
+}
+
+/**
+ *  Inserts a trigger where it belongs in the sorted container, after any
+ *  that start at the same tick, so that the container never needs to be
+ *  sorted again.  Only the triggers after it are shifted.
+ */
+
+void
+triggers::insert_sorted (const trigger & t)
+{
+    auto pos = std::upper_bound(m_triggers.begin(), m_triggers.end(), t);
+    (void) m_triggers.insert(pos, t);
+}
+
+/**
+ *  Gets the index of the first trigger that has not ended by the given
+ *  tick, for play().  Playback moves forward a little in each frame, so
+ *  the answer is nearly always the last one, or the one after it.  After a
+ *  reposition, a loop, or an edit, a binary search finds it.
+ *
+ * \param tick
+ *      The starting tick of the frame.
+ *
+ * \return
+ *      Returns the index, which is the size of the container if all of the
+ *      triggers have ended.
+ */
+
+std::size_t
+triggers::play_cursor (midipulse tick)
+{
+    std::size_t count = m_triggers.size();
+    std::size_t c = m_play_cursor;
+    for (int tries = 0; tries < 2 && c <= count; ++tries, ++c)
+    {
+        bool before = c == 0 || m_triggers[c - 1].tick_end() < tick;
+        bool after = c == count || m_triggers[c].tick_end() >= tick;
+        if (before && after)
+        {
+            m_play_cursor = c;
+            return c;
+        }
+        if (! before)
+            break;                      /* went backward, e.g. a loop       */
+    }
+    m_play_cursor = std::size_t(first_unended(tick) - m_triggers.cbegin());
+    return m_play_cursor;
+}
+
 /**
  *  Adjusts the given offset by mod'ing it with m_length and adding
  *  m_length if needed, and returning the result.
@@ -483,7 +651,10 @@ triggers::adjust_offset (midipulse offset)
 }
 
 /**
- *  Adds a trigger.
+ *  Adds a trigger.  The triggers are sorted and do not overlap, so only the
+ *  run of triggers from the first one not ended by the new trigger's start
+ *  to the last one starting by its end can be touched; the rest are left
+ *  alone, and the new trigger is inserted in place.
  *
  * \param tick
  *      Provides the tick (pulse) time at which the trigger goes on.
@@ -519,7 +690,10 @@ triggers::add
     {
         midipulse adjusted_offset = fixoffset ? adjust_offset(offset) : offset;
         trigger t(tick, len, adjusted_offset, transpose);
-        for (auto ti = m_triggers.begin(); ti != m_triggers.end(); /* ++ti */)
+        auto ti = m_triggers.begin() +
+            (first_unended(t.tick_start()) - m_triggers.cbegin());
+
+        while (ti != m_triggers.end() && ti->tick_start() <= t.tick_end())
         {
             midipulse tickstart = ti->tick_start();
             midipulse tickend = ti->tick_end();
@@ -539,16 +713,15 @@ triggers::add
             }
             ++ti;                                   /* tricky code          */
         }
-        m_triggers.push_back(t);
-        sort();
+        insert_sorted(t);
     }
+    changed();                          /* for the song timeline    */
 }
 
 /**
- *  This function examines each trigger in the trigger list.  If the given
- *  position is between the current trigger's tick-start and tick-end
- *  values, the these values are copied to the start and end parameters,
- *  respectively, and then we exit.
+ *  This function looks up the trigger that covers the given position.  If
+ *  found, its tick-start and tick-end values are copied to the start and
+ *  end parameters, respectively.
  *
  * \param position
  *      The position to examine.
@@ -570,32 +743,25 @@ triggers::add
 bool
 triggers::intersect (midipulse position, midipulse & start, midipulse & ender)
 {
-    for (auto & ti : m_triggers)
+    auto ti = covering(position);
+    bool result = ti != m_triggers.end();
+    if (result)
     {
-        if (ti.tick_start() <= position && position <= ti.tick_end())
-        {
-            start = ti.tick_start();        /* return by reference */
-            ender = ti.tick_end();          /* ditto               */
-            return true;
-        }
+        start = ti->tick_start();           /* return by reference */
+        ender = ti->tick_end();             /* ditto               */
     }
-    return false;
+    return result;
 }
 
 bool
 triggers::intersect (midipulse position)
 {
-    for (auto & ti : m_triggers)
-    {
-        if (ti.tick_start() <= position && position <= ti.tick_end())
-            return true;
-    }
-    return false;
+    return covering(position) != m_triggers.end();
 }
 
 /**
- *  Grows a trigger.  This function looks for the first trigger where
- *  the tickfrom parameter is between the trigger's tick-start and tick-end
+ *  Grows a trigger.  This function looks up the trigger where the
+ *  tickfrom parameter is between the trigger's tick-start and tick-end
  *  values.  If found then the trigger's start is moved back to tickto, if
  *  necessary, or the trigger's end is moved to tickto plus the length
  *  parameter, if necessary.
@@ -617,27 +783,62 @@ bool
 triggers::grow_trigger (midipulse tickfrom, midipulse tickto, midipulse len)
 {
     bool result = false;
-    for (auto & t : m_triggers)
+    auto ti = covering(tickfrom);
+    if (ti != m_triggers.end())
     {
-        midipulse start = t.tick_start();
-        midipulse ender = t.tick_end();
-        if (start <= tickfrom && tickfrom <= ender)
-        {
-            midipulse calcend = tickto + len - 1;
-            if (tickto < start)
-                start = tickto;
+        midipulse start = ti->tick_start();
+        midipulse ender = ti->tick_end();
+        midipulse calcend = tickto + len - 1;
+        if (tickto < start)
+            start = tickto;
 
-            if (calcend > ender)
-            {
+        if (calcend > ender)
+        {
 #if defined SEQ66_PLATFORM_DEBUG_TMI
-                printf("Growing trigger from %ld to %ld (%ld), length %ld\n",
-                    long(tickfrom), long(tickto), long(calcend), long(len));
+            printf("Growing trigger from %ld to %ld (%ld), length %ld\n",
+                long(tickfrom), long(tickto), long(calcend), long(len));
 #endif
-                ender = calcend;
-            }
-            add(start, ender - start + 1, t.offset());
+            ender = calcend;
+        }
+        add(start, ender - start + 1, ti->offset());
+        result = true;
+    }
+    changed();                          /* for the song timeline    */
+    return result;
+}
+
+/**
+ *  Sets the end of the trigger covering tickfrom to tickto.  A longer
+ *  trigger is grown via grow_trigger().  A shorter one is cut in place,
+ *  which cannot overlap its neighbors.  The end is never moved before the
+ *  start of the trigger.
+ *
+ * \param tickfrom
+ *      A tick inside the trigger to close.
+ *
+ * \param tickto
+ *      The desired end tick.
+ *
+ * \return
+ *      Returns true if a trigger was found.
+ */
+
+bool
+triggers::close_trigger (midipulse tickfrom, midipulse tickto)
+{
+    bool result = false;
+    auto ti = covering(tickfrom);
+    if (ti != m_triggers.end())
+    {
+        if (tickto > ti->tick_end())
+        {
+            result = grow_trigger(tickfrom, tickto, 1);
+        }
+        else
+        {
+            ti->tick_end(std::max(tickto, ti->tick_start()));
+            changed();                  /* for the song timeline    */
             result = true;
-            break;
         }
     }
     return result;
@@ -654,24 +855,27 @@ triggers::grow_trigger (midipulse tickfrom, midipulse tickto, midipulse len)
 bool
 triggers::remove (midipulse tick)
 {
-    bool result = false;
-    for (auto i = m_triggers.begin(); i != m_triggers.end(); ++i)
+    auto i = covering(tick);
+    bool result = i != m_triggers.end();
+    if (result)
     {
-        if (i->tick_start() <= tick && tick <= i->tick_end())
-        {
-            unselect(*i);                       /* adjust selection count   */
-            m_triggers.erase(i);
-            result = true;
-            break;
-        }
+        unselect(*i);                           /* adjust selection count   */
+        m_triggers.erase(i);
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
+/**
+ *  Sorts the triggers, if they are not sorted already.  The editing
+ *  functions keep them sorted, so this is a single pass in practice.
+ */
+
 void
 triggers::sort ()
 {
-    std::sort(m_triggers.begin(), m_triggers.end());
+    if (! std::is_sorted(m_triggers.begin(), m_triggers.end()))
+        std::stable_sort(m_triggers.begin(), m_triggers.end());
 }
 
 /**
@@ -700,6 +904,7 @@ triggers::split (trigger & trig, midipulse splittick)
     if (result)
         add(new_tick_start, len + 1, trig.offset());
 
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -718,21 +923,19 @@ bool
 triggers::split (midipulse splittick, trigger::splitpoint splittype)
 {
     bool result = false;
-    for (auto & t : m_triggers)
+    auto t = covering(splittick);
+    if (t != m_triggers.end())
     {
-        if (t.tick_start() <= splittick && splittick <= t.tick_end())
+        midipulse tick = splittick;                 /* snap or exact    */
+        midipulse offset = 0;
+        if (splittype == trigger::splitpoint::middle)
         {
-            midipulse tick = splittick;             /* snap or exact    */
-            midipulse offset = 0;
-            if (splittype == trigger::splitpoint::middle)
-            {
-                tick = (t.tick_end() - t.tick_start() + 1) / 2;
-                offset = t.tick_start();
-            }
-            result = split(t, tick + offset);
-            break;
+            tick = (t->tick_end() - t->tick_start() + 1) / 2;
+            offset = t->tick_start();
         }
+        result = split(*t, tick + offset);
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -764,10 +967,14 @@ triggers::adjust_offsets_to_length (midipulse newlength)
         t.offset(new_offset % newlength);
         t.offset(newlength - t.offset());
     }
+    changed();                          /* for the song timeline    */
 }
 
 /**
- *  Copies triggers to a point distant from a given tick.
+ *  Copies triggers to a point distant from a given tick.  The copies are
+ *  made in order, so they are one sorted run, which is merged into the
+ *  triggers, rather than appending them (while iterating, which is unsafe
+ *  for a vector) and sorting everything.
  *
  * \param starttick
  *      The current location of the triggers.
@@ -783,6 +990,8 @@ triggers::copy (midipulse starttick, midipulse distance)
     midipulse from_start_tick = starttick + distance;
     midipulse from_end_tick = from_start_tick + distance - 1;
     move(starttick, distance, true);
+
+    container copies;
     for (auto & t : m_triggers)
     {
         midipulse tickstart = t.tick_start();
@@ -802,10 +1011,18 @@ triggers::copy (midipulse starttick, midipulse distance)
             if (xt.offset() < 0)
                 xt.increment_offset(m_length);
 
-            m_triggers.push_back(xt);
+            copies.push_back(xt);
         }
     }
-    sort();                                     /* m_triggers.sort()        */
+    if (! copies.empty())
+    {
+        auto middle = m_triggers.insert
+        (
+            m_triggers.end(), copies.begin(), copies.end()
+        );
+        std::inplace_merge(m_triggers.begin(), middle, m_triggers.end());
+    }
+    changed();                          /* for the song timeline    */
 }
 
 /**
@@ -826,11 +1043,10 @@ const trigger &
 triggers::find_trigger (midipulse tick) const
 {
     static trigger s_dummy;
-    for (auto i = m_triggers.begin(); i != m_triggers.end(); ++i)
-    {
-        if (i->tick_start() <= tick && tick <= i->tick_end())
-            return *i;
-    }
+    auto i = first_unended(tick);
+    if (i != m_triggers.cend() && i->tick_start() <= tick)
+        return *i;
+
     return s_dummy;
 }
 
@@ -950,6 +1166,7 @@ triggers::move
             ++counter;
         }
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -999,6 +1216,7 @@ triggers::move_split
         }
     }
     move(starttick, distance, direction, false /* ? */);
+    changed();                          /* for the song timeline    */
 }
 
 /**
@@ -1145,6 +1363,7 @@ triggers::move_selected (midipulse tick, bool fixoffset, grow which)
         else
             mintick = i->tick_end() + 1;
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -1175,6 +1394,7 @@ triggers::offset_selected (midipulse tick, grow editmode)
                 t.increment_offset(tick);
         }
     }
+    changed();                          /* for the song timeline    */
 }
 
 /**
@@ -1195,6 +1415,36 @@ triggers::get_maximum () const
     return result;
 }
 
+/**
+ *  Finds the next tick after the given tick at which the playing state of
+ *  the pattern can change, either the start of a trigger or the tick just
+ *  after the end of a trigger.  Used by the deadline output scheduler so that
+ *  it does not sleep past a trigger boundary.  The triggers are sorted by
+ *  start tick, so we can stop at the first start beyond the tick.
+ *
+ * \param tick
+ *      Provides the current tick.
+ *
+ * \return
+ *      Returns the next transition tick, or c_null_midipulse if there is
+ *      none.
+ */
+
+midipulse
+triggers::next_transition (midipulse tick) const
+{
+    midipulse result = c_null_midipulse;
+    auto i = first_unended(tick);
+    if (i != m_triggers.cend())
+    {
+        if (i->tick_start() > tick)
+            result = i->tick_start();
+        else
+            result = i->tick_end() + 1;
+    }
+    return result;
+}
+
 /**
  *  Checks the list of triggers against the given tick.  If any
  *  trigger is found to bracket that tick, then true is returned.
@@ -1209,16 +1459,8 @@ triggers::get_maximum () const
 bool
 triggers::get_state (midipulse tick) const
 {
-    bool result = false;
-    for (const auto & t : m_triggers)
-    {
-        if (t.tick_start() <= tick && tick <= t.tick_end())
-        {
-            result = true;
-            break;
-        }
-    }
-    return result;
+    auto i = first_unended(tick);
+    return i != m_triggers.cend() && i->tick_start() <= tick;
 }
 
 bool
@@ -1236,6 +1478,7 @@ triggers::transpose (midipulse tick, int transposition)
             break;
         }
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -1330,6 +1573,7 @@ triggers::remove_selected ()
             break;
         }
     }
+    changed();                          /* for the song timeline    */
     return result;
 }
 
@@ -1393,6 +1637,7 @@ triggers::paste (midipulse paste_tick)
         }
         m_trigger_copied = false;
     }
+    changed();                          /* for the song timeline    */
 }
 
 /**
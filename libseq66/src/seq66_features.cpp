@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-03-12
- * \updates       2024-11-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The first part of this file defines a couple of global structure
@@ -609,6 +609,15 @@ seq_build_details ()
 #if defined SEQ66_NSM_SUPPORT
         << "NSM (Non Session Manager)\n"
 #endif
+#if defined SEQ66_LINK_SUPPORT
+        << "Ableton Link\n"
+#endif
+#if defined SEQ66_OPENGL_SUPPORT
+        << "OpenGL rendering of the rolls\n"
+#endif
+#if defined SEQ66_LEAN_ENGINE
+        << "Lean engine (no GUI-only settings)\n"
+#endif
 #if defined SEQ66_SHOW_FEATURES_TMI
         <<
             "\n"
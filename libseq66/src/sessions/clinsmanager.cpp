@@ -25,7 +25,7 @@
  * \library       clinsmanager application
  * \author        Chris Ahlstrom
  * \date          2020-08-31
- * \updates       2024-11-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This object also works if there is no session manager in the build.  It
@@ -35,7 +35,6 @@
 #include "cfg/cmdlineopts.hpp"          /* command-line functions           */
 #include "cfg/settings.hpp"             /* seq66::usr() and seq66::rc()     */
 #include "os/daemonize.hpp"             /* seq66::session_setup(), _close() */
-#include "os/timing.hpp"                /* seq66::millisleep()              */
 #include "sessions/clinsmanager.hpp"    /* seq66::clinsmanager class        */
 #include "util/filefunctions.hpp"       /* seq66::pathname_concatenate()    */
 #include "util/strfunctions.hpp"        /* seq66::contains()                */
@@ -47,6 +46,14 @@
 namespace seq66
 {
 
+/**
+ *  How long run() sleeps when nothing wakes it.  Signals, the NSM save and
+ *  quit requests, the end of a background save, and held-back control-out
+ *  feedback all wake it, so this is only a heartbeat.
+ */
+
+static const int c_idle_wait_ms = 1000;
+
 /**
  *  This function attempts to get the ACTUAL operating system on which
  *  a clinsmanager application is built.  See the comment for
@@ -98,7 +105,11 @@ clinsmanager::clinsmanager (const std::string & caps) :
     smanager            (caps),
 #if defined SEQ66_NSM_SUPPORT
     m_nsm_client        (),
+    m_osc_metrics       (),
+    m_osc_control       (),
+    m_osc_mirror        (),
 #endif
+    m_state_mirror      (),
     m_nsm_active        (false),
     m_poll_period_ms    (3 * usr().window_redraw_rate())    /* in qsmainwnd */
 {
@@ -266,6 +277,7 @@ clinsmanager::close_session (std::string & msg, bool ok)
          */
     }
 #endif
+    stop_osc_servers();
     return smanager::close_session(msg, ok);
 }
 
@@ -305,6 +317,11 @@ clinsmanager::save_session (std::string & msg, bool ok)
  *  This function is useful in the command-line version of the application.
  *  For the Qt version, see the qt5nsmanager class, which runs the Qt exec()
  *  function..
+ *
+ *  Rather than waking at the redraw rate to poll for work, the loop sleeps
+ *  in session_wait() until something calls session_wake(), or the idle
+ *  heartbeat comes around.  Only while the rate limit is holding back
+ *  control-out feedback does it wake at the redraw rate, to send it.
  */
 
 bool
@@ -312,6 +329,7 @@ clinsmanager::run ()
 {
     bool result = false;
     session_setup();
+    start_osc_servers();
     while (! session_close())
     {
         result = true;
@@ -324,11 +342,113 @@ clinsmanager::run ()
                 file_error(msg, "CLI");
             }
         }
-        millisleep(m_poll_period_ms);
+        check_background_save();
+        journal_edits();
+
+        int waitms = c_idle_wait_ms;
+        if (not_nullptr(perf()))
+        {
+            (void) perf()->send_pending_feedback();     /* rate-limited     */
+            if (perf()->feedback_pending())
+                waitms = m_poll_period_ms;
+        }
+        (void) session_wait(waitms);
     }
     return true;
 }
 
+/**
+ *  Starts the OSC metrics and control servers, if the 'rc' "metrics-port"
+ *  or "osc-control-port" is set and the performer exists, and the mirror
+ *  link, if "mirror-role" is set.  A replica takes no OSC control, as it
+ *  follows its primary only.  Also starts the shared-memory state mirror,
+ *  if "state-mirror" is set; it needs no liblo.  A failure is reported,
+ *  but is not fatal.
+ */
+
+void
+clinsmanager::start_osc_servers ()
+{
+    if (is_nullptr(perf()))
+        return;
+
+    if (! rc().state_mirror().empty() && ! m_state_mirror)
+    {
+        m_state_mirror.reset
+        (
+            new (std::nothrow) statemirror(*perf(), rc().state_mirror())
+        );
+        if (m_state_mirror && ! m_state_mirror->start())
+            m_state_mirror.reset();
+    }
+
+#if defined SEQ66_NSM_SUPPORT
+
+    int port = rc().metrics_port();
+    if (port > 0 && ! m_osc_metrics)
+    {
+        m_osc_metrics.reset(new (std::nothrow) oscmetrics(*perf(), port));
+        if (m_osc_metrics && ! m_osc_metrics->start())
+            m_osc_metrics.reset();
+    }
+    port = rc().osc_control_port();
+    if (port > 0 && ! m_osc_control)
+    {
+        if (rc().is_mirror_replica())
+        {
+            warn_message("A mirror replica takes no OSC control");
+        }
+        else
+        {
+            m_osc_control.reset(new (std::nothrow) osccontrol(*perf(), port));
+            if (m_osc_control && ! m_osc_control->start())
+                m_osc_control.reset();
+        }
+    }
+    bool primary = rc().is_mirror_primary();
+    if ((primary || rc().is_mirror_replica()) && ! m_osc_mirror)
+    {
+        m_osc_mirror.reset
+        (
+            new (std::nothrow) oscmirror
+            (
+                *perf(), primary, rc().mirror_host(), rc().mirror_port()
+            )
+        );
+        if (m_osc_mirror && ! m_osc_mirror->start())
+            m_osc_mirror.reset();
+    }
+#endif
+}
+
+void
+clinsmanager::stop_osc_servers ()
+{
+    if (m_state_mirror)
+    {
+        m_state_mirror->stop();
+        m_state_mirror.reset();
+    }
+
+#if defined SEQ66_NSM_SUPPORT
+    if (m_osc_mirror)
+    {
+        m_osc_mirror->stop();
+        m_osc_mirror.reset();
+    }
+    if (m_osc_control)
+    {
+        m_osc_control->stop();
+        m_osc_control.reset();
+    }
+    if (m_osc_metrics)
+    {
+        m_osc_metrics->stop();
+        m_osc_metrics.reset();
+    }
+#endif
+}
+
 /**
  *  Creates a session path specified by the Non Session Manager.  This
  *  function is meant to be called after receiving the /nsm/client/open
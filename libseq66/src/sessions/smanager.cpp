@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-03-22
- * \updates       2025-01-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Note that this module is part of the libseq66 library, not the libsessions
@@ -61,9 +61,13 @@
 #include "play/performer.hpp"           /* seq66::performer                 */
 #include "play/playlist.hpp"            /* seq66::playlist class            */
 #include "os/daemonize.hpp"             /* seq66::reroute_stdio(), etc.     */
+#include "os/perftrace.hpp"             /* seq66::perftrace_dump()          */
 #include "os/shellexecute.hpp"          /* seq66::copy_directory_recursive()*/
+#include "os/startupprofile.hpp"        /* seq66::startup_phase, etc.       */
+#include "os/timing.hpp"                /* seq66::microtime()               */
 #include "sessions/smanager.hpp"        /* seq66::smanager()                */
 #include "util/filefunctions.hpp"       /* seq66::file_readable() etc.      */
+#include "util/msglog.hpp"              /* seq66::start_msglog() etc.       */
 
 #if defined SEQ66_PORTMIDI_SUPPORT
 #include "portmidi.h"                   /* Pm_error_present()               */
@@ -95,6 +99,13 @@ static std::string s_port_update_msg
     "them in the 'rc' file."
 };
 
+/**
+ *  The size at which the edit journal is compacted into one image of the
+ *  song.
+ */
+
+static const size_t c_journal_compact_size = 4 * 1024 * 1024;
+
 /**
  *  Does the usual construction.  It also calls set_defaults() from the
  *  settings.cpp module in order to guarantee that we have rc() and usr()
@@ -102,6 +113,9 @@ static std::string s_port_update_msg
  *
  *  create_performer() has to wait until after the calls to
  *  main_settings(), create_session(), create_project(),
+ *
+ *  The console messages are handed to the msglog thread from here on, so
+ *  that the I/O threads never wait on the console or the log file.
  */
 
 smanager::smanager (const std::string & caps) :
@@ -116,9 +130,17 @@ smanager::smanager (const std::string & caps) :
     m_last_dirty_status     (false),
     m_rerouted              (false),
     m_extant_errmsg         (),
-    m_extant_msg_active     (false)
+    m_extant_msg_active     (false),
+    m_save_thread           (),
+    m_save_mutex            (),
+    m_save_done             (false),
+    m_save_ok               (false),
+    m_save_message          (),
+    m_journal               (),
+    m_journal_time          (0)
 {
     set_configuration_defaults();
+    (void) start_msglog();
 }
 
 /**
@@ -130,8 +152,11 @@ smanager::smanager (const std::string & caps) :
 
 smanager::~smanager ()
 {
+    finish_background_save();
     if (! is_help())
         session_message("Exiting session manager");
+
+    stop_msglog();                              /* writes the rest first    */
 }
 
 /**
@@ -262,6 +287,7 @@ smanager::main_settings (int argc, char * argv [])
         }
         else
         {
+            startup_phase sp("command line");
             int rcode = cmdlineopts::parse_command_line_options(argc, argv);
             result = rcode != (-1);
             if (result)
@@ -341,6 +367,7 @@ smanager::main_settings (int argc, char * argv [])
 
             if (! in_nsm)
             {
+                startup_phase sp("configuration");
                 std::string errmessage;             /* just in case!        */
                 result = cmdlineopts::parse_options_files(errmessage);
                 if (result)
@@ -475,6 +502,7 @@ smanager::main_settings (int argc, char * argv [])
 bool
 smanager::create_performer ()
 {
+    startup_phase sp("performer launch");
     bool result = false;
     int ppqn = choose_ppqn();
     int rows = usr().mainwnd_rows();
@@ -670,12 +698,213 @@ smanager::close_session (std::string & msg, bool ok)
         perf()->put_settings(rc(), usr());     /* copy latest settings      */
         if (result)
             (void) save_session(msg, result);
+
+        finish_background_save();              /* exiting, so wait for it  */
+        m_journal.reset();
+        (void) midijournal::discard(rc().midi_filename());  /* normal exit  */
     }
     result = ok;
     (void) session_close();                    /* daemonize signals exit   */
     return result;
 }
 
+/**
+ *  Writes the events of the --trace option, if on, to the file given with
+ *  the option, or to "seq66-trace.json" in the configuration directory.
+ */
+
+void
+smanager::write_trace () const
+{
+    if (perftrace())
+    {
+        std::string filename = perftrace_file();
+        if (filename.empty())
+        {
+            filename = filename_concatenate
+            (
+                rc().home_config_directory(), "seq66-trace.json"
+            );
+        }
+        if (perftrace_dump(filename))
+            file_message("Trace", filename);
+        else
+            file_error("Trace", filename);
+    }
+}
+
+/**
+ *  Saves the MIDI file without making the caller wait on the disk.  The song
+ *  is encoded into a buffer here, which is a consistent snapshot of the
+ *  patterns, triggers, and mute-groups, taken under the same locks used by a
+ *  normal save.  The buffer is then written by a thread.  The performer is
+ *  marked unmodified now; check_background_save() marks it modified again
+ *  if the write fails.  A save still in progress is waited for first.
+ *
+ * \param filename
+ *      The full path to the MIDI file to write.
+ *
+ * \param [out] msg
+ *      Holds the error message if the song could not be encoded.
+ *
+ * \return
+ *      Returns true if the song was encoded and the write was started.
+ */
+
+bool
+smanager::save_in_background (const std::string & filename, std::string & msg)
+{
+    finish_background_save();
+
+    bool glob = usr().global_seq_feature();
+    std::unique_ptr<midifile> f(new midifile(filename, perf()->ppqn(), glob));
+    bool result = f->encode(*perf());
+    if (result)
+    {
+        std::string oldname = rc().midi_filename();
+        if (oldname != filename)
+            (void) midijournal::discard(oldname);   /* a "Save As"          */
+
+        rc().midi_filename(filename);
+        rc().last_used_dir(filename.substr(0, filename.rfind("/") + 1));
+        rc().add_recent_file(filename);
+        perf()->unmodify();
+        m_save_thread = std::thread
+        (
+            [this, filename] (std::unique_ptr<midifile> mf)
+            {
+                bool ok = mf->write_encoded();
+                std::lock_guard<std::mutex> lock(m_save_mutex);
+                m_save_ok = ok;
+                m_save_message = ok ? filename : mf->error_message() ;
+                m_save_done = true;
+                session_wake();             /* report it without delay  */
+            },
+            std::move(f)
+        );
+    }
+    else
+    {
+        msg = f->error_message();
+        file_error("Encoding failed", filename);
+    }
+    return result;
+}
+
+/**
+ *  Reports the outcome of a finished background save, once.  Meant to be
+ *  called periodically by the thread that owns the performer, such as the
+ *  run() loop of clinsmanager or the timer of the Qt session manager.
+ */
+
+void
+smanager::check_background_save ()
+{
+    bool done = false;
+    bool ok = false;
+    std::string message;
+    {
+        std::lock_guard<std::mutex> lock(m_save_mutex);
+        done = m_save_done;
+        if (done)
+        {
+            ok = m_save_ok;
+            message = m_save_message;
+            m_save_done = false;
+        }
+    }
+    if (done)
+    {
+        if (m_save_thread.joinable())
+            m_save_thread.join();
+
+        if (ok)
+        {
+            file_message("Wrote MIDI file", message);
+            (void) midijournal::discard(message);   /* all edits saved      */
+        }
+        else
+        {
+            file_error("Write failed", message);
+            if (not_nullptr(perf()))
+                perf()->modify();                   /* still needs a save   */
+        }
+    }
+}
+
+/**
+ *  Waits for a background save, if any, and reports it.
+ */
+
+void
+smanager::finish_background_save ()
+{
+    if (m_save_thread.joinable())
+        m_save_thread.join();
+
+    check_background_save();
+}
+
+/**
+ *  Writes the patterns changed since the last write to the edit journal of
+ *  the song, every 'rc' "journal-interval" seconds.  Meant to be called
+ *  periodically, like check_background_save(), by the thread that owns the
+ *  performer.  While the song is unmodified, the journal just takes the
+ *  song as its starting point.  Nothing is done during a background save,
+ *  which discards the journal when it is done, or for a WRK file, which is
+ *  never saved under its own name.  See the midijournal class.
+ */
+
+void
+smanager::journal_edits ()
+{
+    int interval = rc().journal_interval();
+    if (interval <= 0 || is_nullptr(perf()) || m_save_thread.joinable())
+        return;
+
+    const std::string & fname = rc().midi_filename();
+    if (fname.empty() || file_extension_match(fname, "wrk"))
+        return;
+
+    long now = microtime();
+    if (now - m_journal_time < long(interval) * 1000000L)
+        return;
+
+    m_journal_time = now;
+
+    performer & p = *perf();
+    bool fresh = ! m_journal || m_journal->song_name() != fname ||
+        m_journal->ppqn() != p.ppqn();          /* records need one PPQN    */
+
+    if (fresh)
+        m_journal.reset(new (std::nothrow) midijournal(fname, p.ppqn()));
+
+    if (! m_journal)
+        return;
+
+    if (p.modified())
+    {
+        bool ok;
+        if (fresh)                              /* no known starting point  */
+        {
+            ok = m_journal->compact(p);
+        }
+        else
+        {
+            ok = m_journal->append(p);
+            if (ok && m_journal->journal_size() > c_journal_compact_size)
+                ok = m_journal->compact(p);
+        }
+        if (! ok)
+        {
+            std::string jname = midijournal::journal_name(fname);
+            file_error("Journal write failed", jname);
+        }
+    }
+    else
+        m_journal->start(p);
+}
+
 /**
  *  This function saves the following files (so far):
  *
@@ -689,6 +918,9 @@ smanager::close_session (std::string & msg, bool ok)
  *  session, if applicable.  That function also clears the message parameter
  *  before the saving starts.
  *
+ *  If the --trace option is on, the engine trace is also written, so that a
+ *  session-manager save or a SIGUSR1 captures the recent past.
+ *
  * \param [out] msg
  *      Provides a place to store any error message for the caller to use.
  *
@@ -700,6 +932,8 @@ smanager::close_session (std::string & msg, bool ok)
 bool
 smanager::save_session (std::string & msg, bool ok)
 {
+    write_trace();
+
     bool result = not_nullptr(perf());
     if (result)
     {
@@ -718,7 +952,11 @@ smanager::save_session (std::string & msg, bool ok)
                     if (is_wrk)
                         filename = file_extension_set(filename, ".midi");
 
-                    result = write_midi_file(*perf(), filename, msg);
+                    if (rc().save_in_background())
+                        result = save_in_background(filename, msg);
+                    else
+                        result = write_midi_file(*perf(), filename, msg);
+
                     if (result)
                         msg = result ? "Saved: " : "Not able to save: " ;
 
@@ -983,10 +1221,14 @@ smanager::error_handling ()
 bool
 smanager::create (int argc, char * argv [])
 {
+    startup_phase settings("main settings");
     bool result = main_settings(argc, argv);
+    settings.finish();
     if (result)
     {
+        startup_phase session("session");
         bool ok = create_session(argc, argv);       /* path, client ID, etc */
+        session.finish();
         if (ok)
         {
             /*
@@ -1000,10 +1242,15 @@ smanager::create (int argc, char * argv [])
                 homedir = rc().home_config_directory();
 
             session_message("Session manager path", homedir);
+
+            startup_phase project("project");
             (void) create_project(argc, argv, homedir);
         }
         if (ok)
+        {
+            startup_phase ctrl("'ctrl' file");
             (void) open_midi_control_file();
+        }
 
         /*
          * We don't want to return a false result, otherwise seq66 will
@@ -1016,6 +1263,7 @@ smanager::create (int argc, char * argv [])
         ok = create_performer();
         if (ok)
         {
+            startup_phase midifile("MIDI file");
             std::string fname = midi_filename();
             if (fname.empty())
             {
@@ -1040,10 +1288,13 @@ smanager::create (int argc, char * argv [])
                 (void) open_midi_file(fname);
 
         }
+        startup_phase lists("playlist and note-map");
         ok = open_playlist();
         if (ok)
             ok = open_note_mapper();
 
+        lists.finish();
+
 #if defined USE_CRIPPLED_RUN
 
         /*
@@ -1073,7 +1324,10 @@ smanager::create (int argc, char * argv [])
 
                 append_error_message(errmsgs);
             }
+            startup_phase window("window");
             result = create_window();
+            window.finish();
+            startup_report();
             if (result)
             {
                 if (perf()->new_ports_available())
@@ -25,11 +25,15 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-10
- * \updates       2023-04-03
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  One of the big new feature of some of these functions is writing the name of
  *  the application in color before each message that is put out.
+ *
+ *  While the msglog runs (see msglog.hpp), the messages are queued for its
+ *  writer thread instead of being written by the caller.  The code below
+ *  that writes to std::cout and std::cerr is used before and after that.
  */
 
 #include <assert.h>                     /* defines the assert() macro       */
@@ -38,6 +42,7 @@
 #include <iostream>
 
 #include "util/basic_macros.hpp"        /* basic macros-cum-functions       */
+#include "util/msglog.hpp"              /* seq66::post_msglog()             */
 
 #if defined SEQ66_PLATFORM_UNIX
 #include <unistd.h>                     /* C::write(2)                      */
@@ -281,7 +286,7 @@ async_safe_utoa (char * destination, unsigned number, bool spacebefore)
 void
 info_message (const std::string & msg, const std::string & data)
 {
-    if (verbose())
+    if (verbose() && ! post_msglog(msglevel::info, msg, msg, data))
     {
         std::cout << seq_client_tag(msglevel::info) << " " << msg;
         if (! data.empty())
@@ -295,6 +300,9 @@ info_message (const std::string & msg, const std::string & data)
 void
 status_message (const std::string & msg, const std::string & data)
 {
+    if (post_msglog(msglevel::status, msg, msg, data))
+        return;
+
     std::cout << seq_client_tag(msglevel::status) << " " << msg;
     if (! data.empty())
         std::cout << ": " << data;
@@ -306,6 +314,9 @@ status_message (const std::string & msg, const std::string & data)
 void
 session_message (const std::string & msg, const std::string & data)
 {
+    if (post_msglog(msglevel::session, msg, msg, data))
+        return;
+
     std::cout << seq_client_tag(msglevel::session) << " " << msg;
     if (! data.empty())
         std::cout << ": " << data;
@@ -331,6 +342,9 @@ session_message (const std::string & msg, const std::string & data)
 void
 warn_message (const std::string & msg, const std::string & data)
 {
+    if (post_msglog(msglevel::warn, msg, msg, data))
+        return;
+
     std::cerr << seq_client_tag(msglevel::warn) << " " << msg;
     if (! data.empty())
         std::cerr << ": " << data;
@@ -356,6 +370,9 @@ warn_message (const std::string & msg, const std::string & data)
 bool
 error_message (const std::string & msg, const std::string & data)
 {
+    if (post_msglog(msglevel::error, msg, msg, data))
+        return false;
+
     std::cerr << seq_client_tag(msglevel::error) << " " << msg;
     if (! data.empty())
         std::cerr << ": " << data;
@@ -389,7 +406,7 @@ static const char * s_normal = "\033[0m";
 void
 debug_message (const std::string & msg, const std::string & data)
 {
-    if (investigate())
+    if (investigate() && ! post_msglog(msglevel::debug, msg, msg, data))
     {
         std::cerr << seq_client_tag(msglevel::debug) << " ";
         if (is_a_tty(STDERR_FILENO))
@@ -427,8 +444,12 @@ debug_message (const std::string & msg, const std::string & data)
 bool
 file_error (const std::string & tag, const std::string & path)
 {
-    std::cerr << seq_client_tag(msglevel::error) << " "
-        << tag << ": '" << path << "'" << std::endl;
+    std::string quoted = "'" + path + "'";
+    if (! post_msglog(msglevel::error, tag, tag, quoted))
+    {
+        std::cerr << seq_client_tag(msglevel::error) << " "
+            << tag << ": " << quoted << std::endl;
+    }
 
     return false;
 }
@@ -448,8 +469,12 @@ file_error (const std::string & tag, const std::string & path)
 void
 file_message (const std::string & tag, const std::string & path)
 {
-    std::cout << seq_client_tag(msglevel::status) << " "
-        << tag << ": '" << path << "'" << std::endl;
+    std::string quoted = "'" + path + "'";
+    if (! post_msglog(msglevel::status, tag, tag, quoted))
+    {
+        std::cout << seq_client_tag(msglevel::status) << " "
+            << tag << ": " << quoted << std::endl;
+    }
 }
 
 /**
@@ -588,31 +613,14 @@ msgprintf (msglevel lev, std::string fmt, ...)
         va_start(args, fmt);
 
         std::string output = formatted(fmt, args);          /* Steps 2 & 3  */
-        switch (lev)
+        bool shown = lev != msglevel::info || verbose();
+        if (shown && ! post_msglog(lev, fmt, output))
         {
-        case msglevel::none:
-
-            std::cout << seq_client_tag(lev) << " " << output << std::endl;
-            break;
-
-        case msglevel::info:
-
-            if (verbose())
-                std::cout << seq_client_tag(lev) << " " << output << std::endl;
-            break;
-
-        case msglevel::status:
-        case msglevel::session:
-
-            std::cout << seq_client_tag(lev) << " " << output << std::endl;
-            break;
-
-        case msglevel::warn:
-        case msglevel::error:
-        case msglevel::debug:
+            bool iserror = lev == msglevel::warn ||
+                lev == msglevel::error || lev == msglevel::debug;
 
-            std::cerr << seq_client_tag(lev) << " " << output << std::endl;
-            break;
+            std::ostream & os = iserror ? std::cerr : std::cout ;
+            os << seq_client_tag(lev) << " " << output << std::endl;
         }
         va_end(args);                                       /* 2019-04-21   */
     }
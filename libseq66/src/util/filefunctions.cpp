@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2025-01-27
+ * \updates       2026-10-14
  * \version       $Revision$
  *
  *    We basically include only the functions we need for Seq66, not
@@ -622,6 +622,32 @@ file_size (const std::string & filename)
     return result;
 }
 
+/**
+ *  Gets the time of the last modification of a file, as used to tell if a
+ *  file changed since it was last looked at.
+ *
+ * \param filename
+ *      The name of the file.
+ *
+ * \return
+ *      Returns the modification time, in seconds since the epoch, or 0 if
+ *      the file cannot be examined.
+ */
+
+long
+file_mod_time (const std::string & filename)
+{
+    long result = 0;
+    if (file_name_good(filename))
+    {
+        stat_t statusbuf;
+        int statresult = S_STAT(filename.c_str(), &statusbuf);
+        if (statresult == 0)
+            result = long(statusbuf.st_mtime);
+    }
+    return result;
+}
+
 /**
  *  Verifies that a file-name pointer is legal.  The following checks are
  *  made:
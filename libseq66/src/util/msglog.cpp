@@ -0,0 +1,453 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          msglog.cpp
+ *
+ *  This module defines the asynchronous writer of the console messages.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The ring is the bounded queue of Dmitry Vyukov.  Each slot has a
+ *  sequence number; a producer claims position p by a compare-and-swap of
+ *  the head when the slot's number is p, fills it, and sets the number to
+ *  p + 1, which tells the writer it is full.  The writer empties the slot
+ *  and sets the number to p + size, which frees it for the next lap.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstring>                      /* std::memcpy()                    */
+#include <functional>                   /* std::hash<>                      */
+#include <iostream>                     /* std::cout, std::cerr             */
+
+#include "util/msglog.hpp"              /* seq66::msglog class              */
+
+#if defined SEQ66_PLATFORM_UNIX
+#include <unistd.h>                     /* STDERR_FILENO                    */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The count of records in the ring, a power of two.
+ */
+
+static const std::size_t c_msglog_records = 1024;
+
+/**
+ *  The interval between drains by the writer thread.  Short enough that a
+ *  message shows up at once, to the eye.
+ */
+
+static const int c_msglog_drain_ms = 20;
+
+/**
+ *  The number of messages from one site allowed in a second.
+ */
+
+static const int c_msglog_site_limit = 20;
+
+/**
+ *  The colors of a debug message, as in debug_message().
+ */
+
+static const char * s_black  = "\033[1;30m";
+static const char * s_normal = "\033[0m";
+
+msglog::msglog () :
+    m_records       (),
+    m_mask          (c_msglog_records - 1),
+    m_head          (0),
+    m_tail          (0),
+    m_sites         (c_site_count),
+    m_thread        (),
+    m_mutex         (),
+    m_wakeup        (),
+    m_stopping      (false),
+    m_running       (false),
+    m_posting       (0),
+    m_dropped       (0),
+    m_reported      (0)
+{
+    for (auto & s : m_sites)
+    {
+        s.ms_key = 0;
+        s.ms_second = 0;
+        s.ms_count = 0;
+        s.ms_suppressed = 0;
+    }
+}
+
+msglog::~msglog ()
+{
+    stop();
+}
+
+/**
+ *  Allocates the ring, if not yet done, and starts the writer thread.
+ *
+ * \return
+ *      Returns true if the thread was started.
+ */
+
+bool
+msglog::start ()
+{
+    bool result = ! m_running;
+    if (result)
+    {
+        if (m_records.empty())
+        {
+            std::vector<record> temp(c_msglog_records);
+            m_records.swap(temp);
+        }
+        for (std::size_t i = 0; i < m_records.size(); ++i)
+            m_records[i].mr_sequence.store(i, std::memory_order_relaxed);
+
+        m_head = 0;
+        m_tail = 0;
+        m_stopping = false;
+        m_thread = std::thread(&msglog::writer_func, this);
+        m_running = true;
+    }
+    return result;
+}
+
+/**
+ *  Stops taking messages, waits for the producers still inside post(), and
+ *  stops the writer thread, which writes the rest of the messages first.
+ */
+
+void
+msglog::stop ()
+{
+    if (m_running)
+    {
+        m_running = false;
+        while (m_posting > 0)
+            std::this_thread::yield();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+}
+
+/**
+ *  Queues a message for the writer thread, unless its site is over the
+ *  rate limit.  Never waits.
+ *
+ * \param lev
+ *      The level of the message, which selects its tag and stream.  Whether
+ *      an info message is shown at all is decided by the caller.
+ *
+ * \param sitetext
+ *      The text that identifies where the message comes from, such as the
+ *      message itself or the format of msgprintf(), without the variable
+ *      data.
+ *
+ * \param msg
+ *      The message, sans the tag and the newline.
+ *
+ * \param data
+ *      Additional text, shown after a colon.  Optional.
+ *
+ * \return
+ *      Returns false if the msglog is not running, or the message is empty,
+ *      in which case the caller writes the message itself.  Otherwise, the
+ *      message is queued, suppressed, or dropped, and true is returned.
+ */
+
+bool
+msglog::post
+(
+    msglevel lev, const std::string & sitetext,
+    const std::string & msg, const std::string & data
+)
+{
+    if (msg.empty() || ! m_running)
+        return false;
+
+    ++m_posting;
+    bool result = m_running;                    /* stop() may have begun    */
+    if (result)
+    {
+        int suppressed = 0;
+        if (! limited(sitetext, suppressed))
+        {
+            if (suppressed > 0)
+            {
+                std::string note = std::to_string(suppressed) +
+                    " similar messages suppressed";
+
+                (void) push(lev, note, msg);
+            }
+            (void) push(lev, msg, data);
+        }
+    }
+    --m_posting;
+    return result;
+}
+
+/**
+ *  Counts a message against its site's limit for the current second.  The
+ *  table is updated without a lock; a lost count in a race only makes the
+ *  limit a little loose.
+ *
+ * \param sitetext
+ *      The text of the site, which is hashed to find its slot.
+ *
+ * \param [out] suppressed
+ *      Set to the count of messages of this site suppressed in an earlier
+ *      second, if this is the first message of a new second, else 0.
+ *
+ * \return
+ *      Returns true if the message is to be suppressed.
+ */
+
+bool
+msglog::limited (const std::string & sitetext, int & suppressed)
+{
+    using namespace std::chrono;
+    long second = long
+    (
+        duration_cast<seconds>(steady_clock::now().time_since_epoch()).count()
+    );
+    std::size_t key = std::hash<std::string>()(sitetext);
+    site & s = m_sites[key % std::size_t(c_site_count)];
+    suppressed = 0;
+    if (s.ms_key.load() != key)
+    {
+        s.ms_key = key;                         /* take over the slot       */
+        s.ms_second = second;
+        s.ms_count = 1;
+        s.ms_suppressed = 0;
+        return false;
+    }
+
+    long old = s.ms_second.load();
+    if (old != second && s.ms_second.compare_exchange_strong(old, second))
+    {
+        s.ms_count = 0;
+        suppressed = s.ms_suppressed.exchange(0);
+    }
+    if (++s.ms_count > c_msglog_site_limit)
+    {
+        ++s.ms_suppressed;
+        return true;
+    }
+    return false;
+}
+
+/**
+ *  Claims the next slot of the ring and copies the message into it.
+ *
+ * \return
+ *      Returns false if the ring is full, in which case the message is
+ *      counted as dropped.
+ */
+
+bool
+msglog::push
+(
+    msglevel lev, const std::string & msg, const std::string & data
+)
+{
+    record * slot = nullptr;
+    std::size_t pos = m_head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        record & r = m_records[pos & m_mask];
+        std::size_t seq = r.mr_sequence.load(std::memory_order_acquire);
+        long diff = long(seq) - long(pos);
+        if (diff == 0)
+        {
+            if
+            (
+                m_head.compare_exchange_weak
+                (
+                    pos, pos + 1, std::memory_order_relaxed
+                )
+            )
+            {
+                slot = &r;
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            ++m_dropped;                        /* the ring is full         */
+            return false;
+        }
+        else
+            pos = m_head.load(std::memory_order_relaxed);
+    }
+
+    std::size_t room = std::size_t(c_text_size - 1);
+    std::size_t len = msg.size() < room ? msg.size() : room ;
+    std::memcpy(slot->mr_text, msg.data(), len);
+    if (! data.empty() && len + 2 < room)
+    {
+        std::size_t more = data.size();
+        slot->mr_text[len++] = ':';
+        slot->mr_text[len++] = ' ';
+        if (more > room - len)
+            more = room - len;
+
+        std::memcpy(slot->mr_text + len, data.data(), more);
+        len += more;
+    }
+    slot->mr_text[len] = 0;
+    slot->mr_level = lev;
+    slot->mr_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ *  Drains the ring every so often, until stopped, then once more.
+ */
+
+void
+msglog::writer_func ()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (! m_stopping)
+    {
+        (void) m_wakeup.wait_for
+        (
+            lock, std::chrono::milliseconds(c_msglog_drain_ms)
+        );
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();
+}
+
+/**
+ *  Writes the full slots to std::cout or std::cerr, as the message
+ *  functions did, with the tag of the message level in front.  The streams
+ *  are flushed once per drain instead of once per line.
+ */
+
+void
+msglog::drain ()
+{
+    bool wrote_out = false;
+    bool wrote_err = false;
+    for (;;)
+    {
+        record & r = m_records[m_tail & m_mask];
+        std::size_t seq = r.mr_sequence.load(std::memory_order_acquire);
+        if (seq != m_tail + 1)
+            break;
+
+        msglevel lev = r.mr_level;
+        bool iserror = lev == msglevel::error || lev == msglevel::warn ||
+            lev == msglevel::debug;
+
+        std::ostream & os = iserror ? std::cerr : std::cout ;
+        os << seq_client_tag(lev) << " ";
+        if (lev == msglevel::debug && is_a_tty(STDERR_FILENO))
+            os << s_black << r.mr_text << s_normal << "\n";
+        else
+            os << r.mr_text << "\n";
+
+        if (iserror)
+            wrote_err = true;
+        else
+            wrote_out = true;
+
+        r.mr_sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+        ++m_tail;
+    }
+    report_dropped();
+    if (wrote_out)
+        std::cout.flush();
+
+    if (wrote_err)
+        std::cerr.flush();
+}
+
+/**
+ *  Writes the count of messages newly dropped, if any.
+ */
+
+void
+msglog::report_dropped ()
+{
+    int dropped = m_dropped;
+    if (dropped > m_reported)
+    {
+        std::cerr << seq_client_tag(msglevel::warn) << " "
+            << (dropped - m_reported) << " messages dropped" << "\n";
+
+        m_reported = dropped;
+    }
+}
+
+/*
+ *  The application's msglog.
+ */
+
+static msglog s_msglog;
+
+bool
+start_msglog ()
+{
+    return s_msglog.start();
+}
+
+void
+stop_msglog ()
+{
+    s_msglog.stop();
+}
+
+bool
+post_msglog
+(
+    msglevel lev, const std::string & sitetext,
+    const std::string & msg, const std::string & data
+)
+{
+    return s_msglog.post(lev, sitetext, msg, data);
+}
+
+}           // namespace seq66
+
+/*
+ * msglog.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,133 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          parallel.cpp
+ *
+ *  This module defines a helper to spread a batch of independent jobs over
+ *  a few short-lived threads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The jobs are handed out one at a time from an atomic index, so a slow
+ *  job does not hold up the ones behind it, and the calling thread takes
+ *  jobs too, rather than waiting idle.
+ */
+
+#include <algorithm>                    /* std::min()                       */
+#include <atomic>                       /* std::atomic<>                    */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "util/parallel.hpp"            /* seq66::parallel_for()            */
+
+/*
+ *  This namespace is not documented because it screws up the document
+ *  processing done by Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ * \return
+ *      Returns the number of hardware threads, or 1 if it is not known.
+ */
+
+std::size_t
+parallel_cores ()
+{
+    std::size_t result = std::size_t(std::thread::hardware_concurrency());
+    return result > 0 ? result : 1 ;
+}
+
+/**
+ *  Calls the job once for each index from 0 to count - 1, spread over the
+ *  given number of threads, the caller being one of them.  Each index is
+ *  done exactly once, in no particular order, so a job must touch only its
+ *  own results.  All of the jobs are done when this function returns, and
+ *  the joins make their results visible to the caller.
+ *
+ * \param count
+ *      The number of jobs.
+ *
+ * \param job
+ *      The function to call with the index of each job.
+ *
+ * \param workers
+ *      The most threads to use, counting the caller.  If 1 or less, the
+ *      caller does all of the jobs.  No more threads than jobs are used.
+ */
+
+void
+parallel_for
+(
+    std::size_t count,
+    const std::function<void (std::size_t)> & job,
+    std::size_t workers
+)
+{
+    std::atomic<std::size_t> next(0);
+    auto worker = [&next, &job, count] ()
+    {
+        for (;;)
+        {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count)
+                break;
+
+            job(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    workers = std::min(workers, count);
+    for (std::size_t w = 1; w < workers; ++w)
+        threads.emplace_back(worker);
+
+    worker();                                   /* this thread helps        */
+    for (auto & t : threads)
+        t.join();
+}
+
+/**
+ *  Calls the job once for each index, over as many threads as there are
+ *  cores (see parallel_cores()).
+ */
+
+void
+parallel_for
+(
+    std::size_t count,
+    const std::function<void (std::size_t)> & job
+)
+{
+    parallel_for(count, job, parallel_cores());
+}
+
+}               // namespace seq66
+
+/*
+ * parallel.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-01-16
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Seq66 needs a mutex for sequencer operations. We have finally, after a
@@ -179,6 +179,21 @@ recmutex::unlock () const
     (void) pthread_mutex_unlock(&m_mutex_lock);
 }
 
+/**
+ *  Tries to lock the recmutex without blocking.  Like lock(), this succeeds
+ *  if the calling thread already holds the lock.
+ *
+ * \return
+ *      Returns true if the lock was obtained.  The caller must then call
+ *      unlock().
+ */
+
+bool
+recmutex::try_lock () const
+{
+    return pthread_mutex_trylock(&m_mutex_lock) == 0;
+}
+
 /**
  *  FreeBSD prthreads is different from the others.
  */
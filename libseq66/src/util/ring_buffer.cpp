@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-09-19
- * \updates       2023-12-08
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  A lock-free ring buffer.
@@ -98,6 +98,11 @@
  *      -   Provides a pop_front() to remove the front object.
  *      -   Currently does not handle TYPE = char as strings, just single
  *          characters.
+ *      -   Is safe without locking for one producer thread and one consumer
+ *          thread, using atomic free-running head and tail counters.  A
+ *          full buffer refuses new items rather than overwriting old ones.
+ *      -   Provides push() and pop() for moving a batch of items with one
+ *          index update.
  *
  *  Recommendations for TYPE:
  *
@@ -250,8 +255,8 @@ run_ring_test ()
     }
 
     /*
-     * Full buffer test. Ultimately 10 items entered. Only 8 should remain.
-     * Then we pop all items in the ring_buffer and show them.
+     * Full buffer test. Ultimately 10 items offered. Only the first 8 should
+     * be stored.  Then we pop all items in the ring_buffer and show them.
      * (Should compare counters at some point.)
      */
 
@@ -303,7 +308,7 @@ run_ring_test ()
     if (result)
     {
         /*
-         * Here, rt_a and rt_b should be dropped.
+         * Here, rt_i and rt_j should be refused.
          */
 
         rb.push_back(rt_i);
@@ -313,7 +318,7 @@ run_ring_test ()
         std::size_t wspace = rb.write_space();
         if (rb.count() != 8 || rspace != 8 || wspace != 0)
         {
-            show_error("objects not overwritten");
+            show_error("objects overwritten");
             result = false;
         }
         if (rb.dropped() != 2)
@@ -329,7 +334,7 @@ run_ring_test ()
                 ring_test::cref item = rb.front();
                 std::string values = item.to_string();
                 printf("[%d] %s\n", i, values.c_str());
-                if (item.test_counter() != (i + 3))
+                if (item.test_counter() != (i + 1))
                     result = false;
 
                 rb.pop_front();
@@ -339,7 +344,7 @@ run_ring_test ()
 
             if (rb.empty())
             {
-                show_message("Should see rt_c through rt_j values");
+                show_message("Should see rt_a through rt_h values");
             }
             else
             {
@@ -349,6 +354,30 @@ run_ring_test ()
         }
     }
 
+    /*
+     *  Move test.  The moved item must come back whole, with its text, and
+     *  the dropped count must not change.
+     */
+
+    if (result)
+    {
+        rb.clear();
+
+        ring_test rt;
+        bool ok = rb.push_back(ring_test(11, "rt_k"));
+        ok = ok && rb.pop_front(rt);
+        if (! ok || rt.test_counter() != 11 || rt.test_text() != "rt_k")
+        {
+            show_error("ring_buffer move push/pop failed");
+            result = false;
+        }
+        if (result && (! rb.empty() || rb.dropped() != 0 || rb.pop_front(rt)))
+        {
+            show_error("ring_buffer not empty after move pop");
+            result = false;
+        }
+    }
+
     /*
      *  Alternative push/pops with access via front(). Note that back()
      *  goes back one step from the tail in order to (hopefully) get a valid
@@ -0,0 +1,162 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          rwmutex.cpp
+ *
+ *  This module defines a reader/writer mutex that is recursive for the
+ *  writer.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  An uncontended lock or unlock is one atomic operation on the
+ *  std::shared_timed_mutex, plus a relaxed load of the owner, about the
+ *  cost of the pthread recursive mutex it replaces.
+ */
+
+#include "util/rwmutex.hpp"             /* seq66::rwmutex                   */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+rwmutex::rwmutex () :
+    m_lock      (),
+    m_owner     (std::thread::id()),
+    m_depth     (0)
+{
+    // no code
+}
+
+/**
+ *  As with recmutex, copying an object that holds a mutex gives the copy a
+ *  new mutex of its own.
+ */
+
+rwmutex::rwmutex (const rwmutex & /* rhs */) :
+    m_lock      (),
+    m_owner     (std::thread::id()),
+    m_depth     (0)
+{
+    // no code
+}
+
+rwmutex &
+rwmutex::operator = (const rwmutex & /* rhs */)
+{
+    return *this;
+}
+
+/**
+ *  Takes the writer lock, or, if this thread already holds it, goes one
+ *  level deeper.
+ */
+
+void
+rwmutex::lock () const
+{
+    if (owned())
+    {
+        ++m_depth;
+    }
+    else
+    {
+        m_lock.lock();
+        m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        m_depth = 1;
+    }
+}
+
+void
+rwmutex::unlock () const
+{
+    if (--m_depth == 0)
+    {
+        m_owner.store(std::thread::id(), std::memory_order_relaxed);
+        m_lock.unlock();
+    }
+}
+
+/**
+ *  Used by sequence::play() to see if an editor has the pattern.
+ *
+ * \return
+ *      Returns true if the writer lock is now held.
+ */
+
+bool
+rwmutex::try_lock () const
+{
+    bool result = owned();
+    if (result)
+    {
+        ++m_depth;
+    }
+    else
+    {
+        result = m_lock.try_lock();
+        if (result)
+        {
+            m_owner.store
+            (
+                std::this_thread::get_id(), std::memory_order_relaxed
+            );
+            m_depth = 1;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Takes the reader lock.  The writer taking it just goes one level deeper
+ *  into the writer lock.
+ */
+
+void
+rwmutex::lock_shared () const
+{
+    if (owned())
+        ++m_depth;
+    else
+        m_lock.lock_shared();
+}
+
+void
+rwmutex::unlock_shared () const
+{
+    if (owned())
+        unlock();
+    else
+        m_lock.unlock_shared();
+}
+
+}           // namespace seq66
+
+/*
+ * rwmutex.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,158 @@
+#if ! defined SEQ66_OSCCONTROL_HPP
+#define SEQ66_OSCCONTROL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          osccontrol.hpp
+ *
+ *  This module declares an OSC server of controls.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  When the 'rc' option "osc-control-port" is set, a liblo server thread
+ *  listens on that UDP port for controls, which map onto the same
+ *  automation slots as the MIDI and keystroke controls:
+ *
+ *      -   "/seq66/control/automation" i:slot [i:action [i:value]].
+ *      -   "/seq66/control/loop" i:pattern [i:action].
+ *      -   "/seq66/control/mute_group" i:group [i:action].
+ *
+ *  The action is that of automation::action, toggle by default.  A value is
+ *  not limited to 7 bits.  The liblo thread only queues the control to the
+ *  performer (see performer::post_remote_control()), which the input
+ *  thread dispatches as it does MIDI controls, so the liblo thread never
+ *  waits on the performer's locks.
+ */
+
+#include "seq66_features.hpp"           /* feature (SUPPORT) macros         */
+#include "ctrl/automation.hpp"          /* seq66::automation::slot, action  */
+
+#if defined SEQ66_LIBLO_SUPPORT
+#include <lo/lo.h>                      /* library for the OSC protocol     */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class performer;
+
+/**
+ *  Takes controls for a performer over OSC.
+ */
+
+class osccontrol
+{
+
+private:
+
+    /**
+     *  The performer to which the controls are posted.
+     */
+
+    performer & m_perf;
+
+    /**
+     *  The UDP port listened to.
+     */
+
+    int m_port;
+
+    /**
+     *  The count of controls refused, because out of range or because the
+     *  queue was full.  Written only by the liblo thread.
+     */
+
+    int m_refused;
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+    /**
+     *  The liblo server thread.
+     */
+
+    lo_server_thread m_lo_server_thread;
+
+#endif
+
+public:
+
+    osccontrol (performer & p, int port);
+    ~osccontrol ();
+
+    osccontrol (const osccontrol &) = delete;
+    osccontrol & operator = (const osccontrol &) = delete;
+
+    bool start ();
+    void stop ();
+    bool post (automation::slot s, int index, int act, int value);
+
+    int port () const
+    {
+        return m_port;
+    }
+
+    int refused () const
+    {
+        return m_refused;
+    }
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+private:
+
+    static int osc_automation
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static int osc_loop
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static int osc_mute_group
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static void osc_error (int num, const char * msg, const char * path);
+
+#endif
+
+};          // class osccontrol
+
+}           // namespace seq66
+
+#endif      // SEQ66_OSCCONTROL_HPP
+
+/*
+ * osccontrol.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
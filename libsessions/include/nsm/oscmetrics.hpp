@@ -0,0 +1,166 @@
+#if ! defined SEQ66_OSCMETRICS_HPP
+#define SEQ66_OSCMETRICS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          oscmetrics.hpp
+ *
+ *  This module declares an OSC server of the engine metrics.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  When the 'rc' option "metrics-port" is set, a liblo server thread
+ *  listens on that UDP port for two queries:
+ *
+ *      -   "/seq66/metrics".  Each metric is sent back to the sender as a
+ *          "/seq66/metrics/<name>" message holding a double, or, for the
+ *          metrics of a buss, an int (the buss) and a double.
+ *      -   "/seq66/metrics/text".  All of the metrics are sent back as one
+ *          "/seq66/metrics/text" message holding a string in the Prometheus
+ *          text format, for a bridge to a dashboard.
+ *
+ *  The metrics are read from atomic counters (see outputstats), so a query
+ *  never blocks the I/O threads.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector                      */
+
+#include "seq66_features.hpp"           /* feature (SUPPORT) macros         */
+
+#if defined SEQ66_LIBLO_SUPPORT
+#include <lo/lo.h>                      /* library for the OSC protocol     */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class performer;
+
+/**
+ *  Serves the metrics of a performer over OSC.
+ */
+
+class oscmetrics
+{
+
+public:
+
+    /**
+     *  One metric.  A buss of -1 marks a metric of the whole engine.
+     */
+
+    class metric
+    {
+
+    public:
+
+        std::string om_name;            /**< The name, such as "underruns". */
+        std::string om_help;            /**< The Prometheus HELP text.      */
+        int om_bus;                     /**< The buss, or -1.               */
+        double om_value;                /**< The reading.                   */
+
+    };
+
+    using metrics = std::vector<metric>;
+
+private:
+
+    /**
+     *  The performer whose metrics are served.
+     */
+
+    performer & m_perf;
+
+    /**
+     *  The UDP port listened to.
+     */
+
+    int m_port;
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+    /**
+     *  The liblo server thread.
+     */
+
+    lo_server_thread m_lo_server_thread;
+
+#endif
+
+public:
+
+    oscmetrics (performer & p, int port);
+    ~oscmetrics ();
+
+    oscmetrics (const oscmetrics &) = delete;
+    oscmetrics & operator = (const oscmetrics &) = delete;
+
+    bool start ();
+    void stop ();
+    metrics gather () const;
+    std::string text () const;
+
+    int port () const
+    {
+        return m_port;
+    }
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+private:
+
+    static int osc_metrics
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static int osc_metrics_text
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static void osc_error (int num, const char * msg, const char * path);
+
+    void reply (lo_message msg);
+    void reply_text (lo_message msg);
+
+#endif
+
+};          // class oscmetrics
+
+}           // namespace seq66
+
+#endif      // SEQ66_OSCMETRICS_HPP
+
+/*
+ * oscmetrics.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,212 @@
+#if ! defined SEQ66_OSCMIRROR_HPP
+#define SEQ66_OSCMIRROR_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          oscmirror.hpp
+ *
+ *  This module declares the OSC link between a mirroring primary and its
+ *  replica.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  For a show with a hot spare, the 'rc' option "mirror-role" makes one
+ *  Seq66 the primary and another the replica.  The primary's mirror thread
+ *  sends UDP datagrams to "mirror-host" at "mirror-port":
+ *
+ *      -   "/seq66/mirror/action" iiiiiii:  serial, slot, action, d0, d1,
+ *          index, inverse.  One for each automation control done on the
+ *          primary, from MIDI, a key, or OSC, as soon as it is done.  The
+ *          replica replays it through the same opcontainer operation.
+ *      -   "/seq66/mirror/state" iiihdis:  serial, running, song mode, tick,
+ *          tempo, playscreen, and a string of '1' and '0' for the armed
+ *          status of each slot of the playscreen.  Sent every 50 ms, and
+ *          just after any actions.  It covers whatever the actions do not,
+ *          such as clicks in the user interface, and any datagrams lost.
+ *
+ *  The serial number, shared by both messages, lets the replica count the
+ *  ones lost.  The replica's liblo thread only queues what it gets to the
+ *  performer, as osccontrol does, and the input thread applies it; see
+ *  performer::mirror_follow().  The replica plays along with its output on
+ *  standby, so that when the primary goes quiet it need only unmute.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+
+#include "seq66_features.hpp"           /* feature (SUPPORT) macros         */
+
+#if defined SEQ66_LIBLO_SUPPORT
+#include <lo/lo.h>                      /* library for the OSC protocol     */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class performer;
+
+/**
+ *  Sends a primary's controls and state to its replica, or takes them in.
+ */
+
+class oscmirror
+{
+
+private:
+
+    /**
+     *  The performer mirrored, or mirroring.
+     */
+
+    performer & m_perf;
+
+    /**
+     *  True for the primary, which sends; false for the replica, which
+     *  listens.
+     */
+
+    bool m_primary;
+
+    /**
+     *  The host of the replica.  Used by the primary only.
+     */
+
+    std::string m_host;
+
+    /**
+     *  The UDP port of the replica.
+     */
+
+    int m_port;
+
+    /**
+     *  Tells the primary's mirror thread to keep going.
+     */
+
+    std::atomic<bool> m_running;
+
+    /**
+     *  The primary's mirror thread, which sends the datagrams.
+     */
+
+    std::thread m_thread;
+
+    /**
+     *  The serial number of the last datagram sent (primary) or received
+     *  (replica).
+     */
+
+    int m_serial;
+
+    /**
+     *  The count of datagrams the replica found missing, by the gaps in the
+     *  serial numbers.  Written only by the liblo thread.
+     */
+
+    std::atomic<int> m_lost;
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+    /**
+     *  The address of the replica, for the primary.
+     */
+
+    lo_address m_lo_address;
+
+    /**
+     *  The liblo server thread of the replica.
+     */
+
+    lo_server_thread m_lo_server_thread;
+
+#endif
+
+public:
+
+    oscmirror
+    (
+        performer & p, bool primary, const std::string & host, int port
+    );
+    ~oscmirror ();
+
+    oscmirror (const oscmirror &) = delete;
+    oscmirror & operator = (const oscmirror &) = delete;
+
+    bool start ();
+    void stop ();
+
+    bool primary () const
+    {
+        return m_primary;
+    }
+
+    int port () const
+    {
+        return m_port;
+    }
+
+    int lost () const
+    {
+        return m_lost;
+    }
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+private:
+
+    void send_loop ();
+    bool send_actions ();
+    void send_state ();
+    void received (int serial);
+    static int osc_action
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static int osc_state
+    (
+        const char * path, const char * types,
+        lo_arg ** argv, int argc, lo_message msg, void * user_data
+    );
+    static void osc_error (int num, const char * msg, const char * path);
+
+#endif
+
+};          // class oscmirror
+
+}           // namespace seq66
+
+#endif      // SEQ66_OSCMIRROR_HPP
+
+/*
+ * oscmirror.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
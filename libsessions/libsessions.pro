@@ -46,11 +46,17 @@ contains (CONFIG, rtmidi) {
 contains (CONFIG, rtmidi) {
 HEADERS += include/nsm/nsmbase.hpp \
  include/nsm/nsmclient.hpp \
- include/nsm/nsmmessagesex.hpp
+ include/nsm/nsmmessagesex.hpp \
+ include/nsm/osccontrol.hpp \
+ include/nsm/oscmetrics.hpp \
+ include/nsm/oscmirror.hpp
 
 SOURCES += src/nsm/nsmbase.cpp \
  src/nsm/nsmclient.cpp \
  src/nsm/nsmmessagesex.cpp \
+ src/nsm/osccontrol.cpp \
+ src/nsm/oscmetrics.cpp \
+ src/nsm/oscmirror.cpp
 }
 
 INCLUDEPATH = ../include/qt/rtmidi \
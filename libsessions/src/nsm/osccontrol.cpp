@@ -0,0 +1,271 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          osccontrol.cpp
+ *
+ *  This module defines the OSC server of controls.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The handlers are registered for any argument types, and take an int, a
+ *  float, or a double for each argument, because many control surfaces
+ *  (e.g. TouchOSC) send floats.  A missing action means toggle.
+ */
+
+#include "nsm/osccontrol.hpp"           /* seq66::osccontrol class          */
+#include "play/performer.hpp"           /* seq66::performer class           */
+#include "util/basic_macros.hpp"        /* seq66::error_message()           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The paths of the controls.
+ */
+
+static const char * const s_automation_path = "/seq66/control/automation";
+static const char * const s_loop_path = "/seq66/control/loop";
+static const char * const s_mute_group_path = "/seq66/control/mute_group";
+
+osccontrol::osccontrol (performer & p, int port) :
+    m_perf              (p),
+    m_port              (port),
+    m_refused           (0)
+#if defined SEQ66_LIBLO_SUPPORT
+    ,
+    m_lo_server_thread  (nullptr)
+#endif
+{
+    // no code
+}
+
+osccontrol::~osccontrol ()
+{
+    stop();
+}
+
+/**
+ *  Creates the liblo server on the port and starts its thread.
+ *
+ * \return
+ *      Returns true if the server is running.
+ */
+
+bool
+osccontrol::start ()
+{
+#if defined SEQ66_LIBLO_SUPPORT
+    bool result = is_nullptr(m_lo_server_thread) && m_port > 0;
+    if (result)
+    {
+        std::string port = std::to_string(m_port);
+        m_lo_server_thread = lo_server_thread_new(port.c_str(), osc_error);
+        result = not_nullptr(m_lo_server_thread);
+        if (result)
+        {
+            (void) lo_server_thread_add_method
+            (
+                m_lo_server_thread, s_automation_path, nullptr,
+                osc_automation, this
+            );
+            (void) lo_server_thread_add_method
+            (
+                m_lo_server_thread, s_loop_path, nullptr, osc_loop, this
+            );
+            (void) lo_server_thread_add_method
+            (
+                m_lo_server_thread, s_mute_group_path, nullptr,
+                osc_mute_group, this
+            );
+            result = lo_server_thread_start(m_lo_server_thread) == 0;
+            if (result)
+                info_message("OSC control on UDP port", port);
+            else
+                stop();
+        }
+        if (! result)
+            error_message("Cannot take OSC control on UDP port", port);
+    }
+    return result;
+#else
+    return false;
+#endif
+}
+
+void
+osccontrol::stop ()
+{
+#if defined SEQ66_LIBLO_SUPPORT
+    if (not_nullptr(m_lo_server_thread))
+    {
+        (void) lo_server_thread_stop(m_lo_server_thread);
+        lo_server_thread_free(m_lo_server_thread);
+        m_lo_server_thread = nullptr;
+    }
+#endif
+}
+
+/**
+ *  Queues a control to the performer.  Called only in the liblo thread,
+ *  the one producer of the performer's remote-control queue.
+ *
+ * \param s
+ *      The slot, automation::slot::loop or ::mute_group, or the automation
+ *      slot.
+ *
+ * \param index
+ *      The pattern or group number.  Ignored for an automation slot.
+ *
+ * \param act
+ *      The automation::action value, 1 to 3.
+ *
+ * \param value
+ *      The value passed as d1.
+ *
+ * \return
+ *      Returns true if the control was queued.
+ */
+
+bool
+osccontrol::post (automation::slot s, int index, int act, int value)
+{
+    bool result = act > int(automation::action::none) &&
+        act < int(automation::action::max);
+
+    if (result)
+    {
+        automation::action a = static_cast<automation::action>(act);
+        result = m_perf.post_remote_control(s, a, index, value);
+    }
+    if (! result)
+        ++m_refused;
+
+    return result;
+}
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+/**
+ *  Gets an argument as an integer, whether it was sent as an int, a float,
+ *  or a double.
+ *
+ * \return
+ *      Returns the argument, or the default value if it is missing or of
+ *      another type.
+ */
+
+static int
+osc_int_arg
+(
+    const char * types, lo_arg ** argv, int argc, int i, int defalt
+)
+{
+    int result = defalt;
+    if (i < argc && not_nullptr(types))
+    {
+        switch (types[i])
+        {
+        case 'i':   result = int(argv[i]->i);                   break;
+        case 'f':   result = int(argv[i]->f + 0.5f);            break;
+        case 'd':   result = int(argv[i]->d + 0.5);             break;
+        default:                                                break;
+        }
+    }
+    return result;
+}
+
+int
+osccontrol::osc_automation
+(
+    const char * /*path*/, const char * types,
+    lo_arg ** argv, int argc, lo_message /*msg*/, void * user_data
+)
+{
+    osccontrol * self = static_cast<osccontrol *>(user_data);
+    if (not_nullptr(self) && argc > 0)
+    {
+        int op = osc_int_arg(types, argv, argc, 0, (-1));
+        int act = osc_int_arg(types, argv, argc, 1, 1);
+        int value = osc_int_arg(types, argv, argc, 2, 0);
+        (void) self->post(opcontrol::set_slot(op), 0, act, value);
+    }
+    return 0;
+}
+
+int
+osccontrol::osc_loop
+(
+    const char * /*path*/, const char * types,
+    lo_arg ** argv, int argc, lo_message /*msg*/, void * user_data
+)
+{
+    osccontrol * self = static_cast<osccontrol *>(user_data);
+    if (not_nullptr(self) && argc > 0)
+    {
+        int pattern = osc_int_arg(types, argv, argc, 0, (-1));
+        int act = osc_int_arg(types, argv, argc, 1, 1);
+        (void) self->post(automation::slot::loop, pattern, act, 0);
+    }
+    return 0;
+}
+
+int
+osccontrol::osc_mute_group
+(
+    const char * /*path*/, const char * types,
+    lo_arg ** argv, int argc, lo_message /*msg*/, void * user_data
+)
+{
+    osccontrol * self = static_cast<osccontrol *>(user_data);
+    if (not_nullptr(self) && argc > 0)
+    {
+        int group = osc_int_arg(types, argv, argc, 0, (-1));
+        int act = osc_int_arg(types, argv, argc, 1, 1);
+        (void) self->post(automation::slot::mute_group, group, act, 0);
+    }
+    return 0;
+}
+
+void
+osccontrol::osc_error (int num, const char * msg, const char * path)
+{
+    std::string text = std::to_string(num) + " " +
+        (not_nullptr(msg) ? msg : "") + " " + (not_nullptr(path) ? path : "");
+
+    error_message("OSC control server error", text);
+}
+
+#endif  // defined SEQ66_LIBLO_SUPPORT
+
+}           // namespace seq66
+
+/*
+ * osccontrol.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
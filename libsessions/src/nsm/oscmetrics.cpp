@@ -0,0 +1,399 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          oscmetrics.cpp
+ *
+ *  This module defines the OSC server of the engine metrics.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The counters are totals since start-up (or since the statistics were
+ *  cleared), so that a dashboard can take their rates itself.  The frame
+ *  time percentiles are estimated from the histogram of outputstats, and
+ *  are the upper limits of its buckets.
+ */
+
+#include <cstdio>                       /* std::snprintf()                  */
+
+#include "nsm/oscmetrics.hpp"           /* seq66::oscmetrics class          */
+#include "play/performer.hpp"           /* seq66::performer class           */
+#include "util/basic_macros.hpp"        /* seq66::error_message()           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The paths of the queries and of the replies.
+ */
+
+static const char * const s_metrics_path = "/seq66/metrics";
+static const char * const s_metrics_text_path = "/seq66/metrics/text";
+
+/**
+ *  Adds one metric to a list.
+ */
+
+static void
+add_metric
+(
+    oscmetrics::metrics & m, const char * name, const char * help,
+    double value, int bus = (-1)
+)
+{
+    oscmetrics::metric om;
+    om.om_name = name;
+    om.om_help = help;
+    om.om_bus = bus;
+    om.om_value = value;
+    m.push_back(om);
+}
+
+oscmetrics::oscmetrics (performer & p, int port) :
+    m_perf              (p),
+    m_port              (port)
+#if defined SEQ66_LIBLO_SUPPORT
+    ,
+    m_lo_server_thread  (nullptr)
+#endif
+{
+    // no code
+}
+
+oscmetrics::~oscmetrics ()
+{
+    stop();
+}
+
+/**
+ *  Creates the liblo server on the port and starts its thread.
+ *
+ * \return
+ *      Returns true if the server is running.
+ */
+
+bool
+oscmetrics::start ()
+{
+#if defined SEQ66_LIBLO_SUPPORT
+    bool result = is_nullptr(m_lo_server_thread) && m_port > 0;
+    if (result)
+    {
+        std::string port = std::to_string(m_port);
+        m_lo_server_thread = lo_server_thread_new(port.c_str(), osc_error);
+        result = not_nullptr(m_lo_server_thread);
+        if (result)
+        {
+            (void) lo_server_thread_add_method
+            (
+                m_lo_server_thread, s_metrics_path, "", osc_metrics, this
+            );
+            (void) lo_server_thread_add_method
+            (
+                m_lo_server_thread, s_metrics_text_path, "",
+                osc_metrics_text, this
+            );
+            result = lo_server_thread_start(m_lo_server_thread) == 0;
+            if (result)
+                info_message("OSC metrics on UDP port", port);
+            else
+                stop();
+        }
+        if (! result)
+            error_message("Cannot serve OSC metrics on UDP port", port);
+    }
+    return result;
+#else
+    return false;
+#endif
+}
+
+void
+oscmetrics::stop ()
+{
+#if defined SEQ66_LIBLO_SUPPORT
+    if (not_nullptr(m_lo_server_thread))
+    {
+        (void) lo_server_thread_stop(m_lo_server_thread);
+        lo_server_thread_free(m_lo_server_thread);
+        m_lo_server_thread = nullptr;
+    }
+#endif
+}
+
+/**
+ *  Reads the metrics.  Called in the liblo thread; everything read here is
+ *  atomic or harmless to read while it changes.
+ */
+
+oscmetrics::metrics
+oscmetrics::gather () const
+{
+    metrics result;
+    outputstats::values v = m_perf.output_statistics();
+    add_metric
+    (
+        result, "frames_total", "Output frames played.", double(v.ov_frames)
+    );
+    add_metric
+    (
+        result, "frame_mean_us", "Mean output frame time.",
+        double(v.frame_mean_us())
+    );
+    add_metric
+    (
+        result, "frame_p50_us", "Median output frame time (bucket limit).",
+        double(v.frame_percentile_us(50))
+    );
+    add_metric
+    (
+        result, "frame_p90_us", "90th percentile output frame time.",
+        double(v.frame_percentile_us(90))
+    );
+    add_metric
+    (
+        result, "frame_p99_us", "99th percentile output frame time.",
+        double(v.frame_percentile_us(99))
+    );
+    add_metric
+    (
+        result, "frame_max_us", "Longest output frame time.",
+        double(v.ov_frame_max_us)
+    );
+    add_metric
+    (
+        result, "underruns_total", "Output frames that ran late.",
+        double(v.ov_underruns)
+    );
+    add_metric
+    (
+        result, "late_max_us", "Latest output thread wake-up.",
+        double(v.ov_late_max_us)
+    );
+    add_metric
+    (
+        result, "lock_waits_total", "Waits for a pattern lock in playback.",
+        double(v.ov_lock_waits)
+    );
+    add_metric
+    (
+        result, "output_buffer_max", "High-water mark of the output buffers.",
+        double(v.ov_buffer_max)
+    );
+    add_metric
+    (
+        result, "output_buffer_dropped_total",
+        "Events dropped by full output buffers.", double(v.ov_buffer_dropped)
+    );
+    add_metric
+    (
+        result, "input_buffer_max", "High-water mark of the input buffers.",
+        double(v.ov_input_buffer_max)
+    );
+    add_metric
+    (
+        result, "input_buffer_dropped_total",
+        "Events dropped by full input buffers.", double(v.ov_input_dropped)
+    );
+    add_metric
+    (
+        result, "notices_dropped_total",
+        "Notifications dropped by a full queue.",
+        double(m_perf.notices_dropped())
+    );
+    add_metric
+    (
+        result, "captures_dropped_total",
+        "Input-capture messages dropped by a full ring.",
+        double(m_perf.captures_dropped())
+    );
+
+    const mastermidibus * mmb = m_perf.master_bus();
+    if (not_nullptr(mmb))
+    {
+        add_metric
+        (
+            result, "events_total", "Events sent to the output busses.",
+            double(mmb->play_count())
+        );
+        int buses = mmb->get_num_out_buses();
+        for (int b = 0; b < buses; ++b)
+        {
+            add_metric
+            (
+                result, "bus_events_total", "Events sent to an output buss.",
+                double(mmb->play_count(bussbyte(b))), b
+            );
+        }
+    }
+
+    int active = 0;
+    seq::number high = m_perf.sequence_high();
+    for (seq::number s = 0; s < high; ++s)
+    {
+        const seq::pointer sp = m_perf.get_sequence(s);
+        if (sp && sp->armed())
+            ++active;
+    }
+    add_metric
+    (
+        result, "active_patterns", "Patterns armed for playback.",
+        double(active)
+    );
+    add_metric
+    (
+        result, "running", "1 if playback is running.",
+        m_perf.is_running() ? 1.0 : 0.0
+    );
+    add_metric
+    (
+        result, "tempo_bpm", "Current tempo.",
+        double(m_perf.get_beats_per_minute())
+    );
+    add_metric
+    (
+        result, "tick", "Current playback tick.", double(m_perf.get_tick())
+    );
+    return result;
+}
+
+/**
+ *  Formats the metrics in the Prometheus text exposition format, each name
+ *  prefixed with "seq66_", and each buss as a "bus" label.
+ */
+
+std::string
+oscmetrics::text () const
+{
+    std::string result;
+    std::string lastname;
+    char value[64];
+    for (const auto & om : gather())
+    {
+        std::string name = "seq66_" + om.om_name;
+        if (name != lastname)
+        {
+            result += "# HELP " + name + " " + om.om_help + "\n";
+            lastname = name;
+        }
+        result += name;
+        if (om.om_bus >= 0)
+            result += "{bus=\"" + std::to_string(om.om_bus) + "\"}";
+
+        (void) std::snprintf(value, sizeof value, " %.17g\n", om.om_value);
+        result += value;
+    }
+    return result;
+}
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+int
+oscmetrics::osc_metrics
+(
+    const char * /*path*/, const char * /*types*/,
+    lo_arg ** /*argv*/, int /*argc*/, lo_message msg, void * user_data
+)
+{
+    oscmetrics * self = static_cast<oscmetrics *>(user_data);
+    if (not_nullptr(self))
+        self->reply(msg);
+
+    return 0;
+}
+
+int
+oscmetrics::osc_metrics_text
+(
+    const char * /*path*/, const char * /*types*/,
+    lo_arg ** /*argv*/, int /*argc*/, lo_message msg, void * user_data
+)
+{
+    oscmetrics * self = static_cast<oscmetrics *>(user_data);
+    if (not_nullptr(self))
+        self->reply_text(msg);
+
+    return 0;
+}
+
+void
+oscmetrics::osc_error (int num, const char * msg, const char * path)
+{
+    std::string text = std::to_string(num) + " " +
+        (not_nullptr(msg) ? msg : "") + " " + (not_nullptr(path) ? path : "");
+
+    error_message("OSC metrics server error", text);
+}
+
+/**
+ *  Sends each metric to the sender of the query.
+ */
+
+void
+oscmetrics::reply (lo_message msg)
+{
+    lo_address sender = lo_message_get_source(msg);
+    lo_server server = lo_server_thread_get_server(m_lo_server_thread);
+    std::string base = s_metrics_path;
+    for (const auto & om : gather())
+    {
+        std::string path = base + "/" + om.om_name;
+        lo_message m = lo_message_new();
+        if (om.om_bus >= 0)
+            (void) lo_message_add_int32(m, om.om_bus);
+
+        (void) lo_message_add_double(m, om.om_value);
+        (void) lo_send_message_from(sender, server, path.c_str(), m);
+        lo_message_free(m);
+    }
+}
+
+/**
+ *  Sends all of the metrics to the sender of the query as one string.
+ */
+
+void
+oscmetrics::reply_text (lo_message msg)
+{
+    lo_address sender = lo_message_get_source(msg);
+    lo_server server = lo_server_thread_get_server(m_lo_server_thread);
+    std::string t = text();
+    lo_message m = lo_message_new();
+    (void) lo_message_add_string(m, t.c_str());
+    (void) lo_send_message_from(sender, server, s_metrics_text_path, m);
+    lo_message_free(m);
+}
+
+#endif  // defined SEQ66_LIBLO_SUPPORT
+
+}           // namespace seq66
+
+/*
+ * oscmetrics.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
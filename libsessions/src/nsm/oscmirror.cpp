@@ -0,0 +1,329 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          oscmirror.cpp
+ *
+ *  This module defines the OSC link between a mirroring primary and its
+ *  replica.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The handlers are registered with their exact argument types, so liblo
+ *  drops any datagram that does not match, and the handlers need not check.
+ */
+
+#include <chrono>                       /* std::chrono::milliseconds        */
+#include <cstdint>                      /* std::int64_t                     */
+
+#include "nsm/oscmirror.hpp"            /* seq66::oscmirror class           */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "play/performer.hpp"           /* seq66::performer class           */
+#include "util/basic_macros.hpp"        /* seq66::error_message()           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The paths and argument types of the messages.
+ */
+
+static const char * const s_action_path = "/seq66/mirror/action";
+static const char * const s_action_types = "iiiiiii";
+static const char * const s_state_path = "/seq66/mirror/state";
+static const char * const s_state_types = "iiihdis";
+
+/**
+ *  How often the primary's mirror thread looks for controls to send, and
+ *  how often, at most, it sends the state.
+ */
+
+static const int c_mirror_poll_ms = 5;
+static const long c_mirror_state_us = 50000;
+
+oscmirror::oscmirror
+(
+    performer & p, bool primary, const std::string & host, int port
+) :
+    m_perf              (p),
+    m_primary           (primary),
+    m_host              (host),
+    m_port              (port),
+    m_running           (false),
+    m_thread            (),
+    m_serial            (0),
+    m_lost              (0)
+#if defined SEQ66_LIBLO_SUPPORT
+    ,
+    m_lo_address        (nullptr),
+    m_lo_server_thread  (nullptr)
+#endif
+{
+    // no code
+}
+
+oscmirror::~oscmirror ()
+{
+    stop();
+}
+
+/**
+ *  For the primary, opens the address of the replica and starts the mirror
+ *  thread.  For the replica, creates the liblo server on the port and
+ *  starts its thread.
+ *
+ * \return
+ *      Returns true if the mirroring is running.
+ */
+
+bool
+oscmirror::start ()
+{
+#if defined SEQ66_LIBLO_SUPPORT
+    bool result = ! m_running && is_nullptr(m_lo_server_thread) && m_port > 0;
+    if (result)
+    {
+        std::string port = std::to_string(m_port);
+        if (m_primary)
+        {
+            m_lo_address = lo_address_new(m_host.c_str(), port.c_str());
+            result = not_nullptr(m_lo_address);
+            if (result)
+            {
+                m_running = true;
+                m_thread = std::thread(&oscmirror::send_loop, this);
+                info_message("Mirroring to " + m_host + " on UDP port", port);
+            }
+            else
+                error_message("Cannot mirror to " + m_host + " port", port);
+        }
+        else
+        {
+            m_lo_server_thread = lo_server_thread_new(port.c_str(), osc_error);
+            result = not_nullptr(m_lo_server_thread);
+            if (result)
+            {
+                (void) lo_server_thread_add_method
+                (
+                    m_lo_server_thread, s_action_path, s_action_types,
+                    osc_action, this
+                );
+                (void) lo_server_thread_add_method
+                (
+                    m_lo_server_thread, s_state_path, s_state_types,
+                    osc_state, this
+                );
+                result = lo_server_thread_start(m_lo_server_thread) == 0;
+                if (result)
+                    info_message("Mirror replica on UDP port", port);
+                else
+                    stop();
+            }
+            if (! result)
+                error_message("Cannot be a mirror replica on UDP port", port);
+        }
+    }
+    return result;
+#else
+    error_message("Mirroring needs a build with liblo");
+    return false;
+#endif
+}
+
+void
+oscmirror::stop ()
+{
+#if defined SEQ66_LIBLO_SUPPORT
+    if (m_running)
+    {
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+    if (not_nullptr(m_lo_address))
+    {
+        lo_address_free(m_lo_address);
+        m_lo_address = nullptr;
+    }
+    if (not_nullptr(m_lo_server_thread))
+    {
+        (void) lo_server_thread_stop(m_lo_server_thread);
+        lo_server_thread_free(m_lo_server_thread);
+        m_lo_server_thread = nullptr;
+    }
+#endif
+}
+
+#if defined SEQ66_LIBLO_SUPPORT
+
+/**
+ *  The primary's mirror thread.  Sends each control as soon as it is seen,
+ *  followed by the state; and otherwise the state every 50 ms, which is
+ *  also the heartbeat that keeps the replica from taking over.
+ */
+
+void
+oscmirror::send_loop ()
+{
+    long laststate = 0;
+    while (m_running)
+    {
+        long now = microtime();
+        if (send_actions() || now - laststate >= c_mirror_state_us)
+        {
+            send_state();
+            laststate = now;
+        }
+        std::this_thread::sleep_for
+        (
+            std::chrono::milliseconds(c_mirror_poll_ms)
+        );
+    }
+}
+
+/**
+ * \return
+ *      Returns true if any controls were sent.
+ */
+
+bool
+oscmirror::send_actions ()
+{
+    bool result = false;
+    performer::remotecontrol c;
+    while (m_perf.pop_mirror_action(c))
+    {
+        (void) lo_send
+        (
+            m_lo_address, s_action_path, s_action_types, ++m_serial,
+            int(c.rc_slot), int(c.rc_action), c.rc_d0, c.rc_d1,
+            c.rc_index, c.rc_inverse ? 1 : 0
+        );
+        result = true;
+    }
+    return result;
+}
+
+void
+oscmirror::send_state ()
+{
+    performer::mirrorstate ms;
+    m_perf.get_mirror_state(ms);
+    (void) lo_send
+    (
+        m_lo_address, s_state_path, s_state_types, ++m_serial,
+        ms.ms_running ? 1 : 0, ms.ms_song_mode ? 1 : 0,
+        std::int64_t(ms.ms_tick), double(ms.ms_bpm), ms.ms_playscreen,
+        ms.ms_armed.c_str()
+    );
+}
+
+/**
+ *  Counts the datagrams missing before this one.  A serial number that
+ *  goes backward means the primary restarted.
+ */
+
+void
+oscmirror::received (int serial)
+{
+    if (m_serial > 0 && serial > m_serial + 1)
+        m_lost += serial - m_serial - 1;
+
+    m_serial = serial;
+}
+
+int
+oscmirror::osc_action
+(
+    const char * /*path*/, const char * /*types*/,
+    lo_arg ** argv, int /*argc*/, lo_message /*msg*/, void * user_data
+)
+{
+    oscmirror * self = static_cast<oscmirror *>(user_data);
+    if (not_nullptr(self))
+    {
+        self->received(argv[0]->i);
+
+        int act = argv[2]->i;
+        bool ok = act > int(automation::action::none) &&
+            act < int(automation::action::max);
+
+        if (ok)
+        {
+            automation::slot s = automation::slot(argv[1]->i);
+            automation::action a = static_cast<automation::action>(act);
+            (void) self->m_perf.post_remote_control
+            (
+                s, a, argv[5]->i, argv[4]->i, argv[3]->i, argv[6]->i != 0
+            );
+        }
+    }
+    return 0;
+}
+
+int
+oscmirror::osc_state
+(
+    const char * /*path*/, const char * /*types*/,
+    lo_arg ** argv, int /*argc*/, lo_message /*msg*/, void * user_data
+)
+{
+    oscmirror * self = static_cast<oscmirror *>(user_data);
+    if (not_nullptr(self))
+    {
+        self->received(argv[0]->i);
+
+        performer::mirrorstate ms;
+        ms.ms_running = argv[1]->i != 0;
+        ms.ms_song_mode = argv[2]->i != 0;
+        ms.ms_tick = midipulse(argv[3]->h);
+        ms.ms_bpm = midibpm(argv[4]->d);
+        ms.ms_playscreen = argv[5]->i;
+        ms.ms_armed = &argv[6]->s;
+        self->m_perf.post_mirror_state(ms);
+    }
+    return 0;
+}
+
+void
+oscmirror::osc_error (int num, const char * msg, const char * path)
+{
+    std::string text = std::to_string(num) + " " +
+        (not_nullptr(msg) ? msg : "") + " " + (not_nullptr(path) ? path : "");
+
+    error_message("OSC mirror error", text);
+}
+
+#endif  // defined SEQ66_LIBLO_SUPPORT
+
+}           // namespace seq66
+
+/*
+ * oscmirror.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-12-05
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This midibus module is the Windows (PortMidi) version of the midibus
@@ -35,6 +35,8 @@
  *  class for all midibus classes.
  */
 
+#include <atomic>                       /* std::atomic<double>              */
+
 #include "midi/midibase.hpp"
 #include "portmidi.h"                   /* PortMIDI API header file         */
 
@@ -75,6 +77,22 @@ private:
 
     bool m_is_port_locked;
 
+    /**
+     *  The output latency, in milliseconds, from the "portmidi-latency"
+     *  option.  If greater than zero, each event is timestamped and
+     *  PortMidi delivers it that much later than its timestamp.
+     */
+
+    int m_latency_ms;
+
+    /**
+     *  The exact play position of the current output frame, set by the
+     *  master buss for all of the ports.  An event that lags it was played
+     *  late, and is stamped that much earlier.
+     */
+
+    static std::atomic<double> sm_frame_tick;
+
 public:
 
     /*
@@ -102,6 +120,11 @@ public:
         m_is_port_locked = true;
     }
 
+    static void frame_tick (double tick)
+    {
+        sm_frame_tick.store(tick, std::memory_order_relaxed);
+    }
+
 protected:
 
     virtual int api_poll_for_midi () override;
@@ -112,6 +135,13 @@ protected:
     virtual void api_stop () override;
     virtual void api_clock (midipulse tick) override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_batch (const batchevent * evs, int count) override;
+
+private:
+
+    PmTimestamp stamp () const;
+    PmTimestamp stamp (midipulse tick) const;
+    void write (PmEvent * buffer, int count);
 
     /*
      * Functions not implemented in PortMIDI.  For example, the "sub"
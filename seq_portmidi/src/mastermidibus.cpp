@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-09-20
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the mastermidibus
@@ -33,6 +33,7 @@
  */
 
 #include "midi/event.hpp"               /* seq66::event                     */
+#include "os/timing.hpp"                /* seq66::microtime()               */
 #include "mastermidibus_pm.hpp"         /* seq66::mastermidibus, PortMIDI   */
 #include "midibus_pm.hpp"               /* seq66::midibus, PortMIDI         */
 #include "portmidi.h"                   /* external PortMidi header file    */
@@ -184,6 +185,34 @@ mastermidibus::api_init (int ppqn, midibpm /*bpm*/)
     m_inbus_array.set_all_inputs();
 }
 
+/**
+ *  Converts the timestamp of an incoming PortMidi event, in PortTime
+ *  milliseconds, to the microtime() time base, by its age.  CoreMIDI
+ *  stamps the packets as they arrive.  A timestamp that is not on the
+ *  PortTime clock, as some drivers give, is detected by its age, and the
+ *  event is taken to arrive now.
+ *
+ * \param ts
+ *      The timestamp of the event.
+ *
+ * \return
+ *      Returns the arrival time in microseconds.
+ */
+
+static long
+arrival_us (PmTimestamp ts)
+{
+    static const long c_max_age_ms = 1000;
+    long result = microtime();
+    if (Pt_Started())
+    {
+        long age = long(Pt_Time()) - long(ts);
+        if (age > 0 && age < c_max_age_ms)
+            result -= age * 1000;
+    }
+    return result;
+}
+
 /**
  *  Grab a MIDI event.  This function ssumes that [api_]poll_for_midi() has
  *  been called to "prime the pump".
@@ -243,6 +272,7 @@ mastermidibus::api_get_midi_event (event * in)
                 buffer[1] = Pm_MessageData1(pme.message);
                 buffer[2] = Pm_MessageData2(pme.message);
                 result = in->set_midi_event(ts, buffer, 0);     /* 0 count  */
+                in->arrival_us(arrival_us(pme.timestamp));
                 in->set_input_bus(bussbyte(b));
 #if defined SEQ66_PLATFORM_DEBUG_TMI
             printf("[seq66] input event on PortMidi bus %d\n", int(b));
@@ -256,25 +286,36 @@ mastermidibus::api_get_midi_event (event * in)
 }
 
 /**
- *  Not yet implemented.  There is no PPQN code in the original PortMIDI
- *  project.
+ *  There is no PPQN code in the original PortMIDI project, but our PortTime
+ *  keeps the PPQN, which the output ports use to stamp late events.
+ */
+
+void
+mastermidibus::api_set_ppqn (int ppqn)
+{
+    Pt_Set_Ppqn(ppqn);
+}
+
+/**
+ *  There is no BPM code in the original PortMIDI project.  Tempo is set via
+ *  a timer (at least in their test application).  As with the PPQN, our
+ *  PortTime keeps it for the output ports.
  */
 
 void
-mastermidibus::api_set_ppqn (int /*ppqn*/)
+mastermidibus::api_set_beats_per_minute (midibpm bpm)
 {
-    // no code
+    Pt_Set_Bpm(double(bpm));
 }
 
 /**
- *  Not yet implemented.  There is no BPM code in the original PortMIDI
- *  project.  Tempo is set via a timer (at least in their test application).
+ *  Gives the output ports the play position of the frame.
  */
 
 void
-mastermidibus::api_set_beats_per_minute (midibpm /*bpm*/)
+mastermidibus::api_frame_tick (double tick)
 {
-    // no code
+    midibus::frame_tick(tick);
 }
 
 }           // namespace seq66
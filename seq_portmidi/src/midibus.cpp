@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-06-28
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the midibus class.
@@ -43,9 +43,11 @@
  */
 
 #include "cfg/settings.hpp"             /* seq66::rc_settings               */
+#include "midi/calculations.hpp"        /* seq66::pulse_length_us()         */
 #include "midi/event.hpp"               /* seq66::event and macros          */
 #include "os/timing.hpp"                /* seq66::microsleep()              */
 #include "midibus_pm.hpp"               /* seq66::midibus for PortMIDI      */
+#include "porttime.h"                   /* Pt_Time(), Pt_Get_Bpm(), etc.    */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -54,6 +56,23 @@
 namespace seq66
 {
 
+/**
+ *  The size of the PortMidi output buffer.  With a latency, events wait in
+ *  it until they are due, so it must hold the busiest stretch of that
+ *  length.  Without a latency, it is written straight through.
+ */
+
+static const int c_buffer_size          = 100;
+static const int c_latency_buffer_size  = 1024;
+
+/**
+ *  The number of events in each Pm_Write() of a batch.
+ */
+
+static const int c_chunk_size = 64;
+
+std::atomic<double> midibus::sm_frame_tick(0.0);
+
 #if defined THIS_FUNCTION_IS_NEEDED
 
 static std::string
@@ -97,7 +116,8 @@ midibus::midibus
         midibase::port::normal              // false
     ),
     m_pms               (nullptr),
-    m_is_port_locked    (false)
+    m_is_port_locked    (false),
+    m_latency_ms        (rc().portmidi_latency_ms())
 {
     // Empty body
 }
@@ -154,6 +174,9 @@ midibus::api_poll_for_midi ()
  *  If there is an error, we set the clocking to e_clock::disable to indicate
  *  we should not bother to use the port.
  *
+ *  With a "portmidi-latency", no time procedure is passed, so PortMidi
+ *  starts the PortTime timer and uses Pt_Time(), as stamp() does.
+ *
  * \return
  *      Returns true if the output port was successfully opened.
  */
@@ -161,9 +184,10 @@ midibus::api_poll_for_midi ()
 bool
 midibus::api_init_out ()
 {
+    int buffersize = m_latency_ms > 0 ? c_latency_buffer_size : c_buffer_size ;
     PmError err = Pm_OpenOutput
     (
-        &m_pms, queue_number(), NULL, 100, NULL, NULL, 0
+        &m_pms, queue_number(), NULL, buffersize, NULL, NULL, m_latency_ms
     );
     bool result = err == pmNoError;
     if (! result)
@@ -237,11 +261,105 @@ midibus::api_play (const event * e24, midibyte channel)
     e24->get_data(buffer[1], buffer[2]);
 
     PmEvent event;
-    event.timestamp = 0;
+    event.timestamp = stamp(e24->timestamp());
     event.message = Pm_Message(buffer[0], buffer[1], buffer[2]);
     /* PmError err = */ Pm_Write(m_pms, &event, 1);
 }
 
+/**
+ *  Plays a frame's events for this port with one Pm_Write() per chunk of
+ *  events, instead of one per event.  Each event is stamped for its tick,
+ *  so that, with a "portmidi-latency", PortMidi spaces them out as they
+ *  were meant to be, however late the output thread woke up.
+ *
+ * \param evs
+ *      The events and their channels, in timestamp order.
+ *
+ * \param count
+ *      The number of events.
+ */
+
+void
+midibus::api_play_batch (const batchevent * evs, int count)
+{
+    if (is_nullptr(m_pms))
+        return;
+
+    PmEvent chunk[c_chunk_size];
+    int i = 0;
+    while (i < count)
+    {
+        int n = 0;
+        for ( ; n < c_chunk_size && i < count; ++n, ++i)
+        {
+            const event & e24 = evs[i].be_event;
+            midibyte d0, d1;
+            e24.get_data(d0, d1);
+            chunk[n].timestamp = stamp(e24.timestamp());
+            chunk[n].message = Pm_Message
+            (
+                e24.get_status(evs[i].be_channel), d0, d1
+            );
+        }
+        write(chunk, n);
+    }
+}
+
+/**
+ *  Writes events, logging a failure, such as a full buffer.
+ */
+
+void
+midibus::write (PmEvent * buffer, int count)
+{
+    PmError err = Pm_Write(m_pms, buffer, count);
+    if (err != pmNoError)
+        errprintf("Pm_Write(): %s\n", Pm_GetErrorText(err));
+}
+
+/**
+ *  Gets the timestamp of a message to be sent now.  Without a latency,
+ *  PortMidi ignores timestamps, and the PortTime timer might not even be
+ *  running, so 0 is used.
+ */
+
+PmTimestamp
+midibus::stamp () const
+{
+    return m_latency_ms > 0 ? PmTimestamp(Pt_Time()) : 0 ;
+}
+
+/**
+ *  Gets the timestamp of an event played in the current frame.  That is
+ *  now, less how far the event lags the exact play position of the frame,
+ *  but no more than the latency, so that an event that comes out late
+ *  because the output thread woke up late is still delivered at (its time
+ *  + latency).  The tempo and PPQN are those of PortTime, kept up to date
+ *  by the master buss.
+ *
+ * \param tick
+ *      The event's timestamp, the tick at which it should sound.
+ */
+
+PmTimestamp
+midibus::stamp (midipulse tick) const
+{
+    PmTimestamp result = stamp();
+    if (m_latency_ms > 0)
+    {
+        double late = sm_frame_tick.load(std::memory_order_relaxed) -
+            double(tick);
+
+        if (late > 0.0)
+        {
+            double us = late * pulse_length_us(Pt_Get_Bpm(), Pt_Get_Ppqn());
+            int ms = int(us / 1000.0 + 0.5);
+            result -= ms < m_latency_ms ? ms : m_latency_ms ;
+        }
+    }
+    return result;
+}
+
 /**
  *  Continue from the given tick.  This function implements only the
  *  PortMidi-specific code.
@@ -258,7 +376,7 @@ void
 midibus::api_continue_from (midipulse /* tick */, midipulse beats)
 {
     PmEvent event;
-    event.timestamp = 0;
+    event.timestamp = stamp();
     event.message = Pm_Message(EVENT_MIDI_CONTINUE, 0, 0);
     Pm_Write(m_pms, &event, 1);
     event.message = Pm_Message
@@ -279,7 +397,7 @@ midibus::api_start ()
     if (not_nullptr(m_pms) && port_enabled())
     {
         PmEvent event;
-        event.timestamp = 0;
+        event.timestamp = stamp();
         event.message = Pm_Message(EVENT_MIDI_START, 0, 0);
         Pm_Write(m_pms, &event, 1);
     }
@@ -296,7 +414,7 @@ midibus::api_stop ()
     if (not_nullptr(m_pms) && port_enabled())
     {
         PmEvent event;
-        event.timestamp = 0;
+        event.timestamp = stamp();
         event.message = Pm_Message(EVENT_MIDI_STOP, 0, 0);
         Pm_Write(m_pms, &event, 1);
     }
@@ -311,17 +429,17 @@ midibus::api_stop ()
  *      midibase::clock().
  *
  * \param tick
- *      The clock tick value, not used in the API implementation of this
- *      function for PortMidi.
+ *      The clock tick value, used to stamp the clock when there is a
+ *      "portmidi-latency".
  */
 
 void
-midibus::api_clock (midipulse /* tick */)
+midibus::api_clock (midipulse tick)
 {
     if (not_nullptr(m_pms) && port_enabled())
     {
         PmEvent event;
-        event.timestamp = 0;                /* WHY NOT use 'tick' here? */
+        event.timestamp = stamp(tick);
         event.message = Pm_Message(EVENT_MIDI_CLOCK, 0, 0);
         Pm_Write(m_pms, &event, 1);
     }
@@ -24,7 +24,7 @@
  * \library     seq66 application
  * \author      PortMIDI team; modifications by Chris Ahlstrom
  * \date        2018-05-13
- * \updates     2023-06-03
+ * \updates     2026-10-14
  * \license     GNU GPLv2 or above
  *
  *  A platform interface to the MacOS X CoreMIDI framework.
@@ -246,6 +246,7 @@ midi_synchronize (PmInternal * midi)
         ;
     m->delta = pm_stream_time - ((UInt64) real_time * (UInt64) 1000000);
     m->sync_time = real_time;
+    midi->sync_time = real_time;    /* else Pm_Write() resyncs every time   */
     return real_time;
 }
 
@@ -422,9 +423,13 @@ readProc (const MIDIPacketList * newPackets, void * refCon, void * connRefCon)
          * conversion.
          */
 
+        MIDITimeStamp stamp = packet->timeStamp;
+        if (stamp == 0)                 /* 0 means "now" to CoreMIDI        */
+            stamp = AudioGetCurrentHostTime();
+
         event.timestamp = (PmTimestamp)
         (
-            (AudioConvertHostTimeToNanos(packet->timeStamp) - m->delta) /
+            (AudioConvertHostTimeToNanos(stamp) - m->delta) /
             (UInt64) 1000000
         );
         status = packet->data[0];
@@ -464,7 +469,7 @@ midi_in_open (PmInternal * midi, void * driverInfo)
     midi_macosxcm_type m;
     OSStatus macHostError;
 
-    if (midi->time_proc == NULL)i   /* insure we have a time_proc for timing */
+    if (midi->time_proc == NULL)    /* insure we have a time_proc for timing */
     {
         if (! Pt_Started())
             Pt_Start(1, 0, 0);
@@ -483,7 +488,7 @@ midi_in_open (PmInternal * midi, void * driverInfo)
 
     m = (midi_macosxcm_type) pm_alloc(sizeof(midi_macosxcm_node)); /* create */
     midi->descriptor = m;
-    if (is nullptr(m))
+    if (is_nullptr(m))
         return pmInsufficientMemory;
 
     m->error[0] = 0;
@@ -593,7 +598,7 @@ midi_out_close (PmInternal * midi)
         return pmBadPtr;
 
     midi->descriptor = NULL;
-    pm_free(midi->descriptor);
+    pm_free(m);
     return pmNoError;
 }
 
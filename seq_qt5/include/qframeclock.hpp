@@ -0,0 +1,248 @@
+#if ! defined SEQ66_QFRAMECLOCK_HPP
+#define SEQ66_QFRAMECLOCK_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qframeclock.hpp
+ *
+ *  This module declares the single redraw clock shared by the Qt windows
+ *  and frames.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Each view used to start its own periodic QTimer and, at every tick,
+ *  poll the dirty flags of the performer and the patterns in its
+ *  conditional_update() slot, even with nothing playing and nothing
+ *  changed.  Now qt_timer() hands the view a single-shot QTimer that the
+ *  frame clock starts, from its own timer, only when the view is due and
+ *  there is something to show:
+ *
+ *      -   The performer is running, so that the playhead moves.
+ *      -   A performer::callbacks notification, a pattern change (see
+ *          sequence::change_generation()), or a call to
+ *          performer::set_needs_update() has happened since the view last
+ *          woke.
+ *      -   The slow heartbeat has come around, for any change that comes
+ *          through none of those paths.
+ *
+ *  A view that is hidden (e.g. a tab that is not shown) is not woken at all.
+ *  The main window and the session manager, which poll for session requests
+ *  and signals, ask qt_timer() for an ordinary periodic timer instead.
+ *
+ *  Each tick also delivers the notifications that other threads queued in
+ *  the performer (see performer::deliver_notifications()), so that every
+ *  client handler runs on the GUI thread.  The notification counter stays
+ *  atomic all the same.
+ *
+ *  The clock also backs off when the engine is loaded.  About four times a
+ *  second it compares the output statistics (see outputstats) with the
+ *  previous reading.  If the output thread had an underrun, or more than a
+ *  few of its frames took half of performer::frame_budget_us() or more, the
+ *  tick interval is doubled, down to 10 redraws a second.  After a second
+ *  with no such trouble, it steps back toward the redraw rate of the 'usr'
+ *  file, one period at a time.  A redraw competes with the output thread
+ *  for the CPU and the memory bus even on another core, so this leaves it
+ *  more room on a small machine, with no tuning by the user.
+ */
+
+#include <atomic>                       /* std::atomic<unsigned>            */
+#include <vector>                       /* std::vector<>                    */
+
+#include "play/outputstats.hpp"         /* seq66::outputstats::values       */
+#include "play/performer.hpp"           /* seq66::performer::callbacks      */
+
+class QTimer;
+class QWidget;
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The GUI frame clock.  There is at most one, created by qsmainwnd.
+ */
+
+class qframeclock final : protected performer::callbacks
+{
+
+private:
+
+    /**
+     *  One view driven by the clock.  The timer is the one returned by
+     *  qt_timer(), and is owned by the view.
+     */
+
+    class client
+    {
+
+    public:
+
+        QTimer * fc_timer;              /**< The view's single-shot timer.  */
+        QWidget * fc_widget;            /**< The view, if it is a widget.   */
+        int fc_factor;                  /**< Wakes every nth tick.          */
+        unsigned fc_generation;         /**< Changes seen at the last wake. */
+        unsigned fc_last_tick;          /**< The tick of the last wake.     */
+
+    };
+
+    /**
+     *  The one instance, or null.
+     */
+
+    static qframeclock * sm_instance;
+
+    /**
+     *  The periodic timer, the only one left running.
+     */
+
+    QTimer * m_timer;
+
+    /**
+     *  The tick interval.  This is the "redraw rate" from the 'usr' file,
+     *  rounded to a whole number of refresh periods of the primary screen.
+     */
+
+    int m_period_ms;
+
+    /**
+     *  The multiple of m_period_ms now in use, raised while the engine is
+     *  loaded.  1 is the full redraw rate.
+     */
+
+    int m_throttle;
+
+    /**
+     *  The largest throttle, which makes the tick about 100 ms long.
+     */
+
+    int m_throttle_max;
+
+    /**
+     *  The milliseconds of ticks since the last reading of the output
+     *  statistics, and the number of calm readings in a row.
+     */
+
+    int m_govern_ms;
+    int m_calm_readings;
+
+    /**
+     *  The previous reading of the output statistics.
+     */
+
+    outputstats::values m_last_stats;
+
+    /**
+     *  The number of ticks between wakes of an idle view, about half a
+     *  second.
+     */
+
+    int m_heartbeat_ticks;
+
+    /**
+     *  The tick counter.
+     */
+
+    unsigned m_tick;
+
+    /**
+     *  The count of performer notifications.
+     */
+
+    std::atomic<unsigned> m_notifications;
+
+    /**
+     *  The views.
+     */
+
+    std::vector<client> m_clients;
+
+public:
+
+    qframeclock (performer & p);
+    ~qframeclock ();
+
+    qframeclock (const qframeclock &) = delete;
+    qframeclock & operator = (const qframeclock &) = delete;
+
+    static qframeclock * instance ()
+    {
+        return sm_instance;
+    }
+
+    int period_ms () const
+    {
+        return m_period_ms;
+    }
+
+    int interval_ms () const
+    {
+        return m_period_ms * m_throttle;
+    }
+
+    void add (QTimer * t, QObject * self, int redraw_factor);
+    void remove (QTimer * t);
+
+private:
+
+    unsigned generation () const;
+    void tick ();
+    void govern ();
+    bool engine_loaded (const outputstats::values & v) const;
+    void set_throttle (int throttle);
+
+    void notified ()
+    {
+        m_notifications.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:                                /* performer::callback overrides    */
+
+    virtual bool on_mutes_change (mutegroup::number, performer::change)
+        override;
+    virtual bool on_set_change (screenset::number, performer::change)
+        override;
+    virtual bool on_sequence_change (seq::number, performer::change)
+        override;
+    virtual bool on_automation_change (automation::slot) override;
+    virtual bool on_ui_change (seq::number) override;
+    virtual bool on_trigger_change (seq::number, performer::change) override;
+    virtual bool on_resolution_change (int, midibpm, performer::change)
+        override;
+    virtual bool on_song_action (bool, playlist::action) override;
+
+};          // class qframeclock
+
+}           // namespace seq66
+
+#endif      // SEQ66_QFRAMECLOCK_HPP
+
+/*
+ * qframeclock.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,304 @@
+#if ! defined SEQ66_QGLROLL_HPP
+#define SEQ66_QGLROLL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qglroll.hpp
+ *
+ *  This module declares the GPU (OpenGL) rendering of the piano roll and of
+ *  the song editor.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The rolls keep their QPainter drawing code.  For the GPU path, they draw
+ *  into a qglrecorder instead of a pixmap; its paint engine turns each
+ *  rectangle, line, and ellipse into a colored rectangle, and keeps the
+ *  text items.  The rectangles are handed to a qglroll, an OpenGL widget
+ *  laid over the visible part of the roll, as layers (e.g. grid, notes,
+ *  overlays).  A layer that is handed in again is compared with the old
+ *  one, and only the span of rectangles that changed is uploaded to the
+ *  instance buffer, so a changed note or a moved playhead costs a few
+ *  bytes.  Each frame is one instanced draw of all the rectangles, followed
+ *  by the text items, if any, drawn by QPainter.
+ *
+ *  The approximations:  pen styles other than solid are drawn solid at
+ *  half the alpha, gradients are drawn in their middle color, and slanted
+ *  lines, polygons, and ellipses are drawn as their bounding rectangles.
+ *  None of these are used for the notes or triggers themselves.
+ *
+ *  The qglroll widget exists only if the build defines SEQ66_OPENGL_SUPPORT
+ *  (./configure --enable-opengl, or qmake CONFIG+=opengl), and is used only
+ *  if the 'usr' option "gpu-rendering" is true.  If the OpenGL context is
+ *  older than 3.3 (3.0 for OpenGL ES), it reports failed(), and the roll
+ *  goes back to the raster path.
+ */
+
+#include <QColor>
+#include <QFont>
+#include <QPaintDevice>
+#include <QPointF>
+#include <QRect>
+#include <QString>
+
+#include <memory>                       /* std::unique_ptr<>                */
+#include <vector>                       /* std::vector<>                    */
+
+#include "seq66_features.h"             /* SEQ66_OPENGL_SUPPORT             */
+
+#if defined SEQ66_OPENGL_SUPPORT
+#include <QOpenGLBuffer>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLVertexArrayObject>
+#include <QOpenGLWidget>
+#endif
+
+class QOpenGLShaderProgram;
+class QWidget;
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class qglpaintengine;
+
+/**
+ *  One rectangle as uploaded to the GPU:  the position and size in the
+ *  coordinates of the roll widget, and the color, as an instance attribute.
+ */
+
+struct glrect
+{
+    float gr_x;                         /**< The left edge.                 */
+    float gr_y;                         /**< The top edge.                  */
+    float gr_w;                         /**< The width.                     */
+    float gr_h;                         /**< The height.                    */
+    unsigned char gr_rgba[4];           /**< The color, alpha last.         */
+};
+
+/**
+ *  One text item, drawn after the rectangles.
+ */
+
+struct gltext
+{
+    QPointF gt_point;                   /**< The baseline start, in roll.   */
+    QString gt_text;                    /**< The text.                      */
+    QFont gt_font;                      /**< The font of the painter.       */
+    QColor gt_color;                    /**< The pen color.                 */
+};
+
+/**
+ *  A paint device that records the drawing of a roll as rectangles and
+ *  text items.  Anything falling wholly outside of the area is dropped.
+ */
+
+class qglrecorder final : public QPaintDevice
+{
+    friend class qglpaintengine;
+
+private:
+
+    /**
+     *  The widget drawn for, which provides the sizes and resolution.
+     */
+
+    const QWidget * m_host;
+
+    /**
+     *  The area kept, in the coordinates of the host.
+     */
+
+    QRect m_area;
+
+    /**
+     *  The rectangles and texts recorded.
+     */
+
+    std::vector<glrect> m_rects;
+    std::vector<gltext> m_texts;
+
+    /**
+     *  The paint engine, created with the recorder.
+     */
+
+    std::unique_ptr<qglpaintengine> m_engine;
+
+public:
+
+    qglrecorder (const QWidget * host, const QRect & area);
+    virtual ~qglrecorder ();
+
+    void clear (const QRect & area);
+
+    const QRect & area () const
+    {
+        return m_area;
+    }
+
+    const std::vector<glrect> & rects () const
+    {
+        return m_rects;
+    }
+
+    const std::vector<gltext> & texts () const
+    {
+        return m_texts;
+    }
+
+    virtual QPaintEngine * paintEngine () const override;
+
+protected:
+
+    virtual int metric (PaintDeviceMetric m) const override;
+
+private:
+
+    void add_rect (const QRectF & r, const QColor & c);
+    void add_text
+    (
+        const QPointF & p, const QString & s,
+        const QFont & f, const QColor & c
+    );
+
+};          // class qglrecorder
+
+#if defined SEQ66_OPENGL_SUPPORT
+
+/**
+ *  The OpenGL widget that draws the layers of a roll.  It is a child of the
+ *  roll, placed over the visible part of it, and lets the mouse events go
+ *  through to the roll.
+ */
+
+class qglroll final : public QOpenGLWidget, protected QOpenGLExtraFunctions
+{
+
+private:
+
+    /**
+     *  A layer is a contiguous span of the instances, with its own texts.
+     *  The layers are drawn in the order of their keys.
+     */
+
+    class layer
+    {
+
+    public:
+
+        int ly_key;
+        std::size_t ly_start;
+        std::size_t ly_count;
+        std::vector<gltext> ly_texts;
+
+    };
+
+    /**
+     *  The layers, sorted by key, and all of their rectangles.
+     */
+
+    std::vector<layer> m_layers;
+    std::vector<glrect> m_instances;
+
+    /**
+     *  The span of m_instances not yet uploaded, empty if lo >= hi.
+     */
+
+    std::size_t m_dirty_lo;
+    std::size_t m_dirty_hi;
+
+    /**
+     *  The number of instances the GPU buffer can hold.
+     */
+
+    std::size_t m_capacity;
+
+    /**
+     *  The GPU objects, created in initializeGL().
+     */
+
+    std::unique_ptr<QOpenGLShaderProgram> m_program;
+    QOpenGLVertexArrayObject m_vao;
+    QOpenGLBuffer m_quad;
+    QOpenGLBuffer m_instance_buffer;
+    int m_origin_location;
+    int m_size_location;
+
+    /**
+     *  Set if the context is too old or the shaders did not build.  The
+     *  roll then goes back to raster painting.
+     */
+
+    bool m_failed;
+
+    /**
+     *  The background color, drawn where no rectangle is.
+     */
+
+    QColor m_clear_color;
+
+public:
+
+    qglroll (QWidget * host);
+    virtual ~qglroll ();
+
+    static qglroll * make (QWidget * host);
+
+    bool failed () const
+    {
+        return m_failed;
+    }
+
+    void set_view (const QRect & area);
+    void set_layer (int key, const qglrecorder & rec);
+    void clear_layer (int key);
+
+protected:
+
+    virtual void initializeGL () override;
+    virtual void paintGL () override;
+
+private:
+
+    std::vector<layer>::iterator find_layer (int key);
+    void mark_dirty (std::size_t lo, std::size_t hi);
+    void upload_instances ();
+    bool build_program ();
+    void release_gl ();
+
+};          // class qglroll
+
+#endif      // defined SEQ66_OPENGL_SUPPORT
+
+}           // namespace seq66
+
+#endif      // SEQ66_QGLROLL_HPP
+
+/*
+ * qglroll.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
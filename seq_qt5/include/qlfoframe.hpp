@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2022-05-15
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Provides a way to modulate MIDI controller events.
@@ -146,6 +146,7 @@ private slots:
     void phase_text_change ();
     void use_measure_clicked (int state);
     void reset ();
+    void add_lane ();
 
 private:
 
@@ -28,13 +28,18 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-28
- * \updates       2023-12-07
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
 
 #include <QFont>
+#include <QLine>
+#include <QPoint>
+#include <QRect>
+#include <vector>                       /* std::vector<>                    */
 
+#include "qslivemodel.hpp"              /* seq66::qslivemodel::item         */
 #include "qslotbutton.hpp"              /* seq66::qslotbutton base class    */
 
 /*
@@ -152,6 +157,29 @@ private:
     int m_note_min;
     int m_note_max;
 
+    /**
+     *  The pattern as drawn in the event box, kept from one paint to the
+     *  next.  It is scaled from the events held by the shared live model
+     *  (see qslivemodel), which walks the pattern once per edit for all
+     *  of the live grids.  It is rebuilt when the model's item is rebuilt,
+     *  or the event box changes.  The progress bar is drawn over it.
+     */
+
+    bool m_thumbnail_valid;
+    unsigned m_thumbnail_serial;
+    QRect m_thumbnail_box;
+    std::vector<QLine> m_thumbnail_notes;
+    std::vector<QPoint> m_thumbnail_tempos;
+    std::vector<QPoint> m_thumbnail_programs;
+
+    /**
+     *  The redraw generation and status bits of the pattern when the face
+     *  of the button was last checked.  See face_changed().
+     */
+
+    unsigned m_face_generation;
+    unsigned m_face_status;
+
     /**
      *  Provides a pointer to the sequence displayed by this button.  Note that
      *  we do not want to use a shared pointer.  First, semantically this button
@@ -244,13 +272,25 @@ public:
     virtual void set_checked (bool flag) override;
     virtual bool toggle_enabled () override;
     virtual bool toggle_checked () override;
+    virtual bool face_changed () override;
 
 protected:
 
-    void draw_progress (QPainter & p, midipulse tick, bool tiny = false);
-    void draw_progress_box (QPainter & painter);
-    void draw_pattern (QPainter & painter);
-    void initialize_fingerprint ();
+    const qslivemodel::item & model () const
+    {
+        return live_model().get(m_seq);
+    }
+
+    void draw_progress
+    (
+        QPainter & p, const qslivemodel::item & it,
+        bool tiny = false
+    );
+    void draw_progress_box (QPainter & painter, const qslivemodel::item & it);
+    void draw_pattern (QPainter & painter, const qslivemodel::item & it);
+    void initialize_fingerprint (const qslivemodel::item & it);
+    bool thumbnail_stale (const qslivemodel::item & it) const;
+    void build_thumbnail (const qslivemodel::item & it);
 
 private:
 
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-05-29
- * \updates       2023-10-09
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  We want to be able to survey the existing mute-groups.
@@ -46,8 +46,8 @@
  *  Forward references.
  */
 
+class QModelIndex;
 class QPushButton;
-class QTableWidgetItem;
 class QTimer;
 
 /*
@@ -66,6 +66,7 @@ namespace Ui
 
 namespace seq66
 {
+    class qmutemodel;
     class qsmainwnd;
 
 /**
@@ -79,21 +80,10 @@ class qmutemaster final :
 {
     friend class qsmainwnd;
     friend class qseditoptions;
+    friend class qmutemodel;
 
 private:
 
-    /**
-     *  Provides human-readable names for the columns of the set table.
-     */
-
-    enum class column_id
-    {
-        group_number,
-        group_count,
-        group_keyname,
-        group_name
-    };
-
     enum class enabling
     {
         disable,
@@ -195,20 +185,12 @@ private:
     void set_column_widths (int total_width);
     void setup_table ();
     bool initialize_table ();
-    bool group_line
-    (
-        mutegroup::number row,
-        int mutecount,
-        const std::string & keyname,
-        const std::string & groupname
-    );
 
 #if defined PASS_KEYSTROKES_TO_PARENT
     bool handle_key_press (const keystroke & k);
     bool handle_key_release (const keystroke & k);
 #endif
 
-    QTableWidgetItem * cell (screenset::number row, column_id col);
     void clear_pattern_mutes ();
     bool load_mutegroups (const std::string & fullfilespec);
     bool save_mutegroups (const std::string & fullfilespec);    // UNUSED
@@ -219,13 +201,8 @@ signals:
 private slots:
 
     void conditional_update ();
-    void slot_table_click
-    (
-        int row, int /*column*/,
-        int /*prevrow*/, int /*prevcolumn*/
-    );
+    void slot_table_click (const QModelIndex & current);
     void slot_clear_all_mutes ();
-    void slot_cell_changed (int row, int column);
     void slot_bin_mode (bool ischecked);
     void slot_hex_mode (bool ischecked);
     void slot_trigger ();
@@ -266,6 +243,12 @@ private:
 
     QTimer * m_timer;
 
+    /**
+     *  The model of the mute-group table, owned by this frame.
+     */
+
+    qmutemodel * m_group_model;
+
     /**
      *  The main window that owns this window.
      */
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2023-10-15
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -35,6 +35,7 @@
 #include <QWidget>
 
 #include "qperfbase.hpp"                /* for constants and base class     */
+#include "qperfrows.hpp"                /* seq66::qperfrows row model       */
 #include "gui_palette_qt5.hpp"          /* gui_pallete_qt5::Color etc.      */
 
 /*
@@ -79,6 +80,7 @@ public:
 protected:
 
     void reupdate ();
+    void update_rows ();
     void set_preview_row (int row);
 
     int name_x (int i)
@@ -105,6 +107,7 @@ protected:          // Qt overrides
 private:
 
     int convert_y (int y);
+    int row_max () const;
 
     const Color & preview_color () const
     {
@@ -127,6 +130,12 @@ private slots:
 
 private:
 
+    /**
+     *  The snapshots of the rows, read only for the rows painted.
+     */
+
+    qperfrows m_rows;
+
     QFont m_font;
     int m_nametext_x;
     Color m_preview_color;                  /* will reduce its alpha value  */
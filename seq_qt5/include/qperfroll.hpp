@@ -28,14 +28,18 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-12-02
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class represents the central piano-roll user-interface area of the
  *  performance/song editor.
  */
 
+#include <QLine>
+#include <QPoint>
 #include <QWidget>
+#include <memory>                       /* std::unique_ptr<>                */
+#include <vector>                       /* std::vector<>                    */
 
 #include "qperfbase.hpp"                /* seq66::qperfbase base class      */
 
@@ -54,6 +58,8 @@ class QTimer;
 namespace seq66
 {
     class performer;
+    class qglrecorder;
+    class qglroll;
     class qperfeditframe64;
     class qperfnames;
 
@@ -102,6 +108,17 @@ private:
     int seq_id_from_xy (int /*click_x*/, int click_y);
     void draw_grid (QPainter & painter, const QRect & r);
     void draw_triggers (QPainter & painter, const QRect & r);
+    void draw_overlays (QPainter & painter);
+    unsigned change_generation () const;
+    unsigned perf_generation () const;
+    void update_progress ();
+    void update_rows (bool repaint);
+    void gpu_paint (bool changed);
+
+    bool use_gpu () const
+    {
+        return m_gl_view != nullptr;
+    }
 
     void resize ()
     {
@@ -168,6 +185,45 @@ private:
     void delete_trigger (int seq, midipulse tick);
     void follow_progress ();
 
+private:
+
+    /**
+     *  The notes of a pattern, as drawn in one repeat of the pattern inside
+     *  a trigger box, relative to the box's top-left corner.  They are
+     *  recalculated only when the pattern's redraw generation or the drawn
+     *  size changes, and otherwise are simply translated to each repeat.
+     */
+
+    class notecache
+    {
+
+    public:
+
+        bool nc_valid;
+        unsigned nc_generation;
+        int nc_width;
+        int nc_height;
+        std::vector<QLine> nc_notes;
+        std::vector<QPoint> nc_tempos;
+
+        notecache () :
+            nc_valid        (false),
+            nc_generation   (0),
+            nc_width        (0),
+            nc_height       (0),
+            nc_notes        (),
+            nc_tempos       ()
+        {
+            // no code
+        }
+
+    };
+
+    const notecache & pattern_notes
+    (
+        const seq::pointer & s, int seqid, int lenw
+    );
+
 private:
 
     qperfeditframe64 * m_parent_frame;
@@ -194,6 +250,41 @@ private:
     bool m_grow_direction;
     bool m_adding_pressed;
 
+    /**
+     *  The note caches, indexed by pattern number.
+     */
+
+    std::vector<notecache> m_note_cache;
+
+    /**
+     *  The sum of the change counters at the last full repaint, and the
+     *  playhead position then drawn.  While playing, if nothing has changed,
+     *  only the strips under the old and new playhead are repainted.
+     */
+
+    unsigned m_change_generation;
+    int m_progress_x;
+
+    /**
+     *  The performer's part of the change counters at the last full
+     *  repaint, and the redraw generation of each pattern row as last
+     *  painted.  If only patterns changed, only their rows are repainted.
+     */
+
+    unsigned m_perf_generation;
+    std::vector<unsigned> m_row_generations;
+
+    /**
+     *  The GPU view of the roll, a child widget over the visible part of
+     *  it, the recorder its layers are drawn into, and the area for which
+     *  the grid and triggers were last recorded.  The view is null unless
+     *  the build supports OpenGL and "gpu-rendering" is on.
+     */
+
+    qglroll * m_gl_view;
+    std::unique_ptr<qglrecorder> m_gl_recorder;
+    QRect m_gl_rect;
+
 };          // class qperfroll
 
 }           // namespace seq66
@@ -0,0 +1,194 @@
+#if ! defined SEQ66_QPERFROWS_HPP
+#define SEQ66_QPERFROWS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qperfrows.hpp
+ *
+ *  This module declares the row model of the names column of the song
+ *  editor.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Formerly qperfnames painted every row of the song, thousands of them
+ *  with many sets, at each repaint, and read the name, mute, color, length,
+ *  and trigger count of each pattern, each read taking the lock of the
+ *  pattern.  Now each row has a snapshot here, and only the rows that are
+ *  exposed are painted.  A snapshot is read again only after a change
+ *  counter of the patterns or of the performer has moved, and then only
+ *  when its row is painted or checked for a repaint.  The rows scrolled out
+ *  of view cost nothing.  Everything here runs in the GUI thread.
+ */
+
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "play/seq.hpp"                 /* seq66::seq::number               */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class performer;
+
+/**
+ *  Holds the per-row data drawn by qperfnames.
+ */
+
+class qperfrows
+{
+
+public:
+
+    /**
+     *  The snapshot of one row.
+     */
+
+    class row
+    {
+        friend class qperfrows;
+
+    private:
+
+        unsigned m_stamp;               /**< Model stamp of the snapshot.   */
+        bool m_active;                  /**< The row has a pattern.         */
+        bool m_muted;                   /**< The song mute of the pattern.  */
+        int m_color;                    /**< The palette color number.      */
+        int m_measures;                 /**< The length in measures.        */
+        int m_triggers;                 /**< The number of triggers.        */
+        std::string m_name;             /**< The name of the pattern.       */
+        std::string m_label;            /**< performer::sequence_label().   */
+        std::string m_set_name;         /**< Name of the set, first row.    */
+
+    public:
+
+        row ();
+
+        bool operator == (const row & rhs) const;
+
+        bool operator != (const row & rhs) const
+        {
+            return ! (*this == rhs);
+        }
+
+        bool active () const
+        {
+            return m_active;
+        }
+
+        bool muted () const
+        {
+            return m_muted;
+        }
+
+        int color () const
+        {
+            return m_color;
+        }
+
+        int measures () const
+        {
+            return m_measures;
+        }
+
+        int triggers () const
+        {
+            return m_triggers;
+        }
+
+        const std::string & name () const
+        {
+            return m_name;
+        }
+
+        const std::string & label () const
+        {
+            return m_label;
+        }
+
+        const std::string & set_name () const
+        {
+            return m_set_name;
+        }
+
+    };          // nested class row
+
+private:
+
+    /**
+     *  The source of the data.
+     */
+
+    const performer & m_perf;
+
+    /**
+     *  The rows, indexed by pattern number, grown as rows are asked for.
+     */
+
+    std::vector<row> m_rows;
+
+    /**
+     *  The stamp of the current data.  A row with another stamp is stale.
+     *  It starts at 1, so that a new row, with stamp 0, is stale.
+     */
+
+    unsigned m_stamp;
+
+    /**
+     *  The sum of the change counters seen by the last check().
+     */
+
+    unsigned m_generation;
+
+public:
+
+    qperfrows (const performer & p);
+
+    qperfrows (const qperfrows &) = delete;
+    qperfrows & operator = (const qperfrows &) = delete;
+
+    void invalidate ();
+    bool check ();
+    const row & get (seq::number seqno);
+    bool changed (seq::number seqno);
+
+private:
+
+    unsigned generation () const;
+    void refresh (row & r, seq::number seqno);
+
+};          // class qperfrows
+
+}           // namespace seq66
+
+#endif      // SEQ66_QPERFROWS_HPP
+
+/*
+ * qperfrows.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-09-04
- * \updates       2023-07-13
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -41,7 +41,7 @@
  * Qt forward references.
  */
 
-class QTableWidgetItem;
+class QModelIndex;
 class QTimer;
 
 /*
@@ -60,6 +60,7 @@ namespace Ui
 namespace seq66
 {
     class performer;
+    class qplaylistmodel;
     class qsmainwnd;
 
 /**
@@ -72,19 +73,6 @@ class qplaylistframe final : public QFrame
 
     Q_OBJECT
 
-private:
-
-    /**
-     *  Provides human-readable names for the columns of the playlist and song
-     *  tables.
-     */
-
-    enum column_id_t
-    {
-        CID_MIDI_NUMBER,
-        CID_ITEM_NAME
-    };
-
 public:
 
     qplaylistframe
@@ -106,7 +94,6 @@ private:
     void set_current_song ();
     void fill_playlists ();
     void fill_songs ();
-    QTableWidgetItem * cell (bool isplaylist, int row, column_id_t col);
 
     performer & perf ()
     {
@@ -140,8 +127,8 @@ signals:
 
 private slots:
 
-    void slot_list_click_ex (int, int, int, int);
-    void slot_song_click_ex (int, int, int, int);
+    void slot_list_click_ex (const QModelIndex & current);
+    void slot_song_click_ex (const QModelIndex & current);
     void slot_file_create_click();
     void slot_list_dir_click ();
     void slot_list_load_click ();
@@ -178,6 +165,13 @@ private:
 
     QTimer * m_timer;
 
+    /**
+     *  The models of the playlist and song tables, owned by this frame.
+     */
+
+    qplaylistmodel * m_list_model;
+    qplaylistmodel * m_song_model;
+
     /**
      *  The performer object.
      */
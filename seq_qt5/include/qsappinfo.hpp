@@ -22,12 +22,13 @@
 /**
  * \file          qsappinfo.hpp
  *
- *  This dialog provides some context-specific help.
+ *  This dialog provides some context-specific help, and a reading of the
+ *  memory held by the song data.
  *
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2023-08-21
- * \updates       2023-09-12
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -41,6 +42,7 @@ namespace Ui
 
 namespace seq66
 {
+    class performer;
 
 class qsappinfo final : public QDialog
 {
@@ -48,7 +50,7 @@ class qsappinfo final : public QDialog
 
 public:
 
-    explicit qsappinfo (QWidget * parent = nullptr);
+    explicit qsappinfo (const performer & p, QWidget * parent = nullptr);
     virtual ~qsappinfo ();
 
 private:
@@ -67,11 +69,18 @@ private slots:
     void slot_songroll_keys ();
     void slot_hot_keys ();
     void slot_mutes_keys ();
+    void slot_memory_usage ();
 
 private:
 
     Ui::qsappinfo * ui;
 
+    /**
+     *  Provides the memory usage reading.
+     */
+
+    const performer & m_performer;
+
 };             // class qsappinfo
 
 }              // namespace seq66
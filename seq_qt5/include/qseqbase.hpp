@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-20
- * \updates       2023-09-11
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class is a base class for qseqroll, qseqdata, qtriggereditor, and
@@ -149,6 +149,18 @@ protected:
         m_move_snap_offset_x = v;
     }
 
+    /**
+     *  Tells if the view is zoomed out so far that a sixteenth note is at
+     *  most three pixels wide, which is too narrow for a note highlight or
+     *  a data value.  Then events share pixel columns, and the editors draw
+     *  from an eventsummary instead of event by event.
+     */
+
+    bool summarized () const
+    {
+        return tix_to_pix(z().ppqn() / 4) <= 3;
+    }
+
     /*
      * We are not the owner of this shared pointer.
      */
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2023-11-22
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The data pane is the drawing-area below the seqedit's event area, and
@@ -47,6 +47,7 @@
 #include <QPen>
 
 #include "midi/midibytes.hpp"           /* midibyte, midipulse aliases      */
+#include "play/eventsummary.hpp"        /* seq66::eventsummary class        */
 #include "qseqbase.hpp"                 /* seq66::qseqbase mixin class      */
 
 /*
@@ -144,6 +145,10 @@ public:
 private:
 
     void flag_dirty ();                 /* tricky code */
+    void draw_summary (QPainter & painter, const QRect & r);
+    void build_summary ();
+    void refresh_summary ();
+    bool dense_lane ();
 
 #if defined SEQ66_ALLOW_RELATIVE_VELOCITY_CHANGE
     void set_adjustment (midipulse tick_start, midipulse tick_finish);
@@ -248,6 +253,25 @@ private:
 
     bool m_dragging;
 
+    /**
+     *  The data events being shown, summarized for drawing zoomed out, and
+     *  the status, controller, and pattern redraw generation for which it
+     *  was built.
+     */
+
+    eventsummary m_summary;
+    bool m_summary_valid;
+    midibyte m_summary_status;
+    midibyte m_summary_cc;
+    unsigned m_summary_generation;
+
+    /**
+     *  The redraw generation of the pattern last seen by
+     *  conditional_update(), for getting the region changed since.
+     */
+
+    unsigned m_region_generation;
+
 };          // class qseqdata
 
 }           // namespace seq66
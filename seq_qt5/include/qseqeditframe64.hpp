@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-15
- * \updates       2025-01-12
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -157,6 +157,7 @@ public:
     bool follow_progress (bool expand = false);
     void scroll_to_tick (midipulse tick);
     void scroll_to_note (int note);
+    bool quantize_job (int divide);
 
     int edit_channel () const
     {
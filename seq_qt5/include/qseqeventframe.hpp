@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-13
- * \updates       2023-05-05
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
@@ -147,6 +147,7 @@ private:
     void set_event_line (int row);                              /* overload */
     void set_dirty (bool flag = true);
     bool initialize_table ();
+    void load_visible_rows ();
     std::string make_seq_title ();
     std::string get_lengths ();
 
@@ -176,9 +177,12 @@ protected:                          // overrides of event handlers
 
     virtual void keyPressEvent (QKeyEvent *) override;
     virtual void keyReleaseEvent (QKeyEvent *) override;
+    virtual void resizeEvent (QResizeEvent *) override;
 
 private slots:
 
+    void slot_table_scrolled (int value);
+
     void slot_table_click_ex (int row, int column, int prevrow, int prevcol);
     void slot_row_selected ();
     void slot_link_status ();
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-12-17
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  We are currently moving toward making this class a base class.
@@ -37,9 +37,14 @@
  *  progress bar during playback.  See the qseqbase::m_progress_follow member.
  */
 
+#include <QPixmap>
 #include <QWidget>
 
+#include <memory>                       /* std::unique_ptr<>                */
+#include <vector>                       /* std::vector<>                    */
+
 #include "cfg/scales.hpp"               /* seq66::scales enum class         */
+#include "play/eventsummary.hpp"        /* seq66::eventsummary class        */
 #include "play/sequence.hpp"            /* sequence::editmode mode          */
 #include "util/rect.hpp"                /* seq66::rect class                */
 #include "qseqbase.hpp"                 /* seq66::qseqbase mixin class      */
@@ -60,6 +65,8 @@ class QTimer;
 namespace seq66
 {
     class performer;
+    class qglrecorder;
+    class qglroll;
     class qseqeditframe64;
     class qseqkeys;
 
@@ -69,6 +76,34 @@ namespace seq66
 
 class qseqroll final : public QWidget, public qseqbase
 {
+
+private:
+
+    /**
+     *  The notes of a pattern summarized for drawing zoomed out, one
+     *  run-mode eventsummary per note row, with the pattern and the redraw
+     *  generation they were built for.
+     */
+
+    class notesummary
+    {
+
+    public:
+
+        const sequence * ns_seq;
+        unsigned ns_generation;
+        std::vector<eventsummary> ns_rows;
+
+        notesummary () :
+            ns_seq          (nullptr),
+            ns_generation   (0),
+            ns_rows         ()
+        {
+            // no code
+        }
+
+    };
+
     friend class qseqframe;             /* for qseqroll::set_dirty() access */
     friend class qseqeditframe64;
 
@@ -179,6 +214,12 @@ private:
     void start_paste();
     void draw_grid (QPainter & painter, const QRect & r);
     void draw_notes (QPainter & painter, const QRect & r, bool background);
+    void draw_summary
+    (
+        QPainter & painter, const QRect & r,
+        sequence & s, bool background
+    );
+    void build_summary (notesummary & ns, sequence & s);
     void draw_drum_notes (QPainter & painter, const QRect & r, bool background);
     void draw_drum_note (QPainter & painter, int x, int y);
     void call_draw_notes (QPainter & painter, const QRect & view);
@@ -192,6 +233,22 @@ private:
         QPainter & painter,
         const seq66::rect & selection   /* why is seq66 scoped needed???    */
     );
+    void render_backing (const QRect & area);
+    void render_patch ();
+    bool patch_region ();
+    void draw_overlays (QPainter & painter, const QRect & r);
+    void update_progress ();
+    void gpu_paint ();
+
+    bool use_gpu () const
+    {
+        return m_gl_view != nullptr;
+    }
+
+    void invalidate_backing ()
+    {
+        m_backing_dirty = true;
+    }
 
 private:
 
@@ -366,6 +423,60 @@ private:
 
     bool m_link_wraparound;
 
+    /**
+     *  The static layer of the piano roll, the grid and the notes, rendered
+     *  for the visible area.  A repaint copies it, then draws the playhead
+     *  and any selection box, ghost notes, or drag box over it.  It is
+     *  rendered again only if the notes, zoom, scroll, size, scale, or edit
+     *  mode change, as flagged by set_dirty(), sequence::is_dirty_edit(),
+     *  or a different visible area.
+     */
+
+    QPixmap m_backing;
+
+    /**
+     *  The area of the widget that m_backing covers, and the edit mode and
+     *  scroll offsets (x, v) it was drawn for.  The grid depends on both
+     *  offsets.
+     */
+
+    QRect m_backing_rect;
+    sequence::editmode m_backing_mode;
+    QPoint m_backing_scroll;
+
+    /**
+     *  Set when m_backing must be rendered again.
+     */
+
+    bool m_backing_dirty;
+
+    /**
+     *  The part of m_backing to render again at the next repaint, and the
+     *  redraw generation of the pattern it was last patched for.  See
+     *  patch_region().
+     */
+
+    QRect m_backing_patch;
+    unsigned m_region_generation;
+
+    /**
+     *  The note summaries of the pattern and of the background pattern.
+     */
+
+    notesummary m_fore_summary;
+    notesummary m_back_summary;
+
+    /**
+     *  The GPU view of the roll, a child widget over the visible part of
+     *  it, and the recorder its layers are drawn into.  Null unless the
+     *  build supports OpenGL and "gpu-rendering" is on.  The grid and the
+     *  notes are recorded for the area in m_backing_rect, under the same
+     *  conditions as m_backing is rendered; the overlays at each update.
+     */
+
+    qglroll * m_gl_view;
+    std::unique_ptr<qglrecorder> m_gl_recorder;
+
 signals:
 
 public slots:
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-05-11
- * \updates       2023-11-11
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  We want to be able to survey the existing screen-sets and sequences, and
@@ -49,8 +49,8 @@
  *  Forward references.
  */
 
+class QModelIndex;
 class QPushButton;
-class QTableWidgetItem;
 class QTimer;
 
 /*
@@ -69,6 +69,7 @@ namespace Ui
 
 namespace seq66
 {
+    class qsetmodel;
     class qsmainwnd;
 
 /**
@@ -80,20 +81,10 @@ class qsetmaster final :
     public QFrame,
     protected performer::callbacks
 {
+    friend class qsetmodel;
 
 private:
 
-    /**
-     *  Provides human-readable names for the columns of the set table.
-     */
-
-    enum class column_id
-    {
-        set_number,
-        set_seq_count,
-        set_name
-    };
-
     using buttons = std::vector<QPushButton *>;
 
 private:
@@ -159,18 +150,12 @@ private:
     void set_column_widths (int total_width);
     void setup_table ();
     bool initialize_table ();
-    bool set_line
-    (
-        screenset & sset,
-        screenset::number row
-    );
 
 #if defined PASS_KEYSTROKES_TO_PARENT
     bool handle_key_press (const keystroke & k);
     bool handle_key_release (const keystroke & k);
 #endif
 
-    QTableWidgetItem * cell (screenset::number row, column_id col);
     void move_helper (int oldrow, int newrow);
 
 signals:
@@ -183,11 +168,7 @@ private slots:
     void slot_move_down ();
     void slot_move_up ();
     void slot_delete ();
-    void slot_table_click_ex
-    (
-        int row, int /*column*/, int /*prevrow*/, int /*prevcolumn*/
-    );
-    void slot_cell_changed (int row, int column);
+    void slot_table_click_ex (const QModelIndex & current);
     void slot_toggle_trigger_mode ();
     void slot_set_0 ();
 
@@ -214,6 +195,12 @@ private:
 
     QTimer * m_timer;
 
+    /**
+     *  The model of the set table, owned by this frame.
+     */
+
+    qsetmodel * m_set_model;
+
     /**
      *  The main window that owns this window.
      */
@@ -256,12 +243,6 @@ private:
 
     bool m_trigger_mode;
 
-    /**
-     *  Prevents slots from working while the tables are built.
-     */
-
-    bool m_table_initializing;
-
     /**
      *  Indicates that this view is embedded in a frame, and thus permanent.
      *  Commented out because we no longer support an external setmaster
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-13
- * \updates       2023-05-03
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class supports the left side of the Qt 5 version of the Event Editor
@@ -36,6 +36,8 @@
  *  widget will be used to display the events.
  */
 
+#include <vector>                       /* std::vector<>                    */
+
 #include "midi/editable_events.hpp"     /* seq66::editable_events container */
 #include "play/seq.hpp"                 /* seq66::seq::pointer & sequence   */
 
@@ -86,6 +88,15 @@ private:
 
     editable_events m_event_container;
 
+    /**
+     *  The events in table order, one per row.  It lets a row be found from
+     *  an event, or from a time, and an event from a row, without walking
+     *  the multimap, and so lets the table fill only the rows that are
+     *  shown.  It is rebuilt whenever events are added or removed.
+     */
+
+    std::vector<editable_events::iterator> m_rows;
+
     /**
      *  Holds the current event (i.e. most recently inserted) for usage by the
      *  caller, the event-edit frame.
@@ -215,6 +226,7 @@ public:
     void clear ()
     {
         m_event_container.clear();
+        m_rows.clear();
     }
 
     midipulse get_length () const
@@ -222,15 +234,9 @@ public:
         return m_event_container.get_length();
     }
 
-    int count_to_link (const editable_event & source) const
-    {
-        return m_event_container.count_to_link(source);
-    }
-
-    editable_event & lookup_link (const editable_event & ee)
-    {
-        return m_event_container.lookup_link(ee);
-    }
+    int count_to_link (const editable_event & source) const;
+    editable_event & lookup_link (const editable_event & ee);
+    int row_of_time (midipulse tick) const;
 
     const editable_event & current_event () const
     {
@@ -330,6 +336,7 @@ private:
 
     bool load_events ();
     bool load_table ();
+    bool load_row (int row);
     midibyte string_to_channel (const std::string & channel);
     std::string events_to_string () const;
     void set_current_event
@@ -394,6 +401,8 @@ private:
     void page_movement (int new_value);
 #endif
     void page_topper (editable_events::iterator newcurrent);
+    void index_rows ();
+    int row_of (editable_events::iterator ei) const;
     int decrement_top ();
     int increment_top ();
     int decrement_current ();
@@ -0,0 +1,94 @@
+#if ! defined SEQ66_QSINPUTMONITOR_HPP
+#define SEQ66_QSINPUTMONITOR_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qsinputmonitor.hpp
+ *
+ *  This dialog shows the MIDI messages arriving on the input busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The dialog is laid out in code instead of in a .ui form, as is the
+ *  qsoutputstats dialog.
+ */
+
+#include <QDialog>
+#include <vector>                       /* std::vector<>                    */
+
+#include "play/inputmonitor.hpp"        /* seq66::inputmonitor::record      */
+
+class QLabel;
+class QPushButton;
+class QTableView;
+class QTimer;
+
+namespace seq66
+{
+    class performer;
+    class qsinputmodel;
+
+class qsinputmonitor final : public QDialog
+{
+    Q_OBJECT
+
+public:
+
+    qsinputmonitor (performer & p, QWidget * parent = nullptr);
+    virtual ~qsinputmonitor ();
+
+protected:
+
+    virtual void showEvent (QShowEvent *) override;
+    virtual void hideEvent (QHideEvent *) override;
+
+private slots:
+
+    void conditional_update ();
+    void slot_pause (bool checked);
+    void slot_clear ();
+
+private:
+
+    performer & m_performer;
+    qsinputmodel * m_model;
+    QTableView * m_view;
+    QLabel * m_status;
+    QPushButton * m_pause;
+    QTimer * m_timer;
+    std::vector<inputmonitor::record> m_batch;
+    bool m_paused;
+
+};             // class qsinputmonitor
+
+}              // namespace seq66
+
+#endif         // SEQ66_QSINPUTMONITOR_HPP
+
+/*
+ * qsinputmonitor.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
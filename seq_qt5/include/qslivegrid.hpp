@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-21
- * \updates       2025-01-12
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *
@@ -186,6 +186,10 @@ private:
     bool delete_slot (seq::number seqno);
     bool delete_all_slots ();
     bool refresh_all_slots ();
+    bool rebind_all_slots ();
+    qslotbutton * spare_button (seq::number seqno, seq::pointer pattern);
+    void retire_button (qslotbutton * pb);
+    void clear_spare_buttons ();
     bool modify_slot (qslotbutton * newslot, int row, int column);
     void button_toggle_enabled (seq::number seqno);
     void button_toggle_checked (seq::number seqno);
@@ -219,6 +223,8 @@ private slots:
     void edit_sequence_ex ();
     void edit_events ();
     void record_sequence ();
+    void notemap_sequence ();
+    void filter_sequence ();
     void copy_sequence ();
     void cut_sequence ();
     void paste_sequence ();
@@ -256,6 +262,17 @@ private:
 
     buttons m_loop_buttons;
 
+    /**
+     *  Buttons taken out of the grid by a change of screen-set, hidden, and
+     *  kept for when their patterns (or an empty slot) are shown again.  A
+     *  loop button keeps its pattern and its cached thumbnail, so switching
+     *  back and forth between sets creates no widgets.  The oldest spares
+     *  are deleted once there are more than a few sets' worth of them, and
+     *  all are deleted when the grid is rebuilt.
+     */
+
+    buttons m_spare_buttons;
+
     /**
      *  Layout of buttons for determining sequence numbers.
      */
@@ -0,0 +1,236 @@
+#if ! defined SEQ66_QSLIVEMODEL_HPP
+#define SEQ66_QSLIVEMODEL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qslivemodel.hpp
+ *
+ *  This module declares the render model shared by all of the live grids.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The main window's live grid and every external live frame show pattern
+ *  buttons.  Formerly each button read the status of its pattern and walked
+ *  all of its events for the thumbnail on its own, so that each extra live
+ *  frame, and each extra button showing the same pattern, repeated the
+ *  work.  Now each pattern has one item in this model.  Its status and play
+ *  tick are read once per frame, and its events are walked once per edit,
+ *  in tick and note units.  Each button only scales the item to its own
+ *  event box, and only when the item or the box changes.
+ *
+ *  The frame is advanced by the first live grid attached, normally the one
+ *  in the main window.  The other grids read the snapshot of the latest
+ *  frame.  Everything here runs in the GUI thread.
+ */
+
+#include <map>                          /* std::map<>                       */
+#include <memory>                       /* std::weak_ptr<>                  */
+#include <vector>                       /* std::vector<>                    */
+
+#include "play/seq.hpp"                 /* seq66::seq::number, pointer      */
+#include "play/sequence.hpp"            /* seq66::sequence class            */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds the per-pattern data drawn by the live grids.
+ */
+
+class qslivemodel
+{
+
+public:
+
+    /**
+     *  One drawable event of a pattern, as returned by
+     *  sequence::get_next_note().
+     */
+
+    class mark
+    {
+
+    public:
+
+        sequence::draw m_kind;
+        sequence::note_info m_info;
+
+    };
+
+    /**
+     *  The snapshot of one pattern.
+     */
+
+    class item
+    {
+        friend class qslivemodel;
+
+    private:
+
+        std::weak_ptr<sequence> m_seq;  /**< The pattern, not owned.        */
+        unsigned m_frame;               /**< Frame of the status snapshot.  */
+        unsigned m_status;              /**< The status bits, see below.    */
+        midipulse m_tick;               /**< The last tick played.          */
+        bool m_valid;                   /**< The event data has been built. */
+        unsigned m_generation;          /**< Redraw generation of the data. */
+        midipulse m_length;             /**< Pattern length of the data.    */
+        unsigned m_serial;              /**< Bumped for each rebuild.       */
+        bool m_have_notes;              /**< Result of minmax_notes().      */
+        int m_note_min;                 /**< The lowest note.               */
+        int m_note_max;                 /**< The highest note.              */
+        bool m_threshold;               /**< Result of event_threshold().   */
+        std::vector<mark> m_marks;      /**< The events to draw.            */
+
+    public:
+
+        item ();
+
+        unsigned status () const
+        {
+            return m_status;
+        }
+
+        bool armed () const
+        {
+            return (m_status & c_armed) != 0;
+        }
+
+        bool queued () const
+        {
+            return (m_status & c_queued) != 0;
+        }
+
+        bool one_shot () const
+        {
+            return (m_status & c_one_shot) != 0;
+        }
+
+        bool snap_it () const
+        {
+            return (m_status & c_snap_it) != 0;
+        }
+
+        midipulse tick () const
+        {
+            return m_tick;
+        }
+
+        unsigned serial () const
+        {
+            return m_serial;
+        }
+
+        midipulse length () const
+        {
+            return m_length;
+        }
+
+        bool minmax_notes (int & lowest, int & highest) const
+        {
+            lowest = m_note_min;
+            highest = m_note_max;
+            return m_have_notes;
+        }
+
+        bool event_threshold () const
+        {
+            return m_threshold;
+        }
+
+        const std::vector<mark> & marks () const
+        {
+            return m_marks;
+        }
+
+    };          // nested class item
+
+private:
+
+    /**
+     *  The status bits of an item.
+     */
+
+    static const unsigned c_armed       = 0x01;
+    static const unsigned c_queued      = 0x02;
+    static const unsigned c_one_shot    = 0x04;
+    static const unsigned c_recording   = 0x08;
+    static const unsigned c_alter       = 0x10;
+    static const unsigned c_expanded    = 0x20;
+    static const unsigned c_snap_it     = 0x40;
+
+    /**
+     *  The items, keyed by pattern number.  A map keeps references to the
+     *  items valid as others are added.
+     */
+
+    std::map<seq::number, item> m_items;
+
+    /**
+     *  The live grids using the model.  The first one advances the frame.
+     */
+
+    std::vector<const void *> m_views;
+
+    /**
+     *  The current frame number.
+     */
+
+    unsigned m_frame;
+
+public:
+
+    qslivemodel ();
+
+    qslivemodel (const qslivemodel &) = delete;
+    qslivemodel & operator = (const qslivemodel &) = delete;
+
+    void attach (const void * view);
+    void detach (const void * view);
+    void advance (const void * view);
+    const item & get (seq::pointer s);
+    void forget (seq::number seqno);
+
+private:
+
+    static unsigned status_of (const sequence & s);
+    static void rebuild (item & it, const sequence & s);
+
+};          // class qslivemodel
+
+extern qslivemodel & live_model ();
+
+}           // namespace seq66
+
+#endif      // SEQ66_QSLIVEMODEL_HPP
+
+/*
+ * qslivemodel.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2021-09-19
- * \updates       2022-07-22
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  All this button can do is enable a new pattern to be created.  It is
@@ -168,6 +168,12 @@ public:
     }
 
     virtual void setup ();
+    void rebind
+    (
+        seq::number slotnumber,
+        const std::string & label,
+        const std::string & hotkey
+    );
 
     virtual seq::pointer loop ()
     {
@@ -309,6 +315,17 @@ protected:
         // no code, handles empty button
     }
 
+    /**
+     *  Tells if the face of the button (everything but the progress bar)
+     *  needs to be painted again.  The base class cannot tell, so it says
+     *  yes.
+     */
+
+    virtual bool face_changed ()
+    {
+        return true;
+    }
+
 protected:
 
     void label_color (Color c)
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2025-01-25
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The main window is known as the "Patterns window" or "Patterns panel".  It
@@ -83,6 +83,7 @@ namespace Ui
 namespace seq66
 {
     class keystroke;
+    class qframeclock;
     class qliveframeex;
     class qmutemaster;
     class qperfeditex;
@@ -100,6 +101,8 @@ namespace seq66
     class qslivegrid;
     class qslogview;
     class qsmaintime;
+    class qsoutputstats;
+    class qsinputmonitor;
     class qt5nsmanager;
     class smanager;
 
@@ -331,6 +334,7 @@ private:
     QMessageBox * m_msg_error;              /* QErrorMessage        */
     QMessageBox * m_msg_save_changes;
     QTimer * m_timer;
+    qframeclock * m_frame_clock;            /* drives the views' timers */
     QMenu * m_menu_recent;
     QList<QAction *> m_recent_action_list;
     qsmaintime * m_beat_ind;
@@ -339,6 +343,8 @@ private:
     qsbuildinfo * m_dialog_build_info;
     qsappinfo * m_dialog_app_info;
     qslogview * m_dialog_log_view;
+    qsoutputstats * m_dialog_output_stats;
+    qsinputmonitor * m_dialog_input_monitor;
     qsessionframe * m_session_frame;
     qsetmaster * m_set_master;
     qmutemaster * m_mute_master;
@@ -442,6 +448,14 @@ private:
 
     bool m_shrunken;
 
+    /**
+     *  The timer that drives the script of the --gui-bench option, and the
+     *  trace-clock time at which the script started.
+     */
+
+    QTimer * m_bench_timer;
+    long m_bench_start_us;
+
 signals:
 
     void signal_set_change (int setno);
@@ -484,6 +498,7 @@ private slots:
     bool export_song (const std::string & fname = "");
     void quit ();
     void import_midi_into_set ();           /* normal import into set       */
+    void import_midi_into_sets ();          /* files, one per set           */
     void import_midi_into_session ();       /* import MIDI into session     */
     void import_project ();                 /* import a configuration       */
     void import_playlist ();
@@ -496,8 +511,12 @@ private slots:
     void show_qsbuildinfo ();
     void show_qsappinfo ();
     void show_qslogview ();
+    void show_qsoutputstats ();
+    void show_qsinputmonitor ();
     void tabWidgetClicked (int newindex);
     void conditional_update ();             /* redraw certain GUI elements  */
+    void start_gui_bench ();                /* opens the --gui-bench song   */
+    void gui_bench_step ();                 /* scrolls, zooms, flips tabs   */
     void load_editor (int seqid);
     void load_event_editor (int seqid);
     void load_qseqedit (int seqid);
@@ -505,8 +524,10 @@ private slots:
     void load_qperfedit (bool on);
     void load_live_frame (int ssnum);
     void load_session_frame ();
-    void load_set_master ();
-    void load_mute_master ();
+    bool load_set_master ();
+    bool load_mute_master ();
+    bool load_playlist_frame ();
+    bool load_edit_prefs ();
     void toggle_time_format (bool on);
     void reset_sets ();
     void open_performance_edit ();
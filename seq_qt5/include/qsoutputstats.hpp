@@ -0,0 +1,97 @@
+#if ! defined SEQ66_QSOUTPUTSTATS_HPP
+#define SEQ66_QSOUTPUTSTATS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qsoutputstats.hpp
+ *
+ *  This dialog shows the timing statistics of the output thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The dialog is small and fixed, so it is laid out in code instead of in a
+ *  .ui form.
+ */
+
+#include <QDialog>
+
+#include "play/outputstats.hpp"         /* seq66::outputstats               */
+
+class QLabel;
+class QTimer;
+
+namespace seq66
+{
+    class performer;
+
+class qsoutputstats final : public QDialog
+{
+    Q_OBJECT
+
+public:
+
+    qsoutputstats (performer & p, QWidget * parent = nullptr);
+    virtual ~qsoutputstats ();
+
+protected:
+
+    virtual void showEvent (QShowEvent *) override;
+    virtual void hideEvent (QHideEvent *) override;
+
+private slots:
+
+    void conditional_update ();
+    void slot_clear ();
+
+private:
+
+    QLabel * add_row (int row, const QString & name);
+
+private:
+
+    performer & m_performer;
+    QTimer * m_timer;
+    QLabel * m_frames;
+    QLabel * m_frame_time;
+    QLabel * m_events;
+    QLabel * m_late_max;
+    QLabel * m_underruns;
+    QLabel * m_lock_wait;
+    QLabel * m_buffer;
+    QLabel * m_pacing;
+    QLabel * m_gui_interval;
+    QLabel * m_lateness[outputstats::c_lateness_buckets];
+
+};             // class qsoutputstats
+
+}              // namespace seq66
+
+#endif         // SEQ66_QSOUTPUTSTATS_HPP
+
+/*
+ * qsoutputstats.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
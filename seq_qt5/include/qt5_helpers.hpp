@@ -28,11 +28,13 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-03-14
- * \updates       2025-01-23
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
 
+#include <vector>                       /* std::vector<>                    */
+
 #include "ctrl/keymap.hpp"              /* seq66::qt_modkey_ordinal()       */
 #include "ctrl/keystroke.hpp"           /* seq66::keystroke wrapper class   */
 
@@ -70,6 +72,7 @@ namespace seq66
 {
 
 class combolist;
+class editjob;
 
 /*
  *  Free constants in the seq66 namespace.  These values are simply visible
@@ -112,8 +115,10 @@ extern QTimer * qt_timer
     QObject * self,
     const std::string & name,
     int redraw_factor,
-    const char * slotname
+    const char * slotname,
+    bool periodic = false
 );
+extern bool qt_run_edit (QWidget * parent, editjob & job);
 extern void enable_combobox_item
 (
     QComboBox * box, int index, bool enabled = true
@@ -142,6 +147,11 @@ extern QAction * new_qaction (const std::string & text, QObject * parent);
 extern QMenu * new_qmenu (const std::string & text, QWidget * parent = nullptr);
 extern bool show_open_midi_file_dialog (QWidget * parent, std::string & file);
 extern bool show_import_midi_file_dialog (QWidget * parent, std::string & file);
+extern bool show_import_midi_files_dialog
+(
+    QWidget * parent,
+    std::vector<std::string> & files
+);
 extern bool show_select_project_dialog
 (
     QWidget * parent,
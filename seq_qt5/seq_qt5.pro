@@ -49,6 +49,13 @@ contains (CONFIG, rtmidi) {
    DEFINES += "SEQ66_PORTMIDI_SUPPORT=1"
 }
 
+# "qmake CONFIG+=opengl" builds the GPU rendering of the piano roll and
+# song editor; see qglroll.hpp and the 'usr' option "gpu-rendering".
+
+contains (CONFIG, opengl) {
+   DEFINES += "SEQ66_OPENGL_SUPPORT=1"
+}
+
 TARGET = seq_qt5
 
 # Target file directory:
@@ -89,6 +96,8 @@ HEADERS += include/gui_palette_qt5.hpp \
  include/qbase.hpp \
  include/qclocklayout.hpp \
  include/qeditbase.hpp \
+ include/qframeclock.hpp \
+ include/qglroll.hpp \
  include/qinputcheckbox.hpp \
  include/qlfoframe.hpp \
  include/qliveframeex.hpp \
@@ -100,6 +109,7 @@ HEADERS += include/gui_palette_qt5.hpp \
  include/qperfeditframe64.hpp \
  include/qperfnames.hpp \
  include/qperfroll.hpp \
+ include/qperfrows.hpp \
  include/qperftime.hpp \
  include/qplaylistframe.hpp \
  include/qportwidget.hpp \
@@ -123,10 +133,13 @@ HEADERS += include/gui_palette_qt5.hpp \
  include/qseventslots.hpp \
  include/qslivebase.hpp \
  include/qslivegrid.hpp \
+ include/qslivemodel.hpp \
  include/qslogview.hpp \
  include/qslotbutton.hpp \
  include/qsmaintime.hpp \
  include/qsmainwnd.hpp \
+ include/qsoutputstats.hpp \
+ include/qsinputmonitor.hpp \
  include/qstriggereditor.hpp \
  include/qt5_helper.h \
  include/qt5_helpers.hpp \
@@ -137,6 +150,8 @@ SOURCES += src/gui_palette_qt5.cpp \
  src/qbase.cpp \
  src/qclocklayout.cpp \
  src/qeditbase.cpp \
+ src/qframeclock.cpp \
+ src/qglroll.cpp \
  src/qinputcheckbox.cpp \
  src/qlfoframe.cpp \
  src/qliveframeex.cpp \
@@ -148,6 +163,7 @@ SOURCES += src/gui_palette_qt5.cpp \
  src/qperfeditframe64.cpp \
  src/qperfnames.cpp \
  src/qperfroll.cpp \
+ src/qperfrows.cpp \
  src/qperftime.cpp \
  src/qplaylistframe.cpp \
  src/qportwidget.cpp \
@@ -171,10 +187,13 @@ SOURCES += src/gui_palette_qt5.cpp \
  src/qseventslots.cpp \
  src/qslivebase.cpp \
  src/qslivegrid.cpp \
+ src/qslivemodel.cpp \
  src/qslogview.cpp \
  src/qslotbutton.cpp \
  src/qsmaintime.cpp \
  src/qsmainwnd.cpp \
+ src/qsoutputstats.cpp \
+ src/qsinputmonitor.cpp \
  src/qstriggereditor.cpp \
  src/qt5_helpers.cpp \
  src/qt5nsmanager.cpp
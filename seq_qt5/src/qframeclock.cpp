@@ -0,0 +1,422 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qframeclock.cpp
+ *
+ *  This module defines the single redraw clock shared by the Qt windows and
+ *  frames.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Qt offers no portable way to run a timer from the vertical retrace, so
+ *  the tick is simply made a whole number of refresh periods long, with a
+ *  precise timer, so that the views are woken in step with the display
+ *  rather than drifting across it.  A throttled tick stays a whole number
+ *  of refresh periods.
+ */
+
+#include <algorithm>                    /* std::find_if()                   */
+#include <cmath>                        /* std::lround()                    */
+#include <string>                       /* std::string, std::to_string()    */
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+#include <QWidget>
+
+#include "cfg/settings.hpp"             /* seq66::usr().window_redraw_rate()*/
+#include "play/sequence.hpp"            /* seq66::sequence::change_gen...() */
+#include "qframeclock.hpp"              /* seq66::qframeclock class         */
+#include "util/basic_macros.hpp"        /* seq66::info_message()            */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The heartbeat of idle views, in milliseconds.
+ */
+
+static const int c_heartbeat_ms = 500;
+
+/**
+ *  The governor's figures:  the interval between readings of the output
+ *  statistics, the longest tick it will throttle to (10 redraws a second),
+ *  the number of calm readings before it steps back by one period, and the
+ *  share of slow frames, in per-mille, that counts as a load.
+ */
+
+static const int c_govern_ms = 250;
+static const int c_slowest_tick_ms = 100;
+static const int c_calm_readings = 4;
+static const long c_slow_frames_permille = 20;
+
+/*
+ * The one frame clock.
+ */
+
+qframeclock * qframeclock::sm_instance = nullptr;
+
+/**
+ *  Creates and starts the clock, and registers it for the performer's
+ *  notifications.
+ */
+
+qframeclock::qframeclock (performer & p) :
+    performer::callbacks    (p),
+    m_timer                 (new QTimer()),
+    m_period_ms             (usr().window_redraw_rate()),
+    m_throttle              (1),
+    m_throttle_max          (1),
+    m_govern_ms             (0),
+    m_calm_readings         (0),
+    m_last_stats            (p.output_stats().get()),
+    m_heartbeat_ticks       (1),
+    m_tick                  (0),
+    m_notifications         (0),
+    m_clients               ()
+{
+    QScreen * screen = QGuiApplication::primaryScreen();
+    if (not_nullptr(screen))
+    {
+        double hz = screen->refreshRate();
+        if (hz >= 24.0)                         /* ignore bogus rates       */
+        {
+            double frame_ms = 1000.0 / hz;
+            long frames = std::lround(double(m_period_ms) / frame_ms);
+            if (frames < 1)
+                frames = 1;
+
+            m_period_ms = int(std::lround(double(frames) * frame_ms));
+        }
+    }
+    if (m_period_ms < 1)
+        m_period_ms = 1;
+
+    m_throttle_max = c_slowest_tick_ms / m_period_ms;
+    if (m_throttle_max < 1)
+        m_throttle_max = 1;
+
+    m_heartbeat_ticks = c_heartbeat_ms / m_period_ms;
+    if (m_heartbeat_ticks < 1)
+        m_heartbeat_ticks = 1;
+
+    sm_instance = this;
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(m_period_ms);
+    QObject::connect(m_timer, &QTimer::timeout, [this] () { tick(); });
+    m_timer->start();
+    cb_perf().enregister(this);
+}
+
+/**
+ *  The client timers belong to their views, some of which outlive the
+ *  clock, when the main window's children are deleted after it.  Their
+ *  removal then finds no instance, and does nothing.
+ */
+
+qframeclock::~qframeclock ()
+{
+    cb_perf().unregister(this);
+    sm_instance = nullptr;
+    m_timer->stop();
+    delete m_timer;
+}
+
+/**
+ *  Adds a view to the clock.  The timer is made single-shot, so that each
+ *  start() by the clock calls the view's slot once, at the next pass of the
+ *  event loop.  It is removed from the clock when it is destroyed.
+ *
+ * \param t
+ *      The view's timer, already connected to its slot.
+ *
+ * \param self
+ *      The view.  If it is a widget, it is not woken while hidden.
+ *
+ * \param redraw_factor
+ *      The view is due at every nth tick of the clock.
+ */
+
+void
+qframeclock::add (QTimer * t, QObject * self, int redraw_factor)
+{
+    if (not_nullptr(t))
+    {
+        client c;
+        c.fc_timer = t;
+        c.fc_widget = qobject_cast<QWidget *>(self);
+        c.fc_factor = redraw_factor > 0 ? redraw_factor : 1 ;
+        c.fc_generation = ~generation();        /* wake at the first tick   */
+        c.fc_last_tick = m_tick;
+        m_clients.push_back(c);
+        t->setSingleShot(true);
+        t->setInterval(0);
+        QObject::connect
+        (
+            t, &QObject::destroyed,
+            [t] ()
+            {
+                qframeclock * fc = qframeclock::instance();
+                if (not_nullptr(fc))
+                    fc->remove(t);
+            }
+        );
+    }
+}
+
+void
+qframeclock::remove (QTimer * t)
+{
+    auto it = std::find_if
+    (
+        m_clients.begin(), m_clients.end(),
+        [t] (const client & c) { return c.fc_timer == t; }
+    );
+    if (it != m_clients.end())
+        m_clients.erase(it);
+}
+
+/**
+ *  The sum of the counters of everything that can change what the views
+ *  show.  Only equality matters, so wrap-around does no harm, and no
+ *  pattern needs to be locked to read it.
+ */
+
+unsigned
+qframeclock::generation () const
+{
+    return m_notifications.load(std::memory_order_relaxed) +
+        sequence::change_generation() + cb_perf().update_generation();
+}
+
+/**
+ *  First hands on any notifications queued by the output or input threads,
+ *  as this is the GUI thread.  Then wakes the views that are due, shown,
+ *  and have something to show.  The generation is read before any view
+ *  runs, so that a change made while the views update is seen at the next
+ *  tick.
+ */
+
+void
+qframeclock::tick ()
+{
+    ++m_tick;
+    (void) cb_perf().deliver_notifications();
+    govern();
+
+    bool running = cb_perf().is_running();
+    unsigned gen = generation();
+    for (auto & c : m_clients)
+    {
+        if ((m_tick % unsigned(c.fc_factor)) != 0)
+            continue;
+
+        if (not_nullptr(c.fc_widget) && ! c.fc_widget->isVisible())
+            continue;
+
+        bool heartbeat = m_tick - c.fc_last_tick >=
+            unsigned(m_heartbeat_ticks);
+
+        if (! running && ! heartbeat && c.fc_generation == gen)
+            continue;
+
+        c.fc_generation = gen;
+        c.fc_last_tick = m_tick;
+        c.fc_timer->start();
+    }
+}
+
+/**
+ *  Reads the output statistics every c_govern_ms, and changes the tick
+ *  interval if the engine's load calls for it.  The reading takes only
+ *  the relaxed atomic counters, and no lock.  On a load, the throttle is
+ *  doubled at once; after c_calm_readings calm readings, it steps down by
+ *  one.
+ */
+
+void
+qframeclock::govern ()
+{
+    m_govern_ms += interval_ms();
+    if (m_govern_ms < c_govern_ms)
+        return;
+
+    m_govern_ms = 0;
+
+    outputstats::values v = cb_perf().output_stats().get();
+    bool loaded = engine_loaded(v);
+    m_last_stats = v;
+    if (loaded)
+    {
+        m_calm_readings = 0;
+        if (m_throttle < m_throttle_max)
+            set_throttle(m_throttle * 2);
+    }
+    else if (m_throttle > 1)
+    {
+        if (++m_calm_readings >= c_calm_readings)
+        {
+            m_calm_readings = 0;
+            set_throttle(m_throttle - 1);
+        }
+    }
+}
+
+/**
+ *  Compares a reading of the output statistics with the previous one.
+ *  The engine is loaded if there were underruns since then, or if enough
+ *  of the frames played since then fell into the histogram buckets that
+ *  start at half of the frame budget or more.  If the statistics were
+ *  cleared in the meantime, the counts go backward, and the reading is
+ *  taken as calm.
+ */
+
+bool
+qframeclock::engine_loaded (const outputstats::values & v) const
+{
+    long underruns = v.ov_underruns - m_last_stats.ov_underruns;
+    long frames = v.ov_frames - m_last_stats.ov_frames;
+    if (underruns < 0 || frames < 0)
+        return false;
+
+    if (underruns > 0)
+        return true;
+
+    if (frames == 0)
+        return false;
+
+    long half_budget = performer::frame_budget_us() / 2;
+    long slow = 0;
+    for (int b = 1; b < outputstats::c_lateness_buckets; ++b)
+    {
+        if (outputstats::bucket_limit_us(b - 1) >= half_budget)
+            slow += v.ov_frame_times[b] - m_last_stats.ov_frame_times[b];
+    }
+    return slow * 1000 > frames * c_slow_frames_permille;
+}
+
+/**
+ *  Changes the tick interval.  The heartbeat is kept at about the same
+ *  time in milliseconds.
+ */
+
+void
+qframeclock::set_throttle (int throttle)
+{
+    if (throttle > m_throttle_max)
+        throttle = m_throttle_max;
+    else if (throttle < 1)
+        throttle = 1;
+
+    if (throttle != m_throttle)
+    {
+        m_throttle = throttle;
+        m_heartbeat_ticks = c_heartbeat_ms / interval_ms();
+        if (m_heartbeat_ticks < 1)
+            m_heartbeat_ticks = 1;
+
+        m_timer->setInterval(interval_ms());
+        if (rc().investigate())
+        {
+            std::string msg = "GUI redraw interval ";
+            msg += std::to_string(interval_ms());
+            msg += " ms";
+            info_message("Frame clock", msg);
+        }
+    }
+}
+
+/*
+ *  The performer notifications.  They arrive on the GUI thread, but only
+ *  count, as the views will look for themselves.  They return false so as
+ *  not to claim the work from any other client.
+ */
+
+bool
+qframeclock::on_mutes_change (mutegroup::number, performer::change)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_set_change (screenset::number, performer::change)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_sequence_change (seq::number, performer::change)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_automation_change (automation::slot)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_ui_change (seq::number)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_trigger_change (seq::number, performer::change)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_resolution_change (int, midibpm, performer::change)
+{
+    notified();
+    return false;
+}
+
+bool
+qframeclock::on_song_action (bool, playlist::action)
+{
+    notified();
+    return false;
+}
+
+}           // namespace seq66
+
+/*
+ * qframeclock.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,970 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qglroll.cpp
+ *
+ *  This module defines the GPU (OpenGL) rendering of the piano roll and of
+ *  the song editor.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  See qglroll.hpp for the design.  The paint engine claims all features,
+ *  so that QPainter hands it the primitives as drawn, untransformed; the
+ *  engine applies the translation and the clipping.
+ */
+
+#include <QPaintEngine>
+#include <QPainter>
+#include <QTextItem>
+#include <QWidget>
+
+#include <algorithm>                    /* std::lower_bound(), std::max()   */
+#include <cmath>                        /* std::floor()                     */
+#include <cstring>                      /* std::memcmp()                    */
+#include <string>                       /* std::string, std::to_string()    */
+
+#include "cfg/settings.hpp"             /* seq66::usr().gpu_rendering()     */
+#include "qglroll.hpp"                  /* seq66::qglroll, qglrecorder      */
+
+#if defined SEQ66_OPENGL_SUPPORT
+#include <QOpenGLContext>
+#include <QOpenGLShaderProgram>
+#include <QSurfaceFormat>
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The paint engine of qglrecorder.  It tracks the pen, brush, transform,
+ *  and clip of the painter, and turns each primitive into rectangles.
+ */
+
+class qglpaintengine final : public QPaintEngine
+{
+
+private:
+
+    qglrecorder & m_recorder;
+    QPen m_pen;
+    QBrush m_brush;
+    QFont m_font;
+    QTransform m_transform;
+    QRectF m_clip;
+    bool m_clipping;
+
+public:
+
+    qglpaintengine (qglrecorder & rec) :
+        QPaintEngine    (QPaintEngine::AllFeatures),
+        m_recorder      (rec),
+        m_pen           (),
+        m_brush         (),
+        m_font          (),
+        m_transform     (),
+        m_clip          (),
+        m_clipping      (false)
+    {
+        // no code
+    }
+
+    virtual bool begin (QPaintDevice *) override
+    {
+        m_transform.reset();
+        m_clipping = false;
+        return true;
+    }
+
+    virtual bool end () override
+    {
+        return true;
+    }
+
+    virtual Type type () const override
+    {
+        return QPaintEngine::User;
+    }
+
+    virtual void updateState (const QPaintEngineState & state) override;
+    virtual void drawRects (const QRect * rects, int count) override;
+    virtual void drawRects (const QRectF * rects, int count) override;
+    virtual void drawLines (const QLine * lines, int count) override;
+    virtual void drawLines (const QLineF * lines, int count) override;
+    virtual void drawEllipse (const QRectF & r) override;
+    virtual void drawEllipse (const QRect & r) override;
+    virtual void drawPath (const QPainterPath & path) override;
+    virtual void drawPolygon
+    (
+        const QPointF * points, int count, PolygonDrawMode mode
+    ) override;
+    virtual void drawPolygon
+    (
+        const QPoint * points, int count, PolygonDrawMode mode
+    ) override;
+    virtual void drawPixmap
+    (
+        const QRectF &, const QPixmap &, const QRectF &
+    ) override
+    {
+        // pixmaps are not used by the rolls
+    }
+    virtual void drawTextItem (const QPointF & p, const QTextItem & ti)
+        override;
+
+private:
+
+    void fill (const QRectF & r, const QColor & c);
+    void fill_rect (const QRectF & r);
+    void stroke_rect (const QRectF & r);
+    void stroke_line (const QLineF & line);
+
+    bool has_pen () const
+    {
+        return m_pen.style() != Qt::NoPen;
+    }
+
+    bool has_brush () const
+    {
+        return m_brush.style() != Qt::NoBrush;
+    }
+
+    qreal pen_width () const
+    {
+        qreal w = m_pen.widthF();
+        return w < 1.0 ? 1.0 : w ;      /* a cosmetic pen is one pixel      */
+    }
+
+    QColor pen_color () const;
+    QColor brush_color () const;
+
+};          // class qglpaintengine
+
+/**
+ *  Takes the parts of the painter's state that matter.  The clip is in the
+ *  painter coordinates in force when it is set.
+ */
+
+void
+qglpaintengine::updateState (const QPaintEngineState & state)
+{
+    QPaintEngine::DirtyFlags flags = state.state();
+    if (flags & QPaintEngine::DirtyPen)
+        m_pen = state.pen();
+
+    if (flags & QPaintEngine::DirtyBrush)
+        m_brush = state.brush();
+
+    if (flags & QPaintEngine::DirtyFont)
+        m_font = state.font();
+
+    if (flags & QPaintEngine::DirtyTransform)
+        m_transform = state.transform();
+
+    if (flags & (QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath))
+    {
+        QRectF c = flags & QPaintEngine::DirtyClipPath ?
+            state.clipPath().boundingRect() :
+            QRectF(state.clipRegion().boundingRect()) ;
+
+        c = m_transform.mapRect(c);
+        switch (state.clipOperation())
+        {
+        case Qt::NoClip:
+            m_clipping = false;
+            break;
+
+        case Qt::IntersectClip:
+            m_clip = m_clipping ? (m_clip & c) : c ;
+            m_clipping = true;
+            break;
+
+        default:
+            m_clip = c;
+            m_clipping = true;
+            break;
+        }
+    }
+    if (flags & QPaintEngine::DirtyClipEnabled)
+        m_clipping = state.isClipEnabled() && m_clipping;
+}
+
+/**
+ *  A gradient is drawn in the color of its middle stop.
+ */
+
+QColor
+qglpaintengine::brush_color () const
+{
+    const QGradient * g = m_brush.gradient();
+    if (g != nullptr)
+    {
+        QGradientStops stops = g->stops();
+        if (! stops.isEmpty())
+            return stops[stops.size() / 2].second;
+    }
+    return m_brush.color();
+}
+
+/**
+ *  A dotted or dashed pen is drawn solid, but fainter.
+ */
+
+QColor
+qglpaintengine::pen_color () const
+{
+    QColor c = m_pen.color();
+    if (m_pen.style() != Qt::SolidLine)
+        c.setAlpha(c.alpha() / 2);
+
+    return c;
+}
+
+/**
+ *  Adds a rectangle given in painter coordinates, transformed and clipped.
+ */
+
+void
+qglpaintengine::fill (const QRectF & r, const QColor & c)
+{
+    if (c.alpha() == 0)
+        return;
+
+    QRectF m = m_transform.mapRect(r);
+    if (m_clipping)
+        m = m & m_clip;
+
+    if (! m.isEmpty())
+        m_recorder.add_rect(m, c);
+}
+
+void
+qglpaintengine::fill_rect (const QRectF & r)
+{
+    if (has_brush())
+        fill(r, brush_color());
+}
+
+/**
+ *  Draws the outline of a rectangle as four rectangles, covering the same
+ *  pixels as the raster engine does for a one-pixel pen.
+ */
+
+void
+qglpaintengine::stroke_rect (const QRectF & r)
+{
+    if (! has_pen())
+        return;
+
+    QColor c = pen_color();
+    qreal pw = pen_width();
+    qreal o = std::floor((pw - 1.0) / 2.0);
+    qreal x = r.x() - o;
+    qreal y = r.y() - o;
+    qreal w = r.width() + pw;
+    qreal h = r.height() + pw;
+    fill(QRectF(x, y, w, pw), c);                       /* top              */
+    fill(QRectF(x, y + h - pw, w, pw), c);              /* bottom           */
+    fill(QRectF(x, y + pw, pw, h - 2 * pw), c);         /* left             */
+    fill(QRectF(x + w - pw, y + pw, pw, h - 2 * pw), c); /* right           */
+}
+
+/**
+ *  Horizontal and vertical lines are exact.  A slanted line is drawn as
+ *  its bounding rectangle; the rolls use them only for small marks.
+ */
+
+void
+qglpaintengine::stroke_line (const QLineF & line)
+{
+    if (! has_pen())
+        return;
+
+    qreal pw = pen_width();
+    qreal o = std::floor((pw - 1.0) / 2.0);
+    qreal x0 = std::min(line.x1(), line.x2());
+    qreal y0 = std::min(line.y1(), line.y2());
+    qreal w = std::abs(line.dx());
+    qreal h = std::abs(line.dy());
+    fill(QRectF(x0 - o, y0 - o, w + pw, h + pw), pen_color());
+}
+
+void
+qglpaintengine::drawRects (const QRect * rects, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        fill_rect(QRectF(rects[i]));
+        stroke_rect(QRectF(rects[i]));
+    }
+}
+
+void
+qglpaintengine::drawRects (const QRectF * rects, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        fill_rect(rects[i]);
+        stroke_rect(rects[i]);
+    }
+}
+
+void
+qglpaintengine::drawLines (const QLine * lines, int count)
+{
+    for (int i = 0; i < count; ++i)
+        stroke_line(QLineF(lines[i]));
+}
+
+void
+qglpaintengine::drawLines (const QLineF * lines, int count)
+{
+    for (int i = 0; i < count; ++i)
+        stroke_line(lines[i]);
+}
+
+/**
+ *  An ellipse (e.g. a tempo dot) is drawn as a filled rectangle, in the
+ *  brush color, or else the pen color.
+ */
+
+void
+qglpaintengine::drawEllipse (const QRectF & r)
+{
+    if (has_brush())
+        fill(r, brush_color());
+    else if (has_pen())
+        fill(r, pen_color());
+}
+
+void
+qglpaintengine::drawEllipse (const QRect & r)
+{
+    drawEllipse(QRectF(r));
+}
+
+void
+qglpaintengine::drawPath (const QPainterPath & path)
+{
+    QRectF r = path.boundingRect();
+    fill_rect(r);
+    stroke_rect(r);
+}
+
+/**
+ *  A polyline is drawn segment by segment; a filled polygon (e.g. a drum
+ *  note) as its bounding rectangle.
+ */
+
+void
+qglpaintengine::drawPolygon
+(
+    const QPointF * points, int count, PolygonDrawMode mode
+)
+{
+    if (count < 2)
+        return;
+
+    if (mode == QPaintEngine::PolylineMode)
+    {
+        for (int i = 1; i < count; ++i)
+            stroke_line(QLineF(points[i - 1], points[i]));
+    }
+    else
+    {
+        QPolygonF poly;
+        for (int i = 0; i < count; ++i)
+            poly << points[i];
+
+        QRectF r = poly.boundingRect();
+        fill_rect(r);
+        stroke_rect(r);
+    }
+}
+
+void
+qglpaintengine::drawPolygon
+(
+    const QPoint * points, int count, PolygonDrawMode mode
+)
+{
+    std::vector<QPointF> pf;
+    pf.reserve(std::size_t(count));
+    for (int i = 0; i < count; ++i)
+        pf.push_back(QPointF(points[i]));
+
+    drawPolygon(pf.data(), count, mode);
+}
+
+void
+qglpaintengine::drawTextItem (const QPointF & p, const QTextItem & ti)
+{
+    m_recorder.add_text
+    (
+        m_transform.map(p), ti.text(), ti.font(), m_pen.color()
+    );
+}
+
+/*
+ *  The recorder.
+ */
+
+qglrecorder::qglrecorder (const QWidget * host, const QRect & area) :
+    QPaintDevice    (),
+    m_host          (host),
+    m_area          (area),
+    m_rects         (),
+    m_texts         (),
+    m_engine        (new qglpaintengine(*this))
+{
+    // no code
+}
+
+qglrecorder::~qglrecorder ()
+{
+    // the engine is deleted with the recorder
+}
+
+/**
+ *  Empties the recorder for a new drawing, keeping its storage.
+ */
+
+void
+qglrecorder::clear (const QRect & area)
+{
+    m_area = area;
+    m_rects.clear();
+    m_texts.clear();
+}
+
+QPaintEngine *
+qglrecorder::paintEngine () const
+{
+    return m_engine.get();
+}
+
+/**
+ *  The metrics are those of the host widget, so that fonts are sized as
+ *  they are when painting the widget itself.
+ */
+
+int
+qglrecorder::metric (PaintDeviceMetric m) const
+{
+    switch (m)
+    {
+    case PdmWidth:              return m_host->width();
+    case PdmHeight:             return m_host->height();
+    case PdmWidthMM:            return m_host->widthMM();
+    case PdmHeightMM:           return m_host->heightMM();
+    case PdmNumColors:          return m_host->colorCount();
+    case PdmDepth:              return m_host->depth();
+    case PdmDpiX:               return m_host->logicalDpiX();
+    case PdmDpiY:               return m_host->logicalDpiY();
+    case PdmPhysicalDpiX:       return m_host->physicalDpiX();
+    case PdmPhysicalDpiY:       return m_host->physicalDpiY();
+    default:                    return QPaintDevice::metric(m);
+    }
+}
+
+/**
+ *  Keeps a rectangle that touches the area.
+ */
+
+void
+qglrecorder::add_rect (const QRectF & r, const QColor & c)
+{
+    if (r.intersects(QRectF(m_area)))
+    {
+        glrect g;
+        g.gr_x = float(r.x());
+        g.gr_y = float(r.y());
+        g.gr_w = float(r.width());
+        g.gr_h = float(r.height());
+        g.gr_rgba[0] = static_cast<unsigned char>(c.red());
+        g.gr_rgba[1] = static_cast<unsigned char>(c.green());
+        g.gr_rgba[2] = static_cast<unsigned char>(c.blue());
+        g.gr_rgba[3] = static_cast<unsigned char>(c.alpha());
+        m_rects.push_back(g);
+    }
+}
+
+void
+qglrecorder::add_text
+(
+    const QPointF & p, const QString & s,
+    const QFont & f, const QColor & c
+)
+{
+    if (m_area.contains(p.toPoint()))
+        m_texts.push_back(gltext{p, s, f, c});
+}
+
+#if defined SEQ66_OPENGL_SUPPORT
+
+/**
+ *  The instance buffer is grown by doubling, from this size.
+ */
+
+static const std::size_t c_min_capacity = 1024;
+
+/**
+ *  The shaders.  Each instance is a rectangle; the four corners of the unit
+ *  quad are scaled to it and moved to the view, whose origin is the top-left
+ *  of the widget's place in the roll.
+ */
+
+static const char * const s_vertex_shader =
+    "in vec2 a_corner;\n"
+    "in vec4 a_rect;\n"
+    "in vec4 a_color;\n"
+    "uniform vec2 u_origin;\n"
+    "uniform vec2 u_size;\n"
+    "out vec4 v_color;\n"
+    "void main ()\n"
+    "{\n"
+    "    vec2 p = a_rect.xy + a_corner * a_rect.zw - u_origin;\n"
+    "    vec2 ndc = p / u_size * 2.0 - 1.0;\n"
+    "    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);\n"
+    "    v_color = a_color;\n"
+    "}\n"
+    ;
+
+static const char * const s_fragment_shader =
+    "in vec4 v_color;\n"
+    "out vec4 o_color;\n"
+    "void main ()\n"
+    "{\n"
+    "    o_color = v_color;\n"
+    "}\n"
+    ;
+
+/**
+ *  Creates the widget over the host, asking for an OpenGL 3.3 core context.
+ *  On OpenGL ES, the request is ignored and a 3.0 context is checked for in
+ *  initializeGL().
+ */
+
+qglroll::qglroll (QWidget * host) :
+    QOpenGLWidget       (host),
+    QOpenGLExtraFunctions (),
+    m_layers            (),
+    m_instances         (),
+    m_dirty_lo          (0),
+    m_dirty_hi          (0),
+    m_capacity          (0),
+    m_program           (),
+    m_vao               (),
+    m_quad              (QOpenGLBuffer::VertexBuffer),
+    m_instance_buffer   (QOpenGLBuffer::VertexBuffer),
+    m_origin_location   (-1),
+    m_size_location     (-1),
+    m_failed            (false),
+    m_clear_color       (host->palette().color(QPalette::Base))
+{
+    QSurfaceFormat fmt = format();
+    fmt.setVersion(3, 3);
+    fmt.setProfile(QSurfaceFormat::CoreProfile);
+    setFormat(fmt);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+    setGeometry(0, 0, 1, 1);
+    lower();                            /* tool-tips go over the GL view    */
+    show();
+}
+
+/**
+ *  The GPU objects need the context to be current to be released.
+ */
+
+qglroll::~qglroll ()
+{
+    release_gl();
+}
+
+/**
+ * \return
+ *      Returns a new qglroll over the host if "gpu-rendering" is set, or
+ *      a null pointer.  The host owns it, as its Qt child.
+ */
+
+qglroll *
+qglroll::make (QWidget * host)
+{
+    return usr().gpu_rendering() ? new qglroll(host) : nullptr ;
+}
+
+void
+qglroll::release_gl ()
+{
+    if (context() != nullptr)
+    {
+        makeCurrent();
+        m_program.reset();
+        if (m_instance_buffer.isCreated())
+            m_instance_buffer.destroy();
+
+        if (m_quad.isCreated())
+            m_quad.destroy();
+
+        if (m_vao.isCreated())
+            m_vao.destroy();
+
+        doneCurrent();
+    }
+}
+
+/**
+ *  Places the widget over an area of the host.  The rectangles stay in host
+ *  coordinates; only the origin of the view moves, so that scrolling within
+ *  the recorded area uploads nothing.
+ */
+
+void
+qglroll::set_view (const QRect & area)
+{
+    if (area != geometry())
+    {
+        setGeometry(area);
+        update();
+    }
+}
+
+std::vector<qglroll::layer>::iterator
+qglroll::find_layer (int key)
+{
+    return std::lower_bound
+    (
+        m_layers.begin(), m_layers.end(), key,
+        [] (const layer & ly, int k)
+        {
+            return ly.ly_key < k;
+        }
+    );
+}
+
+void
+qglroll::mark_dirty (std::size_t lo, std::size_t hi)
+{
+    if (m_dirty_hi <= m_dirty_lo)
+    {
+        m_dirty_lo = lo;
+        m_dirty_hi = hi;
+    }
+    else
+    {
+        m_dirty_lo = std::min(m_dirty_lo, lo);
+        m_dirty_hi = std::max(m_dirty_hi, hi);
+    }
+}
+
+/**
+ *  Replaces the rectangles and texts of a layer.  If the layer keeps its
+ *  number of rectangles, only the span from the first to the last changed
+ *  one is marked for upload; otherwise the rest of the instances move, and
+ *  are uploaded from the start of the layer on.
+ */
+
+void
+qglroll::set_layer (int key, const qglrecorder & rec)
+{
+    auto it = find_layer(key);
+    if (it == m_layers.end() || it->ly_key != key)
+    {
+        std::size_t start = it == m_layers.end() ?
+            m_instances.size() : it->ly_start ;
+
+        it = m_layers.insert(it, layer{key, start, 0, {}});
+    }
+
+    const std::vector<glrect> & rs = rec.rects();
+    std::size_t start = it->ly_start;
+    std::size_t n = rs.size();
+    it->ly_texts = rec.texts();
+    if (n == it->ly_count)
+    {
+        const glrect * old = m_instances.data() + start;
+        std::size_t lo = 0;
+        while (lo < n && std::memcmp(&old[lo], &rs[lo], sizeof(glrect)) == 0)
+            ++lo;
+
+        std::size_t hi = n;
+        while (hi > lo)
+        {
+            if (std::memcmp(&old[hi - 1], &rs[hi - 1], sizeof(glrect)) != 0)
+                break;
+
+            --hi;
+        }
+
+        if (hi > lo)
+        {
+            std::copy
+            (
+                rs.begin() + lo, rs.begin() + hi,
+                m_instances.begin() + start + lo
+            );
+            mark_dirty(start + lo, start + hi);
+        }
+    }
+    else
+    {
+        auto first = m_instances.begin() + start;
+        m_instances.erase(first, first + it->ly_count);
+        m_instances.insert(m_instances.begin() + start, rs.begin(), rs.end());
+        for (auto next = it + 1; next != m_layers.end(); ++next)
+            next->ly_start = next->ly_start - it->ly_count + n;
+
+        it->ly_count = n;
+        mark_dirty(start, m_instances.size());
+    }
+    update();
+}
+
+void
+qglroll::clear_layer (int key)
+{
+    qglrecorder empty(this, QRect());
+    auto it = find_layer(key);
+    if (it != m_layers.end() && it->ly_key == key)
+        set_layer(key, empty);
+}
+
+/**
+ *  Builds the GPU objects.  The instance buffer holds the glrect structures
+ *  as they are:  four floats for the rectangle, and four normalized bytes
+ *  for the color.
+ */
+
+void
+qglroll::initializeGL ()
+{
+    initializeOpenGLFunctions();
+
+    QOpenGLContext * ctx = context();
+    QSurfaceFormat f = ctx->format();
+    int version = f.majorVersion() * 10 + f.minorVersion();
+    bool es = ctx->isOpenGLES();
+    m_failed = es ? version < 30 : version < 33 ;
+    if (m_failed)
+    {
+        std::string msg = "OpenGL " + std::to_string(f.majorVersion()) +
+            "." + std::to_string(f.minorVersion()) + " too old, using raster";
+
+        warnprint(msg);
+        return;
+    }
+    if (! build_program())
+    {
+        m_failed = true;
+        return;
+    }
+
+    static const GLfloat s_corners [] =
+    {
+        0.0f, 0.0f,  1.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f
+    };
+    m_vao.create();
+    QOpenGLVertexArrayObject::Binder vaobinder(&m_vao);
+    m_quad.create();
+    m_quad.bind();
+    m_quad.allocate(s_corners, int(sizeof s_corners));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    m_quad.release();
+
+    GLsizei stride = GLsizei(sizeof(glrect));
+    m_capacity = std::max(c_min_capacity, m_instances.size());
+    m_instance_buffer.create();
+    m_instance_buffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    m_instance_buffer.bind();
+    m_instance_buffer.allocate(int(m_capacity * sizeof(glrect)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, nullptr);
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer
+    (
+        2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+        reinterpret_cast<const void *>(4 * sizeof(GLfloat))
+    );
+    glVertexAttribDivisor(2, 1);
+    m_instance_buffer.release();
+    mark_dirty(0, m_instances.size());  /* a new context has no instances  */
+}
+
+bool
+qglroll::build_program ()
+{
+    QByteArray header = context()->isOpenGLES() ?
+        "#version 300 es\nprecision mediump float;\n" : "#version 330 core\n" ;
+
+    m_program.reset(new QOpenGLShaderProgram);
+    bool result = m_program->addShaderFromSourceCode
+    (
+        QOpenGLShader::Vertex, header + s_vertex_shader
+    );
+    if (result)
+    {
+        result = m_program->addShaderFromSourceCode
+        (
+            QOpenGLShader::Fragment, header + s_fragment_shader
+        );
+    }
+    if (result)
+    {
+        m_program->bindAttributeLocation("a_corner", 0);
+        m_program->bindAttributeLocation("a_rect", 1);
+        m_program->bindAttributeLocation("a_color", 2);
+        result = m_program->link();
+    }
+    if (result)
+    {
+        m_origin_location = m_program->uniformLocation("u_origin");
+        m_size_location = m_program->uniformLocation("u_size");
+    }
+    else
+    {
+        std::string log = m_program->log().toStdString();
+        errprintf("OpenGL shaders: %s", log.c_str());
+        m_program.reset();
+    }
+    return result;
+}
+
+/**
+ *  Uploads the span of instances that changed, growing the buffer first if
+ *  they no longer fit.
+ */
+
+void
+qglroll::upload_instances ()
+{
+    if (m_dirty_hi <= m_dirty_lo)
+        return;
+
+    m_instance_buffer.bind();
+    if (m_instances.size() > m_capacity)
+    {
+        while (m_capacity < m_instances.size())
+            m_capacity *= 2;
+
+        m_instance_buffer.allocate(int(m_capacity * sizeof(glrect)));
+        m_dirty_lo = 0;
+        m_dirty_hi = m_instances.size();
+    }
+    if (m_dirty_hi > m_instances.size())
+        m_dirty_hi = m_instances.size();
+
+    if (m_dirty_hi > m_dirty_lo)
+    {
+        m_instance_buffer.write
+        (
+            int(m_dirty_lo * sizeof(glrect)), &m_instances[m_dirty_lo],
+            int((m_dirty_hi - m_dirty_lo) * sizeof(glrect))
+        );
+    }
+    m_instance_buffer.release();
+    m_dirty_lo = m_dirty_hi = 0;
+}
+
+/**
+ *  Draws all of the rectangles in one instanced call, then the texts.
+ */
+
+void
+qglroll::paintGL ()
+{
+    glClearColor
+    (
+        GLfloat(m_clear_color.redF()), GLfloat(m_clear_color.greenF()),
+        GLfloat(m_clear_color.blueF()), 1.0f
+    );
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (m_failed || ! m_program)
+        return;
+
+    upload_instances();
+    if (! m_instances.empty())
+    {
+        QPointF origin = geometry().topLeft();
+        m_program->bind();
+        m_program->setUniformValue
+        (
+            m_origin_location, GLfloat(origin.x()), GLfloat(origin.y())
+        );
+        m_program->setUniformValue
+        (
+            m_size_location, GLfloat(width()), GLfloat(height())
+        );
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        {
+            QOpenGLVertexArrayObject::Binder vaobinder(&m_vao);
+            glDrawArraysInstanced
+            (
+                GL_TRIANGLE_STRIP, 0, 4, GLsizei(m_instances.size())
+            );
+        }
+        glDisable(GL_BLEND);
+        m_program->release();
+    }
+
+    bool texts = false;
+    for (const auto & ly : m_layers)
+    {
+        if (! ly.ly_texts.empty())
+        {
+            texts = true;
+            break;
+        }
+    }
+    if (texts)
+    {
+        QPainter painter(this);
+        painter.translate(-geometry().topLeft());
+        for (const auto & ly : m_layers)
+        {
+            for (const auto & t : ly.ly_texts)
+            {
+                painter.setFont(t.gt_font);
+                painter.setPen(t.gt_color);
+                painter.drawText(t.gt_point, t.gt_text);
+            }
+        }
+    }
+}
+
+#endif      // defined SEQ66_OPENGL_SUPPORT
+
+}           // namespace seq66
+
+/*
+ * qglroll.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
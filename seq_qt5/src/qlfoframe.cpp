@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2022-05-15
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The LFO (low-frequency oscillator) provides a way to modulate the
@@ -112,6 +112,7 @@ qlfoframe::qlfoframe
 {
     ui->setupUi(this);
     connect(ui->m_button_reset, SIGNAL(clicked()), this, SLOT(reset()));
+    connect(ui->m_button_lane, SIGNAL(clicked()), this, SLOT(add_lane()));
     connect(ui->m_button_close, SIGNAL(clicked()), this, SLOT(close()));
 
     /*
@@ -327,7 +328,9 @@ qlfoframe::wave_type_change (int waveid)
 
 /**
  *  Changes the scaling provided by this window.  Changes take place right
- *  away in this callback, and would require multiple undoes to fully undo.
+ *  away in this callback.  Only the first change after opening or a reset
+ *  pushes an undo, so that one undo reverts a whole session of slider
+ *  moves.  The later moves are previews, announced when the window closes.
  */
 
 void
@@ -340,7 +343,7 @@ qlfoframe::scale_lfo_change ()
     track().change_event_data_lfo
     (
         m_value, m_range, m_speed, m_phase, m_wave,
-        m_seqdata.status(), m_seqdata.cc(), m_use_measure
+        m_seqdata.status(), m_seqdata.cc(), m_use_measure, ! m_is_modified
     );
     m_seqdata.set_dirty();
 
@@ -376,6 +379,44 @@ qlfoframe::reset ()
     m_is_modified = false;
 }
 
+/**
+ *  Turns the current settings into a modulation lane, which the pattern
+ *  generates while it plays, and puts back the original events, so that
+ *  the lane alone does the modulating.  The lane repeats over the pattern
+ *  length, so a per-measure speed is converted to periods per pattern.
+ */
+
+void
+qlfoframe::add_lane ()
+{
+    double speed = m_speed;
+    if (m_use_measure)
+    {
+        midipulse measure = track().measures_to_ticks();
+        if (measure > 0)
+            speed *= double(track().get_length()) / double(measure);
+    }
+
+    midibyte status = m_seqdata.status();
+    midibyte channel = track().seq_midi_channel();
+    if (! is_null_channel(channel))
+        status = event::mask_status(status) | channel;
+
+    modlane ml
+    (
+        status, m_seqdata.cc(), m_wave, m_value, m_range, speed, m_phase
+    );
+    bool room = int(track().mod_lanes().size()) < modlane::c_lanes_max;
+    if (ml.valid() && room)
+    {
+        if (m_is_modified)
+            reset();
+
+        if (track().add_mod_lane(ml, true))
+            perf().modify();
+    }
+}
+
 void
 qlfoframe::closeEvent (QCloseEvent * event)
 {
@@ -383,7 +424,10 @@ qlfoframe::closeEvent (QCloseEvent * event)
         m_edit_frame->remove_lfo_frame();
 
     if (m_is_modified)
+    {
+        track().modify();                   /* announce the previewed edits */
         perf().modify();
+    }
 
     event->accept();
 }
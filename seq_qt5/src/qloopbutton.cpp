@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-28
- * \updates       2024-11-16
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  A paint event is a request to repaint all/part of a widget. It happens for
@@ -180,6 +180,14 @@ qloopbutton::qloopbutton
     m_fingerprint_count     (m_fingerprint_size),
     m_note_min              (usr().progress_note_min()),
     m_note_max              (usr().progress_note_max()),
+    m_thumbnail_valid       (false),
+    m_thumbnail_serial      (0),
+    m_thumbnail_box         (),
+    m_thumbnail_notes       (),
+    m_thumbnail_tempos      (),
+    m_thumbnail_programs    (),
+    m_face_generation       (0),
+    m_face_status           (0),
     m_seq                   (seqp),                 /* loop()               */
     m_is_checked            (loop()->armed()),
     m_prog_thickness        (usr().progress_bar_thick() ? 2 : 1),
@@ -373,19 +381,19 @@ qloopbutton::initialize_text ()
  */
 
 void
-qloopbutton::initialize_fingerprint ()
+qloopbutton::initialize_fingerprint (const qslivemodel::item & it)
 {
     const int i1 = int(m_fingerprint_size);
     if (! m_fingerprint_inited && i1 > 0)
     {
         int n0, n1;
-        bool have_notes = loop()->minmax_notes(n0, n1); /* fill n0 and n1   */
+        bool have_notes = it.minmax_notes(n0, n1);      /* fill n0 and n1   */
         if (have_notes)
-            have_notes = loop()->event_threshold();
+            have_notes = it.event_threshold();
 
         if (have_notes)
         {
-            midipulse t1 = loop()->get_length();        /* t0 = 0           */
+            midipulse t1 = it.length();                 /* t0 = 0           */
             if (t1 == 0)
                 return;
 
@@ -414,14 +422,9 @@ qloopbutton::initialize_fingerprint ()
                 m_fingerprint[i] = m_fingerprint_count[i] = 0;
 
             int nh = n1 - n0;
-            loop()->draw_lock();
-            for (auto cev = loop()->cbegin(); ! loop()->cend(cev); ++cev)
+            for (const auto & m : it.marks())
             {
-                sequence::note_info ni;
-                sequence::draw dt = loop()->get_next_note(ni, cev);
-                if (dt == sequence::draw::finish)
-                    break;
-
+                const sequence::note_info & ni = m.m_info;
                 int x = x0 + (ni.start() * xw) / t1;
                 int y = y0 + yh * (ni.note() - n0) / nh;
                 int i = i1 * (x - x0) / xw;
@@ -438,7 +441,6 @@ qloopbutton::initialize_fingerprint ()
                 else
                     m_fingerprint[i] = midishort(y);
             }
-            loop()->draw_unlock();
             for (int i = 0; i < i1; ++i)
             {
                 if (m_fingerprint_count[i] > 1)
@@ -509,6 +511,36 @@ qloopbutton::toggle_checked ()
     return result;
 }
 
+/**
+ *  Tells if anything shown on the button, other than the progress bar, may
+ *  have changed since the last call.  Edits, and most status changes, bump
+ *  the pattern's redraw generation; the status bits, read once per frame
+ *  by the shared live model, catch the rest, such as the recording
+ *  indicator.  The live grid uses this to repaint only the progress box of
+ *  the buttons whose faces are unchanged.  An edit that covers only a
+ *  region of the pattern (see sequence::dirty_region()) changes only the
+ *  thumbnail in the progress box, so it leaves the face unchanged.
+ */
+
+bool
+qloopbutton::face_changed ()
+{
+    if (! loop())
+        return true;
+
+    unsigned generation = loop()->redraw_generation();
+    unsigned status = model().status();         /* read once per frame  */
+    bool result = status != m_face_status;
+    if (generation != m_face_generation)
+    {
+        sequence::region r;
+        if (! loop()->dirty_region(m_face_generation, r))   /* updates it   */
+            result = true;
+    }
+    m_face_status = status;
+    return result;
+}
+
 /**
  *  Call the update() function of this button.
  *
@@ -569,7 +601,8 @@ qloopbutton::paintEvent (QPaintEvent * pev)
     QPainter painter(this);
     if (loop())
     {
-        midipulse tick = loop()->get_last_tick();
+        const qslivemodel::item & it = model();
+        midipulse tick = it.tick();
         if (initialize_text() || tick == 0)
         {
             QRectF box
@@ -681,15 +714,14 @@ qloopbutton::paintEvent (QPaintEvent * pev)
                 );
                 painter.drawText(box, m_top_left.m_flags, title);
             }
-            initialize_fingerprint();
         }
         if (sm_draw_progress_box)
-            draw_progress_box(painter);
+            draw_progress_box(painter, it);
 
-        draw_pattern(painter);
+        draw_pattern(painter, it);
 
-        bool tiny = ! (loop()->is_playable() && loop()->armed());
-        draw_progress(painter, tick, tiny);
+        bool tiny = ! (loop()->is_playable() && it.armed());
+        draw_progress(painter, it, tiny);
     }
     else
     {
@@ -713,11 +745,12 @@ void
 qloopbutton::draw_progress
 (
     QPainter & painter,
-    midipulse tick,
+    const qslivemodel::item & it,
     bool tiny
 )
 {
-    midipulse t1 = loop()->get_length();
+    midipulse tick = it.tick();
+    midipulse t1 = it.length();
     if (t1 > 0)
     {
         QBrush brush(m_prog_back_color, Qt::SolidPattern);
@@ -754,12 +787,16 @@ qloopbutton::draw_progress
  */
 
 void
-qloopbutton::draw_progress_box (QPainter & painter)
+qloopbutton::draw_progress_box
+(
+    QPainter & painter,
+    const qslivemodel::item & it
+)
 {
     QBrush brush(m_prog_back_color, Qt::SolidPattern);
     QPen pen(pen_color());                          /* #50: text_color()    */
     const int penwidth = m_prog_thickness;          /* 2 */
-    bool qsnap = loop()->snap_it();
+    bool qsnap = it.snap_it();
     Color backcolor = back_color();
     if (qsnap)                                      /* playing, queued, ... */
     {
@@ -767,17 +804,17 @@ qloopbutton::draw_progress_box (QPainter & painter)
         pen.setColor(Qt::gray);                     /* instead of Qt::black */
         pen.setStyle(Qt::SolidLine);
     }
-    else if (loop()->armed())                       /* armed, playing       */
+    else if (it.armed())                            /* armed, playing       */
     {
         backcolor.setAlpha(s_alpha_playing);
     }
-    else if (loop()->get_queued())
+    else if (it.queued())
     {
         backcolor = Qt::gray;
         backcolor.setAlpha(s_alpha_queued);
         pen.setStyle(Qt::SolidLine);
     }
-    else if (loop()->one_shot())                    /* one-shot queued      */
+    else if (it.one_shot())                         /* one-shot queued      */
     {
         backcolor = Qt::black;
         backcolor.setAlpha(s_alpha_oneshot);
@@ -859,20 +896,24 @@ qloopbutton::draw_progress_box (QPainter & painter)
  *          number of measures is greater than 4.  We don't need to draw the
  *          whole set of notes.  Instead, we draw the calculated finger print.
  *      -   Otherwise, the sequence is short and we draw it normally.
+ *
+ *  Either way, the drawing comes from the thumbnail cache, which is rebuilt
+ *  only when the pattern has changed.  See build_thumbnail().
  */
 
 void
-qloopbutton::draw_pattern (QPainter & painter)
+qloopbutton::draw_pattern (QPainter & painter, const qslivemodel::item & it)
 {
-    midipulse t1 = loop()->get_length();
-    if (loop()->event_count() > 0 && t1 > 0)
+    if (thumbnail_stale(it))
+        build_thumbnail(it);
+
+    midipulse t1 = it.length();
+    if (! it.marks().empty() && t1 > 0)
     {
         QBrush brush(m_prog_back_color, Qt::SolidPattern);
         QPen pen(text_color());
         int x0 = m_event_box.x();
-        int y0 = m_event_box.y();
         int xw = m_event_box.w();
-        int yh = m_event_box.h();
         if (m_fingerprinted)
         {
             if (loop()->transposable())
@@ -893,34 +934,6 @@ qloopbutton::draw_pattern (QPainter & painter)
         }
         else
         {
-            int height = max_midi_value();
-            int n0, n1;
-            if (m_note_max > 0)
-            {
-                n0 = m_note_min;
-                n1 = m_note_max;
-            }
-            else
-            {
-                bool have_notes = loop()->minmax_notes(n0, n1);
-                if (have_notes)
-                {
-                    /*
-                     * Added an octave of padding above and below for looks.
-                     */
-
-                    n0 -= 12;
-                    n0 = clamp_midibyte_value(n0);
-                    n1 += 12;
-                    n1 = clamp_midibyte_value(n1);
-                }
-                else
-                {
-                    n0 = 0;
-                    n1 = max_midi_value();
-                }
-            }
-            height = n1 - n0;
             pen.setWidth(1);
             if (loop()->transposable())
                 pen.setColor(pen_color());      /* issue #50 text_color()   */
@@ -928,45 +941,135 @@ qloopbutton::draw_pattern (QPainter & painter)
                 pen.setColor(drum_color());
 
             painter.setPen(pen);
-            loop()->draw_lock();
-            for (auto cev = loop()->cbegin(); ! loop()->cend(cev); ++cev)
-            {
-                sequence::note_info ni;
-                sequence::draw dt = loop()->get_next_note(ni, cev);
-                if (dt == sequence::draw::finish)
-                    break;
-
-                int tick_s_x = (ni.start() * xw) / t1;
-                int sx = x0 + tick_s_x;                /* start x          */
-                if (dt == sequence::draw::tempo)
-                {
-                    midibpm max = usr().midi_bpm_maximum();
-                    midibpm min = usr().midi_bpm_minimum();
-                    double tempo = double(ni.velocity());
-                    int y = int((max - tempo) / (max - min) * yh) + y0;
-                    brush.setColor(tempo_paint());
-                    painter.setBrush(brush);
-                    painter.drawEllipse(sx, y, 4, 4);
-                }
-                else if (dt == sequence::draw::program)
-                {
-                    int y = y0 + yh * (n1 - ni.note()) / height;
-                    brush.setColor(drum_paint());
-                    painter.setBrush(brush);
-                    painter.drawEllipse(sx, y, 4, 4);
-                }
-                else
-                {
-                    int y = y0 + yh * (n1 - ni.note()) / height;
-                    int tick_f_x = (ni.finish() * xw) / t1;
-                    if (! sequence::is_draw_note(dt) || tick_f_x <= tick_s_x)
-                        tick_f_x = tick_s_x + 1;
+            if (! m_thumbnail_notes.empty())
+                painter.drawLines
+                (
+                    m_thumbnail_notes.data(), int(m_thumbnail_notes.size())
+                );
 
-                    int fx = x0 + tick_f_x;            /* finish x         */
-                    painter.drawLine(sx, y, fx, y);
-                }
+            if (! m_thumbnail_tempos.empty())
+            {
+                brush.setColor(tempo_paint());
+                painter.setBrush(brush);
+                for (const auto & p : m_thumbnail_tempos)
+                    painter.drawEllipse(p.x(), p.y(), 4, 4);
+            }
+            if (! m_thumbnail_programs.empty())
+            {
+                brush.setColor(drum_paint());
+                painter.setBrush(brush);
+                for (const auto & p : m_thumbnail_programs)
+                    painter.drawEllipse(p.x(), p.y(), 4, 4);
             }
-            loop()->draw_unlock();
+        }
+    }
+}
+
+/**
+ *  Tells if the cached thumbnail no longer matches the model's item or the
+ *  event box.
+ */
+
+bool
+qloopbutton::thumbnail_stale (const qslivemodel::item & it) const
+{
+    QRect box(m_event_box.x(), m_event_box.y(), m_event_box.w(),
+        m_event_box.h());
+
+    return ! m_thumbnail_valid || m_thumbnail_serial != it.serial() ||
+        m_thumbnail_box != box;
+}
+
+/**
+ *  Converts the events saved by the shared live model, the notes to line
+ *  segments, and the tempo and program events to dots, in the coordinates
+ *  of the event box.  The fingerprint, used for long patterns, is
+ *  recalculated as well.  No lock is needed, as the pattern itself is not
+ *  walked here.
+ */
+
+void
+qloopbutton::build_thumbnail (const qslivemodel::item & it)
+{
+    m_thumbnail_serial = it.serial();
+    m_thumbnail_box.setRect
+    (
+        m_event_box.x(), m_event_box.y(), m_event_box.w(), m_event_box.h()
+    );
+    m_thumbnail_notes.clear();
+    m_thumbnail_tempos.clear();
+    m_thumbnail_programs.clear();
+    m_thumbnail_valid = true;
+    m_fingerprint_inited = m_fingerprinted = false;
+    initialize_fingerprint(it);
+
+    midipulse t1 = it.length();
+    if (m_fingerprinted || it.marks().empty() || t1 <= 0)
+        return;
+
+    int x0 = m_event_box.x();
+    int y0 = m_event_box.y();
+    int xw = m_event_box.w();
+    int yh = m_event_box.h();
+    int n0, n1;
+    if (m_note_max > 0)
+    {
+        n0 = m_note_min;
+        n1 = m_note_max;
+    }
+    else
+    {
+        bool have_notes = it.minmax_notes(n0, n1);
+        if (have_notes)
+        {
+            /*
+             * Added an octave of padding above and below for looks.
+             */
+
+            n0 -= 12;
+            n0 = clamp_midibyte_value(n0);
+            n1 += 12;
+            n1 = clamp_midibyte_value(n1);
+        }
+        else
+        {
+            n0 = 0;
+            n1 = max_midi_value();
+        }
+    }
+
+    int height = n1 - n0;
+    if (height <= 0)
+        height = 1;
+
+    midibpm max = usr().midi_bpm_maximum();
+    midibpm min = usr().midi_bpm_minimum();
+    for (const auto & m : it.marks())
+    {
+        const sequence::note_info & ni = m.m_info;
+        sequence::draw dt = m.m_kind;
+        int tick_s_x = (ni.start() * xw) / t1;
+        int sx = x0 + tick_s_x;                        /* start x          */
+        if (dt == sequence::draw::tempo)
+        {
+            double tempo = double(ni.velocity());
+            int y = int((max - tempo) / (max - min) * yh) + y0;
+            m_thumbnail_tempos.emplace_back(sx, y);
+        }
+        else if (dt == sequence::draw::program)
+        {
+            int y = y0 + yh * (n1 - ni.note()) / height;
+            m_thumbnail_programs.emplace_back(sx, y);
+        }
+        else
+        {
+            int y = y0 + yh * (n1 - ni.note()) / height;
+            int tick_f_x = (ni.finish() * xw) / t1;
+            if (! sequence::is_draw_note(dt) || tick_f_x <= tick_s_x)
+                tick_f_x = tick_s_x + 1;
+
+            int fx = x0 + tick_f_x;                    /* finish x         */
+            m_thumbnail_notes.emplace_back(sx, y, fx, y);
         }
     }
 }
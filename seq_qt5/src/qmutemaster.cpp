@@ -24,14 +24,15 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-05-29
- * \updates       2023-11-26
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
 
+#include <QAbstractTableModel>
+#include <QHeaderView>
 #include <QKeyEvent>                    /* Needed for QKeyEvent::accept()   */
 #include <QPushButton>
-#include <QTableWidgetItem>
 #include <QTimer>
 
 #include "seq66-config.h"               /* defines SEQ66_QMAKE_RULES        */
@@ -69,6 +70,178 @@ static const int c_button_size      = 26;   // 28; // 26; // 24;
 namespace seq66
 {
 
+/**
+ *  The model of the mute-group table.  Each cell is read from the
+ *  performer's mutegroups when the view shows it, so that refreshing the
+ *  table no longer creates and fills a table item for every cell.  The row
+ *  is the mute-group number.  It adds no signals or slots, so it needs no
+ *  Q_OBJECT.
+ */
+
+class qmutemodel final : public QAbstractTableModel
+{
+
+private:
+
+    qmutemaster & m_mute_master;
+    int m_rows;
+
+public:
+
+    qmutemodel (qmutemaster & owner) :
+        QAbstractTableModel (&owner),
+        m_mute_master       (owner),
+        m_rows              (owner.cb_perf().mutegroup_count())
+    {
+        // no code
+    }
+
+    virtual int rowCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : m_rows ;
+    }
+
+    virtual int columnCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : 4 ;
+    }
+
+    virtual QVariant data (const QModelIndex & index, int role) const override;
+    virtual QVariant headerData
+    (
+        int section, Qt::Orientation orientation, int role
+    ) const override;
+    virtual Qt::ItemFlags flags (const QModelIndex & index) const override;
+    virtual bool setData
+    (
+        const QModelIndex & index, const QVariant & value, int role
+    ) override;
+
+    void reload ();
+    void row_changed (mutegroup::number m);
+
+};
+
+QVariant
+qmutemodel::data (const QModelIndex & index, int role) const
+{
+    QVariant result;
+    if (index.isValid() && (role == Qt::DisplayRole || role == Qt::EditRole))
+    {
+        performer & p = m_mute_master.cb_perf();
+        mutegroup::number m = mutegroup::number(index.row());
+        switch (index.column())
+        {
+        case 0:
+            result = QString::number(m);
+            break;
+
+        case 1:
+            result = QString::number(p.count_mutes(m));
+            break;
+
+        case 2:
+            result = qt(p.lookup_mute_key(m));
+            break;
+
+        case 3:
+            result = qt(p.group_name(m));
+            break;
+        }
+    }
+    return result;
+}
+
+QVariant
+qmutemodel::headerData
+(
+    int section, Qt::Orientation orientation, int role
+) const
+{
+    static const char * const s_headers [] =
+    {
+        "Group", "Active", "Key", "Group Name"
+    };
+    QVariant result;
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+    {
+        if (section >= 0 && section < 4)
+            result = QString(s_headers[section]);
+    }
+    return result;
+}
+
+/**
+ *  Currently, the only cell that can be changed is the "Group Name".
+ */
+
+Qt::ItemFlags
+qmutemodel::flags (const QModelIndex & index) const
+{
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+    if (index.isValid() && index.column() == 3)
+        result |= Qt::ItemIsEditable;
+
+    return result;
+}
+
+/**
+ *  Renames the mute-group.  This can modify the '.mutes' file, the MIDI
+ *  file, or both.
+ */
+
+bool
+qmutemodel::setData
+(
+    const QModelIndex & index, const QVariant & value, int role
+)
+{
+    bool result = index.isValid() && index.column() == 3 &&
+        role == Qt::EditRole;
+
+    if (result)
+    {
+        mutegroup::number m = mutegroup::number(index.row());
+        std::string name = value.toString().toStdString();
+        if (m_mute_master.cb_perf().group_name(m, name))
+        {
+            m_mute_master.modify_mutes();
+            emit dataChanged(index, index);
+        }
+    }
+    return result;
+}
+
+/**
+ *  Tells the view that every row may have changed.  The model is reset
+ *  only if the number of groups changes.
+ */
+
+void
+qmutemodel::reload ()
+{
+    int rows = m_mute_master.cb_perf().mutegroup_count();
+    if (rows != m_rows)
+    {
+        beginResetModel();
+        m_rows = rows;
+        endResetModel();
+    }
+    else if (m_rows > 0)
+        emit dataChanged(index(0, 0), index(m_rows - 1, 3));
+}
+
+/**
+ *  Tells the view that one mute-group has changed.
+ */
+
+void
+qmutemodel::row_changed (mutegroup::number m)
+{
+    if (m >= 0 && m < m_rows)
+        emit dataChanged(index(m, 0), index(m, 3));
+}
+
 /**
  *
  * \param p
@@ -94,6 +267,7 @@ qmutemaster::qmutemaster
     performer::callbacks    (p),
     ui                      (new Ui::qmutemaster),
     m_timer                 (nullptr),
+    m_group_model           (nullptr),
     m_main_window           (mainparent),
     m_is_initialized        (false),
     m_to_midi_active        (false),
@@ -381,64 +555,32 @@ qmutemaster::clear_pattern_mutes ()
     m_pattern_offset = 0;
 }
 
+/**
+ *  The column headers come from qmutemodel::headerData(), and a group name
+ *  edited in the table goes to qmutemodel::setData().  The selection model
+ *  exists only after the model is set.
+ */
+
 void
 qmutemaster::setup_table ()
 {
-    QStringList columns;
-    columns << "Group" << "Active" << "Key" << "Group Name";
-
-    /*
-     * This advice is bs. The actual answer is to set the horizontal header to be
-     * visible.
-     *
-     * ui->m_group_table->insertColumn(0);
-     * ui->m_group_table->insertColumn(1);
-     * ui->m_group_table->insertColumn(2);
-     * ui->m_group_table->insertColumn(3);
-     */
-
-    ui->m_group_table->setHorizontalHeaderLabels(columns);
+    m_group_model = new qmutemodel(*this);
+    ui->m_group_table->setModel(m_group_model);
     ui->m_group_table->setSelectionBehavior(QAbstractItemView::SelectRows);
 
     int w = ui->m_group_table->width();
     set_column_widths(w - c_table_fix);
+    ui->m_group_table->verticalHeader()->
+        setDefaultSectionSize(c_table_row_height);
 
-    const int rows = ui->m_group_table->rowCount();
-    for (int r = 0; r < rows; ++r)
-        ui->m_group_table->setRowHeight(r, c_table_row_height);
-
-    connect
-    (
-        ui->m_group_table, SIGNAL(currentCellChanged(int, int, int, int)),
-        this, SLOT(slot_table_click(int, int, int, int))
-    );
     connect
     (
-        ui->m_group_table, SIGNAL(cellChanged(int, int)),
-        this, SLOT(slot_cell_changed(int, int))
+        ui->m_group_table->selectionModel(),
+        SIGNAL(currentRowChanged(const QModelIndex &, const QModelIndex &)),
+        this, SLOT(slot_table_click(const QModelIndex &))
     );
 }
 
-/**
- *  Currently, the only cell that can be changed is the "Group Name".
- *  This can modify the '.mutes' file, the MIDI file, or both.
- */
-
-void
-qmutemaster::slot_cell_changed (int row, int column)
-{
-    column_id cid = static_cast<column_id>(column);
-    if (cid == column_id::group_name)
-    {
-        mutegroup::number m = mutegroup::number(row);
-        QTableWidgetItem * c = cell(m, cid);
-        QString qtext = c->text();
-        std::string name = qtext.toStdString();
-        if (cb_perf().group_name(m, name))
-            modify_mutes();
-    }
-}
-
 /**
  *  Scales the columns against the provided window width. The width factors
  *  should add up to 1.  However, we make the name column narrower.
@@ -491,98 +633,19 @@ qmutemaster::set_current_group (int group)
     return result;
 }
 
-bool
-qmutemaster::initialize_table ()
-{
-    int rows = cb_perf().mutegroup_count();
-    bool result = rows > 0;
-    ui->m_group_table->clearContents();
-    if (result)
-    {
-        for (int row = 0; row < rows; ++row)
-        {
-            mutegroup::number g = mutegroup::number(row);
-            int mutecount = cb_perf().count_mutes(g);
-            std::string keyname = cb_perf().lookup_mute_key(row);
-            std::string groupname = cb_perf().group_name(row);
-            (void) group_line(g, mutecount, keyname, groupname);
-        }
-        ui->m_group_table->clearSelection();
-    }
-    return result;
-}
-
 /**
- *  Retrieve the table cell at the given row and column.
- *
- * \param row
- *      The row number, which should be in the range of 0 to 32.
- *
- * \param col
- *      The column enumeration value, which indicates one of these four
- *      columns: number, count, keyname, and name.
- *
- * \return
- *      Returns a pointer the table widget-item for the given row and column.
- *      If out-of-range, a null pointer is returned.
- */
-
-QTableWidgetItem *
-qmutemaster::cell (mutegroup::number row, column_id col)
-{
-    int column = int(col);
-    QTableWidgetItem * result = ui->m_group_table->item(row, column);
-    if (is_nullptr(result))
-    {
-        result = new (std::nothrow) QTableWidgetItem;
-        if (not_nullptr(result))
-        {
-            ui->m_group_table->setItem(row, column, result);
-            if (col != column_id::group_name)
-                result->setFlags(result->flags() ^ Qt::ItemIsEditable);
-        }
-    }
-    return result;
-}
-
-/**
- *  Obtains the group number (row), number of active (arming) items in the
- *  mute-group, and the keystroke used to access that mute-group. These are
- *  then set into the cells of the corresponding column.
+ *  The model reads the mute-groups itself, so this only tells the view to
+ *  show them again.
  */
 
 bool
-qmutemaster::group_line
-(
-    mutegroup::number row,
-    int mutecount,
-    const std::string & keyname,
-    const std::string & groupname
-)
+qmutemaster::initialize_table ()
 {
-    bool result = false;
-    QTableWidgetItem * qtip = cell(row, column_id::group_number);
-    if (not_nullptr(qtip))
+    bool result = cb_perf().mutegroup_count() > 0;
+    if (not_nullptr(m_group_model))
     {
-        std::string groupnostr = std::to_string(int(row));
-        qtip->setText(qt(groupnostr));
-        qtip = cell(row, column_id::group_count);
-        if (not_nullptr(qtip))
-        {
-            std::string gcountstr = std::to_string(mutecount);
-            qtip->setText(qt(gcountstr));
-            qtip = cell(row, column_id::group_keyname);
-            if (not_nullptr(qtip))
-            {
-                qtip->setText(qt(keyname));
-                qtip = cell(row, column_id::group_name);
-                if (not_nullptr(qtip))
-                {
-                    qtip->setText(qt(groupname));
-                    result = true;
-                }
-            }
-        }
+        m_group_model->reload();
+        ui->m_group_table->clearSelection();
     }
     return result;
 }
@@ -592,11 +655,9 @@ qmutemaster::group_line
  */
 
 void
-qmutemaster::slot_table_click
-(
-    int row, int /*column*/, int /*prevrow*/, int /*prevcolumn*/
-)
+qmutemaster::slot_table_click (const QModelIndex & current)
 {
+    int row = current.row();
     int rows = cb_perf().mutegroup_count();                 /* always 32    */
     if (rows > 0)
     {
@@ -1025,9 +1086,8 @@ qmutemaster::handle_group_change (int groupno)
  *  Handles mute-group changes from other dialogs.  These changes involve only
  *  the adding/subtracting of patterns to an old or a new group.
  *
- *  Don't think we need to call modify_mutes() here.... But it gets modified
- *  anyway by initialize table. That should not be done unless it is a real
- *  change.
+ *  Don't think we need to call modify_mutes() here.  Only the row of the
+ *  changed group is redrawn; the rest of the table is left alone.
  */
 
 bool
@@ -1040,7 +1100,7 @@ qmutemaster::on_mutes_change (mutegroup::number group, performer::change mod)
         if (ok)
         {
             if (mod == performer::change::yes)          /* ca 2023-11-07    */
-                result = initialize_table();
+                m_group_model->row_changed(group);      /* only its row     */
 
             if (result)
             {
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-04-09
- * \updates       2025-01-23
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This dialog provides a way to combine the following pattern adjustments:
@@ -43,6 +43,7 @@
 #include <QButtonGroup>
 
 #include "seq66-config.h"               /* defines SEQ66_QMAKE_RULES        */
+#include "play/editjob.hpp"             /* seq66::editjob worker edits      */
 #include "play/performer.hpp"           /* seq66::performer class           */
 #include "qpatternfix.hpp"              /* seq66::qpatternfix class         */
 #include "qseqdata.hpp"                 /* seq66::qseqdata for status, CC   */
@@ -809,9 +810,15 @@ qpatternfix::slot_set ()
         m_time_sig_width, m_measures, m_scale_factor,
         m_notemap_file, m_reverse_notemap, fixeffect::none
     };
-    bool success = perf().fix_pattern(track().seq_number(), fp);
+    editjob job                                         /* worker thread    */
+    (
+        perf().get_sequence(track().seq_number()), "Fixing pattern",
+        [&fp] (sequence & s) { return s.fix_pattern(fp); }
+    );
+    bool success = qt_run_edit(this, job);
     if (success)
     {
+        perf().notify_trigger_change(track().seq_number());
         bool alteration = m_alt_type != alteration::none;
         bool bitshifted = bit_test(fp.fp_effect, fixeffect::shifted);
         bool bitreversed = bit_test(fp.fp_effect, fixeffect::reversed);
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-12-28
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module is almost exclusively user-interface code.  There are some
@@ -37,7 +37,10 @@
  *  the build with the "--disable-highlight" option.
  */
 
+#include <algorithm>                    /* std::min()                       */
+
 #include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
 #include <QPen>
 
@@ -76,6 +79,7 @@ const int s_pointsize = 7;
 qperfnames::qperfnames (performer & p, QWidget * parent) :
     QWidget             (parent),
     qperfbase           (p),
+    m_rows              (p),
     m_font              ("Monospace"),
     m_nametext_x        (6 * 2 + 6 * 20),                   /* see name_x() */
     m_preview_color     (progress_paint()),
@@ -98,26 +102,65 @@ qperfnames::qperfnames (performer & p, QWidget * parent) :
 }
 
 /**
- *  A pass-along function for the parent frame to call.
+ *  A pass-along function for the parent frame to call.  Not all of the
+ *  changes it passes along, such as a renamed set, are counted, so every
+ *  row is read again.
  */
 
 void
 qperfnames::reupdate ()
 {
+    m_rows.invalidate();
     update();
 }
 
 /**
- *  Draws the sequence names down the side of the performance roll.
+ *  Called at each tick of the timer of the roll, since this panel has no
+ *  timer of its own.  If a change counter has moved, the visible rows whose
+ *  data changed are repainted.  The other rows are read again only when
+ *  they are scrolled into view.
+ */
+
+void
+qperfnames::update_rows ()
+{
+    if (m_rows.check())
+    {
+        QRect visible = visibleRegion().boundingRect();
+        int h = track_height();
+        if (! visible.isEmpty() && h > 0)
+        {
+            int set_count = setmaster::Size();
+            int y_s = visible.top() / h;
+            int y_f = std::min(visible.bottom() / h, row_max());
+            for (int seq_id = y_s; seq_id <= y_f; ++seq_id)
+            {
+                if (m_rows.changed(seq_id))
+                {
+                    int y = name_y(seq_id);
+                    update(QRect(0, y, width(), h));
+                    if ((seq_id % set_count) == 0)      /* the set's name   */
+                        update(QRect(0, y, 15, h * set_count));
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  Draws the sequence names down the side of the performance roll.  Only
+ *  the rows that cross the exposed rectangle are drawn, from the snapshots
+ *  in the row model, along with the bank boxes of their sets.
  */
 
 void
-qperfnames::paintEvent (QPaintEvent *)
+qperfnames::paintEvent (QPaintEvent * qpep)
 {
+    QRect r = qpep->rect();
     int h = track_height();
-    int y_s = 0;
-    int y_f = height() / h;
     int set_count = setmaster::Size();                  /* number of rows   */
+    int y_s = r.top() / h;
+    int y_f = std::min(r.bottom() / h, row_max());
     QPainter painter(this);
     QPen pen(text_paint());                             /* fore_color()     */
     QBrush brush(backnames_paint(), Qt::SolidPattern);
@@ -127,180 +170,179 @@ qperfnames::paintEvent (QPaintEvent *)
     painter.setBrush(brush);
     painter.setFont(m_font);
     painter.drawRect(0, 0, width(), height() - 1);      // rectangle border
+    if (y_f < y_s)
+        return;
+
     int set_y = h * set_count / 2;
-    for (int y = y_s; y <= y_f; ++y)
+    int rect_x = 6 * 2 + 2;
+    int rect_w = c_names_x - 15;
+    for (int bank_id = y_s / set_count; bank_id <= y_f / set_count; ++bank_id)
     {
-        int seq_id = y;
-        if (seq_id < int(perf().sequence_max()))        // or use set_count?
+        int seq_id = bank_id * set_count;
+        int rect_y = h * seq_id;
+        char ss[16];
+        snprintf(ss, sizeof ss, "%2d", bank_id);
+        pen.setColor(fore_color());             // black bank boxes
+        brush.setColor(back_color());           // Qt::black
+        brush.setStyle(Qt::SolidPattern);
+        painter.setPen(pen);
+        painter.setBrush(brush);
+        painter.drawRect(1, name_y(seq_id) + 1, 13, h - 1);
+
+        int text_y = rect_y + set_y;
+        QString bankss(ss);
+
+        /*
+         * pen.setColor(fore_color());          // for bank number
+         * pen.setColor(text_paint());          // for bank number
+         */
+
+        pen.setColor(text_names_paint());       // for bank number
+        painter.setPen(pen);
+        painter.drawText(1, rect_y + 10, bankss);
+
+        /*
+         * pen.setColor(Qt::black);             // bank name sideways
+         * painter.setPen(pen);
+         */
+
+        painter.save();                         // {
+
+        QString bank(qt(m_rows.get(seq_id).set_name()));
+        painter.translate(12, text_y + bank.length() * 4);
+        painter.rotate(270);
+        painter.drawText(0, 0, bank);
+        painter.restore();                      // }
+    }
+    for (int seq_id = y_s; seq_id <= y_f; ++seq_id)
+    {
+        const qperfrows::row & rw = m_rows.get(seq_id);
+        int rect_y = h * seq_id;
+        if (rw.active())
         {
-            int rect_x = 6 * 2 + 2;
-            int rect_y = h * seq_id;
-            int rect_w = c_names_x - 15;
-            if ((seq_id % set_count) == 0)              // 1st seq in bank?
+            bool muted = rw.muted();                // ! s->armed()
+            char name[64];
+            snprintf
+            (
+                name, sizeof name, "%-14.14s %3d",
+                rw.name().c_str(), rw.measures()
+            );
+
+            QString chinfo(name);
+            if (use_gradient())
             {
-                char ss[16];
-                int bank_id = seq_id / set_count;
-                snprintf(ss, sizeof ss, "%2d", bank_id);
-                pen.setColor(fore_color());             // black bank boxes
-                brush.setColor(back_color());           // Qt::black
-                brush.setStyle(Qt::SolidPattern);
-                painter.setPen(pen);
-                painter.setBrush(brush);
-                painter.drawRect(1, name_y(seq_id) + 1, 13, h - 1);
-
-                int text_y = rect_y + set_y;
-                QString bankss(ss);
+                QLinearGradient grad
+                (
+                    rect_x, rect_y, rect_x, rect_y + h + 1
+                );
+                if (muted)
+                {
+                    Color backcolor = grey_color();
+                    grad.setColorAt(0.01, backcolor.darker());
+                    grad.setColorAt(0.5, backcolor.lighter());
+                    grad.setColorAt(0.99, backcolor.darker());
+                }
+                else
+                {
+                    int c = rw.color();
+                    Color backcolor = get_color_fix(PaletteColor(c));
+                    int alpha = seq_id == m_preview_row ?
+                        s_alpha_bright : s_alpha_normal ;
+
+                    backcolor.setAlpha(alpha);
+                    grad.setColorAt(0.01, backcolor.darker(150));
+                    grad.setColorAt(0.5, backcolor.lighter());
+                    grad.setColorAt(0.99, backcolor.darker(150));
+                }
+                painter.fillRect
+                (
+                    rect_x +2 , rect_y +1, rect_w -2, h - 1, grad
+                );
+                pen.setColor(fore_color());
 
                 /*
-                 * pen.setColor(fore_color());          // for bank number
-                 * pen.setColor(text_paint());          // for bank number
+                 * 0.99.1: Draw a rectangle around the gradient.
                  */
 
-                pen.setColor(text_names_paint());       // for bank number
+                pen.setStyle(Qt::SolidLine);
+                pen.setColor(fore_color());
                 painter.setPen(pen);
-                painter.drawText(1, rect_y + 10, bankss);
-
-                /*
-                 * pen.setColor(Qt::black);             // bank name sideways
-                 * painter.setPen(pen);
-                 */
-
-                painter.save();                         // {
-
-                QString bank(qt(perf().set_name(bank_id)));
-                painter.translate(12, text_y + bank.length() * 4);
-                painter.rotate(270);
-                painter.drawText(0, 0, bank);
-                painter.restore();                      // }
+                brush.setStyle(Qt::NoBrush);
+                painter.setBrush(brush);
+                painter.drawRect(rect_x, rect_y, rect_w, h);
             }
-            if (perf().is_seq_active(seq_id))
+            else
             {
-                std::string seq_name = perf().sequence_label(seq_id);
-                seq::pointer s = perf().get_sequence(seq_id);
-                bool muted = s->get_song_mute();        // ! s->armed()
-                char name[64];
-                snprintf
-                (
-                    name, sizeof name, "%-14.14s %3d",
-                    s->name().c_str(), s->measures()
-                );
-
-                QString chinfo(name);
-                if (use_gradient())
+                if (muted)
                 {
-                    QLinearGradient grad
-                    (
-                        rect_x, rect_y, rect_x, rect_y + h + 1
-                    );
-                    if (muted)
-                    {
-                        Color backcolor = grey_color();
-                        grad.setColorAt(0.01, backcolor.darker());
-                        grad.setColorAt(0.5, backcolor.lighter());
-                        grad.setColorAt(0.99, backcolor.darker());
-                    }
-                    else
-                    {
-                        int c = s->color();
-                        Color backcolor = get_color_fix(PaletteColor(c));
-                        int alpha = seq_id == m_preview_row ?
-                            s_alpha_bright : s_alpha_normal ;
-
-                        backcolor.setAlpha(alpha);
-                        grad.setColorAt(0.01, backcolor.darker(150));
-                        grad.setColorAt(0.5, backcolor.lighter());
-                        grad.setColorAt(0.99, backcolor.darker(150));
-                    }
-                    painter.fillRect
-                    (
-                        rect_x +2 , rect_y +1, rect_w -2, h - 1, grad
-                    );
-                    pen.setColor(fore_color());
-
-                    /*
-                     * 0.99.1: Draw a rectangle around the gradient.
-                     */
-
-                    pen.setStyle(Qt::SolidLine);
-                    pen.setColor(fore_color());
-                    painter.setPen(pen);
-                    brush.setStyle(Qt::NoBrush);
+                    brush.setColor(grey_color());
+                    brush.setStyle(Qt::SolidPattern);
                     painter.setBrush(brush);
                     painter.drawRect(rect_x, rect_y, rect_w, h);
+                    pen.setColor(fore_color());
                 }
                 else
                 {
-                    if (muted)
-                    {
-                        brush.setColor(grey_color());
-                        brush.setStyle(Qt::SolidPattern);
-                        painter.setBrush(brush);
-                        painter.drawRect(rect_x, rect_y, rect_w, h);
-                        pen.setColor(fore_color());
-                    }
-                    else
-                    {
-                        int c = s->color();
-                        Color backcolor = get_color_fix(PaletteColor(c));
-                        int alpha = seq_id == m_preview_row ?
-                            s_alpha_bright : s_alpha_normal ;
-
-                        backcolor.setAlpha(alpha);
-                        brush.setColor(backcolor);
-                        brush.setStyle(Qt::SolidPattern);
-                        painter.setBrush(brush);
-                        painter.drawRect(rect_x, rect_y, rect_w, h);
-                        pen.setColor(fore_color());
-                    }
+                    int c = rw.color();
+                    Color backcolor = get_color_fix(PaletteColor(c));
+                    int alpha = seq_id == m_preview_row ?
+                        s_alpha_bright : s_alpha_normal ;
+
+                    backcolor.setAlpha(alpha);
+                    brush.setColor(backcolor);
+                    brush.setStyle(Qt::SolidPattern);
+                    painter.setBrush(brush);
+                    painter.drawRect(rect_x, rect_y, rect_w, h);
+                    pen.setColor(fore_color());
                 }
+            }
 
-                /*
-                 * painter.setPen(pen);
-                 * painter.setPen(text_paint());
-                 */
+            /*
+             * painter.setPen(pen);
+             * painter.setPen(text_paint());
+             */
 
-                painter.setPen(text_names_paint());
-                painter.drawText(18, rect_y + 9, chinfo);
-                if (! track_thin())
+            painter.setPen(text_names_paint());
+            painter.drawText(18, rect_y + 9, chinfo);
+            if (! track_thin())
+            {
+                char temp[8];
+                snprintf(temp, sizeof temp, "%3d", rw.triggers());
+                painter.drawText(18, rect_y + 19, qt(rw.label()));
+                painter.drawText(114, rect_y + 19, temp);
+            }
+            if (use_gradient())
+            {
+                if (muted)
                 {
-                    char temp[8];
-                    snprintf(temp, sizeof temp, "%3d", s->trigger_count());
-                    painter.drawText(18, rect_y + 19, qt(seq_name));
-                    painter.drawText(114, rect_y + 19, temp);
+                    brush.setColor(grey_color());
+                    brush.setStyle(Qt::SolidPattern);
+                    painter.setBrush(brush);
                 }
-                if (use_gradient())
+                else
                 {
-                    if (muted)
-                    {
-                        brush.setColor(grey_color());
-                        brush.setStyle(Qt::SolidPattern);
-                        painter.setBrush(brush);
-                    }
-                    else
-                    {
-                        int c = s->color();
-                        Color backcolor = get_color_fix(PaletteColor(c));
-                        int alpha = seq_id == m_preview_row ?
-                            s_alpha_bright : s_alpha_normal ;
-
-                        backcolor.setAlpha(alpha);
-                        brush.setColor(backcolor);
-                        brush.setStyle(Qt::SolidPattern);
-                        painter.setBrush(brush);
-                    }
+                    int c = rw.color();
+                    Color backcolor = get_color_fix(PaletteColor(c));
+                    int alpha = seq_id == m_preview_row ?
+                        s_alpha_bright : s_alpha_normal ;
+
+                    backcolor.setAlpha(alpha);
+                    brush.setColor(backcolor);
+                    brush.setStyle(Qt::SolidPattern);
+                    painter.setBrush(brush);
                 }
-                painter.drawRect(name_x(2), name_y(seq_id), 9, h);
-                painter.drawText(name_x(4), name_y(seq_id) + 9, QString("M"));
-            }
-            else
-            {
-                pen.setStyle(Qt::SolidLine);
-                pen.setColor(fore_color());
-                brush.setColor(backnames_paint());      /* Qt::lightGray)   */
-                painter.setPen(pen);                    /* fill background  */
-                painter.setBrush(brush);
-                painter.drawRect(rect_x, rect_y, rect_w, h);
             }
+            painter.drawRect(name_x(2), name_y(seq_id), 9, h);
+            painter.drawText(name_x(4), name_y(seq_id) + 9, QString("M"));
+        }
+        else
+        {
+            pen.setStyle(Qt::SolidLine);
+            pen.setColor(fore_color());
+            brush.setColor(backnames_paint());      /* Qt::lightGray)   */
+            painter.setPen(pen);                    /* fill background  */
+            painter.setBrush(brush);
+            painter.drawRect(rect_x, rect_y, rect_w, h);
         }
     }
 }
@@ -338,6 +380,17 @@ qperfnames::convert_y (int y)
     return seq;
 }
 
+/**
+ * \return
+ *      Returns the number of the last row that can hold a pattern.
+ */
+
+int
+qperfnames::row_max () const
+{
+    return int(perf().sequence_max()) - 1;
+}
+
 void
 qperfnames::keyPressEvent (QKeyEvent * event)
 {
@@ -374,12 +427,12 @@ qperfnames::mousePressEvent (QMouseEvent * ev)
     {
         bool isshiftkey = (ev->modifiers() & Qt::ShiftModifier) != 0;
         (void) perf().toggle_sequences(seqno, isshiftkey);
-        update();
+        reupdate();
     }
     else if (ev->button() == Qt::RightButton)
     {
         (void) perf().sequence_playing_toggle(seqno);
-        update();
+        reupdate();
     }
 }
 
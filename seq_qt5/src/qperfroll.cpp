@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-12-28
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class represents the central piano-roll user-interface area of the
@@ -37,15 +37,19 @@
  *  handle.  That is, if moving or growing, snap the tick.
  */
 
+#include <algorithm>                    /* std::lower_bound()               */
+
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QTimer>
 
 #include "cfg/settings.hpp"             /* seq66::usr() config functions    */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
 #include "play/performer.hpp"           /* seq66::performer class           */
 #include "util/rect.hpp"                /* seq66::rect::xy_to_rect_get()    */
 #include "gui_palette_qt5.hpp"
+#include "qglroll.hpp"                  /* seq66::qglroll, qglrecorder      */
 #include "qperfeditframe64.hpp"
 #include "qperfnames.hpp"
 #include "qperfroll.hpp"
@@ -88,6 +92,14 @@ static const int s_vfont_size_small     =  8;
 static const int s_vfont_size_normal    = 12;
 static const int s_vfont_size_large     = 16;
 
+/**
+ *  The layers of the GPU view, in drawing order.
+ */
+
+static const int c_gl_grid_layer        = 0;
+static const int c_gl_triggers_layer    = 1;
+static const int c_gl_overlay_layer     = 2;
+
 /**
  *  Principal constructor.
  */
@@ -120,7 +132,15 @@ qperfroll::qperfroll
     m_last_tick         (0),
     m_box_select        (false),
     m_grow_direction    (false),
-    m_adding_pressed    (false)
+    m_adding_pressed    (false),
+    m_note_cache        (),
+    m_change_generation (0),
+    m_progress_x        (0),
+    m_perf_generation   (0),
+    m_row_generations   (),
+    m_gl_view           (nullptr),
+    m_gl_recorder       (),
+    m_gl_rect           ()
 {
     setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::MinimumExpanding);
     setFocusPolicy(Qt::StrongFocus);
@@ -129,6 +149,11 @@ qperfroll::qperfroll
     m_font.setLetterSpacing(QFont::AbsoluteSpacing, 1);
     m_font.setBold(true);
     m_font.setPointSize(s_vfont_size_normal);
+#if defined SEQ66_OPENGL_SUPPORT
+    m_gl_view = qglroll::make(this);
+    if (not_nullptr(m_gl_view))
+        m_gl_recorder.reset(new qglrecorder(this, QRect()));
+#endif
     m_timer = qt_timer(this, "qperfroll", 2, SLOT(conditional_update()));
 }
 
@@ -144,17 +169,132 @@ qperfroll::~qperfroll ()
 
 /**
  *  Calls update() if needed, and also implements follow-progress.
+ *
+ *  While playing, the performer always needs an update.  If no pattern,
+ *  trigger, or performer setting has changed since the last full repaint,
+ *  only the strips of the old and new playhead are repainted.  If only the
+ *  contents of patterns changed, only their rows are added.  With the GPU
+ *  view, a scroll also needs an update, and the layers are recorded here.
+ *  The names panel, which has no timer, repaints its changed rows here.
  */
 
 void
 qperfroll::conditional_update ()
 {
-    if (perf().needs_update() || check_dirty())
+    bool local = is_dirty();                    /* before check_dirty()     */
+    bool scrolled = false;
+    if (not_nullptr(m_perf_names))
+        m_perf_names->update_rows();            /* it has no timer          */
+
+#if defined SEQ66_OPENGL_SUPPORT
+    scrolled = use_gpu() &&
+        visibleRegion().boundingRect() != m_gl_view->geometry();
+#endif
+    if (perf().needs_update() || check_dirty() || scrolled)
     {
         if (perf().follow_progress())
             follow_progress();              /* keep up with progress    */
 
-        update();
+        unsigned gen = change_generation();
+        bool perf_changed = perf_generation() != m_perf_generation;
+        if (use_gpu())
+        {
+            bool changed = local || gen != m_change_generation;
+            m_change_generation = gen;
+            gpu_paint(changed);
+        }
+        else if (local || ! perf().is_running() || perf_changed)
+        {
+            m_change_generation = gen;
+            m_perf_generation = perf_generation();
+            update_rows(false);
+            update();
+        }
+        else if (gen != m_change_generation)
+        {
+            m_change_generation = gen;
+            update_rows(true);                  /* only the edited patterns */
+            update_progress();
+        }
+        else
+            update_progress();
+    }
+}
+
+/**
+ *  Records the redraw generation of each visible pattern row, and, if
+ *  asked, repaints the rows whose pattern has changed since the last time.
+ *
+ * \param repaint
+ *      If true, update the rows that changed.  Otherwise, the caller does a
+ *      full update, and the generations are only recorded.
+ */
+
+void
+qperfroll::update_rows (bool repaint)
+{
+    QRect visible = visibleRegion().boundingRect();
+    int th = track_height();
+    if (visible.isEmpty() || th <= 0)
+        return;
+
+    int y_s = visible.top() / th;
+    int y_f = visible.bottom() / th;
+    if (std::size_t(y_f) >= m_row_generations.size())
+        m_row_generations.resize(std::size_t(y_f) + 1, 0);
+
+    for (int seqid = y_s; seqid <= y_f; ++seqid)
+    {
+        unsigned g = 0;
+        if (perf().is_seq_active(seqid))
+            g = perf().get_sequence(seqid)->redraw_generation() + 1;
+
+        unsigned & rg = m_row_generations[std::size_t(seqid)];
+        if (repaint && g != rg)
+            update(QRect(visible.left(), seqid * th, visible.width(), th));
+
+        rg = g;
+    }
+}
+
+/**
+ *  The sum of the counters of the changes that can alter the triggers or
+ *  their contents.  Only equality matters.
+ */
+
+unsigned
+qperfroll::change_generation () const
+{
+    return sequence::change_generation() + perf_generation();
+}
+
+/**
+ *  The performer's part of change_generation(), the changes that can move
+ *  anything in the roll, not just the contents of a pattern.
+ */
+
+unsigned
+qperfroll::perf_generation () const
+{
+    return perf().update_generation() + perf().trigger_generation();
+}
+
+/**
+ *  Repaints only the playhead, at its old and new positions.
+ */
+
+void
+qperfroll::update_progress ()
+{
+    int newx = z().tix_to_pix(perf().get_tick());
+    if (newx == 0)
+        newx = 3;
+
+    if (newx != m_progress_x)
+    {
+        int w = progress_bar_width() + 2;
+        update(QRect(m_progress_x - w, 0, 2 * w, height()));
+        update(QRect(newx - w, 0, 2 * w, height()));
     }
 }
 
@@ -171,14 +311,23 @@ qperfroll::follow_progress ()
 }
 
 /**
- *  Draws and redraws the performance roll.
+ *  Draws and redraws the performance roll.  Only the exposed rectangle is
+ *  drawn, whether it is the playhead strip, the strip uncovered by a
+ *  scroll, or the part of a large song that the scroll-area shows.
  */
 
 void
-qperfroll::paintEvent (QPaintEvent * /*qpep*/)
+qperfroll::paintEvent (QPaintEvent * qpep)
 {
+    trace_scope ts("qperfroll paint");
+    if (use_gpu())
+    {
+        gpu_paint(true);                    /* the GPU view covers us       */
+        return;
+    }
+
     QPainter painter(this);
-    QRect r(0, 0, width(), height());
+    QRect r = qpep->rect();
     QBrush brush(Qt::white, Qt::NoBrush);
     QPen pen(fore_color());
     pen.setStyle(Qt::SolidLine);
@@ -191,6 +340,29 @@ qperfroll::paintEvent (QPaintEvent * /*qpep*/)
     draw_grid(painter, r);
     draw_triggers(painter, r);
 
+#if defined THIS_CODE_ADDS_VALUE
+    int xwidth = r.width();
+    int yheight = r.height() - 1;
+    pen.setStyle(Qt::SolidLine);                    // draw border
+    pen.setColor(Qt::black);
+    pen.setWidth(c_border_width);
+    painter.setPen(pen);
+    painter.drawRect(0, 0, xwidth, yheight);
+#endif
+
+    draw_overlays(painter);
+}
+
+/**
+ *  Draws the selection box, if any, and the playhead.
+ */
+
+void
+qperfroll::draw_overlays (QPainter & painter)
+{
+    QBrush brush(Qt::white, Qt::NoBrush);
+    QPen pen(fore_color());
+
     /*
      * Draw selections, if applicable.  Currently, only one box can be selected.
      * Kepler34 has a feature called "box select" that we've had trouble
@@ -220,16 +392,6 @@ qperfroll::paintEvent (QPaintEvent * /*qpep*/)
         painter.setBrush(brush);
     }
 
-#if defined THIS_CODE_ADDS_VALUE
-    int xwidth = r.width();
-    int yheight = r.height() - 1;
-    pen.setStyle(Qt::SolidLine);                    // draw border
-    pen.setColor(Qt::black);
-    pen.setWidth(c_border_width);
-    painter.setPen(pen);
-    painter.drawRect(0, 0, xwidth, yheight);
-#endif
-
     midipulse tick = perf().get_tick();         /* draw progress playhead   */
     int progress_x = z().tix_to_pix(tick);
     pen.setColor(progress_color());
@@ -240,6 +402,77 @@ qperfroll::paintEvent (QPaintEvent * /*qpep*/)
     if (progress_x == 0)
         progress_x = 3;
     painter.drawLine(progress_x, 1, progress_x, height() - 2);
+    m_progress_x = progress_x;
+}
+
+/**
+ *  The GPU version of paintEvent().  The view is moved over the visible
+ *  part of the roll.  The grid and the triggers are recorded for the
+ *  visible part plus a margin of one view all around, again only if
+ *  something changed or the view left that area, and the qglroll uploads
+ *  only the rectangles that changed.  The overlays are recorded at each
+ *  update.
+ *
+ *  If the OpenGL context could not be used, the view is dropped and the
+ *  raster path takes over.
+ *
+ * \param changed
+ *      True if a pattern, a trigger, or a setting changed.
+ */
+
+void
+qperfroll::gpu_paint (bool changed)
+{
+#if defined SEQ66_OPENGL_SUPPORT
+    if (m_gl_view->failed())
+    {
+        m_gl_view->deleteLater();
+        m_gl_view = nullptr;
+        m_gl_recorder.reset();
+        update();
+        return;
+    }
+
+    QRect visible = visibleRegion().boundingRect();
+    if (visible.isEmpty())
+        return;
+
+    qglrecorder & rec = *m_gl_recorder;
+    m_gl_view->set_view(visible);
+    if (changed || ! m_gl_rect.contains(visible))
+    {
+        int mx = visible.width();
+        int my = visible.height();
+        m_gl_rect = visible.adjusted(-mx, -my, mx, my) & rect();
+        if (! is_initialized())
+            set_initialized();
+
+        rec.clear(m_gl_rect);
+        {
+            QPainter painter(&rec);
+            QPen pen(fore_color());
+            painter.setPen(pen);
+            painter.setBrush(QBrush(Qt::white, Qt::NoBrush));
+            painter.drawRect(0, 0, width(), height());
+            draw_grid(painter, m_gl_rect);
+        }
+        m_gl_view->set_layer(c_gl_grid_layer, rec);
+        rec.clear(m_gl_rect);
+        {
+            QPainter painter(&rec);
+            draw_triggers(painter, m_gl_rect);
+        }
+        m_gl_view->set_layer(c_gl_triggers_layer, rec);
+    }
+    rec.clear(visible);
+    {
+        QPainter painter(&rec);
+        draw_overlays(painter);
+    }
+    m_gl_view->set_layer(c_gl_overlay_layer, rec);
+#else
+    (void) changed;
+#endif
 }
 
 bool
@@ -1006,11 +1239,18 @@ qperfroll::redo ()
     perf().pop_trigger_redo();
 }
 
+/**
+ *  Draws the rows and the beat and measure lines that cross the exposed
+ *  rectangle.
+ */
+
 void
 qperfroll::draw_grid (QPainter & painter, const QRect & r)
 {
-    int xwidth = r.width();
-    int yheight = r.height();
+    int xleft = r.left();
+    int xright = r.right() + 1;
+    int yheight = height();
+    int th = track_height();
     QBrush brush(back_color());                         /* Qt::NoBrush      */
     QPen pen(fore_color());                             /* Qt::black        */
     pen.setStyle(Qt::SolidLine);
@@ -1018,10 +1258,10 @@ qperfroll::draw_grid (QPainter & painter, const QRect & r)
     painter.setPen(pen);
     painter.setBrush(brush);
     painter.drawRect(0, 0, width(), height());          /* full width       */
-    for (int i = 0; i < height(); i += track_height())  /* horizontal lines */
+    for (int i = (r.top() / th) * th; i <= r.bottom(); i += th)
     {
         int y = i + c_ycorrection;                      /* - 2 */
-        painter.drawLine(0, y, xwidth, y);
+        painter.drawLine(xleft, y, xright, y);          /* horizontal line  */
     }
 
     /*
@@ -1029,11 +1269,11 @@ qperfroll::draw_grid (QPainter & painter, const QRect & r)
      *  the beat-length (PPQN) makes drawing go faster.
      */
 
-    midipulse tick0 = scroll_offset();
-    midipulse windowticks = z().pix_to_tix(xwidth);
-    midipulse tick1 = tick0 + windowticks;
     midipulse tickstep = beat_length();                 /* versus 1         */
+    midipulse tick0 = scroll_offset() + z().pix_to_tix(xleft);
+    midipulse tick1 = scroll_offset() + z().pix_to_tix(xright) + tickstep;
     int penwidth = 1;
+    tick0 -= tick0 % tickstep;                          /* back to a beat   */
     for (midipulse tick = tick0; tick < tick1; tick += tickstep)
     {
         int x_pos = xoffset(tick);
@@ -1055,11 +1295,104 @@ qperfroll::draw_grid (QPainter & painter, const QRect & r)
     }
 }
 
+/**
+ *  Gets the notes of a pattern as drawn in one repeat of the pattern,
+ *  recalculating them only if the pattern or the drawn size has changed.
+ *
+ * \param s
+ *      The pattern, already known to be active.
+ *
+ * \param seqid
+ *      The pattern number, which indexes the cache.
+ *
+ * \param lenw
+ *      The pixel width of one repeat of the pattern.
+ *
+ * \return
+ *      Returns the cached notes and tempo events.  The points are relative to
+ *      the top left of the repeat.
+ */
+
+const qperfroll::notecache &
+qperfroll::pattern_notes (const seq::pointer & s, int seqid, int lenw)
+{
+    if (std::size_t(seqid) >= m_note_cache.size())
+        m_note_cache.resize(std::size_t(seqid) + 1);
+
+    notecache & nc = m_note_cache[std::size_t(seqid)];
+    unsigned gen = s->redraw_generation();
+    int cny = track_height() - 6;
+    bool valid = nc.nc_valid && nc.nc_generation == gen &&
+        nc.nc_width == lenw && nc.nc_height == cny;
+
+    if (! valid)
+    {
+        midipulse lens = s->get_length();
+        nc.nc_notes.clear();
+        nc.nc_tempos.clear();
+        s->draw_lock();
+
+        int note0, note1;
+        (void) s->minmax_notes(note0, note1);
+
+        int height = note1 - note0;
+        height += 2;
+        for (auto cev = s->cbegin(); lens > 0 && ! s->cend(cev); ++cev)
+        {
+            sequence::note_info ni;
+            sequence::draw dt = s->get_next_note(ni, cev);
+            if (dt == sequence::draw::finish)
+                break;
+
+            midipulse tick_s = ni.start();
+            int sx = tick_s * lenw / lens;
+            if (dt == sequence::draw::tempo)
+            {
+                midibpm max = usr().midi_bpm_maximum();
+                midibpm min = usr().midi_bpm_minimum();
+                double tempo = double(ni.velocity());
+                int yt = int(cny * (max - tempo) / (max - min));
+                nc.nc_tempos.push_back(QPoint(sx, yt));
+            }
+            else
+            {
+                midipulse tick_f = ni.finish();
+                int note_y = (cny - (cny * (ni.note() - note0)) / height) + 1;
+                int fx = tick_f * lenw / lens;
+                if (sequence::is_draw_note_onoff(dt))
+                    fx = sx + 1;
+
+                if (fx <= sx)
+                    fx = sx + 1;
+
+                nc.nc_notes.push_back(QLine(sx, note_y, fx, note_y));
+            }
+        }
+        s->draw_unlock();
+        nc.nc_valid = true;
+        nc.nc_generation = gen;
+        nc.nc_width = lenw;
+        nc.nc_height = cny;
+    }
+    return nc;
+}
+
+/**
+ *  Draws the triggers that cross the exposed rectangle.  Only the rows in
+ *  the rectangle are visited.  As the triggers of a pattern are sorted and
+ *  do not overlap, a binary search finds the first one that ends in the
+ *  rectangle, and the walk stops at the first one that starts past it.
+ *  Likewise, only the repeats of the pattern inside the rectangle have
+ *  their notes drawn, from the note cache.
+ */
+
 void
 qperfroll::draw_triggers (QPainter & painter, const QRect & r)
 {
-    int y_s = 0;
-    int y_f = r.height() / track_height();
+    int y_s = r.top() / track_height();
+    int y_f = r.bottom() / track_height();
+    midipulse tick_l = z().pix_to_tix(r.left() > 2 ? r.left() - 2 : 0);
+    midipulse tick_r = z().pix_to_tix(r.right() + 2);
     int cbw = c_size_box_w;                     /* copied for readability   */
     QBrush brush(Qt::NoBrush);
     QPen pen(fore_color());
@@ -1099,11 +1432,23 @@ qperfroll::draw_triggers (QPainter & painter, const QRect & r)
             int lenw = z().tix_to_pix(lens);
             int h = track_height() - 1;
             int cbwoffset = cbw + h / 2 - 2;
-            trigger trig;
             painter.setFont(m_font);
-            s->reset_draw_trigger_marker();
-            while (s->next_trigger(trig))               /* side-effect      */
+
+            const triggers::container trigs = s->get_triggers();
+            auto tit = std::lower_bound
+            (
+                trigs.cbegin(), trigs.cend(), tick_l,
+                [] (const trigger & tr, midipulse tk)
+                {
+                    return tr.tick_end() < tk;
+                }
+            );
+            for ( ; tit != trigs.cend(); ++tit)
             {
+                const trigger & trig = *tit;
+                if (trig.tick_start() > tick_r)
+                    break;
+
                 if (trig.tick_end() > 0)
                 {
                     int x_on = z().tix_to_pix(trig.tick_start());
@@ -1192,66 +1537,43 @@ qperfroll::draw_triggers (QPainter & painter, const QRect & r)
                     }
 
                     midipulse t = trig.trigger_marker(lens);    /* offset   */
-                    while (t < trig.tick_end())
-                    {
-                        int note0, note1;
-                        (void) s->minmax_notes(note0, note1);
+                    if (lens <= 0 || lenw <= 0)
+                        continue;
 
-                        int height = note1 - note0;
-                        height += 2;
-                        if (s->transposable())
-                            pen.setColor(fore_color());
-                        else
-                            pen.setColor(drum_color());
+                    if (t + lens < tick_l)              /* skip hidden ones */
+                        t += ((tick_l - t) / lens) * lens;
 
-                        painter.setPen(pen);
+                    const notecache & nc = pattern_notes(s, seqid, lenw);
+                    if (s->transposable())
+                        pen.setColor(fore_color());
+                    else
+                        pen.setColor(drum_color());
+
+                    painter.setPen(pen);
 
-                        int cny = track_height() - 6;
+                    QRect box(x, y, xmax - x + 1, h + 2);
+                    while (t < trig.tick_end() && t <= tick_r)
+                    {
                         int marker_x = z().tix_to_pix(t);
-                        for (auto cev = s->cbegin(); ! s->cend(cev); ++cev)
+                        if (! nc.nc_notes.empty())
                         {
-                            sequence::note_info ni;
-                            sequence::draw dt = s->get_next_note(ni, cev);
-                            if (dt == sequence::draw::finish)
-                                break;
-
-                            midipulse tick_s = ni.start();
-                            int sx = tick_s * lenw / lens + marker_x;
-                            if (dt == sequence::draw::tempo)
-                            {
-                                midibpm max = usr().midi_bpm_maximum();
-                                midibpm min = usr().midi_bpm_minimum();
-                                double tempo = double(ni.velocity());
-                                int yt = int(cny * (max-tempo) / (max-min)) + y;
-                                if (sx < x)
-                                    sx = x;
-
-                                if (sx <= xmax)
-                                    painter.drawEllipse(sx, yt, 3, 3);
-                            }
-                            else
-                            {
-                                midipulse tick_f = ni.finish();
-                                int note_y =
-                                (
-                                    cny - (cny * (ni.note() - note0)) / height
-                                ) + 1 + y;
-                                int fx = tick_f * lenw / lens + marker_x;
-                                if (sequence::is_draw_note_onoff(dt))
-                                    fx = sx + 1;
-
-                                if (fx <= sx)
-                                    fx = sx + 1;
-
-                                if (sx < x)
-                                    sx = x;
-
-                                if (fx > xmax)
-                                    fx = xmax;
-
-                                if (fx >= x && sx <= xmax)
-                                    painter.drawLine(sx, note_y, fx, note_y);
-                            }
+                            painter.save();
+                            painter.setClipRect(box & r);
+                            painter.translate(marker_x, y);
+                            painter.drawLines
+                            (
+                                nc.nc_notes.data(), int(nc.nc_notes.size())
+                            );
+                            painter.restore();
+                        }
+                        for (const auto & p : nc.nc_tempos)
+                        {
+                            int sx = p.x() + marker_x;
+                            if (sx < x)
+                                sx = x;
+
+                            if (sx <= xmax)
+                                painter.drawEllipse(sx, p.y() + y, 3, 3);
                         }
                         t += lens;
                     }
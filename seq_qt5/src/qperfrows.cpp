@@ -0,0 +1,213 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qperfrows.cpp
+ *
+ *  This module defines the row model of the names column of the song
+ *  editor.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  See qperfrows.hpp for the reasons for this module.
+ */
+
+#include "play/performer.hpp"           /* seq66::performer class           */
+#include "play/setmaster.hpp"           /* seq66::setmaster::Size()         */
+#include "qperfrows.hpp"                /* seq66::qperfrows class           */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+qperfrows::row::row () :
+    m_stamp         (0),
+    m_active        (false),
+    m_muted         (false),
+    m_color         (0),
+    m_measures      (0),
+    m_triggers      (0),
+    m_name          (),
+    m_label         (),
+    m_set_name      ()
+{
+    // no code
+}
+
+/**
+ *  Compares the data drawn, ignoring the stamp.
+ */
+
+bool
+qperfrows::row::operator == (const row & rhs) const
+{
+    return
+    (
+        m_active == rhs.m_active && m_muted == rhs.m_muted &&
+        m_color == rhs.m_color && m_measures == rhs.m_measures &&
+        m_triggers == rhs.m_triggers && m_name == rhs.m_name &&
+        m_label == rhs.m_label && m_set_name == rhs.m_set_name
+    );
+}
+
+qperfrows::qperfrows (const performer & p) :
+    m_perf          (p),
+    m_rows          (),
+    m_stamp         (1),
+    m_generation    (generation())
+{
+    // no code
+}
+
+/**
+ *  Makes every row stale, for the changes that no counter covers, such as
+ *  the renaming of a set, or a new song.
+ */
+
+void
+qperfrows::invalidate ()
+{
+    if (++m_stamp == 0)
+        m_stamp = 1;                    /* 0 is the stamp of a new row      */
+
+    m_generation = generation();
+}
+
+/**
+ *  Makes every row stale if a pattern, a trigger, or the performer has
+ *  changed since the last check.  This is only the reading of a few
+ *  counters, so it can be done at each tick of a timer.
+ *
+ * \return
+ *      Returns true if something changed, so that the caller can look for
+ *      the rows to repaint with changed().
+ */
+
+bool
+qperfrows::check ()
+{
+    unsigned g = generation();
+    bool result = g != m_generation;
+    if (result)
+        invalidate();
+
+    return result;
+}
+
+/**
+ *  Gets a row, reading it again if it is stale.
+ *
+ * \param seqno
+ *      The pattern number of the row, 0 or more.
+ */
+
+const qperfrows::row &
+qperfrows::get (seq::number seqno)
+{
+    std::size_t index = std::size_t(seqno);
+    if (index >= m_rows.size())
+        m_rows.resize(index + 1);
+
+    row & r = m_rows[index];
+    if (r.m_stamp != m_stamp)
+        refresh(r, seqno);
+
+    return r;
+}
+
+/**
+ *  Reads a stale row again, and tells if its data changed.  A row never
+ *  read counts as changed.
+ *
+ * \param seqno
+ *      The pattern number of the row, 0 or more.
+ *
+ * \return
+ *      Returns true if the row needs to be repainted.
+ */
+
+bool
+qperfrows::changed (seq::number seqno)
+{
+    std::size_t index = std::size_t(seqno);
+    bool result = index >= m_rows.size() || m_rows[index].m_stamp == 0;
+    if (! result && m_rows[index].m_stamp != m_stamp)
+    {
+        row old = m_rows[index];
+        result = get(seqno) != old;
+    }
+    return result;
+}
+
+/**
+ *  The sum of the change counters that cover the data of the rows.  Only
+ *  equality matters.  Names, colors, lengths, and song mutes go through
+ *  sequence::set_dirty() or set_dirty_mp(); the trigger counts through the
+ *  trigger generation; a new or removed pattern through the update
+ *  generation.
+ */
+
+unsigned
+qperfrows::generation () const
+{
+    return sequence::change_generation() +
+        m_perf.update_generation() + m_perf.trigger_generation();
+}
+
+/**
+ *  Reads the data of a row from its pattern, and from its set if it is the
+ *  first row of the set.
+ */
+
+void
+qperfrows::refresh (row & r, seq::number seqno)
+{
+    int setsize = setmaster::Size();
+    r = row();
+    r.m_stamp = m_stamp;
+    if ((seqno % setsize) == 0)
+        r.m_set_name = m_perf.set_name(seqno / setsize);
+
+    const seq::pointer s = m_perf.get_sequence(seqno);
+    r.m_active = bool(s);
+    if (r.m_active)
+    {
+        r.m_muted = s->get_song_mute();
+        r.m_color = s->color();
+        r.m_measures = s->measures();
+        r.m_triggers = s->trigger_count();
+        r.m_name = s->name();
+        r.m_label = m_perf.sequence_label(*s);
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * qperfrows.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
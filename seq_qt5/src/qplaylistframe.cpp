@@ -26,12 +26,14 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-09-04
- * \updates       2023-09-07
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  */
 
+#include <QAbstractTableModel>
 #include <QErrorMessage>                /* QErrorMessage                    */
+#include <QHeaderView>
 #include <QKeyEvent>                    /* Needed for QKeyEvent::accept()   */
 #include <QTimer>
 
@@ -65,6 +67,109 @@ static const int c_playlist_table_fix   = 24; // 48
 
 static const int c_playlist_row_height  = 18;
 
+/**
+ *  The model of the playlist table or the song table.  Each cell is read
+ *  from the performer's playlist when the view shows it.  Unlike the old
+ *  table filling, reading the songs no longer selects each song in turn.
+ *  It adds no signals or slots, so it needs no Q_OBJECT.
+ */
+
+class qplaylistmodel final : public QAbstractTableModel
+{
+
+private:
+
+    performer & m_performer;
+    bool m_is_playlist;                 /* else it shows the songs          */
+    int m_rows;
+
+public:
+
+    qplaylistmodel (performer & p, bool isplaylist, QObject * parent) :
+        QAbstractTableModel (parent),
+        m_performer         (p),
+        m_is_playlist       (isplaylist),
+        m_rows              (0)
+    {
+        // no code
+    }
+
+    virtual int rowCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : m_rows ;
+    }
+
+    virtual int columnCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : 2 ;
+    }
+
+    virtual QVariant data (const QModelIndex & index, int role) const override;
+    virtual QVariant headerData
+    (
+        int section, Qt::Orientation orientation, int role
+    ) const override;
+
+    void reload ();
+
+};
+
+QVariant
+qplaylistmodel::data (const QModelIndex & index, int role) const
+{
+    QVariant result;
+    if (index.isValid() && role == Qt::DisplayRole)
+    {
+        int midinumber = 0;
+        std::string name;
+        bool ok = m_is_playlist ?
+            m_performer.playlist_item(index.row(), midinumber, name) :
+            m_performer.song_item(index.row(), midinumber, name) ;
+
+        if (ok)
+        {
+            if (index.column() == 0)
+                result = QString::number(midinumber);
+            else
+                result = qt(name);
+        }
+    }
+    return result;
+}
+
+QVariant
+qplaylistmodel::headerData
+(
+    int section, Qt::Orientation orientation, int role
+) const
+{
+    QVariant result;
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+    {
+        if (section == 0)
+            result = QString("#");
+        else if (section == 1)
+            result = QString(m_is_playlist ?
+                "Playlist Names" : "Song Files in List");
+    }
+    return result;
+}
+
+/**
+ *  A new playlist file, or a new current playlist, replaces every row, so
+ *  the model is always reset.  This also clears the current row, so that
+ *  selecting a row afterward always emits currentRowChanged().
+ */
+
+void
+qplaylistmodel::reload ()
+{
+    beginResetModel();
+    m_rows = m_is_playlist ? m_performer.playlist_count() :
+        m_performer.song_count() ;
+    endResetModel();
+}
+
 /**
  *  Principal constructor.
  */
@@ -78,16 +183,16 @@ qplaylistframe::qplaylistframe
     QFrame                  (frameparent),
     ui                      (new Ui::qplaylistframe),
     m_timer                 (nullptr),
+    m_list_model            (new qplaylistmodel(p, true, this)),
+    m_song_model            (new qplaylistmodel(p, false, this)),
     m_performer             (p),
     m_parent                (window),
     m_current_list_index    (0),
     m_current_song_index    (0)
 {
     ui->setupUi(this);
-
-    QStringList playcolumns;
-    playcolumns << "#" << "Playlist Names";
-    ui->tablePlaylistSections->setHorizontalHeaderLabels(playcolumns);
+    ui->tablePlaylistSections->setModel(m_list_model);
+    ui->tablePlaylistSongs->setModel(m_song_model);
     ui->tablePlaylistSections->setSelectionBehavior
     (
         QAbstractItemView::SelectRows   /* QAbstractItemView::SelectItems   */
@@ -96,10 +201,6 @@ qplaylistframe::qplaylistframe
     (
         QAbstractItemView::SingleSelection
     );
-
-    QStringList songcolumns;
-    songcolumns << "#" << "Song Files in List";
-    ui->tablePlaylistSongs->setHorizontalHeaderLabels(songcolumns);
     ui->tablePlaylistSongs->setSelectionBehavior(QAbstractItemView::SelectRows);
     ui->tablePlaylistSongs->setSelectionMode
     (
@@ -109,13 +210,15 @@ qplaylistframe::qplaylistframe
     set_column_widths();
     connect
     (
-        ui->tablePlaylistSections, SIGNAL(currentCellChanged(int, int, int, int)),
-        this, SLOT(slot_list_click_ex(int, int, int, int))
+        ui->tablePlaylistSections->selectionModel(),
+        SIGNAL(currentRowChanged(const QModelIndex &, const QModelIndex &)),
+        this, SLOT(slot_list_click_ex(const QModelIndex &))
     );
     connect
     (
-        ui->tablePlaylistSongs, SIGNAL(currentCellChanged(int, int, int, int)),
-        this, SLOT(slot_song_click_ex(int, int, int, int))
+        ui->tablePlaylistSongs->selectionModel(),
+        SIGNAL(currentRowChanged(const QModelIndex &, const QModelIndex &)),
+        this, SLOT(slot_song_click_ex(const QModelIndex &))
     );
     connect
     (
@@ -335,19 +438,15 @@ qplaylistframe::conditional_update ()
 }
 
 /**
- *  Sets the height of the rows in the list and song tables.
+ *  Sets the height of the rows in the list and song tables, including rows
+ *  added later.
  */
 
 void
 qplaylistframe::set_row_heights (int height)
 {
-    const int prows = ui->tablePlaylistSections->rowCount();
-    for (int pr = 0; pr < prows; ++pr)
-        ui->tablePlaylistSections->setRowHeight(pr, height);
-
-    const int rows = ui->tablePlaylistSongs->rowCount();
-    for (int sr = 0; sr < rows; ++sr)
-        ui->tablePlaylistSongs->setRowHeight(sr, height);
+    ui->tablePlaylistSections->verticalHeader()->setDefaultSectionSize(height);
+    ui->tablePlaylistSongs->verticalHeader()->setDefaultSectionSize(height);
 }
 
 /**
@@ -496,148 +595,34 @@ qplaylistframe::set_current_song ()
 }
 
 /**
- *  Retrieves the table cell at the given row and column.
- *
- * \param isplaylist
- *      If true, this call affects the play-list table.  Otherwise, it affects
- *      the song-list table.
- *
- * \param row
- *      The row number, which should be in range.
- *
- * \param col
- *      The column enumeration value, which will be in range.
- *
- * \return
- *      Returns a pointer the table widget-item for the given row and column.
- *      If out-of-range, a null pointer is returned.
- */
-
-QTableWidgetItem *
-qplaylistframe::cell (bool isplaylist, int row, column_id_t col)
-{
-    int column = int(col);
-    QTableWidget * listptr = isplaylist ?
-        ui->tablePlaylistSections : ui->tablePlaylistSongs ;
-
-    QTableWidgetItem * result = listptr->item(row, column);
-    if (is_nullptr(result))
-    {
-        /*
-         * Will test row/column and maybe add rows on the fly later.
-         */
-
-        result = new QTableWidgetItem;
-        listptr->setItem(row, column, result);
-    }
-    return result;
-}
-
-/**
- *  Adds the list of playlists to the tablePlaylistSections table-widget.  It
- *  does not select a play-list or select a song.  To be called only when
- *  loading a new play-list, as in reset_playlist().  Only acts if the list is
- *  non-empty.
+ *  Shows the list of playlists in the tablePlaylistSections table.  It does
+ *  not select a play-list or select a song, nor, now that the model reads
+ *  the playlists itself, does it change the current play-list.  To be called
+ *  only when loading a new play-list, as in reset_playlist().
  */
 
 void
 qplaylistframe::fill_playlists ()
 {
-    int rows = perf().playlist_count();
-    if (rows > 0)
+    m_list_model->reload();
+    if (perf().playlist_count() == 0)
     {
-        ui->tablePlaylistSections->clearContents();
-        ui->tablePlaylistSections->setRowCount(rows);
-        for (int r = 0; r < rows; ++r)
-        {
-            std::string temp;
-            QTableWidgetItem * qtip = cell(true, r, CID_MIDI_NUMBER);
-            ui->tablePlaylistSections->setRowHeight(r, c_playlist_row_height);
-            if (not_nullptr(qtip))
-            {
-                int midinumber = perf().playlist_midi_number();
-                temp = std::to_string(midinumber);
-                qtip->setText(qt(temp));
-            }
-            qtip = cell(true, r, CID_ITEM_NAME);
-            if (not_nullptr(qtip))
-            {
-                temp = perf().playlist_name();
-                qtip->setText(qt(temp));
-            }
-
-            /*
-             * Load the next list.  The false means "don't load the song", and
-             * the true means "we're loading the playlist, so go to the next
-             * playlist even if not active."
-             */
-
-            if (! perf().open_next_list(false, true))
-                break;
-        }
-
-        /*
-         * Only when list selected: ui->buttonPlaylistRemove->setEnabled(true);
-         * Only when song selected: ui->buttonSongRemove->setEnabled(true);
-         */
-    }
-    else
-    {
-        /*
-         * This call cleans out the grid.
-         *
-         * ui->tablePlaylistSections->setRowCount(0);
-         */
-
-        ui->tablePlaylistSections->clearContents();
         ui->buttonPlaylistRemove->setEnabled(false);
         ui->buttonSongRemove->setEnabled(false);
     }
 }
 
 /**
- *  Adds the songs of the current playlist to the tablePlaylistSongs
- *  table-widget.  It does not select any song.
+ *  Shows the songs of the current playlist in the tablePlaylistSongs table.
+ *  It does not select any song.
  */
 
 void
 qplaylistframe::fill_songs ()
 {
-    int rows = perf().song_count();
-    if (rows > 0)
+    m_song_model->reload();
+    if (perf().song_count() == 0)
     {
-        ui->tablePlaylistSongs->clearContents();
-        ui->tablePlaylistSongs->setRowCount(rows);
-        for (int r = 0; r < rows; ++r)
-        {
-            std::string temp;
-            if (perf().open_select_song_by_index(r, false))
-            {
-                QTableWidgetItem * qtip = cell(false, r, CID_MIDI_NUMBER);
-                ui->tablePlaylistSongs->setRowHeight
-                (
-                    r, c_playlist_row_height
-                );
-                if (not_nullptr(qtip))
-                {
-                    int midinumber = perf().song_midi_number();
-                    temp = std::to_string(midinumber);
-                    qtip->setText(qt(temp));
-                }
-                qtip = cell(false, r, CID_ITEM_NAME);
-                if (not_nullptr(qtip))
-                {
-                    temp = perf().song_filename();
-                    qtip->setText(qt(temp));
-                }
-            }
-            else
-                break;
-        }
-    }
-    else
-    {
-        ui->tablePlaylistSongs->clearContents();
         ui->editSongPath->setText("");
 #if defined USE_SONG_NUMBER_TEXTEDIT
         ui->editSongNumber->setText("0");
@@ -671,17 +656,14 @@ qplaylistframe::load_playlist (const std::string & fullfilespec)
 }
 
 /**
- *  Weird, this function sometimes receives a row of -1, even when
- *  ui->tablePlaylistSections->clearContents() is called.  We ignore this
- *  happenstance without showing a message.
+ *  This function receives a row of -1 when the model is reset and the
+ *  current row is cleared.  We ignore this without showing a message.
  */
 
 void
-qplaylistframe::slot_list_click_ex
-(
-    int row, int /*column*/, int /*prevrow*/, int /*prevcolumn*/
-)
+qplaylistframe::slot_list_click_ex (const QModelIndex & current)
 {
+    int row = current.row();
     if (row >= 0)
     {
         m_current_list_index = row;
@@ -697,17 +679,13 @@ qplaylistframe::slot_list_click_ex
 }
 
 /**
- *  Weird, this function sometimes receives a row of -1, even when
- *  ui->tablePlaylistSongs->clearContents() is called.  We ignore this
- *  happenstance without showing a message.
+ *  See slot_list_click_ex().
  */
 
 void
-qplaylistframe::slot_song_click_ex
-(
-    int row, int /*column*/, int /*prevrow*/, int /*prevcolumn*/
-)
+qplaylistframe::slot_song_click_ex (const QModelIndex & current)
 {
+    int row = current.row();
     if (row >= 0)
     {
         m_current_song_index = row;
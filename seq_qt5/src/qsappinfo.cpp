@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2023-08-21
- * \updates       2025-01-25
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This module supports a task similar to that of the Help / Tutorial menu
@@ -42,9 +42,12 @@
  *  flexibly select the document folder, and then write a function
  *  to read the desired file into a string.
  *
+ *  The first reserved button shows the memory held by the song data, read
+ *  from performer::memory_usage() each time it is clicked.
  */
 
 #include "cfg/settings.hpp"             /* seq66::open_share_doc_file()     */
+#include "play/performer.hpp"           /* seq66::performer::memory_usage() */
 #include "qsappinfo.hpp"                /* seq66::qsappinfo dialog class    */
 #include "qt5_helpers.hpp"              /* seq66::qt() string conversion    */
 
@@ -79,12 +82,14 @@ static const std::string s_error_html
  *  Principal constructor.
  */
 
-qsappinfo::qsappinfo (QWidget * parent) :
-    QDialog (parent),
-    ui      (new Ui::qsappinfo)
+qsappinfo::qsappinfo (const performer & p, QWidget * parent) :
+    QDialog         (parent),
+    ui              (new Ui::qsappinfo),
+    m_performer     (p)
 {
     ui->setupUi(this);
-    ui->buttonReserved_1->hide();
+    ui->buttonReserved_1->setText("Memory Usage");
+    ui->buttonReserved_1->setEnabled(true);
     ui->buttonReserved_2->hide();
     slot_common_keys();
     connect
@@ -117,6 +122,11 @@ qsappinfo::qsappinfo (QWidget * parent) :
         ui->buttonMutesKeys, SIGNAL(clicked(bool)),
         this, SLOT(slot_mutes_keys())
     );
+    connect
+    (
+        ui->buttonReserved_1, SIGNAL(clicked(bool)),
+        this, SLOT(slot_memory_usage())
+    );
 }
 
 qsappinfo::~qsappinfo ()
@@ -176,6 +186,39 @@ qsappinfo::slot_mutes_keys ()
     open_html("mute_group_keys", "Grid Mute-Group Keys");
 }
 
+/**
+ *  Shows the memory held by each category of song data, as a table.  The
+ *  figures are estimates; see memoryusage.
+ */
+
+void
+qsappinfo::slot_memory_usage ()
+{
+    using cat = memoryusage::category;
+    memoryusage mu = m_performer.memory_usage();
+    std::string html
+    {
+        "<html><head><meta charset=\"utf-8\" /></head><body>"
+        "<table cellpadding=\"3\">"
+        "<tr><th align=\"left\">Category</th>"
+        "<th align=\"right\">KiB</th></tr>"
+    };
+    for (int c = 0; c < static_cast<int>(cat::max); ++c)
+    {
+        cat category = static_cast<cat>(c);
+        std::size_t kib = (mu.bytes(category) + 1023) / 1024;
+        html += "<tr><td>" + memoryusage::name(category) + "</td>";
+        html += "<td align=\"right\">" + std::to_string(kib) + "</td></tr>";
+    }
+    html += "<tr><td><b>total</b></td><td align=\"right\"><b>";
+    html += std::to_string((mu.total() + 1023) / 1024);
+    html += "</b></td></tr></table>";
+    html += "<p>" + std::to_string(mu.patterns()) + " patterns.</p>";
+    html += "</body></html>";
+    ui->textBrowser->setHtml(qt(html));
+    ui->appPanelLabel->setText("Memory Usage");
+}
+
 }               // namespace seq66
 
 /*
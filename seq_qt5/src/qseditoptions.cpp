@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2025-01-26
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *      This version is located in Edit / Preferences.
@@ -50,6 +50,7 @@
 
 #include <QButtonGroup>
 
+#include "cfg/hotsettings.hpp"          /* seq66::publish_hot_settings()    */
 #include "midi/jack_assistant.hpp"      /* seq66::jack_assistant statics    */
 #include "os/daemonize.hpp"             /* seq66::signal_for_restart()      */
 #include "play/performer.hpp"           /* seq66::performer class           */
@@ -2510,6 +2511,7 @@ qseditoptions::reset ()
 {
     rc() = m_backup_rc;
     usr() = m_backup_usr;
+    publish_hot_settings();
     reload_needed(false);
 }
 
@@ -3403,6 +3405,7 @@ qseditoptions::modify_rc ()
         ui->checkBoxSaveRc->setChecked(true);
         rc().auto_rc_save(true);
         rc().modify();
+        publish_hot_settings();             /* what the RT threads read     */
         reload_needed(true);
     }
 }
@@ -26,7 +26,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2023-11-24
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The data pane is the drawing-area below the seqedit's event area, and
@@ -35,6 +35,7 @@
  */
 
 #include "cfg/settings.hpp"             /* seq66::usr() config functions    */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
 #include "play/performer.hpp"           /* seq66::performer class           */
 #include "qseqdata.hpp"                 /* seq66::qseqdata class            */
 #include "qseqeditframe64.hpp"          /* seq66::qseqeditframe64 class     */
@@ -127,7 +128,13 @@ qseqdata::qseqdata
     m_drag_handle           (false),
     m_mouse_tick            (-1),
     m_handle_delta          (z().pix_to_tix(s_handle_delta)),
-    m_dragging              (false)
+    m_dragging              (false),
+    m_summary               (),
+    m_summary_valid         (false),
+    m_summary_status        (0),
+    m_summary_cc            (0),
+    m_summary_generation    (0),
+    m_region_generation     (0)
 {
     setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
     setMouseTracking(true);                     /* no click needed          */
@@ -155,13 +162,29 @@ qseqdata::~qseqdata ()
 /**
  *  In an effort to reduce CPU usage when simply idling, this function calls
  *  update() only if necessary.  See qseqbase::dirty().
+ *
+ *  An edit of only part of the pattern (see sequence::dirty_region())
+ *  repaints only the ticks it covers, with room for the handles and the
+ *  value digits drawn to the right of each event.
  */
 
 void
 qseqdata::conditional_update ()
 {
-    if (check_dirty())
+    sequence::region r;
+    bool partial = track().dirty_region(m_region_generation, r);
+    if (check_dirty() || ! partial)
+    {
         update();
+    }
+    else if (! sequence::region_empty(r))
+    {
+        int x0 = z().tix_to_pix(r.r_start) + m_keyboard_padding_x;
+        int x1 = z().tix_to_pix(r.r_finish) + m_keyboard_padding_x;
+        x0 -= 2 * s_handle_d;
+        x1 += 2 * s_handle_d + sc_text_spacing * 4;
+        update(QRect(x0, 0, x1 - x0 + 1, height()));
+    }
 }
 
 bool
@@ -202,12 +225,125 @@ qseqdata::wheelEvent (QWheelEvent * qwep)
 }
 
 /**
- *  We create an iterator and use sequence::get_next_event_match().
+ *  Summarizes the continuous events that match the status and controller
+ *  being shown.
+ */
+
+void
+qseqdata::build_summary ()
+{
+    m_summary.clear();
+    m_summary_valid = true;
+    m_summary_status = m_status;
+    m_summary_cc = m_cc;
+    m_summary_generation = track().redraw_generation();
+    track().draw_lock();
+    for (auto cev = track().cbegin(); ! track().cend(cev); ++cev)
+    {
+        if (! track().get_next_event_match(m_status, m_cc, cev))
+            break;
+
+        if (cev->is_continuous_event())
+        {
+            midibyte d0, d1;
+            cev->get_data(d0, d1);
+
+            int value = event::is_one_byte_msg(m_status) ? d0 : d1 ;
+            midipulse tick = cev->timestamp();
+            m_summary.add(tick, tick, value, cev->is_selected());
+        }
+    }
+    track().draw_unlock();
+    m_summary.build();
+}
+
+/**
+ *  Rebuilds the summary if the status or controller shown, or the pattern,
+ *  has changed since it was built.
+ */
+
+void
+qseqdata::refresh_summary ()
+{
+    bool stale = ! m_summary_valid ||
+        m_summary_status != m_status || m_summary_cc != m_cc ||
+        m_summary_generation != track().redraw_generation();
+
+    if (stale)
+        build_summary();
+}
+
+/**
+ *  Tells if the lane shown has more events than the pattern has pixels,
+ *  as does a mod-wheel or aftertouch sweep recorded from a controller.
+ *  Then the event lines are drawn over each other, at great cost, even
+ *  when the view is not zoomed out, and the summary is drawn instead.
+ */
+
+bool
+qseqdata::dense_lane ()
+{
+    refresh_summary();
+    if (m_summary.empty())
+        return false;
+
+    int pixels = z().tix_to_pix(track().get_length());
+    return m_summary.level(0).size() > std::size_t(pixels > 0 ? pixels : 1);
+}
+
+/**
+ *  Draws one data line per pixel bucket of the summary, for the part of
+ *  the pattern that is exposed.  The range of the values in the bucket,
+ *  from the smallest to the largest, is drawn in full color, and the line
+ *  below it in a lighter color, so that a dense sweep shows the same shape
+ *  as the events would, with their jitter.
+ */
+
+void
+qseqdata::draw_summary (QPainter & painter, const QRect & r)
+{
+    refresh_summary();
+    if (m_summary.empty())
+        return;
+
+    int left = r.x() - m_keyboard_padding_x;
+    midipulse start_tick = z().pix_to_tix(left > 0 ? left : 0);
+    midipulse end_tick = z().pix_to_tix(r.right() + 1);
+    int lvl = m_summary.level_for(z().pix_to_tix(1));
+    const eventsummary::spans & spans = m_summary.level(lvl);
+    QPen pen(fore_color());
+    pen.setWidth(2);
+    for (auto sp = m_summary.first(lvl, start_tick); sp != spans.cend(); ++sp)
+    {
+        if (sp->sp_start > end_tick)
+            break;
+
+        int event_x = z().tix_to_pix(sp->sp_start) + m_keyboard_padding_x - 3;
+        int ymax = height() - byte_height(m_dataarea_y, sp->sp_max);
+        int ymin = height() - byte_height(m_dataarea_y, sp->sp_min);
+        QColor c = sp->sp_selected ? sel_paint() : fore_color();
+        QColor light = c;
+        light.setAlpha(96);
+        pen.setColor(light);
+        painter.setPen(pen);
+        painter.drawLine(event_x, ymin, event_x, height());
+        pen.setColor(c);
+        painter.setPen(pen);
+        painter.drawLine(event_x, ymax, event_x, ymin);
+    }
+}
+
+/**
+ *  We create an iterator and use sequence::get_next_event_match().  When
+ *  zoomed far out, or when the lane has more events than pixels, the
+ *  controller or velocity lines are drawn from the summary instead, one
+ *  per pixel bucket, without the values.
  */
 
 void
 qseqdata::paintEvent (QPaintEvent * qpep)
 {
+    trace_scope ts("qseqdata paint");
     QRect r = qpep->rect();
     QPainter painter(this);
     QBrush brush(backdata_paint(), Qt::SolidPattern);
@@ -221,8 +357,19 @@ qseqdata::paintEvent (QPaintEvent * qpep)
     midipulse start_tick = z().pix_to_tix(r.x());
     midipulse end_tick = start_tick + z().pix_to_tix(r.width());
     int text_y = sc_text_spacing;
+    bool lod = m_data_type == type::note || is_pitchbend();
+    if (lod)
+        lod = summarized() || dense_lane();
+
+    if (lod)
+        draw_summary(painter, r);
+
     track().draw_lock();
-    for (auto cev = track().cbegin(); ! track().cend(cev); ++cev)
+    for
+    (
+        auto cev = track().cbegin(start_tick);
+        ! lod && ! track().cend(cev, end_tick); ++cev
+    )
     {
         if (! track().get_next_event_match(m_status, m_cc, cev))
             break;
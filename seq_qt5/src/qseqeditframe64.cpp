@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-15
- * \updates       2025-01-14
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The data pane is the drawing-area below the seqedit's event area, and
@@ -94,6 +94,7 @@
 #include <QScrollBar>
 
 #include "midi/controllers.hpp"         /* seq66::controller_name()         */
+#include "play/editjob.hpp"             /* seq66::editjob worker edits      */
 #include "play/performer.hpp"           /* seq66::performer reference       */
 #include "util/strfunctions.hpp"        /* seq66::string_to_int()           */
 #include "qlfoframe.hpp"                /* seq66::qlfoframe dialog class    */
@@ -1450,7 +1451,11 @@ qseqeditframe64::on_sequence_change
             }
         }
         set_external_frame_title(modification);
-        set_dirty();
+        if (modification || ! track().partial_change())
+            set_dirty();
+        else if (not_nullptr(m_seqevent))
+            m_seqevent->set_dirty();            /* roll & data use regions  */
+
         update_midi_buttons();                  /* mirror current states    */
     }
     return result;
@@ -2917,7 +2922,7 @@ qseqeditframe64::inverse_note_selection ()
 void
 qseqeditframe64::quantize_notes ()
 {
-    track().push_quantize_notes(1);
+    (void) quantize_job(1);
 }
 
 /**
@@ -2927,7 +2932,31 @@ qseqeditframe64::quantize_notes ()
 void
 qseqeditframe64::tighten_notes ()
 {
-    track().push_quantize_notes(2);
+    (void) quantize_job(2);
+}
+
+/**
+ *  Quantizes or tightens the selected notes on a worker thread (see the
+ *  editjob class), so that a long pattern does not freeze the editor.  The
+ *  undo is pushed when the result is swapped in.
+ *
+ * \param divide
+ *      1 to quantize, 2 to tighten.
+ *
+ * \return
+ *      Returns true if notes were changed.
+ */
+
+bool
+qseqeditframe64::quantize_job (int divide)
+{
+    editjob job
+    (
+        perf().get_sequence(track().seq_number()),
+        divide == 2 ? "Tightening notes" : "Quantizing notes",
+        [divide] (sequence & s) { return s.quantize_notes(divide); }
+    );
+    return qt_run_edit(this, job);
 }
 
 /**
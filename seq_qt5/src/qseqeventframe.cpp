@@ -26,13 +26,16 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-13
- * \updates       2023-12-09
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class is the "Event Editor".
  */
 
+#include <QHeaderView>
 #include <QKeyEvent>                    /* Needed for QKeyEvent::accept()   */
+#include <QResizeEvent>
+#include <QScrollBar>
 
 #include "cfg/settings.hpp"             /* SEQ66_QMAKE_RULES indirectly     */
 #include "midi/controllers.hpp"         /* seq66::controller_name(), etc.   */
@@ -192,6 +195,11 @@ qseqeventframe::qseqeventframe
         ui->eventTableWidget, SIGNAL(clicked(const QModelIndex &)),
         this, SLOT(slot_row_selected())
     );
+    connect
+    (
+        ui->eventTableWidget->verticalScrollBar(), SIGNAL(valueChanged(int)),
+        this, SLOT(slot_table_scrolled(int))
+    );
     ui->button_link->setChecked(m_linked_selection);
     connect
     (
@@ -641,12 +649,20 @@ qseqeventframe::on_sequence_change
     return result;
 }
 
+/**
+ *  Sets the height of all rows, including ones added later, by making it
+ *  the fixed default height of the vertical header.  Setting the height of
+ *  each row in turn made the table layout again for each row, which took
+ *  many seconds for a large pattern.
+ */
+
 void
 qseqeventframe::set_row_heights (int height)
 {
-    const int rows = ui->eventTableWidget->rowCount();
-    for (int r = 0; r < rows; ++r)
-        ui->eventTableWidget->setRowHeight(r, height);  /* set_row_height() */
+    QHeaderView * vh = ui->eventTableWidget->verticalHeader();
+    vh->setMinimumSectionSize(height);
+    vh->setDefaultSectionSize(height);
+    vh->setSectionResizeMode(QHeaderView::Fixed);
 }
 
 /**
@@ -676,7 +692,9 @@ qseqeventframe::set_column_widths (int total_width)
 }
 
 /**
- *  Clears, then refills the event table from the qseventslots object.
+ *  Clears, then refills the event table from the qseventslots object.  Only
+ *  the rows that are shown are filled; the rest are filled as they are
+ *  scrolled into view.  See load_visible_rows().
  */
 
 bool
@@ -691,9 +709,11 @@ qseqeventframe::initialize_table ()
         {
             ui->eventTableWidget->clearContents();
             ui->eventTableWidget->setRowCount(rows);
-            set_row_heights(sc_event_row_height);
             if (m_eventslots->load_table())
+            {
+                load_visible_rows();
                 m_eventslots->select_event(0);      /* first row */
+            }
 
             ui->button_clear->setEnabled(true);
         }
@@ -701,7 +721,6 @@ qseqeventframe::initialize_table ()
         {
             ui->eventTableWidget->clearContents();
             ui->eventTableWidget->setRowCount(s_default_rows);
-            set_row_heights(sc_event_row_height);
             ui->button_clear->setEnabled(false);
             ui->button_del->setEnabled(false);
             ui->button_modify->setEnabled(false);
@@ -711,6 +730,41 @@ qseqeventframe::initialize_table ()
     return result;
 }
 
+/**
+ *  Fills the rows in the visible part of the table that have not been
+ *  filled yet.  A row that has been filled has an item in its first
+ *  column.  Rows inserted or modified are filled by the editing code.
+ */
+
+void
+qseqeventframe::load_visible_rows ()
+{
+    if (not_nullptr(m_eventslots) && ! m_eventslots->empty())
+    {
+        QTableWidget * table = ui->eventTableWidget;
+        int rows = table->rowCount();
+        int first = table->rowAt(0);
+        int last = table->rowAt(table->viewport()->height() - 1);
+        if (first < 0)
+            first = 0;
+
+        if (last < 0 || last >= rows)
+            last = rows - 1;
+
+        for (int row = first; row <= last; ++row)
+        {
+            if (is_nullptr(table->item(row, 0)))
+                (void) m_eventslots->load_row(row);
+        }
+    }
+}
+
+void
+qseqeventframe::slot_table_scrolled (int /*value*/)
+{
+    load_visible_rows();
+}
+
 std::string
 qseqeventframe::make_seq_title ()
 {
@@ -1446,6 +1500,17 @@ qseqeventframe::keyReleaseEvent (QKeyEvent * event)
     event->accept();
 }
 
+/**
+ *  A taller table shows more rows, which may not have been filled yet.
+ */
+
+void
+qseqeventframe::resizeEvent (QResizeEvent * qrep)
+{
+    QFrame::resizeEvent(qrep);
+    load_visible_rows();
+}
+
 }           // namespace seq66
 
 /*
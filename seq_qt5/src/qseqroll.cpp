@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-12-29
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Please see the additional notes for the Gtkmm-2.4 version of this panel,
@@ -44,7 +44,9 @@
 #include <QTimer>
 
 #include "cfg/settings.hpp"             /* seq66::usr().key_height(), etc.  */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
 #include "play/performer.hpp"           /* seq66::performer class           */
+#include "qglroll.hpp"                  /* seq66::qglroll, qglrecorder      */
 #include "qseqeditframe64.hpp"          /* seq66::qseqeditframe64 class     */
 #include "qseqkeys.hpp"                 /* seq66::qseqkeys class            */
 #include "qseqroll.hpp"                 /* seq66::qseqroll class            */
@@ -79,6 +81,14 @@ namespace seq66
 static const int c_border_width     = 2;
 static const int c_pen_width        = 1;
 
+/**
+ *  The layers of the GPU view, in drawing order.
+ */
+
+static const int c_gl_grid_layer    = 0;
+static const int c_gl_notes_layer   = 1;
+static const int c_gl_overlay_layer = 2;
+
 /**
  *  Principal constructor.
  */
@@ -124,7 +134,18 @@ qseqroll::qseqroll
     m_v_zooming             (false),
     m_selection             (),
     m_last_base_note        (-1),
-    m_link_wraparound       (usr().pattern_wraparound())
+    m_link_wraparound       (usr().pattern_wraparound()),
+    m_backing               (),
+    m_backing_rect          (),
+    m_backing_mode          (mode),
+    m_backing_scroll        (),
+    m_backing_dirty         (true),
+    m_backing_patch         (),
+    m_region_generation     (0),
+    m_fore_summary          (),
+    m_back_summary          (),
+    m_gl_view               (nullptr),
+    m_gl_recorder           ()
 {
     setAttribute(Qt::WA_StaticContents);
     setAttribute(Qt::WA_OpaquePaintEvent);          /* no erase on repaint  */
@@ -136,6 +157,11 @@ qseqroll::qseqroll
     m_font.setBold(false);
     m_font.setPointSize(6);                         /* 8 is too obtrusive   */
     set_snap(track().snap());
+#if defined SEQ66_OPENGL_SUPPORT
+    m_gl_view = qglroll::make(this);
+    if (not_nullptr(m_gl_view))
+        m_gl_recorder.reset(new qglrecorder(this, QRect()));
+#endif
     show();
     m_timer = qt_timer(this, "qseqroll", 1, SLOT(conditional_update()));
 }
@@ -154,6 +180,12 @@ qseqroll::~qseqroll ()
  *  In an effort to reduce CPU usage when simply idling, this function calls
  *  update() only if necessary.  See qseqbase::check_dirty().
  *
+ *  While playing, the performer always needs an update.  If nothing else has
+ *  changed, only the strips of the old and new playhead are repainted, from
+ *  the cached static layer.  With the GPU view, a scroll also needs an
+ *  update, and the layers are recorded here, rather than in paintEvent(),
+ *  which the view covers.
+ *
  *  bool ok = track().playing();
  *  if (m_draw_whole_grid)
  */
@@ -161,14 +193,49 @@ qseqroll::~qseqroll ()
 void
 qseqroll::conditional_update ()
 {
+    bool local = is_dirty();                    /* before check_dirty()     */
+    if (track().is_dirty_edit() && ! patch_region())
+    {
+        invalidate_backing();
+        local = true;
+    }
+
     bool ok = perf().needs_update() || check_dirty();
+#if defined SEQ66_OPENGL_SUPPORT
+    if (use_gpu() && visibleRegion().boundingRect() != m_gl_view->geometry())
+        ok = true;
+#endif
+
     if (ok)
     {
 #if defined SEQ66_ALWAYS_VERIFY_AND_LINK        /* defined                  */
         if (track().recording())
             (void) track().verify_and_link();   /* refresh before update    */
 #endif
-        update();
+        if (use_gpu())
+            gpu_paint();
+        else if (local || m_backing_dirty || ! perf().is_running())
+            update();
+        else
+            update_progress();
+    }
+}
+
+/**
+ *  Repaints only the playhead, at its old and new positions.  The rest of
+ *  the roll comes unchanged from the static layer.
+ */
+
+void
+qseqroll::update_progress ()
+{
+    int oldx = progress_x();
+    int newx = xoffset(track().get_tick());
+    if (newx != oldx)
+    {
+        int w = progress_bar_width() + 2;
+        update(QRect(oldx - w, 0, 2 * w, height()));
+        update(QRect(newx - w, 0, 2 * w, height()));
     }
 }
 
@@ -193,6 +260,7 @@ qseqroll::set_dirty ()
      * of the four pattern editor frames including this one.
      */
 
+    invalidate_backing();
     qseqbase::set_dirty();
 }
 
@@ -383,37 +451,60 @@ qseqroll::set_redraw ()
  *  use the QRect of the paint-event?
  *
  *  Here, we could choose black instead white for "inverse" mode.
+ *
+ *  The grid and the notes come from the cached static layer (see
+ *  render_backing()), which covers the visible part of the widget.  Only
+ *  the playhead and the selection overlays are drawn here each time.  A
+ *  painted note renders only its own part of the static layer again (see
+ *  render_patch()).
  */
 
 void
 qseqroll::paintEvent (QPaintEvent * qpep)
 {
+    trace_scope ts("qseqroll paint");
+    if (use_gpu())
+    {
+        gpu_paint();                        /* the GPU view covers us       */
+        return;
+    }
+
     QRect r = qpep->rect();
-    QRect view(0, 0, width(), height());
+    QRect visible = visibleRegion().boundingRect().united(r);
     QPainter painter(this);
-    QBrush brush(blank_brush());    // QBrush brush(Qt::white, Qt::NoBrush);
-    QPen pen(Qt::lightGray);
-    pen.setStyle(Qt::SolidLine);
-    pen.setColor(Qt::lightGray);
-    painter.setPen(pen);
-    painter.setFont(m_font);
+    QPoint scroll(scroll_offset_x(), scroll_offset_v());
     m_frame_ticks = z().pix_to_tix(r.width());
     m_edit_mode = perf().edit_mode(track().seq_number());
+    if
+    (
+        m_backing_dirty || m_backing.isNull() ||
+        m_edit_mode != m_backing_mode || scroll != m_backing_scroll ||
+        ! m_backing_rect.contains(r)
+    )
+    {
+        render_backing(visible);
+    }
+    else if (! m_backing_patch.isEmpty())
+        render_patch();
 
-    /*
-     * Draw the border and grid. See the banner notes about width and height.
-     * Doesn't seem to be needed: painter.drawRect(0, 0, ww, wh);
-     */
-
-    draw_grid(painter, view);
-    set_initialized();
+    painter.drawPixmap(m_backing_rect.topLeft(), m_backing);  /* clipped   */
+    draw_overlays(painter, r);
+}
 
-    /*
-     * Draw the events. This currently draws all of them.  Drawing all them
-     * only needs to be drawn once.
-     */
+/**
+ *  Draws what changes at each update over the static layer:  the playhead,
+ *  and the selection box, paste box, or drag box, if any.
+ *
+ * \param r
+ *      The area being drawn, which the playhead spans vertically.
+ */
 
-    call_draw_notes(painter, view);
+void
+qseqroll::draw_overlays (QPainter & painter, const QRect & r)
+{
+    QBrush brush(blank_brush());    // QBrush brush(Qt::white, Qt::NoBrush);
+    QPen pen(Qt::lightGray);
+    painter.setFont(m_font);
     pen.setWidth(c_pen_width);
 
     /*
@@ -493,6 +584,158 @@ qseqroll::paintEvent (QPaintEvent * qpep)
     }
 }
 
+/**
+ *  Renders the static layer, the grid and the notes, for the given area of
+ *  the widget.  The painter is translated and clipped so that the drawing
+ *  code is the same as for drawing straight to the widget.
+ *
+ * \param area
+ *      The part of the widget to cover, normally the visible part.
+ */
+
+void
+qseqroll::render_backing (const QRect & area)
+{
+    QRect view(0, 0, width(), height());
+    qreal ratio = devicePixelRatioF();
+    m_backing = QPixmap(area.size() * ratio);
+    m_backing.setDevicePixelRatio(ratio);
+    m_backing_rect = area;
+    m_backing_mode = m_edit_mode;
+    m_backing_scroll = QPoint(scroll_offset_x(), scroll_offset_v());
+    m_backing_dirty = false;
+    m_backing_patch = QRect();
+    m_region_generation = track().redraw_generation();  /* all drawn now  */
+
+    QPainter painter(&m_backing);
+    QPen pen(Qt::lightGray);
+    pen.setStyle(Qt::SolidLine);
+    painter.translate(-area.topLeft());
+    painter.setClipRect(area);
+    painter.setPen(pen);
+    painter.setFont(m_font);
+
+    /*
+     * Draw the border and grid. See the banner notes about width and height.
+     * Doesn't seem to be needed: painter.drawRect(0, 0, ww, wh);
+     */
+
+    draw_grid(painter, view);
+    set_initialized();
+
+    /*
+     * Draw the events. This currently draws all of them.  Drawing all them
+     * only needs to be drawn once.
+     */
+
+    call_draw_notes(painter, view);
+}
+
+/**
+ *  Renders the grid and the notes again for the patch area of the static
+ *  layer only.  The notes are looked up from the tick at the left of the
+ *  patch, and the painter is clipped to it, so the cost does not depend on
+ *  the size of the pattern.
+ */
+
+void
+qseqroll::render_patch ()
+{
+    QRect area = m_backing_patch & m_backing_rect;
+    m_backing_patch = QRect();
+    if (! area.isEmpty())
+    {
+        QRect view(0, 0, width(), height());
+        QRect notes = area.translated(-m_keypadding_x, 0);  /* tick basis  */
+        if (notes.left() < 0)
+            notes.setLeft(0);
+
+        QPainter painter(&m_backing);
+        QPen pen(Qt::lightGray);
+        pen.setStyle(Qt::SolidLine);
+        painter.translate(-m_backing_rect.topLeft());
+        painter.setClipRect(area);
+        painter.setPen(pen);
+        painter.setFont(m_font);
+        draw_grid(painter, view);
+        call_draw_notes(painter, notes);
+    }
+}
+
+/**
+ *  The GPU version of paintEvent().  The view is moved over the visible
+ *  part of the roll.  The grid and the notes are recorded for the visible
+ *  part plus a margin of one view all around, so that a short scroll moves
+ *  only the view, and are recorded again under the same conditions as
+ *  render_backing() is called.  The qglroll uploads only the rectangles
+ *  that changed, so an edit of a few notes is cheap.  The overlays are
+ *  recorded at each update.
+ *
+ *  If the OpenGL context could not be used, the view is dropped and the
+ *  raster path takes over.
+ */
+
+void
+qseqroll::gpu_paint ()
+{
+#if defined SEQ66_OPENGL_SUPPORT
+    if (m_gl_view->failed())
+    {
+        m_gl_view->deleteLater();
+        m_gl_view = nullptr;
+        m_gl_recorder.reset();
+        invalidate_backing();
+        update();
+        return;
+    }
+
+    QRect visible = visibleRegion().boundingRect();
+    if (visible.isEmpty())
+        return;
+
+    QRect view(0, 0, width(), height());
+    QPoint scroll(scroll_offset_x(), scroll_offset_v());
+    qglrecorder & rec = *m_gl_recorder;
+    m_frame_ticks = z().pix_to_tix(visible.width());
+    m_edit_mode = perf().edit_mode(track().seq_number());
+    m_gl_view->set_view(visible);
+    if
+    (
+        m_backing_dirty || m_edit_mode != m_backing_mode ||
+        scroll != m_backing_scroll || ! m_backing_rect.contains(visible)
+    )
+    {
+        int mx = visible.width();
+        int my = visible.height();
+        m_backing_rect = visible.adjusted(-mx, -my, mx, my) & view;
+        m_backing_mode = m_edit_mode;
+        m_backing_scroll = scroll;
+        m_backing_dirty = false;
+        rec.clear(m_backing_rect);
+        {
+            QPainter painter(&rec);
+            painter.setFont(m_font);
+            draw_grid(painter, view);
+        }
+        set_initialized();
+        m_gl_view->set_layer(c_gl_grid_layer, rec);
+        rec.clear(m_backing_rect);
+        {
+            QPainter painter(&rec);
+            painter.setFont(m_font);
+            call_draw_notes(painter, view);
+        }
+        m_gl_view->set_layer(c_gl_notes_layer, rec);
+    }
+    rec.clear(visible);
+    {
+        QPainter painter(&rec);
+        draw_overlays(painter, visible);
+    }
+    m_gl_view->set_layer(c_gl_overlay_layer, rec);
+#endif
+}
+
 void
 qseqroll::call_draw_notes (QPainter & painter, const QRect & view)
 {
@@ -575,7 +818,8 @@ qseqroll::draw_grid (QPainter & painter, const QRect & r)
         painter.drawLine(r.x(), y, r.x() + r.width(), y);
         if (m_scale != scales::off)
         {
-            if (! scales_policy(m_scale, modkey))       /* scales.cpp/hpp   */
+            int note = remkeys - 1 - scroll_offset_v(); /* the row's note   */
+            if (! scales_policy(m_scale, m_key, note))  /* scales.cpp/hpp   */
             {
                 /*
                  * This color is only part of the scale-brush border.
@@ -678,9 +922,19 @@ qseqroll::draw_notes
     if (is_nullptr(s))
         return;
 
+    if (summarized())
+    {
+        draw_summary(painter, r, *s, background);
+        return;
+    }
+
     int noteheight = unit_height() - 2;     /* was "- 3"    */
     s->draw_lock();
-    for (auto cev = s->cbegin(); ! s->cend(cev); ++cev)
+    for
+    (
+        auto cev = s->cbegin(start_tick, true);
+        ! s->cend(cev, end_tick); ++cev
+    )
     {
         sequence::note_info ni;
         sequence::draw dt = s->get_next_note(ni, cev);
@@ -694,8 +948,11 @@ qseqroll::draw_notes
         bool end_in = ni.finish() >= start_tick && ni.finish() <= end_tick;
         bool not_wrapped = ni.finish() >= ni.start();
         bool linkedin = dt == sequence::draw::linked && end_in;
+        bool across = dt == sequence::draw::linked && not_wrapped &&
+            ni.start() < start_tick && ni.finish() > end_tick;
+
         bool bad = false;
-        if (start_in || linkedin)
+        if (start_in || linkedin || across)     /* across a patch, too      */
         {
             int in_shift = 0;
             int length_add = 0;
@@ -865,6 +1122,137 @@ qseqroll::draw_notes
     s->draw_unlock();
 }
 
+/**
+ *  Builds the per-row summary of the notes of a pattern.  A wrapped note
+ *  covers the end of the pattern and, if wraparound is drawn, its start.
+ *  An unlinked note-on or note-off is given the short width that
+ *  draw_notes() gives it, and is flagged.
+ */
+
+void
+qseqroll::build_summary (notesummary & ns, sequence & s)
+{
+    ns.ns_rows.assign(std::size_t(c_notes_count), eventsummary(true));
+    ns.ns_seq = &s;
+    ns.ns_generation = s.redraw_generation();
+
+    midipulse seqlength = s.get_length();
+    s.draw_lock();
+    for (auto cev = s.cbegin(); ! s.cend(cev); ++cev)
+    {
+        sequence::note_info ni;
+        sequence::draw dt = s.get_next_note(ni, cev);
+        if (dt == sequence::draw::finish)
+            break;
+
+        if (dt == sequence::draw::tempo || dt == sequence::draw::program)
+            continue;
+
+        int note = ni.note();
+        if (note < 0 || note >= c_notes_count)
+            continue;
+
+        eventsummary & row = ns.ns_rows[std::size_t(note)];
+        bool selected = ni.selected();
+        if (dt == sequence::draw::linked)
+        {
+            if (ni.finish() >= ni.start())
+            {
+                row.add(ni.start(), ni.finish(), note, selected);
+            }
+            else
+            {
+                row.add(ni.start(), seqlength, note, selected);
+                if (m_link_wraparound)
+                    row.add(0, ni.finish(), note, selected, true);
+            }
+        }
+        else
+            row.add(ni.start(), ni.start() + 16, note, selected, true);
+    }
+    s.draw_unlock();
+    for (auto & row : ns.ns_rows)
+        row.build();
+}
+
+/**
+ *  Draws the notes from the summary, with one plain box per run of notes
+ *  at the resolution of a pixel.  Only the rows and runs inside the
+ *  painter's clip area (the area of the static layer) are visited.
+ *
+ * \param painter
+ *      The painter, clipped to the area being drawn.
+ *
+ * \param r
+ *      The whole widget, as passed to draw_notes().
+ *
+ * \param s
+ *      The pattern, or the background pattern.
+ *
+ * \param background
+ *      If true, the background brush is used.
+ */
+
+void
+qseqroll::draw_summary
+(
+    QPainter & painter, const QRect & r,
+    sequence & s, bool background
+)
+{
+    notesummary & ns = background ? m_back_summary : m_fore_summary;
+    if (ns.ns_seq != &s || ns.ns_generation != s.redraw_generation())
+        build_summary(ns, s);
+
+    QRect area = r;
+    if (painter.hasClipping())
+        area &= painter.clipBoundingRect().toAlignedRect();
+
+    int left = area.left() - m_keypadding_x;
+    midipulse tpp = pix_to_tix(1);
+    midipulse start_tick = pix_to_tix(left > 0 ? left : 0);
+    midipulse end_tick = pix_to_tix(area.right() + 1);
+    int noteheight = unit_height() - 2;
+    QPen pen(fore_color());
+    pen.setStyle(Qt::SolidLine);
+    pen.setWidth(1);
+    painter.setPen(pen);
+    for (int note = 0; note < c_notes_count; ++note)
+    {
+        int y = note_to_pix(note);
+        if (y > area.bottom() || y + noteheight < area.top())
+            continue;
+
+        const eventsummary & row = ns.ns_rows[std::size_t(note)];
+        if (row.empty())
+            continue;
+
+        int lvl = row.level_for(tpp);
+        const eventsummary::spans & spans = row.level(lvl);
+        for (auto sp = row.first(lvl, start_tick); sp != spans.cend(); ++sp)
+        {
+            if (sp->sp_start > end_tick)
+                break;
+
+            int x = xoffset(sp->sp_start);
+            int w = xoffset(sp->sp_end + 1) - x;
+            if (w < 1)
+                w = 1;
+
+            if (background)
+                painter.setBrush(backseq_brush());
+            else if (sp->sp_flagged)
+                painter.setBrush(QBrush(Qt::magenta));
+            else if (sp->sp_selected)
+                painter.setBrush(QBrush(sel_color()));
+            else
+                painter.setBrush(note_brush());
+
+            painter.drawRect(x, y, w, noteheight);
+        }
+    }
+}
+
 /**
  *  It would be nice to include the selected notes in the selection box
  *  when pasting.  We'll see how practical this feature is.
@@ -1062,7 +1450,11 @@ qseqroll::draw_drum_notes
         return;
 
     s->draw_lock();
-    for (auto cev = s->cbegin(); ! s->cend(cev); ++cev)
+    for
+    (
+        auto cev = s->cbegin(start_tick, true);
+        ! s->cend(cev, end_tick); ++cev
+    )
     {
         sequence::note_info ni;
         sequence::draw dt = s->get_next_note(ni, cev);
@@ -1122,6 +1514,9 @@ qseqroll::note_off_length () const
  *  We no longer support single-note undo of painted notes; they all get
  *  undone.
  *
+ *  The notes added are patched into the static layer, and only the area
+ *  they cover is repainted; see patch_region().
+ *
  *      if (m_chord > 0)
  *          result = track().push_add_chord(m_chord, tick, n, note);
  *      else
@@ -1150,7 +1545,43 @@ qseqroll::add_painted_note (midipulse tick, int note)
     if (result)
     {
         result = mark_modified();
-        set_dirty();
+        if (! patch_region())
+            set_dirty();
+    }
+    return result;
+}
+
+/**
+ *  Gets the region of the pattern changed since the last look (see
+ *  sequence::dirty_region()), marks it to be rendered again in the static
+ *  layer, and repaints only that.  Drum mode, summaries, wrap-around, and
+ *  the GPU view do not patch.
+ *
+ * \return
+ *      Returns false if the caller must render the whole static layer
+ *      again.
+ */
+
+bool
+qseqroll::patch_region ()
+{
+    sequence::region r;
+    bool result = track().dirty_region(m_region_generation, r);
+    if (result && ! sequence::region_empty(r))
+    {
+        result = ! use_gpu() && ! is_drum_mode() && ! summarized() &&
+            ! m_link_wraparound && ! m_backing_dirty && ! m_backing.isNull();
+
+        if (result)
+        {
+            int x0 = xoffset(r.r_start) - 1;
+            int x1 = xoffset(r.r_finish) + 2;
+            int y0 = note_to_pix(r.r_high) - 1;
+            int y1 = note_to_pix(r.r_low) + unit_height() + 1;
+            QRect area(QPoint(x0, y0), QPoint(x1, y1));
+            m_backing_patch |= area;
+            update(area);
+        }
     }
     return result;
 }
@@ -1158,6 +1589,7 @@ qseqroll::add_painted_note (midipulse tick, int note)
 void
 qseqroll::resizeEvent (QResizeEvent * qrep)
 {
+    invalidate_backing();
     QWidget::resizeEvent(qrep);
 }
 
@@ -1489,7 +1921,7 @@ qseqroll::mouseMoveEvent (QMouseEvent * event)
         if (drop_action())
             (void) snap_current_x();
 
-        set_dirty();
+        qseqbase::set_dirty();          /* boxes are overlays; keep cache   */
     }
     if (painting())
     {
@@ -1797,7 +2229,7 @@ qseqroll::keyPressEvent (QKeyEvent * event)
 
                     case Qt::Key_Q:             /* quantize selected notes  */
 
-                        if (track().push_quantize_notes(1))
+                        if (frame64()->quantize_job(1))
                             done = mark_modified();
                         break;
 
@@ -1814,7 +2246,7 @@ qseqroll::keyPressEvent (QKeyEvent * event)
 
                     case Qt::Key_T:             /* tighten selected notes   */
 
-                        if (track().push_quantize_notes(2))
+                        if (frame64()->quantize_job(2))
                             done = mark_modified();
                         break;
 
@@ -2043,6 +2475,7 @@ void
 qseqroll::update_edit_mode (sequence::editmode mode)
 {
     m_edit_mode = mode;
+    invalidate_backing();
 }
 
 /**
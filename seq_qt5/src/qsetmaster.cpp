@@ -24,16 +24,17 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2023-11-11
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The set-master controls the existence and usage of all sets.  For control
  *  of the play-screen (playing set), see the setmapper class.
  */
 
+#include <QAbstractTableModel>
+#include <QHeaderView>
 #include <QKeyEvent>                    /* Needed for QKeyEvent::accept()   */
 #include <QPushButton>
-#include <QTableWidgetItem>
 #include <QTimer>
 
 #include "seq66-config.h"               /* defines SEQ66_QMAKE_RULES        */
@@ -74,6 +75,166 @@ static const int c_table_row_height = 18;
 namespace seq66
 {
 
+/**
+ *  The model of the set table.  It keeps no copy of the sets; each cell is
+ *  read from the performer (the setmaster) when the view shows it, and a
+ *  change to one set signals only its row.  The row is the set number.  It
+ *  adds no signals or slots, so it needs no Q_OBJECT.
+ */
+
+class qsetmodel final : public QAbstractTableModel
+{
+
+private:
+
+    qsetmaster & m_set_master;
+    int m_rows;
+
+public:
+
+    qsetmodel (qsetmaster & owner) :
+        QAbstractTableModel (&owner),
+        m_set_master        (owner),
+        m_rows              (owner.cb_perf().screenset_count())
+    {
+        // no code
+    }
+
+    virtual int rowCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : m_rows ;
+    }
+
+    virtual int columnCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : 3 ;
+    }
+
+    virtual QVariant data (const QModelIndex & index, int role) const override;
+    virtual QVariant headerData
+    (
+        int section, Qt::Orientation orientation, int role
+    ) const override;
+    virtual Qt::ItemFlags flags (const QModelIndex & index) const override;
+    virtual bool setData
+    (
+        const QModelIndex & index, const QVariant & value, int role
+    ) override;
+
+    void reload ();
+    void row_changed (screenset::number setno);
+
+};
+
+QVariant
+qsetmodel::data (const QModelIndex & index, int role) const
+{
+    QVariant result;
+    if (index.isValid() && (role == Qt::DisplayRole || role == Qt::EditRole))
+    {
+        const performer & p = m_set_master.cb_perf();
+        screenset::number s = screenset::number(index.row());
+        switch (index.column())
+        {
+        case 0:
+            result = QString::number(s);
+            break;
+
+        case 1:
+            result = QString::number(p.screenset_seq_count(s));
+            break;
+
+        case 2:
+            result = qt(p.set_name(s));
+            break;
+        }
+    }
+    return result;
+}
+
+QVariant
+qsetmodel::headerData (int section, Qt::Orientation orientation, int role) const
+{
+    static const char * const s_headers [] = { "Set #", "Seqs", "Set Name" };
+    QVariant result;
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+    {
+        if (section >= 0 && section < 3)
+            result = QString(s_headers[section]);
+    }
+    return result;
+}
+
+/**
+ *  Only the set name can be edited.
+ */
+
+Qt::ItemFlags
+qsetmodel::flags (const QModelIndex & index) const
+{
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+    if (index.isValid() && index.column() == 2)
+        result |= Qt::ItemIsEditable;
+
+    return result;
+}
+
+/**
+ *  Renames the set, and marks the file as modified, but only if the name
+ *  is new.  Unlike the old cellChanged() handling, filling the table can
+ *  no longer wipe out a name.
+ */
+
+bool
+qsetmodel::setData (const QModelIndex & index, const QVariant & value, int role)
+{
+    bool result = index.isValid() && index.column() == 2 &&
+        role == Qt::EditRole;
+
+    if (result)
+    {
+        screenset::number s = screenset::number(index.row());
+        std::string name = value.toString().toStdString();
+        if (name != m_set_master.cb_perf().set_name(s))
+        {
+            m_set_master.cb_perf().screenset_name(s, name);
+            m_set_master.set_needs_update();
+            emit dataChanged(index, index);
+        }
+    }
+    return result;
+}
+
+/**
+ *  Tells the view that every row may have changed.  Only when the number
+ *  of sets changes is the model reset, which loses the selection.
+ */
+
+void
+qsetmodel::reload ()
+{
+    int rows = m_set_master.cb_perf().screenset_count();
+    if (rows != m_rows)
+    {
+        beginResetModel();
+        m_rows = rows;
+        endResetModel();
+    }
+    else if (m_rows > 0)
+        emit dataChanged(index(0, 0), index(m_rows - 1, 2));
+}
+
+/**
+ *  Tells the view that one set has changed.
+ */
+
+void
+qsetmodel::row_changed (screenset::number setno)
+{
+    if (setno >= 0 && setno < m_rows)
+        emit dataChanged(index(setno, 0), index(setno, 2));
+}
+
 /**
  *  Principal constructor.
  *
@@ -101,14 +262,14 @@ qsetmaster::qsetmaster
     ui                      (new Ui::qsetmaster),
     m_operations            ("Set Master Operations"),
     m_timer                 (nullptr),
+    m_set_model             (nullptr),
     m_main_window           (mainparent),
     m_set_buttons           (setmaster::Size(), nullptr),
     m_current_set           (seq::unassigned()),
     m_current_row           (seq::unassigned()),
     m_current_row_count     (cb_perf().screenset_count()),
     m_needs_update          (true),
-    m_trigger_mode          (false),
-    m_table_initializing    (true)
+    m_trigger_mode          (false)
 {
     ui->setupUi(this);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -171,42 +332,33 @@ qsetmaster::conditional_update ()
     }
 }
 
+/**
+ *  The column headers now come from qsetmodel::headerData().  The selection
+ *  model exists only after the model is set.
+ */
+
 void
 qsetmaster::setup_table ()
 {
-    QStringList columns;
-    columns << "Set #" << "Seqs" << "Set Name";
-
-    /*
-     * This advice is bs. The actual answer is to set the horizontal header to
-     * be visible.
-     *
-     *  ui->m_set_table->insertColumn(0), and 1 and 2;;
-     */
-
-    ui->m_set_table->setHorizontalHeaderLabels(columns);
+    m_set_model = new qsetmodel(*this);
+    ui->m_set_table->setModel(m_set_model);
     ui->m_set_table->setSelectionBehavior(QAbstractItemView::SelectRows);
 
     /*
      * ui->m_set_table->setSelectionMode(QAbstractItemView::SingleSelection);
      */
 
-    const int rows = ui->m_set_table->rowCount();
-    for (int r = 0; r < rows; ++r)
-        ui->m_set_table->setRowHeight(r, c_table_row_height);
+    ui->m_set_table->verticalHeader()->
+        setDefaultSectionSize(c_table_row_height);
 
     int w = ui->m_set_table->width();
     set_column_widths(w + c_set_table_fix);
 
     connect
     (
-        ui->m_set_table, SIGNAL(currentCellChanged(int, int, int, int)),
-        this, SLOT(slot_table_click_ex(int, int, int, int))
-    );
-    connect
-    (
-        ui->m_set_table, SIGNAL(cellChanged(int, int)),
-        this, SLOT(slot_cell_changed(int, int))
+        ui->m_set_table->selectionModel(),
+        SIGNAL(currentRowChanged(const QModelIndex &, const QModelIndex &)),
+        this, SLOT(slot_table_click_ex(const QModelIndex &))
     );
     ui->m_button_toggle_trigger_mode->setCheckable(true);
     ui->m_button_toggle_trigger_mode->setChecked(false);
@@ -243,105 +395,17 @@ qsetmaster::current_row (int row)
 }
 
 /**
- *  Do we want to skip non-existent sets?
+ *  The model reads the sets itself, so this only tells the view to show
+ *  them again.
  */
 
 bool
 qsetmaster::initialize_table ()
 {
-    bool result = false;
-    m_table_initializing = true;
-    int rows = setmaster::Size();   /* cb_perf().screenset_count()  */
-    if (rows > 0)
-    {
-        ui->m_set_table->clearContents();
-        for (int r = 0; r < rows; ++r)
-            ui->m_set_table->setRowHeight(r, c_table_row_height);
-
-        int active = cb_perf().screenset_count();
-        if (active > 0)
-        {
-            screenset::sethandler setfunc =
-            (
-                std::bind
-                (
-                    &qsetmaster::set_line, this,
-                    std::placeholders::_1, std::placeholders::_2
-                )
-            );
-            (void) cb_perf().exec_set_function(setfunc);
-        }
-    }
-    m_table_initializing = false;
-    return result;
-}
-
-/**
- *  Retrieve the table cell at the given row and column.
- *
- *  Issue:
- *
- *      When this is first called [via initialize_table()], the
- *      QWidgetTableItem does not exist.  So we make a new one, which has no
- *      text in it, and insert it.  This then sends the cellChanged(int, int)
- *      signal, which calls slot_cell_changed(), which sets the set's name to
- *      empty!  This issue must also be checked/fixed in qplaylistframe ::
- *      cell(), qseqeventframe :: cell(), and qmutemaster :: cell().
- *
- * \param row
- *      The row number, which should be in the range of 0 to 32.
- *
- * \param col
- *      The column enumeration value, which will be in range.
- *
- * \return
- *      Returns a pointer the table widget-item for the given row and column.
- *      If out-of-range, a null pointer is returned.
- */
-
-QTableWidgetItem *
-qsetmaster::cell (screenset::number row, column_id col)
-{
-    int column = int(col);
-    QTableWidgetItem * result = ui->m_set_table->item(row, column);
-    if (is_nullptr(result))
-    {
-        result = new (std::nothrow) QTableWidgetItem;
-        if (not_nullptr(result))
-        {
-            ui->m_set_table->setItem(row, column, result);
-            if (col != column_id::set_name)
-                result->setFlags(result->flags() ^ Qt::ItemIsEditable);
-        }
-    }
-    return result;
-}
+    bool result = not_nullptr(m_set_model);
+    if (result)
+        m_set_model->reload();
 
-bool
-qsetmaster::set_line (screenset & sset, screenset::number row)
-{
-    bool result = false;
-    QTableWidgetItem * qtip = cell(row, column_id::set_number);
-    if (not_nullptr(qtip))
-    {
-        int setno = int(row);                   // int(sset.set_number());
-        std::string setnostr = std::to_string(setno);
-        qtip->setText(qt(setnostr));
-        qtip = cell(row, column_id::set_name);  // clears sset.name()!
-        if (not_nullptr(qtip))
-        {
-            const std::string & setname = sset.name();
-            qtip->setText(qt(setname));
-            qtip = cell(row, column_id::set_seq_count);
-            if (not_nullptr(qtip))
-            {
-                int seqcount = int(sset.active_count());
-                std::string seqcountstr = std::to_string(seqcount);
-                qtip->setText(qt(seqcountstr));
-                result = true;
-            }
-        }
-    }
     return result;
 }
 
@@ -363,11 +427,9 @@ qsetmaster::set_needs_update ()
  */
 
 void
-qsetmaster::slot_table_click_ex
-(
-    int row, int /*column*/, int /*prevrow*/, int /*prevcolumn*/
-)
+qsetmaster::slot_table_click_ex (const QModelIndex & current)
 {
+    int row = current.row();
     int rows = cb_perf().screenset_count();
     if (rows > 0 && row >= 0 && row < rows)
     {
@@ -380,28 +442,6 @@ qsetmaster::slot_table_click_ex
     }
 }
 
-void
-qsetmaster::slot_cell_changed (int row, int column)
-{
-    if (! m_table_initializing)
-    {
-        column_id cid = static_cast<column_id>(column);
-        if (cid == column_id::set_name)
-        {
-            screenset::number s = screenset::number(row);
-            QTableWidgetItem * c = cell(s, cid);
-            QString qtext = c->text();
-            std::string name = qtext.toStdString();
-            std::string oldname = cb_perf().set_name(s);
-            if (name != oldname)
-            {
-                cb_perf().screenset_name(s, name);
-                set_needs_update();
-            }
-        }
-    }
-}
-
 void
 qsetmaster::slot_toggle_trigger_mode ()
 {
@@ -508,7 +548,7 @@ qsetmaster::slot_set_name ()
     {
         std::string name = ui->m_set_name_text->text().toStdString();
         cb_perf().screenset_name(m_current_set, name);
-        (void) initialize_table();      /* refill with sets */
+        m_set_model->row_changed(m_current_set);
     }
 }
 
@@ -549,30 +589,19 @@ qsetmaster::slot_move_up ()
 }
 
 /**
- *  Provides common code for slot_move_down() and slot_move_up().  Note that
- *  there is a trick here.  We cannot swap by set number, but by key value.
+ *  Provides common code for slot_move_down() and slot_move_up().  The row
+ *  is the set number, so only the two rows swapped are redrawn.
  */
 
 void
 qsetmaster::move_helper (int oldrow, int newrow)
 {
-    QTableWidgetItem * c0 = cell(oldrow, column_id::set_number);
-    if (not_nullptr(c0))
+    if (cb_perf().swap_sets(oldrow, newrow))        /* a modify action      */
     {
-        std::string snstring = c0->text().toStdString();
-        int set0 = string_to_int(snstring);
-        QTableWidgetItem * c1 = cell(newrow, column_id::set_number);
-        if (not_nullptr(c1))
-        {
-            std::string snstring = c1->text().toStdString();
-            int set1 = string_to_int(snstring);
-            if (cb_perf().swap_sets(set0, set1))    /* a modify action      */
-            {
-                (void) initialize_table();          /* refill with sets     */
-                ui->m_set_table->selectRow(newrow);
-                set_needs_update();
-            }
-        }
+        m_set_model->row_changed(oldrow);
+        m_set_model->row_changed(newrow);
+        ui->m_set_table->selectRow(newrow);
+        set_needs_update();
     }
 }
 
@@ -590,28 +619,20 @@ qsetmaster::slot_delete ()
     int rows = cb_perf().screenset_count();
     if (rows > 1)                                   /* cannot move if 1 row */
     {
-        int row = current_row();                    /* last row clicked     */
-        if (row >= 0 && row < rows)                 /* deleteable?          */
+        int setno = current_row();                  /* last row clicked     */
+        if (setno > 0 && setno < rows)              /* deleteable?          */
         {
-            QTableWidgetItem * qtip = cell(row, column_id::set_number);
-            if (not_nullptr(qtip))
+            /*
+             * if (cb_perf().remove_set(setno))
+             */
+
+            if (cb_perf().clear_set(setno))
             {
-                std::string snstr = qtip->text().toStdString();
-                int setno = string_to_int(snstr);
-                if (setno > 0)
-                {
-                    /*
-                     * if (cb_perf().remove_set(setno))
-                     */
-
-                    if (cb_perf().clear_set(setno))
-                    {
-                        if (setno == m_current_set)
-                            m_current_set = seq::unassigned();
-
-                        set_needs_update();
-                    }
-                }
+                if (setno == m_current_set)
+                    m_current_set = seq::unassigned();
+
+                m_set_model->reload();
+                set_needs_update();
             }
         }
     }
@@ -639,7 +660,7 @@ qsetmaster::on_set_change (screenset::number setno, performer::change modtype)
     }
     else
     {
-        result = initialize_table();    /* redraw the set-list (set-table)  */
+        m_set_model->row_changed(setno); /* redraw only the changed set     */
         set_needs_update();             /* cause set-buttons to redraw      */
     }
     return result;
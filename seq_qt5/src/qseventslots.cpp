@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-13
- * \updates       2024-11-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Also note that, currently, the editable_events container does not support
@@ -35,6 +35,8 @@
  *  as well.
  */
 
+#include <algorithm>                    /* std::lower_bound()               */
+
 #include "play/performer.hpp"           /* seq66::performer class           */
 #include "util/strfunctions.hpp"        /* seq66::strings_match()           */
 #include "qseqeventframe.hpp"
@@ -69,6 +71,7 @@ qseventslots::qseventslots
     m_parent                (parent),
     m_seq                   (s),
     m_event_container       (s, p.get_beats_per_minute()),
+    m_rows                  (),
     m_current_event         (m_event_container),
     m_event_count           (0),
     m_last_max_timestamp    (0),
@@ -125,14 +128,14 @@ qseventslots::load_events ()
                 if (increment_bottom() == SEQ66_NULL_EVENT_INDEX)
                     break;
             }
-            for (auto & ei : m_event_container)
-                ei.second.analyze();        /* creates the event strings    */
+            index_rows();
         }
         else
             result = false;
     }
     if (! result)
     {
+        m_rows.clear();
         m_line_count = 0;
         m_current_iterator = m_bottom_iterator =
             m_top_iterator = m_event_container.end();
@@ -140,20 +143,159 @@ qseventslots::load_events ()
     return result;
 }
 
+/**
+ *  Tells if there are events for the table.  The rows are no longer all
+ *  filled here; the event frame fills only the rows it shows, via
+ *  load_row(), as they are scrolled into view.  With a long controller
+ *  recording, filling every row took seconds and a great deal of memory.
+ */
+
 bool
 qseventslots::load_table ()
 {
-    bool result = m_event_container.count() > 0;
-    if (m_event_count > 0)
+    return m_event_container.count() > 0;
+}
+
+/**
+ *  Fills one row of the table.
+ *
+ * \param row
+ *      The row, which is also the index of the event in the container.
+ *
+ * \return
+ *      Returns true if the row is in range.
+ */
+
+bool
+qseventslots::load_row (int row)
+{
+    bool result = row >= 0 && row < int(m_rows.size());
+    if (result)
+        set_table_event(editable_events::dref(m_rows[std::size_t(row)]), row);
+
+    return result;
+}
+
+/**
+ *  Rebuilds the row index of the events.  The multimap's order is the
+ *  table order.
+ */
+
+void
+qseventslots::index_rows ()
+{
+    m_rows.clear();
+    m_rows.reserve(std::size_t(m_event_container.count()));
+    auto ei = m_event_container.begin();
+    for ( ; ei != m_event_container.end(); ++ei)
+        m_rows.push_back(ei);
+}
+
+/**
+ *  Finds the first row at or after the given time.  The events are sorted
+ *  by time stamp, so this is a binary search.
+ *
+ * \return
+ *      Returns the row number, which is the row count if every event comes
+ *      before the tick.
+ */
+
+int
+qseventslots::row_of_time (midipulse tick) const
+{
+    auto ri = std::lower_bound
+    (
+        m_rows.cbegin(), m_rows.cend(), tick,
+        [] (const editable_events::iterator & ei, midipulse tk)
+        {
+            return editable_events::cdref(ei).timestamp() < tk;
+        }
+    );
+    return int(ri - m_rows.cbegin());
+}
+
+/**
+ *  Finds the row of an event in the container.
+ *
+ * \return
+ *      Returns the row, or SEQ66_NULL_EVENT_INDEX if not found.
+ */
+
+int
+qseventslots::row_of (editable_events::iterator ei) const
+{
+    if (ei != m_event_container.end())
     {
-        int row = 0;
-        for (auto & ei : m_event_container)
+        int rows = int(m_rows.size());
+        int row = row_of_time(editable_events::cdref(ei).timestamp());
+        for ( ; row < rows; ++row)
         {
-            set_table_event(ei.second, row);
-            ++row;
+            if (m_rows[std::size_t(row)] == ei)
+                return row;
         }
     }
-    return result;
+    return SEQ66_NULL_EVENT_INDEX;
+}
+
+/**
+ *  Gets the row of the event linked to the given one.  As the link time is
+ *  the partner's time stamp, only the events at that time need checking.
+ *  If the partner is not found, the full search of the container is the
+ *  fallback.
+ *
+ * \return
+ *      Returns the row of the linked event, or -1.
+ */
+
+int
+qseventslots::count_to_link (const editable_event & source) const
+{
+    if (source.is_linked())
+    {
+        event::key k(source);
+        midipulse lt = source.link_time();
+        int rows = int(m_rows.size());
+        for (int row = row_of_time(lt); row < rows; ++row)
+        {
+            const editable_event & e =
+                editable_events::cdref(m_rows[std::size_t(row)]);
+
+            if (e.timestamp() != lt)
+                break;
+
+            if (e.is_linked() && e.link_key() == k)
+                return row;
+        }
+    }
+    return m_event_container.count_to_link(source);
+}
+
+/**
+ *  Looks up the event linked to the given one, the same way as
+ *  count_to_link().
+ */
+
+editable_event &
+qseventslots::lookup_link (const editable_event & ee)
+{
+    if (ee.is_linked())
+    {
+        event::key k(ee);
+        midipulse lt = ee.link_time();
+        int rows = int(m_rows.size());
+        for (int row = row_of_time(lt); row < rows; ++row)
+        {
+            editable_event & e =
+                editable_events::dref(m_rows[std::size_t(row)]);
+
+            if (e.timestamp() != lt)
+                break;
+
+            if (e.is_linked() && e.link_key() == k)
+                return e;
+        }
+    }
+    return m_event_container.lookup_link(ee);
 }
 
 /**
@@ -485,6 +627,7 @@ qseventslots::insert_event (editable_event ev)          // Q: where called?
     bool result = m_event_container.add(ev);
     if (result)
     {
+        index_rows();
         m_event_count = m_event_container.count();
         if (m_event_count == 1)
         {
@@ -713,6 +856,7 @@ qseventslots::delete_current_event ()
          */
 
         m_event_container.remove(oldcurrent);       /* wrapper for erase()  */
+        index_rows();
 
         int newcount = m_event_container.count();
         if (newcount == 0)
@@ -985,18 +1129,10 @@ qseventslots::page_topper (editable_events::iterator newcurrent)
 
     if (ok)
     {
-        auto ei = m_event_container.begin();
-        int botindex = 0;
-        while (ei != newcurrent)
-        {
-            ++botindex;
-            ++ei;
-            if (botindex == m_event_count)
-            {
-                ok = false;                     /* never found the event!   */
-                break;
-            }
-        }
+        int botindex = row_of(newcurrent);
+        if (botindex == SEQ66_NULL_EVENT_INDEX)
+            ok = false;                         /* never found the event!   */
+
         if (m_event_count <= line_maximum())    /* fewer events than lines  */
         {
             if (ok)
@@ -1069,23 +1205,13 @@ qseventslots::select_event (int event_index, bool full_redraw)
     if (ok)
         ok = (event_index < m_line_count);
 
+    if (ok)
+        ok = event_index >= 0 && event_index < int(m_rows.size());
+
     if (ok)
     {
-        auto ei = m_event_container.begin();    /* not m_top_iterator   */
-        ok = ei != m_event_container.end();
-        if (ok && (event_index > 0))
-        {
-            int i = 0;
-            while (i++ < event_index)
-            {
-                ++ei;
-                ok = ei != m_event_container.end();
-                if (! ok)
-                    break;
-            }
-        }
-        if (ok)
-            set_current_event(ei, event_index, full_redraw);
+        auto ei = m_rows[std::size_t(event_index)];
+        set_current_event(ei, event_index, full_redraw);
     }
 }
 
@@ -0,0 +1,474 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qsinputmonitor.cpp
+ *
+ *  This dialog shows the MIDI messages arriving on the input busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The input thread feeds performer::input_monitor() only while this dialog
+ *  is shown and not paused.  A timer, at a fraction of the window redraw
+ *  rate, drains it into a fixed history of raw records; the oldest are
+ *  dropped when it is full.  The table asks the model only for the rows it
+ *  shows, which are decoded then, so a flood of clock messages costs a
+ *  copy of a few bytes per message and the redraw of one screen of rows.
+ *  The rows have a fixed height, so that the view never measures them all.
+ */
+
+#include <QAbstractTableModel>
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QScrollBar>
+#include <QTableView>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "midi/event.hpp"               /* seq66 MIDI status values         */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "qsinputmonitor.hpp"           /* seq66::qsinputmonitor dialog     */
+#include "qt5_helpers.hpp"              /* seq66::qt_timer()                */
+
+namespace seq66
+{
+
+/**
+ *  The refresh period, as a multiple of the window redraw rate.  At the
+ *  default redraw rate, about eight times a second.
+ */
+
+static const int c_redraw_factor = 3;
+
+/**
+ *  The number of messages kept for viewing.
+ */
+
+static const int c_history_rows = 10000;
+
+/**
+ *  The most records drained at one time.  More than the ring holds, so the
+ *  ring is emptied at each refresh.
+ */
+
+static const int c_drain_batch = 8192;
+
+/**
+ *  The columns of the table.
+ */
+
+enum column
+{
+    col_time,
+    col_buss,
+    col_channel,
+    col_message,
+    col_data,
+    col_count
+};
+
+/**
+ *  The names of the channel messages, by the high nybble of the status,
+ *  less 8.
+ */
+
+static const char * const s_channel_names [] =
+{
+    "Note Off", "Note On", "Aftertouch", "Control",
+    "Program", "Ch Pressure", "Pitch Wheel"
+};
+
+/**
+ *  The names of the system messages, by the low nybble of the status.  The
+ *  undefined ones are shown in hex instead.
+ */
+
+static const char * const s_system_names [] =
+{
+    "SysEx", "MTC Quarter", "Song Position", "Song Select",
+    nullptr, nullptr, "Tune Request", "SysEx End",
+    "Clock", nullptr, "Start", "Continue",
+    "Stop", nullptr, "Active Sense", "Reset"
+};
+
+/**
+ *  The model of the table, a circular history of raw records.  It adds no
+ *  signals or slots, so it needs no Q_OBJECT.
+ */
+
+class qsinputmodel final : public QAbstractTableModel
+{
+
+public:
+
+    using record = inputmonitor::record;
+
+private:
+
+    std::vector<record> m_rows;
+    int m_first;
+    int m_count;
+    long m_base_us;
+
+public:
+
+    qsinputmodel (QObject * parent) :
+        QAbstractTableModel (parent),
+        m_rows      (std::size_t(c_history_rows)),
+        m_first     (0),
+        m_count     (0),
+        m_base_us   (0)
+    {
+        // no code
+    }
+
+    virtual int rowCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : m_count ;
+    }
+
+    virtual int columnCount (const QModelIndex & parent) const override
+    {
+        return parent.isValid() ? 0 : int(col_count) ;
+    }
+
+    virtual QVariant data (const QModelIndex & index, int role) const override;
+    virtual QVariant headerData
+    (
+        int section, Qt::Orientation orientation, int role
+    ) const override;
+
+    void append (const record * r, int count);
+    void clear ();
+
+private:
+
+    const record & at (int row) const
+    {
+        return m_rows[std::size_t((m_first + row) % c_history_rows)];
+    }
+
+    static QString message_name (midibyte status);
+    static QString message_data (const record & r);
+
+};
+
+/**
+ *  Decodes a cell.  Called by the view only for the rows it shows.
+ */
+
+QVariant
+qsinputmodel::data (const QModelIndex & index, int role) const
+{
+    QVariant result;
+    if (index.isValid() && index.row() < m_count)
+    {
+        const record & r = at(index.row());
+        if (role == Qt::DisplayRole)
+        {
+            switch (index.column())
+            {
+            case col_time:
+                result = QString::number
+                (
+                    double(r.mr_us - m_base_us) / 1000000.0, 'f', 3
+                );
+                break;
+
+            case col_buss:
+                result = int(r.mr_bus);
+                break;
+
+            case col_channel:
+                if (r.mr_status < EVENT_MIDI_SYSEX)
+                    result = int(r.mr_status & EVENT_GET_CHAN_MASK) + 1;
+                break;
+
+            case col_message:
+                result = message_name(r.mr_status);
+                break;
+
+            case col_data:
+                result = message_data(r);
+                break;
+            }
+        }
+        else if (role == Qt::TextAlignmentRole)
+        {
+            if (index.column() < col_message)
+                result = int(Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+    return result;
+}
+
+QVariant
+qsinputmodel::headerData
+(
+    int section, Qt::Orientation orientation, int role
+) const
+{
+    static const char * const s_headers [] =
+    {
+        "Time (s)", "Buss", "Ch", "Message", "Data"
+    };
+    QVariant result;
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+    {
+        if (section >= 0 && section < col_count)
+            result = QString(s_headers[section]);
+    }
+    return result;
+}
+
+QString
+qsinputmodel::message_name (midibyte status)
+{
+    const char * name = nullptr;
+    if (status >= EVENT_NOTE_OFF && status < EVENT_MIDI_SYSEX)
+        name = s_channel_names[(status >> 4) - 8];
+    else if (status >= EVENT_MIDI_SYSEX)
+        name = s_system_names[status & 0x0F];
+
+    return not_nullptr(name) ? QString(name) :
+        QString("0x%1").arg(int(status), 2, 16, QChar('0')) ;
+}
+
+QString
+qsinputmodel::message_data (const record & r)
+{
+    QString result;
+    midibyte kind = r.mr_status & EVENT_GET_STATUS_MASK;
+    if (r.mr_status == EVENT_MIDI_SYSEX)
+    {
+        result = QString("%1 bytes: %2 %3 ...").arg(r.mr_size)
+            .arg(int(r.mr_d0), 2, 16, QChar('0'))
+            .arg(int(r.mr_d1), 2, 16, QChar('0'));
+    }
+    else if (kind == EVENT_PITCH_WHEEL && r.mr_status < EVENT_MIDI_SYSEX)
+    {
+        int bend = (int(r.mr_d1) << 7 | int(r.mr_d0)) - 8192;
+        result = QString::number(bend);
+    }
+    else if (r.mr_status == EVENT_MIDI_SONG_POS && r.mr_size == 3)
+    {
+        int beats = int(r.mr_d1) << 7 | int(r.mr_d0);
+        result = QString::number(beats);
+    }
+    else if (r.mr_size == 2)
+        result = QString::number(int(r.mr_d0));
+    else if (r.mr_size == 3)
+        result = QString("%1 %2").arg(int(r.mr_d0)).arg(int(r.mr_d1));
+
+    return result;
+}
+
+/**
+ *  Adds records to the end of the history, first removing the oldest ones
+ *  if there is not room.  The first record ever added sets time 0.
+ */
+
+void
+qsinputmodel::append (const record * r, int count)
+{
+    if (count > c_history_rows)
+    {
+        r += count - c_history_rows;
+        count = c_history_rows;
+    }
+    if (count > 0)
+    {
+        if (m_base_us == 0)
+            m_base_us = r[0].mr_us;
+
+        int overflow = m_count + count - c_history_rows;
+        if (overflow > 0)
+        {
+            beginRemoveRows(QModelIndex(), 0, overflow - 1);
+            m_first = (m_first + overflow) % c_history_rows;
+            m_count -= overflow;
+            endRemoveRows();
+        }
+        beginInsertRows(QModelIndex(), m_count, m_count + count - 1);
+        for (int i = 0; i < count; ++i)
+        {
+            int slot = (m_first + m_count + i) % c_history_rows;
+            m_rows[std::size_t(slot)] = r[i];
+        }
+        m_count += count;
+        endInsertRows();
+    }
+}
+
+void
+qsinputmodel::clear ()
+{
+    beginResetModel();
+    m_first = m_count = 0;
+    m_base_us = 0;
+    endResetModel();
+}
+
+/**
+ *  Principal constructor.
+ */
+
+qsinputmonitor::qsinputmonitor (performer & p, QWidget * parent) :
+    QDialog         (parent),
+    m_performer     (p),
+    m_model         (nullptr),
+    m_view          (nullptr),
+    m_status        (nullptr),
+    m_pause         (nullptr),
+    m_timer         (nullptr),
+    m_batch         (std::size_t(c_drain_batch)),
+    m_paused        (false)
+{
+    setWindowTitle("MIDI Input Monitor");
+
+    QVBoxLayout * vbox = new QVBoxLayout(this);
+    m_model = new qsinputmodel(this);
+    m_view = new QTableView();
+    m_view->setModel(m_model);
+    m_view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setWordWrap(false);
+    m_view->verticalHeader()->hide();
+    m_view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_view->verticalHeader()->setDefaultSectionSize
+    (
+        m_view->fontMetrics().height() + 4
+    );
+    m_view->horizontalHeader()->setStretchLastSection(true);
+    m_view->setMinimumSize(480, 320);
+    vbox->addWidget(m_view);
+
+    m_status = new QLabel();
+    vbox->addWidget(m_status);
+
+    QDialogButtonBox * buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    m_pause = buttons->addButton("Pause", QDialogButtonBox::ActionRole);
+    m_pause->setCheckable(true);
+
+    QPushButton * clear = buttons->addButton
+    (
+        "Clear", QDialogButtonBox::ResetRole
+    );
+    vbox->addWidget(buttons);
+    connect(buttons, SIGNAL(rejected()), this, SLOT(close()));
+    connect(m_pause, SIGNAL(toggled(bool)), this, SLOT(slot_pause(bool)));
+    connect(clear, SIGNAL(clicked(bool)), this, SLOT(slot_clear()));
+
+    m_timer = qt_timer
+    (
+        this, "qsinputmonitor", c_redraw_factor, SLOT(conditional_update())
+    );
+    if (not_nullptr(m_timer))
+        m_timer->stop();                /* runs only while shown            */
+}
+
+qsinputmonitor::~qsinputmonitor ()
+{
+    m_performer.input_monitor().enable(false);
+    if (not_nullptr(m_timer))
+        m_timer->stop();
+}
+
+void
+qsinputmonitor::showEvent (QShowEvent *)
+{
+    m_performer.input_monitor().enable(! m_paused);
+    if (not_nullptr(m_timer))
+        m_timer->start();
+}
+
+/**
+ *  Once hidden, the input thread stops feeding the monitor.
+ */
+
+void
+qsinputmonitor::hideEvent (QHideEvent *)
+{
+    m_performer.input_monitor().enable(false);
+    if (not_nullptr(m_timer))
+        m_timer->stop();
+}
+
+/**
+ *  Moves the new messages into the table.  The table follows the newest
+ *  message, unless the user has scrolled away from the bottom.
+ */
+
+void
+qsinputmonitor::conditional_update ()
+{
+    inputmonitor & im = m_performer.input_monitor();
+    if (! m_paused)
+    {
+        int count = im.drain(m_batch.data(), int(m_batch.size()));
+        if (count > 0)
+        {
+            QScrollBar * sb = m_view->verticalScrollBar();
+            bool follow = sb->value() == sb->maximum();
+            m_model->append(m_batch.data(), count);
+            if (follow)
+                m_view->scrollToBottom();
+        }
+    }
+    m_status->setText
+    (
+        QString("%1 messages shown, %2 dropped%3")
+            .arg(m_model->rowCount(QModelIndex())).arg(im.dropped())
+            .arg(m_paused ? ", paused" : "")
+    );
+}
+
+/**
+ *  While paused, the monitor is off, so the input thread is not burdened,
+ *  and the table can be studied.
+ */
+
+void
+qsinputmonitor::slot_pause (bool checked)
+{
+    m_paused = checked;
+    m_performer.input_monitor().enable(! checked && isVisible());
+    conditional_update();
+}
+
+void
+qsinputmonitor::slot_clear ()
+{
+    m_model->clear();
+    conditional_update();
+}
+
+}               // namespace seq66
+
+/*
+ * qsinputmonitor.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-21
- * \updates       2025-02-03
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class is the Qt counterpart to the mainwid class.  This version is
@@ -66,6 +66,7 @@
  *             menu." Code supplied by phuel 2023-02-26.
  */
 
+#include <QInputDialog>
 #include <QMenu>
 #include <QMessageBox>
 #include <QMimeData>
@@ -76,11 +77,13 @@
 #include "cfg/settings.hpp"             /* seq66::usr() config functions    */
 #include "ctrl/keystroke.hpp"           /* seq66::keystroke class           */
 #include "play/performer.hpp"           /* seq66::performer class           */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
 #include "os/timing.hpp"                /* seq66::millisleep()              */
 #include "util/filefunctions.hpp"       /* seq66::get_full_path()           */
 #include "gui_palette_qt5.hpp"          /* seq66::gui_palette_qt5 class     */
 #include "qloopbutton.hpp"              /* seq66::qloopbutton (qslotbutton) */
 #include "qslivegrid.hpp"               /* seq66::qslivegrid                */
+#include "qslivemodel.hpp"              /* seq66::live_model()              */
 #include "qsmainwnd.hpp"                /* the true parent of this class    */
 #include "qt5_helpers.hpp"              /* seq66::qt_keystroke() etc.       */
 
@@ -153,6 +156,7 @@ qslivegrid::qslivegrid
     m_msg_box               (nullptr),
     m_redraw_buttons        (true),
     m_loop_buttons          (),
+    m_spare_buttons         (),
     m_x_min                 (0),
     m_x_max                 (0),
     m_y_min                 (0),
@@ -281,6 +285,7 @@ qslivegrid::qslivegrid
      */
 
     perf().enregister(this);                                /* notification */
+    live_model().attach(this);                              /* shared model */
     m_timer = qt_timer(this, "qslivegrid", 3, SLOT(conditional_update()));
 }
 
@@ -296,6 +301,7 @@ qslivegrid::~qslivegrid()
 
     perf().unregister(this);
     clear_loop_buttons();               /* currently we use raw pointers    */
+    live_model().detach(this);          /* after the buttons are gone       */
     delete ui;
 }
 
@@ -404,6 +410,11 @@ qslivegrid::set_playlist_name (const std::string & plname, bool modified)
  *  update() only if necessary.  See qlivebase::check_dirty(). All
  *  sequences are potentially checked.
  *
+ *  The first live grid created, normally the one in the main window, starts
+ *  a new frame of the shared live model (see qslivemodel), which every live
+ *  grid then reads, so the patterns are examined once per frame, no matter
+ *  how many external live frames are open.
+ *
  *  Actually, we need a way to update only the loop slots in the grid layout,
  *  and only update the progress area.
  *
@@ -420,6 +431,7 @@ qslivegrid::set_playlist_name (const std::string & plname, bool modified)
 void
 qslivegrid::conditional_update ()
 {
+    live_model().advance(this);
     if (m_loop_buttons.empty())
         return;
 
@@ -529,6 +541,20 @@ qslivegrid::clear_loop_buttons ()
         }
         m_loop_buttons.clear();
     }
+    clear_spare_buttons();
+}
+
+/**
+ *  Deletes the spare buttons.  They are no longer in the layout.
+ */
+
+void
+qslivegrid::clear_spare_buttons ()
+{
+    for (auto pb : m_spare_buttons)
+        delete pb;
+
+    m_spare_buttons.clear();
 }
 
 /**
@@ -652,6 +678,7 @@ qslivegrid::create_one_button (seq::number seqno)
 void
 qslivegrid::paintEvent (QPaintEvent * /*qpep*/)
 {
+    trace_scope ts("qslivegrid paint");
     if (m_redraw_buttons)
     {
         create_loop_buttons();                  /* refresh_all_slots()  */
@@ -866,6 +893,153 @@ qslivegrid::refresh_all_slots ()
     return result;
 }
 
+/**
+ *  Shows a new screen-set in the existing grid.  Each slot keeps its button
+ *  if it already shows the right pattern (or is empty, and stays empty).
+ *  Otherwise the slot gets a spare bound to the new pattern, or a new button
+ *  if there is none, and the old button is retired to the spares.  An empty
+ *  slot takes any empty spare and simply renumbers it.  A set change then
+ *  costs work only for the slots that change, and no pattern thumbnail is
+ *  drawn from scratch when going back to a set shown recently.
+ *
+ * \return
+ *      Returns false if the grid has not been built, or does not match the
+ *      size of a set, in which case the caller must rebuild it.
+ */
+
+bool
+qslivegrid::rebind_all_slots ()
+{
+    int setsize = perf().screenset_size();
+    bool result = ! m_redraw_buttons && setsize > 0 &&
+        setsize == int(m_loop_buttons.size());
+
+    if (result)
+    {
+        seq::number offset = seq_offset();
+        for (int index = 0; index < setsize; ++index)
+        {
+            seq::number s = index + offset;
+            int row, column;
+            if (! perf().seq_to_grid(s, row, column, is_external()))
+            {
+                result = false;
+                break;
+            }
+
+            qslotbutton * pb = m_loop_buttons[index];
+            seq::pointer pattern = perf().loop(s);          /* can be null  */
+            bool enabled = perf().is_screenset_active(s);
+            if (pb->slot_number() == s && pb->loop() == pattern)
+            {
+                if (pattern)
+                    pb->set_checked(pattern->armed());
+
+                pb->setEnabled(enabled);
+                continue;                                   /* no change    */
+            }
+            if (! pattern && ! pb->is_active())
+            {
+                pb->rebind(s, std::to_string(s), perf().lookup_slot_key(s));
+                pb->setEnabled(enabled);
+                continue;                                   /* renumbered   */
+            }
+
+            qslotbutton * nb = spare_button(s, pattern);
+            if (not_nullptr(nb))
+            {
+                ui->loopGridLayout->addWidget(nb, row, column);
+                nb->show();
+                nb->setEnabled(enabled);
+                if (pattern)
+                    nb->set_checked(pattern->armed());
+
+                nb->reupdate(true);
+            }
+            else
+            {
+                nb = create_one_button(s);              /* adds to layout   */
+                if (is_nullptr(nb))
+                {
+                    result = false;
+                    break;
+                }
+            }
+            ui->loopGridLayout->removeWidget(pb);
+            retire_button(pb);
+            m_loop_buttons[index] = nb;
+        }
+        if (result)
+            measure_loop_buttons();
+    }
+    return result;
+}
+
+/**
+ *  Takes a spare button out of the pool.
+ *
+ * \param seqno
+ *      The slot number wanted.  A loop button must match it.
+ *
+ * \param pattern
+ *      The pattern wanted.  If null, any empty spare is renumbered to the
+ *      slot number and returned.
+ *
+ * \return
+ *      Returns the button, or null if there is no suitable spare.
+ */
+
+qslotbutton *
+qslivegrid::spare_button (seq::number seqno, seq::pointer pattern)
+{
+    qslotbutton * result = nullptr;
+    for (auto it = m_spare_buttons.begin(); it != m_spare_buttons.end(); ++it)
+    {
+        qslotbutton * pb = *it;
+        bool found = pattern ?
+            pb->slot_number() == seqno && pb->loop() == pattern :
+            ! pb->is_active() ;
+
+        if (found)
+        {
+            result = pb;
+            (void) m_spare_buttons.erase(it);
+            if (! pattern)
+            {
+                std::string hotkey = perf().lookup_slot_key(seqno);
+                pb->rebind(seqno, std::to_string(seqno), hotkey);
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Hides a button taken out of the layout and adds it to the spares,
+ *  deleting the oldest spares if there are too many.
+ */
+
+void
+qslivegrid::retire_button (qslotbutton * pb)
+{
+    static const int s_spare_sets = 4;
+    if (not_nullptr(pb))
+    {
+        pb->hide();
+        m_spare_buttons.push_back(pb);
+
+        std::size_t limit = std::size_t(s_spare_sets) *
+            std::size_t(perf().screenset_size());
+
+        while (m_spare_buttons.size() > limit)
+        {
+            delete m_spare_buttons.front();
+            (void) m_spare_buttons.erase(m_spare_buttons.begin());
+        }
+    }
+}
+
 bool
 qslivegrid::modify_slot (qslotbutton * newslot, int row, int column)
 {
@@ -884,6 +1058,9 @@ qslivegrid::modify_slot (qslotbutton * newslot, int row, int column)
  *  We have found we need to pause the timer when switching banks while
  *  playing, otherwise there is a high probability of a seqfault, due to
  *  updating the user-interface (which deletes and rebuilts the slot buttons).
+ *
+ *  The buttons are now rebound to the new set where possible, and the grid
+ *  is rebuilt only if that cannot be done.
  */
 
 void
@@ -891,7 +1068,9 @@ qslivegrid::update_bank (int bankid)
 {
     m_timer->stop();
     qslivebase::update_bank(bankid);
-    (void) recreate_all_slots();        /* sets m_redraw_buttons to true    */
+    if (! rebind_all_slots())
+        (void) recreate_all_slots();    /* sets m_redraw_buttons to true    */
+
     m_timer->start();
 }
 
@@ -899,7 +1078,9 @@ void
 qslivegrid::update_bank ()
 {
     m_timer->stop();
-    (void) recreate_all_slots();        /* sets m_redraw_buttons to true    */
+    if (! rebind_all_slots())
+        (void) recreate_all_slots();    /* sets m_redraw_buttons to true    */
+
     m_timer->start();
 }
 
@@ -1372,6 +1553,11 @@ qslivegrid::reupdate ()
     }
 }
 
+/**
+ *  Called on every timer tick while playing.  A button whose face has not
+ *  changed repaints only its progress box, over its cached thumbnail.
+ */
+
 void
 qslivegrid::update_state ()
 {
@@ -1383,7 +1569,7 @@ qslivegrid::update_state ()
             if (s)
             {
                 pb->set_checked(s->armed());
-                pb->reupdate(true);
+                pb->reupdate(pb->face_changed());
             }
             else
                 pb->reupdate(false);
@@ -1437,6 +1623,47 @@ qslivegrid::record_sequence ()
     }
 }
 
+/**
+ *  Toggles the remapping of the notes of the pattern, as played, through
+ *  the note-map file.
+ */
+
+void
+qslivegrid::notemap_sequence ()
+{
+    seq::pointer sp = perf().get_sequence(m_current_seq);
+    if (sp)
+        (void) perf().live_notemap(*sp, ! sp->live_notemap());
+}
+
+/**
+ *  Prompts for the output filter stages of the pattern, such as
+ *  "transpose:-12 velocity:80".  An empty entry removes them.
+ */
+
+void
+qslivegrid::filter_sequence ()
+{
+    seq::pointer sp = perf().get_sequence(m_current_seq);
+    if (sp)
+    {
+        bool ok;
+        QString text = QInputDialog::getText
+        (
+            this, tr("Output Filter"),
+            tr("Stages (transpose:N velocity:P channel:C thin:D rate:N)"),
+            QLineEdit::Normal, qt(sp->output_filter()), &ok
+        );
+        if (ok && ! sp->output_filter(text.toStdString(), true))
+        {
+            QMessageBox::warning
+            (
+                this, tr("Output Filter"), tr("Bad filter stages.")
+            );
+        }
+    }
+}
+
 void
 qslivegrid::copy_sequence ()
 {
@@ -1895,6 +2122,27 @@ qslivegrid::popup_menu ()
             actionRecord, SIGNAL(triggered(bool)),
             this, SLOT(record_sequence())
         );
+        if (perf().notemap_exists())
+        {
+            QAction * actionNotemap = new_qaction
+            (
+                "Live &note-map toggle", m_popup
+            );
+            m_popup->addAction(actionNotemap);
+            connect
+            (
+                actionNotemap, SIGNAL(triggered(bool)),
+                this, SLOT(notemap_sequence())
+            );
+        }
+
+        QAction * actionFilter = new_qaction("Output &filter...", m_popup);
+        m_popup->addAction(actionFilter);
+        connect
+        (
+            actionFilter, SIGNAL(triggered(bool)),
+            this, SLOT(filter_sequence())
+        );
 
         /**
          *  Copy/Cut/Delete/Paste menus
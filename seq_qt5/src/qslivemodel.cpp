@@ -0,0 +1,242 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qslivemodel.cpp
+ *
+ *  This module defines the render model shared by all of the live grids.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  See qslivemodel.hpp for the reasons for this module.
+ */
+
+#include <algorithm>                    /* std::find()                      */
+
+#include "qslivemodel.hpp"              /* seq66::qslivemodel class         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The single model used by all of the live grids.
+ */
+
+qslivemodel &
+live_model ()
+{
+    static qslivemodel s_live_model;
+    return s_live_model;
+}
+
+qslivemodel::item::item () :
+    m_seq           (),
+    m_frame         (0),
+    m_status        (0),
+    m_tick          (0),
+    m_valid         (false),
+    m_generation    (0),
+    m_length        (0),
+    m_serial        (0),
+    m_have_notes    (false),
+    m_note_min      (0),
+    m_note_max      (0),
+    m_threshold     (false),
+    m_marks         ()
+{
+    // no code
+}
+
+qslivemodel::qslivemodel () :
+    m_items     (),
+    m_views     (),
+    m_frame     (0)
+{
+    // no code
+}
+
+/**
+ *  Adds a live grid to the list.  The first one attached advances the
+ *  frame.
+ */
+
+void
+qslivemodel::attach (const void * view)
+{
+    auto it = std::find(m_views.begin(), m_views.end(), view);
+    if (it == m_views.end())
+        m_views.push_back(view);
+}
+
+/**
+ *  Removes a live grid.  If it was the first one, the next one takes over
+ *  the advancing of the frame.  When the last one goes, the items are
+ *  released.
+ */
+
+void
+qslivemodel::detach (const void * view)
+{
+    auto it = std::find(m_views.begin(), m_views.end(), view);
+    if (it != m_views.end())
+        (void) m_views.erase(it);
+
+    if (m_views.empty())
+        m_items.clear();
+}
+
+/**
+ *  Called by each live grid at the start of its timer callback.  Only the
+ *  first grid starts a new frame, so that the status of each pattern is
+ *  read once per frame no matter how many grids show it.
+ */
+
+void
+qslivemodel::advance (const void * view)
+{
+    if (! m_views.empty() && m_views.front() == view)
+        ++m_frame;
+}
+
+/**
+ *  Gets the item for a pattern, refreshing its status once per frame, and
+ *  walking its events again only if it has been edited since.  A new
+ *  pattern in the same slot starts a new item.
+ *
+ * \param s
+ *      The pattern, which must be valid.
+ *
+ * \return
+ *      Returns a reference to the item, valid until the pattern number is
+ *      forgotten.
+ */
+
+const qslivemodel::item &
+qslivemodel::get (seq::pointer s)
+{
+    item & it = m_items[s->seq_number()];
+    if (it.m_seq.lock() != s)
+    {
+        it = item();
+        it.m_seq = s;
+        it.m_frame = m_frame - 1;               /* force a first refresh    */
+    }
+    if (it.m_frame != m_frame)
+    {
+        it.m_frame = m_frame;
+        it.m_status = status_of(*s);
+        it.m_tick = s->get_last_tick();
+        if
+        (
+            ! it.m_valid || it.m_generation != s->redraw_generation() ||
+            it.m_length != s->get_length()
+        )
+        {
+            rebuild(it, *s);
+        }
+    }
+    return it;
+}
+
+/**
+ *  Drops the item of a pattern that has been removed or replaced.
+ */
+
+void
+qslivemodel::forget (seq::number seqno)
+{
+    (void) m_items.erase(seqno);
+}
+
+/**
+ *  Gathers the status flags that change the face of a pattern button.
+ */
+
+unsigned
+qslivemodel::status_of (const sequence & s)
+{
+    unsigned result = 0;
+    if (s.armed())
+        result |= c_armed;
+
+    if (s.get_queued())
+        result |= c_queued;
+
+    if (s.one_shot())
+        result |= c_one_shot;
+
+    if (s.recording())
+        result |= c_recording;
+
+    if (s.alter_recording())
+        result |= c_alter;
+
+    if (s.expanded_recording())
+        result |= c_expanded;
+
+    if (s.snap_it())
+        result |= c_snap_it;
+
+    return result;
+}
+
+/**
+ *  Walks the events of the pattern once, saving the drawable ones.  The
+ *  generation is read before the walk, so that an edit made during it
+ *  causes another rebuild at the next frame.
+ */
+
+void
+qslivemodel::rebuild (item & it, const sequence & s)
+{
+    it.m_valid = true;
+    it.m_generation = s.redraw_generation();
+    it.m_length = s.get_length();
+    it.m_have_notes = s.minmax_notes(it.m_note_min, it.m_note_max);
+    it.m_threshold = s.event_threshold();
+    it.m_marks.clear();
+    s.draw_lock();
+    for (auto cev = s.cbegin(); ! s.cend(cev); ++cev)
+    {
+        mark m;
+        m.m_kind = s.get_next_note(m.m_info, cev);
+        if (m.m_kind == sequence::draw::finish)
+            break;
+
+        it.m_marks.push_back(m);
+    }
+    s.draw_unlock();
+    ++it.m_serial;
+}
+
+}           // namespace seq66
+
+/*
+ * qslivemodel.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-26
- * \updates       2023-10-27
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This object is just a QPushButton with number label.  See seq66::qslivegrid
@@ -117,6 +117,28 @@ qslotbutton::setup ()
     setText(qt(snstring));
 }
 
+/**
+ *  Moves the button to another slot number, in place of deleting it and
+ *  creating a new one.  Used by qslivegrid for empty slots when the
+ *  screen-set changes; a loop button stays bound to its pattern.
+ */
+
+void
+qslotbutton::rebind
+(
+    seq::number slotnumber,
+    const std::string & label,
+    const std::string & hotkey
+)
+{
+    m_slot_number = slotnumber;
+    m_label = label;
+    m_hotkey = hotkey;
+    m_is_dirty = true;
+    setup();
+    reupdate(true);
+}
+
 }           // namespace seq66
 
 /*
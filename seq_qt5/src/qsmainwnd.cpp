@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2025-01-26
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The main window is known as the "Patterns window" or "Patterns panel".  It
@@ -56,12 +56,15 @@
  *  Export as MIDI  export_file_as...()     Save as regular MIDI file
  *  Export Config:  export_project ()       Save all configuration files
  *  Import MIDI     import_midi_into_set()  Import MIDI into current set
+ *  Import to sets  import_midi_into_sets() Import MIDI files, one per set
  *  Import Project  import_project()        Import a project configuration
  *  Quit/Exit       quit()                  Normal Qt application closing
  *  Help            show_qsabout()          Show Help About (version info)
  *                  show_qsbuildinfo()      Show features of the build
  *                  show_qsappinfo()        Show additional features
  *                  show_qslogview()        Show the configured log file.
+ *                  show_qsoutputstats()    Show output timing statistics.
+ *                  show_qsinputmonitor()   Show the incoming MIDI.
  */
 
 #include <QErrorMessage>                /* QErrorMessage                    */
@@ -70,6 +73,7 @@
 #include <QMessageBox>                  /* QMessageBox                      */
 #include <QResizeEvent>                 /* QResizeEvent                     */
 #include <QScreen>                      /* QScreen                          */
+#include <QTimer>                       /* QTimer::singleShot()             */
 
 #undef USE_QDESKTOPSERVICES
 #if defined USE_QDESKTOPSERVICES
@@ -79,15 +83,19 @@
 #endif
 
 #include <iomanip>                      /* std::hex, std::setw()            */
+#include <iostream>                     /* std::cout                        */
 #include <sstream>                      /* std::ostringstream               */
 #include <utility>                      /* std::make_pair()                 */
 
 #include "cfg/cmdlineopts.hpp"          /* write_options_files()            */
 #include "ctrl/keystroke.hpp"           /* seq66::keystroke class           */
+#include "midi/guibench.hpp"            /* seq66::gui_bench()               */
 #include "midi/wrkfile.hpp"             /* seq66::wrkfile class             */
 #include "os/daemonize.hpp"             /* seq66::signal_for_restart()      */
+#include "os/perftrace.hpp"             /* seq66::perftrace_summary()       */
 #include "play/songsummary.hpp"         /* seq66::write_song_summary()      */
 #include "util/strfunctions.hpp"        /* seq66::string_to_int()           */
+#include "qframeclock.hpp"              /* seq66::qframeclock redraw clock  */
 #include "qliveframeex.hpp"             /* seq66::qliveframeex container    */
 #include "qmutemaster.hpp"              /* shows a map of mute-groups       */
 #include "qperfeditex.hpp"              /* seq66::qperfeditex container     */
@@ -98,6 +106,8 @@
 #include "qsabout.hpp"                  /* seq66::qsabout dialog class      */
 #include "qsappinfo.hpp"                /* seq66::qsappinfo dialog class    */
 #include "qslogview.hpp"                /* seq66::qslogview dialog class    */
+#include "qsoutputstats.hpp"            /* seq66::qsoutputstats dialog      */
+#include "qsinputmonitor.hpp"           /* seq66::qsinputmonitor dialog     */
 #include "qsbuildinfo.hpp"              /* seq66::qsbuildinfo dialog class  */
 #include "qseditoptions.hpp"            /* seq66::qseditoptions dialog      */
 #include "qseqeditex.hpp"               /* seq66::qseqeditex container      */
@@ -265,6 +275,7 @@ qsmainwnd::qsmainwnd
     m_msg_error             (nullptr),
     m_msg_save_changes      (nullptr),
     m_timer                 (nullptr),
+    m_frame_clock           (new qframeclock(p)),   /* before any qt_timer()*/
     m_menu_recent           (nullptr),          /* QMenu *                  */
     m_recent_action_list    (),                 /* QList<QAction *>         */
     m_beat_ind              (nullptr),
@@ -273,6 +284,8 @@ qsmainwnd::qsmainwnd
     m_dialog_build_info     (nullptr),
     m_dialog_app_info       (nullptr),
     m_dialog_log_view       (nullptr),
+    m_dialog_output_stats   (nullptr),
+    m_dialog_input_monitor  (nullptr),
     m_session_frame         (nullptr),
     m_set_master            (nullptr),
     m_mute_master           (nullptr),
@@ -292,7 +305,9 @@ qsmainwnd::qsmainwnd
     m_open_live_frames      (),
     m_perf_frame_visible    (false),
     m_current_main_set      (0),
-    m_shrunken              (usr().shrunken())
+    m_shrunken              (usr().shrunken()),
+    m_bench_timer           (nullptr),
+    m_bench_start_us        (0)
 {
     ui->setupUi(this);
 
@@ -442,14 +457,15 @@ qsmainwnd::qsmainwnd
      *  Main time bar at top right.
      */
 
-    m_dialog_prefs = new (std::nothrow) qseditoptions(cb_perf(), this);
     m_beat_ind = new (std::nothrow) qsmaintime
     (
         cb_perf(), ui->verticalWidget /*this*/, 4, 4
     );
     m_dialog_about = new (std::nothrow) qsabout(this);
-    m_dialog_app_info = new (std::nothrow) qsappinfo(this);
+    m_dialog_app_info = new (std::nothrow) qsappinfo(cb_perf(), this);
     m_dialog_log_view = new (std::nothrow) qslogview(this);
+    m_dialog_output_stats = new (std::nothrow) qsoutputstats(cb_perf(), this);
+    m_dialog_input_monitor = new (std::nothrow) qsinputmonitor(cb_perf(), this);
     m_dialog_build_info = new (std::nothrow) qsbuildinfo(this);
     make_perf_frame_in_tab();           /* create m_song_frame64 pointer    */
     m_live_frame = new (std::nothrow) qslivegrid
@@ -460,13 +476,6 @@ qsmainwnd::qsmainwnd
     {
         ui->LiveTabLayout->addWidget(m_live_frame);
     }
-    m_playlist_frame = new (std::nothrow) qplaylistframe
-    (
-        cb_perf(), this, ui->PlaylistTab
-    );
-    if (not_nullptr(m_playlist_frame))
-        ui->PlaylistTabLayout->addWidget(m_playlist_frame);
-
     connect
     (
         ui->actionExportProject, SIGNAL(triggered(bool)),
@@ -503,6 +512,17 @@ qsmainwnd::qsmainwnd
         this, SLOT(import_midi_into_set())
     );
 
+    /*
+     * File / Import / MIDI Files into Sets. Reads several MIDI files at
+     * once, each into its own set, starting with the current set.
+     */
+
+    connect
+    (
+        ui->actionImportMIDISets, SIGNAL(triggered(bool)),
+        this, SLOT(import_midi_into_sets())
+    );
+
     /**
      * File / Import / Import Project.
      */
@@ -566,6 +586,16 @@ qsmainwnd::qsmainwnd
         this, SLOT(show_qslogview())
     );
     connect
+    (
+        ui->actionOutputStats, SIGNAL(triggered(bool)),
+        this, SLOT(show_qsoutputstats())
+    );
+    connect
+    (
+        ui->actionInputMonitor, SIGNAL(triggered(bool)),
+        this, SLOT(show_qsinputmonitor())
+    );
+    connect
     (
         ui->actionSongSummary, SIGNAL(triggered(bool)),
         this, SLOT(slot_summary_save())
@@ -588,14 +618,11 @@ qsmainwnd::qsmainwnd
      * with the current status.
      */
 
-    if (not_nullptr(m_dialog_prefs))
-    {
-        connect
-        (
-            ui->actionPreferences, SIGNAL(triggered(bool)),
-            this, SLOT(slot_open_edit_prefs())
-        );
-    }
+    connect
+    (
+        ui->actionPreferences, SIGNAL(triggered(bool)),
+        this, SLOT(slot_open_edit_prefs())
+    );
     connect
     (
         ui->actionSongEditor, SIGNAL(triggered(bool)),
@@ -958,8 +985,6 @@ qsmainwnd::qsmainwnd
     if (! midifilename.empty())
         enable_save(false);
 
-    load_set_master();
-    load_mute_master();
     load_session_frame();
     ui->tabWidget->setCurrentIndex(Tab_Live);
     ui->tabWidget->setTabEnabled(Tab_Events, false);    /* prevents issues  */
@@ -1042,7 +1067,12 @@ qsmainwnd::qsmainwnd
     show_song_mode(m_song_mode);
     (void) refresh_captions();
     cb_perf().enregister(this);
-    m_timer = qt_timer(this, "qsmainwnd", 3, SLOT(conditional_update()));
+    m_timer = qt_timer
+    (
+        this, "qsmainwnd", 3, SLOT(conditional_update()), true /* periodic */
+    );
+    if (gui_bench().active())
+        QTimer::singleShot(500, this, SLOT(start_gui_bench()));
 }
 
 /**
@@ -1066,6 +1096,7 @@ qsmainwnd::~qsmainwnd ()
         m_timer->stop();
 
     cb_perf().unregister(this);
+    delete m_frame_clock;
     delete ui;
 }
 
@@ -1465,11 +1496,32 @@ qsmainwnd::edit_bpm ()
         enable_save();
 }
 
+/**
+ *  The Preferences dialog is by far the biggest piece of the user
+ *  interface, and is seldom opened during a show, so it is not made until
+ *  it is first wanted.
+ *
+ * \return
+ *      Returns true if the dialog exists.
+ */
+
+bool
+qsmainwnd::load_edit_prefs ()
+{
+    if (is_nullptr(m_dialog_prefs))
+        m_dialog_prefs = new (std::nothrow) qseditoptions(cb_perf(), this);
+
+    return not_nullptr(m_dialog_prefs);
+}
+
 void
 qsmainwnd::slot_open_edit_prefs ()
 {
-    m_dialog_prefs->show();
-    m_dialog_prefs->sync();
+    if (load_edit_prefs())
+    {
+        m_dialog_prefs->show();
+        m_dialog_prefs->sync();
+    }
 }
 
 void
@@ -1676,7 +1728,7 @@ qsmainwnd::open_list_dialog ()
     bool result = show_playlist_dialog(this, fname, OpeningFile);
     if (result)
     {
-        result = not_nullptr(m_playlist_frame);
+        result = load_playlist_frame();
         if (result)
         {
             cb_perf().playlist_activate(true);      /* ca 2023-07-17    */
@@ -1739,7 +1791,7 @@ qsmainwnd::specify_list_dialog ()
             rc().playlist_filename(fname);
             rc().auto_playlist_save(true);
             rc().auto_rc_save(true);
-            result = not_nullptr(m_playlist_frame);
+            result = load_playlist_frame();
             if (result)
             {
                 result = m_playlist_frame->load_playlist(fname);
@@ -1807,7 +1859,7 @@ qsmainwnd::open_mutes_dialog ()
     );
     if (result)
     {
-        result = not_nullptr(m_mute_master);
+        result = load_mute_master();
         if (result)
         {
             result = m_mute_master->load_mutegroups(fname);
@@ -1816,7 +1868,8 @@ qsmainwnd::open_mutes_dialog ()
                 fname = filename_base(fname);
                 rc().mute_group_filename(fname);
                 rc().mute_group_file_active(true);
-                m_dialog_prefs->sync();             /* also call apply()? */
+                if (not_nullptr(m_dialog_prefs))
+                    m_dialog_prefs->sync();         /* also call apply()? */
             }
             else
                 show_error_box("Mute-groups loading error");  // TODO
@@ -1855,7 +1908,7 @@ qsmainwnd::save_mutes_dialog (const std::string & basename)
     );
     if (result)
     {
-        result = not_nullptr(m_mute_master);
+        result = load_mute_master();
         if (result)
         {
             /*
@@ -1867,7 +1920,8 @@ qsmainwnd::save_mutes_dialog (const std::string & basename)
             if (result)
             {
                 rc().mute_group_filename(fname);
-                m_dialog_prefs->sync();             /* also call apply()? */
+                if (not_nullptr(m_dialog_prefs))
+                    m_dialog_prefs->sync();         /* also call apply()? */
             }
             else
                 show_error_box("Mute-groups saving error");
@@ -2691,6 +2745,31 @@ qsmainwnd::import_midi_into_set ()
     }
 }
 
+/**
+ *  Imports the selected MIDI files into the current set and those after
+ *  it, one file per set, in the order of the file-names.  The files are
+ *  read in parallel and installed as one change; see import_midi_files().
+ */
+
+void
+qsmainwnd::import_midi_into_sets ()
+{
+    std::vector<std::string> files;
+    if (show_import_midi_files_dialog(this, files))
+    {
+        std::string errmsg;
+        int setno = int(cb_perf().playscreen_number());
+        int count = import_midi_files(cb_perf(), files, setno, errmsg);
+        if (count > 0)
+        {
+            update_bank(setno);
+            (void) refresh_captions();
+        }
+        if (! errmsg.empty())
+            show_error_box(errmsg);
+    }
+}
+
 /*
  *  We do not want to save any configuration after the import.  We need to
  *  restart the app to load the new configuration; we tell the user that this
@@ -2765,6 +2844,20 @@ qsmainwnd::show_qslogview ()
     }
 }
 
+void
+qsmainwnd::show_qsoutputstats ()
+{
+    if (not_nullptr(m_dialog_output_stats))
+        m_dialog_output_stats->show();
+}
+
+void
+qsmainwnd::show_qsinputmonitor ()
+{
+    if (not_nullptr(m_dialog_input_monitor))
+        m_dialog_input_monitor->show();
+}
+
 /**
  *  Loads a slightly compressed qseqeditframe64 for the selected
  *  sequence into the "Edit" tab.  It is compressed by hiding some of
@@ -2820,6 +2913,105 @@ qsmainwnd::load_editor (int seqid)
     }
 }
 
+/**
+ *  Starts the script of the --gui-bench option.  The benchmark song is
+ *  written to the configuration directory and opened as any other song, the
+ *  first pattern is put in the Edit tab, and playback starts.  The trace
+ *  clock is noted, so that the frames painted while loading are left out
+ *  of the report.
+ */
+
+void
+qsmainwnd::start_gui_bench ()
+{
+    std::string fname = filename_concatenate
+    (
+        rc().home_config_directory(), "seq66-gui-bench.midi"
+    );
+    bool ok = gui_bench().write_song(fname) && open_file(fname);
+    if (ok)
+    {
+        load_editor(0);
+        ui->tabWidget->setTabEnabled(Tab_Editor, true);
+        m_bench_start_us = perftrace_clock();
+        m_bench_timer = qt_timer
+        (
+            this, "gui-bench", 1, SLOT(gui_bench_step()), true /* periodic */
+        );
+        start_playing();
+        file_message("GUI benchmark", fname);
+    }
+    else
+        quit();
+}
+
+/**
+ *  Runs one step of the --gui-bench script, at the redraw rate.  Every two
+ *  seconds the next of the Live, Song, and Edit tabs is shown.  In the
+ *  Song and Edit tabs, each step scrolls one measure further, wrapping at
+ *  the end of the song or pattern, and each second zooms in or out, in a
+ *  cycle of three zooms in and three out.  When the time is up, playback
+ *  stops, the paint times of each window are printed, and the application
+ *  quits.
+ */
+
+void
+qsmainwnd::gui_bench_step ()
+{
+    static const long c_phase_us = 2000000;
+    static const long c_zoom_us = 1000000;
+    static const int c_tabs [] = { Tab_Live, Tab_Song, Tab_Editor };
+    static midipulse s_tick = 0;
+    static long s_last_zoom = 0;
+    long elapsed = perftrace_clock() - m_bench_start_us;
+    if (elapsed >= long(gui_bench().seconds()) * 1000000)
+    {
+        m_bench_timer->stop();
+        stop_playing();
+        std::cout
+            << "GUI benchmark: " << gui_bench().patterns() << " patterns, "
+            << gui_bench().events() << " notes, "
+            << gui_bench().triggers() << " triggers each; "
+            << gui_bench().seconds() << " s; frame times in ms\n"
+            ;
+        if (perftrace_summary(std::cout, m_bench_start_us, "paint") == 0)
+            std::cout << "No frames were painted\n";
+
+        quit();
+        return;
+    }
+
+    int tab = c_tabs[(elapsed / c_phase_us) % 3];
+    if (ui->tabWidget->currentIndex() != tab)
+        ui->tabWidget->setCurrentIndex(tab);
+
+    bool zoom = elapsed / c_zoom_us != s_last_zoom;
+    bool zoomin = (elapsed / c_zoom_us) % 6 < 3;
+    s_last_zoom = elapsed / c_zoom_us;
+    s_tick += cb_perf().ppqn() * 4;
+    if (tab == Tab_Song && not_nullptr(m_song_frame64))
+    {
+        midipulse songlength = cb_perf().get_max_trigger();
+        if (songlength > 0)
+            m_song_frame64->scroll_to_tick(s_tick % songlength);
+
+        if (zoom)
+            (void) (zoomin ? m_song_frame64->zoom_in() :
+                m_song_frame64->zoom_out());
+    }
+    else if (tab == Tab_Editor && not_nullptr(m_edit_frame))
+    {
+        qseqeditframe64 * ef = dynamic_cast<qseqeditframe64 *>(m_edit_frame);
+        seq::pointer s = cb_perf().get_sequence(0);
+        if (not_nullptr(ef) && s && s->get_length() > 0)
+            ef->scroll_to_tick(s_tick % s->get_length());
+
+        if (zoom)
+            (void) (zoomin ? m_edit_frame->zoom_in() :
+                m_edit_frame->zoom_out());
+    }
+}
+
 void
 qsmainwnd::remove_edit_tab_frame ()
 {
@@ -2878,32 +3070,69 @@ qsmainwnd::load_event_editor (int seqid)
     }
 }
 
-void
+/**
+ *  The Sets, Mutes, and Playlist tabs are filled when first shown (see
+ *  tabWidgetClicked()), or when a file operation needs them, rather than
+ *  when the main window is made.  Until then, the callers that merely
+ *  refresh them find null pointers, and skip them; each frame reads the
+ *  current state when it is created.
+ *
+ * \return
+ *      Returns true if the frame exists.
+ */
+
+bool
 qsmainwnd::load_set_master ()
 {
-    qsetmaster * qsm = new (std::nothrow) qsetmaster
-    (
-        cb_perf(), this, ui->SetMasterTab
-    );
-    if (not_nullptr(qsm))
+    if (is_nullptr(m_set_master))
     {
-        ui->SetsTabLayout->addWidget(qsm);
-        m_set_master = qsm;
+        qsetmaster * qsm = new (std::nothrow) qsetmaster
+        (
+            cb_perf(), this, ui->SetMasterTab
+        );
+        if (not_nullptr(qsm))
+        {
+            ui->SetsTabLayout->addWidget(qsm);
+            m_set_master = qsm;
+        }
     }
+    return not_nullptr(m_set_master);
 }
 
-void
+bool
 qsmainwnd::load_mute_master ()
 {
-    qmutemaster * qsm = new (std::nothrow) qmutemaster
-    (
-        cb_perf(), this, ui->MuteMasterTab
-    );
-    if (not_nullptr(qsm))
+    if (is_nullptr(m_mute_master))
     {
-        ui->MutesTabLayout->addWidget(qsm);
-        m_mute_master = qsm;
+        qmutemaster * qsm = new (std::nothrow) qmutemaster
+        (
+            cb_perf(), this, ui->MuteMasterTab
+        );
+        if (not_nullptr(qsm))
+        {
+            ui->MutesTabLayout->addWidget(qsm);
+            m_mute_master = qsm;
+        }
     }
+    return not_nullptr(m_mute_master);
+}
+
+bool
+qsmainwnd::load_playlist_frame ()
+{
+    if (is_nullptr(m_playlist_frame))
+    {
+        qplaylistframe * qpf = new (std::nothrow) qplaylistframe
+        (
+            cb_perf(), this, ui->PlaylistTab
+        );
+        if (not_nullptr(qpf))
+        {
+            ui->PlaylistTabLayout->addWidget(qpf);
+            m_playlist_frame = qpf;
+        }
+    }
+    return not_nullptr(m_playlist_frame);
 }
 
 /**
@@ -3332,7 +3561,8 @@ qsmainwnd::update_beats_per_measure (int bmindex)
 }
 
 /**
- *  If we've selected the edit tab, make sure it has something to edit.
+ *  If we've selected the edit tab, make sure it has something to edit.  The
+ *  Playlist, Sets, and Mutes tabs are filled the first time they are shown.
  *
  * \warning
  *      Somehow, checking for not_nullptr(m_edit_frame) to determine whether
@@ -3343,6 +3573,13 @@ qsmainwnd::update_beats_per_measure (int bmindex)
 void
 qsmainwnd::tabWidgetClicked (int newindex)
 {
+    if (newindex == Tab_Playlist)
+        (void) load_playlist_frame();
+    else if (newindex == Tab_Set_Master)
+        (void) load_set_master();
+    else if (newindex == Tab_Mute_Master)
+        (void) load_mute_master();
+
     bool isnull = is_nullptr(m_edit_frame);
     seq::number seqid = cb_perf().first_seq();      /* seq in playscreen?   */
     if (isnull)
@@ -0,0 +1,220 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          qsoutputstats.cpp
+ *
+ *  This dialog shows the timing statistics of the output thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The figures are read from performer::output_statistics() a couple of
+ *  times a second, only while the dialog is visible.  The "Clear" button
+ *  starts the counting over, so that a busy passage can be measured alone.
+ */
+
+#include <QDialogButtonBox>
+#include <QGridLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "qframeclock.hpp"              /* seq66::qframeclock::instance()   */
+#include "qsoutputstats.hpp"            /* seq66::qsoutputstats dialog      */
+#include "qt5_helpers.hpp"              /* seq66::qt(), qt_timer()          */
+
+namespace seq66
+{
+
+/**
+ *  The refresh period, as a multiple of the window redraw rate.
+ */
+
+static const int c_redraw_factor = 12;
+
+/**
+ *  Principal constructor.
+ */
+
+qsoutputstats::qsoutputstats (performer & p, QWidget * parent) :
+    QDialog         (parent),
+    m_performer     (p),
+    m_timer         (nullptr),
+    m_frames        (nullptr),
+    m_frame_time    (nullptr),
+    m_events        (nullptr),
+    m_late_max      (nullptr),
+    m_underruns     (nullptr),
+    m_lock_wait     (nullptr),
+    m_buffer        (nullptr),
+    m_pacing        (nullptr),
+    m_gui_interval  (nullptr),
+    m_lateness      ()
+{
+    setWindowTitle("Output Timing Statistics");
+
+    QVBoxLayout * vbox = new QVBoxLayout(this);
+    QGridLayout * grid = new QGridLayout();
+    vbox->addLayout(grid);
+
+    int row = 0;
+    m_frames = add_row(row++, "Frames played");
+    m_frame_time = add_row(row++, "Frame time, mean / max");
+    m_events = add_row(row++, "Events per frame, mean / max");
+    m_underruns = add_row(row++, "Underruns");
+    m_late_max = add_row(row++, "Latest wake-up");
+    for (int b = 0; b < outputstats::c_lateness_buckets; ++b)
+    {
+        std::string name = "Wake-ups " + outputstats::bucket_label(b) +
+            " late";
+
+        m_lateness[b] = add_row(row++, qt(name));
+    }
+    m_lock_wait = add_row(row++, "Pattern-lock waits, max");
+    m_buffer = add_row(row++, "Output buffer high-water, dropped");
+    m_pacing = add_row(row++, "Paced overloads, deferred, backlog max");
+    m_gui_interval = add_row(row++, "GUI redraw interval");
+
+    QDialogButtonBox * buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    QPushButton * clear = buttons->addButton
+    (
+        "Clear", QDialogButtonBox::ResetRole
+    );
+    vbox->addWidget(buttons);
+    connect(buttons, SIGNAL(rejected()), this, SLOT(close()));
+    connect(clear, SIGNAL(clicked(bool)), this, SLOT(slot_clear()));
+
+    m_timer = qt_timer
+    (
+        this, "qsoutputstats", c_redraw_factor, SLOT(conditional_update())
+    );
+    if (not_nullptr(m_timer))
+        m_timer->stop();                /* runs only while shown            */
+}
+
+qsoutputstats::~qsoutputstats ()
+{
+    if (not_nullptr(m_timer))
+        m_timer->stop();
+}
+
+QLabel *
+qsoutputstats::add_row (int row, const QString & name)
+{
+    QGridLayout * grid = static_cast<QGridLayout *>
+    (
+        layout()->itemAt(0)->layout()
+    );
+    QLabel * value = new QLabel("0");
+    value->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    grid->addWidget(new QLabel(name), row, 0);
+    grid->addWidget(value, row, 1);
+    return value;
+}
+
+void
+qsoutputstats::showEvent (QShowEvent *)
+{
+    conditional_update();
+    if (not_nullptr(m_timer))
+        m_timer->start();
+}
+
+void
+qsoutputstats::hideEvent (QHideEvent *)
+{
+    if (not_nullptr(m_timer))
+        m_timer->stop();
+}
+
+/**
+ *  Reads the statistics and fills in the labels.
+ */
+
+void
+qsoutputstats::conditional_update ()
+{
+    outputstats::values v = m_performer.output_statistics();
+    m_frames->setText(QString::number(v.ov_frames));
+    m_frame_time->setText
+    (
+        QString("%1 / %2 us").arg(v.frame_mean_us()).arg(v.ov_frame_max_us)
+    );
+    m_events->setText
+    (
+        QString("%1 / %2").arg(v.events_mean(), 0, 'f', 1).arg(v.ov_events_max)
+    );
+    m_underruns->setText(QString::number(v.ov_underruns));
+    m_late_max->setText(QString("%1 us").arg(v.ov_late_max_us));
+    for (int b = 0; b < outputstats::c_lateness_buckets; ++b)
+        m_lateness[b]->setText(QString::number(v.ov_lateness[b]));
+
+    m_lock_wait->setText
+    (
+        QString("%1, %2 us").arg(v.ov_lock_waits).arg(v.ov_lock_wait_max_us)
+    );
+    if (v.ov_buffer_size > 0)
+    {
+        m_buffer->setText
+        (
+            QString("%1/%2, %3").arg(v.ov_buffer_max)
+                .arg(v.ov_buffer_size).arg(v.ov_buffer_dropped)
+        );
+    }
+    else
+        m_buffer->setText("n/a");
+
+    if (v.ov_paced_frames > 0)
+    {
+        m_pacing->setText
+        (
+            QString("%1, %2, %3 us").arg(v.ov_overloads)
+                .arg(v.ov_deferred).arg(v.ov_backlog_max_us)
+        );
+    }
+    else
+        m_pacing->setText("n/a");
+
+    qframeclock * fc = qframeclock::instance();
+    if (not_nullptr(fc))
+        m_gui_interval->setText(QString("%1 ms").arg(fc->interval_ms()));
+    else
+        m_gui_interval->setText("n/a");
+}
+
+void
+qsoutputstats::slot_clear ()
+{
+    m_performer.clear_output_statistics();
+    conditional_update();
+}
+
+}               // namespace seq66
+
+/*
+ * qsoutputstats.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
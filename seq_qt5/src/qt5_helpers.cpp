@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-03-14
- * \updates       2025-01-25
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The items provided externally are:
@@ -37,7 +37,10 @@
  *      -   qt().  Converts an std::sring to a QString.
  *      -   qt_set_layout_visibility(). Hide/show a layout and its children.
  *      -   qt_timer(). Encapsulates creating and starting a timer, with a
- *          callback given by a Qt slot-name.
+ *          callback given by a Qt slot-name, usually driven by the frame
+ *          clock.
+ *      -   qt_run_edit(). Runs a long pattern edit on a worker thread, with
+ *          a progress dialog that can cancel it.
  *      -   enable_combobox_item(). Handles the appearance of a combo box.
  *      -   fill_combobox(). Fills a combo box from a combolist.
  *      -   new_qaction(). Creates a menu action from text and an icon. Also
@@ -45,6 +48,7 @@
  *      -   new_qmenu(). Similar.
  *      -   show_open_midi_file_dialog()
  *      -   show_import_midi_file_dialog()
+ *      -   show_import_midi_files_dialog()
  *      -   show_select_project_dialog()
  *      -   show_playlist_dialog()
  *      -   show_text_file_dialog()
@@ -57,6 +61,7 @@
 #include <QComboBox>
 #include <QColor>
 #include <QErrorMessage>
+#include <QEventLoop>
 #include <QFileDialog>                  /* prompt for full MIDI file's path */
 #include <QIcon>
 #include <QLayout>
@@ -66,6 +71,7 @@
 #include <QMenu>
 #include <QMessageBox>
 #include <QPalette>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QScrollArea>
 #include <QScrollBar>
@@ -75,8 +81,10 @@
 #include <QToolTip>
 
 #include "cfg/settings.hpp"             /* seq66::rc().home_config_dir...() */
+#include "play/editjob.hpp"             /* seq66::editjob                   */
 #include "util/filefunctions.hpp"       /* seq66 file-name manipulations    */
 #include "util/strfunctions.hpp"        /* seq66::toupper() and tolower     */
+#include "qframeclock.hpp"              /* seq66::qframeclock               */
 #include "qt5_helpers.hpp"              /* these cool helper functions!     */
 
 /**
@@ -359,7 +367,14 @@ qt_error_box (QWidget * self, const std::string & msg)
 }
 
 /**
- *  Creates a QTimer in a consistent manner.
+ *  Creates a QTimer in a consistent manner.  If the frame clock exists, the
+ *  timer is handed to it, and the slot is called only when there is
+ *  something new to show.  See the qframeclock module.
+ *
+ * \param periodic
+ *      If true, the timer runs on its own at the redraw rate, as for
+ *      objects that must poll no matter what, such as the session manager.
+ *      The default is false.
  */
 
 QTimer *
@@ -368,7 +383,8 @@ qt_timer
     QObject * self,
     const std::string & name,
     int redraw_factor,
-    const char * slotname
+    const char * slotname,
+    bool periodic
 )
 {
     QTimer * result = new QTimer(self);
@@ -393,10 +409,13 @@ qt_timer
         QMetaObject::Connection c =
             QObject::connect(result, SIGNAL(timeout()), self, slotname);
 
-        if (bool(c))
-            result->start();
-        else
+        qframeclock * fc = periodic ? nullptr : qframeclock::instance() ;
+        if (! bool(c))
             error_message("Connection invalid");
+        else if (not_nullptr(fc))
+            fc->add(result, self, redraw_factor);
+        else
+            result->start();
     }
     else
     {
@@ -408,6 +427,61 @@ qt_timer
     return result;
 }
 
+/**
+ *  Runs a pattern edit on its worker thread, and swaps the result in.
+ *  Meanwhile a local event loop keeps the windows alive, and a progress
+ *  dialog, modal only to the parent's window and shown only if the edit
+ *  takes more than half a second, offers to cancel it.  Playback goes on,
+ *  from the pattern as it was.
+ *
+ * \param parent
+ *      The window of the editor, used to place the dialog.
+ *
+ * \param job
+ *      The edit, not yet started.
+ *
+ * \return
+ *      Returns true if the edit was done and applied.
+ */
+
+bool
+qt_run_edit (QWidget * parent, editjob & job)
+{
+    if (! job.start())
+        return false;
+
+    QProgressDialog progress(qt(job.name()), "Cancel", 0, 100, parent);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+    progress.setAutoClose(false);
+    progress.setAutoReset(false);
+
+    QEventLoop loop;
+    QTimer poll;
+    QObject::connect
+    (
+        &poll, &QTimer::timeout,
+        [&job, &progress, &loop] ()
+        {
+            if (job.finished())
+                loop.quit();
+            else
+                progress.setValue(job.percent());
+        }
+    );
+    QObject::connect
+    (
+        &progress, &QProgressDialog::canceled, [&job] () { job.cancel(); }
+    );
+    poll.start(50);
+    if (! job.finished())
+        loop.exec();
+
+    poll.stop();
+    progress.close();
+    return job.apply();
+}
+
 /**
  *  Helper for handling enabled/disabled items in a combo-box
  */
@@ -661,6 +735,36 @@ show_import_midi_file_dialog (QWidget * parent, std::string & selectedfile)
     );
 }
 
+/**
+ *  Selects several MIDI files at once, for import_midi_files(), starting
+ *  in the last-used directory.  They are returned sorted by name, the
+ *  order of the screen-sets they go into.
+ */
+
+bool
+show_import_midi_files_dialog
+(
+    QWidget * parent,
+    std::vector<std::string> & files
+)
+{
+    QStringList names = QFileDialog::getOpenFileNames
+    (
+        parent, "Import MIDI Files into Sets", qt(rc().last_used_dir()),
+        qt(midi_wrk_wildcards())
+    );
+    names.sort();
+    files.clear();
+    for (const auto & n : names)
+        files.push_back(n.toStdString());
+
+    bool result = ! files.empty();
+    if (result)
+        rc().last_used_dir(filename_path(files[0]));
+
+    return result;
+}
+
 /**
  *  This function allows one to select an 'rc' file.
  */
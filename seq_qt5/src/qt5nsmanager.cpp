@@ -25,7 +25,7 @@
  * \library       qt5nsmanager application
  * \author        Chris Ahlstrom
  * \date          2020-03-15
- * \updates       2023-11-07
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  Duty now for the future! Join the Smart Patrol!
@@ -105,6 +105,8 @@ qt5nsmanager::conditional_update ()
 {
     if (not_nullptr(perf()))
     {
+        check_background_save();                /* a failure sets dirty     */
+        journal_edits();                        /* if "journal-interval"    */
         if (perf()->modified() != last_dirty_status())
             set_last_dirty();
 
@@ -172,7 +174,8 @@ qt5nsmanager::create_window ()
             (void) smanager::create_window();       /* just house-keeping   */
             m_timer = qt_timer
             (
-                this, "qt5nsmanager", 5, SLOT(conditional_update())
+                this, "qt5nsmanager", 5, SLOT(conditional_update()),
+                true                                /* periodic, polls      */
             );
 
             /*
@@ -310,6 +313,8 @@ qt5nsmanager::run ()
     bool restart = perf()->port_map_error(); // || perf()->new_ports_available();
     if (session_setup(restart))                 /* need an early exit?      */
     {
+        start_osc_servers();                    /* metrics, OSC control     */
+
         int exit_status = m_application.exec(); /* run main window loop     */
         status_message("Early exit flagged by session setup");
         return exit_status == EXIT_SUCCESS;
@@ -28,13 +28,16 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2022-02-16
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This mastermidibus module is the Linux (and, soon, JACK) version of the
  *  mastermidibus module using the completely refactored RtMidi library.
  */
 
+#include <memory>                       /* std::unique_ptr<>                */
+#include <vector>                       /* std::vector<>                    */
+
 #include "midi/mastermidibase.hpp"      /* seq66::mastermidibase ABC        */
 #include "rtmidi_info.hpp"              /* seq66::rtmidi_info, new class    */
 
@@ -45,6 +48,8 @@
 namespace seq66
 {
 
+class rtp_network;
+
 /**
  *  The class that "supervises" all of the midibus objects.  This
  *  implementation uses the PortMidi library, which supports Linux and
@@ -73,6 +78,16 @@ private:
 
     bool m_use_jack_polling;
 
+    /**
+     *  The RTP-MIDI session of the "rtp-midi-peers" option, if any, and the
+     *  input busses of its peers, which the ALSA and null APIs must poll
+     *  themselves.  The busses are in the buss arrays, after the native
+     *  ones.
+     */
+
+    std::unique_ptr<rtp_network> m_rtp_network;
+    std::vector<midibus *> m_rtp_inputs;
+
 public:
 
     mastermidibus () = delete;
@@ -85,6 +100,16 @@ protected:
 
     virtual bool api_get_midi_event (event * in) override;
     virtual int api_poll_for_midi () override;
+
+    /**
+     *  JACK sends the thru routes from its process callback.
+     */
+
+    virtual bool api_routes_thru () const override
+    {
+        return m_use_jack_polling;
+    }
+
     virtual void api_init (int ppqn, midibpm bpm) override;
 
     /**
@@ -106,9 +131,11 @@ protected:
         midi_master().api_set_beats_per_minute(b);
     }
 
-    virtual void api_flush () override
+    virtual void api_flush () override;
+
+    virtual void api_frame_tick (double tick) override
     {
-        midi_master().api_flush();
+        midi_master().api_frame_tick(tick);
     }
 
     virtual void api_port_start (mastermidibus & masterbus, int bus, int port)
@@ -118,6 +145,8 @@ protected:
 
 private:
 
+    void apply_port_changes ();
+
     /*
      * Would this function be useful?
      *
@@ -126,6 +155,8 @@ private:
 
     midibus * make_virtual_bus (int bus, midibase::io iotype);
     midibus * make_normal_bus (int bus, midibase::io iotype);
+    void make_network_busses ();
+    int network_poll ();
 
     const rtmidi_info & midi_master () const
     {
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-18
- * \updates       2022-06-02
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  The midi_alsa module is the Linux version of the midi_alsa module.
@@ -71,17 +71,18 @@ private:
 
     /**
      *  Destination address of client.  Could potentially be replaced by
-     *  midibase::m_bus_id.
+     *  midibase::m_bus_id.  Changes if the port is reconnected after the
+     *  device comes back with a new client number.
      */
 
-    const int m_dest_addr_client;
+    int m_dest_addr_client;
 
     /**
      *  Destination port of client.  Could potentially be replaced by
      *  midibase::m_port_id.
      */
 
-    const int m_dest_addr_port;
+    int m_dest_addr_port;
 
     /**
      *  Local address of client.
@@ -95,6 +96,30 @@ private:
 
     int m_local_addr_port;
 
+    /**
+     *  The MIDI-bytes-to-ALSA-event encoder used by api_play().  As in
+     *  Qtractor, it is created once, rather than being created and freed
+     *  for every event played.
+     */
+
+    snd_midi_event_t * m_midi_encoder;
+
+    /**
+     *  The "alsa-lookahead" setting, in microseconds.  If greater than zero,
+     *  and the output queue exists, events are scheduled on that queue this
+     *  far ahead instead of being delivered directly.
+     */
+
+    const long m_lookahead_us;
+
+    /**
+     *  The pattern tag of the event being played by api_play_batch(), or 0.
+     *  It is put into the ALSA event, so that api_retract() can find the
+     *  events of a muted pattern still waiting in the output queue.
+     */
+
+    midibyte m_tag;
+
     /**
      *  Holds the port name for the ALSA MIDI input port.  It is derived from
      *  the (optionally configured) official client name for the application
@@ -131,12 +156,18 @@ public:
 
 protected:
 
+    snd_seq_t * seq ()
+    {
+        return m_seq;
+    }
+
     virtual bool api_init_out () override;
     virtual bool api_init_in () override;
     virtual bool api_init_out_sub () override;
     virtual bool api_init_in_sub () override;
     virtual bool api_deinit_out () override;
     virtual bool api_deinit_in () override;
+    virtual bool api_reconnect () override;
 
     /**
      * ALSA get MIDI events via the midi_alsa_info object at present.
@@ -158,7 +189,10 @@ protected:
 
     virtual bool api_connect () override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_batch (const batchevent * evs, int count) override;
+    virtual void api_retract (midibyte tag) override;
     virtual void api_sysex (const event * e24) override;
+    virtual void api_sysex_chunk (const midibyte * data, int len) override;
     virtual void api_flush () override;
     virtual void api_continue_from (midipulse tick, midipulse beats) override;
     virtual void api_start () override;
@@ -170,6 +204,7 @@ protected:
 private:
 
     bool set_virtual_name (int portid, const std::string & portname);
+    void schedule (snd_seq_event_t & ev, midipulse tick);
 
 };          // class midi_alsa
 
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-04
- * \updates       2022-06-03
+ * \updates       2026-10-14
  * \license       See above.
  *
  *    We need to have a way to get all of the ALSA information of
@@ -35,6 +35,7 @@
  */
 
 #include <alsa/asoundlib.h>
+#include <vector>                       /* std::vector<>                    */
 
 #include "midi_info.hpp"                /* seq66::midi_port_info etc.       */
 #include "midi/midibus.hpp"             /* seq66::midibus                   */
@@ -89,6 +90,13 @@ private:
 
     struct pollfd * m_poll_descriptors;
 
+    /**
+     *  The input filter of each input buss, by buss number, or null if it
+     *  has none, gathered in api_connect(), once the busses exist.
+     */
+
+    std::vector<const inputfilter *> m_input_filters;
+
 public:
 
     midi_alsa_info () = delete;
@@ -124,10 +132,12 @@ private:
         midi_port_info & outports
     ) override;
 
+    void start_output_queue ();
     void get_poll_descriptors ();
     void remove_poll_descriptors ();
     bool check_port_type (snd_seq_port_info_t * pinfo) const;
     bool show_event (snd_seq_event_t * ev, const char * tag);
+    void post_port_start (int client, int port);
 
 };          // class midi_alsa_info
 
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; modifications by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2022-03-13
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  Declares the following classes:
@@ -151,7 +151,42 @@ public:
     virtual bool api_deinit_in () = 0;
     virtual bool api_get_midi_event (event *) = 0;
     virtual void api_play (const event * e24, midibyte channel) = 0;
+
+    /**
+     *  Plays a frame's batch of events.  Only the JACK implementation writes
+     *  them all at once.
+     */
+
+    virtual void api_play_batch (const batchevent * evs, int count)
+    {
+        for (int i = 0; i < count; ++i)
+            api_play(&evs[i].be_event, evs[i].be_channel);
+    }
+
+    /**
+     *  Takes back a pattern's events not yet sent.  Only the ALSA
+     *  implementation, with its lookahead queue, has any.
+     */
+
+    virtual void api_retract (midibyte /* tag */)
+    {
+        // no code
+    }
+
     virtual void api_sysex (const event * e24) = 0;
+
+    /**
+     *  Sends a chunk of a streamed SysEx message.  The ALSA and JACK
+     *  implementations send the bytes in place; this one copies them into
+     *  an event.
+     */
+
+    virtual void api_sysex_chunk (const midibyte * data, int len)
+    {
+        event ev;
+        if (ev.set_sysex(data, len))
+            api_sysex(&ev);
+    }
     virtual void api_continue_from (midipulse tick, midipulse beats) = 0;
     virtual void api_start () = 0;
     virtual void api_stop () = 0;
@@ -160,6 +195,28 @@ public:
     virtual void api_set_ppqn (int ppqn) = 0;
     virtual void api_set_beats_per_minute (midibpm bpm) = 0;
 
+    /**
+     *  Only the JACK implementation has an output buffer to report on.
+     */
+
+    virtual bool api_buffer_stats
+    (
+        int & /* size */, int & /* highwater */, int & /* dropped */
+    )
+    {
+        return false;
+    }
+
+    /**
+     *  Only the ALSA implementation can connect an existing port to a port
+     *  that has come back.
+     */
+
+    virtual bool api_reconnect ()
+    {
+        return false;
+    }
+
     /*
      * The next two functions are provisional.  Currently useful only in the
      * midi_jack module.
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-05
- * \updates       2022-06-15
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  We need to have a way to get all of the API information from each
@@ -54,7 +54,11 @@
  *  An alternate name for this class could be "midi_master".  :-)
  */
 
+#include <atomic>                       /* std::atomic<midipulse>           */
+#include <vector>                       /* std::vector<>                    */
+
 #include "rterror.hpp"                  /* seq66::rterror exception class   */
+#include "util/recmutex.hpp"            /* seq66::recmutex recursive mutex  */
 #include "rtmidi_types.hpp"             /* seq66::rtmidi_api, midi_message  */
 
 /**
@@ -347,6 +351,33 @@ private:
 
     int m_global_queue;
 
+    /**
+     *  The ID of the ALSA queue used to schedule output ahead of time when
+     *  the "alsa-lookahead" option is set.  It is kept apart from the global
+     *  queue so that input timestamps are not affected.  Otherwise c_bad_id.
+     */
+
+    int m_output_queue;
+
+    /**
+     *  The tick of the output frame being played, with its fraction.  It is
+     *  set once per frame by the output thread, so that an API that
+     *  schedules ahead can tell how late each event is.  Atomic because MIDI
+     *  thru also plays events.
+     */
+
+    std::atomic<double> m_frame_tick;
+
+    /**
+     *  Serializes output through a handle shared by all of the ports, as
+     *  with ALSA, where every port writes into the one client's output
+     *  buffer.  The master bus no longer serializes all output, so such an
+     *  API must lock this instead.  JACK ports each have their own buffer,
+     *  and do not use it.
+     */
+
+    mutable recmutex m_output_mutex;
+
     /**
      *  Provides a handle to the main ALSA or JACK implementation object.
      *  Created by the class derived from midi_info.
@@ -382,6 +413,38 @@ private:
 
     bool m_midi_port_refresh;
 
+public:
+
+    /**
+     *  A port that the system announced as started or exited while running,
+     *  as for the plugging or unplugging of a USB device.  The names are
+     *  those of the client and port, obtained when the port starts, since a
+     *  device that comes back can be given a new client number.
+     */
+
+    class port_change
+    {
+
+    public:
+
+        bool pc_started;                /**< Port start versus port exit.   */
+        int pc_client;                  /**< The system's client number.    */
+        int pc_port;                    /**< The system's port number.      */
+        std::string pc_client_name;     /**< The client name, when started. */
+        std::string pc_port_name;       /**< The port name, when started.   */
+
+    };
+
+private:
+
+    /**
+     *  Holds the port changes seen by api_get_midi_event(), until the master
+     *  bus takes them to update the busses.  Both are done in the input
+     *  thread, so no lock is needed.
+     */
+
+    std::vector<port_change> m_port_changes;
+
 protected:
 
     /**
@@ -604,6 +667,40 @@ public:
         return m_global_queue;
     }
 
+    int output_queue () const
+    {
+        return m_output_queue;
+    }
+
+    double frame_tick () const
+    {
+        return m_frame_tick.load(std::memory_order_relaxed);
+    }
+
+    void frame_tick (double tick)
+    {
+        m_frame_tick.store(tick, std::memory_order_relaxed);
+    }
+
+    recmutex & output_mutex () const
+    {
+        return m_output_mutex;
+    }
+
+    /**
+     *  Moves the pending port changes to the caller.
+     *
+     * \return
+     *      Returns true if there were any.
+     */
+
+    bool take_port_changes (std::vector<port_change> & changes)
+    {
+        changes.clear();
+        m_port_changes.swap(changes);
+        return ! changes.empty();
+    }
+
     /**
      *  A basic error reporting function for midi_info classes.
      */
@@ -630,6 +727,11 @@ protected:
         m_global_queue = q;
     }
 
+    void output_queue (int q)
+    {
+        m_output_queue = q;
+    }
+
     void midi_handle (void * h)
     {
         m_midi_handle = h;
@@ -640,6 +742,22 @@ protected:
         return m_bus_container;
     }
 
+    void post_port_change
+    (
+        bool started, int client, int port,
+        const std::string & clientname = "",
+        const std::string & portname = ""
+    )
+    {
+        port_change pc;
+        pc.pc_started = started;
+        pc.pc_client = client;
+        pc.pc_port = port;
+        pc.pc_client_name = clientname;
+        pc.pc_port_name = portname;
+        m_port_changes.push_back(pc);
+    }
+
 private:
 
     /**
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2022-09-13
+ * \updates       2026-10-14
  * \license       See above.
  *
  *    In this refactoring, we've stripped out most of the original RtMidi
@@ -176,6 +176,7 @@ protected:
         const std::string & destportname
     );
     bool register_port (midibase::io iotype, const std::string & portname);
+    void use_input_filter ();
 
 protected:
 
@@ -204,7 +205,9 @@ protected:
     }
 
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_batch (const batchevent * evs, int count) override;
     virtual void api_sysex (const event * e24) override;
+    virtual void api_sysex_chunk (const midibyte * data, int len) override;
     virtual void api_flush () override;
     virtual void api_continue_from (midipulse tick, midipulse beats) override;
     virtual void api_start () override;
@@ -213,6 +216,10 @@ protected:
     virtual void api_set_ppqn (int ppqn) override;
     virtual void api_set_beats_per_minute (midibpm bpm) override;
     virtual std::string api_get_port_name () override;
+    virtual bool api_buffer_stats
+    (
+        int & size, int & highwater, int & dropped
+    ) override;
 
 private:
 
@@ -27,25 +27,24 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-02
- * \updates       2022-11-22
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  GitHub issue #165: enabled a build and run with no JACK support.
  */
 
 #include "util/basic_macros.h"          /* nullptr and other macros         */
+#include "midi/inputfilter.hpp"         /* seq66::inputfilter class         */
 #include "midi/midibytes.hpp"           /* seq66::midibyte, other aliases   */
 #include "rtmidi_types.hpp"             /* seq66::rtmidi_in_data class      */
 
 #if defined SEQ66_JACK_SUPPORT
 
+#include <atomic>                       /* std::atomic<bool>                */
+#include <semaphore.h>                  /* sem_t, sem_post(), sem_wait()    */
 #include <jack/jack.h>
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
 #include "util/ring_buffer.hpp"         /* seq66::ring_buffer<> template    */
-#else
-#include <jack/ringbuffer.h>
-#endif
 
 /*
  * Do not document the namespace; it breaks Doxygen.
@@ -62,6 +61,34 @@ namespace seq66
 
 class midi_jack_data
 {
+
+public:
+
+    /**
+     *  A channel message routed by MIDI thru from an input port to an output
+     *  port, with the frame offset at which it arrived in the cycle.
+     */
+
+    class thru_event
+    {
+
+    public:
+
+        jack_nframes_t te_offset;       /**< The offset in the cycle.       */
+        size_t te_size;                 /**< The number of bytes, 1 to 3.   */
+        jack_midi_data_t te_data[3];    /**< The channel message.           */
+
+    };
+
+    /**
+     *  The most thru events an output port can take in one cycle.  More are
+     *  dropped.
+     */
+
+    static const int c_thru_capacity = 256;
+
+private:
+
     /**
      *  Holds data about JACK transport, to be used in midi_jack ::
      *  jack_frame_offset(). These values are a subset of what appears in the
@@ -79,6 +106,29 @@ class midi_jack_data
     static double sm_jack_frame_factor;         /* frames per PPQN tick     */
     static bool sm_use_offset;                  /* requires JACK transport  */
 
+    /**
+     *  The tick-to-frame mapping of the current process cycle when the
+     *  JACK-driven engine plays it.  Set by jack_process_io() before the
+     *  output ports are processed.
+     */
+
+    static jack_nframes_t sm_cycle_start;       /* jack_last_frame_time()   */
+    static bool sm_engine_active;               /* JACK cycle played events */
+    static double sm_engine_start_tick;         /* the tick at frame 0      */
+    static double sm_engine_ticks_per_frame;    /* the tempo, in frames     */
+
+    /**
+     *  The input "doorbell".  The JACK process callback posts the semaphore
+     *  when it has queued input, and the input thread blocks on it instead
+     *  of polling the input queues every few microseconds.  The pending
+     *  flag keeps it to one post per batch.  If the semaphore cannot be
+     *  made, input_wait() falls back to a short sleep.
+     */
+
+    static sem_t sm_input_semaphore;
+    static bool sm_input_semaphore_ok;
+    static std::atomic<bool> sm_input_pending;
+
     /**
      *  Holds the JACK sequencer client pointer so that it can be used by the
      *  midibus objects.  This is actually an opaque pointer; there is no way
@@ -106,11 +156,7 @@ class midi_jack_data
      *  MIDI message ring buffer.  (See issue #100).
      */
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
     ring_buffer<midi_message> * m_jack_buffer;
-#else
-    jack_ringbuffer_t * m_jack_buffmessage;
-#endif
 
     /**
      *  The last time-stamp obtained.  Use for calculating the delta time, I
@@ -139,6 +185,32 @@ class midi_jack_data
 
     rtmidi_in_data * m_jack_rtmidiin;
 
+    /**
+     *  For an input port, the output port to which jack_process_rtmidi_input()
+     *  sends the channel messages at once, as set up from the [midi-thru]
+     *  routes, or null.  Atomic, since the routes are set while the process
+     *  callback may be running.
+     */
+
+    std::atomic<midi_jack_data *> m_jack_thru;
+
+    /**
+     *  For an input port, the filter of its buss, run by
+     *  jack_process_rtmidi_input() before a message is routed or queued,
+     *  or null if it has none.  Set before the port is registered.
+     */
+
+    const inputfilter * m_jack_filter;
+
+    /**
+     *  For an output port, the thru events routed to it in this cycle, in
+     *  order of offset.  The input ports are processed first, so these go
+     *  out in the same cycle.  Only the JACK process thread uses them.
+     */
+
+    thru_event m_thru_events[c_thru_capacity];
+    int m_thru_count;
+
 public:
 
     midi_jack_data ();
@@ -174,6 +246,34 @@ public:
     );
     static double cycle (jack_nframes_t f, jack_nframes_t F);
     static double pulse_cycle (midipulse p, jack_nframes_t F);
+    static jack_nframes_t engine_offset (jack_nframes_t F, midipulse p);
+
+    static void engine_window (bool active, double tick, double tpf)
+    {
+        sm_engine_active = active;
+        sm_engine_start_tick = tick;
+        sm_engine_ticks_per_frame = tpf;
+    }
+
+    static bool engine_active ()
+    {
+        return sm_engine_active;
+    }
+
+    static void input_init ();
+    static void input_free ();
+    static void input_signal ();
+    static bool input_wait (int ms);
+
+    static jack_nframes_t cycle_start ()
+    {
+        return sm_cycle_start;
+    }
+
+    static void cycle_start (jack_nframes_t f)
+    {
+        sm_cycle_start = f;
+    }
 
     static double frame (midipulse p)
     {
@@ -326,37 +426,60 @@ public:
         m_jack_rtmidiin = rid;
     }
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-    bool valid_buffer () const
+    midi_jack_data * jack_thru () const
     {
-        return not_nullptr(m_jack_buffer);
+        return m_jack_thru.load(std::memory_order_acquire);
     }
 
-    ring_buffer<midi_message> * jack_buffer ()
+    void jack_thru (midi_jack_data * dest)
     {
-        return m_jack_buffer;
+        m_jack_thru.store(dest, std::memory_order_release);
     }
 
-    void jack_buffer (ring_buffer<midi_message> * rb)
+    const inputfilter * jack_filter () const
     {
-        m_jack_buffer = rb;
+        return m_jack_filter;
+    }
+
+    void jack_filter (const inputfilter * f)
+    {
+        m_jack_filter = f;
     }
-#else
+
+    bool thru_push
+    (
+        jack_nframes_t offset, const jack_midi_data_t * data, size_t size
+    );
+
+    int thru_count () const
+    {
+        return m_thru_count;
+    }
+
+    const thru_event & thru_at (int index) const
+    {
+        return m_thru_events[index];
+    }
+
+    void thru_clear ()
+    {
+        m_thru_count = 0;
+    }
+
     bool valid_buffer () const
     {
-        return not_nullptr(m_jack_buffmessage);
+        return not_nullptr(m_jack_buffer);
     }
 
-    jack_ringbuffer_t * jack_buffmessage ()
+    ring_buffer<midi_message> * jack_buffer ()
     {
-        return m_jack_buffmessage;
+        return m_jack_buffer;
     }
 
-    void jack_buffmessage (jack_ringbuffer_t * jrb)
+    void jack_buffer (ring_buffer<midi_message> * rb)
     {
-        m_jack_buffmessage = jrb;
+        m_jack_buffer = rb;
     }
-#endif
 
     jack_time_t jack_lasttime () const
     {
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-01
- * \updates       2023-12-08
+ * \updates       2026-10-14
  * \license       See above.
  *
  *    We need to have a way to get all of the JACK information of
@@ -40,6 +40,10 @@
 
 #if defined SEQ66_JACK_SUPPORT
 
+#include <atomic>                       /* std::atomic<bool>                */
+#include <thread>                       /* std::thread                      */
+#include <unordered_set>                /* std::unordered_set<>             */
+
 #include <jack/jack.h>                  /* JACK (2) API                     */
 
 #include "midi_info.hpp"                /* seq66::midi_port_info etc.       */
@@ -121,6 +125,25 @@ private:
 
     jack_nframes_t m_jack_sample_rate;
 
+    /**
+     *  With the "jack-lazy-connect" option, the thread that connects the
+     *  ports after the client is activated, and the flag that stops it at
+     *  exit.
+     */
+
+    std::thread m_connect_thread;
+    std::atomic<bool> m_connect_stop;
+
+    /**
+     *  The full names of the JACK MIDI ports in the graph, read with one
+     *  jack_get_ports() call before the connection pass, so that a missing
+     *  port is found without a failed jack_connect() round trip.  If not
+     *  loaded, every port is assumed to exist.
+     */
+
+    std::unordered_set<std::string> m_graph_ports;
+    bool m_graph_loaded;
+
 public:
 
     midi_jack_info () = delete;
@@ -190,6 +213,12 @@ private:
 
     jack_client_t * connect ();
     void disconnect ();
+    bool connect_all_ports ();
+    bool connect_ports (bool enabled);
+    void connect_lazily ();
+    void load_graph_ports ();
+    bool graph_has_port (const std::string & fullname) const;
+    void set_thru_routes ();
     void extract_names
     (
         const std::string & fullname,
@@ -0,0 +1,197 @@
+#if ! defined SEQ66_MIDI_NULL_HPP
+#define SEQ66_MIDI_NULL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midi_null.hpp
+ *
+ *  This module declares the MIDI I/O classes of the null MIDI API.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A null output port discards what it is sent, or loops it back to the
+ *  input ports (see midi_null_info), but first it timestamps the send and
+ *  compares it to the ideal time of the event, as given by its tick, the
+ *  tempo, and the time playback started.  The statistics are logged when
+ *  playback stops and when the port is closed.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <mutex>                        /* std::mutex, std::lock_guard      */
+
+#include "midi_api.hpp"                 /* seq66::midi_api                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class event;
+    class midibus;
+    class midi_null_info;
+
+/**
+ *  This class implements the null version of the midi_api.
+ */
+
+class midi_null : public midi_api
+{
+
+private:
+
+    using clock = std::chrono::steady_clock;
+
+    /**
+     *  The master information object, which holds the loopback queue.
+     */
+
+    midi_null_info & m_null_info;
+
+    /**
+     *  Guards the statistics, which are updated by the output thread and
+     *  reported by whatever thread stops playback.
+     */
+
+    std::mutex m_stats_mutex;
+
+    /**
+     *  The time and tick at which playback started or continued.  Sends
+     *  made while stopped (e.g. MIDI thru) are counted, but not timed.
+     */
+
+    clock::time_point m_origin;
+    midipulse m_origin_tick;
+    bool m_running;
+
+    /**
+     *  The tempo in force since the origin, and the tick of the last event
+     *  timed.  When the tempo changes, the origin is moved to that tick.
+     */
+
+    midibpm m_bpm;
+    midipulse m_last_tick;
+
+    /**
+     *  The number of events sent, and the number that were timed.
+     */
+
+    long m_send_count;
+    long m_timed_count;
+
+    /**
+     *  The sum, the most late, and the most early of the scheduling errors,
+     *  in microseconds.  A positive error means the event went out late.
+     */
+
+    double m_error_sum_us;
+    double m_late_max_us;
+    double m_early_max_us;
+
+public:
+
+    midi_null (midibus & parentbus, midi_info & masterinfo);
+    virtual ~midi_null ();
+
+protected:
+
+    virtual bool api_init_out () override;
+    virtual bool api_init_in () override;
+    virtual bool api_init_out_sub () override;
+    virtual bool api_init_in_sub () override;
+    virtual bool api_deinit_out () override;
+    virtual bool api_deinit_in () override;
+
+    virtual bool api_get_midi_event (event *) override
+    {
+        return false;                   /* see midi_null_info               */
+    }
+
+    virtual int api_poll_for_midi () override
+    {
+        return 0;                       /* see midi_in_null                 */
+    }
+
+    virtual bool api_connect () override;
+    virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_sysex (const event * e24) override;
+    virtual void api_flush () override;
+    virtual void api_continue_from (midipulse tick, midipulse beats) override;
+    virtual void api_start () override;
+    virtual void api_stop () override;
+    virtual void api_clock (midipulse tick) override;
+    virtual void api_set_ppqn (int ppqn) override;
+    virtual void api_set_beats_per_minute (midibpm bpm) override;
+
+    midi_null_info & null_info ()
+    {
+        return m_null_info;
+    }
+
+private:
+
+    void restart (midipulse tick);
+    void record (const event & ev);
+    void report ();
+
+};          // class midi_null
+
+/**
+ *  This class implements the null version of a MIDI input object.
+ */
+
+class midi_in_null final : public midi_null
+{
+
+public:
+
+    midi_in_null (midibus & parentbus, midi_info & masterinfo);
+
+    virtual int api_poll_for_midi () override;
+
+};          // class midi_in_null
+
+/**
+ *  This class implements the null version of a MIDI output object.
+ */
+
+class midi_out_null final : public midi_null
+{
+
+public:
+
+    midi_out_null (midibus & parentbus, midi_info & masterinfo);
+
+};          // class midi_out_null
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIDI_NULL_HPP
+
+/*
+ * midi_null.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
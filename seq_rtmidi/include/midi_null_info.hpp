@@ -0,0 +1,118 @@
+#if ! defined SEQ66_MIDI_NULL_INFO_HPP
+#define SEQ66_MIDI_NULL_INFO_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midi_null_info.hpp
+ *
+ *    A class for the ports of the null MIDI API, which has no devices.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       See above.
+ *
+ *    Selected by the --null-midi option.  The ports are made up, so that
+ *    the performer, the control paths, and the output thread can be run and
+ *    profiled without ALSA, JACK, or any hardware.  With "--null-midi=loop",
+ *    output is fed back to the input ports in memory.
+ */
+
+#include <condition_variable>           /* std::condition_variable          */
+#include <deque>                        /* std::deque<>                     */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+
+#include "midi_info.hpp"                /* seq66::midi_port_info etc.       */
+#include "midi/event.hpp"               /* seq66::event                     */
+
+/*
+ * Do not document the namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The class for the made-up null ports and the loopback queue.
+ */
+
+class midi_null_info final : public midi_info
+{
+
+private:
+
+    /**
+     *  Guards the loopback queue, which is filled by the output thread (or
+     *  MIDI thru) and emptied by the input thread.
+     */
+
+    std::mutex m_loop_mutex;
+
+    /**
+     *  Wakes up api_poll_for_midi() when an event is looped back.
+     */
+
+    std::condition_variable m_loop_cond;
+
+    /**
+     *  The events sent to the null output ports, when looping back, each
+     *  with the input buss it is to arrive on.
+     */
+
+    std::deque<event> m_loop_queue;
+
+public:
+
+    midi_null_info () = delete;
+    midi_null_info (const std::string & appname, int ppqn, midibpm bpm);
+    virtual ~midi_null_info ();
+
+    void loop_back (const event & ev, int outport);
+    int pending ();
+
+    virtual bool api_get_midi_event (event * inev) override;
+    virtual int api_poll_for_midi () override;
+
+    virtual void api_flush () override
+    {
+        // nothing is buffered
+    }
+
+private:
+
+    virtual int get_all_port_info
+    (
+        midi_port_info & inports,
+        midi_port_info & outports
+    ) override;
+
+};          // class midi_null_info
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIDI_NULL_INFO_HPP
+
+/*
+ * midi_null_info.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
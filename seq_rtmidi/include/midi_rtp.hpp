@@ -0,0 +1,119 @@
+#if ! defined SEQ66_MIDI_RTP_HPP
+#define SEQ66_MIDI_RTP_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midi_rtp.hpp
+ *
+ *  This module declares the MIDI I/O class of the network (RTP-MIDI)
+ *  busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  A network buss is a midibus like any other, added by mastermidibus after
+ *  the busses of the native API, whatever that is, one output and one input
+ *  for each peer of "rtp-midi-peers".  Its rtmidi object holds a midi_rtp
+ *  rather than the API's port class, and the midi_rtp hands the events to
+ *  the peer's session; see rtp_session.hpp.
+ */
+
+#include <cstdint>                      /* std::uint64_t                    */
+#include <memory>                       /* std::shared_ptr<>                */
+
+#include "midi_api.hpp"                 /* seq66::midi_api                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class event;
+    class midibus;
+    class rtp_peer;
+
+/**
+ *  This class implements the network version of the midi_api, for both
+ *  output and input.
+ */
+
+class midi_rtp final : public midi_api
+{
+
+private:
+
+    /**
+     *  The peer, which the network also holds, so that it lives as long
+     *  as the longer of the two.
+     */
+
+    std::shared_ptr<rtp_peer> m_peer;
+
+public:
+
+    midi_rtp
+    (
+        midibus & parentbus, midi_info & masterinfo,
+        std::shared_ptr<rtp_peer> peer
+    );
+    virtual ~midi_rtp ();
+
+protected:
+
+    virtual bool api_init_out () override;
+    virtual bool api_init_in () override;
+    virtual bool api_init_out_sub () override;
+    virtual bool api_init_in_sub () override;
+    virtual bool api_deinit_out () override;
+    virtual bool api_deinit_in () override;
+    virtual bool api_get_midi_event (event * inev) override;
+    virtual int api_poll_for_midi () override;
+    virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_sysex (const event * e24) override;
+    virtual void api_sysex_chunk (const midibyte * data, int len) override;
+    virtual void api_flush () override;
+    virtual void api_continue_from (midipulse tick, midipulse beats) override;
+    virtual void api_start () override;
+    virtual void api_stop () override;
+    virtual void api_clock (midipulse tick) override;
+    virtual void api_set_ppqn (int ppqn) override;
+    virtual void api_set_beats_per_minute (midibpm bpm) override;
+
+private:
+
+    std::uint64_t schedule (midipulse tick);
+    void send_byte (midipulse tick, midibyte status);
+
+};          // class midi_rtp
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIDI_RTP_HPP
+
+/*
+ * midi_rtp.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,13 +28,15 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-21
- * \updates       2025-01-20
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This midibus module is the RtMidi version of the midibus
  *  module.
  */
 
+#include <memory>                       /* std::shared_ptr<>                */
+
 #include "midi/midibase.hpp"            /* seq66::midibase class (new)      */
 #include "rtmidi_types.hpp"             /* midibase::port::normal           */
 
@@ -47,6 +49,7 @@ namespace seq66
     class event;
     class rtmidi;
     class rtmidi_info;
+    class rtp_peer;
 
 /**
  *  This class implements with rtmidi version of the midibus object.
@@ -79,6 +82,13 @@ private:
 
     rtmidi_info & m_master_info;
 
+    /**
+     *  The network peer of an RTP-MIDI buss, or null for a buss of the
+     *  native MIDI API.
+     */
+
+    std::shared_ptr<rtp_peer> m_rtp_peer;
+
 public:
 
     /*
@@ -94,6 +104,19 @@ public:
         int bussoverride        = null_buss()
     );
 
+    /*
+     * Network (RTP-MIDI) buss constructor.
+     */
+
+    midibus
+    (
+        rtmidi_info & rt,
+        std::shared_ptr<rtp_peer> peer,
+        int index,
+        int peerindex,
+        midibase::io iotype
+    );
+
     virtual ~midibus ();
 
     virtual bool api_connect ();
@@ -127,7 +150,15 @@ protected:
     virtual void api_stop () override;
     virtual void api_clock (midipulse tick) override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_batch (const batchevent * evs, int count) override;
+    virtual void api_retract (midibyte tag) override;
     virtual void api_sysex (const event * e24) override;
+    virtual void api_sysex_chunk (const midibyte * data, int len) override;
+    virtual bool api_buffer_stats
+    (
+        int & size, int & highwater, int & dropped
+    ) override;
+    virtual bool api_reconnect () override;
 
 };          // class midibus (rtmidi version)
 
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2025-01-20
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  The big difference between this class (seq66::rtmidi) and
@@ -35,6 +35,7 @@
  *  functions, while the latter gets if via midi_api_info-derived functions.
  */
 
+#include <memory>                           /* std::shared_ptr<>            */
 #include <string>
 
 #include "midi_api.hpp"                     /* seq66::midi[_in][_out]_api   */
@@ -47,6 +48,7 @@
 
 namespace seq66
 {
+    class rtp_peer;
 
 /**
  *  The main class of the rtmidi API.  We moved the enum Api definition into
@@ -93,6 +95,16 @@ public:
         get_api()->api_play(e24, channel);
     }
 
+    virtual void api_play_batch (const batchevent * evs, int count) override
+    {
+        get_api()->api_play_batch(evs, count);
+    }
+
+    virtual void api_retract (midibyte tag) override
+    {
+        get_api()->api_retract(tag);
+    }
+
     virtual void api_continue_from (midipulse tick, midipulse beats) override
     {
         get_api()->api_continue_from(tick, beats);
@@ -168,11 +180,29 @@ public:
         get_api()->api_sysex(e24);
     }
 
+    virtual void api_sysex_chunk (const midibyte * data, int len) override
+    {
+        get_api()->api_sysex_chunk(data, len);
+    }
+
     virtual void api_flush () override
     {
         get_api()->api_flush();
     }
 
+    virtual bool api_buffer_stats
+    (
+        int & size, int & highwater, int & dropped
+    ) override
+    {
+        return get_api()->api_buffer_stats(size, highwater, dropped);
+    }
+
+    virtual bool api_reconnect () override
+    {
+        return get_api()->api_reconnect();
+    }
+
 public:
 
     /**
@@ -280,6 +310,11 @@ class rtmidi_in : public rtmidi
 public:
 
     rtmidi_in (midibus & parentbus, rtmidi_info & info);
+    rtmidi_in
+    (
+        midibus & parentbus, rtmidi_info & info,
+        std::shared_ptr<rtp_peer> peer
+    );
     virtual ~rtmidi_in ();
 
 protected:
@@ -306,6 +341,11 @@ class rtmidi_out : public rtmidi
 public:
 
     rtmidi_out (midibus & parentbus, rtmidi_info & info);
+    rtmidi_out
+    (
+        midibus & parentbus, rtmidi_info & info,
+        std::shared_ptr<rtp_peer> peer
+    );
 
     /**
      *  The destructor closes any open MIDI connections.
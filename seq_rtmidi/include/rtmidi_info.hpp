@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Refactoring by Chris Ahlstrom
  * \date          2016-12-08
- * \updates       2022-03-26
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This class is like the rtmidi_in and rtmidi_out classes, but cut down to
@@ -297,11 +297,21 @@ public:
         return get_api_info()->api_get_midi_event(inev);
     }
 
+    bool take_port_changes (std::vector<midi_info::port_change> & changes)
+    {
+        return get_api_info()->take_port_changes(changes);
+    }
+
     void api_flush ()
     {
         get_api_info()->api_flush();
     }
 
+    void api_frame_tick (double tick)
+    {
+        get_api_info()->frame_tick(tick);
+    }
+
     int api_poll_for_midi ()
     {
         return get_api_info()->api_poll_for_midi();
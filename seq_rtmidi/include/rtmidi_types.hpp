@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-20
- * \updates       2023-12-03
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  The lack of hiding of these types within a class is a little to be
@@ -35,6 +35,7 @@
  *  refactor and partition, and slightly easier to read.
  */
 
+#include <atomic>                           /* std::atomic<unsigned>        */
 #include <string>                           /* std::string                  */
 #include <vector>                           /* std::vector container        */
 
@@ -71,6 +72,14 @@ namespace seq66
 
 const int c_default_queue_size  = 100;
 
+/**
+ *  The number of bytes a midi_message can hold without allocating.  This
+ *  covers all channel and system messages, and short SysEx (e.g. identity
+ *  requests and MMC).  Longer SysEx spills into a heap buffer.
+ */
+
+const int c_midi_message_inline = 16;
+
 /**
  *    MIDI API specifier arguments.  These items used to be nested in
  *    the rtmidi class, but that only worked when RtMidi.cpp/h were
@@ -82,6 +91,7 @@ enum class rtmidi_api
     unspecified,        /**< Search for a working compiled API.     */
     alsa,               /**< Advanced Linux Sound Architecture API. */
     jack,               /**< JACK Low-Latency MIDI Server API.      */
+    null,               /**< No devices; for profiling and testing. */
 
 #if defined SEQ66_USE_RTMIDI_API_ALL
 
@@ -143,6 +153,11 @@ api_to_int (rtmidi_api api)
  *  uses the seq66::event rather than the seq66::midi_message object.
  *  For the moment, we will translate between them until we have the
  *  interactions between the old and new modules under control.
+ *
+ *  The bytes are stored inline, up to c_midi_message_inline of them, so
+ *  that creating, pushing, and copying a message in the JACK process
+ *  callback and in send_message() does not call malloc().  Only a SysEx
+ *  message longer than that moves its bytes into the heap container.
  */
 
 class midi_message
@@ -186,15 +201,29 @@ private:
 #endif
 
     /**
-     *  Holds the event status and data bytes.
+     *  Holds the event status and data bytes, as long as they fit.
+     */
+
+    midibyte m_inline_bytes[c_midi_message_inline];
+
+    /**
+     *  Holds all of the bytes once there are more than will fit inline.
+     *  Empty (and unallocated) otherwise.
+     */
+
+    container m_heap_bytes;
+
+    /**
+     *  The number of bytes in the message, whichever buffer holds them.
      */
 
-    container m_bytes;
+    std::size_t m_byte_count;
 
     /**
      *  Holds the timestamp of the MIDI message. Non-zero only in the JACK
      *  implementation at present.  It can also hold a JACK frame number. The
-     *  caller can know this only by context at present.
+     *  caller can know this only by context at present.  For JACK input, it
+     *  is the arrival time in the microtime() time base.
      */
 
     midipulse m_timestamp;
@@ -213,28 +242,30 @@ public:
     midi_message (const midibyte * mbs, std::size_t sz);
     midi_message (const midi_message & rhs) = default;
     midi_message & operator = (const midi_message & rhs) = default;
+    midi_message (midi_message && rhs) = default;
+    midi_message & operator = (midi_message && rhs) = default;
     ~midi_message () = default;
 
     midibyte & operator [] (std::size_t i)
     {
         static midibyte s_zero = 0;
-        return (i < m_bytes.size()) ? m_bytes[i] : s_zero ;
+        return (i < m_byte_count) ? bytes()[i] : s_zero ;
     }
 
     const midibyte & operator [] (std::size_t i) const
     {
         static midibyte s_zero = 0;
-        return (i < m_bytes.size()) ? m_bytes[i] : s_zero ;
+        return (i < m_byte_count) ? bytes()[i] : s_zero ;
     }
 
     const char * buffer () const                // was "array"
     {
-        return reinterpret_cast<const char *>(&m_bytes[0]);
+        return reinterpret_cast<const char *>(bytes());
     }
 
     const midibyte * event_bytes () const       // bypasses timestamp
     {
-        return m_bytes.data();
+        return bytes();
     }
 
 #if defined SEQ66_SHOW_TIMING
@@ -263,14 +294,21 @@ public:
 
     int event_count () const                    // was "count"
     {
-        return int(m_bytes.size());
+        return int(m_byte_count);
     }
 
     void push (midibyte b)
     {
-        m_bytes.push_back(b);
+        if (m_byte_count < std::size_t(c_midi_message_inline))
+            m_inline_bytes[m_byte_count] = b;
+        else
+            spill(b);
+
+        ++m_byte_count;
     }
 
+    void push (const midibyte * mbs, std::size_t sz);
+
     midipulse timestamp () const
     {
         return m_timestamp;
@@ -293,18 +331,35 @@ public:
 
     midibyte status () const
     {
-        return event_count() > 0 ? m_bytes[0] : 0 ;
+        return event_count() > 0 ? bytes()[0] : 0 ;
     }
 
     bool is_sysex () const
     {
-        return m_bytes.size() > 0 ? event::is_sysex_msg(m_bytes[0]) : false ;
+        return m_byte_count > 0 ? event::is_sysex_msg(bytes()[0]) : false ;
     }
 
     std::string to_string () const;
 
 private:
 
+    bool is_inline () const
+    {
+        return m_byte_count <= std::size_t(c_midi_message_inline);
+    }
+
+    midibyte * bytes ()
+    {
+        return is_inline() ? &m_inline_bytes[0] : m_heap_bytes.data() ;
+    }
+
+    const midibyte * bytes () const
+    {
+        return is_inline() ? &m_inline_bytes[0] : m_heap_bytes.data() ;
+    }
+
+    void spill (midibyte b);
+
 };          // class midi_message
 
 /**
@@ -324,6 +379,9 @@ using rtmidi_callback_t = void (*)
  *  Provides a queue of midi_message structures.  This entity used to be a
  *  plain structure nested in the midi_in_api class.  We made it a class to
  *  encapsulate some common operations to save a burden on the callers.
+ *
+ *  The JACK process callback adds, and the input thread pops, at the same
+ *  time.  Each side owns its own index, and the shared count is atomic.
  */
 
 class midi_queue
@@ -333,7 +391,7 @@ private:
 
     unsigned m_front;
     unsigned m_back;
-    unsigned m_size;
+    std::atomic<unsigned> m_size;           /* JACK adds, input thread pops */
     unsigned m_ring_size;
     midi_message * m_ring;
 
@@ -363,6 +421,7 @@ public:
     }
 
     bool add (const midi_message & mmsg);
+    bool add (midi_message && mmsg);
     void pop ();
     midi_message pop_front ();
     void allocate (unsigned queuesize = c_default_queue_size);
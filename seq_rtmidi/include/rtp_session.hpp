@@ -0,0 +1,432 @@
+#if ! defined SEQ66_RTP_SESSION_HPP
+#define SEQ66_RTP_SESSION_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          rtp_session.hpp
+ *
+ *  This module declares the network MIDI (RTP-MIDI, AppleMIDI) sessions
+ *  behind the network busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  Each peer of the 'rc' option "rtp-midi-peers" is a remote MIDI device
+ *  (or a computer running an RTP-MIDI driver).  The rtp_network owns the
+ *  two UDP sockets of the session, the control port ("rtp-midi-port") and
+ *  the data port (the next one), and a thread that:
+ *
+ *      -   Invites each peer, with the AppleMIDI "IN" command, first on its
+ *          control port and then on its data port, and invites it again
+ *          every few seconds until it answers "OK".  A peer that invites
+ *          Seq66 is accepted if its host is configured.
+ *      -   Runs the AppleMIDI clock synchronization ("CK"), to learn the
+ *          offset between the two 10 kHz clocks, so that the timestamps of
+ *          incoming packets can be followed.
+ *      -   Sends receiver feedback ("RS"), which lets the peer trim its
+ *          recovery journal, and takes the peer's, which trims ours.
+ *      -   Receives the RTP-MIDI packets, recovers from a gap in the
+ *          sequence numbers with the recovery journal of the next packet,
+ *          and queues the events to the peer's input buss at their time.
+ *
+ *  The output thread appends each event played on a peer's output buss to
+ *  the peer's packet, timestamped "rtp-midi-lookahead" ms after the exact
+ *  time of its tick, as "alsa-lookahead" does; when the frame is flushed,
+ *  each peer with events gets one packet.  The recovery journal (RFC 6295),
+ *  sent with each packet, holds chapters P (program), C (controllers), W
+ *  (pitch wheel), and N (notes) of each channel changed since the
+ *  checkpoint, which is the last packet the peer said it got.  The system
+ *  chapters and SysEx are not journalled.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstdint>                      /* std::uint16_t, std::uint32_t     */
+#include <deque>                        /* std::deque<>                     */
+#include <memory>                       /* std::shared_ptr<>                */
+#include <mutex>                        /* std::mutex, std::lock_guard      */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include <netinet/in.h>                 /* struct sockaddr_in               */
+
+#include "rtmidi_types.hpp"             /* seq66::midi_message              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The MIDI channel state of one end of a stream:  what the sender
+ *  journals, and what the receiver compares the journal to.
+ */
+
+class rtp_journal
+{
+
+private:
+
+    /**
+     *  The state of one channel.  Each item has the sequence number of the
+     *  packet that last changed it, and a flag that it changed after the
+     *  checkpoint, and so belongs in the journal.
+     */
+
+    struct channel
+    {
+        midibyte ch_velocity[128];              /**< 0 means the note is off */
+        std::uint16_t ch_note_seq[128];
+        bool ch_note_new[128];
+        midibyte ch_control[128];
+        std::uint16_t ch_control_seq[128];
+        bool ch_control_new[128];
+        int ch_program;                         /**< -1 until one is seen   */
+        int ch_bank_msb;
+        int ch_bank_lsb;
+        std::uint16_t ch_program_seq;
+        bool ch_program_new;
+        int ch_pitch;                           /**< 14 bits; -1 none yet   */
+        std::uint16_t ch_pitch_seq;
+        bool ch_pitch_new;
+    };
+
+    channel m_channels[16];
+
+public:
+
+    rtp_journal ();
+
+    void clear ();
+    void update (const midibyte * msg, int len, std::uint16_t seq);
+    void encode (std::vector<midibyte> & out, std::uint16_t checkpoint);
+    bool recover
+    (
+        const midibyte * journal, int len, std::vector<midi_message> & fixes
+    );
+
+private:
+
+    void recover_channel
+    (
+        int ch, midibyte toc, const midibyte * p, int len,
+        std::vector<midi_message> & fixes
+    );
+    void fix
+    (
+        std::vector<midi_message> & fixes,
+        midibyte status, midibyte d0, midibyte d1
+    );
+
+};          // class rtp_journal
+
+/**
+ *  One remote RTP-MIDI device:  its session state, the packet being built
+ *  for it, and the events that came from it.
+ */
+
+class rtp_peer
+{
+    friend class rtp_network;
+
+public:
+
+    /**
+     *  The progress of the session with the peer.
+     */
+
+    enum class state
+    {
+        idle,                   /**< Not yet invited, or it said goodbye.   */
+        control,                /**< Invited on the control port.           */
+        data,                   /**< Invited on the data port.              */
+        connected               /**< In the session.                        */
+    };
+
+private:
+
+    /**
+     *  The peer as configured, "host:port", which names its busses.
+     */
+
+    std::string m_name;
+    std::string m_host;
+    int m_port;
+
+    /**
+     *  The control and data addresses of the peer, once the host is
+     *  resolved.
+     */
+
+    sockaddr_in m_control_addr;
+    sockaddr_in m_data_addr;
+    bool m_resolved;
+
+    /**
+     *  The data socket of the network, which the output thread sends on.
+     *  Set to -1 when the network closes, in case a buss outlives it.
+     */
+
+    int m_data_fd;
+
+    /**
+     *  Copies of the network's synchronization source, the microtime() at
+     *  which its 10 kHz clock started, and the lookahead, for the output
+     *  thread.
+     */
+
+    std::uint32_t m_ssrc;
+    long m_origin_us;
+    long m_lookahead_us;
+
+    /**
+     *  The session state, which only the network thread changes.  The
+     *  output thread sends only when connected.
+     */
+
+    std::atomic<state> m_state;
+    std::uint32_t m_token;
+    std::uint32_t m_peer_ssrc;
+    long m_retry_us;
+    int m_tries;
+    long m_sync_us;
+    int m_syncs;
+    long m_heard_us;
+
+    /**
+     *  The offset of the peer's 10 kHz clock from ours, and true once a
+     *  clock synchronization gave it.
+     */
+
+    std::atomic<std::int64_t> m_offset;
+    std::atomic<bool> m_synced;
+
+    /**
+     *  Guards the output side, used by the output thread to build the
+     *  packet, and by the network thread to take the peer's feedback.
+     */
+
+    std::mutex m_send_mutex;
+    std::vector<midibyte> m_commands;
+    std::vector<midibyte> m_packet;
+    std::uint64_t m_first_ts;
+    std::uint64_t m_last_ts;
+    midibyte m_send_status;
+    std::uint16_t m_send_seq;
+    std::uint16_t m_checkpoint;
+    bool m_acked;
+    rtp_journal m_send_journal;
+
+    /**
+     *  The receiving side, used by the network thread only, except for the
+     *  queue of events, which is guarded.
+     */
+
+    rtp_journal m_recv_journal;
+    bool m_recv_started;
+    std::uint16_t m_recv_seq;
+    midibyte m_recv_status;
+    midibytes m_recv_sysex;
+    long m_feedback_us;
+    std::mutex m_recv_mutex;
+    std::deque<midi_message> m_inbox;
+    int m_input_buss;
+
+    /**
+     *  Statistics, logged as the network closes.
+     */
+
+    std::atomic<long> m_packets_sent;
+    std::atomic<long> m_packets_received;
+    std::atomic<long> m_packets_lost;
+
+public:
+
+    rtp_peer (const std::string & host, int port);
+
+    rtp_peer (const rtp_peer &) = delete;
+    rtp_peer & operator = (const rtp_peer &) = delete;
+
+    const std::string & name () const
+    {
+        return m_name;
+    }
+
+    bool connected () const
+    {
+        return m_state == state::connected;
+    }
+
+    void input_buss (int b)
+    {
+        m_input_buss = b;
+    }
+
+    long lookahead_us () const
+    {
+        return m_lookahead_us;
+    }
+
+    std::uint64_t clock_ts () const;
+    void append
+    (
+        const midibyte * msg, int len, std::uint64_t ts,
+        bool runstatus = false
+    );
+    void flush ();
+    int pending_input (long now);
+    bool pop_input (midi_message & mm, long now);
+
+private:
+
+    void reset_session ();
+    void send_packet ();
+    void receive_packet (const midibyte * p, int len, long now);
+    void queue_input (const midibyte * msg, int len, long due);
+    void take_feedback (std::uint16_t seq);
+
+};          // class rtp_peer
+
+/**
+ *  The session endpoint:  the sockets, the peers, and the network thread.
+ */
+
+class rtp_network
+{
+
+private:
+
+    using peer_list = std::vector<std::shared_ptr<rtp_peer>>;
+
+    /**
+     *  The peers, in the order of the option, and so of their busses.
+     */
+
+    peer_list m_peers;
+
+    /**
+     *  The local control port, and the sockets of it and the data port.
+     */
+
+    int m_port;
+    int m_control_fd;
+    int m_data_fd;
+
+    /**
+     *  Our synchronization source identifier, and the name given to the
+     *  peers.
+     */
+
+    std::uint32_t m_ssrc;
+    std::string m_name;
+
+    /**
+     *  The timestamp lookahead, in microseconds.
+     */
+
+    long m_lookahead_us;
+
+    /**
+     *  The microtime() at which our 10 kHz clock started.
+     */
+
+    long m_origin_us;
+
+    /**
+     *  The network thread and its flag.
+     */
+
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+
+    /**
+     *  The receive buffer of the network thread.
+     */
+
+    std::vector<midibyte> m_buffer;
+
+public:
+
+    rtp_network (const std::string & peers, int port, int lookaheadms);
+    ~rtp_network ();
+
+    rtp_network (const rtp_network &) = delete;
+    rtp_network & operator = (const rtp_network &) = delete;
+
+    bool start (const std::string & clientname);
+    void stop ();
+    void flush ();
+
+    int count () const
+    {
+        return int(m_peers.size());
+    }
+
+    std::shared_ptr<rtp_peer> peer (int i) const
+    {
+        return m_peers[std::size_t(i)];
+    }
+
+    std::uint64_t clock_ts () const;
+
+private:
+
+    bool open_socket (int & fd, int port);
+    void close_sockets ();
+    void net_loop ();
+    void service (long now);
+    void read_socket (int fd, bool iscontrol, long now);
+    void session_command
+    (
+        const midibyte * p, int len, const sockaddr_in & from,
+        bool iscontrol, long now
+    );
+    void send_invitation (rtp_peer & pr, bool iscontrol);
+    void send_command
+    (
+        int fd, const sockaddr_in & to, const char * cmd,
+        std::uint32_t token, bool withname = true
+    );
+    void send_sync
+    (
+        rtp_peer & pr, int count, std::uint64_t ts1,
+        std::uint64_t ts2, std::uint64_t ts3
+    );
+    void send_feedback (rtp_peer & pr);
+    rtp_peer * find_peer (const sockaddr_in & from, bool iscontrol);
+    rtp_peer * find_peer (std::uint32_t ssrc);
+
+};          // class rtp_network
+
+}           // namespace seq66
+
+#endif      // SEQ66_RTP_SESSION_HPP
+
+/*
+ * rtp_session.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
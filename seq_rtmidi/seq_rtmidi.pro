@@ -37,6 +37,10 @@ CONFIG(debug, debug|release) {
 DEFINES += "SEQ66_MIDILIB=rtmidi"
 DEFINES += "SEQ66_RTMIDI_SUPPORT=1"
 
+contains (CONFIG, lean) {
+   DEFINES += "SEQ66_LEAN_ENGINE=1"
+}
+
 HEADERS += \
  include/mastermidibus_rm.hpp \
  include/midibus_rm.hpp \
@@ -47,10 +51,14 @@ HEADERS += \
  include/midi_jack.hpp \
  include/midi_jack_data.hpp \
  include/midi_jack_info.hpp \
+ include/midi_null.hpp \
+ include/midi_null_info.hpp \
  include/midi_probe.hpp \
+ include/midi_rtp.hpp \
  include/rterror.hpp \
  include/rtmidi.hpp \
  include/rtmidi_info.hpp \
+ include/rtp_session.hpp \
  include/seq66_rtmidi_features.h
 
 # Mac OSX and Windows currently are not supported by the internal rtmidi
@@ -66,10 +74,14 @@ SOURCES += \
  src/midi_jack.cpp \
  src/midi_jack_data.cpp \
  src/midi_jack_info.cpp \
+ src/midi_null.cpp \
+ src/midi_null_info.cpp \
  src/midi_probe.cpp \
+ src/midi_rtp.cpp \
  src/rtmidi.cpp \
  src/rtmidi_info.cpp \
- src/rtmidi_types.cpp
+ src/rtmidi_types.cpp \
+ src/rtp_session.cpp
 
 # Note that the seq66-config.h file in ../include/qt/rtmidi, though based on a
 # bootstrap of the release mode of the GNU Autotools-built version of
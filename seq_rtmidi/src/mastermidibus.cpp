@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-06-04
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the mastermidibus
@@ -36,6 +36,7 @@
 #include "midi/event.hpp"               /* seq66::event                     */
 #include "mastermidibus_rm.hpp"         /* seq66::mastermidibus, rtmidi     */
 #include "midibus_rm.hpp"               /* seq66::midibus, rtmidi           */
+#include "rtp_session.hpp"              /* seq66::rtp_network, RTP-MIDI     */
 
 #define SEQ66_USE_JACK_POLLING_FLAG     /* until we reconcile ALSA/JACK     */
 
@@ -62,10 +63,13 @@ mastermidibus::mastermidibus (int ppqn, midibpm bpm) :
     mastermidibase      (ppqn, bpm),
     m_midi_master                                           /* rtmidi_info  */
     (
-        rc().with_jack_midi() ? rtmidi_api::jack : rtmidi_api::alsa,
+        rc().with_null_midi() ? rtmidi_api::null :
+            rc().with_jack_midi() ? rtmidi_api::jack : rtmidi_api::alsa,
         rc().app_client_name(), ppqn, bpm
     ),
-    m_use_jack_polling  (rc().with_jack_midi())
+    m_use_jack_polling  (rc().with_jack_midi() && ! rc().with_null_midi()),
+    m_rtp_network       (),
+    m_rtp_inputs        ()
 {
     // Empty body
 }
@@ -77,7 +81,8 @@ mastermidibus::mastermidibus (int ppqn, midibpm bpm) :
 
 mastermidibus::~mastermidibus ()
 {
-    // Empty body
+    if (m_rtp_network)
+        m_rtp_network->stop();
 }
 
 /**
@@ -196,6 +201,7 @@ mastermidibus::api_init (int ppqn, midibpm bpm)
             }
         }
     }
+    make_network_busses();
     set_beats_per_minute(bpm);
     set_ppqn(ppqn);
 }
@@ -241,6 +247,53 @@ mastermidibus::make_normal_bus (int bus, midibase::io iotype)
     return m;
 }
 
+/**
+ *  Adds an output and an input buss for each peer of the "rtp-midi-peers"
+ *  option, after the busses of the native API, so that the numbers of
+ *  those busses do not change.  The session itself starts in activate().
+ */
+
+void
+mastermidibus::make_network_busses ()
+{
+    if (rc().rtp_midi_peers().empty() || m_rtp_network)
+        return;
+
+    m_rtp_network.reset
+    (
+        new (std::nothrow) rtp_network
+        (
+            rc().rtp_midi_peers(), rc().rtp_midi_port(),
+            rc().rtp_midi_lookahead_ms()
+        )
+    );
+    if (! m_rtp_network)
+        return;
+
+    for (int p = 0; p < m_rtp_network->count(); ++p)
+    {
+        std::shared_ptr<rtp_peer> peer = m_rtp_network->peer(p);
+        int bus = m_outbus_array.count();
+        midibus * m = new (std::nothrow) midibus
+        (
+            midi_master(), peer, bus, p, midibase::io::output
+        );
+        if (not_nullptr(m))
+            m_outbus_array.add(m, clock(bus));
+
+        bus = m_inbus_array.count();
+        m = new (std::nothrow) midibus
+        (
+            midi_master(), peer, bus, p, midibase::io::input
+        );
+        if (not_nullptr(m))
+        {
+            m_inbus_array.add(m, input(bus));
+            m_rtp_inputs.push_back(m);
+        }
+    }
+}
+
 /**
  *  Activates the mastermidibase code and the rtmidi_info object via its
  *  api_connect() function.
@@ -253,6 +306,37 @@ mastermidibus::activate ()
     if (result)
         result = midi_master().api_connect();      /* activates, too    */
 
+    if (result && m_rtp_network)
+        (void) m_rtp_network->start(rc().app_client_name());
+
+    return result;
+}
+
+/**
+ *  Flushes the API's output, and sends the packet each network peer got
+ *  in this frame.
+ */
+
+void
+mastermidibus::api_flush ()
+{
+    midi_master().api_flush();
+    if (m_rtp_network)
+        m_rtp_network->flush();
+}
+
+/**
+ *  For the ALSA and null APIs, counts the events the network input busses
+ *  have due.
+ */
+
+int
+mastermidibus::network_poll ()
+{
+    int result = 0;
+    for (auto m : m_rtp_inputs)
+        result += m->poll_for_midi();
+
     return result;
 }
 
@@ -261,9 +345,11 @@ mastermidibus::activate ()
  *  primitive poll, which exits when some data is obtained, or sleeps a
  *  millisecond in note data is obtained.
  *
- *  For JACK polling, call the base-class implementation:
+ *  For JACK polling, check the input queues of the ports.  If they are
+ *  empty, block in midi_jack_info::api_poll_for_midi() until the JACK
+ *  process callback signals input (or a short timeout passes), and check
+ *  again.  There is no sleeping or spinning.  The queues are checked via:
  *
- *      -   mastermidibase::api_poll_for_midi()
  *      -   busarray::poll_for_midi()
  *      -   businfo::poll_for_midi()
  *      -   midibus::poll_for_midi() [midibase::poll_for_midi()]
@@ -290,9 +376,26 @@ mastermidibus::api_poll_for_midi ()
 {
 #if defined SEQ66_USE_JACK_POLLING_FLAG
     if (m_use_jack_polling)                             /* --jack-midi set  */
-        return mastermidibase::api_poll_for_midi();     /* inbus-array poll */
+    {
+        int result = m_inbus_array.poll_for_midi();     /* queued already?  */
+        if (result == 0)
+        {
+            (void) midi_master().api_poll_for_midi();   /* block on input   */
+            result = m_inbus_array.poll_for_midi();
+        }
+        return result;
+    }
     else
-        return midi_master().api_poll_for_midi();       /* ALSA poll        */
+    {
+        int result = network_poll();                    /* RTP-MIDI input   */
+        if (result == 0)
+        {
+            result = midi_master().api_poll_for_midi(); /* ALSA poll        */
+            if (result == 0)
+                result = network_poll();
+        }
+        return result;
+    }
 #else
     return mastermidibase::api_poll_for_midi();         /* inbus-array poll */
 #endif
@@ -300,6 +403,8 @@ mastermidibus::api_poll_for_midi ()
 
 /**
  *  Grab a MIDI event.  For the ALSA implementation, this call is ...???
+ *  The ALSA implementation also sees the announcements of ports that start
+ *  and exit; see apply_port_changes().
  *
  * \threadsafe
  */
@@ -309,14 +414,73 @@ mastermidibus::api_get_midi_event (event * inev)
 {
 #if defined SEQ66_USE_JACK_POLLING_FLAG
     if (m_use_jack_polling)
+    {
         return m_inbus_array.get_midi_event(inev);
+    }
     else
-        return midi_master().api_get_midi_event(inev);
+    {
+        for (auto m : m_rtp_inputs)
+        {
+            if (m->get_midi_event(inev))
+            {
+                inev->set_input_bus(bussbyte(m->bus_index()));
+                return true;
+            }
+        }
+
+        bool result = midi_master().api_get_midi_event(inev);
+        apply_port_changes();
+        return result;
+    }
 #else
     return m_inbus_array.get_midi_event(inev);
 #endif
 }
 
+/**
+ *  Acts on the ports that the MIDI API saw start or exit (hot-plugging).
+ *  A port that exits makes its busses inactive.  A port that starts
+ *  reconnects the busses that had it, found by name.  Only those busses are
+ *  touched: nothing is enumerated or rebuilt, and the buss numbers used by
+ *  the patterns and by the clock and input lists do not change.  A port
+ *  that was not in use is left for the next start of the application (or a
+ *  full refresh of the ports).
+ */
+
+void
+mastermidibus::apply_port_changes ()
+{
+    std::vector<midi_info::port_change> changes;
+    if (! midi_master().take_port_changes(changes))
+        return;
+
+    for (const auto & pc : changes)
+    {
+        std::string name =
+            std::to_string(pc.pc_client) + ":" + std::to_string(pc.pc_port);
+
+        if (pc.pc_started)
+        {
+            bool ok = port_restart
+            (
+                pc.pc_client, pc.pc_port, pc.pc_client_name, pc.pc_port_name
+            );
+            if (ok)
+            {
+                name += " ";
+                name += pc.pc_port_name;
+                info_message("Port reconnected", name);
+            }
+        }
+        else
+        {
+            port_exit(pc.pc_client, pc.pc_port);
+            if (rc().verbose())
+                info_message("Port exited", name);
+        }
+    }
+}
+
 }           // namespace seq66
 
 /*
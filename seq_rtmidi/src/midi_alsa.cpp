@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-18
- * \updates       2024-06-06
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Linux-only implementation of ALSA MIDI support.
@@ -111,6 +111,7 @@
 
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
 #include "midi/event.hpp"               /* seq66::event (MIDI event)        */
+#include "util/automutex.hpp"           /* seq66::automutex                 */
 #include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
 #include "midi_alsa.hpp"                /* seq66::midi_alsa for ALSA        */
 #include "midi_info.hpp"                /* seq66::midi_info                 */
@@ -128,6 +129,22 @@ namespace seq66
  * --------------------------------------------------------------------------
  */
 
+/**
+ *  Defines the size of the MIDI event buffer, which should be large enough to
+ *  accomodate the largest MIDI message to be encoded.
+ *  A local define for visibility.  Also provided, but not yet used, is a size
+ *  for SysEx events, which we don't handle, but want to note here.  Inspired
+ *  by Qtractor code. Also in Qtractor, the same snd_midi_event_t object is
+ *  used over and over, rather than being recreated/destroyed for every
+ *  event-play by snd_midi_event_new() and snd_midi_event_free().
+ *
+ * Unused:
+ *
+ *      static const size_t s_sysex_size_max = 512; // Hydrogen uses 32 w/input
+ */
+
+static const size_t s_event_size_max =  10;
+
 /**
  *  Provides a constructor with client number, port number, ALSA sequencer
  *  support, name of client, name of port, etc., mostly contained within an
@@ -170,8 +187,14 @@ midi_alsa::midi_alsa (midibus & parentbus, midi_info & masterinfo) :
     m_dest_addr_client  (parentbus.bus_id()),
     m_dest_addr_port    (parentbus.port_id()),
     m_local_addr_client (snd_seq_client_id(m_seq)),     /* our client ID    */
-    m_local_addr_port   (-1)
+    m_local_addr_port   (-1),
+    m_midi_encoder      (nullptr),
+    m_lookahead_us      (long(rc().alsa_lookahead_ms()) * 1000),
+    m_tag               (0)
 {
+    if (snd_midi_event_new(s_event_size_max, &m_midi_encoder) != 0)
+        m_midi_encoder = nullptr;
+
     set_client_id(m_local_addr_client);
     set_name(SEQ66_CLIENT_NAME, bus_name(), port_name());
 #if defined SEQ66_SHOW_BUS_VALUES
@@ -180,12 +203,13 @@ midi_alsa::midi_alsa (midibus & parentbus, midi_info & masterinfo) :
 }
 
 /**
- *  A rote empty virtual destructor.
+ *  Frees the MIDI event encoder.
  */
 
 midi_alsa::~midi_alsa ()
 {
-    // empty body
+    if (not_nullptr(m_midi_encoder))
+        snd_midi_event_free(m_midi_encoder);
 }
 
 /**
@@ -305,6 +329,59 @@ midi_alsa::api_init_in ()
     return true;
 }
 
+/**
+ *  Connects the local port, made by api_init_out() or api_init_in(), to the
+ *  system port given by the parent buss, which has been updated to the new
+ *  client and port numbers of a device that went away and came back.  ALSA
+ *  drops the old subscription when the device goes away, so there is
+ *  nothing to undo.  Only the shared sequencer handle is used, so the
+ *  output mutex is held, as in api_play().
+ *
+ * \return
+ *      Returns true if the connection was made.
+ */
+
+bool
+midi_alsa::api_reconnect ()
+{
+    if (m_local_addr_port < 0 || is_virtual_port())
+        return false;
+
+    automutex locker(master_info().output_mutex());
+    m_dest_addr_client = parent_bus().bus_id();
+    m_dest_addr_port = parent_bus().port_id();
+    int rcode;
+    if (is_input_port())
+    {
+        rcode = snd_seq_connect_from
+        (
+            m_seq, m_local_addr_port, m_dest_addr_client, m_dest_addr_port
+        );
+    }
+    else
+    {
+        rcode = snd_seq_connect_to
+        (
+            m_seq, m_local_addr_port, m_dest_addr_client, m_dest_addr_port
+        );
+    }
+
+    bool result = rcode >= 0;
+    if (result)
+    {
+        set_port_open();
+    }
+    else
+    {
+        msgprintf
+        (
+            msglevel::error, "ALSA reconnect %d:%d error",
+            m_dest_addr_client, m_dest_addr_port
+        );
+    }
+    return result;
+}
+
 /**
  *  Gets information directly from ALSA.  The problem this function solves is
  *  that the midibus constructor for a virtual ALSA port doesn't not have all
@@ -502,27 +579,99 @@ midi_alsa::api_connect ()
 }
 
 /**
- *  Defines the size of the MIDI event buffer, which should be large enough to
- *  accomodate the largest MIDI message to be encoded.
- *  A local define for visibility.  Also provided, but not yet used, is a size
- *  for SysEx events, which we don't handle, but want to note here.  Inspired
- *  by Qtractor code. Also in Qtractor, the same snd_midi_event_t object is
- *  used over and over, rather than being recreated/destroyed for every
- *  event-play by snd_midi_event_new() and snd_midi_event_free().
+ *  Fills in an ALSA event from a channel-voice message directly, rather
+ *  than by feeding the bytes to the ALSA MIDI encoder, which resets its
+ *  state and parses the status byte all over again for every event played.
+ *  The results are the same as the encoder's: the pitch-wheel value is made
+ *  signed, and a Note On with a velocity of 0 stays a Note On.
  *
- * Unused:
+ * \param ev
+ *      The ALSA event, already cleared.
  *
- *      static const size_t s_sysex_size_max = 512; // Hydrogen uses 32 w/input
+ * \param status
+ *      The status byte, with the channel already masked in.
+ *
+ * \param d0
+ *      The first data byte.
+ *
+ * \param d1
+ *      The second data byte, ignored for the one-byte messages.
+ *
+ * \return
+ *      Returns false if the status is not a channel-voice message, in which
+ *      case the event is left alone for the encoder.
  */
 
-static const size_t s_event_size_max =  10;
+static inline bool
+encode_voice
+(
+    snd_seq_event_t & ev, midibyte status, midibyte d0, midibyte d1
+)
+{
+    int ch = int(status & 0x0F);
+    switch (event::mask_status(status))
+    {
+    case EVENT_NOTE_OFF:
+
+        snd_seq_ev_set_noteoff(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_NOTE_ON:
+
+        snd_seq_ev_set_noteon(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_AFTERTOUCH:
+
+        snd_seq_ev_set_keypress(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_CONTROL_CHANGE:
+
+        snd_seq_ev_set_controller(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_PROGRAM_CHANGE:
+
+        snd_seq_ev_set_pgmchange(&ev, ch, d0);
+        break;
+
+    case EVENT_CHANNEL_PRESSURE:
+
+        snd_seq_ev_set_chanpress(&ev, ch, d0);
+        break;
+
+    case EVENT_PITCH_WHEEL:
+
+        snd_seq_ev_set_pitchbend(&ev, ch, ((int(d1) << 7) | int(d0)) - 8192);
+        break;
+
+    default:
+
+        return false;
+    }
+    return true;
+}
 
 /**
  *  This play() function takes a native event, encodes it to an ALSA MIDI
  *  sequencer event, sets the broadcasting to the subscribers, sets the
- *  direct-passing mode to send the event without queueing, and puts it in the
+ *  direct-passing mode to send the event without queueing (or, with
+ *  "alsa-lookahead", schedules it; see schedule()), and puts it in the
  *  queue.
  *
+ *  The event is only added to the client's output buffer; it is sent by the
+ *  next api_flush() (snd_seq_drain_output()).  During playback that is done
+ *  once per output frame, by performer::play(), so that a frame costs one
+ *  system call instead of one per event.
+ *
+ *  Channel-voice messages, nearly all of what is played, are filled in by
+ *  encode_voice().  Only the rest go through the ALSA MIDI encoder.
+ *
+ *  All of the ports write to the one ALSA client handle, so the output
+ *  functions here take the output mutex of the midi_info object, rather
+ *  than relying on the master bus to serialize everything.
+ *
  * \threadsafe
  *
  * \param e24
@@ -540,29 +689,138 @@ midi_alsa::api_play (const event * e24, midibyte channel)
 {
     if (parent_bus().port_enabled())
     {
-        snd_midi_event_t * midi_ev;                         /* MIDI parser  */
-        int rc = snd_midi_event_new(s_event_size_max, &midi_ev);
-        if (rc == 0)
+        automutex locker(master_info().output_mutex());
+        snd_seq_event_t ev;                                 /* event memory */
+        midibyte buffer[4];                                 /* temp data    */
+        buffer[0] = e24->get_status(channel);               /* status+chan  */
+        e24->get_data(buffer[1], buffer[2]);                /* set the data */
+        snd_seq_ev_clear(&ev);                              /* clear event  */
+        if (! encode_voice(ev, buffer[0], buffer[1], buffer[2]))
         {
-            snd_seq_event_t ev;                             /* event memory */
-            midibyte buffer[4];                             /* temp data    */
-            buffer[0] = e24->get_status(channel);           /* status+chan  */
-            e24->get_data(buffer[1], buffer[2]);            /* set the data */
-            snd_seq_ev_clear(&ev);                          /* clear event  */
-            snd_midi_event_encode(midi_ev, buffer, 3, &ev); /* 3 raw bytes  */
-            snd_midi_event_free(midi_ev);                   /* free parser  */
-            snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set source   */
-            snd_seq_ev_set_subs(&ev);                       /* subscriber   */
-            snd_seq_ev_set_direct(&ev);                     /* immediate    */
-            snd_seq_event_output(m_seq, &ev);               /* pump to que  */
+            snd_midi_event_t * midi_ev = m_midi_encoder;    /* MIDI parser  */
+            if (is_nullptr(midi_ev))
+            {
+                errprint("ALSA MIDI encoder unavailable");
+                return;
+            }
+
+            long count = e24->is_two_bytes() ? 3 : 2 ;      /* raw bytes    */
+            snd_midi_event_reset_encode(midi_ev);           /* no run-stat  */
+            snd_midi_event_encode(midi_ev, buffer, count, &ev);
         }
-        else
+        snd_seq_ev_set_source(&ev, m_local_addr_port);      /* set source   */
+        snd_seq_ev_set_subs(&ev);                           /* subscriber   */
+        schedule(ev, e24->timestamp());                     /* or immediate */
+        snd_seq_ev_set_tag(&ev, m_tag);                     /* for retract  */
+        snd_seq_event_output(m_seq, &ev);                   /* pump to que  */
+    }
+}
+
+/**
+ *  Plays a frame's batch, tagging each event with the tag of its pattern.
+ *
+ * \param evs
+ *      The events, their channels, and their tags.
+ *
+ * \param count
+ *      The number of events.
+ */
+
+void
+midi_alsa::api_play_batch (const batchevent * evs, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        m_tag = evs[i].be_tag;
+        api_play(&evs[i].be_event, evs[i].be_channel);
+    }
+    m_tag = 0;
+}
+
+/**
+ *  With "alsa-lookahead", the events of the last lookahead period are
+ *  still in the output buffer or the output queue when a pattern is muted,
+ *  so the mute would be heard that much later, and the Note Offs sent
+ *  directly by sequence::off_playing_notes() would get ahead of the queued
+ *  Note Ons.  This function removes the pattern's queued events, all but
+ *  its Note Offs, so the mute is heard at once.  The tag is that of the
+ *  pattern, not of the port, so the other patterns on the buss are not
+ *  touched.  The removal covers every port of the client, and the caller
+ *  does not ask for it when another playing pattern shares the tag (see
+ *  performer::output_tag_shared()).  This is the old
+ *  remove_queued_on_events() from Seq24, which had no caller until now.
+ *
+ * \param tag
+ *      The pattern's tag.  Zero (untagged events) is ignored.
+ */
+
+void
+midi_alsa::api_retract (midibyte tag)
+{
+    if (tag > 0 && m_lookahead_us > 0 && master_info().output_queue() >= 0)
+    {
+        automutex locker(master_info().output_mutex());
+        snd_seq_remove_events_t * remove_events;
+        if (snd_seq_remove_events_malloc(&remove_events) == 0)
         {
-            errprint("ALSA out-of-memory error");
+            snd_seq_remove_events_set_condition
+            (
+                remove_events, SND_SEQ_REMOVE_OUTPUT |
+                    SND_SEQ_REMOVE_TAG_MATCH | SND_SEQ_REMOVE_IGNORE_OFF
+            );
+            snd_seq_remove_events_set_tag(remove_events, int(tag));
+            if (snd_seq_remove_events(m_seq, remove_events) < 0)
+                errprint("ALSA event retraction failed");
+
+            snd_seq_remove_events_free(remove_events);
         }
     }
 }
 
+/**
+ *  Sets how ALSA delivers an output event.  Without "alsa-lookahead", the
+ *  event is direct, and goes out when it is drained.  Otherwise it is
+ *  scheduled on the running output queue in (relative) real time.  The
+ *  delay is the lookahead, less how far the event lags the exact play
+ *  position of the frame, so that an event that comes out late because the
+ *  output thread woke up late is still delivered at (its time + lookahead).
+ *  Timing jitter is then that of the kernel timer, at the cost of a fixed
+ *  latency.  Since the play position has a fraction, the lag is exact to
+ *  the microsecond, which keeps the MIDI clock pulses evenly spaced.
+ *
+ * \param ev
+ *      The ALSA event to be set up.
+ *
+ * \param tick
+ *      The event's timestamp, the tick at which it should sound.
+ */
+
+void
+midi_alsa::schedule (snd_seq_event_t & ev, midipulse tick)
+{
+    int queue = master_info().output_queue();
+    if (m_lookahead_us > 0 && queue >= 0)
+    {
+        long us = m_lookahead_us;
+        double late = master_info().frame_tick() - double(tick);
+        if (late > 0.0)
+        {
+            midibpm bp = master_info().bpm();
+            int ppq = master_info().ppqn();
+            us -= long(late * pulse_length_us(bp, ppq) + 0.5);
+            if (us < 0)
+                us = 0;
+        }
+
+        snd_seq_real_time_t rt;
+        rt.tv_sec = unsigned(us / 1000000);
+        rt.tv_nsec = unsigned((us % 1000000) * 1000);
+        snd_seq_ev_schedule_real(&ev, queue, 1, &rt);   /* 1 = relative     */
+    }
+    else
+        snd_seq_ev_set_direct(&ev);                     /* it's immediate   */
+}
+
 /**
  *  min() for long values.
  *
@@ -601,6 +859,7 @@ static const int c_sysex_chunk      =   256;
 void
 midi_alsa::api_sysex (const event * e24)
 {
+    automutex locker(master_info().output_mutex());
     snd_seq_event_t ev;
     snd_seq_ev_clear(&ev);                              /* clear event      */
     snd_seq_ev_set_priority(&ev, 1);
@@ -660,6 +919,36 @@ midi_alsa::api_sysex (const event * e24)
     }
 }
 
+/**
+ *  Sends a chunk of a streamed SysEx message.  ALSA takes a pointer to the
+ *  bytes, so they are not copied here.  The pacing is done by the caller
+ *  (see mastermidibase::pump_sysex()), so there is no sleep, and the output
+ *  mutex is held only for the write.
+ *
+ * \param data
+ *      Points to the chunk, inside the whole message.
+ *
+ * \param len
+ *      The size of the chunk.
+ */
+
+void
+midi_alsa::api_sysex_chunk (const midibyte * data, int len)
+{
+    automutex locker(master_info().output_mutex());
+    snd_seq_event_t ev;
+    snd_seq_ev_clear(&ev);                              /* clear event      */
+    snd_seq_ev_set_priority(&ev, 1);
+    snd_seq_ev_set_subs(&ev);
+    snd_seq_ev_set_direct(&ev);                         /* it's immediate   */
+    snd_seq_ev_set_source(&ev, m_local_addr_port);      /* set source       */
+    snd_seq_ev_set_sysex(&ev, len, const_cast<midibyte *>(data));
+
+    int rc = snd_seq_event_output_direct(m_seq, &ev);
+    if (rc < 0)
+        errprint("Sending SysEx chunk failed");
+}
+
 /**
  *  Flushes our local queue events out into ALSA.  This is also a
  *  midi_alsa_info function.
@@ -668,6 +957,7 @@ midi_alsa::api_sysex (const event * e24)
 void
 midi_alsa::api_flush ()
 {
+    automutex locker(master_info().output_mutex());
     snd_seq_drain_output(m_seq);
 }
 
@@ -689,6 +979,7 @@ midi_alsa::api_continue_from (midipulse /* tick */, midipulse beats)
 {
     if (parent_bus().port_enabled())
     {
+        automutex locker(master_info().output_mutex());
         snd_seq_event_t ev;
         snd_seq_ev_clear(&ev);                          /* clear event      */
         ev.type = SND_SEQ_EVENT_CONTINUE;
@@ -723,6 +1014,7 @@ midi_alsa::api_start ()
 {
     if (parent_bus().port_enabled())
     {
+        automutex locker(master_info().output_mutex());
         snd_seq_event_t ev;
         snd_seq_ev_clear(&ev);                          /* memsets it to 0  */
         ev.type = SND_SEQ_EVENT_START;
@@ -744,6 +1036,7 @@ midi_alsa::api_stop ()
 {
     if (parent_bus().port_enabled())
     {
+        automutex locker(master_info().output_mutex());
         snd_seq_event_t ev;
         snd_seq_ev_clear(&ev);                          /* memsets it to 0  */
         ev.type = SND_SEQ_EVENT_STOP;
@@ -763,12 +1056,14 @@ midi_alsa::api_stop ()
  * \threadsafe
  *
  * \param tick
- *      Provides the starting tick, unused in the ALSA implementation.
+ *      Provides the tick of this clock pulse, used only to schedule it when
+ *      "alsa-lookahead" is in force.
  */
 
 void
-midi_alsa::api_clock (midipulse /*tick*/)
+midi_alsa::api_clock (midipulse tick)
 {
+    automutex locker(master_info().output_mutex());
     snd_seq_event_t ev;
     snd_seq_ev_clear(&ev);                          /* clear event          */
     ev.type = SND_SEQ_EVENT_CLOCK;
@@ -777,7 +1072,7 @@ midi_alsa::api_clock (midipulse /*tick*/)
     snd_seq_ev_set_priority(&ev, 1);
     snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set source           */
     snd_seq_ev_set_subs(&ev);
-    snd_seq_ev_set_direct(&ev);                     /* it's immediate       */
+    schedule(ev, tick);                             /* or immediate         */
     snd_seq_event_output(m_seq, &ev);               /* pump it into queue   */
 }
 
@@ -837,30 +1132,6 @@ midi_alsa::api_set_beats_per_minute (midibpm bpm)
     }
 }
 
-#if defined REMOVE_QUEUED_ON_EVENTS_CODE
-
-/**
- *  Deletes events in the queue.  This function is not used anywhere, and
- *  there was no comment about the intent/context of this function.
- */
-
-void
-midi_alsa::remove_queued_on_events (int tag)
-{
-    snd_seq_remove_events_t * remove_events;
-    snd_seq_remove_events_malloc(&remove_events);
-    snd_seq_remove_events_set_condition
-    (
-        remove_events, SND_SEQ_REMOVE_OUTPUT | SND_SEQ_REMOVE_TAG_MATCH |
-            SND_SEQ_REMOVE_IGNORE_OFF
-    );
-    snd_seq_remove_events_set_tag(remove_events, tag);
-    snd_seq_remove_events(m_seq, remove_events);
-    snd_seq_remove_events_free(remove_events);
-}
-
-#endif      // REMOVE_QUEUED_ON_EVENTS_CODE
-
 /*
  * --------------------------------------------------------------------------
  *  midi_in_alsa
@@ -879,10 +1150,23 @@ midi_in_alsa::midi_in_alsa (midibus & parentbus, midi_info & masterinfo) :
     // Empty body
 }
 
+/**
+ *  The waiting is done by midi_alsa_info::api_poll_for_midi(), which blocks
+ *  in poll().  This function is used by mastermidibase::is_more_input() to
+ *  tell whether more events remain from the last read.  All input ports
+ *  share the one sequencer client, so this reports the events in the
+ *  client's input buffer.  It does not read from the kernel, so the whole
+ *  batch fetched by one read is drained before the next poll().
+ *
+ * \return
+ *      Returns the number of events in the input buffer.
+ */
+
 int
 midi_in_alsa::api_poll_for_midi ()
 {
-    return 0;                       /* master_info().api_poll_for_midi();   */
+    int result = snd_seq_event_input_pending(seq(), 0);
+    return result > 0 ? result : 0 ;
 }
 
 /*
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2023-10-31
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  API information found at:
@@ -79,6 +79,8 @@
 #include "midi/event.hpp"               /* seq66::event and other tokens    */
 #include "midi/midibus_common.hpp"      /* from the libseq66 sub-project    */
 #include "midi_alsa_info.hpp"           /* seq66::midi_alsa_info            */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "util/automutex.hpp"           /* seq66::automutex                 */
 #include "util/basic_macros.hpp"        /* C++ version of easy macros       */
 
 /*
@@ -103,6 +105,25 @@ namespace seq66
 static const int c_poll_wait_ms     = 10;
 static const int c_open_block_mode  = SND_SEQ_NONBLOCK;
 
+/**
+ *  How long to wait for the next part of an incoming SysEx message before
+ *  giving up on it.  A device sending at cable speed takes 80 ms for a
+ *  256-byte part.
+ */
+
+static const int c_sysex_wait_ms    = 250;
+
+/**
+ *  Checks that an incoming SysEx message has its End-of-SysEx byte.
+ */
+
+static bool
+sysex_ended (const event & ev)
+{
+    const event::sysex & data = ev.get_sysex();
+    return ! data.empty() && data.back() == EVENT_MIDI_SYSEX_END;
+}
+
 /*
  * Initialization of static members.
  */
@@ -135,7 +156,8 @@ midi_alsa_info::midi_alsa_info
     midi_info               (appname, ppqn, bpm),
     m_alsa_seq              (nullptr),
     m_num_poll_descriptors  (0),            /* from ALSA mastermidibus      */
-    m_poll_descriptors      (nullptr)       /* ditto                        */
+    m_poll_descriptors      (nullptr),      /* ditto                        */
+    m_input_filters         ()
 {
     snd_seq_t * seq;                        /* point to member              */
     int rcode = snd_seq_open                /* set up ALSA sequencer client */
@@ -161,6 +183,9 @@ midi_alsa_info::midi_alsa_info
         midi_handle(seq);
         snd_seq_set_client_name(m_alsa_seq, rc().app_client_name().c_str());
         global_queue(snd_seq_alloc_queue(m_alsa_seq));
+        if (rc().alsa_lookahead_ms() > 0)
+            start_output_queue();
+
         get_poll_descriptors();
     }
 }
@@ -178,6 +203,11 @@ midi_alsa_info::~midi_alsa_info ()
         snd_seq_ev_clear(&ev);                          /* memset it to 0   */
         snd_seq_stop_queue(m_alsa_seq, global_queue(), &ev);
         snd_seq_free_queue(m_alsa_seq, global_queue());
+        if (output_queue() >= 0)
+        {
+            snd_seq_stop_queue(m_alsa_seq, output_queue(), &ev);
+            snd_seq_free_queue(m_alsa_seq, output_queue());
+        }
         snd_seq_close(m_alsa_seq);                      /* close client     */
         (void) snd_config_update_free_global();         /* more cleanup     */
         m_alsa_seq = nullptr;
@@ -185,6 +215,39 @@ midi_alsa_info::~midi_alsa_info ()
     }
 }
 
+/**
+ *  Allocates and starts the queue used by the "alsa-lookahead" option.
+ *  Output events are scheduled on it in real time, a few milliseconds
+ *  ahead, so that the kernel's timer, and not the wake-up time of the output
+ *  thread, decides when they go out.  It runs from now until exit; only
+ *  relative timestamps are queued on it, so its position never matters.  If
+ *  this fails, output_queue() stays c_bad_id and output remains direct.
+ */
+
+void
+midi_alsa_info::start_output_queue ()
+{
+    int q = snd_seq_alloc_queue(m_alsa_seq);
+    if (q >= 0)
+    {
+        int rcode = snd_seq_start_queue(m_alsa_seq, q, nullptr);
+        if (rcode >= 0)
+            rcode = snd_seq_drain_output(m_alsa_seq);
+
+        if (rcode >= 0)
+        {
+            output_queue(q);
+        }
+        else
+        {
+            (void) snd_seq_free_queue(m_alsa_seq, q);
+            error_message("ALSA lookahead queue start failed");
+        }
+    }
+    else
+        error_message("ALSA lookahead queue allocation failed");
+}
+
 /**
  *  Get the number of MIDI input poll file descriptors.  Allocate the
  *  poll-descriptors array.  Then get the input poll-descriptors into the
@@ -375,18 +438,37 @@ midi_alsa_info::get_all_port_info
 
 /**
  *  Flushes our local queue events out into ALSA.  This is also a midi_alsa
- *  function.
+ *  function.  The ports share the handle, so the output mutex is locked.
  */
 
 void
 midi_alsa_info::api_flush ()
 {
+    automutex locker(output_mutex());
     snd_seq_drain_output(m_alsa_seq);
 }
 
+/**
+ *  All of the ports are handled by this one client, so there is nothing to
+ *  activate.  The input filters of the busses are gathered, so that
+ *  api_get_midi_event() can find that of a buss by number.
+ */
+
 bool
 midi_alsa_info::api_connect ()
 {
+    m_input_filters.clear();
+    for (auto m : bus_container())
+    {
+        if (m->is_input_port() && ! m->input_filter().empty())
+        {
+            std::size_t b = std::size_t(m->bus_index());
+            if (b >= m_input_filters.size())
+                m_input_filters.resize(b + 1, nullptr);
+
+            m_input_filters[b] = &m->input_filter();
+        }
+    }
     return true;
 }
 
@@ -584,6 +666,44 @@ midi_alsa_info::api_port_start (mastermidibus & masterbus, int bus, int port)
     get_poll_descriptors();
 }
 
+/**
+ *  Posts the start of a port for the master bus, with the names of the
+ *  client and the port, which are what are matched to find the bus that
+ *  used the port before it went away.  Our own ports, and ports that
+ *  cannot be subscribed to, are ignored.
+ *
+ * \param client
+ *      Provides the ALSA client number of the new port.
+ *
+ * \param port
+ *      Provides the ALSA port number of the new port.
+ */
+
+void
+midi_alsa_info::post_port_start (int client, int port)
+{
+    if (client == snd_seq_client_id(m_alsa_seq))
+        return;
+
+    snd_seq_client_info_t * cinfo;
+    snd_seq_client_info_alloca(&cinfo);
+    snd_seq_port_info_t * pinfo;
+    snd_seq_port_info_alloca(&pinfo);
+    if (snd_seq_get_any_client_info(m_alsa_seq, client, cinfo) < 0)
+        return;
+
+    if (snd_seq_get_any_port_info(m_alsa_seq, client, port, pinfo) < 0)
+        return;
+
+    int cap = snd_seq_port_info_get_capability(pinfo);
+    if (CAP_FULL_WRITE(cap) || CAP_FULL_READ(cap))
+    {
+        std::string clientname = snd_seq_client_info_get_name(cinfo);
+        std::string portname = snd_seq_port_info_get_name(pinfo);
+        post_port_change(true, client, port, clientname, portname);
+    }
+}
+
 /**
  *  For debugging, we may expose the following static function for use for
  *  normal (and usually copious) incoming MIDI events.  For less common
@@ -714,26 +834,26 @@ midi_alsa_info::api_get_midi_event (event * inev)
         case SND_SEQ_EVENT_PORT_START:
         {
             /*
-             * Figure out how to best do this.  It has way too many parameters
-             * now, and is currently meant to be called from mastermidibus.
-             * See mastermidibase::port_start().
-             *
-             * port_start(masterbus, ev->data.addr.client, ev->data.addr.port);
-             * api_port_start (mastermidibus & masterbus, int bus, int port)
+             * The master bus takes the change after this call and reconnects
+             * the bus that had this port, if any.  See
+             * mastermidibus::apply_port_changes().
              */
 
+            post_port_start(ev->data.addr.client, ev->data.addr.port);
             result = show_event(ev, "Port start");
             break;
         }
         case SND_SEQ_EVENT_PORT_EXIT:
         {
             /*
-             * The port_exit() function is defined in mastermidibase and in
-             * businfo.  They seem to cover this functionality.
-             *
-             * port_exit(masterbus, ev->data.addr.client, ev->data.addr.port);
+             * ALSA has already dropped the subscription; the master bus just
+             * marks the bus inactive.  See mastermidibase::port_exit().
              */
 
+            int client = int(ev->data.addr.client);
+            if (client != snd_seq_client_id(m_alsa_seq))
+                post_port_change(false, client, int(ev->data.addr.port));
+
             result = show_event(ev, "Port exit");
             break;
         }
@@ -779,35 +899,82 @@ midi_alsa_info::api_get_midi_event (event * inev)
      */
 
     long bytes = snd_midi_event_decode(midi_ev, buffer, sizeof buffer, ev);
+    bussbyte b = 0;
+    if (bytes > 0)
+    {
+        b = input_ports().get_port_index
+        (
+            int(ev->source.client), int(ev->source.port)
+        );
+        if (std::size_t(b) < m_input_filters.size())
+        {
+            const inputfilter * f = m_input_filters[b];
+            if (not_nullptr(f) && ! f->apply(buffer, std::size_t(bytes)))
+                bytes = 0;                      /* dropped by the filter    */
+        }
+    }
     if (bytes > 0)
     {
         result = inev->set_midi_event(ev->time.tick, buffer, bytes);
         if (result)
         {
-            bussbyte b = input_ports().get_port_index
-            (
-                int(ev->source.client), int(ev->source.port)
-            );
-            bool sysex = inev->is_sysex();
+            inev->arrival_us(microtime());      /* read as soon as polled   */
+            bool sysex = inev->is_sysex() && ! sysex_ended(*inev);
             inev->set_input_bus(b);
 #if defined SEQ66_PLATFORM_DEBUG_TMI
             printf("[seq66] input event on ALSA bus %d\n", int(b));
 #endif
+            snd_seq_addr_t source = ev->source;
+            long lastpart = microtime();
             while (sysex)           /* sysex might be more than one message */
             {
+                /*
+                 * Read the rest of the message, up to its End-of-SysEx,
+                 * waiting for parts that have not come in yet.  (It used to
+                 * stop at the last event already queued, which cut dumps
+                 * short.)  The SysEx events carry their bytes, which are
+                 * appended as is, with no decoding.  Other events that come
+                 * in the middle of the message, from the same port or from
+                 * others, are dropped.
+                 */
+
+                if (microtime() - lastpart > c_sysex_wait_ms * 1000L)
+                {
+                    errprint("SysEx input incomplete");
+                    break;
+                }
+
                 int remcount = snd_seq_event_input(m_alsa_seq, &ev);
-                long bytes = snd_midi_event_decode
-                (
-                    midi_ev, buffer, sizeof buffer, ev
-                );
-                if (bytes > 0)
+                if (remcount == -EAGAIN)
                 {
-                    sysex = inev->append_sysex(buffer, bytes);
-                    if (remcount == 0)
-                        sysex = false;
+                    int ready = poll
+                    (
+                        m_poll_descriptors, m_num_poll_descriptors,
+                        c_sysex_wait_ms
+                    );
+                    if (ready > 0)
+                        continue;
+
+                    errprint("SysEx input incomplete");
+                    break;
+                }
+                if (remcount < 0 || is_nullptr(ev))
+                    break;
+
+                bool same = ev->source.client == source.client &&
+                    ev->source.port == source.port;
+
+                if (same && ev->type == SND_SEQ_EVENT_SYSEX)
+                {
+                    const midibyte * data =
+                        static_cast<const midibyte *>(ev->data.ext.ptr);
+
+                    int len = int(ev->data.ext.len);
+                    sysex = inev->append_sysex(data, len) &&
+                        ! sysex_ended(*inev);
+
+                    lastpart = microtime();
                 }
-                else
-                    sysex = false;
             }
         }
         snd_midi_event_free(midi_ev);
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-06
- * \updates       2022-06-26
+ * \updates       2026-10-14
  * \license       See above.
  *
  * Classes defined:
@@ -249,11 +249,15 @@ midi_info::midi_info (const std::string & appname, int ppqn, midibpm bpm) :
     m_output            (),                 /* midi_port_info for outputs   */
     m_bus_container     (),                 /* holds all I/O buss pointers  */
     m_global_queue      (c_bad_id),         /* a la mastermidibase; created */
+    m_output_queue      (c_bad_id),         /* only for "alsa-lookahead"    */
+    m_frame_tick        (0.0),
+    m_output_mutex      (),
     m_midi_handle       (nullptr),          /* usually looked up or created */
     m_app_name          (appname),
     m_ppqn              (ppqn),
     m_bpm               (bpm),
     m_midi_port_refresh (false),
+    m_port_changes      (),
     m_error_string      ()
 {
     // No code
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2025-01-22
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  Written primarily by Alexander Svetalkin, with updates for delta time by
@@ -170,46 +170,35 @@
 
 #include <cstring>                      /* std::strcpy(), std::strcat()     */
 #include <sstream>
+#include <utility>                      /* std::move()                      */
 
 #include <jack/midiport.h>
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
 #include "util/ring_buffer.hpp"         /* seq66::ring_buffer<> template    */
-#else
-#include <jack/ringbuffer.h>
-#endif
 
 #if defined SEQ66_JACK_METADATA_TEST
 #include <jack/metadata.h>
 #endif
 
+#include "cfg/hotsettings.hpp"          /* seq66::hot() for the RT threads  */
 #include "cfg/settings.hpp"             /* seq66::rc() accessor function    */
 #include "midi/event.hpp"               /* seq66::event from main library   */
 #include "midi/jack_assistant.hpp"      /* seq66::jack_status_pair_t        */
 #include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
 #include "midi_jack.hpp"                /* seq66::midi_jack                 */
-#include "os/timing.hpp"                /* seq66::microsleep()              */
+#include "os/timing.hpp"                /* seq66::microsleep(), microtime() */
 
-/**
- *  Delimits the size of the JACK ringbuffer. Related to issue #100, when
- *  we play the Sequencer64 MIDI tune "b4uacuse-stress.midi", we can fail to
- *  write to the ringbuffer.  So we've doubled the size. Without timestamps,
- *  that allows about 10K events. With time-stamps, about 4.7K events.
- *
- *  For the new midi_message ringbuffer, running the stress file from the
- *  Sequencer64 project, the maximum number of events in the ring buffer
- *  is about 200 at 192 PPQN.  At 960 PPQN, thousands of events are dropped
- *  and the buffer maxes out (1024 events).  Let's try 4096 instead.
- *  Weird, now that tune yields the max of 196! Let's try 2048. Might be a
- *  useful configuration option.
+/*
+ *  The size of the ring-buffer of each port, in messages, is now the
+ *  "jack-ringbuffer" option of the 'rc' file.  Running the stress file
+ *  "b4uacuse-stress.midi" from the Sequencer64 project, the most messages
+ *  in the buffer of an output port was about 200, so the default, 2048,
+ *  leaves plenty of room.  The jack_ringbuffer_t alternative, with
+ *  size-prefixed raw bytes, is gone; input and output ports both use the
+ *  midi_message ring_buffer, whose dropped messages and high-water mark
+ *  are counted in the output statistics.
  */
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-static const size_t c_jack_ringbuffer_size = 2048;          /* tentative    */
-#else
-static const size_t c_jack_ringbuffer_size = 32768;         /* was 16384    */
-#endif
-
 /*
  * Do not document the namespace; it breaks Doxygen.
  */
@@ -270,6 +259,15 @@ valid_frame_offset (jack_nframes_t offset)
  *  This function used to be static, but now we make it available to
  *  midi_jack_info.  Also note the s_null_detected flag.
  *
+ *  If the port has a [midi-input-filter], each message is first run through
+ *  it, and is neither routed nor queued if the filter drops it.
+ *
+ *  If the port has a [midi-thru] route, each channel message is also handed
+ *  right here to the output port of the route, which jack_process_io()
+ *  processes after all of the inputs, so that the message goes out in this
+ *  same cycle, at the offset at which it came in.  It is still queued for
+ *  the input thread, so that it can be recorded.
+ *
  * jack_time_t t = jack_get_time() returns JACK's current system time
  * in microseconds, using the JACK clock source. Guaranteed to be monotonic,
  * but not linear. The jack_time_t type is uint64_t.
@@ -295,42 +293,107 @@ valid_frame_offset (jack_nframes_t offset)
  *    Returns 0 unless overflow occurs, then -1 is returned.
  */
 
+/**
+ *  Gets the arrival time of the first frame of the input of this cycle, in
+ *  the microtime() time base, so that the recorder can place each event at
+ *  its own time.  The events of a cycle arrived during the previous cycle,
+ *  which began the period of the cycle before the start of this one.  The
+ *  JACK time of that is converted to microtime() by its age, since the two
+ *  clocks need not have the same origin.
+ *
+ * \param client
+ *      The JACK client, for its frame times.
+ *
+ * \param framect
+ *      The number of frames in the cycle.
+ *
+ * \param [out] frame_us
+ *      The length of a frame, in microseconds, rounded down.  Kept integral
+ *      because the message holds it as a pulse value; the error is under
+ *      a microsecond a frame.
+ *
+ * \return
+ *      Returns the microtime() of the first frame, or 0 if unknown.
+ */
+
+static long
+input_arrival
+(
+    jack_client_t * client, jack_nframes_t framect, long & frame_us
+)
+{
+    long result = 0;
+    frame_us = 0;
+    if (not_nullptr(client) && framect > 0)
+    {
+        jack_nframes_t cycle = ::jack_last_frame_time(client);
+        jack_time_t start = ::jack_frames_to_time(client, cycle);
+        jack_time_t prior = ::jack_frames_to_time(client, cycle - framect);
+        jack_time_t now = ::jack_get_time();
+        if (start > prior && now >= prior)
+        {
+            frame_us = long((start - prior) / framect);
+            result = microtime() - long(now - prior);
+        }
+    }
+    return result;
+}
+
 int
 jack_process_rtmidi_input (jack_nframes_t framect, void * arg)
 {
     midi_jack_data * jackdata = reinterpret_cast<midi_jack_data *>(arg);
     rtmidi_in_data * rtindata = jackdata->jack_rtmidiin();
+    ring_buffer<midi_message> * rb = jackdata->jack_buffer();
     void * buf = ::jack_port_get_buffer(jackdata->jack_port(), framect);
-    int evcount = ::jack_midi_get_event_count(buf);
+    int evcount = is_nullptr(rb) ? 0 : ::jack_midi_get_event_count(buf);
+    midi_jack_data * thru = jackdata->jack_thru();
+    const inputfilter * filter = jackdata->jack_filter();
     bool overflow = false;
+    bool queued = false;
+    long arrival = 0;                               /* microtime() of frame */
+    long frame_us = 0;                              /* length of a frame    */
+    if (evcount > 0)
+        arrival = input_arrival(jackdata->jack_client(), framect, frame_us);
+
     for (int j = 0; j < evcount; ++j)
     {
         jack_midi_event_t jmevent;
         int rc = ::jack_midi_event_get(&jmevent, buf, j);
         if (rc == 0)                                /* ENODATA if buf empty */
         {
-            jack_time_t jtime = ::jack_get_time();  /* time in microsec (!) */
-            jack_time_t delta_jtime;                /* uint64_t             */
-            if (rtindata->first_message())
+            midibyte shortmsg[3];                   /* filtered copy        */
+            if (not_nullptr(filter) && jmevent.size <= sizeof shortmsg)
             {
-                rtindata->first_message(false);
-                delta_jtime = 0;
+                std::memcpy(shortmsg, jmevent.buffer, jmevent.size);
+                if (! filter->apply(shortmsg, jmevent.size))
+                    continue;                       /* dropped, not queued  */
+
+                jmevent.buffer = shortmsg;          /* JACK's is read-only  */
             }
-            else
+            if (not_nullptr(thru) && jmevent.size > 0)
             {
-                jtime -= jackdata->jack_lasttime();
-                delta_jtime = jack_time_t(jtime * 0.000001);    /* secs ??? */
+                midibyte status = midibyte(jmevent.buffer[0]);
+                if (status >= 0x80 && status < 0xF0)    /* channel message  */
+                {
+                    bool ok = thru->thru_push
+                    (
+                        jmevent.time, jmevent.buffer, jmevent.size
+                    );
+                    if (! ok)
+                        async_safe_strprint("T");   /* thru overflow    */
+                }
             }
-            jackdata->jack_lasttime(jtime);
-
-            size_t eventsize = jmevent.size;
-            midi_message message(delta_jtime);      /* issue #100 ??????    */
-            for (size_t i = 0; i < eventsize; ++i)
-                message.push(jmevent.buffer[i]);
 
+            midi_message message(arrival + long(jmevent.time) * frame_us);
+            message.push(jmevent.buffer, jmevent.size);     /* all at once  */
             if (! rtindata->continue_sysex())
             {
-                if (! rtindata->queue().add(message))
+                if (rb->push_back(std::move(message)))  /* counts drops */
+                {
+                    queued = true;
+                }
+                else
                 {
                     async_safe_strprint("~");
                     overflow = true;
@@ -349,6 +412,9 @@ jack_process_rtmidi_input (jack_nframes_t framect, void * arg)
             async_safe_errprint(errmsg);
         }
     }
+    if (queued)
+        midi_jack_data::input_signal();             /* wake input thread    */
+
     if (overflow)
     {
         async_safe_errprint(" Message overflow ");
@@ -380,7 +446,55 @@ message_time (const midi_message & msg, uint64_t t = 0)
 
 #endif
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
+/**
+ *  Writes the thru events of an output port that are due by the given
+ *  offset, so that they interleave in order with the played events.  An
+ *  event is never written before the last one written.
+ *
+ * \param jackdata
+ *      The output port, holding the thru events of this cycle.
+ *
+ * \param buf
+ *      The cleared JACK port buffer.
+ *
+ * \param limit
+ *      The offset up to which the thru events are written.
+ *
+ * \param [inout] next
+ *      The index of the next thru event to write.
+ *
+ * \param [inout] least
+ *      The last offset written, which is updated.
+ */
+
+static void
+jack_thru_output
+(
+    midi_jack_data * jackdata,
+    void * buf,
+    jack_nframes_t limit,
+    int & next,
+    jack_nframes_t & least
+)
+{
+    while (next < jackdata->thru_count())
+    {
+        const midi_jack_data::thru_event & te = jackdata->thru_at(next);
+        if (te.te_offset > limit)
+            break;
+
+        jack_nframes_t offset = te.te_offset < least ? least : te.te_offset ;
+        int rc = ::jack_midi_event_write(buf, offset, te.te_data, te.te_size);
+        if (rc != 0)
+        {
+            async_safe_errprint("JACK MIDI thru write error");
+            next = jackdata->thru_count();
+            break;
+        }
+        least = offset;
+        ++next;
+    }
+}
 
 /**
  *  Handles peeking and reading data from our replacement for the JACK
@@ -481,6 +595,12 @@ jack_get_event_data
                 memcpy(dest, msg.event_bytes(), datasz);
                 destsz = datasz;
             }
+            else
+            {
+                async_safe_errprint("JACK message too large");
+                destsz = 0;                     /* drop it, not garbage     */
+                result = 0;
+            }
             buffmsg->pop_front();
         }
         else
@@ -500,7 +620,96 @@ jack_get_event_data
     return result;
 }
 
-#endif  // defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
+/**
+ *  The number of messages sorted at a time by jack_engine_output().
+ */
+
+static const int s_engine_batch_size = 64;
+
+/**
+ *  The output half of the JACK-driven engine.  The messages for this cycle
+ *  were pushed by the engine (see jack_assistant::run_engine()) moments ago,
+ *  in this same thread, so each one can be written at the frame offset
+ *  matching its tick.  Since the patterns are played one after another,
+ *  their events are not in time order; JACK refuses out-of-order events, so
+ *  each batch is sorted by offset (stably, to keep the order of events on
+ *  the same tick).  The batch storage is static, since only the JACK
+ *  process thread calls this function.
+ *
+ * \param jackdata
+ *      The source of JACK information for this port.
+ *
+ * \param buf
+ *      The cleared JACK port buffer.
+ *
+ * \param framect
+ *      The number of frames in this cycle.
+ *
+ * \param [inout] thrunext
+ *      The index of the next thru event, written in order with the rest.
+ *
+ * \param [inout] least
+ *      The last offset written.
+ */
+
+static void
+jack_engine_output
+(
+    midi_jack_data * jackdata,
+    void * buf,
+    jack_nframes_t framect,
+    int & thrunext,
+    jack_nframes_t & least
+)
+{
+    static midi_message s_batch[s_engine_batch_size];
+    static jack_nframes_t s_offsets[s_engine_batch_size];
+    static int s_order[s_engine_batch_size];
+    ring_buffer<midi_message> * rb = jackdata->jack_buffer();
+    for (;;)
+    {
+        int count = int(rb->pop(s_batch, s_engine_batch_size));
+        if (count == 0)
+            break;
+
+        for (int i = 0; i < count; ++i)
+        {
+            midipulse ts = s_batch[i].timestamp();
+            jack_nframes_t offset = midi_jack_data::engine_offset(framect, ts);
+            s_offsets[i] = offset < least ? least : offset ;
+
+            int j = i;                          /* stable insertion sort    */
+            while (j > 0 && s_offsets[s_order[j - 1]] > s_offsets[i])
+            {
+                s_order[j] = s_order[j - 1];
+                --j;
+            }
+            s_order[j] = i;
+        }
+        for (int k = 0; k < count; ++k)
+        {
+            const midi_message & msg = s_batch[s_order[k]];
+            const jack_midi_data_t * data =
+                reinterpret_cast<const jack_midi_data_t *>(msg.event_bytes());
+
+            jack_nframes_t offset = s_offsets[s_order[k]];
+            jack_thru_output(jackdata, buf, offset, thrunext, least);
+            if (offset < least)
+                offset = least;
+
+            int rc = ::jack_midi_event_write
+            (
+                buf, offset, data, size_t(msg.event_count())
+            );
+            if (rc != 0)
+            {
+                async_safe_errprint("JACK MIDI write error");
+                return;
+            }
+            least = offset;
+        }
+    }
+}
 
 /**
  *  Defines the JACK output process callback for a MIDI output port (a
@@ -533,6 +742,15 @@ jack_get_event_data
  *  Could consider using JACK callbacks to detect server-setting changes.
  *  That would be more robust.
  *
+ *  When the JACK-driven engine has played this cycle, the messages are
+ *  written by jack_engine_output() instead, at exact frame offsets.
+ *
+ *  The MIDI thru events routed to the port in this cycle (see
+ *  jack_process_rtmidi_input()) are merged in by offset, and then cleared.
+ *
+ *  The cycle start frame and the frame factor are obtained once per cycle
+ *  by jack_process_io(), which must be the caller.
+ *
  * \param framect
  *    The number of frames to be processed.
  *
@@ -544,8 +762,6 @@ jack_get_event_data
  *    Returns 0.
  */
 
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-
 int
 jack_process_rtmidi_output (jack_nframes_t framect, void * arg)
 {
@@ -553,89 +769,51 @@ jack_process_rtmidi_output (jack_nframes_t framect, void * arg)
     char * mbuf = &mbuffer[0];
     midi_jack_data * jackdata = reinterpret_cast<midi_jack_data *>(arg);
     jack_port_t * jackport = jackdata->jack_port();
-    const jack_nframes_t cycle_start =
-        ::jack_last_frame_time(jackdata->jack_client());
-
+    const jack_nframes_t cycle_start = midi_jack_data::cycle_start();
     jack_nframes_t lastvalue = 0;
+    jack_nframes_t least = 0;                   /* offsets never go back    */
+    int thrunext = 0;
     void * buf = ::jack_port_get_buffer(jackport, framect);
-    jack_position_t pos = jack_assistant::get_jack_parameters().position;
-    if (midi_jack_data::recalculate_frame_factor(pos, framect))
-        async_safe_errprint("JACK settings changed");
-
     ::jack_midi_clear_buffer(buf);
-    for (;;)
+    if (midi_jack_data::engine_active())
     {
-        size_t destsz = s_message_buffer_size;
-        jack_nframes_t offset = jack_get_event_data
-        (
-            jackdata, framect, cycle_start, lastvalue, mbuf, destsz
-        );
-        if (destsz > 0 && valid_frame_offset(offset))
-        {
-            const jack_midi_data_t * data =
-                reinterpret_cast<const jack_midi_data_t *>(mbuf);
-
-            int rc = ::jack_midi_event_write(buf, offset, data, destsz);
-            if (rc != 0)
-            {
-                async_safe_errprint("JACK MIDI write error");
-                break;
-            }
-            lastvalue = offset;            /* tricky code */
-        }
-        else
-            break;
+        jack_engine_output(jackdata, buf, framect, thrunext, least);
     }
-    return 0;
-}
-
-#else
-
-int
-jack_process_rtmidi_output (jack_nframes_t framect, void * arg)
-{
-    midi_jack_data * jackdata = reinterpret_cast<midi_jack_data *>(arg);
-    jack_port_t * jackport = jackdata->jack_port();
-    jack_ringbuffer_t * buffmsg = jackdata->jack_buffmessage();
-    short space = 0;
-    const size_t sz = sizeof(space);
-    char * sp = reinterpret_cast<char *>(&space);
-    void * buf = ::jack_port_get_buffer(jackport, framect);
-    ::jack_midi_clear_buffer(buf);                  /* no nullptr test      */
-    for (;;)
+    else
     {
-        size_t msgsz = ::jack_ringbuffer_read_space(buffmsg);
-        if (msgsz >= c_jack_ringbuffer_size)
-        {
-            async_safe_errprint("impossible event size");
-            break;
-        }
-        else if (msgsz > 0)
+        for (;;)
         {
-            (void) ::jack_ringbuffer_read(buffmsg, sp, sz);
-            jack_midi_data_t * md = ::jack_midi_event_reserve(buf, 0, space);
-            if (not_nullptr(md))
+            size_t destsz = s_message_buffer_size;
+            jack_nframes_t offset = jack_get_event_data
+            (
+                jackdata, framect, cycle_start, lastvalue, mbuf, destsz
+            );
+            if (destsz > 0 && valid_frame_offset(offset))
             {
-                char * mididata = reinterpret_cast<char *>(md);
-                (void) ::jack_ringbuffer_read       /* ignore byte count */
-                (
-                    buffmsg, mididata, size_t(space)
-                );
+                const jack_midi_data_t * data =
+                    reinterpret_cast<const jack_midi_data_t *>(mbuf);
+
+                jack_thru_output(jackdata, buf, offset, thrunext, least);
+                if (offset < least)
+                    offset = least;
+
+                int rc = ::jack_midi_event_write(buf, offset, data, destsz);
+                if (rc != 0)
+                {
+                    async_safe_errprint("JACK MIDI write error");
+                    break;
+                }
+                lastvalue = least = offset;     /* tricky code */
             }
             else
-            {
-                async_safe_errprint("JACK event reserve null pointer");
                 break;
-            }
         }
-        else
-            break;
     }
+    jack_thru_output(jackdata, buf, framect, thrunext, least);
+    jackdata->thru_clear();
     return 0;
 }
 
-#endif  // defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-
 /**
  *  This callback is to shut down JACK by clearing the jack_assistant ::
  *  m_jack_running flag.
@@ -685,7 +863,7 @@ jack_port_connect_callback
     midi_jack_info * jack = reinterpret_cast<midi_jack_info *>(arg);
     if (not_nullptr(jack))
     {
-        if (rc().investigate())
+        if (hot().investigate())
         {
             char value[c_async_safe_utoa_size];
             char temp[2 * c_async_safe_utoa_size + 48];
@@ -832,7 +1010,7 @@ jack_port_register_callback (jack_port_id_t portid, int regv, void * arg)
             else
                 return;                             /* fatal error, bug out */
 
-            if (rc().investigate())
+            if (hot().investigate())
             {
                 /*
                  * JACK docs say this function doesn't need to be suitable for
@@ -931,7 +1109,6 @@ midi_jack::midi_jack (midibus & parentbus, midi_info & masterinfo) :
 
 midi_jack::~midi_jack ()
 {
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
     if (not_nullptr(jack_data().jack_buffer()))
     {
         ring_buffer<midi_message> * rb = jack_data().jack_buffer();
@@ -947,10 +1124,6 @@ midi_jack::~midi_jack ()
         }
         delete jack_data().jack_buffer();
     }
-#else
-    if (not_nullptr(jack_data().jack_buffmessage()))
-        ::jack_ringbuffer_free(jack_data().jack_buffmessage());
-#endif
 }
 
 /**
@@ -979,7 +1152,7 @@ midi_jack::api_init_out ()
     bool result = true;
     std::string remoteportname = connect_name();    /* "bus:port"   */
     remote_port_name(remoteportname);
-    result = create_ringbuffer(c_jack_ringbuffer_size);
+    result = create_ringbuffer(size_t(rc().jack_ringbuffer_size()));
     if (result)
     {
         set_alt_name(rc().application_name(), rc().app_client_name());
@@ -1027,8 +1200,27 @@ midi_jack::api_init_in ()
 {
     std::string remoteportname = connect_name();    /* "bus:port"       */
     remote_port_name(remoteportname);
-    set_alt_name(rc().application_name(), rc().app_client_name());
-    return register_port(midibase::io::input, port_name());
+    bool result = create_ringbuffer(size_t(rc().jack_ringbuffer_size()));
+    if (result)
+    {
+        set_alt_name(rc().application_name(), rc().app_client_name());
+        use_input_filter();
+        result = register_port(midibase::io::input, port_name());
+    }
+    return result;
+}
+
+/**
+ *  Gives the process callback the input filter of the buss, if it has one.
+ *  Done before the port is registered, so that the callback never sees it
+ *  change.
+ */
+
+void
+midi_jack::use_input_filter ()
+{
+    const inputfilter & f = parent_bus().input_filter();
+    jack_data().jack_filter(f.empty() ? nullptr : &f);
 }
 
 /**
@@ -1139,7 +1331,7 @@ midi_jack::api_init_out_sub ()
         result = portid >= 0;
     }
     if (result)
-        result = create_ringbuffer(c_jack_ringbuffer_size);
+        result = create_ringbuffer(size_t(rc().jack_ringbuffer_size()));
 
     if (result)
     {
@@ -1178,6 +1370,9 @@ midi_jack::api_init_in_sub ()
         portid = bus_index();
         result = portid >= 0;
     }
+    if (result)
+        result = create_ringbuffer(size_t(rc().jack_ringbuffer_size()));
+
     if (result)
     {
         std::string portname = master_info().get_port_name(bus_index());
@@ -1188,6 +1383,7 @@ midi_jack::api_init_in_sub ()
             portname += " ";
             portname += std::to_string(portid);
         }
+        use_input_filter();
         result = register_port(midibase::io::input, portname);
         if (result)
         {
@@ -1277,6 +1473,59 @@ midi_jack::api_play (const event * e24, midibyte channel)
     }
 }
 
+/**
+ *  Plays a frame's events for this port with one write to the ring-buffer
+ *  per chunk of messages, instead of one per event.  The chunk is static,
+ *  since only the output thread plays batches.  Without the message
+ *  ring-buffer, or when the JACK frame time is written into each message,
+ *  the events are sent one at a time.
+ *
+ * \param evs
+ *      The events and their channels, in timestamp order.
+ *
+ * \param count
+ *      The number of events.
+ */
+
+void
+midi_jack::api_play_batch (const batchevent * evs, int count)
+{
+#if ! defined SEQ66_ENCODE_JACK_FRAME_TIME
+
+    static const int s_chunk_size = 64;
+    static midi_message s_chunk[s_chunk_size];
+    ring_buffer<midi_message> * rb = jack_data().jack_buffer();
+    if (! jack_data().valid_buffer() || is_nullptr(rb))
+        return;
+
+    int i = 0;
+    while (i < count)
+    {
+        int n = 0;
+        for ( ; n < s_chunk_size && i < count; ++n, ++i)
+        {
+            const event & e24 = evs[i].be_event;
+            midi_message & message = s_chunk[n];
+            message = midi_message(e24.timestamp());
+            midibyte d0, d1;
+            e24.get_data(d0, d1);
+            message.push(e24.get_status(evs[i].be_channel));
+            message.push(d0);
+            if (e24.is_two_bytes())
+                message.push(d1);
+        }
+        if (rb->push(s_chunk, std::size_t(n)) < std::size_t(n))
+            async_safe_errprint("JACK send event failed");
+    }
+
+#else
+
+    for (int i = 0; i < count; ++i)
+        api_play(&evs[i].be_event, evs[i].be_channel);
+
+#endif
+}
+
 /**
  *  Sends a JACK MIDI output message.  It writes the full message size and
  *  the message itself to the JACK ring buffer (actually our new ring_buffer
@@ -1303,8 +1552,6 @@ midi_jack::api_play (const event * e24, midibyte channel)
 bool
 midi_jack::send_message (const midi_message & message)
 {
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-
     ring_buffer<midi_message> * rb = jack_data().jack_buffer();
 
 #if defined SEQ66_ENCODE_JACK_FRAME_TIME
@@ -1317,7 +1564,7 @@ midi_jack::send_message (const midi_message & message)
     if (result)
     {
         size_t space = size_t(rb->read_space());
-        result = space > 0 && space < c_jack_ringbuffer_size;
+        result = space > 0 && space < size_t(rb->buffer_size());
     }
 
     /*
@@ -1331,34 +1578,12 @@ midi_jack::send_message (const midi_message & message)
 #else
     return rb->push_back(message);
 #endif
-
-#else   // ! defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
-
-    int nbytes = message.event_count();
-    bool result = nbytes > 0 && nbytes < int(s_message_buffer_size);
-    if (result)
-    {
-        short n = short(nbytes);
-        int count1 = ::jack_ringbuffer_write    /* write raw message size ! */
-        (
-            jack_data().jack_buffmessage(),
-            reinterpret_cast<char *>(&n), sizeof n
-        );
-        int count2 = ::jack_ringbuffer_write    /* write the message bytes  */
-        (
-            jack_data().jack_buffmessage(),
-            message.buffer(), size_t(n)
-        );
-        result = (count1 > 0) && (count2 > 0);
-    }
-    return result;
-
-#endif
 }
 
 /**
- *  Work on this routine now in progress.  Unlike the ALSA implementation, we
- *  do not try to send large messages (greater than 255 bytes) in chunks.
+ *  Sends a SysEx message as one JACK event.  A large message does not get
+ *  here; mastermidibase::sysex() streams it, and each chunk is sent by
+ *  api_sysex_chunk().
  *
  *  The event::sysex data type is a vector of midibytes.  Also note that both
  *  Meta and Sysex messages are covered by the event :: is_ex_data() function
@@ -1379,10 +1604,7 @@ midi_jack::api_sysex (const event * e24)
 {
     midi_message message(e24->timestamp());             /* issue #100       */
     const event::sysex & data = e24->get_sysex();
-    int data_size = e24->sysex_size();
-    for (int offset = 0; offset < data_size; ++offset)
-        message.push(data[offset]);
-
+    message.push(data.data(), data.size());
     if (jack_data().valid_buffer())
     {
         if (! send_message(message))
@@ -1390,6 +1612,29 @@ midi_jack::api_sysex (const event * e24)
     }
 }
 
+/**
+ *  Sends a chunk of a streamed SysEx message as its own JACK event, copied
+ *  once, from the message, into the ring-buffer.
+ *
+ * \param data
+ *      Points to the chunk, inside the whole message.
+ *
+ * \param len
+ *      The size of the chunk, at most c_sysex_chunk_size.
+ */
+
+void
+midi_jack::api_sysex_chunk (const midibyte * data, int len)
+{
+    midi_message message;
+    message.push(data, std::size_t(len));
+    if (jack_data().valid_buffer())
+    {
+        if (! send_message(message))
+            printf("JACK send sysex chunk failed");
+    }
+}
+
 /**
  *  It seems like JACK doesn't have the concept of flushing events.
  *  The actual function called right now is midi_jack_info::api_flush(), via
@@ -1402,6 +1647,29 @@ midi_jack::api_flush ()
     // No code needed
 }
 
+/**
+ *  Reports on the ring-buffer that carries output to the JACK process
+ *  callback, or input from it.  The figures are the same ones the
+ *  destructor warns about.
+ *
+ * \return
+ *      Returns false if the ring-buffer is not in use.
+ */
+
+bool
+midi_jack::api_buffer_stats (int & size, int & highwater, int & dropped)
+{
+    ring_buffer<midi_message> * rb = jack_data().jack_buffer();
+    bool result = not_nullptr(rb);
+    if (result)
+    {
+        size = rb->buffer_size();
+        highwater = rb->count_max();
+        dropped = rb->dropped();
+    }
+    return result;
+}
+
 /**
  *  jack_transport_locate(), jack_transport_reposition(), or something else?
  *  What is used by jack_assistant?
@@ -1609,6 +1877,10 @@ midi_jack::close_client ()
  *  If this is nominally a local output port, it is really accepting input,
  *  and this is the destination-port name.
  *
+ *  During the connection pass at start-up, a remote port missing from the
+ *  graph fails without a jack_connect() call, and a connection that is
+ *  already made is not made again.
+ *
  * \param input
  *      Indicates true if the port to register and connect is an input port,
  *      and false if the port is an output port.  Useful macros for
@@ -1647,8 +1919,22 @@ midi_jack::connect_port
     bool result = true;
     if (! is_virtual_port())
     {
+        bool input = iotype == midibase::io::input;
+        const std::string & remotename = input ? srcportname : destportname ;
         result = ! srcportname.empty() && ! destportname.empty();
-        if (result)
+        if (result && ! jack_info().graph_has_port(remotename))
+        {
+            m_error_string = "JACK port missing '";
+            m_error_string += remotename;
+            m_error_string += "'";
+            error(rterror::kind::driver_error, m_error_string);
+            result = false;
+        }
+
+        bool connected = result && not_nullptr(port_handle()) &&
+            ::jack_port_connected_to(port_handle(), remotename.c_str()) != 0;
+
+        if (result && ! connected)                  /* else as with EEXIST  */
         {
             int rc = ::jack_connect
             (
@@ -1665,7 +1951,6 @@ midi_jack::connect_port
                 }
                 else
                 {
-                    bool input = iotype == midibase::io::input;
                     m_error_string = "JACK Connect error";
                     m_error_string += input ? "input '" : "output '";
                     m_error_string += srcportname;
@@ -1797,28 +2082,29 @@ midi_jack::close_port ()
 }
 
 /**
- *  Creates the JACK output ring-buffer.
+ *  Creates the ring-buffer of the port:  output messages on their way to
+ *  the JACK process callback, or input messages on their way from it to
+ *  the input thread.  A port that already has one keeps it.
  */
 
 bool
 midi_jack::create_ringbuffer (size_t rbsize)
 {
     bool result = rbsize > 0;
+    if (jack_data().valid_buffer())
+        return true;
+
     if (result)
     {
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
         ring_buffer<midi_message> * rb =
             new (std::nothrow) ring_buffer<midi_message>(rbsize);
 
         result = not_nullptr(rb);
         if (result)
+        {
+            (void) rb->mlock();                 /* keep it out of swap      */
             jack_data().jack_buffer(rb);
-#else
-        jack_ringbuffer_t * rb = ::jack_ringbuffer_create(rbsize);
-        result = not_nullptr(rb);
-        if (result)
-            jack_data().jack_buffmessage(rb);
-#endif
+        }
         if (! result)
         {
             m_error_string = "JACK ringbuffer create error";
@@ -1863,19 +2149,18 @@ midi_in_jack::midi_in_jack (midibus & parentbus, midi_info & masterinfo)
 }
 
 /**
- *  Checks the rtmidi_in_data queue for the number of items in the queue.
+ *  Checks the ring-buffer of the port for the number of messages that the
+ *  JACK process callback has put there.
  *
  * \return
- *      Returns the value of rtindata->queue().count(), unless the caller is
- *      using an rtmidi callback function, in which case 0 is always returned.
+ *      Returns the number of messages waiting to be read.
  */
 
 int
 midi_in_jack::api_poll_for_midi ()
 {
-    rtmidi_in_data * rtindata = jack_data().jack_rtmidiin();
-    (void) microsleep(std_sleep_us());                          /* 10 us */
-    return rtindata->queue().count();
+    ring_buffer<midi_message> * rb = jack_data().jack_buffer();
+    return is_nullptr(rb) ? 0 : int(rb->read_space()) ;
 }
 
 /**
@@ -1904,15 +2189,16 @@ midi_in_jack::api_poll_for_midi ()
 bool
 midi_in_jack::api_get_midi_event (event * inev)
 {
-    rtmidi_in_data * rtindata = jack_data().jack_rtmidiin();
-    bool result = ! rtindata->queue().empty();
+    ring_buffer<midi_message> * rb = jack_data().jack_buffer();
+    midi_message mm;
+    bool result = not_nullptr(rb) && rb->pop_front(mm);
     if (result)
     {
-        midi_message mm = rtindata->queue().pop_front();
         result = inev->set_midi_event
         (
-            mm.timestamp(), mm.event_bytes(), mm.event_count()
+            0, mm.event_bytes(), mm.event_count()
         );
+        inev->arrival_us(long(mm.timestamp())); /* see input_arrival()      */
         inev->set_input_bus(mm.input_buss());   // but busarry::get_midi_event()!
         if (result)
         {
@@ -1924,7 +2210,7 @@ midi_in_jack::api_get_midi_event (event * inev)
              */
 
             midibyte st = mm[0];
-            if (st >= EVENT_MIDI_REALTIME && rc().verbose())
+            if (st >= EVENT_MIDI_REALTIME && hot().verbose())
             {
                 static int s_count = 0;
                 char c;
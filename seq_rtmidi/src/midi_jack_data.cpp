@@ -24,16 +24,19 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-09-13
- * \updates       2022-11-22
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  GitHub issue #165: enabled a build and run with no JACK support.
  */
 
+#include <cerrno>                       /* EINTR                            */
 #include <cmath>                        /* std::trunc(double) functions     */
+#include <ctime>                        /* clock_gettime(), timespec        */
 
 #include "midi_jack_data.hpp"           /* seq66::midi_jack_data class      */
 #include "cfg/settings.hpp"             /* seq66::rc() config accessor      */
+#include "os/timing.hpp"                /* seq66::microsleep()              */
 
 #if defined SEQ66_JACK_SUPPORT
 
@@ -59,6 +62,13 @@ double midi_jack_data::sm_jack_ticks_per_beat       = 1920.0;
 double midi_jack_data::sm_jack_beats_per_minute     = 1.0;  /* 120.0        */
 double midi_jack_data::sm_jack_frame_factor         = 0.0;
 bool midi_jack_data::sm_use_offset                  = false;
+jack_nframes_t midi_jack_data::sm_cycle_start       = 0;
+bool midi_jack_data::sm_engine_active               = false;
+double midi_jack_data::sm_engine_start_tick         = 0.0;
+double midi_jack_data::sm_engine_ticks_per_frame    = 0.0;
+sem_t midi_jack_data::sm_input_semaphore;
+bool midi_jack_data::sm_input_semaphore_ok          = false;
+std::atomic<bool> midi_jack_data::sm_input_pending(false);
 
 /**
  * \ctor midi_jack_data
@@ -67,20 +77,65 @@ bool midi_jack_data::sm_use_offset                  = false;
 midi_jack_data::midi_jack_data () :
     m_jack_client           (nullptr),
     m_jack_port             (nullptr),
-#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
     m_jack_buffer           (nullptr),      /* ring_buffer<midi_message>    */
-#else
-    m_jack_buffmessage      (nullptr),
-#endif
     m_jack_lasttime         (0),
 #if defined SEQ66_MIDI_PORT_REFRESH
     m_internal_port_id      (null_system_port_id()),
 #endif
-    m_jack_rtmidiin         (nullptr)
+    m_jack_rtmidiin         (nullptr),
+    m_jack_thru             (nullptr),
+    m_jack_filter           (nullptr),
+    m_thru_events           (),
+    m_thru_count            (0)
 {
     // Empty body
 }
 
+/**
+ *  Adds a thru event for this output port, keeping the events in order of
+ *  offset, since JACK refuses out-of-order events.  Events from one input
+ *  are already in order; only events from another input routed to the same
+ *  port move.  Called only from the JACK process thread.
+ *
+ * \param offset
+ *      The frame offset at which the event arrived in the cycle.
+ *
+ * \param data
+ *      The bytes of the channel message.
+ *
+ * \param size
+ *      The number of bytes, at most 3.
+ *
+ * \return
+ *      Returns false if the event was too long, or the port has no room left
+ *      in this cycle.
+ */
+
+bool
+midi_jack_data::thru_push
+(
+    jack_nframes_t offset, const jack_midi_data_t * data, size_t size
+)
+{
+    bool result = m_thru_count < c_thru_capacity && size <= 3 && size > 0;
+    if (result)
+    {
+        int i = m_thru_count++;
+        while (i > 0 && m_thru_events[i - 1].te_offset > offset)
+        {
+            m_thru_events[i] = m_thru_events[i - 1];
+            --i;
+        }
+
+        thru_event & te = m_thru_events[i];
+        te.te_offset = offset;
+        te.te_size = size;
+        for (size_t b = 0; b < size; ++b)
+            te.te_data[b] = data[b];
+    }
+    return result;
+}
+
 /**
  *  This destructor currently does nothing, as it owns nothing.
  */
@@ -313,6 +368,122 @@ midi_jack_data::frame_offset
     return result;
 }
 
+/**
+ *  Creates the input semaphore.  Called once, by the midi_jack_info
+ *  constructor, before the JACK client is activated.
+ */
+
+void
+midi_jack_data::input_init ()
+{
+    if (! sm_input_semaphore_ok)
+        sm_input_semaphore_ok = sem_init(&sm_input_semaphore, 0, 0) == 0;
+}
+
+/**
+ *  Destroys the input semaphore.  Called by the midi_jack_info destructor
+ *  after the JACK client is closed.
+ */
+
+void
+midi_jack_data::input_free ()
+{
+    if (sm_input_semaphore_ok)
+    {
+        sm_input_semaphore_ok = false;
+        (void) sem_destroy(&sm_input_semaphore);
+    }
+}
+
+/**
+ *  Wakes up the input thread.  Called in the JACK process callback after
+ *  input messages are queued.  sem_post() does not block, and is only done
+ *  if the input thread has not already been signalled but not yet run.
+ */
+
+void
+midi_jack_data::input_signal ()
+{
+    if (! sm_input_pending.exchange(true))
+    {
+        if (sm_input_semaphore_ok)
+            (void) sem_post(&sm_input_semaphore);
+    }
+}
+
+/**
+ *  Blocks the input thread until the JACK process callback has queued some
+ *  input, or until the timeout expires, so that the thread can still check
+ *  for exit.  The pending flag is cleared before the caller looks at the
+ *  queues, so that input arriving while it drains them posts again.
+ *
+ * \param ms
+ *      The timeout, in milliseconds.
+ *
+ * \return
+ *      Returns true if input was signalled.
+ */
+
+bool
+midi_jack_data::input_wait (int ms)
+{
+    bool result = false;
+    if (sm_input_semaphore_ok)
+    {
+        struct timespec deadline;
+        (void) clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += ms / 1000;
+        deadline.tv_nsec += long(ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_nsec -= 1000000000;
+            ++deadline.tv_sec;
+        }
+        int rc;
+        do
+        {
+            rc = sem_timedwait(&sm_input_semaphore, &deadline);
+        } while (rc != 0 && errno == EINTR);
+        result = rc == 0;
+    }
+    else
+        result = microsleep(std_sleep_us());        /* legacy polling       */
+
+    sm_input_pending.store(false);
+    return result;
+}
+
+/**
+ *  Calculates the frame offset of an event played by the JACK-driven engine
+ *  in the current cycle.  Unlike the estimates above, this is exact: the
+ *  engine has just played the ticks of this very cycle, so the offset is
+ *  simply the event's distance from the cycle's first tick, in frames.
+ *  Events from other threads (e.g. MIDI thru), or before a loop wrap-around,
+ *  land at frame 0.
+ *
+ * \param F
+ *      The number of frames in the cycle.
+ *
+ * \param p
+ *      The timestamp of the event, in pulses.
+ *
+ * \return
+ *      Returns the offset, from 0 to F - 1.
+ */
+
+jack_nframes_t
+midi_jack_data::engine_offset (jack_nframes_t F, midipulse p)
+{
+    jack_nframes_t result = 0;
+    double delta = double(p) - sm_engine_start_tick;
+    if (delta > 0.0 && sm_engine_ticks_per_frame > 0.0)
+    {
+        double f = delta / sm_engine_ticks_per_frame;
+        result = f < double(F) ? jack_nframes_t(f) : F - 1 ;
+    }
+    return result;
+}
+
 /**
  *  Calculates pulses * frames / pulse to estimate the frame value.
  *  This value is rounded and truncated.
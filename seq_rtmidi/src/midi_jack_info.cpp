@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-01
- * \updates       2023-12-08
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  This class is meant to collect a whole bunch of JACK information about
@@ -32,7 +32,11 @@
  *  creating JACK midibus objects and midi_jack API objects.
  */
 
+#include <chrono>                       /* std::chrono::milliseconds        */
 #include <cstring>                      /* std::strcpy(), std::strcat()     */
+#include <future>                       /* std::promise<>, std::future<>    */
+#include <memory>                       /* std::shared_ptr<>                */
+#include <thread>                       /* std::thread                      */
 
 #include "seq66-config.h"
 
@@ -40,7 +44,9 @@
 
 #if defined SEQ66_JACK_METADATA
 #include <jack/metadata.h>
-#include "base64_images.hpp"
+#if ! defined SEQ66_LEAN_ENGINE
+#include "base64_images.hpp"            /* PNG icons, about 24 KB of data   */
+#endif
 #endif
 
 #include "cfg/settings.hpp"             /* seq66::rc() configuration object */
@@ -50,6 +56,8 @@
 #include "midi_jack.hpp"                /* seq66::midi_jack_info            */
 #include "midi_jack_data.hpp"           /* seq66::midi_jack_data            */
 #include "midi_jack_info.hpp"           /* seq66::midi_jack_info            */
+#include "os/perftrace.hpp"             /* seq66::trace_scope               */
+#include "os/rtsafe.hpp"                /* seq66::rt_thread()               */
 #include "os/timing.hpp"                /* seq66::microsleep()              */
 #include "util/basic_macros.hpp"        /* C++ version of easy macros       */
 #include "util/strfunctions.hpp"        /* seq66::contains()                */
@@ -61,6 +69,13 @@
 namespace seq66
 {
 
+/**
+ *  How long api_poll_for_midi() blocks waiting for input before returning,
+ *  so that the input thread can check for exit.  As in midi_alsa_info.
+ */
+
+static const int c_input_wait_ms = 10;
+
 /*
  * Defined in midi_jack.cpp; used to be static.
  */
@@ -87,7 +102,14 @@ extern void jack_port_register_callback
  *  Provides a JACK callback function that uses the callbacks defined in the
  *  midi_jack module.  This function calls both the input callback and
  *  the output callback, depending on the port type.  This may lead to
- *  delays, depending on the size of the JACK MIDI buffer.
+ *  delays, depending on the size of the JACK MIDI buffer.  It also drives
+ *  the JACK-driven engine ("output-scheduler = jack"), if the performer
+ *  has installed it.
+ *
+ *  All of the MIDI ports belong to the one JACK client created in
+ *  connect(), so this is the only MIDI process callback, however many
+ *  ports there are.  The work common to all ports is done once, here, and
+ *  then each enabled port's buffer is serviced in a single pass.
  *
  * \param nframes
  *      The frame number from the JACK API.
@@ -102,22 +124,59 @@ extern void jack_port_register_callback
 int
 jack_process_io (jack_nframes_t nframes, void * arg)
 {
+    trace_scope ts("JACK process");
     midi_jack_info * self = reinterpret_cast<midi_jack_info *>(arg);
     if (not_nullptr(self))
     {
+        if (rc().rt_safe() && ! rt_thread())
+            rt_thread(true);                    /* count allocations here   */
+
         /*
-         * Go through the I/O ports and route the data appropriately.
+         * First let the JACK-driven engine, if active, play this cycle, so
+         * that its events go out in this cycle.  Then go through the I/O
+         * ports and route the data appropriately.
+         */
+
+        jack_assistant::engine_window window;
+        jack_nframes_t rate = jack_nframes_t(self->jack_sample_rate());
+        bool engine = jack_assistant::run_engine(nframes, rate, window);
+        midi_jack_data::engine_window
+        (
+            engine, window.ew_start_tick, window.ew_ticks_per_frame
+        );
+
+        /*
+         * The cycle start and the frame-offset factors are the same for
+         * every port, so get them once per cycle, not once per port.
+         */
+
+        const jack_position_t & pos =
+            jack_assistant::get_jack_parameters().position;
+
+        jack_client_t * client = self->client_handle();
+        midi_jack_data::cycle_start(::jack_last_frame_time(client));
+        if (midi_jack_data::recalculate_frame_factor(pos, nframes))
+            async_safe_errprint("JACK settings changed");
+
+        /*
+         * The inputs go first, so that the MIDI thru events they route to
+         * the outputs go out in this same cycle.
          */
 
         for (auto mj : self->jack_ports())  /* midi_jack pointers       */
         {
-            if (mj->enabled())
+            if (mj->parent_bus().is_input_port() && mj->enabled())
+                (void) jack_process_rtmidi_input(nframes, &mj->jack_data());
+        }
+        for (auto mj : self->jack_ports())
+        {
+            if (! mj->parent_bus().is_input_port())
             {
                 midi_jack_data * mjp = &mj->jack_data();
-                if (mj->parent_bus().is_input_port())
-                    (void) jack_process_rtmidi_input(nframes, mjp);
-                else
+                if (mj->enabled())
                     (void) jack_process_rtmidi_output(nframes, mjp);
+                else
+                    mjp->thru_clear();      /* drop any routed thru     */
             }
         }
     }
@@ -147,9 +206,14 @@ midi_jack_info::midi_jack_info
     m_jack_ports            (),
     m_jack_client           (nullptr),              /* inited for connect() */
     m_jack_buffer_size      (0),
-    m_jack_sample_rate      (0)
+    m_jack_sample_rate      (0),
+    m_connect_thread        (),
+    m_connect_stop          (false),
+    m_graph_ports           (),
+    m_graph_loaded          (false)
 {
     silence_jack_info();
+    midi_jack_data::input_init();                   /* before the callback  */
     m_jack_client = connect();
     if (not_nullptr(m_jack_client))                 /* created by connect() */
     {
@@ -167,6 +231,7 @@ midi_jack_info::midi_jack_info
 midi_jack_info::~midi_jack_info ()
 {
     disconnect();
+    midi_jack_data::input_free();                   /* after the callback   */
 }
 
 /**
@@ -239,6 +304,10 @@ midi_jack_info::connect ()
                 (
                     m_jack_client, JACK_METADATA_ICON_NAME, n
                 );
+#if defined SEQ66_LEAN_ENGINE
+                if (! ok)
+                    error_message("Failed to set client icon", n);
+#else
                 if (ok)
                 {
                     debug_message("Set 32x32 icon", n);
@@ -264,6 +333,7 @@ midi_jack_info::connect ()
                     if (! ok)
                         error_message("Failed to set 128x128 icon");
                 }
+#endif  // defined SEQ66_LEAN_ENGINE
 #endif
             }
             else
@@ -293,6 +363,10 @@ midi_jack_info::connect ()
 void
 midi_jack_info::disconnect ()
 {
+    m_connect_stop = true;
+    if (m_connect_thread.joinable())
+        m_connect_thread.join();
+
     if (not_nullptr(m_jack_client))
     {
         ::jack_deactivate(m_jack_client);
@@ -803,6 +877,7 @@ midi_jack_info::api_connect ()
     bool result = not_nullptr(client_handle());
     if (result)
     {
+        set_thru_routes();
         m_jack_buffer_size = ::jack_get_buffer_size(client_handle());
 
         int rcode = ::jack_activate(client_handle());
@@ -825,15 +900,16 @@ midi_jack_info::api_connect ()
     }
     if (result && rc().jack_auto_connect())         /* issue #60        */
     {
-        for (auto m : bus_container())              /* midibus pointers */
+        if (rc().jack_lazy_connect())
         {
-            if (m->is_port_connectable())
-            {
-                result = m->api_connect();
-                if (! result)
-                    break;
-            }
+            m_connect_stop = false;
+            m_connect_thread = std::thread
+            (
+                &midi_jack_info::connect_lazily, this
+            );
         }
+        else
+            result = connect_all_ports();
     }
     if (! result)
     {
@@ -843,6 +919,157 @@ midi_jack_info::api_connect ()
     return result;
 }
 
+/**
+ *  Points each input port that has a [midi-thru] route at the output port
+ *  of the route, found by buss number, so that the process callback can
+ *  route its channel messages itself.  A route to a missing output buss is
+ *  ignored.
+ */
+
+void
+midi_jack_info::set_thru_routes ()
+{
+    for (auto in : jack_ports())
+    {
+        if (! in->parent_bus().is_input_port())
+            continue;
+
+        midi_jack_data * dest = nullptr;
+        int outbus = rc().thru_route(in->parent_bus().bus_index());
+        if (outbus >= 0)
+        {
+            for (auto out : jack_ports())
+            {
+                const midibus & ob = out->parent_bus();
+                if (! ob.is_input_port() && ob.bus_index() == outbus)
+                {
+                    dest = &out->jack_data();
+                    break;
+                }
+            }
+            if (is_nullptr(dest))
+                error_message("No thru buss", std::to_string(outbus));
+        }
+        in->jack_data().jack_thru(dest);
+    }
+}
+
+/**
+ *  Makes the connection pass, after all of the ports have been registered
+ *  and the client activated.  The ports of the graph are read once, up
+ *  front, so that each connection needs no look-up of its own.
+ *
+ * \return
+ *      Returns true if all of the connections were made.
+ */
+
+bool
+midi_jack_info::connect_all_ports ()
+{
+    load_graph_ports();
+
+    bool result = connect_ports(true) && connect_ports(false);
+    m_graph_ports.clear();
+    m_graph_loaded = false;
+    return result;
+}
+
+/**
+ *  Reads the full names of all of the JACK MIDI ports, of every client,
+ *  into m_graph_ports.
+ */
+
+void
+midi_jack_info::load_graph_ports ()
+{
+    m_graph_ports.clear();
+    m_graph_loaded = false;
+    if (not_nullptr(m_jack_client))
+    {
+        const char ** ports = ::jack_get_ports
+        (
+            m_jack_client, NULL, JACK_DEFAULT_MIDI_TYPE, 0
+        );
+        if (not_nullptr(ports))
+        {
+            for (int i = 0; not_nullptr(ports[i]); ++i)
+                m_graph_ports.insert(ports[i]);
+
+            ::jack_free(ports);
+        }
+        m_graph_loaded = true;
+    }
+}
+
+/**
+ *  Checks for a port in the graph read by load_graph_ports().
+ *
+ * \param fullname
+ *      The "client:port" name of the port.
+ *
+ * \return
+ *      Returns true if the port exists, or if the graph is not loaded.
+ */
+
+bool
+midi_jack_info::graph_has_port (const std::string & fullname) const
+{
+    return ! m_graph_loaded || m_graph_ports.count(fullname) > 0;
+}
+
+/**
+ *  Connects each connectable bus to the system port it shadows.  Each
+ *  jack_connect() is a round trip to the JACK server, and a graph change
+ *  in every client, which is why a setup with many clients is slow to
+ *  start.  So a connection that already exists, or whose port is missing
+ *  from the graph, is not attempted.
+ *
+ * \param enabled
+ *      If true, the ports enabled in the 'rc' clocks and inputs lists are
+ *      connected.  If false, those that are not are connected, which
+ *      happens only if rc().init_disabled_ports() is set.
+ *
+ * \return
+ *      Returns false if a connection failed, or if stopped by
+ *      disconnect().
+ */
+
+bool
+midi_jack_info::connect_ports (bool enabled)
+{
+    bool result = true;
+    for (auto m : bus_container())                  /* midibus pointers     */
+    {
+        if (m_connect_stop)
+        {
+            result = false;
+            break;
+        }
+        if (m->is_port_connectable() && m->port_enabled() == enabled)
+        {
+            result = m->api_connect();
+            if (! result)
+                break;
+        }
+    }
+    return result;
+}
+
+/**
+ *  The body of the connection thread of the "jack-lazy-connect" option.
+ *  The ports the last session enabled are connected first, as they are the
+ *  ones that will be played, then any others that are connectable.  Until its connection is
+ *  made, a port simply plays to nowhere, or hears nothing.
+ */
+
+void
+midi_jack_info::connect_lazily ()
+{
+    bool ok = connect_all_ports();
+    if (! ok && ! m_connect_stop)
+        error_message("JACK background connection failed");
+}
+
 /**
  *  Sets the PPQN numeric value, then makes JACK calls to set up the PPQ
  *  tempo.
@@ -910,14 +1137,19 @@ midi_jack_info::api_port_start
 }
 
 /**
- *  We might be able to eliminate this function.
+ *  Blocks the input thread until the JACK process callback signals that it
+ *  has queued input, or until c_input_wait_ms passes, so that an idle input
+ *  thread uses no CPU.  The events themselves are in the queues of the
+ *  input ports; see mastermidibus::api_poll_for_midi().
+ *
+ * \return
+ *      Returns 1 if input was signalled, and 0 on a timeout.
  */
 
 int
 midi_jack_info::api_poll_for_midi ()
 {
-    (void) microsleep(std_sleep_us());
-    return 0;
+    return midi_jack_data::input_wait(c_input_wait_ms) ? 1 : 0 ;
 }
 
 /**
@@ -976,6 +1208,54 @@ silence_jack_info (bool silent)
         ::jack_set_info_function(jack_message_bit_bucket);
 }
 
+namespace
+{
+
+const int c_jack_probe_wait_ms  = 5000;     /* JACK was found last time     */
+const int c_jack_probe_brief_ms = 1000;     /* JACK was not found last time */
+
+/**
+ *  Opens and activates a client, and checks for JACK MIDI output ports.
+ *  It does not stay open.
+ */
+
+bool
+probe_jack ()
+{
+    bool result = false;
+    const char * cname = "jack_detector";
+    jack_status_t status;
+    jack_status_t * ps = &status;
+    jack_options_t jopts = JackNoStartServer;
+    jack_client_t * jackman = ::jack_client_open(cname, jopts, ps);
+    if (not_nullptr(jackman))
+    {
+        int rc = ::jack_activate(jackman);
+        if (rc == 0)
+        {
+            const char ** ports = ::jack_get_ports
+            (
+                jackman, NULL, JACK_DEFAULT_MIDI_TYPE, JackPortIsOutput
+            );
+            result = not_nullptr(ports);
+            if (result)
+            {
+                int count = 0;
+                while (not_nullptr(ports[count]))
+                    ++count;
+
+                result = count > 0;
+                ::jack_free(ports);
+            }
+            ::jack_deactivate(jackman);
+        }
+        (void) ::jack_client_close(jackman);
+    }
+    return result;
+}
+
+}           // namespace (anonymous)
+
 /**
  *  JACK detection function.  Just opens a client without activating it, then
  *  closes it.
@@ -1009,6 +1289,14 @@ silence_jack_info (bool silent)
  *  Needs testing under various conditions.
  *
  *  This is a pared-down version of detect_jack() in the rtl66 library.
+ *
+ *  A JACK server that is hung, or a jackdbus that is slow to answer, can
+ *  keep jack_client_open() from returning for a long time, which used to
+ *  hold up the start of the application.  So the probe is run in a thread,
+ *  and waited for only so long: longer if the 'rc' file says JACK was the
+ *  MIDI engine found last time, and briefly otherwise.  If the wait runs
+ *  out, JACK is treated as absent, and the probe thread is left to finish
+ *  on its own.
  */
 
 bool
@@ -1028,33 +1316,23 @@ detect_jack (bool forcecheck)
     }
     else
     {
-        const char * cname = "jack_detector";
-        jack_status_t status;
-        jack_status_t * ps = &status;
-        jack_options_t jopts = JackNoStartServer;
-        jack_client_t * jackman = ::jack_client_open(cname, jopts, ps);
-        if (not_nullptr(jackman))
-        {
-            int rc = ::jack_activate(jackman);
-            if (rc == 0)
-            {
-                const char ** ports = ::jack_get_ports
-                (
-                    jackman, NULL, JACK_DEFAULT_MIDI_TYPE, JackPortIsOutput
-                );
-                result = not_nullptr(ports);
-                if (result)
-                {
-                    int count = 0;
-                    while (not_nullptr(ports[count]))
-                        ++count;
+        /*
+         * The promise is shared, so that a probe that outlasts the wait
+         * still has somewhere to put its answer.
+         */
+
+        auto answer = std::make_shared<std::promise<bool>>();
+        std::future<bool> detected = answer->get_future();
+        std::thread([answer] () { answer->set_value(probe_jack()); }).detach();
+
+        bool lastjack = rc().last_midi_api() == "jack";
+        int ms = lastjack ? c_jack_probe_wait_ms : c_jack_probe_brief_ms ;
+        auto wait = std::chrono::milliseconds(ms);
+        if (detected.wait_for(wait) == std::future_status::ready)
+            result = detected.get();
+        else
+            warnprint("JACK probe timed out");
 
-                    result = count > 0;
-                }
-                ::jack_deactivate(jackman);
-            }
-            (void) ::jack_client_close(jackman);
-        }
         if (result)
         {
             s_jack_was_detected = true;
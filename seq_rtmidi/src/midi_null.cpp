@@ -0,0 +1,370 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midi_null.cpp
+ *
+ *  This module defines the MIDI I/O classes of the null MIDI API.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  The ideal time of an event is the time playback started (or continued),
+ *  plus the length of the ticks from the start tick to the event's
+ *  timestamp at the current tempo.  The error is the time of the send less
+ *  the ideal time.  It includes the output thread's wake-up latency and any
+ *  lateness of the frame, which is what the user hears on a real device,
+ *  less the device's own latency.
+ */
+
+#include "seq66-config.h"               /* SEQ66_CLIENT_NAME                */
+#include "cfg/settings.hpp"             /* seq66::rc()                      */
+#include "midi/calculations.hpp"        /* seq66::ticks_to_delta_time_us()  */
+#include "midi/event.hpp"               /* seq66::event (MIDI event)        */
+#include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
+#include "midi_null.hpp"                /* seq66::midi_null                 */
+#include "midi_null_info.hpp"           /* seq66::midi_null_info            */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Principal constructor.  The master information object is always a
+ *  midi_null_info, because rtmidi creates midi_null ports only when the
+ *  null API has been selected.
+ */
+
+midi_null::midi_null (midibus & parentbus, midi_info & masterinfo) :
+    midi_api            (parentbus, masterinfo),
+    m_null_info         (static_cast<midi_null_info &>(masterinfo)),
+    m_stats_mutex       (),
+    m_origin            (clock::now()),
+    m_origin_tick       (0),
+    m_running           (false),
+    m_bpm               (masterinfo.bpm()),
+    m_last_tick         (0),
+    m_send_count        (0),
+    m_timed_count       (0),
+    m_error_sum_us      (0.0),
+    m_late_max_us       (0.0),
+    m_early_max_us      (0.0)
+{
+    set_name(SEQ66_CLIENT_NAME, bus_name(), port_name());
+}
+
+midi_null::~midi_null ()
+{
+    // no code
+}
+
+bool
+midi_null::api_init_out ()
+{
+    set_port_open();
+    return true;
+}
+
+bool
+midi_null::api_init_in ()
+{
+    set_port_open();
+    return true;
+}
+
+bool
+midi_null::api_init_out_sub ()
+{
+    std::string portname = port_name();
+    if (portname.empty())
+        portname = rc().app_client_name() + " out";
+
+    set_port_id(bus_index());
+    port_name(portname);
+    set_port_open();
+    return true;
+}
+
+bool
+midi_null::api_init_in_sub ()
+{
+    std::string portname = port_name();
+    if (portname.empty())
+        portname = rc().app_client_name() + " in";
+
+    set_port_id(bus_index());
+    port_name(portname);
+    set_port_open();
+    return true;
+}
+
+/**
+ *  Logs the statistics of an output port as it is closed.
+ */
+
+bool
+midi_null::api_deinit_out ()
+{
+    report();
+    return true;
+}
+
+bool
+midi_null::api_deinit_in ()
+{
+    return true;
+}
+
+bool
+midi_null::api_connect ()
+{
+    return true;
+}
+
+/**
+ *  Times the event, then drops it or loops it back.  The event that is
+ *  looped back carries the channel it was sent on.
+ *
+ * \param e24
+ *      The event to be sent.
+ *
+ * \param channel
+ *      The channel to send the event on.
+ */
+
+void
+midi_null::api_play (const event * e24, midibyte channel)
+{
+    record(*e24);
+    if (rc().null_midi_loopback())
+    {
+        event ev(*e24);
+        if (ev.get_status() < EVENT_MIDI_SYSEX)
+            ev.set_status(e24->get_status(channel));
+
+        null_info().loop_back(ev, bus_index());
+    }
+}
+
+void
+midi_null::api_sysex (const event * e24)
+{
+    record(*e24);
+    if (rc().null_midi_loopback())
+        null_info().loop_back(*e24, bus_index());
+}
+
+void
+midi_null::api_flush ()
+{
+    // nothing is buffered
+}
+
+void
+midi_null::api_continue_from (midipulse tick, midipulse /*beats*/)
+{
+    restart(tick);
+}
+
+void
+midi_null::api_start ()
+{
+    restart(0);
+}
+
+/**
+ *  Stops the timing, and logs the statistics for the run.  They are then
+ *  cleared, so that closing the port does not log them again.
+ */
+
+void
+midi_null::api_stop ()
+{
+    report();
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    m_running = false;
+    m_send_count = m_timed_count = 0;
+}
+
+void
+midi_null::api_clock (midipulse /*tick*/)
+{
+    // MIDI clocks are not timed
+}
+
+void
+midi_null::api_set_ppqn (int /*ppqn*/)
+{
+    // the PPQN of the master information object is used
+}
+
+/**
+ *  The tempo of the master information object is used.  A change of tempo
+ *  is noticed by record().
+ */
+
+void
+midi_null::api_set_beats_per_minute (midibpm /*bpm*/)
+{
+    // no code
+}
+
+/**
+ *  Starts a new run of timing, clearing the statistics.
+ *
+ * \param tick
+ *      The tick at which playback starts or continues.
+ */
+
+void
+midi_null::restart (midipulse tick)
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    m_origin = clock::now();
+    m_origin_tick = m_last_tick = tick;
+    m_running = true;
+    m_bpm = master_info().bpm();
+    m_send_count = m_timed_count = 0;
+    m_error_sum_us = m_late_max_us = m_early_max_us = 0.0;
+}
+
+/**
+ *  Counts a send and, while playing, compares the time of the send to the
+ *  ideal time of the event.  If the tempo has changed, the origin is first
+ *  moved to the ideal time of the last event timed, so that the ticks
+ *  before the change are measured at the old tempo.
+ *
+ * \param ev
+ *      The event being sent, whose timestamp is the tick it belongs to.
+ */
+
+void
+midi_null::record (const event & ev)
+{
+    clock::time_point now = clock::now();
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    ++m_send_count;
+    if (m_running && ev.timestamp() >= m_origin_tick)
+    {
+        int ppq = master_info().ppqn();
+        midibpm bp = master_info().bpm();
+        if (bp != m_bpm)
+        {
+            double us = ticks_to_delta_time_us
+            (
+                m_last_tick - m_origin_tick, m_bpm, ppq
+            );
+            m_origin += std::chrono::microseconds(long(us));
+            m_origin_tick = m_last_tick;
+            m_bpm = bp;
+        }
+
+        double ideal = ticks_to_delta_time_us
+        (
+            ev.timestamp() - m_origin_tick, m_bpm, ppq
+        );
+        double actual = double
+        (
+            std::chrono::duration_cast<std::chrono::microseconds>
+            (
+                now - m_origin
+            ).count()
+        );
+        double error = actual - ideal;
+        m_error_sum_us += error;
+        if (error > m_late_max_us)
+            m_late_max_us = error;
+        else if (error < m_early_max_us)
+            m_early_max_us = error;
+
+        if (ev.timestamp() > m_last_tick)
+            m_last_tick = ev.timestamp();
+
+        ++m_timed_count;
+    }
+}
+
+/**
+ *  Logs the scheduling error of the sends timed since the last start.
+ */
+
+void
+midi_null::report ()
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    if (m_timed_count > 0)
+    {
+        double mean = m_error_sum_us / double(m_timed_count);
+        msgprintf
+        (
+            msglevel::info, "%s: %ld sent, %ld timed; error mean %.0f us, "
+            "latest %.0f us, earliest %.0f us",
+            port_name().c_str(), m_send_count, m_timed_count,
+            mean, m_late_max_us, m_early_max_us
+        );
+    }
+}
+
+/*
+ * midi_in_null section
+ */
+
+midi_in_null::midi_in_null (midibus & parentbus, midi_info & masterinfo) :
+    midi_null   (parentbus, masterinfo)
+{
+    // Empty body
+}
+
+/**
+ *  Used by mastermidibase::is_more_input() to drain the loopback queue;
+ *  the waiting is done by midi_null_info::api_poll_for_midi().
+ *
+ * \return
+ *      Returns the number of looped-back events waiting.
+ */
+
+int
+midi_in_null::api_poll_for_midi ()
+{
+    return null_info().pending();
+}
+
+/*
+ * midi_out_null section
+ */
+
+midi_out_null::midi_out_null (midibus & parentbus, midi_info & masterinfo) :
+    midi_null   (parentbus, masterinfo)
+{
+    // Empty body
+}
+
+}           // namespace seq66
+
+/*
+ * midi_null.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,242 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midi_null_info.cpp
+ *
+ *    A class for the made-up ports of the null MIDI API.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       See above.
+ *
+ *  There are as many output ports as the "manual" (virtual) output port
+ *  count in the 'rc' file.  Input ports exist only when looping back, one
+ *  per "manual" input port; output port n loops to input port n modulo the
+ *  number of input ports.
+ */
+
+#include <chrono>                       /* std::chrono::milliseconds        */
+
+#include "cfg/settings.hpp"             /* seq66::rc() configuration object */
+#include "midi_null_info.hpp"           /* seq66::midi_null_info            */
+#include "util/basic_macros.hpp"        /* C++ version of easy macros       */
+
+/*
+ * Do not document the namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The longest wait for looped-back input, as with the poll() timeout of
+ *  the ALSA implementation.
+ */
+
+static const int c_poll_wait_ms     = 10;
+
+/**
+ *  The made-up client number and name of the null ports.
+ */
+
+static const int c_null_client      = 0;
+static const char * const c_null_client_name = "null";
+
+/**
+ *  Principal constructor.  There is nothing to open.
+ *
+ * \param appname
+ *      Provides the name of the application.
+ *
+ * \param ppqn
+ *      Provides the PPQN value needed by this object.
+ *
+ * \param bpm
+ *      Provides the beats/minute value needed by this object.
+ */
+
+midi_null_info::midi_null_info
+(
+    const std::string & appname,
+    int ppqn,
+    midibpm bpm
+) :
+    midi_info       (appname, ppqn, bpm),
+    m_loop_mutex    (),
+    m_loop_cond     (),
+    m_loop_queue    ()
+{
+    // no code
+}
+
+midi_null_info::~midi_null_info ()
+{
+    // no code
+}
+
+/**
+ *  Queues an event sent to a null output port, for the input thread to
+ *  pick up via api_get_midi_event().
+ *
+ * \param ev
+ *      The event as sent, with its channel in the status byte.
+ *
+ * \param outport
+ *      The index of the output port, which selects the input port.
+ */
+
+void
+midi_null_info::loop_back (const event & ev, int outport)
+{
+    int inports = input_ports().get_port_count();
+    if (inports > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_loop_mutex);
+            m_loop_queue.push_back(ev);
+            m_loop_queue.back().set_input_bus(bussbyte(outport % inports));
+        }
+        m_loop_cond.notify_one();
+    }
+}
+
+/**
+ *  Waits briefly for looped-back input.
+ *
+ * \return
+ *      Returns the number of events waiting.
+ */
+
+int
+midi_null_info::api_poll_for_midi ()
+{
+    std::unique_lock<std::mutex> lock(m_loop_mutex);
+    if (m_loop_queue.empty())
+    {
+        (void) m_loop_cond.wait_for
+        (
+            lock, std::chrono::milliseconds(c_poll_wait_ms)
+        );
+    }
+    return int(m_loop_queue.size());
+}
+
+/**
+ *  Checks for looped-back input without waiting, for
+ *  mastermidibase::is_more_input().
+ *
+ * \return
+ *      Returns the number of events waiting.
+ */
+
+int
+midi_null_info::pending ()
+{
+    std::lock_guard<std::mutex> lock(m_loop_mutex);
+    return int(m_loop_queue.size());
+}
+
+/**
+ *  Gets the oldest looped-back event.
+ *
+ * \param inev
+ *      The destination for the event.
+ *
+ * \return
+ *      Returns false if there is no event.
+ */
+
+bool
+midi_null_info::api_get_midi_event (event * inev)
+{
+    std::lock_guard<std::mutex> lock(m_loop_mutex);
+    bool result = ! m_loop_queue.empty() && not_nullptr(inev);
+    if (result)
+    {
+        *inev = m_loop_queue.front();
+        m_loop_queue.pop_front();
+    }
+    return result;
+}
+
+/**
+ *  Makes up the null ports.
+ *
+ * \param inputports
+ *      The ports that Seq66 reads from, used only when looping back.
+ *
+ * \param outputports
+ *      The ports that Seq66 writes to.
+ *
+ * \return
+ *      Returns the total number of ports, or -1 if there are none.
+ */
+
+int
+midi_null_info::get_all_port_info
+(
+    midi_port_info & inputports,
+    midi_port_info & outputports
+)
+{
+    int result = 0;
+    inputports.clear();
+    outputports.clear();
+    if (rc().null_midi_loopback())
+    {
+        int count = rc().manual_in_port_count();
+        for (int port = 0; port < count; ++port)
+        {
+            std::string portname = "loop in " + std::to_string(port);
+            inputports.add
+            (
+                c_null_client, c_null_client_name, port, portname,
+                midibase::io::input, midibase::port::normal
+            );
+            ++result;
+        }
+    }
+
+    int count = rc().manual_port_count();
+    for (int port = 0; port < count; ++port)
+    {
+        std::string portname = "null out " + std::to_string(port);
+        outputports.add
+        (
+            c_null_client, c_null_client_name, port, portname,
+            midibase::io::output, midibase::port::normal
+        );
+        ++result;
+    }
+    if (result == 0)
+        result = (-1);
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * midi_null_info.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
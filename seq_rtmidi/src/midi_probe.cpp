@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone, 2003-2012; refactoring by Chris Ahlstrom
  * \date          2016-11-19
- * \updates       2022-03-13
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  We include this test code in our library, rather than in a separate
@@ -70,6 +70,7 @@ midi_api_name (int i)
         s_api_map[rtmidi_api::unspecified]  = "Unspecified";
         s_api_map[rtmidi_api::alsa]         = "ALSA";
         s_api_map[rtmidi_api::jack]         = "Jack";
+        s_api_map[rtmidi_api::null]         = "Null";
 
 #if defined SEQ66_USE_RTMIDI_API_ALL
         /*
@@ -0,0 +1,310 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midi_rtp.cpp
+ *
+ *  This module defines the MIDI I/O class of the network (RTP-MIDI)
+ *  busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ */
+
+#include "midi/calculations.hpp"        /* seq66::pulse_length_us()         */
+#include "midi/event.hpp"               /* seq66::event (MIDI event)        */
+#include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
+#include "midi_info.hpp"                /* seq66::midi_info                 */
+#include "midi_rtp.hpp"                 /* seq66::midi_rtp                  */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "rtp_session.hpp"              /* seq66::rtp_peer                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+midi_rtp::midi_rtp
+(
+    midibus & parentbus, midi_info & masterinfo,
+    std::shared_ptr<rtp_peer> peer
+) :
+    midi_api    (parentbus, masterinfo),
+    m_peer      (peer)
+{
+    // no code
+}
+
+midi_rtp::~midi_rtp ()
+{
+    // no code
+}
+
+bool
+midi_rtp::api_init_out ()
+{
+    set_port_open();
+    return true;
+}
+
+/**
+ *  Opens the peer's input to this buss.  Until then, what the peer sends
+ *  is dropped.
+ */
+
+bool
+midi_rtp::api_init_in ()
+{
+    m_peer->input_buss(parent_bus().bus_index());
+    set_port_open();
+    return true;
+}
+
+bool
+midi_rtp::api_init_out_sub ()
+{
+    return api_init_out();
+}
+
+bool
+midi_rtp::api_init_in_sub ()
+{
+    return api_init_in();
+}
+
+bool
+midi_rtp::api_deinit_out ()
+{
+    return true;
+}
+
+bool
+midi_rtp::api_deinit_in ()
+{
+    m_peer->input_buss(-1);
+    return true;
+}
+
+/**
+ *  Gets the next incoming event whose time has come.  The arrival time is
+ *  its time on our clock, when the peer's clock is known.
+ *
+ * \param inev
+ *      The destination for the event.
+ *
+ * \return
+ *      Returns true if an event was obtained, other than Active Sensing or
+ *      Reset, which are dropped as the JACK input does.
+ */
+
+bool
+midi_rtp::api_get_midi_event (event * inev)
+{
+    midi_message mm;
+    bool result = m_peer->pop_input(mm, microtime());
+    if (result)
+    {
+        result = inev->set_midi_event(0, mm.event_bytes(), mm.event_count());
+        inev->arrival_us(long(mm.timestamp()));
+        inev->set_input_bus(mm.input_buss());
+        if (result && event::is_sense_or_reset(mm.status()))
+            result = false;
+    }
+    return result;
+}
+
+int
+midi_rtp::api_poll_for_midi ()
+{
+    return m_peer->pending_input(microtime());
+}
+
+/**
+ *  Adds the event to the peer's packet for the frame, at its time, with
+ *  running status if the buss's output filter has a "running" stage.
+ *
+ * \param e24
+ *      The event to be sent.
+ *
+ * \param channel
+ *      The channel to send the event on.
+ */
+
+void
+midi_rtp::api_play (const event * e24, midibyte channel)
+{
+    midibyte msg[3];
+    midibyte d0, d1;
+    e24->get_data(d0, d1);
+    msg[0] = e24->get_status(channel);
+    msg[1] = d0;
+    msg[2] = d1;
+    int len = e24->is_two_bytes() ? 3 : 2 ;
+    m_peer->append
+    (
+        msg, len, schedule(e24->timestamp()), parent_bus().running_status()
+    );
+}
+
+void
+midi_rtp::api_sysex (const event * e24)
+{
+    const event::sysex & data = e24->get_sysex();
+    if (! data.empty())
+        api_sysex_chunk(data.data(), int(data.size()));
+}
+
+/**
+ *  Sends a SysEx message, or a chunk of a streamed one.  A chunk that is
+ *  not the whole message is coded as an RTP-MIDI segment:  F0 ... F0 for
+ *  the first, F7 ... F0 for the middle ones, and F7 ... F7 for the last.
+ *
+ * \param data
+ *      The bytes of the message or chunk.
+ *
+ * \param len
+ *      The number of bytes.
+ */
+
+void
+midi_rtp::api_sysex_chunk (const midibyte * data, int len)
+{
+    if (len <= 0)
+        return;
+
+    bool first = data[0] == EVENT_MIDI_SYSEX;
+    bool last = data[len - 1] == EVENT_MIDI_SYSEX_END;
+    midibytes segment;
+    segment.reserve(std::size_t(len) + 2);
+    if (! first)
+        segment.push_back(EVENT_MIDI_SYSEX_END);
+
+    segment.insert(segment.end(), data, data + len);
+    if (! last)
+        segment.push_back(EVENT_MIDI_SYSEX);
+
+    m_peer->append
+    (
+        segment.data(), int(segment.size()),
+        m_peer->clock_ts() + std::uint64_t(m_peer->lookahead_us() / 100)
+    );
+}
+
+/**
+ *  The packets are sent by rtp_network::flush(), at the end of the frame;
+ *  this does the same for the one peer.
+ */
+
+void
+midi_rtp::api_flush ()
+{
+    m_peer->flush();
+}
+
+/**
+ *  Sends Song Position, in MIDI beats (sixteenth notes), then Continue.
+ */
+
+void
+midi_rtp::api_continue_from (midipulse tick, midipulse beats)
+{
+    midibyte msg[3];
+    msg[0] = EVENT_MIDI_SONG_POS;
+    msg[1] = midibyte(beats & 0x7F);
+    msg[2] = midibyte((beats >> 7) & 0x7F);
+    m_peer->append(msg, 3, schedule(tick));
+    send_byte(tick, EVENT_MIDI_CONTINUE);
+}
+
+void
+midi_rtp::api_start ()
+{
+    send_byte(0, EVENT_MIDI_START);
+}
+
+void
+midi_rtp::api_stop ()
+{
+    send_byte(0, EVENT_MIDI_STOP);
+}
+
+void
+midi_rtp::api_clock (midipulse tick)
+{
+    if (tick >= 0)
+        send_byte(tick, EVENT_MIDI_CLOCK);
+}
+
+void
+midi_rtp::api_set_ppqn (int /*ppqn*/)
+{
+    // the PPQN of the master information object is used
+}
+
+void
+midi_rtp::api_set_beats_per_minute (midibpm /*bpm*/)
+{
+    // the tempo of the master information object is used
+}
+
+/**
+ *  Gives the time of an event on our 10 kHz clock:  the lookahead from
+ *  now, less how far the event lags the exact play position of the frame,
+ *  as in midi_alsa::schedule().  An event that comes out late because the
+ *  output thread woke up late is then still timestamped at (its time +
+ *  lookahead), and the peer plays it then.
+ *
+ * \param tick
+ *      The event's timestamp, the tick at which it should sound.
+ */
+
+std::uint64_t
+midi_rtp::schedule (midipulse tick)
+{
+    long us = m_peer->lookahead_us();
+    double late = master_info().frame_tick() - double(tick);
+    if (late > 0.0 && us > 0)
+    {
+        midibpm bp = master_info().bpm();
+        int ppq = master_info().ppqn();
+        us -= long(late * pulse_length_us(bp, ppq) + 0.5);
+        if (us < 0)
+            us = 0;
+    }
+    return m_peer->clock_ts() + std::uint64_t(us / 100);
+}
+
+void
+midi_rtp::send_byte (midipulse tick, midibyte status)
+{
+    m_peer->append(&status, 1, schedule(tick));
+}
+
+}           // namespace seq66
+
+/*
+ * midi_rtp.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-21
- * \updates       2025-01-20
+ * \updates       2026-10-14
  * \license       GNU GPLv2 or above
  *
  *  This file provides a cross-platform implementation of the midibus class.
@@ -38,6 +38,7 @@
 #include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
 #include "rtmidi.hpp"                   /* RtMidi updated API header file   */
 #include "rtmidi_info.hpp"              /* seq66::rtmidi_info (new)         */
+#include "rtp_session.hpp"              /* seq66::rtp_peer, RTP-MIDI        */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -98,7 +99,8 @@ midibus::midibus
         rt.get_port_alias(index)
     ),
     m_rt_midi       (nullptr),
-    m_master_info   (rt)                /* master_info() accessor           */
+    m_master_info   (rt),               /* master_info() accessor           */
+    m_rtp_peer      ()
 {
     if (porttype == port::manual)
     {
@@ -150,6 +152,48 @@ midibus::midibus
     }
 }
 
+/**
+ *  Network-port constructor.  The buss is a normal one, so that it is
+ *  opened with init_in() or init_out(), named "RTP-MIDI" and with the
+ *  "host:port" of the peer as its port name.
+ *
+ * \param rt
+ *      Provides the rtmidi_info object, for the application name, the PPQN,
+ *      and the tempo.
+ *
+ * \param peer
+ *      The peer of the session that the buss sends to or receives from.
+ *
+ * \param index
+ *      The buss's index, after the busses of the native API.
+ *
+ * \param peerindex
+ *      The index of the peer, used as the port ID.
+ *
+ * \param iotype
+ *      Indicates an input or an output buss.
+ */
+
+midibus::midibus
+(
+    rtmidi_info & rt,
+    std::shared_ptr<rtp_peer> peer,
+    int index,
+    int peerindex,
+    midibase::io iotype
+) :
+    midibase
+    (
+        rt.app_name(), "RTP-MIDI", peer->name(), index, 0, peerindex,
+        rt.global_queue(), rt.ppqn(), rt.bpm(), iotype, port::normal, ""
+    ),
+    m_rt_midi       (nullptr),
+    m_master_info   (rt),
+    m_rtp_peer      (peer)
+{
+    // no code
+}
+
 /**
  *  The destructor closes out the RtMidi MIDI infrastructure.
  */
@@ -274,7 +318,11 @@ midibus::api_init_out ()
     bool result = false;
     try
     {
-        m_rt_midi = new rtmidi_out(*this, master_info());
+        if (m_rtp_peer)
+            m_rt_midi = new rtmidi_out(*this, master_info(), m_rtp_peer);
+        else
+            m_rt_midi = new rtmidi_out(*this, master_info());
+
         result = m_rt_midi->api_init_out();
     }
     catch (const rterror & err)
@@ -322,7 +370,12 @@ midibus::api_init_in ()
     try
     {
         if (is_nullptr(m_rt_midi))
-            m_rt_midi = new rtmidi_in(*this, master_info());
+        {
+            if (m_rtp_peer)
+                m_rt_midi = new rtmidi_in(*this, master_info(), m_rtp_peer);
+            else
+                m_rt_midi = new rtmidi_in(*this, master_info());
+        }
 
         result = good_api();
         if (result)
@@ -410,6 +463,20 @@ midibus::api_play (const event * e24, midibyte channel)
         m_rt_midi->api_play(e24, channel);
 }
 
+void
+midibus::api_play_batch (const batchevent * evs, int count)
+{
+    if (good_api())
+        m_rt_midi->api_play_batch(evs, count);
+}
+
+void
+midibus::api_retract (midibyte tag)
+{
+    if (good_api())
+        m_rt_midi->api_retract(tag);
+}
+
 void
 midibus::api_sysex (const event * e24)
 {
@@ -417,6 +484,34 @@ midibus::api_sysex (const event * e24)
         m_rt_midi->api_sysex(e24);
 }
 
+void
+midibus::api_sysex_chunk (const midibyte * data, int len)
+{
+    if (good_api())
+        m_rt_midi->api_sysex_chunk(data, len);
+}
+
+bool
+midibus::api_buffer_stats (int & size, int & highwater, int & dropped)
+{
+    return good_api() ?
+        m_rt_midi->api_buffer_stats(size, highwater, dropped) : false ;
+}
+
+/**
+ *  Connects the existing port to the system port given by the buss and port
+ *  IDs, after the system port went away and came back.
+ *
+ * \return
+ *      Returns true if the connection was made.
+ */
+
+bool
+midibus::api_reconnect ()
+{
+    return good_api() ? m_rt_midi->api_reconnect() : false ;
+}
+
 /**
  *  Continue from the given tick.  This function implements only the
  *  RtMidi-specific code.
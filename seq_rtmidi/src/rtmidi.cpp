@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2025-02-02
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  An abstract base class for realtime MIDI input/output.
@@ -57,6 +57,9 @@
 #include "midi_alsa.hpp"
 #endif
 
+#include "midi_null.hpp"                /* seq66::midi_in/out_null, always  */
+#include "midi_rtp.hpp"                 /* seq66::midi_rtp, network busses  */
+
 /*
  * Do not document the namespace; it breaks Doxygen.
  */
@@ -192,6 +195,30 @@ rtmidi_in::rtmidi_in (midibus & parentbus, rtmidi_info & info) :
     }
 }
 
+/**
+ *  Network-buss constructor.  The API is always midi_rtp, whatever the
+ *  selected API.
+ *
+ * \param parentbus
+ *      The network buss.
+ *
+ * \param info
+ *      The master information object of the selected API.
+ *
+ * \param peer
+ *      The peer whose input this is.
+ */
+
+rtmidi_in::rtmidi_in
+(
+    midibus & parentbus, rtmidi_info & info,
+    std::shared_ptr<rtp_peer> peer
+) :
+    rtmidi   (parentbus, info)
+{
+    set_api(new midi_rtp(parentbus, *(info.get_api_info()), peer));
+}
+
 /**
  *  A do-nothing virtual destructor.
  */
@@ -295,6 +322,18 @@ rtmidi_in::openmidi_api (rtmidi_api api, rtmidi_info & info)
             }
 #endif
         }
+        else if (api == rtmidi_api::null)
+        {
+            midi_in_null * minp = new (std::nothrow) midi_in_null
+            (
+                parent_bus(), midiinfo
+            );
+            if (not_nullptr(minp))
+            {
+                set_api(minp);
+                got_an_api = true;
+            }
+        }
     }
     if (! got_an_api)
     {
@@ -374,6 +413,30 @@ rtmidi_out::rtmidi_out (midibus & parentbus, rtmidi_info & info) :
     }
 }
 
+/**
+ *  Network-buss constructor.  The API is always midi_rtp, whatever the
+ *  selected API.
+ *
+ * \param parentbus
+ *      The network buss.
+ *
+ * \param info
+ *      The master information object of the selected API.
+ *
+ * \param peer
+ *      The peer this output sends to.
+ */
+
+rtmidi_out::rtmidi_out
+(
+    midibus & parentbus, rtmidi_info & info,
+    std::shared_ptr<rtp_peer> peer
+) :
+    rtmidi   (parentbus, info)
+{
+    set_api(new midi_rtp(parentbus, *(info.get_api_info()), peer));
+}
+
 /**
  *  A do-nothing virtual destructor.
  */
@@ -478,6 +541,18 @@ rtmidi_out::openmidi_api (rtmidi_api api, rtmidi_info & info)
             }
 #endif
         }
+        else if (api == rtmidi_api::null)
+        {
+            midi_out_null * monp = new (std::nothrow) midi_out_null
+            (
+                parent_bus(), midiinfo
+            );
+            if (not_nullptr(monp))
+            {
+                set_api(monp);
+                got_an_api = true;
+            }
+        }
     }
     if (! got_an_api)
     {
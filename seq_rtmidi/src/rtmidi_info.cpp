@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-08
- * \updates       2025-01-20
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  An abstract base class for realtime MIDI input/output.  This class
@@ -46,6 +46,8 @@
 #include "midi_jack_info.hpp"
 #endif
 
+#include "midi_null_info.hpp"           /* seq66::midi_null_info, always    */
+
 /*
  * Do not document the namespace; it breaks Doxygen.
  */
@@ -59,6 +61,41 @@ namespace seq66
 
 rtmidi_api rtmidi_info::sm_selected_api = rtmidi_api::unspecified;
 
+namespace
+{
+
+/**
+ *  The names of the APIs saved as "last-midi-api" in the 'rc' file.  An
+ *  empty name is unspecified.
+ */
+
+std::string
+api_tag (rtmidi_api api)
+{
+    switch (api)
+    {
+    case rtmidi_api::alsa:  return "alsa";
+    case rtmidi_api::jack:  return "jack";
+    case rtmidi_api::null:  return "null";
+    default:                return "";
+    }
+}
+
+/**
+ *  Notes the API that worked in the 'rc' settings, so that the next run
+ *  tries it first.
+ */
+
+void
+remember_api (rtmidi_api api)
+{
+    std::string name = api_tag(api);
+    if (name != rc().last_midi_api())
+        rc().last_midi_api(name);
+}
+
+}           // namespace (anonymous)
+
 /**
  *  This is a static function to replace the midi_api version.
  */
@@ -135,6 +172,7 @@ rtmidi_info::rtmidi_info
                 if (get_all_port_info() >= 0)
                 {
                     selected_api(api);              /* log API that worked  */
+                    remember_api(api);
                     return;
                 }
             }
@@ -145,10 +183,29 @@ rtmidi_info::rtmidi_info
         }
     }
 
+    /*
+     * The API that worked at the last run, if any, is tried first, and the
+     * API that just failed is not tried again.
+     */
+
     rtmidi_api_list apis;
     get_compiled_api(apis);
+    const std::string & lastname = rc().last_midi_api();
+    for (unsigned i = 1; i < apis.size(); ++i)
+    {
+        if (! lastname.empty() && api_tag(apis[i]) == lastname)
+        {
+            rtmidi_api last = apis[i];
+            apis.erase(apis.begin() + i);
+            apis.insert(apis.begin(), last);
+            break;
+        }
+    }
     for (unsigned i = 0; i < apis.size(); ++i)
     {
+        if (apis[i] == api)
+            continue;
+
         if (openmidi_api(apis[i], appname, ppqn, bpm)) // get_api_info()
         {
             /*
@@ -161,6 +218,7 @@ rtmidi_info::rtmidi_info
                 if (get_all_port_info() >= 0)
                 {
                     selected_api(apis[i]);          /* log API that worked  */
+                    remember_api(apis[i]);
                     break;
                 }
             }
@@ -286,6 +344,16 @@ rtmidi_info::openmidi_api
     }
 #endif
 
+    if (api == rtmidi_api::null)
+    {
+        midi_null_info * mnip = new (std::nothrow) midi_null_info
+        (
+            appname, ppqn, bpm
+        );
+        result = not_nullptr(mnip);
+        if (result)
+            result = set_api_info(mnip);
+    }
     return result;
 }
 
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-12-01
- * \updates       2023-12-03
+ * \updates       2026-10-14
  * \license       See above.
  *
  *  Provides some basic types for the (heavily-factored) rtmidi library, very
@@ -32,6 +32,7 @@
  */
 
 #include <cstring>                      /* std::memcpy()                    */
+#include <utility>                      /* std::move()                      */
 
 #include "rtmidi_types.hpp"             /* seq66::rtmidi, etc.              */
 #include "util/basic_macros.hpp"        /* errprintfunc() macro, etc.       */
@@ -64,7 +65,9 @@ midi_message::midi_message (midipulse ts) :
     m_msg_number    (sm_msg_number++),
     m_msg_send_time (0),
 #endif
-    m_bytes         (),
+    m_inline_bytes  (),
+    m_heap_bytes    (),
+    m_byte_count    (0),
     m_timestamp     (ts),
     m_input_buss    (null_buss())
 {
@@ -86,12 +89,75 @@ midi_message::midi_message (const midibyte * mbs, std::size_t sz) :
 #if defined SEQ66_SHOW_TIMING
     m_msg_number    (sm_msg_number++),
 #endif
-    m_bytes         (),
+    m_inline_bytes  (),
+    m_heap_bytes    (),
+    m_byte_count    (0),
     m_timestamp     (0),
     m_input_buss    (null_buss())
 {
-    for (std::size_t i = 0; i < sz; ++i)
-        m_bytes.push_back(*mbs++);
+    push(mbs, sz);
+}
+
+/**
+ *  Appends a block of bytes at once, such as a SysEx message or a chunk of
+ *  one, instead of a byte at a time.
+ *
+ * \param mbs
+ *      Provides the bytes.
+ *
+ * \param sz
+ *      The number of bytes.
+ */
+
+void
+midi_message::push (const midibyte * mbs, std::size_t sz)
+{
+    const std::size_t inlinesize = std::size_t(c_midi_message_inline);
+    std::size_t total = m_byte_count + sz;
+    if (sz == 0)
+        return;
+
+    if (total <= inlinesize)
+    {
+        std::memcpy(&m_inline_bytes[m_byte_count], mbs, sz);
+    }
+    else
+    {
+        if (m_byte_count <= inlinesize)             /* move them to heap    */
+        {
+            m_heap_bytes.reserve(total);
+            m_heap_bytes.assign
+            (
+                &m_inline_bytes[0], &m_inline_bytes[0] + m_byte_count
+            );
+        }
+        m_heap_bytes.insert(m_heap_bytes.end(), mbs, mbs + sz);
+    }
+    m_byte_count = total;
+}
+
+/**
+ *  Called by push() when the inline buffer is full.  On the first call, the
+ *  inline bytes are moved to the heap container, which then holds all of
+ *  the bytes.  Only long SysEx messages get here, so the allocation does
+ *  not affect normal note traffic.
+ *
+ * \param b
+ *      The byte to append.
+ */
+
+void
+midi_message::spill (midibyte b)
+{
+    if (m_byte_count == std::size_t(c_midi_message_inline))
+    {
+        m_heap_bytes.reserve(std::size_t(c_midi_message_inline) * 4);
+        m_heap_bytes.assign
+        (
+            &m_inline_bytes[0], &m_inline_bytes[c_midi_message_inline]
+        );
+    }
+    m_heap_bytes.push_back(b);
 }
 
 /**
@@ -123,11 +189,11 @@ midi_message::to_string () const
         if (i == 0)
         {
             char temp[8];
-            snprintf(temp, sizeof temp, "0x%2x", m_bytes[i]);
+            snprintf(temp, sizeof temp, "0x%2x", bytes()[i]);
             result += temp;
         }
         else
-            result += std::to_string(m_bytes[i]);
+            result += std::to_string(bytes()[i]);
     }
     return result;
 }
@@ -219,6 +285,26 @@ midi_queue::add (const midi_message & mmsg)
     return result;
 }
 
+/**
+ *  Adds a message the caller is done with, moving its bytes, if they are
+ *  on the heap, instead of copying them.
+ */
+
+bool
+midi_queue::add (midi_message && mmsg)
+{
+    bool result = ! full();
+    if (result)
+    {
+        m_ring[m_back++] = std::move(mmsg);
+        if (m_back == m_ring_size)
+            m_back = 0;
+
+        ++m_size;
+    }
+    return result;
+}
+
 /**
  *  Pops, so to speak, the front message out of the queue, effectively
  *  throwing it away.  One useful call sequence is:
@@ -241,10 +327,9 @@ midi_queue::pop ()
 }
 
 /**
- *  Pops a copy of the front message.   Could be a little inefficient, since a
- *  couple of copies are made, and we cannot use return-code optimization.
- *
- *  Perhaps at some point we could use move semantics?
+ *  Pops the front message.  Its bytes are moved out, not copied, so that a
+ *  large SysEx message is not copied again; the emptied slot is refilled
+ *  by assignment in add().
  *
  * \return
  *      Returns a copy of the message that was in front before the popping.
@@ -258,7 +343,7 @@ midi_queue::pop_front ()
     midi_message result;
     if (m_size != 0)
     {
-        result = m_ring[m_front];
+        result = std::move(m_ring[m_front]);
         pop();
     }
     return result;
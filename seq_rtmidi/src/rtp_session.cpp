@@ -0,0 +1,1829 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          rtp_session.cpp
+ *
+ *  This module defines the network MIDI (RTP-MIDI, AppleMIDI) sessions
+ *  behind the network busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-14
+ * \updates       2026-10-14
+ * \license       GNU GPLv2 or above
+ *
+ *  All the numbers on the wire are big-endian.  The AppleMIDI session
+ *  commands start with 0xFFFF and two letters; anything else that comes to
+ *  the data port is an RTP packet (RFC 3550) with a MIDI payload (RFC 6295):
+ *
+\verbatim
+        V=2, PT=0x61, sequence, timestamp (10 kHz), SSRC    12 bytes
+        B J Z P LEN, then LEN bytes of commands             1 or 2 bytes
+        recovery journal, if J                              the rest
+\endverbatim
+ *
+ *  Seq66 sends each command with its status byte, and, after the first,
+ *  with a delta time from the one before, so that the events of a frame
+ *  keep their spacing.  If the buss's output filter has a "running" stage,
+ *  a channel command with the status of the one before it in the packet
+ *  leaves the status out.  The first command of a packet always has its
+ *  status, so the P flag is never needed.  It takes running status and the
+ *  other optional codings from a peer.
+ */
+
+#include <cstdlib>                      /* std::atoi()                      */
+#include <cstring>                      /* std::memset(), std::memcpy()     */
+#include <random>                       /* std::random_device               */
+
+#include <arpa/inet.h>                  /* htons(), htonl()                 */
+#include <fcntl.h>                      /* fcntl(), O_NONBLOCK              */
+#include <netdb.h>                      /* getaddrinfo(), freeaddrinfo()    */
+#include <poll.h>                       /* poll(), struct pollfd            */
+#include <sys/socket.h>                 /* socket(), bind(), sendto()       */
+#include <unistd.h>                     /* close()                          */
+
+#include "midi/event.hpp"               /* seq66::event status macros       */
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "rtp_session.hpp"              /* seq66::rtp_network, rtp_peer     */
+#include "util/basic_macros.hpp"        /* seq66::info_message(), etc.      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The RTP payload type used for MIDI by AppleMIDI, and the AppleMIDI
+ *  protocol version.
+ */
+
+static const midibyte c_payload_type    = 0x61;
+static const std::uint32_t c_version    = 2;
+
+/**
+ *  Session timing, in microseconds:  the wait for an answer to an
+ *  invitation, the number of tries, and the rest before the next round;
+ *  the first few clock synchronizations, then the usual ones; the receiver
+ *  feedback; and the silence after which the peer is taken as gone.
+ */
+
+static const long c_invite_us           =  1000000;
+static const int c_invite_tries         = 12;
+static const long c_invite_rest_us      = 10000000;
+static const long c_sync_fast_us        =  1500000;
+static const int c_sync_fast_count      = 6;
+static const long c_sync_us             = 10000000;
+static const long c_feedback_us         =  1000000;
+static const long c_timeout_us          = 60000000;
+
+/**
+ *  The network thread's poll timeout, in milliseconds.  The data wakes it
+ *  sooner.
+ */
+
+static const int c_poll_ms              = 100;
+
+/**
+ *  The most bytes of commands put in one packet; more are sent in another.
+ *  Also the most a SysEx chunk needs.  And the largest datagram read.
+ */
+
+static const std::size_t c_commands_max = 1000;
+static const std::size_t c_datagram_max = 65536;
+
+/**
+ *  The checkpoint is at most this many packets back, even if the peer
+ *  never gives receiver feedback, to bound the journal.
+ */
+
+static const int c_journal_window       = 256;
+
+/**
+ *  Incoming events are not held longer than this, in microseconds, however
+ *  far ahead their timestamps are.  And the most events queued.
+ */
+
+static const long c_hold_max_us         = 100000;
+static const std::size_t c_inbox_max    = 4096;
+
+/*
+ * Helpers for the wire format.
+ */
+
+static bool
+seq_after (std::uint16_t a, std::uint16_t b)
+{
+    return std::int16_t(std::uint16_t(a - b)) > 0;
+}
+
+static void
+put16 (std::vector<midibyte> & v, unsigned x)
+{
+    v.push_back(midibyte((x >> 8) & 0xFF));
+    v.push_back(midibyte(x & 0xFF));
+}
+
+static void
+put32 (std::vector<midibyte> & v, std::uint32_t x)
+{
+    put16(v, unsigned(x >> 16));
+    put16(v, unsigned(x & 0xFFFF));
+}
+
+static void
+put64 (std::vector<midibyte> & v, std::uint64_t x)
+{
+    put32(v, std::uint32_t(x >> 32));
+    put32(v, std::uint32_t(x & 0xFFFFFFFF));
+}
+
+static std::uint32_t
+get16 (const midibyte * p)
+{
+    return (std::uint32_t(p[0]) << 8) | std::uint32_t(p[1]);
+}
+
+static std::uint32_t
+get32 (const midibyte * p)
+{
+    return (get16(p) << 16) | get16(p + 2);
+}
+
+static std::uint64_t
+get64 (const midibyte * p)
+{
+    return (std::uint64_t(get32(p)) << 32) | std::uint64_t(get32(p + 4));
+}
+
+/**
+ *  Appends a delta time, coded as in a MIDI file, 7 bits to a byte, with
+ *  the high bit set on all but the last.  At most 4 bytes.
+ */
+
+static void
+put_delta (std::vector<midibyte> & v, std::uint32_t delta)
+{
+    if (delta > 0x0FFFFFFF)
+        delta = 0x0FFFFFFF;
+
+    midibyte bytes[4];
+    int n = 0;
+    do
+    {
+        bytes[n++] = midibyte(delta & 0x7F);
+        delta >>= 7;
+    } while (delta > 0);
+    while (n > 1)
+        v.push_back(midibyte(bytes[--n] | 0x80));
+
+    v.push_back(bytes[0]);
+}
+
+/**
+ * \return
+ *      Returns the number of data bytes after a channel or system status,
+ *      or -1 for the SysEx statuses, which run to an end marker.
+ */
+
+static int
+data_bytes (midibyte status)
+{
+    if (status < 0xF0)
+    {
+        midibyte code = status & 0xF0;
+        return (code == 0xC0 || code == 0xD0) ? 1 : 2 ;
+    }
+    else if (status == 0xF0 || status == 0xF7)
+        return (-1);
+    else if (status == 0xF1 || status == 0xF3)
+        return 1;
+    else if (status == 0xF2)
+        return 2;
+
+    return 0;
+}
+
+/**
+ * \return
+ *      Returns a random, non-zero, identifier, for an SSRC, a token, or the
+ *      first sequence number.
+ */
+
+static std::uint32_t
+random_id ()
+{
+    std::random_device rd;
+    std::uint32_t result = std::uint32_t(rd());
+    return result != 0 ? result : 1 ;
+}
+
+/*
+ * rtp_journal section
+ */
+
+rtp_journal::rtp_journal () :
+    m_channels  ()
+{
+    clear();
+}
+
+void
+rtp_journal::clear ()
+{
+    for (auto & c : m_channels)
+    {
+        for (int n = 0; n < 128; ++n)
+        {
+            c.ch_velocity[n] = 0;
+            c.ch_note_seq[n] = 0;
+            c.ch_note_new[n] = false;
+            c.ch_control[n] = 0xFF;                 /* not yet known        */
+            c.ch_control_seq[n] = 0;
+            c.ch_control_new[n] = false;
+        }
+        c.ch_program = c.ch_bank_msb = c.ch_bank_lsb = (-1);
+        c.ch_program_seq = 0;
+        c.ch_program_new = false;
+        c.ch_pitch = (-1);
+        c.ch_pitch_seq = 0;
+        c.ch_pitch_new = false;
+    }
+}
+
+/**
+ *  Records a channel message in the state of its channel.
+ *
+ * \param msg
+ *      The message, with its status byte.  Only channel messages count.
+ *
+ * \param len
+ *      The length of the message.
+ *
+ * \param seq
+ *      The sequence number of the packet that carries it.
+ */
+
+void
+rtp_journal::update (const midibyte * msg, int len, std::uint16_t seq)
+{
+    if (len < 2 || msg[0] < 0x80 || msg[0] >= 0xF0)
+        return;
+
+    channel & c = m_channels[msg[0] & 0x0F];
+    midibyte code = msg[0] & 0xF0;
+    midibyte d0 = msg[1] & 0x7F;
+    midibyte d1 = len > 2 ? (msg[2] & 0x7F) : 0 ;
+    switch (code)
+    {
+    case EVENT_NOTE_OFF:
+    case EVENT_NOTE_ON:
+
+        c.ch_velocity[d0] = code == EVENT_NOTE_ON ? d1 : 0 ;
+        c.ch_note_seq[d0] = seq;
+        c.ch_note_new[d0] = true;
+        break;
+
+    case EVENT_CONTROL_CHANGE:
+
+        c.ch_control[d0] = d1;
+        c.ch_control_seq[d0] = seq;
+        c.ch_control_new[d0] = true;
+        if (d0 == 0)
+            c.ch_bank_msb = d1;
+        else if (d0 == 32)
+            c.ch_bank_lsb = d1;
+        else if (d0 == 120 || d0 == 123)            /* sound/notes off      */
+        {
+            for (int n = 0; n < 128; ++n)
+            {
+                if (c.ch_velocity[n] > 0)
+                {
+                    c.ch_velocity[n] = 0;
+                    c.ch_note_seq[n] = seq;
+                    c.ch_note_new[n] = true;
+                }
+            }
+        }
+        break;
+
+    case EVENT_PROGRAM_CHANGE:
+
+        c.ch_program = d0;
+        c.ch_program_seq = seq;
+        c.ch_program_new = true;
+        break;
+
+    case EVENT_PITCH_WHEEL:
+
+        c.ch_pitch = int(d0) | (int(d1) << 7);
+        c.ch_pitch_seq = seq;
+        c.ch_pitch_new = true;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ *  Appends the recovery journal of the state changed after the checkpoint.
+ *  Items not changed since then are dropped from the journal for good.
+ *  The S bits are all zero, so that a receiver always reads the whole
+ *  journal.  The chapters are in the order of the table of contents:  P,
+ *  C, W, N.  Each channel journal is at most 3 + 3 + 257 + 2 + 270 bytes,
+ *  within its 10-bit length.
+ *
+ * \param [out] out
+ *      The packet to append the journal to.
+ *
+ * \param checkpoint
+ *      The sequence number of the checkpoint packet.
+ */
+
+void
+rtp_journal::encode (std::vector<midibyte> & out, std::uint16_t checkpoint)
+{
+    std::size_t head = out.size();
+    out.push_back(0);
+    put16(out, checkpoint);
+
+    int channels = 0;
+    for (int ch = 0; ch < 16; ++ch)
+    {
+        channel & c = m_channels[ch];
+        if (c.ch_program_new && ! seq_after(c.ch_program_seq, checkpoint))
+            c.ch_program_new = false;
+
+        if (c.ch_pitch_new && ! seq_after(c.ch_pitch_seq, checkpoint))
+            c.ch_pitch_new = false;
+
+        int controls = 0, logs = 0, offlow = 128, offhigh = -1;
+        for (int n = 0; n < 128; ++n)
+        {
+            if (c.ch_control_new[n])
+            {
+                if (seq_after(c.ch_control_seq[n], checkpoint))
+                    ++controls;
+                else
+                    c.ch_control_new[n] = false;
+            }
+            if (c.ch_note_new[n])
+            {
+                if (! seq_after(c.ch_note_seq[n], checkpoint))
+                    c.ch_note_new[n] = false;
+                else if (c.ch_velocity[n] > 0)
+                    ++logs;
+                else
+                {
+                    if (n < offlow)
+                        offlow = n;
+
+                    offhigh = n;
+                }
+            }
+        }
+        if (logs > 127)
+            logs = 127;
+
+        bool offs = offhigh >= 0;
+        bool notes = logs > 0 || offs;
+        if (! c.ch_program_new && controls == 0 && ! c.ch_pitch_new && ! notes)
+            continue;
+
+        std::size_t chead = out.size();
+        out.push_back(0);
+        out.push_back(0);
+        out.push_back(0);
+
+        midibyte toc = 0;
+        if (c.ch_program_new)                           /* chapter P        */
+        {
+            toc |= 0x80;
+            out.push_back(midibyte(c.ch_program & 0x7F));
+            out.push_back
+            (
+                c.ch_bank_msb >= 0 ? midibyte(0x80 | c.ch_bank_msb) : 0
+            );
+            out.push_back(c.ch_bank_lsb >= 0 ? midibyte(c.ch_bank_lsb) : 0);
+        }
+        if (controls > 0)                               /* chapter C        */
+        {
+            toc |= 0x40;
+            out.push_back(midibyte(controls - 1));
+            for (int n = 0; n < 128; ++n)
+            {
+                if (c.ch_control_new[n])
+                {
+                    out.push_back(midibyte(n));
+                    out.push_back(c.ch_control[n]);     /* A = 0, a value   */
+                }
+            }
+        }
+        if (c.ch_pitch_new)                             /* chapter W        */
+        {
+            toc |= 0x10;
+            out.push_back(midibyte(c.ch_pitch & 0x7F));
+            out.push_back(midibyte((c.ch_pitch >> 7) & 0x7F));
+        }
+        if (notes)                                      /* chapter N        */
+        {
+            int low = offs ? offlow / 8 : 15 ;
+            int high = offs ? offhigh / 8 : (logs == 127 ? 1 : 0) ;
+            toc |= 0x08;
+            out.push_back(midibyte(logs));
+            out.push_back(midibyte((low << 4) | high));
+
+            int count = 0;
+            for (int n = 0; n < 128 && count < logs; ++n)
+            {
+                if (c.ch_note_new[n] && c.ch_velocity[n] > 0)
+                {
+                    out.push_back(midibyte(n));
+                    out.push_back(midibyte(0x80 | c.ch_velocity[n]));
+                    ++count;
+                }
+            }
+            for (int b = low; offs && b <= high; ++b)
+            {
+                midibyte bits = 0;
+                for (int i = 0; i < 8; ++i)
+                {
+                    int n = b * 8 + i;
+                    if (c.ch_note_new[n] && c.ch_velocity[n] == 0)
+                        bits |= midibyte(0x80 >> i);
+                }
+                out.push_back(bits);
+            }
+        }
+
+        std::size_t length = out.size() - chead;
+        out[chead] = midibyte((ch << 3) | ((length >> 8) & 0x03));
+        out[chead + 1] = midibyte(length & 0xFF);
+        out[chead + 2] = toc;
+        ++channels;
+    }
+    if (channels > 0)
+        out[head] = midibyte(0x20 | (channels - 1));    /* A, TOTCHAN       */
+}
+
+/**
+ *  Compares a recovery journal to the state, after a gap in the packets,
+ *  and makes the messages that bring the state up to date.  The system
+ *  journal, and the chapters not understood, are skipped.
+ *
+ * \param journal
+ *      The start of the journal.
+ *
+ * \param len
+ *      Its length.
+ *
+ * \param [out] fixes
+ *      The messages to play.  They are also applied to the state.
+ *
+ * \return
+ *      Returns false if the journal is malformed.  The fixes found before
+ *      the problem are kept.
+ */
+
+bool
+rtp_journal::recover
+(
+    const midibyte * journal, int len, std::vector<midi_message> & fixes
+)
+{
+    if (len < 3)
+        return false;
+
+    midibyte h = journal[0];
+    int pos = 3;
+    if ((h & 0x40) != 0)                                /* Y, system        */
+    {
+        if (len < pos + 2)
+            return false;
+
+        pos += int(((journal[pos] & 0x03) << 8) | journal[pos + 1]);
+    }
+    if ((h & 0x20) != 0)                                /* A, channels      */
+    {
+        int channels = (h & 0x0F) + 1;
+        for (int i = 0; i < channels; ++i)
+        {
+            if (len < pos + 3)
+                return false;
+
+            const midibyte * p = journal + pos;
+            int ch = (p[0] >> 3) & 0x0F;
+            int length = int(((p[0] & 0x03) << 8) | p[1]);
+            if (length < 3 || len < pos + length)
+                return false;
+
+            recover_channel(ch, p[2], p + 3, length - 3, fixes);
+            pos += length;
+        }
+    }
+    return true;
+}
+
+void
+rtp_journal::recover_channel
+(
+    int ch, midibyte toc, const midibyte * p, int len,
+    std::vector<midi_message> & fixes
+)
+{
+    channel & c = m_channels[ch];
+    midibyte chan = midibyte(ch);
+    int pos = 0;
+    if ((toc & 0x80) != 0)                              /* chapter P        */
+    {
+        if (len < pos + 3)
+            return;
+
+        int program = p[pos] & 0x7F;
+        bool bank = (p[pos + 1] & 0x80) != 0;
+        midibyte msb = p[pos + 1] & 0x7F;
+        midibyte lsb = p[pos + 2] & 0x7F;
+        if (program != c.ch_program)
+        {
+            if (bank)
+            {
+                fix(fixes, EVENT_CONTROL_CHANGE | chan, 0, msb);
+                fix(fixes, EVENT_CONTROL_CHANGE | chan, 32, lsb);
+            }
+            fix(fixes, EVENT_PROGRAM_CHANGE | chan, midibyte(program), 0);
+        }
+        pos += 3;
+    }
+    if ((toc & 0x40) != 0)                              /* chapter C        */
+    {
+        if (len < pos + 1)
+            return;
+
+        int count = (p[pos] & 0x7F) + 1;
+        ++pos;
+        for (int i = 0; i < count && len >= pos + 2; ++i, pos += 2)
+        {
+            midibyte number = p[pos] & 0x7F;
+            bool tool = (p[pos + 1] & 0x80) != 0;       /* toggle or count  */
+            midibyte value = p[pos + 1] & 0x7F;
+            if (! tool && c.ch_control[number] != value)
+                fix(fixes, EVENT_CONTROL_CHANGE | chan, number, value);
+        }
+    }
+    if ((toc & 0x20) != 0)                              /* chapter M, skip  */
+    {
+        if (len < pos + 2)
+            return;
+
+        pos += int(((p[pos] & 0x03) << 8) | p[pos + 1]);
+    }
+    if ((toc & 0x10) != 0)                              /* chapter W        */
+    {
+        if (len < pos + 2)
+            return;
+
+        midibyte first = p[pos] & 0x7F;
+        midibyte second = p[pos + 1] & 0x7F;
+        if (c.ch_pitch != (int(first) | (int(second) << 7)))
+            fix(fixes, EVENT_PITCH_WHEEL | chan, first, second);
+
+        pos += 2;
+    }
+    if ((toc & 0x08) != 0)                              /* chapter N        */
+    {
+        if (len < pos + 2)
+            return;
+
+        int logs = p[pos] & 0x7F;
+        int low = p[pos + 1] >> 4;
+        int high = p[pos + 1] & 0x0F;
+        if (logs == 127 && low == 15 && high == 0)
+            logs = 128;
+
+        pos += 2;
+        for (int i = 0; i < logs && len >= pos + 2; ++i, pos += 2)
+        {
+            midibyte note = p[pos] & 0x7F;
+            midibyte velocity = p[pos + 1] & 0x7F;
+            bool play = (p[pos + 1] & 0x80) != 0;       /* Y, still timely  */
+            if (play && velocity > 0 && c.ch_velocity[note] == 0)
+                fix(fixes, EVENT_NOTE_ON | chan, note, velocity);
+        }
+        for (int b = low; b <= high && len > pos; ++b, ++pos)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                int n = b * 8 + i;
+                if ((p[pos] & (0x80 >> i)) != 0 && c.ch_velocity[n] > 0)
+                    fix(fixes, EVENT_NOTE_OFF | chan, midibyte(n), 0);
+            }
+        }
+    }
+}
+
+void
+rtp_journal::fix
+(
+    std::vector<midi_message> & fixes,
+    midibyte status, midibyte d0, midibyte d1
+)
+{
+    midibyte msg[3] = { status, d0, d1 };
+    int len = data_bytes(status) + 1;
+    update(msg, len, 0);
+    fixes.push_back(midi_message(msg, std::size_t(len)));
+}
+
+/*
+ * rtp_peer section
+ */
+
+rtp_peer::rtp_peer (const std::string & host, int port) :
+    m_name              (host + ":" + std::to_string(port)),
+    m_host              (host),
+    m_port              (port),
+    m_control_addr      (),
+    m_data_addr         (),
+    m_resolved          (false),
+    m_data_fd           (-1),
+    m_ssrc              (0),
+    m_origin_us         (0),
+    m_lookahead_us      (0),
+    m_state             (state::idle),
+    m_token             (0),
+    m_peer_ssrc         (0),
+    m_retry_us          (0),
+    m_tries             (0),
+    m_sync_us           (0),
+    m_syncs             (0),
+    m_heard_us          (0),
+    m_offset            (0),
+    m_synced            (false),
+    m_send_mutex        (),
+    m_commands          (),
+    m_packet            (),
+    m_first_ts          (0),
+    m_last_ts           (0),
+    m_send_status       (0),
+    m_send_seq          (0),
+    m_checkpoint        (0),
+    m_acked             (false),
+    m_send_journal      (),
+    m_recv_journal      (),
+    m_recv_started      (false),
+    m_recv_seq          (0),
+    m_recv_status       (0),
+    m_recv_sysex        (),
+    m_feedback_us       (0),
+    m_recv_mutex        (),
+    m_inbox             (),
+    m_input_buss        (-1),
+    m_packets_sent      (0),
+    m_packets_received  (0),
+    m_packets_lost      (0)
+{
+    m_send_seq = m_checkpoint = std::uint16_t(random_id() & 0xFFFF);
+    m_commands.reserve(c_commands_max + 64);
+}
+
+/**
+ * \return
+ *      Returns the time on our 10 kHz clock.
+ */
+
+std::uint64_t
+rtp_peer::clock_ts () const
+{
+    return std::uint64_t(microtime() - m_origin_us) / 100;
+}
+
+/**
+ *  Adds a command to the packet of the frame.  Called by the output thread.
+ *  Nothing is kept while the peer is not in the session.
+ *
+ * \param msg
+ *      The command, with its status byte; for SysEx, one segment.
+ *
+ * \param len
+ *      The length of the command.
+ *
+ * \param ts
+ *      The time, on our 10 kHz clock, at which it is to sound.  A time
+ *      before that of the command ahead of it is taken as the same.
+ *
+ * \param runstatus
+ *      If true, a channel command with the same status as the one before
+ *      it in the packet is added without its status byte.  System Common
+ *      and SysEx commands end the running status; System Realtime ones do
+ *      not.
+ */
+
+void
+rtp_peer::append
+(
+    const midibyte * msg, int len, std::uint64_t ts, bool runstatus
+)
+{
+    if (! connected() || len <= 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    if (m_commands.size() + std::size_t(len) + 4 > c_commands_max)
+        send_packet();
+
+    if (m_commands.empty())
+    {
+        m_first_ts = m_last_ts = ts;
+    }
+    else
+    {
+        if (ts < m_last_ts)
+            ts = m_last_ts;
+
+        put_delta(m_commands, std::uint32_t(ts - m_last_ts));
+        m_last_ts = ts;
+    }
+
+    midibyte status = msg[0];
+    bool runs = runstatus && status < 0xF0 && status == m_send_status;
+    m_commands.insert(m_commands.end(), msg + (runs ? 1 : 0), msg + len);
+    if (status < 0xF0)
+        m_send_status = status;
+    else if (status < 0xF8)
+        m_send_status = 0;                              /* system common    */
+}
+
+/**
+ *  Sends the packet of the frame, if it has any commands.
+ */
+
+void
+rtp_peer::flush ()
+{
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    send_packet();
+}
+
+/**
+ *  Builds and sends the packet of the commands gathered, with the journal
+ *  of the state before them, and then adds them to the state, following
+ *  any running status.  Called with the send mutex locked.
+ */
+
+void
+rtp_peer::send_packet ()
+{
+    if (m_commands.empty())
+        return;
+
+    if (m_data_fd >= 0 && connected())
+    {
+        std::uint16_t seq = ++m_send_seq;
+        if (seq_after(std::uint16_t(seq - c_journal_window), m_checkpoint))
+            m_checkpoint = std::uint16_t(seq - c_journal_window);
+
+        std::size_t len = m_commands.size();
+        m_packet.clear();
+        m_packet.push_back(0x80);                       /* V = 2            */
+        m_packet.push_back(c_payload_type);
+        put16(m_packet, seq);
+        put32(m_packet, std::uint32_t(m_first_ts & 0xFFFFFFFF));
+        put32(m_packet, m_ssrc);
+        if (len <= 15)
+            m_packet.push_back(midibyte(0x40 | len));   /* J, short LEN     */
+        else
+            put16(m_packet, unsigned(0xC000 | (len & 0x0FFF)));
+
+        m_packet.insert(m_packet.end(), m_commands.begin(), m_commands.end());
+        m_send_journal.encode(m_packet, m_checkpoint);
+        (void) sendto
+        (
+            m_data_fd, m_packet.data(), m_packet.size(), 0,
+            reinterpret_cast<const sockaddr *>(&m_data_addr),
+            sizeof m_data_addr
+        );
+        ++m_packets_sent;
+
+        const midibyte * p = m_commands.data();
+        std::size_t pos = 0;
+        midibyte running = 0;
+        bool first = true;
+        while (pos < len)                               /* to the journal   */
+        {
+            if (! first)
+            {
+                while (pos < len && (p[pos] & 0x80) != 0)
+                    ++pos;
+
+                ++pos;                                  /* last delta byte  */
+            }
+            first = false;
+            if (pos >= len)
+                break;
+
+            midibyte status = p[pos];
+            bool runs = status < 0x80;
+            if (runs)
+            {
+                if (running == 0)
+                    break;                              /* cannot happen    */
+
+                status = running;
+            }
+
+            int count = data_bytes(status);
+            std::size_t n = runs ? 0 : 1 ;
+            if (count < 0)
+            {
+                while (pos + n < len && p[pos + n] != 0xF7 &&
+                        p[pos + n] != 0xF0)
+                    ++n;
+
+                ++n;
+                if (pos + n > len)
+                    break;
+
+                m_send_journal.update(p + pos, int(n), seq);
+                running = 0;
+            }
+            else
+            {
+                n += std::size_t(count);
+                if (pos + n > len)
+                    break;
+
+                midibyte msg[3] = { status, 0, 0 };
+                for (int i = 0; i < count; ++i)
+                    msg[i + 1] = p[pos + n - count + i];
+
+                m_send_journal.update(msg, count + 1, seq);
+                if (status < 0xF0)
+                    running = status;
+                else if (status < 0xF8)
+                    running = 0;
+            }
+            pos += n;
+        }
+    }
+    m_commands.clear();
+    m_send_status = 0;                  /* a packet starts with a status    */
+}
+
+/**
+ *  Takes the peer's receiver feedback, the last packet it got, which moves
+ *  the checkpoint up.
+ */
+
+void
+rtp_peer::take_feedback (std::uint16_t seq)
+{
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    if (seq_after(seq, m_checkpoint) && ! seq_after(seq, m_send_seq))
+    {
+        m_checkpoint = seq;
+        m_acked = true;
+    }
+}
+
+/**
+ *  Forgets the session, for a goodbye, a time-out, or a new invitation.
+ *  The send journal is kept; the checkpoint moves to the last packet sent,
+ *  since the peer starts again.
+ */
+
+void
+rtp_peer::reset_session ()
+{
+    m_state = state::idle;
+    m_synced = false;
+    m_syncs = 0;
+    m_recv_started = false;
+    m_recv_status = 0;
+    m_recv_sysex.clear();
+    m_recv_journal.clear();
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    m_commands.clear();
+    m_send_status = 0;
+    m_checkpoint = m_send_seq;
+    m_acked = false;
+}
+
+/**
+ *  Handles an RTP-MIDI packet from the peer.  A gap in the sequence numbers
+ *  is made good from the journal first, at once, since the journal gives
+ *  the state before this packet.  Then the commands are queued at their
+ *  time, which is their timestamp on the peer's clock, brought to ours.
+ *
+ * \param p
+ *      The packet.
+ *
+ * \param len
+ *      Its length.
+ *
+ * \param now
+ *      The time it was read, in microtime().
+ */
+
+void
+rtp_peer::receive_packet (const midibyte * p, int len, long now)
+{
+    if (len < 13 || (p[0] >> 6) != 2)
+        return;
+
+    int pos = 12 + 4 * (p[0] & 0x0F);                   /* CSRC list        */
+    if ((p[0] & 0x10) != 0)                             /* extension        */
+    {
+        if (len < pos + 4)
+            return;
+
+        pos += 4 + 4 * int(get16(p + pos + 2));
+    }
+    if (len <= pos)
+        return;
+
+    std::uint16_t seq = std::uint16_t(get16(p + 2));
+    std::uint32_t ts = get32(p + 4);
+    int lost = 0;
+    if (m_recv_started)
+    {
+        int delta = std::int16_t(std::uint16_t(seq - m_recv_seq));
+        if (delta <= 0)
+            return;                                     /* late duplicate   */
+
+        lost = delta - 1;
+    }
+    m_recv_started = true;
+    m_recv_seq = seq;
+    ++m_packets_received;
+
+    midibyte h = p[pos];
+    int clen = h & 0x0F;
+    if ((h & 0x80) != 0)
+    {
+        if (len < pos + 2)
+            return;
+
+        clen = (clen << 8) | p[pos + 1];
+        pos += 2;
+    }
+    else
+        ++pos;
+
+    int end = pos + clen;
+    if (end > len)
+        return;
+
+    if (lost > 0)
+    {
+        m_packets_lost += lost;
+        if ((h & 0x40) != 0)
+        {
+            std::vector<midi_message> fixes;
+            (void) m_recv_journal.recover(p + end, len - end, fixes);
+            for (const auto & mm : fixes)
+                queue_input(mm.event_bytes(), mm.event_count(), now);
+        }
+        m_recv_status = 0;
+    }
+
+    long due = now;
+    if (m_synced)
+    {
+        std::uint64_t peernow = std::uint64_t
+        (
+            std::int64_t(std::uint64_t(now - m_origin_us) / 100) + m_offset
+        );
+        long ahead = long(std::int32_t(ts - std::uint32_t(peernow))) * 100;
+        if (ahead > c_hold_max_us)
+            ahead = c_hold_max_us;
+
+        if (ahead > 0)
+            due += ahead;
+    }
+
+    midibyte running = (h & 0x10) != 0 ? m_recv_status : 0 ;   /* P    */
+    bool first = (h & 0x20) == 0;                       /* Z = 0, no delta  */
+    long delta_us = 0;
+    while (pos < end)
+    {
+        if (! first)
+        {
+            std::uint32_t d = 0;
+            for (int i = 0; i < 4 && pos < end; ++i)
+            {
+                midibyte b = p[pos++];
+                d = (d << 7) | (b & 0x7F);
+                if ((b & 0x80) == 0)
+                    break;
+            }
+            delta_us += long(d) * 100;
+            if (delta_us > c_hold_max_us)
+                delta_us = c_hold_max_us;
+        }
+        first = false;
+        if (pos >= end)
+            break;
+
+        midibyte status = p[pos];
+        int start = pos;
+        bool runs = status < 0x80;
+        if (runs)
+        {
+            if (running == 0)
+                break;                                  /* malformed        */
+
+            status = running;
+        }
+        else
+            ++pos;
+
+        int count = data_bytes(status);
+        if (count < 0)                                  /* SysEx segment    */
+        {
+            while (pos < end && p[pos] != 0xF7 && p[pos] != 0xF0)
+                ++pos;
+
+            if (pos >= end)
+                break;
+
+            midibyte last = p[pos++];
+            running = 0;
+            if (status == 0xF0)
+                m_recv_sysex.clear();
+            else if (m_recv_sysex.empty())
+                continue;                               /* no start seen    */
+
+            m_recv_sysex.insert
+            (
+                m_recv_sysex.end(), p + start + (status == 0xF0 ? 0 : 1),
+                p + pos - 1
+            );
+            if (last == 0xF7)                           /* the last segment */
+            {
+                m_recv_sysex.push_back(0xF7);
+                queue_input
+                (
+                    m_recv_sysex.data(), int(m_recv_sysex.size()),
+                    due + delta_us
+                );
+                m_recv_sysex.clear();
+            }
+            continue;
+        }
+        if (pos + count > end)
+            break;
+
+        midibyte msg[3] = { status, 0, 0 };
+        for (int i = 0; i < count; ++i)
+            msg[i + 1] = p[pos + i];
+
+        pos += count;
+        if (status < 0xF0)
+            running = status;
+        else if (status < 0xF8)
+            running = 0;                                /* system common    */
+
+        m_recv_journal.update(msg, count + 1, seq);
+        queue_input(msg, count + 1, due + delta_us);
+    }
+    m_recv_status = running;
+}
+
+/**
+ *  Queues an incoming message for the input buss, if it is open, at its
+ *  time.  The queue is kept in time order.
+ */
+
+void
+rtp_peer::queue_input (const midibyte * msg, int len, long due)
+{
+    if (m_input_buss < 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_recv_mutex);
+    if (! m_inbox.empty() && due < long(m_inbox.back().timestamp()))
+        due = long(m_inbox.back().timestamp());
+
+    if (m_inbox.size() >= c_inbox_max)
+        m_inbox.pop_front();
+
+    m_inbox.emplace_back(msg, std::size_t(len));
+    m_inbox.back().timestamp(midipulse(due));
+    m_inbox.back().input_buss(bussbyte(m_input_buss));
+}
+
+/**
+ * \param now
+ *      The current microtime().
+ *
+ * \return
+ *      Returns the number of incoming messages whose time has come.
+ */
+
+int
+rtp_peer::pending_input (long now)
+{
+    std::lock_guard<std::mutex> lock(m_recv_mutex);
+    int result = 0;
+    for (const auto & mm : m_inbox)
+    {
+        if (long(mm.timestamp()) > now)
+            break;
+
+        ++result;
+    }
+    return result;
+}
+
+bool
+rtp_peer::pop_input (midi_message & mm, long now)
+{
+    std::lock_guard<std::mutex> lock(m_recv_mutex);
+    bool result = ! m_inbox.empty() && long(m_inbox.front().timestamp()) <= now;
+    if (result)
+    {
+        mm = m_inbox.front();
+        m_inbox.pop_front();
+    }
+    return result;
+}
+
+/*
+ * rtp_network section
+ */
+
+/**
+ *  Makes a peer for each "host" or "host:port" in the list.
+ *
+ * \param peers
+ *      The peers, separated by spaces or commas.
+ *
+ * \param port
+ *      The local control port.
+ *
+ * \param lookaheadms
+ *      The lookahead of the timestamps of outgoing events.
+ */
+
+rtp_network::rtp_network
+(
+    const std::string & peers, int port, int lookaheadms
+) :
+    m_peers         (),
+    m_port          (port),
+    m_control_fd    (-1),
+    m_data_fd       (-1),
+    m_ssrc          (random_id()),
+    m_name          (),
+    m_lookahead_us  (long(lookaheadms) * 1000),
+    m_origin_us     (microtime()),
+    m_running       (false),
+    m_thread        (),
+    m_buffer        (c_datagram_max)
+{
+    std::string::size_type pos = 0;
+    for (;;)
+    {
+        pos = peers.find_first_not_of(" ,\t", pos);
+        if (pos == std::string::npos)
+            break;
+
+        std::string::size_type next = peers.find_first_of(" ,\t", pos);
+        std::string spec = peers.substr(pos, next - pos);
+        std::string host = spec;
+        int peerport = 5004;
+        std::string::size_type colon = spec.find(':');
+        if (colon != std::string::npos)
+        {
+            host = spec.substr(0, colon);
+            peerport = std::atoi(spec.substr(colon + 1).c_str());
+        }
+        if (! host.empty() && peerport > 0 && peerport < 65535)
+            m_peers.emplace_back(std::make_shared<rtp_peer>(host, peerport));
+        else
+            error_message("Bad RTP-MIDI peer", spec);
+
+        if (next == std::string::npos)
+            break;
+
+        pos = next;
+    }
+}
+
+rtp_network::~rtp_network ()
+{
+    stop();
+}
+
+/**
+ * \return
+ *      Returns the time on our 10 kHz clock.
+ */
+
+std::uint64_t
+rtp_network::clock_ts () const
+{
+    return std::uint64_t(microtime() - m_origin_us) / 100;
+}
+
+/**
+ *  Opens the control and data ports, and starts the network thread, which
+ *  invites the peers.
+ *
+ * \param clientname
+ *      The name given to the peers, which they usually show.
+ *
+ * \return
+ *      Returns true if the ports are open.
+ */
+
+bool
+rtp_network::start (const std::string & clientname)
+{
+    if (m_running || m_peers.empty())
+        return m_running;
+
+    m_name = clientname;
+    bool result = open_socket(m_control_fd, m_port);
+    if (result)
+        result = open_socket(m_data_fd, m_port + 1);
+
+    if (result)
+    {
+        for (auto & pr : m_peers)
+        {
+            std::lock_guard<std::mutex> lock(pr->m_send_mutex);
+            pr->m_data_fd = m_data_fd;
+            pr->m_ssrc = m_ssrc;
+            pr->m_origin_us = m_origin_us;
+            pr->m_lookahead_us = m_lookahead_us;
+        }
+        m_running = true;
+        m_thread = std::thread(&rtp_network::net_loop, this);
+        info_message
+        (
+            "RTP-MIDI session on UDP port", std::to_string(m_port)
+        );
+    }
+    else
+    {
+        error_message("Cannot open RTP-MIDI port", std::to_string(m_port));
+        close_sockets();
+    }
+    return result;
+}
+
+/**
+ *  Says goodbye to the peers in the session, stops the network thread, and
+ *  closes the ports.  Logs what was sent and received.
+ */
+
+void
+rtp_network::stop ()
+{
+    if (! m_running)
+        return;
+
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+
+    for (auto & pr : m_peers)
+    {
+        if (pr->connected())
+        {
+            send_command
+            (
+                m_control_fd, pr->m_control_addr, "BY", pr->m_token, false
+            );
+        }
+        {
+            std::lock_guard<std::mutex> lock(pr->m_send_mutex);
+            pr->m_data_fd = -1;
+            pr->m_state = rtp_peer::state::idle;
+        }
+        if (pr->m_packets_sent > 0 || pr->m_packets_received > 0)
+        {
+            msgprintf
+            (
+                msglevel::info, "%s: %ld packets sent, %ld received, "
+                "%ld lost", pr->name().c_str(), long(pr->m_packets_sent),
+                long(pr->m_packets_received), long(pr->m_packets_lost)
+            );
+        }
+    }
+    close_sockets();
+}
+
+/**
+ *  Sends the packet of the frame to each peer that has one.  Called with
+ *  the flush of the output thread.
+ */
+
+void
+rtp_network::flush ()
+{
+    for (auto & pr : m_peers)
+        pr->flush();
+}
+
+bool
+rtp_network::open_socket (int & fd, int port)
+{
+    fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    bool result = fd >= 0;
+    if (result)
+    {
+        int on = 1;
+        (void) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof on);
+
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof addr);
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(std::uint16_t(port));
+        result = ::bind
+        (
+            fd, reinterpret_cast<const sockaddr *>(&addr), sizeof addr
+        ) == 0;
+        if (result)
+        {
+            int flags = ::fcntl(fd, F_GETFL, 0);
+            result = flags >= 0 &&
+                ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+        }
+    }
+    return result;
+}
+
+void
+rtp_network::close_sockets ()
+{
+    if (m_control_fd >= 0)
+    {
+        (void) ::close(m_control_fd);
+        m_control_fd = -1;
+    }
+    if (m_data_fd >= 0)
+    {
+        (void) ::close(m_data_fd);
+        m_data_fd = -1;
+    }
+}
+
+/**
+ *  The network thread.  Reads what comes, and keeps the sessions going.
+ */
+
+void
+rtp_network::net_loop ()
+{
+    pollfd fds[2];
+    fds[0].fd = m_control_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_data_fd;
+    fds[1].events = POLLIN;
+    while (m_running)
+    {
+        fds[0].revents = fds[1].revents = 0;
+
+        int rc = ::poll(fds, 2, c_poll_ms);
+        long now = microtime();
+        if (rc > 0)
+        {
+            if ((fds[0].revents & POLLIN) != 0)
+                read_socket(m_control_fd, true, now);
+
+            if ((fds[1].revents & POLLIN) != 0)
+                read_socket(m_data_fd, false, now);
+        }
+        service(now);
+    }
+}
+
+/**
+ *  Moves each peer's session along:  resolving its host, inviting it,
+ *  synchronizing the clocks, and giving feedback.
+ */
+
+void
+rtp_network::service (long now)
+{
+    for (auto & p : m_peers)
+    {
+        rtp_peer & pr = *p;
+        if (now < pr.m_retry_us && pr.m_state != rtp_peer::state::connected)
+            continue;
+
+        if (! pr.m_resolved)
+        {
+            addrinfo hints;
+            addrinfo * res = nullptr;
+            std::memset(&hints, 0, sizeof hints);
+            hints.ai_family = AF_INET;
+            hints.ai_socktype = SOCK_DGRAM;
+            if (::getaddrinfo(pr.m_host.c_str(), nullptr, &hints, &res) == 0)
+            {
+                std::memcpy
+                (
+                    &pr.m_control_addr, res->ai_addr, sizeof(sockaddr_in)
+                );
+                ::freeaddrinfo(res);
+                pr.m_control_addr.sin_port = htons(std::uint16_t(pr.m_port));
+                pr.m_data_addr = pr.m_control_addr;
+                pr.m_data_addr.sin_port = htons(std::uint16_t(pr.m_port + 1));
+                pr.m_resolved = true;
+            }
+            else
+            {
+                pr.m_retry_us = now + c_invite_rest_us;
+                continue;
+            }
+        }
+        switch (pr.m_state.load())
+        {
+        case rtp_peer::state::idle:
+
+            pr.m_token = random_id();
+            pr.m_state = rtp_peer::state::control;
+            pr.m_tries = 0;
+            send_invitation(pr, true);
+            break;
+
+        case rtp_peer::state::control:
+        case rtp_peer::state::data:
+
+            if (pr.m_tries < c_invite_tries)
+            {
+                send_invitation(pr, pr.m_state == rtp_peer::state::control);
+            }
+            else
+            {
+                pr.m_state = rtp_peer::state::idle;
+                pr.m_retry_us = now + c_invite_rest_us;
+            }
+            break;
+
+        case rtp_peer::state::connected:
+
+            if (now - pr.m_heard_us > c_timeout_us)
+            {
+                warn_message("RTP-MIDI peer timed out", pr.name());
+                pr.reset_session();
+                pr.m_retry_us = now;
+                break;
+            }
+            if (now >= pr.m_sync_us)
+            {
+                send_sync(pr, 0, clock_ts(), 0, 0);
+                long wait = pr.m_syncs < c_sync_fast_count ?
+                    c_sync_fast_us : c_sync_us ;
+
+                pr.m_sync_us = now + wait;
+            }
+            if (pr.m_recv_started && now - pr.m_feedback_us >= c_feedback_us)
+            {
+                send_feedback(pr);
+                pr.m_feedback_us = now;
+            }
+            break;
+        }
+    }
+}
+
+void
+rtp_network::read_socket (int fd, bool iscontrol, long now)
+{
+    for (;;)
+    {
+        sockaddr_in from;
+        socklen_t fromlen = sizeof from;
+        ssize_t n = ::recvfrom
+        (
+            fd, m_buffer.data(), m_buffer.size(), 0,
+            reinterpret_cast<sockaddr *>(&from), &fromlen
+        );
+        if (n < 0)
+            break;                                      /* EAGAIN, drained  */
+
+        const midibyte * p = m_buffer.data();
+        int len = int(n);
+        if (len >= 4 && p[0] == 0xFF && p[1] == 0xFF)
+        {
+            session_command(p, len, from, iscontrol, now);
+        }
+        else if (! iscontrol)
+        {
+            rtp_peer * pr = find_peer(from, false);
+            if (not_nullptr(pr) && pr->connected())
+            {
+                pr->m_heard_us = now;
+                pr->receive_packet(p, len, now);
+            }
+        }
+    }
+}
+
+/**
+ *  Handles an AppleMIDI session command.
+ *
+ * \param p
+ *      The command, starting with 0xFFFF and its two letters.
+ *
+ * \param len
+ *      Its length.
+ *
+ * \param from
+ *      The address it came from.
+ *
+ * \param iscontrol
+ *      True if it came to the control port.
+ *
+ * \param now
+ *      The time it was read, in microtime().
+ */
+
+void
+rtp_network::session_command
+(
+    const midibyte * p, int len, const sockaddr_in & from,
+    bool iscontrol, long now
+)
+{
+    std::string cmd(reinterpret_cast<const char *>(p + 2), 2);
+    if (cmd == "CK")
+    {
+        if (len < 36)
+            return;
+
+        rtp_peer * pr = find_peer(get32(p + 4));
+        if (is_nullptr(pr))
+            return;
+
+        int count = p[8];
+        std::uint64_t ts1 = get64(p + 12);
+        std::uint64_t ts2 = get64(p + 20);
+        std::uint64_t ts3 = get64(p + 28);
+        pr->m_heard_us = now;
+        if (count == 0)                                 /* the peer asks    */
+        {
+            send_sync(*pr, 1, ts1, clock_ts(), 0);
+        }
+        else if (count == 1)                            /* our reply comes  */
+        {
+            ts3 = clock_ts();
+            send_sync(*pr, 2, ts1, ts2, ts3);
+            pr->m_offset = std::int64_t(ts2) - std::int64_t((ts1 + ts3) / 2);
+            pr->m_synced = true;
+            ++pr->m_syncs;
+        }
+        else if (count == 2)                            /* its reply comes  */
+        {
+            pr->m_offset = std::int64_t((ts1 + ts3) / 2) - std::int64_t(ts2);
+            pr->m_synced = true;
+        }
+    }
+    else if (cmd == "RS")
+    {
+        if (len >= 10)
+        {
+            rtp_peer * pr = find_peer(get32(p + 4));
+            if (not_nullptr(pr))
+                pr->take_feedback(std::uint16_t(get16(p + 8)));
+        }
+    }
+    else if (len >= 16)
+    {
+        std::uint32_t token = get32(p + 8);
+        std::uint32_t ssrc = get32(p + 12);
+        rtp_peer * pr = find_peer(from, iscontrol);
+        if (cmd == "IN")                                /* it invites us    */
+        {
+            int fd = iscontrol ? m_control_fd : m_data_fd ;
+            if (is_nullptr(pr))
+            {
+                send_command(fd, from, "NO", token);
+                return;
+            }
+            send_command(fd, from, "OK", token);
+            if (iscontrol)
+            {
+                pr->reset_session();
+                pr->m_control_addr = from;
+                pr->m_token = token;
+                pr->m_state = rtp_peer::state::data;
+                pr->m_tries = c_invite_tries;           /* no invites of ours */
+                pr->m_retry_us = now + c_invite_us;
+            }
+            else
+            {
+                pr->m_data_addr = from;
+                pr->m_peer_ssrc = ssrc;
+                pr->m_heard_us = now;
+                pr->m_sync_us = now + c_sync_us;        /* the peer syncs   */
+                pr->m_state = rtp_peer::state::connected;
+                info_message("RTP-MIDI peer joined", pr->name());
+            }
+        }
+        else if (is_nullptr(pr) || token != pr->m_token)
+        {
+            return;
+        }
+        else if (cmd == "OK")
+        {
+            if (iscontrol && pr->m_state == rtp_peer::state::control)
+            {
+                pr->m_state = rtp_peer::state::data;
+                pr->m_tries = 0;
+                send_invitation(*pr, false);
+                pr->m_retry_us = now + c_invite_us;
+            }
+            else if (! iscontrol && pr->m_state == rtp_peer::state::data)
+            {
+                pr->m_peer_ssrc = ssrc;
+                pr->m_heard_us = now;
+                pr->m_syncs = 0;
+                pr->m_sync_us = now;
+                pr->m_state = rtp_peer::state::connected;
+                info_message("RTP-MIDI session with", pr->name());
+            }
+        }
+        else if (cmd == "NO" || cmd == "BY")
+        {
+            if (cmd == "NO")
+                warn_message("RTP-MIDI peer declined", pr->name());
+            else
+                info_message("RTP-MIDI peer left", pr->name());
+
+            pr->reset_session();
+            pr->m_retry_us = now + c_invite_rest_us;
+        }
+    }
+}
+
+void
+rtp_network::send_invitation (rtp_peer & pr, bool iscontrol)
+{
+    int fd = iscontrol ? m_control_fd : m_data_fd ;
+    const sockaddr_in & to = iscontrol ? pr.m_control_addr : pr.m_data_addr ;
+    send_command(fd, to, "IN", pr.m_token);
+    ++pr.m_tries;
+    pr.m_retry_us = microtime() + c_invite_us;
+}
+
+/**
+ *  Sends an IN, OK, NO, or BY command:  the protocol version, the
+ *  initiator's token, our SSRC, and, but for BY, our name.
+ */
+
+void
+rtp_network::send_command
+(
+    int fd, const sockaddr_in & to, const char * cmd,
+    std::uint32_t token, bool withname
+)
+{
+    std::vector<midibyte> msg;
+    msg.push_back(0xFF);
+    msg.push_back(0xFF);
+    msg.push_back(midibyte(cmd[0]));
+    msg.push_back(midibyte(cmd[1]));
+    put32(msg, c_version);
+    put32(msg, token);
+    put32(msg, m_ssrc);
+    if (withname)
+    {
+        msg.insert(msg.end(), m_name.begin(), m_name.end());
+        msg.push_back(0);
+    }
+    (void) ::sendto
+    (
+        fd, msg.data(), msg.size(), 0,
+        reinterpret_cast<const sockaddr *>(&to), sizeof to
+    );
+}
+
+/**
+ *  Sends a clock synchronization, CK, on the data port.  Count 0 starts
+ *  one with our time; the peer answers with count 1 and its time; count 2
+ *  returns our time again, and each side then knows the round trip, and
+ *  so the offset of the clocks.
+ */
+
+void
+rtp_network::send_sync
+(
+    rtp_peer & pr, int count, std::uint64_t ts1,
+    std::uint64_t ts2, std::uint64_t ts3
+)
+{
+    std::vector<midibyte> msg;
+    msg.push_back(0xFF);
+    msg.push_back(0xFF);
+    msg.push_back('C');
+    msg.push_back('K');
+    put32(msg, m_ssrc);
+    msg.push_back(midibyte(count));
+    msg.push_back(0);
+    put16(msg, 0);
+    put64(msg, ts1);
+    put64(msg, ts2);
+    put64(msg, ts3);
+    (void) ::sendto
+    (
+        m_data_fd, msg.data(), msg.size(), 0,
+        reinterpret_cast<const sockaddr *>(&pr.m_data_addr),
+        sizeof pr.m_data_addr
+    );
+}
+
+/**
+ *  Sends receiver feedback, RS, on the control port:  the sequence number
+ *  of the last packet received, so that the peer can trim its journal.
+ */
+
+void
+rtp_network::send_feedback (rtp_peer & pr)
+{
+    std::vector<midibyte> msg;
+    msg.push_back(0xFF);
+    msg.push_back(0xFF);
+    msg.push_back('R');
+    msg.push_back('S');
+    put32(msg, m_ssrc);
+    put16(msg, pr.m_recv_seq);
+    put16(msg, 0);
+    (void) ::sendto
+    (
+        m_control_fd, msg.data(), msg.size(), 0,
+        reinterpret_cast<const sockaddr *>(&pr.m_control_addr),
+        sizeof pr.m_control_addr
+    );
+}
+
+/**
+ *  Finds the peer a datagram came from:  by host and port, or, since a
+ *  peer that invites us can use other ports, by host alone.
+ */
+
+rtp_peer *
+rtp_network::find_peer (const sockaddr_in & from, bool iscontrol)
+{
+    rtp_peer * result = nullptr;
+    for (auto & pr : m_peers)
+    {
+        if (! pr->m_resolved)
+            continue;
+
+        const sockaddr_in & a = iscontrol ?
+            pr->m_control_addr : pr->m_data_addr ;
+
+        if (a.sin_addr.s_addr == from.sin_addr.s_addr)
+        {
+            if (a.sin_port == from.sin_port)
+                return pr.get();
+
+            if (is_nullptr(result))
+                result = pr.get();
+        }
+    }
+    return result;
+}
+
+rtp_peer *
+rtp_network::find_peer (std::uint32_t ssrc)
+{
+    for (auto & pr : m_peers)
+    {
+        if (pr->connected() && pr->m_peer_ssrc == ssrc)
+            return pr.get();
+    }
+    return nullptr;
+}
+
+}           // namespace seq66
+
+/*
+ * rtp_session.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+